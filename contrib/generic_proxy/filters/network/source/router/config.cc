@@ -15,7 +15,13 @@ RouterFactory::createFilterFactoryFromProto(const Protobuf::Message& config, con
       const envoy::extensions::filters::network::generic_proxy::router::v3::Router&>(
       config, context.messageValidationVisitor());
 
-  auto router_config = std::make_shared<RouterConfig>(typed_config);
+  if (typed_config.bind_upstream_connection() && typed_config.has_multiplexing()) {
+    throw EnvoyException(
+        "generic proxy router: bind_upstream_connection and multiplexing are mutually exclusive");
+  }
+
+  auto router_config = std::make_shared<RouterConfig>(
+      typed_config, context.serverFactoryContext().threadLocal());
 
   return [&context, router_config](FilterChainFactoryCallbacks& callbacks) {
     callbacks.addDecoderFilter(std::make_shared<RouterFilter>(router_config, context));
@@ -4,9 +4,11 @@
 
 #include "envoy/network/connection.h"
 #include "envoy/server/factory_context.h"
+#include "envoy/thread_local/thread_local.h"
 
 #include "source/common/buffer/buffer_impl.h"
 #include "source/common/common/linked_object.h"
+#include "source/common/protobuf/utility.h"
 #include "source/common/stream_info/stream_info_impl.h"
 #include "source/common/upstream/load_balancer_context_base.h"
 
@@ -104,13 +106,27 @@ using UpstreamRequestPtr = std::unique_ptr<UpstreamRequest>;
 
 class RouterConfig {
 public:
-  RouterConfig(const envoy::extensions::filters::network::generic_proxy::router::v3::Router& config)
-      : bind_upstream_connection_(config.bind_upstream_connection()) {}
+  static constexpr uint32_t DefaultMaxRequestsPerConnection = 100;
+
+  RouterConfig(const envoy::extensions::filters::network::generic_proxy::router::v3::Router& config,
+               ThreadLocal::SlotAllocator& tls)
+      : bind_upstream_connection_(config.bind_upstream_connection()) {
+    if (config.has_multiplexing()) {
+      multiplexed_upstream_factory_ = std::make_unique<MultiplexedGenericUpstreamFactory>(
+          tls, PROTOBUF_GET_WRAPPED_OR_DEFAULT(config.multiplexing(), max_requests_per_connection,
+                                               DefaultMaxRequestsPerConnection));
+    }
+  }
 
   bool bindUpstreamConnection() const { return bind_upstream_connection_; }
 
+  // The factory of the upstreams multiplexed over the shared connections, or nullptr if the
+  // requests are not multiplexed.
+  GenericUpstreamFactory* upstreamFactory() const { return multiplexed_upstream_factory_.get(); }
+
 private:
   const bool bind_upstream_connection_{};
+  std::unique_ptr<MultiplexedGenericUpstreamFactory> multiplexed_upstream_factory_;
 };
 using RouterConfigSharedPtr = std::shared_ptr<RouterConfig>;
 
@@ -124,6 +140,9 @@ public:
       : config_(std::move(config)), generic_upstream_factory_(upstream_factory),
         cluster_manager_(context.serverFactoryContext().clusterManager()),
         time_source_(context.serverFactoryContext().timeSource()) {
+    if (generic_upstream_factory_ == nullptr) {
+      generic_upstream_factory_ = config_->upstreamFactory();
+    }
     if (generic_upstream_factory_ == nullptr) {
       generic_upstream_factory_ = &DefaultGenericUpstreamFactory::get();
     }
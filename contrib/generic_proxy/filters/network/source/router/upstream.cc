@@ -1,5 +1,7 @@
 #include "contrib/generic_proxy/filters/network/source/router/upstream.h"
 
+#include <algorithm>
+
 namespace Envoy {
 namespace Extensions {
 namespace NetworkFilters {
@@ -32,12 +34,11 @@ void SharedRequestManager::onDecodingSuccess(ResponseHeaderFramePtr header_frame
   const bool end_stream = header_frame->frameFlags().endStream();
 
   auto it = pending_requests_.find(stream_id);
-  auto cb = it->second;
-
   if (it == pending_requests_.end()) {
     ENVOY_LOG(error, "generic proxy: id {} not found for frame", stream_id);
     return;
   }
+  auto cb = it->second;
 
   // If the response stream is end, remove the callbacks from the map because we
   // no longer need to track the response.
@@ -52,12 +53,11 @@ void SharedRequestManager::onDecodingSuccess(ResponseCommonFramePtr common_frame
   const bool end_stream = common_frame->frameFlags().endStream();
 
   auto it = pending_requests_.find(stream_id);
-  auto cb = it->second;
-
   if (it == pending_requests_.end()) {
     ENVOY_LOG(error, "generic proxy: id {} not found for frame", stream_id);
     return;
   }
+  auto cb = it->second;
 
   // If the response stream is end, remove the callbacks from the map because we
   // no longer need to track the response.
@@ -70,6 +70,7 @@ void SharedRequestManager::onDecodingSuccess(ResponseCommonFramePtr common_frame
 
 void SharedRequestManager::onDecodingFailure(absl::string_view reason) {
   ENVOY_LOG(error, "generic proxy shared encoder decoder: decoding failure ({})", reason);
+  decoding_failed_ = true;
 
   // Notify all pending requests that the decoding is failed.
   while (!pending_requests_.empty()) {
@@ -321,6 +322,183 @@ void OwnedGenericUpstream::onUpstreamFailure(ConnectionPool::PoolFailureReason r
   upstream_request->onUpstreamFailure(reason, transport_failure_reason);
 }
 
+MultiplexedGenericUpstream::~MultiplexedGenericUpstream() {
+  // The connection is not handed back to the pool, where the responses of the reset requests
+  // could be read by the next user of the connection.
+  closed_ = true;
+  MultiplexedGenericUpstreamBase::cleanUp(true);
+}
+
+bool MultiplexedGenericUpstream::available(uint64_t stream_id) const {
+  if (closed_) {
+    return false;
+  }
+  if (encoder_decoder_ == nullptr) {
+    return pending_requests_.size() < max_requests_ && !pending_requests_.contains(stream_id);
+  }
+  return !encoder_decoder_->decodingFailed() && encoder_decoder_->requestsSize() < max_requests_ &&
+         !encoder_decoder_->containsRequest(stream_id);
+}
+
+void MultiplexedGenericUpstream::onUpstreamData(Buffer::Instance& data, bool end_stream) {
+  // The requests may release the connection while their responses are dispatched to them.
+  const MultiplexedGenericUpstreamSharedPtr self = shared_from_this();
+  MultiplexedGenericUpstreamBase::onUpstreamData(data, end_stream);
+
+  // All the requests were failed on a decoding failure, and the connection can't be used any
+  // further.
+  if (!closed_ && encoder_decoder_ != nullptr && encoder_decoder_->decodingFailed()) {
+    ENVOY_LOG(debug, "generic proxy upstream: close multiplexed connection on decoding failure");
+    onClosed();
+    MultiplexedGenericUpstreamBase::cleanUp(true);
+  }
+}
+
+void MultiplexedGenericUpstream::onEvent(Network::ConnectionEvent event) {
+  if (closed_ || event == Network::ConnectionEvent::Connected ||
+      event == Network::ConnectionEvent::ConnectedZeroRtt) {
+    return;
+  }
+
+  const MultiplexedGenericUpstreamSharedPtr self = shared_from_this();
+  onClosed();
+  if (encoder_decoder_ != nullptr) {
+    encoder_decoder_->onConnectionClose(event);
+  }
+}
+
+void MultiplexedGenericUpstream::onUpstreamSuccess() {
+  ASSERT(encoder_decoder_ != nullptr);
+
+  // The requests may stop the connection while it is handed to them.
+  const MultiplexedGenericUpstreamSharedPtr self = shared_from_this();
+  while (!pending_requests_.empty() && !closed_) {
+    auto it = pending_requests_.begin();
+    auto cb = it->second;
+
+    // Insert it to the waiting response list and remove it from the waiting upstream list.
+    encoder_decoder_->appendUpstreamRequest(it->first, cb);
+    pending_requests_.erase(it);
+
+    cb->onUpstreamSuccess();
+  }
+}
+
+void MultiplexedGenericUpstream::onUpstreamFailure(ConnectionPool::PoolFailureReason reason,
+                                                   absl::string_view transport_reason) {
+  const MultiplexedGenericUpstreamSharedPtr self = shared_from_this();
+  onClosed();
+
+  while (!pending_requests_.empty()) {
+    // Remove then notify.
+    auto it = pending_requests_.begin();
+    auto cb = it->second;
+    pending_requests_.erase(it);
+    cb->onUpstreamFailure(reason, transport_reason);
+  }
+}
+
+void MultiplexedGenericUpstream::appendUpstreamRequest(uint64_t stream_id,
+                                                       UpstreamRequestCallbacks* pending_request) {
+  ASSERT(available(stream_id));
+
+  if (encoder_decoder_ != nullptr) {
+    encoder_decoder_->appendUpstreamRequest(stream_id, pending_request);
+    pending_request->onUpstreamSuccess();
+    return;
+  }
+
+  pending_requests_[stream_id] = pending_request;
+  // If the upstream connection is already initialized, this is a no-op.
+  tryInitialize();
+}
+
+void MultiplexedGenericUpstream::removeUpstreamRequest(uint64_t stream_id) {
+  pending_requests_.erase(stream_id);
+  if (encoder_decoder_ != nullptr) {
+    encoder_decoder_->removeUpstreamRequest(stream_id);
+  }
+}
+
+void MultiplexedGenericUpstream::onClosed() {
+  if (closed_) {
+    return;
+  }
+  closed_ = true;
+  closed_cb_(*this);
+}
+
+MultiplexedGenericUpstreamSharedPtr
+MultiplexedGenericUpstreams::upstream(const Upstream::TcpPoolData& pool_data,
+                                      const CodecFactory& codec_factory, uint64_t stream_id) {
+  const Upstream::HostDescription* host = pool_data.host().get();
+  std::vector<MultiplexedGenericUpstreamSharedPtr>& upstreams = upstreams_[host];
+  for (const MultiplexedGenericUpstreamSharedPtr& upstream : upstreams) {
+    if (upstream->available(stream_id)) {
+      return upstream;
+    }
+  }
+
+  // A closed connection removes itself from the connections of the worker, if they are still
+  // around.
+  std::weak_ptr<MultiplexedGenericUpstreams> weak_upstreams = shared_from_this();
+  auto upstream = std::make_shared<MultiplexedGenericUpstream>(
+      pool_data, codec_factory, max_requests_per_connection_,
+      [weak_upstreams, host](MultiplexedGenericUpstream& closed) {
+        MultiplexedGenericUpstreamsSharedPtr upstreams = weak_upstreams.lock();
+        if (upstreams == nullptr) {
+          return;
+        }
+        auto it = upstreams->upstreams_.find(host);
+        if (it == upstreams->upstreams_.end()) {
+          return;
+        }
+        auto& host_upstreams = it->second;
+        host_upstreams.erase(std::remove_if(host_upstreams.begin(), host_upstreams.end(),
+                                            [&closed](const auto& upstream) {
+                                              return upstream.get() == &closed;
+                                            }),
+                             host_upstreams.end());
+        if (host_upstreams.empty()) {
+          upstreams->upstreams_.erase(it);
+        }
+      });
+  upstreams.push_back(upstream);
+  return upstream;
+}
+
+void MultiplexedGenericUpstreamHandle::appendUpstreamRequest(
+    uint64_t stream_id, UpstreamRequestCallbacks* pending_request) {
+  ASSERT(upstream_ == nullptr);
+  upstream_ = upstreams_->upstream(pool_data_, codec_factory_, stream_id);
+  upstream_->appendUpstreamRequest(stream_id, pending_request);
+}
+
+void MultiplexedGenericUpstreamHandle::removeUpstreamRequest(uint64_t stream_id) {
+  if (upstream_ != nullptr) {
+    upstream_->removeUpstreamRequest(stream_id);
+  }
+}
+
+MultiplexedGenericUpstreamFactory::MultiplexedGenericUpstreamFactory(
+    ThreadLocal::SlotAllocator& tls, uint32_t max_requests_per_connection)
+    : tls_(tls) {
+  tls_.set([max_requests_per_connection](Event::Dispatcher&) {
+    return std::make_shared<MultiplexedGenericUpstreams>(max_requests_per_connection);
+  });
+}
+
+GenericUpstreamSharedPtr MultiplexedGenericUpstreamFactory::createGenericUpstream(
+    Upstream::ThreadLocalCluster& cluster, Upstream::LoadBalancerContext* context,
+    Network::Connection&, const CodecFactory& codec_factory, bool) const {
+  auto pool_data = cluster.tcpConnPool(Upstream::ResourcePriority::Default, context);
+  if (!pool_data.has_value()) {
+    return nullptr;
+  }
+  return std::make_shared<MultiplexedGenericUpstreamHandle>(
+      tls_.get()->shared_from_this(), std::move(pool_data.value()), codec_factory);
+}
+
 GenericUpstreamSharedPtr ProdGenericUpstreamFactory::createGenericUpstream(
     Upstream::ThreadLocalCluster& cluster, Upstream::LoadBalancerContext* context,
     Network::Connection& downstream_conn, const CodecFactory& codec_factory, bool bound) const {
@@ -3,6 +3,7 @@
 #include <cstdint>
 
 #include "envoy/network/connection.h"
+#include "envoy/thread_local/thread_local.h"
 
 #include "source/common/buffer/buffer_impl.h"
 
@@ -105,6 +106,8 @@ public:
 
   size_t requestsSize() const { return request_manager_.size(); }
   bool containsRequest(uint64_t stream_id) const { return request_manager_.contains(stream_id); }
+  // Whether a response could not be decoded, after which the responses can't be told apart.
+  bool decodingFailed() const { return request_manager_.decodingFailed(); }
 
   // ClientCodecCallbacks
   void onDecodingSuccess(ResponseHeaderFramePtr header_frame,
@@ -148,8 +151,10 @@ public:
 
   size_t size() const { return pending_requests_.size(); }
   bool contains(uint64_t stream_id) const { return pending_requests_.contains(stream_id); }
+  bool decodingFailed() const { return decoding_failed_; }
 
   absl::flat_hash_map<uint64_t, UpstreamRequestCallbacks*> pending_requests_;
+  bool decoding_failed_{};
 };
 
 class UniqueRequestManager : Logger::Loggable<Logger::Id::upstream> {
@@ -389,6 +394,154 @@ private:
   UpstreamRequestCallbacks* upstream_request_{};
 };
 
+using MultiplexedGenericUpstreamBase = UpstreamBase<SharedEncoderDecoder>;
+/**
+ * An upstream connection shared by the requests of all the downstream connections of a worker to
+ * a host. The responses are dispatched to the requests by stream id, so the requests on the same
+ * connection must have distinct stream ids.
+ */
+class MultiplexedGenericUpstream
+    : public MultiplexedGenericUpstreamBase,
+      public std::enable_shared_from_this<MultiplexedGenericUpstream> {
+public:
+  using ClosedCb = std::function<void(MultiplexedGenericUpstream&)>;
+
+  MultiplexedGenericUpstream(Upstream::TcpPoolData tcp_pool_data,
+                             const CodecFactory& codec_factory, uint32_t max_requests,
+                             ClosedCb closed_cb)
+      : UpstreamBase(std::move(tcp_pool_data), codec_factory), max_requests_(max_requests),
+        closed_cb_(std::move(closed_cb)) {}
+  ~MultiplexedGenericUpstream() override;
+
+  /**
+   * @return true if the connection takes a new request with the stream id.
+   */
+  bool available(uint64_t stream_id) const;
+
+  // Tcp::ConnectionPool::UpstreamCallbacks
+  void onUpstreamData(Buffer::Instance& data, bool end_stream) override;
+  void onEvent(Network::ConnectionEvent event) override;
+
+  // UpstreamBase
+  void onUpstreamSuccess() override;
+  void onUpstreamFailure(ConnectionPool::PoolFailureReason reason,
+                         absl::string_view transport_failure_reason) override;
+
+  // Upstream
+  void appendUpstreamRequest(uint64_t stream_id,
+                             UpstreamRequestCallbacks* pending_request) override;
+  void removeUpstreamRequest(uint64_t stream_id) override;
+
+  size_t waitingUpstreamRequestsSize() const { return pending_requests_.size(); }
+  size_t waitingResponseRequestsSize() const {
+    return encoder_decoder_ ? encoder_decoder_->requestsSize() : 0;
+  }
+
+private:
+  void onClosed();
+
+  const uint32_t max_requests_;
+  const ClosedCb closed_cb_;
+  bool closed_{};
+
+  // The requests waiting for the connection, in the order in which they were started.
+  using LinkedAbslHashMap = quiche::QuicheLinkedHashMap<uint64_t, UpstreamRequestCallbacks*>;
+  LinkedAbslHashMap pending_requests_;
+};
+
+using MultiplexedGenericUpstreamSharedPtr = std::shared_ptr<MultiplexedGenericUpstream>;
+
+/**
+ * The shared upstream connections of a worker, by host.
+ */
+class MultiplexedGenericUpstreams
+    : public ThreadLocal::ThreadLocalObject,
+      public std::enable_shared_from_this<MultiplexedGenericUpstreams> {
+public:
+  explicit MultiplexedGenericUpstreams(uint32_t max_requests_per_connection)
+      : max_requests_per_connection_(max_requests_per_connection) {}
+
+  /**
+   * @return a connection to the host of the pool that takes the request with the stream id,
+   * opening one if none does.
+   */
+  MultiplexedGenericUpstreamSharedPtr upstream(const Upstream::TcpPoolData& pool_data,
+                                               const CodecFactory& codec_factory,
+                                               uint64_t stream_id);
+
+  size_t upstreamsSize(const Upstream::HostDescription* host) const {
+    auto it = upstreams_.find(host);
+    return it != upstreams_.end() ? it->second.size() : 0;
+  }
+
+private:
+  const uint32_t max_requests_per_connection_;
+  absl::flat_hash_map<const Upstream::HostDescription*,
+                      std::vector<MultiplexedGenericUpstreamSharedPtr>>
+      upstreams_;
+};
+
+using MultiplexedGenericUpstreamsSharedPtr = std::shared_ptr<MultiplexedGenericUpstreams>;
+
+/**
+ * The upstream of a request multiplexed over the shared connections to a host. The request takes
+ * its connection when it is started, once its stream id is known.
+ */
+class MultiplexedGenericUpstreamHandle : public GenericUpstream {
+public:
+  MultiplexedGenericUpstreamHandle(MultiplexedGenericUpstreamsSharedPtr upstreams,
+                                   Upstream::TcpPoolData pool_data,
+                                   const CodecFactory& codec_factory)
+      : upstreams_(std::move(upstreams)), pool_data_(std::move(pool_data)),
+        codec_factory_(codec_factory) {}
+
+  // Upstream
+  void appendUpstreamRequest(uint64_t stream_id,
+                             UpstreamRequestCallbacks* pending_request) override;
+  void removeUpstreamRequest(uint64_t stream_id) override;
+  Upstream::HostDescriptionConstSharedPtr upstreamHost() const override {
+    return pool_data_.host();
+  }
+  ClientCodec& clientCodec() override {
+    ASSERT(upstream_ != nullptr);
+    return upstream_->clientCodec();
+  }
+  OptRef<Network::Connection> upstreamConnection() override {
+    return upstream_ != nullptr ? upstream_->upstreamConnection() : OptRef<Network::Connection>{};
+  }
+  // The connection is shared by other requests, and closes itself when its responses can't be
+  // decoded.
+  void cleanUp(bool) override {}
+
+  const MultiplexedGenericUpstreamSharedPtr& upstream() const { return upstream_; }
+
+private:
+  const MultiplexedGenericUpstreamsSharedPtr upstreams_;
+  const Upstream::TcpPoolData pool_data_;
+  const CodecFactory& codec_factory_;
+  MultiplexedGenericUpstreamSharedPtr upstream_;
+};
+
+/**
+ * Multiplexes the requests of all the downstream connections of a worker over shared upstream
+ * connections to each host. A host gets another connection when its connections carry as many
+ * requests as they may, or all carry a request with the same stream id.
+ */
+class MultiplexedGenericUpstreamFactory : public GenericUpstreamFactory {
+public:
+  MultiplexedGenericUpstreamFactory(ThreadLocal::SlotAllocator& tls,
+                                    uint32_t max_requests_per_connection);
+
+  GenericUpstreamSharedPtr createGenericUpstream(Upstream::ThreadLocalCluster& cluster,
+                                                 Upstream::LoadBalancerContext* context,
+                                                 Network::Connection& downstream_conn,
+                                                 const CodecFactory& codec_factory,
+                                                 bool bound) const override;
+
+private:
+  ThreadLocal::TypedSlot<MultiplexedGenericUpstreams> tls_;
+};
+
 class ProdGenericUpstreamFactory : public GenericUpstreamFactory {
 public:
   GenericUpstreamSharedPtr createGenericUpstream(Upstream::ThreadLocalCluster& cluster,
@@ -1,4 +1,5 @@
 #include "test/mocks/server/factory_context.h"
+#include "test/test_common/utility.h"
 
 #include "contrib/generic_proxy/filters/network/source/router/config.h"
 #include "contrib/generic_proxy/filters/network/test/mocks/filter.h"
@@ -36,6 +37,24 @@ TEST(RouterFactoryTest, RouterFactoryTest) {
   fn(mock_cb);
 }
 
+TEST(RouterFactoryTest, MultiplexingConfig) {
+  NiceMock<Server::Configuration::MockFactoryContext> factory_context;
+  RouterFactory factory;
+
+  envoy::extensions::filters::network::generic_proxy::router::v3::Router proto_config;
+  proto_config.mutable_multiplexing()->mutable_max_requests_per_connection()->set_value(10);
+  auto fn = factory.createFilterFactoryFromProto(proto_config, "test", factory_context);
+
+  NiceMock<MockFilterChainFactoryCallbacks> mock_cb;
+  EXPECT_CALL(mock_cb, addDecoderFilter(_));
+  fn(mock_cb);
+
+  proto_config.set_bind_upstream_connection(true);
+  EXPECT_THROW_WITH_MESSAGE(
+      factory.createFilterFactoryFromProto(proto_config, "test", factory_context), EnvoyException,
+      "generic proxy router: bind_upstream_connection and multiplexing are mutually exclusive");
+}
+
 } // namespace
 } // namespace Router
 } // namespace GenericProxy
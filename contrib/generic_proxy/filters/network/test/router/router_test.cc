@@ -88,7 +88,8 @@ public:
   void setup(FrameFlags frame_flags = FrameFlags{}, bool bound_upstream_connection = false) {
     envoy::extensions::filters::network::generic_proxy::router::v3::Router router_config;
     router_config.set_bind_upstream_connection(bound_upstream_connection);
-    config_ = std::make_shared<Router::RouterConfig>(router_config);
+    config_ = std::make_shared<Router::RouterConfig>(
+        router_config, factory_context_.server_factory_context_.thread_local_);
 
     filter_ =
         std::make_shared<Router::RouterFilter>(config_, factory_context_, &mock_upstream_factory_);
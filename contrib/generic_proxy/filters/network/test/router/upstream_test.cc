@@ -3,6 +3,7 @@
 #include "source/common/tracing/common_values.h"
 
 #include "test/mocks/server/factory_context.h"
+#include "test/mocks/thread_local/mocks.h"
 #include "test/test_common/registry.h"
 #include "test/test_common/utility.h"
 
@@ -114,6 +115,24 @@ public:
         thread_local_cluster_, nullptr, mock_downstream_connection_1_, mock_codec_factory_, false);
     return std::dynamic_pointer_cast<OwnedGenericUpstream>(result);
   }
+  std::shared_ptr<MultiplexedGenericUpstreamHandle>
+  createMultiplexedGenericUpstream(uint32_t max_requests_per_connection = 100) {
+    if (multiplexed_upstream_factory_ == nullptr) {
+      multiplexed_upstream_factory_ =
+          std::make_unique<MultiplexedGenericUpstreamFactory>(tls_, max_requests_per_connection);
+    }
+    auto result = multiplexed_upstream_factory_->createGenericUpstream(
+        thread_local_cluster_, nullptr, mock_downstream_connection_1_, mock_codec_factory_, false);
+    return std::dynamic_pointer_cast<MultiplexedGenericUpstreamHandle>(result);
+  }
+  // Hands the pending connection of the pool to the multiplexed upstream waiting for it.
+  void multiplexedPoolReady() {
+    EXPECT_CALL(*thread_local_cluster_.tcp_conn_pool_.connection_data_, addUpstreamCallbacks(_))
+        .WillOnce(testing::Invoke([&](Tcp::ConnectionPool::UpstreamCallbacks& cb) {
+          mock_upstream_connection_.addConnectionCallbacks(cb);
+        }));
+    thread_local_cluster_.tcp_conn_pool_.poolReady(mock_upstream_connection_);
+  }
 
   NiceMock<Upstream::MockThreadLocalCluster> thread_local_cluster_;
   NiceMock<MockCodecFactory> mock_codec_factory_;
@@ -126,6 +145,9 @@ public:
 
   NiceMock<Network::MockServerConnection> mock_downstream_connection_1_;
   NiceMock<Network::MockServerConnection> mock_downstream_connection_2_;
+
+  NiceMock<ThreadLocal::MockInstance> tls_;
+  std::unique_ptr<MultiplexedGenericUpstreamFactory> multiplexed_upstream_factory_;
 };
 
 TEST_F(UpstreamTest, BoundGenericUpstreamWillBeReusedForSameConnection) {
@@ -661,6 +683,176 @@ TEST_F(UpstreamTest, BoundGenericUpstreamUpstreamConnectionClose) {
   EXPECT_EQ(0, generic_upstream->waitingResponseRequestsSize());
 }
 
+TEST_F(UpstreamTest, MultiplexedGenericUpstreamSharedByRequests) {
+  NiceMock<MockUpstreamRequestCallbacks> mock_upstream_request_callbacks_1;
+  NiceMock<MockUpstreamRequestCallbacks> mock_upstream_request_callbacks_2;
+  NiceMock<MockUpstreamRequestCallbacks> mock_upstream_request_callbacks_3;
+
+  auto generic_upstream_1 = createMultiplexedGenericUpstream();
+  auto generic_upstream_2 = createMultiplexedGenericUpstream();
+  EXPECT_NE(generic_upstream_1, generic_upstream_2);
+
+  EXPECT_CALL(thread_local_cluster_.tcp_conn_pool_, newConnection(_));
+  generic_upstream_1->appendUpstreamRequest(1, &mock_upstream_request_callbacks_1);
+  generic_upstream_2->appendUpstreamRequest(2, &mock_upstream_request_callbacks_2);
+  EXPECT_EQ(generic_upstream_1->upstream(), generic_upstream_2->upstream());
+  EXPECT_EQ(2, generic_upstream_1->upstream()->waitingUpstreamRequestsSize());
+
+  EXPECT_CALL(mock_upstream_request_callbacks_1, onUpstreamSuccess());
+  EXPECT_CALL(mock_upstream_request_callbacks_2, onUpstreamSuccess());
+  multiplexedPoolReady();
+  EXPECT_EQ(0, generic_upstream_1->upstream()->waitingUpstreamRequestsSize());
+  EXPECT_EQ(2, generic_upstream_1->upstream()->waitingResponseRequestsSize());
+
+  // A request on the ready connection is started right away.
+  auto generic_upstream_3 = createMultiplexedGenericUpstream();
+  EXPECT_CALL(thread_local_cluster_.tcp_conn_pool_, newConnection(_)).Times(0);
+  EXPECT_CALL(mock_upstream_request_callbacks_3, onUpstreamSuccess());
+  generic_upstream_3->appendUpstreamRequest(3, &mock_upstream_request_callbacks_3);
+  EXPECT_EQ(generic_upstream_1->upstream(), generic_upstream_3->upstream());
+  EXPECT_EQ(&mock_upstream_connection_, generic_upstream_3->upstreamConnection().ptr());
+
+  auto response_2 = std::make_unique<FakeStreamCodecFactory::FakeResponse>();
+  response_2->stream_frame_flags_ = FrameFlags(2);
+
+  EXPECT_CALL(*mock_client_codec_raw_, decode(_, _))
+      .WillOnce(testing::Invoke([&](Buffer::Instance&, bool) {
+        EXPECT_CALL(mock_upstream_request_callbacks_2, onDecodingSuccess(_, _));
+        cocec_callbacks_->onDecodingSuccess(std::move(response_2), {});
+      }));
+
+  Buffer::OwnedImpl fake_buffer;
+  fake_buffer.add("fake data");
+  generic_upstream_1->upstream()->onUpstreamData(fake_buffer, false);
+  EXPECT_EQ(2, generic_upstream_1->upstream()->waitingResponseRequestsSize());
+
+  // The cleanup of a request does not close the shared connection.
+  EXPECT_CALL(mock_upstream_connection_, close(_)).Times(0);
+  generic_upstream_1->removeUpstreamRequest(1);
+  generic_upstream_1->cleanUp(true);
+  EXPECT_EQ(1, generic_upstream_1->upstream()->waitingResponseRequestsSize());
+  testing::Mock::VerifyAndClearExpectations(&mock_upstream_connection_);
+}
+
+TEST_F(UpstreamTest, MultiplexedGenericUpstreamOpensAnotherConnection) {
+  NiceMock<MockUpstreamRequestCallbacks> mock_upstream_request_callbacks_1;
+  NiceMock<MockUpstreamRequestCallbacks> mock_upstream_request_callbacks_2;
+  NiceMock<MockUpstreamRequestCallbacks> mock_upstream_request_callbacks_3;
+
+  auto generic_upstream_1 = createMultiplexedGenericUpstream(2);
+  auto generic_upstream_2 = createMultiplexedGenericUpstream(2);
+  auto generic_upstream_3 = createMultiplexedGenericUpstream(2);
+
+  EXPECT_CALL(thread_local_cluster_.tcp_conn_pool_, newConnection(_)).Times(2);
+  generic_upstream_1->appendUpstreamRequest(1, &mock_upstream_request_callbacks_1);
+
+  // The stream id is already in flight on the connection.
+  generic_upstream_2->appendUpstreamRequest(1, &mock_upstream_request_callbacks_2);
+  EXPECT_NE(generic_upstream_1->upstream(), generic_upstream_2->upstream());
+
+  // The first connection takes another stream id.
+  generic_upstream_3->appendUpstreamRequest(3, &mock_upstream_request_callbacks_3);
+  EXPECT_EQ(generic_upstream_1->upstream(), generic_upstream_3->upstream());
+
+  // The connections carry as many requests as they may.
+  NiceMock<MockUpstreamRequestCallbacks> mock_upstream_request_callbacks_4;
+  NiceMock<MockUpstreamRequestCallbacks> mock_upstream_request_callbacks_5;
+  auto generic_upstream_4 = createMultiplexedGenericUpstream(2);
+  auto generic_upstream_5 = createMultiplexedGenericUpstream(2);
+  generic_upstream_4->appendUpstreamRequest(4, &mock_upstream_request_callbacks_4);
+  EXPECT_EQ(generic_upstream_2->upstream(), generic_upstream_4->upstream());
+  EXPECT_CALL(thread_local_cluster_.tcp_conn_pool_, newConnection(_));
+  generic_upstream_5->appendUpstreamRequest(5, &mock_upstream_request_callbacks_5);
+  EXPECT_NE(generic_upstream_1->upstream(), generic_upstream_5->upstream());
+  EXPECT_NE(generic_upstream_2->upstream(), generic_upstream_5->upstream());
+}
+
+TEST_F(UpstreamTest, MultiplexedGenericUpstreamOnPoolFailure) {
+  NiceMock<MockUpstreamRequestCallbacks> mock_upstream_request_callbacks_1;
+  NiceMock<MockUpstreamRequestCallbacks> mock_upstream_request_callbacks_2;
+
+  auto generic_upstream_1 = createMultiplexedGenericUpstream();
+  auto generic_upstream_2 = createMultiplexedGenericUpstream();
+
+  EXPECT_CALL(thread_local_cluster_.tcp_conn_pool_, newConnection(_));
+  generic_upstream_1->appendUpstreamRequest(1, &mock_upstream_request_callbacks_1);
+  generic_upstream_2->appendUpstreamRequest(2, &mock_upstream_request_callbacks_2);
+
+  EXPECT_CALL(mock_upstream_request_callbacks_1, onUpstreamFailure(_, _));
+  EXPECT_CALL(mock_upstream_request_callbacks_2, onUpstreamFailure(_, _));
+  thread_local_cluster_.tcp_conn_pool_.poolFailure(
+      ConnectionPool::PoolFailureReason::RemoteConnectionFailure);
+
+  // The next request opens another connection.
+  NiceMock<MockUpstreamRequestCallbacks> mock_upstream_request_callbacks_3;
+  auto generic_upstream_3 = createMultiplexedGenericUpstream();
+  EXPECT_CALL(thread_local_cluster_.tcp_conn_pool_, newConnection(_));
+  generic_upstream_3->appendUpstreamRequest(3, &mock_upstream_request_callbacks_3);
+  EXPECT_NE(generic_upstream_1->upstream(), generic_upstream_3->upstream());
+}
+
+TEST_F(UpstreamTest, MultiplexedGenericUpstreamDecodingFailure) {
+  NiceMock<MockUpstreamRequestCallbacks> mock_upstream_request_callbacks_1;
+  NiceMock<MockUpstreamRequestCallbacks> mock_upstream_request_callbacks_2;
+
+  auto generic_upstream_1 = createMultiplexedGenericUpstream();
+  auto generic_upstream_2 = createMultiplexedGenericUpstream();
+  mock_upstream_request_callbacks_1.upstream_ = generic_upstream_1.get();
+
+  EXPECT_CALL(thread_local_cluster_.tcp_conn_pool_, newConnection(_));
+  generic_upstream_1->appendUpstreamRequest(1, &mock_upstream_request_callbacks_1);
+  generic_upstream_2->appendUpstreamRequest(2, &mock_upstream_request_callbacks_2);
+  multiplexedPoolReady();
+
+  EXPECT_CALL(*mock_client_codec_raw_, decode(_, _))
+      .WillOnce(testing::Invoke(
+          [&](Buffer::Instance&, bool) { cocec_callbacks_->onDecodingFailure("test"); }));
+
+  // All the requests fail and the connection, whose responses can't be told apart any more, is
+  // closed.
+  EXPECT_CALL(mock_upstream_request_callbacks_1, onDecodingFailure(_));
+  EXPECT_CALL(mock_upstream_request_callbacks_2, onDecodingFailure(_));
+  EXPECT_CALL(mock_upstream_connection_, close(_));
+
+  Buffer::OwnedImpl fake_buffer;
+  fake_buffer.add("fake data");
+  generic_upstream_1->upstream()->onUpstreamData(fake_buffer, false);
+  EXPECT_EQ(0, generic_upstream_1->upstream()->waitingResponseRequestsSize());
+  EXPECT_FALSE(generic_upstream_1->upstream()->available(3));
+
+  // The next request opens another connection.
+  NiceMock<MockUpstreamRequestCallbacks> mock_upstream_request_callbacks_3;
+  auto generic_upstream_3 = createMultiplexedGenericUpstream();
+  EXPECT_CALL(thread_local_cluster_.tcp_conn_pool_, newConnection(_));
+  generic_upstream_3->appendUpstreamRequest(3, &mock_upstream_request_callbacks_3);
+  EXPECT_NE(generic_upstream_1->upstream(), generic_upstream_3->upstream());
+}
+
+TEST_F(UpstreamTest, MultiplexedGenericUpstreamUpstreamConnectionClose) {
+  NiceMock<MockUpstreamRequestCallbacks> mock_upstream_request_callbacks_1;
+  NiceMock<MockUpstreamRequestCallbacks> mock_upstream_request_callbacks_2;
+
+  auto generic_upstream_1 = createMultiplexedGenericUpstream();
+  auto generic_upstream_2 = createMultiplexedGenericUpstream();
+
+  EXPECT_CALL(thread_local_cluster_.tcp_conn_pool_, newConnection(_));
+  generic_upstream_1->appendUpstreamRequest(1, &mock_upstream_request_callbacks_1);
+  generic_upstream_2->appendUpstreamRequest(2, &mock_upstream_request_callbacks_2);
+  multiplexedPoolReady();
+
+  EXPECT_CALL(mock_upstream_request_callbacks_1, onConnectionClose(_));
+  EXPECT_CALL(mock_upstream_request_callbacks_2, onConnectionClose(_));
+  mock_upstream_connection_.close(Network::ConnectionCloseType::NoFlush);
+  EXPECT_EQ(0, generic_upstream_1->upstream()->waitingResponseRequestsSize());
+
+  // The next request opens another connection.
+  NiceMock<MockUpstreamRequestCallbacks> mock_upstream_request_callbacks_3;
+  auto generic_upstream_3 = createMultiplexedGenericUpstream();
+  EXPECT_CALL(thread_local_cluster_.tcp_conn_pool_, newConnection(_));
+  generic_upstream_3->appendUpstreamRequest(3, &mock_upstream_request_callbacks_3);
+  EXPECT_NE(generic_upstream_1->upstream(), generic_upstream_3->upstream());
+}
+
 TEST_F(UpstreamTest, OwnedGenericUpstreamInitializeAndPoolReady) {
   EXPECT_CALL(thread_local_cluster_, tcpConnPool(_, _));
   auto generic_upstream = createOwnedGenericUpstream();
@@ -505,8 +505,9 @@ CAPIStatus Filter::getHeader(ProcessorState& state, absl::string_view key, uint6
 void copyHeaderMapToGo(Http::HeaderMap& m, GoString* go_strs, char* go_buf) {
   auto i = 0;
   m.iterate([&i, &go_strs, &go_buf](const Http::HeaderEntry& header) -> Http::HeaderMap::Iterate {
-    auto key = std::string(header.key().getStringView());
-    auto value = std::string(header.value().getStringView());
+    // The keys and values are copied straight into the single block of the Go memory.
+    const absl::string_view key = header.key().getStringView();
+    const absl::string_view value = header.value().getStringView();
 
     auto len = key.length();
     // go_strs is the heap memory of go, and the length is twice the number of headers. So range it
@@ -529,6 +530,67 @@ void copyHeaderMapToGo(Http::HeaderMap& m, GoString* go_strs, char* go_buf) {
   });
 }
 
+namespace {
+
+void applyHeaderMutation(Http::HeaderMap& headers, absl::optional<headerAction> act,
+                         absl::string_view key, absl::string_view value) {
+  if (!act.has_value()) {
+    headers.remove(Http::LowerCaseString(key));
+    return;
+  }
+  switch (act.value()) {
+  case HeaderAdd:
+    headers.addCopy(Http::LowerCaseString(key), value);
+    break;
+
+  case HeaderSet:
+    headers.setCopy(Http::LowerCaseString(key), value);
+    break;
+
+  default:
+    RELEASE_ASSERT(false, absl::StrCat("unknown header action: ", act.value()));
+  }
+}
+
+} // namespace
+
+// The mutations of the headers made from a Go thread are applied in the envoy worker thread, to
+// avoid races between reading them in the envoy worker thread and writing them in the Go thread.
+// They are batched: the mutations made until the worker runs the callback of the first one are
+// all applied at once, in order, before anything which the Go thread posts after them.
+void Filter::postHeaderMutation(ProcessorState& state, Http::HeaderMap* headers,
+                                absl::optional<headerAction> action, absl::string_view key,
+                                absl::string_view value) {
+  // should deep copy the string_view before post to dipatcher callback.
+  pending_header_mutations_.push_back({headers, action, std::string(key), std::string(value)});
+  if (pending_header_mutations_.size() > 1) {
+    return;
+  }
+  auto weak_ptr = weak_from_this();
+  state.getDispatcher().post([this, weak_ptr] {
+    if (!weak_ptr.expired()) {
+      applyPendingHeaderMutations();
+    } else {
+      ENVOY_LOG(debug, "golang filter has gone or destroyed in header mutations");
+    }
+  });
+}
+
+void Filter::applyPendingHeaderMutations() {
+  std::vector<HeaderMutation> mutations;
+  {
+    Thread::LockGuard lock(mutex_);
+    if (has_destroyed_) {
+      ENVOY_LOG(debug, "golang filter has gone or destroyed in header mutations");
+      return;
+    }
+    mutations.swap(pending_header_mutations_);
+  }
+  for (const HeaderMutation& mutation : mutations) {
+    applyHeaderMutation(*mutation.headers_, mutation.action_, mutation.key_, mutation.value_);
+  }
+}
+
 CAPIStatus Filter::copyHeaders(ProcessorState& state, GoString* go_strs, char* go_buf) {
   Thread::LockGuard lock(mutex_);
   if (has_destroyed_) {
@@ -569,45 +631,9 @@ CAPIStatus Filter::setHeader(ProcessorState& state, absl::string_view key, absl:
 
   if (state.isThreadSafe()) {
     // it's safe to write header in the safe thread.
-    switch (act) {
-    case HeaderAdd:
-      headers->addCopy(Http::LowerCaseString(key), value);
-      break;
-
-    case HeaderSet:
-      headers->setCopy(Http::LowerCaseString(key), value);
-      break;
-
-    default:
-      RELEASE_ASSERT(false, absl::StrCat("unknown header action: ", act));
-    }
+    applyHeaderMutation(*headers, act, key, value);
   } else {
-    // should deep copy the string_view before post to dipatcher callback.
-    auto key_str = std::string(key);
-    auto value_str = std::string(value);
-
-    auto weak_ptr = weak_from_this();
-    // dispatch a callback to write header in the envoy safe thread, to make the write operation
-    // safety. otherwise, there might be race between reading in the envoy worker thread and writing
-    // in the Go thread.
-    state.getDispatcher().post([this, headers, weak_ptr, key_str, value_str, act] {
-      if (!weak_ptr.expired() && !hasDestroyed()) {
-        switch (act) {
-        case HeaderAdd:
-          headers->addCopy(Http::LowerCaseString(key_str), value_str);
-          break;
-
-        case HeaderSet:
-          headers->setCopy(Http::LowerCaseString(key_str), value_str);
-          break;
-
-        default:
-          RELEASE_ASSERT(false, absl::StrCat("unknown header action: ", act));
-        }
-      } else {
-        ENVOY_LOG(debug, "golang filter has gone or destroyed in setHeader");
-      }
-    });
+    postHeaderMutation(state, headers, act, key, value);
   }
 
   return CAPIStatus::CAPIOK;
@@ -634,20 +660,7 @@ CAPIStatus Filter::removeHeader(ProcessorState& state, absl::string_view key) {
     // it's safe to write header in the safe thread.
     headers->remove(Http::LowerCaseString(key));
   } else {
-    // should deep copy the string_view before post to dipatcher callback.
-    auto key_str = std::string(key);
-
-    auto weak_ptr = weak_from_this();
-    // dispatch a callback to write header in the envoy safe thread, to make the write operation
-    // safety. otherwise, there might be race between reading in the envoy worker thread and writing
-    // in the Go thread.
-    state.getDispatcher().post([this, weak_ptr, headers, key_str] {
-      if (!weak_ptr.expired() && !hasDestroyed()) {
-        headers->remove(Http::LowerCaseString(key_str));
-      } else {
-        ENVOY_LOG(debug, "golang filter has gone or destroyed in removeHeader");
-      }
-    });
+    postHeaderMutation(state, headers, absl::nullopt, key, "");
   }
   return CAPIStatus::CAPIOK;
 }
@@ -759,45 +772,9 @@ CAPIStatus Filter::setTrailer(ProcessorState& state, absl::string_view key, absl
     return CAPIStatus::CAPIInvalidPhase;
   }
   if (state.isThreadSafe()) {
-    switch (act) {
-    case HeaderAdd:
-      trailers->addCopy(Http::LowerCaseString(key), value);
-      break;
-
-    case HeaderSet:
-      trailers->setCopy(Http::LowerCaseString(key), value);
-      break;
-
-    default:
-      RELEASE_ASSERT(false, absl::StrCat("unknown header action: ", act));
-    }
+    applyHeaderMutation(*trailers, act, key, value);
   } else {
-    // should deep copy the string_view before post to dipatcher callback.
-    auto key_str = std::string(key);
-    auto value_str = std::string(value);
-
-    auto weak_ptr = weak_from_this();
-    // dispatch a callback to write trailer in the envoy safe thread, to make the write operation
-    // safety. otherwise, there might be race between reading in the envoy worker thread and
-    // writing in the Go thread.
-    state.getDispatcher().post([this, trailers, weak_ptr, key_str, value_str, act] {
-      if (!weak_ptr.expired() && !hasDestroyed()) {
-        switch (act) {
-        case HeaderAdd:
-          trailers->addCopy(Http::LowerCaseString(key_str), value_str);
-          break;
-
-        case HeaderSet:
-          trailers->setCopy(Http::LowerCaseString(key_str), value_str);
-          break;
-
-        default:
-          RELEASE_ASSERT(false, absl::StrCat("unknown header action: ", act));
-        }
-      } else {
-        ENVOY_LOG(debug, "golang filter has gone or destroyed in setTrailer");
-      }
-    });
+    postHeaderMutation(state, trailers, act, key, value);
   }
   return CAPIStatus::CAPIOK;
 }
@@ -820,20 +797,7 @@ CAPIStatus Filter::removeTrailer(ProcessorState& state, absl::string_view key) {
   if (state.isThreadSafe()) {
     trailers->remove(Http::LowerCaseString(key));
   } else {
-    // should deep copy the string_view before post to dipatcher callback.
-    auto key_str = std::string(key);
-
-    auto weak_ptr = weak_from_this();
-    // dispatch a callback to write trailer in the envoy safe thread, to make the write operation
-    // safety. otherwise, there might be race between reading in the envoy worker thread and writing
-    // in the Go thread.
-    state.getDispatcher().post([this, trailers, weak_ptr, key_str] {
-      if (!weak_ptr.expired() && !hasDestroyed()) {
-        trailers->remove(Http::LowerCaseString(key_str));
-      } else {
-        ENVOY_LOG(debug, "golang filter has gone or destroyed in removeTrailer");
-      }
-    });
+    postHeaderMutation(state, trailers, absl::nullopt, key, "");
   }
   return CAPIStatus::CAPIOK;
 }
@@ -341,6 +341,22 @@ private:
                                                                  Protobuf::Arena* arena);
   CAPIStatus serializeStringValue(Filters::Common::Expr::CelValue value, std::string* result);
 
+  // A mutation of the headers or the trailers made from a Go thread, to apply on the worker.
+  struct HeaderMutation {
+    Http::HeaderMap* headers_;
+    // Unset for a removal.
+    absl::optional<headerAction> action_;
+    std::string key_;
+    std::string value_;
+  };
+
+  // Queues the mutation, to apply on the worker along with the others queued until then: only the
+  // first of them posts a callback.
+  void postHeaderMutation(ProcessorState& state, Http::HeaderMap* headers,
+                          absl::optional<headerAction> action, absl::string_view key,
+                          absl::string_view value) ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+  void applyPendingHeaderMutations();
+
   const FilterConfigSharedPtr config_;
   Dso::HttpFilterDsoPtr dynamic_lib_;
 
@@ -360,6 +376,7 @@ private:
   // back from go).
   Thread::MutexBasicLockable mutex_{};
   bool has_destroyed_ ABSL_GUARDED_BY(mutex_){false};
+  std::vector<HeaderMutation> pending_header_mutations_ ABSL_GUARDED_BY(mutex_);
 
   bool is_golang_processing_log_{false};
 };
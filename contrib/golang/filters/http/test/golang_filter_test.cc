@@ -28,6 +28,7 @@ using testing::_;
 using testing::AtLeast;
 using testing::InSequence;
 using testing::Invoke;
+using testing::Return;
 
 namespace Envoy {
 namespace Extensions {
@@ -184,6 +185,46 @@ TEST_F(GolangHttpFilterTest, SetHeaderAtWrongStage) {
   delete req;
 }
 
+// The header mutations from a Go thread are applied together, in order, on the worker.
+TEST_F(GolangHttpFilterTest, BatchHeaderMutationsFromGoThread) {
+  setup(PASSTHROUGH, genSoPath(PASSTHROUGH), PASSTHROUGH);
+  auto filter = std::make_shared<TestFilter>(
+      config_, Dso::DsoManager<Dso::HttpFilterDsoImpl>::getDsoByPluginName(PASSTHROUGH), 0);
+  auto req = new HttpRequestInternal(*filter);
+  DecodingProcessorState& state = req->decodingState();
+  state.setDecoderFilterCallbacks(decoder_callbacks_);
+  Http::TestRequestHeaderMapImpl request_headers{{":path", "/"}, {"foo", "old"}, {"baz", "old"}};
+  state.headers = &request_headers;
+  state.setFilterState(FilterState::ProcessingHeader);
+
+  EXPECT_CALL(decoder_callbacks_.dispatcher_, isThreadSafe()).WillRepeatedly(Return(false));
+  Event::PostCb apply_mutations;
+  EXPECT_CALL(decoder_callbacks_.dispatcher_, post(_))
+      .WillOnce(Invoke([&](Event::PostCb cb) { apply_mutations = std::move(cb); }));
+  EXPECT_EQ(CAPIOK, filter->setHeader(state, "foo", "new", HeaderSet));
+  EXPECT_EQ(CAPIOK, filter->setHeader(state, "foo", "added", HeaderAdd));
+  EXPECT_EQ(CAPIOK, filter->removeHeader(state, "baz"));
+  EXPECT_EQ("old", request_headers.get_("foo"));
+
+  apply_mutations();
+  const auto foo = request_headers.get(Http::LowerCaseString("foo"));
+  ASSERT_EQ(2, foo.size());
+  EXPECT_EQ("new", foo[0]->value().getStringView());
+  EXPECT_EQ("added", foo[1]->value().getStringView());
+  EXPECT_FALSE(request_headers.has("baz"));
+
+  // The next mutation posts a new callback.
+  EXPECT_CALL(decoder_callbacks_.dispatcher_, post(_))
+      .WillOnce(Invoke([&](Event::PostCb cb) { apply_mutations = std::move(cb); }));
+  EXPECT_EQ(CAPIOK, filter->setHeader(state, "baz", "new", HeaderSet));
+  apply_mutations();
+  EXPECT_EQ("new", request_headers.get_("baz"));
+
+  state.headers = nullptr;
+  delete req;
+  filter->onDestroy();
+}
+
 // invalid config for routeconfig filter
 TEST_F(GolangHttpFilterTest, InvalidConfigForRouteConfigFilter) {
   InSequence s;
@@ -10,12 +10,25 @@ HyperscanEngine::HyperscanEngine(Event::Dispatcher& dispatcher, ThreadLocal::Slo
 
 absl::StatusOr<Envoy::Regex::CompiledMatcherPtr>
 HyperscanEngine::matcher(const std::string& regex) const {
-  std::vector<const char*> expressions{regex.c_str()};
-  std::vector<unsigned int> flags{HS_FLAG_UTF8};
-  std::vector<unsigned int> ids{0};
+  absl::MutexLock lock(&mutex_);
+  const auto it = matchers_.find(regex);
+  MatcherSharedPtr matcher = it != matchers_.end() ? it->second.lock() : nullptr;
+  if (matcher == nullptr) {
+    std::vector<const char*> expressions{regex.c_str()};
+    std::vector<unsigned int> flags{HS_FLAG_UTF8};
+    std::vector<unsigned int> ids{0};
 
-  return std::make_unique<Matching::InputMatchers::Hyperscan::Matcher>(expressions, flags, ids,
-                                                                       dispatcher_, tls_, true);
+    matcher = std::make_shared<Matching::InputMatchers::Hyperscan::Matcher>(
+        expressions, flags, ids, dispatcher_, tls_, true);
+    matchers_.insert_or_assign(regex, matcher);
+
+    // Forget the regexes of the configs which were removed, once they are as many as the others.
+    if (matchers_.size() >= sweep_threshold_) {
+      absl::erase_if(matchers_, [](const auto& entry) { return entry.second.expired(); });
+      sweep_threshold_ = std::max(MinSweepThreshold, 2 * matchers_.size());
+    }
+  }
+  return std::make_unique<SharedMatcher>(std::move(matcher));
 }
 
 } // namespace Hyperscan
@@ -1,22 +1,58 @@
 #pragma once
 
+#include <memory>
+#include <string>
+
 #include "envoy/common/regex.h"
 
 #include "contrib/hyperscan/matching/input_matchers/source/matcher.h"
 
+#include "absl/container/flat_hash_map.h"
+#include "absl/synchronization/mutex.h"
+
 namespace Envoy {
 namespace Extensions {
 namespace Regex {
 namespace Hyperscan {
 
+using MatcherSharedPtr = std::shared_ptr<const Matching::InputMatchers::Hyperscan::Matcher>;
+using MatcherWeakPtr = std::weak_ptr<const Matching::InputMatchers::Hyperscan::Matcher>;
+
+/**
+ * A compiled regex of the engine. The matchers of identical regexes share the database compiled
+ * for the first of them, and its per worker scratch space.
+ */
+class SharedMatcher : public Envoy::Regex::CompiledMatcher {
+public:
+  explicit SharedMatcher(MatcherSharedPtr matcher) : matcher_(std::move(matcher)) {}
+
+  // Envoy::Regex::CompiledMatcher
+  bool match(absl::string_view value) const override { return matcher_->match(value); }
+  std::string replaceAll(absl::string_view value, absl::string_view substitution) const override {
+    return matcher_->replaceAll(value, substitution);
+  }
+
+  const MatcherSharedPtr& matcher() const { return matcher_; }
+
+private:
+  const MatcherSharedPtr matcher_;
+};
+
 class HyperscanEngine : public Envoy::Regex::Engine {
 public:
   explicit HyperscanEngine(Event::Dispatcher& dispatcher, ThreadLocal::SlotAllocator& tls);
   absl::StatusOr<Envoy::Regex::CompiledMatcherPtr> matcher(const std::string& regex) const override;
 
 private:
+  // The number of compiled regexes above which the ones no longer used are forgotten.
+  static constexpr size_t MinSweepThreshold = 64;
+
   Event::Dispatcher& dispatcher_;
   ThreadLocal::SlotAllocator& tls_;
+  mutable absl::Mutex mutex_;
+  // The compiled regexes still in use, by pattern.
+  mutable absl::flat_hash_map<std::string, MatcherWeakPtr> matchers_ ABSL_GUARDED_BY(mutex_);
+  mutable size_t sweep_threshold_ ABSL_GUARDED_BY(mutex_){MinSweepThreshold};
 };
 
 } // namespace Hyperscan
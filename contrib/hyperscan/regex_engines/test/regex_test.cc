@@ -33,6 +33,33 @@ TEST_F(EngineTest, Matcher) {
   EXPECT_TRUE(engine_->matcher("^/asdf/.+").status().ok());
 }
 
+// Verify that the matchers of identical regexes share their compiled database.
+TEST_F(EngineTest, SharedMatcher) {
+  setup();
+
+  auto first = engine_->matcher("^/asdf/.+");
+  auto second = engine_->matcher("^/asdf/.+");
+  auto other = engine_->matcher("^/qwer/.+");
+  ASSERT_TRUE(first.ok());
+  ASSERT_TRUE(second.ok());
+  ASSERT_TRUE(other.ok());
+  const auto& first_matcher = dynamic_cast<const SharedMatcher&>(*first.value()).matcher();
+  EXPECT_EQ(first_matcher, dynamic_cast<const SharedMatcher&>(*second.value()).matcher());
+  EXPECT_NE(first_matcher, dynamic_cast<const SharedMatcher&>(*other.value()).matcher());
+  EXPECT_TRUE(second.value()->match("/asdf/1"));
+  EXPECT_FALSE(second.value()->match("/qwer/1"));
+  EXPECT_EQ("/x", second.value()->replaceAll("/asdf/1", "/x"));
+
+  // The regex is compiled again once its matchers are all destroyed.
+  MatcherWeakPtr weak_matcher = first_matcher;
+  first.value().reset();
+  second.value().reset();
+  EXPECT_TRUE(weak_matcher.expired());
+  auto third = engine_->matcher("^/asdf/.+");
+  ASSERT_TRUE(third.ok());
+  EXPECT_TRUE(third.value()->match("/asdf/1"));
+}
+
 } // namespace Hyperscan
 } // namespace Regex
 } // namespace Extensions
@@ -20,30 +20,71 @@ RequestParseResponse RequestStartParser::parse(absl::string_view& data) {
   }
 }
 
+// Fixed-width fields at the start of request header: api key, api version and correlation id.
+constexpr size_t FIXED_WIDTH_HEADER_FIELDS_SIZE =
+    sizeof(int16_t) + sizeof(int16_t) + sizeof(int32_t);
+
+absl::optional<RequestHeader> RequestHeaderDeserializer::decodeCommonPart(absl::string_view& data) {
+  // Client id is a nullable string, prefixed with its int16 length (-1 for null).
+  if (data.size() < FIXED_WIDTH_HEADER_FIELDS_SIZE + sizeof(int16_t)) {
+    return absl::nullopt;
+  }
+  const int16_t client_id_length = readFixedWidth<int16_t>(data, FIXED_WIDTH_HEADER_FIELDS_SIZE);
+  if (client_id_length < -1) {
+    // Invalid length, the common part deserializer is going to report it.
+    return absl::nullopt;
+  }
+  const size_t client_id_offset = FIXED_WIDTH_HEADER_FIELDS_SIZE + sizeof(int16_t);
+  const size_t client_id_size = client_id_length > 0 ? client_id_length : 0;
+  if (data.size() < client_id_offset + client_id_size) {
+    return absl::nullopt;
+  }
+
+  NullableString client_id;
+  if (client_id_length >= 0) {
+    client_id = std::string(data.substr(client_id_offset, client_id_size));
+  }
+  const RequestHeader result = {readFixedWidth<int16_t>(data, 0),
+                                readFixedWidth<int16_t>(data, sizeof(int16_t)),
+                                readFixedWidth<int32_t>(data, sizeof(int16_t) + sizeof(int16_t)),
+                                client_id};
+  data.remove_prefix(client_id_offset + client_id_size);
+  return result;
+}
+
 uint32_t RequestHeaderDeserializer::feed(absl::string_view& data) {
-  uint32_t consumed = 0;
+  const size_t initial_size = data.size();
 
-  consumed += common_part_deserializer_.feed(data);
-  if (common_part_deserializer_.ready()) {
-    const auto request_header = common_part_deserializer_.get();
-    if (requestUsesTaggedFieldsInHeader(request_header.api_key_, request_header.api_version_)) {
-      tagged_fields_present_ = true;
-      consumed += tagged_fields_deserializer_.feed(data);
+  if (!common_part_) {
+    if (!common_part_deserializer_used_) {
+      common_part_ = decodeCommonPart(data);
+      common_part_deserializer_used_ = !common_part_;
     }
+    if (common_part_deserializer_used_) {
+      common_part_deserializer_.feed(data);
+      if (common_part_deserializer_.ready()) {
+        common_part_ = common_part_deserializer_.get();
+      }
+    }
+  }
+
+  if (common_part_ &&
+      requestUsesTaggedFieldsInHeader(common_part_->api_key_, common_part_->api_version_)) {
+    tagged_fields_present_ = true;
+    tagged_fields_deserializer_.feed(data);
   }
 
-  return consumed;
+  return initial_size - data.size();
 }
 
 bool RequestHeaderDeserializer::ready() const {
   // Header is only fully parsed after we have processed everything, including tagged fields (if
   // they are present).
-  return common_part_deserializer_.ready() &&
-         (tagged_fields_present_ ? tagged_fields_deserializer_.ready() : true);
+  return common_part_ && (tagged_fields_present_ ? tagged_fields_deserializer_.ready() : true);
 }
 
 RequestHeader RequestHeaderDeserializer::get() const {
-  auto result = common_part_deserializer_.get();
+  auto result = *common_part_;
   if (tagged_fields_present_) {
     result.tagged_fields_ = tagged_fields_deserializer_.get();
   }
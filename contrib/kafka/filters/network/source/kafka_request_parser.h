@@ -116,13 +116,23 @@ public:
   RequestHeader get() const override;
 
 private:
-  // Deserializer for the first 4 fields, that are present in every request header.
+  // Decodes the first 4 fields at once if all of them are present in the data, what is the usual
+  // case, as requests arrive in larger chunks. Consumes nothing otherwise, and the fields are then
+  // fed to the common part deserializer.
+  static absl::optional<RequestHeader> decodeCommonPart(absl::string_view& data);
+
+  // The first 4 fields, once they have been decoded.
+  absl::optional<RequestHeader> common_part_;
+
+  // Deserializer for the first 4 fields, that are present in every request header, used when
+  // they are not all present in the first data fed.
+  bool common_part_deserializer_used_{false};
   CommonPartDeserializer common_part_deserializer_;
 
   // Tagged fields are used only in request header v2.
   // This flag will be set depending on common part's result (api key & version), and will decide
   // whether we want to feed data to tagged fields deserializer.
-  bool tagged_fields_present_;
+  bool tagged_fields_present_{false};
   TaggedFieldsDeserializer tagged_fields_deserializer_;
 };
 
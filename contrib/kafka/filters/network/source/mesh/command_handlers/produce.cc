@@ -22,6 +22,10 @@ ProduceRequestHolder::ProduceRequestHolder(AbstractRequestListener& filter,
     : BaseInFlightRequest{filter}, kafka_facade_{kafka_facade}, request_{request} {
   outbound_records_ = record_extractor.extractRecords(request_->data_.topic_data_);
   expected_responses_ = outbound_records_.size();
+  pending_records_.reserve(outbound_records_.size());
+  for (size_t i = 0; i < outbound_records_.size(); ++i) {
+    pending_records_[outbound_records_[i].value_.data()].push_back(i);
+  }
 }
 
 void ProduceRequestHolder::startProcessing() {
@@ -47,22 +51,27 @@ bool ProduceRequestHolder::finished() const { return 0 == expected_responses_; }
 // If all the records got their delivery data filled in, we are done, and can notify the origin
 // filter.
 bool ProduceRequestHolder::accept(const DeliveryMemento& memento) {
-  for (auto& outbound_record : outbound_records_) {
-    if (outbound_record.value_.data() == memento.data_) {
-      // We have matched the downstream request that matches our confirmation from upstream Kafka.
-      outbound_record.error_code_ = memento.error_code_;
-      outbound_record.saved_offset_ = memento.offset_;
-      --expected_responses_;
-      if (finished()) {
-        // All elements had their responses matched.
-        ENVOY_LOG(trace, "All deliveries finished for produce request {}",
-                  request_->request_header_.correlation_id_);
-        notifyFilter();
-      }
-      return true;
-    }
+  const auto it = pending_records_.find(memento.data_);
+  if (it == pending_records_.end()) {
+    return false;
+  }
+  // We have matched the downstream request that matches our confirmation from upstream Kafka.
+  // Records sharing their value data (e.g. null values) get confirmed in the order they were sent.
+  OutboundRecord& outbound_record = outbound_records_[it->second.front()];
+  it->second.pop_front();
+  if (it->second.empty()) {
+    pending_records_.erase(it);
+  }
+  outbound_record.error_code_ = memento.error_code_;
+  outbound_record.saved_offset_ = memento.offset_;
+  --expected_responses_;
+  if (finished()) {
+    // All elements had their responses matched.
+    ENVOY_LOG(trace, "All deliveries finished for produce request {}",
+              request_->request_header_.correlation_id_);
+    notifyFilter();
   }
-  return false;
+  return true;
 }
 
 AbstractResponseSharedPtr ProduceRequestHolder::computeAnswer() const {
@@ -1,5 +1,8 @@
 #pragma once
 
+#include <deque>
+
+#include "absl/container/flat_hash_map.h"
 #include "contrib/kafka/filters/network/source/external/requests.h"
 #include "contrib/kafka/filters/network/source/mesh/abstract_command.h"
 #include "contrib/kafka/filters/network/source/mesh/command_handlers/produce_record_extractor.h"
@@ -86,6 +89,10 @@ private:
 
   // Real records extracted out of request.
   std::vector<OutboundRecord> outbound_records_;
+
+  // Indices of records still waiting for their delivery confirmations, by their value data (what
+  // the confirmations carry), so they can be matched without going through all the records.
+  absl::flat_hash_map<const void*, std::deque<size_t>> pending_records_;
 };
 
 } // namespace Mesh
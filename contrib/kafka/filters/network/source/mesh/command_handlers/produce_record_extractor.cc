@@ -13,9 +13,8 @@ RecordExtractorImpl::extractRecords(const std::vector<TopicProduceData>& data) c
     for (const auto& partition_data : topic_data.partition_data_) {
       // Kafka protocol allows nullable data.
       if (partition_data.records_) {
-        const auto topic_result = extractPartitionRecords(topic_data.name_, partition_data.index_,
-                                                          *(partition_data.records_));
-        std::copy(topic_result.begin(), topic_result.end(), std::back_inserter(result));
+        extractPartitionRecords(topic_data.name_, partition_data.index_,
+                                *(partition_data.records_), result);
       }
     }
   }
@@ -35,69 +34,95 @@ constexpr int8_t SUPPORTED_MAGIC = 2;
 
 // Reference implementation:
 // https://github.com/apache/kafka/blob/2.4.1/clients/src/main/java/org/apache/kafka/common/record/DefaultRecordBatch.java#L443
-std::vector<OutboundRecord> RecordExtractorImpl::extractPartitionRecords(const std::string& topic,
-                                                                         const int32_t partition,
-                                                                         const Bytes& bytes) const {
+void RecordExtractorImpl::extractPartitionRecords(const std::string& topic,
+                                                  const int32_t partition, const Bytes& bytes,
+                                                  std::vector<OutboundRecord>& result) const {
 
   absl::string_view data = {reinterpret_cast<const char*>(bytes.data()), bytes.size()};
 
-  // Let's skip these common fields, because we are not using them.
+  // Clients can send a few record batches for the same partition, one after another.
+  do {
+    processRecordBatch(topic, partition, data, result);
+  } while (!data.empty());
+}
+
+// Offsets of the record batch fields we use, the others get ignored (because we rip the batch up
+// and send its contents).
+// See:
+// https://github.com/apache/kafka/blob/2.4.1/clients/src/main/java/org/apache/kafka/common/record/DefaultRecordBatch.java#L50
+// and:
+// https://github.com/apache/kafka/blob/2.4.1/clients/src/main/java/org/apache/kafka/common/record/DefaultRecordBatch.java#L471
+constexpr unsigned int LENGTH_OFFSET = /* BaseOffset */ sizeof(int64_t);
+constexpr unsigned int RECORD_LENGTH_END = LENGTH_OFFSET + sizeof(int32_t);
+constexpr unsigned int MAGIC_OFFSET = RECORD_BATCH_COMMON_FIELDS_SIZE;
+constexpr unsigned int ATTRIBUTES_OFFSET =
+    MAGIC_OFFSET + sizeof(int8_t) + /* CRC */ sizeof(int32_t);
+constexpr unsigned int RECORD_COUNT_OFFSET =
+    ATTRIBUTES_OFFSET + sizeof(int16_t) + /* LastOffsetDelta */ sizeof(int32_t) +
+    /* FirstTimestamp */ sizeof(int64_t) + /* MaxTimestamp */ sizeof(int64_t) +
+    /* ProducerId */ sizeof(int64_t) + /* ProducerEpoch */ sizeof(int16_t) +
+    /* BaseSequence */ sizeof(int32_t);
+constexpr unsigned int RECORD_BATCH_HEADER_SIZE = RECORD_COUNT_OFFSET + sizeof(int32_t);
+
+// The lowest 3 bits of attributes carry the compression codec, compressed records can't be ripped
+// up without decompressing them.
+constexpr int16_t COMPRESSION_CODEC_MASK = 0x07;
+
+void RecordExtractorImpl::processRecordBatch(const std::string& topic, const int32_t partition,
+                                             absl::string_view& data,
+                                             std::vector<OutboundRecord>& result) const {
+
   if (data.length() < RECORD_BATCH_COMMON_FIELDS_SIZE) {
     throw EnvoyException(fmt::format("record batch for [{}-{}] is too short (no common fields): {}",
                                      topic, partition, data.length()));
   }
-  data = {data.data() + RECORD_BATCH_COMMON_FIELDS_SIZE,
-          data.length() - RECORD_BATCH_COMMON_FIELDS_SIZE};
-
-  // Extract magic - it what is the format of records present in the bytes provided.
-  Int8Deserializer magic_deserializer;
-  magic_deserializer.feed(data);
-  if (!magic_deserializer.ready()) {
+  if (data.length() < MAGIC_OFFSET + sizeof(int8_t)) {
     throw EnvoyException(
         fmt::format("magic byte is not present in record batch for [{}-{}]", topic, partition));
   }
 
   // Old client sending old magic, or Apache Kafka introducing new magic.
-  const int8_t magic = magic_deserializer.get();
+  const int8_t magic = readFixedWidth<int8_t>(data, MAGIC_OFFSET);
   if (SUPPORTED_MAGIC != magic) {
     throw EnvoyException(fmt::format("unknown magic value in record batch for [{}-{}]: {}", topic,
                                      partition, magic));
   }
 
-  // We have received a record batch with good magic.
-  return processRecordBatch(topic, partition, data);
-}
-
-// Record batch fields we are going to ignore (because we rip it up and send its contents).
-// See:
-// https://github.com/apache/kafka/blob/2.4.1/clients/src/main/java/org/apache/kafka/common/record/DefaultRecordBatch.java#L50
-// and:
-// https://github.com/apache/kafka/blob/2.4.1/clients/src/main/java/org/apache/kafka/common/record/DefaultRecordBatch.java#L471
-constexpr unsigned int IGNORED_FIELDS_SIZE =
-    /* CRC */ sizeof(int32_t) + /* Attributes */ sizeof(int16_t) +
-    /* LastOffsetDelta */ sizeof(int32_t) + /* FirstTimestamp */ sizeof(int64_t) +
-    /* MaxTimestamp */ sizeof(int64_t) + /* ProducerId */ sizeof(int64_t) +
-    /* ProducerEpoch */ sizeof(int16_t) + /* BaseSequence */ sizeof(int32_t) +
-    /* RecordCount */ sizeof(int32_t);
-
-std::vector<OutboundRecord> RecordExtractorImpl::processRecordBatch(const std::string& topic,
-                                                                    const int32_t partition,
-                                                                    absl::string_view data) const {
-
-  if (data.length() < IGNORED_FIELDS_SIZE) {
+  // All the fixed-width fields of batch header are present, so we read the ones we need at once.
+  if (data.length() < RECORD_BATCH_HEADER_SIZE) {
     throw EnvoyException(
         fmt::format("record batch for [{}-{}] is too short (no attribute fields): {}", topic,
-                    partition, data.length()));
+                    partition, data.length() - MAGIC_OFFSET - sizeof(int8_t)));
+  }
+  const int32_t length = readFixedWidth<int32_t>(data, LENGTH_OFFSET);
+  // Length covers the batch after itself.
+  if (length < static_cast<int32_t>(RECORD_BATCH_HEADER_SIZE - RECORD_LENGTH_END)) {
+    throw EnvoyException(fmt::format("record batch for [{}-{}] has invalid batch length: {}",
+                                     topic, partition, length));
   }
-  data = {data.data() + IGNORED_FIELDS_SIZE, data.length() - IGNORED_FIELDS_SIZE};
+  const int16_t compression =
+      readFixedWidth<int16_t>(data, ATTRIBUTES_OFFSET) & COMPRESSION_CODEC_MASK;
+  if (0 != compression) {
+    throw EnvoyException(fmt::format("record batch for [{}-{}] is compressed (codec {})", topic,
+                                     partition, compression));
+  }
+  const int32_t record_count = readFixedWidth<int32_t>(data, RECORD_COUNT_OFFSET);
 
-  // We have managed to consume all the fancy bytes, now it's time to get to records.
-  std::vector<OutboundRecord> result;
-  while (!data.empty()) {
-    const OutboundRecord record = extractRecord(topic, partition, data);
-    result.push_back(record);
+  // The batch ends where its length says, if the data is not truncated - if it is, the records are
+  // going to report it.
+  const size_t batch_size = std::min<size_t>(RECORD_LENGTH_END + length, data.size());
+  absl::string_view records =
+      data.substr(RECORD_BATCH_HEADER_SIZE, batch_size - RECORD_BATCH_HEADER_SIZE);
+  data.remove_prefix(batch_size);
+
+  // We have managed to get over all the fancy bytes, now it's time to get to records.
+  // Record count comes from downstream, so it's not trusted more than the bytes present.
+  if (record_count > 0) {
+    result.reserve(result.size() + std::min<size_t>(record_count, records.size()));
+  }
+  while (!records.empty()) {
+    result.push_back(extractRecord(topic, partition, records));
   }
-  return result;
 }
 
 // Reference implementation:
@@ -35,12 +35,12 @@ public:
   static absl::string_view extractByteArray(absl::string_view& input);
 
 private:
-  std::vector<OutboundRecord> extractPartitionRecords(const std::string& topic,
-                                                      const int32_t partition,
-                                                      const Bytes& records) const;
+  void extractPartitionRecords(const std::string& topic, const int32_t partition,
+                               const Bytes& records, std::vector<OutboundRecord>& result) const;
 
-  std::vector<OutboundRecord> processRecordBatch(const std::string& topic, const int32_t partition,
-                                                 absl::string_view data) const;
+  // Processes the record batch at the start of data, and steps over it.
+  void processRecordBatch(const std::string& topic, const int32_t partition,
+                          absl::string_view& data, std::vector<OutboundRecord>& result) const;
 
   OutboundRecord extractRecord(const std::string& topic, const int32_t partition,
                                absl::string_view& data) const;
@@ -84,7 +84,7 @@ void RichKafkaProducer::send(const ProduceFinishCbSharedPtr origin, const Outbou
 
     if (RdKafka::ERR_NO_ERROR == ec) {
       // We have succeeded with submitting data to producer, so we register a callback.
-      unfinished_produce_requests_.push_back(origin);
+      unfinished_produce_requests_[value_data].push_back(origin);
     } else {
       // We could not submit data to producer.
       // Let's treat that as a normal failure (Envoy is a broker after all) and propagate
@@ -106,8 +106,10 @@ void RichKafkaProducer::checkDeliveryReports() {
     // We are going to wait for 1000ms, returning when an event (message delivery) happens or
     // producer is closed. Unfortunately we do not have any ability to interrupt this call, so every
     // destructor is going to take up to this much time.
-    producer_->poll(1000);
     // This invokes the callback below, if any delivery finished (successful or not).
+    if (producer_->poll(1000) > 0) {
+      postDeliveries();
+    }
   }
   ENVOY_LOG(debug, "Poller thread finished");
 }
@@ -116,29 +118,50 @@ void RichKafkaProducer::checkDeliveryReports() {
 void RichKafkaProducer::dr_cb(RdKafka::Message& message) {
   ENVOY_LOG(trace, "Delivery finished: {}, payload has been saved at offset {} in {}/{}",
             message.err(), message.topic_name(), message.partition(), message.offset());
-  const DeliveryMemento memento = {message.payload(), message.err(), message.offset()};
+  deliveries_.push_back({message.payload(), message.err(), message.offset()});
+}
+
+void RichKafkaProducer::postDeliveries() {
+  if (deliveries_.empty()) {
+    return;
+  }
   // Because this method gets executed in poller thread, we need to pass the data through
-  // dispatcher.
-  dispatcher_.post([this, memento]() -> void { processDelivery(memento); });
+  // dispatcher. A single poll can serve many deliveries, so they are passed together instead of
+  // waking up the worker for each of them.
+  dispatcher_.post([this, deliveries = std::move(deliveries_)]() -> void {
+    for (const DeliveryMemento& memento : deliveries) {
+      processDelivery(memento);
+    }
+  });
+  deliveries_.clear();
 }
 
 // We got the delivery data.
-// Now we just check all unfinished requests, find the one that originated this particular delivery,
-// and notify it.
+// Now we just check the unfinished requests that sent this particular data, find the one that
+// originated this delivery, and notify it.
 void RichKafkaProducer::processDelivery(const DeliveryMemento& memento) {
-  for (auto it = unfinished_produce_requests_.begin(); it != unfinished_produce_requests_.end();) {
-    bool accepted = (*it)->accept(memento);
-    if (accepted) {
-      unfinished_produce_requests_.erase(it);
+  const auto requests = unfinished_produce_requests_.find(memento.data_);
+  if (requests == unfinished_produce_requests_.end()) {
+    return;
+  }
+  auto& origins = requests->second;
+  for (auto it = origins.begin(); it != origins.end(); ++it) {
+    if ((*it)->accept(memento)) {
+      origins.erase(it);
       break; // This is important - a single request can be mapped into multiple callbacks here.
-    } else {
-      ++it;
     }
   }
+  if (origins.empty()) {
+    unfinished_produce_requests_.erase(requests);
+  }
 }
 
-std::list<ProduceFinishCbSharedPtr>& RichKafkaProducer::getUnfinishedRequestsForTest() {
-  return unfinished_produce_requests_;
+size_t RichKafkaProducer::getUnfinishedRequestCountForTest() const {
+  size_t result = 0;
+  for (const auto& entry : unfinished_produce_requests_) {
+    result += entry.second.size();
+  }
+  return result;
 }
 
 } // namespace Mesh
@@ -1,9 +1,12 @@
 #pragma once
 
 #include <atomic>
+#include <list>
+#include <vector>
 
 #include "envoy/event/dispatcher.h"
 
+#include "absl/container/flat_hash_map.h"
 #include "contrib/kafka/filters/network/source/mesh/librdkafka_utils.h"
 #include "contrib/kafka/filters/network/source/mesh/upstream_kafka_client.h"
 
@@ -49,16 +52,27 @@ public:
   // RdKafka::DeliveryReportCb
   void dr_cb(RdKafka::Message& message) override;
 
+  // Passes the delivery confirmations collected by a poll to the worker thread, all at once.
+  // Executed in dedicated monitoring thread.
+  void postDeliveries();
+
   // Processes the delivery confirmation.
   // Executed in Envoy worker thread.
   void processDelivery(const DeliveryMemento& memento);
 
-  std::list<ProduceFinishCbSharedPtr>& getUnfinishedRequestsForTest();
+  size_t getUnfinishedRequestCountForTest() const;
 
 private:
   Event::Dispatcher& dispatcher_;
 
-  std::list<ProduceFinishCbSharedPtr> unfinished_produce_requests_;
+  // Requests waiting for their deliveries, by the value data of their records (what the delivery
+  // confirmations carry). A request appears once for each of its records.
+  absl::flat_hash_map<const void*, std::list<ProduceFinishCbSharedPtr>>
+      unfinished_produce_requests_;
+
+  // Delivery confirmations received during the current poll.
+  // Accessed only by monitoring thread.
+  std::vector<DeliveryMemento> deliveries_;
 
   // Real Kafka producer (thread-safe).
   // Invoked by Envoy handler thread (to produce), and internal monitoring thread
@@ -89,6 +89,17 @@ protected:
   bool ready_{false};
 };
 
+/**
+ * Reads an integer in network byte-order at the offset of the data, which the caller has checked to
+ * be long enough. This is the bulk path for runs of fixed-width fields that are known to be all
+ * present, which are then read at once instead of being fed to a deserializer each.
+ */
+template <typename T> T readFixedWidth(absl::string_view data, const size_t offset) {
+  T result;
+  safeMemcpyUnsafeSrc(&result, data.data() + offset);
+  return fromEndianness<ByteOrder::BigEndian>(result);
+}
+
 /**
  * Integer deserializer for int8_t.
  */
@@ -93,6 +93,51 @@ TEST_F(KafkaRequestParserTest, RequestHeaderParserShouldExtractHeaderAndResolveN
   assertStringViewIncrement(data, orig_data, header_len);
 }
 
+TEST_F(KafkaRequestParserTest, RequestHeaderDeserializerShouldDecodeTheSameInOneGoAndByteByByte) {
+  for (const NullableString& client_id : {NullableString{"aaa"}, NullableString{""},
+                                          NullableString{absl::nullopt}}) {
+    // given
+    Bytes bytes;
+    const auto put = [&bytes](const uint64_t value, const size_t size) {
+      for (size_t i = size; i > 0; --i) {
+        bytes.push_back(static_cast<uint8_t>(value >> (8 * (i - 1))));
+      }
+    };
+    // Metadata v9 uses tagged fields in request header.
+    put(3, sizeof(int16_t));    // api_key
+    put(9, sizeof(int16_t));    // api_version
+    put(1234, sizeof(int32_t)); // correlation_id
+    put(client_id ? client_id->size() : 0xffff, sizeof(int16_t));
+    if (client_id) {
+      bytes.insert(bytes.end(), client_id->begin(), client_id->end());
+    }
+    bytes.push_back(0); // Tagged fields count.
+    const RequestHeader expected = {3, 9, 1234, client_id};
+
+    // when - whole header is present.
+    RequestHeaderDeserializer in_one_go;
+    absl::string_view data = {reinterpret_cast<const char*>(bytes.data()), bytes.size()};
+    EXPECT_EQ(in_one_go.feed(data), bytes.size());
+
+    // then
+    ASSERT_TRUE(in_one_go.ready());
+    EXPECT_EQ(in_one_go.get(), expected);
+    EXPECT_TRUE(data.empty());
+
+    // when - header arrives one byte at a time.
+    RequestHeaderDeserializer byte_by_byte;
+    for (size_t i = 0; i < bytes.size(); ++i) {
+      EXPECT_FALSE(byte_by_byte.ready());
+      absl::string_view byte = {reinterpret_cast<const char*>(bytes.data()) + i, 1};
+      EXPECT_EQ(byte_by_byte.feed(byte), 1);
+    }
+
+    // then
+    ASSERT_TRUE(byte_by_byte.ready());
+    EXPECT_EQ(byte_by_byte.get(), expected);
+  }
+}
+
 TEST_F(KafkaRequestParserTest, RequestDataParserShouldHandleDeserializerExceptionsDuringFeeding) {
   // given
 
@@ -41,9 +41,12 @@ MATCHER_P3(HasRecords, topic, partition, expected, "") {
 // Helper function to create a record batch that contains a single record with 5-byte key and 5-byte
 // value.
 Bytes makeGoodRecordBatch() {
-  // Record batch bytes get ignored (apart from magic field), so we can put 0 there.
+  // Record batch bytes get ignored (apart from length, magic, attributes and record count fields),
+  // so we can put 0 there.
   Bytes result = Bytes(16 + 1 + 44);
-  result[16] = 2; // Record batch magic value.
+  result[11] = 61 - 12 + 37; // Record batch length, without base offset and length itself.
+  result[16] = 2;            // Record batch magic value.
+  result[60] = 1;            // Record count.
   Bytes real_data = {/* Length = 36 */ 72,
                      /* Attributes */ 0,
                      /* Timestamp delta */ 0,
@@ -110,6 +113,24 @@ TEST(RecordExtractorImpl, shouldProcessRecordBytes) {
   EXPECT_THAT(result, HasRecords("topic2", 20, 0));
 }
 
+TEST(RecordExtractorImpl, shouldProcessConsecutiveRecordBatches) {
+  // given
+  const RecordExtractorImpl testee;
+
+  Bytes bytes = makeGoodRecordBatch();
+  const Bytes batch = makeGoodRecordBatch();
+  bytes.insert(bytes.end(), batch.begin(), batch.end());
+  bytes.insert(bytes.end(), batch.begin(), batch.end());
+  const PartitionProduceData ppd = {0, bytes};
+  const std::vector<TopicProduceData> input = {{"topic", {ppd}}};
+
+  // when
+  const auto result = testee.extractRecords(input);
+
+  // then
+  EXPECT_THAT(result, HasRecords("topic", 0, 3));
+}
+
 /**
  * Helper function to make record batch (batch contains 1+ records).
  * We use 'stage' parameter to make it a single function with various failure modes.
@@ -164,6 +185,14 @@ const std::vector<TopicProduceData> makeTopicProduceData(const unsigned int stag
     // Last header value is going to be shorter, so there will be one unconsumed byte.
     bytes[92] = 8;
   }
+  if (12 == stage) {
+    // Record batch length is shorter than the batch header.
+    bytes[11] = 12;
+  }
+  if (13 == stage) {
+    // Records are compressed with gzip.
+    bytes[22] = 1;
+  }
   const PartitionProduceData ppd = {0, bytes};
   const TopicProduceData tpd = {"topic", {ppd}};
   return {tpd};
@@ -193,6 +222,10 @@ TEST(RecordExtractorImpl, shouldHandleInvalidRecordBytes) {
                           "invalid header count");
   EXPECT_THROW_WITH_REGEX(testee.extractRecords(makeTopicProduceData(11)), EnvoyException,
                           "data left after consuming record");
+  EXPECT_THROW_WITH_REGEX(testee.extractRecords(makeTopicProduceData(12)), EnvoyException,
+                          "invalid batch length");
+  EXPECT_THROW_WITH_REGEX(testee.extractRecords(makeTopicProduceData(13)), EnvoyException,
+                          "is compressed");
 }
 
 // Minor helper function.
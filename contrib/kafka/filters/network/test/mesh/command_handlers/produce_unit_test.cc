@@ -185,6 +185,33 @@ TEST_F(ProduceUnitTest, ShouldMergeOutboundRecordResponses) {
   EXPECT_EQ(responses[0].partition_responses_[0].base_offset_, 1313);
 }
 
+// Records sharing their value data (here: both values are null) get their deliveries confirmed one
+// at a time.
+TEST_F(ProduceUnitTest, ShouldMatchDeliveriesOfRecordsSharingValue) {
+  // given
+  const OutboundRecord r1 = {"t1", 13, "aaa", {}, {}};
+  const OutboundRecord r2 = {r1.topic_, r1.partition_, "bbb", {}, {}};
+  const std::vector<OutboundRecord> records = {r1, r2};
+  EXPECT_CALL(extractor_, extractRecords(_)).WillOnce(Return(records));
+
+  const RequestHeader header = {0, 0, 0, absl::nullopt};
+  const ProduceRequest data = {0, 0, {}};
+  const auto message = std::make_shared<Request<ProduceRequest>>(header, data);
+  std::shared_ptr<ProduceRequestHolder> testee =
+      std::make_shared<ProduceRequestHolder>(filter_, upstream_kafka_facade_, extractor_, message);
+
+  // when, then - each memento confirms a single record.
+  const DeliveryMemento dm = {nullptr, 0, 4242};
+  EXPECT_TRUE(testee->accept(dm));
+  EXPECT_FALSE(testee->finished());
+  EXPECT_CALL(filter_, onRequestReadyForAnswer());
+  EXPECT_TRUE(testee->accept(dm));
+  EXPECT_TRUE(testee->finished());
+
+  // when, then - there is nothing left to confirm.
+  EXPECT_FALSE(testee->accept(dm));
+}
+
 // Flow with errors.
 // The produce request has 2 records, both pointing to same partition.
 // The first record is going to fail.
@@ -78,7 +78,7 @@ TEST_F(UpstreamKafkaClientTest, ShouldSendRecordsAndReceiveConfirmations) {
   for (const auto& arg : payloads) {
     testee.send(origin_, makeRecord(arg));
   }
-  EXPECT_EQ(testee.getUnfinishedRequestsForTest().size(), payloads.size());
+  EXPECT_EQ(testee.getUnfinishedRequestCountForTest(), payloads.size());
 
   // when, then - should process confirmations.
   EXPECT_CALL(*origin_, accept(_)).Times(3).WillRepeatedly(Return(true));
@@ -86,7 +86,7 @@ TEST_F(UpstreamKafkaClientTest, ShouldSendRecordsAndReceiveConfirmations) {
     const DeliveryMemento memento = {arg.c_str(), RdKafka::ERR_NO_ERROR, 0};
     testee.processDelivery(memento);
   }
-  EXPECT_EQ(testee.getUnfinishedRequestsForTest().size(), 0);
+  EXPECT_EQ(testee.getUnfinishedRequestCountForTest(), 0);
 }
 
 TEST_F(UpstreamKafkaClientTest, ShouldCheckCallbacksForDeliveries) {
@@ -103,17 +103,18 @@ TEST_F(UpstreamKafkaClientTest, ShouldCheckCallbacksForDeliveries) {
   auto origin2 = std::make_shared<MockProduceFinishCb>();
   testee.send(origin1, makeRecord(payloads[0]));
   testee.send(origin2, makeRecord(payloads[1]));
-  EXPECT_EQ(testee.getUnfinishedRequestsForTest().size(), payloads.size());
+  EXPECT_EQ(testee.getUnfinishedRequestCountForTest(), payloads.size());
 
-  // when, then - should process confirmations (notice we pass second memento first).
-  EXPECT_CALL(*origin1, accept(_)).WillOnce(Return(false)).WillOnce(Return(true));
+  // when, then - should process confirmations (notice we pass second memento first), only the
+  // request that sent the data gets asked.
+  EXPECT_CALL(*origin1, accept(_)).WillOnce(Return(true));
   EXPECT_CALL(*origin2, accept(_)).WillOnce(Return(true));
   const DeliveryMemento memento1 = {payloads[1].c_str(), RdKafka::ERR_NO_ERROR, 0};
   testee.processDelivery(memento1);
-  EXPECT_EQ(testee.getUnfinishedRequestsForTest().size(), 1);
+  EXPECT_EQ(testee.getUnfinishedRequestCountForTest(), 1);
   const DeliveryMemento memento2 = {payloads[0].c_str(), RdKafka::ERR_NO_ERROR, 0};
   testee.processDelivery(memento2);
-  EXPECT_EQ(testee.getUnfinishedRequestsForTest().size(), 0);
+  EXPECT_EQ(testee.getUnfinishedRequestCountForTest(), 0);
 }
 
 TEST_F(UpstreamKafkaClientTest, ShouldHandleProduceFailures) {
@@ -127,7 +128,7 @@ TEST_F(UpstreamKafkaClientTest, ShouldHandleProduceFailures) {
   EXPECT_CALL(kafka_utils_, deleteHeaders(_));
   EXPECT_CALL(*origin_, accept(_)).WillOnce(Return(true));
   testee.send(origin_, makeRecord("value"));
-  EXPECT_EQ(testee.getUnfinishedRequestsForTest().size(), 0);
+  EXPECT_EQ(testee.getUnfinishedRequestCountForTest(), 0);
 }
 
 TEST_F(UpstreamKafkaClientTest, ShouldHandleKafkaCallback) {
@@ -136,9 +137,47 @@ TEST_F(UpstreamKafkaClientTest, ShouldHandleKafkaCallback) {
   RichKafkaProducer testee = {dispatcher_, thread_factory_, config_, kafka_utils_};
   NiceMock<MockKafkaMessage> message;
 
-  // when, then - notification is passed to dispatcher.
-  EXPECT_CALL(dispatcher_, post(_));
+  // when, then - notifications collected during a poll are passed to dispatcher together.
+  EXPECT_CALL(dispatcher_, post(_)).Times(0);
+  testee.dr_cb(message);
   testee.dr_cb(message);
+  testing::Mock::VerifyAndClearExpectations(&dispatcher_);
+  EXPECT_CALL(dispatcher_, post(_));
+  testee.postDeliveries();
+
+  // when, then - nothing gets passed if nothing got delivered.
+  testee.postDeliveries();
+}
+
+TEST_F(UpstreamKafkaClientTest, ShouldProcessPostedDeliveries) {
+  // given
+  setupConstructorExpectations();
+  RichKafkaProducer testee = {dispatcher_, thread_factory_, config_, kafka_utils_};
+  EXPECT_CALL(producer_, produce("topic", 13, _, _, _, _, _, _, _, _))
+      .Times(2)
+      .WillRepeatedly(Return(RdKafka::ERR_NO_ERROR));
+  const std::vector<std::string> payloads = {"value1", "value2"};
+  for (const auto& arg : payloads) {
+    testee.send(origin_, makeRecord(arg));
+  }
+
+  // when
+  NiceMock<MockKafkaMessage> message1;
+  ON_CALL(message1, payload()).WillByDefault(Return(const_cast<char*>(payloads[0].c_str())));
+  NiceMock<MockKafkaMessage> message2;
+  ON_CALL(message2, payload()).WillByDefault(Return(const_cast<char*>(payloads[1].c_str())));
+  testee.dr_cb(message1);
+  testee.dr_cb(message2);
+  Event::PostCb callback;
+  EXPECT_CALL(dispatcher_, post(_)).WillOnce([&callback](Event::PostCb cb) {
+    callback = std::move(cb);
+  });
+  testee.postDeliveries();
+
+  // then - all the deliveries get processed in worker thread.
+  EXPECT_CALL(*origin_, accept(_)).Times(2).WillRepeatedly(Return(true));
+  callback();
+  EXPECT_EQ(testee.getUnfinishedRequestCountForTest(), 0);
 }
 
 TEST_F(UpstreamKafkaClientTest, ShouldHandleHeaderConversionFailures) {
@@ -152,7 +191,7 @@ TEST_F(UpstreamKafkaClientTest, ShouldHandleHeaderConversionFailures) {
   EXPECT_CALL(producer_, produce(_, _, _, _, _, _, _, _, _, _)).Times(0);
   EXPECT_CALL(*origin_, accept(_)).WillOnce(Return(true));
   testee.send(origin_, makeRecord("value"));
-  EXPECT_EQ(testee.getUnfinishedRequestsForTest().size(), 0);
+  EXPECT_EQ(testee.getUnfinishedRequestCountForTest(), 0);
 }
 
 // This handles situations when users pass bad config to raw producer.
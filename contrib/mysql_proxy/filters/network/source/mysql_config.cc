@@ -28,8 +28,14 @@ NetworkFilters::MySQLProxy::MySQLConfigFactory::createFilterFactoryFromProtoType
 
   const std::string stat_prefix = fmt::format("mysql.{}", proto_config.stat_prefix());
 
-  MySQLFilterConfigSharedPtr filter_config(
-      std::make_shared<MySQLFilterConfig>(stat_prefix, context.scope()));
+  absl::optional<envoy::type::v3::FractionalPercent> decoding_sample;
+  if (proto_config.has_decoding_sample()) {
+    decoding_sample = proto_config.decoding_sample();
+  }
+
+  MySQLFilterConfigSharedPtr filter_config(std::make_shared<MySQLFilterConfig>(
+      stat_prefix, context.scope(), decoding_sample,
+      context.serverFactoryContext().api().randomGenerator()));
   return [filter_config](Network::FilterManager& filter_manager) -> void {
     filter_manager.addFilter(std::make_shared<MySQLFilter>(filter_config));
   };
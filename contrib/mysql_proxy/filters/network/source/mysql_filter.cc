@@ -5,6 +5,7 @@
 #include "source/common/buffer/buffer_impl.h"
 #include "source/common/common/assert.h"
 #include "source/common/common/logger.h"
+#include "source/common/protobuf/utility.h"
 #include "source/extensions/filters/network/well_known_names.h"
 
 #include "contrib/mysql_proxy/filters/network/source/mysql_codec.h"
@@ -16,10 +17,21 @@ namespace Extensions {
 namespace NetworkFilters {
 namespace MySQLProxy {
 
-MySQLFilterConfig::MySQLFilterConfig(const std::string& stat_prefix, Stats::Scope& scope)
-    : scope_(scope), stats_(generateStats(stat_prefix, scope)) {}
+MySQLFilterConfig::MySQLFilterConfig(
+    const std::string& stat_prefix, Stats::Scope& scope,
+    const absl::optional<envoy::type::v3::FractionalPercent>& decoding_sample,
+    Random::RandomGenerator& random)
+    : scope_(scope), stats_(generateStats(stat_prefix, scope)), decoding_sample_(decoding_sample),
+      random_(random) {}
+
+bool MySQLFilterConfig::sampleSession() {
+  return !decoding_sample_.has_value() ||
+         ProtobufPercentHelper::evaluateFractionalPercent(decoding_sample_.value(),
+                                                          random_.random());
+}
 
-MySQLFilter::MySQLFilter(MySQLFilterConfigSharedPtr config) : config_(std::move(config)) {}
+MySQLFilter::MySQLFilter(MySQLFilterConfigSharedPtr config)
+    : config_(std::move(config)), decode_commands_(config_->sampleSession()) {}
 
 void MySQLFilter::initializeReadFilterCallbacks(Network::ReadFilterCallbacks& callbacks) {
   read_callbacks_ = &callbacks;
@@ -65,6 +77,27 @@ void MySQLFilter::doDecode(Buffer::Instance& buffer) {
     sniffing_ = false;
     read_buffer_.drain(read_buffer_.length());
     write_buffer_.drain(write_buffer_.length());
+    return;
+  }
+
+  if (passThrough()) {
+    ENVOY_LOG(trace, "mysql_proxy: passing the rest of the session through");
+    sniffing_ = false;
+    read_buffer_.drain(read_buffer_.length());
+    write_buffer_.drain(write_buffer_.length());
+  }
+}
+
+bool MySQLFilter::passThrough() {
+  switch (decoder_->getSession().getState()) {
+  case MySQLSession::State::SslPt:
+    return true;
+  case MySQLSession::State::Req:
+  case MySQLSession::State::Resync:
+    // The client is logged in, and only its commands follow.
+    return !decode_commands_;
+  default:
+    return false;
   }
 }
 
@@ -1,11 +1,13 @@
 #pragma once
 
 #include "envoy/access_log/access_log.h"
+#include "envoy/common/random_generator.h"
 #include "envoy/network/connection.h"
 #include "envoy/network/filter.h"
 #include "envoy/stats/scope.h"
 #include "envoy/stats/stats.h"
 #include "envoy/stats/stats_macros.h"
+#include "envoy/type/v3/percent.pb.h"
 
 #include "source/common/common/logger.h"
 
@@ -49,10 +51,15 @@ struct MySQLProxyStats {
  */
 class MySQLFilterConfig {
 public:
-  MySQLFilterConfig(const std::string& stat_prefix, Stats::Scope& scope);
+  MySQLFilterConfig(const std::string& stat_prefix, Stats::Scope& scope,
+                    const absl::optional<envoy::type::v3::FractionalPercent>& decoding_sample,
+                    Random::RandomGenerator& random);
 
   const MySQLProxyStats& stats() { return stats_; }
 
+  // Returns true if the commands of a new session are decoded.
+  bool sampleSession();
+
   Stats::Scope& scope_;
   MySQLProxyStats stats_;
 
@@ -60,6 +67,9 @@ private:
   MySQLProxyStats generateStats(const std::string& prefix, Stats::Scope& scope) {
     return MySQLProxyStats{ALL_MYSQL_PROXY_STATS(POOL_COUNTER_PREFIX(scope, prefix))};
   }
+
+  const absl::optional<envoy::type::v3::FractionalPercent> decoding_sample_;
+  Random::RandomGenerator& random_;
 };
 
 using MySQLFilterConfigSharedPtr = std::shared_ptr<MySQLFilterConfig>;
@@ -96,11 +106,16 @@ public:
   MySQLSession& getSession() { return decoder_->getSession(); }
 
 private:
+  // Returns true if the rest of the session is passed through without being decoded, because it
+  // is encrypted or because its commands are not decoded.
+  bool passThrough();
+
   Network::ReadFilterCallbacks* read_callbacks_{};
   MySQLFilterConfigSharedPtr config_;
   Buffer::OwnedImpl read_buffer_;
   Buffer::OwnedImpl write_buffer_;
   std::unique_ptr<Decoder> decoder_;
+  const bool decode_commands_;
   bool sniffing_{true};
 };
 
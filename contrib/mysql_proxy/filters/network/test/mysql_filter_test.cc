@@ -1,5 +1,6 @@
 #include "source/common/buffer/buffer_impl.h"
 
+#include "test/mocks/common.h"
 #include "test/mocks/network/mocks.h"
 
 #include "contrib/mysql_proxy/filters/network/source/mysql_codec.h"
@@ -22,8 +23,8 @@ class MySQLFilterTest : public testing::Test, public MySQLTestUtils {
 public:
   MySQLFilterTest() { ENVOY_LOG_MISC(info, "test"); }
 
-  void initialize() {
-    config_ = std::make_shared<MySQLFilterConfig>(stat_prefix_, scope_);
+  void initialize(absl::optional<envoy::type::v3::FractionalPercent> decoding_sample = {}) {
+    config_ = std::make_shared<MySQLFilterConfig>(stat_prefix_, scope_, decoding_sample, random_);
     filter_ = std::make_unique<MySQLFilter>(config_);
     filter_->initializeReadFilterCallbacks(filter_callbacks_);
   }
@@ -33,6 +34,7 @@ public:
   Stats::IsolatedStoreImpl store_;
   Stats::Scope& scope_{*store_.rootScope()};
   std::string stat_prefix_{"test."};
+  NiceMock<Random::MockRandomGenerator> random_;
   NiceMock<Network::MockReadFilterCallbacks> filter_callbacks_;
 };
 
@@ -1068,6 +1070,43 @@ TEST_F(MySQLFilterTest, MySqlLoginAndQueryTest) {
   EXPECT_EQ(MySQLSession::State::ReqResp, filter_->getSession().getState());
 }
 
+/**
+ * Test that the commands of a session which is not sampled are passed through without being
+ * decoded once the client is logged in.
+ */
+TEST_F(MySQLFilterTest, MySqlSessionNotSampledTest) {
+  envoy::type::v3::FractionalPercent decoding_sample;
+  decoding_sample.set_numerator(0);
+  initialize(decoding_sample);
+
+  EXPECT_EQ(Envoy::Network::FilterStatus::Continue, filter_->onNewConnection());
+
+  std::string greeting_data = encodeServerGreeting(MYSQL_PROTOCOL_10);
+  Buffer::InstancePtr greet_data(new Buffer::OwnedImpl(greeting_data));
+  EXPECT_EQ(Envoy::Network::FilterStatus::Continue, filter_->onData(*greet_data, false));
+
+  std::string clogin_data = encodeClientLogin(CLIENT_PROTOCOL_41, "user1", CHALLENGE_SEQ_NUM);
+  Buffer::InstancePtr client_login_data(new Buffer::OwnedImpl(clogin_data));
+  EXPECT_EQ(Envoy::Network::FilterStatus::Continue, filter_->onData(*client_login_data, false));
+  EXPECT_EQ(1UL, config_->stats().login_attempts_.value());
+
+  std::string srv_resp_data = encodeClientLoginResp(MYSQL_RESP_OK);
+  Buffer::InstancePtr server_resp_data(new Buffer::OwnedImpl(srv_resp_data));
+  EXPECT_EQ(Envoy::Network::FilterStatus::Continue, filter_->onData(*server_resp_data, false));
+  EXPECT_EQ(MySQLSession::State::Req, filter_->getSession().getState());
+
+  Command mysql_cmd_encode{};
+  mysql_cmd_encode.setCmd(Command::Cmd::Query);
+  mysql_cmd_encode.setData("CREATE DATABASE mysqldb");
+  Buffer::OwnedImpl client_query_data;
+  mysql_cmd_encode.encode(client_query_data);
+  BufferHelper::encodeHdr(client_query_data, 0);
+  EXPECT_EQ(Envoy::Network::FilterStatus::Continue, filter_->onData(client_query_data, false));
+  EXPECT_EQ(MySQLSession::State::Req, filter_->getSession().getState());
+  EXPECT_EQ(0UL, config_->stats().queries_parsed_.value());
+  EXPECT_EQ(0UL, config_->stats().decoder_errors_.value());
+}
+
 } // namespace MySQLProxy
 } // namespace NetworkFilters
 } // namespace Extensions
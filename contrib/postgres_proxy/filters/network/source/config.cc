@@ -20,9 +20,13 @@ NetworkFilters::PostgresProxy::PostgresConfigFactory::createFilterFactoryFromPro
       PROTOBUF_GET_WRAPPED_OR_DEFAULT(proto_config, enable_sql_parsing, true);
   config_options.terminate_ssl_ = proto_config.terminate_ssl();
   config_options.upstream_ssl_ = proto_config.upstream_ssl();
+  if (proto_config.has_decoding_sample()) {
+    config_options.decoding_sample_ = proto_config.decoding_sample();
+  }
 
-  PostgresFilterConfigSharedPtr filter_config(
-      std::make_shared<PostgresFilterConfig>(config_options, context.scope()));
+  PostgresFilterConfigSharedPtr filter_config(std::make_shared<PostgresFilterConfig>(
+      config_options, context.scope(),
+      context.serverFactoryContext().api().randomGenerator()));
   return [filter_config](Network::FilterManager& filter_manager) -> void {
     filter_manager.addFilter(std::make_shared<PostgresFilter>(filter_config));
   };
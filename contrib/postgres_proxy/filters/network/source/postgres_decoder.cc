@@ -1,5 +1,6 @@
 #include "contrib/postgres_proxy/filters/network/source/postgres_decoder.h"
 
+#include <algorithm>
 #include <vector>
 
 #include "absl/strings/str_split.h"
@@ -390,6 +391,63 @@ Decoder::Result DecoderImpl::onDataInSync(Buffer::Instance& data, bool frontend)
 
   return Decoder::Result::ReadyForNext;
 }
+/*
+  onHeaders is called in place of onDataInSync on the sessions whose messages are not decoded.
+  It reads the 1 byte message type and the 4 bytes of message length of each message, which
+  may be split over the data of several calls, and skips the message bodies in place.
+*/
+void DecoderImpl::onHeaders(const Buffer::Instance& data, bool frontend) {
+  ASSERT(state_ == State::InSyncState);
+
+  MessageHeader& header = frontend ? FE_header_ : BE_header_;
+  MsgGroup& msg_processor = frontend ? FE_messages_ : BE_messages_;
+  for (const Buffer::RawSlice& slice : data.getRawSlices()) {
+    const char* bytes = static_cast<const char*>(slice.mem_);
+    uint64_t offset = 0;
+    while (offset < slice.len_) {
+      if (header.body_left_ > 0) {
+        const uint64_t skipped = std::min(header.body_left_, slice.len_ - offset);
+        header.body_left_ -= skipped;
+        offset += skipped;
+        continue;
+      }
+
+      const uint64_t copied =
+          std::min<uint64_t>(sizeof(header.bytes_) - header.size_, slice.len_ - offset);
+      memcpy(header.bytes_ + header.size_, bytes + offset, copied);
+      header.size_ += copied;
+      offset += copied;
+      if (header.size_ < sizeof(header.bytes_)) {
+        break;
+      }
+      onHeader(header, msg_processor, frontend);
+      if (state_ != State::InSyncState) {
+        return;
+      }
+    }
+  }
+}
+
+void DecoderImpl::onHeader(MessageHeader& header, MsgGroup& msg_processor, bool frontend) {
+  header.size_ = 0;
+  command_ = header.bytes_[0];
+  message_len_ = absl::big_endian::Load32(header.bytes_ + 1);
+  // The message length includes the length field itself.
+  if (message_len_ < 4) {
+    // Message does not conform to the expected format. Move to out-of-sync state.
+    state_ = State::OutOfSyncState;
+    return;
+  }
+
+  frontend ? callbacks_->incMessagesFrontend() : callbacks_->incMessagesBackend();
+  if (!msg_processor.messages_.contains(command_)) {
+    incMessagesUnknown();
+  }
+  header.body_left_ = message_len_ - 4;
+  ENVOY_LOG(trace, "postgres_proxy: ({}) skipping message {}, length {}",
+            msg_processor.direction_, command_, message_len_);
+}
+
 /*
   onDataIgnore method is called when the decoder does not inspect passing
   messages. This happens when the decoder detected encrypted packets or
@@ -64,6 +64,16 @@ public:
             // call starttls transport socket to enable TLS.
   };
   virtual Result onData(Buffer::Instance& data, bool frontend) PURE;
+  // Counts the messages in the data from their type and length only, without decoding or
+  // draining the data. The body of a message cut at the end of the data is skipped in the data
+  // that follows. This may only be called when the decoder is in sync and all the data passed to
+  // onData() in the same direction was consumed.
+  virtual void onHeaders(const Buffer::Instance& data, bool frontend) PURE;
+  // Returns true if the decoder follows the message boundaries, past the startup messages.
+  virtual bool inSync() const PURE;
+  // Returns true if the decoder ignores all the data that follows, because the session is
+  // encrypted or its message boundaries were lost.
+  virtual bool ignoresData() const PURE;
   virtual PostgresSession& getSession() PURE;
 
   const Extensions::Common::SQLUtils::SQLUtils::DecoderAttributes& getAttributes() const {
@@ -83,6 +93,11 @@ public:
   DecoderImpl(DecoderCallbacks* callbacks) : callbacks_(callbacks) { initialize(); }
 
   Result onData(Buffer::Instance& data, bool frontend) override;
+  void onHeaders(const Buffer::Instance& data, bool frontend) override;
+  bool inSync() const override { return state_ == State::InSyncState; }
+  bool ignoresData() const override {
+    return state_ == State::OutOfSyncState || state_ == State::EncryptedState;
+  }
   PostgresSession& getSession() override { return session_; }
 
   std::string getMessage() { return message_; }
@@ -163,6 +178,15 @@ protected:
   void onParse();
   void onStartup();
 
+  // The message header read by onHeaders() in one direction, and the bytes of the message body
+  // still to be skipped.
+  struct MessageHeader {
+    char bytes_[5];
+    uint32_t size_{};
+    uint64_t body_left_{};
+  };
+  void onHeader(MessageHeader& header, MsgGroup& msg_processor, bool frontend);
+
   void incMessagesUnknown() { callbacks_->incMessagesUnknown(); }
   void incSessionsEncrypted() { callbacks_->incSessionsEncrypted(); }
   void incSessionsUnencrypted() { callbacks_->incSessionsUnencrypted(); }
@@ -198,6 +222,9 @@ protected:
   MsgParserDict BE_errors_;
   MsgParserDict BE_notices_;
 
+  MessageHeader FE_header_;
+  MessageHeader BE_header_;
+
   // Buffer used to temporarily store a downstream postgres packet
   // while sending other packets. Currently used only when negotiating
   // upstream SSL.
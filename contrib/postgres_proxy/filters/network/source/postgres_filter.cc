@@ -4,6 +4,7 @@
 #include "envoy/network/connection.h"
 
 #include "source/common/common/assert.h"
+#include "source/common/protobuf/utility.h"
 #include "source/extensions/filters/network/well_known_names.h"
 
 #include "contrib/postgres_proxy/filters/network/source/postgres_decoder.h"
@@ -14,12 +15,20 @@ namespace NetworkFilters {
 namespace PostgresProxy {
 
 PostgresFilterConfig::PostgresFilterConfig(const PostgresFilterConfigOptions& config_options,
-                                           Stats::Scope& scope)
+                                           Stats::Scope& scope, Random::RandomGenerator& random)
     : enable_sql_parsing_(config_options.enable_sql_parsing_),
       terminate_ssl_(config_options.terminate_ssl_), upstream_ssl_(config_options.upstream_ssl_),
-      scope_{scope}, stats_{generateStats(config_options.stats_prefix_, scope)} {}
+      decoding_sample_(config_options.decoding_sample_), scope_{scope},
+      stats_{generateStats(config_options.stats_prefix_, scope)}, random_(random) {}
 
-PostgresFilter::PostgresFilter(PostgresFilterConfigSharedPtr config) : config_{config} {
+bool PostgresFilterConfig::sampleSession() {
+  return !decoding_sample_.has_value() ||
+         ProtobufPercentHelper::evaluateFractionalPercent(decoding_sample_.value(),
+                                                          random_.random());
+}
+
+PostgresFilter::PostgresFilter(PostgresFilterConfigSharedPtr config)
+    : config_{config}, decode_messages_(config_->sampleSession()) {
   if (!decoder_) {
     decoder_ = createDecoder(this);
   }
@@ -30,6 +39,10 @@ Network::FilterStatus PostgresFilter::onData(Buffer::Instance& data, bool) {
   ENVOY_CONN_LOG(trace, "postgres_proxy: got {} bytes", read_callbacks_->connection(),
                  data.length());
 
+  if (passThrough(frontend_buffer_, data, true)) {
+    return Network::FilterStatus::Continue;
+  }
+
   // Frontend Buffer
   frontend_buffer_.add(data);
   Network::FilterStatus result = doDecode(frontend_buffer_, true);
@@ -52,6 +65,9 @@ void PostgresFilter::initializeWriteFilterCallbacks(Network::WriteFilterCallback
 
 // Network::WriteFilter
 Network::FilterStatus PostgresFilter::onWrite(Buffer::Instance& data, bool) {
+  if (passThrough(backend_buffer_, data, false)) {
+    return Network::FilterStatus::Continue;
+  }
 
   // Backend Buffer
   backend_buffer_.add(data);
@@ -63,6 +79,22 @@ Network::FilterStatus PostgresFilter::onWrite(Buffer::Instance& data, bool) {
   return result;
 }
 
+bool PostgresFilter::passThrough(const Buffer::Instance& buffer, const Buffer::Instance& data,
+                                 bool frontend) {
+  // The data buffered before must be decoded first.
+  if (buffer.length() != 0) {
+    return false;
+  }
+  if (decoder_->ignoresData()) {
+    return true;
+  }
+  if (!decode_messages_ && decoder_->inSync()) {
+    decoder_->onHeaders(data, frontend);
+    return true;
+  }
+  return false;
+}
+
 DecoderPtr PostgresFilter::createDecoder(DecoderCallbacks* callbacks) {
   return std::make_unique<DecoderImpl>(callbacks);
 }
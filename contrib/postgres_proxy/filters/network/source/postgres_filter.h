@@ -1,9 +1,11 @@
 #pragma once
 
+#include "envoy/common/random_generator.h"
 #include "envoy/network/filter.h"
 #include "envoy/stats/scope.h"
 #include "envoy/stats/stats.h"
 #include "envoy/stats/stats_macros.h"
+#include "envoy/type/v3/percent.pb.h"
 
 #include "source/common/buffer/buffer_impl.h"
 #include "source/common/common/logger.h"
@@ -72,14 +74,20 @@ public:
     bool terminate_ssl_;
     envoy::extensions::filters::network::postgres_proxy::v3alpha::PostgresProxy::SSLMode
         upstream_ssl_;
+    absl::optional<envoy::type::v3::FractionalPercent> decoding_sample_;
   };
-  PostgresFilterConfig(const PostgresFilterConfigOptions& config_options, Stats::Scope& scope);
+  PostgresFilterConfig(const PostgresFilterConfigOptions& config_options, Stats::Scope& scope,
+                       Random::RandomGenerator& random);
+
+  // Returns true if the messages of a new session are decoded.
+  bool sampleSession();
 
   bool enable_sql_parsing_{true};
   bool terminate_ssl_{false};
   envoy::extensions::filters::network::postgres_proxy::v3alpha::PostgresProxy::SSLMode
       upstream_ssl_{
           envoy::extensions::filters::network::postgres_proxy::v3alpha::PostgresProxy::DISABLE};
+  const absl::optional<envoy::type::v3::FractionalPercent> decoding_sample_;
   Stats::Scope& scope_;
   PostgresProxyStats stats_;
 
@@ -87,6 +95,8 @@ private:
   PostgresProxyStats generateStats(const std::string& prefix, Stats::Scope& scope) {
     return PostgresProxyStats{ALL_POSTGRES_PROXY_STATS(POOL_COUNTER_PREFIX(scope, prefix))};
   }
+
+  Random::RandomGenerator& random_;
 };
 
 using PostgresFilterConfigSharedPtr = std::shared_ptr<PostgresFilterConfig>;
@@ -138,12 +148,17 @@ public:
   const PostgresFilterConfigSharedPtr& getConfig() const { return config_; }
 
 private:
+  // Returns true if the data is passed through without being buffered for decoding, because
+  // the decoder ignores it or only counts its messages.
+  bool passThrough(const Buffer::Instance& buffer, const Buffer::Instance& data, bool frontend);
+
   Network::ReadFilterCallbacks* read_callbacks_{};
   Network::WriteFilterCallbacks* write_callbacks_{};
   PostgresFilterConfigSharedPtr config_;
   Buffer::OwnedImpl frontend_buffer_;
   Buffer::OwnedImpl backend_buffer_;
   std::unique_ptr<Decoder> decoder_;
+  const bool decode_messages_;
 };
 
 } // namespace PostgresProxy
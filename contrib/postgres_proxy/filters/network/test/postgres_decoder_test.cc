@@ -306,6 +306,42 @@ TEST_F(PostgresProxyDecoderTest, IncorrectMessages) {
   ASSERT_THAT(decoder_->state(), DecoderImpl::State::OutOfSyncState);
 }
 
+// Test verifies that the messages are counted from their headers only, with their bodies
+// skipped over the data that follows.
+TEST_F(PostgresProxyDecoderTest, HeadersOnly) {
+  createPostgresMsg(data_, "C", "SELECT blah");
+  Buffer::OwnedImpl unknown;
+  createPostgresMsg(unknown, "=", "some not important string which will be ignored anyways");
+  data_.move(unknown);
+  Buffer::OwnedImpl rest;
+  createPostgresMsg(rest, "Z", "I");
+  // Cut the ReadyForQuery message in the middle of its length.
+  data_.move(rest, 3);
+
+  EXPECT_CALL(callbacks_, incMessagesBackend()).Times(2);
+  EXPECT_CALL(callbacks_, incMessagesUnknown());
+  EXPECT_CALL(callbacks_, incStatements(testing::_)).Times(0);
+  const uint64_t length = data_.length();
+  decoder_->onHeaders(data_, false);
+  ASSERT_THAT(data_.length(), length);
+  testing::Mock::VerifyAndClearExpectations(&callbacks_);
+
+  EXPECT_CALL(callbacks_, incMessagesBackend());
+  EXPECT_CALL(callbacks_, incMessagesUnknown()).Times(0);
+  decoder_->onHeaders(rest, false);
+  ASSERT_THAT(decoder_->state(), DecoderImpl::State::InSyncState);
+  testing::Mock::VerifyAndClearExpectations(&callbacks_);
+
+  // A message length shorter than the length field means that the boundaries are lost.
+  data_.drain(data_.length());
+  data_.add("Z");
+  data_.writeBEInt<uint32_t>(3);
+  EXPECT_CALL(callbacks_, incMessagesBackend()).Times(0);
+  decoder_->onHeaders(data_, false);
+  ASSERT_THAT(decoder_->state(), DecoderImpl::State::OutOfSyncState);
+  ASSERT_TRUE(decoder_->ignoresData());
+}
+
 // Test if frontend command calls incMessagesFrontend() method.
 TEST_F(PostgresProxyFrontendDecoderTest, FrontendInc) {
   decoder_->state(DecoderImpl::State::InSyncState);
@@ -687,6 +723,7 @@ public:
   MOCK_METHOD(void, addBufferFragment, (Buffer::BufferFragment&), (override));
   MOCK_METHOD(void, add, (absl::string_view), (override));
   MOCK_METHOD(void, add, (const Instance&), (override));
+  MOCK_METHOD(void, addShared, (Instance&), (override));
   MOCK_METHOD(void, prepend, (absl::string_view), (override));
   MOCK_METHOD(void, prepend, (Instance&), (override));
   MOCK_METHOD(void, copyOut, (size_t, uint64_t, void*), (const, override));
@@ -5,6 +5,7 @@
 
 #include "source/extensions/filters/network/well_known_names.h"
 
+#include "test/mocks/common.h"
 #include "test/mocks/network/mocks.h"
 
 #include "contrib/postgres_proxy/filters/network/source/postgres_filter.h"
@@ -24,6 +25,9 @@ using namespace std::literals::string_literals;
 class MockDecoderTest : public Decoder {
 public:
   MOCK_METHOD(Decoder::Result, onData, (Buffer::Instance&, bool), (override));
+  MOCK_METHOD(void, onHeaders, (const Buffer::Instance&, bool), (override));
+  MOCK_METHOD(bool, inSync, (), (const, override));
+  MOCK_METHOD(bool, ignoresData, (), (const, override));
   MOCK_METHOD(PostgresSession&, getSession, (), (override));
 };
 
@@ -40,7 +44,7 @@ public:
         envoy::extensions::filters::network::postgres_proxy::v3alpha::
             PostgresProxy_SSLMode_DISABLE};
 
-    config_ = std::make_shared<PostgresFilterConfig>(config_options, scope_);
+    config_ = std::make_shared<PostgresFilterConfig>(config_options, scope_, random_);
     filter_ = std::make_unique<PostgresFilter>(config_);
 
     filter_->initializeReadFilterCallbacks(read_callbacks_);
@@ -60,6 +64,7 @@ public:
 
   Stats::IsolatedStoreImpl store_;
   Stats::Scope& scope_{*store_.rootScope()};
+  NiceMock<Random::MockRandomGenerator> random_;
   std::string stat_prefix_{"test."};
   std::unique_ptr<PostgresFilter> filter_;
   PostgresFilterConfigSharedPtr config_;
@@ -235,6 +240,36 @@ TEST_F(PostgresFilterTest, BackendMsgsStats) {
   ASSERT_THAT(filter_->getStats().transactions_rollback_.value(), 1);
 }
 
+// Test verifies that the messages of the sessions which are not sampled are only counted
+// and passed through without being buffered.
+TEST_F(PostgresFilterTest, SessionNotSampled) {
+  PostgresFilterConfig::PostgresFilterConfigOptions config_options{
+      stat_prefix_, true, false,
+      envoy::extensions::filters::network::postgres_proxy::v3alpha::PostgresProxy_SSLMode_DISABLE};
+  config_options.decoding_sample_.emplace().set_numerator(0);
+  config_ = std::make_shared<PostgresFilterConfig>(config_options, scope_, random_);
+  filter_ = std::make_unique<PostgresFilter>(config_);
+  filter_->initializeReadFilterCallbacks(read_callbacks_);
+  filter_->initializeWriteFilterCallbacks(write_callbacks_);
+
+  // The startup message is still decoded.
+  createInitialPostgresRequest(data_);
+  filter_->onData(data_, false);
+  ASSERT_THAT(filter_->getStats().messages_frontend_.value(), 1);
+  ASSERT_THAT(static_cast<DecoderImpl*>(filter_->getDecoder())->state(),
+              DecoderImpl::State::InSyncState);
+
+  createPostgresMsg(data_, "C", "SELECT blah");
+  Buffer::OwnedImpl unknown;
+  createPostgresMsg(unknown, "=", "blah blah blah");
+  data_.move(unknown);
+  ASSERT_THAT(filter_->onWrite(data_, false), Network::FilterStatus::Continue);
+  ASSERT_THAT(filter_->getBackendBufLength(), 0);
+  ASSERT_THAT(filter_->getStats().messages_backend_.value(), 2);
+  ASSERT_THAT(filter_->getStats().messages_unknown_.value(), 1);
+  ASSERT_THAT(filter_->getStats().statements_.value(), 0);
+}
+
 // Test sends series of E type error messages to the filter and
 // verifies that statistic counters are increased.
 TEST_F(PostgresFilterTest, ErrorMsgsStats) {
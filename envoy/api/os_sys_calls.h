@@ -105,6 +105,12 @@ public:
   virtual SysCallIntResult recvmmsg(os_fd_t sockfd, struct mmsghdr* msgvec, unsigned int vlen,
                                     int flags, struct timespec* timeout) PURE;
 
+  /**
+   * @see sendmmsg (man 2 sendmmsg)
+   */
+  virtual SysCallIntResult sendmmsg(os_fd_t sockfd, struct mmsghdr* msgvec, unsigned int vlen,
+                                    int flags) PURE;
+
   /**
    * return true if the OS supports recvmmsg() and sendmmsg().
    */
@@ -147,6 +153,11 @@ public:
   virtual SysCallPtrResult mmap(void* addr, size_t length, int prot, int flags, int fd,
                                 off_t offset) PURE;
 
+  /**
+   * @see man 2 munmap
+   */
+  virtual SysCallIntResult munmap(void* addr, size_t length) PURE;
+
   /**
    * @see man 2 stat
    */
@@ -20,6 +20,22 @@ public:
    * @see sched_getaffinity (man 2 sched_getaffinity)
    */
   virtual SysCallIntResult sched_getaffinity(pid_t pid, size_t cpusetsize, cpu_set_t* mask) PURE;
+
+  /**
+   * @see sched_getcpu (man 3 sched_getcpu)
+   */
+  virtual SysCallIntResult sched_getcpu() PURE;
+
+  /**
+   * @see pipe2 (man 2 pipe2)
+   */
+  virtual SysCallIntResult pipe2(os_fd_t pipefd[2], int flags) PURE;
+
+  /**
+   * @see splice (man 2 splice)
+   */
+  virtual SysCallSizeResult splice(os_fd_t fd_in, loff_t* off_in, os_fd_t fd_out, loff_t* off_out,
+                                   size_t len, unsigned int flags) PURE;
 };
 
 using LinuxOsSysCallsPtr = std::unique_ptr<LinuxOsSysCalls>;
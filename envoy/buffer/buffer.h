@@ -134,6 +134,16 @@ public:
    * should trigger a reset of the corresponding upstream stream if it exists.
    */
   virtual void resetDownstream() PURE;
+
+  /**
+   * Sets the route of the downstream stream associated with this account, which determines the
+   * tenant which the memory of the account is also accounted to. The memory already charged to
+   * the account is moved to the new tenant.
+   *
+   * @param virtual_host_name the name of the virtual host of the route.
+   * @param route_name the name of the route.
+   */
+  virtual void setRoute(absl::string_view virtual_host_name, absl::string_view route_name) PURE;
 };
 
 using BufferMemoryAccountSharedPtr = std::shared_ptr<BufferMemoryAccount>;
@@ -191,6 +201,14 @@ public:
    */
   virtual void add(const Instance& data) PURE;
 
+  /**
+   * Add the content of another buffer into this buffer, sharing the memory of its slices rather
+   * than copying it where possible. The shared slices become immutable in both buffers, so later
+   * additions to either buffer go to new slices. Small slices are copied.
+   * @param data supplies the buffer to share the content of, which keeps its content.
+   */
+  virtual void addShared(Instance& data) PURE;
+
   /**
    * Prepend a string_view to the buffer.
    * @param data supplies the string_view to copy.
@@ -270,7 +288,9 @@ public:
   virtual void move(Instance& rhs) PURE;
 
   /**
-   * Move a portion of a buffer into this buffer. As little copying is done as possible.
+   * Move a portion of a buffer into this buffer. As little copying is done as possible: the part
+   * of a large slice which is moved is shared with the rest of it left in rhs, as addShared()
+   * does, which makes the slice immutable.
    * @param rhs supplies the buffer to move.
    * @param length supplies the amount of data to move.
    */
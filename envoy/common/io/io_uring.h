@@ -29,7 +29,9 @@ public:
     Shutdown = 0x40,
   };
 
-  Request(RequestType type, IoUringSocket& socket) : type_(type), socket_(socket) {}
+  Request(RequestType type, IoUringSocket& socket) : type_(type), socket_(&socket) {}
+  // For the requests that don't belong to a socket, e.g. the reads and writes of files.
+  explicit Request(RequestType type) : type_(type) {}
   virtual ~Request() = default;
 
   /**
@@ -38,13 +40,14 @@ public:
   RequestType type() const { return type_; }
 
   /**
-   * Returns the io_uring socket the request belongs to.
+   * Returns the io_uring socket the request belongs to. Must only be called on the requests of a
+   * socket.
    */
-  IoUringSocket& socket() const { return socket_; }
+  IoUringSocket& socket() const { return *socket_; }
 
 private:
   RequestType type_;
-  IoUringSocket& socket_;
+  IoUringSocket* socket_{};
 };
 
 /**
@@ -52,9 +55,12 @@ private:
  * @param user_data is any data attached to an entry submitted to the submission
  * queue.
  * @param result is a return code of submitted system call.
+ * @param flags is the flags of the completion queue entry, like `IORING_CQE_F_MORE` or
+ * `IORING_CQE_F_BUFFER`. It is always 0 for injected completions.
  * @param injected indicates whether the completion is injected or not.
  */
-using CompletionCb = std::function<void(Request* user_data, int32_t result, bool injected)>;
+using CompletionCb =
+    std::function<void(Request* user_data, int32_t result, uint32_t flags, bool injected)>;
 
 /**
  * Callback for releasing the user data.
@@ -147,6 +153,33 @@ public:
    */
   virtual IoUringResult prepareShutdown(os_fd_t fd, int how, Request* user_data) PURE;
 
+  /**
+   * Prepares a multishot recv system call and puts it into the submission queue. The request
+   * completes once for every read, each time with a buffer selected from the provided buffer ring,
+   * and with `IORING_CQE_F_MORE` set in the flags of the completion until its last completion.
+   * Requires a successful call to registerProvidedBuffers().
+   * Returns IoUringResult::Failed in case the submission queue is full already
+   * and IoUringResult::Ok otherwise.
+   */
+  virtual IoUringResult prepareRecvMultishot(os_fd_t fd, Request* user_data) PURE;
+
+  /**
+   * Registers a provided buffer ring with the kernel, from which the buffers of multishot recv
+   * requests are selected. The ring initially holds all the buffers.
+   * @param buffers is the memory of the buffers, which must outlive the io_uring.
+   * @param num_buffers is the number of buffers, which must be a power of 2 up to 32768.
+   * @param buffer_size is the size of each buffer.
+   * @return whether the ring was registered, which requires Linux 5.19 or later.
+   */
+  virtual bool registerProvidedBuffers(uint8_t* buffers, uint32_t num_buffers,
+                                       uint32_t buffer_size) PURE;
+
+  /**
+   * Gives a buffer selected by a completion back to the provided buffer ring.
+   * @param buffer_id is the id of the buffer, from the flags of the completion.
+   */
+  virtual void recycleProvidedBuffer(uint16_t buffer_id) PURE;
+
   /**
    * Submits the entries in the submission queue to the kernel using the
    * `io_uring_enter()` system call.
@@ -212,6 +212,7 @@ constexpr bool win32SupportsOriginalDestination() {
 #endif
 
 #if defined(__linux__)
+#include <linux/errqueue.h>
 #include <linux/netfilter_ipv4.h>
 #endif
 
@@ -234,6 +235,22 @@ constexpr bool win32SupportsOriginalDestination() {
 #define UDP_SEGMENT 103
 #endif
 
+#ifndef SO_TXTIME
+#define SO_TXTIME 61
+#endif
+
+#ifndef SO_ZEROCOPY
+#define SO_ZEROCOPY 60
+#endif
+
+#ifndef MSG_ZEROCOPY
+#define MSG_ZEROCOPY 0x4000000
+#endif
+
+#ifndef SCM_TXTIME
+#define SCM_TXTIME SO_TXTIME
+#endif
+
 #ifndef IPPROTO_MPTCP
 #define IPPROTO_MPTCP 262
 #endif
@@ -335,3 +352,9 @@ struct mmsghdr {
 #else
 #define ENVOY_PLATFORM_ENABLE_SEND_RST 0
 #endif
+
+#if defined(__linux__) && defined(SO_EE_ORIGIN_ZEROCOPY)
+#define ENVOY_PLATFORM_ENABLE_MSG_ZEROCOPY 1
+#else
+#define ENVOY_PLATFORM_ENABLE_MSG_ZEROCOPY 0
+#endif
@@ -2,6 +2,11 @@
 
 #include "envoy/compression/compressor/compressor.h"
 
+#include "source/common/common/interval_value.h"
+#include "source/common/common/macros.h"
+
+#include "absl/types/optional.h"
+
 namespace Envoy {
 namespace Compression {
 namespace Compressor {
@@ -11,8 +16,41 @@ public:
   virtual ~CompressorFactory() = default;
 
   virtual CompressorPtr createCompressor() PURE;
+
+  /**
+   * Creates a compressor for the given load, which is the state of the
+   * envoy.overload_actions.reduce_compression_level overload action. The compressors of the
+   * factories which support it are created with a compression level lowered as the load grows,
+   * from the configured level when the action is inactive down to the cheapest level when it is
+   * saturated. The other factories ignore the load.
+   * @param load the state of the overload action.
+   * @return the compressor.
+   */
+  virtual CompressorPtr createCompressorForLoad(UnitFloat load) {
+    UNREFERENCED_PARAMETER(load);
+    return createCompressor();
+  }
+
+  /**
+   * @param load the state of the envoy.overload_actions.reduce_compression_level overload action.
+   * @return the compression level of the compressors created for the given load, or absl::nullopt
+   *         if the factory doesn't lower its compression level.
+   */
+  virtual absl::optional<uint32_t> compressionLevelForLoad(UnitFloat load) const {
+    UNREFERENCED_PARAMETER(load);
+    return absl::nullopt;
+  }
+
   virtual const std::string& statsPrefix() const PURE;
   virtual const std::string& contentEncoding() const PURE;
+
+  /**
+   * @return the raw SHA-256 hash of the shared dictionary the compressors compress with, or an
+   *         empty string if they don't. The responses are only compressed with a dictionary for
+   *         the clients which announce it in the "available-dictionary" request header. Must be
+   *         called on the thread the compressors are created on.
+   */
+  virtual std::string dictionaryHash() const { return ""; }
 };
 
 using CompressorFactoryPtr = std::unique_ptr<CompressorFactory>;
@@ -16,6 +16,14 @@ public:
   // A more generic method might be `hint()` which gives the user of the decompressor a hint about
   // the type of decompression that it can perform.
   virtual const std::string& contentEncoding() const PURE;
+
+  /**
+   * @return the raw SHA-256 hash of the shared dictionary the decompressors decompress with, or an
+   *         empty string if they don't. The dictionary is announced in the "available-dictionary"
+   *         request header along with the content encoding. Must be called on the thread the
+   *         decompressors are created on.
+   */
+  virtual std::string dictionaryHash() const { return ""; }
 };
 
 using DecompressorFactoryPtr = std::unique_ptr<DecompressorFactory>;
@@ -54,6 +54,12 @@ public:
    */
   virtual const Protobuf::Message& resource() const PURE;
 
+  /**
+   * @return std::shared_ptr<const Protobuf::Message> the resource message, shared with the
+   *         caller, which can keep it rather than copying it. The message must not be modified.
+   */
+  virtual std::shared_ptr<const Protobuf::Message> sharedResource() const PURE;
+
   virtual absl::optional<std::chrono::milliseconds> ttl() const PURE;
 
   /**
@@ -87,6 +93,23 @@ public:
    *         the route config name for a envoy.config.route.v3.RouteConfiguration message.
    */
   virtual std::string resourceName(const Protobuf::Message& resource) PURE;
+
+  /**
+   * Unpacks the opaque resource as decodeResource() does, but without validating it. Unlike
+   * decodeResource(), this may be called from any thread, so that the resources of a large
+   * response may be unpacked in parallel.
+   * @param resource some opaque resource (ProtobufWkt::Any).
+   * @return ProtobufTypes::MessagePtr the unpacked message, to be validated with
+   *         validateResource() if the resource has a type URL, or nullptr if the decoder can only
+   *         decode resources with decodeResource().
+   */
+  virtual ProtobufTypes::MessagePtr unpackResource(const ProtobufWkt::Any&) { return nullptr; }
+
+  /**
+   * Validates a message returned by unpackResource(), on the main thread.
+   * @param resource the unpacked message.
+   */
+  virtual void validateResource(const Protobuf::Message&) {}
 };
 
 using OpaqueResourceDecoderSharedPtr = std::shared_ptr<OpaqueResourceDecoder>;
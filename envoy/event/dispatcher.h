@@ -39,8 +39,14 @@ namespace Event {
  * All dispatcher stats. @see stats_macros.h
  */
 #define ALL_DISPATCHER_STATS(HISTOGRAM)                                                            \
+  HISTOGRAM(deferred_delete_backlog, Unspecified)                                                  \
+  HISTOGRAM(deferred_delete_duration_us, Microseconds)                                             \
+  HISTOGRAM(file_event_duration_us, Microseconds)                                                  \
   HISTOGRAM(loop_duration_us, Microseconds)                                                        \
-  HISTOGRAM(poll_delay_us, Microseconds)
+  HISTOGRAM(poll_delay_us, Microseconds)                                                           \
+  HISTOGRAM(post_callback_duration_us, Microseconds)                                               \
+  HISTOGRAM(schedulable_callback_duration_us, Microseconds)                                        \
+  HISTOGRAM(timer_duration_us, Microseconds)
 
 /**
  * Struct definition for all dispatcher stats. @see stats_macros.h
@@ -47,6 +47,18 @@ public:
    */
   virtual void sendMessageRaw(Buffer::InstancePtr&& request, bool end_stream) PURE;
 
+  /**
+   * Send request message to the stream, corked with the other messages sent this way during the
+   * current iteration of the event loop: they are written to the stream at once at the end of the
+   * iteration, or before the next message sent with sendMessageRaw() or closeStream(). This is for
+   * the streams sending many small messages at a time. The default implementation sends the
+   * message right away.
+   * @param request serialized message.
+   */
+  virtual void sendMessageRawCorked(Buffer::InstancePtr&& request) {
+    sendMessageRaw(std::move(request), false);
+  }
+
   /**
    * Close the stream locally and send an empty DATA frame to the remote. No further methods may be
    * invoked on the stream object, but callbacks may still be received until the stream is closed
@@ -35,6 +35,9 @@ namespace Http3 {
 struct CodecStats;
 }
 
+class HeaderMapArena;
+using HeaderMapArenaSharedPtr = std::shared_ptr<HeaderMapArena>;
+
 // Legacy default value of 60K is safely under both codec default limits.
 static constexpr uint32_t DEFAULT_MAX_REQUEST_HEADERS_KB = 60;
 // Default maximum number of headers.
@@ -260,6 +263,12 @@ public:
    * @return List of shared pointers to access loggers for this stream.
    */
   virtual std::list<AccessLog::InstanceSharedPtr> accessLogHandlers() PURE;
+
+  /**
+   * @return the arena the codec should allocate the request headers and trailers of this stream
+   *         from, or nullptr to allocate them from the heap.
+   */
+  virtual HeaderMapArenaSharedPtr headerMapArena() PURE;
 };
 
 /**
@@ -456,6 +456,15 @@ public:
    */
   virtual void resetIdleTimer() PURE;
 
+  /**
+   * Tells the filter manager that the filter doesn't need to see the body data of the stream in
+   * the direction of these callbacks, e.g. a filter which only checks the headers of a WebSocket
+   * or CONNECT tunnel. Once the filter has continued the headers, the data skips it on its way
+   * down the filter chain. The filter is still given decodeComplete() or encodeComplete() at the
+   * end of the stream.
+   */
+  virtual void disableDataCallbacks() PURE;
+
   /**
    * This is a helper to get the route's per-filter config if it exists, otherwise the virtual
    * host's. Or nullptr if none of them exist.
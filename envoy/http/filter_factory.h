@@ -4,6 +4,7 @@
 #include <map>
 
 #include "envoy/common/pure.h"
+#include "envoy/stats/stats_macros.h"
 
 #include "absl/strings/string_view.h"
 #include "absl/types/optional.h"
@@ -23,6 +24,22 @@ class FilterChainFactoryCallbacks;
  */
 using FilterFactoryCb = std::function<void(FilterChainFactoryCallbacks& callbacks)>;
 
+/**
+ * All the latency stats of an HTTP filter. @see stats_macros.h
+ */
+#define ALL_FILTER_LATENCY_STATS(HISTOGRAM)                                                        \
+  HISTOGRAM(decode_data_us, Microseconds)                                                          \
+  HISTOGRAM(decode_headers_us, Microseconds)                                                       \
+  HISTOGRAM(encode_data_us, Microseconds)                                                          \
+  HISTOGRAM(encode_headers_us, Microseconds)
+
+/**
+ * Struct definition for the latency stats of an HTTP filter. @see stats_macros.h
+ */
+struct FilterLatencyStats {
+  ALL_FILTER_LATENCY_STATS(GENERATE_HISTOGRAM_STRUCT)
+};
+
 /**
  * Simple struct of additional contextual information of HTTP filter, e.g. filter config name
  * from configuration, canonical filter name, etc.
@@ -34,6 +51,9 @@ struct FilterContext {
   // Filter extension qualified name. This is used as a fallback of `config_name`. E.g.,
   // "envoy.filters.http.buffer" for the HTTP buffer filter.
   std::string filter_name;
+  // The stats to record the time spent in the callbacks of the filter into, if the stream is
+  // sampled for filter latency. They are owned by the filter chain configuration.
+  const FilterLatencyStats* latency_stats{};
 };
 
 /**
@@ -33,6 +33,15 @@ public:
   static QueryParamsMulti parseParameters(absl::string_view data, size_t start, bool decode_params);
   static QueryParamsMulti parseQueryString(absl::string_view url);
   static QueryParamsMulti parseAndDecodeQueryString(absl::string_view url);
+
+  /**
+   * Same as parseQueryString() and parseAndDecodeQueryString(), except that the parameters are
+   * only parsed again when the query string differs from the one of the previous call on this
+   * thread. This is for the routes, matchers and policies which each look at the parameters of
+   * the same path. The returned reference is only valid until the next call on this thread.
+   */
+  static const QueryParamsMulti& parseQueryStringCached(absl::string_view url);
+  static const QueryParamsMulti& parseAndDecodeQueryStringCached(absl::string_view url);
 };
 
 } // namespace Utility
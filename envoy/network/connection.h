@@ -409,6 +409,13 @@ public:
    */
   virtual void setTransportSocketConnectTimeout(std::chrono::milliseconds timeout,
                                                 Stats::Counter& timeout_stat) PURE;
+
+  /**
+   * Flush the data written to the connection once at the end of the event loop iteration it is
+   * written in, so that the writes made in an iteration, e.g. by several streams or filters, take
+   * a single flush rather than one in each of the following iterations they spread over.
+   */
+  virtual void enableWriteCoalescing() PURE;
 };
 
 using ServerConnectionPtr = std::unique_ptr<ServerConnection>;
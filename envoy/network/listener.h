@@ -297,6 +297,12 @@ public:
    */
   virtual bool ignoreGlobalConnLimit() const PURE;
 
+  /**
+   * @return bool whether the writes to the connections of the listener during an event loop
+   * iteration are flushed together at the end of the iteration.
+   */
+  virtual bool coalesceWrites() const PURE;
+
   /**
    * @return bool whether the listener should bypass overload manager actions
    */
@@ -28,6 +28,15 @@ public:
    */
   virtual bool onRdsUpdate(const Protobuf::Message& rc, const std::string& version_info) PURE;
 
+  /**
+   * Same as above, for a RouteConfiguration which the receiver keeps rather than copies, when it
+   * doesn't need to change it.
+   * @param rc supplies the RouteConfiguration, which must not be modified.
+   * @param version_info supplies RouteConfiguration version.
+   */
+  virtual bool onRdsUpdate(std::shared_ptr<const Protobuf::Message> rc,
+                           const std::string& version_info) PURE;
+
   /**
    * @return uint64_t the hash value of RouteConfiguration.
    */
@@ -133,6 +133,12 @@ public:
    */
   virtual const std::vector<Matchers::StringMatcherPtr>& allowOrigins() const PURE;
 
+  /**
+   * @param origin supplies the value of the origin header of the request.
+   * @return bool whether the origin, or any origin, is matched by the allowOrigins() matchers.
+   */
+  virtual bool isOriginAllowed(absl::string_view origin) const PURE;
+
   /**
    * @return std::string access-control-allow-methods value.
    */
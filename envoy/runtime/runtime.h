@@ -18,6 +18,7 @@
 #include "absl/container/flat_hash_map.h"
 #include "absl/container/node_hash_map.h"
 #include "absl/types/optional.h"
+#include "absl/types/span.h"
 
 namespace Envoy {
 
@@ -209,6 +210,15 @@ public:
    * @return const std::vector<OverrideLayerConstPtr>& the raw map of loaded values.
    */
   virtual const std::vector<OverrideLayerConstPtr>& getLayers() const PURE;
+
+  /**
+   * Fetch the entries of the keys of the Runtime::KeyIndex, which are looked up once when the
+   * snapshot is made so that the readers of these keys don't hash them for each lookup.
+   * @return the entries by the index of their key, with nullptr for the keys without a value. The
+   *         keys registered after the snapshot was made are out of the span. Snapshots which don't
+   *         index their entries return an empty span, so that all the keys are looked up by name.
+   */
+  virtual absl::Span<const Entry* const> indexedEntries() const { return {}; }
 };
 
 using SnapshotConstSharedPtr = std::shared_ptr<const Snapshot>;
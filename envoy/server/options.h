@@ -201,6 +201,12 @@ public:
    */
   virtual const std::string& logPath() const PURE;
 
+  /**
+   * @return uint32_t the size in KiB of the buffer of each thread logging to the application log
+   *         through a background thread, or 0 if the log is written synchronously.
+   */
+  virtual uint32_t logAsyncBufferSizeKb() const PURE;
+
   /**
    * @return the restart epoch. 0 indicates the first server start, 1 the second, and so on.
    */
@@ -217,6 +223,18 @@ public:
    */
   virtual std::chrono::milliseconds fileFlushIntervalMsec() const PURE;
 
+  /**
+   * @return uint32_t the size in KiB of the buffered log data above which it is flushed without
+   *         waiting for the flush interval.
+   */
+  virtual uint32_t fileFlushMinSizeKb() const PURE;
+
+  /**
+   * @return uint32_t the size in KiB of the buffered log data above which log writes are dropped,
+   *         or 0 if the buffered log data is not bounded.
+   */
+  virtual uint32_t fileMaxBufferedSizeKb() const PURE;
+
   /**
    * @return const std::string& the server's cluster.
    */
@@ -257,6 +275,11 @@ public:
    */
   virtual bool cpusetThreadsEnabled() const PURE;
 
+  /**
+   * @return bool indicating whether each worker thread should be pinned to a CPU.
+   */
+  virtual bool pinWorkerThreadsEnabled() const PURE;
+
   /**
    * @return the names of extensions to disable.
    */
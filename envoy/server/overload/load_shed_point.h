@@ -3,6 +3,7 @@
 #include <memory>
 
 #include "envoy/common/pure.h"
+#include "envoy/http/header_map.h"
 
 #include "absl/strings/string_view.h"
 
@@ -47,6 +48,10 @@ public:
 
   // Whether to shed the load.
   virtual bool shouldShedLoad() PURE;
+
+  // Whether to shed the load of an HTTP request, which may be of low priority given its headers.
+  // The points which don't tell the priorities of the requests apart shed them all alike.
+  virtual bool shouldShedRequest(const Http::RequestHeaderMap&) { return shouldShedLoad(); }
 };
 
 using LoadShedPointPtr = std::unique_ptr<LoadShedPoint>;
@@ -94,6 +94,11 @@ public:
    * @return the max depth used when verifying the certificate-chain
    */
   virtual absl::optional<uint32_t> maxVerifyDepth() const PURE;
+
+  /**
+   * @return the max number of verified peer certificate chains to remember, 0 if none.
+   */
+  virtual uint32_t verifiedChainCacheSize() const PURE;
 };
 
 using CertificateValidationContextConfigPtr = std::unique_ptr<CertificateValidationContextConfig>;
@@ -9,6 +9,7 @@
 #include "envoy/common/pure.h"
 #include "envoy/ssl/certificate_validation_context_config.h"
 #include "envoy/ssl/handshaker.h"
+#include "envoy/ssl/session_cache/session_cache.h"
 #include "envoy/ssl/tls_certificate_config.h"
 
 #include "source/common/network/cidr_range.h"
@@ -117,6 +118,12 @@ public:
    * @return the access log manager object reference
    */
   virtual AccessLog::AccessLogManager& accessLogManager() const PURE;
+
+  /**
+   * @return true if the encryption of the records sent should move to the kernel after the
+   * handshake, where supported.
+   */
+  virtual bool kernelTlsOffload() const PURE;
 };
 
 class ClientContextConfig : public virtual ContextConfig {
@@ -194,11 +201,25 @@ public:
    */
   virtual bool disableStatefulSessionResumption() const PURE;
 
+  /**
+   * @return the cache of the sessions of the stateful TLS session resumption, or nullptr if the
+   * sessions are cached by each context.
+   */
+  virtual SessionCacheSharedPtr sessionCache() const PURE;
+
   /**
    * @return True if we allow full scan certificates when there is no cert matching SNI during
    * downstream TLS handshake, false otherwise.
    */
   virtual bool fullScanCertsOnSNIMismatch() const PURE;
+
+  /**
+   * @return a hash of the current configuration and secrets, equal for the configs from which
+   * identical server contexts would be created, or absl::nullopt if the server contexts created
+   * from this config can't be shared with other configs, e.g. since they depend on extensions.
+   * The contexts must not reference the config after their creation to be shared.
+   */
+  virtual absl::optional<uint64_t> contextHash() const PURE;
 };
 
 using ServerContextConfigPtr = std::unique_ptr<ServerContextConfig>;
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <chrono>
+#include <memory>
+#include <string>
+
+#include "envoy/common/pure.h"
+#include "envoy/config/typed_config.h"
+#include "envoy/protobuf/message_validator.h"
+
+#include "absl/strings/string_view.h"
+#include "absl/types/optional.h"
+
+namespace Envoy {
+namespace Server {
+namespace Configuration {
+// Prevent a dependency loop with the forward declaration.
+class ServerFactoryContext;
+} // namespace Configuration
+} // namespace Server
+
+namespace Ssl {
+
+/**
+ * A cache of the serialized TLS sessions of the stateful session resumption of server contexts,
+ * replacing the cache of each SSL_CTX. It's used by the workers concurrently, and it may be shared
+ * by several contexts, which prefix the session IDs of their keys with their session ID context.
+ */
+class SessionCache {
+public:
+  virtual ~SessionCache() = default;
+
+  /**
+   * Adds or replaces a session.
+   * @param key supplies the key of the session.
+   * @param session supplies the serialized session.
+   * @param timeout supplies the lifetime of the session, after which it can't be resumed.
+   */
+  virtual void insert(absl::string_view key, absl::string_view session,
+                      std::chrono::seconds timeout) PURE;
+
+  /**
+   * @param key supplies the key of the session.
+   * @return the serialized session, or absl::nullopt if it isn't in the cache or expired.
+   */
+  virtual absl::optional<std::string> lookup(absl::string_view key) PURE;
+
+  /**
+   * Removes a session, e.g. since its connection failed. This is a no-op if it isn't in the cache.
+   * @param key supplies the key of the session.
+   */
+  virtual void remove(absl::string_view key) PURE;
+};
+
+using SessionCacheSharedPtr = std::shared_ptr<SessionCache>;
+
+/**
+ * A factory of session caches. The contexts configured with identical caches use a single one,
+ * which is kept across the updates of the contexts.
+ */
+class SessionCacheFactory : public Config::TypedFactory {
+public:
+  /**
+   * Creates a session cache. It's called on the main thread.
+   * @param config supplies the configuration of the cache.
+   * @param validation_visitor supplies the configuration validator.
+   * @param context supplies the server factory context.
+   * @return the session cache.
+   */
+  virtual SessionCacheSharedPtr
+  createSessionCache(const Protobuf::Message& config,
+                     ProtobufMessage::ValidationVisitor& validation_visitor,
+                     Server::Configuration::ServerFactoryContext& context) PURE;
+
+  std::string category() const override { return "envoy.tls.session_cache"; }
+};
+
+} // namespace Ssl
+} // namespace Envoy
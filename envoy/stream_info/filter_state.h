@@ -10,6 +10,7 @@
 #include "source/common/common/utility.h"
 #include "source/common/protobuf/protobuf.h"
 
+#include "absl/hash/hash.h"
 #include "absl/strings/string_view.h"
 #include "absl/types/optional.h"
 
@@ -152,6 +153,23 @@ public:
   using Objects = std::vector<FilterObject>;
   using ObjectsPtr = std::unique_ptr<Objects>;
 
+  /**
+   * The name of an object, hashed once when it is created, e.g. at config time, so that the
+   * lookups of the object don't hash the name again.
+   */
+  class Key {
+  public:
+    explicit Key(absl::string_view name)
+        : name_(name), hash_(absl::Hash<absl::string_view>{}(name_)) {}
+
+    const std::string& name() const { return name_; }
+    size_t hash() const { return hash_; }
+
+  private:
+    const std::string name_;
+    const size_t hash_;
+  };
+
   virtual ~FilterState() = default;
 
   /**
@@ -188,6 +206,19 @@ public:
    */
   virtual const Object* getDataReadOnlyGeneric(absl::string_view data_name) const PURE;
 
+  /**
+   * Same as getDataReadOnly(absl::string_view), with the hash of the name computed in advance.
+   */
+  template <typename T> const T* getDataReadOnly(const Key& key) const {
+    return dynamic_cast<const T*>(getDataReadOnlyGeneric(key));
+  }
+
+  /**
+   * Same as getDataReadOnlyGeneric(absl::string_view), with the hash of the name computed in
+   * advance.
+   */
+  virtual const Object* getDataReadOnlyGeneric(const Key& key) const PURE;
+
   /**
    * @param data_name the name of the data being looked up (mutable/readonly).
    * @return a typed pointer to the stored data or nullptr if the data does not exist or the data
@@ -225,6 +256,11 @@ public:
    */
   virtual bool hasDataWithName(absl::string_view data_name) const PURE;
 
+  /**
+   * Same as hasDataWithName(absl::string_view), with the hash of the name computed in advance.
+   */
+  virtual bool hasDataWithName(const Key& key) const PURE;
+
   /**
    * @param life_span the LifeSpan above which data existence is checked.
    * @return whether data of any type exist with LifeSpan greater than life_span.
@@ -60,6 +60,12 @@ public:
    */
   virtual Network::ClientConnection& connection() PURE;
 
+  /**
+   * @return the socket of the connection, or nullptr if it is not known. The socket must not be
+   *         read from nor written to while the connection may itself read or write.
+   */
+  virtual const Network::Socket* socket() PURE;
+
   /**
    * Sets the ConnectionState for this connection. Any existing ConnectionState is destroyed.
    * @param ConnectionStatePtr&& new ConnectionState for this connection.
@@ -157,6 +157,13 @@ public:
    * @return the const SSL connection data of upstream.
    */
   virtual Ssl::ConnectionInfoConstSharedPtr getUpstreamConnectionSslInfo() PURE;
+
+  /**
+   * @return the socket of the upstream TCP connection when bytes are proxied to it as is, or
+   *         nullptr otherwise, e.g. when they are tunneled over HTTP or go through a transport
+   *         socket other than the raw buffer one.
+   */
+  virtual const Network::Socket* upstreamSocket() PURE;
 };
 
 using GenericConnPoolPtr = std::unique_ptr<GenericConnPool>;
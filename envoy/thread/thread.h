@@ -56,6 +56,8 @@ using ThreadPtr = std::unique_ptr<Thread>;
 // Options specified during thread creation.
 struct Options {
   std::string name_; // A name supplied for the thread. On Linux this is limited to 15 chars.
+  // A CPU the thread is pinned to. Only supported on Linux, ignored on other platforms.
+  absl::optional<uint32_t> cpu_{};
 };
 
 using OptionsOptConstRef = const absl::optional<Options>&;
@@ -10,6 +10,9 @@
 #include "envoy/thread_local/thread_local_object.h"
 
 #include "source/common/common/assert.h"
+#include "source/common/common/cleanup.h"
+
+#include "absl/base/attributes.h"
 
 namespace Envoy {
 namespace ThreadLocal {
@@ -209,6 +212,8 @@ private:
 
 template <class T = ThreadLocalObject> using TypedSlotPtr = std::unique_ptr<TypedSlot<T>>;
 
+using ScopedBatch = std::unique_ptr<Cleanup>;
+
 /**
  * Interface for getting and setting thread local data as well as registering a thread
  */
@@ -248,6 +253,19 @@ public:
    * @return true if global threading has been shutdown or false if not.
    */
   virtual bool isShutdown() const PURE;
+
+  /**
+   * Batches the updates of the slots posted to the worker threads from the main thread: until the
+   * returned object is destroyed, the callbacks of set(), runOnAllThreads() and of the slot
+   * removals are queued, and are then delivered in order with a single post to each worker. The
+   * main thread still runs its part of the updates right away. Batches may be nested, in which
+   * case the updates are delivered when the outermost one ends.
+   * @param complete_cb supplies an optional callback to invoke on the main thread once all the
+   *                    workers ran the batch. The completion callbacks of the batched
+   *                    runOnAllThreads() calls are also only invoked then.
+   * @return ScopedBatch an object which delivers the batch when destroyed.
+   */
+  ABSL_MUST_USE_RESULT virtual ScopedBatch batchUpdates(std::function<void()> complete_cb) PURE;
 };
 
 } // namespace ThreadLocal
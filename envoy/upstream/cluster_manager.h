@@ -353,6 +353,14 @@ public:
    */
   virtual Config::GrpcMuxSharedPtr adsMux() PURE;
 
+  /**
+   * Pauses posting the thread local cluster updates to the workers, e.g. while the clusters of an
+   * xDS response are added, updated or removed. The updates made while paused are applied to the
+   * main thread right away, and posted to each worker as a single batch once resumed.
+   * @return a ScopedResume object, which when destructed, posts the paused updates.
+   */
+  ABSL_MUST_USE_RESULT virtual Config::ScopedResume pauseThreadLocalClusterUpdates() PURE;
+
   /**
    * @return Grpc::AsyncClientManager& the cluster manager's gRPC client manager.
    */
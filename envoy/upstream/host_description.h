@@ -1,5 +1,9 @@
 #pragma once
 
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
 #include <map>
 #include <memory>
 #include <string>
@@ -22,37 +26,125 @@ namespace Upstream {
 
 using MetadataConstSharedPtr = std::shared_ptr<const envoy::config::core::v3::Metadata>;
 
+/**
+ * A load report stat of the requests to the hosts of a locality and priority of a cluster, which
+ * the hosts count their own requests in. @see LocalityLoadStats.
+ */
+class LocalityLoadStat {
+public:
+  virtual ~LocalityLoadStat() = default;
+
+  virtual void add(uint64_t amount) PURE;
+  virtual void sub(uint64_t amount) PURE;
+};
+
+/**
+ * A host counter which also counts in a load report stat of the locality of the host, if set.
+ */
+class LoadReportPrimitiveCounter : public Stats::PrimitiveCounter {
+public:
+  void add(uint64_t amount) {
+    Stats::PrimitiveCounter::add(amount);
+    if (LocalityLoadStat* stat = locality_stat_.load(std::memory_order_acquire); stat != nullptr) {
+      stat->add(amount);
+    }
+  }
+  void inc() { add(1); }
+
+  void setLocalityStat(LocalityLoadStat* stat) {
+    locality_stat_.store(stat, std::memory_order_release);
+  }
+
+private:
+  std::atomic<LocalityLoadStat*> locality_stat_{nullptr};
+};
+
+/**
+ * A host gauge which also counts in a load report stat of the locality of the host, if set.
+ */
+class LoadReportPrimitiveGauge : public Stats::PrimitiveGauge {
+public:
+  void add(uint64_t amount) {
+    Stats::PrimitiveGauge::add(amount);
+    if (LocalityLoadStat* stat = locality_stat_.load(std::memory_order_acquire); stat != nullptr) {
+      stat->add(amount);
+    }
+  }
+  void dec() { sub(1); }
+  void inc() { add(1); }
+  void set(uint64_t value) {
+    const uint64_t current = Stats::PrimitiveGauge::value();
+    if (value >= current) {
+      add(value - current);
+    } else {
+      sub(current - value);
+    }
+  }
+  void sub(uint64_t amount) {
+    Stats::PrimitiveGauge::sub(amount);
+    if (LocalityLoadStat* stat = locality_stat_.load(std::memory_order_acquire); stat != nullptr) {
+      stat->sub(amount);
+    }
+  }
+
+  // Moves the current value of the gauge from the previous stat to the new one.
+  void setLocalityStat(LocalityLoadStat* stat) {
+    const uint64_t current = Stats::PrimitiveGauge::value();
+    LocalityLoadStat* previous = locality_stat_.exchange(stat, std::memory_order_acq_rel);
+    if (previous != nullptr) {
+      previous->sub(current);
+    }
+    if (stat != nullptr) {
+      stat->add(current);
+    }
+  }
+
+private:
+  std::atomic<LocalityLoadStat*> locality_stat_{nullptr};
+};
+
+#define GENERATE_LOAD_REPORT_COUNTER_STRUCT(NAME) LoadReportPrimitiveCounter NAME##_;
+#define GENERATE_LOAD_REPORT_GAUGE_STRUCT(NAME) LoadReportPrimitiveGauge NAME##_;
+#define LOAD_REPORT_COUNTER_NAME_AND_REFERENCE(NAME)                                               \
+  {absl::string_view(#NAME), std::ref<Stats::PrimitiveCounter>(NAME##_)},
+#define LOAD_REPORT_GAUGE_NAME_AND_REFERENCE(NAME)                                                 \
+  {absl::string_view(#NAME), std::ref<Stats::PrimitiveGauge>(NAME##_)},
+
 /**
  * All per host stats. @see stats_macros.h
  *
  * {rq_success, rq_error} have specific semantics driven by the needs of EDS load reporting. See
- * envoy.api.v2.endpoint.UpstreamLocalityStats for the definitions of success/error. These are
- * latched by LoadStatsReporter, independent of the normal stats sink flushing.
+ * envoy.api.v2.endpoint.UpstreamLocalityStats for the definitions of success/error. The load
+ * report stats also count in the LocalityLoadStats of the locality and priority of the host,
+ * which are latched by LoadStatsReporter, independent of the normal stats sink flushing.
  */
-#define ALL_HOST_STATS(COUNTER, GAUGE)                                                             \
+#define ALL_HOST_STATS(COUNTER, GAUGE, LOAD_REPORT_COUNTER, LOAD_REPORT_GAUGE)                     \
   COUNTER(cx_connect_fail)                                                                         \
   COUNTER(cx_total)                                                                                \
-  COUNTER(rq_error)                                                                                \
-  COUNTER(rq_success)                                                                              \
+  LOAD_REPORT_COUNTER(rq_error)                                                                    \
+  LOAD_REPORT_COUNTER(rq_success)                                                                  \
   COUNTER(rq_timeout)                                                                              \
-  COUNTER(rq_total)                                                                                \
+  LOAD_REPORT_COUNTER(rq_total)                                                                    \
   GAUGE(cx_active)                                                                                 \
-  GAUGE(rq_active)
+  LOAD_REPORT_GAUGE(rq_active)
 
 /**
  * All per host stats defined. @see stats_macros.h
  */
 struct HostStats {
-  ALL_HOST_STATS(GENERATE_PRIMITIVE_COUNTER_STRUCT, GENERATE_PRIMITIVE_GAUGE_STRUCT);
+  ALL_HOST_STATS(GENERATE_PRIMITIVE_COUNTER_STRUCT, GENERATE_PRIMITIVE_GAUGE_STRUCT,
+                 GENERATE_LOAD_REPORT_COUNTER_STRUCT, GENERATE_LOAD_REPORT_GAUGE_STRUCT);
 
   // Provide access to name,counter pairs.
   std::vector<std::pair<absl::string_view, Stats::PrimitiveCounterReference>> counters() {
-    return {ALL_HOST_STATS(PRIMITIVE_COUNTER_NAME_AND_REFERENCE, IGNORE_PRIMITIVE_GAUGE)};
+    return {ALL_HOST_STATS(PRIMITIVE_COUNTER_NAME_AND_REFERENCE, IGNORE_PRIMITIVE_GAUGE,
+                           LOAD_REPORT_COUNTER_NAME_AND_REFERENCE, IGNORE_PRIMITIVE_GAUGE)};
   }
 
   // Provide access to name,gauge pairs.
   std::vector<std::pair<absl::string_view, Stats::PrimitiveGaugeReference>> gauges() {
-    return {ALL_HOST_STATS(IGNORE_PRIMITIVE_COUNTER, PRIMITIVE_GAUGE_NAME_AND_REFERENCE)};
+    return {ALL_HOST_STATS(IGNORE_PRIMITIVE_COUNTER, PRIMITIVE_GAUGE_NAME_AND_REFERENCE,
+                           IGNORE_PRIMITIVE_COUNTER, LOAD_REPORT_GAUGE_NAME_AND_REFERENCE)};
   }
 };
 
@@ -84,6 +176,59 @@ public:
   virtual StatMapPtr latch() PURE;
 };
 
+/**
+ * The load report stats of the requests to the hosts of a locality and priority of a cluster.
+ * The hosts count their requests in them as they count their own stats, so that load reports
+ * are computed per locality instead of per host.
+ */
+class LocalityLoadStats {
+public:
+  virtual ~LocalityLoadStats() = default;
+
+  struct Latched {
+    uint64_t rq_success_{};
+    uint64_t rq_error_{};
+    uint64_t rq_total_{};
+    // The requests in progress, which is a gauge and so isn't reset by latching.
+    uint64_t rq_active_{};
+    LoadMetricStats::StatMapPtr load_metrics_;
+  };
+
+  virtual LocalityLoadStat& rqSuccess() PURE;
+  virtual LocalityLoadStat& rqError() PURE;
+  virtual LocalityLoadStat& rqTotal() PURE;
+  virtual LocalityLoadStat& rqActive() PURE;
+  virtual LoadMetricStats& loadMetricStats() PURE;
+
+  /**
+   * @return the counts since the previous latch, and the current requests in progress.
+   */
+  virtual Latched latch() PURE;
+};
+
+/**
+ * The LocalityLoadStats of a cluster, per locality and priority.
+ */
+class LocalityLoadStatsMap {
+public:
+  virtual ~LocalityLoadStatsMap() = default;
+
+  using ForEachCb = std::function<void(const envoy::config::core::v3::Locality& locality,
+                                       uint32_t priority, LocalityLoadStats& stats)>;
+
+  /**
+   * @return the stats of the locality and priority, which are created on the first call and live
+   *         as long as the map. This may be called from any thread.
+   */
+  virtual LocalityLoadStats& get(const envoy::config::core::v3::Locality& locality,
+                                 uint32_t priority) PURE;
+
+  /**
+   * Calls the callback with the stats of each locality and priority created so far.
+   */
+  virtual void forEach(const ForEachCb& cb) PURE;
+};
+
 class ClusterInfo;
 
 /**
@@ -239,6 +384,32 @@ public:
   virtual Network::UpstreamTransportSocketFactory&
   resolveTransportSocketFactory(const Network::Address::InstanceConstSharedPtr& dest_address,
                                 const envoy::config::core::v3::Metadata* metadata) const PURE;
+
+  /**
+   * Base interface for attaching LbPolicy-specific data to individual hosts.
+   */
+  class HostLbPolicyData {
+  public:
+    virtual ~HostLbPolicyData() = default;
+
+    /**
+     * Called by the router when a response of the host completes, on the thread of the request.
+     * @param response_time the time from the end of the downstream request to the end of the
+     * response.
+     */
+    virtual void onResponseTime(std::chrono::microseconds) {}
+  };
+  using HostLbPolicyDataPtr = std::shared_ptr<HostLbPolicyData>;
+
+  /* Takes ownership of lb_policy_data and attaches it to the host.
+   * Must be called before the host is used across threads.
+   */
+  virtual void setLbPolicyData(HostLbPolicyDataPtr lb_policy_data) PURE;
+
+  /*
+   * @return a reference to the LbPolicyData attached to the host.
+   */
+  virtual const HostLbPolicyDataPtr& lbPolicyData() const PURE;
 };
 
 using HostDescriptionConstSharedPtr = std::shared_ptr<const HostDescription>;
@@ -300,25 +300,6 @@ public:
    * Set true to disable active health check for the host.
    */
   virtual void setDisableActiveHealthCheck(bool disable_active_health_check) PURE;
-
-  /**
-   * Base interface for attaching LbPolicy-specific data to individual hosts.
-   */
-  class HostLbPolicyData {
-  public:
-    virtual ~HostLbPolicyData() = default;
-  };
-  using HostLbPolicyDataPtr = std::shared_ptr<HostLbPolicyData>;
-
-  /* Takes ownership of lb_policy_data and attaches it to the host.
-   * Must be called before the host is used across threads.
-   */
-  virtual void setLbPolicyData(HostLbPolicyDataPtr lb_policy_data) PURE;
-
-  /*
-   * @return a reference to the LbPolicyData attached to the host.
-   */
-  virtual const HostLbPolicyDataPtr& lbPolicyData() const PURE;
 };
 
 using HostConstSharedPtr = std::shared_ptr<const Host>;
@@ -747,6 +728,8 @@ public:
   COUNTER(upstream_rq_pending_failure_eject)                                                       \
   COUNTER(upstream_rq_pending_overflow)                                                            \
   COUNTER(upstream_rq_pending_total)                                                               \
+  COUNTER(upstream_rq_preconnect_hit)                                                              \
+  COUNTER(upstream_rq_preconnect_miss)                                                             \
   COUNTER(upstream_rq_0rtt)                                                                        \
   COUNTER(upstream_rq_per_try_timeout)                                                             \
   COUNTER(upstream_rq_per_try_idle_timeout)                                                        \
@@ -761,13 +744,16 @@ public:
   COUNTER(upstream_rq_total)                                                                       \
   COUNTER(upstream_rq_tx_reset)                                                                    \
   COUNTER(upstream_http3_broken)                                                                   \
+  COUNTER(upstream_grid_http3_won)                                                                 \
+  COUNTER(upstream_grid_tcp_won)                                                                   \
   GAUGE(upstream_cx_active, Accumulate)                                                            \
   GAUGE(upstream_cx_rx_bytes_buffered, Accumulate)                                                 \
   GAUGE(upstream_cx_tx_bytes_buffered, Accumulate)                                                 \
   GAUGE(upstream_rq_active, Accumulate)                                                            \
   GAUGE(upstream_rq_pending_active, Accumulate)                                                    \
   HISTOGRAM(upstream_cx_connect_ms, Milliseconds)                                                  \
-  HISTOGRAM(upstream_cx_length_ms, Milliseconds)
+  HISTOGRAM(upstream_cx_length_ms, Milliseconds)                                                   \
+  HISTOGRAM(upstream_grid_http3_lag_ms, Milliseconds)
 
 /**
  * All cluster load report stats. These are only use for EDS load reporting and not sent to the
@@ -966,6 +952,13 @@ public:
    */
   virtual float peekaheadRatio() const PURE;
 
+  /**
+   * @return the maximum number of connections the connection pools of an upstream preconnect for
+   *         the streams predicted from their recent streams and connections, 0 if the adaptive
+   *         preconnect is disabled.
+   */
+  virtual uint32_t maxAdaptivePreconnectConnections() const PURE;
+
   /**
    * @return soft limit on size of the cluster's connections read and write buffers.
    */
@@ -1123,6 +1116,12 @@ public:
    */
   virtual ClusterLoadReportStats& loadReportStats() const PURE;
 
+  /**
+   * @return LocalityLoadStatsMap& the load report stats of the hosts of this cluster, per locality
+   *         and priority.
+   */
+  virtual LocalityLoadStatsMap& localityLoadStats() const PURE;
+
   /**
    * @return absl::optional<std::reference_wrapper<ClusterRequestResponseSizeStats>> stats to track
    * headers/body sizes of request/response for this cluster.
@@ -1,5 +1,6 @@
 #include "source/common/access_log/access_log_manager_impl.h"
 
+#include <algorithm>
 #include <string>
 
 #include "envoy/common/exception.h"
@@ -16,6 +17,14 @@ namespace {
 static constexpr Filesystem::FlagSet default_flags{1 << Filesystem::File::Operation::Write |
                                                    1 << Filesystem::File::Operation::Create |
                                                    1 << Filesystem::File::Operation::Append};
+
+// Returns the index of the calling thread among the threads which wrote an access log, so that
+// each thread keeps writing to the same write shard of the files.
+uint32_t writerIndex() {
+  static std::atomic<uint32_t> next_index{0};
+  static thread_local const uint32_t index = next_index++;
+  return index;
+}
 } // namespace
 
 AccessLogManagerImpl::~AccessLogManagerImpl() {
@@ -48,21 +57,30 @@ AccessLogManagerImpl::createAccessLog(const Filesystem::FilePathAndType& file_in
 
   access_logs_[file_name] =
       std::make_shared<AccessLogFileImpl>(std::move(file), dispatcher_, lock_, file_stats_,
-                                          file_flush_interval_msec_, api_.threadFactory());
+                                          file_options_, api_.threadFactory());
   return access_logs_[file_name];
 }
 
 AccessLogFileImpl::AccessLogFileImpl(Filesystem::FilePtr&& file, Event::Dispatcher& dispatcher,
                                      Thread::BasicLockable& lock, AccessLogFileStats& stats,
-                                     std::chrono::milliseconds flush_interval_msec,
+                                     const AccessLogFileOptions& options,
                                      Thread::ThreadFactory& thread_factory)
     : file_(std::move(file)), file_lock_(lock),
       flush_timer_(dispatcher.createTimer([this]() -> void {
         stats_.flushed_by_timer_.inc();
-        flush_event_.notifyOne();
+        {
+          Thread::LockGuard lock(write_lock_);
+          flush_event_.notifyOne();
+        }
         flush_timer_->enableTimer(flush_interval_msec_);
       })),
-      thread_factory_(thread_factory), flush_interval_msec_(flush_interval_msec), stats_(stats) {
+      thread_factory_(thread_factory), flush_interval_msec_(options.flush_interval_msec_),
+      min_flush_size_(options.min_flush_size_), max_buffered_size_(options.max_buffered_size_),
+      stats_(stats) {
+  write_shards_.reserve(std::max<uint32_t>(options.write_shards_, 1));
+  for (uint32_t i = 0; i < std::max<uint32_t>(options.write_shards_, 1); ++i) {
+    write_shards_.push_back(std::make_unique<WriteShard>());
+  }
   flush_timer_->enableTimer(flush_interval_msec_);
 }
 
@@ -85,8 +103,10 @@ AccessLogFileImpl::~AccessLogFileImpl() {
 
   // Flush any remaining data. If file was not opened for some reason, skip flushing part.
   if (file_->isOpen()) {
-    if (flush_buffer_.length() > 0) {
-      doWrite(flush_buffer_);
+    Thread::LockGuard flush_lock(flush_lock_);
+    collectWriteShards();
+    if (about_to_write_buffer_.length() > 0) {
+      doWrite(about_to_write_buffer_);
     }
     const Api::IoCallBoolResult result = file_->close();
     ASSERT(result.return_value_, fmt::format("unable to close file '{}': {}", file_->path(),
@@ -136,13 +156,13 @@ void AccessLogFileImpl::flushThreadFunc() {
     {
       Thread::LockGuard write_lock(write_lock_);
 
-      // flush_event_ can be woken up either by large enough flush_buffer or by timer.
-      // In case it was timer, flush_buffer_ can be empty.
+      // flush_event_ can be woken up either by large enough write shards or by timer.
+      // In case it was timer, the write shards can be empty.
       //
       // Note: do not stop waiting when only `do_reopen` is true. In this case, we tried to
       // reopen and failed. We don't want to retry this in a tight loop, so wait for the next
       // event (timer or flush).
-      while (flush_buffer_.length() == 0 && !flush_thread_exit_ && !reopen_file_) {
+      while (buffered_size_ == 0 && !flush_thread_exit_ && !reopen_file_) {
         // CondVar::wait() does not throw, so it's safe to pass the mutex rather than the guard.
         flush_event_.wait(write_lock_);
       }
@@ -152,8 +172,7 @@ void AccessLogFileImpl::flushThreadFunc() {
       }
 
       flush_lock = std::unique_lock<Thread::BasicLockable>(flush_lock_);
-      about_to_write_buffer_.move(flush_buffer_);
-      ASSERT(flush_buffer_.length() == 0);
+      collectWriteShards();
 
       if (reopen_file_) {
         do_reopen = true;
@@ -180,44 +199,55 @@ void AccessLogFileImpl::flushThreadFunc() {
 }
 
 void AccessLogFileImpl::flush() {
-  std::unique_lock<Thread::BasicLockable> flush_buffer_lock;
-
-  {
-    Thread::LockGuard write_lock(write_lock_);
-
-    // flush_lock_ must be held while checking this or else it is
-    // possible that flushThreadFunc() has already moved data from
-    // flush_buffer_ to about_to_write_buffer_, has unlocked write_lock_,
-    // but has not yet completed doWrite(). This would allow flush() to
-    // return before the pending data has actually been written to disk.
-    flush_buffer_lock = std::unique_lock<Thread::BasicLockable>(flush_lock_);
-
-    if (flush_buffer_.length() == 0) {
-      return;
-    }
-
-    about_to_write_buffer_.move(flush_buffer_);
-    ASSERT(flush_buffer_.length() == 0);
+  // flush_lock_ must be held while collecting the write shards or else it
+  // is possible that flushThreadFunc() has already moved their data to
+  // about_to_write_buffer_ but has not yet completed doWrite(). This would
+  // allow flush() to return before the pending data has actually been
+  // written to disk.
+  Thread::LockGuard flush_lock(flush_lock_);
+  collectWriteShards();
+  if (about_to_write_buffer_.length() == 0) {
+    return;
   }
 
   doWrite(about_to_write_buffer_);
 }
 
 void AccessLogFileImpl::write(absl::string_view data) {
-  Thread::LockGuard lock(write_lock_);
-
-  if (flush_thread_ == nullptr) {
-    createFlushStructures();
+  if (max_buffered_size_ > 0 && buffered_size_ + data.size() > max_buffered_size_) {
+    // The flush thread is falling behind, the line is dropped rather than growing the buffers.
+    stats_.write_dropped_.inc();
+    return;
   }
 
+  uint64_t buffered_size;
+  {
+    WriteShard& shard = *write_shards_[writerIndex() % write_shards_.size()];
+    Thread::LockGuard lock(shard.lock_);
+    shard.buffer_.add(data.data(), data.size());
+    buffered_size = buffered_size_ += data.size();
+  }
   stats_.write_buffered_.inc();
   stats_.write_total_buffered_.add(data.length());
-  flush_buffer_.add(data.data(), data.size());
-  if (flush_buffer_.length() > MIN_FLUSH_SIZE) {
+  // The flush thread is started once there is data, which it flushes on its first loop.
+  absl::call_once(flush_thread_once_, [this]() { createFlushStructures(); });
+
+  // Only the write crossing the flush size wakes the flush thread up, so that the writes don't
+  // contend on write_lock_.
+  if (buffered_size > min_flush_size_ && buffered_size - data.size() <= min_flush_size_) {
+    Thread::LockGuard lock(write_lock_);
     flush_event_.notifyOne();
   }
 }
 
+void AccessLogFileImpl::collectWriteShards() {
+  for (const std::unique_ptr<WriteShard>& shard : write_shards_) {
+    Thread::LockGuard lock(shard->lock_);
+    buffered_size_ -= shard->buffer_.length();
+    about_to_write_buffer_.move(shard->buffer_);
+  }
+}
+
 void AccessLogFileImpl::createFlushStructures() {
   flush_thread_ = thread_factory_.createThread([this]() -> void { flushThreadFunc(); },
                                                Thread::Options{"AccessLogFlush"});
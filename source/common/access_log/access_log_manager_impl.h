@@ -1,6 +1,8 @@
 #pragma once
 
+#include <atomic>
 #include <string>
+#include <vector>
 
 #include "envoy/access_log/access_log.h"
 #include "envoy/api/api.h"
@@ -13,6 +15,7 @@
 #include "source/common/common/logger.h"
 #include "source/common/common/thread.h"
 
+#include "absl/base/call_once.h"
 #include "absl/container/node_hash_map.h"
 
 namespace Envoy {
@@ -22,6 +25,7 @@ namespace Envoy {
   COUNTER(reopen_failed)                                                                           \
   COUNTER(write_buffered)                                                                          \
   COUNTER(write_completed)                                                                         \
+  COUNTER(write_dropped)                                                                           \
   COUNTER(write_failed)                                                                            \
   GAUGE(write_total_buffered, Accumulate)
 
@@ -31,15 +35,28 @@ struct AccessLogFileStats {
 
 namespace AccessLog {
 
+/**
+ * How the access log files buffer and flush their writes.
+ */
+struct AccessLogFileOptions {
+  // Time interval the buffered data gets flushed at, no matter if it reached min_flush_size_.
+  std::chrono::milliseconds flush_interval_msec_{10000};
+  // Size of the buffered data above which the flush thread is woken up.
+  uint64_t min_flush_size_{64 * 1024};
+  // Size of the buffered data above which the writes are dropped, or 0 if it isn't bounded.
+  uint64_t max_buffered_size_{0};
+  // Number of buffers the writes are spread over, ideally one per thread writing access logs.
+  uint32_t write_shards_{1};
+};
+
 class AccessLogManagerImpl : public AccessLogManager, Logger::Loggable<Logger::Id::main> {
 public:
-  AccessLogManagerImpl(std::chrono::milliseconds file_flush_interval_msec, Api::Api& api,
+  AccessLogManagerImpl(const AccessLogFileOptions& file_options, Api::Api& api,
                        Event::Dispatcher& dispatcher, Thread::BasicLockable& lock,
                        Stats::Store& stats_store)
-      : file_flush_interval_msec_(file_flush_interval_msec), api_(api), dispatcher_(dispatcher),
-        lock_(lock), file_stats_{
-                         ACCESS_LOG_FILE_STATS(POOL_COUNTER_PREFIX(stats_store, "filesystem."),
-                                               POOL_GAUGE_PREFIX(stats_store, "filesystem."))} {}
+      : file_options_(file_options), api_(api), dispatcher_(dispatcher), lock_(lock),
+        file_stats_{ACCESS_LOG_FILE_STATS(POOL_COUNTER_PREFIX(stats_store, "filesystem."),
+                                          POOL_GAUGE_PREFIX(stats_store, "filesystem."))} {}
   ~AccessLogManagerImpl() override;
 
   // AccessLog::AccessLogManager
@@ -48,7 +65,7 @@ public:
   createAccessLog(const Filesystem::FilePathAndType& file_info) override;
 
 private:
-  const std::chrono::milliseconds file_flush_interval_msec_;
+  const AccessLogFileOptions file_options_;
   Api::Api& api_;
   Event::Dispatcher& dispatcher_;
   Thread::BasicLockable& lock_;
@@ -62,13 +79,16 @@ private:
  * This implementation uses a flush thread per file, with the idea there aren't that many
  * files. If this turns out to be a good implementation we can potentially have a single flush
  * thread that flushes all files, but we will start with this.
+ *
+ * The writes are spread over several buffers, each thread writing to the same one, so that the
+ * workers do not contend with each other. The flush thread only holds the lock of a buffer for as
+ * long as it takes to move its slices out.
  */
 class AccessLogFileImpl : public AccessLogFile {
 public:
   AccessLogFileImpl(Filesystem::FilePtr&& file, Event::Dispatcher& dispatcher,
                     Thread::BasicLockable& lock, AccessLogFileStats& stats,
-                    std::chrono::milliseconds flush_interval_msec,
-                    Thread::ThreadFactory& thread_factory);
+                    const AccessLogFileOptions& options, Thread::ThreadFactory& thread_factory);
   ~AccessLogFileImpl() override;
 
   // AccessLog::AccessLogFile
@@ -83,19 +103,25 @@ public:
   void flush() override;
 
 private:
+  // A buffer of the writes of some of the threads.
+  struct WriteShard {
+    Thread::MutexBasicLockable lock_;
+    Buffer::OwnedImpl buffer_ ABSL_GUARDED_BY(lock_);
+  };
+
   void doWrite(Buffer::Instance& buffer);
   void flushThreadFunc();
   void createFlushStructures();
-
-  // Minimum size before the flush thread will be told to flush.
-  static const uint64_t MIN_FLUSH_SIZE = 1024 * 64;
+  // Moves the data of all the write shards to about_to_write_buffer_, with flush_lock_ held.
+  void collectWriteShards();
 
   Filesystem::FilePtr file_;
 
   // These locks are always acquired in the following order if multiple locks are held:
   //    1) write_lock_
   //    2) flush_lock_
-  //    3) file_lock_
+  //    3) the lock_ of a write shard
+  //    4) file_lock_
   Thread::BasicLockable& file_lock_;      // This lock is used only by the flush thread when writing
                                           // to disk. This is used to make sure that file blocks do
                                           // not get interleaved by multiple processes writing to
@@ -106,17 +132,18 @@ private:
                                           // and all other data used during flushing and file
                                           // re-opening.
   Thread::MutexBasicLockable
-      write_lock_; // The lock is used when filling the flush buffer. It allows
-                   // multiple threads to write to the same file at relatively
-                   // high performance. It is always local to the process.
+      write_lock_; // The lock guards the events of the flush thread. The writes only take it when
+                   // they wake the flush thread up, once enough data is buffered.
+  absl::once_flag flush_thread_once_;
   Thread::ThreadPtr flush_thread_;
   Thread::CondVar flush_event_;
   bool flush_thread_exit_ ABSL_GUARDED_BY(write_lock_){false};
   bool reopen_file_ ABSL_GUARDED_BY(write_lock_){false};
-  Buffer::OwnedImpl
-      flush_buffer_ ABSL_GUARDED_BY(write_lock_); // This buffer is used by multiple threads. It
-                                                  // gets filled and then flushed either when max
-                                                  // size is reached or when a timer fires.
+  // These buffers are filled by the threads, each one writing to the same shard, and then flushed
+  // either when min_flush_size_ is reached or when a timer fires.
+  std::vector<std::unique_ptr<WriteShard>> write_shards_;
+  // The size of the data in the write shards, only updated under the lock of a write shard.
+  std::atomic<uint64_t> buffered_size_{0};
   // TODO(jmarantz): this should be ABSL_GUARDED_BY(flush_lock_) but the analysis cannot poke
   // through the std::make_unique assignment. I do not believe it's possible to annotate this
   // properly now due to limitations in the clang thread annotation analysis.
@@ -128,8 +155,10 @@ private:
   Event::TimerPtr flush_timer_;
   Thread::ThreadFactory& thread_factory_;
   const std::chrono::milliseconds flush_interval_msec_; // Time interval buffer gets flushed no
-                                                        // matter if it reached the MIN_FLUSH_SIZE
+                                                        // matter if it reached the min_flush_size_
                                                         // or not.
+  const uint64_t min_flush_size_;
+  const uint64_t max_buffered_size_;
   AccessLogFileStats& stats_;
 };
 
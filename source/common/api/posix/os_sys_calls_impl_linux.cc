@@ -2,7 +2,9 @@
 #error "Linux platform file is part of non-Linux build."
 #endif
 
+#include <fcntl.h>
 #include <sched.h>
+#include <unistd.h>
 
 #include <cerrno>
 
@@ -17,5 +19,21 @@ SysCallIntResult LinuxOsSysCallsImpl::sched_getaffinity(pid_t pid, size_t cpuset
   return {rc, errno};
 }
 
+SysCallIntResult LinuxOsSysCallsImpl::sched_getcpu() {
+  const int rc = ::sched_getcpu();
+  return {rc, rc != -1 ? 0 : errno};
+}
+
+SysCallIntResult LinuxOsSysCallsImpl::pipe2(os_fd_t pipefd[2], int flags) {
+  const int rc = ::pipe2(pipefd, flags);
+  return {rc, rc != -1 ? 0 : errno};
+}
+
+SysCallSizeResult LinuxOsSysCallsImpl::splice(os_fd_t fd_in, loff_t* off_in, os_fd_t fd_out,
+                                              loff_t* off_out, size_t len, unsigned int flags) {
+  const ssize_t rc = ::splice(fd_in, off_in, fd_out, off_out, len, flags);
+  return {rc, rc != -1 ? 0 : errno};
+}
+
 } // namespace Api
 } // namespace Envoy
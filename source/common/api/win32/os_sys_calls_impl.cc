@@ -197,6 +197,11 @@ SysCallIntResult OsSysCallsImpl::recvmmsg(os_fd_t sockfd, struct mmsghdr* msgvec
   PANIC("not implemented");
 }
 
+SysCallIntResult OsSysCallsImpl::sendmmsg(os_fd_t sockfd, struct mmsghdr* msgvec,
+                                          unsigned int vlen, int flags) {
+  PANIC("not implemented");
+}
+
 bool OsSysCallsImpl::supportsMmsg() const {
   // Windows doesn't support it.
   return false;
@@ -232,6 +237,10 @@ SysCallPtrResult OsSysCallsImpl::mmap(void* addr, size_t length, int prot, int f
   PANIC("mmap not implemented on Windows");
 }
 
+SysCallIntResult OsSysCallsImpl::munmap(void* addr, size_t length) {
+  PANIC("munmap not implemented on Windows");
+}
+
 SysCallIntResult OsSysCallsImpl::stat(const char* pathname, struct stat* buf) {
   const int rc = ::stat(pathname, buf);
   return {rc, rc != -1 ? 0 : errno};
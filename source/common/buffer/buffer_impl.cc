@@ -66,6 +66,25 @@ void OwnedImpl::add(const Instance& data) {
   }
 }
 
+void OwnedImpl::addShared(Instance& data) {
+  ASSERT(&data != this);
+  OwnedImpl& other = static_cast<OwnedImpl&>(data);
+  for (size_t i = 0; i < other.slices_.size(); ++i) {
+    Slice& slice = other.slices_[i];
+    const uint64_t slice_size = slice.dataSize();
+    if (slice_size == 0) {
+      continue;
+    }
+    // Small slices are cheaper to copy than to share, sharing making their free space unusable.
+    if (slice_size < CopyThreshold || !slice.canShare()) {
+      addImpl(slice.data(), slice_size);
+    } else {
+      slices_.emplace_back(slice.share());
+      length_ += slice_size;
+    }
+  }
+}
+
 void OwnedImpl::prepend(absl::string_view data) {
   uint64_t size = data.size();
   bool new_slice_needed = slices_.empty();
@@ -338,10 +357,14 @@ void OwnedImpl::move(Instance& rhs, uint64_t length, bool reset_drain_trackers_a
     if (copy_size == 0) {
       other.slices_.pop_front();
     } else if (copy_size < slice_size) {
-      // TODO(brian-pane) add reference-counting to allow slices to share their storage
-      // and eliminate the copy for this partial-slice case?
-      add(other.slices_.front().data(), copy_size);
-      other.slices_.front().drain(copy_size);
+      Slice& other_slice = other.slices_.front();
+      // The front of a large slice is shared rather than copied, leaving the slice immutable.
+      if (copy_size >= CopyThreshold && other_slice.canShare()) {
+        coalesceOrAddSlice(other_slice.share(copy_size));
+      } else {
+        add(other_slice.data(), copy_size);
+      }
+      other_slice.drain(copy_size);
       other.length_ -= copy_size;
     } else {
       if (reset_drain_trackers_and_accounting) {
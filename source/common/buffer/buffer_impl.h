@@ -9,6 +9,7 @@
 #include "envoy/buffer/buffer.h"
 #include "envoy/http/stream_reset_handler.h"
 
+#include "source/common/buffer/slice_storage_pool.h"
 #include "source/common/common/assert.h"
 #include "source/common/common/non_copyable.h"
 #include "source/common/common/utility.h"
@@ -37,7 +38,7 @@ namespace Buffer {
 class Slice {
 public:
   using Reservation = RawSlice;
-  using StoragePtr = std::unique_ptr<uint8_t[]>;
+  using StoragePtr = SliceStoragePool::StoragePtr;
 
   struct SizedStorage {
     StoragePtr mem_{};
@@ -57,7 +58,7 @@ public:
    * @param account the account to charge.
    */
   Slice(uint64_t min_capacity, const BufferMemoryAccountSharedPtr& account)
-      : capacity_(sliceSize(min_capacity)), storage_(new uint8_t[capacity_]),
+      : capacity_(sliceSize(min_capacity)), storage_(SliceStoragePool::allocate(capacity_)),
         base_(storage_.get()) {
     if (account) {
       account->charge(capacity_);
@@ -104,6 +105,7 @@ public:
     drain_trackers_ = std::move(rhs.drain_trackers_);
     account_ = std::move(rhs.account_);
     releasor_.swap(rhs.releasor_);
+    shared_storage_ = std::move(rhs.shared_storage_);
 
     rhs.capacity_ = 0;
     rhs.base_ = nullptr;
@@ -114,6 +116,7 @@ public:
   Slice& operator=(Slice&& rhs) noexcept {
     if (this != &rhs) {
       callAndClearDrainTrackersAndCharges();
+      releaseOwnedStorage();
 
       capacity_ = rhs.capacity_;
       storage_ = std::move(rhs.storage_);
@@ -127,6 +130,7 @@ public:
       }
       releasor_ = rhs.releasor_;
       rhs.releasor_ = nullptr;
+      shared_storage_ = std::move(rhs.shared_storage_);
 
       rhs.capacity_ = 0;
       rhs.base_ = nullptr;
@@ -139,6 +143,7 @@ public:
 
   ~Slice() {
     callAndClearDrainTrackersAndCharges();
+    releaseOwnedStorage();
     if (releasor_) {
       releasor_();
     }
@@ -154,6 +159,39 @@ public:
    */
   bool canCoalesce() const { return storage_ != nullptr; }
 
+  /**
+   * @return true if the content of this Slice can be shared with share().
+   */
+  bool canShare() const { return storage_ != nullptr || shared_storage_ != nullptr; }
+
+  /**
+   * Create an immutable Slice sharing the content of this one, without copying it. This Slice
+   * becomes immutable too if it wasn't, so that the shared content can't change. The storage is
+   * released with the last of the slices sharing it.
+   * @return the Slice sharing the content.
+   */
+  Slice share() { return share(dataSize()); }
+
+  /**
+   * Create an immutable Slice sharing the front of the content of this one, as share() does.
+   * @param size the size in bytes of the content to share, which must not be more than dataSize().
+   * @return the Slice sharing the content.
+   */
+  Slice share(uint64_t size) {
+    ASSERT(canShare());
+    ASSERT(size <= dataSize());
+    if (storage_ != nullptr) {
+      shared_storage_ = std::make_shared<SharedStorage>(std::move(storage_), capacity_);
+    }
+    Slice shared;
+    shared.capacity_ = data_ + size;
+    shared.base_ = base_;
+    shared.data_ = data_;
+    shared.reservable_ = data_ + size;
+    shared.shared_storage_ = shared_storage_;
+    return shared;
+  }
+
   /**
    * @return a pointer to the start of the usable content.
    */
@@ -190,7 +228,7 @@ public:
    */
   uint64_t reservableSize() const {
     ASSERT(capacity_ >= reservable_);
-    return capacity_ - reservable_;
+    return isMutable() ? capacity_ - reservable_ : 0;
   }
 
   /**
@@ -215,7 +253,7 @@ public:
     // no data has been added or because all the added data has been drained, the data
     // section is at the very start of the slice.
     ASSERT(!(dataSize() == 0 && data_ > 0));
-    uint64_t available_size = capacity_ - reservable_;
+    uint64_t available_size = reservableSize();
     if (available_size == 0) {
       return {nullptr, 0};
     }
@@ -279,6 +317,10 @@ public:
    * @return number of bytes copied (may be a smaller than size, may even be zero).
    */
   uint64_t prepend(const void* data, uint64_t size) {
+    if (!isMutable()) {
+      // The space in front of the content of an immutable slice isn't its own to write to.
+      return 0;
+    }
     const uint8_t* src = static_cast<const uint8_t*>(data);
     uint64_t copy_size;
     if (dataSize() == 0) {
@@ -385,10 +427,36 @@ public:
    */
   static inline SizedStorage newStorage(uint64_t min_capacity) {
     const uint64_t slice_size = sliceSize(min_capacity);
-    return {StoragePtr{new uint8_t[slice_size]}, static_cast<size_t>(slice_size)};
+    return {SliceStoragePool::allocate(slice_size), static_cast<size_t>(slice_size)};
+  }
+
+  /**
+   * Release backend storage that was created by newStorage() but not handed to a slice.
+   * @param storage the backend storage to release.
+   */
+  static inline void releaseStorage(SizedStorage&& storage) {
+    if (storage.mem_ != nullptr) {
+      SliceStoragePool::release(std::move(storage.mem_), storage.len_);
+    }
   }
 
 protected:
+  /** The storage of slices created by share(), returned to the slice storage pool by the last. */
+  struct SharedStorage {
+    SharedStorage(StoragePtr mem, uint64_t len) : mem_(std::move(mem)), len_(len) {}
+    ~SharedStorage() { SliceStoragePool::release(std::move(mem_), len_); }
+
+    StoragePtr mem_;
+    const uint64_t len_;
+  };
+
+  /** Returns the storage owned by the slice, if any, to the slice storage pool. */
+  void releaseOwnedStorage() {
+    if (storage_ != nullptr) {
+      SliceStoragePool::release(std::move(storage_), capacity_);
+    }
+  }
+
   /** Length of the byte array that base_ points to. This is also the offset in bytes from the start
    * of the slice to the end of the Reservable section. */
   uint64_t capacity_ = 0;
@@ -416,6 +484,9 @@ protected:
 
   /** The releasor for the BufferFragment */
   std::function<void()> releasor_;
+
+  /** Storage shared with other slices, which base_ points into, if the slice was shared. */
+  std::shared_ptr<SharedStorage> shared_storage_;
 };
 
 class OwnedImpl;
@@ -675,6 +746,7 @@ public:
   void addBufferFragment(BufferFragment& fragment) override;
   void add(absl::string_view data) override;
   void add(const Instance& data) override;
+  void addShared(Instance& data) override;
   void prepend(absl::string_view data) override;
   void prepend(Instance& data) override;
   void copyOut(size_t start, uint64_t size, void* data) const override;
@@ -792,6 +864,8 @@ private:
           ASSERT(r->len_ == Slice::default_slice_size_);
           if (free_list_ref_.size() < free_list_max_) {
             free_list_ref_.push_back(std::move(r->mem_));
+          } else {
+            Slice::releaseStorage(std::move(*r));
           }
         }
       }
@@ -805,7 +879,7 @@ private:
         storage.mem_ = std::move(free_list_ref_.back());
         free_list_ref_.pop_back();
       } else {
-        storage.mem_.reset(new uint8_t[Slice::default_slice_size_]);
+        storage.mem_ = SliceStoragePool::allocate(Slice::default_slice_size_);
       }
 
       return storage;
@@ -829,6 +903,10 @@ private:
   };
 
   struct OwnedImplReservationSlicesOwnerSingle : public OwnedImplReservationSlicesOwner {
+    ~OwnedImplReservationSlicesOwnerSingle() override {
+      Slice::releaseStorage(std::move(owned_storage_));
+    }
+
     absl::Span<Slice::SizedStorage> ownedStorages() override {
       return absl::MakeSpan(&owned_storage_, 1);
     }
@@ -0,0 +1,88 @@
+#include "source/common/buffer/mapped_file.h"
+
+#include "envoy/common/platform.h"
+
+#include "source/common/api/os_sys_calls_impl.h"
+#include "source/common/common/assert.h"
+#include "source/common/common/cleanup.h"
+#include "source/common/common/fmt.h"
+#include "source/common/common/utility.h"
+
+namespace Envoy {
+namespace Buffer {
+namespace {
+
+// A fragment of a mapped file, which keeps it mapped until the fragment is drained.
+class MappedFileFragment : public BufferFragment {
+public:
+  MappedFileFragment(MappedFileConstSharedPtr file, absl::string_view data)
+      : file_(std::move(file)), data_(data) {}
+
+  // Buffer::BufferFragment
+  const void* data() const override { return data_.data(); }
+  size_t size() const override { return data_.size(); }
+  void done() override { delete this; }
+
+private:
+  const MappedFileConstSharedPtr file_;
+  const absl::string_view data_;
+};
+
+} // namespace
+
+absl::StatusOr<MappedFileConstSharedPtr> MappedFile::create(const std::string& path) {
+#ifdef WIN32
+  return absl::UnimplementedError(fmt::format("can't map {}: not supported on Windows", path));
+#else
+  auto& os_sys_calls = Api::OsSysCallsSingleton::get();
+  const Api::SysCallIntResult open_result = os_sys_calls.open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (open_result.return_value_ == -1) {
+    return absl::InvalidArgumentError(
+        fmt::format("can't open {}: {}", path, errorDetails(open_result.errno_)));
+  }
+  const os_fd_t fd = open_result.return_value_;
+  // The mapping outlives the file descriptor.
+  Cleanup close_fd([&os_sys_calls, fd] { os_sys_calls.close(fd); });
+
+  struct stat info;
+  const Api::SysCallIntResult stat_result = os_sys_calls.fstat(fd, &info);
+  if (stat_result.return_value_ == -1) {
+    return absl::InvalidArgumentError(
+        fmt::format("can't stat {}: {}", path, errorDetails(stat_result.errno_)));
+  }
+  if (!S_ISREG(info.st_mode)) {
+    return absl::InvalidArgumentError(fmt::format("can't map {}: not a regular file", path));
+  }
+  const size_t size = info.st_size;
+  if (size == 0) {
+    return MappedFileConstSharedPtr(new MappedFile(nullptr, 0));
+  }
+  const Api::SysCallPtrResult map_result =
+      os_sys_calls.mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+  if (map_result.return_value_ == MAP_FAILED) {
+    return absl::InvalidArgumentError(
+        fmt::format("can't map {}: {}", path, errorDetails(map_result.errno_)));
+  }
+  return MappedFileConstSharedPtr(new MappedFile(map_result.return_value_, size));
+#endif
+}
+
+MappedFile::~MappedFile() {
+  if (data_ != nullptr) {
+    const Api::SysCallIntResult result = Api::OsSysCallsSingleton::get().munmap(data_, size_);
+    ASSERT(result.return_value_ == 0);
+  }
+}
+
+void MappedFile::addRange(MappedFileConstSharedPtr file, uint64_t offset, uint64_t length,
+                          Instance& buffer) {
+  ASSERT(offset <= file->size_);
+  const absl::string_view data = file->data().substr(offset, length);
+  if (data.empty()) {
+    return;
+  }
+  buffer.addBufferFragment(*new MappedFileFragment(std::move(file), data));
+}
+
+} // namespace Buffer
+} // namespace Envoy
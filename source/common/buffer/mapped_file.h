@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "envoy/buffer/buffer.h"
+
+#include "source/common/common/non_copyable.h"
+
+#include "absl/status/statusor.h"
+#include "absl/strings/string_view.h"
+
+namespace Envoy {
+namespace Buffer {
+
+class MappedFile;
+using MappedFileConstSharedPtr = std::shared_ptr<const MappedFile>;
+
+/**
+ * A read-only shared mapping of a whole file, whose memory is the page cache of the file. It is
+ * meant for the large static bodies served to many requests, which can then be added to buffers
+ * without being read into memory of their own, nor copied. The writes to sockets which have
+ * SO_ZEROCOPY set send them straight from the page cache.
+ *
+ * The file must be replaced, e.g. by renaming another one over it, rather than changed in place
+ * while it is mapped: the data would change under the buffers, and reading the pages past the end
+ * of a truncated file raises SIGBUS.
+ */
+class MappedFile : NonCopyable {
+public:
+  /**
+   * Maps the file.
+   * @param path supplies the path of the file.
+   * @return the mapping, or an error if the file can't be opened or mapped.
+   */
+  static absl::StatusOr<MappedFileConstSharedPtr> create(const std::string& path);
+
+  ~MappedFile();
+
+  /**
+   * @return the contents of the file.
+   */
+  absl::string_view data() const { return {static_cast<const char*>(data_), size_}; }
+
+  /**
+   * Adds a range of the file to the buffer, without copying it. The file stays mapped until the
+   * buffers referencing it drained the range.
+   * @param file supplies the mapped file.
+   * @param offset supplies the offset of the range, which must be within the file.
+   * @param length supplies the length of the range, which is cut at the end of the file.
+   * @param buffer supplies the buffer to add the range to.
+   */
+  static void addRange(MappedFileConstSharedPtr file, uint64_t offset, uint64_t length,
+                       Instance& buffer);
+
+private:
+  MappedFile(void* data, size_t size) : data_(data), size_(size) {}
+
+  // Null for an empty file, which can't be mapped.
+  void* const data_;
+  const size_t size_;
+};
+
+} // namespace Buffer
+} // namespace Envoy
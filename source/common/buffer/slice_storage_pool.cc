@@ -0,0 +1,173 @@
+#include "source/common/buffer/slice_storage_pool.h"
+
+#include <array>
+#include <atomic>
+#include <vector>
+
+#include "source/common/common/assert.h"
+#include "source/common/common/macros.h"
+#include "source/common/memory/accounting.h"
+
+#include "absl/container/flat_hash_set.h"
+#include "absl/synchronization/mutex.h"
+
+namespace Envoy {
+namespace Buffer {
+namespace {
+
+constexpr size_t NumSizeClasses = SliceStoragePool::MaxCachedSize / SliceStoragePool::PageSize;
+
+std::atomic<uint64_t> max_cached_bytes_per_thread{0};
+
+bool cacheable(uint64_t size) {
+  return size != 0 && size <= SliceStoragePool::MaxCachedSize &&
+         size % SliceStoragePool::PageSize == 0;
+}
+
+size_t sizeClass(uint64_t size) { return size / SliceStoragePool::PageSize - 1; }
+
+class ThreadCache;
+
+// Set once the cache of the thread is destroyed. It is trivially destructible, so it remains
+// accessible until the thread exits.
+thread_local bool cache_destroyed = false;
+
+// Keeps track of the caches of all the threads so that their statistics can be aggregated.
+struct Registry {
+  absl::Mutex mutex_;
+  absl::flat_hash_set<const ThreadCache*> caches_ ABSL_GUARDED_BY(mutex_);
+  // Statistics of the caches of the threads that exited.
+  SliceStoragePool::Stats retired_ ABSL_GUARDED_BY(mutex_);
+};
+
+// Never destroyed, as thread caches may be destroyed at process exit after static destructors ran.
+Registry& cacheRegistry() { MUTABLE_CONSTRUCT_ON_FIRST_USE(Registry); }
+
+void accumulate(SliceStoragePool::Stats& total, const SliceStoragePool::Stats& stats) {
+  total.hits_ += stats.hits_;
+  total.misses_ += stats.misses_;
+  total.overflows_ += stats.overflows_;
+  total.cached_bytes_ += stats.cached_bytes_;
+}
+
+class ThreadCache {
+public:
+  ThreadCache() {
+    Registry& registry = cacheRegistry();
+    absl::MutexLock lock(&registry.mutex_);
+    registry.caches_.insert(this);
+  }
+
+  ~ThreadCache() {
+    // Objects destroyed after the cache during thread exit free their storage directly.
+    cache_destroyed = true;
+    clear();
+    Registry& registry = cacheRegistry();
+    absl::MutexLock lock(&registry.mutex_);
+    accumulate(registry.retired_, stats());
+    registry.caches_.erase(this);
+  }
+
+  SliceStoragePool::StoragePtr allocate(uint64_t size) {
+    auto& free_list = free_lists_[sizeClass(size)];
+    if (free_list.empty()) {
+      increment(misses_, 1);
+      return SliceStoragePool::StoragePtr(new uint8_t[size]);
+    }
+    SliceStoragePool::StoragePtr storage = std::move(free_list.back());
+    free_list.pop_back();
+    increment(hits_, 1);
+    decrement(cached_bytes_, size);
+    return storage;
+  }
+
+  void release(SliceStoragePool::StoragePtr storage, uint64_t size, uint64_t max_cached_bytes) {
+    if (cached_bytes_.load(std::memory_order_relaxed) + size > max_cached_bytes) {
+      increment(overflows_, 1);
+      return;
+    }
+    free_lists_[sizeClass(size)].push_back(std::move(storage));
+    increment(cached_bytes_, size);
+  }
+
+  void clear() {
+    for (auto& free_list : free_lists_) {
+      free_list.clear();
+    }
+    cached_bytes_.store(0, std::memory_order_relaxed);
+  }
+
+  // May be called from any thread.
+  SliceStoragePool::Stats stats() const {
+    return {hits_.load(std::memory_order_relaxed), misses_.load(std::memory_order_relaxed),
+            overflows_.load(std::memory_order_relaxed),
+            cached_bytes_.load(std::memory_order_relaxed)};
+  }
+
+private:
+  // The counters are only written by the thread owning the cache, so there is no need for atomic
+  // read-modify-write operations. They are atomic so that they can be read from other threads.
+  static void increment(std::atomic<uint64_t>& counter, uint64_t value) {
+    counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+  }
+  static void decrement(std::atomic<uint64_t>& counter, uint64_t value) {
+    counter.store(counter.load(std::memory_order_relaxed) - value, std::memory_order_relaxed);
+  }
+
+  std::array<std::vector<SliceStoragePool::StoragePtr>, NumSizeClasses> free_lists_;
+  std::atomic<uint64_t> hits_{0};
+  std::atomic<uint64_t> misses_{0};
+  std::atomic<uint64_t> overflows_{0};
+  std::atomic<uint64_t> cached_bytes_{0};
+};
+
+ThreadCache& threadCache() {
+  static thread_local ThreadCache cache;
+  return cache;
+}
+
+} // namespace
+
+void SliceStoragePool::setMaxCachedBytesPerThread(uint64_t max_cached_bytes) {
+  max_cached_bytes_per_thread.store(max_cached_bytes, std::memory_order_relaxed);
+}
+
+uint64_t SliceStoragePool::maxCachedBytesPerThread() {
+  return max_cached_bytes_per_thread.load(std::memory_order_relaxed);
+}
+
+SliceStoragePool::StoragePtr SliceStoragePool::allocate(uint64_t size) {
+  // The storage held by the caches isn't charged, as it is reported by their statistics.
+  Memory::Accounting::charge(Memory::Subsystem::Buffers, size);
+  if (maxCachedBytesPerThread() == 0 || !cacheable(size) || cache_destroyed) {
+    return StoragePtr(new uint8_t[size]);
+  }
+  return threadCache().allocate(size);
+}
+
+void SliceStoragePool::release(StoragePtr storage, uint64_t size) {
+  ASSERT(storage != nullptr);
+  Memory::Accounting::credit(Memory::Subsystem::Buffers, size);
+  const uint64_t max_cached_bytes = maxCachedBytesPerThread();
+  if (max_cached_bytes == 0 || !cacheable(size) || cache_destroyed) {
+    return;
+  }
+  threadCache().release(std::move(storage), size, max_cached_bytes);
+}
+
+SliceStoragePool::Stats SliceStoragePool::threadStats() { return threadCache().stats(); }
+
+SliceStoragePool::Stats SliceStoragePool::stats() {
+  Registry& registry = cacheRegistry();
+  absl::MutexLock lock(&registry.mutex_);
+  Stats total = registry.retired_;
+  for (const ThreadCache* cache : registry.caches_) {
+    accumulate(total, cache->stats());
+  }
+  return total;
+}
+
+void SliceStoragePool::clearThreadCache() { threadCache().clear(); }
+
+} // namespace Buffer
+} // namespace Envoy
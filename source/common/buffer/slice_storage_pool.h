@@ -0,0 +1,84 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+
+namespace Envoy {
+namespace Buffer {
+
+/**
+ * Per-thread cache of the storage of buffer slices, organized by size class. Slices release their
+ * storage to the cache of the thread that destroys them, and slices allocate their storage from
+ * the cache of the thread that creates them, so that storage churns through a free list owned by
+ * the worker instead of the allocator's shared free lists.
+ *
+ * Only storage sizes that are a multiple of PageSize and at most MaxCachedSize are cached. The
+ * amount of memory held by the cache of each thread is bounded by maxCachedBytesPerThread(),
+ * which is 0, i.e. caching is disabled, by default.
+ */
+class SliceStoragePool {
+public:
+  using StoragePtr = std::unique_ptr<uint8_t[]>;
+
+  static constexpr uint64_t PageSize = 4096;
+  static constexpr uint64_t MaxCachedSize = 16 * PageSize;
+
+  /**
+   * Statistics of the pool. All values but cached_bytes_ are cumulative.
+   */
+  struct Stats {
+    // Allocations served from the cache.
+    uint64_t hits_{};
+    // Allocations of a cacheable size that were served by the heap.
+    uint64_t misses_{};
+    // Releases of a cacheable size that were freed because the cache was full.
+    uint64_t overflows_{};
+    // Bytes currently held by the caches.
+    uint64_t cached_bytes_{};
+  };
+
+  /**
+   * Sets the maximum number of bytes that the cache of each thread may hold. Setting it to 0
+   * disables caching. This is meant to be called once at startup, before any worker thread is
+   * started; caches holding more memory than a lowered limit only shrink as they are used.
+   */
+  static void setMaxCachedBytesPerThread(uint64_t max_cached_bytes);
+
+  /**
+   * @return the maximum number of bytes that the cache of each thread may hold.
+   */
+  static uint64_t maxCachedBytesPerThread();
+
+  /**
+   * Allocates slice storage, from the cache of the current thread when possible.
+   * @param size supplies the size of the storage.
+   * @return StoragePtr uninitialized storage of the requested size.
+   */
+  static StoragePtr allocate(uint64_t size);
+
+  /**
+   * Releases slice storage allocated with allocate() to the cache of the current thread, or frees
+   * it if it is not cacheable or the cache is full.
+   * @param storage supplies the storage to release.
+   * @param size supplies the size the storage was allocated with.
+   */
+  static void release(StoragePtr storage, uint64_t size);
+
+  /**
+   * @return Stats the statistics of the cache of the current thread.
+   */
+  static Stats threadStats();
+
+  /**
+   * @return Stats the statistics of the caches of all the threads, including exited ones.
+   */
+  static Stats stats();
+
+  /**
+   * Frees all the storage held by the cache of the current thread.
+   */
+  static void clearThreadCache();
+};
+
+} // namespace Buffer
+} // namespace Envoy
@@ -1,5 +1,6 @@
 #include "source/common/buffer/watermark_buffer.h"
 
+#include <algorithm>
 #include <cstdint>
 #include <memory>
 
@@ -7,6 +8,7 @@
 
 #include "source/common/common/assert.h"
 #include "source/common/common/logger.h"
+#include "source/common/memory/accounting.h"
 #include "source/common/runtime/runtime_features.h"
 
 namespace Envoy {
@@ -35,6 +37,11 @@ void WatermarkBuffer::add(const Instance& data) {
   checkHighAndOverflowWatermarks();
 }
 
+void WatermarkBuffer::addShared(Instance& data) {
+  OwnedImpl::addShared(data);
+  checkHighAndOverflowWatermarks();
+}
+
 void WatermarkBuffer::prepend(absl::string_view data) {
   OwnedImpl::prepend(data);
   checkHighAndOverflowWatermarks();
@@ -204,6 +211,11 @@ void WatermarkBufferFactory::unregisterAccount(const BufferMemoryAccountSharedPt
 uint64_t WatermarkBufferFactory::resetAccountsGivenPressure(float pressure) {
   ASSERT(pressure >= 0.0 && pressure <= 1.0, "Provided pressure is out of range [0, 1].");
 
+  // When some tenants are over their budget, only their accounts are reset.
+  const bool isolate_tenants = std::any_of(
+      tenants_.begin(), tenants_.end(),
+      [this](const BufferMemoryTenantEntry& tenant) { return overBudget(tenant.second); });
+
   // Compute buckets to clear
   const uint32_t buckets_to_clear = std::min<uint32_t>(
       std::floor(pressure * BufferMemoryAccountImpl::NUM_MEMORY_CLASSES_) + 1, 8);
@@ -225,6 +237,11 @@ uint64_t WatermarkBufferFactory::resetAccountsGivenPressure(float pressure) {
     auto it = bucket.begin();
     while (it != bucket.end() && num_streams_reset < kMaxNumberOfStreamsToResetPerInvocation) {
       auto next = std::next(it);
+      if (isolate_tenants &&
+          !static_cast<const BufferMemoryAccountImpl&>(**it).tenantOverBudget()) {
+        it = next;
+        continue;
+      }
       // This will trigger an erase, which avoids rehashing and invalidates the
       // iterator *it*. *next* is still valid.
       (*it)->resetDownstream();
@@ -239,17 +256,48 @@ uint64_t WatermarkBufferFactory::resetAccountsGivenPressure(float pressure) {
   return num_streams_reset;
 }
 
+BufferMemoryTenantEntry* WatermarkBufferFactory::acquireTenant(absl::string_view virtual_host_name,
+                                                               absl::string_view route_name) {
+  absl::string_view name;
+  switch (tenant_kind_) {
+  case envoy::config::overload::v3::BufferFactoryConfig::VIRTUAL_HOST:
+    name = virtual_host_name;
+    break;
+  case envoy::config::overload::v3::BufferFactoryConfig::ROUTE:
+    name = route_name;
+    break;
+  default:
+    break;
+  }
+  if (name.empty()) {
+    return nullptr;
+  }
+  BufferMemoryTenantEntry& tenant = *tenants_.try_emplace(name).first;
+  ++tenant.second.accounts_;
+  return &tenant;
+}
+
+void WatermarkBufferFactory::releaseTenant(BufferMemoryTenantEntry& tenant) {
+  ASSERT(tenant.second.accounts_ > 0);
+  if (--tenant.second.accounts_ == 0) {
+    ASSERT(tenant.second.balance_ == 0);
+    tenants_.erase(tenant.first);
+  }
+}
+
 WatermarkBufferFactory::WatermarkBufferFactory(
     const envoy::config::overload::v3::BufferFactoryConfig& config)
     : bitshift_(config.minimum_account_to_track_power_of_two()
                     ? config.minimum_account_to_track_power_of_two() - 1
-                    : kEffectivelyDisableTrackingBitshift) {}
+                    : kEffectivelyDisableTrackingBitshift),
+      tenant_kind_(config.tenant()), tenant_memory_budget_(config.tenant_memory_budget_bytes()) {}
 
 WatermarkBufferFactory::~WatermarkBufferFactory() {
   for (auto& account_set : size_class_account_sets_) {
     ASSERT(account_set.empty(),
            "Expected all Accounts to have unregistered from the Watermark Factory.");
   }
+  ASSERT(tenants_.empty(), "Expected all Accounts to have released their tenant.");
 }
 
 BufferMemoryAccountSharedPtr
@@ -287,6 +335,10 @@ void BufferMemoryAccountImpl::updateAccountClass() {
 void BufferMemoryAccountImpl::credit(uint64_t amount) {
   ASSERT(buffer_memory_allocated_ >= amount);
   buffer_memory_allocated_ -= amount;
+  if (tenant_ != nullptr) {
+    tenant_->second.balance_ -= amount;
+  }
+  Memory::Accounting::credit(Memory::Subsystem::BufferAccounts, amount);
   updateAccountClass();
 }
 
@@ -294,12 +346,42 @@ void BufferMemoryAccountImpl::charge(uint64_t amount) {
   // Check overflow
   ASSERT(std::numeric_limits<uint64_t>::max() - buffer_memory_allocated_ >= amount);
   buffer_memory_allocated_ += amount;
+  if (tenant_ != nullptr) {
+    tenant_->second.balance_ += amount;
+  }
+  Memory::Accounting::charge(Memory::Subsystem::BufferAccounts, amount);
   updateAccountClass();
 }
 
+void BufferMemoryAccountImpl::setRoute(absl::string_view virtual_host_name,
+                                       absl::string_view route_name) {
+  if (!reset_handler_.has_value()) {
+    return;
+  }
+  BufferMemoryTenantEntry* tenant = factory_->acquireTenant(virtual_host_name, route_name);
+  if (tenant != nullptr) {
+    tenant->second.balance_ += buffer_memory_allocated_;
+  }
+  releaseTenant();
+  tenant_ = tenant;
+}
+
+bool BufferMemoryAccountImpl::tenantOverBudget() const {
+  return tenant_ != nullptr && factory_->overBudget(tenant_->second);
+}
+
+void BufferMemoryAccountImpl::releaseTenant() {
+  if (tenant_ != nullptr) {
+    tenant_->second.balance_ -= buffer_memory_allocated_;
+    factory_->releaseTenant(*tenant_);
+    tenant_ = nullptr;
+  }
+}
+
 void BufferMemoryAccountImpl::clearDownstream() {
   if (reset_handler_.has_value()) {
     reset_handler_.reset();
+    releaseTenant();
     factory_->unregisterAccount(shared_this_, current_bucket_idx_);
     current_bucket_idx_.reset();
     shared_this_ = nullptr;
@@ -2,6 +2,7 @@
 
 #include <functional>
 #include <string>
+#include <utility>
 
 #include "envoy/buffer/buffer.h"
 #include "envoy/common/optref.h"
@@ -9,6 +10,8 @@
 
 #include "source/common/buffer/buffer_impl.h"
 
+#include "absl/container/node_hash_map.h"
+
 namespace Envoy {
 namespace Buffer {
 
@@ -32,6 +35,7 @@ public:
   void add(const void* data, uint64_t size) override;
   void add(absl::string_view data) override;
   void add(const Instance& data) override;
+  void addShared(Instance& data) override;
   void prepend(absl::string_view data) override;
   void prepend(Instance& data) override;
   size_t addFragments(absl::Span<const absl::string_view> fragments) override;
@@ -80,6 +84,16 @@ using WatermarkBufferPtr = std::unique_ptr<WatermarkBuffer>;
 
 class WatermarkBufferFactory;
 
+// The memory held in buffers by the streams of a tenant, e.g. of a virtual host, on a worker.
+struct BufferMemoryTenant {
+  uint64_t balance_ = 0;
+  // The number of accounts accounted to the tenant.
+  uint32_t accounts_ = 0;
+};
+
+// The tenants are keyed by their name.
+using BufferMemoryTenantEntry = std::pair<const std::string, BufferMemoryTenant>;
+
 /**
  * A BufferMemoryAccountImpl tracks allocated bytes across associated buffers and
  * slices that originate from those buffers, or are untagged and pass through an
@@ -125,6 +139,11 @@ public:
     }
   }
 
+  void setRoute(absl::string_view virtual_host_name, absl::string_view route_name) override;
+
+  // Whether the tenant of the account holds more memory than its budget.
+  bool tenantOverBudget() const;
+
   // The number of memory classes the Account expects to exists. See
   // *WatermarkBufferFactory* for details on the memory classes.
   static constexpr uint32_t NUM_MEMORY_CLASSES_ = 8;
@@ -139,12 +158,17 @@ private:
   // Returned class index, if present, is in the range [0, NUM_MEMORY_CLASSES_).
   absl::optional<uint32_t> balanceToClassIndex();
   void updateAccountClass();
+  // Moves the balance of the account out of its tenant, if any, and releases the tenant.
+  void releaseTenant();
 
   uint64_t buffer_memory_allocated_ = 0;
   // Current bucket index where the account is being tracked in.
   absl::optional<uint32_t> current_bucket_idx_{};
 
   WatermarkBufferFactory* factory_ = nullptr;
+  // The tenant which the balance of the account is also accounted to, if any. It is released
+  // when clearing the downstream.
+  BufferMemoryTenantEntry* tenant_ = nullptr;
 
   OptRef<Http::StreamResetHandler> reset_handler_;
   // Keep a copy of the shared_ptr pointing to this account. We opted to go this
@@ -185,6 +209,11 @@ private:
  * TODO(kbaichoo): Update this documentation when we make the minimum account
  * threshold configurable.
  *
+ * The balances of the accounts may also be summed per tenant, i.e. per virtual
+ * host or route of their stream, as configured. When some tenants hold more than
+ * their budget, only the tracked accounts of those tenants are reset under
+ * pressure, so that the streams of the other tenants are spared.
+ *
  */
 class WatermarkBufferFactory : public WatermarkFactory {
 public:
@@ -214,6 +243,17 @@ public:
   virtual void unregisterAccount(const BufferMemoryAccountSharedPtr& account,
                                  absl::optional<uint32_t> current_class);
 
+  // Returns the tenant of the streams of the route, counting one more account in it, or nullptr
+  // if the streams of the route aren't accounted to any tenant.
+  BufferMemoryTenantEntry* acquireTenant(absl::string_view virtual_host_name,
+                                         absl::string_view route_name);
+  // Counts one less account in the tenant, which must not hold any balance of the account.
+  void releaseTenant(BufferMemoryTenantEntry& tenant);
+
+  bool overBudget(const BufferMemoryTenant& tenant) const {
+    return tenant_memory_budget_ != 0 && tenant.balance_ > tenant_memory_budget_;
+  }
+
 protected:
   // Enable subclasses to inspect the mapping.
   using MemoryClassesToAccountsSet = std::array<absl::flat_hash_set<BufferMemoryAccountSharedPtr>,
@@ -222,6 +262,11 @@ protected:
   // How much to bit shift right balances to test whether the account should be
   // tracked in *size_class_account_sets_*.
   const uint32_t bitshift_;
+  const envoy::config::overload::v3::BufferFactoryConfig::Tenant tenant_kind_;
+  // The budget of each tenant, or zero if the tenants have no budget.
+  const uint64_t tenant_memory_budget_;
+  // The node hash map keeps the entries at stable addresses for the accounts pointing to them.
+  absl::node_hash_map<std::string, BufferMemoryTenant> tenants_;
 };
 
 } // namespace Buffer
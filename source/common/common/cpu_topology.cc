@@ -0,0 +1,143 @@
+#include "source/common/common/cpu_topology.h"
+
+#include <algorithm>
+
+#include "source/common/common/logger.h"
+#include "source/common/common/macros.h"
+
+#include "absl/strings/numbers.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_split.h"
+#include "absl/strings/strip.h"
+
+#if defined(__linux__)
+#include <sched.h>
+
+#include "source/common/api/os_sys_calls_impl_linux.h"
+#endif
+
+namespace Envoy {
+namespace {
+
+#if defined(__linux__)
+constexpr absl::string_view NumaNodeDirectory = "/sys/devices/system/node";
+#endif
+
+// An upper bound on the size of a list, so that a bogus range does not exhaust the memory.
+constexpr uint32_t MaxListSize = 1 << 16;
+
+} // namespace
+
+CpuTopology::CpuTopology(std::vector<uint32_t> cpus,
+                         absl::flat_hash_map<uint32_t, uint32_t> numa_nodes)
+    : cpus_(std::move(cpus)), numa_nodes_(std::move(numa_nodes)) {
+  std::sort(cpus_.begin(), cpus_.end());
+}
+
+CpuTopology CpuTopology::discover(Filesystem::Instance& file_system) {
+#if defined(__linux__)
+  std::vector<uint32_t> cpus;
+  cpu_set_t mask;
+  const Api::SysCallIntResult result =
+      Api::LinuxOsSysCallsSingleton::get().sched_getaffinity(0, sizeof(mask), &mask);
+  if (result.return_value_ == -1) {
+    ENVOY_LOG_MISC(warn, "failed to get the CPU affinity of the process: errno={}", result.errno_);
+    return {};
+  }
+  for (uint32_t cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+    if (CPU_ISSET(cpu, &mask)) {
+      cpus.push_back(cpu);
+    }
+  }
+
+  // Systems without NUMA support have no node directory, all their CPUs are then in node 0.
+  absl::flat_hash_map<uint32_t, uint32_t> numa_nodes;
+  const absl::StatusOr<std::string> online =
+      file_system.fileReadToEnd(absl::StrCat(NumaNodeDirectory, "/online"));
+  const absl::optional<std::vector<uint32_t>> nodes =
+      online.ok() ? parseList(online.value()) : absl::nullopt;
+  if (nodes.has_value()) {
+    for (const uint32_t node : nodes.value()) {
+      const absl::StatusOr<std::string> cpu_list =
+          file_system.fileReadToEnd(absl::StrCat(NumaNodeDirectory, "/node", node, "/cpulist"));
+      const absl::optional<std::vector<uint32_t>> node_cpus =
+          cpu_list.ok() ? parseList(cpu_list.value()) : absl::nullopt;
+      if (!node_cpus.has_value()) {
+        ENVOY_LOG_MISC(debug, "failed to read the CPUs of NUMA node {}", node);
+        continue;
+      }
+      for (const uint32_t cpu : node_cpus.value()) {
+        numa_nodes.emplace(cpu, node);
+      }
+    }
+  }
+  return {std::move(cpus), std::move(numa_nodes)};
+#else
+  UNREFERENCED_PARAMETER(file_system);
+  return {};
+#endif
+}
+
+absl::optional<std::vector<uint32_t>> CpuTopology::parseList(absl::string_view list) {
+  std::vector<uint32_t> values;
+  list = absl::StripAsciiWhitespace(list);
+  if (list.empty()) {
+    return values;
+  }
+  for (const absl::string_view range : absl::StrSplit(list, ',')) {
+    const size_t dash = range.find('-');
+    uint32_t first;
+    uint32_t last;
+    if (!absl::SimpleAtoi(range.substr(0, dash), &first)) {
+      return absl::nullopt;
+    }
+    if (dash == absl::string_view::npos) {
+      last = first;
+    } else if (!absl::SimpleAtoi(range.substr(dash + 1), &last)) {
+      return absl::nullopt;
+    }
+    if (last < first || values.size() + (last - first) >= MaxListSize) {
+      return absl::nullopt;
+    }
+    for (uint64_t value = first; value <= last; ++value) {
+      values.push_back(static_cast<uint32_t>(value));
+    }
+  }
+  std::sort(values.begin(), values.end());
+  values.erase(std::unique(values.begin(), values.end()), values.end());
+  return values;
+}
+
+absl::optional<uint32_t> CpuTopology::currentCpu() {
+#if defined(__linux__)
+  const Api::SysCallIntResult result = Api::LinuxOsSysCallsSingleton::get().sched_getcpu();
+  if (result.return_value_ >= 0) {
+    return result.return_value_;
+  }
+#endif
+  return absl::nullopt;
+}
+
+uint32_t CpuTopology::numaNode(uint32_t cpu) const {
+  const auto it = numa_nodes_.find(cpu);
+  return it != numa_nodes_.end() ? it->second : 0;
+}
+
+std::vector<uint32_t> CpuTopology::numaNodes() const {
+  std::vector<uint32_t> nodes;
+  for (const uint32_t cpu : cpus_) {
+    nodes.push_back(numaNode(cpu));
+  }
+  std::sort(nodes.begin(), nodes.end());
+  nodes.erase(std::unique(nodes.begin(), nodes.end()), nodes.end());
+  return nodes;
+}
+
+absl::optional<uint32_t> CpuTopology::workerCpu(uint32_t worker_index) const {
+  if (cpus_.empty()) {
+    return absl::nullopt;
+  }
+  return cpus_[worker_index % cpus_.size()];
+}
+
+} // namespace Envoy
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "envoy/filesystem/filesystem.h"
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/optional.h"
+
+namespace Envoy {
+
+/**
+ * The CPUs that the process may run on, and the NUMA nodes they belong to.
+ */
+class CpuTopology {
+public:
+  CpuTopology() = default;
+  CpuTopology(std::vector<uint32_t> cpus, absl::flat_hash_map<uint32_t, uint32_t> numa_nodes);
+
+  /**
+   * Discovers the CPUs in the affinity mask of the process and, on Linux, the NUMA nodes they
+   * belong to from sysfs. Nothing is discovered on other platforms.
+   * @param file_system supplies the file system to read sysfs from.
+   */
+  static CpuTopology discover(Filesystem::Instance& file_system);
+
+  /**
+   * Parses a list of CPUs or NUMA nodes in the format used by the kernel, e.g. "0-3,8,10-11".
+   * @return the sorted list, or absl::nullopt if the list is malformed.
+   */
+  static absl::optional<std::vector<uint32_t>> parseList(absl::string_view list);
+
+  /**
+   * @return the CPU that the calling thread runs on, or absl::nullopt if it is not known.
+   */
+  static absl::optional<uint32_t> currentCpu();
+
+  /**
+   * @return the sorted CPUs that the process may run on.
+   */
+  const std::vector<uint32_t>& cpus() const { return cpus_; }
+
+  /**
+   * @return the NUMA node of a CPU. CPUs whose node is not known belong to node 0.
+   */
+  uint32_t numaNode(uint32_t cpu) const;
+
+  /**
+   * @return the sorted NUMA nodes that the CPUs of the process belong to.
+   */
+  std::vector<uint32_t> numaNodes() const;
+
+  /**
+   * Workers are assigned the CPUs of the process round robin, in the order of their indexes.
+   * @return the CPU of the worker with the given index, or absl::nullopt if no CPU is known.
+   */
+  absl::optional<uint32_t> workerCpu(uint32_t worker_index) const;
+
+private:
+  std::vector<uint32_t> cpus_;
+  absl::flat_hash_map<uint32_t, uint32_t> numa_nodes_;
+};
+
+} // namespace Envoy
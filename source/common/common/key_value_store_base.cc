@@ -55,7 +55,12 @@ KeyValueStoreBase::KeyValueStoreBase(Event::Dispatcher& dispatcher,
   }
 }
 
-bool KeyValueStoreBase::parseContents(absl::string_view contents) {
+bool KeyValueStoreBase::parseContents(absl::string_view contents, uint64_t* records) {
+  parsing_ = true;
+  absl::Cleanup restore_parsing = [this] { parsing_ = false; };
+  if (records != nullptr) {
+    *records = 0;
+  }
   std::string error;
   while (!contents.empty()) {
     absl::optional<absl::string_view> key = getToken(contents, error);
@@ -82,9 +87,16 @@ bool KeyValueStoreBase::parseContents(absl::string_view contents) {
       ttl.emplace(std::chrono::duration_cast<std::chrono::seconds>(
           std::chrono::time_point<std::chrono::system_clock>(std::chrono::seconds(ttl_int)) -
           time_source_.systemTime()));
-      if (ttl <= std::chrono::seconds(0)) {
-        continue;
-      }
+    }
+    if (records != nullptr) {
+      ++*records;
+    }
+    if (ttl && ttl <= std::chrono::seconds(0)) {
+      // The pair expired, or records the removal of its key.
+      const std::string expired_key(key.value());
+      ttl_manager_.clear(expired_key);
+      store_.erase(expired_key);
+      continue;
     }
     addOrUpdate(key.value(), value.value(), ttl);
   }
@@ -119,7 +131,13 @@ void KeyValueStoreBase::addOrUpdate(absl::string_view key_view, absl::string_vie
   if (ttl) {
     ttl_manager_.add(std::chrono::milliseconds(ttl.value()), key);
   }
+  if (!parsing_) {
+    onUpdated(key, &value_with_ttl);
+  }
   if (max_entries_ && store_.size() > max_entries_) {
+    if (!parsing_) {
+      onUpdated(store_.begin()->first, nullptr);
+    }
     store_.pop_front();
   }
 
@@ -141,7 +159,9 @@ void KeyValueStoreBase::onExpiredKeys(const std::vector<std::string>& keys) {
 void KeyValueStoreBase::remove(absl::string_view key) {
   ENVOY_BUG(!under_iterate_, "remove under the stack of iterate");
   ttl_manager_.clear(std::string(key));
-  store_.erase(std::string(key));
+  if (store_.erase(std::string(key)) > 0) {
+    onUpdated(std::string(key), nullptr);
+  }
   if (!flush_timer_->enabled()) {
     flush();
   }
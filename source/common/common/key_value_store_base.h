@@ -25,9 +25,11 @@ public:
 
   // If |contents| is in the form of
   // [length]\n[key][length]\n[value]
-  // parses key value pairs from |contents| and inserts into store_.
+  // parses key value pairs from |contents| and inserts into store_. A pair replaces
+  // the earlier ones of its key, and a pair whose TTL has passed removes its key.
+  // If |records| is not null, it is set to the number of pairs parsed.
   // Returns true on success and false on failure.
-  bool parseContents(absl::string_view contents);
+  bool parseContents(absl::string_view contents, uint64_t* records = nullptr);
   // Callback function for ttlManager.
   void onExpiredKeys(const std::vector<std::string>& keys);
 
@@ -51,11 +53,18 @@ protected:
 
   const KeyValueMap& store() { return store_; }
 
+  // Called when the entry of |key| is added or updated, or removed when |value| is
+  // nullptr, other than by parseContents() or by the expiry of its TTL. Lets
+  // subclasses record the changes between flushes instead of serializing the whole
+  // store on each flush.
+  virtual void onUpdated(const std::string&, const ValueWithTtl*) {}
+
 private:
   const uint32_t max_entries_;
   const Event::TimerPtr flush_timer_;
   Config::TtlManager ttl_manager_;
   KeyValueMap store_;
+  bool parsing_{};
   // Used for validation only.
   mutable bool under_iterate_{};
   TimeSource& time_source_;
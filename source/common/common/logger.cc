@@ -78,22 +78,63 @@ void StderrSinkDelegate::flush() {
 }
 
 void DelegatingLogSink::set_formatter(std::unique_ptr<spdlog::formatter> formatter) {
+  static std::atomic<uint64_t> next_formatter_version{1};
   absl::MutexLock lock(&format_mutex_);
   formatter_ = std::move(formatter);
+  formatter_version_.store(formatter_ == nullptr ? 0 : next_formatter_version++,
+                           std::memory_order_release);
 }
 
-void DelegatingLogSink::log(const spdlog::details::log_msg& msg) {
-  absl::ReleasableMutexLock lock(&format_mutex_);
-  absl::string_view msg_view = absl::string_view(msg.payload.data(), msg.payload.size());
+namespace {
+
+// The copy of the formatter of the sink kept by a thread.
+struct ThreadFormatter {
+  ~ThreadFormatter() { destroyed() = true; }
+
+  // It is trivially destructible, so it remains accessible until the thread exits.
+  static bool& destroyed() {
+    static thread_local bool destroyed = false;
+    return destroyed;
+  }
+
+  uint64_t version_{0};
+  std::unique_ptr<spdlog::formatter> formatter_;
+};
 
+} // namespace
+
+absl::string_view DelegatingLogSink::format(const spdlog::details::log_msg& msg,
+                                            spdlog::memory_buf_t& formatted) {
+  if (ThreadFormatter::destroyed()) {
+    // The thread is exiting, so it formats with the formatter of the sink.
+    absl::MutexLock lock(&format_mutex_);
+    if (formatter_ == nullptr) {
+      return {msg.payload.data(), msg.payload.size()};
+    }
+    formatter_->format(msg, formatted);
+    return {formatted.data(), formatted.size()};
+  }
+
+  // The formatters aren't thread safe, e.g. they cache the formatted time, so each thread formats
+  // with a copy of its own rather than serializing on the formatter of the sink.
+  static thread_local ThreadFormatter thread_formatter;
+  if (thread_formatter.version_ != formatter_version_.load(std::memory_order_acquire)) {
+    absl::MutexLock lock(&format_mutex_);
+    thread_formatter.version_ = formatter_version_.load(std::memory_order_relaxed);
+    thread_formatter.formatter_ = formatter_ == nullptr ? nullptr : formatter_->clone();
+  }
+  if (thread_formatter.formatter_ == nullptr) {
+    return {msg.payload.data(), msg.payload.size()};
+  }
+  thread_formatter.formatter_->format(msg, formatted);
+  return {formatted.data(), formatted.size()};
+}
+
+void DelegatingLogSink::log(const spdlog::details::log_msg& msg) {
   // This memory buffer must exist in the scope of the entire function,
   // otherwise the string_view will refer to memory that is already free.
   spdlog::memory_buf_t formatted;
-  if (formatter_) {
-    formatter_->format(msg, formatted);
-    msg_view = absl::string_view(formatted.data(), formatted.size());
-  }
-  lock.Release();
+  const absl::string_view msg_view = format(msg, formatted);
 
   auto log_to_sink = [this, msg_view, msg](SinkDelegate& sink) {
     if (should_escape_) {
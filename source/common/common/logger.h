@@ -1,5 +1,6 @@
 #pragma once
 
+#include <atomic>
 #include <bitset>
 #include <chrono>
 #include <cstdint>
@@ -261,11 +262,16 @@ private:
   SinkDelegate** tlsSink();
   void setTlsDelegate(SinkDelegate* sink);
   SinkDelegate* tlsDelegate();
+  // Returns the message formatted in the buffer, or its payload if there is no formatter.
+  absl::string_view format(const spdlog::details::log_msg& msg, spdlog::memory_buf_t& formatted);
 
   SinkDelegate* sink_ ABSL_GUARDED_BY(sink_mutex_){nullptr};
   absl::Mutex sink_mutex_;
   std::unique_ptr<StderrSinkDelegate> stderr_sink_; // Builtin sink to use as a last resort.
   std::unique_ptr<spdlog::formatter> formatter_ ABSL_GUARDED_BY(format_mutex_);
+  // Identifies formatter_ among all the formatters set, so that the copies of the threads are
+  // replaced when it changes. Zero when no formatter is set.
+  std::atomic<uint64_t> formatter_version_{0};
   absl::Mutex format_mutex_;
   bool should_escape_{false};
 };
@@ -1,10 +1,13 @@
 #include "source/common/common/logger_delegates.h"
 
+#include <algorithm>
 #include <cassert> // use direct system-assert to avoid cyclic dependency.
 #include <cstdint>
+#include <cstring>
 #include <iostream>
 #include <string>
 
+#include "absl/strings/str_cat.h"
 #include "spdlog/spdlog.h"
 
 namespace Envoy {
@@ -34,5 +37,190 @@ void FileSinkDelegate::flush() {
   log_file_->flush();
 }
 
+namespace {
+
+// How long the background thread waits for more messages once it wrote all of them, unless a flush
+// is requested. Writing the messages as they come would wake it up for each of them.
+constexpr absl::Duration DrainInterval = absl::Milliseconds(5);
+
+uint64_t alignedLength(uint64_t length) { return (length + 7) & ~uint64_t(7); }
+
+// Whether the current thread is the background thread of an AsyncSinkDelegate.
+bool& isWriterThread() {
+  static thread_local bool writer_thread = false;
+  return writer_thread;
+}
+
+} // namespace
+
+AsyncSinkDelegate::RingBuffer::RingBuffer(uint32_t size)
+    : buffer_(std::max<uint64_t>(alignedLength(size), 2 * sizeof(Header))) {}
+
+bool AsyncSinkDelegate::RingBuffer::push(spdlog::level::level_enum level, absl::string_view msg) {
+  const uint64_t size = buffer_.size();
+  const uint64_t entry_size = sizeof(Header) + alignedLength(msg.size());
+  if (entry_size > size) {
+    return false;
+  }
+  uint64_t write_position = write_position_.load(std::memory_order_relaxed);
+  const uint64_t free_space =
+      size - (write_position - read_position_.load(std::memory_order_acquire));
+  // The entries don't wrap around: the space left at the end of the buffer is skipped instead. It
+  // is a multiple of the header size, so it can always hold the header of the padding.
+  const uint64_t space_to_end = size - write_position % size;
+  const uint64_t padding = space_to_end < entry_size ? space_to_end : 0;
+  if (free_space < padding + entry_size) {
+    return false;
+  }
+  if (padding != 0) {
+    const Header header{static_cast<uint32_t>(padding - sizeof(Header)), Padding};
+    memcpy(&buffer_[write_position % size], &header, sizeof(Header));
+    write_position += padding;
+  }
+  char* entry = &buffer_[write_position % size];
+  const Header header{static_cast<uint32_t>(msg.size()), static_cast<uint32_t>(level)};
+  memcpy(entry, &header, sizeof(Header));
+  memcpy(entry + sizeof(Header), msg.data(), msg.size());
+  write_position_.store(write_position + entry_size, std::memory_order_release);
+  return true;
+}
+
+void AsyncSinkDelegate::RingBuffer::drain(
+    const std::function<void(spdlog::level::level_enum, absl::string_view)>& cb) {
+  const uint64_t size = buffer_.size();
+  uint64_t read_position = read_position_.load(std::memory_order_relaxed);
+  const uint64_t write_position = write_position_.load(std::memory_order_acquire);
+  while (read_position != write_position) {
+    const char* entry = &buffer_[read_position % size];
+    Header header;
+    memcpy(&header, entry, sizeof(Header));
+    if (header.level_ != Padding) {
+      cb(static_cast<spdlog::level::level_enum>(header.level_),
+         absl::string_view(entry + sizeof(Header), header.length_));
+    }
+    read_position += sizeof(Header) + alignedLength(header.length_);
+    // The space of each message is reusable once it is written.
+    read_position_.store(read_position, std::memory_order_release);
+  }
+}
+
+AsyncSinkDelegate::AsyncSinkDelegate(uint32_t buffer_size, Thread::ThreadFactory& thread_factory,
+                                     DelegatingLogSinkSharedPtr log_sink)
+    : SinkDelegate(log_sink), buffer_size_(buffer_size), id_([] {
+        static std::atomic<uint64_t> next_id{1};
+        return next_id++;
+      }()) {
+  thread_ = thread_factory.createThread([this]() -> void { writeLoop(); },
+                                        Thread::Options{"async_log"});
+  setDelegate();
+}
+
+AsyncSinkDelegate::~AsyncSinkDelegate() {
+  // No thread logs to this delegate once it is restored, so the background thread writes the
+  // messages left before exiting.
+  restoreDelegate();
+  {
+    absl::MutexLock lock(&mutex_);
+    shutdown_ = true;
+  }
+  thread_->join();
+}
+
+AsyncSinkDelegate::RingBuffer& AsyncSinkDelegate::threadRingBuffer() {
+  // The ring buffer of a thread is looked up with the id of its delegate, so that the threads which
+  // logged to an earlier delegate get a new one.
+  struct ThreadRingBuffer {
+    uint64_t id_;
+    RingBuffer* ring_buffer_;
+  };
+  static thread_local ThreadRingBuffer thread_ring_buffer{0, nullptr};
+  if (thread_ring_buffer.id_ != id_) {
+    auto ring_buffer = std::make_unique<RingBuffer>(buffer_size_);
+    thread_ring_buffer = {id_, ring_buffer.get()};
+    absl::MutexLock lock(&mutex_);
+    ring_buffers_.push_back(std::move(ring_buffer));
+  }
+  return *thread_ring_buffer.ring_buffer_;
+}
+
+void AsyncSinkDelegate::log(absl::string_view msg, const spdlog::details::log_msg& log_msg) {
+  if (!threadRingBuffer().push(log_msg.level, msg)) {
+    dropped_messages_.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+void AsyncSinkDelegate::flush() {
+  // The messages of the background thread are written after its current drain, so it can't wait
+  // for them.
+  if (isWriterThread()) {
+    return;
+  }
+  absl::MutexLock lock(&mutex_);
+  const uint64_t request = ++flush_requests_;
+  auto flushed = [this, request]() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_) {
+    return flushed_ >= request;
+  };
+  mutex_.Await(absl::Condition(&flushed));
+}
+
+void AsyncSinkDelegate::writeLoop() {
+  isWriterThread() = true;
+  uint64_t flushed = 0;
+  bool idle = false;
+  while (true) {
+    uint64_t flush_requests;
+    bool shutdown;
+    {
+      absl::MutexLock lock(&mutex_);
+      if (idle) {
+        mutex_.AwaitWithTimeout(absl::Condition(this, &AsyncSinkDelegate::wakeUp), DrainInterval);
+      }
+      flush_requests = flush_requests_;
+      shutdown = shutdown_;
+    }
+    idle = !drain();
+    if (flush_requests != flushed || shutdown) {
+      previousDelegate()->flush();
+      flushed = flush_requests;
+      absl::MutexLock lock(&mutex_);
+      flushed_ = flushed;
+    }
+    if (shutdown) {
+      return;
+    }
+  }
+}
+
+bool AsyncSinkDelegate::drain() {
+  std::vector<RingBuffer*> ring_buffers;
+  {
+    absl::MutexLock lock(&mutex_);
+    ring_buffers.reserve(ring_buffers_.size());
+    for (const auto& ring_buffer : ring_buffers_) {
+      ring_buffers.push_back(ring_buffer.get());
+    }
+  }
+
+  bool wrote = false;
+  auto write = [this, &wrote](spdlog::level::level_enum level, absl::string_view msg) {
+    // The formatted message is written as is, so the log message only carries its level.
+    previousDelegate()->log(
+        msg, spdlog::details::log_msg(spdlog::string_view_t(), level,
+                                      spdlog::string_view_t(msg.data(), msg.size())));
+    wrote = true;
+  };
+  for (RingBuffer* ring_buffer : ring_buffers) {
+    ring_buffer->drain(write);
+  }
+  const uint64_t dropped_messages = dropped_messages_.load(std::memory_order_relaxed);
+  if (dropped_messages != reported_dropped_messages_) {
+    write(spdlog::level::warn,
+          absl::StrCat("async log sink dropped ", dropped_messages - reported_dropped_messages_,
+                       " messages as the buffers were full", spdlog::details::os::default_eol));
+    reported_dropped_messages_ = dropped_messages;
+  }
+  return wrote;
+}
+
 } // namespace Logger
 } // namespace Envoy
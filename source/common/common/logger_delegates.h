@@ -1,15 +1,20 @@
 #pragma once
 
+#include <atomic>
 #include <cstdint>
+#include <functional>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "envoy/access_log/access_log.h"
+#include "envoy/thread/thread.h"
 
 #include "source/common/common/logger.h"
 #include "source/common/common/macros.h"
 
 #include "absl/strings/string_view.h"
+#include "absl/synchronization/mutex.h"
 
 namespace Envoy {
 namespace Logger {
@@ -31,6 +36,82 @@ private:
   AccessLog::AccessLogFileSharedPtr log_file_;
 };
 
+/**
+ * SinkDelegate that hands the log messages over to a background thread, which writes them to the
+ * delegate it replaces. Each thread logs to a lock free ring buffer of its own, so that the
+ * threads logging at a high rate, e.g. the workers with debug logging enabled, don't serialize on
+ * the sink. The messages logged while the ring buffer of their thread is full are dropped, and
+ * their count is written by the background thread.
+ */
+class AsyncSinkDelegate : public SinkDelegate {
+public:
+  /**
+   * @param buffer_size supplies the size in bytes of the ring buffer of each logging thread.
+   * @param thread_factory supplies the factory of the background thread.
+   * @param log_sink supplies the sink to install the delegate in.
+   */
+  AsyncSinkDelegate(uint32_t buffer_size, Thread::ThreadFactory& thread_factory,
+                    DelegatingLogSinkSharedPtr log_sink);
+  ~AsyncSinkDelegate() override;
+
+  // SinkDelegate
+  void log(absl::string_view msg, const spdlog::details::log_msg& log_msg) override;
+  // Waits for the messages logged so far to be written and flushed by the background thread.
+  void flush() override;
+
+  /**
+   * @return the number of messages dropped because the ring buffer of their thread was full.
+   */
+  uint64_t droppedMessages() const { return dropped_messages_.load(std::memory_order_relaxed); }
+
+private:
+  // A ring buffer of the messages of a thread, written by that thread and read by the background
+  // thread.
+  class RingBuffer {
+  public:
+    explicit RingBuffer(uint32_t size);
+
+    // Returns false, without adding the message, if it doesn't fit in the free space.
+    bool push(spdlog::level::level_enum level, absl::string_view msg);
+    // Calls the callback with each message added so far, which is then removed.
+    void drain(const std::function<void(spdlog::level::level_enum, absl::string_view)>& cb);
+
+  private:
+    struct Header {
+      uint32_t length_;
+      // The level of the message, or Padding for the unused space at the end of the buffer.
+      uint32_t level_;
+    };
+    static constexpr uint32_t Padding = UINT32_MAX;
+
+    std::vector<char> buffer_;
+    // The positions are the total number of bytes read and written, so that they only grow.
+    std::atomic<uint64_t> read_position_{0};
+    std::atomic<uint64_t> write_position_{0};
+  };
+
+  RingBuffer& threadRingBuffer();
+  void writeLoop();
+  // Writes the messages of the ring buffers with the previous delegate. Returns whether any was.
+  bool drain();
+  bool wakeUp() const ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_) {
+    return shutdown_ || flush_requests_ != flushed_;
+  }
+
+  const uint32_t buffer_size_;
+  // Identifies the delegate in the thread local ring buffer references.
+  const uint64_t id_;
+  std::atomic<uint64_t> dropped_messages_{0};
+  // The count of dropped messages last written. Only used by the background thread.
+  uint64_t reported_dropped_messages_{0};
+  absl::Mutex mutex_;
+  std::vector<std::unique_ptr<RingBuffer>> ring_buffers_ ABSL_GUARDED_BY(mutex_);
+  uint64_t flush_requests_ ABSL_GUARDED_BY(mutex_){0};
+  uint64_t flushed_ ABSL_GUARDED_BY(mutex_){0};
+  bool shutdown_ ABSL_GUARDED_BY(mutex_){false};
+  Thread::ThreadPtr thread_;
+};
+
 } // namespace Logger
 
 } // namespace Envoy
@@ -6,6 +6,7 @@
 #include "envoy/common/matchers.h"
 #include "envoy/common/regex.h"
 #include "envoy/config/core/v3/base.pb.h"
+#include "envoy/stream_info/filter_state.h"
 #include "envoy/type/matcher/v3/filter_state.pb.h"
 #include "envoy/type/matcher/v3/metadata.pb.h"
 #include "envoy/type/matcher/v3/number.pb.h"
@@ -236,7 +237,7 @@ public:
   bool match(const StreamInfo::FilterState& filter_state) const;
 
 private:
-  const std::string key_;
+  const StreamInfo::FilterState::Key key_;
   const StringMatcherPtr value_matcher_;
 };
 
@@ -7,6 +7,7 @@
 #include "absl/strings/str_cat.h"
 
 #if defined(__linux__)
+#include <sched.h>
 #include <sys/syscall.h>
 #endif
 
@@ -60,6 +61,20 @@ PosixThread::PosixThread(ThreadHandle* thread_handle, OptionsOptConstRef options
     name_ = options->name_.substr(0, PTHREAD_MAX_THREADNAME_LEN_INCLUDING_NULL_BYTE - 1);
   }
 
+#if defined(__linux__)
+  if (options && options->cpu_.has_value() && options->cpu_.value() < CPU_SETSIZE) {
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+    CPU_SET(options->cpu_.value(), &cpu_set);
+    const int set_affinity_rc =
+        pthread_setaffinity_np(thread_handle_->handle(), sizeof(cpu_set), &cpu_set);
+    if (set_affinity_rc != 0) {
+      ENVOY_LOG_MISC(warn, "Error {} pinning thread `{}' to CPU {}", set_affinity_rc, name_,
+                     options->cpu_.value());
+    }
+  }
+#endif
+
 #if SUPPORTS_PTHREAD_NAMING
   // If the name was not specified, get it from the OS. If the name was
   // specified, write it into the thread, and assert that the OS sees it the
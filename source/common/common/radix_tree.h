@@ -0,0 +1,160 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "absl/strings/match.h"
+#include "absl/strings/string_view.h"
+
+namespace Envoy {
+
+/**
+ * A radix tree (compressed trie) used for prefix lookups over large key sets.
+ *
+ * Compared to TrieLookupTable, chains of nodes with a single child are collapsed into one edge,
+ * so the number of nodes is bounded by twice the number of keys regardless of the key lengths.
+ * This trades slightly more expensive lookups per character for much lower memory usage and
+ * faster construction when there are many long keys with few shared prefixes.
+ *
+ * Type of Value must be empty-constructible, copyable and convertible to bool, e.g. smart
+ * pointers and raw pointers. An empty-initialized Value denotes the absence of an entry.
+ */
+template <class Value> class RadixTree {
+public:
+  /**
+   * Adds an entry to the tree at the given key.
+   * @param key the key used to add the entry.
+   * @param value the value to be associated with the key.
+   * @param overwrite_existing will overwrite the value when the value for a given key already
+   * exists.
+   * @return false when a value already exists for the given key.
+   */
+  bool add(absl::string_view key, Value value, bool overwrite_existing = true) {
+    Node* node = &root_;
+    while (!key.empty()) {
+      auto it = node->lowerBound(static_cast<uint8_t>(key[0]));
+      if (it == node->children_.end() || (*it)->firstChar() != static_cast<uint8_t>(key[0])) {
+        // No edge shares a prefix with the key, add a leaf.
+        auto leaf = std::make_unique<Node>(key);
+        leaf->value_ = std::move(value);
+        node->children_.insert(it, std::move(leaf));
+        return true;
+      }
+
+      Node* child = it->get();
+      const size_t common = commonPrefixLength(child->prefix_, key);
+      if (common < child->prefix_.size()) {
+        // The key diverges in the middle of the edge, split it at the divergence point.
+        auto split = std::make_unique<Node>(absl::string_view(child->prefix_).substr(0, common));
+        child->prefix_.erase(0, common);
+        split->children_.push_back(std::move(*it));
+        *it = std::move(split);
+        child = it->get();
+      }
+      node = child;
+      key.remove_prefix(common);
+    }
+
+    if (node->value_ && !overwrite_existing) {
+      return false;
+    }
+    node->value_ = std::move(value);
+    return true;
+  }
+
+  /**
+   * Finds the entry associated with the key.
+   * @param key the key used to find.
+   * @return the Value associated with the key, or an empty-initialized Value
+   *         if there is no matching key.
+   */
+  Value find(absl::string_view key) const {
+    const Node* node = &root_;
+    while (!key.empty()) {
+      node = node->child(key);
+      if (node == nullptr) {
+        return {};
+      }
+      key.remove_prefix(node->prefix_.size());
+    }
+    return node->value_;
+  }
+
+  /**
+   * Finds the entry with the longest key that is a prefix of the specified key.
+   * Complexity is O(min(longest key prefix, key length)).
+   * @param key the key used to find.
+   * @return a value whose key is a prefix of the specified key. If there are
+   *         multiple such values, the one with the longest key. If there are
+   *         no keys that are a prefix of the input key, an empty-initialized Value.
+   */
+  Value findLongestPrefix(absl::string_view key) const {
+    const Node* node = &root_;
+    Value result = root_.value_;
+    while (!key.empty()) {
+      node = node->child(key);
+      if (node == nullptr) {
+        break;
+      }
+      key.remove_prefix(node->prefix_.size());
+      if (node->value_) {
+        result = node->value_;
+      }
+    }
+    return result;
+  }
+
+  /**
+   * @return whether the tree holds no entries.
+   */
+  bool empty() const { return !root_.value_ && root_.children_.empty(); }
+
+private:
+  struct Node {
+    Node() = default;
+    explicit Node(absl::string_view prefix) : prefix_(prefix) {}
+
+    uint8_t firstChar() const { return static_cast<uint8_t>(prefix_[0]); }
+
+    // Children are sorted by the first character of their edge, which is unique among siblings.
+    typename std::vector<std::unique_ptr<Node>>::iterator lowerBound(uint8_t c) {
+      return std::lower_bound(
+          children_.begin(), children_.end(), c,
+          [](const std::unique_ptr<Node>& child, uint8_t c) { return child->firstChar() < c; });
+    }
+
+    // Returns the child whose edge is a prefix of the key, or nullptr.
+    const Node* child(absl::string_view key) const {
+      const uint8_t c = static_cast<uint8_t>(key[0]);
+      const auto it = std::lower_bound(
+          children_.begin(), children_.end(), c,
+          [](const std::unique_ptr<Node>& child, uint8_t c) { return child->firstChar() < c; });
+      if (it == children_.end() || (*it)->firstChar() != c ||
+          !absl::StartsWith(key, (*it)->prefix_)) {
+        return nullptr;
+      }
+      return it->get();
+    }
+
+    // The label of the edge leading to this node. Empty only for the root.
+    std::string prefix_;
+    Value value_{};
+    std::vector<std::unique_ptr<Node>> children_;
+  };
+
+  static size_t commonPrefixLength(absl::string_view a, absl::string_view b) {
+    const size_t length = std::min(a.size(), b.size());
+    size_t i = 0;
+    while (i < length && a[i] == b[i]) {
+      ++i;
+    }
+    return i;
+  }
+
+  Node root_;
+};
+
+} // namespace Envoy
@@ -2,6 +2,7 @@
 
 #include "source/common/common/assert.h"
 
+#include "absl/numeric/int128.h"
 #include "openssl/rand.h"
 
 namespace Envoy {
@@ -9,6 +10,60 @@ namespace Random {
 
 constexpr size_t CONSTEXPR_UUID_LENGTH = 36;
 const size_t RandomGeneratorImpl::UUID_LENGTH = CONSTEXPR_UUID_LENGTH;
+static_assert(std::tuple_size<RandomUtility::UuidBuffer>::value == CONSTEXPR_UUID_LENGTH);
+
+namespace {
+
+// Writes the UUID4 of the 16 random bytes to the buffer of CONSTEXPR_UUID_LENGTH characters.
+void formatUuid(uint8_t* rand, char* uuid) {
+  // Create UUID from Truly Random or Pseudo-Random Numbers.
+  // See: https://tools.ietf.org/html/rfc4122#section-4.4
+  rand[6] = (rand[6] & 0x0f) | 0x40; // UUID version 4 (random)
+  rand[8] = (rand[8] & 0x3f) | 0x80; // UUID variant 1 (RFC4122)
+
+  // Convert UUID to a string representation, e.g. a121e9e1-feae-4136-9e0e-6fac343d56c9.
+  static const char* const hex = "0123456789abcdef";
+
+  for (uint8_t i = 0; i < 4; i++) {
+    const uint8_t d = rand[i];
+    uuid[2 * i] = hex[d >> 4];
+    uuid[2 * i + 1] = hex[d & 0x0f];
+  }
+
+  uuid[8] = '-';
+
+  for (uint8_t i = 4; i < 6; i++) {
+    const uint8_t d = rand[i];
+    uuid[2 * i + 1] = hex[d >> 4];
+    uuid[2 * i + 2] = hex[d & 0x0f];
+  }
+
+  uuid[13] = '-';
+
+  for (uint8_t i = 6; i < 8; i++) {
+    const uint8_t d = rand[i];
+    uuid[2 * i + 2] = hex[d >> 4];
+    uuid[2 * i + 3] = hex[d & 0x0f];
+  }
+
+  uuid[18] = '-';
+
+  for (uint8_t i = 8; i < 10; i++) {
+    const uint8_t d = rand[i];
+    uuid[2 * i + 3] = hex[d >> 4];
+    uuid[2 * i + 4] = hex[d & 0x0f];
+  }
+
+  uuid[23] = '-';
+
+  for (uint8_t i = 10; i < 16; i++) {
+    const uint8_t d = rand[i];
+    uuid[2 * i + 4] = hex[d >> 4];
+    uuid[2 * i + 5] = hex[d & 0x0f];
+  }
+}
+
+} // namespace
 
 uint64_t RandomUtility::random() {
   // Prefetch 256 * sizeof(uint64_t) bytes of randomness. buffered_idx is initialized to 256,
@@ -82,54 +137,23 @@ std::string RandomUtility::uuid() {
   uint8_t* rand = &buffered[buffered_idx];
   buffered_idx += 16;
 
-  // Create UUID from Truly Random or Pseudo-Random Numbers.
-  // See: https://tools.ietf.org/html/rfc4122#section-4.4
-  rand[6] = (rand[6] & 0x0f) | 0x40; // UUID version 4 (random)
-  rand[8] = (rand[8] & 0x3f) | 0x80; // UUID variant 1 (RFC4122)
-
-  // Convert UUID to a string representation, e.g. a121e9e1-feae-4136-9e0e-6fac343d56c9.
-  static const char* const hex = "0123456789abcdef";
   char uuid[CONSTEXPR_UUID_LENGTH];
+  formatUuid(rand, uuid);
+  return {uuid, CONSTEXPR_UUID_LENGTH};
+}
 
-  for (uint8_t i = 0; i < 4; i++) {
-    const uint8_t d = rand[i];
-    uuid[2 * i] = hex[d >> 4];
-    uuid[2 * i + 1] = hex[d & 0x0f];
-  }
-
-  uuid[8] = '-';
-
-  for (uint8_t i = 4; i < 6; i++) {
-    const uint8_t d = rand[i];
-    uuid[2 * i + 1] = hex[d >> 4];
-    uuid[2 * i + 2] = hex[d & 0x0f];
-  }
-
-  uuid[13] = '-';
-
-  for (uint8_t i = 6; i < 8; i++) {
-    const uint8_t d = rand[i];
-    uuid[2 * i + 2] = hex[d >> 4];
-    uuid[2 * i + 3] = hex[d & 0x0f];
-  }
-
-  uuid[18] = '-';
-
-  for (uint8_t i = 8; i < 10; i++) {
-    const uint8_t d = rand[i];
-    uuid[2 * i + 3] = hex[d >> 4];
-    uuid[2 * i + 4] = hex[d & 0x0f];
-  }
-
-  uuid[23] = '-';
-
-  for (uint8_t i = 10; i < 16; i++) {
-    const uint8_t d = rand[i];
-    uuid[2 * i + 4] = hex[d >> 4];
-    uuid[2 * i + 5] = hex[d & 0x0f];
-  }
+uint64_t RandomUtility::fastRandom() {
+  // See: https://github.com/wangyi-fudan/wyhash
+  static thread_local uint64_t state = random();
+  state += 0xa0761d6478bd642f;
+  const absl::uint128 product = absl::uint128(state) * (state ^ 0xe7037ed1a0b428db);
+  return absl::Uint128High64(product) ^ absl::Uint128Low64(product);
+}
 
-  return {uuid, CONSTEXPR_UUID_LENGTH};
+absl::string_view RandomUtility::fastUuid(UuidBuffer& buffer) {
+  uint64_t rand[2] = {fastRandom(), fastRandom()};
+  formatUuid(reinterpret_cast<uint8_t*>(rand), buffer.data());
+  return {buffer.data(), buffer.size()};
 }
 
 uint64_t RandomGeneratorImpl::random() { return RandomUtility::random(); }
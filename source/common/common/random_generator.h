@@ -1,7 +1,11 @@
 #pragma once
 
+#include <array>
+
 #include "envoy/common/random_generator.h"
 
+#include "absl/strings/string_view.h"
+
 namespace Envoy {
 namespace Random {
 
@@ -14,6 +18,21 @@ class RandomUtility {
 public:
   static uint64_t random();
   static std::string uuid();
+
+  /**
+   * @return a random number of a per-thread wyrand generator seeded by random(). It is several
+   * times cheaper than random(), but it is not cryptographically secure: its next numbers can be
+   * predicted from the previous ones.
+   */
+  static uint64_t fastRandom();
+
+  using UuidBuffer = std::array<char, 36>;
+
+  /**
+   * Writes a UUID4 made of the numbers of fastRandom() to the buffer, without allocating it.
+   * @return the UUID, which points into the buffer.
+   */
+  static absl::string_view fastUuid(UuidBuffer& buffer);
 };
 
 /**
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+namespace Envoy {
+
+/**
+ * A limit on the units of a resource allocated by the threads of the process, e.g. on the
+ * connections accepted by the workers, whose allocations and releases don't all update the same
+ * counter. Each thread allocates from the units reserved by its shard, which reserves up to
+ * `slack` more units at a time from the global pool when it runs out, and gives the units beyond
+ * `slack` back to it on release. The limit is never exceeded, but an allocation may fail while
+ * the other shards hold up to `slack` units each. Without slack, every allocation and release goes
+ * to the global pool.
+ */
+class ShardedLimit {
+public:
+  ShardedLimit(uint64_t max, uint64_t slack, uint32_t shards)
+      : max_(max), slack_(slack), available_(max), shards_(std::max(shards, 1U)) {}
+
+  /**
+   * @return whether the units were allocated, or false if that would exceed the limit.
+   */
+  bool tryAllocate(uint64_t units) {
+    Shard& shard = currentShard();
+    uint64_t reserved = shard.reserved_.load(std::memory_order_relaxed);
+    while (reserved >= units) {
+      if (shard.reserved_.compare_exchange_weak(reserved, reserved - units,
+                                                std::memory_order_relaxed)) {
+        return true;
+      }
+    }
+    if (tryAllocateAvailable(shard, units)) {
+      return true;
+    }
+    // The units reserved by the shard may make up for the ones missing from the global pool.
+    reserved = shard.reserved_.exchange(0, std::memory_order_relaxed);
+    if (reserved == 0) {
+      return false;
+    }
+    available_.fetch_add(reserved, std::memory_order_relaxed);
+    return tryAllocateAvailable(shard, units);
+  }
+
+  /**
+   * Releases units previously allocated, by any thread.
+   */
+  void release(uint64_t units) {
+    Shard& shard = currentShard();
+    uint64_t reserved = shard.reserved_.fetch_add(units, std::memory_order_relaxed) + units;
+    while (reserved > slack_) {
+      if (shard.reserved_.compare_exchange_weak(reserved, slack_, std::memory_order_relaxed)) {
+        available_.fetch_add(reserved - slack_, std::memory_order_relaxed);
+        return;
+      }
+    }
+  }
+
+  /**
+   * @return the units allocated. It is only exact when no thread is allocating or releasing.
+   */
+  uint64_t allocated() const {
+    uint64_t unallocated = available_.load(std::memory_order_relaxed);
+    for (const Shard& shard : shards_) {
+      unallocated += shard.reserved_.load(std::memory_order_relaxed);
+    }
+    return max_ - std::min(unallocated, max_);
+  }
+
+  uint64_t max() const { return max_; }
+
+private:
+  // Each shard has its own cache line, so that the threads of different shards don't contend.
+  struct alignas(64) Shard {
+    std::atomic<uint64_t> reserved_{0};
+  };
+
+  // Allocates the units from the global pool, reserving up to slack_ more for the shard.
+  bool tryAllocateAvailable(Shard& shard, uint64_t units) {
+    uint64_t available = available_.load(std::memory_order_relaxed);
+    while (available >= units) {
+      const uint64_t taken = std::min(available, units + slack_);
+      if (available_.compare_exchange_weak(available, available - taken,
+                                           std::memory_order_relaxed)) {
+        if (taken > units) {
+          shard.reserved_.fetch_add(taken - units, std::memory_order_relaxed);
+        }
+        return true;
+      }
+    }
+    return false;
+  }
+
+  Shard& currentShard() {
+    static std::atomic<uint32_t> next_thread_index{0};
+    static thread_local const uint32_t thread_index =
+        next_thread_index.fetch_add(1, std::memory_order_relaxed);
+    return shards_[thread_index % shards_.size()];
+  }
+
+  const uint64_t max_;
+  const uint64_t slack_;
+  std::atomic<uint64_t> available_;
+  std::vector<Shard> shards_;
+};
+
+} // namespace Envoy
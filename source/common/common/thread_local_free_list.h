@@ -0,0 +1,117 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+
+#include "absl/base/config.h"
+
+#ifdef ABSL_HAVE_ADDRESS_SANITIZER
+#include <sanitizer/asan_interface.h>
+#endif
+
+namespace Envoy {
+
+/**
+ * Per-thread free list of the memory of the objects of a class, for objects which are created and
+ * destroyed at a high rate on the workers, e.g. for each request. Up to MaxFreeBlocks released
+ * blocks are kept by each thread, and the next objects created by the thread are constructed in
+ * them instead of being allocated from the heap. Only the memory is recycled: the objects are
+ * constructed and destroyed as usual.
+ *
+ * A class opts in by forwarding its allocation functions to the free list:
+ *
+ *   static void* operator new(size_t size) { return ThreadLocalFreeList<Foo, 64>::allocate(size); }
+ *   static void operator delete(void* block, size_t size) {
+ *     ThreadLocalFreeList<Foo, 64>::release(block, size);
+ *   }
+ *
+ * Objects of derived classes, whose size differs, go to the heap. The free blocks are poisoned
+ * under AddressSanitizer, except for the link to the next one.
+ */
+template <class T, size_t MaxFreeBlocks> class ThreadLocalFreeList {
+public:
+  static void* allocate(size_t size) {
+    static_assert(alignof(T) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+    FreeList* free_list = freeList(size);
+    if (free_list == nullptr || free_list->head_ == nullptr) {
+      return ::operator new(size);
+    }
+    Block* block = free_list->head_;
+    unpoison(block);
+    free_list->head_ = block->next_;
+    --free_list->size_;
+    return block;
+  }
+
+  static void release(void* memory, size_t size) {
+    FreeList* free_list = freeList(size);
+    if (free_list == nullptr || free_list->size_ == MaxFreeBlocks) {
+      ::operator delete(memory);
+      return;
+    }
+    Block* block = static_cast<Block*>(memory);
+    block->next_ = free_list->head_;
+    poison(block);
+    free_list->head_ = block;
+    ++free_list->size_;
+  }
+
+  /**
+   * @return the number of free blocks held by the current thread.
+   */
+  static size_t freeBlocks() {
+    FreeList* free_list = freeList(sizeof(T));
+    return free_list == nullptr ? 0 : free_list->size_;
+  }
+
+private:
+  struct Block {
+    Block* next_;
+  };
+  static_assert(sizeof(T) >= sizeof(Block));
+
+  struct FreeList {
+    ~FreeList() {
+      // Objects destroyed after the free list during thread exit release their memory directly.
+      destroyed() = true;
+      while (head_ != nullptr) {
+        Block* block = head_;
+        unpoison(block);
+        head_ = block->next_;
+        ::operator delete(block);
+      }
+    }
+
+    Block* head_{};
+    size_t size_{};
+  };
+
+  // It is trivially destructible, so it remains accessible until the thread exits.
+  static bool& destroyed() {
+    static thread_local bool destroyed = false;
+    return destroyed;
+  }
+
+  static FreeList* freeList(size_t size) {
+    if (size != sizeof(T) || destroyed()) {
+      return nullptr;
+    }
+    static thread_local FreeList free_list;
+    return &free_list;
+  }
+
+  static void poison([[maybe_unused]] Block* block) {
+#ifdef ABSL_HAVE_ADDRESS_SANITIZER
+    ASAN_POISON_MEMORY_REGION(reinterpret_cast<char*>(block) + sizeof(Block),
+                              sizeof(T) - sizeof(Block));
+#endif
+  }
+
+  static void unpoison([[maybe_unused]] Block* block) {
+#ifdef ABSL_HAVE_ADDRESS_SANITIZER
+    ASAN_UNPOISON_MEMORY_REGION(block, sizeof(T));
+#endif
+  }
+};
+
+} // namespace Envoy
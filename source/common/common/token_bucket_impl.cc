@@ -1,12 +1,17 @@
 #include "source/common/common/token_bucket_impl.h"
 
+#include <algorithm>
 #include <chrono>
+#include <cmath>
 
 namespace Envoy {
 
 namespace {
 // The minimal fill rate will be one second every year.
 constexpr double kMinFillRate = 1.0 / (365 * 24 * 60 * 60);
+constexpr double kNanosecondsPerSecond = 1e9;
+// Keeps the times of the atomic token bucket far from overflowing.
+constexpr double kMaxFillDuration = static_cast<double>(int64_t(1) << 60);
 } // namespace
 
 TokenBucketImpl::TokenBucketImpl(uint64_t max_tokens, TimeSource& time_source, double fill_rate)
@@ -56,4 +61,110 @@ void TokenBucketImpl::maybeReset(uint64_t num_tokens) {
   last_fill_ = time_source_.monotonicTime();
 }
 
+AtomicTokenBucketImpl::AtomicTokenBucketImpl(uint64_t max_tokens, TimeSource& time_source,
+                                             double fill_rate)
+    : max_tokens_(max_tokens),
+      fill_rate_(std::max(std::abs(fill_rate), kMinFillRate) / kNanosecondsPerSecond),
+      fill_duration_(static_cast<int64_t>(std::min(max_tokens_ / fill_rate_, kMaxFillDuration))),
+      time_source_(time_source), empty_time_(now() - fill_duration_) {}
+
+int64_t AtomicTokenBucketImpl::now() const {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             time_source_.monotonicTime().time_since_epoch())
+      .count();
+}
+
+double AtomicTokenBucketImpl::tokens(int64_t now, int64_t& empty_time) const {
+  // The tokens beyond the maximum are lost, as if the bucket had been empty later.
+  empty_time = std::max(empty_time, now - fill_duration_);
+  return std::min((now - empty_time) * fill_rate_, max_tokens_);
+}
+
+uint64_t AtomicTokenBucketImpl::consume(uint64_t tokens, bool allow_partial) {
+  const int64_t time_now = now();
+  int64_t expected_empty_time = empty_time_.load(std::memory_order_relaxed);
+  int64_t new_empty_time;
+  uint64_t consumed;
+  do {
+    // expected_empty_time is either loaded above or reloaded during the CAS failure below.
+    int64_t empty_time = expected_empty_time;
+    const double available = this->tokens(time_now, empty_time);
+    consumed = allow_partial ? std::min(tokens, static_cast<uint64_t>(std::floor(available)))
+                             : tokens;
+    if (consumed == 0 || available < consumed) {
+      return 0;
+    }
+    new_empty_time = empty_time + static_cast<int64_t>(std::ceil(consumed / fill_rate_));
+    // Relaxed consistency is enough since only the value of the bucket matters.
+  } while (!empty_time_.compare_exchange_weak(expected_empty_time, new_empty_time,
+                                              std::memory_order_relaxed));
+  return consumed;
+}
+
+uint64_t AtomicTokenBucketImpl::consume(uint64_t tokens, bool allow_partial,
+                                        std::chrono::milliseconds& time_to_next_token) {
+  auto tokens_consumed = consume(tokens, allow_partial);
+  time_to_next_token = nextTokenAvailable();
+  return tokens_consumed;
+}
+
+std::chrono::milliseconds AtomicTokenBucketImpl::nextTokenAvailable() {
+  int64_t empty_time = empty_time_.load(std::memory_order_relaxed);
+  const double available = tokens(now(), empty_time);
+  if (available >= 1) {
+    return std::chrono::milliseconds(0);
+  }
+  return std::chrono::milliseconds(
+      static_cast<uint64_t>(std::ceil((1 - available) / fill_rate_ / 1e6)));
+}
+
+void AtomicTokenBucketImpl::maybeReset(uint64_t num_tokens) {
+  ASSERT(num_tokens <= max_tokens_);
+  // Don't reset if reset once before.
+  bool reset_once = false;
+  if (!reset_once_.compare_exchange_strong(reset_once, true, std::memory_order_relaxed)) {
+    return;
+  }
+  empty_time_.store(now() - static_cast<int64_t>(num_tokens / fill_rate_),
+                    std::memory_order_relaxed);
+}
+
+LeasedTokenBucketImpl::LeasedTokenBucketImpl(std::shared_ptr<TokenBucket> shared,
+                                             uint64_t lease_size)
+    : shared_(std::move(shared)), lease_size_(std::max<uint64_t>(lease_size, 1)) {}
+
+uint64_t LeasedTokenBucketImpl::consume(uint64_t tokens, bool allow_partial) {
+  if (leased_ < tokens) {
+    // Leases what the consumption misses, and at least a full lease.
+    leased_ += shared_->consume(std::max(tokens - leased_, lease_size_), true);
+  }
+  if (allow_partial) {
+    tokens = std::min(tokens, leased_);
+  }
+  if (leased_ < tokens) {
+    return 0;
+  }
+  leased_ -= tokens;
+  return tokens;
+}
+
+uint64_t LeasedTokenBucketImpl::consume(uint64_t tokens, bool allow_partial,
+                                        std::chrono::milliseconds& time_to_next_token) {
+  auto tokens_consumed = consume(tokens, allow_partial);
+  time_to_next_token = nextTokenAvailable();
+  return tokens_consumed;
+}
+
+std::chrono::milliseconds LeasedTokenBucketImpl::nextTokenAvailable() {
+  if (leased_ > 0) {
+    return std::chrono::milliseconds(0);
+  }
+  return shared_->nextTokenAvailable();
+}
+
+void LeasedTokenBucketImpl::maybeReset(uint64_t num_tokens) {
+  leased_ = 0;
+  shared_->maybeReset(num_tokens);
+}
+
 } // namespace Envoy
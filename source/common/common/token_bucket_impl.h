@@ -1,5 +1,8 @@
 #pragma once
 
+#include <atomic>
+#include <memory>
+
 #include "envoy/common/time.h"
 #include "envoy/common/token_bucket.h"
 
@@ -35,4 +38,76 @@ private:
   TimeSource& time_source_;
 };
 
+/**
+ * A lock-free implementation of the token bucket interface, which can be shared between threads.
+ * The tokens are derived from the time since the bucket was last empty, which is kept in
+ * nanoseconds and updated with a compare-and-swap. Like SharedTokenBucketImpl, only the first call
+ * to maybeReset() resets the bucket, so that its users can't refill it by resetting it.
+ */
+class AtomicTokenBucketImpl : public TokenBucket {
+public:
+  /**
+   * @param max_tokens supplies the maximum number of tokens in the bucket.
+   * @param time_source supplies the time source.
+   * @param fill_rate supplies the number of tokens that will return to the bucket on each second.
+   * The default is 1.
+   */
+  explicit AtomicTokenBucketImpl(uint64_t max_tokens, TimeSource& time_source,
+                                 double fill_rate = 1);
+
+  AtomicTokenBucketImpl(const AtomicTokenBucketImpl&) = delete;
+  AtomicTokenBucketImpl(AtomicTokenBucketImpl&&) = delete;
+
+  // TokenBucket
+  uint64_t consume(uint64_t tokens, bool allow_partial) override;
+  uint64_t consume(uint64_t tokens, bool allow_partial,
+                   std::chrono::milliseconds& time_to_next_token) override;
+  std::chrono::milliseconds nextTokenAvailable() override;
+  void maybeReset(uint64_t num_tokens) override;
+
+private:
+  int64_t now() const;
+  // Returns the tokens in the bucket at the time, and the time at which it was last empty.
+  double tokens(int64_t now, int64_t& empty_time) const;
+
+  const double max_tokens_;
+  // The tokens returning to the bucket on each nanosecond.
+  const double fill_rate_;
+  // The time it takes to fill the empty bucket, in nanoseconds.
+  const int64_t fill_duration_;
+  TimeSource& time_source_;
+  // The time, in nanoseconds of the monotonic clock, at which the bucket was last empty, assuming
+  // it then filled up without a limit.
+  std::atomic<int64_t> empty_time_;
+  std::atomic<bool> reset_once_{false};
+};
+
+/**
+ * A token bucket of a single thread, consuming the tokens of a token bucket shared between threads
+ * in leases, so that the threads seldom contend on it (not thread-safe). The tokens leased and not
+ * yet consumed by each thread, at most the larger of lease_size and of the tokens of a
+ * consumption, bound the error of the shared bucket.
+ */
+class LeasedTokenBucketImpl : public TokenBucket {
+public:
+  /**
+   * @param shared supplies the token bucket shared between threads. A reset of the lease drops the
+   * tokens leased and resets the shared bucket, if it allows it.
+   * @param lease_size supplies the number of tokens to lease from the shared bucket at once.
+   */
+  LeasedTokenBucketImpl(std::shared_ptr<TokenBucket> shared, uint64_t lease_size);
+
+  // TokenBucket
+  uint64_t consume(uint64_t tokens, bool allow_partial) override;
+  uint64_t consume(uint64_t tokens, bool allow_partial,
+                   std::chrono::milliseconds& time_to_next_token) override;
+  std::chrono::milliseconds nextTokenAvailable() override;
+  void maybeReset(uint64_t num_tokens) override;
+
+private:
+  const std::shared_ptr<TokenBucket> shared_;
+  const uint64_t lease_size_;
+  uint64_t leased_{};
+};
+
 } // namespace Envoy
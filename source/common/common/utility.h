@@ -17,6 +17,7 @@
 
 #include "absl/container/flat_hash_map.h"
 #include "absl/container/flat_hash_set.h"
+#include "absl/container/inlined_vector.h"
 #include "absl/strings/string_view.h"
 
 namespace Envoy {
@@ -779,6 +780,31 @@ public:
     return result ? result->value_ : nullptr;
   }
 
+  /**
+   * Finds the entries of all keys that are a prefix of the specified key.
+   * Complexity is O(min(longest key prefix, key length)).
+   * @param key the key used to find.
+   * @return the values whose keys are a prefix of the specified key, ordered from the shortest
+   *         key to the longest key. Empty if there are no keys that are a prefix of the input key.
+   */
+  absl::InlinedVector<Value, 4> findMatchingPrefixes(absl::string_view key) const {
+    absl::InlinedVector<Value, 4> result;
+    const TrieNode* current = &root_;
+    if (current->value_) {
+      result.push_back(current->value_);
+    }
+    for (uint8_t c : key) {
+      current = (*current)[c];
+      if (current == nullptr) {
+        break;
+      }
+      if (current->value_) {
+        result.push_back(current->value_);
+      }
+    }
+    return result;
+  }
+
 private:
   TrieNode root_;
 };
@@ -31,7 +31,9 @@ public:
                                              const ProtobufWkt::Any& resource,
                                              const std::string& version) {
     if (resource.Is<envoy::service::discovery::v3::Resource>()) {
-      envoy::service::discovery::v3::Resource r;
+      // The wrapper is only needed while its resource is decoded, so it is allocated on an arena.
+      Protobuf::Arena arena;
+      auto& r = *Protobuf::Arena::Create<envoy::service::discovery::v3::Resource>(&arena);
       MessageUtil::unpackToOrThrow(resource, r);
 
       r.set_version(version);
@@ -50,6 +52,26 @@ public:
     return std::make_unique<DecodedResourceImpl>(resource_decoder, resource);
   }
 
+  // Builds the resource from its message, unpacked with OpaqueResourceDecoder::unpackResource()
+  // and validated, and from the Resource wrapping it in the response, if any.
+  static DecodedResourceImplPtr
+  fromUnpackedResource(OpaqueResourceDecoder& resource_decoder, ProtobufTypes::MessagePtr message,
+                       const envoy::service::discovery::v3::Resource* wrapper,
+                       const std::string& version) {
+    if (wrapper != nullptr) {
+      return std::unique_ptr<DecodedResourceImpl>(new DecodedResourceImpl(
+          resource_decoder, wrapper->name(), wrapper->aliases(), std::move(message),
+          wrapper->has_resource(), wrapper->version(),
+          wrapper->has_ttl() ? absl::make_optional(std::chrono::milliseconds(
+                                   DurationUtil::durationToMilliseconds(wrapper->ttl())))
+                             : absl::nullopt,
+          wrapper->has_metadata() ? absl::make_optional(wrapper->metadata()) : absl::nullopt));
+    }
+    return std::unique_ptr<DecodedResourceImpl>(new DecodedResourceImpl(
+        resource_decoder, absl::nullopt, Protobuf::RepeatedPtrField<std::string>(),
+        std::move(message), true, version, absl::nullopt, absl::nullopt));
+  }
+
   DecodedResourceImpl(OpaqueResourceDecoder& resource_decoder,
                       const envoy::service::discovery::v3::Resource& resource)
       : DecodedResourceImpl(
@@ -74,6 +96,7 @@ public:
   const std::vector<std::string>& aliases() const override { return aliases_; }
   const std::string& version() const override { return version_; };
   const Protobuf::Message& resource() const override { return *resource_; };
+  std::shared_ptr<const Protobuf::Message> sharedResource() const override { return resource_; }
   bool hasResource() const override { return has_resource_; }
   absl::optional<std::chrono::milliseconds> ttl() const override { return ttl_; }
   const OptRef<const envoy::config::core::v3::Metadata> metadata() const override {
@@ -90,8 +113,18 @@ private:
         name_(name ? *name : resource_decoder.resourceName(*resource_)),
         aliases_(repeatedPtrFieldToVector(aliases)), version_(version), ttl_(ttl),
         metadata_(metadata) {}
+  DecodedResourceImpl(OpaqueResourceDecoder& resource_decoder, absl::optional<std::string> name,
+                      const Protobuf::RepeatedPtrField<std::string>& aliases,
+                      ProtobufTypes::MessagePtr resource, bool has_resource,
+                      const std::string& version, absl::optional<std::chrono::milliseconds> ttl,
+                      const absl::optional<envoy::config::core::v3::Metadata>& metadata)
+      : resource_(std::move(resource)), has_resource_(has_resource),
+        name_(name ? *name : resource_decoder.resourceName(*resource_)),
+        aliases_(repeatedPtrFieldToVector(aliases)), version_(version), ttl_(ttl),
+        metadata_(metadata) {}
 
-  const ProtobufTypes::MessagePtr resource_;
+  // Shared with the subscriptions which keep the resource after the update.
+  const std::shared_ptr<const Protobuf::Message> resource_;
   const bool has_resource_;
   const std::string name_;
   const std::vector<std::string> aliases_;
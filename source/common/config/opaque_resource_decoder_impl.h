@@ -28,6 +28,18 @@ public:
     return MessageUtil::getStringField(resource, name_field_);
   }
 
+  ProtobufTypes::MessagePtr unpackResource(const ProtobufWkt::Any& resource) override {
+    auto typed_message = std::make_unique<Current>();
+    if (!resource.type_url().empty()) {
+      MessageUtil::anyConvert<Current>(resource, *typed_message);
+    }
+    return typed_message;
+  }
+
+  void validateResource(const Protobuf::Message& resource) override {
+    MessageUtil::validate(dynamic_cast<const Current&>(resource), validation_visitor_);
+  }
+
 private:
   ProtobufMessage::ValidationVisitor& validation_visitor_;
   const std::string name_field_;
@@ -0,0 +1,161 @@
+#include "source/common/config/resource_decoder_pool.h"
+
+#include <exception>
+
+#include "envoy/common/exception.h"
+#include "envoy/service/discovery/v3/discovery.pb.h"
+
+#include "source/common/common/thread.h"
+#include "source/common/config/decoded_resource_impl.h"
+
+#include "absl/types/optional.h"
+
+namespace Envoy {
+namespace Config {
+
+namespace {
+
+// The responses with fewer resources are decoded on the main thread alone, as waking up the pool
+// costs more than it saves.
+constexpr int MinPooledResources = 64;
+
+// A resource of a response unpacked by the pool.
+struct UnpackedResource {
+  absl::optional<envoy::service::discovery::v3::Resource> wrapper_;
+  ProtobufTypes::MessagePtr message_;
+  std::exception_ptr error_;
+};
+
+} // namespace
+
+ResourceDecoderPool::ResourceDecoderPool(Thread::ThreadFactory& thread_factory, uint32_t threads) {
+  for (uint32_t i = 0; i < threads; ++i) {
+    threads_.push_back(thread_factory.createThread([this]() { threadRoutine(); },
+                                                   Thread::Options{"xds_decoder"}));
+  }
+}
+
+ResourceDecoderPool::~ResourceDecoderPool() {
+  {
+    absl::MutexLock lock(&mutex_);
+    shutdown_ = true;
+    work_.SignalAll();
+  }
+  for (Thread::ThreadPtr& thread : threads_) {
+    thread->join();
+  }
+}
+
+void ResourceDecoderPool::run(size_t count, const std::function<void(size_t)>& cb) {
+  {
+    absl::MutexLock lock(&mutex_);
+    ASSERT(running_threads_ == 0);
+    cb_ = &cb;
+    count_ = count;
+    next_index_ = 0;
+    running_threads_ = threads_.size();
+    ++generation_;
+    work_.SignalAll();
+  }
+  runIndexes(count, cb);
+
+  absl::MutexLock lock(&mutex_);
+  while (running_threads_ > 0) {
+    done_.Wait(&mutex_);
+  }
+  cb_ = nullptr;
+}
+
+void ResourceDecoderPool::runIndexes(size_t count, const std::function<void(size_t)>& cb) {
+  for (size_t i = next_index_++; i < count; i = next_index_++) {
+    cb(i);
+  }
+}
+
+void ResourceDecoderPool::threadRoutine() {
+  uint64_t generation = 0;
+  while (true) {
+    const std::function<void(size_t)>* cb;
+    size_t count;
+    {
+      absl::MutexLock lock(&mutex_);
+      while (!shutdown_ && generation_ == generation) {
+        work_.Wait(&mutex_);
+      }
+      if (shutdown_) {
+        return;
+      }
+      generation = generation_;
+      cb = cb_;
+      count = count_;
+    }
+    runIndexes(count, *cb);
+
+    absl::MutexLock lock(&mutex_);
+    if (--running_threads_ == 0) {
+      done_.Signal();
+    }
+  }
+}
+
+std::vector<DecodedResourcePtr>
+decodeResources(OpaqueResourceDecoder& resource_decoder,
+                const Protobuf::RepeatedPtrField<ProtobufWkt::Any>& resources,
+                const std::string& version) {
+  std::vector<DecodedResourcePtr> decoded_resources;
+  decoded_resources.reserve(resources.size());
+  ResourceDecoderPool* pool = ResourceDecoderPoolSingleton::getExisting();
+  if (pool == nullptr || resources.size() < MinPooledResources) {
+    for (const auto& resource : resources) {
+      decoded_resources.push_back(
+          DecodedResourceImpl::fromResource(resource_decoder, resource, version));
+    }
+    return decoded_resources;
+  }
+
+  // Unpacking the resources only parses them, which is safe on any thread.
+  std::vector<UnpackedResource> unpacked_resources(resources.size());
+  pool->run(resources.size(), [&](size_t i) {
+    UnpackedResource& unpacked = unpacked_resources[i];
+    const ProtobufWkt::Any& resource = resources[i];
+    TRY_NEEDS_AUDIT {
+      if (resource.Is<envoy::service::discovery::v3::Resource>()) {
+        unpacked.wrapper_.emplace();
+        MessageUtil::unpackToOrThrow(resource, unpacked.wrapper_.value());
+        unpacked.wrapper_->set_version(version);
+      }
+      unpacked.message_ = resource_decoder.unpackResource(
+          unpacked.wrapper_.has_value() ? unpacked.wrapper_->resource() : resource);
+    }
+    END_TRY
+    catch (const EnvoyException&) {
+      unpacked.error_ = std::current_exception();
+    }
+  });
+
+  for (int i = 0; i < resources.size(); ++i) {
+    UnpackedResource& unpacked = unpacked_resources[i];
+    if (unpacked.error_ != nullptr) {
+      std::rethrow_exception(unpacked.error_);
+    }
+    if (unpacked.message_ == nullptr) {
+      // The decoder can't unpack the resources off the main thread.
+      decoded_resources.push_back(
+          DecodedResourceImpl::fromResource(resource_decoder, resources[i], version));
+      continue;
+    }
+    const ProtobufWkt::Any& resource =
+        unpacked.wrapper_.has_value() ? unpacked.wrapper_->resource() : resources[i];
+    // As with decodeResource(), the resources without a type URL are left empty and unvalidated.
+    if (!resource.type_url().empty()) {
+      resource_decoder.validateResource(*unpacked.message_);
+    }
+    decoded_resources.push_back(DecodedResourceImpl::fromUnpackedResource(
+        resource_decoder, std::move(unpacked.message_),
+        unpacked.wrapper_.has_value() ? &unpacked.wrapper_.value() : nullptr, version));
+  }
+  return decoded_resources;
+}
+
+} // namespace Config
+} // namespace Envoy
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include "envoy/config/subscription.h"
+#include "envoy/thread/thread.h"
+
+#include "source/common/protobuf/protobuf.h"
+#include "source/common/singleton/threadsafe_singleton.h"
+
+#include "absl/synchronization/mutex.h"
+
+namespace Envoy {
+namespace Config {
+
+/**
+ * Threads unpacking the resources of the large xDS responses in parallel. The main thread takes
+ * part in the unpacking and waits for it to be done, and then validates the resources and hands
+ * them to the subscriptions as usual: the validation reports to the validation visitor and looks
+ * at the runtime, which only the main thread may do.
+ */
+class ResourceDecoderPool {
+public:
+  ResourceDecoderPool(Thread::ThreadFactory& thread_factory, uint32_t threads);
+  ~ResourceDecoderPool();
+
+  /**
+   * Runs the callback for each index below the count, on the threads of the pool and on the
+   * calling thread, and returns once it ran for all of them.
+   * @param count supplies the number of indexes.
+   * @param cb supplies the callback, which must not throw.
+   */
+  void run(size_t count, const std::function<void(size_t)>& cb);
+
+private:
+  void runIndexes(size_t count, const std::function<void(size_t)>& cb);
+  void threadRoutine();
+
+  absl::Mutex mutex_;
+  absl::CondVar work_;
+  absl::CondVar done_;
+  // The callback and the count of the current run, which is numbered by the generation.
+  const std::function<void(size_t)>* cb_ ABSL_GUARDED_BY(mutex_){};
+  size_t count_ ABSL_GUARDED_BY(mutex_){};
+  uint64_t generation_ ABSL_GUARDED_BY(mutex_){};
+  // The threads which haven't finished the current run yet.
+  size_t running_threads_ ABSL_GUARDED_BY(mutex_){};
+  bool shutdown_ ABSL_GUARDED_BY(mutex_){};
+  std::atomic<size_t> next_index_{};
+  std::vector<Thread::ThreadPtr> threads_;
+};
+
+using ResourceDecoderPoolSingleton = InjectableSingleton<ResourceDecoderPool>;
+
+/**
+ * Decodes the resources of a response as DecodedResourceImpl::fromResource() does, unpacking them
+ * on the ResourceDecoderPoolSingleton if one is installed and there are enough of them. As when
+ * they are decoded one at a time, the first resource which fails to decode throws.
+ * @param resource_decoder supplies the decoder of the resources.
+ * @param resources supplies the resources of the response.
+ * @param version supplies the version of the response.
+ * @return std::vector<DecodedResourcePtr> the decoded resources, in the order of the response.
+ */
+std::vector<DecodedResourcePtr>
+decodeResources(OpaqueResourceDecoder& resource_decoder,
+                const Protobuf::RepeatedPtrField<ProtobufWkt::Any>& resources,
+                const std::string& version);
+
+} // namespace Config
+} // namespace Envoy
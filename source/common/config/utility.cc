@@ -261,9 +261,12 @@ void Utility::translateOpaqueConfig(const ProtobufWkt::Any& typed_config,
     // Unpack methods will only use the fully qualified type name after the last '/'.
     // https://github.com/protocolbuffers/protobuf/blob/3.6.x/src/google/protobuf/any.proto#L87
     absl::string_view type = TypeUtil::typeUrlToDescriptorFullName(typed_config.type_url());
+    // The structs are only intermediates of the conversion, so their trees are allocated on an
+    // arena, to be freed at once rather than node by node.
+    Protobuf::Arena arena;
 
     if (type == typed_struct_type) {
-      xds::type::v3::TypedStruct typed_struct;
+      auto& typed_struct = *Protobuf::Arena::Create<xds::type::v3::TypedStruct>(&arena);
       MessageUtil::unpackToOrThrow(typed_config, typed_struct);
       // if out_proto is expecting Struct, return directly
       if (out_proto.GetTypeName() == struct_type) {
@@ -278,7 +281,7 @@ void Utility::translateOpaqueConfig(const ProtobufWkt::Any& typed_config,
 #endif
       }
     } else if (type == legacy_typed_struct_type) {
-      udpa::type::v1::TypedStruct typed_struct;
+      auto& typed_struct = *Protobuf::Arena::Create<udpa::type::v1::TypedStruct>(&arena);
       MessageUtil::unpackToOrThrow(typed_config, typed_struct);
       // if out_proto is expecting Struct, return directly
       if (out_proto.GetTypeName() == struct_type) {
@@ -298,7 +301,7 @@ void Utility::translateOpaqueConfig(const ProtobufWkt::Any& typed_config,
       MessageUtil::unpackToOrThrow(typed_config, out_proto);
     } else {
 #ifdef ENVOY_ENABLE_YAML
-      ProtobufWkt::Struct struct_config;
+      auto& struct_config = *Protobuf::Arena::Create<ProtobufWkt::Struct>(&arena);
       MessageUtil::unpackToOrThrow(typed_config, struct_config);
       MessageUtil::jsonConvert(struct_config, validation_visitor, out_proto);
 #else
@@ -1,5 +1,8 @@
 #include "source/common/conn_pool/conn_pool_base.h"
 
+#include <algorithm>
+#include <chrono>
+
 #include "source/common/common/assert.h"
 #include "source/common/common/debug_recursion_checker.h"
 #include "source/common/network/transport_socket_options_impl.h"
@@ -10,6 +13,10 @@
 namespace Envoy {
 namespace ConnectionPool {
 namespace {
+
+// The weight of the latest sample in the averages of the adaptive preconnect.
+constexpr double AdaptivePreconnectWeight = 0.1;
+
 [[maybe_unused]] ssize_t connectingCapacity(const std::list<ActiveClientPtr>& connecting_clients) {
   ssize_t ret = 0;
   for (const auto& client : connecting_clients) {
@@ -98,7 +105,8 @@ bool ConnPoolImplBase::shouldCreateNewConnection(float global_preconnect_ratio)
     // new streams are established or torn down and simply attempts to maintain
     // the correct ratio of streams and anticipated capacity.
     return shouldConnect(pending_streams_.size(), num_active_streams_, connecting_stream_capacity_,
-                         perUpstreamPreconnectRatio());
+                         perUpstreamPreconnectRatio()) ||
+           shouldPreconnectForPredictedStreams();
   }
 }
 
@@ -106,6 +114,52 @@ float ConnPoolImplBase::perUpstreamPreconnectRatio() const {
   return host_->cluster().perUpstreamPreconnectRatio();
 }
 
+bool ConnPoolImplBase::shouldPreconnectForPredictedStreams() const {
+  const uint32_t max_connections = host_->cluster().maxAdaptivePreconnectConnections();
+  if (max_connections == 0 || !last_stream_time_.has_value() || connect_latency_average_ == 0) {
+    return false;
+  }
+  // Only the connections which are or will soon be able to take a stream are in the budget, so
+  // the loop below is bounded by it.
+  if (ready_clients_.size() + connecting_clients_.size() + early_data_clients_.size() >=
+      max_connections) {
+    return false;
+  }
+
+  // When the streams stop arriving, the time since the last one is a better estimate than the
+  // average.
+  const double elapsed =
+      std::chrono::duration<double>(dispatcher_.timeSource().monotonicTime() - *last_stream_time_)
+          .count();
+  const double stream_interval = std::max({stream_interval_average_, elapsed, 1e-6});
+  // The streams expected to arrive while a new connection is established.
+  const double predicted_streams = connect_latency_average_ / stream_interval;
+
+  int64_t capacity = connecting_stream_capacity_;
+  for (const ActiveClientPtr& client : ready_clients_) {
+    capacity += client->currentUnusedCapacity();
+  }
+  return pending_streams_.size() + predicted_streams > capacity;
+}
+
+void ConnPoolImplBase::onStreamArrival() {
+  const MonotonicTime now = dispatcher_.timeSource().monotonicTime();
+  if (last_stream_time_.has_value()) {
+    const double interval = std::chrono::duration<double>(now - *last_stream_time_).count();
+    stream_interval_average_ += AdaptivePreconnectWeight * (interval - stream_interval_average_);
+  }
+  last_stream_time_ = now;
+}
+
+void ConnPoolImplBase::onConnectLatency(std::chrono::milliseconds latency) {
+  const double sample = std::chrono::duration<double>(latency).count();
+  if (connect_latency_average_ == 0) {
+    connect_latency_average_ = sample;
+  } else {
+    connect_latency_average_ += AdaptivePreconnectWeight * (sample - connect_latency_average_);
+  }
+}
+
 ConnPoolImplBase::ConnectionResult ConnPoolImplBase::tryCreateNewConnections() {
   ConnPoolImplBase::ConnectionResult result;
   // Somewhat arbitrarily cap the number of connections preconnected due to new
@@ -260,9 +314,16 @@ ConnectionPool::Cancellable* ConnPoolImplBase::newStreamImpl(AttachContext& cont
   ASSERT(static_cast<ssize_t>(connecting_stream_capacity_) ==
          connectingCapacity(connecting_clients_) +
              connectingCapacity(early_data_clients_)); // O(n) debug check.
+  const bool adaptive_preconnect = host_->cluster().maxAdaptivePreconnectConnections() > 0;
+  if (adaptive_preconnect) {
+    onStreamArrival();
+  }
   if (!ready_clients_.empty()) {
     ActiveClient& client = *ready_clients_.front();
     ENVOY_CONN_LOG(debug, "using existing fully connected connection", client);
+    if (adaptive_preconnect) {
+      host_->cluster().trafficStats()->upstream_rq_preconnect_hit_.inc();
+    }
     attachStreamToClient(client, context);
     // Even if there's a ready client, we may want to preconnect to handle the next incoming stream.
     tryCreateNewConnections();
@@ -272,6 +333,9 @@ ConnectionPool::Cancellable* ConnPoolImplBase::newStreamImpl(AttachContext& cont
   if (can_send_early_data && !early_data_clients_.empty()) {
     ActiveClient& client = *early_data_clients_.front();
     ENVOY_CONN_LOG(debug, "using existing early data ready connection", client);
+    if (adaptive_preconnect) {
+      host_->cluster().trafficStats()->upstream_rq_preconnect_hit_.inc();
+    }
     attachStreamToClient(client, context);
     // Even if there's an available client, we may want to preconnect to handle the next
     // incoming stream.
@@ -287,6 +351,9 @@ ConnectionPool::Cancellable* ConnPoolImplBase::newStreamImpl(AttachContext& cont
     return nullptr;
   }
 
+  if (adaptive_preconnect) {
+    host_->cluster().trafficStats()->upstream_rq_preconnect_miss_.inc();
+  }
   ConnectionPool::Cancellable* pending = newPendingStream(context, can_send_early_data);
   ENVOY_LOG(debug, "trying to create new connection");
   ENVOY_LOG(trace, fmt::format("{}", *this));
@@ -575,6 +642,9 @@ void ConnPoolImplBase::onConnectionEvent(ActiveClient& client, absl::string_view
     ASSERT(connecting_stream_capacity_ >= client.currentUnusedCapacity());
     connecting_stream_capacity_ -= client.currentUnusedCapacity();
     client.has_handshake_completed_ = true;
+    if (host_->cluster().maxAdaptivePreconnectConnections() > 0) {
+      onConnectLatency(client.conn_connect_ms_->elapsed());
+    }
     client.conn_connect_ms_->complete();
     client.conn_connect_ms_.reset();
     if (client.state() == ActiveClient::State::Connecting ||
@@ -11,6 +11,7 @@
 #include "source/common/common/linked_object.h"
 
 #include "absl/strings/string_view.h"
+#include "absl/types/optional.h"
 #include "fmt/ostream.h"
 
 namespace Envoy {
@@ -345,6 +346,13 @@ protected:
 
   float perUpstreamPreconnectRatio() const;
 
+  // Whether a connection is needed for the streams predicted to arrive while it is established,
+  // when the adaptive preconnect is enabled.
+  bool shouldPreconnectForPredictedStreams() const;
+  // Updates the averages of the adaptive preconnect.
+  void onStreamArrival();
+  void onConnectLatency(std::chrono::milliseconds latency);
+
   ConnectionPool::Cancellable*
   addPendingStream(Envoy::ConnectionPool::PendingStreamPtr&& pending_stream) {
     LinkedList::moveIntoList(std::move(pending_stream), pending_streams_);
@@ -401,6 +409,11 @@ private:
   // The number of streams currently attached to clients.
   uint32_t num_active_streams_{0};
 
+  // The exponentially weighted moving averages of the adaptive preconnect, in seconds.
+  double stream_interval_average_{0};
+  double connect_latency_average_{0};
+  absl::optional<MonotonicTime> last_stream_time_;
+
   // Whether the connection pool is currently in the process of closing
   // all connections so that it can be gracefully deleted.
   bool is_draining_for_deletion_{false};
@@ -1,5 +1,6 @@
 #include "source/common/event/dispatcher_impl.h"
 
+#include <algorithm>
 #include <chrono>
 #include <cstdint>
 #include <functional>
@@ -26,6 +27,8 @@
 #include "source/common/filesystem/watcher_impl.h"
 #include "source/common/network/address_impl.h"
 #include "source/common/network/connection_impl.h"
+#include "source/common/profiler/sampling_profiler.h"
+#include "source/common/protobuf/utility.h"
 #include "source/common/runtime/runtime_features.h"
 
 #include "event2/event.h"
@@ -60,13 +63,16 @@ DispatcherImpl::DispatcherImpl(const std::string& name, Api::Api& api,
                      watermark_factory != nullptr
                          ? watermark_factory
                          : std::make_shared<Buffer::WatermarkBufferFactory>(
-                               api.bootstrap().overload_manager().buffer_factory_config())) {}
+                               api.bootstrap().overload_manager().buffer_factory_config()),
+                     api.bootstrap().deferred_deletion()) {}
 
 DispatcherImpl::DispatcherImpl(const std::string& name, Thread::ThreadFactory& thread_factory,
                                TimeSource& time_source, Filesystem::Instance& file_system,
                                Event::TimeSystem& time_system,
                                const ScaledRangeTimerManagerFactory& scaled_timer_factory,
-                               const Buffer::WatermarkFactorySharedPtr& watermark_factory)
+                               const Buffer::WatermarkFactorySharedPtr& watermark_factory,
+                               const envoy::config::bootstrap::v3::Bootstrap::DeferredDeletion&
+                                   deferred_deletion)
     : name_(name), thread_factory_(thread_factory), time_source_(time_source),
       file_system_(file_system), buffer_factory_(watermark_factory),
       scheduler_(time_system.createScheduler(base_scheduler_, base_scheduler_)),
@@ -74,13 +80,22 @@ DispatcherImpl::DispatcherImpl(const std::string& name, Thread::ThreadFactory& t
           base_scheduler_.createSchedulableCallback([this]() -> void { runThreadLocalDelete(); })),
       deferred_delete_cb_(base_scheduler_.createSchedulableCallback(
           [this]() -> void { clearDeferredDeleteList(); })),
+      max_deferred_deletes_per_pass_(
+          PROTOBUF_GET_WRAPPED_OR_DEFAULT(deferred_deletion, max_objects_per_pass, 0)),
+      max_deferred_delete_duration_(
+          deferred_deletion.has_max_duration_per_pass()
+              ? absl::make_optional(std::chrono::milliseconds(
+                    PROTOBUF_GET_MS_REQUIRED(deferred_deletion, max_duration_per_pass)))
+              : absl::nullopt),
       post_cb_(base_scheduler_.createSchedulableCallback([this]() -> void { runPostCallbacks(); })),
       current_to_delete_(&to_delete_1_), scaled_timer_manager_(scaled_timer_factory(*this)) {
   ASSERT(!name_.empty());
   FatalErrorHandler::registerFatalErrorHandler(*this);
   updateApproximateMonotonicTimeInternal();
-  base_scheduler_.registerOnPrepareCallback(
-      std::bind(&DispatcherImpl::updateApproximateMonotonicTime, this));
+  base_scheduler_.registerOnPrepareCallback([this]() {
+    updateApproximateMonotonicTime();
+    recordCallbackDurations();
+  });
 }
 
 DispatcherImpl::~DispatcherImpl() {
@@ -112,34 +127,61 @@ void DispatcherImpl::initializeStats(Stats::Scope& scope,
 
 void DispatcherImpl::clearDeferredDeleteList() {
   ASSERT(isThreadSafe());
-  std::vector<DeferredDeletablePtr>* to_delete = current_to_delete_;
-
-  size_t num_to_delete = to_delete->size();
-  if (deferred_deleting_ || !num_to_delete) {
+  if (deferred_deleting_) {
     return;
   }
 
-  ENVOY_LOG(trace, "clearing deferred deletion list (size={})", num_to_delete);
-
-  // Swap the current deletion vector so that if we do deferred delete while we are deleting, we
-  // use the other vector. We will get another callback to delete that vector.
-  if (current_to_delete_ == &to_delete_1_) {
-    current_to_delete_ = &to_delete_2_;
-  } else {
-    current_to_delete_ = &to_delete_1_;
+  // The objects left over by a bounded pass are destroyed before those deferred since.
+  std::vector<DeferredDeletablePtr>* to_delete =
+      current_to_delete_ == &to_delete_1_ ? &to_delete_2_ : &to_delete_1_;
+  if (next_to_delete_ == to_delete->size()) {
+    to_delete = current_to_delete_;
+    if (to_delete->empty()) {
+      return;
+    }
+    // Swap the current deletion vector so that if we do deferred delete while we are deleting, we
+    // use the other vector. We will get another callback to delete that vector.
+    current_to_delete_ = to_delete == &to_delete_1_ ? &to_delete_2_ : &to_delete_1_;
+    next_to_delete_ = 0;
   }
 
+  const size_t num_to_delete = to_delete->size();
+  ENVOY_LOG(trace, "clearing deferred deletion list (size={})", num_to_delete - next_to_delete_);
+
   touchWatchdog();
+  const CallbackDurationTimer timer(*this, &CallbackDurations::deferred_deletes_);
   deferred_deleting_ = true;
 
   // Calling clear() on the vector does not specify which order destructors run in. We want to
   // destroy in FIFO order so just do it manually. This required 2 passes over the vector which is
   // not optimal but can be cleaned up later if needed.
-  for (size_t i = 0; i < num_to_delete; i++) {
-    (*to_delete)[i].reset();
+  const size_t end =
+      max_deferred_deletes_per_pass_ > 0
+          ? std::min(num_to_delete, next_to_delete_ + max_deferred_deletes_per_pass_)
+          : num_to_delete;
+  const MonotonicTime deadline =
+      max_deferred_delete_duration_.has_value()
+          ? time_source_.monotonicTime() + max_deferred_delete_duration_.value()
+          : MonotonicTime::max();
+  while (next_to_delete_ < end) {
+    (*to_delete)[next_to_delete_++].reset();
+    if (max_deferred_delete_duration_.has_value() && time_source_.monotonicTime() >= deadline) {
+      break;
+    }
   }
 
-  to_delete->clear();
+  if (next_to_delete_ == num_to_delete) {
+    to_delete->clear();
+    next_to_delete_ = 0;
+  } else {
+    // Leave the rest to the next iteration of the loop, so that it polls in between.
+    ENVOY_LOG(debug, "deferred deletion pass left {} objects over",
+              num_to_delete - next_to_delete_);
+    if (stats_ != nullptr) {
+      stats_->deferred_delete_backlog_.recordValue(num_to_delete - next_to_delete_);
+    }
+    deferred_delete_cb_->scheduleCallbackNextIteration();
+  }
   deferred_deleting_ = false;
 }
 
@@ -178,6 +220,7 @@ FileEventPtr DispatcherImpl::createFileEvent(os_fd_t fd, FileReadyCb cb, FileTri
       *this, fd,
       [this, cb](uint32_t events) {
         touchWatchdog();
+        const CallbackDurationTimer timer(*this, &CallbackDurations::file_events_);
         return cb(events);
       },
       trigger, events)};
@@ -207,6 +250,7 @@ Event::SchedulableCallbackPtr DispatcherImpl::createSchedulableCallback(std::fun
   ASSERT(isThreadSafe());
   return base_scheduler_.createSchedulableCallback([this, cb]() {
     touchWatchdog();
+    const CallbackDurationTimer timer(*this, &CallbackDurations::schedulable_callbacks_);
     cb();
   });
 }
@@ -215,6 +259,7 @@ TimerPtr DispatcherImpl::createTimerInternal(TimerCb cb) {
   return scheduler_->createTimer(
       [this, cb]() {
         touchWatchdog();
+        const CallbackDurationTimer timer(*this, &CallbackDurations::timers_);
         cb();
       },
       *this);
@@ -239,15 +284,48 @@ SignalEventPtr DispatcherImpl::listenForSignal(signal_t signal_num, SignalCb cb)
   return SignalEventPtr{new SignalEventImpl(*this, signal_num, cb)};
 }
 
-void DispatcherImpl::post(PostCb callback) {
-  bool do_post;
-  {
-    Thread::LockGuard lock(post_lock_);
-    do_post = post_callbacks_.empty();
-    post_callbacks_.push_back(std::move(callback));
+DispatcherImpl::PostQueue::~PostQueue() {
+  PostNode* node = head_.load(std::memory_order_acquire);
+  while (node != nullptr) {
+    std::unique_ptr<PostNode> done(node);
+    node = node->next_;
   }
+}
+
+bool DispatcherImpl::PostQueue::push(PostCb&& callback) {
+  auto* node = new PostNode(std::move(callback));
+  node->next_ = head_.load(std::memory_order_relaxed);
+  while (!head_.compare_exchange_weak(node->next_, node, std::memory_order_release,
+                                      std::memory_order_relaxed)) {
+  }
+  return node->next_ == nullptr;
+}
 
-  if (do_post) {
+DispatcherImpl::PostNode* DispatcherImpl::PostQueue::popAll() {
+  PostNode* node = head_.exchange(nullptr, std::memory_order_acquire);
+  PostNode* reversed = nullptr;
+  while (node != nullptr) {
+    PostNode* next = node->next_;
+    node->next_ = reversed;
+    reversed = node;
+    node = next;
+  }
+  return reversed;
+}
+
+size_t DispatcherImpl::PostQueue::size() const {
+  size_t size = 0;
+  for (const PostNode* node = head_.load(std::memory_order_acquire); node != nullptr;
+       node = node->next_) {
+    ++size;
+  }
+  return size;
+}
+
+void DispatcherImpl::post(PostCb callback) {
+  // Only the post which finds the queue empty schedules the run, so the posts in between the runs
+  // of the loop take a single wakeup of the dispatcher thread.
+  if (post_callbacks_.push(std::move(callback))) {
     post_cb_->scheduleCallbackCurrentIteration();
   }
 }
@@ -287,11 +365,7 @@ void DispatcherImpl::shutdown() {
   // callbacks and dispatcher thread deletable objects.
   ASSERT(isThreadSafe());
   auto deferred_deletables_size = current_to_delete_->size();
-  std::list<std::function<void()>>::size_type post_callbacks_size;
-  {
-    Thread::LockGuard lock(post_lock_);
-    post_callbacks_size = post_callbacks_.size();
-  }
+  const size_t post_callbacks_size = post_callbacks_.size();
 
   std::list<DispatcherThreadDeletableConstPtr> local_deletables;
   {
@@ -316,6 +390,25 @@ void DispatcherImpl::updateApproximateMonotonicTimeInternal() {
   approximate_monotonic_time_ = time_source_.monotonicTime();
 }
 
+void DispatcherImpl::recordCallbackDurations() {
+  if (stats_ == nullptr) {
+    return;
+  }
+  const auto record = [](Stats::Histogram& histogram,
+                         absl::optional<MonotonicTime::duration>& duration) {
+    if (duration.has_value()) {
+      histogram.recordValue(
+          std::chrono::duration_cast<std::chrono::microseconds>(duration.value()).count());
+      duration.reset();
+    }
+  };
+  record(stats_->deferred_delete_duration_us_, callback_durations_.deferred_deletes_);
+  record(stats_->file_event_duration_us_, callback_durations_.file_events_);
+  record(stats_->post_callback_duration_us_, callback_durations_.post_callbacks_);
+  record(stats_->schedulable_callback_duration_us_, callback_durations_.schedulable_callbacks_);
+  record(stats_->timer_duration_us_, callback_durations_.timers_);
+}
+
 void DispatcherImpl::runThreadLocalDelete() {
   std::list<DispatcherThreadDeletableConstPtr> to_be_delete;
   {
@@ -337,27 +430,21 @@ void DispatcherImpl::runPostCallbacks() {
   // objects that is being deferred deleted.
   clearDeferredDeleteList();
 
-  std::list<PostCb> callbacks;
-  {
-    // Take ownership of the callbacks under the post_lock_. The lock must be released before
-    // callbacks execute. Callbacks added after this transfer will re-arm post_cb_ and will execute
-    // later in the event loop.
-    Thread::LockGuard lock(post_lock_);
-    callbacks = std::move(post_callbacks_);
-    // post_callbacks_ should be empty after the move.
-    ASSERT(post_callbacks_.empty());
-  }
-  // It is important that the execution and deletion of the callback happen while post_lock_ is not
-  // held. Either the invocation or destructor of the callback can call post() on this dispatcher.
-  while (!callbacks.empty()) {
+  // Take the queued callbacks at once. Callbacks added after this will re-arm post_cb_ and will
+  // execute later in the event loop. Either the invocation or destructor of the callback can call
+  // post() on this dispatcher.
+  const CallbackDurationTimer timer(*this, &CallbackDurations::post_callbacks_);
+  PostNode* next = post_callbacks_.popAll();
+  while (next != nullptr) {
+    // Destroy the node at the end of the iteration, so that the destructor of the callback that
+    // just executed runs before the next callback executes.
+    std::unique_ptr<PostNode> node(next);
+    next = node->next_;
     // Touch the watchdog before executing the callback to avoid spurious watchdog miss events when
     // executing a long list of callbacks.
     touchWatchdog();
     // Run the callback.
-    callbacks.front()();
-    // Pop the front so that the destructor of the callback that just executed runs before the next
-    // callback executes.
-    callbacks.pop_front();
+    node->callback_();
   }
 }
 
@@ -395,6 +482,7 @@ void DispatcherImpl::pushTrackedObject(const ScopeTrackedObject* object) {
   ASSERT(object != nullptr);
   tracked_object_stack_.push_back(object);
   ASSERT(tracked_object_stack_.size() <= ExpectedMaxTrackedObjectStackDepth);
+  Profiler::SamplingProfiler::setTrackedObject(object);
 }
 
 void DispatcherImpl::popTrackedObject(const ScopeTrackedObject* expected_object) {
@@ -406,6 +494,8 @@ void DispatcherImpl::popTrackedObject(const ScopeTrackedObject* expected_object)
   tracked_object_stack_.pop_back();
   ASSERT(top == expected_object,
          "Popped the top of the tracked object stack, but it wasn't the expected object!");
+  Profiler::SamplingProfiler::setTrackedObject(
+      tracked_object_stack_.empty() ? nullptr : tracked_object_stack_.back());
 }
 
 } // namespace Event
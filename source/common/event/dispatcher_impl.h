@@ -1,5 +1,6 @@
 #pragma once
 
+#include <atomic>
 #include <cstdint>
 #include <functional>
 #include <list>
@@ -9,6 +10,7 @@
 #include "envoy/api/api.h"
 #include "envoy/common/scope_tracker.h"
 #include "envoy/common/time.h"
+#include "envoy/config/bootstrap/v3/bootstrap.pb.h"
 #include "envoy/event/deferred_deletable.h"
 #include "envoy/event/dispatcher.h"
 #include "envoy/network/connection_handler.h"
@@ -21,6 +23,7 @@
 #include "source/common/signal/fatal_error_handler.h"
 
 #include "absl/container/inlined_vector.h"
+#include "absl/types/optional.h"
 
 namespace Envoy {
 namespace Event {
@@ -47,7 +50,9 @@ public:
                  TimeSource& time_source, Filesystem::Instance& file_system,
                  Event::TimeSystem& time_system,
                  const ScaledRangeTimerManagerFactory& scaled_timer_factory,
-                 const Buffer::WatermarkFactorySharedPtr& watermark_factory);
+                 const Buffer::WatermarkFactorySharedPtr& watermark_factory,
+                 const envoy::config::bootstrap::v3::Bootstrap::DeferredDeletion&
+                     deferred_deletion);
   ~DispatcherImpl() override;
 
   /**
@@ -125,10 +130,72 @@ private:
   };
   using WatchdogRegistrationPtr = std::unique_ptr<WatchdogRegistration>;
 
+  // The time spent in each category of callbacks during the current iteration of the loop, if the
+  // category ran at all. Only kept when the dispatcher stats are enabled.
+  struct CallbackDurations {
+    absl::optional<MonotonicTime::duration> deferred_deletes_;
+    absl::optional<MonotonicTime::duration> file_events_;
+    absl::optional<MonotonicTime::duration> post_callbacks_;
+    absl::optional<MonotonicTime::duration> schedulable_callbacks_;
+    absl::optional<MonotonicTime::duration> timers_;
+  };
+
+  // Adds the time until its destruction to a category of the callback durations, if the
+  // dispatcher stats are enabled.
+  class CallbackDurationTimer {
+  public:
+    CallbackDurationTimer(DispatcherImpl& dispatcher,
+                          absl::optional<MonotonicTime::duration> CallbackDurations::*category)
+        : dispatcher_(dispatcher), category_(dispatcher.stats_ != nullptr ? category : nullptr),
+          start_(category_ != nullptr ? dispatcher.time_source_.monotonicTime()
+                                      : MonotonicTime()) {}
+    ~CallbackDurationTimer() {
+      if (category_ != nullptr) {
+        auto& duration = dispatcher_.callback_durations_.*category_;
+        duration = duration.value_or(MonotonicTime::duration::zero()) +
+                   (dispatcher_.time_source_.monotonicTime() - start_);
+      }
+    }
+
+  private:
+    DispatcherImpl& dispatcher_;
+    absl::optional<MonotonicTime::duration> CallbackDurations::*const category_;
+    const MonotonicTime start_;
+  };
+
+  // A post callback, linked into the queue of the callbacks to run.
+  struct PostNode {
+    explicit PostNode(PostCb&& callback) : callback_(std::move(callback)) {}
+
+    PostCb callback_;
+    PostNode* next_{};
+  };
+
+  // A lock-free queue of the post callbacks, which any thread pushes to and the dispatcher thread
+  // takes all at once. The callbacks are pushed on a stack, and reversed into FIFO order when
+  // taken.
+  class PostQueue {
+  public:
+    ~PostQueue();
+
+    // Pushes the callback, and returns true if the queue was empty, in which case the caller
+    // schedules the run of the callbacks. Pushes in between are left to that run.
+    bool push(PostCb&& callback);
+    // Takes the queued callbacks, the oldest first. The caller owns the nodes.
+    PostNode* popAll();
+    // Returns the number of queued callbacks. Only called from the dispatcher thread.
+    size_t size() const;
+
+  private:
+    std::atomic<PostNode*> head_{};
+  };
+
   TimerPtr createTimerInternal(TimerCb cb);
   void updateApproximateMonotonicTimeInternal();
   void runPostCallbacks();
   void runThreadLocalDelete();
+  // Records the callback durations of the iteration of the loop that just ended.
+  void recordCallbackDurations();
 
   // Helper used to touch the watchdog after most schedulable, fd, and timer callbacks.
   void touchWatchdog();
@@ -159,19 +226,25 @@ private:
   bool shutdown_called_{false};
 
   SchedulableCallbackPtr deferred_delete_cb_;
+  // The bounds of a deferred deletion pass, zero or nullopt if unbounded.
+  const uint32_t max_deferred_deletes_per_pass_;
+  const absl::optional<std::chrono::milliseconds> max_deferred_delete_duration_;
 
   SchedulableCallbackPtr post_cb_;
-  Thread::MutexBasicLockable post_lock_;
-  std::list<PostCb> post_callbacks_ ABSL_GUARDED_BY(post_lock_);
+  PostQueue post_callbacks_;
 
   std::vector<DeferredDeletablePtr> to_delete_1_;
   std::vector<DeferredDeletablePtr> to_delete_2_;
   std::vector<DeferredDeletablePtr>* current_to_delete_;
+  // The position in the vector not taking new deletions of the first object left over by a bounded
+  // pass.
+  size_t next_to_delete_{};
 
   absl::InlinedVector<const ScopeTrackedObject*, ExpectedMaxTrackedObjectStackDepth>
       tracked_object_stack_;
   bool deferred_deleting_{};
   MonotonicTime approximate_monotonic_time_;
+  CallbackDurations callback_durations_;
   WatchdogRegistrationPtr watchdog_registration_;
   const ScaledRangeTimerManagerPtr scaled_timer_manager_;
 };
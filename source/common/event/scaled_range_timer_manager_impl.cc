@@ -11,6 +11,14 @@
 
 namespace Envoy {
 namespace Event {
+namespace {
+
+// The min durations from which the timers wait on the wheel, and the tick of the wheel. The wheel
+// fires them as precisely as a real Timer, which has millisecond precision.
+constexpr std::chrono::milliseconds CoarseTimerMinDuration{1000};
+constexpr std::chrono::milliseconds WheelTick{1};
+
+} // namespace
 
 /**
  * Implementation of Timer that can be scaled by the backing manager object.
@@ -30,7 +38,7 @@ namespace Event {
  * [scaling-max -> inactive -> waiting-for-min -> scaling-max] in a single
  * method call. The waiting-for-min transitions are elided for efficiency.
  */
-class ScaledRangeTimerManagerImpl::RangeTimerImpl final : public Timer {
+class ScaledRangeTimerManagerImpl::RangeTimerImpl final : public Timer, public TimerWheel::Entry {
 public:
   RangeTimerImpl(ScaledTimerMinimum minimum, TimerCb callback, ScaledRangeTimerManagerImpl& manager)
       : minimum_(minimum), manager_(manager), callback_(std::move(callback)),
@@ -43,7 +51,12 @@ public:
       Dispatch(RangeTimerImpl& timer) : timer_(timer) {}
       RangeTimerImpl& timer_;
       void operator()(const Inactive&) {}
-      void operator()(const WaitingForMin&) { timer_.min_duration_timer_->disableTimer(); }
+      void operator()(const WaitingForMin&) {
+        timer_.min_duration_timer_->disableTimer();
+        if (timer_.manager_.wheel_ != nullptr) {
+          timer_.manager_.wheel_->cancel(timer_);
+        }
+      }
       void operator()(ScalingMax& active) { timer_.manager_.removeTimer(active.handle_); }
     };
     absl::visit(Dispatch(*this), state_);
@@ -65,7 +78,11 @@ public:
       state_.emplace<ScalingMax>(handle);
     } else {
       state_.emplace<WaitingForMin>(max_ms - min_ms);
-      min_duration_timer_->enableTimer(std::min(max_ms, min_ms));
+      if (min_ms >= CoarseTimerMinDuration) {
+        manager_.wheel().schedule(*this, min_ms);
+      } else {
+        min_duration_timer_->enableTimer(min_ms);
+      }
     }
   }
 
@@ -109,6 +126,9 @@ private:
     ScaledRangeTimerManagerImpl::ScalingTimerHandle handle_;
   };
 
+  // TimerWheel::Entry
+  void onWheelTimer() override { onMinTimerComplete(); }
+
   /**
    * This is called when the min timer expires, on the dispatcher for the manager. It registers with
    * the manager so the duration can be scaled, unless the duration is zero in which case it just
@@ -163,6 +183,13 @@ TimerPtr ScaledRangeTimerManagerImpl::createTimer(ScaledTimerMinimum minimum, Ti
   return std::make_unique<RangeTimerImpl>(minimum, callback, *this);
 }
 
+TimerWheel& ScaledRangeTimerManagerImpl::wheel() {
+  if (wheel_ == nullptr) {
+    wheel_ = std::make_unique<TimerWheel>(dispatcher_, WheelTick);
+  }
+  return *wheel_;
+}
+
 void ScaledRangeTimerManagerImpl::setScaleFactor(UnitFloat scale_factor) {
   const MonotonicTime now = dispatcher_.approximateMonotonicTime();
   scale_factor_ = scale_factor;
@@ -7,6 +7,8 @@
 #include "envoy/event/scaled_range_timer_manager.h"
 #include "envoy/event/timer.h"
 
+#include "source/common/event/timer_wheel.h"
+
 #include "absl/container/flat_hash_map.h"
 
 namespace Envoy {
@@ -20,6 +22,9 @@ namespace Event {
  * expectation is that the number of (max - min) values used to enable timers is small, so the
  * number of queues is tightly bounded. The queue-based implementation depends on that expectation
  * for efficient operation.
+ *
+ * The timers whose min duration is coarse wait for it on a timer wheel, instead of each on a real
+ * Timer, so that enabling and disabling them doesn't churn the dispatcher's timers.
  */
 class ScaledRangeTimerManagerImpl : public ScaledRangeTimerManager {
 public:
@@ -122,10 +127,14 @@ private:
 
   void onQueueTimerFired(Queue& queue);
 
+  // Returns the wheel of the timers waiting for a coarse min duration, creating it on first use.
+  TimerWheel& wheel();
+
   Dispatcher& dispatcher_;
   const ScaledTimerTypeMapConstSharedPtr timer_minimums_;
   UnitFloat scale_factor_;
   absl::flat_hash_set<std::unique_ptr<Queue>, Hash, Eq> queues_;
+  std::unique_ptr<TimerWheel> wheel_;
 };
 
 } // namespace Event
@@ -0,0 +1,171 @@
+#include "source/common/event/timer_wheel.h"
+
+#include <algorithm>
+
+namespace Envoy {
+namespace Event {
+
+TimerWheel::TimerWheel(Dispatcher& dispatcher, std::chrono::milliseconds tick)
+    : time_source_(dispatcher.timeSource()), tick_(tick),
+      start_(time_source_.monotonicTime()), timer_(dispatcher.createTimer([this] { onTimer(); })) {
+  ASSERT(tick_ > MonotonicTime::duration::zero());
+  for (auto& level : slots_) {
+    for (Link& slot : level) {
+      slot.prev_ = slot.next_ = &slot;
+    }
+  }
+}
+
+TimerWheel::~TimerWheel() {
+  // The entries shouldn't outlive the wheel.
+  ASSERT(size_ == 0);
+}
+
+void TimerWheel::schedule(Entry& entry, std::chrono::milliseconds duration) {
+  cancel(entry);
+  const MonotonicTime now = time_source_.monotonicTime();
+  if (size_ == 0) {
+    // Catch up with the time while there is nothing to move down the wheel.
+    current_tick_ = std::max<uint64_t>(current_tick_, (now - start_) / tick_);
+  }
+  const MonotonicTime::duration expiry = now - start_ + duration;
+  entry.expiry_tick_ = std::max<uint64_t>((expiry + tick_ - MonotonicTime::duration(1)) / tick_,
+                                          current_tick_);
+  place(entry);
+  ++size_;
+  // The timer is armed again once the expired entries are processed.
+  if (!processing_ && (!armed_tick_.has_value() || entry.expiry_tick_ < armed_tick_.value())) {
+    arm(entry.expiry_tick_);
+  }
+}
+
+void TimerWheel::cancel(Entry& entry) {
+  if (!entry.scheduled()) {
+    return;
+  }
+  unlink(entry);
+  --size_;
+  // The timer is left armed, and finds nothing to do if the entry was the next to expire.
+}
+
+void TimerWheel::link(Link& slot, Link& link) {
+  link.prev_ = slot.prev_;
+  link.next_ = &slot;
+  slot.prev_->next_ = &link;
+  slot.prev_ = &link;
+}
+
+void TimerWheel::unlink(Link& link) {
+  link.prev_->next_ = link.next_;
+  link.next_->prev_ = link.prev_;
+  link.prev_ = link.next_ = nullptr;
+}
+
+uint64_t TimerWheel::nowTick() const { return (time_source_.monotonicTime() - start_) / tick_; }
+
+void TimerWheel::place(Entry& entry) {
+  ASSERT(entry.expiry_tick_ >= current_tick_);
+  uint64_t delta = entry.expiry_tick_ - current_tick_;
+  uint64_t tick = entry.expiry_tick_;
+  if (delta >= MaxDelta) {
+    delta = MaxDelta - 1;
+    tick = current_tick_ + delta;
+  }
+  uint32_t level = 0;
+  while (delta >= (uint64_t{1} << (SlotBits * (level + 1)))) {
+    ++level;
+  }
+  link(slots_[level][(tick >> (SlotBits * level)) & (Slots - 1)], entry);
+}
+
+uint64_t TimerWheel::nextTick() const {
+  // An entry of the first level expires at the tick of its slot. The entries of the levels above
+  // move down a level at the start of the turn of their slot.
+  uint64_t next_tick = UINT64_MAX;
+  for (uint64_t tick = current_tick_; tick < current_tick_ + Slots; ++tick) {
+    const Link& slot = slots_[0][tick & (Slots - 1)];
+    if (slot.next_ != &slot) {
+      next_tick = tick;
+      break;
+    }
+  }
+  for (uint32_t level = 1; level < Levels; ++level) {
+    const uint32_t shift = SlotBits * level;
+    const uint64_t first_turn = (current_tick_ + (uint64_t{1} << shift) - 1) >> shift;
+    for (uint64_t turn = first_turn; turn < first_turn + Slots; ++turn) {
+      const Link& slot = slots_[level][turn & (Slots - 1)];
+      if (slot.next_ != &slot) {
+        next_tick = std::min(next_tick, turn << shift);
+        break;
+      }
+    }
+  }
+  return next_tick;
+}
+
+void TimerWheel::processTick(uint64_t tick) {
+  current_tick_ = tick;
+  // Move down the entries of the slots whose turn starts at the tick.
+  for (uint32_t level = 1; level < Levels; ++level) {
+    const uint32_t shift = SlotBits * level;
+    if ((tick & ((uint64_t{1} << shift) - 1)) != 0) {
+      break;
+    }
+    Link& slot = slots_[level][(tick >> shift) & (Slots - 1)];
+    while (slot.next_ != &slot) {
+      auto& entry = static_cast<Entry&>(*slot.next_);
+      unlink(entry);
+      place(entry);
+    }
+  }
+
+  // Take the expired entries off the wheel before running any of them, so that the entries they
+  // schedule can't land among them.
+  Link expired;
+  expired.prev_ = expired.next_ = &expired;
+  Link& slot = slots_[0][tick & (Slots - 1)];
+  while (slot.next_ != &slot) {
+    Link& entry = *slot.next_;
+    unlink(entry);
+    link(expired, entry);
+  }
+  current_tick_ = tick + 1;
+  while (expired.next_ != &expired) {
+    auto& entry = static_cast<Entry&>(*expired.next_);
+    ASSERT(entry.expiry_tick_ == tick);
+    unlink(entry);
+    --size_;
+    entry.onWheelTimer();
+  }
+}
+
+void TimerWheel::onTimer() {
+  armed_tick_.reset();
+  const uint64_t now_tick = nowTick();
+  processing_ = true;
+  // Skip to the ticks with something to do, rather than going through each.
+  while (size_ > 0) {
+    const uint64_t tick = nextTick();
+    if (tick > now_tick) {
+      break;
+    }
+    processTick(tick);
+  }
+  processing_ = false;
+  current_tick_ = std::max(current_tick_, now_tick + 1);
+  if (size_ > 0) {
+    arm(nextTick());
+  }
+}
+
+void TimerWheel::arm(uint64_t tick) {
+  armed_tick_ = tick;
+  const MonotonicTime::duration delay =
+      start_ + tick_ * static_cast<int64_t>(tick) - time_source_.monotonicTime();
+  // Round up, so that the timer doesn't fire before the tick starts.
+  timer_->enableHRTimer(std::max(std::chrono::ceil<std::chrono::microseconds>(delay),
+                                 std::chrono::microseconds::zero()));
+}
+
+} // namespace Event
+} // namespace Envoy
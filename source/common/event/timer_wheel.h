@@ -0,0 +1,108 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+
+#include "envoy/common/pure.h"
+#include "envoy/common/time.h"
+#include "envoy/event/dispatcher.h"
+#include "envoy/event/timer.h"
+
+#include "source/common/common/assert.h"
+
+#include "absl/types/optional.h"
+
+namespace Envoy {
+namespace Event {
+
+/**
+ * A hierarchical timer wheel, for timers of which many may be enabled at once and which don't need
+ * to fire more precisely than a tick. Scheduling and cancelling a timer take constant time, and
+ * the timers expiring on the same tick fire together, from a single dispatcher timer which is only
+ * armed for the next tick with something to do.
+ *
+ * The first level of the wheel has a slot per tick. Each level above has a slot per turn of the
+ * level below, whose timers are moved down when the turn starts.
+ */
+class TimerWheel {
+private:
+  // A link of the circular lists of the slots, whose heads are the slots themselves.
+  struct Link {
+    Link* prev_{};
+    Link* next_{};
+  };
+
+public:
+  /**
+   * A timer scheduled on the wheel. It must not be destroyed while scheduled.
+   */
+  class Entry : Link {
+  public:
+    virtual ~Entry() { ASSERT(!scheduled()); }
+
+    bool scheduled() const { return next_ != nullptr; }
+
+    /**
+     * Called when the timer expires, once it is no longer scheduled.
+     */
+    virtual void onWheelTimer() PURE;
+
+  private:
+    friend class TimerWheel;
+
+    uint64_t expiry_tick_{};
+  };
+
+  TimerWheel(Dispatcher& dispatcher, std::chrono::milliseconds tick);
+  ~TimerWheel();
+
+  /**
+   * Schedules the entry to expire after the duration, rounded up to the next tick. The entry is
+   * rescheduled if it already was.
+   */
+  void schedule(Entry& entry, std::chrono::milliseconds duration);
+
+  /**
+   * Cancels the entry if it is scheduled.
+   */
+  void cancel(Entry& entry);
+
+  /**
+   * @return the number of scheduled entries.
+   */
+  size_t size() const { return size_; }
+
+private:
+  static constexpr uint32_t SlotBits = 6;
+  static constexpr uint64_t Slots = 1 << SlotBits;
+  static constexpr uint32_t Levels = 5;
+  // The entries expiring further away wait in the top level until they get closer.
+  static constexpr uint64_t MaxDelta = uint64_t{1} << (SlotBits * Levels);
+
+  static void link(Link& slot, Link& link);
+  static void unlink(Link& link);
+
+  uint64_t nowTick() const;
+  // Puts the entry in the slot of its expiry, relative to the current tick.
+  void place(Entry& entry);
+  // Returns the next tick at which an entry expires or moves down a level.
+  uint64_t nextTick() const;
+  void processTick(uint64_t tick);
+  void onTimer();
+  void arm(uint64_t tick);
+
+  TimeSource& time_source_;
+  const MonotonicTime::duration tick_;
+  const MonotonicTime start_;
+  const TimerPtr timer_;
+  std::array<std::array<Link, Slots>, Levels> slots_;
+  // The first tick whose entries haven't expired yet.
+  uint64_t current_tick_{};
+  absl::optional<uint64_t> armed_tick_;
+  size_t size_{};
+  bool processing_{};
+};
+
+} // namespace Event
+} // namespace Envoy
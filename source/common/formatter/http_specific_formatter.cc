@@ -79,13 +79,15 @@ AccessLogTypeFormatter::formatValueWithContext(const HttpFormatterContext& conte
 HeaderFormatter::HeaderFormatter(const std::string& main_header,
                                  const std::string& alternative_header,
                                  absl::optional<size_t> max_length)
-    : main_header_(main_header), alternative_header_(alternative_header), max_length_(max_length) {}
+    : main_header_(Http::LowerCaseString(main_header)),
+      alternative_header_(Http::LowerCaseString(alternative_header)), max_length_(max_length) {}
 
-const Http::HeaderEntry* HeaderFormatter::findHeader(const Http::HeaderMap& headers) const {
-  const auto header = headers.get(main_header_);
+template <class HeaderMapType>
+const Http::HeaderEntry* HeaderFormatter::findHeader(const HeaderMapType& headers) const {
+  const auto header = main_header_.get(headers);
 
-  if (header.empty() && !alternative_header_.get().empty()) {
-    const auto alternate_header = headers.get(alternative_header_);
+  if (header.empty() && !alternative_header_.name().get().empty()) {
+    const auto alternate_header = alternative_header_.get(headers);
     // TODO(https://github.com/envoyproxy/envoy/issues/13454): Potentially log all header values.
     return alternate_header.empty() ? nullptr : alternate_header[0];
   }
@@ -93,7 +95,8 @@ const Http::HeaderEntry* HeaderFormatter::findHeader(const Http::HeaderMap& head
   return header.empty() ? nullptr : header[0];
 }
 
-absl::optional<std::string> HeaderFormatter::format(const Http::HeaderMap& headers) const {
+template <class HeaderMapType>
+absl::optional<std::string> HeaderFormatter::format(const HeaderMapType& headers) const {
   const Http::HeaderEntry* header = findHeader(headers);
   if (!header) {
     return absl::nullopt;
@@ -104,7 +107,8 @@ absl::optional<std::string> HeaderFormatter::format(const Http::HeaderMap& heade
   return std::string(val);
 }
 
-ProtobufWkt::Value HeaderFormatter::formatValue(const Http::HeaderMap& headers) const {
+template <class HeaderMapType>
+ProtobufWkt::Value HeaderFormatter::formatValue(const HeaderMapType& headers) const {
   const Http::HeaderEntry* header = findHeader(headers);
   if (!header) {
     return SubstitutionFormatUtils::unspecifiedValue();
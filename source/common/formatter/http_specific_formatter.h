@@ -12,6 +12,7 @@
 
 #include "source/common/common/utility.h"
 #include "source/common/formatter/substitution_format_utility.h"
+#include "source/common/http/header_accessor.h"
 
 #include "absl/container/flat_hash_map.h"
 #include "absl/types/optional.h"
@@ -57,14 +58,17 @@ public:
                   absl::optional<size_t> max_length);
 
 protected:
-  absl::optional<std::string> format(const Http::HeaderMap& headers) const;
-  ProtobufWkt::Value formatValue(const Http::HeaderMap& headers) const;
+  template <class HeaderMapType>
+  absl::optional<std::string> format(const HeaderMapType& headers) const;
+  template <class HeaderMapType> ProtobufWkt::Value formatValue(const HeaderMapType& headers) const;
 
 private:
-  const Http::HeaderEntry* findHeader(const Http::HeaderMap& headers) const;
+  template <class HeaderMapType>
+  const Http::HeaderEntry* findHeader(const HeaderMapType& headers) const;
 
-  Http::LowerCaseString main_header_;
-  Http::LowerCaseString alternative_header_;
+  // Accessors are used so that headers registered as inline headers are found in O(1).
+  const Http::HeaderAccessor main_header_;
+  const Http::HeaderAccessor alternative_header_;
   absl::optional<size_t> max_length_;
 };
 
@@ -111,7 +111,7 @@ private:
   const Envoy::StreamInfo::FilterState::Object*
   filterState(const StreamInfo::StreamInfo& stream_info) const;
 
-  std::string key_;
+  const StreamInfo::FilterState::Key key_;
   absl::optional<size_t> max_length_;
 
   const bool is_upstream_;
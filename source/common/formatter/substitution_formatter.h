@@ -11,10 +11,13 @@
 #include "envoy/formatter/substitution_formatter.h"
 #include "envoy/stream_info/stream_info.h"
 
+#include "source/common/buffer/buffer_impl.h"
 #include "source/common/common/utility.h"
 #include "source/common/formatter/http_specific_formatter.h"
 #include "source/common/formatter/stream_info_formatter.h"
 #include "source/common/json/json_loader.h"
+#include "source/common/json/json_sanitizer.h"
+#include "source/common/json/json_streamer.h"
 
 #include "absl/container/flat_hash_map.h"
 #include "absl/types/optional.h"
@@ -374,6 +377,179 @@ private:
 template <class FormatterContext>
 using StructFormatterBasePtr = std::unique_ptr<StructFormatterBase<FormatterContext>>;
 
+/**
+ * A formatter for JSON log formats which doesn't build a Struct for each log line. The format is
+ * compiled once into a flat sequence of literal JSON fragments, i.e. the keys and the punctuation,
+ * and of the providers of the values, which are streamed into an output buffer. The properties are
+ * sorted, as in the JSON serialization of a Struct.
+ */
+template <class FormatterContext> class JsonStreamingFormatterBase {
+public:
+  using CommandParsers = std::vector<CommandParserBasePtr<FormatterContext>>;
+  using PlainNumber = PlainNumberFormatterBase<FormatterContext>;
+
+  JsonStreamingFormatterBase(const ProtobufWkt::Struct& format_mapping, bool preserve_types,
+                             const CommandParsers& commands = {})
+      : preserve_types_(preserve_types) {
+    compileMap(format_mapping, commands);
+  }
+
+  void format(const FormatterContext& context, const StreamInfo::StreamInfo& info,
+              Buffer::Instance& output) const {
+    Json::Streamer streamer(output);
+    for (const FormatElement& element : elements_) {
+      if (element.providers_.empty()) {
+        streamer.addConstantString(element.literal_);
+      } else {
+        addValue(streamer, element.providers_, context, info);
+      }
+    }
+  }
+
+private:
+  // Either a literal JSON fragment, or the providers of a value.
+  struct FormatElement {
+    std::string literal_;
+    std::vector<FormatterProviderBasePtr<FormatterContext>> providers_;
+  };
+
+  // Methods for compiling the format.
+  void appendLiteral(absl::string_view literal) {
+    if (elements_.empty() || !elements_.back().providers_.empty()) {
+      elements_.emplace_back();
+    }
+    elements_.back().literal_.append(literal.data(), literal.size());
+  }
+  void compileMap(const ProtobufWkt::Struct& struct_format, const CommandParsers& commands) {
+    std::string sanitize_buffer;
+    bool first = true;
+    appendLiteral("{");
+    for (const auto& [key, value] : sortedFields(struct_format)) {
+      appendLiteral(
+          absl::StrCat(first ? "\"" : ",\"", Json::sanitize(sanitize_buffer, key), "\":"));
+      first = false;
+      compileValue(*value, commands);
+    }
+    appendLiteral("}");
+  }
+  void compileValue(const ProtobufWkt::Value& value, const CommandParsers& commands) {
+    switch (value.kind_case()) {
+    case ProtobufWkt::Value::kStringValue:
+      if (value.string_value().find('%') == std::string::npos) {
+        // A string without commands is a literal.
+        std::string sanitize_buffer;
+        appendLiteral(
+            absl::StrCat("\"", Json::sanitize(sanitize_buffer, value.string_value()), "\""));
+      } else {
+        elements_.push_back({"", SubstitutionFormatParser::parse<FormatterContext>(
+                                     value.string_value(), commands)});
+      }
+      break;
+
+    case ProtobufWkt::Value::kStructValue:
+      compileMap(value.struct_value(), commands);
+      break;
+
+    case ProtobufWkt::Value::kListValue:
+      appendLiteral("[");
+      for (int i = 0; i < value.list_value().values_size(); ++i) {
+        if (i > 0) {
+          appendLiteral(",");
+        }
+        compileValue(value.list_value().values(i), commands);
+      }
+      appendLiteral("]");
+      break;
+
+    case ProtobufWkt::Value::kNumberValue: {
+      std::vector<FormatterProviderBasePtr<FormatterContext>> providers;
+      providers.emplace_back(
+          FormatterProviderBasePtr<FormatterContext>{new PlainNumber(value.number_value())});
+      elements_.push_back({"", std::move(providers)});
+      break;
+    }
+
+    default:
+      throwEnvoyExceptionOrPanic(
+          "Only string values, nested structs, list values and number values are "
+          "supported in structured access log format.");
+    }
+  }
+
+  // Methods for doing the actual formatting.
+  void addValue(Json::Streamer& streamer,
+                const std::vector<FormatterProviderBasePtr<FormatterContext>>& providers,
+                const FormatterContext& context, const StreamInfo::StreamInfo& info) const {
+    if (providers.size() == 1) {
+      const auto& provider = providers.front();
+      if (preserve_types_) {
+        addProtoValue(streamer, provider->formatValueWithContext(context, info));
+        return;
+      }
+      const absl::optional<std::string> str = provider->formatWithContext(context, info);
+      streamer.addSanitized("\"", str.has_value() ? absl::string_view(*str) : EmptyValue, "\"");
+      return;
+    }
+    // Multiple providers forces string output.
+    std::string str;
+    for (const auto& provider : providers) {
+      const absl::optional<std::string> bit = provider->formatWithContext(context, info);
+      absl::StrAppend(&str, bit.has_value() ? absl::string_view(*bit) : EmptyValue);
+    }
+    streamer.addSanitized("\"", str, "\"");
+  }
+  static void addProtoValue(Json::Streamer& streamer, const ProtobufWkt::Value& value) {
+    switch (value.kind_case()) {
+    case ProtobufWkt::Value::kStringValue:
+      streamer.addSanitized("\"", value.string_value(), "\"");
+      break;
+    case ProtobufWkt::Value::kNumberValue:
+      streamer.addNumber(value.number_value());
+      break;
+    case ProtobufWkt::Value::kBoolValue:
+      streamer.addBool(value.bool_value());
+      break;
+    case ProtobufWkt::Value::kStructValue: {
+      bool first = true;
+      streamer.addConstantString("{");
+      for (const auto& [key, field] : sortedFields(value.struct_value())) {
+        streamer.addSanitized(first ? "\"" : ",\"", key, "\":");
+        first = false;
+        addProtoValue(streamer, *field);
+      }
+      streamer.addConstantString("}");
+      break;
+    }
+    case ProtobufWkt::Value::kListValue:
+      streamer.addConstantString("[");
+      for (int i = 0; i < value.list_value().values_size(); ++i) {
+        if (i > 0) {
+          streamer.addConstantString(",");
+        }
+        addProtoValue(streamer, value.list_value().values(i));
+      }
+      streamer.addConstantString("]");
+      break;
+    default:
+      streamer.addConstantString("null");
+      break;
+    }
+  }
+  static std::map<absl::string_view, const ProtobufWkt::Value*>
+  sortedFields(const ProtobufWkt::Struct& struct_value) {
+    std::map<absl::string_view, const ProtobufWkt::Value*> fields;
+    for (const auto& [key, value] : struct_value.fields()) {
+      fields.emplace(key, &value);
+    }
+    return fields;
+  }
+
+  static constexpr absl::string_view EmptyValue = DefaultUnspecifiedValueStringView;
+
+  const bool preserve_types_;
+  std::vector<FormatElement> elements_;
+};
+
 template <class FormatterContext>
 class JsonFormatterBaseImpl : public FormatterBase<FormatterContext> {
 public:
@@ -382,13 +558,30 @@ public:
   JsonFormatterBaseImpl(const ProtobufWkt::Struct& format_mapping, bool preserve_types,
                         bool omit_empty_values, bool sort_properties,
                         const CommandParsers& commands = {})
-      : struct_formatter_(format_mapping, preserve_types, omit_empty_values, commands),
-        sort_properties_(sort_properties) {}
+      : sort_properties_(sort_properties) {
+    // Whether the key of a value is omitted is only known once the value is formatted, so the
+    // log lines omitting the empty values are built as a Struct.
+    if (omit_empty_values) {
+      struct_formatter_ = std::make_unique<StructFormatterBase<FormatterContext>>(
+          format_mapping, preserve_types, omit_empty_values, commands);
+    } else {
+      streaming_formatter_ = std::make_unique<JsonStreamingFormatterBase<FormatterContext>>(
+          format_mapping, preserve_types, commands);
+    }
+  }
 
   // FormatterBase
   std::string formatWithContext(const FormatterContext& context,
                                 const StreamInfo::StreamInfo& info) const override {
-    const ProtobufWkt::Struct output_struct = struct_formatter_.formatWithContext(context, info);
+    if (streaming_formatter_ != nullptr) {
+      // The properties are always sorted.
+      Buffer::OwnedImpl output;
+      streaming_formatter_->format(context, info, output);
+      output.add("\n");
+      return output.toString();
+    }
+
+    const ProtobufWkt::Struct output_struct = struct_formatter_->formatWithContext(context, info);
 
     std::string log_line = "";
 #ifdef ENVOY_ENABLE_YAML
@@ -405,7 +598,8 @@ public:
   }
 
 private:
-  const StructFormatterBase<FormatterContext> struct_formatter_;
+  std::unique_ptr<JsonStreamingFormatterBase<FormatterContext>> streaming_formatter_;
+  StructFormatterBasePtr<FormatterContext> struct_formatter_;
   const bool sort_properties_;
 };
 
@@ -273,11 +273,38 @@ void AsyncStreamImpl::onReset() {
 }
 
 void AsyncStreamImpl::sendMessageRaw(Buffer::InstancePtr&& buffer, bool end_stream) {
+  flushCorkedMessages();
   Common::prependGrpcFrameHeader(*buffer);
   stream_->sendData(*buffer, end_stream);
 }
 
+void AsyncStreamImpl::sendMessageRawCorked(Buffer::InstancePtr&& buffer) {
+  Common::prependGrpcFrameHeader(*buffer);
+  corked_messages_.move(*buffer);
+  if (flush_corked_messages_ == nullptr) {
+    flush_corked_messages_ = dispatcher_->createSchedulableCallback([this]() {
+      if (!http_reset_) {
+        flushCorkedMessages();
+      }
+    });
+  }
+  if (!flush_corked_messages_->enabled()) {
+    flush_corked_messages_->scheduleCallbackCurrentIteration();
+  }
+}
+
+void AsyncStreamImpl::flushCorkedMessages() {
+  if (corked_messages_.length() == 0) {
+    return;
+  }
+  flush_corked_messages_->cancel();
+  stream_->sendData(corked_messages_, false);
+  // The stream doesn't necessarily drain what it was given.
+  corked_messages_.drain(corked_messages_.length());
+}
+
 void AsyncStreamImpl::closeStream() {
+  flushCorkedMessages();
   Buffer::OwnedImpl empty_buffer;
   stream_->sendData(empty_buffer, true);
   current_span_->setTag(Tracing::Tags::get().Status, Tracing::Tags::get().Canceled);
@@ -287,6 +314,9 @@ void AsyncStreamImpl::closeStream() {
 void AsyncStreamImpl::resetStream() { cleanup(); }
 
 void AsyncStreamImpl::cleanup() {
+  if (flush_corked_messages_ != nullptr) {
+    flush_corked_messages_->cancel();
+  }
   if (!http_reset_) {
     http_reset_ = true;
     stream_->reset();
@@ -79,6 +79,7 @@ public:
 
   // Grpc::AsyncStream
   void sendMessageRaw(Buffer::InstancePtr&& request, bool end_stream) override;
+  void sendMessageRawCorked(Buffer::InstancePtr&& request) override;
   void closeStream() override;
   void resetStream() override;
   bool isAboveWriteBufferHighWatermark() const override {
@@ -96,6 +97,8 @@ private:
   void streamError(Status::GrpcStatus grpc_status) { streamError(grpc_status, EMPTY_STRING); }
 
   void cleanup();
+  // Writes the corked messages to the stream.
+  void flushCorkedMessages();
   void trailerResponse(absl::optional<Status::GrpcStatus> grpc_status,
                        const std::string& grpc_message);
 
@@ -116,6 +119,9 @@ private:
   Decoder decoder_;
   // This is a member to avoid reallocation on every onData().
   std::vector<Frame> decoded_frames_;
+  // The framed messages sent with sendMessageRawCorked() during this iteration of the event loop.
+  Buffer::OwnedImpl corked_messages_;
+  Event::SchedulableCallbackPtr flush_corked_messages_;
 
   friend class AsyncClientImpl;
 };
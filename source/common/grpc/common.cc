@@ -190,13 +190,18 @@ Buffer::InstancePtr Common::serializeToGrpcFrame(const Protobuf::Message& messag
 Buffer::InstancePtr Common::serializeMessage(const Protobuf::Message& message) {
   auto body = std::make_unique<Buffer::OwnedImpl>();
   const uint32_t size = message.ByteSize();
-  auto reservation = body->reserveSingleSlice(size);
-  ASSERT(reservation.slice().len_ >= size);
-  uint8_t* current = reinterpret_cast<uint8_t*>(reservation.slice().mem_);
+  // Leave room for a frame header in front of the message, so that prependGrpcFrameHeader() writes
+  // it in the same slice instead of allocating another one, e.g. when the message is sent on an
+  // Envoy gRPC stream.
+  const uint32_t alloc_size = size + GRPC_FRAME_HEADER_SIZE;
+  auto reservation = body->reserveSingleSlice(alloc_size);
+  ASSERT(reservation.slice().len_ >= alloc_size);
+  uint8_t* current = reinterpret_cast<uint8_t*>(reservation.slice().mem_) + GRPC_FRAME_HEADER_SIZE;
   Protobuf::io::ArrayOutputStream stream(current, size, -1);
   Protobuf::io::CodedOutputStream codec_stream(&stream);
   message.SerializeWithCachedSizes(&codec_stream);
-  reservation.commit(size);
+  reservation.commit(alloc_size);
+  body->drain(GRPC_FRAME_HEADER_SIZE);
   return body;
 }
 
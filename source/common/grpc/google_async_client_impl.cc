@@ -1,5 +1,8 @@
 #include "source/common/grpc/google_async_client_impl.h"
 
+#include <algorithm>
+#include <vector>
+
 #include "envoy/common/time.h"
 #include "envoy/config/core/v3/grpc_service.pb.h"
 #include "envoy/http/protocol.h"
@@ -16,6 +19,7 @@
 #include "source/common/router/header_parser.h"
 #include "source/common/tracing/http_tracer_impl.h"
 
+#include "absl/container/inlined_vector.h"
 #include "absl/strings/str_cat.h"
 #include "grpcpp/support/proto_buffer_reader.h"
 
@@ -23,7 +27,9 @@ namespace Envoy {
 namespace Grpc {
 namespace {
 static constexpr int DefaultBufferLimitBytes = 1024 * 1024;
-}
+// The maximum number of completions delivered to the dispatchers of their streams at once.
+static constexpr uint32_t MaxCompletionBatchSize = 64;
+} // namespace
 
 GoogleAsyncClientThreadLocal::GoogleAsyncClientThreadLocal(Api::Api& api)
     : completion_thread_(api.threadFactory().createThread([this] { completionThread(); },
@@ -54,25 +60,60 @@ void GoogleAsyncClientThreadLocal::completionThread() {
   ENVOY_LOG(debug, "completionThread running");
   void* tag;
   bool ok;
-  while (cq_.Next(&tag, &ok)) {
-    const auto& google_async_tag = *reinterpret_cast<GoogleAsyncTag*>(tag);
-    const GoogleAsyncTag::Operation op = google_async_tag.op_;
-    GoogleAsyncStreamImpl& stream = google_async_tag.stream_;
-    ENVOY_LOG(trace, "completionThread CQ event {} {}", op, ok);
-    Thread::LockGuard lock(stream.completed_ops_lock_);
-
-    // It's an invariant that there must only be one pending post for arbitrary
-    // length completed_ops_, otherwise we can race in stream destruction, where
-    // we process multiple events in onCompletedOps() but have only partially
-    // consumed the posts on the dispatcher.
-    // TODO(htuch): This may result in unbounded processing on the silo thread
-    // in onCompletedOps() in extreme cases, when we emplace_back() in
-    // completionThread() at a high rate, consider bounding the length of such
-    // sequences if this behavior becomes an issue.
-    if (stream.completed_ops_.empty()) {
-      stream.dispatcher_.post([&stream] { stream.onCompletedOps(); });
+  bool shutdown = !cq_.Next(&tag, &ok);
+  while (!shutdown) {
+    // The completions which are already available are delivered together, with a single post to
+    // the dispatcher of their streams, so that a busy client wakes up its silo thread once per
+    // batch of completions rather than once per stream.
+    absl::InlinedVector<std::pair<Event::Dispatcher*, std::vector<GoogleAsyncStreamImpl*>>, 1>
+        batches;
+    for (uint32_t completions = 0;;) {
+      const auto& google_async_tag = *reinterpret_cast<GoogleAsyncTag*>(tag);
+      const GoogleAsyncTag::Operation op = google_async_tag.op_;
+      GoogleAsyncStreamImpl& stream = google_async_tag.stream_;
+      ENVOY_LOG(trace, "completionThread CQ event {} {}", op, ok);
+      {
+        Thread::LockGuard lock(stream.completed_ops_lock_);
+
+        // It's an invariant that there must only be one pending post for arbitrary
+        // length completed_ops_, otherwise we can race in stream destruction, where
+        // we process multiple events in onCompletedOps() but have only partially
+        // consumed the posts on the dispatcher.
+        // TODO(htuch): This may result in unbounded processing on the silo thread
+        // in onCompletedOps() in extreme cases, when we emplace_back() in
+        // completionThread() at a high rate, consider bounding the length of such
+        // sequences if this behavior becomes an issue.
+        if (stream.completed_ops_.empty()) {
+          auto batch = std::find_if(batches.begin(), batches.end(), [&stream](const auto& batch) {
+            return batch.first == &stream.dispatcher_;
+          });
+          if (batch == batches.end()) {
+            batch = batches.emplace(batches.end(), &stream.dispatcher_,
+                                    std::vector<GoogleAsyncStreamImpl*>());
+          }
+          batch->second.push_back(&stream);
+        }
+        stream.completed_ops_.emplace_back(op, ok);
+      }
+      if (++completions == MaxCompletionBatchSize) {
+        break;
+      }
+      const auto status = cq_.AsyncNext(&tag, &ok, gpr_time_0(GPR_CLOCK_MONOTONIC));
+      if (status != grpc::CompletionQueue::GOT_EVENT) {
+        shutdown = status == grpc::CompletionQueue::SHUTDOWN;
+        break;
+      }
+    }
+    for (auto& [dispatcher, streams] : batches) {
+      dispatcher->post([streams = std::move(streams)] {
+        for (GoogleAsyncStreamImpl* stream : streams) {
+          stream->onCompletedOps();
+        }
+      });
+    }
+    if (!shutdown) {
+      shutdown = !cq_.Next(&tag, &ok);
     }
-    stream.completed_ops_.emplace_back(op, ok);
   }
   ENVOY_LOG(debug, "completionThread exiting");
 }
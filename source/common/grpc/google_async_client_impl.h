@@ -106,7 +106,8 @@ private:
   // operations on the GoogleAsyncClientImpl silo thread, and then synchronously
   // blocking on a completion queue, cq_, on a distinct thread. When cq_ events
   // are delivered, we cross-post to the silo dispatcher to continue the
-  // operation.
+  // operation. The completions already available when a cq_ event is delivered
+  // are cross-posted with it, as a batch.
   //
   // We have an independent completion thread for each TLS silo (i.e. one per worker and
   // also one for the main thread).
@@ -15,6 +15,10 @@ void sendMessageUntyped(RawAsyncStream* stream, const Protobuf::Message& request
   stream->sendMessageRaw(Common::serializeMessage(request), end_stream);
 }
 
+void sendMessageCorkedUntyped(RawAsyncStream* stream, const Protobuf::Message& request) {
+  stream->sendMessageRawCorked(Common::serializeMessage(request));
+}
+
 ProtobufTypes::MessagePtr parseMessageUntyped(ProtobufTypes::MessagePtr&& message,
                                               Buffer::InstancePtr&& response) {
   // TODO(htuch): Need to add support for compressed responses as well here.
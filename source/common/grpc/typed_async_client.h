@@ -15,6 +15,7 @@ namespace Internal {
  * Forward declarations for helper functions.
  */
 void sendMessageUntyped(RawAsyncStream* stream, const Protobuf::Message& request, bool end_stream);
+void sendMessageCorkedUntyped(RawAsyncStream* stream, const Protobuf::Message& request);
 ProtobufTypes::MessagePtr parseMessageUntyped(ProtobufTypes::MessagePtr&& message,
                                               Buffer::InstancePtr&& response);
 RawAsyncStream* startUntyped(RawAsyncClient* client,
@@ -38,6 +39,12 @@ public:
   void sendMessage(const Protobuf::Message& request, bool end_stream) {
     Internal::sendMessageUntyped(stream_, std::move(request), end_stream);
   }
+  void sendMessageRaw(Buffer::InstancePtr&& request, bool end_stream) {
+    stream_->sendMessageRaw(std::move(request), end_stream);
+  }
+  void sendMessageCorked(const Protobuf::Message& request) {
+    Internal::sendMessageCorkedUntyped(stream_, request);
+  }
   void closeStream() { stream_->closeStream(); }
   void resetStream() { stream_->resetStream(); }
   bool isAboveWriteBufferHighWatermark() const {
@@ -78,6 +78,20 @@ AsyncClientImpl::startRequest(RequestHeaderMapPtr&& request_headers, Callbacks&
   return internalStartRequest(async_request);
 }
 
+std::shared_ptr<NullRouteImpl>
+AsyncClientImpl::sharedRoute(const absl::optional<std::chrono::milliseconds>& timeout) {
+  const int64_t key = timeout.has_value() ? timeout->count() : -1;
+  if (auto it = shared_routes_.find(key); it != shared_routes_.end()) {
+    return it->second;
+  }
+  auto route = std::make_shared<NullRouteImpl>(cluster_->name(), defaultRetryPolicy(),
+                                               factory_context_.regexEngine(), timeout);
+  if (shared_routes_.size() < MaxSharedRoutes) {
+    shared_routes_.emplace(key, route);
+  }
+  return route;
+}
+
 AsyncClient::Stream* AsyncClientImpl::start(AsyncClient::StreamCallbacks& callbacks,
                                             const AsyncClient::StreamOptions& options) {
   auto stream_or_error = AsyncStreamImpl::create(*this, callbacks, options);
@@ -102,12 +116,25 @@ createRetryPolicy(AsyncClientImpl& parent, const AsyncClient::StreamOptions& opt
     creation_status = policy_or_error.status();
     return policy_or_error.status().ok() ? std::move(policy_or_error.value()) : nullptr;
   }
-  if (options.parsed_retry_policy == nullptr) {
-    return std::make_unique<Router::RetryPolicyImpl>();
-  }
+  // The streams without a retry policy use the default one of the client.
   return nullptr;
 }
 
+std::shared_ptr<NullRouteImpl>
+AsyncStreamImpl::createRoute(AsyncClientImpl& parent, const AsyncClient::StreamOptions& options,
+                             const Router::RetryPolicy* retry_policy) {
+  if (retry_policy == nullptr) {
+    retry_policy = options.parsed_retry_policy;
+  }
+  if (retry_policy == nullptr && options.hash_policy.empty()) {
+    return parent.sharedRoute(options.timeout);
+  }
+  return std::make_shared<NullRouteImpl>(
+      parent.cluster_->name(),
+      retry_policy != nullptr ? *retry_policy : AsyncClientImpl::defaultRetryPolicy(),
+      parent.factory_context_.regexEngine(), options.timeout, options.hash_policy);
+}
+
 AsyncStreamImpl::AsyncStreamImpl(AsyncClientImpl& parent, AsyncClient::StreamCallbacks& callbacks,
                                  const AsyncClient::StreamOptions& options,
                                  absl::Status& creation_status)
@@ -122,10 +149,7 @@ AsyncStreamImpl::AsyncStreamImpl(AsyncClientImpl& parent, AsyncClient::StreamCal
                              StreamInfo::FilterState::LifeSpan::FilterChain)),
       tracing_config_(Tracing::EgressConfig::get()),
       retry_policy_(createRetryPolicy(parent, options, parent_.factory_context_, creation_status)),
-      route_(std::make_shared<NullRouteImpl>(
-          parent_.cluster_->name(),
-          retry_policy_ != nullptr ? *retry_policy_ : *options.parsed_retry_policy,
-          parent_.factory_context_.regexEngine(), options.timeout, options.hash_policy)),
+      route_(createRoute(parent, options, retry_policy_.get())),
       account_(options.account_), buffer_limit_(options.buffer_limit_), send_xff_(options.send_xff),
       send_internal_(options.send_internal) {
   stream_info_.dynamicMetadata().MergeFrom(options.metadata);
@@ -36,6 +36,7 @@
 #include "source/common/common/assert.h"
 #include "source/common/common/empty_string.h"
 #include "source/common/common/linked_object.h"
+#include "source/common/common/macros.h"
 #include "source/common/http/message_impl.h"
 #include "source/common/http/null_route_impl.h"
 #include "source/common/router/config_impl.h"
@@ -45,6 +46,8 @@
 #include "source/common/upstream/retry_factory.h"
 #include "source/extensions/early_data/default_early_data_policy.h"
 
+#include "absl/container/flat_hash_map.h"
+
 namespace Envoy {
 namespace Http {
 namespace {
@@ -79,11 +82,26 @@ public:
   static const absl::string_view ResponseBufferLimit;
 
 private:
+  // The maximum number of different timeouts for which a route is kept in shared_routes_.
+  static constexpr size_t MaxSharedRoutes = 16;
+
   template <typename T> T* internalStartRequest(T* async_request);
+  // Returns the route of the streams with the timeout but without their own retry or hash policy,
+  // which is shared by all of them instead of being built again for each one.
+  std::shared_ptr<NullRouteImpl>
+  sharedRoute(const absl::optional<std::chrono::milliseconds>& timeout);
+  // The retry policy of the streams without one, which doesn't retry. It outlives the clients, as
+  // their streams may be deleted after them.
+  static const Router::RetryPolicyImpl& defaultRetryPolicy() {
+    CONSTRUCT_ON_FIRST_USE(Router::RetryPolicyImpl);
+  }
+
   const Router::FilterConfigSharedPtr config_;
   Event::Dispatcher& dispatcher_;
   std::list<std::unique_ptr<AsyncStreamImpl>> active_streams_;
   Runtime::Loader& runtime_;
+  // The shared routes by timeout in milliseconds, or by -1 for no timeout.
+  absl::flat_hash_map<int64_t, std::shared_ptr<NullRouteImpl>> shared_routes_;
 
   friend class AsyncStreamImpl;
   friend class AsyncRequestSharedImpl;
@@ -168,6 +186,9 @@ protected:
   const bool discard_response_body_;
 
 private:
+  static std::shared_ptr<NullRouteImpl> createRoute(AsyncClientImpl& parent,
+                                                    const AsyncClient::StreamOptions& options,
+                                                    const Router::RetryPolicy* retry_policy);
   void cleanup();
   void closeRemote(bool end_stream);
   bool complete() { return local_closed_ && remote_closed_; }
@@ -263,6 +284,7 @@ private:
   OptRef<DownstreamStreamFilterCallbacks> downstreamCallbacks() override { return {}; }
   OptRef<UpstreamStreamFilterCallbacks> upstreamCallbacks() override { return {}; }
   void resetIdleTimer() override {}
+  void disableDataCallbacks() override {}
   void setUpstreamOverrideHost(Upstream::LoadBalancerContext::OverrideHost) override {}
   absl::optional<Upstream::LoadBalancerContext::OverrideHost>
   upstreamOverrideHost() const override {
@@ -36,6 +36,7 @@
 #include "source/common/http/codes.h"
 #include "source/common/http/conn_manager_utility.h"
 #include "source/common/http/exception.h"
+#include "source/common/http/header_map_arena.h"
 #include "source/common/http/header_map_impl.h"
 #include "source/common/http/header_utility.h"
 #include "source/common/http/headers.h"
@@ -474,6 +475,13 @@ Network::FilterStatus ConnectionManagerImpl::onData(Buffer::Instance& data, bool
     // Close connections if Envoy is under pressure, typically memory, before creating codec.
     if (hcm_ondata_creating_codec_ != nullptr && hcm_ondata_creating_codec_->shouldShedLoad()) {
       stats_.named_.downstream_rq_overload_close_.inc();
+      if (Runtime::runtimeFeatureEnabled(
+              "envoy.reloadable_features.hcm_canned_overload_response")) {
+        // Answer from the raw bytes, without creating a codec and decoding the request.
+        Buffer::OwnedImpl response(ConnectionManagerUtility::overloadedConnectionResponse(
+            read_callbacks_->connection(), data, config_->appendLocalOverload()));
+        read_callbacks_->connection().write(response, false);
+      }
       handleCodecOverloadError("onData codec creation overload");
       return Network::FilterStatus::StopIteration;
     }
@@ -805,6 +813,10 @@ ConnectionManagerImpl::ActiveStream::ActiveStream(ConnectionManagerImpl& connect
     filter_manager_.addAccessLogHandler(access_log);
   }
 
+  if (Runtime::runtimeFeatureEnabled("envoy.reloadable_features.per_stream_header_map_arena")) {
+    header_map_arena_ = std::make_shared<HeaderMapArena>();
+  }
+
   filter_manager_.streamInfo().setStreamIdProvider(
       std::make_shared<HttpStreamIdProviderImpl>(*this));
 
@@ -1191,7 +1203,7 @@ void ConnectionManagerImpl::ActiveStream::decodeHeaders(RequestHeaderMapSharedPt
   // Drop new requests when overloaded as soon as we have decoded the headers.
   const bool drop_request_due_to_overload =
       (connection_manager_.accept_new_http_stream_ != nullptr &&
-       connection_manager_.accept_new_http_stream_->shouldShedLoad()) ||
+       connection_manager_.accept_new_http_stream_->shouldShedRequest(*request_headers_)) ||
       connection_manager_.random_generator_.bernoulli(
           connection_manager_.overload_stop_accepting_requests_ref_.value());
 
@@ -2059,6 +2071,16 @@ void ConnectionManagerImpl::ActiveStream::setRoute(Router::RouteConstSharedPtr r
     cached_cluster_info_ = (nullptr == cluster) ? nullptr : cluster->info();
   }
 
+  // Account the memory of the stream to the tenant of its route.
+  if (Buffer::BufferMemoryAccountSharedPtr account = filter_manager_.account();
+      account != nullptr) {
+    account->setRoute(route != nullptr && route->routeEntry() != nullptr
+                          ? absl::string_view(route->routeEntry()->virtualHost().name())
+                          : absl::string_view(),
+                      route != nullptr ? absl::string_view(route->routeName())
+                                       : absl::string_view());
+  }
+
   // Update route and cluster info in the filter manager's stream info.
   filter_manager_.streamInfo().route_ = std::move(route); // Now can move route here safely.
   filter_manager_.streamInfo().setUpstreamClusterInfo(cached_cluster_info_.value());
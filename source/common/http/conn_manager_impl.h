@@ -39,6 +39,7 @@
 #include "source/common/buffer/watermark_buffer.h"
 #include "source/common/common/dump_state_utils.h"
 #include "source/common/common/linked_object.h"
+#include "source/common/common/thread_local_free_list.h"
 #include "source/common/grpc/common.h"
 #include "source/common/http/conn_manager_config.h"
 #include "source/common/http/filter_manager.h"
@@ -151,6 +152,11 @@ private:
     ActiveStream(ConnectionManagerImpl& connection_manager, uint32_t buffer_limit,
                  Buffer::BufferMemoryAccountSharedPtr account);
 
+    // The memory of the streams is recycled by the worker.
+    using FreeList = ThreadLocalFreeList<ActiveStream, 256>;
+    static void* operator new(size_t size) { return FreeList::allocate(size); }
+    static void operator delete(void* stream, size_t size) { FreeList::release(stream, size); }
+
     // Event::DeferredDeletable
     void deleteIsPending() override {
       // The stream should not be accessed once deferred delete has been called.
@@ -192,6 +198,7 @@ private:
     std::list<AccessLog::InstanceSharedPtr> accessLogHandlers() override {
       return filter_manager_.accessLogHandlers();
     }
+    HeaderMapArenaSharedPtr headerMapArena() override { return header_map_arena_; }
     // Hand off headers/trailers and stream info to the codec's response encoder, for logging later
     // (i.e. possibly after this stream has been destroyed).
     //
@@ -425,6 +432,10 @@ private:
     // both locations, then refer to the FM when doing stream logs.
     const uint64_t stream_id_;
 
+    // Arena backing the request headers and trailers decoded by the codec for this stream, if
+    // enabled. The header maps share its ownership, so its memory is released in bulk once the
+    // last of them is gone, which may be after the stream is destroyed.
+    HeaderMapArenaSharedPtr header_map_arena_;
     RequestHeaderMapSharedPtr request_headers_;
     RequestTrailerMapPtr request_trailers_;
 
@@ -8,6 +8,7 @@
 
 #include "source/common/common/empty_string.h"
 #include "source/common/common/enum_to_int.h"
+#include "source/common/common/macros.h"
 #include "source/common/common/utility.h"
 #include "source/common/http/conn_manager_config.h"
 #include "source/common/http/header_utility.h"
@@ -35,6 +36,28 @@ absl::string_view getScheme(absl::string_view forwarded_proto, bool is_ssl) {
   return is_ssl ? Headers::get().SchemeValues.Https : Headers::get().SchemeValues.Http;
 }
 
+// The HTTP/1 responses of the connections rejected before their codec is created.
+struct OverloadedHttp1Responses {
+  OverloadedHttp1Responses()
+      : response_(absl::StrCat(StatusLine, FixedHeaders, "\r\n\r\n", Body)),
+        with_overloaded_header_(absl::StrCat(StatusLine, FixedHeaders, "\r\n",
+                                             Headers::get().EnvoyLocalOverloaded.get(), ": ",
+                                             Headers::get().EnvoyOverloadedValues.True,
+                                             "\r\n\r\n", Body)) {}
+
+  static const OverloadedHttp1Responses& get() {
+    CONSTRUCT_ON_FIRST_USE(OverloadedHttp1Responses);
+  }
+
+  static constexpr absl::string_view StatusLine = "HTTP/1.1 503 Service Unavailable\r\n";
+  static constexpr absl::string_view FixedHeaders =
+      "content-length: 16\r\ncontent-type: text/plain\r\nconnection: close";
+  static constexpr absl::string_view Body = "envoy overloaded";
+
+  const std::string response_;
+  const std::string with_overloaded_header_;
+};
+
 } // namespace
 std::string ConnectionManagerUtility::determineNextProtocol(Network::Connection& connection,
                                                             const Buffer::Instance& data) {
@@ -53,6 +76,24 @@ std::string ConnectionManagerUtility::determineNextProtocol(Network::Connection&
   return "";
 }
 
+absl::string_view
+ConnectionManagerUtility::overloadedConnectionResponse(Network::Connection& connection,
+                                                       const Buffer::Instance& data,
+                                                       bool append_local_overload) {
+  if (determineNextProtocol(connection, data) == Utility::AlpnNames::get().Http2) {
+    // The empty SETTINGS frame starting the connection of the server, and a GOAWAY frame without
+    // error whose last stream id is 0, so that the client can retry all its streams.
+    static constexpr absl::string_view Http2Response{"\x00\x00\x00\x04\x00\x00\x00\x00\x00"
+                                                     "\x00\x00\x08\x07\x00\x00\x00\x00\x00"
+                                                     "\x00\x00\x00\x00\x00\x00\x00\x00",
+                                                     26};
+    return Http2Response;
+  }
+
+  const OverloadedHttp1Responses& responses = OverloadedHttp1Responses::get();
+  return append_local_overload ? responses.with_overloaded_header_ : responses.response_;
+}
+
 ServerConnectionPtr ConnectionManagerUtility::autoCreateCodec(
     Network::Connection& connection, const Buffer::Instance& data,
     ServerConnectionCallbacks& callbacks, Stats::Scope& scope, Random::RandomGenerator& random,
@@ -27,6 +27,20 @@ public:
   static std::string determineNextProtocol(Network::Connection& connection,
                                            const Buffer::Instance& data);
 
+  /**
+   * Get the canned response rejecting a connection which is closed before its codec is created,
+   * from the beginning of its data: a GOAWAY frame refusing all the streams of the HTTP/2
+   * connections, and a 503 response for the others. The responses are built once, so that
+   * rejecting the connections is cheaper than processing them.
+   * @param connection supplies the connection to reject.
+   * @param data supplies the currently available read data on the connection.
+   * @param append_local_overload supplies whether to add the x-envoy-overloaded header to the
+   *        HTTP/1 response.
+   */
+  static absl::string_view overloadedConnectionResponse(Network::Connection& connection,
+                                                        const Buffer::Instance& data,
+                                                        bool append_local_overload);
+
   /**
    * Create an HTTP codec given the connection and the beginning of the incoming data.
    * @param connection supplies the connection.
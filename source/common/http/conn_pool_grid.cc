@@ -122,7 +122,7 @@ ConnectivityGrid::WrapperCallbacks::newStream(ConnectionPool::Instance& pool) {
   auto attempt = std::make_unique<ConnectionAttemptCallbacks>(*this, pool);
   LinkedList::moveIntoList(std::move(attempt), connection_attempts_);
   if (!next_attempt_timer_->enabled()) {
-    next_attempt_timer_->enableTimer(grid_.next_attempt_duration_);
+    next_attempt_timer_->enableTimer(grid_.nextAttemptDuration());
   }
   // Note that in the case of immediate attempt/failure, newStream will delete this.
   return connection_attempts_.front()->newStream();
@@ -134,9 +134,22 @@ void ConnectivityGrid::WrapperCallbacks::onConnectionAttemptReady(
     absl::optional<Http::Protocol> protocol) {
   ENVOY_LOG(trace, "{} pool successfully connected to host '{}'.", describePool(attempt->pool()),
             host->hostname());
+  // Whether the other attempt was still pending when this one connected.
+  const bool won_race = inner_callbacks_ != nullptr && connection_attempts_.size() > 1;
   if (!grid_.isPoolHttp3(attempt->pool())) {
     tcp_attempt_succeeded_ = true;
     maybeMarkHttp3Broken();
+    if (won_race) {
+      grid_.host_->cluster().trafficStats()->upstream_grid_tcp_won_.inc();
+      tcp_won_time_ = grid_.time_source_.monotonicTime();
+    }
+  } else if (won_race) {
+    grid_.host_->cluster().trafficStats()->upstream_grid_http3_won_.inc();
+  } else if (tcp_won_time_.has_value()) {
+    grid_.host_->cluster().trafficStats()->upstream_grid_http3_lag_ms_.recordValue(
+        std::chrono::duration_cast<std::chrono::milliseconds>(grid_.time_source_.monotonicTime() -
+                                                              *tcp_won_time_)
+            .count());
   }
 
   grid_.dispatcher_.deferredDelete(attempt->removeFromList(connection_attempts_));
@@ -221,10 +234,8 @@ ConnectivityGrid::ConnectivityGrid(
     ConnectivityOptions connectivity_options, Quic::QuicStatNames& quic_stat_names,
     Stats::Scope& scope, Http::PersistentQuicInfo& quic_info)
     : dispatcher_(dispatcher), random_generator_(random_generator), host_(host), options_(options),
-      transport_socket_options_(transport_socket_options), state_(state),
-      next_attempt_duration_(std::chrono::milliseconds(kDefaultTimeoutMs)),
-      time_source_(time_source), alternate_protocols_(alternate_protocols),
-      quic_stat_names_(quic_stat_names), scope_(scope),
+      transport_socket_options_(transport_socket_options), state_(state), time_source_(time_source),
+      alternate_protocols_(alternate_protocols), quic_stat_names_(quic_stat_names), scope_(scope),
       // TODO(RyanTheOptimist): Figure out how scheme gets plumbed in here.
       origin_("https", getSni(transport_socket_options, host_->transportSocketFactory()),
               host_->address()->ip()->port()),
@@ -233,11 +244,6 @@ ConnectivityGrid::ConnectivityGrid(
   // HTTP/3.
   ASSERT(connectivity_options.protocols_.size() == 3);
   ASSERT(alternate_protocols);
-  std::chrono::milliseconds rtt =
-      std::chrono::duration_cast<std::chrono::milliseconds>(alternate_protocols_->getSrtt(origin_));
-  if (rtt.count() != 0) {
-    next_attempt_duration_ = std::chrono::milliseconds(rtt.count() * 2);
-  }
 }
 
 ConnectivityGrid::~ConnectivityGrid() {
@@ -376,6 +382,17 @@ bool ConnectivityGrid::isPoolHttp3(const ConnectionPool::Instance& pool) {
   return &pool == http3_pool_.get();
 }
 
+std::chrono::milliseconds ConnectivityGrid::nextAttemptDuration() const {
+  // The round trip time is read for each stream, so that the delay follows the measurements made
+  // since the grid was created.
+  const std::chrono::milliseconds rtt =
+      std::chrono::duration_cast<std::chrono::milliseconds>(alternate_protocols_->getSrtt(origin_));
+  if (rtt.count() != 0) {
+    return rtt * 2;
+  }
+  return std::chrono::milliseconds(kDefaultTimeoutMs);
+}
+
 HttpServerPropertiesCache::Http3StatusTracker& ConnectivityGrid::getHttp3StatusTracker() const {
   ENVOY_BUG(host_->address()->type() == Network::Address::Type::Ip, "Address is not an IP address");
   return alternate_protocols_->getOrCreateHttp3StatusTracker(origin_);
@@ -141,6 +141,8 @@ public:
     ConnectionPool::Callbacks* inner_callbacks_;
     // The timer which tracks when new connections should be attempted.
     Event::TimerPtr next_attempt_timer_;
+    // The time at which the TCP attempt won against a pending HTTP/3 attempt, if it did.
+    absl::optional<MonotonicTime> tcp_won_time_;
     // Checks if http2 has been attempted.
     bool has_attempted_http2_ = false;
     // True if the HTTP/3 attempt failed.
@@ -180,6 +182,11 @@ public:
   // Returns true if pool is the grid's HTTP/3 connection pool.
   bool isPoolHttp3(const ConnectionPool::Instance& pool);
 
+  // Returns how long HTTP/3 is given to connect before TCP is attempted as well: twice the last
+  // smoothed round trip time of the origin, as measured by the QUIC connections, or 300ms until it
+  // is known.
+  std::chrono::milliseconds nextAttemptDuration() const;
+
   // Returns true if HTTP/3 is currently broken. While HTTP/3 is broken the grid will not
   // attempt to make new HTTP/3 connections.
   bool isHttp3Broken() const;
@@ -229,7 +236,6 @@ private:
   const Network::ConnectionSocket::OptionsSharedPtr options_;
   const Network::TransportSocketOptionsConstSharedPtr transport_socket_options_;
   Upstream::ClusterConnectivityState& state_;
-  std::chrono::milliseconds next_attempt_duration_;
   TimeSource& time_source_;
   HttpServerPropertiesCacheSharedPtr alternate_protocols_;
 
@@ -11,12 +11,14 @@
 #include "source/common/http/utility.h"
 #include "source/common/protobuf/utility.h"
 
+#include "absl/strings/str_cat.h"
+
 namespace Envoy {
 namespace Http {
 
 void FilterChainUtility::createFilterChainForFactories(
     Http::FilterChainManager& manager, const FilterChainOptions& options,
-    const FilterFactoriesList& filter_factories) {
+    const FilterFactoriesList& filter_factories, bool sample_latency) {
   bool added_missing_config_filter = false;
   for (const auto& filter_config_provider : filter_factories) {
     // If this filter is disabled explicitly, skip trying to create it.
@@ -28,8 +30,10 @@ void FilterChainUtility::createFilterChainForFactories(
     auto config = filter_config_provider.provider->config();
     if (config.has_value()) {
       Filter::NamedHttpFilterFactoryCb& factory_cb = config.value().get();
-      manager.applyFilterFactoryCb({filter_config_provider.provider->name(), factory_cb.name},
-                                   factory_cb.factory_cb);
+      manager.applyFilterFactoryCb(
+          {filter_config_provider.provider->name(), factory_cb.name,
+           sample_latency ? filter_config_provider.latency_stats.get() : nullptr},
+          factory_cb.factory_cb);
       continue;
     }
 
@@ -46,6 +50,16 @@ void FilterChainUtility::createFilterChainForFactories(
   }
 }
 
+void FilterChainUtility::createLatencyStats(FilterFactoriesList& filter_factories,
+                                            Stats::Scope& scope, const std::string& prefix) {
+  for (auto& filter_config_provider : filter_factories) {
+    const std::string filter_prefix =
+        absl::StrCat(prefix, "filter.", filter_config_provider.provider->name(), ".");
+    filter_config_provider.latency_stats = std::make_unique<const FilterLatencyStats>(
+        FilterLatencyStats{ALL_FILTER_LATENCY_STATS(POOL_HISTOGRAM_PREFIX(scope, filter_prefix))});
+  }
+}
+
 SINGLETON_MANAGER_REGISTRATION(downstream_filter_config_provider_manager);
 SINGLETON_MANAGER_REGISTRATION(upstream_filter_config_provider_manager);
 
@@ -5,6 +5,7 @@
 #include "envoy/extensions/filters/network/http_connection_manager/v3/http_connection_manager.pb.h"
 #include "envoy/filter/config_provider_manager.h"
 #include "envoy/http/filter.h"
+#include "envoy/stats/scope.h"
 
 #include "source/common/common/empty_string.h"
 #include "source/common/common/logger.h"
@@ -46,15 +47,29 @@ public:
     // If true, this filter is disabled by default and must be explicitly enabled by
     // route configuration.
     bool disabled{};
+    // The latency stats of the filter, if filter latency sampling is enabled.
+    std::unique_ptr<const FilterLatencyStats> latency_stats;
   };
 
   using FilterFactoriesList = std::list<FilterFactoryProvider>;
   using FiltersList = Protobuf::RepeatedPtrField<
       envoy::extensions::filters::network::http_connection_manager::v3::HttpFilter>;
 
+  /**
+   * Creates the filters of a stream.
+   * @param sample_latency whether the time spent in the callbacks of the filters of the stream
+   *        is recorded into their latency stats, for the filters which have them.
+   */
   static void createFilterChainForFactories(Http::FilterChainManager& manager,
                                             const FilterChainOptions& options,
-                                            const FilterFactoriesList& filter_factories);
+                                            const FilterFactoriesList& filter_factories,
+                                            bool sample_latency = false);
+
+  /**
+   * Creates the latency stats of the filters, rooted at <prefix>filter.<config_name>.
+   */
+  static void createLatencyStats(FilterFactoriesList& filter_factories, Stats::Scope& scope,
+                                 const std::string& prefix);
 
   static std::shared_ptr<DownstreamFilterConfigProviderManager>
   createSingletonDownstreamFilterConfigProviderManager(
@@ -275,6 +275,11 @@ void ActiveStreamFilterBase::resetIdleTimer() {
   parent_.filter_manager_callbacks_.resetIdleTimer();
 }
 
+void ActiveStreamFilterBase::disableDataCallbacks() {
+  data_callbacks_disabled_ = Runtime::runtimeFeatureEnabled(
+      "envoy.reloadable_features.skip_data_of_filters_without_interest");
+}
+
 const Router::RouteSpecificFilterConfig*
 ActiveStreamFilterBase::mostSpecificPerFilterConfig() const {
   auto current_route = getRoute();
@@ -580,7 +585,11 @@ void FilterManager::decodeHeaders(ActiveStreamDecoderFilter* filter, RequestHead
     if ((*entry)->end_stream_) {
       state_.filter_call_state_ |= FilterCallState::EndOfStream;
     }
+    const MonotonicTime start = filterLatencyStart(**entry);
     FilterHeadersStatus status = (*entry)->decodeHeaders(headers, (*entry)->end_stream_);
+    if (const auto* latency_stats = (*entry)->filter_context_.latency_stats; latency_stats) {
+      recordFilterLatency(latency_stats->decode_headers_us_, start);
+    }
     state_.filter_call_state_ &= ~FilterCallState::DecodeHeaders;
     if ((*entry)->end_stream_) {
       state_.filter_call_state_ &= ~FilterCallState::EndOfStream;
@@ -712,6 +721,15 @@ void FilterManager::decodeData(ActiveStreamDecoderFilter* filter, Buffer::Instan
     }
     ASSERT(!(state_.filter_call_state_ & FilterCallState::DecodeData));
 
+    if ((*entry)->skipsData()) {
+      recordLatestDataFilter(entry, state_.latest_data_decoding_filter_, decoder_filters_);
+      (*entry)->end_stream_ = end_stream && !filter_manager_callbacks_.requestTrailers();
+      if ((*entry)->end_stream_) {
+        (*entry)->handle_->decodeComplete();
+      }
+      continue;
+    }
+
     // We check the request_trailers_ pointer here in case addDecodedTrailers
     // is called in decodeData during a previous filter invocation, at which point we communicate to
     // the current and future filters that the stream has not yet ended.
@@ -723,7 +741,11 @@ void FilterManager::decodeData(ActiveStreamDecoderFilter* filter, Buffer::Instan
 
     state_.filter_call_state_ |= FilterCallState::DecodeData;
     (*entry)->end_stream_ = end_stream && !filter_manager_callbacks_.requestTrailers();
+    const MonotonicTime start = filterLatencyStart(**entry);
     FilterDataStatus status = (*entry)->handle_->decodeData(data, (*entry)->end_stream_);
+    if (const auto* latency_stats = (*entry)->filter_context_.latency_stats; latency_stats) {
+      recordFilterLatency(latency_stats->decode_data_us_, start);
+    }
     if ((*entry)->end_stream_) {
       (*entry)->handle_->decodeComplete();
     }
@@ -1223,7 +1245,11 @@ void FilterManager::encodeHeaders(ActiveStreamEncoderFilter* filter, ResponseHea
     if ((*entry)->end_stream_) {
       state_.filter_call_state_ |= FilterCallState::EndOfStream;
     }
+    const MonotonicTime start = filterLatencyStart(**entry);
     FilterHeadersStatus status = (*entry)->handle_->encodeHeaders(headers, (*entry)->end_stream_);
+    if (const auto* latency_stats = (*entry)->filter_context_.latency_stats; latency_stats) {
+      recordFilterLatency(latency_stats->encode_headers_us_, start);
+    }
     if (state_.encoder_filter_chain_aborted_) {
       ENVOY_STREAM_LOG(trace,
                        "encodeHeaders filter iteration aborted due to local reply: filter={}",
@@ -1400,6 +1426,15 @@ void FilterManager::encodeData(ActiveStreamEncoderFilter* filter, Buffer::Instan
     }
     ASSERT(!(state_.filter_call_state_ & FilterCallState::EncodeData));
 
+    if ((*entry)->skipsData()) {
+      recordLatestDataFilter(entry, state_.latest_data_encoding_filter_, encoder_filters_);
+      (*entry)->end_stream_ = end_stream && !filter_manager_callbacks_.responseTrailers();
+      if ((*entry)->end_stream_) {
+        (*entry)->handle_->encodeComplete();
+      }
+      continue;
+    }
+
     // We check the response_trailers_ pointer here in case addEncodedTrailers
     // is called in encodeData during a previous filter invocation, at which point we communicate to
     // the current and future filters that the stream has not yet ended.
@@ -1411,7 +1446,11 @@ void FilterManager::encodeData(ActiveStreamEncoderFilter* filter, Buffer::Instan
     recordLatestDataFilter(entry, state_.latest_data_encoding_filter_, encoder_filters_);
 
     (*entry)->end_stream_ = end_stream && !filter_manager_callbacks_.responseTrailers();
+    const MonotonicTime start = filterLatencyStart(**entry);
     FilterDataStatus status = (*entry)->handle_->encodeData(data, (*entry)->end_stream_);
+    if (const auto* latency_stats = (*entry)->filter_context_.latency_stats; latency_stats) {
+      recordFilterLatency(latency_stats->encode_data_us_, start);
+    }
     if (state_.encoder_filter_chain_aborted_) {
       ENVOY_STREAM_LOG(trace, "encodeData filter iteration aborted due to local reply: filter={}",
                        *this, (*entry)->filter_context_.config_name);
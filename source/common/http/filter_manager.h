@@ -17,6 +17,7 @@
 #include "source/common/common/dump_state_utils.h"
 #include "source/common/common/linked_object.h"
 #include "source/common/common/logger.h"
+#include "source/common/common/thread_local_free_list.h"
 #include "source/common/grpc/common.h"
 #include "source/common/http/header_utility.h"
 #include "source/common/http/headers.h"
@@ -69,7 +70,8 @@ struct ActiveStreamFilterBase : public virtual StreamFilterCallbacks,
       : parent_(parent), iteration_state_(IterationState::Continue),
         filter_context_(std::move(filter_context)), iterate_from_current_filter_(false),
         headers_continued_(false), continued_1xx_headers_(false), end_stream_(false),
-        is_encoder_decoder_filter_(is_encoder_decoder_filter), processed_headers_(false) {}
+        is_encoder_decoder_filter_(is_encoder_decoder_filter), processed_headers_(false),
+        data_callbacks_disabled_(false) {}
 
   // Functions in the following block are called after the filter finishes processing
   // corresponding data. Those functions handle state updates and data storage (if needed)
@@ -118,6 +120,7 @@ struct ActiveStreamFilterBase : public virtual StreamFilterCallbacks,
   const ScopeTrackedObject& scope() override;
   void restoreContextOnContinue(ScopeTrackedObjectStack& tracked_object_stack) override;
   void resetIdleTimer() override;
+  void disableDataCallbacks() override;
   const Router::RouteSpecificFilterConfig* mostSpecificPerFilterConfig() const override;
   void traversePerFilterConfig(
       std::function<void(const Router::RouteSpecificFilterConfig&)> cb) const override;
@@ -137,6 +140,8 @@ struct ActiveStreamFilterBase : public virtual StreamFilterCallbacks,
     return iteration_state_ == IterationState::StopAllBuffer ||
            iteration_state_ == IterationState::StopAllWatermark;
   }
+  // The data skips the filter if it has asked to, once it has continued the headers.
+  bool skipsData() { return data_callbacks_disabled_ && processed_headers_ && canIterate(); }
   void allowIteration() {
     ASSERT(iteration_state_ != IterationState::Continue);
     iteration_state_ = IterationState::Continue;
@@ -193,6 +198,8 @@ struct ActiveStreamFilterBase : public virtual StreamFilterCallbacks,
   const bool is_encoder_decoder_filter_ : 1;
   // If true, the filter has processed headers.
   bool processed_headers_ : 1;
+  // If true, the filter doesn't need to see the body data.
+  bool data_callbacks_disabled_ : 1;
 };
 
 /**
@@ -208,6 +215,12 @@ struct ActiveStreamDecoderFilter : public ActiveStreamFilterBase,
     handle_->setDecoderFilterCallbacks(*this);
   }
 
+  // The memory of the filter wrappers, of which there is one per filter and stream, is recycled
+  // by the worker.
+  using FreeList = ThreadLocalFreeList<ActiveStreamDecoderFilter, 1024>;
+  static void* operator new(size_t size) { return FreeList::allocate(size); }
+  static void operator delete(void* filter, size_t size) { FreeList::release(filter, size); }
+
   // ActiveStreamFilterBase
   bool canContinue() override;
   Buffer::InstancePtr createBuffer() override;
@@ -300,6 +313,11 @@ struct ActiveStreamEncoderFilter : public ActiveStreamFilterBase,
     handle_->setEncoderFilterCallbacks(*this);
   }
 
+  // See ActiveStreamDecoderFilter.
+  using FreeList = ThreadLocalFreeList<ActiveStreamEncoderFilter, 1024>;
+  static void* operator new(size_t size) { return FreeList::allocate(size); }
+  static void operator delete(void* filter, size_t size) { FreeList::release(filter, size); }
+
   // ActiveStreamFilterBase
   bool canContinue() override;
   Buffer::InstancePtr createBuffer() override;
@@ -971,6 +989,19 @@ private:
   std::list<ActiveStreamDecoderFilterPtr>::iterator
   commonDecodePrefix(ActiveStreamDecoderFilter* filter,
                      FilterIterationStartState filter_iteration_start_state);
+  // Returns the start time of a callback of the filter, if the stream is sampled for filter
+  // latency.
+  MonotonicTime filterLatencyStart(const ActiveStreamFilterBase& filter) {
+    return filter.filter_context_.latency_stats != nullptr
+               ? dispatcher_.timeSource().monotonicTime()
+               : MonotonicTime();
+  }
+  // Records the time spent in a callback of a filter since start.
+  void recordFilterLatency(Stats::Histogram& histogram, MonotonicTime start) {
+    histogram.recordValue(std::chrono::duration_cast<std::chrono::microseconds>(
+                              dispatcher_.timeSource().monotonicTime() - start)
+                              .count());
+  }
   void addDecodedData(ActiveStreamDecoderFilter& filter, Buffer::Instance& data, bool streaming);
   RequestTrailerMap& addDecodedTrailers();
   MetadataMapVector& addDecodedMetadata();
@@ -1151,8 +1182,14 @@ public:
   }
 
   bool shouldLoadShed() override {
-    return downstream_filter_load_shed_point_ != nullptr &&
-           downstream_filter_load_shed_point_->shouldShedLoad();
+    if (downstream_filter_load_shed_point_ == nullptr) {
+      return false;
+    }
+    // The filters may have set the headers telling the priority of the request.
+    const RequestHeaderMapOptRef request_headers = filter_manager_callbacks_.requestHeaders();
+    return request_headers.has_value()
+               ? downstream_filter_load_shed_point_->shouldShedRequest(*request_headers)
+               : downstream_filter_load_shed_point_->shouldShedLoad();
   }
 
 private:
@@ -7,6 +7,7 @@
 
 #include "source/common/common/matchers.h"
 #include "source/common/common/regex.h"
+#include "source/common/http/header_accessor.h"
 #include "source/common/http/utility.h"
 #include "source/common/runtime/runtime_features.h"
 
@@ -29,7 +30,7 @@ class HeaderHashMethod : public HashMethodImplBase {
 public:
   HeaderHashMethod(const envoy::config::route::v3::RouteAction::HashPolicy::Header& header,
                    bool terminal, Regex::Engine& regex_engine)
-      : HashMethodImplBase(terminal), header_name_(header.header_name()) {
+      : HashMethodImplBase(terminal), header_(LowerCaseString(header.header_name())) {
     if (header.has_regex_rewrite()) {
       const auto& rewrite_spec = header.regex_rewrite();
       regex_rewrite_ = Regex::Utility::parseRegex(rewrite_spec.pattern(), regex_engine);
@@ -43,7 +44,7 @@ public:
                                     const StreamInfo::FilterStateSharedPtr) const override {
     absl::optional<uint64_t> hash;
 
-    const auto header = headers.get(header_name_);
+    const auto header = header_.get(headers);
     if (!header.empty()) {
       absl::InlinedVector<absl::string_view, 1> header_values;
       size_t num_headers_to_hash = header.size();
@@ -72,7 +73,7 @@ public:
   }
 
 private:
-  const LowerCaseString header_name_;
+  const HeaderAccessor header_;
   Regex::CompiledMatcherPtr regex_rewrite_{};
   std::string regex_rewrite_substitution_{};
 };
@@ -150,8 +151,8 @@ public:
 
     const HeaderEntry* header = headers.Path();
     if (header) {
-      Http::Utility::QueryParamsMulti query_parameters =
-          Http::Utility::QueryParamsMulti::parseQueryString(header->value().getStringView());
+      const Http::Utility::QueryParamsMulti& query_parameters =
+          Http::Utility::QueryParamsMulti::parseQueryStringCached(header->value().getStringView());
       const auto val = query_parameters.getFirstValue(parameter_name_);
       if (val.has_value()) {
         hash = HashUtil::xxHash64(val.value());
@@ -180,7 +181,7 @@ public:
   }
 
 private:
-  const std::string key_;
+  const StreamInfo::FilterState::Key key_;
 };
 
 HashPolicyImpl::HashPolicyImpl(
@@ -0,0 +1,42 @@
+#include "source/common/http/header_accessor.h"
+
+#include "source/common/common/assert.h"
+#include "source/common/http/header_map_impl.h"
+
+namespace Envoy {
+namespace Http {
+
+HeaderAccessor::HeaderAccessor(const LowerCaseString& name) : name_(name) {
+  // This will force the header maps to be finalized in unit tests and do nothing in prod (where the
+  // header maps are already finalized when the server is initializing).
+  RequestHeaderMapImpl::inlineHeadersSize();
+  RequestTrailerMapImpl::inlineHeadersSize();
+  ResponseHeaderMapImpl::inlineHeadersSize();
+  ResponseTrailerMapImpl::inlineHeadersSize();
+
+  request_headers_handle_ =
+      CustomInlineHeaderRegistry::getInlineHeader<RequestHeaderMap::header_map_type>(name_);
+  request_trailers_handle_ =
+      CustomInlineHeaderRegistry::getInlineHeader<RequestTrailerMap::header_map_type>(name_);
+  response_headers_handle_ =
+      CustomInlineHeaderRegistry::getInlineHeader<ResponseHeaderMap::header_map_type>(name_);
+  response_trailers_handle_ =
+      CustomInlineHeaderRegistry::getInlineHeader<ResponseTrailerMap::header_map_type>(name_);
+}
+
+bool HeaderAccessor::isInline(CustomInlineHeaderRegistry::Type type) const {
+  switch (type) {
+  case CustomInlineHeaderRegistry::Type::RequestHeaders:
+    return request_headers_handle_.has_value();
+  case CustomInlineHeaderRegistry::Type::RequestTrailers:
+    return request_trailers_handle_.has_value();
+  case CustomInlineHeaderRegistry::Type::ResponseHeaders:
+    return response_headers_handle_.has_value();
+  case CustomInlineHeaderRegistry::Type::ResponseTrailers:
+    return response_trailers_handle_.has_value();
+  }
+  PANIC_DUE_TO_CORRUPT_ENUM;
+}
+
+} // namespace Http
+} // namespace Envoy
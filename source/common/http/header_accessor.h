@@ -0,0 +1,100 @@
+#pragma once
+
+#include "envoy/http/header_map.h"
+
+#include "absl/types/optional.h"
+
+namespace Envoy {
+namespace Http {
+
+/**
+ * Accessor for a header that is known at configuration time. If the header is registered as a
+ * custom inline header for a header map type, e.g. through the inline_headers field of the
+ * bootstrap, its inline handle is resolved once at construction and accesses to header maps of
+ * that type are O(1). Otherwise accesses fall back to the lookup by name of the header map.
+ */
+class HeaderAccessor {
+public:
+  /**
+   * @param name supplies the name of the header to access.
+   */
+  explicit HeaderAccessor(const LowerCaseString& name);
+
+  /**
+   * @return the name of the header.
+   */
+  const LowerCaseString& name() const { return name_; }
+
+  /**
+   * Get the header from a header map.
+   * @param headers supplies the header map.
+   * @return all the header entries matching the name. Inline headers have at most one entry.
+   */
+  HeaderMap::GetResult get(const RequestHeaderMap& headers) const {
+    return getImpl(headers, request_headers_handle_);
+  }
+  HeaderMap::GetResult get(const RequestTrailerMap& headers) const {
+    return getImpl(headers, request_trailers_handle_);
+  }
+  HeaderMap::GetResult get(const ResponseHeaderMap& headers) const {
+    return getImpl(headers, response_headers_handle_);
+  }
+  HeaderMap::GetResult get(const ResponseTrailerMap& headers) const {
+    return getImpl(headers, response_trailers_handle_);
+  }
+  HeaderMap::GetResult get(const HeaderMap& headers) const { return headers.get(name_); }
+
+  /**
+   * Remove the header from a header map.
+   * @param headers supplies the header map.
+   * @return the number of headers removed.
+   */
+  size_t remove(RequestHeaderMap& headers) const {
+    return removeImpl(headers, request_headers_handle_);
+  }
+  size_t remove(RequestTrailerMap& headers) const {
+    return removeImpl(headers, request_trailers_handle_);
+  }
+  size_t remove(ResponseHeaderMap& headers) const {
+    return removeImpl(headers, response_headers_handle_);
+  }
+  size_t remove(ResponseTrailerMap& headers) const {
+    return removeImpl(headers, response_trailers_handle_);
+  }
+  size_t remove(HeaderMap& headers) const { return headers.remove(name_); }
+
+  /**
+   * @return whether the header is an inline header of the header map type, in which case accesses
+   *         to maps of that type are O(1). Exposed for tests.
+   */
+  bool isInline(CustomInlineHeaderRegistry::Type type) const;
+
+private:
+  template <class HeaderMapType>
+  HeaderMap::GetResult getImpl(const HeaderMapType& headers,
+                               const absl::optional<typename HeaderMapType::Handle>& handle) const {
+    if (!handle.has_value()) {
+      return headers.get(name_);
+    }
+    const HeaderEntry* entry = headers.getInline(handle.value());
+    if (entry == nullptr) {
+      return {};
+    }
+    return HeaderMap::GetResult(HeaderMap::NonConstGetResult{const_cast<HeaderEntry*>(entry)});
+  }
+
+  template <class HeaderMapType>
+  size_t removeImpl(HeaderMapType& headers,
+                    const absl::optional<typename HeaderMapType::Handle>& handle) const {
+    return handle.has_value() ? headers.removeInline(handle.value()) : headers.remove(name_);
+  }
+
+  const LowerCaseString name_;
+  absl::optional<RequestHeaderMap::Handle> request_headers_handle_;
+  absl::optional<RequestTrailerMap::Handle> request_trailers_handle_;
+  absl::optional<ResponseHeaderMap::Handle> response_headers_handle_;
+  absl::optional<ResponseTrailerMap::Handle> response_trailers_handle_;
+};
+
+} // namespace Http
+} // namespace Envoy
@@ -0,0 +1,56 @@
+#include "source/common/http/header_map_arena.h"
+
+#include <algorithm>
+
+namespace Envoy {
+namespace Http {
+
+void* HeaderMapArena::allocate(size_t size, size_t alignment) {
+  ASSERT(alignment <= alignof(std::max_align_t));
+  size = roundUp(size);
+
+  FreeNode** free_list = freeList(size);
+  if (*free_list != nullptr) {
+    FreeNode* node = *free_list;
+    *free_list = node->next_;
+    return node;
+  }
+
+  if (size > remaining_) {
+    // Allocations that do not fit in a block, which header maps never make in practice, get a
+    // block of their own so that the current block can still be used.
+    const size_t block_size = std::max(block_size_, size);
+    // NOLINTNEXTLINE(modernize-make-unique): the block does not need to be zero-initialized.
+    blocks_.push_back(std::unique_ptr<char[]>(new char[block_size]));
+    bytes_allocated_ += block_size;
+    if (block_size > block_size_) {
+      return blocks_.back().get();
+    }
+    next_ = blocks_.back().get();
+    remaining_ = block_size;
+  }
+  void* p = next_;
+  next_ += size;
+  remaining_ -= size;
+  return p;
+}
+
+void HeaderMapArena::deallocate(void* p, size_t size) {
+  FreeNode** free_list = freeList(roundUp(size));
+  FreeNode* node = static_cast<FreeNode*>(p);
+  node->next_ = *free_list;
+  *free_list = node;
+}
+
+HeaderMapArena::FreeNode** HeaderMapArena::freeList(size_t size) {
+  for (auto& [list_size, head] : free_lists_) {
+    if (list_size == size) {
+      return &head;
+    }
+  }
+  free_lists_.emplace_back(size, nullptr);
+  return &free_lists_.back().second;
+}
+
+} // namespace Http
+} // namespace Envoy
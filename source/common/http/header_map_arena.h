@@ -0,0 +1,119 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "source/common/common/assert.h"
+#include "source/common/common/non_copyable.h"
+
+#include "absl/container/inlined_vector.h"
+
+namespace Envoy {
+namespace Http {
+
+/**
+ * Arena that header maps allocate their entries from. It is meant to be shared by the header maps
+ * of a single stream: the entries are carved out of a few large blocks instead of being allocated
+ * one by one, and the blocks are released in bulk once the arena and every header map allocated
+ * from it are destroyed. Entries removed from a header map are recycled for later entries.
+ *
+ * The arena is not thread safe. All the header maps sharing an arena must be used, and destroyed,
+ * on a single thread, which is the case for the header maps of a stream.
+ */
+class HeaderMapArena : NonCopyable {
+public:
+  static constexpr size_t DefaultBlockSize = 4096;
+
+  explicit HeaderMapArena(size_t block_size = DefaultBlockSize) : block_size_(block_size) {}
+
+  /**
+   * Allocates memory from the arena.
+   * @param size supplies the number of bytes to allocate.
+   * @param alignment supplies the required alignment, which must be at most that of
+   *        std::max_align_t.
+   */
+  void* allocate(size_t size, size_t alignment);
+
+  /**
+   * Returns memory previously obtained from allocate() with the same size for reuse by later
+   * allocations. The memory itself is only released when the arena is destroyed.
+   */
+  void deallocate(void* p, size_t size);
+
+  /**
+   * @return the number of blocks allocated from the heap so far.
+   */
+  uint64_t blocksAllocated() const { return blocks_.size(); }
+
+  /**
+   * @return the number of bytes allocated from the heap so far.
+   */
+  uint64_t bytesAllocated() const { return bytes_allocated_; }
+
+private:
+  struct FreeNode {
+    FreeNode* next_;
+  };
+
+  static size_t roundUp(size_t size) {
+    constexpr size_t alignment = alignof(std::max_align_t);
+    return (size + alignment - 1) & ~(alignment - 1);
+  }
+  FreeNode** freeList(size_t size);
+
+  const size_t block_size_;
+  std::vector<std::unique_ptr<char[]>> blocks_;
+  char* next_{};
+  size_t remaining_{};
+  uint64_t bytes_allocated_{};
+  // Header maps only allocate list nodes of a single size, so there are very few free lists.
+  absl::InlinedVector<std::pair<size_t, FreeNode*>, 2> free_lists_;
+};
+
+using HeaderMapArenaSharedPtr = std::shared_ptr<HeaderMapArena>;
+
+/**
+ * Standard allocator that allocates from a HeaderMapArena, or from the heap when it has no arena.
+ * The allocator does not keep the arena alive, its user must.
+ */
+template <class T> class HeaderMapArenaAllocator {
+public:
+  using value_type = T;
+
+  explicit HeaderMapArenaAllocator(HeaderMapArena* arena = nullptr) : arena_(arena) {}
+  // NOLINTNEXTLINE(google-explicit-constructor)
+  template <class U> HeaderMapArenaAllocator(const HeaderMapArenaAllocator<U>& other)
+      : arena_(other.arena()) {}
+
+  T* allocate(size_t n) {
+    if (arena_ == nullptr) {
+      return std::allocator<T>().allocate(n);
+    }
+    return static_cast<T*>(arena_->allocate(n * sizeof(T), alignof(T)));
+  }
+  void deallocate(T* p, size_t n) {
+    if (arena_ == nullptr) {
+      std::allocator<T>().deallocate(p, n);
+      return;
+    }
+    arena_->deallocate(p, n * sizeof(T));
+  }
+
+  HeaderMapArena* arena() const { return arena_; }
+
+  template <class U> bool operator==(const HeaderMapArenaAllocator<U>& other) const {
+    return arena_ == other.arena();
+  }
+  template <class U> bool operator!=(const HeaderMapArenaAllocator<U>& other) const {
+    return arena_ != other.arena();
+  }
+
+private:
+  HeaderMapArena* arena_;
+};
+
+} // namespace Http
+} // namespace Envoy
@@ -174,13 +174,18 @@ void HeaderMapImpl::updateSize(uint64_t from_size, uint64_t to_size) {
   ASSERT(cached_byte_size_ >= from_size);
   cached_byte_size_ -= from_size;
   cached_byte_size_ += to_size;
+  Memory::Accounting::charge(Memory::Subsystem::HeaderMaps, to_size - from_size);
 }
 
-void HeaderMapImpl::addSize(uint64_t size) { cached_byte_size_ += size; }
+void HeaderMapImpl::addSize(uint64_t size) {
+  cached_byte_size_ += size;
+  Memory::Accounting::charge(Memory::Subsystem::HeaderMaps, size);
+}
 
 void HeaderMapImpl::subtractSize(uint64_t size) {
   ASSERT(cached_byte_size_ >= size);
   cached_byte_size_ -= size;
+  Memory::Accounting::credit(Memory::Subsystem::HeaderMaps, size);
 }
 
 void HeaderMapImpl::copyFrom(HeaderMap& lhs, const HeaderMap& header_map) {
@@ -405,6 +410,7 @@ void HeaderMapImpl::iterateReverse(HeaderMap::ConstIterateCb cb) const {
 void HeaderMapImpl::clear() {
   clearInline();
   headers_.clear();
+  Memory::Accounting::credit(Memory::Subsystem::HeaderMaps, cached_byte_size_);
   cached_byte_size_ = 0;
 }
 
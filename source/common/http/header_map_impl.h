@@ -14,7 +14,9 @@
 #include "source/common/common/compiled_string_map.h"
 #include "source/common/common/non_copyable.h"
 #include "source/common/common/utility.h"
+#include "source/common/http/header_map_arena.h"
 #include "source/common/http/headers.h"
+#include "source/common/memory/accounting.h"
 #include "source/common/runtime/runtime_features.h"
 
 namespace Envoy {
@@ -55,9 +57,14 @@ public:
 class HeaderMapImpl : NonCopyable {
 public:
   HeaderMapImpl(const uint32_t max_headers_kb = UINT32_MAX,
-                const uint32_t max_headers_count = UINT32_MAX)
-      : max_headers_kb_(max_headers_kb), max_headers_count_(max_headers_count) {}
-  virtual ~HeaderMapImpl() = default;
+                const uint32_t max_headers_count = UINT32_MAX,
+                HeaderMapArenaSharedPtr arena = nullptr)
+      : arena_(std::move(arena)), headers_(arena_.get()), max_headers_kb_(max_headers_kb),
+        max_headers_count_(max_headers_count) {}
+  // The bytes of the headers are charged to the header maps subsystem as they change.
+  virtual ~HeaderMapImpl() {
+    Memory::Accounting::credit(Memory::Subsystem::HeaderMaps, cached_byte_size_);
+  }
 
   // The following "constructors" call virtual functions during construction and must use the
   // static factory pattern.
@@ -97,6 +104,7 @@ public:
   void setCopy(const LowerCaseString& key, absl::string_view value);
   uint64_t byteSize() const;
   uint32_t maxHeadersKb() const { return max_headers_kb_; }
+  const HeaderMapArenaSharedPtr& arena() const { return arena_; }
   uint32_t maxHeadersCount() const { return max_headers_count_; }
   HeaderMap::GetResult get(const LowerCaseString& key) const;
   void iterate(HeaderMap::ConstIterateCb cb) const;
@@ -129,9 +137,10 @@ protected:
 
     HeaderString key_;
     HeaderString value_;
-    std::list<HeaderEntryImpl>::iterator entry_;
+    std::list<HeaderEntryImpl, HeaderMapArenaAllocator<HeaderEntryImpl>>::iterator entry_;
   };
-  using HeaderNode = std::list<HeaderEntryImpl>::iterator;
+  using HeaderEntryList = std::list<HeaderEntryImpl, HeaderMapArenaAllocator<HeaderEntryImpl>>;
+  using HeaderNode = HeaderEntryList::iterator;
 
   /**
    * This is the static lookup table that is used to determine whether a header is one of the O(1)
@@ -210,7 +219,9 @@ protected:
     using HeaderNodeVector = absl::InlinedVector<HeaderNode, 1>;
     using HeaderLazyMap = absl::flat_hash_map<absl::string_view, HeaderNodeVector>;
 
-    HeaderList() : pseudo_headers_end_(headers_.end()) {}
+    explicit HeaderList(HeaderMapArena* arena)
+        : headers_(HeaderMapArenaAllocator<HeaderEntryImpl>(arena)),
+          pseudo_headers_end_(headers_.end()) {}
 
     template <class Key> bool isPseudoHeader(const Key& key) {
       return !key.getStringView().empty() && key.getStringView()[0] == ':';
@@ -300,12 +311,12 @@ protected:
      */
     size_t remove(absl::string_view key);
 
-    std::list<HeaderEntryImpl>::iterator begin() { return headers_.begin(); }
-    std::list<HeaderEntryImpl>::iterator end() { return headers_.end(); }
-    std::list<HeaderEntryImpl>::const_iterator begin() const { return headers_.begin(); }
-    std::list<HeaderEntryImpl>::const_iterator end() const { return headers_.end(); }
-    std::list<HeaderEntryImpl>::const_reverse_iterator rbegin() const { return headers_.rbegin(); }
-    std::list<HeaderEntryImpl>::const_reverse_iterator rend() const { return headers_.rend(); }
+    HeaderEntryList::iterator begin() { return headers_.begin(); }
+    HeaderEntryList::iterator end() { return headers_.end(); }
+    HeaderEntryList::const_iterator begin() const { return headers_.begin(); }
+    HeaderEntryList::const_iterator end() const { return headers_.end(); }
+    HeaderEntryList::const_reverse_iterator rbegin() const { return headers_.rbegin(); }
+    HeaderEntryList::const_reverse_iterator rend() const { return headers_.rend(); }
     HeaderLazyMap::iterator mapFind(absl::string_view key) { return lazy_map_.find(key); }
     HeaderLazyMap::iterator mapEnd() { return lazy_map_.end(); }
     size_t size() const { return headers_.size(); }
@@ -317,7 +328,7 @@ protected:
     }
 
   private:
-    std::list<HeaderEntryImpl> headers_;
+    HeaderEntryList headers_;
     HeaderNode pseudo_headers_end_;
     HeaderLazyMap lazy_map_;
   };
@@ -340,6 +351,8 @@ protected:
   virtual void clearInline() PURE;
   virtual HeaderEntryImpl** inlineHeaders() PURE;
 
+  // Arena the header entries are allocated from, if any. It must outlive headers_.
+  const HeaderMapArenaSharedPtr arena_;
   HeaderList headers_;
   // TODO(mattklein123): The formatter does not currently get copied when a header map gets
   // copied. This may be problematic in certain cases like request shadowing. This is omitted
@@ -365,8 +378,9 @@ protected:
 template <class Interface> class TypedHeaderMapImpl : public HeaderMapImpl, public Interface {
 public:
   TypedHeaderMapImpl(const uint32_t max_headers_kb = UINT32_MAX,
-                     const uint32_t max_headers_count = UINT32_MAX)
-      : HeaderMapImpl(max_headers_kb, max_headers_count) {}
+                     const uint32_t max_headers_count = UINT32_MAX,
+                     HeaderMapArenaSharedPtr arena = nullptr)
+      : HeaderMapImpl(max_headers_kb, max_headers_count, std::move(arena)) {}
   void setFormatter(StatefulHeaderKeyFormatterPtr&& formatter) {
     formatter_ = std::move(formatter);
   }
@@ -492,9 +506,9 @@ class RequestHeaderMapImpl final : public TypedHeaderMapImpl<RequestHeaderMap>,
 public:
   static std::unique_ptr<RequestHeaderMapImpl>
   create(const uint32_t max_headers_kb = UINT32_MAX,
-         const uint32_t max_headers_count = UINT32_MAX) {
-    return std::unique_ptr<RequestHeaderMapImpl>(
-        new (inlineHeadersSize()) RequestHeaderMapImpl(max_headers_kb, max_headers_count));
+         const uint32_t max_headers_count = UINT32_MAX, HeaderMapArenaSharedPtr arena = nullptr) {
+    return std::unique_ptr<RequestHeaderMapImpl>(new (inlineHeadersSize()) RequestHeaderMapImpl(
+        max_headers_kb, max_headers_count, std::move(arena)));
   }
 
   INLINE_REQ_STRING_HEADERS(DEFINE_INLINE_HEADER_STRING_FUNCS)
@@ -521,9 +535,9 @@ private:
 
   using HeaderHandles = ConstSingleton<HeaderHandleValues>;
 
-  RequestHeaderMapImpl(const uint32_t max_headers_kb = UINT32_MAX,
-                       const uint32_t max_headers_count = UINT32_MAX)
-      : TypedHeaderMapImpl<RequestHeaderMap>(max_headers_kb, max_headers_count) {
+  RequestHeaderMapImpl(const uint32_t max_headers_kb, const uint32_t max_headers_count,
+                       HeaderMapArenaSharedPtr arena)
+      : TypedHeaderMapImpl<RequestHeaderMap>(max_headers_kb, max_headers_count, std::move(arena)) {
     clearInline();
   }
 
@@ -539,9 +553,9 @@ class RequestTrailerMapImpl final : public TypedHeaderMapImpl<RequestTrailerMap>
 public:
   static std::unique_ptr<RequestTrailerMapImpl>
   create(const uint32_t max_headers_kb = UINT32_MAX,
-         const uint32_t max_headers_count = UINT32_MAX) {
-    return std::unique_ptr<RequestTrailerMapImpl>(
-        new (inlineHeadersSize()) RequestTrailerMapImpl(max_headers_kb, max_headers_count));
+         const uint32_t max_headers_count = UINT32_MAX, HeaderMapArenaSharedPtr arena = nullptr) {
+    return std::unique_ptr<RequestTrailerMapImpl>(new (inlineHeadersSize()) RequestTrailerMapImpl(
+        max_headers_kb, max_headers_count, std::move(arena)));
   }
 
 protected:
@@ -551,9 +565,9 @@ protected:
   HeaderEntryImpl** inlineHeaders() override { return inline_headers_; }
 
 private:
-  RequestTrailerMapImpl(const uint32_t max_headers_kb = UINT32_MAX,
-                        const uint32_t max_headers_count = UINT32_MAX)
-      : TypedHeaderMapImpl<RequestTrailerMap>(max_headers_kb, max_headers_count) {
+  RequestTrailerMapImpl(const uint32_t max_headers_kb, const uint32_t max_headers_count,
+                        HeaderMapArenaSharedPtr arena)
+      : TypedHeaderMapImpl<RequestTrailerMap>(max_headers_kb, max_headers_count, std::move(arena)) {
     clearInline();
   }
 
@@ -569,9 +583,9 @@ class ResponseHeaderMapImpl final : public TypedHeaderMapImpl<ResponseHeaderMap>
 public:
   static std::unique_ptr<ResponseHeaderMapImpl>
   create(const uint32_t max_headers_kb = UINT32_MAX,
-         const uint32_t max_headers_count = UINT32_MAX) {
-    return std::unique_ptr<ResponseHeaderMapImpl>(
-        new (inlineHeadersSize()) ResponseHeaderMapImpl(max_headers_kb, max_headers_count));
+         const uint32_t max_headers_count = UINT32_MAX, HeaderMapArenaSharedPtr arena = nullptr) {
+    return std::unique_ptr<ResponseHeaderMapImpl>(new (inlineHeadersSize()) ResponseHeaderMapImpl(
+        max_headers_kb, max_headers_count, std::move(arena)));
   }
 
   INLINE_RESP_STRING_HEADERS(DEFINE_INLINE_HEADER_STRING_FUNCS)
@@ -599,9 +613,9 @@ private:
 
   using HeaderHandles = ConstSingleton<HeaderHandleValues>;
 
-  ResponseHeaderMapImpl(const uint32_t max_headers_kb = UINT32_MAX,
-                        const uint32_t max_headers_count = UINT32_MAX)
-      : TypedHeaderMapImpl<ResponseHeaderMap>(max_headers_kb, max_headers_count) {
+  ResponseHeaderMapImpl(const uint32_t max_headers_kb, const uint32_t max_headers_count,
+                        HeaderMapArenaSharedPtr arena)
+      : TypedHeaderMapImpl<ResponseHeaderMap>(max_headers_kb, max_headers_count, std::move(arena)) {
     clearInline();
   }
   HeaderEntryImpl* inline_headers_[];
@@ -616,9 +630,9 @@ class ResponseTrailerMapImpl final : public TypedHeaderMapImpl<ResponseTrailerMa
 public:
   static std::unique_ptr<ResponseTrailerMapImpl>
   create(const uint32_t max_headers_kb = UINT32_MAX,
-         const uint32_t max_headers_count = UINT32_MAX) {
-    return std::unique_ptr<ResponseTrailerMapImpl>(
-        new (inlineHeadersSize()) ResponseTrailerMapImpl(max_headers_kb, max_headers_count));
+         const uint32_t max_headers_count = UINT32_MAX, HeaderMapArenaSharedPtr arena = nullptr) {
+    return std::unique_ptr<ResponseTrailerMapImpl>(new (inlineHeadersSize()) ResponseTrailerMapImpl(
+        max_headers_kb, max_headers_count, std::move(arena)));
   }
 
   INLINE_RESP_STRING_HEADERS_TRAILERS(DEFINE_INLINE_HEADER_STRING_FUNCS)
@@ -638,9 +652,10 @@ private:
 
   using HeaderHandles = ConstSingleton<HeaderHandleValues>;
 
-  ResponseTrailerMapImpl(const uint32_t max_headers_kb = UINT32_MAX,
-                         const uint32_t max_headers_count = UINT32_MAX)
-      : TypedHeaderMapImpl<ResponseTrailerMap>(max_headers_kb, max_headers_count) {
+  ResponseTrailerMapImpl(const uint32_t max_headers_kb, const uint32_t max_headers_count,
+                         HeaderMapArenaSharedPtr arena)
+      : TypedHeaderMapImpl<ResponseTrailerMap>(max_headers_kb, max_headers_count,
+                                               std::move(arena)) {
     clearInline();
   }
 
@@ -21,7 +21,12 @@ public:
 
   void evaluateHeaders(Http::HeaderMap& headers, const Formatter::HttpFormatterContext& context,
                        const StreamInfo::StreamInfo& stream_info) const override {
-    const std::string value = formatter_->formatWithContext(context, stream_info);
+    std::string value_buffer;
+    absl::string_view value = original_value_;
+    if (!literal_) {
+      value_buffer = formatter_->formatWithContext(context, stream_info);
+      value = value_buffer;
+    }
 
     if (!value.empty() || add_if_empty_) {
       switch (append_action_) {
@@ -53,17 +58,20 @@ private:
   Envoy::Http::LowerCaseString header_name_;
 };
 
+// Removes the headers of consecutive remove mutations in a single pass.
 class RemoveMutation : public HeaderEvaluator {
 public:
-  RemoveMutation(const std::string& header_name) : header_name_(header_name) {}
+  RemoveMutation(const std::string& header_name) { add(header_name); }
+
+  void add(const std::string& header_name) { headers_to_remove_.add(header_name); }
 
   void evaluateHeaders(Http::HeaderMap& headers, const Formatter::HttpFormatterContext&,
                        const StreamInfo::StreamInfo&) const override {
-    headers.remove(header_name_);
+    headers_to_remove_.removeFrom(headers);
   }
 
 private:
-  const Envoy::Http::LowerCaseString header_name_;
+  Envoy::Router::HeadersToRemove headers_to_remove_;
 };
 } // namespace
 
@@ -78,6 +86,8 @@ HeaderMutations::create(const ProtoHeaderMutatons& header_mutations) {
 
 HeaderMutations::HeaderMutations(const ProtoHeaderMutatons& header_mutations,
                                  absl::Status& creation_status) {
+  // The remove mutation of the previous mutation, if it was one.
+  RemoveMutation* last_remove = nullptr;
   for (const auto& mutation : header_mutations) {
     switch (mutation.action_case()) {
     case envoy::config::common::mutation_rules::v3::HeaderMutation::ActionCase::kAppend:
@@ -86,9 +96,16 @@ HeaderMutations::HeaderMutations(const ProtoHeaderMutatons& header_mutations,
       if (!creation_status.ok()) {
         return;
       }
+      last_remove = nullptr;
       break;
     case envoy::config::common::mutation_rules::v3::HeaderMutation::ActionCase::kRemove:
-      header_mutations_.emplace_back(std::make_unique<RemoveMutation>(mutation.remove()));
+      if (last_remove != nullptr) {
+        last_remove->add(mutation.remove());
+      } else {
+        auto remove = std::make_unique<RemoveMutation>(mutation.remove());
+        last_remove = remove.get();
+        header_mutations_.emplace_back(std::move(remove));
+      }
       break;
     default:
       PANIC_DUE_TO_PROTO_UNSET;
@@ -0,0 +1,107 @@
+#include "source/common/http/header_scanner.h"
+
+#include <algorithm>
+#include <cstdint>
+
+#include "source/common/http/character_set_validation.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+namespace Envoy {
+namespace Http {
+
+namespace {
+
+constexpr uint8_t kMaxControlCharacter = 0x1f;
+constexpr uint8_t kDel = 0x7f;
+
+} // namespace
+
+HeaderScanner::ValueScanResult HeaderScanner::scanHeaderValue(absl::string_view value) {
+  ValueScanResult result;
+  const char* data = value.data();
+  size_t remaining = value.size();
+
+#if defined(__SSE2__)
+  if (remaining >= sizeof(__m128i)) {
+    const __m128i cr = _mm_set1_epi8('\r');
+    const __m128i lf = _mm_set1_epi8('\n');
+    const __m128i tab = _mm_set1_epi8('\t');
+    const __m128i del = _mm_set1_epi8(kDel);
+    const __m128i max_control = _mm_set1_epi8(kMaxControlCharacter);
+    __m128i cr_or_lf = _mm_setzero_si128();
+    __m128i invalid = _mm_setzero_si128();
+    // Matches are accumulated over the whole value and only extracted at the end, to keep the
+    // loop free of branches besides the loop condition.
+    do {
+      const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+      const __m128i is_cr_or_lf =
+          _mm_or_si128(_mm_cmpeq_epi8(chunk, cr), _mm_cmpeq_epi8(chunk, lf));
+      // There is no unsigned comparison in SSE2: a byte is at most 0x1f if it is its own minimum
+      // with 0x1f.
+      const __m128i is_control = _mm_cmpeq_epi8(_mm_min_epu8(chunk, max_control), chunk);
+      const __m128i is_allowed_control = _mm_or_si128(is_cr_or_lf, _mm_cmpeq_epi8(chunk, tab));
+      invalid = _mm_or_si128(invalid, _mm_andnot_si128(is_allowed_control, is_control));
+      invalid = _mm_or_si128(invalid, _mm_cmpeq_epi8(chunk, del));
+      cr_or_lf = _mm_or_si128(cr_or_lf, is_cr_or_lf);
+      data += sizeof(__m128i);
+      remaining -= sizeof(__m128i);
+    } while (remaining >= sizeof(__m128i));
+    result.has_cr_or_lf_ = _mm_movemask_epi8(cr_or_lf) != 0;
+    result.has_invalid_character_ = _mm_movemask_epi8(invalid) != 0;
+  }
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+  if (remaining >= sizeof(uint8x16_t)) {
+    const uint8x16_t cr = vdupq_n_u8('\r');
+    const uint8x16_t lf = vdupq_n_u8('\n');
+    const uint8x16_t tab = vdupq_n_u8('\t');
+    const uint8x16_t del = vdupq_n_u8(kDel);
+    const uint8x16_t max_control = vdupq_n_u8(kMaxControlCharacter);
+    uint8x16_t cr_or_lf = vdupq_n_u8(0);
+    uint8x16_t invalid = vdupq_n_u8(0);
+    do {
+      const uint8x16_t chunk = vld1q_u8(reinterpret_cast<const uint8_t*>(data));
+      const uint8x16_t is_cr_or_lf = vorrq_u8(vceqq_u8(chunk, cr), vceqq_u8(chunk, lf));
+      const uint8x16_t is_allowed_control = vorrq_u8(is_cr_or_lf, vceqq_u8(chunk, tab));
+      invalid = vorrq_u8(invalid, vbicq_u8(vcleq_u8(chunk, max_control), is_allowed_control));
+      invalid = vorrq_u8(invalid, vceqq_u8(chunk, del));
+      cr_or_lf = vorrq_u8(cr_or_lf, is_cr_or_lf);
+      data += sizeof(uint8x16_t);
+      remaining -= sizeof(uint8x16_t);
+    } while (remaining >= sizeof(uint8x16_t));
+    result.has_cr_or_lf_ = vmaxvq_u8(cr_or_lf) != 0;
+    result.has_invalid_character_ = vmaxvq_u8(invalid) != 0;
+  }
+#endif
+
+  const ValueScanResult tail = scanHeaderValueScalar(absl::string_view(data, remaining));
+  result.has_cr_or_lf_ |= tail.has_cr_or_lf_;
+  result.has_invalid_character_ |= tail.has_invalid_character_;
+  return result;
+}
+
+HeaderScanner::ValueScanResult HeaderScanner::scanHeaderValueScalar(absl::string_view value) {
+  ValueScanResult result;
+  for (const char c : value) {
+    const uint8_t byte = static_cast<uint8_t>(c);
+    if (byte == '\r' || byte == '\n') {
+      result.has_cr_or_lf_ = true;
+    } else if ((byte <= kMaxControlCharacter && byte != '\t') || byte == kDel) {
+      result.has_invalid_character_ = true;
+    }
+  }
+  return result;
+}
+
+bool HeaderScanner::isTokenString(absl::string_view token) {
+  return std::all_of(token.begin(), token.end(), [](absl::string_view::value_type c) {
+    return testCharInTable(kGenericHeaderNameCharTable, c);
+  });
+}
+
+} // namespace Http
+} // namespace Envoy
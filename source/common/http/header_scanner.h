@@ -0,0 +1,52 @@
+#pragma once
+
+#include "absl/strings/string_view.h"
+
+namespace Envoy {
+namespace Http {
+
+/**
+ * Character scanning of HTTP header names and values. Values are scanned 16 bytes at a time with
+ * SSE2 on x86-64 and NEON on arm64, both of which are part of the baseline instruction set of
+ * their architecture, so no runtime dispatch is needed. Other architectures use the scalar scan.
+ */
+class HeaderScanner {
+public:
+  /**
+   * Result of scanning a header value.
+   */
+  struct ValueScanResult {
+    // The value contains CR or LF, e.g. because of obsolete line folding.
+    bool has_cr_or_lf_{false};
+    // The value contains a control character other than HTAB, CR and LF, or DEL.
+    bool has_invalid_character_{false};
+
+    /**
+     * @return whether the value only holds characters allowed in a field value by RFC 9110,
+     * including obs-text.
+     */
+    bool valid() const { return !has_cr_or_lf_ && !has_invalid_character_; }
+  };
+
+  /**
+   * Scans a header value in a single pass.
+   * @param value supplies the header value to scan.
+   * @return ValueScanResult the characters found in the value.
+   */
+  static ValueScanResult scanHeaderValue(absl::string_view value);
+
+  /**
+   * Scalar version of scanHeaderValue(), which returns the same results. Used for the tail of the
+   * value that is shorter than a vector, and exposed for tests and benchmarks.
+   */
+  static ValueScanResult scanHeaderValueScalar(absl::string_view value);
+
+  /**
+   * @return whether all the characters of the string are tchar per Section 5.6.2 of RFC 9110,
+   * i.e. whether a non-empty string is a valid token, such as a header name or a method.
+   */
+  static bool isTokenString(absl::string_view token);
+};
+
+} // namespace Http
+} // namespace Envoy
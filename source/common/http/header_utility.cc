@@ -8,6 +8,7 @@
 #include "source/common/common/utility.h"
 #include "source/common/http/character_set_validation.h"
 #include "source/common/http/header_map_impl.h"
+#include "source/common/http/header_scanner.h"
 #include "source/common/http/utility.h"
 #include "source/common/protobuf/utility.h"
 #include "source/common/runtime/runtime_features.h"
@@ -197,8 +198,7 @@ bool HeaderUtility::matchHeaders(const HeaderMap& request_headers, const HeaderD
 }
 
 bool HeaderUtility::headerValueIsValid(const absl::string_view header_value) {
-  return http2::adapter::HeaderValidator::IsValidHeaderValue(header_value,
-                                                             http2::adapter::ObsTextOption::kAllow);
+  return HeaderScanner::scanHeaderValue(header_value).valid();
 }
 
 bool HeaderUtility::headerNameIsValid(absl::string_view header_key) {
@@ -67,6 +67,7 @@ public:
   const LowerCaseString AltSvc{"alt-svc"};
   const LowerCaseString Authentication{"authentication"};
   const LowerCaseString Authorization{"authorization"};
+  const LowerCaseString AvailableDictionary{"available-dictionary"};
   const LowerCaseString CacheControl{"cache-control"};
   const LowerCaseString CacheStatus{"cache-status"};
   const LowerCaseString CdnLoop{"cdn-loop"};
@@ -112,6 +113,7 @@ public:
 
   struct {
     const std::string Brotli{"br"};
+    const std::string BrotliDictionary{"dcb"};
     const std::string Gzip{"gzip"};
     const std::string Zstd{"zstd"};
   } ContentEncodingValues;
@@ -126,6 +128,7 @@ public:
 
   struct {
     const std::string AcceptEncoding{"Accept-Encoding"};
+    const std::string AvailableDictionary{"Available-Dictionary"};
     const std::string Wildcard{"*"};
   } VaryValues;
 };
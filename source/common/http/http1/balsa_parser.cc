@@ -5,6 +5,7 @@
 #include <cstdint>
 
 #include "source/common/common/assert.h"
+#include "source/common/http/header_scanner.h"
 #include "source/common/http/headers.h"
 
 #include "absl/strings/ascii.h"
@@ -24,14 +25,6 @@ constexpr absl::string_view kColonSlashSlash = "://";
 constexpr char kResponseFirstByte = 'H';
 constexpr absl::string_view kHttpVersionPrefix = "HTTP/";
 
-// Allowed characters for field names according to Section 5.1
-// and for methods according to Section 9.1 of RFC 9110:
-// https://www.rfc-editor.org/rfc/rfc9110.html
-constexpr absl::string_view kValidCharacters =
-    "!#$%&'*+-.0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ^_`abcdefghijklmnopqrstuvwxyz|~";
-constexpr absl::string_view::iterator kValidCharactersBegin = kValidCharacters.begin();
-constexpr absl::string_view::iterator kValidCharactersEnd = kValidCharacters.end();
-
 bool isFirstCharacterOfValidMethod(char c) {
   static constexpr char kValidFirstCharacters[] = {'A', 'B', 'C', 'D', 'G', 'H', 'L', 'M',
                                                    'N', 'O', 'P', 'R', 'S', 'T', 'U'};
@@ -45,10 +38,8 @@ bool isFirstCharacterOfValidMethod(char c) {
 // enabled.
 bool isMethodValid(absl::string_view method, bool allow_custom_methods) {
   if (allow_custom_methods) {
-    return !method.empty() &&
-           std::all_of(method.begin(), method.end(), [](absl::string_view::value_type c) {
-             return std::binary_search(kValidCharactersBegin, kValidCharactersEnd, c);
-           });
+    // Methods are tokens according to Section 9.1 of RFC 9110.
+    return !method.empty() && HeaderScanner::isTokenString(method);
   }
 
   static constexpr absl::string_view kValidMethods[] = {
@@ -138,11 +129,8 @@ bool isVersionValid(absl::string_view version_input) {
          version_input[1] == '.' && absl::ascii_isdigit(version_input[2]);
 }
 
-bool isHeaderNameValid(absl::string_view name) {
-  return std::all_of(name.begin(), name.end(), [](absl::string_view::value_type c) {
-    return std::binary_search(kValidCharactersBegin, kValidCharactersEnd, c);
-  });
-}
+// Field names are tokens according to Section 5.1 of RFC 9110.
+bool isHeaderNameValid(absl::string_view name) { return HeaderScanner::isTokenString(name); }
 
 } // anonymous namespace
 
@@ -429,7 +417,7 @@ void BalsaParser::validateAndProcessHeadersOrTrailersImpl(const quiche::BalsaHea
 
     // Remove CR and LF characters to match http-parser behavior.
     auto is_cr_or_lf = [](char c) { return c == '\r' || c == '\n'; };
-    if (std::any_of(value.begin(), value.end(), is_cr_or_lf)) {
+    if (HeaderScanner::scanHeaderValue(value).has_cr_or_lf_) {
       std::string value_without_cr_or_lf;
       value_without_cr_or_lf.reserve(value.size());
       for (char c : value) {
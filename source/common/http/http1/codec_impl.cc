@@ -3,6 +3,7 @@
 #include <cstdint>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "envoy/buffer/buffer.h"
 #include "envoy/common/optref.h"
@@ -28,6 +29,7 @@
 #include "source/common/runtime/runtime_features.h"
 
 #include "absl/container/fixed_array.h"
+#include "absl/container/inlined_vector.h"
 #include "absl/strings/ascii.h"
 
 namespace Envoy {
@@ -128,6 +130,50 @@ void StreamEncoderImpl::encodeFormattedHeader(absl::string_view key, absl::strin
   }
 }
 
+namespace {
+
+// The fragments of the serialized headers of a stream, which are added to the buffer at once.
+class HeaderFragments {
+public:
+  // max_headers is the number of headers to be added, which bounds the keys to format.
+  HeaderFragments(HeaderKeyFormatterOptConstRef formatter, size_t max_headers)
+      : formatter_(formatter) {
+    fragments_.reserve(max_headers * 4 + 1);
+    if (formatter_.has_value()) {
+      // The formatted keys are referenced by the fragments, so they must never be reallocated.
+      formatted_keys_.reserve(max_headers);
+    }
+  }
+
+  void add(absl::string_view key, absl::string_view value) {
+    ASSERT(!key.empty());
+    if (formatter_.has_value()) {
+      ASSERT(formatted_keys_.size() < formatted_keys_.capacity());
+      formatted_keys_.push_back(formatter_->format(key));
+      key = formatted_keys_.back();
+    }
+    fragments_.insert(fragments_.end(), {key, COLON_SPACE, value, CRLF});
+    header_bytes_ += key.size() + COLON_SPACE.size() + value.size() + CRLF.size();
+  }
+
+  // Adds the headers and the empty line which ends them to the buffer.
+  void addTo(Buffer::Instance& buffer) {
+    fragments_.push_back(CRLF);
+    buffer.addFragments(fragments_);
+  }
+
+  // The bytes of the headers, not counting the empty line which ends them.
+  uint64_t headerBytes() const { return header_bytes_; }
+
+private:
+  const HeaderKeyFormatterOptConstRef formatter_;
+  absl::InlinedVector<absl::string_view, 64> fragments_;
+  std::vector<std::string> formatted_keys_;
+  uint64_t header_bytes_{};
+};
+
+} // namespace
+
 void ResponseEncoderImpl::encode1xxHeaders(const ResponseHeaderMap& headers) {
   ASSERT(HeaderUtility::isSpecial1xx(headers));
   encodeHeaders(headers, false);
@@ -145,8 +191,10 @@ void StreamEncoderImpl::encodeHeadersBase(const RequestOrResponseHeaderMap& head
 
   const Http::HeaderValues& header_values = Http::Headers::get();
   bool saw_content_length = false;
+  // At most one header is added to those of the map, for the content length or chunked encoding.
+  HeaderFragments fragments(formatter, headers.size() + 1);
   headers.iterate(
-      [this, &header_values, formatter](const HeaderEntry& header) -> HeaderMap::Iterate {
+      [&fragments, &header_values](const HeaderEntry& header) -> HeaderMap::Iterate {
         absl::string_view key_to_use = header.key().getStringView();
         uint32_t key_size_to_use = header.key().size();
         // Translate :authority -> host so that upper layers do not need to deal with this.
@@ -160,7 +208,7 @@ void StreamEncoderImpl::encodeHeadersBase(const RequestOrResponseHeaderMap& head
           return HeaderMap::Iterate::Continue;
         }
 
-        encodeFormattedHeader(key_to_use, header.value().getStringView(), formatter);
+        fragments.add(key_to_use, header.value().getStringView());
 
         return HeaderMap::Iterate::Continue;
       });
@@ -202,7 +250,7 @@ void StreamEncoderImpl::encodeHeadersBase(const RequestOrResponseHeaderMap& head
       // body, per https://tools.ietf.org/html/rfc7230#section-3.3.2
       if (!status || (*status >= 200 && *status != 204)) {
         if (!bodiless_request) {
-          encodeFormattedHeader(header_values.ContentLength.get(), "0", formatter);
+          fragments.add(header_values.ContentLength.get(), "0");
         }
       }
       chunk_encoding_ = false;
@@ -212,8 +260,8 @@ void StreamEncoderImpl::encodeHeadersBase(const RequestOrResponseHeaderMap& head
       // For responses to connect requests, do not send the chunked encoding header:
       // https://tools.ietf.org/html/rfc7231#section-4.3.6.
       if (!is_response_to_connect_request_) {
-        encodeFormattedHeader(header_values.TransferEncoding.get(),
-                              header_values.TransferEncodingValues.Chunked, formatter);
+        fragments.add(header_values.TransferEncoding.get(),
+                      header_values.TransferEncodingValues.Chunked);
       }
       // We do not apply chunk encoding for HTTP upgrades, including CONNECT style upgrades.
       // If there is a body in a response on the upgrade path, the chunks will be
@@ -227,7 +275,8 @@ void StreamEncoderImpl::encodeHeadersBase(const RequestOrResponseHeaderMap& head
     }
   }
 
-  connection_.buffer().add(CRLF);
+  fragments.addTo(connection_.buffer());
+  bytes_meter_->addHeaderBytesSent(fragments.headerBytes());
 
   if (end_stream) {
     endEncode();
@@ -592,8 +641,11 @@ Status ConnectionImpl::onMessageBeginImpl() {
   protocol_ = Protocol::Http11;
   processing_trailers_ = false;
   header_parsing_state_ = HeaderParsingState::Field;
+  // The stream is created before its headers are allocated, so that they can be allocated from the
+  // header map arena of the stream.
+  const Status status = onMessageBeginBase();
   allocHeaders(statefulFormatterFromSettings(codec_settings_));
-  return onMessageBeginBase();
+  return status;
 }
 
 uint32_t ConnectionImpl::getHeadersSize() {
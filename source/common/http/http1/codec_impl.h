@@ -544,7 +544,8 @@ private:
   void allocHeaders(StatefulHeaderKeyFormatterPtr&& formatter) override {
     ASSERT(nullptr == absl::get<RequestHeaderMapPtr>(headers_or_trailers_));
     ASSERT(!processing_trailers_);
-    auto headers = RequestHeaderMapImpl::create(max_headers_kb_, max_headers_count_);
+    auto headers =
+        RequestHeaderMapImpl::create(max_headers_kb_, max_headers_count_, headerMapArena());
     headers->setFormatter(std::move(formatter));
     headers_or_trailers_.emplace<RequestHeaderMapPtr>(std::move(headers));
   }
@@ -552,9 +553,14 @@ private:
     ASSERT(processing_trailers_);
     if (!absl::holds_alternative<RequestTrailerMapPtr>(headers_or_trailers_)) {
       headers_or_trailers_.emplace<RequestTrailerMapPtr>(
-          RequestTrailerMapImpl::create(max_headers_kb_, max_headers_count_));
+          RequestTrailerMapImpl::create(max_headers_kb_, max_headers_count_, headerMapArena()));
     }
   }
+  HeaderMapArenaSharedPtr headerMapArena() const {
+    return active_request_ != nullptr && active_request_->request_decoder_ != nullptr
+               ? active_request_->request_decoder_->headerMapArena()
+               : nullptr;
+  }
   void dumpAdditionalState(std::ostream& os, int indent_level) const override;
 
   void releaseOutboundResponse(const Buffer::OwnedBufferFragmentImpl* fragment);
@@ -74,6 +74,13 @@ public:
   }
 };
 
+// The opaque data of the BDP pings, which the keepalive pings, carrying the time since the epoch in
+// milliseconds, don't have. It reads the same in either byte order.
+constexpr http2::adapter::Http2PingId BdpPingId = UINT64_MAX;
+// How long to wait before sampling the BDP again when a sample doesn't grow the connection window.
+constexpr std::chrono::milliseconds MinBdpPingBackoff{100};
+constexpr std::chrono::milliseconds MaxBdpPingBackoff{10000};
+
 int reasonToReset(StreamResetReason reason) {
   switch (reason) {
   case StreamResetReason::LocalRefusedStreamReset:
@@ -208,6 +215,17 @@ std::vector<http2::adapter::Header>
 ConnectionImpl::StreamImpl::buildHeaders(const HeaderMap& headers) {
   std::vector<http2::adapter::Header> out;
   out.reserve(headers.size());
+  if (Runtime::runtimeFeatureEnabled(
+          "envoy.reloadable_features.http2_submit_headers_without_copy")) {
+    // Both the nghttp2 and the oghttp2 adapters copy the headers into their own header block
+    // before SubmitRequest(), SubmitResponse() and SubmitTrailer() return, so the header block
+    // only needs to borrow views of the header map for the duration of the call.
+    headers.iterate([&out](const HeaderEntry& header) -> HeaderMap::Iterate {
+      out.push_back({header.key().getStringView(), header.value().getStringView()});
+      return HeaderMap::Iterate::Continue;
+    });
+    return out;
+  }
   headers.iterate([&out](const HeaderEntry& header) -> HeaderMap::Iterate {
     out.push_back({getRep(header.key()), getRep(header.value())});
     return HeaderMap::Iterate::Continue;
@@ -646,9 +664,9 @@ bool ConnectionImpl::StreamDataFrameSource::Send(absl::string_view frame_header,
                                                  size_t payload_length) {
   stream_.parent_.protocol_constraints_.incrementOutboundDataFrameCount();
 
-  Buffer::OwnedImpl output;
-  stream_.parent_.addOutboundFrameFragment(
-      output, reinterpret_cast<const uint8_t*>(frame_header.data()), frame_header.size());
+  stream_.parent_.addOutboundFrameFragment(stream_.parent_.outbound_frames_,
+                                           reinterpret_cast<const uint8_t*>(frame_header.data()),
+                                           frame_header.size());
   if (!stream_.parent_.protocol_constraints_.checkOutboundFrameLimits().ok()) {
     ENVOY_CONN_LOG(debug, "error sending data frame: Too many frames in the outbound queue",
                    stream_.parent_.connection_);
@@ -656,8 +674,8 @@ bool ConnectionImpl::StreamDataFrameSource::Send(absl::string_view frame_header,
   }
 
   stream_.parent_.stats_.pending_send_bytes_.sub(payload_length);
-  output.move(*stream_.pending_send_data_, payload_length);
-  stream_.parent_.connection_.write(output, false);
+  stream_.parent_.outbound_frames_.move(*stream_.pending_send_data_, payload_length);
+  stream_.parent_.maybeWriteOutboundFrames();
   return true;
 }
 
@@ -870,9 +888,15 @@ ConnectionImpl::ConnectionImpl(Network::Connection& connection, CodecStats& stat
       per_stream_buffer_limit_(http2_options.initial_stream_window_size().value()),
       stream_error_on_invalid_http_messaging_(
           http2_options.override_stream_error_on_invalid_http_message().value()),
+      batch_outbound_frames_(
+          Runtime::runtimeFeatureEnabled("envoy.reloadable_features.http2_batch_outbound_frames")),
       protocol_constraints_(stats, http2_options), dispatching_(false), raised_goaway_(false),
       random_(random_generator),
-      last_received_data_time_(connection_.dispatcher().timeSource().monotonicTime()) {
+      last_received_data_time_(connection_.dispatcher().timeSource().monotonicTime()),
+      initial_connection_window_size_(http2_options.initial_connection_window_size().value()),
+      max_connection_window_size_(
+          PROTOBUF_GET_WRAPPED_OR_DEFAULT(http2_options, max_connection_window_size, 0)),
+      connection_window_size_(initial_connection_window_size_) {
   if (http2_options.has_use_oghttp2_codec()) {
     use_oghttp2_library_ = http2_options.use_oghttp2_codec().value();
   } else {
@@ -902,6 +926,8 @@ ConnectionImpl::~ConnectionImpl() {
   for (const auto& stream : active_streams_) {
     stream->destroy();
   }
+  stats_.connection_window_autotuned_bytes_.sub(connection_window_size_ -
+                                                initial_connection_window_size_);
 }
 
 void ConnectionImpl::sendKeepalive() {
@@ -941,6 +967,48 @@ void ConnectionImpl::onKeepaliveResponse() {
   }
 }
 
+void ConnectionImpl::sampleBdp(size_t length, bool read_disabled) {
+  if (bdp_ping_outstanding_) {
+    bdp_sample_bytes_ += length;
+    bdp_sample_read_disabled_ = bdp_sample_read_disabled_ || read_disabled;
+    return;
+  }
+  // Nothing is sampled once the window is at its maximum, or if autotuning isn't configured.
+  if (connection_window_size_ >= max_connection_window_size_ ||
+      connection_.dispatcher().timeSource().monotonicTime() < next_bdp_ping_time_) {
+    return;
+  }
+
+  ENVOY_CONN_LOG(trace, "Sending BDP PING", connection_);
+  adapter_->SubmitPing(BdpPingId);
+  bdp_ping_outstanding_ = true;
+  bdp_sample_bytes_ = length;
+  bdp_sample_read_disabled_ = read_disabled;
+}
+
+void ConnectionImpl::onBdpPingAck() {
+  bdp_ping_outstanding_ = false;
+  // The window limits the peer if it sent close to a window's worth of data within a round trip.
+  if (!bdp_sample_read_disabled_ &&
+      bdp_sample_bytes_ * 3 >= static_cast<uint64_t>(connection_window_size_) * 2) {
+    const uint32_t window_size = static_cast<uint32_t>(
+        std::min<uint64_t>(max_connection_window_size_, bdp_sample_bytes_ * 2));
+    if (window_size > connection_window_size_) {
+      ENVOY_CONN_LOG(debug, "growing connection-level window size from {} to {}", connection_,
+                     connection_window_size_, window_size);
+      adapter_->SubmitWindowUpdate(0, window_size - connection_window_size_);
+      stats_.connection_window_autotuned_.inc();
+      stats_.connection_window_autotuned_bytes_.add(window_size - connection_window_size_);
+      connection_window_size_ = window_size;
+      bdp_ping_backoff_ = std::chrono::milliseconds::zero();
+      return;
+    }
+  }
+
+  bdp_ping_backoff_ = std::clamp(2 * bdp_ping_backoff_, MinBdpPingBackoff, MaxBdpPingBackoff);
+  next_bdp_ping_time_ = connection_.dispatcher().timeSource().monotonicTime() + bdp_ping_backoff_;
+}
+
 void ConnectionImpl::onKeepaliveResponseTimeout() {
   ENVOY_CONN_LOG_EVENT(debug, "h2_ping_timeout", "Closing connection due to keepalive timeout",
                        connection_);
@@ -1113,7 +1181,11 @@ Status ConnectionImpl::onPing(uint64_t opaque_data, bool is_ack) {
   if (is_ack) {
     ENVOY_CONN_LOG(trace, "recv PING ACK {}", connection_, opaque_data);
 
-    onKeepaliveResponse();
+    if (opaque_data == BdpPingId && bdp_ping_outstanding_) {
+      onBdpPingAck();
+    } else {
+      onKeepaliveResponse();
+    }
   }
   return okStatus();
 }
@@ -1124,6 +1196,8 @@ Status ConnectionImpl::onBeginData(int32_t stream_id, size_t length, uint8_t fla
   RETURN_IF_ERROR(trackInboundFrames(stream_id, length, NGHTTP2_DATA, flags, padding));
 
   StreamImpl* stream = getStreamUnchecked(stream_id);
+  // The DATA frames of the closed streams take up the connection window as well.
+  sampleBdp(length, stream != nullptr && stream->read_disable_count_ > 0);
   if (!stream) {
     return okStatus();
   }
@@ -1372,20 +1446,32 @@ Status ConnectionImpl::trackInboundFrames(int32_t stream_id, size_t length, uint
 
 ssize_t ConnectionImpl::onSend(const uint8_t* data, size_t length) {
   ENVOY_CONN_LOG(trace, "send data: bytes={}", connection_, length);
-  Buffer::OwnedImpl buffer;
-  addOutboundFrameFragment(buffer, data, length);
+  addOutboundFrameFragment(outbound_frames_, data, length);
 
-  // While the buffer is transient the fragment it contains will be moved into the
-  // write_buffer_ of the underlying connection_ by the write method below.
+  // The fragments of outbound_frames_ will be moved into the write_buffer_ of the underlying
+  // connection_ by the write method, here or at the end of sendPendingFrames().
   // This creates lifetime dependency between the write_buffer_ of the underlying connection
   // and the codec object. Specifically the write_buffer_ MUST be either fully drained or
   // deleted before the codec object is deleted. This is presently guaranteed by the
   // destruction order of the Network::ConnectionImpl object where write_buffer_ is
   // destroyed before the filter_manager_ which owns the codec through Http::ConnectionManagerImpl.
-  connection_.write(buffer, false);
+  maybeWriteOutboundFrames();
   return length;
 }
 
+void ConnectionImpl::maybeWriteOutboundFrames() {
+  if (!batch_outbound_frames_) {
+    writeOutboundFrames();
+  }
+}
+
+void ConnectionImpl::writeOutboundFrames() {
+  connection_.write(outbound_frames_, false);
+  // The frames are done with once written, even if the connection left some of them in the buffer,
+  // e.g. when a write filter stopped the iteration.
+  outbound_frames_.drain(outbound_frames_.length());
+}
+
 Status ConnectionImpl::onStreamClose(StreamImpl* stream, uint32_t error_code) {
   if (stream) {
     const int32_t stream_id = stream->stream_id_;
@@ -1546,6 +1632,11 @@ Status ConnectionImpl::sendPendingFrames() {
   }
 
   const int rc = adapter_->Send();
+  // All the frames the session serialized are written at once, going through the connection's
+  // write filters a single time.
+  if (outbound_frames_.length() > 0) {
+    writeOutboundFrames();
+  }
   if (rc != 0) {
     ASSERT(rc == NGHTTP2_ERR_CALLBACK_FAILURE);
     return codecProtocolError(nghttp2_strerror(rc));
@@ -1736,9 +1827,9 @@ bool ConnectionImpl::Http2Visitor::SendDataFrame(Http2StreamId stream_id,
                    stream_id);
     return false;
   }
-  Buffer::OwnedImpl output;
-  connection_->addOutboundFrameFragment(
-      output, reinterpret_cast<const uint8_t*>(frame_header.data()), frame_header.size());
+  connection_->addOutboundFrameFragment(connection_->outbound_frames_,
+                                        reinterpret_cast<const uint8_t*>(frame_header.data()),
+                                        frame_header.size());
   if (!connection_->protocol_constraints_.checkOutboundFrameLimits().ok()) {
     ENVOY_CONN_LOG(debug, "error sending data frame: Too many frames in the outbound queue",
                    connection_->connection_);
@@ -1746,8 +1837,9 @@ bool ConnectionImpl::Http2Visitor::SendDataFrame(Http2StreamId stream_id,
   }
 
   connection_->stats_.pending_send_bytes_.sub(payload_length);
-  output.move(*stream->pending_send_data_, payload_length);
-  connection_->connection_.write(output, false);
+  // The payload slices are moved rather than copied, only the frame header is written.
+  connection_->outbound_frames_.move(*stream->pending_send_data_, payload_length);
+  connection_->maybeWriteOutboundFrames();
   return true;
 }
 
@@ -2234,6 +2326,7 @@ Status ServerConnectionImpl::onBeginHeaders(int32_t stream_id) {
     stream->runHighWatermarkCallbacks();
   }
   stream->setRequestDecoder(callbacks_.newStream(*stream));
+  stream->allocHeaders();
   stream->stream_id_ = stream_id;
   LinkedList::moveIntoList(std::move(stream), active_streams_);
   adapter_->SetStreamUserData(stream_id, active_streams_.front().get());
@@ -282,6 +282,7 @@ protected:
 
     StreamImpl* base() { return this; }
     void resetStreamWorker(StreamResetReason reason);
+    // The returned headers may refer to the header map, which must outlive them.
     static std::vector<http2::adapter::Header> buildHeaders(const HeaderMap& headers);
     virtual Status onBeginHeaders() PURE;
     virtual void advanceHeadersState() PURE;
@@ -564,9 +565,15 @@ protected:
    */
   struct ServerStreamImpl : public StreamImpl, public ResponseEncoder {
     ServerStreamImpl(ConnectionImpl& parent, uint32_t buffer_limit)
-        : StreamImpl(parent, buffer_limit),
-          headers_or_trailers_(
-              RequestHeaderMapImpl::create(parent_.max_headers_kb_, parent_.max_headers_count_)) {}
+        : StreamImpl(parent, buffer_limit) {}
+
+    // Allocates the request headers once the request decoder is known, so that they can be
+    // allocated from the header map arena of the stream.
+    void allocHeaders() {
+      headers_or_trailers_.emplace<RequestHeaderMapSharedPtr>(
+          RequestHeaderMapImpl::create(parent_.max_headers_kb_, parent_.max_headers_count_,
+                                       request_decoder_->headerMapArena()));
+    }
 
     // StreamImpl
     void destroy() override;
@@ -590,7 +597,8 @@ protected:
     }
     void allocTrailers() override {
       headers_or_trailers_.emplace<RequestTrailerMapPtr>(
-          RequestTrailerMapImpl::create(parent_.max_headers_kb_, parent_.max_headers_count_));
+          RequestTrailerMapImpl::create(parent_.max_headers_kb_, parent_.max_headers_count_,
+                                        request_decoder_->headerMapArena()));
     }
     HeaderMapPtr cloneTrailers(const HeaderMap& trailers) override {
       return createHeaderMap<ResponseTrailerMapImpl>(trailers);
@@ -714,6 +722,9 @@ protected:
   uint32_t per_stream_buffer_limit_;
   bool allow_metadata_;
   const bool stream_error_on_invalid_http_messaging_;
+  // Whether the frames serialized by a sendPendingFrames() call are written to the connection
+  // together at its end, rather than one at a time.
+  const bool batch_outbound_frames_;
 
   // Status for any errors encountered by the nghttp2 callbacks.
   // nghttp2 library uses single return code to indicate callback failure and
@@ -725,6 +736,9 @@ protected:
   // RST_STREAM.
   bool is_outbound_flood_monitored_control_frame_ = 0;
   ProtocolConstraints protocol_constraints_;
+  // The frames serialized and not yet written to the connection. It is declared after the protocol
+  // constraints, which the drain trackers of the frames release.
+  Buffer::OwnedImpl outbound_frames_;
 
   // For the flood mitigation to work the onSend callback must be called once for each outbound
   // frame. This is what the nghttp2 library is doing, however this is not documented. The
@@ -732,6 +746,9 @@ protected:
   // this changes in the future. Also it is important that onSend does not do partial writes, as the
   // nghttp2 library will keep calling this callback to write the rest of the frame.
   ssize_t onSend(const uint8_t* data, size_t length);
+  // Writes the serialized frames to the connection, unless they are batched.
+  void maybeWriteOutboundFrames();
+  void writeOutboundFrames();
 
   // Called when a stream encodes to the http2 connection which enables us to
   // keep the active_streams list in LRU if deferred processing.
@@ -781,6 +798,11 @@ private:
                             uint32_t padding_length);
   void onKeepaliveResponse();
   void onKeepaliveResponseTimeout();
+  // Samples the bandwidth-delay product of the connection with the received DATA frames, sending
+  // a BDP ping if none is outstanding.
+  void sampleBdp(size_t length, bool read_disabled);
+  // Grows the connection window once the BDP ping is acknowledged, if the sample asks for it.
+  void onBdpPingAck();
   bool slowContainsStreamId(int32_t stream_id) const;
   virtual StreamResetReason getMessagingErrorResetReason() const PURE;
 
@@ -801,6 +823,18 @@ private:
   std::chrono::milliseconds keepalive_interval_;
   std::chrono::milliseconds keepalive_timeout_;
   uint32_t keepalive_interval_jitter_percent_;
+  // The connection window autotuning state. The window is only grown up to the maximum size.
+  const uint32_t initial_connection_window_size_;
+  const uint32_t max_connection_window_size_;
+  uint32_t connection_window_size_;
+  // The bytes received since the outstanding BDP ping was sent, and whether a stream was read
+  // disabled meanwhile, in which case it is the consumer rather than the window which limits them.
+  uint64_t bdp_sample_bytes_{};
+  bool bdp_sample_read_disabled_{};
+  bool bdp_ping_outstanding_{};
+  // The samples which don't grow the window make the next ones wait for longer.
+  std::chrono::milliseconds bdp_ping_backoff_{};
+  MonotonicTime next_bdp_ping_time_{};
 };
 
 /**
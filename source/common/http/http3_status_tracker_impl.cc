@@ -11,8 +11,10 @@ const std::chrono::seconds DefaultExpirationTime{1};
 const int MaxConsecutiveBrokenCount = 17;
 } // namespace
 
-Http3StatusTrackerImpl::Http3StatusTrackerImpl(Event::Dispatcher& dispatcher)
-    : expiration_timer_(dispatcher.createTimer([this]() -> void { onExpirationTimeout(); })) {}
+Http3StatusTrackerImpl::Http3StatusTrackerImpl(Event::Dispatcher& dispatcher,
+                                               std::function<void()> on_broken)
+    : on_broken_(std::move(on_broken)),
+      expiration_timer_(dispatcher.createTimer([this]() -> void { onExpirationTimeout(); })) {}
 
 bool Http3StatusTrackerImpl::isHttp3Broken() const { return state_ == State::Broken; }
 
@@ -33,6 +35,9 @@ void Http3StatusTrackerImpl::markHttp3Broken() {
       ++consecutive_broken_count_;
     }
   }
+  if (on_broken_ != nullptr) {
+    on_broken_();
+  }
 }
 
 void Http3StatusTrackerImpl::markHttp3Confirmed() {
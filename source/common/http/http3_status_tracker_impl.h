@@ -1,5 +1,6 @@
 #pragma once
 
+#include <functional>
 #include <memory>
 
 #include "envoy/event/dispatcher.h"
@@ -13,7 +14,9 @@ namespace Http {
 // subject to exponential backoff.
 class Http3StatusTrackerImpl : public HttpServerPropertiesCache::Http3StatusTracker {
 public:
-  explicit Http3StatusTrackerImpl(Event::Dispatcher& dispatcher);
+  // on_broken, if set, is called each time HTTP/3 is marked broken.
+  explicit Http3StatusTrackerImpl(Event::Dispatcher& dispatcher,
+                                  std::function<void()> on_broken = nullptr);
 
   // Returns true if HTTP/3 is broken.
   bool isHttp3Broken() const override;
@@ -39,6 +42,7 @@ private:
   // Called when the expiration timer fires.
   void onExpirationTimeout();
 
+  const std::function<void()> on_broken_;
   State state_{State::Pending};
   // The number of consecutive times HTTP/3 has been marked broken.
   int consecutive_broken_count_{};
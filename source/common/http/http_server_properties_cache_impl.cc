@@ -154,23 +154,41 @@ void HttpServerPropertiesCacheImpl::setAlternatives(const Origin& origin,
                                                     std::vector<AlternateProtocol>& protocols) {
   OriginDataWithOptRef data;
   data.protocols = protocols;
-  auto it = setPropertiesImpl(origin, data);
-  if (key_value_store_) {
-    key_value_store_->addOrUpdate(originToString(origin), originDataToStringForCache(it->second),
-                                  absl::nullopt);
+  setAndStoreProperties(origin, data);
+  if (Observer* observer = this->observer(); observer != nullptr) {
+    observer->onAlternatives(origin, protocols);
   }
 }
 
 void HttpServerPropertiesCacheImpl::setSrtt(const Origin& origin, std::chrono::microseconds srtt) {
   OriginDataWithOptRef data;
   data.srtt = srtt;
-  auto it = setPropertiesImpl(origin, data);
-  if (key_value_store_) {
-    key_value_store_->addOrUpdate(originToString(origin), originDataToStringForCache(it->second),
-                                  absl::nullopt);
+  setAndStoreProperties(origin, data);
+  if (Observer* observer = this->observer(); observer != nullptr) {
+    observer->onSrtt(origin, srtt);
   }
 }
 
+void HttpServerPropertiesCacheImpl::applyAlternatives(const Origin& origin,
+                                                      std::vector<AlternateProtocol> protocols) {
+  applying_ = true;
+  setAlternatives(origin, protocols);
+  applying_ = false;
+}
+
+void HttpServerPropertiesCacheImpl::applySrtt(const Origin& origin,
+                                              std::chrono::microseconds srtt) {
+  applying_ = true;
+  setSrtt(origin, srtt);
+  applying_ = false;
+}
+
+void HttpServerPropertiesCacheImpl::applyHttp3Broken(const Origin& origin) {
+  applying_ = true;
+  getOrCreateHttp3StatusTracker(origin).markHttp3Broken();
+  applying_ = false;
+}
+
 std::chrono::microseconds HttpServerPropertiesCacheImpl::getSrtt(const Origin& origin) const {
   auto entry_it = protocols_.find(origin);
   if (entry_it == protocols_.end()) {
@@ -183,11 +201,7 @@ void HttpServerPropertiesCacheImpl::setConcurrentStreams(const Origin& origin,
                                                          uint32_t concurrent_streams) {
   OriginDataWithOptRef data;
   data.concurrent_streams = concurrent_streams;
-  auto it = setPropertiesImpl(origin, data);
-  if (key_value_store_) {
-    key_value_store_->addOrUpdate(originToString(origin), originDataToStringForCache(it->second),
-                                  absl::nullopt);
-  }
+  setAndStoreProperties(origin, data);
 }
 
 uint32_t HttpServerPropertiesCacheImpl::getConcurrentStreams(const Origin& origin) const {
@@ -229,6 +243,17 @@ HttpServerPropertiesCacheImpl::setPropertiesImpl(const Origin& origin,
                         std::move(origin_data.h3_status_tracker), origin_data.concurrent_streams});
 }
 
+HttpServerPropertiesCacheImpl::ProtocolsMap::iterator
+HttpServerPropertiesCacheImpl::setAndStoreProperties(const Origin& origin,
+                                                     OriginDataWithOptRef& origin_data) {
+  auto it = setPropertiesImpl(origin, origin_data);
+  if (key_value_store_) {
+    key_value_store_->addOrUpdate(originToString(origin), originDataToStringForCache(it->second),
+                                  absl::nullopt);
+  }
+  return it;
+}
+
 HttpServerPropertiesCacheImpl::ProtocolsMap::iterator
 HttpServerPropertiesCacheImpl::addOriginData(const Origin& origin, OriginData&& origin_data) {
   ASSERT(protocols_.find(origin) == protocols_.end());
@@ -283,17 +308,26 @@ HttpServerPropertiesCacheImpl::getOrCreateHttp3StatusTracker(const Origin& origi
   auto entry_it = protocols_.find(origin);
   if (entry_it != protocols_.end()) {
     if (entry_it->second.h3_status_tracker == nullptr) {
-      entry_it->second.h3_status_tracker = std::make_unique<Http3StatusTrackerImpl>(dispatcher_);
+      entry_it->second.h3_status_tracker = createHttp3StatusTracker(origin);
     }
     return *entry_it->second.h3_status_tracker;
   }
 
   OriginDataWithOptRef data;
-  data.h3_status_tracker = std::make_unique<Http3StatusTrackerImpl>(dispatcher_);
+  data.h3_status_tracker = createHttp3StatusTracker(origin);
   auto it = setPropertiesImpl(origin, data);
   return *it->second.h3_status_tracker;
 }
 
+Http3StatusTrackerPtr
+HttpServerPropertiesCacheImpl::createHttp3StatusTracker(const Origin& origin) {
+  return std::make_unique<Http3StatusTrackerImpl>(dispatcher_, [this, origin]() {
+    if (Observer* observer = this->observer(); observer != nullptr) {
+      observer->onHttp3Broken(origin);
+    }
+  });
+}
+
 absl::string_view HttpServerPropertiesCacheImpl::getCanonicalSuffix(absl::string_view hostname) {
   for (const std::string& suffix : canonical_suffixes_) {
     if (absl::EndsWith(hostname, suffix)) {
@@ -34,6 +34,25 @@ public:
                                 std::unique_ptr<KeyValueStore>&& store, size_t max_entries);
   ~HttpServerPropertiesCacheImpl() override;
 
+  // Observes the properties learned by the connections of the worker of a cache, so that they can
+  // be shared with the caches of the other workers.
+  class Observer {
+  public:
+    virtual ~Observer() = default;
+
+    virtual void onAlternatives(const Origin& origin,
+                                const std::vector<AlternateProtocol>& protocols) PURE;
+    virtual void onSrtt(const Origin& origin, std::chrono::microseconds srtt) PURE;
+    virtual void onHttp3Broken(const Origin& origin) PURE;
+  };
+
+  void setObserver(std::unique_ptr<Observer>&& observer) { observer_ = std::move(observer); }
+
+  // Apply the properties learned by the cache of another worker, without notifying the observer.
+  void applyAlternatives(const Origin& origin, std::vector<AlternateProtocol> protocols);
+  void applySrtt(const Origin& origin, std::chrono::microseconds srtt);
+  void applyHttp3Broken(const Origin& origin);
+
   // Captures the data tracked per origin;,
   struct OriginData {
     OriginData() = default;
@@ -131,6 +150,16 @@ private:
 
   ProtocolsMap::iterator setPropertiesImpl(const Origin& origin, OriginDataWithOptRef& origin_data);
 
+  // Sets the properties and writes them to the key value store.
+  ProtocolsMap::iterator setAndStoreProperties(const Origin& origin,
+                                               OriginDataWithOptRef& origin_data);
+
+  // Returns a status tracker which notifies the observer when HTTP/3 is marked broken.
+  Http3StatusTrackerPtr createHttp3StatusTracker(const Origin& origin);
+
+  // Returns the observer to notify of the properties learned by this cache, if any.
+  Observer* observer() const { return applying_ ? nullptr : observer_.get(); }
+
   ProtocolsMap::iterator addOriginData(const Origin& origin, OriginData&& origin_data);
 
   // Returns the canonical suffix, if any, associated with `hostname`.
@@ -155,6 +184,10 @@ private:
   std::vector<std::string> canonical_suffixes_;
 
   const size_t max_entries_;
+
+  std::unique_ptr<Observer> observer_;
+  // Set while applying the properties learned by another cache.
+  bool applying_{false};
 };
 
 } // namespace Http
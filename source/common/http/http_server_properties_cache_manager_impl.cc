@@ -7,6 +7,7 @@
 #include "source/common/config/utility.h"
 #include "source/common/http/http_server_properties_cache_impl.h"
 #include "source/common/protobuf/protobuf.h"
+#include "source/common/runtime/runtime_features.h"
 
 #include "absl/container/flat_hash_map.h"
 
@@ -70,10 +71,56 @@ HttpServerPropertiesCacheSharedPtr HttpServerPropertiesCacheManagerImpl::getCach
     }
   }
 
+  if (Runtime::runtimeFeatureEnabled(
+          "envoy.reloadable_features.share_http_server_properties_across_workers")) {
+    new_cache->setObserver(
+        std::make_unique<CacheObserver>(data_.dispatcher_, weak_from_this(), options.name(),
+                                        new_cache.get()));
+  }
+
   (*slot_).caches_.emplace(options.name(), CacheWithOptions{options, new_cache});
   return new_cache;
 }
 
+void HttpServerPropertiesCacheManagerImpl::applyToPeers(
+    const std::string& name, const HttpServerPropertiesCacheImpl* source, CacheUpdate&& update) {
+  slot_.runOnAllThreads(
+      [name, source, update = std::move(update)](OptRef<State> state) {
+        auto it = state->caches_.find(name);
+        if (it != state->caches_.end() && it->second.cache_.get() != source) {
+          update(*it->second.cache_);
+        }
+      });
+}
+
+void HttpServerPropertiesCacheManagerImpl::CacheObserver::onAlternatives(
+    const HttpServerPropertiesCache::Origin& origin,
+    const std::vector<HttpServerPropertiesCache::AlternateProtocol>& protocols) {
+  share([origin, protocols](HttpServerPropertiesCacheImpl& cache) {
+    cache.applyAlternatives(origin, protocols);
+  });
+}
+
+void HttpServerPropertiesCacheManagerImpl::CacheObserver::onSrtt(
+    const HttpServerPropertiesCache::Origin& origin, std::chrono::microseconds srtt) {
+  share([origin, srtt](HttpServerPropertiesCacheImpl& cache) { cache.applySrtt(origin, srtt); });
+}
+
+void HttpServerPropertiesCacheManagerImpl::CacheObserver::onHttp3Broken(
+    const HttpServerPropertiesCache::Origin& origin) {
+  share([origin](HttpServerPropertiesCacheImpl& cache) { cache.applyHttp3Broken(origin); });
+}
+
+void HttpServerPropertiesCacheManagerImpl::CacheObserver::share(CacheUpdate&& update) {
+  // The manager is only locked on the main thread, so that it is never destroyed on a worker.
+  main_dispatcher_.post(
+      [manager = manager_, name = name_, source = cache_, update = std::move(update)]() mutable {
+        if (std::shared_ptr<HttpServerPropertiesCacheManagerImpl> locked = manager.lock()) {
+          locked->applyToPeers(name, source, std::move(update));
+        }
+      });
+}
+
 HttpServerPropertiesCacheManagerSharedPtr HttpServerPropertiesCacheManagerFactoryImpl::get() {
   return singleton_manager_.getTyped<HttpServerPropertiesCacheManager>(
       SINGLETON_MANAGER_REGISTERED_NAME(alternate_protocols_cache_manager),
@@ -7,6 +7,8 @@
 #include "envoy/singleton/manager.h"
 #include "envoy/thread_local/thread_local.h"
 
+#include "source/common/http/http_server_properties_cache_impl.h"
+
 #include "absl/container/flat_hash_map.h"
 
 namespace Envoy {
@@ -24,8 +26,15 @@ struct AlternateProtocolsData {
   uint32_t concurrency_;
 };
 
-class HttpServerPropertiesCacheManagerImpl : public HttpServerPropertiesCacheManager,
-                                             public Singleton::Instance {
+/**
+ * Creates the caches of each worker. The alternate protocols, round trip times and HTTP/3
+ * failures learned by the cache of a worker are shared with the caches of the same name of the
+ * other workers, through the main thread.
+ */
+class HttpServerPropertiesCacheManagerImpl
+    : public HttpServerPropertiesCacheManager,
+      public Singleton::Instance,
+      public std::enable_shared_from_this<HttpServerPropertiesCacheManagerImpl> {
 public:
   HttpServerPropertiesCacheManagerImpl(AlternateProtocolsData& data,
                                        ThreadLocal::SlotAllocator& tls);
@@ -39,13 +48,46 @@ private:
   // Contains a cache and the options associated with it.
   struct CacheWithOptions {
     CacheWithOptions(const envoy::config::core::v3::AlternateProtocolsCacheOptions& options,
-                     HttpServerPropertiesCacheSharedPtr cache)
+                     std::shared_ptr<HttpServerPropertiesCacheImpl> cache)
         : options_(options), cache_(cache) {}
 
     const envoy::config::core::v3::AlternateProtocolsCacheOptions options_;
-    HttpServerPropertiesCacheSharedPtr cache_;
+    std::shared_ptr<HttpServerPropertiesCacheImpl> cache_;
+  };
+
+  using CacheUpdate = std::function<void(HttpServerPropertiesCacheImpl&)>;
+
+  // Shares the properties learned by the cache of a worker with its peers.
+  class CacheObserver : public HttpServerPropertiesCacheImpl::Observer {
+  public:
+    CacheObserver(Event::Dispatcher& main_dispatcher,
+                  std::weak_ptr<HttpServerPropertiesCacheManagerImpl> manager, std::string name,
+                  const HttpServerPropertiesCacheImpl* cache)
+        : main_dispatcher_(main_dispatcher), manager_(std::move(manager)), name_(std::move(name)),
+          cache_(cache) {}
+
+    // HttpServerPropertiesCacheImpl::Observer
+    void onAlternatives(const HttpServerPropertiesCache::Origin& origin,
+                        const std::vector<HttpServerPropertiesCache::AlternateProtocol>& protocols)
+        override;
+    void onSrtt(const HttpServerPropertiesCache::Origin& origin,
+                std::chrono::microseconds srtt) override;
+    void onHttp3Broken(const HttpServerPropertiesCache::Origin& origin) override;
+
+  private:
+    void share(CacheUpdate&& update);
+
+    Event::Dispatcher& main_dispatcher_;
+    const std::weak_ptr<HttpServerPropertiesCacheManagerImpl> manager_;
+    const std::string name_;
+    const HttpServerPropertiesCacheImpl* const cache_;
   };
 
+  // Applies the update to the caches of the name on all the workers but the one of the source
+  // cache. Called on the main thread.
+  void applyToPeers(const std::string& name, const HttpServerPropertiesCacheImpl* source,
+                    CacheUpdate&& update);
+
   // Per-thread state.
   struct State : public ThreadLocal::ThreadLocalObject {
     // Map from config name to cache for that config.
@@ -161,8 +161,8 @@ public:
       return {Matcher::DataInputGetResult::DataAvailability::NotAvailable, absl::monostate()};
     }
 
-    auto params =
-        Http::Utility::QueryParamsMulti::parseAndDecodeQueryString(ret->value().getStringView());
+    const auto& params = Http::Utility::QueryParamsMulti::parseAndDecodeQueryStringCached(
+        ret->value().getStringView());
 
     auto ItParam = params.getFirstValue(query_param_);
     if (!ItParam.has_value()) {
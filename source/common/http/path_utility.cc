@@ -3,6 +3,8 @@
 #include "source/common/common/logger.h"
 #include "source/common/runtime/runtime_features.h"
 
+#include "absl/strings/ascii.h"
+#include "absl/strings/str_cat.h"
 #include "absl/strings/str_join.h"
 #include "absl/strings/str_split.h"
 #include "absl/types/optional.h"
@@ -25,13 +27,19 @@ absl::optional<std::string> canonicalizePath(absl::string_view original_path) {
   return absl::make_optional(std::move(canonical_path));
 }
 
-void unescapeInPath(std::string& path, absl::string_view escape_sequence,
-                    absl::string_view substitution) {
-  std::vector<absl::string_view> split = absl::StrSplit(path, escape_sequence);
-  if (split.size() == 1) {
-    return;
+// Returns the slash or backslash encoded by the escape sequence at the start of the string, or
+// '\0' if it doesn't start with %2F or %5C in either case.
+char decodeEscapedSlash(absl::string_view escape_sequence) {
+  if (escape_sequence.size() < 3 || escape_sequence[0] != '%') {
+    return '\0';
+  }
+  if (escape_sequence[1] == '2' && absl::ascii_toupper(escape_sequence[2]) == 'F') {
+    return '/';
+  }
+  if (escape_sequence[1] == '5' && absl::ascii_toupper(escape_sequence[2]) == 'C') {
+    return '\\';
   }
-  path = absl::StrJoin(split, substitution);
+  return '\0';
 }
 
 } // namespace
@@ -92,17 +100,29 @@ PathUtil::UnescapeSlashesResult PathUtil::unescapeSlashes(RequestHeaderMap& head
   }
   const absl::string_view query = absl::ClippedSubstr(original_path, query_start);
 
-  // TODO(yanavlasov): optimize this by adding case insensitive matcher
-  std::string decoded_path{path};
-  unescapeInPath(decoded_path, "%2F", "/");
-  unescapeInPath(decoded_path, "%2f", "/");
-  unescapeInPath(decoded_path, "%5C", "\\");
-  unescapeInPath(decoded_path, "%5c", "\\");
-  headers.setPath(absl::StrCat(decoded_path, query));
-  // Path length will not match if there were unescaped %2f or %5c
-  return headers.getPathValue().length() != original_length
-             ? UnescapeSlashesResult::FoundAndUnescaped
-             : UnescapeSlashesResult::NotFound;
+  // Decode the escaped slashes in a single pass, only copying the path once one is found.
+  std::string decoded_path;
+  size_t copied = 0;
+  for (size_t i = path.find('%'); i != absl::string_view::npos; i = path.find('%', i)) {
+    const char slash = decodeEscapedSlash(path.substr(i));
+    if (slash == '\0') {
+      ++i;
+      continue;
+    }
+    if (decoded_path.empty()) {
+      decoded_path.reserve(original_length);
+    }
+    absl::StrAppend(&decoded_path, path.substr(copied, i - copied));
+    decoded_path.push_back(slash);
+    i += 3;
+    copied = i;
+  }
+  if (decoded_path.empty()) {
+    return UnescapeSlashesResult::NotFound;
+  }
+  absl::StrAppend(&decoded_path, path.substr(copied), query);
+  headers.setPath(decoded_path);
+  return UnescapeSlashesResult::FoundAndUnescaped;
 }
 
 absl::string_view PathUtil::removeQueryAndFragment(const absl::string_view path) {
@@ -15,6 +15,7 @@
 #include "source/common/common/empty_string.h"
 #include "source/common/common/enum_to_int.h"
 #include "source/common/common/fmt.h"
+#include "source/common/common/macros.h"
 #include "source/common/common/utility.h"
 #include "source/common/grpc/status.h"
 #include "source/common/http/character_set_validation.h"
@@ -490,6 +491,43 @@ Utility::QueryParamsMulti::parseAndDecodeQueryString(absl::string_view url) {
   return Utility::QueryParamsMulti::parseParameters(url, start, /*decode_params=*/true);
 }
 
+namespace {
+
+// The query parameters last parsed on this thread, with the query string they were parsed from.
+struct CachedQueryParams {
+  std::string query_;
+  Utility::QueryParamsMulti params_;
+};
+
+const Utility::QueryParamsMulti& parseCachedQueryString(absl::string_view url,
+                                                        bool decode_params) {
+  const size_t start = url.find('?');
+  if (start == std::string::npos) {
+    CONSTRUCT_ON_FIRST_USE(Utility::QueryParamsMulti);
+  }
+
+  static thread_local CachedQueryParams caches[2];
+  CachedQueryParams& cache = caches[decode_params];
+  const absl::string_view query = url.substr(start + 1);
+  if (cache.query_ != query) {
+    cache.params_ = Utility::QueryParamsMulti::parseParameters(query, 0, decode_params);
+    cache.query_.assign(query.data(), query.size());
+  }
+  return cache.params_;
+}
+
+} // namespace
+
+const Utility::QueryParamsMulti&
+Utility::QueryParamsMulti::parseQueryStringCached(absl::string_view url) {
+  return parseCachedQueryString(url, /*decode_params=*/false);
+}
+
+const Utility::QueryParamsMulti&
+Utility::QueryParamsMulti::parseAndDecodeQueryStringCached(absl::string_view url) {
+  return parseCachedQueryString(url, /*decode_params=*/true);
+}
+
 Utility::QueryParamsMulti Utility::QueryParamsMulti::parseParameters(absl::string_view data,
                                                                      size_t start,
                                                                      bool decode_params) {
@@ -43,6 +43,10 @@ public:
   IoUringResult prepareClose(os_fd_t fd, Request* user_data) override;
   IoUringResult prepareCancel(Request* cancelling_user_data, Request* user_data) override;
   IoUringResult prepareShutdown(os_fd_t fd, int how, Request* user_data) override;
+  IoUringResult prepareRecvMultishot(os_fd_t fd, Request* user_data) override;
+  bool registerProvidedBuffers(uint8_t* buffers, uint32_t num_buffers,
+                               uint32_t buffer_size) override;
+  void recycleProvidedBuffer(uint16_t buffer_id) override;
   IoUringResult submit() override;
   void injectCompletion(os_fd_t fd, Request* user_data, int32_t result) override;
   void removeInjectedCompletion(os_fd_t fd) override;
@@ -52,6 +56,11 @@ private:
   std::vector<struct io_uring_cqe*> cqes_;
   os_fd_t event_fd_{INVALID_SOCKET};
   std::list<InjectedCompletion> injected_completions_;
+  // The provided buffer ring, if registered.
+  struct io_uring_buf_ring* buf_ring_{nullptr};
+  uint8_t* provided_buffers_{nullptr};
+  uint32_t num_provided_buffers_{0};
+  uint32_t provided_buffer_size_{0};
 };
 
 } // namespace Io
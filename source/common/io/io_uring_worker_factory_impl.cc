@@ -9,9 +9,13 @@ IoUringWorkerFactoryImpl::IoUringWorkerFactoryImpl(uint32_t io_uring_size,
                                                    bool use_submission_queue_polling,
                                                    uint32_t read_buffer_size,
                                                    uint32_t write_timeout_ms,
-                                                   ThreadLocal::SlotAllocator& tls)
+                                                   ThreadLocal::SlotAllocator& tls,
+                                                   uint32_t num_provided_buffers,
+                                                   bool batch_submissions)
     : io_uring_size_(io_uring_size), use_submission_queue_polling_(use_submission_queue_polling),
-      read_buffer_size_(read_buffer_size), write_timeout_ms_(write_timeout_ms), tls_(tls) {}
+      read_buffer_size_(read_buffer_size), write_timeout_ms_(write_timeout_ms),
+      num_provided_buffers_(num_provided_buffers), batch_submissions_(batch_submissions),
+      tls_(tls) {}
 
 OptRef<IoUringWorker> IoUringWorkerFactoryImpl::getIoUringWorker() {
   auto ret = tls_.get();
@@ -25,9 +29,11 @@ void IoUringWorkerFactoryImpl::onWorkerThreadInitialized() {
   tls_.set([io_uring_size = io_uring_size_,
             use_submission_queue_polling = use_submission_queue_polling_,
             read_buffer_size = read_buffer_size_,
-            write_timeout_ms = write_timeout_ms_](Event::Dispatcher& dispatcher) {
+            write_timeout_ms = write_timeout_ms_, num_provided_buffers = num_provided_buffers_,
+            batch_submissions = batch_submissions_](Event::Dispatcher& dispatcher) {
     return std::make_shared<IoUringWorkerImpl>(io_uring_size, use_submission_queue_polling,
-                                               read_buffer_size, write_timeout_ms, dispatcher);
+                                               read_buffer_size, write_timeout_ms, dispatcher,
+                                               num_provided_buffers, batch_submissions);
   });
 }
 
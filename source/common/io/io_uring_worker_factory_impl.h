@@ -10,7 +10,8 @@ class IoUringWorkerFactoryImpl : public IoUringWorkerFactory {
 public:
   IoUringWorkerFactoryImpl(uint32_t io_uring_size, bool use_submission_queue_polling,
                            uint32_t read_buffer_size, uint32_t write_timeout_ms,
-                           ThreadLocal::SlotAllocator& tls);
+                           ThreadLocal::SlotAllocator& tls, uint32_t num_provided_buffers = 0,
+                           bool batch_submissions = false);
 
   OptRef<IoUringWorker> getIoUringWorker() override;
 
@@ -22,6 +23,8 @@ private:
   const bool use_submission_queue_polling_;
   const uint32_t read_buffer_size_;
   const uint32_t write_timeout_ms_;
+  const uint32_t num_provided_buffers_;
+  const bool batch_submissions_;
   ThreadLocal::TypedSlot<IoUringWorker> tls_;
 };
 
@@ -10,6 +10,8 @@ ReadRequest::ReadRequest(IoUringSocket& socket, uint32_t size)
   iov_->iov_len = size;
 }
 
+ReadRequest::ReadRequest(IoUringSocket& socket) : Request(RequestType::Read, socket) {}
+
 WriteRequest::WriteRequest(IoUringSocket& socket, const Buffer::RawSliceVector& slices)
     : Request(RequestType::Write, socket), iov_(std::make_unique<struct iovec[]>(slices.size())) {
   for (size_t i = 0; i < slices.size(); i++) {
@@ -60,14 +62,32 @@ void IoUringSocketEntry::onRemoteClose() {
 
 IoUringWorkerImpl::IoUringWorkerImpl(uint32_t io_uring_size, bool use_submission_queue_polling,
                                      uint32_t read_buffer_size, uint32_t write_timeout_ms,
-                                     Event::Dispatcher& dispatcher)
+                                     Event::Dispatcher& dispatcher, uint32_t num_provided_buffers,
+                                     bool batch_submissions)
     : IoUringWorkerImpl(std::make_unique<IoUringImpl>(io_uring_size, use_submission_queue_polling),
-                        read_buffer_size, write_timeout_ms, dispatcher) {}
+                        read_buffer_size, write_timeout_ms, dispatcher, num_provided_buffers,
+                        batch_submissions) {}
 
 IoUringWorkerImpl::IoUringWorkerImpl(IoUringPtr&& io_uring, uint32_t read_buffer_size,
-                                     uint32_t write_timeout_ms, Event::Dispatcher& dispatcher)
+                                     uint32_t write_timeout_ms, Event::Dispatcher& dispatcher,
+                                     uint32_t num_provided_buffers, bool batch_submissions)
     : io_uring_(std::move(io_uring)), read_buffer_size_(read_buffer_size),
       write_timeout_ms_(write_timeout_ms), dispatcher_(dispatcher) {
+  if (num_provided_buffers > 0) {
+    auto provided_buffers =
+        std::make_shared<ProvidedBuffers>(*io_uring_, num_provided_buffers, read_buffer_size_);
+    if (io_uring_->registerProvidedBuffers(provided_buffers->memory_.get(), num_provided_buffers,
+                                           read_buffer_size_)) {
+      provided_buffers_ = std::move(provided_buffers);
+      recv_multishot_enabled_ = true;
+    } else {
+      ENVOY_LOG(warn, "provided buffer rings are not supported, reading with a request per read");
+    }
+  }
+  if (batch_submissions) {
+    submit_cb_ = dispatcher_.createSchedulableCallback([this]() { io_uring_->submit(); });
+  }
+
   const os_fd_t event_fd = io_uring_->registerEventfd();
   // We only care about the read event of Eventfd, since we only receive the
   // event here.
@@ -98,6 +118,11 @@ IoUringWorkerImpl::~IoUringWorkerImpl() {
   }
 
   dispatcher_.clearDeferredDeleteList();
+
+  // The provided buffers still held by read buffers are no longer given back to the ring.
+  if (provided_buffers_ != nullptr) {
+    provided_buffers_->io_uring_ = nullptr;
+  }
 }
 
 IoUringSocket& IoUringWorkerImpl::addServerSocket(os_fd_t fd, Event::FileReadyCb cb,
@@ -144,7 +169,7 @@ IoUringWorkerImpl::submitConnectRequest(IoUringSocket& socket,
   auto res = io_uring_->prepareConnect(socket.fd(), address, req);
   if (res == IoUringResult::Failed) {
     // TODO(rojkov): handle `EBUSY` in case the completion queue is never reaped.
-    submit();
+    flushSubmissions();
     res = io_uring_->prepareConnect(socket.fd(), address, req);
     RELEASE_ASSERT(res == IoUringResult::Ok, "unable to prepare connect");
   }
@@ -160,7 +185,7 @@ Request* IoUringWorkerImpl::submitReadRequest(IoUringSocket& socket) {
   auto res = io_uring_->prepareReadv(socket.fd(), req->iov_.get(), 1, 0, req);
   if (res == IoUringResult::Failed) {
     // TODO(rojkov): handle `EBUSY` in case the completion queue is never reaped.
-    submit();
+    flushSubmissions();
     res = io_uring_->prepareReadv(socket.fd(), req->iov_.get(), 1, 0, req);
     RELEASE_ASSERT(res == IoUringResult::Ok, "unable to prepare readv");
   }
@@ -168,6 +193,41 @@ Request* IoUringWorkerImpl::submitReadRequest(IoUringSocket& socket) {
   return req;
 }
 
+Request* IoUringWorkerImpl::submitRecvMultishotRequest(IoUringSocket& socket) {
+  if (!recv_multishot_enabled_) {
+    return nullptr;
+  }
+
+  ReadRequest* req = new ReadRequest(socket);
+
+  ENVOY_LOG(trace, "submit multishot recv request, fd = {}, read req = {}", socket.fd(),
+            fmt::ptr(req));
+
+  auto res = io_uring_->prepareRecvMultishot(socket.fd(), req);
+  if (res == IoUringResult::Failed) {
+    // TODO(rojkov): handle `EBUSY` in case the completion queue is never reaped.
+    flushSubmissions();
+    res = io_uring_->prepareRecvMultishot(socket.fd(), req);
+    RELEASE_ASSERT(res == IoUringResult::Ok, "unable to prepare multishot recv");
+  }
+  submit();
+  return req;
+}
+
+Buffer::BufferFragment* IoUringWorkerImpl::createProvidedBufferFragment(uint16_t buffer_id,
+                                                                        size_t data_length) {
+  ASSERT(provided_buffers_ != nullptr);
+  return new Buffer::BufferFragmentImpl(
+      provided_buffers_->buffer(buffer_id), data_length,
+      [provided_buffers = provided_buffers_, buffer_id](
+          const void*, size_t, const Buffer::BufferFragmentImpl* this_fragment) {
+        if (provided_buffers->io_uring_ != nullptr) {
+          provided_buffers->io_uring_->recycleProvidedBuffer(buffer_id);
+        }
+        delete this_fragment;
+      });
+}
+
 Request* IoUringWorkerImpl::submitWriteRequest(IoUringSocket& socket,
                                                const Buffer::RawSliceVector& slices) {
   WriteRequest* req = new WriteRequest(socket, slices);
@@ -177,7 +237,7 @@ Request* IoUringWorkerImpl::submitWriteRequest(IoUringSocket& socket,
   auto res = io_uring_->prepareWritev(socket.fd(), req->iov_.get(), slices.size(), 0, req);
   if (res == IoUringResult::Failed) {
     // TODO(rojkov): handle `EBUSY` in case the completion queue is never reaped.
-    submit();
+    flushSubmissions();
     res = io_uring_->prepareWritev(socket.fd(), req->iov_.get(), slices.size(), 0, req);
     RELEASE_ASSERT(res == IoUringResult::Ok, "unable to prepare writev");
   }
@@ -193,7 +253,7 @@ Request* IoUringWorkerImpl::submitCloseRequest(IoUringSocket& socket) {
   auto res = io_uring_->prepareClose(socket.fd(), req);
   if (res == IoUringResult::Failed) {
     // TODO(rojkov): handle `EBUSY` in case the completion queue is never reaped.
-    submit();
+    flushSubmissions();
     res = io_uring_->prepareClose(socket.fd(), req);
     RELEASE_ASSERT(res == IoUringResult::Ok, "unable to prepare close");
   }
@@ -210,7 +270,7 @@ Request* IoUringWorkerImpl::submitCancelRequest(IoUringSocket& socket, Request*
   auto res = io_uring_->prepareCancel(request_to_cancel, req);
   if (res == IoUringResult::Failed) {
     // TODO(rojkov): handle `EBUSY` in case the completion queue is never reaped.
-    submit();
+    flushSubmissions();
     res = io_uring_->prepareCancel(request_to_cancel, req);
     RELEASE_ASSERT(res == IoUringResult::Ok, "unable to prepare cancel");
   }
@@ -227,7 +287,7 @@ Request* IoUringWorkerImpl::submitShutdownRequest(IoUringSocket& socket, int how
   auto res = io_uring_->prepareShutdown(socket.fd(), how, req);
   if (res == IoUringResult::Failed) {
     // TODO(rojkov): handle `EBUSY` in case the completion queue is never reaped.
-    submit();
+    flushSubmissions();
     res = io_uring_->prepareShutdown(socket.fd(), how, req);
     RELEASE_ASSERT(res == IoUringResult::Ok, "unable to prepare cancel");
   }
@@ -251,7 +311,7 @@ void IoUringWorkerImpl::injectCompletion(IoUringSocket& socket, Request::Request
 void IoUringWorkerImpl::onFileEvent() {
   ENVOY_LOG(trace, "io uring worker, on file event");
   delay_submit_ = true;
-  io_uring_->forEveryCompletion([](Request* req, int32_t result, bool injected) {
+  io_uring_->forEveryCompletion([](Request* req, int32_t result, uint32_t flags, bool injected) {
     ENVOY_LOG(trace, "receive request completion, type = {}, req = {}",
               static_cast<uint8_t>(req->type()), fmt::ptr(req));
     ASSERT(req != nullptr);
@@ -270,6 +330,13 @@ void IoUringWorkerImpl::onFileEvent() {
     case Request::RequestType::Read:
       ENVOY_LOG(trace, "receive Read request completion, fd = {}, req = {}", req->socket().fd(),
                 fmt::ptr(req));
+      if (!injected && static_cast<ReadRequest*>(req)->multishot()) {
+        ReadRequest* read_req = static_cast<ReadRequest*>(req);
+        read_req->buffer_id_ = (flags & IORING_CQE_F_BUFFER)
+                                   ? absl::make_optional<uint16_t>(flags >> IORING_CQE_BUFFER_SHIFT)
+                                   : absl::nullopt;
+        read_req->more_ = (flags & IORING_CQE_F_MORE) != 0;
+      }
       req->socket().onRead(req, result, injected);
       break;
     case Request::RequestType::Write:
@@ -294,18 +361,28 @@ void IoUringWorkerImpl::onFileEvent() {
       break;
     }
 
-    delete req;
+    // A multishot request is only done with its last completion.
+    if (injected || !(flags & IORING_CQE_F_MORE)) {
+      delete req;
+    }
   });
   delay_submit_ = false;
-  submit();
+  flushSubmissions();
 }
 
 void IoUringWorkerImpl::submit() {
-  if (!delay_submit_) {
-    io_uring_->submit();
+  if (delay_submit_) {
+    return;
+  }
+  if (submit_cb_ != nullptr) {
+    submit_cb_->scheduleCallbackCurrentIteration();
+    return;
   }
+  io_uring_->submit();
 }
 
+void IoUringWorkerImpl::flushSubmissions() { io_uring_->submit(); }
+
 IoUringServerSocket::IoUringServerSocket(os_fd_t fd, IoUringWorkerImpl& parent,
                                          Event::FileReadyCb cb, uint32_t write_timeout_ms,
                                          bool enable_close_event)
@@ -430,6 +507,12 @@ void IoUringServerSocket::onCancel(Request* req, int32_t result, bool injected)
 
 void IoUringServerSocket::moveReadDataToBuffer(Request* req, size_t data_length) {
   ReadRequest* read_req = static_cast<ReadRequest*>(req);
+  if (read_req->multishot()) {
+    ASSERT(read_req->buffer_id_.has_value());
+    read_buf_.addBufferFragment(
+        *parent_.createProvidedBufferFragment(read_req->buffer_id_.value(), data_length));
+    return;
+  }
   Buffer::BufferFragment* fragment = new Buffer::BufferFragmentImpl(
       read_req->buf_.release(), data_length,
       [](const void* data, size_t, const Buffer::BufferFragmentImpl* this_fragment) {
@@ -439,6 +522,13 @@ void IoUringServerSocket::moveReadDataToBuffer(Request* req, size_t data_length)
   read_buf_.addBufferFragment(*fragment);
 }
 
+void IoUringServerSocket::discardReadData(Request* req) {
+  ReadRequest* read_req = static_cast<ReadRequest*>(req);
+  if (read_req->multishot() && read_req->buffer_id_.has_value()) {
+    parent_.recycleProvidedBuffer(read_req->buffer_id_.value());
+  }
+}
+
 void IoUringServerSocket::onReadCompleted(int32_t result) {
   ENVOY_LOG(trace, "read from socket, fd = {}, result = {}", fd_, result);
   ReadParam param{read_buf_, result};
@@ -456,13 +546,19 @@ void IoUringServerSocket::onRead(Request* req, int32_t result, bool injected) {
   ENVOY_LOG(trace,
             "onRead with result {}, fd = {}, injected = {}, status_ = {}, enable_close_event = {}",
             result, fd_, injected, status_, enable_close_event_);
+  ReadRequest* read_req = injected ? nullptr : static_cast<ReadRequest*>(req);
   if (!injected) {
-    read_req_ = nullptr;
+    // A multishot recv request stays in flight until its last completion.
+    if (read_req == nullptr || !read_req->multishot() || !read_req->more_) {
+      read_req_ = nullptr;
+    }
     // If the socket is going to close, discard all results.
-    if (status_ == Closed && write_or_shutdown_req_ == nullptr && read_cancel_req_ == nullptr &&
-        write_or_shutdown_cancel_req_ == nullptr) {
+    if (status_ == Closed && read_req_ == nullptr && write_or_shutdown_req_ == nullptr &&
+        read_cancel_req_ == nullptr && write_or_shutdown_cancel_req_ == nullptr) {
       if (result > 0 && keep_fd_open_) {
         moveReadDataToBuffer(req, result);
+      } else if (result > 0) {
+        discardReadData(req);
       }
       closeInternal();
       return;
@@ -472,6 +568,15 @@ void IoUringServerSocket::onRead(Request* req, int32_t result, bool injected) {
   // Move read data from request to buffer or store the error.
   if (result > 0) {
     moveReadDataToBuffer(req, result);
+  } else if (read_req != nullptr && read_req->multishot() &&
+             (result == -ENOBUFS || result == -EINVAL)) {
+    // Either the provided buffers ran out, which ends the multishot recv request, or the kernel
+    // does not support multishot recv. The next read request reads into a buffer of its own.
+    ENVOY_LOG(trace, "multishot recv ended with result {}, fd = {}", result, fd_);
+    if (result == -EINVAL) {
+      parent_.disableRecvMultishot();
+    }
+    next_read_without_provided_buffer_ = true;
   } else {
     if (result != -ECANCELED) {
       read_error_ = result;
@@ -610,7 +715,14 @@ void IoUringServerSocket::onShutdown(Request* req, int32_t result, bool injected
 void IoUringServerSocket::closeInternal() {
   if (keep_fd_open_) {
     if (on_closed_cb_) {
-      on_closed_cb_(read_buf_);
+      // The read buffer is handed to another worker, which must not release the provided buffers
+      // of this one, so their data is copied out.
+      Buffer::OwnedImpl read_buf;
+      for (const Buffer::RawSlice& slice : read_buf_.getRawSlices()) {
+        read_buf.add(slice.mem_, slice.len_);
+      }
+      read_buf_.drain(read_buf_.length());
+      on_closed_cb_(read_buf);
     }
     cleanup();
     return;
@@ -622,7 +734,13 @@ void IoUringServerSocket::closeInternal() {
 
 void IoUringServerSocket::submitReadRequest() {
   if (!read_req_) {
-    read_req_ = parent_.submitReadRequest(*this);
+    if (!next_read_without_provided_buffer_) {
+      read_req_ = parent_.submitRecvMultishotRequest(*this);
+    }
+    next_read_without_provided_buffer_ = false;
+    if (!read_req_) {
+      read_req_ = parent_.submitReadRequest(*this);
+    }
   }
 }
 
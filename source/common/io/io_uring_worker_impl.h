@@ -1,6 +1,7 @@
 #pragma once
 
 #include "envoy/common/io/io_uring.h"
+#include "envoy/event/schedulable_cb.h"
 
 #include "source/common/buffer/buffer_impl.h"
 #include "source/common/common/linked_object.h"
@@ -13,9 +14,17 @@ namespace Io {
 class ReadRequest : public Request {
 public:
   ReadRequest(IoUringSocket& socket, uint32_t size);
+  // Creates a multishot recv request, which reads into the provided buffers of the worker.
+  explicit ReadRequest(IoUringSocket& socket);
+
+  bool multishot() const { return buf_ == nullptr; }
 
   std::unique_ptr<uint8_t[]> buf_;
   std::unique_ptr<struct iovec> iov_;
+  // For multishot recv requests, these are updated by the worker for every completion: the id of
+  // the provided buffer holding the read data if any, and whether more completions follow.
+  absl::optional<uint16_t> buffer_id_;
+  bool more_{false};
 };
 
 class WriteRequest : public Request {
@@ -28,13 +37,46 @@ public:
 class IoUringSocketEntry;
 using IoUringSocketEntryPtr = std::unique_ptr<IoUringSocketEntry>;
 
+/**
+ * The memory of the provided buffers of a worker, which the kernel fills on multishot recv. The
+ * buffers holding read data are owned by read buffers as fragments until they are released and
+ * given back to the ring. They may be released after the worker is destroyed, so the memory lives
+ * until the last of them is released.
+ */
+struct ProvidedBuffers {
+  ProvidedBuffers(IoUring& io_uring, uint32_t num_buffers, uint32_t buffer_size)
+      : memory_(std::make_unique<uint8_t[]>(static_cast<size_t>(num_buffers) * buffer_size)),
+        buffer_size_(buffer_size), io_uring_(&io_uring) {}
+
+  uint8_t* buffer(uint16_t buffer_id) const {
+    return memory_.get() + static_cast<size_t>(buffer_id) * buffer_size_;
+  }
+
+  const std::unique_ptr<uint8_t[]> memory_;
+  const uint32_t buffer_size_;
+  // The io_uring the buffers are given back to, reset once the worker is destroyed.
+  IoUring* io_uring_;
+};
+
+using ProvidedBuffersSharedPtr = std::shared_ptr<ProvidedBuffers>;
+
 class IoUringWorkerImpl : public IoUringWorker, private Logger::Loggable<Logger::Id::io> {
 public:
+  /**
+   * @param num_provided_buffers is the number of buffers of read_buffer_size bytes in the
+   * provided buffer ring of the worker. When it is not 0, sockets read with multishot recv
+   * requests into buffers of the ring instead of submitting a read request with a buffer of their
+   * own for every read. It must be a power of 2 up to 32768.
+   * @param batch_submissions indicates whether the requests prepared out of completion handling
+   * are submitted once at the end of the current dispatcher loop iteration instead of right away.
+   */
   IoUringWorkerImpl(uint32_t io_uring_size, bool use_submission_queue_polling,
                     uint32_t read_buffer_size, uint32_t write_timeout_ms,
-                    Event::Dispatcher& dispatcher);
+                    Event::Dispatcher& dispatcher, uint32_t num_provided_buffers = 0,
+                    bool batch_submissions = false);
   IoUringWorkerImpl(IoUringPtr&& io_uring, uint32_t read_buffer_size, uint32_t write_timeout_ms,
-                    Event::Dispatcher& dispatcher);
+                    Event::Dispatcher& dispatcher, uint32_t num_provided_buffers = 0,
+                    bool batch_submissions = false);
   ~IoUringWorkerImpl() override;
 
   // IoUringWorker
@@ -58,6 +100,20 @@ public:
   // Remove a socket from this worker.
   IoUringSocketEntryPtr removeSocket(IoUringSocketEntry& socket);
 
+  // Submit a multishot recv request reading into the provided buffers, returns nullptr if the
+  // worker has no provided buffers.
+  Request* submitRecvMultishotRequest(IoUringSocket& socket);
+
+  // Stop using multishot recv requests, which the kernel does not support.
+  void disableRecvMultishot() { recv_multishot_enabled_ = false; }
+
+  // Wrap a provided buffer holding read data into a fragment, which gives the buffer back to the
+  // provided buffer ring once released.
+  Buffer::BufferFragment* createProvidedBufferFragment(uint16_t buffer_id, size_t data_length);
+
+  // Give a provided buffer back to the provided buffer ring.
+  void recycleProvidedBuffer(uint16_t buffer_id) { io_uring_->recycleProvidedBuffer(buffer_id); }
+
   // Inject a request completion into the iouring instance for a specific socket.
   void injectCompletion(IoUringSocket& socket, Request::RequestType type, int32_t result);
 
@@ -69,6 +125,8 @@ protected:
   IoUringSocketEntry& addSocket(IoUringSocketEntryPtr&& socket);
   void onFileEvent();
   void submit();
+  // Submit the prepared requests right away, for when the submission queue is full.
+  void flushSubmissions();
 
   // The iouring instance.
   IoUringPtr io_uring_;
@@ -84,6 +142,12 @@ protected:
   // The IoUringWorker will delay the submit the requests which are submitted in request completion
   // callback.
   bool delay_submit_{false};
+  // The provided buffers for multishot recv requests, if any.
+  ProvidedBuffersSharedPtr provided_buffers_;
+  bool recv_multishot_enabled_{false};
+  // Submits the requests prepared during the current dispatcher loop iteration, if submissions
+  // are batched.
+  Event::SchedulableCallbackPtr submit_cb_;
 };
 
 class IoUringSocketEntry : public IoUringSocket,
@@ -242,11 +306,15 @@ protected:
   Request* write_or_shutdown_cancel_req_{nullptr};
   // This is used for tracking the close request.
   Request* close_req_{nullptr};
+  // Whether the next read request reads into a buffer of its own instead of a provided buffer,
+  // since the provided buffers ran out.
+  bool next_read_without_provided_buffer_{false};
 
   void closeInternal();
   void submitReadRequest();
   void submitWriteOrShutdownRequest();
   void moveReadDataToBuffer(Request* req, size_t data_length);
+  void discardReadData(Request* req);
   void onReadCompleted(int32_t result);
   void onWriteCompleted(int32_t result);
 };
@@ -22,6 +22,22 @@
 
 namespace Envoy {
 namespace Json {
+
+KeySelection::KeySelection(const std::vector<std::vector<std::string>>& key_paths) {
+  for (const auto& key_path : key_paths) {
+    Node* node = &root_;
+    for (const std::string& key : key_path) {
+      std::unique_ptr<Node>& child = node->children_[key];
+      if (child == nullptr) {
+        child = std::make_unique<Node>();
+      }
+      node = child.get();
+    }
+    // The value is loaded as a whole, including the values of any longer paths through it.
+    node->leaf_ = true;
+  }
+}
+
 namespace Nlohmann {
 
 namespace {
@@ -178,16 +194,21 @@ private:
  */
 class ObjectHandler : public nlohmann::json_sax<nlohmann::json> {
 public:
-  ObjectHandler() = default;
+  // With a selection, only the selected values are built.
+  explicit ObjectHandler(const KeySelection* selection = nullptr)
+      : selection_(selection != nullptr && !selection->root().leaf_ ? &selection->root()
+                                                                    : nullptr) {}
 
   bool start_object(std::size_t) override;
   bool end_object() override;
   bool key(std::string& val) override;
   bool start_array(std::size_t) override;
   bool end_array() override;
-  bool boolean(bool value) override { return handleValueEvent(Field::createValue(value)); }
+  bool boolean(bool value) override {
+    return skipped(false) || handleValueEvent(Field::createValue(value));
+  }
   bool number_integer(int64_t value) override {
-    return handleValueEvent(Field::createValue(static_cast<int64_t>(value)));
+    return skipped(false) || handleValueEvent(Field::createValue(static_cast<int64_t>(value)));
   }
   bool number_unsigned(uint64_t value) override {
     if (value > static_cast<uint64_t>(std::numeric_limits<int64_t>::max())) {
@@ -195,13 +216,15 @@ public:
           Exception, fmt::format("JSON value from line {} is larger than int64_t (not supported)",
                                  line_number_));
     }
-    return handleValueEvent(Field::createValue(static_cast<int64_t>(value)));
+    return skipped(false) || handleValueEvent(Field::createValue(static_cast<int64_t>(value)));
   }
   bool number_float(double value, const std::string&) override {
-    return handleValueEvent(Field::createValue(value));
+    return skipped(false) || handleValueEvent(Field::createValue(value));
+  }
+  bool null() override { return skipped(false) || handleValueEvent(Field::createNull()); }
+  bool string(std::string& value) override {
+    return skipped(false) || handleValueEvent(Field::createValue(value));
   }
-  bool null() override { return handleValueEvent(Field::createNull()); }
-  bool string(std::string& value) override { return handleValueEvent(Field::createValue(value)); }
   bool binary(binary_t&) override { return false; }
   bool parse_error(std::size_t at, const std::string& token,
                    const nlohmann::detail::exception& ex) override {
@@ -247,6 +270,9 @@ public:
 
 private:
   bool handleValueEvent(FieldSharedPtr ptr);
+  // Returns whether the value starting with the event is left out of the selection. Only the
+  // objects lead further down the selected paths.
+  bool skipped(bool is_object);
 
   enum class State {
     ExpectRoot,
@@ -260,6 +286,16 @@ private:
   std::stack<FieldSharedPtr> stack_;
   std::string key_;
 
+  // The selected keys of each object of the stack, or nullptr for the objects which are loaded as
+  // a whole.
+  const KeySelection::Node* const selection_;
+  std::stack<const KeySelection::Node*> selection_stack_;
+  // The selected keys of the value of key_, and whether that value is left out instead.
+  const KeySelection::Node* key_selection_{};
+  bool skip_key_{};
+  // The depth of the containers of the left out value which is being parsed.
+  uint64_t skip_depth_{};
+
   FieldSharedPtr root_;
 
   std::string error_;
@@ -607,7 +643,24 @@ void Field::validateSchema(const std::string&) const {
   throwExceptionOrPanic(Exception, "not implemented");
 }
 
+bool ObjectHandler::skipped(bool is_object) {
+  if (skip_depth_ > 0) {
+    return true;
+  }
+  if (state_ != State::ExpectValueOrStartObjectArray ||
+      (!skip_key_ && (key_selection_ == nullptr || is_object))) {
+    return false;
+  }
+  skip_key_ = false;
+  state_ = State::ExpectKeyOrEndObject;
+  return true;
+}
+
 bool ObjectHandler::start_object(std::size_t) {
+  if (skipped(true)) {
+    ++skip_depth_;
+    return true;
+  }
   FieldSharedPtr object = Field::createObject();
   object->setLineNumberStart(line_number_);
 
@@ -615,16 +668,19 @@ bool ObjectHandler::start_object(std::size_t) {
   case State::ExpectValueOrStartObjectArray:
     stack_.top()->insert(key_, object);
     stack_.push(object);
+    selection_stack_.push(key_selection_);
     state_ = State::ExpectKeyOrEndObject;
     return true;
   case State::ExpectArrayValueOrEndArray:
     stack_.top()->append(object);
     stack_.push(object);
+    selection_stack_.push(nullptr);
     state_ = State::ExpectKeyOrEndObject;
     return true;
   case State::ExpectRoot:
     root_ = object;
     stack_.push(object);
+    selection_stack_.push(selection_);
     state_ = State::ExpectKeyOrEndObject;
     return true;
   case State::ExpectKeyOrEndObject:
@@ -636,9 +692,14 @@ bool ObjectHandler::start_object(std::size_t) {
 }
 
 bool ObjectHandler::end_object() {
+  if (skip_depth_ > 0) {
+    --skip_depth_;
+    return true;
+  }
   if (state_ == State::ExpectKeyOrEndObject) {
     stack_.top()->setLineNumberEnd(line_number_);
     stack_.pop();
+    selection_stack_.pop();
 
     if (stack_.empty()) {
       state_ = State::ExpectFinished;
@@ -653,7 +714,20 @@ bool ObjectHandler::end_object() {
 }
 
 bool ObjectHandler::key(std::string& val) {
+  if (skip_depth_ > 0) {
+    return true;
+  }
   if (state_ == State::ExpectKeyOrEndObject) {
+    const KeySelection::Node* selection = selection_stack_.top();
+    if (selection == nullptr) {
+      key_selection_ = nullptr;
+    } else if (const auto it = selection->children_.find(val); it != selection->children_.end()) {
+      key_selection_ = it->second->leaf_ ? nullptr : it->second.get();
+    } else {
+      skip_key_ = true;
+      state_ = State::ExpectValueOrStartObjectArray;
+      return true;
+    }
     key_ = val;
     state_ = State::ExpectValueOrStartObjectArray;
     return true;
@@ -662,6 +736,10 @@ bool ObjectHandler::key(std::string& val) {
 }
 
 bool ObjectHandler::start_array(std::size_t) {
+  if (skipped(false)) {
+    ++skip_depth_;
+    return true;
+  }
   FieldSharedPtr array = Field::createArray();
   array->setLineNumberStart(line_number_);
 
@@ -677,6 +755,12 @@ bool ObjectHandler::start_array(std::size_t) {
     return true;
   case State::ExpectRoot:
     root_ = array;
+    if (selection_ != nullptr) {
+      // The elements of the array can't be on the selected paths.
+      state_ = State::ExpectFinished;
+      ++skip_depth_;
+      return true;
+    }
     stack_.push(array);
     state_ = State::ExpectArrayValueOrEndArray;
     return true;
@@ -686,6 +770,10 @@ bool ObjectHandler::start_array(std::size_t) {
 }
 
 bool ObjectHandler::end_array() {
+  if (skip_depth_ > 0) {
+    --skip_depth_;
+    return true;
+  }
   switch (state_) {
   case State::ExpectArrayValueOrEndArray:
     stack_.top()->setLineNumberEnd(line_number_);
@@ -721,10 +809,7 @@ bool ObjectHandler::handleValueEvent(FieldSharedPtr ptr) {
   }
 }
 
-} // namespace
-
-absl::StatusOr<ObjectSharedPtr> Factory::loadFromStringNoThrow(const std::string& json) {
-  ObjectHandler handler;
+absl::StatusOr<ObjectSharedPtr> loadWithHandler(const std::string& json, ObjectHandler& handler) {
   auto json_container = JsonContainer(json.c_str(), &handler);
 
   nlohmann::json::sax_parse(json_container, &handler);
@@ -736,6 +821,19 @@ absl::StatusOr<ObjectSharedPtr> Factory::loadFromStringNoThrow(const std::string
   return handler.getRoot();
 }
 
+} // namespace
+
+absl::StatusOr<ObjectSharedPtr> Factory::loadFromStringNoThrow(const std::string& json) {
+  ObjectHandler handler;
+  return loadWithHandler(json, handler);
+}
+
+absl::StatusOr<ObjectSharedPtr>
+Factory::loadSelectedFromStringNoThrow(const std::string& json, const KeySelection& selection) {
+  ObjectHandler handler(&selection);
+  return loadWithHandler(json, handler);
+}
+
 ObjectSharedPtr Factory::loadFromString(const std::string& json) {
   auto result = loadFromStringNoThrow(json);
   if (!result.ok()) {
@@ -1,16 +1,45 @@
 #pragma once
 
 #include <list>
+#include <memory>
 #include <string>
+#include <vector>
 
 #include "envoy/json/json_object.h"
 
 #include "source/common/protobuf/protobuf.h"
 
+#include "absl/container/flat_hash_map.h"
 #include "absl/strings/string_view.h"
 
 namespace Envoy {
 namespace Json {
+
+/**
+ * The key paths of the values to load from a document, for the users which only look up a few
+ * values of the documents they parse. Built once, and shared by the documents it loads.
+ */
+class KeySelection {
+public:
+  /**
+   * @param key_paths supplies the paths of keys from the root of the documents to the values to
+   *        load. The objects on the paths are loaded with the selected keys only, and the values
+   *        at the end of the paths are loaded as a whole.
+   */
+  explicit KeySelection(const std::vector<std::vector<std::string>>& key_paths);
+
+  struct Node {
+    absl::flat_hash_map<std::string, std::unique_ptr<Node>> children_;
+    // Whether the whole value is loaded, with all of its children.
+    bool leaf_{};
+  };
+
+  const Node& root() const { return root_; }
+
+private:
+  Node root_;
+};
+
 namespace Nlohmann {
 
 class Factory {
@@ -26,6 +55,12 @@ public:
    */
   static absl::StatusOr<ObjectSharedPtr> loadFromStringNoThrow(const std::string& json);
 
+  /**
+   * Constructs a Json Object from a string, with the selected values only.
+   */
+  static absl::StatusOr<ObjectSharedPtr>
+  loadSelectedFromStringNoThrow(const std::string& json, const KeySelection& selection);
+
   /**
    * Constructs a Json Object from a Protobuf struct.
    */
@@ -14,6 +14,11 @@ absl::StatusOr<ObjectSharedPtr> Factory::loadFromStringNoThrow(const std::string
   return Nlohmann::Factory::loadFromStringNoThrow(json);
 }
 
+absl::StatusOr<ObjectSharedPtr>
+Factory::loadSelectedFromStringNoThrow(const std::string& json, const KeySelection& selection) {
+  return Nlohmann::Factory::loadSelectedFromStringNoThrow(json, selection);
+}
+
 ObjectSharedPtr Factory::loadFromProtobufStruct(const ProtobufWkt::Struct& protobuf_struct) {
   return Nlohmann::Factory::loadFromProtobufStruct(protobuf_struct);
 }
@@ -5,6 +5,7 @@
 #include "envoy/json/json_object.h"
 
 #include "source/common/common/statusor.h"
+#include "source/common/json/json_internal.h"
 #include "source/common/protobuf/protobuf.h"
 
 namespace Envoy {
@@ -23,6 +24,16 @@ public:
    */
   static absl::StatusOr<ObjectSharedPtr> loadFromStringNoThrow(const std::string& json);
 
+  /**
+   * Constructs a Json Object from a string, with the values at the key paths of the selection only.
+   * The whole string is still parsed, and the same strings are rejected as by
+   * loadFromStringNoThrow(), but the other values aren't built into objects, which saves most of
+   * the work of loading large documents of which only a few values are needed. The values on the
+   * paths which aren't objects are left out, as they can't hold the values at the end of the paths.
+   */
+  static absl::StatusOr<ObjectSharedPtr>
+  loadSelectedFromStringNoThrow(const std::string& json, const KeySelection& selection);
+
   /**
    * Constructs a Json Object from a Protobuf struct.
    */
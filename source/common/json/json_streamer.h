@@ -192,10 +192,9 @@ public:
    */
   ArrayPtr makeRootArray();
 
-private:
-  friend Level;
-  friend Map;
-  friend Array;
+  // The methods below stream out JSON fragments without the map and array
+  // bookkeeping, for callers which compile the structure of their output
+  // ahead of time and are responsible for its punctuation.
 
   /**
    * Takes a raw string, sanitizes it using JSON syntax, surrounds it
@@ -211,17 +210,22 @@ private:
   void addNumber(int64_t i);
   void addBool(bool b);
 
-  /**
-   * Flushes out any pending fragments.
-   */
-  void flush();
-
   /**
    * Adds a constant string to the output stream. The string must outlive the
    * Streamer object, and is intended for literal strings such as punctuation.
    */
   void addConstantString(absl::string_view str) { response_.addFragments({str}); }
 
+private:
+  friend Level;
+  friend Map;
+  friend Array;
+
+  /**
+   * Flushes out any pending fragments.
+   */
+  void flush();
+
 #ifndef NDEBUG
   /**
    * @return the top Level*. This is used for asserts.
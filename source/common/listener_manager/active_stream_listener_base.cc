@@ -2,6 +2,7 @@
 
 #include "envoy/network/filter.h"
 
+#include "source/common/runtime/runtime_features.h"
 #include "source/common/stats/timespan_impl.h"
 
 namespace Envoy {
@@ -64,6 +65,10 @@ void ActiveStreamListenerBase::newConnection(Network::ConnectionSocketPtr&& sock
         timeout, stats_.downstream_cx_transport_socket_connect_timeout_);
   }
   server_conn_ptr->setBufferLimits(config_->perConnectionBufferLimitBytes());
+  if (config_->coalesceWrites() &&
+      Runtime::runtimeFeatureEnabled("envoy.reloadable_features.coalesce_listener_writes")) {
+    server_conn_ptr->enableWriteCoalescing();
+  }
   RELEASE_ASSERT(server_conn_ptr->connectionInfoProvider().remoteAddress() != nullptr, "");
   const bool empty_filter_chain = !config_->filterChainFactory().createNetworkFilterChain(
       *server_conn_ptr, filter_chain->networkFilterFactories());
@@ -17,12 +17,14 @@
 #include "source/common/access_log/access_log_impl.h"
 #include "source/common/api/os_sys_calls_impl.h"
 #include "source/common/common/assert.h"
+#include "source/common/common/cpu_topology.h"
 #include "source/common/config/utility.h"
 #include "source/common/listener_manager/active_raw_udp_listener_config.h"
 #include "source/common/listener_manager/filter_chain_manager_impl.h"
 #include "source/common/listener_manager/listener_manager_impl.h"
 #include "source/common/network/connection_balancer_impl.h"
 #include "source/common/network/resolver_impl.h"
+#include "source/common/network/reuse_port_cpu_steering_option_impl.h"
 #include "source/common/network/socket_option_factory.h"
 #include "source/common/network/socket_option_impl.h"
 #include "source/common/network/udp_listener_impl.h"
@@ -34,6 +36,9 @@
 #include "source/server/drain_manager_impl.h"
 #include "source/server/transport_socket_config_impl.h"
 
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+
 #ifdef ENVOY_ENABLE_QUIC
 #include "source/common/quic/active_quic_listener.h"
 #include "source/common/quic/udp_gso_batch_writer.h"
@@ -70,6 +75,11 @@ bool shouldBindToPort(const envoy::config::listener::v3::Listener& config) {
   return PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, bind_to_port, true) &&
          PROTOBUF_GET_WRAPPED_OR_DEFAULT(config.deprecated_v1(), bind_to_port, true);
 }
+
+bool usesCpuBalance(const envoy::config::listener::v3::Listener& config) {
+  return config.has_connection_balance_config() &&
+         config.connection_balance_config().has_cpu_balance();
+}
 } // namespace
 
 ListenSocketFactoryImpl::ListenSocketFactoryImpl(
@@ -266,6 +276,7 @@ ListenerImpl::ListenerImpl(const envoy::config::listener::v3::Listener& config,
           added_via_api_ ? parent_.server_.messageValidationContext().dynamicValidationVisitor()
                          : parent_.server_.messageValidationContext().staticValidationVisitor()),
       ignore_global_conn_limit_(config.ignore_global_conn_limit()),
+      coalesce_writes_(!config.disable_write_coalescing()),
       bypass_overload_manager_(config.bypass_overload_manager()),
       listener_init_target_(fmt::format("Listener-init-target {}", name),
                             [this]() { dynamic_init_manager_->initialize(local_init_watcher_); }),
@@ -401,6 +412,7 @@ ListenerImpl::ListenerImpl(ListenerImpl& origin,
           added_via_api_ ? parent_.server_.messageValidationContext().dynamicValidationVisitor()
                          : parent_.server_.messageValidationContext().staticValidationVisitor()),
       ignore_global_conn_limit_(config.ignore_global_conn_limit()),
+      coalesce_writes_(!config.disable_write_coalescing()),
       bypass_overload_manager_(config.bypass_overload_manager()),
       // listener_init_target_ is not used during in place update because we expect server started.
       listener_init_target_("", nullptr),
@@ -495,7 +507,7 @@ void ListenerImpl::buildInternalListener(const envoy::config::listener::v3::List
     }
     if ((config.has_connection_balance_config() &&
          config.connection_balance_config().has_exact_balance()) ||
-        config.enable_mptcp() ||
+        usesCpuBalance(config) || config.enable_mptcp() ||
         config.has_enable_reuse_port() // internal listener doesn't use physical l4 port.
         || (config.has_freebind() && config.freebind().value()) || config.has_tcp_backlog_size() ||
         config.has_tcp_fast_open_queue_length() ||
@@ -614,6 +626,24 @@ void ListenerImpl::buildListenSocketOptions(
         address_opts_list) {
   listen_socket_options_list_.insert(listen_socket_options_list_.begin(), addresses_.size(),
                                      nullptr);
+  // The kernel steers the connections of CPU balanced listeners to the socket of the worker
+  // running on the CPU that received them, which requires a socket per worker.
+  Network::Socket::OptionsSharedPtr cpu_steering_options;
+#if defined(SO_ATTACH_REUSEPORT_CBPF) && defined(__linux__)
+  const uint32_t concurrency = parent_.server_.options().concurrency();
+  if (reuse_port_ && socket_type_ == Network::Socket::Type::Stream && concurrency > 1 &&
+      usesCpuBalance(config)) {
+    const CpuTopology topology = CpuTopology::discover(parent_.server_.api().fileSystem());
+    if (!topology.cpus().empty()) {
+      std::vector<uint32_t> worker_cpus;
+      for (uint32_t index = 0; index < concurrency; ++index) {
+        worker_cpus.push_back(topology.workerCpu(index).value());
+      }
+      cpu_steering_options = std::make_shared<Network::Socket::Options>(
+          1, std::make_shared<Network::ReusePortCpuSteeringOptionImpl>(worker_cpus));
+    }
+  }
+#endif
   for (std::vector<std::reference_wrapper<
            const Protobuf::RepeatedPtrField<envoy::config::core::v3::SocketOption>&>>::size_type i =
            0;
@@ -636,6 +666,9 @@ void ListenerImpl::buildListenSocketOptions(
       addListenSocketOptions(listen_socket_options_list_[i],
                              Network::SocketOptionFactory::buildReusePortOptions());
     }
+    if (cpu_steering_options != nullptr) {
+      addListenSocketOptions(listen_socket_options_list_[i], cpu_steering_options);
+    }
     if (!config.socket_options().empty()) {
       addListenSocketOptions(
           listen_socket_options_list_[i],
@@ -769,6 +802,13 @@ void ListenerImpl::buildConnectionBalancer(const envoy::config::listener::v3::Li
                 config.connection_balance_config().extend_balance(), *listener_factory_context_));
         break;
       }
+      case envoy::config::listener::v3::Listener_ConnectionBalanceConfig::kCpuBalance:
+        connection_balancers_.emplace(
+            address.asString(),
+            std::make_shared<Network::CpuConnectionBalancerImpl>(
+                listener_factory_context_->listenerScope(),
+                CpuTopology::discover(parent_.server_.api().fileSystem())));
+        break;
       case envoy::config::listener::v3::Listener_ConnectionBalanceConfig::BALANCE_TYPE_NOT_SET: {
         throw EnvoyException("No valid balance type for connection balance");
       }
@@ -962,7 +1002,13 @@ bool ListenerImpl::supportUpdateFilterChain(const envoy::config::listener::v3::L
     return false;
   }
 
-  if (ListenerMessageUtil::filterChainOnlyChange(config(), new_config)) {
+  // The listener filters, the access logs and the buffer limit of a TCP listener are looked up in
+  // the listener config of the worker for each new connection, so they are updated in place too.
+  if (ListenerMessageUtil::filterChainOnlyChange(config(), new_config) ||
+      (socket_type_ == Network::Socket::Type::Stream &&
+       Runtime::runtimeFeatureEnabled(
+           "envoy.reloadable_features.in_place_update_listener_filters_and_access_logs") &&
+       ListenerMessageUtil::newConnectionsOnlyChange(config(), new_config))) {
     // We need to calculate the reuse port's default value then ensure whether it is changed or not.
     // Since reuse port's default value isn't the YAML bool field default value. When
     // `enable_reuse_port` is specified, `ListenerMessageUtil::filterChainOnlyChange` use the YAML
@@ -1165,26 +1211,50 @@ bool ListenerMessageUtil::socketOptionsEqual(const envoy::config::listener::v3::
   return true;
 }
 
-bool ListenerMessageUtil::filterChainOnlyChange(const envoy::config::listener::v3::Listener& lhs,
-                                                const envoy::config::listener::v3::Listener& rhs) {
+namespace {
+
+constexpr absl::string_view FilterChainFields[] = {"filter_chains", "default_filter_chain",
+                                                   "filter_chain_matcher"};
+constexpr absl::string_view NewConnectionFields[] = {
+    "filter_chains",    "default_filter_chain", "filter_chain_matcher",
+    "listener_filters", "access_log",           "per_connection_buffer_limit_bytes"};
+
+// Returns true if the listeners are the same if ignoring the fields.
+bool equalIgnoringFields(const envoy::config::listener::v3::Listener& lhs,
+                         const envoy::config::listener::v3::Listener& rhs,
+                         absl::Span<const absl::string_view> ignored_fields) {
 #if defined(ENVOY_ENABLE_FULL_PROTOS)
   Protobuf::util::MessageDifferencer differencer;
   differencer.set_message_field_comparison(Protobuf::util::MessageDifferencer::EQUIVALENT);
   differencer.set_repeated_field_comparison(Protobuf::util::MessageDifferencer::AS_SET);
-  differencer.IgnoreField(
-      envoy::config::listener::v3::Listener::GetDescriptor()->FindFieldByName("filter_chains"));
-  differencer.IgnoreField(envoy::config::listener::v3::Listener::GetDescriptor()->FindFieldByName(
-      "default_filter_chain"));
-  differencer.IgnoreField(envoy::config::listener::v3::Listener::GetDescriptor()->FindFieldByName(
-      "filter_chain_matcher"));
+  for (const absl::string_view field : ignored_fields) {
+    const auto* descriptor =
+        envoy::config::listener::v3::Listener::GetDescriptor()->FindFieldByName(std::string(field));
+    ASSERT(descriptor != nullptr);
+    differencer.IgnoreField(descriptor);
+  }
   return differencer.Compare(lhs, rhs);
 #else
   UNREFERENCED_PARAMETER(lhs);
   UNREFERENCED_PARAMETER(rhs);
+  UNREFERENCED_PARAMETER(ignored_fields);
   // Without message reflection, err on the side of reloads.
   return false;
 #endif
 }
 
+} // namespace
+
+bool ListenerMessageUtil::filterChainOnlyChange(const envoy::config::listener::v3::Listener& lhs,
+                                                const envoy::config::listener::v3::Listener& rhs) {
+  return equalIgnoringFields(lhs, rhs, FilterChainFields);
+}
+
+bool ListenerMessageUtil::newConnectionsOnlyChange(
+    const envoy::config::listener::v3::Listener& lhs,
+    const envoy::config::listener::v3::Listener& rhs) {
+  return equalIgnoringFields(lhs, rhs, NewConnectionFields);
+}
+
 } // namespace Server
 } // namespace Envoy
@@ -56,6 +56,14 @@ public:
    */
   static bool filterChainOnlyChange(const envoy::config::listener::v3::Listener& lhs,
                                     const envoy::config::listener::v3::Listener& rhs);
+
+  /**
+   * @return true if listener message lhs and rhs are the same if ignoring the fields which are only
+   * looked up for the new connections of a TCP listener: the filter chains, the listener filters,
+   * the access logs and the per connection buffer limit.
+   */
+  static bool newConnectionsOnlyChange(const envoy::config::listener::v3::Listener& lhs,
+                                       const envoy::config::listener::v3::Listener& rhs);
 };
 
 class ListenerManagerImpl;
@@ -316,6 +324,7 @@ public:
   }
   Init::Manager& initManager() override;
   bool ignoreGlobalConnLimit() const override { return ignore_global_conn_limit_; }
+  bool coalesceWrites() const override { return coalesce_writes_; }
   bool shouldBypassOverloadManager() const override { return bypass_overload_manager_; }
   const Network::ListenerInfoConstSharedPtr& listenerInfo() const override {
     ASSERT(listener_factory_context_ != nullptr);
@@ -431,6 +440,7 @@ private:
   const uint32_t max_connections_to_accept_per_socket_event_;
   ProtobufMessage::ValidationVisitor& validation_visitor_;
   const bool ignore_global_conn_limit_;
+  const bool coalesce_writes_;
   const bool bypass_overload_manager_;
 
   // A target is added to Server's InitManager if workers_started_ is false.
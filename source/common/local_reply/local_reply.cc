@@ -16,34 +16,72 @@
 namespace Envoy {
 namespace LocalReply {
 
+/**
+ * Formats the body of the local replies. The formats which need no per-request field, i.e. the
+ * default "%LOCAL_REPLY_BODY%" one which leaves the body as it is and the plain texts without any
+ * command, are resolved once when configured instead of being formatted for each local reply.
+ */
 class BodyFormatter {
 public:
-  BodyFormatter()
-      : formatter_(std::make_unique<Envoy::Formatter::FormatterImpl>("%LOCAL_REPLY_BODY%", false)),
-        content_type_(Http::Headers::get().ContentTypeValues.Text) {}
+  BodyFormatter() : content_type_(Http::Headers::get().ContentTypeValues.Text) {}
 
   BodyFormatter(const envoy::config::core::v3::SubstitutionFormatString& config,
                 Server::Configuration::GenericFactoryContext& context)
-      : formatter_(Formatter::SubstitutionFormatStringUtils::fromProtoConfig(config, context)),
-        content_type_(
+      : content_type_(
             !config.content_type().empty() ? config.content_type()
             : config.format_case() ==
                     envoy::config::core::v3::SubstitutionFormatString::FormatCase::kJsonFormat
                 ? Http::Headers::get().ContentTypeValues.Json
-                : Http::Headers::get().ContentTypeValues.Text) {}
+                : Http::Headers::get().ContentTypeValues.Text) {
+    const std::string* text_format = inlineTextFormat(config);
+    if (text_format != nullptr && config.formatters().empty()) {
+      if (*text_format == LocalReplyBodyFormat) {
+        return;
+      }
+      if (text_format->find('%') == std::string::npos) {
+        static_body_ = *text_format;
+        return;
+      }
+    }
+    formatter_ = Formatter::SubstitutionFormatStringUtils::fromProtoConfig(config, context);
+  }
 
   void format(const Http::RequestHeaderMap& request_headers,
               const Http::ResponseHeaderMap& response_headers,
               const Http::ResponseTrailerMap& response_trailers,
               const StreamInfo::StreamInfo& stream_info, std::string& body,
               absl::string_view& content_type) const {
-    body = formatter_->formatWithContext(
-        {&request_headers, &response_headers, &response_trailers, body}, stream_info);
+    if (formatter_ != nullptr) {
+      body = formatter_->formatWithContext(
+          {&request_headers, &response_headers, &response_trailers, body}, stream_info);
+    } else if (static_body_.has_value()) {
+      body = static_body_.value();
+    }
     content_type = content_type_;
   }
 
 private:
-  const Formatter::FormatterPtr formatter_;
+  static constexpr absl::string_view LocalReplyBodyFormat = "%LOCAL_REPLY_BODY%";
+
+  // Returns the text format given inline in the config, or nullptr if there is none.
+  static const std::string*
+  inlineTextFormat(const envoy::config::core::v3::SubstitutionFormatString& config) {
+    switch (config.format_case()) {
+    case envoy::config::core::v3::SubstitutionFormatString::FormatCase::kTextFormat:
+      return &config.text_format();
+    case envoy::config::core::v3::SubstitutionFormatString::FormatCase::kTextFormatSource:
+      return config.text_format_source().specifier_case() ==
+                     envoy::config::core::v3::DataSource::SpecifierCase::kInlineString
+                 ? &config.text_format_source().inline_string()
+                 : nullptr;
+    default:
+      return nullptr;
+    }
+  }
+
+  // Neither is set when the body is left as it is.
+  Formatter::FormatterPtr formatter_;
+  absl::optional<std::string> static_body_;
   const std::string content_type_;
 };
 
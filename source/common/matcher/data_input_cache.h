@@ -0,0 +1,140 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "envoy/matcher/matcher.h"
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/container/inlined_vector.h"
+
+namespace Envoy {
+namespace Matcher {
+
+/**
+ * Numbers the data inputs of the match trees made by a factory, so that the inputs of identical
+ * configurations get the same slot. The inputs whose slot is shared by several of them are fetched
+ * once per evaluation of a tree instead of once each.
+ */
+class DataInputSlots {
+public:
+  // Returns the slot of the input of the serialized configuration, counting one more input in it.
+  uint32_t add(const std::string& config) {
+    const auto [it, inserted] = slots_.try_emplace(config, inputs_.size());
+    if (inserted) {
+      inputs_.push_back(0);
+    }
+    ++inputs_[it->second];
+    return it->second;
+  }
+
+  bool shared(uint32_t slot) const { return inputs_[slot] > 1; }
+
+private:
+  absl::flat_hash_map<std::string, uint32_t> slots_;
+  // The number of inputs in each slot.
+  std::vector<uint32_t> inputs_;
+};
+
+using DataInputSlotsSharedPtr = std::shared_ptr<DataInputSlots>;
+
+/**
+ * The results of the shared data inputs fetched while evaluating match trees against some data on
+ * this thread. It lives on the stack of the outermost evaluation of the data: the nested
+ * evaluations of sub-trees against the same data use the cache of the outermost one.
+ */
+class DataInputCache {
+public:
+  explicit DataInputCache(const void* data) : data_(data), previous_(current()) {
+    if (previous_ == nullptr || previous_->data_ != data) {
+      current() = this;
+    }
+  }
+
+  ~DataInputCache() {
+    if (current() == this) {
+      current() = previous_;
+    }
+  }
+
+  DataInputCache(const DataInputCache&) = delete;
+  DataInputCache& operator=(const DataInputCache&) = delete;
+
+  /**
+   * @return the cache of the evaluation of the data in progress on this thread, or nullptr if the
+   * data isn't being evaluated.
+   */
+  static DataInputCache* get(const void* data) {
+    DataInputCache* cache = current();
+    return cache != nullptr && cache->data_ == data ? cache : nullptr;
+  }
+
+  /**
+   * @return the result fetched for the slot during the evaluation, or nullptr if none was yet.
+   */
+  const DataInputGetResult* find(const DataInputSlots& slots, uint32_t slot) const {
+    for (const Entry& entry : entries_) {
+      if (entry.slots_ == &slots && entry.slot_ == slot) {
+        return &entry.result_;
+      }
+    }
+    return nullptr;
+  }
+
+  void insert(const DataInputSlots& slots, uint32_t slot, const DataInputGetResult& result) {
+    entries_.push_back({&slots, slot, result});
+  }
+
+private:
+  struct Entry {
+    const DataInputSlots* slots_;
+    uint32_t slot_;
+    DataInputGetResult result_;
+  };
+
+  static DataInputCache*& current() {
+    static thread_local DataInputCache* current = nullptr;
+    return current;
+  }
+
+  const void* const data_;
+  DataInputCache* const previous_;
+  absl::InlinedVector<Entry, 4> entries_;
+};
+
+/**
+ * A DataInput whose slot is shared with identical inputs of the same trees. Its result is fetched
+ * by the first of them to be evaluated, and then reused by the others until the end of the
+ * evaluation.
+ */
+template <class DataType> class SharedDataInput : public DataInput<DataType> {
+public:
+  SharedDataInput(DataInputPtr<DataType>&& data_input, DataInputSlotsSharedPtr slots,
+                  uint32_t slot)
+      : data_input_(std::move(data_input)), slots_(std::move(slots)), slot_(slot) {}
+
+  DataInputGetResult get(const DataType& data) const override {
+    DataInputCache* cache = DataInputCache::get(&data);
+    if (cache == nullptr) {
+      return data_input_->get(data);
+    }
+    if (const DataInputGetResult* result = cache->find(*slots_, slot_); result != nullptr) {
+      return *result;
+    }
+    DataInputGetResult result = data_input_->get(data);
+    cache->insert(*slots_, slot_, result);
+    return result;
+  }
+
+  absl::string_view dataInputType() const override { return data_input_->dataInputType(); }
+
+private:
+  const DataInputPtr<DataType> data_input_;
+  const DataInputSlotsSharedPtr slots_;
+  const uint32_t slot_;
+};
+
+} // namespace Matcher
+} // namespace Envoy
@@ -11,6 +11,7 @@
 
 #include "source/common/common/assert.h"
 #include "source/common/config/utility.h"
+#include "source/common/matcher/data_input_cache.h"
 #include "source/common/matcher/exact_map_matcher.h"
 #include "source/common/matcher/field_matcher.h"
 #include "source/common/matcher/list_matcher.h"
@@ -46,6 +47,8 @@ struct MaybeMatchResult {
 template <class DataType>
 static inline MaybeMatchResult evaluateMatch(MatchTree<DataType>& match_tree,
                                              const DataType& data) {
+  // The identical inputs of the tree and of its sub-trees are fetched once from the data.
+  DataInputCache cache(&data);
   const auto result = match_tree.match(data);
   if (result.match_state_ == MatchState::UnableToMatch) {
     return MaybeMatchResult{nullptr, MatchState::UnableToMatch};
@@ -81,7 +84,8 @@ public:
 };
 
 /**
- * Constructs a data input function for a data type.
+ * Constructs a data input function for a data type. The inputs of identical configurations share
+ * their results during each evaluation of their trees, see DataInputCache.
  **/
 template <class DataType> class MatchInputFactory {
 public:
@@ -116,6 +120,20 @@ private:
 
   template <class TypedExtensionConfigType>
   DataInputFactoryCb<DataType> createDataInputBase(const TypedExtensionConfigType& config) {
+    DataInputFactoryCb<DataType> data_input = createUniqueDataInput(config);
+    // Whether the slot is shared is only known once all the inputs of the trees were created.
+    return [data_input, slots = slots_, slot = slots_->add(config.SerializeAsString())]() {
+      DataInputPtr<DataType> input = data_input();
+      if (!slots->shared(slot)) {
+        return input;
+      }
+      return DataInputPtr<DataType>{
+          std::make_unique<SharedDataInput<DataType>>(std::move(input), slots, slot)};
+    };
+  }
+
+  template <class TypedExtensionConfigType>
+  DataInputFactoryCb<DataType> createUniqueDataInput(const TypedExtensionConfigType& config) {
     auto* factory = Config::Utility::getFactory<DataInputFactory<DataType>>(config);
     if (factory != nullptr) {
       validation_visitor_.validateDataInput(*factory, config.typed_config().type_url());
@@ -140,6 +158,7 @@ private:
 
   ProtobufMessage::ValidationVisitor& validator_;
   MatchTreeValidationVisitor<DataType>& validation_visitor_;
+  const DataInputSlotsSharedPtr slots_{std::make_shared<DataInputSlots>()};
 };
 
 /**
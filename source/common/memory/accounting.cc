@@ -0,0 +1,104 @@
+#include "source/common/memory/accounting.h"
+
+#include <atomic>
+
+#include "source/common/common/macros.h"
+
+#include "absl/container/flat_hash_set.h"
+#include "absl/synchronization/mutex.h"
+
+namespace Envoy {
+namespace Memory {
+namespace {
+
+class ThreadCounters;
+
+// Set once the counters of the thread are destroyed. It is trivially destructible, so it remains
+// accessible until the thread exits.
+thread_local bool counters_destroyed = false;
+
+// Keeps track of the counters of all the threads so that they can be aggregated.
+struct Registry {
+  absl::Mutex mutex_;
+  absl::flat_hash_set<const ThreadCounters*> counters_ ABSL_GUARDED_BY(mutex_);
+  // The bytes of the threads that exited, and charged or credited during their exit.
+  std::array<std::atomic<uint64_t>, Accounting::NumSubsystems> retired_{};
+};
+
+// Never destroyed, as the counters of the threads may be destroyed at process exit after the static
+// destructors ran.
+Registry& registry() { MUTABLE_CONSTRUCT_ON_FIRST_USE(Registry); }
+
+class ThreadCounters {
+public:
+  ThreadCounters() {
+    absl::MutexLock lock(&registry().mutex_);
+    registry().counters_.insert(this);
+  }
+
+  ~ThreadCounters() {
+    counters_destroyed = true;
+    absl::MutexLock lock(&registry().mutex_);
+    for (size_t i = 0; i < Accounting::NumSubsystems; ++i) {
+      registry().retired_[i].fetch_add(bytes_[i].load(std::memory_order_relaxed),
+                                       std::memory_order_relaxed);
+    }
+    registry().counters_.erase(this);
+  }
+
+  // The counters are only written by the thread owning them, so there is no need for atomic
+  // read-modify-write operations. They are atomic so that they can be read from other threads.
+  // The credits wrap around, as the memory may be freed by another thread than the one which
+  // allocated it, and the aggregate wraps back.
+  void add(Subsystem subsystem, uint64_t bytes) {
+    std::atomic<uint64_t>& counter = bytes_[static_cast<size_t>(subsystem)];
+    counter.store(counter.load(std::memory_order_relaxed) + bytes, std::memory_order_relaxed);
+  }
+
+  // May be called from any thread.
+  uint64_t bytes(size_t index) const { return bytes_[index].load(std::memory_order_relaxed); }
+
+private:
+  std::array<std::atomic<uint64_t>, Accounting::NumSubsystems> bytes_{};
+};
+
+void add(Subsystem subsystem, uint64_t bytes) {
+  if (counters_destroyed) {
+    registry().retired_[static_cast<size_t>(subsystem)].fetch_add(bytes,
+                                                                  std::memory_order_relaxed);
+    return;
+  }
+  static thread_local ThreadCounters counters;
+  counters.add(subsystem, bytes);
+}
+
+#define GENERATE_MEMORY_SUBSYSTEM_NAME(ENUM, NAME) #NAME,
+
+constexpr absl::string_view SubsystemNames[] = {
+    ALL_MEMORY_SUBSYSTEMS(GENERATE_MEMORY_SUBSYSTEM_NAME)};
+static_assert(sizeof(SubsystemNames) / sizeof(SubsystemNames[0]) == Accounting::NumSubsystems);
+
+} // namespace
+
+void Accounting::charge(Subsystem subsystem, uint64_t bytes) { add(subsystem, bytes); }
+
+void Accounting::credit(Subsystem subsystem, uint64_t bytes) { add(subsystem, -bytes); }
+
+std::array<uint64_t, Accounting::NumSubsystems> Accounting::bytes() {
+  std::array<uint64_t, NumSubsystems> total;
+  absl::MutexLock lock(&registry().mutex_);
+  for (size_t i = 0; i < NumSubsystems; ++i) {
+    total[i] = registry().retired_[i].load(std::memory_order_relaxed);
+    for (const ThreadCounters* counters : registry().counters_) {
+      total[i] += counters->bytes(i);
+    }
+  }
+  return total;
+}
+
+absl::string_view Accounting::name(Subsystem subsystem) {
+  return SubsystemNames[static_cast<size_t>(subsystem)];
+}
+
+} // namespace Memory
+} // namespace Envoy
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+#include "absl/strings/string_view.h"
+
+namespace Envoy {
+namespace Memory {
+
+/**
+ * All the subsystems to which memory is attributed. @see Accounting.
+ */
+#define ALL_MEMORY_SUBSYSTEMS(SUBSYSTEM)                                                           \
+  SUBSYSTEM(BufferAccounts, buffer_accounts)                                                       \
+  SUBSYSTEM(Buffers, buffers)                                                                      \
+  SUBSYSTEM(HeaderMaps, header_maps)                                                               \
+  SUBSYSTEM(Hosts, hosts)                                                                          \
+  SUBSYSTEM(RouteConfigs, route_configs)                                                           \
+  SUBSYSTEM(Stats, stats)                                                                          \
+  SUBSYSTEM(TlsContexts, tls_contexts)
+
+#define GENERATE_MEMORY_SUBSYSTEM_ENUM(ENUM, NAME) ENUM,
+
+enum class Subsystem : uint8_t { ALL_MEMORY_SUBSYSTEMS(GENERATE_MEMORY_SUBSYSTEM_ENUM) Count };
+
+/**
+ * Process wide attribution of the memory to the subsystems of Envoy, so that the growth of the
+ * memory can be tied to e.g. the configuration, the connections or the stats. The bytes are
+ * charged and credited by the subsystems as they allocate and free their memory, to counters of
+ * the calling thread, which are only aggregated when read. A subsystem may free memory on
+ * another thread than the one which allocated it: only the aggregate is meaningful.
+ */
+class Accounting {
+public:
+  static constexpr size_t NumSubsystems = static_cast<size_t>(Subsystem::Count);
+
+  /**
+   * Charge allocated bytes to a subsystem.
+   */
+  static void charge(Subsystem subsystem, uint64_t bytes);
+
+  /**
+   * Credit freed bytes to a subsystem, which were charged to it before.
+   */
+  static void credit(Subsystem subsystem, uint64_t bytes);
+
+  /**
+   * @return the bytes charged to each subsystem and not credited yet, by all the threads including
+   *         the ones which exited, indexed by subsystem.
+   */
+  static std::array<uint64_t, NumSubsystems> bytes();
+
+  /**
+   * @return the snake case name of a subsystem.
+   */
+  static absl::string_view name(Subsystem subsystem);
+};
+
+/**
+ * Bytes charged to a subsystem for the lifetime of the object holding it.
+ */
+class AccountedBytes {
+public:
+  AccountedBytes(Subsystem subsystem, uint64_t bytes) : subsystem_(subsystem), bytes_(bytes) {
+    Accounting::charge(subsystem_, bytes_);
+  }
+  ~AccountedBytes() { Accounting::credit(subsystem_, bytes_); }
+
+  AccountedBytes(const AccountedBytes&) = delete;
+  AccountedBytes& operator=(const AccountedBytes&) = delete;
+
+private:
+  const Subsystem subsystem_;
+  const uint64_t bytes_;
+};
+
+} // namespace Memory
+} // namespace Envoy
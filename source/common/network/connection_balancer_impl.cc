@@ -1,5 +1,9 @@
 #include "source/common/network/connection_balancer_impl.h"
 
+#include "source/common/stats/utility.h"
+
+#include "absl/strings/str_cat.h"
+
 namespace Envoy {
 namespace Network {
 
@@ -34,5 +38,29 @@ ExactConnectionBalancerImpl::pickTargetHandler(BalancedConnectionHandler&) {
   return *min_connection_handler;
 }
 
+CpuConnectionBalancerImpl::CpuConnectionBalancerImpl(Stats::Scope& scope,
+                                                     const CpuTopology& topology)
+    : topology_(topology) {
+  for (const uint32_t node : topology_.numaNodes()) {
+    const std::string node_name = absl::StrCat("numa_node_", node);
+    numa_node_cx_total_.emplace(node, &Stats::Utility::counterFromElements(
+                                          scope, {Stats::DynamicName(node_name),
+                                                  Stats::DynamicName("downstream_cx_total")}));
+  }
+}
+
+BalancedConnectionHandler&
+CpuConnectionBalancerImpl::pickTargetHandler(BalancedConnectionHandler& current_handler) {
+  const absl::optional<uint32_t> cpu = CpuTopology::currentCpu();
+  if (cpu.has_value()) {
+    const auto it = numa_node_cx_total_.find(topology_.numaNode(cpu.value()));
+    if (it != numa_node_cx_total_.end()) {
+      it->second->inc();
+    }
+  }
+  current_handler.incNumConnections();
+  return current_handler;
+}
+
 } // namespace Network
 } // namespace Envoy
@@ -4,9 +4,12 @@
 #include "envoy/network/connection_balancer.h"
 #include "envoy/registry/registry.h"
 #include "envoy/server/filter_config.h"
+#include "envoy/stats/scope.h"
 
+#include "source/common/common/cpu_topology.h"
 #include "source/common/protobuf/protobuf.h"
 
+#include "absl/container/flat_hash_map.h"
 #include "absl/synchronization/mutex.h"
 
 namespace Envoy {
@@ -61,5 +64,27 @@ public:
   }
 };
 
+/**
+ * Implementation of connection balancer that keeps every connection on the handler that accepted
+ * it, like the NOP balancer, for listeners whose connections are steered by the kernel to the
+ * handler of the worker running on the CPU that received them. It counts the connections accepted
+ * on the CPUs of every NUMA node in "numa_node_<node>.downstream_cx_total" in the supplied scope,
+ * so that an operator can see how the connections spread over the nodes.
+ */
+class CpuConnectionBalancerImpl : public ConnectionBalancer {
+public:
+  CpuConnectionBalancerImpl(Stats::Scope& scope, const CpuTopology& topology);
+
+  // ConnectionBalancer
+  void registerHandler(BalancedConnectionHandler&) override {}
+  void unregisterHandler(BalancedConnectionHandler&) override {}
+  BalancedConnectionHandler& pickTargetHandler(BalancedConnectionHandler& current_handler) override;
+
+private:
+  const CpuTopology topology_;
+  // Immutable once constructed, so that it is read by the workers without a lock.
+  absl::flat_hash_map<uint32_t, Stats::Counter*> numa_node_cx_total_;
+};
+
 } // namespace Network
 } // namespace Envoy
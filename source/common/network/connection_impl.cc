@@ -272,6 +272,9 @@ void ConnectionImpl::closeSocket(ConnectionEvent close_type) {
     delayed_close_timer_->disableTimer();
     delayed_close_timer_ = nullptr;
   }
+  if (write_flush_cb_ != nullptr) {
+    write_flush_cb_->cancel();
+  }
 
   ENVOY_CONN_LOG(debug, "closing socket: {}", *this, static_cast<uint32_t>(close_type));
   transport_socket_->closeSocket(close_type);
@@ -539,11 +542,23 @@ void ConnectionImpl::write(Buffer::Instance& data, bool end_stream, bool through
     // doWriteReady into thinking the socket is connected. On macOS, the underlying write may fail
     // with a connection error if a call to write(2) occurs before the connection is completed.
     if (!connecting_) {
-      ioHandle().activateFileEvents(Event::FileReadyType::Write);
+      if (write_flush_cb_ != nullptr) {
+        // The flush runs after the events of the iteration, and whatever else they write.
+        write_flush_cb_->scheduleCallbackCurrentIteration();
+      } else {
+        ioHandle().activateFileEvents(Event::FileReadyType::Write);
+      }
     }
   }
 }
 
+void ConnectionImpl::coalesceWrites() {
+  if (write_flush_cb_ == nullptr) {
+    write_flush_cb_ = dispatcher_.createSchedulableCallback(
+        [this]() { onFileEvent(Event::FileReadyType::Write); });
+  }
+}
+
 void ConnectionImpl::setBufferLimits(uint32_t limit) {
   read_buffer_limit_ = limit;
 
@@ -736,6 +751,11 @@ ConnectionImpl::unixSocketPeerCredentials() const {
 void ConnectionImpl::onWriteReady() {
   ENVOY_CONN_LOG(trace, "write ready", *this);
 
+  if (write_flush_cb_ != nullptr) {
+    // The write buffer is flushed now, a pending flush would find nothing to write.
+    write_flush_cb_->cancel();
+  }
+
   if (connecting_) {
     int error;
     socklen_t error_size = sizeof(error);
@@ -902,6 +922,8 @@ void ServerConnectionImpl::setTransportSocketConnectTimeout(std::chrono::millise
   transport_socket_connect_timer_->enableTimer(timeout);
 }
 
+void ServerConnectionImpl::enableWriteCoalescing() { coalesceWrites(); }
+
 void ServerConnectionImpl::raiseEvent(ConnectionEvent event) {
   switch (event) {
   case ConnectionEvent::ConnectedZeroRtt:
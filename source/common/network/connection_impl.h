@@ -142,6 +142,7 @@ public:
   void setTransportSocketIsReadable() override;
   void flushWriteBuffer() override;
   TransportSocketPtr& transportSocket() { return transport_socket_; }
+  const TransportSocketPtr& transportSocket() const { return transport_socket_; }
 
   // Obtain global next connection ID. This should only be used in tests.
   static uint64_t nextGlobalIdForTest() { return next_global_id_; }
@@ -176,6 +177,10 @@ protected:
   void setFailureReason(absl::string_view failure_reason);
   const std::string& failureReason() const { return failure_reason_; }
 
+  // Flushes the data written from then on once at the end of each event loop iteration, rather
+  // than by activating the write event of the socket on each write.
+  void coalesceWrites();
+
   TransportSocketPtr transport_socket_;
   ConnectionSocketPtr socket_;
   StreamInfo::StreamInfo& stream_info_;
@@ -228,6 +233,8 @@ private:
   uint64_t last_read_buffer_size_{};
   uint64_t last_write_buffer_size_{};
   Buffer::Instance* current_write_buffer_{};
+  // Runs the flush at the end of the event loop iteration, if the writes are coalesced.
+  Event::SchedulableCallbackPtr write_flush_cb_;
   uint32_t read_disable_count_{0};
   DetectedCloseType detected_close_type_{DetectedCloseType::Normal};
   bool write_buffer_above_high_watermark_ : 1;
@@ -254,6 +261,7 @@ public:
   // ServerConnection impl
   void setTransportSocketConnectTimeout(std::chrono::milliseconds timeout,
                                         Stats::Counter& timeout_stat) override;
+  void enableWriteCoalescing() override;
   void raiseEvent(ConnectionEvent event) override;
   bool initializeReadFilters() override;
 
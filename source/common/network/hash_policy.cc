@@ -35,7 +35,7 @@ public:
   }
 
 private:
-  const std::string key_;
+  const StreamInfo::FilterState::Key key_;
 };
 
 HashPolicyImpl::HashPolicyImpl(
@@ -61,6 +61,13 @@ Api::IoCallUint64Result IoSocketHandleImpl::close() {
   if (file_event_) {
     file_event_.reset();
   }
+  if (hasPendingZeroCopySends()) {
+    // The completions can't be received once the socket is closed, so the slices of the sends
+    // still pending are released with it. The kernel keeps their pages pinned, but their data may
+    // change before it is all sent.
+    processZeroCopyCompletions();
+    zero_copy_.reset();
+  }
 
   ASSERT(SOCKET_VALID(fd_));
   const int rc = Api::OsSysCallsSingleton::get().close(fd_).return_value_;
@@ -137,13 +144,134 @@ Api::IoCallUint64Result IoSocketHandleImpl::writev(const Buffer::RawSlice* slice
 Api::IoCallUint64Result IoSocketHandleImpl::write(Buffer::Instance& buffer) {
   constexpr uint64_t MaxSlices = 16;
   Buffer::RawSliceVector slices = buffer.getRawSlices(MaxSlices);
-  Api::IoCallUint64Result result = writev(slices.begin(), slices.size());
+  Api::IoCallUint64Result result = shouldWriteZeroCopy(slices)
+                                       ? writeZeroCopy(slices)
+                                       : writev(slices.begin(), slices.size());
   if (result.ok() && result.return_value_ > 0) {
-    buffer.drain(static_cast<uint64_t>(result.return_value_));
+    if (hasPendingZeroCopySends()) {
+      drainWrittenZeroCopy(buffer, static_cast<uint64_t>(result.return_value_));
+    } else {
+      buffer.drain(static_cast<uint64_t>(result.return_value_));
+    }
   }
   return result;
 }
 
+bool IoSocketHandleImpl::shouldWriteZeroCopy(const Buffer::RawSliceVector& slices) {
+#if ENVOY_PLATFORM_ENABLE_MSG_ZEROCOPY
+  if (zero_copy_ != nullptr && !zero_copy_->enabled_) {
+    return false;
+  }
+  uint64_t length = 0;
+  for (const Buffer::RawSlice& slice : slices) {
+    length += slice.len_;
+  }
+  if (length < ZeroCopyMinWriteSize) {
+    return false;
+  }
+  if (zero_copy_ == nullptr) {
+    zero_copy_ = std::make_unique<ZeroCopyState>();
+    int enabled = 0;
+    socklen_t enabled_length = sizeof(enabled);
+    zero_copy_->enabled_ =
+        getOption(SOL_SOCKET, SO_ZEROCOPY, &enabled, &enabled_length).return_value_ == 0 &&
+        enabled != 0;
+  }
+  return zero_copy_->enabled_;
+#else
+  UNREFERENCED_PARAMETER(slices);
+  return false;
+#endif
+}
+
+Api::IoCallUint64Result IoSocketHandleImpl::writeZeroCopy(const Buffer::RawSliceVector& slices) {
+#if ENVOY_PLATFORM_ENABLE_MSG_ZEROCOPY
+  absl::FixedArray<iovec> iov(slices.size());
+  uint64_t num_slices_to_write = 0;
+  for (const Buffer::RawSlice& slice : slices) {
+    if (slice.mem_ != nullptr && slice.len_ != 0) {
+      iov[num_slices_to_write].iov_base = slice.mem_;
+      iov[num_slices_to_write].iov_len = slice.len_;
+      num_slices_to_write++;
+    }
+  }
+  msghdr message{};
+  message.msg_iov = iov.begin();
+  message.msg_iovlen = num_slices_to_write;
+  const Api::SysCallSizeResult result =
+      Api::OsSysCallsSingleton::get().sendmsg(fd_, &message, MSG_ZEROCOPY);
+  if (result.return_value_ < 0 && result.errno_ == ENOBUFS) {
+    // The kernel can't pin more pages for the socket, so the data is copied instead.
+    return writev(slices.begin(), slices.size());
+  }
+  if (result.return_value_ > 0) {
+    // Only the sends which wrote something get an id.
+    zero_copy_->sends_.emplace_back(zero_copy_->next_id_++);
+  }
+  return sysCallResultToIoCallResult(result);
+#else
+  UNREFERENCED_PARAMETER(slices);
+  PANIC("not reached");
+#endif
+}
+
+void IoSocketHandleImpl::drainWrittenZeroCopy(Buffer::Instance& buffer, uint64_t length) {
+  ZeroCopySend& send = zero_copy_->sends_.back();
+  while (length > 0) {
+    const uint64_t slice_length = buffer.frontSlice().len_;
+    if (slice_length > length) {
+      // The slice stays in the buffer, which neither frees it nor reuses its drained space until
+      // the rest of it is written out too.
+      buffer.drain(length);
+      break;
+    }
+    // The drain trackers are called now, as they would be by a drain.
+    send.slices_.emplace_back().move(buffer, slice_length,
+                                     /*reset_drain_trackers_and_accounting=*/true);
+    length -= slice_length;
+  }
+}
+
+void IoSocketHandleImpl::processZeroCopyCompletions() {
+#if ENVOY_PLATFORM_ENABLE_MSG_ZEROCOPY
+  auto& os_syscalls = Api::OsSysCallsSingleton::get();
+  std::deque<ZeroCopySend>& sends = zero_copy_->sends_;
+  while (!sends.empty()) {
+    // The error carries the address of its origin, which is the local host for the completions.
+    absl::FixedArray<char> cbuf(CMSG_SPACE(sizeof(sock_extended_err) + sizeof(sockaddr_in6)));
+    msghdr message{};
+    message.msg_control = cbuf.begin();
+    message.msg_controllen = cbuf.size();
+    if (os_syscalls.recvmsg(fd_, &message, MSG_ERRQUEUE).return_value_ < 0) {
+      // Nothing is left in the error queue.
+      break;
+    }
+    for (cmsghdr* cmsg = CMSG_FIRSTHDR(&message); cmsg != nullptr;
+         cmsg = CMSG_NXTHDR(&message, cmsg)) {
+      if ((cmsg->cmsg_level != SOL_IP || cmsg->cmsg_type != IP_RECVERR) &&
+          (cmsg->cmsg_level != SOL_IPV6 || cmsg->cmsg_type != IPV6_RECVERR)) {
+        continue;
+      }
+      const auto* error = reinterpret_cast<const sock_extended_err*>(CMSG_DATA(cmsg));
+      if (error->ee_errno != 0 || error->ee_origin != SO_EE_ORIGIN_ZEROCOPY) {
+        continue;
+      }
+      // The completion covers the range of ids from ee_info to ee_data, which may wrap around.
+      const uint32_t first_id = error->ee_info;
+      const uint32_t range = error->ee_data - first_id;
+      for (ZeroCopySend& send : sends) {
+        if (send.id_ - first_id <= range) {
+          send.completed_ = true;
+        }
+      }
+    }
+    while (!sends.empty() && sends.front().completed_) {
+      sends.pop_front();
+    }
+  }
+#endif
+}
+
 Api::IoCallUint64Result IoSocketHandleImpl::sendmsg(const Buffer::RawSlice* slices,
                                                     uint64_t num_slice, int flags,
                                                     const Address::Ip* self_ip,
@@ -450,6 +578,12 @@ Api::IoCallUint64Result IoSocketHandleImpl::recvmmsg(RawSliceArrays& slices, uin
           output.msg_[i].tos_ = *(reinterpret_cast<uint8_t*>(CMSG_DATA(cmsg)));
           continue;
         }
+#ifdef UDP_GRO
+        if (cmsg->cmsg_level == SOL_UDP && cmsg->cmsg_type == UDP_GRO) {
+          output.msg_[i].gso_size_ = *reinterpret_cast<uint16_t*>(CMSG_DATA(cmsg));
+          continue;
+        }
+#endif
         if (addr != nullptr) {
           // This is a IP packet info message.
           output.msg_[i].local_address_ = std::move(addr);
@@ -540,7 +674,17 @@ void IoSocketHandleImpl::initializeFileEvent(Event::Dispatcher& dispatcher, Even
                                              Event::FileTriggerType trigger, uint32_t events) {
   ASSERT(file_event_ == nullptr, "Attempting to initialize two `file_event_` for the same "
                                  "file descriptor. This is not allowed.");
-  file_event_ = dispatcher.createFileEvent(fd_, cb, trigger, events);
+  file_event_ = dispatcher.createFileEvent(
+      fd_,
+      [this, cb = std::move(cb)](uint32_t events) {
+        // The completions of the zero-copy sends make the socket report an error, which the
+        // dispatcher delivers as a read and write event.
+        if (hasPendingZeroCopySends()) {
+          processZeroCopyCompletions();
+        }
+        return cb(events);
+      },
+      trigger, events);
 }
 
 void IoSocketHandleImpl::activateFileEvents(uint32_t events) {
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <deque>
 #include <memory>
 
 #include "envoy/api/io_error.h"
@@ -8,6 +9,7 @@
 #include "envoy/event/dispatcher.h"
 #include "envoy/network/io_handle.h"
 
+#include "source/common/buffer/buffer_impl.h"
 #include "source/common/common/logger.h"
 #include "source/common/network/io_socket_error_impl.h"
 #include "source/common/network/io_socket_handle_base_impl.h"
@@ -44,6 +46,10 @@ public:
   // Close underlying socket if close() hasn't been call yet.
   ~IoSocketHandleImpl() override;
 
+  // The smallest write sent with MSG_ZEROCOPY, on the sockets which have SO_ZEROCOPY set. Pinning
+  // the pages and receiving the completion cost more than copying the smaller writes.
+  static constexpr uint64_t ZeroCopyMinWriteSize = 16 * 1024;
+
   Api::IoCallUint64Result close() override;
 
   Api::IoCallUint64Result readv(uint64_t max_length, Buffer::RawSlice* slices,
@@ -118,6 +124,39 @@ protected:
   }
 
 private:
+  // A send made with MSG_ZEROCOPY, whose data is read by the kernel from the slices it was sent
+  // from until it completes.
+  struct ZeroCopySend {
+    explicit ZeroCopySend(uint32_t id) : id_(id) {}
+
+    // The kernel numbers the zero-copy sends of a socket from 0.
+    const uint32_t id_;
+    bool completed_{};
+    // The slices which were written out while this send was the last one, each in its own buffer
+    // so that moving them in neither copies nor frees them.
+    std::deque<Buffer::OwnedImpl> slices_;
+  };
+
+  struct ZeroCopyState {
+    // Whether SO_ZEROCOPY is set on the socket.
+    bool enabled_{};
+    uint32_t next_id_{};
+    // The sends from the first one not completed yet, in id order. The slices of a send are
+    // released once it and all the sends before it completed.
+    std::deque<ZeroCopySend> sends_;
+  };
+
+  bool shouldWriteZeroCopy(const Buffer::RawSliceVector& slices);
+  Api::IoCallUint64Result writeZeroCopy(const Buffer::RawSliceVector& slices);
+  // Removes the written bytes from the buffer, keeping the slices which the pending zero-copy sends
+  // may read from.
+  void drainWrittenZeroCopy(Buffer::Instance& buffer, uint64_t length);
+  // Receives the completions of the zero-copy sends from the error queue of the socket.
+  void processZeroCopyCompletions();
+  bool hasPendingZeroCopySends() const {
+    return zero_copy_ != nullptr && !zero_copy_->sends_.empty();
+  }
+
   // Returns the destination address if the control message carries it.
   // Otherwise returns nullptr.
   Address::InstanceConstSharedPtr maybeGetDstAddressFromHeader(const cmsghdr& cmsg,
@@ -131,6 +170,8 @@ private:
   // address in each read operation. Only be instantiated if the non-zero address_cache_max_capacity
   // is passed in during the construction.
   std::unique_ptr<AddressInstanceLRUCache> recent_received_addresses_;
+  // Only created by the first write large enough to be sent with MSG_ZEROCOPY.
+  std::unique_ptr<ZeroCopyState> zero_copy_;
 };
 } // namespace Network
 } // namespace Envoy
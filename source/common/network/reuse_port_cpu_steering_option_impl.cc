@@ -0,0 +1,115 @@
+#include "source/common/network/reuse_port_cpu_steering_option_impl.h"
+
+#include "source/common/common/assert.h"
+#include "source/common/common/macros.h"
+#include "source/common/common/scalar_to_byte_vector.h"
+#include "source/common/common/utility.h"
+#include "source/common/network/socket_option_impl.h"
+
+#include "absl/container/flat_hash_set.h"
+
+namespace Envoy {
+namespace Network {
+namespace {
+
+#if defined(__linux__)
+// The program loads the CPU, looks it up with a comparison and a return per CPU, and otherwise
+// returns the CPU modulo the number of workers.
+constexpr uint32_t MaxLookedUpCpus = (BPF_MAXINSNS - 3) / 2;
+#else
+constexpr uint32_t MaxLookedUpCpus = 0;
+#endif
+
+} // namespace
+
+ReusePortCpuSteeringOptionImpl::ReusePortCpuSteeringOptionImpl(
+    const std::vector<uint32_t>& worker_cpus)
+    : num_workers_(worker_cpus.size()) {
+  ASSERT(num_workers_ > 0);
+  // Workers sharing a CPU all run there, the connections of the CPU go to the first of them.
+  absl::flat_hash_set<uint32_t> seen_cpus;
+  for (uint32_t index = 0; index < worker_cpus.size(); ++index) {
+    if (worker_by_cpu_.size() < MaxLookedUpCpus && seen_cpus.insert(worker_cpus[index]).second) {
+      worker_by_cpu_.emplace_back(worker_cpus[index], index);
+    }
+  }
+
+#if defined(__linux__)
+  // SPELLCHECKER(off)
+  program_.push_back(BPF_STMT(BPF_LD | BPF_W | BPF_ABS, SKF_AD_OFF + SKF_AD_CPU)); // ld cpu
+  for (const auto& [cpu, index] : worker_by_cpu_) {
+    program_.push_back(BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, cpu, 0, 1)); // jne #cpu, next
+    program_.push_back(BPF_STMT(BPF_RET | BPF_K, index));               // ret #index
+  }
+  program_.push_back(BPF_STMT(BPF_ALU | BPF_MOD | BPF_K, num_workers_)); // mod #workers
+  program_.push_back(BPF_STMT(BPF_RET | BPF_A, 0));                      // ret a
+  // SPELLCHECKER(on)
+#endif
+}
+
+bool ReusePortCpuSteeringOptionImpl::setOption(
+    Socket& socket, envoy::config::core::v3::SocketOption::SocketState state) const {
+  if (in_state_ != state) {
+    return true;
+  }
+  if (!isSupported()) {
+    ENVOY_LOG(warn, "Failed to set unsupported reuse port CPU steering option on socket");
+    return false;
+  }
+
+#if defined(__linux__)
+  // The kernel copies the program, which only has to outlive the call.
+  sock_fprog prog;
+  prog.len = program_.size();
+  prog.filter = const_cast<sock_filter*>(program_.data());
+  const Api::SysCallIntResult result =
+      SocketOptionImpl::setSocketOption(socket, optionName(), &prog, sizeof(prog));
+  if (result.return_value_ != 0) {
+    ENVOY_LOG(warn, "Attaching reuse port CPU steering program to socket failed: {}",
+              errorDetails(result.errno_));
+    return false;
+  }
+#endif
+  return true;
+}
+
+void ReusePortCpuSteeringOptionImpl::hashKey(std::vector<uint8_t>& hash_key) const {
+  pushScalarToByteVector(num_workers_, hash_key);
+  for (const auto& [cpu, index] : worker_by_cpu_) {
+    pushScalarToByteVector(cpu, hash_key);
+    pushScalarToByteVector(index, hash_key);
+  }
+}
+
+absl::optional<Socket::Option::Details> ReusePortCpuSteeringOptionImpl::getOptionDetails(
+    const Socket&, envoy::config::core::v3::SocketOption::SocketState state) const {
+  if (state != in_state_ || !isSupported()) {
+    return absl::nullopt;
+  }
+
+  Socket::Option::Details info;
+  info.name_ = optionName();
+#if defined(__linux__)
+  info.value_ = {reinterpret_cast<const char*>(program_.data()),
+                 program_.size() * sizeof(sock_filter)};
+#endif
+  return absl::make_optional(std::move(info));
+}
+
+bool ReusePortCpuSteeringOptionImpl::isSupported() const { return optionName().hasValue(); }
+
+uint32_t ReusePortCpuSteeringOptionImpl::workerIndex(uint32_t cpu) const {
+  for (const auto& [worker_cpu, index] : worker_by_cpu_) {
+    if (worker_cpu == cpu) {
+      return index;
+    }
+  }
+  return cpu % num_workers_;
+}
+
+const Network::SocketOptionName& ReusePortCpuSteeringOptionImpl::optionName() {
+  CONSTRUCT_ON_FIRST_USE(Network::SocketOptionName, ENVOY_ATTACH_REUSEPORT_CBPF);
+}
+
+} // namespace Network
+} // namespace Envoy
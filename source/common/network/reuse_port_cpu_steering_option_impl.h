@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "envoy/config/core/v3/base.pb.h"
+#include "envoy/network/listen_socket.h"
+
+#include "source/common/common/logger.h"
+
+#if defined(__linux__)
+#include <linux/filter.h>
+#endif
+
+namespace Envoy {
+namespace Network {
+
+/**
+ * Socket option that attaches a classic BPF program to the SO_REUSEPORT group of a TCP listener,
+ * which steers each new connection to the socket of the worker running on the CPU that received
+ * it. The sockets of a listener join the group in the order of their workers when they start
+ * listening, so the index of a socket in the group is the index of its worker. Connections
+ * received on a CPU that no worker runs on are spread over the workers by CPU.
+ */
+class ReusePortCpuSteeringOptionImpl : public Socket::Option,
+                                       Logger::Loggable<Logger::Id::connection> {
+public:
+  /**
+   * @param worker_cpus supplies the CPU of every worker, in the order of the worker indexes.
+   */
+  explicit ReusePortCpuSteeringOptionImpl(const std::vector<uint32_t>& worker_cpus);
+
+  // Socket::Option
+  bool setOption(Socket& socket,
+                 envoy::config::core::v3::SocketOption::SocketState state) const override;
+  void hashKey(std::vector<uint8_t>& hash_key) const override;
+  absl::optional<Details>
+  getOptionDetails(const Socket& socket,
+                   envoy::config::core::v3::SocketOption::SocketState state) const override;
+  bool isSupported() const override;
+
+  /**
+   * @return the index of the worker that the program steers a connection received on a CPU to.
+   */
+  uint32_t workerIndex(uint32_t cpu) const;
+
+  static const Network::SocketOptionName& optionName();
+
+private:
+  static constexpr envoy::config::core::v3::SocketOption::SocketState in_state_ =
+      envoy::config::core::v3::SocketOption::STATE_LISTENING;
+
+  const uint32_t num_workers_;
+  // The CPUs that the program looks up and the indexes of their workers.
+  std::vector<std::pair<uint32_t, uint32_t>> worker_by_cpu_;
+#if defined(__linux__)
+  std::vector<sock_filter> program_;
+#endif
+};
+
+} // namespace Network
+} // namespace Envoy
@@ -531,6 +531,25 @@ Api::IoCallUint64Result Utility::writeToSocket(IoHandle& handle, Buffer::RawSlic
 
 namespace {
 
+// Buffer::ReservationSingleSlice is always passed by value, and can only be constructed
+// by Buffer::Instance::reserve(), so this is needed to keep a fixed array
+// in which all elements are legally constructed.
+struct BufferAndReservation {
+  BufferAndReservation(uint64_t max_rx_datagram_size)
+      : buffer_(std::make_unique<Buffer::OwnedImpl>()),
+        reservation_(buffer_->reserveSingleSlice(max_rx_datagram_size, true)) {}
+
+  Buffer::InstancePtr buffer_;
+  Buffer::ReservationSingleSlice reservation_;
+};
+
+uint64_t maxRxDatagramSizeWithGro(const UdpPacketProcessor& udp_packet_processor,
+                                  bool count_packets_read) {
+  // TODO(yugant): Avoid allocating 64k for each read by getting memory from UdpPacketProcessor
+  return count_packets_read ? 64 * 1024
+                            : NUM_DATAGRAMS_PER_RECEIVE * udp_packet_processor.maxDatagramSize();
+}
+
 void passPayloadToProcessor(uint64_t bytes_read, Buffer::InstancePtr buffer,
                             Address::InstanceConstSharedPtr peer_addess,
                             Address::InstanceConstSharedPtr local_address,
@@ -551,6 +570,50 @@ void passPayloadToProcessor(uint64_t bytes_read, Buffer::InstancePtr buffer,
                                      std::move(buffer), receive_time, tos);
 }
 
+// Passes a message read with GRO to the processor, one packet per segment of gso_size bytes.
+void passGroPayloadToProcessor(uint64_t bytes_read, Buffer::InstancePtr buffer,
+                               IoHandle::RecvMsgPerPacketInfo& msg,
+                               UdpPacketProcessor& udp_packet_processor,
+                               MonotonicTime receive_time, uint32_t* num_packets_read) {
+  const uint64_t gso_size = msg.gso_size_;
+  ENVOY_LOG_MISC(trace, "gro recv bytes {} with gso_size as {}", bytes_read, gso_size);
+
+  // Skip gso segmentation and proceed as a single payload.
+  if (gso_size == 0u) {
+    if (num_packets_read != nullptr) {
+      *num_packets_read += 1;
+    }
+    passPayloadToProcessor(bytes_read, std::move(buffer), std::move(msg.peer_address_),
+                           std::move(msg.local_address_), udp_packet_processor, receive_time,
+                           msg.tos_);
+    return;
+  }
+
+  // Segment the buffer read by the syscall into gso_sized sub buffers. The sub buffers are views of
+  // the memory of the read buffer, which is released along with the last of them.
+  const uint64_t length = buffer->length();
+  if (length == 0) {
+    return;
+  }
+  const char* data = static_cast<const char*>(buffer->linearize(length));
+  std::shared_ptr<Buffer::Instance> storage = std::move(buffer);
+  for (uint64_t offset = 0; offset < length; offset += gso_size) {
+    const uint64_t segment_length = std::min(length - offset, gso_size);
+    auto* fragment = new Buffer::BufferFragmentImpl(
+        data + offset, segment_length,
+        [storage](const void*, size_t, const Buffer::BufferFragmentImpl* this_fragment) {
+          delete this_fragment;
+        });
+    Buffer::InstancePtr sub_buffer = std::make_unique<Buffer::OwnedImpl>();
+    sub_buffer->addBufferFragment(*fragment);
+    if (num_packets_read != nullptr) {
+      *num_packets_read += 1;
+    }
+    passPayloadToProcessor(segment_length, std::move(sub_buffer), msg.peer_address_,
+                           msg.local_address_, udp_packet_processor, receive_time, msg.tos_);
+  }
+}
+
 Api::IoCallUint64Result readFromSocketRecvGro(IoHandle& handle,
                                               const Address::Instance& local_address,
                                               UdpPacketProcessor& udp_packet_processor,
@@ -564,11 +627,8 @@ Api::IoCallUint64Result readFromSocketRecvGro(IoHandle& handle,
   Buffer::InstancePtr buffer = std::make_unique<Buffer::OwnedImpl>();
   IoHandle::RecvMsgOutput output(1, packets_dropped);
 
-  // TODO(yugant): Avoid allocating 64k for each read by getting memory from UdpPacketProcessor
   const uint64_t max_rx_datagram_size_with_gro =
-      num_packets_read != nullptr
-          ? 64 * 1024
-          : NUM_DATAGRAMS_PER_RECEIVE * udp_packet_processor.maxDatagramSize();
+      maxRxDatagramSizeWithGro(udp_packet_processor, num_packets_read != nullptr);
   ENVOY_LOG_MISC(trace, "starting gro recvmsg with max={}", max_rx_datagram_size_with_gro);
 
   Api::IoCallUint64Result result =
@@ -578,36 +638,8 @@ Api::IoCallUint64Result readFromSocketRecvGro(IoHandle& handle,
     return result;
   }
 
-  const uint64_t gso_size = output.msg_[0].gso_size_;
-  ENVOY_LOG_MISC(trace, "gro recvmsg bytes {} with gso_size as {}", result.return_value_, gso_size);
-
-  // Skip gso segmentation and proceed as a single payload.
-  if (gso_size == 0u) {
-    if (num_packets_read != nullptr) {
-      *num_packets_read += 1;
-    }
-    passPayloadToProcessor(result.return_value_, std::move(buffer),
-                           std::move(output.msg_[0].peer_address_),
-                           std::move(output.msg_[0].local_address_), udp_packet_processor,
-                           receive_time, output.msg_[0].tos_);
-    return result;
-  }
-
-  // Segment the buffer read by the recvmsg syscall into gso_sized sub buffers.
-  // TODO(mattklein123): The following code should be optimized to avoid buffer copies, either by
-  // switching to slices or by using a CoW buffer type.
-  while (buffer->length() > 0) {
-    const uint64_t bytes_to_copy = std::min(buffer->length(), gso_size);
-    Buffer::InstancePtr sub_buffer = std::make_unique<Buffer::OwnedImpl>();
-    sub_buffer->move(*buffer, bytes_to_copy);
-    if (num_packets_read != nullptr) {
-      *num_packets_read += 1;
-    }
-    passPayloadToProcessor(bytes_to_copy, std::move(sub_buffer), output.msg_[0].peer_address_,
-                           output.msg_[0].local_address_, udp_packet_processor, receive_time,
-                           output.msg_[0].tos_);
-  }
-
+  passGroPayloadToProcessor(result.return_value_, std::move(buffer), output.msg_[0],
+                            udp_packet_processor, receive_time, num_packets_read);
   return result;
 }
 
@@ -622,17 +654,6 @@ readFromSocketRecvMmsg(IoHandle& handle, const Address::Instance& local_address,
     *num_packets_read = 0;
   }
 
-  // Buffer::ReservationSingleSlice is always passed by value, and can only be constructed
-  // by Buffer::Instance::reserve(), so this is needed to keep a fixed array
-  // in which all elements are legally constructed.
-  struct BufferAndReservation {
-    BufferAndReservation(uint64_t max_rx_datagram_size)
-        : buffer_(std::make_unique<Buffer::OwnedImpl>()),
-          reservation_(buffer_->reserveSingleSlice(max_rx_datagram_size, true)) {}
-
-    Buffer::InstancePtr buffer_;
-    Buffer::ReservationSingleSlice reservation_;
-  };
   constexpr uint32_t num_slices_per_packet = 1u;
   absl::InlinedVector<BufferAndReservation, NUM_DATAGRAMS_PER_RECEIVE> buffers;
   RawSliceArrays slices(NUM_DATAGRAMS_PER_RECEIVE,
@@ -675,6 +696,52 @@ readFromSocketRecvMmsg(IoHandle& handle, const Address::Instance& local_address,
   return result;
 }
 
+Api::IoCallUint64Result readFromSocketRecvMmsgWithGro(
+    IoHandle& handle, const Address::Instance& local_address,
+    UdpPacketProcessor& udp_packet_processor, MonotonicTime receive_time, uint32_t num_messages,
+    uint32_t* packets_dropped, uint32_t* num_packets_read, uint32_t& num_messages_read) {
+  ASSERT(Api::OsSysCallsSingleton::get().supportsMmsg() &&
+             Api::OsSysCallsSingleton::get().supportsUdpGro(),
+         "cannot use recvmmsg with GRO when the platform doesn't support it.");
+  ASSERT(num_messages > 0 && num_messages <= MAX_NUM_GRO_MESSAGES_PER_RECEIVE);
+  if (num_packets_read != nullptr) {
+    *num_packets_read = 0;
+  }
+  num_messages_read = 0;
+
+  const uint64_t max_rx_datagram_size_with_gro =
+      maxRxDatagramSizeWithGro(udp_packet_processor, num_packets_read != nullptr);
+  absl::InlinedVector<BufferAndReservation, MAX_NUM_GRO_MESSAGES_PER_RECEIVE> buffers;
+  RawSliceArrays slices(num_messages, absl::FixedArray<Buffer::RawSlice>(1u));
+  for (uint32_t i = 0; i < num_messages; i++) {
+    buffers.push_back(max_rx_datagram_size_with_gro);
+    slices[i][0] = buffers[i].reservation_.slice();
+  }
+
+  IoHandle::RecvMsgOutput output(num_messages, packets_dropped);
+  ENVOY_LOG_MISC(trace, "starting gro recvmmsg with messages={} max={}", num_messages,
+                 max_rx_datagram_size_with_gro);
+  Api::IoCallUint64Result result = handle.recvmmsg(slices, local_address.ip()->port(), output);
+  if (!result.ok()) {
+    return result;
+  }
+
+  num_messages_read = result.return_value_;
+  ENVOY_LOG_MISC(trace, "gro recvmmsg read {} messages", num_messages_read);
+  for (uint32_t i = 0; i < num_messages_read; ++i) {
+    if (output.msg_[i].truncated_and_dropped_) {
+      continue;
+    }
+
+    const uint64_t msg_len = output.msg_[i].msg_len_;
+    ASSERT(msg_len <= slices[i][0].len_);
+    buffers[i].reservation_.commit(std::min(max_rx_datagram_size_with_gro, msg_len));
+    passGroPayloadToProcessor(msg_len, std::move(buffers[i].buffer_), output.msg_[i],
+                              udp_packet_processor, receive_time, num_packets_read);
+  }
+  return result;
+}
+
 Api::IoCallUint64Result readFromSocketRecvMsg(IoHandle& handle,
                                               const Address::Instance& local_address,
                                               UdpPacketProcessor& udp_packet_processor,
@@ -719,6 +786,11 @@ Utility::readFromSocket(IoHandle& handle, const Address::Instance& local_address
   } else if (recv_msg_method == UdpRecvMsgMethod::RecvMmsg) {
     return readFromSocketRecvMmsg(handle, local_address, udp_packet_processor, receive_time,
                                   packets_dropped, num_packets_read);
+  } else if (recv_msg_method == UdpRecvMsgMethod::RecvMmsgWithGro) {
+    uint32_t num_messages_read;
+    return readFromSocketRecvMmsgWithGro(handle, local_address, udp_packet_processor,
+                                         receive_time, MAX_NUM_GRO_MESSAGES_PER_RECEIVE,
+                                         packets_dropped, num_packets_read, num_messages_read);
   }
   return readFromSocketRecvMsg(handle, local_address, udp_packet_processor, receive_time,
                                packets_dropped, num_packets_read);
@@ -731,7 +803,12 @@ Api::IoErrorPtr Utility::readPacketsFromSocket(IoHandle& handle,
                                                bool allow_mmsg, uint32_t& packets_dropped) {
   UdpRecvMsgMethod recv_msg_method = UdpRecvMsgMethod::RecvMsg;
   if (allow_gro && handle.supportsUdpGro()) {
-    recv_msg_method = UdpRecvMsgMethod::RecvMsgWithGro;
+    recv_msg_method =
+        allow_mmsg &&
+                Runtime::runtimeFeatureEnabled("envoy.reloadable_features.udp_recvmmsg_with_gro") &&
+                handle.supportsMmsg()
+            ? UdpRecvMsgMethod::RecvMmsgWithGro
+            : UdpRecvMsgMethod::RecvMsgWithGro;
   } else if (allow_mmsg && handle.supportsMmsg()) {
     recv_msg_method = UdpRecvMsgMethod::RecvMmsg;
   }
@@ -749,6 +826,7 @@ Api::IoErrorPtr Utility::readPacketsFromSocket(IoHandle& handle,
   } else {
     switch (recv_msg_method) {
     case UdpRecvMsgMethod::RecvMsgWithGro:
+    case UdpRecvMsgMethod::RecvMmsgWithGro:
       num_reads = (num_packets_to_read / NUM_DATAGRAMS_PER_RECEIVE);
       break;
     case UdpRecvMsgMethod::RecvMmsg:
@@ -762,19 +840,38 @@ Api::IoErrorPtr Utility::readPacketsFromSocket(IoHandle& handle,
     num_reads = std::max<size_t>(1, num_reads);
   }
 
+  // The number of coalesced messages read per recvmmsg call with GRO. It starts with a single
+  // message, as with recvmsg, grows while the calls fill all of their messages and shrinks when
+  // they fill at most half of them, so that the memory reserved for a call follows the load.
+  uint32_t num_gro_messages = 1;
   do {
     const uint32_t old_packets_dropped = packets_dropped;
     uint32_t num_packets_processed = 0;
     const MonotonicTime receive_time = time_source.monotonicTime();
-    Api::IoCallUint64Result result = Utility::readFromSocket(
-        handle, local_address, udp_packet_processor, receive_time, recv_msg_method,
-        &packets_dropped, apply_read_limit_differently ? &num_packets_processed : nullptr);
+    uint32_t* num_packets_read = apply_read_limit_differently ? &num_packets_processed : nullptr;
+    uint32_t num_gro_messages_read = 0;
+    Api::IoCallUint64Result result =
+        recv_msg_method == UdpRecvMsgMethod::RecvMmsgWithGro
+            ? readFromSocketRecvMmsgWithGro(handle, local_address, udp_packet_processor,
+                                            receive_time, num_gro_messages, &packets_dropped,
+                                            num_packets_read, num_gro_messages_read)
+            : Utility::readFromSocket(handle, local_address, udp_packet_processor, receive_time,
+                                      recv_msg_method, &packets_dropped, num_packets_read);
 
     if (!result.ok()) {
       // No more to read or encountered a system error.
       return std::move(result.err_);
     }
 
+    if (recv_msg_method == UdpRecvMsgMethod::RecvMmsgWithGro) {
+      if (num_gro_messages_read == num_gro_messages) {
+        num_gro_messages =
+            std::min<uint32_t>(2 * num_gro_messages, MAX_NUM_GRO_MESSAGES_PER_RECEIVE);
+      } else if (2 * num_gro_messages_read <= num_gro_messages) {
+        num_gro_messages = std::max<uint32_t>(num_gro_messages / 2, 1);
+      }
+    }
+
     if (packets_dropped != old_packets_dropped) {
       // The kernel tracks SO_RXQ_OVFL as a uint32 which can overflow to a smaller
       // value. So as long as this count differs from previously recorded value,
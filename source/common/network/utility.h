@@ -57,6 +57,8 @@ public:
 
 static const uint64_t DEFAULT_UDP_MAX_DATAGRAM_SIZE = 1500;
 static const uint64_t NUM_DATAGRAMS_PER_RECEIVE = 16;
+// The maximum number of GRO coalesced messages read by one recvmmsg call.
+static const uint64_t MAX_NUM_GRO_MESSAGES_PER_RECEIVE = 8;
 static const uint64_t MAX_NUM_PACKETS_PER_EVENT_LOOP = 6000;
 
 /**
@@ -79,6 +81,8 @@ enum class UdpRecvMsgMethod {
   RecvMsgWithGro,
   // The `recvmmsg` system call.
   RecvMmsg,
+  // The `recvmmsg` system call using GRO, reading several coalesced messages per call.
+  RecvMmsgWithGro,
 };
 
 /**
@@ -334,7 +338,10 @@ public:
    * the IoHandle to ensure the platform supports GRO before using it.
    * @param allow_mmsg whether to use recvmmsg, iff the platform supports it. This function will
    * check the IoHandle to ensure the platform supports recvmmsg before using it. If `allow_gro` is
-   * true and the platform supports GRO, then it will take precedence over using recvmmsg.
+   * true and the platform supports GRO, then it will take precedence over using recvmmsg, unless
+   * the runtime feature "envoy.reloadable_features.udp_recvmmsg_with_gro" is enabled, in which case
+   * both are combined. The number of coalesced messages read per recvmmsg call then follows how
+   * many the previous call returned, up to MAX_NUM_GRO_MESSAGES_PER_RECEIVE.
    * @param packets_dropped is the output parameter for number of packets dropped in kernel.
    * Return the io error encountered or nullptr if no io error but read stopped
    * because of MAX_NUM_PACKETS_PER_EVENT_LOOP.
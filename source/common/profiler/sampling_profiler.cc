@@ -0,0 +1,192 @@
+#include "source/common/profiler/sampling_profiler.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <fstream>
+#include <sstream>
+#include <vector>
+
+#include "source/common/profiler/profiler.h"
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/debugging/stacktrace.h"
+
+#ifdef __linux__
+#include <signal.h>
+#include <sys/time.h>
+#include <ucontext.h>
+#endif
+
+namespace Envoy {
+namespace Profiler {
+namespace {
+
+constexpr int MaxDepth = 64;
+
+// A sample of the ring. Its sequence is odd while a signal handler writes it, and is bumped again
+// once done, so that the samples being written while the profile is read can be skipped.
+struct Sample {
+  std::atomic<uint64_t> sequence{0};
+  std::atomic<int> depth{0};
+  std::atomic<void*> pcs[MaxDepth]{};
+};
+
+struct Ring {
+  Sample samples[SamplingProfiler::MaxSamples];
+  std::atomic<uint64_t> next{0};
+};
+
+// Allocated on the first start and never freed, as a pending signal may be handled after a stop.
+std::atomic<Ring*> ring_{nullptr};
+std::atomic<bool> started_{false};
+uint64_t period_us_ = 0;
+
+#ifdef __linux__
+// The address of the instruction which was interrupted, which isn't part of the stack trace.
+void* interruptedPc(void* ucontext) {
+  [[maybe_unused]] const mcontext_t& mcontext = static_cast<ucontext_t*>(ucontext)->uc_mcontext;
+#if defined(__x86_64__)
+  return reinterpret_cast<void*>(mcontext.gregs[REG_RIP]);
+#elif defined(__aarch64__)
+  return reinterpret_cast<void*>(mcontext.pc);
+#else
+  return nullptr;
+#endif
+}
+
+void handleSignal(int, siginfo_t*, void* ucontext) {
+  Ring* ring = ring_.load(std::memory_order_acquire);
+  if (ring == nullptr) {
+    return;
+  }
+  const int saved_errno = errno;
+
+  void* pcs[MaxDepth];
+  int depth = 0;
+  if (void* pc = interruptedPc(ucontext); pc != nullptr) {
+    pcs[depth++] = pc;
+  }
+  // The return address of the handler, in the signal trampoline, is skipped.
+  depth += absl::GetStackTraceWithContext(pcs + depth, MaxDepth - 1 - depth, /* skip_count = */ 1,
+                                          ucontext, nullptr);
+  if (const ScopeTrackedObject* object = SamplingProfiler::trackedObject(); object != nullptr) {
+    // The first word of the object is its vtable pointer, which identifies its class.
+    pcs[depth++] = *reinterpret_cast<void* const*>(object);
+  }
+
+  const uint64_t slot = ring->next.fetch_add(1, std::memory_order_relaxed);
+  Sample& sample = ring->samples[slot % SamplingProfiler::MaxSamples];
+  uint64_t sequence = sample.sequence.load(std::memory_order_relaxed);
+  // The sample is dropped if another thread is still writing the slot, after the ring wrapped.
+  if (sequence % 2 == 0 &&
+      sample.sequence.compare_exchange_strong(sequence, sequence + 1, std::memory_order_relaxed)) {
+    std::atomic_thread_fence(std::memory_order_release);
+    for (int i = 0; i < depth; ++i) {
+      sample.pcs[i].store(pcs[i], std::memory_order_relaxed);
+    }
+    sample.depth.store(depth, std::memory_order_relaxed);
+    sample.sequence.store(sequence + 2, std::memory_order_release);
+  }
+  errno = saved_errno;
+}
+#endif
+
+} // namespace
+
+bool SamplingProfiler::start([[maybe_unused]] uint32_t frequency) {
+#ifdef __linux__
+  if (started() || frequency == 0 || Cpu::profilerEnabled()) {
+    return false;
+  }
+  Ring* ring = ring_.load(std::memory_order_acquire);
+  if (ring == nullptr) {
+    ring_.store(new Ring(), std::memory_order_release);
+  } else {
+    for (Sample& sample : ring->samples) {
+      sample.sequence.store(0, std::memory_order_relaxed);
+    }
+  }
+  period_us_ = std::max<uint64_t>(1000000 / frequency, 1);
+
+  struct sigaction action = {};
+  action.sa_sigaction = handleSignal;
+  action.sa_flags = SA_RESTART | SA_SIGINFO;
+  sigemptyset(&action.sa_mask);
+  if (sigaction(SIGPROF, &action, nullptr) != 0) {
+    return false;
+  }
+  struct itimerval timer = {};
+  timer.it_interval.tv_sec = period_us_ / 1000000;
+  timer.it_interval.tv_usec = period_us_ % 1000000;
+  timer.it_value = timer.it_interval;
+  if (setitimer(ITIMER_PROF, &timer, nullptr) != 0) {
+    signal(SIGPROF, SIG_IGN);
+    return false;
+  }
+  started_ = true;
+  return true;
+#else
+  return false;
+#endif
+}
+
+void SamplingProfiler::stop() {
+#ifdef __linux__
+  if (!started()) {
+    return;
+  }
+  struct itimerval timer = {};
+  setitimer(ITIMER_PROF, &timer, nullptr);
+  // A signal which is still pending is discarded instead of terminating the process.
+  signal(SIGPROF, SIG_IGN);
+  started_ = false;
+#endif
+}
+
+bool SamplingProfiler::started() { return started_; }
+
+absl::StatusOr<std::string> SamplingProfiler::profile() {
+  Ring* ring = ring_.load(std::memory_order_acquire);
+  if (!started() || ring == nullptr) {
+    return absl::FailedPreconditionError("the continuous profiler isn't started");
+  }
+
+  // The identical stacks are aggregated.
+  absl::flat_hash_map<std::vector<uintptr_t>, uint64_t> counts;
+  for (const Sample& sample : ring->samples) {
+    const uint64_t sequence = sample.sequence.load(std::memory_order_acquire);
+    if (sequence == 0 || sequence % 2 == 1) {
+      continue;
+    }
+    std::vector<uintptr_t> pcs(std::min(sample.depth.load(std::memory_order_relaxed), MaxDepth));
+    for (size_t i = 0; i < pcs.size(); ++i) {
+      pcs[i] = reinterpret_cast<uintptr_t>(sample.pcs[i].load(std::memory_order_relaxed));
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (pcs.empty() || sample.sequence.load(std::memory_order_relaxed) != sequence) {
+      continue;
+    }
+    ++counts[std::move(pcs)];
+  }
+
+  // See https://github.com/gperftools/gperftools/blob/master/docs/cpuprofile-fileformat.html.
+  std::vector<uintptr_t> words = {0, 3, 0, period_us_, 0};
+  for (const auto& [pcs, count] : counts) {
+    words.push_back(count);
+    words.push_back(pcs.size());
+    words.insert(words.end(), pcs.begin(), pcs.end());
+  }
+  words.insert(words.end(), {0, 1, 0});
+
+  std::string profile(reinterpret_cast<const char*>(words.data()),
+                      words.size() * sizeof(uintptr_t));
+  std::ifstream maps("/proc/self/maps");
+  std::stringstream maps_contents;
+  maps_contents << maps.rdbuf();
+  profile += maps_contents.str();
+  return profile;
+}
+
+} // namespace Profiler
+} // namespace Envoy
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include "envoy/common/scope_tracker.h"
+
+#include "absl/status/statusor.h"
+
+namespace Envoy {
+namespace Profiler {
+
+/**
+ * Process wide CPU profiling which is cheap enough to be left running in production. The threads
+ * are sampled on SIGPROF at a low frequency of their CPU time, and the most recent samples are kept
+ * in a fixed ring, without any allocation or lock in the signal handler. Only available on Linux.
+ *
+ * Each sample is tagged with the object tracked by the dispatcher of the thread when it was taken,
+ * e.g. the stream or the connection being processed, so that the time spent on behalf of each kind
+ * of object can be told apart in the profile.
+ */
+class SamplingProfiler {
+public:
+  // The number of samples kept in the ring.
+  static constexpr uint32_t MaxSamples = 4096;
+
+  /**
+   * Start sampling the threads. It fails if the profiler is already started, if the gperftools CPU
+   * profiler is enabled, as both rely on SIGPROF, or if the platform isn't supported.
+   * @param frequency the number of samples per second of CPU time.
+   * @return bool whether the profiler was started.
+   */
+  static bool start(uint32_t frequency);
+
+  /**
+   * Stop sampling the threads and drop the samples.
+   */
+  static void stop();
+
+  /**
+   * @return whether the profiler is started or not.
+   */
+  static bool started();
+
+  /**
+   * @return the samples in the ring in the legacy CPU profile format of gperftools, followed by the
+   *         memory mappings of the process, which the pprof tool can read without Envoy's binary
+   *         being symbolized. The tag of a sample is its outermost frame: the address of the
+   *         vtable of the tracked object. An error is returned if the profiler isn't started.
+   */
+  static absl::StatusOr<std::string> profile();
+
+  /**
+   * Set the object tracked by the dispatcher of the calling thread, or nullptr if there is none.
+   */
+  static void setTrackedObject(const ScopeTrackedObject* object) { tracked_object_ = object; }
+
+  /**
+   * @return the object tracked by the dispatcher of the calling thread.
+   */
+  static const ScopeTrackedObject* trackedObject() { return tracked_object_; }
+
+private:
+  static inline thread_local const ScopeTrackedObject* tracked_object_ = nullptr;
+};
+
+} // namespace Profiler
+} // namespace Envoy
@@ -4,10 +4,17 @@
 #include "source/common/common/assert.h"
 #include "source/common/common/hash.h"
 
+#include "absl/container/flat_hash_map.h"
+#include "absl/container/flat_hash_set.h"
+
 namespace Envoy {
 namespace DeterministicProtoHash {
 namespace {
 
+// The most contents of Any fields whose hashes are memoized by each thread, before the memo is
+// cleared.
+constexpr size_t MaxMemoizedAnyHashes = 4096;
+
 // Get a scalar field from protobuf reflection field definition. The return
 // type must be specified by the caller. Every implementation is a specialization
 // because the reflection interface did separate named functions instead of a
@@ -193,6 +200,62 @@ std::unique_ptr<Protobuf::Message> unpackAnyForReflection(const ProtobufWkt::Any
   return msg;
 }
 
+// Whether the messages of the type, and all the messages they may contain, have no map nor Any
+// fields. The serialization of such a message is canonical, since the fields are serialized in
+// field number order, so it can be hashed rather than reflected over.
+bool reachesNoMapNorAny(const Protobuf::Descriptor& descriptor,
+                        absl::flat_hash_set<const Protobuf::Descriptor*>& visited) {
+  if (descriptor.well_known_type() == Protobuf::Descriptor::WELLKNOWNTYPE_ANY) {
+    return false;
+  }
+  if (!visited.insert(&descriptor).second) {
+    return true;
+  }
+  for (int i = 0; i < descriptor.field_count(); i++) {
+    const Protobuf::FieldDescriptor& field = *descriptor.field(i);
+    if (field.is_map() ||
+        (field.cpp_type() == Protobuf::FieldDescriptor::CPPTYPE_MESSAGE &&
+         !reachesNoMapNorAny(*field.message_type(), visited))) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool isWireHashable(const Protobuf::Descriptor& descriptor) {
+  static thread_local absl::flat_hash_map<const Protobuf::Descriptor*, bool> wire_hashable;
+  auto it = wire_hashable.find(&descriptor);
+  if (it == wire_hashable.end()) {
+    absl::flat_hash_set<const Protobuf::Descriptor*> visited;
+    it = wire_hashable.emplace(&descriptor, reachesNoMapNorAny(descriptor, visited)).first;
+  }
+  return it->second;
+}
+
+// Hashes the contents of the Any, with a hash which doesn't depend on its type url prefix nor on
+// how its value was serialized. The xDS resources often share the same typed configs, so the
+// hashes are memoized by the serialized bytes, rather than unpacked and reflected over each time.
+uint64_t hashAny(const ProtobufWkt::Any& any) {
+  static thread_local absl::flat_hash_map<uint64_t, uint64_t> memo;
+  const uint64_t bytes_hash = HashUtil::xxHash64(any.value(), HashUtil::xxHash64(any.type_url()));
+  auto it = memo.find(bytes_hash);
+  if (it != memo.end()) {
+    return it->second;
+  }
+  std::unique_ptr<Protobuf::Message> submsg = unpackAnyForReflection(any);
+  if (submsg == nullptr) {
+    // If we wanted to handle unknown types in Any, this is where we'd have to do it.
+    // Since we don't know the type to introspect it, we hash just its type name.
+    return HashUtil::xxHash64(any.type_url());
+  }
+  const uint64_t hash = reflectionHashMessage(*submsg);
+  if (memo.size() >= MaxMemoizedAnyHashes) {
+    memo.clear();
+  }
+  memo.emplace(bytes_hash, hash);
+  return hash;
+}
+
 // This is intentionally ignoring unknown fields.
 uint64_t reflectionHashMessage(const Protobuf::Message& message, uint64_t seed) {
   using Protobuf::FieldDescriptor;
@@ -202,13 +265,11 @@ uint64_t reflectionHashMessage(const Protobuf::Message& message, uint64_t seed)
   if (descriptor->well_known_type() == Protobuf::Descriptor::WELLKNOWNTYPE_ANY) {
     const ProtobufWkt::Any* any = Protobuf::DynamicCastToGenerated<ProtobufWkt::Any>(&message);
     ASSERT(any != nullptr, "casting to any should always work for WELLKNOWNTYPE_ANY");
-    std::unique_ptr<Protobuf::Message> submsg = unpackAnyForReflection(*any);
-    if (submsg == nullptr) {
-      // If we wanted to handle unknown types in Any, this is where we'd have to do it.
-      // Since we don't know the type to introspect it, we hash just its type name.
-      return HashUtil::xxHash64(any->type_url(), seed);
-    }
-    return reflectionHashMessage(*submsg, seed);
+    return HashUtil::xxHash64Value(hashAny(*any), seed);
+  }
+  if (isWireHashable(*descriptor)) {
+    // The serialization is length delimited, so it needs no end of message marker.
+    return HashUtil::xxHash64(message.SerializeAsString(), seed);
   }
   std::vector<const FieldDescriptor*> fields;
   // ListFields returned the fields ordered by field number.
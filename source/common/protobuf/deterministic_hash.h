@@ -19,6 +19,12 @@ namespace DeterministicProtoHash {
 // collisions if unknown fields are present and are not ignored by the
 // corresponding comparator. A `MessageDifferencer` can be configured to
 // ignore unknown fields, or not to.
+//
+// The messages which have no map nor Any fields, nor any message type they may contain, are hashed
+// by their serialization rather than by reflection, which is a lot faster. Their unknown fields
+// are then hashed too, which may only make otherwise equal messages hash differently. The hashes
+// of the contents of Any fields are memoized by their serialized bytes for each thread, since the
+// same typed configs show up in many resources.
 uint64_t hash(const Protobuf::Message& message);
 
 } // namespace DeterministicProtoHash
@@ -937,7 +937,9 @@ void MessageUtil::loadFromFile(const std::string& path, Protobuf::Message& messa
                                Api::Api& api) {
   auto file_or_error = api.fileSystem().fileReadToEnd(path);
   THROW_IF_STATUS_NOT_OK(file_or_error, throw);
-  const std::string contents = file_or_error.value();
+  // The contents can be large, and aren't needed after parsing, so they are moved out rather than
+  // copied.
+  const std::string contents = std::move(file_or_error.value());
   // If the filename ends with .pb, attempt to parse it as a binary proto.
   if (absl::EndsWithIgnoreCase(path, FileExtensions::get().ProtoBinary)) {
     // Attempt to parse the binary format.
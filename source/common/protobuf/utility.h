@@ -624,6 +624,11 @@ public:
    * Load YAML string into ProtobufWkt::Value.
    */
   static ProtobufWkt::Value loadFromYaml(const std::string& yaml);
+
+  /**
+   * Load YAML string into the ProtobufWkt::Value, which may be allocated on an arena.
+   */
+  static void loadFromYaml(const std::string& yaml, ProtobufWkt::Value& value);
 #endif
 
   /**
@@ -42,8 +42,9 @@ void blockFormat(YAML::Node node) {
   }
 }
 
-ProtobufWkt::Value parseYamlNode(const YAML::Node& node) {
-  ProtobufWkt::Value value;
+// Parses the node into the value in place, so that a value allocated on an arena gets its whole
+// tree on the arena.
+void parseYamlNode(const YAML::Node& node, ProtobufWkt::Value& value) {
   switch (node.Type()) {
   case YAML::NodeType::Null:
     value.set_null_value(ProtobufWkt::NULL_VALUE);
@@ -80,7 +81,7 @@ ProtobufWkt::Value parseYamlNode(const YAML::Node& node) {
   case YAML::NodeType::Sequence: {
     auto& list_values = *value.mutable_list_value()->mutable_values();
     for (const auto& it : node) {
-      *list_values.Add() = parseYamlNode(it);
+      parseYamlNode(it, *list_values.Add());
     }
     break;
   }
@@ -88,7 +89,10 @@ ProtobufWkt::Value parseYamlNode(const YAML::Node& node) {
     auto& struct_fields = *value.mutable_struct_value()->mutable_fields();
     for (const auto& it : node) {
       if (it.first.Tag() != "!ignore") {
-        struct_fields[it.first.as<std::string>()] = parseYamlNode(it.second);
+        // A repeated key replaces the earlier value.
+        ProtobufWkt::Value& field = struct_fields[it.first.as<std::string>()];
+        field.Clear();
+        parseYamlNode(it.second, field);
       }
     }
     break;
@@ -96,7 +100,6 @@ ProtobufWkt::Value parseYamlNode(const YAML::Node& node) {
   case YAML::NodeType::Undefined:
     throw EnvoyException("Undefined YAML value");
   }
-  return value;
 }
 
 void jsonConvertInternal(const Protobuf::Message& source,
@@ -171,7 +174,11 @@ void MessageUtil::loadFromJson(const std::string& json, ProtobufWkt::Struct& mes
 
 void MessageUtil::loadFromYaml(const std::string& yaml, Protobuf::Message& message,
                                ProtobufMessage::ValidationVisitor& validation_visitor) {
-  ProtobufWkt::Value value = ValueUtil::loadFromYaml(yaml);
+  // The value is only an intermediate of the conversion, so its tree is allocated on an arena, to
+  // be freed at once rather than node by node.
+  Protobuf::Arena arena;
+  ProtobufWkt::Value& value = *Protobuf::Arena::Create<ProtobufWkt::Value>(&arena);
+  ValueUtil::loadFromYaml(yaml, value);
   if (value.kind_case() == ProtobufWkt::Value::kStructValue ||
       value.kind_case() == ProtobufWkt::Value::kListValue) {
     jsonConvertInternal(value, validation_visitor, message);
@@ -277,7 +284,13 @@ bool MessageUtil::jsonConvertValue(const Protobuf::Message& source, ProtobufWkt:
 }
 
 ProtobufWkt::Value ValueUtil::loadFromYaml(const std::string& yaml) {
-  TRY_ASSERT_MAIN_THREAD { return parseYamlNode(YAML::Load(yaml)); }
+  ProtobufWkt::Value value;
+  loadFromYaml(yaml, value);
+  return value;
+}
+
+void ValueUtil::loadFromYaml(const std::string& yaml, ProtobufWkt::Value& value) {
+  TRY_ASSERT_MAIN_THREAD { parseYamlNode(YAML::Load(yaml), value); }
   END_TRY
   catch (YAML::ParserException& e) {
     throw EnvoyException(e.what());
@@ -20,7 +20,9 @@
 #include "source/common/quic/envoy_quic_proof_source.h"
 #include "source/common/quic/envoy_quic_utils.h"
 #include "source/common/quic/quic_network_connection.h"
+#include "source/common/quic/udp_gso_batch_writer.h"
 #include "source/common/runtime/runtime_features.h"
+#include "source/common/tls/cert_compression.h"
 
 namespace Envoy {
 namespace Quic {
@@ -63,6 +65,10 @@ ActiveQuicListener::ActiveQuicListener(
       proof_source_factory.createQuicProofSource(
           listen_socket_, listener_config.filterChainManager(), stats_, dispatcher.timeSource()),
       quic::KeyExchangeSource::Default());
+  // The certificate chains are the bulk of the first flight of the server, which the amplification
+  // limit bounds until the address of the client is validated.
+  Extensions::TransportSockets::Tls::CertCompression::registerAlgorithms(
+      crypto_config_->ssl_ctx());
   auto connection_helper = std::make_unique<EnvoyQuicConnectionHelper>(dispatcher_);
   crypto_config_->AddDefaultConfig(random, connection_helper->GetClock(),
                                    quic::QuicCryptoServerConfig::ConfigOptions());
@@ -103,8 +109,17 @@ ActiveQuicListener::ActiveQuicListener(
   // `EnvoyQuicPacketWriter` as an adapter.
   auto* quic_packet_writer = dynamic_cast<quic::QuicPacketWriter*>(udp_packet_writer.get());
   if (quic_packet_writer != nullptr) {
-    quic_dispatcher_->InitializeWithWriter(quic_packet_writer);
     udp_packet_writer.release();
+#if UDP_GSO_BATCH_WRITER_COMPILETIME_SUPPORT
+    // A writer batching across connections is flushed once per event loop iteration rather than
+    // by every connection.
+    auto* gso_batch_writer = dynamic_cast<UdpGsoBatchWriter*>(quic_packet_writer);
+    if (gso_batch_writer != nullptr && gso_batch_writer->batchAcrossConnections()) {
+      quic_packet_writer = new EnvoyQuicDeferredFlushPacketWriter(
+          std::unique_ptr<quic::QuicPacketWriter>(quic_packet_writer), dispatcher);
+    }
+#endif
+    quic_dispatcher_->InitializeWithWriter(quic_packet_writer);
   } else {
     quic_dispatcher_->InitializeWithWriter(new EnvoyQuicPacketWriter(std::move(udp_packet_writer)));
   }
@@ -396,7 +411,7 @@ Network::ConnectionHandler::ActiveUdpListenerPtr ActiveQuicListenerFactory::crea
       quic_config_, kernel_worker_routing_, enabled_, quic_stat_names_,
       packets_to_read_to_connection_count_ratio_, crypto_server_stream_factory_.value(),
       proof_source_factory_.value(),
-      quic_cid_generator_factory_->createQuicConnectionIdGenerator(worker_index));
+      quic_cid_generator_factory_->createQuicConnectionIdGenerator(worker_index, concurrency_));
 }
 Network::ConnectionHandler::ActiveUdpListenerPtr
 ActiveQuicListenerFactory::createActiveQuicListener(
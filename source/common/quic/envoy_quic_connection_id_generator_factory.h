@@ -27,8 +27,10 @@ public:
    * Create a connection ID generator object.
    * @param worker_index an index to be encoded to QUIC connection ID for routing packets to the
    * current listener.
+   * @param concurrency the total number of worker threads.
    */
-  virtual QuicConnectionIdGeneratorPtr createQuicConnectionIdGenerator(uint32_t worker_index) PURE;
+  virtual QuicConnectionIdGeneratorPtr createQuicConnectionIdGenerator(uint32_t worker_index,
+                                                                       uint32_t concurrency) PURE;
 
   /**
    * Create a socket option with BPF program to consistently route QUIC packets to the right listen
@@ -74,5 +74,32 @@ quic::WriteResult EnvoyQuicPacketWriter::Flush() {
   return convertToQuicWriteResult(result);
 }
 
+EnvoyQuicDeferredFlushPacketWriter::EnvoyQuicDeferredFlushPacketWriter(
+    std::unique_ptr<quic::QuicPacketWriter> writer, Event::Dispatcher& dispatcher)
+    : writer_(std::move(writer)), flush_cb_(dispatcher.createSchedulableCallback([this]() {
+        flush();
+      })) {}
+
+void EnvoyQuicDeferredFlushPacketWriter::SetWritable() {
+  writer_->SetWritable();
+  // Send the packets buffered while the socket was blocked.
+  flush_cb_->scheduleCallbackCurrentIteration();
+}
+
+quic::WriteResult EnvoyQuicDeferredFlushPacketWriter::Flush() {
+  flush_cb_->scheduleCallbackCurrentIteration();
+  return {quic::WRITE_STATUS_OK, 0};
+}
+
+void EnvoyQuicDeferredFlushPacketWriter::flush() {
+  const quic::WriteResult result = writer_->Flush();
+  if (result.status != quic::WRITE_STATUS_OK) {
+    // A blocked writer keeps the packets and is flushed again once writable, the connections
+    // see errors when they next write.
+    ENVOY_LOG(debug, "Deferred flush failed with status {} and error code {}",
+              static_cast<int>(result.status), result.error_code);
+  }
+}
+
 } // namespace Quic
 } // namespace Envoy
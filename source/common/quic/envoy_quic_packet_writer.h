@@ -1,7 +1,10 @@
 #pragma once
 
+#include "envoy/event/dispatcher.h"
 #include "envoy/network/udp_packet_writer_handler.h"
 
+#include "source/common/common/logger.h"
+
 #include "quiche/quic/core/quic_packet_writer.h"
 
 namespace Envoy {
@@ -36,5 +39,50 @@ private:
   Network::UdpPacketWriterPtr envoy_udp_packet_writer_;
 };
 
+/**
+ * Wraps a batch writer to defer the flushes of the connections to the end of the current event
+ * loop iteration, so that the packets of all the connections written to in the iteration are sent
+ * together.
+ */
+class EnvoyQuicDeferredFlushPacketWriter : public quic::QuicPacketWriter,
+                                           protected Logger::Loggable<Logger::Id::quic> {
+public:
+  EnvoyQuicDeferredFlushPacketWriter(std::unique_ptr<quic::QuicPacketWriter> writer,
+                                     Event::Dispatcher& dispatcher);
+
+  // quic::QuicPacketWriter
+  quic::WriteResult WritePacket(const char* buffer, size_t buf_len,
+                                const quic::QuicIpAddress& self_address,
+                                const quic::QuicSocketAddress& peer_address,
+                                quic::PerPacketOptions* options,
+                                const quic::QuicPacketWriterParams& params) override {
+    return writer_->WritePacket(buffer, buf_len, self_address, peer_address, options, params);
+  }
+  bool IsWriteBlocked() const override { return writer_->IsWriteBlocked(); }
+  void SetWritable() override;
+  bool IsBatchMode() const override { return writer_->IsBatchMode(); }
+  bool SupportsReleaseTime() const override { return writer_->SupportsReleaseTime(); }
+  bool SupportsEcn() const override { return writer_->SupportsEcn(); }
+  absl::optional<int> MessageTooBigErrorCode() const override {
+    return writer_->MessageTooBigErrorCode();
+  }
+  quic::QuicByteCount GetMaxPacketSize(const quic::QuicSocketAddress& peer_address) const override {
+    return writer_->GetMaxPacketSize(peer_address);
+  }
+  quic::QuicPacketBuffer
+  GetNextWriteLocation(const quic::QuicIpAddress& self_address,
+                       const quic::QuicSocketAddress& peer_address) override {
+    return writer_->GetNextWriteLocation(self_address, peer_address);
+  }
+  // Schedules the flush of the wrapped writer, and reports success.
+  quic::WriteResult Flush() override;
+
+private:
+  void flush();
+
+  std::unique_ptr<quic::QuicPacketWriter> writer_;
+  Event::SchedulableCallbackPtr flush_cb_;
+};
+
 } // namespace Quic
 } // namespace Envoy
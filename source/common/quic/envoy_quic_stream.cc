@@ -1,5 +1,8 @@
 #include "source/common/quic/envoy_quic_stream.h"
 
+#include <algorithm>
+
+#include "source/common/buffer/buffer_impl.h"
 #include "source/common/http/utility.h"
 
 #include "quiche/quic/core/http/http_encoder.h"
@@ -9,6 +12,61 @@
 namespace Envoy {
 namespace Quic {
 
+namespace {
+
+// Keeps the body slices of a write while QUICHE refers to them, instead of copying them into its
+// send buffer. QUICHE releases the slices as they are acknowledged, mostly in order: the released
+// slices at the front are freed right away, the others with the last of those in front of them.
+// It deletes itself once all the slices are released.
+class BodySlices {
+public:
+  static void wrap(Buffer::Instance& data,
+                   absl::InlinedVector<quiche::QuicheMemSlice, 4>& quic_slices) {
+    auto* body_slices = new BodySlices(data);
+    quic_slices.reserve(body_slices->slices_.size());
+    for (const SliceState& slice : body_slices->slices_) {
+      quic_slices.emplace_back(slice.data_, slice.length_, [body_slices](const char* data) {
+        body_slices->release(data);
+      });
+    }
+  }
+
+private:
+  struct SliceState {
+    const char* data_;
+    uint64_t length_;
+    bool released_;
+  };
+
+  explicit BodySlices(Buffer::Instance& data) {
+    buffer_.move(data);
+    for (const Buffer::RawSlice& slice : buffer_.getRawSlices()) {
+      slices_.push_back({static_cast<const char*>(slice.mem_), slice.len_, false});
+    }
+  }
+
+  void release(const char* data) {
+    auto it = std::find_if(slices_.begin() + released_front_, slices_.end(),
+                           [data](const SliceState& slice) { return slice.data_ == data; });
+    ASSERT(it != slices_.end() && !it->released_);
+    it->released_ = true;
+    while (released_front_ < slices_.size() && slices_[released_front_].released_) {
+      buffer_.drain(slices_[released_front_].length_);
+      ++released_front_;
+    }
+    if (released_front_ == slices_.size()) {
+      delete this;
+    }
+  }
+
+  Buffer::OwnedImpl buffer_;
+  absl::InlinedVector<SliceState, 4> slices_;
+  // The number of slices at the front which are released and drained from the buffer.
+  size_t released_front_{0};
+};
+
+} // namespace
+
 void EnvoyQuicStream::encodeData(Buffer::Instance& data, bool end_stream) {
   ENVOY_STREAM_LOG(debug, "encodeData (end_stream={}) of {} bytes.", *this, end_stream,
                    data.length());
@@ -32,23 +90,10 @@ void EnvoyQuicStream::encodeData(Buffer::Instance& data, bool end_stream) {
     }
   } else {
 #endif
-    Buffer::RawSliceVector raw_slices = data.getRawSlices();
+    // The slices are handed to QUICHE as they are, sharing a single holder.
     absl::InlinedVector<quiche::QuicheMemSlice, 4> quic_slices;
-    quic_slices.reserve(raw_slices.size());
-    for (auto& slice : raw_slices) {
-      ASSERT(slice.len_ != 0);
-      // Move each slice into a stand-alone buffer.
-      // TODO(danzh): investigate the cost of allocating one buffer per slice.
-      // If it turns out to be expensive, add a new function to free data in the middle in buffer
-      // interface and re-design QuicheMemSliceImpl.
-      auto single_slice_buffer = std::make_unique<Buffer::OwnedImpl>();
-      single_slice_buffer->move(data, slice.len_);
-      quic_slices.emplace_back(
-          reinterpret_cast<char*>(slice.mem_), slice.len_,
-          [single_slice_buffer = std::move(single_slice_buffer)](const char*) mutable {
-            // Free this memory explicitly when the callback is invoked.
-            single_slice_buffer = nullptr;
-          });
+    if (has_data) {
+      BodySlices::wrap(data, quic_slices);
     }
     quic::QuicConsumedData result{0, false};
     absl::Span<quiche::QuicheMemSlice> span(quic_slices);
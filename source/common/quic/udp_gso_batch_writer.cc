@@ -1,11 +1,85 @@
 #include "source/common/quic/udp_gso_batch_writer.h"
 
+#include <vector>
+
+#include "envoy/common/platform.h"
+
+#include "source/common/api/os_sys_calls_impl.h"
 #include "source/common/network/io_socket_error_impl.h"
 #include "source/common/quic/envoy_quic_utils.h"
 
+#include "absl/container/fixed_array.h"
+
 namespace Envoy {
 namespace Quic {
 namespace {
+
+// The kernel limits the number of segments of a GSO message.
+constexpr size_t MaxSegmentsPerGsoMessage = 64;
+// The largest UDP payload of an IPv4 packet.
+constexpr size_t MaxGsoMessageSize = 65507;
+// The control messages of a GSO message: the source address, the segment size, the release time
+// and the ECN codepoint.
+constexpr size_t GsoMessageControlSpace = CMSG_SPACE(sizeof(in6_pktinfo)) +
+                                          CMSG_SPACE(sizeof(uint16_t)) +
+                                          CMSG_SPACE(sizeof(uint64_t)) + CMSG_SPACE(sizeof(int));
+
+// A run of buffered writes sent as one GSO message.
+struct GsoMessage {
+  const quic::BufferedWrite* first_;
+  size_t length_;
+  size_t num_segments_;
+};
+
+cmsghdr* appendCmsg(msghdr& hdr, cmsghdr* previous, int level, int type, size_t data_size) {
+  cmsghdr* cmsg = previous == nullptr ? CMSG_FIRSTHDR(&hdr) : CMSG_NXTHDR(&hdr, previous);
+  ASSERT(cmsg != nullptr);
+  cmsg->cmsg_level = level;
+  cmsg->cmsg_type = type;
+  cmsg->cmsg_len = CMSG_LEN(data_size);
+  return cmsg;
+}
+
+// Sets the control messages of a GSO message, and returns their length.
+size_t buildGsoMessageCmsgs(msghdr& hdr, const GsoMessage& message, bool release_time) {
+  const quic::BufferedWrite& first = *message.first_;
+  size_t length = 0;
+  cmsghdr* cmsg = nullptr;
+  if (first.self_address.IsInitialized()) {
+    if (first.self_address.IsIPv4()) {
+      cmsg = appendCmsg(hdr, cmsg, IPPROTO_IP, IP_PKTINFO, sizeof(in_pktinfo));
+      auto* pktinfo = reinterpret_cast<in_pktinfo*>(CMSG_DATA(cmsg));
+      memset(pktinfo, 0, sizeof(in_pktinfo));
+      pktinfo->ipi_spec_dst = first.self_address.GetIPv4();
+      length += CMSG_SPACE(sizeof(in_pktinfo));
+    } else {
+      cmsg = appendCmsg(hdr, cmsg, IPPROTO_IPV6, IPV6_PKTINFO, sizeof(in6_pktinfo));
+      auto* pktinfo = reinterpret_cast<in6_pktinfo*>(CMSG_DATA(cmsg));
+      memset(pktinfo, 0, sizeof(in6_pktinfo));
+      pktinfo->ipi6_addr = first.self_address.GetIPv6();
+      length += CMSG_SPACE(sizeof(in6_pktinfo));
+    }
+  }
+  if (message.num_segments_ > 1) {
+    cmsg = appendCmsg(hdr, cmsg, SOL_UDP, UDP_SEGMENT, sizeof(uint16_t));
+    *reinterpret_cast<uint16_t*>(CMSG_DATA(cmsg)) = first.buf_len;
+    length += CMSG_SPACE(sizeof(uint16_t));
+  }
+  if (release_time && first.release_time != 0) {
+    cmsg = appendCmsg(hdr, cmsg, SOL_SOCKET, SCM_TXTIME, sizeof(uint64_t));
+    *reinterpret_cast<uint64_t*>(CMSG_DATA(cmsg)) = first.release_time;
+    length += CMSG_SPACE(sizeof(uint64_t));
+  }
+  if (first.params.ecn_codepoint != quic::ECN_NOT_ECT) {
+    const bool v4 = !first.self_address.IsInitialized() || first.self_address.IsIPv4();
+    cmsg = appendCmsg(hdr, cmsg, v4 ? IPPROTO_IP : IPPROTO_IPV6, v4 ? IP_TOS : IPV6_TCLASS,
+                      sizeof(int));
+    *reinterpret_cast<int*>(CMSG_DATA(cmsg)) = static_cast<int>(first.params.ecn_codepoint);
+    length += CMSG_SPACE(sizeof(int));
+  }
+  return length;
+}
+
 Api::IoCallUint64Result convertQuicWriteResult(quic::WriteResult quic_result, size_t payload_len) {
   switch (quic_result.status) {
   case quic::WRITE_STATUS_OK:
@@ -39,8 +113,17 @@ Api::IoCallUint64Result convertQuicWriteResult(quic::WriteResult quic_result, si
 } // namespace
 
 // Initialize QuicGsoBatchWriter, set io_handle_ and stats_
-UdpGsoBatchWriter::UdpGsoBatchWriter(Network::IoHandle& io_handle, Stats::Scope& scope)
-    : quic::QuicGsoBatchWriter(io_handle.fdDoNotUse()), stats_(generateStats(scope)) {}
+UdpGsoBatchWriter::UdpGsoBatchWriter(Network::IoHandle& io_handle, Stats::Scope& scope,
+                                     bool batch_across_connections)
+    : quic::QuicGsoBatchWriter(io_handle.fdDoNotUse()), stats_(generateStats(scope)),
+      io_handle_(io_handle), batch_across_connections_(batch_across_connections) {}
+
+UdpGsoBatchWriter::UdpGsoBatchWriter(Network::IoHandle& io_handle, Stats::Scope& scope,
+                                     bool batch_across_connections,
+                                     clockid_t clockid_for_release_time)
+    : quic::QuicGsoBatchWriter(io_handle.fdDoNotUse(), clockid_for_release_time),
+      stats_(generateStats(scope)), io_handle_(io_handle),
+      batch_across_connections_(batch_across_connections) {}
 
 Api::IoCallUint64Result
 UdpGsoBatchWriter::writePacket(const Buffer::Instance& buffer, const Network::Address::Ip* local_ip,
@@ -84,6 +167,104 @@ Api::IoCallUint64Result UdpGsoBatchWriter::flush() {
   return convertQuicWriteResult(quic_result, /*payload_len=*/0);
 }
 
+UdpGsoBatchWriter::CanBatchResult UdpGsoBatchWriter::CanBatch(
+    const char* buffer, size_t buf_len, const quic::QuicIpAddress& self_address,
+    const quic::QuicSocketAddress& peer_address, const quic::PerPacketOptions* options,
+    const quic::QuicPacketWriterParams& params, uint64_t release_time) const {
+  if (!batch_across_connections_) {
+    return quic::QuicGsoBatchWriter::CanBatch(buffer, buf_len, self_address, peer_address, options,
+                                              params, release_time);
+  }
+  // Any write joins the batch, which is split into GSO messages when flushed. The batch is
+  // flushed early only when its buffer is full.
+  return CanBatchResult(/*can_batch=*/true, /*must_flush=*/false);
+}
+
+UdpGsoBatchWriter::FlushImplResult UdpGsoBatchWriter::FlushImpl() {
+  if (!batch_across_connections_) {
+    return quic::QuicGsoBatchWriter::FlushImpl();
+  }
+  return flushAcrossConnections();
+}
+
+UdpGsoBatchWriter::FlushImplResult UdpGsoBatchWriter::flushAcrossConnections() {
+  // Group the buffered writes into runs of contiguous writes to the same peer, all of the size of
+  // the first one except for a shorter last one.
+  std::vector<GsoMessage> messages;
+  for (const quic::BufferedWrite& write : buffered_writes()) {
+    if (!messages.empty()) {
+      GsoMessage& message = messages.back();
+      const quic::BufferedWrite& first = *message.first_;
+      if (write.self_address == first.self_address && write.peer_address == first.peer_address &&
+          write.release_time == first.release_time &&
+          write.params.ecn_codepoint == first.params.ecn_codepoint &&
+          message.length_ == message.num_segments_ * first.buf_len &&
+          write.buf_len <= first.buf_len && message.num_segments_ < MaxSegmentsPerGsoMessage &&
+          message.length_ + write.buf_len <= MaxGsoMessageSize &&
+          write.buffer == first.buffer + message.length_) {
+        message.length_ += write.buf_len;
+        ++message.num_segments_;
+        continue;
+      }
+    }
+    messages.push_back({&write, write.buf_len, 1});
+  }
+
+  const size_t num_messages = messages.size();
+  absl::FixedArray<mmsghdr> hdrs(num_messages);
+  absl::FixedArray<iovec> iovs(num_messages);
+  absl::FixedArray<sockaddr_storage> peer_addresses(num_messages);
+  absl::FixedArray<char> cbufs(num_messages * GsoMessageControlSpace, 0);
+  for (size_t i = 0; i < num_messages; ++i) {
+    const quic::BufferedWrite& first = *messages[i].first_;
+    Network::Address::InstanceConstSharedPtr peer_address =
+        quicAddressToEnvoyAddressInstance(first.peer_address);
+    memcpy(&peer_addresses[i], peer_address->sockAddr(), peer_address->sockAddrLen());
+    iovs[i].iov_base = const_cast<char*>(first.buffer);
+    iovs[i].iov_len = messages[i].length_;
+
+    memset(&hdrs[i], 0, sizeof(mmsghdr));
+    msghdr& hdr = hdrs[i].msg_hdr;
+    hdr.msg_name = &peer_addresses[i];
+    hdr.msg_namelen = peer_address->sockAddrLen();
+    hdr.msg_iov = &iovs[i];
+    hdr.msg_iovlen = 1;
+    hdr.msg_control = cbufs.data() + i * GsoMessageControlSpace;
+    hdr.msg_controllen = GsoMessageControlSpace;
+    hdr.msg_controllen = buildGsoMessageCmsgs(hdr, messages[i], SupportsReleaseTime());
+    if (hdr.msg_controllen == 0) {
+      hdr.msg_control = nullptr;
+    }
+  }
+
+  FlushImplResult result{quic::WriteResult(quic::WRITE_STATUS_OK, 0), /*num_packets_sent=*/0,
+                         /*bytes_written=*/0};
+  size_t num_messages_sent = 0;
+  while (num_messages_sent < num_messages) {
+    const Api::SysCallIntResult rc = Api::OsSysCallsSingleton::get().sendmmsg(
+        io_handle_.fdDoNotUse(), hdrs.data() + num_messages_sent,
+        num_messages - num_messages_sent, 0);
+    if (rc.return_value_ <= 0) {
+      result.write_result = quic::WriteResult(rc.errno_ == SOCKET_ERROR_AGAIN
+                                                  ? quic::WRITE_STATUS_BLOCKED
+                                                  : quic::WRITE_STATUS_ERROR,
+                                              rc.errno_);
+      ENVOY_LOG_MISC(trace, "sendmmsg failed with error code {} after {} of {} messages",
+                     rc.errno_, num_messages_sent, num_messages);
+      return result;
+    }
+    for (size_t i = num_messages_sent; i < num_messages_sent + rc.return_value_; ++i) {
+      result.num_packets_sent += messages[i].num_segments_;
+      result.bytes_written += messages[i].length_;
+    }
+    num_messages_sent += rc.return_value_;
+  }
+  ENVOY_LOG_MISC(trace, "sendmmsg sent {} packets in {} messages", result.num_packets_sent,
+                 num_messages);
+  result.write_result.bytes_written = result.bytes_written;
+  return result;
+}
+
 void UdpGsoBatchWriter::updateUdpGsoBatchWriterStats(quic::WriteResult quic_result) {
   if (quic_result.status == quic::WRITE_STATUS_OK && quic_result.bytes_written > 0) {
     if (gso_size_ > 0u) {
@@ -104,7 +285,13 @@ UdpGsoBatchWriterStats UdpGsoBatchWriter::generateStats(Stats::Scope& scope) {
 
 Network::UdpPacketWriterPtr
 UdpGsoBatchWriterFactory::createUdpPacketWriter(Network::IoHandle& io_handle, Stats::Scope& scope) {
-  return std::make_unique<UdpGsoBatchWriter>(io_handle, scope);
+  if (pacing_offload_) {
+    // The fq qdisc, which paces the sockets whose packets carry a release time, uses the
+    // monotonic clock.
+    return std::make_unique<UdpGsoBatchWriter>(io_handle, scope, batch_across_connections_,
+                                               CLOCK_MONOTONIC);
+  }
+  return std::make_unique<UdpGsoBatchWriter>(io_handle, scope, batch_across_connections_);
 }
 
 } // namespace Quic
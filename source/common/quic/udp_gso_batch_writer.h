@@ -56,7 +56,22 @@ struct UdpGsoBatchWriterStats {
  */
 class UdpGsoBatchWriter : public quic::QuicGsoBatchWriter, public Network::UdpPacketWriter {
 public:
-  UdpGsoBatchWriter(Network::IoHandle& io_handle, Stats::Scope& scope);
+  /**
+   * @param batch_across_connections whether packets to different peers are buffered in the same
+   * batch, which is then sent with one sendmmsg call with a GSO message per run of packets to the
+   * same peer.
+   */
+  UdpGsoBatchWriter(Network::IoHandle& io_handle, Stats::Scope& scope,
+                    bool batch_across_connections = false);
+
+  /**
+   * Same as above, but also passes the release time of paced packets to the kernel with
+   * SO_TXTIME, if supported.
+   * @param clockid_for_release_time the clock of the release times, CLOCK_MONOTONIC for the fq
+   * qdisc.
+   */
+  UdpGsoBatchWriter(Network::IoHandle& io_handle, Stats::Scope& scope,
+                    bool batch_across_connections, clockid_t clockid_for_release_time);
 
   // writePacket perform batched sends based on QuicGsoBatchWriter::WritePacket
   Api::IoCallUint64Result writePacket(const Buffer::Instance& buffer,
@@ -73,7 +88,25 @@ public:
                        const Network::Address::Instance& peer_address) override;
   Api::IoCallUint64Result flush() override;
 
+  bool batchAcrossConnections() const { return batch_across_connections_; }
+
+protected:
+  // quic::QuicGsoBatchWriter
+  CanBatchResult CanBatch(const char* buffer, size_t buf_len,
+                          const quic::QuicIpAddress& self_address,
+                          const quic::QuicSocketAddress& peer_address,
+                          const quic::PerPacketOptions* options,
+                          const quic::QuicPacketWriterParams& params,
+                          uint64_t release_time) const override;
+  FlushImplResult FlushImpl() override;
+
 private:
+  /**
+   * Sends the buffered writes with one sendmmsg call, grouping each run of writes to the same
+   * peer into one GSO message.
+   */
+  FlushImplResult flushAcrossConnections();
+
   /**
    * @brief Update stats_ field for the udp packet writer
    * @param quic_result is the result from Flush/WritePacket
@@ -88,15 +121,22 @@ private:
   UdpGsoBatchWriterStats generateStats(Stats::Scope& scope);
   UdpGsoBatchWriterStats stats_;
   uint64_t gso_size_;
+  Network::IoHandle& io_handle_;
+  const bool batch_across_connections_;
 };
 
 class UdpGsoBatchWriterFactory : public Network::UdpPacketWriterFactory {
 public:
+  UdpGsoBatchWriterFactory(bool batch_across_connections = false, bool pacing_offload = false)
+      : batch_across_connections_(batch_across_connections), pacing_offload_(pacing_offload) {}
+
   Network::UdpPacketWriterPtr createUdpPacketWriter(Network::IoHandle& io_handle,
                                                     Stats::Scope& scope) override;
 
 private:
   envoy::config::core::v3::RuntimeFeatureFlag enabled_;
+  const bool batch_across_connections_;
+  const bool pacing_offload_;
 };
 
 } // namespace Quic
@@ -82,7 +82,14 @@ absl::Status RdsRouteConfigSubscription::onConfigUpdate(
   }
   std::unique_ptr<Init::ManagerImpl> noop_init_manager;
   std::unique_ptr<Cleanup> resume_rds;
-  if (config_update_info_->onRdsUpdate(route_config, version_info)) {
+  // The decoded resource is kept by the receiver rather than copied, when it can be shared.
+  std::shared_ptr<const Protobuf::Message> shared_route_config =
+      resources[0].get().sharedResource();
+  const bool updated =
+      shared_route_config != nullptr
+          ? config_update_info_->onRdsUpdate(std::move(shared_route_config), version_info)
+          : config_update_info_->onRdsUpdate(route_config, version_info);
+  if (updated) {
     stats_.config_reload_.inc();
     stats_.config_reload_time_ms_.set(DateUtil::nowToMilliseconds(factory_context_.timeSource()));
 
@@ -14,7 +14,7 @@ RouteConfigUpdateReceiverImpl::RouteConfigUpdateReceiverImpl(
       config_(config_traits_.createNullConfig()) {}
 
 void RouteConfigUpdateReceiverImpl::updateConfig(
-    std::unique_ptr<Protobuf::Message>&& route_config_proto) {
+    std::shared_ptr<const Protobuf::Message> route_config_proto) {
   config_ = config_traits_.createConfig(*route_config_proto, factory_context_,
                                         false /* not validate unknown cluster */);
   // If the above create config doesn't raise exception, update the
@@ -30,11 +30,26 @@ void RouteConfigUpdateReceiverImpl::onUpdateCommon(const std::string& version_in
 // Rds::RouteConfigUpdateReceiver
 bool RouteConfigUpdateReceiverImpl::onRdsUpdate(const Protobuf::Message& rc,
                                                 const std::string& version_info) {
+  return applyRdsUpdate(rc, nullptr, version_info);
+}
+
+bool RouteConfigUpdateReceiverImpl::onRdsUpdate(std::shared_ptr<const Protobuf::Message> rc,
+                                                const std::string& version_info) {
+  const Protobuf::Message& message = *rc;
+  return applyRdsUpdate(message, std::move(rc), version_info);
+}
+
+bool RouteConfigUpdateReceiverImpl::applyRdsUpdate(
+    const Protobuf::Message& rc, std::shared_ptr<const Protobuf::Message> shared_rc,
+    const std::string& version_info) {
   uint64_t new_hash = getHash(rc);
   if (!checkHash(new_hash)) {
     return false;
   }
-  updateConfig(cloneProto(proto_traits_, rc));
+  if (shared_rc == nullptr) {
+    shared_rc = cloneProto(proto_traits_, rc);
+  }
+  updateConfig(std::move(shared_rc));
   updateHash(new_hash);
   onUpdateCommon(version_info);
   return true;
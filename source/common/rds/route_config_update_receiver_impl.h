@@ -17,11 +17,13 @@ public:
   uint64_t getHash(const Protobuf::Message& rc) const { return MessageUtil::hash(rc); }
   bool checkHash(uint64_t new_hash) const { return (new_hash != last_config_hash_); }
   void updateHash(uint64_t hash) { last_config_hash_ = hash; }
-  void updateConfig(std::unique_ptr<Protobuf::Message>&& route_config_proto);
+  void updateConfig(std::shared_ptr<const Protobuf::Message> route_config_proto);
   void onUpdateCommon(const std::string& version_info);
 
   // RouteConfigUpdateReceiver
   bool onRdsUpdate(const Protobuf::Message& rc, const std::string& version_info) override;
+  bool onRdsUpdate(std::shared_ptr<const Protobuf::Message> rc,
+                   const std::string& version_info) override;
 
   uint64_t configHash() const override { return last_config_hash_; }
   const absl::optional<RouteConfigProvider::ConfigInfo>& configInfo() const override;
@@ -30,11 +32,16 @@ public:
   SystemTime lastUpdated() const override { return last_updated_; }
 
 private:
+  // Updates from rc, keeping shared_rc if set, otherwise a copy of rc.
+  bool applyRdsUpdate(const Protobuf::Message& rc,
+                      std::shared_ptr<const Protobuf::Message> shared_rc,
+                      const std::string& version_info);
+
   ConfigTraits& config_traits_;
   ProtoTraits& proto_traits_;
   Server::Configuration::ServerFactoryContext& factory_context_;
   TimeSource& time_source_;
-  ProtobufTypes::MessagePtr route_config_proto_;
+  std::shared_ptr<const Protobuf::Message> route_config_proto_;
   uint64_t last_config_hash_{0ull};
   SystemTime last_updated_;
   absl::optional<RouteConfigProvider::ConfigInfo> config_info_;
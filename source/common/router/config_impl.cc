@@ -239,6 +239,21 @@ createRedirectConfig(const envoy::config::route::v3::Route& route, Regex::Engine
   return redirect_config;
 }
 
+// Hashes every field of the route configuration but its virtual hosts, without copying them.
+uint64_t commonRouteConfigHash(const envoy::config::route::v3::RouteConfiguration& config) {
+  Protobuf::FieldMask mask;
+  const Protobuf::Descriptor* descriptor = config.GetDescriptor();
+  for (int i = 0; i < descriptor->field_count(); ++i) {
+    const Protobuf::FieldDescriptor* field = descriptor->field(i);
+    if (field->number() != envoy::config::route::v3::RouteConfiguration::kVirtualHostsFieldNumber) {
+      mask.add_paths(field->name());
+    }
+  }
+  envoy::config::route::v3::RouteConfiguration common_config;
+  ProtobufUtil::FieldMaskUtil::MergeMessageTo(config, mask, {}, &common_config);
+  return MessageUtil::hash(common_config);
+}
+
 } // namespace
 
 const std::string& OriginalConnectPort::key() {
@@ -875,8 +890,8 @@ bool RouteEntryImplBase::matchRoute(const Http::RequestHeaderMap& headers,
     return false;
   }
   if (!config_query_parameters_.empty()) {
-    auto query_parameters =
-        Http::Utility::QueryParamsMulti::parseQueryString(headers.getPathValue());
+    const auto& query_parameters =
+        Http::Utility::QueryParamsMulti::parseQueryStringCached(headers.getPathValue());
     matches &= ConfigUtility::matchQueryParams(query_parameters, config_query_parameters_);
     if (!matches) {
       return false;
@@ -1934,6 +1949,23 @@ VirtualHostImpl::VirtualHostImpl(
       SET_AND_RETURN_IF_NOT_OK(route_or_error.status(), creation_status);
       routes_.emplace_back(route_or_error.value());
     }
+
+    if (routes_.size() >= MinRoutesForPathIndex &&
+        Runtime::runtimeFeatureEnabled("envoy.reloadable_features.route_path_index")) {
+      // The regex prefilter is built with RE2, so it is only used with the RE2 regex engine.
+      const bool prefilter_regex_routes =
+          Runtime::runtimeFeatureEnabled("envoy.reloadable_features.route_regex_prefilter") &&
+          dynamic_cast<const Regex::GoogleReEngine*>(&factory_context.regexEngine()) != nullptr;
+      auto path_index = std::make_unique<RoutePathIndex>(prefilter_regex_routes);
+      for (int i = 0; i < virtual_host.routes_size(); ++i) {
+        path_index->addRoute(i, virtual_host.routes(i).match());
+      }
+      path_index->compile();
+      // Without any indexed route the index would only add overhead to the linear scan.
+      if (path_index->indexedRoutes() > 0) {
+        path_index_ = std::move(path_index);
+      }
+    }
   }
 }
 
@@ -1977,6 +2009,47 @@ RouteConstSharedPtr VirtualHostImpl::getRouteFromRoutes(
   return nullptr;
 }
 
+RouteConstSharedPtr VirtualHostImpl::getRouteFromPathIndex(
+    const RouteCallback& cb, const Http::RequestHeaderMap& headers,
+    const StreamInfo::StreamInfo& stream_info, uint64_t random_value) const {
+  // Strip the path the same way the route path matchers do before matching.
+  absl::string_view path = Http::PathUtil::removeQueryAndFragment(headers.getPathValue());
+  if (shared_virtual_host_->globalRouteConfig().ignorePathParametersInPathMatching()) {
+    path = path.substr(0, path.find(';'));
+  }
+
+  for (const uint32_t position : path_index_->candidates(path)) {
+    RouteConstSharedPtr route_entry =
+        routes_[position]->matches(headers, stream_info, random_value);
+    if (route_entry == nullptr) {
+      continue;
+    }
+
+    if (cb == nullptr) {
+      return route_entry;
+    }
+
+    // The evaluation status is relative to the whole route table, so that the callback observes
+    // the same status as with a linear scan over all routes.
+    RouteEvalStatus eval_status = (position + 1 == routes_.size())
+                                      ? RouteEvalStatus::NoMoreRoutes
+                                      : RouteEvalStatus::HasMoreRoutes;
+    RouteMatchStatus match_status = cb(route_entry, eval_status);
+    if (match_status == RouteMatchStatus::Accept) {
+      return route_entry;
+    }
+    if (match_status == RouteMatchStatus::Continue &&
+        eval_status == RouteEvalStatus::NoMoreRoutes) {
+      ENVOY_LOG(debug,
+                "return null when route match status is Continue but there is no more routes");
+      return nullptr;
+    }
+  }
+
+  ENVOY_LOG(debug, "route was resolved but final route list did not match incoming request");
+  return nullptr;
+}
+
 RouteConstSharedPtr VirtualHostImpl::getRouteFromEntries(const RouteCallback& cb,
                                                          const Http::RequestHeaderMap& headers,
                                                          const StreamInfo::StreamInfo& stream_info,
@@ -2025,40 +2098,25 @@ RouteConstSharedPtr VirtualHostImpl::getRouteFromEntries(const RouteCallback& cb
     return nullptr;
   }
 
+  // Pathless requests only match routes which support them, which are never indexed.
+  if (path_index_ != nullptr && headers.Path() != nullptr) {
+    return getRouteFromPathIndex(cb, headers, stream_info, random_value);
+  }
+
   // Check for a route that matches the request.
   return getRouteFromRoutes(cb, headers, stream_info, random_value, routes_);
 }
 
-const VirtualHostImpl* RouteMatcher::findWildcardVirtualHost(
-    absl::string_view host, const RouteMatcher::WildcardVirtualHosts& wildcard_virtual_hosts,
-    RouteMatcher::SubstringFunction substring_function) const {
-  // We do a longest wildcard match against the host that's passed in
-  // (e.g. "foo-bar.baz.com" should match "*-bar.baz.com" before matching "*.baz.com" for suffix
-  // wildcards). This is done by scanning the length => wildcards map looking for every wildcard
-  // whose size is < length.
-  for (const auto& iter : wildcard_virtual_hosts) {
-    const uint32_t wildcard_length = iter.first;
-    const auto& wildcard_map = iter.second;
-    // >= because *.foo.com shouldn't match .foo.com.
-    if (wildcard_length >= host.size()) {
-      continue;
-    }
-    const auto match = wildcard_map.find(substring_function(host, wildcard_length));
-    if (match != wildcard_map.end()) {
-      return match->second.get();
-    }
-  }
-  return nullptr;
-}
 absl::StatusOr<std::unique_ptr<RouteMatcher>>
 RouteMatcher::create(const envoy::config::route::v3::RouteConfiguration& route_config,
                      const CommonConfigSharedPtr& global_route_config,
                      Server::Configuration::ServerFactoryContext& factory_context,
-                     ProtobufMessage::ValidationVisitor& validator, bool validate_clusters) {
+                     ProtobufMessage::ValidationVisitor& validator, bool validate_clusters,
+                     const RouteMatcher* previous_matcher) {
   absl::Status creation_status = absl::OkStatus();
-  auto ret = std::unique_ptr<RouteMatcher>{new RouteMatcher(route_config, global_route_config,
-                                                            factory_context, validator,
-                                                            validate_clusters, creation_status)};
+  auto ret = std::unique_ptr<RouteMatcher>{
+      new RouteMatcher(route_config, global_route_config, factory_context, validator,
+                       validate_clusters, previous_matcher, creation_status)};
   RETURN_IF_NOT_OK(creation_status);
   return ret;
 }
@@ -2066,7 +2124,7 @@ RouteMatcher::RouteMatcher(const envoy::config::route::v3::RouteConfiguration& r
                            const CommonConfigSharedPtr& global_route_config,
                            Server::Configuration::ServerFactoryContext& factory_context,
                            ProtobufMessage::ValidationVisitor& validator, bool validate_clusters,
-                           absl::Status& creation_status)
+                           const RouteMatcher* previous_matcher, absl::Status& creation_status)
     : vhost_scope_(factory_context.scope().scopeFromStatName(
           factory_context.routerContext().virtualClusterStatNames().vhost_)),
       ignore_port_in_host_matching_(route_config.ignore_port_in_host_matching()) {
@@ -2074,11 +2132,38 @@ RouteMatcher::RouteMatcher(const envoy::config::route::v3::RouteConfiguration& r
   if (validate_clusters) {
     validation_clusters = factory_context.clusterManager().clusters();
   }
+  // Virtual hosts validated against the current clusters must be rebuilt on every update, since
+  // the clusters they reference may have been removed since.
+  const bool share_virtual_hosts =
+      !validate_clusters &&
+      Runtime::runtimeFeatureEnabled("envoy.reloadable_features.reuse_unchanged_virtual_hosts");
+  if (share_virtual_hosts) {
+    virtual_hosts_by_hash_.reserve(route_config.virtual_hosts_size());
+  }
   for (const auto& virtual_host_config : route_config.virtual_hosts()) {
-    VirtualHostSharedPtr virtual_host = std::make_shared<VirtualHostImpl>(
-        virtual_host_config, global_route_config, factory_context, *vhost_scope_, validator,
-        validation_clusters, creation_status);
-    SET_AND_RETURN_IF_NOT_OK(creation_status, creation_status);
+    VirtualHostSharedPtr virtual_host;
+    if (share_virtual_hosts) {
+      const uint64_t hash = MessageUtil::hash(virtual_host_config);
+      if (previous_matcher != nullptr) {
+        const auto it = previous_matcher->virtual_hosts_by_hash_.find(hash);
+        if (it != previous_matcher->virtual_hosts_by_hash_.end()) {
+          virtual_host = it->second;
+        }
+      }
+      if (virtual_host == nullptr) {
+        virtual_host = std::make_shared<VirtualHostImpl>(virtual_host_config, global_route_config,
+                                                         factory_context, *vhost_scope_, validator,
+                                                         validation_clusters, creation_status);
+        SET_AND_RETURN_IF_NOT_OK(creation_status, creation_status);
+      }
+      virtual_hosts_by_hash_.emplace(hash, virtual_host);
+    } else {
+      virtual_host = std::make_shared<VirtualHostImpl>(virtual_host_config, global_route_config,
+                                                       factory_context, *vhost_scope_, validator,
+                                                       validation_clusters, creation_status);
+      SET_AND_RETURN_IF_NOT_OK(creation_status, creation_status);
+    }
+    bool has_wildcard_domain = false;
     for (const std::string& domain_name : virtual_host_config.domains()) {
       const Http::LowerCaseString lower_case_domain_name(domain_name);
       absl::string_view domain = lower_case_domain_name;
@@ -2091,13 +2176,14 @@ RouteMatcher::RouteMatcher(const envoy::config::route::v3::RouteConfiguration& r
         }
         default_virtual_host_ = virtual_host;
       } else if (!domain.empty() && '*' == domain[0]) {
-        duplicate_found = !wildcard_virtual_host_suffixes_[domain.size() - 1]
-                               .emplace(domain.substr(1), virtual_host)
-                               .second;
+        const std::string reversed_suffix(domain.rbegin(), domain.rend() - 1);
+        duplicate_found =
+            !wildcard_virtual_host_suffixes_.add(reversed_suffix, virtual_host.get(), false);
+        has_wildcard_domain = true;
       } else if (!domain.empty() && '*' == domain[domain.size() - 1]) {
-        duplicate_found = !wildcard_virtual_host_prefixes_[domain.size() - 1]
-                               .emplace(domain.substr(0, domain.size() - 1), virtual_host)
-                               .second;
+        duplicate_found = !wildcard_virtual_host_prefixes_.add(
+            domain.substr(0, domain.size() - 1), virtual_host.get(), false);
+        has_wildcard_domain = true;
       } else {
         duplicate_found = !virtual_hosts_.emplace(domain, virtual_host).second;
       }
@@ -2109,6 +2195,9 @@ RouteMatcher::RouteMatcher(const envoy::config::route::v3::RouteConfiguration& r
         return;
       }
     }
+    if (has_wildcard_domain) {
+      wildcard_virtual_hosts_.push_back(std::move(virtual_host));
+    }
   }
 }
 
@@ -2141,18 +2230,20 @@ const VirtualHostImpl* RouteMatcher::findVirtualHost(const Http::RequestHeaderMa
   if (iter != virtual_hosts_.end()) {
     return iter->second.get();
   }
-  if (!wildcard_virtual_host_suffixes_.empty()) {
-    const VirtualHostImpl* vhost = findWildcardVirtualHost(
-        host, wildcard_virtual_host_suffixes_,
-        [](absl::string_view h, int l) -> absl::string_view { return h.substr(h.size() - l); });
+  // We do a longest wildcard match against the host (e.g. "foo-bar.baz.com" should match
+  // "*-bar.baz.com" before matching "*.baz.com" for suffix wildcards). The wildcard must match at
+  // least one character, so "*.foo.com" doesn't match ".foo.com": the lookups are done on the host
+  // without its first character for suffixes, and without its last character for prefixes.
+  if (!host.empty() && !wildcard_virtual_host_suffixes_.empty()) {
+    const std::string reversed_host(host.rbegin(), host.rend() - 1);
+    const VirtualHostImpl* vhost = wildcard_virtual_host_suffixes_.findLongestPrefix(reversed_host);
     if (vhost != nullptr) {
       return vhost;
     }
   }
-  if (!wildcard_virtual_host_prefixes_.empty()) {
-    const VirtualHostImpl* vhost = findWildcardVirtualHost(
-        host, wildcard_virtual_host_prefixes_,
-        [](absl::string_view h, int l) -> absl::string_view { return h.substr(0, l); });
+  if (!host.empty() && !wildcard_virtual_host_prefixes_.empty()) {
+    const VirtualHostImpl* vhost = wildcard_virtual_host_prefixes_.findLongestPrefix(
+        absl::string_view(host).substr(0, host.size() - 1));
     if (vhost != nullptr) {
       return vhost;
     }
@@ -2289,9 +2380,18 @@ absl::StatusOr<std::shared_ptr<ConfigImpl>>
 ConfigImpl::create(const envoy::config::route::v3::RouteConfiguration& config,
                    Server::Configuration::ServerFactoryContext& factory_context,
                    ProtobufMessage::ValidationVisitor& validator, bool validate_clusters_default) {
+  return create(config, factory_context, validator, validate_clusters_default, nullptr);
+}
+
+absl::StatusOr<std::shared_ptr<ConfigImpl>>
+ConfigImpl::create(const envoy::config::route::v3::RouteConfiguration& config,
+                   Server::Configuration::ServerFactoryContext& factory_context,
+                   ProtobufMessage::ValidationVisitor& validator, bool validate_clusters_default,
+                   const ConfigImpl* previous_config) {
   absl::Status creation_status = absl::OkStatus();
-  auto ret = std::shared_ptr<ConfigImpl>(new ConfigImpl(
-      config, factory_context, validator, validate_clusters_default, creation_status));
+  auto ret = std::shared_ptr<ConfigImpl>(new ConfigImpl(config, factory_context, validator,
+                                                        validate_clusters_default,
+                                                        previous_config, creation_status));
   RETURN_IF_NOT_OK(creation_status);
   return ret;
 }
@@ -2299,14 +2399,37 @@ ConfigImpl::create(const envoy::config::route::v3::RouteConfiguration& config,
 ConfigImpl::ConfigImpl(const envoy::config::route::v3::RouteConfiguration& config,
                        Server::Configuration::ServerFactoryContext& factory_context,
                        ProtobufMessage::ValidationVisitor& validator,
-                       bool validate_clusters_default, absl::Status& creation_status) {
-  auto config_or_error = CommonConfigImpl::create(config, factory_context, validator);
-  SET_AND_RETURN_IF_NOT_OK(config_or_error.status(), creation_status);
-  shared_config_ = std::move(config_or_error.value());
+                       bool validate_clusters_default, absl::Status& creation_status)
+    : ConfigImpl(config, factory_context, validator, validate_clusters_default, nullptr,
+                 creation_status) {}
+
+ConfigImpl::ConfigImpl(const envoy::config::route::v3::RouteConfiguration& config,
+                       Server::Configuration::ServerFactoryContext& factory_context,
+                       ProtobufMessage::ValidationVisitor& validator,
+                       bool validate_clusters_default, const ConfigImpl* previous_config,
+                       absl::Status& creation_status)
+    : accounted_bytes_(Memory::Subsystem::RouteConfigs, config.ByteSizeLong()) {
+  if (Runtime::runtimeFeatureEnabled("envoy.reloadable_features.reuse_unchanged_virtual_hosts")) {
+    common_config_hash_ = commonRouteConfigHash(config);
+  }
+
+  // Virtual hosts hold on to the shared config, so they can only be reused along with it.
+  const RouteMatcher* previous_matcher = nullptr;
+  if (previous_config != nullptr && previous_config->route_matcher_ != nullptr &&
+      common_config_hash_.has_value() &&
+      previous_config->common_config_hash_ == common_config_hash_) {
+    shared_config_ = previous_config->shared_config_;
+    previous_matcher = previous_config->route_matcher_.get();
+  } else {
+    auto config_or_error = CommonConfigImpl::create(config, factory_context, validator);
+    SET_AND_RETURN_IF_NOT_OK(config_or_error.status(), creation_status);
+    shared_config_ = std::move(config_or_error.value());
+  }
 
   auto matcher_or_error = RouteMatcher::create(
       config, shared_config_, factory_context, validator,
-      PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, validate_clusters, validate_clusters_default));
+      PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, validate_clusters, validate_clusters_default),
+      previous_matcher);
   SET_AND_RETURN_IF_NOT_OK(matcher_or_error.status(), creation_status);
   route_matcher_ = std::move(matcher_or_error.value());
 }
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <algorithm>
 #include <chrono>
 #include <cstdint>
 #include <iterator>
@@ -24,18 +25,23 @@
 
 #include "source/common/common/matchers.h"
 #include "source/common/common/packed_struct.h"
+#include "source/common/common/radix_tree.h"
 #include "source/common/config/datasource.h"
 #include "source/common/config/metadata.h"
 #include "source/common/http/hash_policy.h"
 #include "source/common/http/header_utility.h"
 #include "source/common/matcher/matcher.h"
+#include "source/common/memory/accounting.h"
 #include "source/common/router/config_utility.h"
 #include "source/common/router/header_parser.h"
 #include "source/common/router/metadatamatchcriteria_impl.h"
+#include "source/common/router/route_path_index.h"
 #include "source/common/router/router_ratelimit.h"
 #include "source/common/router/tls_context_match_criteria_impl.h"
 #include "source/common/stats/symbol_table.h"
 
+#include "absl/container/flat_hash_map.h"
+#include "absl/container/flat_hash_set.h"
 #include "absl/container/node_hash_map.h"
 #include "absl/types/optional.h"
 
@@ -176,6 +182,17 @@ public:
       allow_origins_.push_back(
           std::make_unique<Matchers::StringMatcherImpl<envoy::type::matcher::v3::StringMatcher>>(
               string_match, factory_context));
+      // The matchers which match "*" allow any origin, and the exact origins are looked up in a
+      // set, so that only the other matchers are evaluated for each request.
+      if (allow_origins_.back()->match("*")) {
+        allow_any_origin_ = true;
+      } else if (string_match.match_pattern_case() ==
+                     envoy::type::matcher::v3::StringMatcher::MatchPatternCase::kExact &&
+                 !string_match.ignore_case()) {
+        exact_allow_origins_.insert(string_match.exact());
+      } else {
+        other_allow_origins_.push_back(allow_origins_.back().get());
+      }
     }
     if (config.has_allow_credentials()) {
       allow_credentials_ = PROTOBUF_GET_WRAPPED_REQUIRED(config, allow_credentials);
@@ -195,6 +212,15 @@ public:
   const std::vector<Matchers::StringMatcherPtr>& allowOrigins() const override {
     return allow_origins_;
   };
+  bool isOriginAllowed(absl::string_view origin) const override {
+    if (allow_any_origin_ || exact_allow_origins_.contains(origin)) {
+      return true;
+    }
+    return std::any_of(other_allow_origins_.begin(), other_allow_origins_.end(),
+                       [origin](const Matchers::StringMatcher* matcher) {
+                         return matcher->match(origin);
+                       });
+  }
   const std::string& allowMethods() const override { return allow_methods_; };
   const std::string& allowHeaders() const override { return allow_headers_; };
   const std::string& exposeHeaders() const override { return expose_headers_; };
@@ -227,6 +253,9 @@ private:
   const ProtoType config_;
   Runtime::Loader& loader_;
   std::vector<Matchers::StringMatcherPtr> allow_origins_;
+  bool allow_any_origin_{};
+  absl::flat_hash_set<std::string> exact_allow_origins_;
+  std::vector<const Matchers::StringMatcher*> other_allow_origins_;
   const std::string allow_methods_;
   const std::string allow_headers_;
   const std::string expose_headers_;
@@ -401,9 +430,18 @@ public:
                      const StreamInfo::StreamInfo& stream_info, uint64_t random_value,
                      absl::Span<const RouteEntryImplBaseConstSharedPtr> routes) const;
 
+  // Virtual hosts with at least this many routes get a path index to narrow down the routes that
+  // are evaluated for a request.
+  static constexpr uint32_t MinRoutesForPathIndex = 16;
+
 private:
   enum class SslRequirements : uint8_t { None, ExternalOnly, All };
 
+  RouteConstSharedPtr getRouteFromPathIndex(const RouteCallback& cb,
+                                            const Http::RequestHeaderMap& headers,
+                                            const StreamInfo::StreamInfo& stream_info,
+                                            uint64_t random_value) const;
+
   static const std::shared_ptr<const SslRedirectRoute> SSL_REDIRECT_ROUTE;
 
   CommonVirtualHostSharedPtr shared_virtual_host_;
@@ -411,6 +449,7 @@ private:
   SslRequirements ssl_requirements_;
 
   std::vector<RouteEntryImplBaseConstSharedPtr> routes_;
+  std::unique_ptr<const RoutePathIndex> path_index_;
   Matcher::MatchTreeSharedPtr<Http::HttpMatchingData> matcher_;
 };
 
@@ -1535,7 +1574,8 @@ public:
   create(const envoy::config::route::v3::RouteConfiguration& config,
          const CommonConfigSharedPtr& global_route_config,
          Server::Configuration::ServerFactoryContext& factory_context,
-         ProtobufMessage::ValidationVisitor& validator, bool validate_clusters);
+         ProtobufMessage::ValidationVisitor& validator, bool validate_clusters,
+         const RouteMatcher* previous_matcher = nullptr);
 
   RouteConstSharedPtr route(const RouteCallback& cb, const Http::RequestHeaderMap& headers,
                             const StreamInfo::StreamInfo& stream_info, uint64_t random_value) const;
@@ -1547,31 +1587,25 @@ private:
                const CommonConfigSharedPtr& global_route_config,
                Server::Configuration::ServerFactoryContext& factory_context,
                ProtobufMessage::ValidationVisitor& validator, bool validate_clusters,
-               absl::Status& creation_status);
-
-  using WildcardVirtualHosts =
-      std::map<int64_t, absl::node_hash_map<std::string, VirtualHostSharedPtr>, std::greater<>>;
-  using SubstringFunction = std::function<absl::string_view(absl::string_view, int)>;
-  const VirtualHostImpl* findWildcardVirtualHost(absl::string_view host,
-                                                 const WildcardVirtualHosts& wildcard_virtual_hosts,
-                                                 SubstringFunction substring_function) const;
+               const RouteMatcher* previous_matcher, absl::Status& creation_status);
+
   bool ignorePortInHostMatching() const { return ignore_port_in_host_matching_; }
 
   Stats::ScopeSharedPtr vhost_scope_;
   absl::node_hash_map<std::string, VirtualHostSharedPtr> virtual_hosts_;
-  // std::greater as a minor optimization to iterate from more to less specific
-  //
-  // A note on using an unordered_map versus a vector of (string, VirtualHostSharedPtr) pairs:
-  //
-  // Based on local benchmarks, each vector entry costs around 20ns for recall and (string)
-  // comparison with a fixed cost of about 25ns. For unordered_map, the empty map costs about 65ns
-  // and climbs to about 110ns once there are any entries.
-  //
-  // The break-even is 4 entries.
-  WildcardVirtualHosts wildcard_virtual_host_suffixes_;
-  WildcardVirtualHosts wildcard_virtual_host_prefixes_;
+  // Wildcard domains are kept in radix trees so that the most specific wildcard is found in a
+  // single walk over the host, whatever the number of distinct wildcard lengths. Suffix wildcards
+  // (e.g. "*.foo.com") are keyed by their reversed suffix, prefix wildcards (e.g. "foo.*") by
+  // their prefix. The trees reference the virtual hosts owned by wildcard_virtual_hosts_.
+  RadixTree<const VirtualHostImpl*> wildcard_virtual_host_suffixes_;
+  RadixTree<const VirtualHostImpl*> wildcard_virtual_host_prefixes_;
+  std::vector<VirtualHostSharedPtr> wildcard_virtual_hosts_;
 
   VirtualHostSharedPtr default_virtual_host_;
+  // Virtual hosts keyed by the hash of their configuration, so that a matcher built for a later
+  // version of the same route configuration can reuse the ones that did not change. Empty when
+  // the virtual hosts are not shareable, e.g. when they were validated against the clusters.
+  absl::flat_hash_map<uint64_t, VirtualHostSharedPtr> virtual_hosts_by_hash_;
   const bool ignore_port_in_host_matching_{false};
 };
 
@@ -1657,6 +1691,18 @@ public:
          Server::Configuration::ServerFactoryContext& factory_context,
          ProtobufMessage::ValidationVisitor& validator, bool validate_clusters_default);
 
+  /**
+   * Creates a config for a new version of the route configuration that was used to build
+   * previous_config. Virtual hosts whose configuration did not change are shared with
+   * previous_config instead of being rebuilt, as long as the rest of the route configuration is
+   * unchanged and clusters are not validated.
+   */
+  static absl::StatusOr<std::shared_ptr<ConfigImpl>>
+  create(const envoy::config::route::v3::RouteConfiguration& config,
+         Server::Configuration::ServerFactoryContext& factory_context,
+         ProtobufMessage::ValidationVisitor& validator, bool validate_clusters_default,
+         const ConfigImpl* previous_config);
+
   bool virtualHostExists(const Http::RequestHeaderMap& headers) const {
     return route_matcher_->findVirtualHost(headers) != nullptr;
   }
@@ -1699,10 +1745,19 @@ protected:
              Server::Configuration::ServerFactoryContext& factory_context,
              ProtobufMessage::ValidationVisitor& validator, bool validate_clusters_default,
              absl::Status& creation_status);
+  ConfigImpl(const envoy::config::route::v3::RouteConfiguration& config,
+             Server::Configuration::ServerFactoryContext& factory_context,
+             ProtobufMessage::ValidationVisitor& validator, bool validate_clusters_default,
+             const ConfigImpl* previous_config, absl::Status& creation_status);
 
 private:
   CommonConfigSharedPtr shared_config_;
   std::unique_ptr<RouteMatcher> route_matcher_;
+  // Hash of the route configuration without its virtual hosts, used to tell whether the shared
+  // config and the virtual hosts can be reused by the next version of the configuration.
+  absl::optional<uint64_t> common_config_hash_;
+  // The serialized size of the route configuration, as an estimate of the memory it takes.
+  const Memory::AccountedBytes accounted_bytes_;
 };
 
 /**
@@ -73,6 +73,7 @@ HeadersToAddEntry::HeadersToAddEntry(const HeaderValueOption& header_value_optio
   auto formatter_or_error = parseHttpHeaderFormatter(header_value_option.header());
   SET_AND_RETURN_IF_NOT_OK(formatter_or_error.status(), creation_status);
   formatter_ = std::move(formatter_or_error.value());
+  literal_ = original_value_.find('%') == std::string::npos;
 }
 
 HeadersToAddEntry::HeadersToAddEntry(const HeaderValue& header_value,
@@ -82,6 +83,19 @@ HeadersToAddEntry::HeadersToAddEntry(const HeaderValue& header_value,
   auto formatter_or_error = parseHttpHeaderFormatter(header_value);
   SET_AND_RETURN_IF_NOT_OK(formatter_or_error.status(), creation_status);
   formatter_ = std::move(formatter_or_error.value());
+  literal_ = original_value_.find('%') == std::string::npos;
+}
+
+void HeadersToRemove::removeFrom(Http::HeaderMap& headers) const {
+  if (headers_.size() == 1) {
+    headers.remove(headers_.front());
+    return;
+  }
+  if (!headers_.empty()) {
+    headers.removeIf([this](const Http::HeaderEntry& header) {
+      return header_set_.contains(header.key().getStringView());
+    });
+  }
 }
 
 absl::StatusOr<HeaderParserPtr>
@@ -127,7 +141,7 @@ HeaderParser::configure(const Protobuf::RepeatedPtrField<HeaderValueOption>& hea
     if (!Http::HeaderUtility::isRemovableHeader(header)) {
       return absl::InvalidArgumentError(":-prefixed or host headers may not be removed");
     }
-    header_parser->headers_to_remove_.emplace_back(header);
+    header_parser->headers_to_remove_.add(header);
   }
 
   return header_parser;
@@ -144,9 +158,7 @@ void HeaderParser::evaluateHeaders(Http::HeaderMap& headers,
                                    const StreamInfo::StreamInfo* stream_info) const {
   // Removing headers in the headers_to_remove_ list first makes
   // remove-before-add the default behavior as expected by users.
-  for (const auto& header : headers_to_remove_) {
-    headers.remove(header);
-  }
+  headers_to_remove_.removeFrom(headers);
 
   // Temporary storage to hold evaluated values of headers to add and replace. This is required
   // to execute all formatters using the original received headers.
@@ -169,7 +181,7 @@ void HeaderParser::evaluateHeaders(Http::HeaderMap& headers,
   std::string value_buffer;
   for (const auto& [key, entry] : headers_to_add_) {
     absl::string_view value;
-    if (stream_info != nullptr) {
+    if (stream_info != nullptr && !entry->literal_) {
       value_buffer = entry->formatter_->formatWithContext(context, *stream_info);
       value = value_buffer;
     } else {
@@ -248,7 +260,7 @@ Http::HeaderTransforms HeaderParser::getHeaderTransforms(const StreamInfo::Strea
     }
   }
 
-  transforms.headers_to_remove = headers_to_remove_;
+  transforms.headers_to_remove = headers_to_remove_.headers();
 
   return transforms;
 }
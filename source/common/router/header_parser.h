@@ -11,6 +11,8 @@
 #include "source/common/http/header_map_impl.h"
 #include "source/common/protobuf/protobuf.h"
 
+#include "absl/container/flat_hash_set.h"
+
 namespace Envoy {
 namespace Router {
 
@@ -41,6 +43,8 @@ struct HeadersToAddEntry {
 
   std::string original_value_;
   bool add_if_empty_ = false;
+  // Whether the value has no commands, so that it is the original value without being formatted.
+  bool literal_ = false;
 
   Formatter::FormatterPtr formatter_;
   HeaderAppendAction append_action_;
@@ -51,6 +55,26 @@ protected:
   HeadersToAddEntry(const HeaderValueOption& header_value_option, absl::Status& creation_status);
 };
 
+/**
+ * The headers removed by a list of header operations. Several headers are removed in a single pass
+ * over the header map instead of one pass each.
+ */
+class HeadersToRemove {
+public:
+  void add(const std::string& header) {
+    headers_.emplace_back(header);
+    header_set_.insert(header);
+  }
+
+  void removeFrom(Http::HeaderMap& headers) const;
+
+  const std::vector<Http::LowerCaseString>& headers() const { return headers_; }
+
+private:
+  std::vector<Http::LowerCaseString> headers_;
+  absl::flat_hash_set<std::string> header_set_;
+};
+
 /**
  * HeaderParser manipulates Http::HeaderMap instances. Headers to be added are pre-parsed to select
  * between a constant value implementation and a dynamic value implementation based on
@@ -128,7 +152,7 @@ protected:
 
 private:
   std::vector<std::pair<Http::LowerCaseString, std::unique_ptr<HeadersToAddEntry>>> headers_to_add_;
-  std::vector<Http::LowerCaseString> headers_to_remove_;
+  HeadersToRemove headers_to_remove_;
 };
 
 } // namespace Router
@@ -44,10 +44,14 @@ ConfigTraitsImpl::createConfig(const Protobuf::Message& rc,
                                Server::Configuration::ServerFactoryContext& factory_context,
                                bool validate_clusters_default) const {
   ASSERT(dynamic_cast<const envoy::config::route::v3::RouteConfiguration*>(&rc));
-  return THROW_OR_RETURN_VALUE(
+  const std::shared_ptr<const ConfigImpl> previous_config = last_config_.lock();
+  std::shared_ptr<ConfigImpl> config = THROW_OR_RETURN_VALUE(
       ConfigImpl::create(static_cast<const envoy::config::route::v3::RouteConfiguration&>(rc),
-                         factory_context, validator_, validate_clusters_default),
+                         factory_context, validator_, validate_clusters_default,
+                         previous_config.get()),
       std::shared_ptr<ConfigImpl>);
+  last_config_ = config;
+  return config;
 }
 
 bool RouteConfigUpdateReceiverImpl::onRdsUpdate(const Protobuf::Message& rc,
@@ -77,12 +81,35 @@ bool RouteConfigUpdateReceiverImpl::onRdsUpdate(const Protobuf::Message& rc,
     }
   }
   base_.updateConfig(std::move(new_route_config));
+  onRdsConfigUpdated(new_hash, new_vhds_config_hash, version_info);
+  return true;
+}
+
+bool RouteConfigUpdateReceiverImpl::onRdsUpdate(std::shared_ptr<const Protobuf::Message> rc,
+                                                const std::string& version_info) {
+  const auto* route_config =
+      dynamic_cast<const envoy::config::route::v3::RouteConfiguration*>(rc.get());
+  if (route_config == nullptr || route_config->has_vhds()) {
+    // The vhosts of VHDS are merged into a copy.
+    return onRdsUpdate(*rc, version_info);
+  }
+  uint64_t new_hash = base_.getHash(*rc);
+  if (!base_.checkHash(new_hash)) {
+    return false;
+  }
+  base_.updateConfig(std::move(rc));
+  onRdsConfigUpdated(new_hash, 0ul, version_info);
+  return true;
+}
+
+void RouteConfigUpdateReceiverImpl::onRdsConfigUpdated(uint64_t new_hash,
+                                                       uint64_t new_vhds_config_hash,
+                                                       const std::string& version_info) {
   base_.updateHash(new_hash);
   vhds_configuration_changed_ = new_vhds_config_hash != last_vhds_config_hash_;
   last_vhds_config_hash_ = new_vhds_config_hash;
 
   base_.onUpdateCommon(version_info);
-  return true;
 }
 
 bool RouteConfigUpdateReceiverImpl::onVhdsUpdate(
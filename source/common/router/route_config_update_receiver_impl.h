@@ -1,5 +1,6 @@
 #pragma once
 
+#include <memory>
 #include <string>
 
 #include "envoy/config/route/v3/route.pb.h"
@@ -29,6 +30,9 @@ public:
 
 private:
   ProtobufMessage::ValidationVisitor& validator_;
+  // The config most recently created by this instance, whose unchanged virtual hosts are reused
+  // by the next one. Not owned: it is only useful while the provider still holds it.
+  mutable std::weak_ptr<const ConfigImpl> last_config_;
 };
 
 class RouteConfigUpdateReceiverImpl : public RouteConfigUpdateReceiver {
@@ -47,6 +51,8 @@ public:
 
   // Router::RouteConfigUpdateReceiver
   bool onRdsUpdate(const Protobuf::Message& rc, const std::string& version_info) override;
+  bool onRdsUpdate(std::shared_ptr<const Protobuf::Message> rc,
+                   const std::string& version_info) override;
   bool onVhdsUpdate(const VirtualHostRefVector& added_vhosts,
                     const std::set<std::string>& added_resource_ids,
                     const Protobuf::RepeatedPtrField<std::string>& removed_resources,
@@ -74,6 +80,9 @@ public:
   }
 
 private:
+  void onRdsConfigUpdated(uint64_t new_hash, uint64_t new_vhds_config_hash,
+                          const std::string& version_info);
+
   ConfigTraitsImpl config_traits_;
 
   Rds::RouteConfigUpdateReceiverImpl base_;
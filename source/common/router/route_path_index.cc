@@ -0,0 +1,139 @@
+#include "source/common/router/route_path_index.h"
+
+#include <algorithm>
+
+#include "source/common/protobuf/utility.h"
+
+namespace Envoy {
+namespace Router {
+
+namespace {
+
+// Upper bound of the memory used by the compiled regex set and its DFA cache. Lookups fall back
+// to evaluating every regex route if the DFA runs out of memory.
+constexpr int64_t RegexSetMaxMemory = 32 << 20;
+
+re2::RE2::Options regexSetOptions() {
+  // Match the options used by the RE2 regex engine.
+  re2::RE2::Options options(re2::RE2::Quiet);
+  options.set_max_mem(RegexSetMaxMemory);
+  return options;
+}
+
+} // namespace
+
+RoutePathIndex::RoutePathIndex(bool prefilter_regex_routes) {
+  if (prefilter_regex_routes) {
+    // Regex routes must match the whole path.
+    regex_set_ = std::make_unique<re2::RE2::Set>(regexSetOptions(), re2::RE2::ANCHOR_BOTH);
+  }
+}
+
+void RoutePathIndex::addRoute(uint32_t position,
+                              const envoy::config::route::v3::RouteMatch& match) {
+  // Case insensitive routes would require folding the request path before the lookup, leave them
+  // to the full evaluation.
+  if (!PROTOBUF_GET_WRAPPED_OR_DEFAULT(match, case_sensitive, true)) {
+    unindexed_routes_.push_back(position);
+    return;
+  }
+
+  switch (match.path_specifier_case()) {
+  case envoy::config::route::v3::RouteMatch::PathSpecifierCase::kPrefix:
+    addPrefixRoute(position, match.prefix());
+    return;
+  case envoy::config::route::v3::RouteMatch::PathSpecifierCase::kPathSeparatedPrefix:
+    // The separator check is left to the route itself, the index only narrows by prefix.
+    addPrefixRoute(position, match.path_separated_prefix());
+    return;
+  case envoy::config::route::v3::RouteMatch::PathSpecifierCase::kPath:
+    exact_routes_[match.path()].push_back(position);
+    indexed_routes_++;
+    return;
+  case envoy::config::route::v3::RouteMatch::PathSpecifierCase::kSafeRegex:
+    if (regex_set_ != nullptr && regex_set_->Add(match.safe_regex().regex(), nullptr) >= 0) {
+      regex_routes_.push_back(position);
+      indexed_routes_++;
+      return;
+    }
+    break;
+  default:
+    break;
+  }
+  unindexed_routes_.push_back(position);
+}
+
+void RoutePathIndex::addPrefixRoute(uint32_t position, const std::string& prefix) {
+  auto [it, inserted] = prefix_route_lists_.try_emplace(prefix);
+  if (inserted) {
+    prefix_routes_.add(prefix, &it->second);
+  }
+  it->second.push_back(position);
+  indexed_routes_++;
+}
+
+void RoutePathIndex::compile() {
+  if (regex_set_ == nullptr) {
+    return;
+  }
+  if (regex_routes_.empty()) {
+    regex_set_.reset();
+    return;
+  }
+  if (!regex_set_->Compile()) {
+    ENVOY_LOG(warn, "unable to compile the prefilter of {} regex routes, evaluating all of them",
+              regex_routes_.size());
+    unindexRegexRoutes();
+  }
+}
+
+void RoutePathIndex::unindexRegexRoutes() {
+  indexed_routes_ -= regex_routes_.size();
+  RouteList unindexed_routes;
+  unindexed_routes.reserve(unindexed_routes_.size() + regex_routes_.size());
+  std::merge(unindexed_routes_.begin(), unindexed_routes_.end(), regex_routes_.begin(),
+             regex_routes_.end(), std::back_inserter(unindexed_routes));
+  unindexed_routes_ = std::move(unindexed_routes);
+  regex_routes_.clear();
+  regex_set_.reset();
+}
+
+RoutePathIndex::Candidates RoutePathIndex::candidates(absl::string_view path) const {
+  Candidates result(unindexed_routes_.begin(), unindexed_routes_.end());
+  // Every list is sorted already, only sort when routes were gathered from more than one list.
+  bool needs_sort = false;
+  const auto append = [&result, &needs_sort](const RouteList& routes) {
+    needs_sort |= !result.empty();
+    result.insert(result.end(), routes.begin(), routes.end());
+  };
+
+  for (const RouteList* routes : prefix_routes_.findMatchingPrefixes(path)) {
+    append(*routes);
+  }
+  if (const auto it = exact_routes_.find(path); it != exact_routes_.end()) {
+    append(it->second);
+  }
+
+  if (regex_set_ != nullptr) {
+    std::vector<int> matched;
+    re2::RE2::Set::ErrorInfo error_info;
+    if (regex_set_->Match(path, &matched, &error_info)) {
+      // The matched patterns are not ordered.
+      needs_sort = true;
+      for (const int pattern : matched) {
+        result.push_back(regex_routes_[pattern]);
+      }
+    } else if (error_info.kind != re2::RE2::Set::kNoError) {
+      ENVOY_LOG_EVERY_POW_2(warn, "regex route prefilter failed, evaluating all regex routes");
+      append(regex_routes_);
+    }
+  }
+
+  if (needs_sort) {
+    std::sort(result.begin(), result.end());
+  }
+  return result;
+}
+
+} // namespace Router
+} // namespace Envoy
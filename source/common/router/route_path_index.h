@@ -0,0 +1,89 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "envoy/config/route/v3/route_components.pb.h"
+
+#include "source/common/common/logger.h"
+#include "source/common/common/utility.h"
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/container/inlined_vector.h"
+#include "absl/container/node_hash_map.h"
+#include "absl/strings/string_view.h"
+#include "re2/set.h"
+
+namespace Envoy {
+namespace Router {
+
+/**
+ * Index over the path match criteria of the routes of a virtual host. For a request path it
+ * yields the positions of the routes whose path criterion may match the path, so that only those
+ * routes need to be fully evaluated. Prefix, exact path and path separated prefix routes are kept
+ * in a trie and a hash map respectively. When regex prefiltering is enabled, the regex routes are
+ * compiled into a single RE2::Set so that one pass over the path yields the matching regex routes.
+ * Routes which cannot be indexed (URI template, CONNECT, case insensitive matching) are always
+ * returned as candidates.
+ *
+ * The candidates are a superset of the matching routes and are returned in route table order, so
+ * evaluating them in turn preserves first-match semantics.
+ */
+class RoutePathIndex : Logger::Loggable<Logger::Id::router> {
+public:
+  using Candidates = absl::InlinedVector<uint32_t, 16>;
+
+  /**
+   * @param prefilter_regex_routes whether regex routes are compiled into a RE2::Set. This must
+   *        only be set if the regex routes are evaluated with RE2, otherwise the prefilter could
+   *        disagree with the regex engine.
+   */
+  explicit RoutePathIndex(bool prefilter_regex_routes = false);
+
+  /**
+   * Adds a route to the index. Routes must be added in increasing order of position.
+   * @param position the position of the route in the route table.
+   * @param match the match criteria of the route.
+   */
+  void addRoute(uint32_t position, const envoy::config::route::v3::RouteMatch& match);
+
+  /**
+   * Finishes building the index. Must be called after all the routes have been added and before
+   * any lookup.
+   */
+  void compile();
+
+  /**
+   * @param path the request path with the query string, fragment and, if path parameters are
+   *        ignored for matching, path parameters removed.
+   * @return the positions of the routes which may match the path, in increasing order.
+   */
+  Candidates candidates(absl::string_view path) const;
+
+  /**
+   * @return the number of routes whose path criterion is indexed.
+   */
+  uint32_t indexedRoutes() const { return indexed_routes_; }
+
+private:
+  using RouteList = std::vector<uint32_t>;
+
+  void addPrefixRoute(uint32_t position, const std::string& prefix);
+  void unindexRegexRoutes();
+
+  // The prefix route lists are owned by a node map for pointer stability, and referenced from
+  // the trie used for lookups.
+  absl::node_hash_map<std::string, RouteList> prefix_route_lists_;
+  TrieLookupTable<const RouteList*> prefix_routes_;
+  absl::flat_hash_map<std::string, RouteList> exact_routes_;
+  // Positions of the regex routes, indexed by their pattern index in regex_set_.
+  RouteList regex_routes_;
+  std::unique_ptr<re2::RE2::Set> regex_set_;
+  RouteList unindexed_routes_;
+  uint32_t indexed_routes_{};
+};
+
+} // namespace Router
+} // namespace Envoy
@@ -49,6 +49,13 @@ constexpr char NumInternalRedirectsFilterStateName[] = "num_internal_redirects";
 
 uint32_t getLength(const Buffer::Instance* instance) { return instance ? instance->length() : 0; }
 
+// The bytes of the request bodies buffered for retries, shadows and internal redirects by the
+// routers of this thread.
+uint64_t& workerRetryBufferBytes() {
+  static thread_local uint64_t bytes = 0;
+  return bytes;
+}
+
 bool schemeIsHttp(const Http::RequestHeaderMap& downstream_headers,
                   OptRef<const Network::Connection> connection) {
   if (Http::Utility::schemeIsHttp(downstream_headers.getSchemeValue())) {
@@ -86,6 +93,10 @@ FilterConfig::FilterConfig(Stats::StatName stat_prefix,
     upstream_logs_.push_back(AccessLog::AccessLogFactory::fromProto(upstream_log, context));
   }
 
+  if (config.has_max_retry_buffer_bytes_per_worker()) {
+    max_retry_buffer_bytes_per_worker_ = config.max_retry_buffer_bytes_per_worker().value();
+  }
+
   if (config.has_upstream_log_options() &&
       config.upstream_log_options().has_upstream_log_flush_interval()) {
     upstream_log_flush_interval_ = std::chrono::milliseconds(DurationUtil::durationToMilliseconds(
@@ -339,6 +350,7 @@ Filter::~Filter() {
   // Upstream resources should already have been cleaned.
   ASSERT(upstream_requests_.empty());
   ASSERT(!retry_state_);
+  releaseRetryBuffer();
 }
 
 const FilterUtility::StrictHeaderChecker::HeaderCheckResult
@@ -871,13 +883,15 @@ Http::FilterDataStatus Filter::decodeData(Buffer::Instance& data, bool end_strea
                    (!active_shadow_policies_.empty() && !streaming_shadows_) ||
                    (route_entry_ && route_entry_->internalRedirectPolicy().enabled());
   if (buffering &&
-      getLength(callbacks_->decodingBuffer()) + data.length() > retry_shadow_buffer_limit_) {
+      (getLength(callbacks_->decodingBuffer()) + data.length() > retry_shadow_buffer_limit_ ||
+       retryBufferBudgetExceeded(data.length()))) {
     ENVOY_LOG(debug,
-              "The request payload has at least {} bytes data which exceeds buffer limit {}. Give "
-              "up on the retry/shadow.",
+              "The request payload has at least {} bytes data which exceeds buffer limit {} or the "
+              "buffer budget of the worker. Give up on the retry/shadow.",
               getLength(callbacks_->decodingBuffer()) + data.length(), retry_shadow_buffer_limit_);
     cluster_->trafficStats()->retry_or_shadow_abandoned_.inc();
     retry_state_.reset();
+    releaseRetryBuffer();
     buffering = false;
     active_shadow_policies_.clear();
     request_buffer_overflowed_ = true;
@@ -900,7 +914,8 @@ Http::FilterDataStatus Filter::decodeData(Buffer::Instance& data, bool end_strea
       shadow_stream->removeDestructorCallback();
       shadow_stream->removeWatermarkCallbacks();
     }
-    Buffer::OwnedImpl copy(data);
+    Buffer::OwnedImpl copy;
+    copy.addShared(data);
     shadow_stream->sendData(copy, end_stream);
   }
   if (end_stream) {
@@ -908,7 +923,9 @@ Http::FilterDataStatus Filter::decodeData(Buffer::Instance& data, bool end_strea
   }
   if (buffering) {
     if (!upstream_requests_.empty()) {
-      Buffer::OwnedImpl copy(data);
+      // The buffered body shares its memory with the upstream requests and shadows.
+      Buffer::OwnedImpl copy;
+      copy.addShared(data);
       upstream_requests_.front()->acceptDataFromRouter(copy, end_stream);
     }
 
@@ -918,6 +935,8 @@ Http::FilterDataStatus Filter::decodeData(Buffer::Instance& data, bool end_strea
     // so that all buffered data is available by the time we do request complete processing and
     // potentially shadow. Additionally, we can't do a copy here because there's a check down
     // this stack for whether `data` is the same buffer as already buffered data.
+    retry_buffer_bytes_ += data.length();
+    workerRetryBufferBytes() += data.length();
     callbacks_->addDecodedData(data, true);
   } else {
     if (!Runtime::runtimeFeatureEnabled(
@@ -1040,7 +1059,8 @@ void Filter::maybeDoShadowing() {
     Http::RequestMessagePtr request(new Http::RequestMessageImpl(
         Http::createHeaderMap<Http::RequestHeaderMapImpl>(*shadow_headers_)));
     if (callbacks_->decodingBuffer()) {
-      request->body().add(*callbacks_->decodingBuffer());
+      // Sharing the buffered body leaves its content as is.
+      request->body().addShared(const_cast<Buffer::Instance&>(*callbacks_->decodingBuffer()));
     }
     if (shadow_trailers_) {
       request->trailers(Http::createHeaderMap<Http::RequestTrailerMapImpl>(*shadow_trailers_));
@@ -1087,6 +1107,16 @@ void Filter::onRequestComplete() {
   }
 }
 
+bool Filter::retryBufferBudgetExceeded(uint64_t length) const {
+  return config_->max_retry_buffer_bytes_per_worker_.has_value() &&
+         workerRetryBufferBytes() + length > config_->max_retry_buffer_bytes_per_worker_.value();
+}
+
+void Filter::releaseRetryBuffer() {
+  workerRetryBufferBytes() -= retry_buffer_bytes_;
+  retry_buffer_bytes_ = 0;
+}
+
 void Filter::onDestroy() {
   // Reset any in-flight upstream requests.
   resetAll();
@@ -1738,8 +1768,16 @@ void Filter::onUpstreamComplete(UpstreamRequest& upstream_request) {
     upstream_request.resetStream();
   }
   Event::Dispatcher& dispatcher = callbacks_->dispatcher();
-  std::chrono::milliseconds response_time = std::chrono::duration_cast<std::chrono::milliseconds>(
-      dispatcher.timeSource().monotonicTime() - downstream_request_complete_time_);
+  const MonotonicTime::duration elapsed =
+      dispatcher.timeSource().monotonicTime() - downstream_request_complete_time_;
+  std::chrono::milliseconds response_time =
+      std::chrono::duration_cast<std::chrono::milliseconds>(elapsed);
+
+  if (const auto& lb_policy_data = upstream_request.upstreamHost()->lbPolicyData();
+      lb_policy_data != nullptr && !callbacks_->streamInfo().healthCheck() &&
+      DateUtil::timePointValid(downstream_request_complete_time_)) {
+    lb_policy_data->onResponseTime(std::chrono::duration_cast<std::chrono::microseconds>(elapsed));
+  }
 
   Upstream::ClusterTimeoutBudgetStatsOptRef tb_stats = cluster()->timeoutBudgetStats();
   if (tb_stats.has_value()) {
@@ -2043,8 +2081,9 @@ void Filter::doRetry(bool can_send_early_data, bool can_use_http3, TimeoutRetry
   // sure we don't send data on the wrong request.
   if (!upstream_requests_.empty() && (upstream_requests_.front().get() == upstream_request_tmp)) {
     if (callbacks_->decodingBuffer()) {
-      // If we are doing a retry we need to make a copy.
-      Buffer::OwnedImpl copy(*callbacks_->decodingBuffer());
+      // If we are doing a retry we need a copy, which shares the memory of the buffered body.
+      Buffer::OwnedImpl copy;
+      copy.addShared(const_cast<Buffer::Instance&>(*callbacks_->decodingBuffer()));
       upstream_requests_.front()->acceptDataFromRouter(copy, !downstream_trailers_ &&
                                                                  downstream_end_stream_);
     }
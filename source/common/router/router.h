@@ -277,6 +277,7 @@ public:
   HeaderVectorPtr strict_check_headers_;
   const bool flush_upstream_log_on_upstream_stream_;
   absl::optional<std::chrono::milliseconds> upstream_log_flush_interval_;
+  absl::optional<uint64_t> max_retry_buffer_bytes_per_worker_;
   std::list<AccessLog::InstanceSharedPtr> upstream_logs_;
   Http::Context& http_context_;
   Stats::StatName zone_name_;
@@ -305,8 +306,11 @@ public:
   Filter(const FilterConfigSharedPtr& config, FilterStats& stats)
       : config_(config), stats_(stats), grpc_request_(false), exclude_http_code_stats_(false),
         downstream_response_started_(false), downstream_end_stream_(false), is_retry_(false),
-        request_buffer_overflowed_(false), streaming_shadows_(Runtime::runtimeFeatureEnabled(
-                                               "envoy.reloadable_features.streaming_shadow")) {}
+        request_buffer_overflowed_(false),
+        streaming_shadows_(
+            Runtime::runtimeFeatureEnabled("envoy.reloadable_features.streaming_shadow")),
+        cache_hash_key_(
+            Runtime::runtimeFeatureEnabled("envoy.reloadable_features.router_cache_hash_key")) {}
 
   ~Filter() override;
 
@@ -327,17 +331,28 @@ public:
   // Upstream::LoadBalancerContext
   absl::optional<uint64_t> computeHashKey() override {
     if (route_entry_ && downstream_headers_) {
+      // Have we been called before? The hash policy only depends on the request, so the hosts
+      // selected for the retries of the stream use the hash computed for the first one. This also
+      // keeps them from adding the same cookie to the response again.
+      if (hash_key_.has_value()) {
+        return hash_key_.value();
+      }
       auto hash_policy = route_entry_->hashPolicy();
-      if (hash_policy) {
-        return hash_policy->generateHash(
-            callbacks_->streamInfo().downstreamAddressProvider().remoteAddress().get(),
-            *downstream_headers_,
-            [this](const std::string& key, const std::string& path, std::chrono::seconds max_age,
-                   Http::CookieAttributeRefVector attributes) {
-              return addDownstreamSetCookie(key, path, max_age, attributes);
-            },
-            callbacks_->streamInfo().filterState());
+      if (hash_policy == nullptr) {
+        return {};
+      }
+      absl::optional<uint64_t> hash_key = hash_policy->generateHash(
+          callbacks_->streamInfo().downstreamAddressProvider().remoteAddress().get(),
+          *downstream_headers_,
+          [this](const std::string& key, const std::string& path, std::chrono::seconds max_age,
+                 Http::CookieAttributeRefVector attributes) {
+            return addDownstreamSetCookie(key, path, max_age, attributes);
+          },
+          callbacks_->streamInfo().filterState());
+      if (cache_hash_key_) {
+        hash_key_ = hash_key;
       }
+      return hash_key;
     }
     return {};
   }
@@ -502,6 +517,10 @@ private:
                           bool dropped);
   void chargeUpstreamAbort(Http::Code code, bool dropped, UpstreamRequest& upstream_request);
   void cleanup();
+  // Whether buffering length more bytes would exceed the retry buffer budget of the worker.
+  bool retryBufferBudgetExceeded(uint64_t length) const;
+  // Releases the bytes buffered by this router from the budget of the worker.
+  void releaseRetryBuffer();
   virtual RetryStatePtr
   createRetryState(const RetryPolicy& policy, Http::RequestHeaderMap& request_headers,
                    const Upstream::ClusterInfo& cluster, const VirtualCluster* vcluster,
@@ -578,6 +597,8 @@ private:
   Http::RequestTrailerMap* downstream_trailers_{};
   MonotonicTime downstream_request_complete_time_;
   MetadataMatchCriteriaConstPtr metadata_match_;
+  // The result of the hash policy for the stream, once computed.
+  absl::optional<absl::optional<uint64_t>> hash_key_;
   std::function<void(Http::ResponseHeaderMap&)> modify_headers_;
   std::vector<std::reference_wrapper<const ShadowPolicy>> active_shadow_policies_{};
   std::unique_ptr<Http::RequestHeaderMap> shadow_headers_;
@@ -592,6 +613,9 @@ private:
   // Set of ongoing shadow streams which have not yet received end stream.
   absl::flat_hash_set<Http::AsyncClient::OngoingRequest*> shadow_streams_;
 
+  // The bytes of the request body buffered by this router, counted in the budget of the worker.
+  uint64_t retry_buffer_bytes_{0};
+
   // Keep small members (bools and enums) at the end of class, to reduce alignment overhead.
   uint32_t retry_shadow_buffer_limit_{std::numeric_limits<uint32_t>::max()};
   uint32_t attempt_count_{1};
@@ -607,6 +631,7 @@ private:
   bool include_timeout_retry_header_in_request_ : 1;
   bool request_buffer_overflowed_ : 1;
   const bool streaming_shadows_ : 1;
+  const bool cache_hash_key_ : 1;
 };
 
 class ProdFilter : public Filter {
@@ -261,8 +261,8 @@ QueryParameterValueMatchAction::QueryParameterValueMatchAction(
 bool QueryParameterValueMatchAction::populateDescriptor(
     RateLimit::DescriptorEntry& descriptor_entry, const std::string&,
     const Http::RequestHeaderMap& headers, const StreamInfo::StreamInfo&) const {
-  Http::Utility::QueryParamsMulti query_parameters =
-      Http::Utility::QueryParamsMulti::parseAndDecodeQueryString(headers.getPathValue());
+  const Http::Utility::QueryParamsMulti& query_parameters =
+      Http::Utility::QueryParamsMulti::parseAndDecodeQueryStringCached(headers.getPathValue());
   if (expect_match_ ==
       ConfigUtility::matchQueryParams(query_parameters, action_query_parameters_)) {
     descriptor_entry = {descriptor_key_, descriptor_value_};
@@ -21,6 +21,7 @@
 #include "source/common/protobuf/message_validator_impl.h"
 #include "source/common/protobuf/utility.h"
 #include "source/common/runtime/runtime_features.h"
+#include "source/common/runtime/runtime_key_index.h"
 
 #include "absl/container/node_hash_map.h"
 #include "absl/container/node_hash_set.h"
@@ -230,6 +231,7 @@ SnapshotImpl::SnapshotImpl(Random::RandomGenerator& generator, RuntimeStats& sta
       values_.emplace(kv.first, kv.second);
     }
   }
+  indexed_entries_ = KeyIndex::resolve(values_);
   stats.num_keys_.set(values_.size());
 }
 
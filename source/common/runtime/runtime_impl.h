@@ -85,6 +85,7 @@ public:
   double getDouble(absl::string_view key, double default_value) const override;
   bool getBoolean(absl::string_view key, bool value) const override;
   const std::vector<OverrideLayerConstPtr>& getLayers() const override;
+  absl::Span<const Entry* const> indexedEntries() const override { return indexed_entries_; }
 
   const EntryMap& values() const;
 
@@ -96,6 +97,8 @@ public:
 private:
   const std::vector<OverrideLayerConstPtr> layers_;
   EntryMap values_;
+  // The entries of the keys of the KeyIndex, pointing into values_.
+  std::vector<const Entry*> indexed_entries_;
   Random::RandomGenerator& generator_;
   RuntimeStats& stats_;
 };
@@ -0,0 +1,47 @@
+#include "source/common/runtime/runtime_key_index.h"
+
+#include "source/common/common/macros.h"
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/synchronization/mutex.h"
+
+namespace Envoy {
+namespace Runtime {
+
+namespace {
+
+struct Keys {
+  absl::Mutex mutex_;
+  absl::flat_hash_map<std::string, uint32_t> indexes_ ABSL_GUARDED_BY(mutex_);
+  // The keys by their index.
+  std::vector<std::string> keys_ ABSL_GUARDED_BY(mutex_);
+};
+
+Keys& keys() { MUTABLE_CONSTRUCT_ON_FIRST_USE(Keys); }
+
+} // namespace
+
+uint32_t KeyIndex::add(absl::string_view key) {
+  Keys& all = keys();
+  absl::MutexLock lock(&all.mutex_);
+  const auto [it, inserted] = all.indexes_.try_emplace(key, all.keys_.size());
+  if (inserted) {
+    all.keys_.emplace_back(key);
+  }
+  return it->second;
+}
+
+std::vector<const Snapshot::Entry*> KeyIndex::resolve(const Snapshot::EntryMap& values) {
+  Keys& all = keys();
+  absl::MutexLock lock(&all.mutex_);
+  std::vector<const Snapshot::Entry*> entries;
+  entries.reserve(all.keys_.size());
+  for (const std::string& key : all.keys_) {
+    const auto it = values.find(key);
+    entries.push_back(it != values.end() ? &it->second : nullptr);
+  }
+  return entries;
+}
+
+} // namespace Runtime
+} // namespace Envoy
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "envoy/runtime/runtime.h"
+
+#include "absl/strings/string_view.h"
+
+namespace Envoy {
+namespace Runtime {
+
+/**
+ * The process-wide index of the runtime keys read on hot paths. The keys are registered when the
+ * configurations reading them are loaded, and each snapshot looks their entries up once when it
+ * is made, so that these configurations find them by their index instead of hashing them for each
+ * lookup. @see Snapshot::indexedEntries().
+ */
+class KeyIndex {
+public:
+  /**
+   * @return the index of the key, registering it if it wasn't yet.
+   */
+  static uint32_t add(absl::string_view key);
+
+  /**
+   * @return the entries of the values of the registered keys, by the index of their key.
+   */
+  static std::vector<const Snapshot::Entry*> resolve(const Snapshot::EntryMap& values);
+};
+
+/**
+ * A runtime key registered in the KeyIndex, whose values are found in the snapshots by its index.
+ * The snapshots which don't index their entries, or which were made before the key was
+ * registered, are looked up by name.
+ */
+class IndexedKey {
+public:
+  explicit IndexedKey(absl::string_view key) : key_(key), index_(KeyIndex::add(key)) {}
+
+  const std::string& key() const { return key_; }
+
+  uint64_t getInteger(const Snapshot& snapshot, uint64_t default_value) const {
+    const Snapshot::Entry* entry;
+    if (!find(snapshot, entry)) {
+      return snapshot.getInteger(key_, default_value);
+    }
+    return entry != nullptr && entry->uint_value_ ? entry->uint_value_.value() : default_value;
+  }
+
+  double getDouble(const Snapshot& snapshot, double default_value) const {
+    const Snapshot::Entry* entry;
+    if (!find(snapshot, entry)) {
+      return snapshot.getDouble(key_, default_value);
+    }
+    return entry != nullptr && entry->double_value_ ? entry->double_value_.value() : default_value;
+  }
+
+  bool getBoolean(const Snapshot& snapshot, bool default_value) const {
+    const Snapshot::Entry* entry;
+    if (!find(snapshot, entry)) {
+      return snapshot.getBoolean(key_, default_value);
+    }
+    return entry != nullptr && entry->bool_value_ ? entry->bool_value_.value() : default_value;
+  }
+
+private:
+  // Sets the entry of the key in the snapshot, or returns false if the snapshot doesn't index it.
+  bool find(const Snapshot& snapshot, const Snapshot::Entry*& entry) const {
+    const absl::Span<const Snapshot::Entry* const> entries = snapshot.indexedEntries();
+    if (index_ >= entries.size()) {
+      return false;
+    }
+    entry = entries[index_];
+    return true;
+  }
+
+  const std::string key_;
+  const uint32_t index_;
+};
+
+} // namespace Runtime
+} // namespace Envoy
@@ -7,6 +7,7 @@
 #include "envoy/type/v3/percent.pb.h"
 
 #include "source/common/protobuf/utility.h"
+#include "source/common/runtime/runtime_key_index.h"
 
 namespace Envoy {
 namespace Runtime {
@@ -18,22 +19,22 @@ public:
       : runtime_key_(uint32_proto.runtime_key()), default_value_(uint32_proto.default_value()),
         runtime_(runtime) {}
 
-  const std::string& runtimeKey() const { return runtime_key_; }
+  const std::string& runtimeKey() const { return runtime_key_.key(); }
 
   uint32_t value() const {
-    uint64_t raw_value = runtime_.snapshot().getInteger(runtime_key_, default_value_);
+    uint64_t raw_value = runtime_key_.getInteger(runtime_.snapshot(), default_value_);
     if (raw_value > std::numeric_limits<uint32_t>::max()) {
       ENVOY_LOG_EVERY_POW_2(
           warn,
           "parsed runtime value:{} of {} is larger than uint32 max, returning default instead",
-          raw_value, runtime_key_);
+          raw_value, runtime_key_.key());
       return default_value_;
     }
     return static_cast<uint32_t>(raw_value);
   }
 
 private:
-  const std::string runtime_key_;
+  const IndexedKey runtime_key_;
   const uint32_t default_value_;
   Runtime::Loader& runtime_;
 };
@@ -47,10 +48,10 @@ public:
         default_value_(PROTOBUF_GET_WRAPPED_OR_DEFAULT(feature_flag_proto, default_value, true)),
         runtime_(runtime) {}
 
-  bool enabled() const { return runtime_.snapshot().getBoolean(runtime_key_, default_value_); }
+  bool enabled() const { return runtime_key_.getBoolean(runtime_.snapshot(), default_value_); }
 
 private:
-  const std::string runtime_key_;
+  const IndexedKey runtime_key_;
   const bool default_value_;
   Runtime::Loader& runtime_;
 };
@@ -65,14 +66,14 @@ public:
       : runtime_key_(std::move(runtime_key)), default_value_(default_value), runtime_(runtime) {}
   virtual ~Double() = default;
 
-  const std::string& runtimeKey() const { return runtime_key_; }
+  const std::string& runtimeKey() const { return runtime_key_.key(); }
 
   virtual double value() const {
-    return runtime_.snapshot().getDouble(runtime_key_, default_value_);
+    return runtime_key_.getDouble(runtime_.snapshot(), default_value_);
   }
 
 protected:
-  const std::string runtime_key_;
+  const IndexedKey runtime_key_;
   const double default_value_;
   Runtime::Loader& runtime_;
 };
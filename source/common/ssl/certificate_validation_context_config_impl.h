@@ -58,6 +58,8 @@ public:
 
   absl::optional<uint32_t> maxVerifyDepth() const override { return max_verify_depth_; }
 
+  uint32_t verifiedChainCacheSize() const override { return verified_chain_cache_size_; }
+
 protected:
   CertificateValidationContextConfigImpl(
       const envoy::extensions::transport_sockets::tls::v3::CertificateValidationContext& config,
@@ -82,6 +84,7 @@ private:
   Api::Api& api_;
   const bool only_verify_leaf_cert_crl_;
   absl::optional<uint32_t> max_verify_depth_;
+  const uint32_t verified_chain_cache_size_;
 };
 
 } // namespace Ssl
@@ -67,12 +67,15 @@ void AllocatorImpl::debugPrint() {
 //
 // We implement the RefcountInterface API to avoid weak counter and destructor overhead in
 // shared_ptr.
+//
+// The stats are allocated from the slabs of the allocator, and find it from the
+// header of their slab chunk rather than holding a reference to it, saving 8
+// bytes per stat.
 template <class BaseClass> class StatsSharedImpl : public MetricImpl<BaseClass> {
 public:
   StatsSharedImpl(StatName name, AllocatorImpl& alloc, StatName tag_extracted_name,
                   const StatNameTagVector& stat_name_tags)
-      : MetricImpl<BaseClass>(name, tag_extracted_name, stat_name_tags, alloc.symbolTable()),
-        alloc_(alloc) {}
+      : MetricImpl<BaseClass>(name, tag_extracted_name, stat_name_tags, alloc.symbolTable()) {}
 
   ~StatsSharedImpl() override {
     // MetricImpl must be explicitly cleared() before destruction, otherwise it
@@ -82,8 +85,15 @@ public:
     this->clear(symbolTable());
   }
 
+  static void* operator new(size_t size, StatSlab& slab) {
+    ASSERT(size <= slab.blockSize());
+    return slab.allocate();
+  }
+  static void operator delete(void* block, StatSlab&) { StatSlab::release(block); }
+  static void operator delete(void* block) { StatSlab::release(block); }
+
   // Metric
-  SymbolTable& symbolTable() final { return alloc_.symbolTable(); }
+  SymbolTable& symbolTable() final { return alloc().symbolTable(); }
   bool used() const override { return flags_ & Metric::Flags::Used; }
   bool hidden() const override { return flags_ & Metric::Flags::Hidden; }
 
@@ -101,11 +111,12 @@ public:
     // destruct anything. But it seems preferable at to be conservative here,
     // as stats will only go out of scope when a scope is destructed (during
     // xDS) or during admin stats operations.
-    Thread::LockGuard lock(alloc_.mutex_);
+    AllocatorImpl& alloc = this->alloc();
+    Thread::LockGuard lock(alloc.mutex_);
     ASSERT(ref_count_ >= 1);
     if (--ref_count_ == 0) {
-      alloc_.sync().syncPoint(AllocatorImpl::DecrementToZeroSyncPoint);
-      removeFromSetLockHeld();
+      alloc.sync().syncPoint(AllocatorImpl::DecrementToZeroSyncPoint);
+      removeFromSetLockHeld(alloc);
       return true;
     }
     return false;
@@ -117,10 +128,11 @@ public:
    * our ref-count decrement hits zero. The counters and gauges are held in
    * distinct sets so we virtualize this removal helper.
    */
-  virtual void removeFromSetLockHeld() ABSL_EXCLUSIVE_LOCKS_REQUIRED(alloc_.mutex_) PURE;
+  virtual void removeFromSetLockHeld(AllocatorImpl& alloc)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(alloc.mutex_) PURE;
 
 protected:
-  AllocatorImpl& alloc_;
+  AllocatorImpl& alloc() const { return *static_cast<AllocatorImpl*>(StatSlab::owner(this)); }
 
   // ref_count_ can be incremented as an atomic, without taking a new lock, as
   // the critical 0->1 transition occurs in makeCounter and makeGauge, which
@@ -128,9 +140,9 @@ protected:
   // but these are always in transition to ref-count 2 or higher, and thus
   // cannot race with a decrement to zero.
   //
-  // However, we must hold alloc_.mutex_ when decrementing ref_count_ so that
-  // when it hits zero we can atomically remove it from alloc_.counters_ or
-  // alloc_.gauges_. We leave it atomic to avoid taking the lock on increment.
+  // However, we must hold the allocator's mutex_ when decrementing ref_count_
+  // so that when it hits zero we can atomically remove it from its counters_ or
+  // gauges_. We leave it atomic to avoid taking the lock on increment.
   std::atomic<uint32_t> ref_count_{0};
 
   std::atomic<uint16_t> flags_{0};
@@ -142,10 +154,11 @@ public:
               const StatNameTagVector& stat_name_tags)
       : StatsSharedImpl(name, alloc, tag_extracted_name, stat_name_tags) {}
 
-  void removeFromSetLockHeld() ABSL_EXCLUSIVE_LOCKS_REQUIRED(alloc_.mutex_) override {
-    const size_t count = alloc_.counters_.erase(statName());
+  void removeFromSetLockHeld(AllocatorImpl& alloc)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(alloc.mutex_) override {
+    const size_t count = alloc.counters_.erase(statName());
     ASSERT(count == 1);
-    alloc_.sinked_counters_.erase(this);
+    alloc.sinked_counters_.erase(this);
   }
 
   // Stats::Counter
@@ -191,10 +204,11 @@ public:
     }
   }
 
-  void removeFromSetLockHeld() override ABSL_EXCLUSIVE_LOCKS_REQUIRED(alloc_.mutex_) {
-    const size_t count = alloc_.gauges_.erase(statName());
+  void removeFromSetLockHeld(AllocatorImpl& alloc)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(alloc.mutex_) override {
+    const size_t count = alloc.gauges_.erase(statName());
     ASSERT(count == 1);
-    alloc_.sinked_gauges_.erase(this);
+    alloc.sinked_gauges_.erase(this);
   }
 
   // Stats::Gauge
@@ -273,10 +287,11 @@ public:
                   const StatNameTagVector& stat_name_tags)
       : StatsSharedImpl(name, alloc, tag_extracted_name, stat_name_tags) {}
 
-  void removeFromSetLockHeld() ABSL_EXCLUSIVE_LOCKS_REQUIRED(alloc_.mutex_) override {
-    const size_t count = alloc_.text_readouts_.erase(statName());
+  void removeFromSetLockHeld(AllocatorImpl& alloc)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(alloc.mutex_) override {
+    const size_t count = alloc.text_readouts_.erase(statName());
     ASSERT(count == 1);
-    alloc_.sinked_text_readouts_.erase(this);
+    alloc.sinked_text_readouts_.erase(this);
   }
 
   // Stats::TextReadout
@@ -296,6 +311,12 @@ private:
   std::string value_ ABSL_GUARDED_BY(mutex_);
 };
 
+AllocatorImpl::AllocatorImpl(SymbolTable& symbol_table)
+    : counter_slab_(this, sizeof(CounterImpl), alignof(CounterImpl)),
+      gauge_slab_(this, sizeof(GaugeImpl), alignof(GaugeImpl)),
+      text_readout_slab_(this, sizeof(TextReadoutImpl), alignof(TextReadoutImpl)),
+      symbol_table_(symbol_table) {}
+
 CounterSharedPtr AllocatorImpl::makeCounter(StatName name, StatName tag_extracted_name,
                                             const StatNameTagVector& stat_name_tags) {
   Thread::LockGuard lock(mutex_);
@@ -326,7 +347,8 @@ GaugeSharedPtr AllocatorImpl::makeGauge(StatName name, StatName tag_extracted_na
     return {*iter};
   }
   auto gauge =
-      GaugeSharedPtr(new GaugeImpl(name, *this, tag_extracted_name, stat_name_tags, import_mode));
+      GaugeSharedPtr(new (gauge_slab_) GaugeImpl(name, *this, tag_extracted_name, stat_name_tags,
+                                                 import_mode));
   gauges_.insert(gauge.get());
   // Add gauge to sinked_gauges_ if it matches the sink predicate.
   if (sink_predicates_ != nullptr && sink_predicates_->includeGauge(*gauge)) {
@@ -346,7 +368,8 @@ TextReadoutSharedPtr AllocatorImpl::makeTextReadout(StatName name, StatName tag_
     return {*iter};
   }
   auto text_readout =
-      TextReadoutSharedPtr(new TextReadoutImpl(name, *this, tag_extracted_name, stat_name_tags));
+      TextReadoutSharedPtr(new (text_readout_slab_)
+                               TextReadoutImpl(name, *this, tag_extracted_name, stat_name_tags));
   text_readouts_.insert(text_readout.get());
   // Add text_readout to sinked_text_readouts_ if it matches the sink predicate.
   if (sink_predicates_ != nullptr && sink_predicates_->includeTextReadout(*text_readout)) {
@@ -366,7 +389,7 @@ bool AllocatorImpl::isMutexLockedForTest() {
 
 Counter* AllocatorImpl::makeCounterInternal(StatName name, StatName tag_extracted_name,
                                             const StatNameTagVector& stat_name_tags) {
-  return new CounterImpl(name, *this, tag_extracted_name, stat_name_tags);
+  return new (counter_slab_) CounterImpl(name, *this, tag_extracted_name, stat_name_tags);
 }
 
 void AllocatorImpl::forEachCounter(SizeFn f_size, StatFn<Counter> f_stat) const {
@@ -9,6 +9,7 @@
 
 #include "source/common/common/thread_synchronizer.h"
 #include "source/common/stats/metric_impl.h"
+#include "source/common/stats/stat_slab.h"
 
 #include "absl/container/flat_hash_set.h"
 #include "absl/strings/string_view.h"
@@ -20,7 +21,7 @@ class AllocatorImpl : public Allocator {
 public:
   static const char DecrementToZeroSyncPoint[];
 
-  AllocatorImpl(SymbolTable& symbol_table) : symbol_table_(symbol_table) {}
+  AllocatorImpl(SymbolTable& symbol_table);
   ~AllocatorImpl() override;
 
   // Allocator
@@ -80,6 +81,12 @@ private:
   // protected by locks.
   mutable Thread::MutexBasicLockable mutex_;
 
+  // The storage of the stats, declared before the members holding references to stats so that
+  // it is destroyed after them.
+  StatSlab counter_slab_;
+  StatSlab gauge_slab_;
+  StatSlab text_readout_slab_;
+
   StatSet<Counter> counters_ ABSL_GUARDED_BY(mutex_);
   StatSet<Gauge> gauges_ ABSL_GUARDED_BY(mutex_);
   StatSet<TextReadout> text_readouts_ ABSL_GUARDED_BY(mutex_);
@@ -56,6 +56,22 @@ public:
                   const Protobuf::Map<std::string, uint64_t>& gauges,
                   const DynamicsMap& dynamics = DynamicsMap());
 
+  /**
+   * Adds a counter delta from the parent, as mergeStats() does for each of counter_deltas.
+   *
+   * @param stat_name the name of the counter, built as by the parent.
+   * @param delta the amount added to the counter.
+   */
+  void mergeCounter(StatName stat_name, uint64_t delta);
+
+  /**
+   * Sets the parent value of a gauge, as mergeStats() does for each of gauges.
+   *
+   * @param stat_name the name of the gauge, built as by the parent.
+   * @param parent_value the value of the gauge in the parent.
+   */
+  void mergeGauge(StatName stat_name, uint64_t parent_value);
+
   /**
    * Indicates that a gauge's value from the hot-restart parent should be
    * retained, combining it with the child data. By default, data is transferred
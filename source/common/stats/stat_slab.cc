@@ -0,0 +1,159 @@
+#include "source/common/stats/stat_slab.h"
+
+#include <algorithm>
+#include <new>
+
+#include "source/common/common/assert.h"
+#include "source/common/common/lock_guard.h"
+#include "source/common/memory/accounting.h"
+
+#include "absl/base/config.h"
+
+#ifdef ABSL_HAVE_ADDRESS_SANITIZER
+#include <sanitizer/asan_interface.h>
+#define STAT_SLAB_POISON(address, size) ASAN_POISON_MEMORY_REGION(address, size)
+#define STAT_SLAB_UNPOISON(address, size) ASAN_UNPOISON_MEMORY_REGION(address, size)
+#else
+#define STAT_SLAB_POISON(address, size)
+#define STAT_SLAB_UNPOISON(address, size)
+#endif
+
+namespace Envoy {
+namespace Stats {
+
+struct StatSlab::Chunk {
+  StatSlab* const slab_;
+  Chunk* prev_{};
+  Chunk* next_{};
+  // The freed blocks, linked through their first word.
+  void* free_list_{};
+  // The blocks are carved in order, when no freed block is left.
+  uint32_t carved_{};
+  uint32_t used_{};
+};
+
+namespace {
+
+size_t roundUp(size_t size, size_t alignment) {
+  return (size + alignment - 1) / alignment * alignment;
+}
+
+// The free list is linked through the freed blocks.
+size_t roundedBlockSize(size_t size, size_t alignment) {
+  return roundUp(std::max(size, sizeof(void*)), std::max(alignment, alignof(void*)));
+}
+
+} // namespace
+
+StatSlab::StatSlab(void* owner, size_t block_size, size_t block_alignment)
+    : owner_(owner), block_size_(roundedBlockSize(block_size, block_alignment)),
+      blocks_offset_(roundUp(sizeof(Chunk), std::max(block_alignment, alignof(void*)))),
+      blocks_per_chunk_((ChunkSize - blocks_offset_) / block_size_) {
+  RELEASE_ASSERT(blocks_per_chunk_ > 0, "stat too large for a slab chunk");
+}
+
+StatSlab::~StatSlab() {
+  Thread::LockGuard lock(mutex_);
+  while (head_ != nullptr) {
+    Chunk* chunk = head_;
+    unlink(*chunk);
+    STAT_SLAB_UNPOISON(chunk, ChunkSize);
+    chunk->~Chunk();
+    ::operator delete(chunk, std::align_val_t(ChunkSize));
+    Memory::Accounting::credit(Memory::Subsystem::Stats, ChunkSize);
+  }
+}
+
+bool StatSlab::full(const Chunk& chunk) const { return chunk.used_ == blocks_per_chunk_; }
+
+void* StatSlab::allocate() {
+  Thread::LockGuard lock(mutex_);
+  Chunk* chunk = head_;
+  if (chunk == nullptr || full(*chunk)) {
+    chunk = new (::operator new(ChunkSize, std::align_val_t(ChunkSize))) Chunk{this};
+    STAT_SLAB_POISON(reinterpret_cast<char*>(chunk) + blocks_offset_,
+                     ChunkSize - blocks_offset_);
+    ++num_chunks_;
+    Memory::Accounting::charge(Memory::Subsystem::Stats, ChunkSize);
+    pushFront(*chunk);
+  }
+
+  void* block = chunk->free_list_;
+  if (block != nullptr) {
+    STAT_SLAB_UNPOISON(block, block_size_);
+    chunk->free_list_ = *static_cast<void**>(block);
+  } else {
+    block = reinterpret_cast<char*>(chunk) + blocks_offset_ + chunk->carved_++ * block_size_;
+    STAT_SLAB_UNPOISON(block, block_size_);
+  }
+  if (++chunk->used_ == blocks_per_chunk_) {
+    unlink(*chunk);
+    pushBack(*chunk);
+  }
+  return block;
+}
+
+void StatSlab::release(void* block) {
+  if (block == nullptr) {
+    return;
+  }
+  Chunk* chunk = chunkOf(block);
+  StatSlab& slab = *chunk->slab_;
+  Thread::LockGuard lock(slab.mutex_);
+  ASSERT(chunk->used_ > 0);
+  const bool was_full = slab.full(*chunk);
+  *static_cast<void**>(block) = chunk->free_list_;
+  chunk->free_list_ = block;
+  STAT_SLAB_POISON(block, slab.block_size_);
+
+  if (--chunk->used_ == 0 && slab.num_chunks_ > 1) {
+    slab.unlink(*chunk);
+    --slab.num_chunks_;
+    STAT_SLAB_UNPOISON(chunk, ChunkSize);
+    chunk->~Chunk();
+    ::operator delete(chunk, std::align_val_t(ChunkSize));
+    Memory::Accounting::credit(Memory::Subsystem::Stats, ChunkSize);
+  } else if (was_full) {
+    slab.unlink(*chunk);
+    slab.pushFront(*chunk);
+  }
+}
+
+void* StatSlab::owner(const void* address) { return chunkOf(address)->slab_->owner_; }
+
+uint64_t StatSlab::numChunksForTest() const {
+  Thread::LockGuard lock(mutex_);
+  return num_chunks_;
+}
+
+void StatSlab::pushFront(Chunk& chunk) {
+  chunk.prev_ = nullptr;
+  chunk.next_ = head_;
+  if (head_ != nullptr) {
+    head_->prev_ = &chunk;
+  } else {
+    tail_ = &chunk;
+  }
+  head_ = &chunk;
+}
+
+void StatSlab::pushBack(Chunk& chunk) {
+  chunk.next_ = nullptr;
+  chunk.prev_ = tail_;
+  if (tail_ != nullptr) {
+    tail_->next_ = &chunk;
+  } else {
+    head_ = &chunk;
+  }
+  tail_ = &chunk;
+}
+
+void StatSlab::unlink(Chunk& chunk) {
+  (chunk.prev_ != nullptr ? chunk.prev_->next_ : head_) = chunk.next_;
+  (chunk.next_ != nullptr ? chunk.next_->prev_ : tail_) = chunk.prev_;
+  chunk.prev_ = nullptr;
+  chunk.next_ = nullptr;
+}
+
+} // namespace Stats
+} // namespace Envoy
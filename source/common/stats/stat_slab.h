@@ -0,0 +1,87 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "source/common/common/thread.h"
+#include "source/common/common/thread_annotations.h"
+
+namespace Envoy {
+namespace Stats {
+
+/**
+ * Fixed-size blocks for the stats of one type, carved from chunks aligned on their size. The
+ * stats of an allocator are thus laid out contiguously rather than scattered over the heap, with
+ * no per-object allocator overhead, and a stat finds its owner from the header of its chunk
+ * rather than from a member of its own.
+ *
+ * Freed blocks are reused before new ones are carved, and a chunk whose blocks have all been
+ * freed is returned to the heap unless it is the last chunk of the slab.
+ */
+class StatSlab {
+public:
+  static constexpr size_t ChunkSize = 64 * 1024;
+
+  /**
+   * @param owner supplies the object owning the stats, returned by owner().
+   * @param block_size supplies the size of the blocks.
+   * @param block_alignment supplies the alignment of the blocks.
+   */
+  StatSlab(void* owner, size_t block_size, size_t block_alignment);
+  ~StatSlab();
+
+  /**
+   * @return a block of the slab.
+   */
+  void* allocate();
+
+  /**
+   * Returns a block to the slab it was allocated from.
+   * @param block supplies the block, which may be nullptr.
+   */
+  static void release(void* block);
+
+  /**
+   * @param address supplies an address within a block.
+   * @return the owner of the slab the block was allocated from.
+   */
+  static void* owner(const void* address);
+
+  /**
+   * @return the size of the blocks.
+   */
+  size_t blockSize() const { return block_size_; }
+
+  /**
+   * @return the number of chunks of the slab, exposed for testing purposes.
+   */
+  uint64_t numChunksForTest() const;
+
+private:
+  struct Chunk;
+
+  static Chunk* chunkOf(const void* address) {
+    return reinterpret_cast<Chunk*>(reinterpret_cast<uintptr_t>(address) & ~(ChunkSize - 1));
+  }
+
+  bool full(const Chunk& chunk) const;
+  void pushFront(Chunk& chunk) ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+  void pushBack(Chunk& chunk) ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+  void unlink(Chunk& chunk) ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+
+  void* const owner_;
+  const size_t block_size_;
+  const size_t blocks_offset_;
+  const uint32_t blocks_per_chunk_;
+
+  // Allocation happens under the lock of the allocator, but the stats are released when their
+  // last reference is dropped, which can occur on any thread.
+  mutable Thread::MutexBasicLockable mutex_;
+  // All the chunks, those with free or uncarved blocks first.
+  Chunk* head_ ABSL_GUARDED_BY(mutex_){};
+  Chunk* tail_ ABSL_GUARDED_BY(mutex_){};
+  uint64_t num_chunks_ ABSL_GUARDED_BY(mutex_){};
+};
+
+} // namespace Stats
+} // namespace Envoy
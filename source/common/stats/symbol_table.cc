@@ -8,6 +8,7 @@
 #include "source/common/common/assert.h"
 #include "source/common/common/logger.h"
 #include "source/common/common/utility.h"
+#include "source/common/memory/accounting.h"
 
 #include "absl/strings/str_cat.h"
 
@@ -261,7 +262,7 @@ bool StatName::startsWith(StatName prefix) const {
 
 std::vector<absl::string_view> SymbolTable::decodeStrings(StatName stat_name) const {
   std::vector<absl::string_view> strings;
-  Thread::LockGuard lock(lock_);
+  absl::ReaderMutexLock lock(&lock_);
   Encoding::decodeTokens(
       stat_name,
       [this, &strings](Symbol symbol)
@@ -270,6 +271,17 @@ std::vector<absl::string_view> SymbolTable::decodeStrings(StatName stat_name) co
   return strings;
 }
 
+void SymbolTable::decodeTokens(StatName stat_name,
+                               const std::function<void(Symbol, absl::string_view)>& symbol_fn,
+                               const std::function<void(absl::string_view)>& dynamic_fn) const {
+  absl::ReaderMutexLock lock(&lock_);
+  Encoding::decodeTokens(
+      stat_name,
+      [this, &symbol_fn](Symbol symbol)
+          ABSL_NO_THREAD_SAFETY_ANALYSIS { symbol_fn(symbol, fromSymbol(symbol)); },
+      dynamic_fn);
+}
+
 void SymbolTable::Encoding::moveToMemBlock(MemBlockBuilder<uint8_t>& mem_block) {
   appendEncoding(data_bytes_required_, mem_block);
   mem_block.appendBlock(mem_block_);
@@ -309,20 +321,31 @@ void SymbolTable::addTokensToEncoding(const absl::string_view name, Encoding& en
   // We want to hold the lock for the minimum amount of time, so we do the
   // string-splitting and prepare a temp vector of Symbol first.
   const std::vector<absl::string_view> tokens = absl::StrSplit(name, '.');
-  std::vector<Symbol> symbols;
-  symbols.reserve(tokens.size());
+  std::vector<Symbol> symbols(tokens.size(), 0);
 
-  // Now take the lock and populate the Symbol objects, which involves bumping
-  // ref-counts in this.
+  // Most names are made of existing symbols, whose ref-counts can be bumped
+  // with the lock shared. Recording recent lookups needs it exclusively.
+  bool complete = false;
   {
-    Thread::LockGuard lock(lock_);
+    absl::ReaderMutexLock lock(&lock_);
+    if (recent_lookups_.capacity() == 0) {
+      complete = lookupSymbols(tokens, symbols);
+    }
+  }
+
+  // Now take the lock exclusively and populate the missing Symbol objects,
+  // which involves bumping ref-counts in this.
+  if (!complete) {
+    absl::MutexLock lock(&lock_);
     recent_lookups_.lookup(name);
-    for (auto& token : tokens) {
+    for (size_t i = 0; i < tokens.size(); ++i) {
       // TODO(jmarantz): consider using StatNameDynamicStorage for tokens with
       // length below some threshold, say 4 bytes. It might be preferable not to
       // reserve Symbols for every 3 digit number found (for example) in ipv4
       // addresses.
-      symbols.push_back(toSymbol(token));
+      if (symbols[i] == 0) {
+        symbols[i] = toSymbol(tokens[i]);
+      }
     }
   }
 
@@ -330,8 +353,38 @@ void SymbolTable::addTokensToEncoding(const absl::string_view name, Encoding& en
   encoding.addSymbols(symbols);
 }
 
+bool SymbolTable::lookupSymbols(const std::vector<absl::string_view>& tokens,
+                                std::vector<Symbol>& symbols) {
+  bool complete = true;
+  for (size_t i = 0; i < tokens.size(); ++i) {
+    auto encode_find = encode_map_.find(tokens[i]);
+    if (encode_find == encode_map_.end()) {
+      complete = false;
+      continue;
+    }
+    // The symbol is referenced with the lock held, so its count can't drop to zero meanwhile.
+    encode_find->second.ref_count_.fetch_add(1, std::memory_order_relaxed);
+    symbols[i] = encode_find->second.symbol_;
+  }
+  return complete;
+}
+
+SymbolTable::SharedSymbol& SymbolTable::sharedSymbol(Symbol symbol) {
+  auto decode_search = decode_map_.find(symbol);
+  ASSERT(decode_search != decode_map_.end(),
+         "Please see "
+         "https://github.com/envoyproxy/envoy/blob/main/source/docs/stats.md#"
+         "debugging-symbol-table-assertions");
+  auto encode_search = encode_map_.find(decode_search->second->toStringView());
+  ASSERT(encode_search != encode_map_.end(),
+         "Please see "
+         "https://github.com/envoyproxy/envoy/blob/main/source/docs/stats.md#"
+         "debugging-symbol-table-assertions");
+  return encode_search->second;
+}
+
 uint64_t SymbolTable::numSymbols() const {
-  Thread::LockGuard lock(lock_);
+  absl::ReaderMutexLock lock(&lock_);
   ASSERT(encode_map_.size() == decode_map_.size());
   return encode_map_.size();
 }
@@ -344,21 +397,10 @@ void SymbolTable::incRefCount(const StatName& stat_name) {
   // Before taking the lock, decode the array of symbols from the SymbolTable::Storage.
   const SymbolVec symbols = Encoding::decodeSymbols(stat_name);
 
-  Thread::LockGuard lock(lock_);
+  // The caller holds references on the symbols, which can be added to with the lock shared.
+  absl::ReaderMutexLock lock(&lock_);
   for (Symbol symbol : symbols) {
-    auto decode_search = decode_map_.find(symbol);
-
-    ASSERT(decode_search != decode_map_.end(),
-           "Please see "
-           "https://github.com/envoyproxy/envoy/blob/main/source/docs/stats.md#"
-           "debugging-symbol-table-assertions");
-    auto encode_search = encode_map_.find(decode_search->second->toStringView());
-    ASSERT(encode_search != encode_map_.end(),
-           "Please see "
-           "https://github.com/envoyproxy/envoy/blob/main/source/docs/stats.md#"
-           "debugging-symbol-table-assertions");
-
-    ++encode_search->second.ref_count_;
+    sharedSymbol(symbol).ref_count_.fetch_add(1, std::memory_order_relaxed);
   }
 }
 
@@ -366,8 +408,29 @@ void SymbolTable::free(const StatName& stat_name) {
   // Before taking the lock, decode the array of symbols from the SymbolTable::Storage.
   const SymbolVec symbols = Encoding::decodeSymbols(stat_name);
 
-  Thread::LockGuard lock(lock_);
-  for (Symbol symbol : symbols) {
+  // References which are not the last ones of their symbol are dropped with the
+  // lock shared. The last ones are left for the exclusive lock, as the symbol
+  // may be referenced again before it is taken.
+  SymbolVec last_references;
+  {
+    absl::ReaderMutexLock lock(&lock_);
+    for (Symbol symbol : symbols) {
+      std::atomic<uint32_t>& ref_count = sharedSymbol(symbol).ref_count_;
+      uint32_t count = ref_count.load(std::memory_order_relaxed);
+      while (count > 1 &&
+             !ref_count.compare_exchange_weak(count, count - 1, std::memory_order_relaxed)) {
+      }
+      if (count <= 1) {
+        last_references.push_back(symbol);
+      }
+    }
+  }
+  if (last_references.empty()) {
+    return;
+  }
+
+  absl::MutexLock lock(&lock_);
+  for (Symbol symbol : last_references) {
     auto decode_search = decode_map_.find(symbol);
     ASSERT(decode_search != decode_map_.end());
 
@@ -395,7 +458,7 @@ uint64_t SymbolTable::getRecentLookups(const RecentLookupsFn& iter) const {
   // We don't want to hold lock_ while calling the iterator, but we need it to
   // access recent_lookups_, so we buffer in name_count_map.
   {
-    Thread::LockGuard lock(lock_);
+    absl::ReaderMutexLock lock(&lock_);
     recent_lookups_.forEach(
         [&name_count_map](absl::string_view str, uint64_t count)
             ABSL_NO_THREAD_SAFETY_ANALYSIS { name_count_map[std::string(str)] += count; });
@@ -445,17 +508,17 @@ DynamicSpans SymbolTable::getDynamicSpans(StatName stat_name) const {
 }
 
 void SymbolTable::setRecentLookupCapacity(uint64_t capacity) {
-  Thread::LockGuard lock(lock_);
+  absl::MutexLock lock(&lock_);
   recent_lookups_.setCapacity(capacity);
 }
 
 void SymbolTable::clearRecentLookups() {
-  Thread::LockGuard lock(lock_);
+  absl::MutexLock lock(&lock_);
   recent_lookups_.clear();
 }
 
 uint64_t SymbolTable::recentLookupCapacity() const {
-  Thread::LockGuard lock(lock_);
+  absl::ReaderMutexLock lock(&lock_);
   return recent_lookups_.capacity();
 }
 
@@ -492,7 +555,7 @@ Symbol SymbolTable::toSymbol(absl::string_view sv) {
 }
 
 absl::string_view SymbolTable::fromSymbol(const Symbol symbol) const
-    ABSL_EXCLUSIVE_LOCKS_REQUIRED(lock_) {
+    ABSL_SHARED_LOCKS_REQUIRED(lock_) {
   auto search = decode_map_.find(symbol);
   RELEASE_ASSERT(search != decode_map_.end(), "no such symbol");
   return search->second->toStringView();
@@ -513,12 +576,12 @@ bool SymbolTable::lessThan(const StatName& a, const StatName& b) const {
   // Proactively take the table lock in anticipation that we'll need to
   // convert at least one symbol to a string_view, and it's easier not to
   // bother to lazily take the lock.
-  Thread::LockGuard lock(lock_);
+  absl::ReaderMutexLock lock(&lock_);
   return lessThanLockHeld(a, b);
 }
 
 bool SymbolTable::lessThanLockHeld(const StatName& a, const StatName& b) const
-    ABSL_EXCLUSIVE_LOCKS_REQUIRED(lock_) {
+    ABSL_SHARED_LOCKS_REQUIRED(lock_) {
   Encoding::TokenIter a_iter(a), b_iter(b);
   while (true) {
     Encoding::TokenIter::TokenType a_type = a_iter.next();
@@ -548,7 +611,7 @@ bool SymbolTable::lessThanLockHeld(const StatName& a, const StatName& b) const
 
 #ifndef ENVOY_CONFIG_COVERAGE
 void SymbolTable::debugPrint() const {
-  Thread::LockGuard lock(lock_);
+  absl::ReaderMutexLock lock(&lock_);
   std::vector<Symbol> symbols;
   for (const auto& p : decode_map_) {
     symbols.push_back(p.first);
@@ -557,7 +620,8 @@ void SymbolTable::debugPrint() const {
   for (Symbol symbol : symbols) {
     const InlineString& token = *decode_map_.find(symbol)->second;
     const SharedSymbol& shared_symbol = encode_map_.find(token.toStringView())->second;
-    ENVOY_LOG_MISC(info, "{}: '{}' ({})", symbol, token.toStringView(), shared_symbol.ref_count_);
+    ENVOY_LOG_MISC(info, "{}: '{}' ({})", symbol, token.toStringView(),
+                   shared_symbol.ref_count_.load());
   }
 }
 #endif
@@ -724,6 +788,7 @@ void SymbolTable::populateList(const StatName* names, uint32_t num_names, StatNa
   // we though we needed.
   ASSERT(mem_block.capacityRemaining() == 0);
   list.moveStorageIntoList(mem_block.release());
+  Memory::Accounting::charge(Memory::Subsystem::Stats, total_size_bytes);
 }
 
 StatNameList::~StatNameList() { ASSERT(!populated()); }
@@ -741,13 +806,16 @@ void StatNameList::iterate(const std::function<bool(StatName)>& f) const {
 }
 
 void StatNameList::clear(SymbolTable& symbol_table) {
-  iterate([&symbol_table](StatName stat_name) -> bool {
+  uint64_t size_bytes = 1;
+  iterate([&symbol_table, &size_bytes](StatName stat_name) -> bool {
+    size_bytes += stat_name.size();
     // nolint: https://github.com/llvm/llvm-project/issues/81597
     // NOLINTNEXTLINE(clang-analyzer-unix.Malloc)
     symbol_table.free(stat_name);
     return true;
   });
   storage_.reset();
+  Memory::Accounting::credit(Memory::Subsystem::Stats, size_bytes);
 }
 
 StatNameSet::StatNameSet(SymbolTable& symbol_table, absl::string_view name)
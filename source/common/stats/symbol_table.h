@@ -1,6 +1,7 @@
 #pragma once
 
 #include <algorithm>
+#include <atomic>
 #include <memory>
 #include <stack>
 #include <string>
@@ -19,6 +20,7 @@
 #include "absl/container/inlined_vector.h"
 #include "absl/strings/str_join.h"
 #include "absl/strings/str_split.h"
+#include "absl/synchronization/mutex.h"
 
 namespace Envoy {
 namespace Stats {
@@ -324,7 +326,21 @@ public:
    */
   DynamicSpans getDynamicSpans(StatName stat_name) const;
 
-  bool lessThanLockHeld(const StatName& a, const StatName& b) const;
+  /**
+   * Calls the functions with each token of a stat_name, in order, taking the lock once for the
+   * whole name. The functions must not call back into the table.
+   *
+   * @param stat_name the input stat name.
+   * @param symbol_fn called with the symbol of a symbolic token, which identifies it in this
+   *        table, and its string.
+   * @param dynamic_fn called with the string of a dynamic token, which may contain periods.
+   */
+  void decodeTokens(StatName stat_name,
+                    const std::function<void(Symbol, absl::string_view)>& symbol_fn,
+                    const std::function<void(absl::string_view)>& dynamic_fn) const;
+
+  bool lessThanLockHeld(const StatName& a, const StatName& b) const
+      ABSL_SHARED_LOCKS_REQUIRED(lock_);
 
   template <class GetStatName, class Obj> struct StatNameCompare {
     StatNameCompare(const SymbolTable& symbol_table, GetStatName getter)
@@ -349,7 +365,7 @@ public:
   void sortByStatNames(Iter begin, Iter end, GetStatName get_stat_name) const {
     // Grab the lock once before sorting begins, so we don't have to re-take
     // it on every comparison.
-    Thread::LockGuard lock(lock_);
+    absl::ReaderMutexLock lock(&lock_);
     StatNameCompare<GetStatName, Obj> compare(*this, get_stat_name);
     std::sort(begin, end, compare);
   }
@@ -397,13 +413,21 @@ private:
 
   struct SharedSymbol {
     SharedSymbol(Symbol symbol) : symbol_(symbol) {}
+    // The maps only move their values when they are modified, with the lock held exclusively.
+    SharedSymbol(SharedSymbol&& src) noexcept
+        : symbol_(src.symbol_), ref_count_(src.ref_count_.load(std::memory_order_relaxed)) {}
 
     Symbol symbol_;
-    uint32_t ref_count_{1};
+    // Changed with the lock held shared, as long as the symbol stays referenced. Dropping the
+    // last reference requires the exclusive lock, so that the symbol can't be resurrected
+    // concurrently.
+    std::atomic<uint32_t> ref_count_{1};
   };
 
-  // This must be held during both encode() and free().
-  mutable Thread::MutexBasicLockable lock_;
+  // This must be held exclusively to add or remove symbols, and shared to look them up. Encoding
+  // names whose symbols all exist and freeing references which are not the last ones only take
+  // it shared, so that workers building the same dynamic names don't serialize.
+  mutable absl::Mutex lock_;
 
   /**
    * Decodes a uint8_t array into an array of period-delimited strings. Note
@@ -420,6 +444,24 @@ private:
    */
   std::vector<absl::string_view> decodeStrings(StatName stat_name) const;
 
+  /**
+   * Looks up the symbols of the tokens, taking a reference on the ones which exist.
+   *
+   * @param tokens the tokens of a name.
+   * @param symbols receives the symbol of each token, or 0 if the token has no symbol.
+   * @return bool true if all the tokens have a symbol.
+   */
+  bool lookupSymbols(const std::vector<absl::string_view>& tokens, std::vector<Symbol>& symbols)
+      ABSL_SHARED_LOCKS_REQUIRED(lock_);
+
+  /**
+   * Finds the shared symbol of an encoded symbol.
+   *
+   * @param symbol the symbol.
+   * @return SharedSymbol& the symbol and its reference count.
+   */
+  SharedSymbol& sharedSymbol(Symbol symbol) ABSL_SHARED_LOCKS_REQUIRED(lock_);
+
   /**
    * Convenience function for encode(), symbolizing one string segment at a time.
    *
@@ -434,7 +476,7 @@ private:
    * @param symbol the individual symbol to be decoded.
    * @return absl::string_view the decoded string.
    */
-  absl::string_view fromSymbol(Symbol symbol) const ABSL_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+  absl::string_view fromSymbol(Symbol symbol) const ABSL_SHARED_LOCKS_REQUIRED(lock_);
 
   /**
    * Stages a new symbol for use. To be called after a successful insertion.
@@ -451,7 +493,7 @@ private:
   void addTokensToEncoding(absl::string_view name, Encoding& encoding);
 
   Symbol monotonicCounter() {
-    Thread::LockGuard lock(lock_);
+    absl::ReaderMutexLock lock(&lock_);
     return monotonic_counter_;
   }
 
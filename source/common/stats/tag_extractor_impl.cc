@@ -1,5 +1,6 @@
 #include "source/common/stats/tag_extractor_impl.h"
 
+#include <algorithm>
 #include <cstring>
 #include <string>
 
@@ -7,6 +8,7 @@
 
 #include "source/common/common/assert.h"
 #include "source/common/common/fmt.h"
+#include "source/common/common/logger.h"
 #include "source/common/common/perf_annotation.h"
 #include "source/common/common/regex.h"
 
@@ -33,6 +35,64 @@ const std::vector<absl::string_view>& TagExtractionContext::tokens() {
   return tokens_;
 }
 
+bool TagExtractionContext::re2MayMatch(int index) {
+  if (prefilter_ == nullptr || index < 0) {
+    return true;
+  }
+  if (!prefiltered_) {
+    prefiltered_ = true;
+    prefilter_matched_ = prefilter_->match(name_, prefilter_matches_);
+  }
+  return !prefilter_matched_ ||
+         std::binary_search(prefilter_matches_.begin(), prefilter_matches_.end(), index);
+}
+
+namespace {
+
+// Upper bound of the memory used by the compiled prefilter and its DFA cache. The extractors all
+// run their own match if the DFA runs out of memory.
+constexpr int64_t PrefilterMaxMemory = 8 << 20;
+
+re2::RE2::Options prefilterOptions() {
+  re2::RE2::Options options(re2::RE2::Quiet);
+  options.set_max_mem(PrefilterMaxMemory);
+  return options;
+}
+
+} // namespace
+
+// The extractors use RE2::PartialMatch, so the regexes may match anywhere in the name.
+TagExtractorRe2Prefilter::TagExtractorRe2Prefilter()
+    : set_(std::make_unique<re2::RE2::Set>(prefilterOptions(), re2::RE2::UNANCHORED)) {}
+
+int TagExtractorRe2Prefilter::add(absl::string_view regex) {
+  ASSERT(!compiled_);
+  return set_ != nullptr ? set_->Add(regex, nullptr) : -1;
+}
+
+void TagExtractorRe2Prefilter::compile() {
+  ASSERT(!compiled_);
+  compiled_ = true;
+  if (set_ != nullptr && !set_->Compile()) {
+    ENVOY_LOG_MISC(warn, "unable to compile the tag extractor prefilter, running every extractor");
+    set_.reset();
+  }
+}
+
+bool TagExtractorRe2Prefilter::match(absl::string_view name, std::vector<int>& matches) const {
+  if (!compiled_ || set_ == nullptr) {
+    return false;
+  }
+  re2::RE2::Set::ErrorInfo error_info;
+  if (!set_->Match(name, &matches, &error_info) && error_info.kind != re2::RE2::Set::kNoError) {
+    ENVOY_LOG_EVERY_POW_2_MISC(warn, "tag extractor prefilter failed, running every extractor");
+    return false;
+  }
+  // The matched regexes are not ordered.
+  std::sort(matches.begin(), matches.end());
+  return true;
+}
+
 namespace {
 
 bool regexStartsWithDot(absl::string_view regex) {
@@ -152,7 +212,7 @@ bool TagExtractorRe2Impl::extractTag(TagExtractionContext& context, std::vector<
   PERF_OPERATION(perf);
 
   absl::string_view stat_name = context.name();
-  if (substrMismatch(stat_name)) {
+  if (substrMismatch(stat_name) || !context.re2MayMatch(prefilter_index_)) {
     PERF_RECORD(perf, "re2-skip", name_);
     PERF_TAG_INC(skipped_);
     return false;
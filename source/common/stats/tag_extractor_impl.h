@@ -1,8 +1,10 @@
 #pragma once
 
 #include <cstdint>
+#include <memory>
 #include <regex>
 #include <string>
+#include <vector>
 
 #ifdef ENVOY_PERF_ANNOTATION
 #include <fmt/core.h>
@@ -18,17 +20,62 @@
 namespace Envoy {
 namespace Stats {
 
+/**
+ * The regexes of the RE2 tag extractors of a producer, compiled into a single RE2::Set. A stat
+ * name is scanned once against all of them, and only the extractors whose regex matches somewhere
+ * in the name run their capturing match.
+ */
+class TagExtractorRe2Prefilter {
+public:
+  TagExtractorRe2Prefilter();
+
+  /**
+   * @param regex supplies the regex of an RE2 extractor.
+   * @return the index of the regex in the prefilter, or -1 if it could not be added.
+   */
+  int add(absl::string_view regex);
+
+  /**
+   * Compiles the regexes, after which no more can be added.
+   */
+  void compile();
+
+  /**
+   * @param name supplies the stat name.
+   * @param matches receives the sorted indexes of the regexes matching the name.
+   * @return false if the name could not be scanned, in which case every extractor must run.
+   */
+  bool match(absl::string_view name, std::vector<int>& matches) const;
+
+private:
+  std::unique_ptr<re2::RE2::Set> set_;
+  bool compiled_{};
+};
+
 // Carries state across tag extractions.
 class TagExtractionContext {
 public:
-  explicit TagExtractionContext(absl::string_view name) : name_(name) {}
+  explicit TagExtractionContext(absl::string_view name,
+                                const TagExtractorRe2Prefilter* prefilter = nullptr)
+      : name_(name), prefilter_(prefilter) {}
 
   absl::string_view name() { return name_; }
   const std::vector<absl::string_view>& tokens();
 
+  /**
+   * @param index supplies the prefilter index of an RE2 extractor, or -1 if it has none.
+   * @return false if the regex of the extractor cannot match the name. The name is scanned
+   *         against the prefilter on first use.
+   */
+  bool re2MayMatch(int index);
+
 private:
   absl::string_view name_;
   std::vector<absl::string_view> tokens_;
+  const TagExtractorRe2Prefilter* const prefilter_;
+  bool prefiltered_{};
+  bool prefilter_matched_{};
+  std::vector<int> prefilter_matches_;
 };
 
 // To check if a tag extractor is actually used you can run
@@ -141,9 +188,18 @@ public:
   bool extractTag(TagExtractionContext& context, std::vector<Tag>& tags,
                   IntervalSet<size_t>& remove_characters) const override;
 
+  /**
+   * Adds the regex of the extractor to the prefilter of its producer.
+   * @param prefilter supplies the prefilter.
+   */
+  void addToPrefilter(TagExtractorRe2Prefilter& prefilter) {
+    prefilter_index_ = prefilter.add(regex_.pattern());
+  }
+
 private:
   const re2::RE2 regex_;
   const std::string negative_match_;
+  int prefilter_index_{-1};
 };
 
 /**
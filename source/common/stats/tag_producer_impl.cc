@@ -59,6 +59,7 @@ TagProducerImpl::TagProducerImpl(const envoy::config::metrics::v3::StatsConfig&
       fixed_tags_.push_back(Tag{name, tag_specifier.fixed_value()});
     }
   }
+  re2_prefilter_.compile();
 }
 
 absl::Status TagProducerImpl::addExtractorsMatching(absl::string_view name) {
@@ -88,6 +89,11 @@ absl::Status TagProducerImpl::addExtractorsMatching(absl::string_view name) {
 }
 
 void TagProducerImpl::addExtractor(TagExtractorPtr extractor) {
+  if (auto* re2_extractor = dynamic_cast<TagExtractorRe2Impl*>(extractor.get());
+      re2_extractor != nullptr) {
+    re2_extractor->addToPrefilter(re2_prefilter_);
+  }
+
   auto insertion = extractor_map_.insert(std::make_pair(extractor->name(), std::ref(*extractor)));
   if (!insertion.second) {
     extractor->setOtherExtractorWithSameNameExists(true);
@@ -124,8 +130,7 @@ void TagProducerImpl::forEachExtractorMatching(
 std::string TagProducerImpl::produceTags(absl::string_view metric_name, TagVector& tags) const {
   // TODO(jmarantz): Skip the creation of string-based tags, creating a StatNameTagVector instead.
   IntervalSetImpl<size_t> remove_characters;
-  TagExtractionContext tag_extraction_context(metric_name);
-  std::vector<absl::string_view> tokens;
+  TagExtractionContext tag_extraction_context(metric_name, &re2_prefilter_);
   absl::flat_hash_set<absl::string_view> dup_set;
   forEachExtractorMatching(metric_name, [&remove_characters, &tags, &tag_extraction_context,
                                          &dup_set](const TagExtractorPtr& tag_extractor) {
@@ -14,6 +14,7 @@
 #include "source/common/common/utility.h"
 #include "source/common/config/well_known_names.h"
 #include "source/common/protobuf/protobuf.h"
+#include "source/common/stats/tag_extractor_impl.h"
 
 #include "absl/container/flat_hash_map.h"
 #include "absl/container/node_hash_set.h"
@@ -117,6 +118,10 @@ private:
   // send duplicate tag names to Prometheus so this needs to be filtered out.
   absl::flat_hash_map<absl::string_view, std::reference_wrapper<TagExtractor>> extractor_map_;
 
+  // The regexes of all the RE2 extractors, so that a stat name is scanned once to find the ones
+  // which can match it.
+  TagExtractorRe2Prefilter re2_prefilter_;
+
   TagVector fixed_tags_;
 };
 
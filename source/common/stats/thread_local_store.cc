@@ -22,6 +22,17 @@
 
 namespace Envoy {
 namespace Stats {
+namespace {
+
+// The log linear histograms start with room for a few buckets, and grow as values fall in new
+// ones. Most histograms only see values in a few buckets, if any, e.g. the timing histograms of
+// rarely used routes, so most of the 100 buckets allocated upfront by default would be wasted in
+// each of the interval, cumulative and thread local histograms.
+constexpr int InitialHistogramBuckets = 4;
+
+histogram_t* allocHistogram() { return hist_alloc_nbins(InitialHistogramBuckets); }
+
+} // namespace
 
 const char ThreadLocalStoreImpl::DeleteScopeSync[] = "delete-scope";
 const char ThreadLocalStoreImpl::IterateScopeSync[] = "iterate-scope";
@@ -366,10 +377,25 @@ void ThreadLocalStoreImpl::clearScopesFromCaches() {
       *central_caches = std::move(central_cache_entries_to_cleanup_);
       central_cache_entries_to_cleanup_.clear();
     }
+    // The histograms released so far are cleared from the TLS caches along with the scopes, rather
+    // than in a pass of their own.
+    auto histograms = std::make_shared<std::vector<uint64_t>>();
+    {
+      Thread::LockGuard lock(hist_mutex_);
+      histograms->swap(histograms_to_cleanup_);
+    }
 
     tls_cache_->runOnAllThreads(
-        [scope_ids](OptRef<TlsCache> tls_cache) { tls_cache->eraseScopes(*scope_ids); },
-        [central_caches]() { /* Holds onto central_caches until all tls caches are clear */ });
+        [scope_ids, histograms](OptRef<TlsCache> tls_cache) {
+          tls_cache->eraseScopes(*scope_ids);
+          tls_cache->eraseHistograms(*histograms);
+        },
+        [this, central_caches]() {
+          // Releasing the central caches releases the histograms they were the last to reference,
+          // which are all cleared from the TLS caches in the next pass.
+          central_caches->clear();
+          clearHistogramsFromCaches();
+        });
   }
 }
 
@@ -384,6 +410,11 @@ void ThreadLocalStoreImpl::clearHistogramsFromCaches() {
       Thread::LockGuard lock(hist_mutex_);
       histograms->swap(histograms_to_cleanup_);
     }
+    // The histograms may already have been cleared along with scopes, or by a call made directly
+    // rather than by the post which released them.
+    if (histograms->empty()) {
+      return;
+    }
 
     tls_cache_->runOnAllThreads(
         [histograms](OptRef<TlsCache> tls_cache) { tls_cache->eraseHistograms(*histograms); });
@@ -804,8 +835,8 @@ ThreadLocalHistogramImpl::ThreadLocalHistogramImpl(StatName name, Histogram::Uni
                                                    SymbolTable& symbol_table)
     : HistogramImplHelper(name, tag_extracted_name, stat_name_tags, symbol_table), unit_(unit),
       used_(false), created_thread_id_(std::this_thread::get_id()), symbol_table_(symbol_table) {
-  histograms_[0] = hist_alloc();
-  histograms_[1] = hist_alloc();
+  histograms_[0] = allocHistogram();
+  histograms_[1] = allocHistogram();
 }
 
 ThreadLocalHistogramImpl::~ThreadLocalHistogramImpl() {
@@ -832,8 +863,8 @@ ParentHistogramImpl::ParentHistogramImpl(StatName name, Histogram::Unit unit,
                                          const StatNameTagVector& stat_name_tags,
                                          ConstSupportedBuckets& supported_buckets, uint64_t id)
     : MetricImpl(name, tag_extracted_name, stat_name_tags, thread_local_store.symbolTable()),
-      unit_(unit), thread_local_store_(thread_local_store), interval_histogram_(hist_alloc()),
-      cumulative_histogram_(hist_alloc()),
+      unit_(unit), thread_local_store_(thread_local_store), interval_histogram_(allocHistogram()),
+      cumulative_histogram_(allocHistogram()),
       interval_statistics_(interval_histogram_, unit, supported_buckets),
       cumulative_statistics_(cumulative_histogram_, unit, supported_buckets), id_(id) {}
 
@@ -921,22 +952,46 @@ void ParentHistogramImpl::merge() {
     }
     // Since TLS merge is done, we can release the lock here.
     lock.release();
-    hist_accumulate(cumulative_histogram_, &interval_histogram_, 1);
-    cumulative_statistics_.refresh(cumulative_histogram_);
-    interval_statistics_.refresh(interval_histogram_);
+    // Without new samples, the cumulative histogram is unchanged, and the interval one only
+    // needs its statistics cleared after an interval which had samples.
+    const bool has_samples = hist_sample_count(interval_histogram_) > 0;
+    if (has_samples) {
+      hist_accumulate(cumulative_histogram_, &interval_histogram_, 1);
+      cumulative_statistics_stale_ = true;
+    }
+    interval_statistics_stale_ |= has_samples || interval_had_samples_;
+    interval_had_samples_ = has_samples;
     merged_ = true;
   }
 }
 
+const HistogramStatistics& ParentHistogramImpl::intervalStatistics() const {
+  if (interval_statistics_stale_) {
+    interval_statistics_.refresh(interval_histogram_);
+    interval_statistics_stale_ = false;
+  }
+  return interval_statistics_;
+}
+
+const HistogramStatistics& ParentHistogramImpl::cumulativeStatistics() const {
+  if (cumulative_statistics_stale_) {
+    cumulative_statistics_.refresh(cumulative_histogram_);
+    cumulative_statistics_stale_ = false;
+  }
+  return cumulative_statistics_;
+}
+
 std::string ParentHistogramImpl::quantileSummary() const {
   if (used()) {
     std::vector<std::string> summary;
-    const std::vector<double>& supported_quantiles_ref = interval_statistics_.supportedQuantiles();
+    const HistogramStatistics& interval_statistics = intervalStatistics();
+    const HistogramStatistics& cumulative_statistics = cumulativeStatistics();
+    const std::vector<double>& supported_quantiles_ref = interval_statistics.supportedQuantiles();
     summary.reserve(supported_quantiles_ref.size());
     for (size_t i = 0; i < supported_quantiles_ref.size(); ++i) {
       summary.push_back(fmt::format("P{:g}({},{})", 100 * supported_quantiles_ref[i],
-                                    interval_statistics_.computedQuantiles()[i],
-                                    cumulative_statistics_.computedQuantiles()[i]));
+                                    interval_statistics.computedQuantiles()[i],
+                                    cumulative_statistics.computedQuantiles()[i]));
     }
     return absl::StrJoin(summary, " ");
   } else {
@@ -947,12 +1002,14 @@ std::string ParentHistogramImpl::quantileSummary() const {
 std::string ParentHistogramImpl::bucketSummary() const {
   if (used()) {
     std::vector<std::string> bucket_summary;
-    ConstSupportedBuckets& supported_buckets = interval_statistics_.supportedBuckets();
+    const HistogramStatistics& interval_statistics = intervalStatistics();
+    const HistogramStatistics& cumulative_statistics = cumulativeStatistics();
+    ConstSupportedBuckets& supported_buckets = interval_statistics.supportedBuckets();
     bucket_summary.reserve(supported_buckets.size());
     for (size_t i = 0; i < supported_buckets.size(); ++i) {
       bucket_summary.push_back(fmt::format("B{:g}({},{})", supported_buckets[i],
-                                           interval_statistics_.computedBuckets()[i],
-                                           cumulative_statistics_.computedBuckets()[i]));
+                                           interval_statistics.computedBuckets()[i],
+                                           cumulative_statistics.computedBuckets()[i]));
     }
     return absl::StrJoin(bucket_summary, " ");
   } else {
@@ -96,14 +96,13 @@ public:
    * This method is called during the main stats flush process for each of the histograms. It
    * iterates through the TLS histograms and collects the histogram data of all of them
    * in to "interval_histogram". Then the collected "interval_histogram" is merged to a
-   * "cumulative_histogram".
+   * "cumulative_histogram". The statistics are only recomputed when they are accessed, and
+   * when the merged histograms changed.
    */
   void merge() override;
 
-  const HistogramStatistics& intervalStatistics() const override { return interval_statistics_; }
-  const HistogramStatistics& cumulativeStatistics() const override {
-    return cumulative_statistics_;
-  }
+  const HistogramStatistics& intervalStatistics() const override;
+  const HistogramStatistics& cumulativeStatistics() const override;
   std::string quantileSummary() const override;
   std::string bucketSummary() const override;
   std::vector<Bucket> detailedTotalBuckets() const override {
@@ -136,8 +135,14 @@ private:
   ThreadLocalStoreImpl& thread_local_store_;
   histogram_t* interval_histogram_;
   histogram_t* cumulative_histogram_;
-  HistogramStatisticsImpl interval_statistics_;
-  HistogramStatisticsImpl cumulative_statistics_;
+  // Refreshed on the main thread, where the histograms are merged, when first accessed after
+  // a merge which changed them.
+  mutable HistogramStatisticsImpl interval_statistics_;
+  mutable HistogramStatisticsImpl cumulative_statistics_;
+  mutable bool interval_statistics_stale_{false};
+  mutable bool cumulative_statistics_stale_{false};
+  // Whether the last merged interval had samples.
+  bool interval_had_samples_{false};
   mutable Thread::MutexBasicLockable merge_lock_;
   std::list<TlsHistogramSharedPtr> tls_histograms_ ABSL_GUARDED_BY(merge_lock_);
   bool merged_{false};
@@ -78,17 +78,23 @@ void FilterStateImpl::setData(absl::string_view data_name, std::shared_ptr<Objec
   data_storage_[data_name] = std::move(filter_object);
 }
 
+template <class Name> bool FilterStateImpl::hasDataWithNameImpl(const Name& name) const {
+  return data_storage_.contains(name) || (parent_ && parent_->hasDataWithName(name));
+}
+
 bool FilterStateImpl::hasDataWithName(absl::string_view data_name) const {
-  return hasDataWithNameInternally(data_name) || (parent_ && parent_->hasDataWithName(data_name));
+  return hasDataWithNameImpl(data_name);
 }
 
-const FilterState::Object*
-FilterStateImpl::getDataReadOnlyGeneric(absl::string_view data_name) const {
-  const auto it = data_storage_.find(data_name);
+bool FilterStateImpl::hasDataWithName(const Key& key) const { return hasDataWithNameImpl(key); }
+
+template <class Name>
+const FilterState::Object* FilterStateImpl::getDataReadOnlyImpl(const Name& name) const {
+  const auto it = data_storage_.find(name);
 
   if (it == data_storage_.end()) {
     if (parent_) {
-      return parent_->getDataReadOnlyGeneric(data_name);
+      return parent_->getDataReadOnlyGeneric(name);
     }
     return nullptr;
   }
@@ -97,6 +103,15 @@ FilterStateImpl::getDataReadOnlyGeneric(absl::string_view data_name) const {
   return current->data_.get();
 }
 
+const FilterState::Object*
+FilterStateImpl::getDataReadOnlyGeneric(absl::string_view data_name) const {
+  return getDataReadOnlyImpl(data_name);
+}
+
+const FilterState::Object* FilterStateImpl::getDataReadOnlyGeneric(const Key& key) const {
+  return getDataReadOnlyImpl(key);
+}
+
 FilterState::Object* FilterStateImpl::getDataMutableGeneric(absl::string_view data_name) {
   return getDataSharedMutableGeneric(data_name).get();
 }
@@ -37,8 +37,10 @@ public:
       absl::string_view data_name, std::shared_ptr<Object> data, FilterState::StateType state_type,
       FilterState::LifeSpan life_span = FilterState::LifeSpan::FilterChain,
       StreamSharingMayImpactPooling stream_sharing = StreamSharingMayImpactPooling::None) override;
-  bool hasDataWithName(absl::string_view) const override;
+  bool hasDataWithName(absl::string_view data_name) const override;
+  bool hasDataWithName(const Key& key) const override;
   const Object* getDataReadOnlyGeneric(absl::string_view data_name) const override;
+  const Object* getDataReadOnlyGeneric(const Key& key) const override;
   Object* getDataMutableGeneric(absl::string_view data_name) override;
   std::shared_ptr<Object> getDataSharedMutableGeneric(absl::string_view data_name) override;
   bool hasDataAtOrAboveLifeSpan(FilterState::LifeSpan life_span) const override;
@@ -48,13 +50,29 @@ public:
   FilterStateSharedPtr parent() const override { return parent_; }
 
 private:
+  // Looks up the names either by themselves or by key, using the hash of the key.
+  struct NameHash {
+    using is_transparent = void;
+    size_t operator()(absl::string_view name) const {
+      return absl::Hash<absl::string_view>{}(name);
+    }
+    size_t operator()(const Key& key) const { return key.hash(); }
+  };
+  struct NameEq {
+    using is_transparent = void;
+    bool operator()(absl::string_view lhs, absl::string_view rhs) const { return lhs == rhs; }
+    bool operator()(absl::string_view lhs, const Key& rhs) const { return lhs == rhs.name(); }
+  };
+
   // This only checks the local data_storage_ for data_name existence.
   bool hasDataWithNameInternally(absl::string_view data_name) const;
+  template <class Name> bool hasDataWithNameImpl(const Name& name) const;
+  template <class Name> const Object* getDataReadOnlyImpl(const Name& name) const;
   void maybeCreateParent(FilterStateSharedPtr ancestor);
 
   FilterStateSharedPtr parent_;
   const FilterState::LifeSpan life_span_;
-  absl::flat_hash_map<std::string, std::unique_ptr<FilterObject>> data_storage_;
+  absl::flat_hash_map<std::string, std::unique_ptr<FilterObject>, NameHash, NameEq> data_storage_;
 };
 
 } // namespace StreamInfo
@@ -197,16 +197,24 @@ struct StreamInfoImpl : public StreamInfo {
   uint64_t bytesReceived() const override { return bytes_received_; }
 
   void addBytesRetransmitted(uint64_t bytes_retransmitted) override {
-    bytes_retransmitted_ += bytes_retransmitted;
+    if (bytes_retransmitted != 0) {
+      rareFields().bytes_retransmitted_ += bytes_retransmitted;
+    }
   }
 
-  uint64_t bytesRetransmitted() const override { return bytes_retransmitted_; }
+  uint64_t bytesRetransmitted() const override {
+    return rare_fields_ != nullptr ? rare_fields_->bytes_retransmitted_ : 0;
+  }
 
   void addPacketsRetransmitted(uint64_t packets_retransmitted) override {
-    packets_retransmitted_ += packets_retransmitted;
+    if (packets_retransmitted != 0) {
+      rareFields().packets_retransmitted_ += packets_retransmitted;
+    }
   }
 
-  uint64_t packetsRetransmitted() const override { return packets_retransmitted_; }
+  uint64_t packetsRetransmitted() const override {
+    return rare_fields_ != nullptr ? rare_fields_->packets_retransmitted_ : 0;
+  }
 
   absl::optional<Http::Protocol> protocol() const override { return protocol_; }
 
@@ -227,11 +235,12 @@ struct StreamInfoImpl : public StreamInfo {
   }
 
   const absl::optional<std::string>& connectionTerminationDetails() const override {
-    return connection_termination_details_;
+    return rare_fields_ != nullptr ? rare_fields_->connection_termination_details_
+                                   : emptyOptionalString();
   }
 
   void setConnectionTerminationDetails(absl::string_view connection_termination_details) override {
-    connection_termination_details_.emplace(connection_termination_details);
+    rareFields().connection_termination_details_.emplace(connection_termination_details);
   }
 
   void addBytesSent(uint64_t bytes_sent) override { bytes_sent_ += bytes_sent; }
@@ -269,11 +278,13 @@ struct StreamInfoImpl : public StreamInfo {
   }
 
   void setVirtualClusterName(const absl::optional<std::string>& virtual_cluster_name) override {
-    virtual_cluster_name_ = virtual_cluster_name;
+    if (virtual_cluster_name.has_value() || rare_fields_ != nullptr) {
+      rareFields().virtual_cluster_name_ = virtual_cluster_name;
+    }
   }
 
   const absl::optional<std::string>& virtualClusterName() const override {
-    return virtual_cluster_name_;
+    return rare_fields_ != nullptr ? rare_fields_->virtual_cluster_name_ : emptyOptionalString();
   }
 
   bool healthCheck() const override { return health_check_request_; }
@@ -374,9 +385,13 @@ struct StreamInfoImpl : public StreamInfo {
     // These two are set in the constructor, but to T(recreate), and should be T(create)
     start_time_ = info.startTime();
     start_time_monotonic_ = info.startTimeMonotonic();
-    downstream_transport_failure_reason_ = std::string(info.downstreamTransportFailureReason());
-    bytes_retransmitted_ = info.bytesRetransmitted();
-    packets_retransmitted_ = info.packetsRetransmitted();
+    setDownstreamTransportFailureReason(info.downstreamTransportFailureReason());
+    if (rare_fields_ != nullptr) {
+      rare_fields_->bytes_retransmitted_ = 0;
+      rare_fields_->packets_retransmitted_ = 0;
+    }
+    addBytesRetransmitted(info.bytesRetransmitted());
+    addPacketsRetransmitted(info.packetsRetransmitted());
     if (Runtime::runtimeFeatureEnabled(
             "envoy.reloadable_features.http1_connection_close_header_in_redirect")) {
       should_drain_connection_ = info.shouldDrainConnectionUponCompletion();
@@ -390,10 +405,12 @@ struct StreamInfoImpl : public StreamInfo {
   // * downstream_connection_info_provider_ is always set in the ctor.
   void setFrom(StreamInfo& info, const Http::RequestHeaderMap* request_headers) {
     setFromForRecreateStream(info);
-    virtual_cluster_name_ = info.virtualClusterName();
+    setVirtualClusterName(info.virtualClusterName());
     response_code_ = info.responseCode();
     response_code_details_ = info.responseCodeDetails();
-    connection_termination_details_ = info.connectionTerminationDetails();
+    if (info.connectionTerminationDetails().has_value() || rare_fields_ != nullptr) {
+      rareFields().connection_termination_details_ = info.connectionTerminationDetails();
+    }
     upstream_info_ = info.upstreamInfo();
     if (info.requestComplete().has_value()) {
       // derive final time from other info's complete duration and start time.
@@ -425,11 +442,14 @@ struct StreamInfoImpl : public StreamInfo {
   bool isShadow() const override { return is_shadow_; }
 
   void setDownstreamTransportFailureReason(absl::string_view failure_reason) override {
-    downstream_transport_failure_reason_ = std::string(failure_reason);
+    if (!failure_reason.empty() || rare_fields_ != nullptr) {
+      rareFields().downstream_transport_failure_reason_ = std::string(failure_reason);
+    }
   }
 
   absl::string_view downstreamTransportFailureReason() const override {
-    return downstream_transport_failure_reason_;
+    return rare_fields_ != nullptr ? rare_fields_->downstream_transport_failure_reason_
+                                   : absl::string_view();
   }
 
   bool shouldSchemeMatchUpstream() const override { return should_scheme_match_upstream_; }
@@ -451,9 +471,29 @@ struct StreamInfoImpl : public StreamInfo {
   absl::optional<Http::Protocol> protocol_;
 
 private:
+  // The fields which most streams don't set, allocated when one of them is.
+  struct RareFields {
+    absl::optional<std::string> connection_termination_details_;
+    absl::optional<std::string> virtual_cluster_name_;
+    std::string downstream_transport_failure_reason_;
+    uint64_t bytes_retransmitted_{};
+    uint64_t packets_retransmitted_{};
+  };
+
+  RareFields& rareFields() {
+    if (rare_fields_ == nullptr) {
+      rare_fields_ = std::make_unique<RareFields>();
+    }
+    return *rare_fields_;
+  }
+
+  static const absl::optional<std::string>& emptyOptionalString() {
+    CONSTRUCT_ON_FIRST_USE(absl::optional<std::string>);
+  }
+
   absl::optional<uint32_t> response_code_;
   absl::optional<std::string> response_code_details_;
-  absl::optional<std::string> connection_termination_details_;
+  std::unique_ptr<RareFields> rare_fields_;
 
 public:
   absl::InlinedVector<ResponseFlag, 4> response_flags_{};
@@ -464,9 +504,6 @@ public:
 
 private:
   absl::optional<uint32_t> attempt_count_;
-  // TODO(agrawroh): Check if the owner of this storage outlives the StreamInfo. We should only copy
-  // the string if it could outlive the StreamInfo.
-  absl::optional<std::string> virtual_cluster_name_;
 
   static Network::ConnectionInfoProviderSharedPtr emptyDownstreamAddressProvider() {
     MUTABLE_CONSTRUCT_ON_FIRST_USE(
@@ -476,8 +513,6 @@ private:
 
   std::shared_ptr<UpstreamInfo> upstream_info_;
   uint64_t bytes_received_{};
-  uint64_t bytes_retransmitted_{};
-  uint64_t packets_retransmitted_{};
   uint64_t bytes_sent_{};
   const Network::ConnectionInfoProviderSharedPtr downstream_connection_info_provider_;
   const Http::RequestHeaderMap* request_headers_{};
@@ -489,7 +524,6 @@ private:
   BytesMeterSharedPtr upstream_bytes_meter_{std::make_shared<BytesMeter>()};
   BytesMeterSharedPtr downstream_bytes_meter_;
   bool is_shadow_{false};
-  std::string downstream_transport_failure_reason_;
   bool should_scheme_match_upstream_{false};
   bool should_drain_connection_{false};
 };
@@ -47,6 +47,9 @@ public:
       parent_.onUpstreamData(data, end_stream);
       return Network::FilterStatus::StopIteration;
     }
+    void initializeReadFilterCallbacks(Network::ReadFilterCallbacks& callbacks) override {
+      parent_.socket_ = &callbacks.socket();
+    }
     ActiveTcpClient& parent_;
   };
 
@@ -67,6 +70,7 @@ public:
     }
 
     Network::ClientConnection& connection() override { return connection_; }
+    const Network::Socket* socket() override { return parent_ ? parent_->socket_ : nullptr; }
     void setConnectionState(ConnectionPool::ConnectionStatePtr&& state) override {
       parent_->connection_state_ = std::move(state);
     }
@@ -125,6 +129,8 @@ public:
   Envoy::ConnectionPool::ConnPoolImplBase& parent_;
   ConnectionPool::UpstreamCallbacks* callbacks_{};
   Network::ClientConnectionPtr connection_;
+  // The socket of connection_, known once its read filters are initialized.
+  const Network::Socket* socket_{};
   ConnectionPool::ConnectionStatePtr connection_state_;
   TcpConnectionData* tcp_connection_data_{};
   bool associated_before_{};
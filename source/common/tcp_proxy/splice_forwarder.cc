@@ -0,0 +1,192 @@
+#include "source/common/tcp_proxy/splice_forwarder.h"
+
+#if defined(__linux__)
+#include <fcntl.h>
+#endif
+
+#include "envoy/api/os_sys_calls.h"
+
+#include "source/common/api/os_sys_calls_impl.h"
+#include "source/common/common/assert.h"
+#include "source/common/common/utility.h"
+#include "source/common/network/connection_impl.h"
+#include "source/common/network/raw_buffer_socket.h"
+
+#if defined(__linux__)
+#include "source/common/api/os_sys_calls_impl_linux.h"
+#endif
+
+namespace Envoy {
+namespace TcpProxy {
+
+bool SpliceForwarder::usesRawBufferTransport(const Network::Connection& connection) {
+  // The other implementations of the connections, e.g. the happy eyeballs ones, are not spliced.
+  const auto* connection_impl = dynamic_cast<const Network::ConnectionImpl*>(&connection);
+  return connection_impl != nullptr &&
+         dynamic_cast<const Network::RawBufferSocket*>(
+             connection_impl->transportSocket().get()) != nullptr;
+}
+
+#if defined(__linux__)
+
+namespace {
+
+// The default capacity of a pipe, which is also the most a single splice() moves.
+constexpr size_t PipeCapacity = 64 * 1024;
+// The number of times the source of a direction is read before yielding to other events.
+constexpr uint32_t MaxReadsPerEvent = 16;
+
+Api::SysCallSizeResult splice(os_fd_t from, os_fd_t to, size_t length) {
+  return Api::LinuxOsSysCallsSingleton::get().splice(from, nullptr, to, nullptr, length,
+                                                     SPLICE_F_MOVE | SPLICE_F_NONBLOCK);
+}
+
+} // namespace
+
+bool SpliceForwarder::isSupported() { return true; }
+
+SpliceForwarderPtr SpliceForwarder::create(Event::Dispatcher& dispatcher, os_fd_t downstream_fd,
+                                           os_fd_t upstream_fd, Callbacks& callbacks) {
+  SpliceForwarderPtr forwarder(new SpliceForwarder(downstream_fd, upstream_fd, callbacks));
+  if (!forwarder->createPipe(forwarder->downstream_to_upstream_) ||
+      !forwarder->createPipe(forwarder->upstream_to_downstream_)) {
+    return nullptr;
+  }
+
+  // The sockets are watched with the trigger type of the connections so that libevent accepts a
+  // second event on their file descriptors. Registering the events reports the current readiness
+  // of the sockets, which starts the transfers.
+  SpliceForwarder* raw = forwarder.get();
+  forwarder->downstream_event_ = dispatcher.createFileEvent(
+      downstream_fd,
+      [raw](uint32_t events) {
+        raw->onFileEvent(events, raw->downstream_to_upstream_, raw->upstream_to_downstream_);
+        return absl::OkStatus();
+      },
+      Event::PlatformDefaultTriggerType, Event::FileReadyType::Read | Event::FileReadyType::Write);
+  forwarder->upstream_event_ = dispatcher.createFileEvent(
+      upstream_fd,
+      [raw](uint32_t events) {
+        raw->onFileEvent(events, raw->upstream_to_downstream_, raw->downstream_to_upstream_);
+        return absl::OkStatus();
+      },
+      Event::PlatformDefaultTriggerType, Event::FileReadyType::Read | Event::FileReadyType::Write);
+  forwarder->downstream_to_upstream_.source_event_ = forwarder->downstream_event_.get();
+  forwarder->upstream_to_downstream_.source_event_ = forwarder->upstream_event_.get();
+  return forwarder;
+}
+
+SpliceForwarder::SpliceForwarder(os_fd_t downstream_fd, os_fd_t upstream_fd, Callbacks& callbacks)
+    : callbacks_(callbacks),
+      downstream_to_upstream_{Direction::DownstreamToUpstream, downstream_fd, upstream_fd},
+      upstream_to_downstream_{Direction::UpstreamToDownstream, upstream_fd, downstream_fd} {}
+
+SpliceForwarder::~SpliceForwarder() {
+  // The file events must go away before the pipes, and before the connections close the sockets.
+  downstream_event_.reset();
+  upstream_event_.reset();
+  auto& os_sys_calls = Api::OsSysCallsSingleton::get();
+  for (Pipe* pipe : {&downstream_to_upstream_, &upstream_to_downstream_}) {
+    if (pipe->read_end_ != INVALID_SOCKET) {
+      os_sys_calls.close(pipe->read_end_);
+      os_sys_calls.close(pipe->write_end_);
+    }
+  }
+}
+
+bool SpliceForwarder::createPipe(Pipe& pipe) {
+  os_fd_t fds[2];
+  const Api::SysCallIntResult result =
+      Api::LinuxOsSysCallsSingleton::get().pipe2(fds, O_NONBLOCK | O_CLOEXEC);
+  if (result.return_value_ != 0) {
+    ENVOY_LOG(debug, "failed to create splice pipe: {}", errorDetails(result.errno_));
+    return false;
+  }
+  pipe.read_end_ = fds[0];
+  pipe.write_end_ = fds[1];
+  return true;
+}
+
+void SpliceForwarder::onFileEvent(uint32_t events, Pipe& read_pipe, Pipe& write_pipe) {
+  // The socket is the source of read_pipe and the destination of write_pipe.
+  if (events & Event::FileReadyType::Write) {
+    transfer(write_pipe);
+  }
+  if (events & Event::FileReadyType::Read) {
+    transfer(read_pipe);
+  }
+}
+
+void SpliceForwarder::transfer(Pipe& pipe) {
+  if (pipe.done_) {
+    return;
+  }
+
+  uint64_t moved = 0;
+  uint32_t reads = 0;
+  while (true) {
+    if (pipe.buffered_ > 0) {
+      const Api::SysCallSizeResult result =
+          splice(pipe.read_end_, pipe.destination_, pipe.buffered_);
+      if (result.return_value_ > 0) {
+        pipe.buffered_ -= result.return_value_;
+        moved += result.return_value_;
+        continue;
+      }
+      if (result.errno_ == SOCKET_ERROR_AGAIN) {
+        // Resumes once the destination is writable.
+        break;
+      }
+      // The bytes left in the pipe cannot be delivered. The connection of the destination
+      // observes the error as well, and closes both connections.
+      ENVOY_LOG(debug, "splice to fd {} failed: {}", pipe.destination_,
+                errorDetails(result.errno_));
+      pipe.buffered_ = 0;
+      pipe.source_done_ = true;
+    }
+
+    if (pipe.source_done_) {
+      pipe.done_ = true;
+      break;
+    }
+    if (reads == MaxReadsPerEvent) {
+      // Yield to the other events of the dispatcher, reading resumes in its next iteration.
+      pipe.source_event_->activate(Event::FileReadyType::Read);
+      break;
+    }
+    ++reads;
+
+    const Api::SysCallSizeResult result = splice(pipe.source_, pipe.write_end_, PipeCapacity);
+    if (result.return_value_ > 0) {
+      pipe.buffered_ += result.return_value_;
+    } else if (result.return_value_ == 0 || result.errno_ != SOCKET_ERROR_AGAIN) {
+      // End of stream or error, which the connection of the source observes once it reads again.
+      pipe.source_done_ = true;
+    } else {
+      // Resumes once the source is readable.
+      break;
+    }
+  }
+
+  if (moved > 0) {
+    callbacks_.onSplicedBytes(pipe.direction_, moved);
+  }
+  if (pipe.done_) {
+    callbacks_.onSpliceDone(pipe.direction_);
+  }
+}
+
+#else
+
+bool SpliceForwarder::isSupported() { return false; }
+
+SpliceForwarderPtr SpliceForwarder::create(Event::Dispatcher&, os_fd_t, os_fd_t, Callbacks&) {
+  return nullptr;
+}
+
+SpliceForwarder::~SpliceForwarder() = default;
+
+#endif
+
+} // namespace TcpProxy
+} // namespace Envoy
@@ -0,0 +1,123 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+
+#include "envoy/common/platform.h"
+#include "envoy/common/pure.h"
+#include "envoy/event/dispatcher.h"
+#include "envoy/event/file_event.h"
+#include "envoy/network/connection.h"
+
+#include "source/common/common/logger.h"
+#include "source/common/common/non_copyable.h"
+
+namespace Envoy {
+namespace TcpProxy {
+
+class SpliceForwarder;
+using SpliceForwarderPtr = std::unique_ptr<SpliceForwarder>;
+
+/**
+ * Moves the bytes between the sockets of a downstream and an upstream TCP connection with
+ * splice(2), through a pipe per direction, so that they are neither copied to user space nor held
+ * in connection buffers. The connections must not read from their sockets while the bytes of a
+ * direction are spliced, nor write to them while splicing, and must have nothing left to write to
+ * them when splicing starts.
+ *
+ * A direction holds at most the capacity of its pipe: its source is only read once the bytes in
+ * the pipe are written to its destination, so a slow reader on one side throttles the other side
+ * the way the watermarks of the connection buffers would.
+ */
+class SpliceForwarder : NonCopyable, Logger::Loggable<Logger::Id::filter> {
+public:
+  enum class Direction { DownstreamToUpstream, UpstreamToDownstream };
+
+  class Callbacks {
+  public:
+    virtual ~Callbacks() = default;
+
+    /**
+     * Called when bytes were moved from the source of a direction to its destination.
+     * @param direction supplies the direction the bytes were moved in.
+     * @param bytes supplies the number of bytes moved.
+     */
+    virtual void onSplicedBytes(Direction direction, uint64_t bytes) PURE;
+
+    /**
+     * Called once the source of a direction reached the end of stream or failed, or its
+     * destination failed. The bytes of the direction are no longer spliced, and the connection of
+     * its source must read from its socket again to observe the end of stream or the error. The
+     * forwarder must not be destroyed from this callback.
+     * @param direction supplies the direction that is done.
+     */
+    virtual void onSpliceDone(Direction direction) PURE;
+  };
+
+  /**
+   * @return whether splicing is supported on this platform.
+   */
+  static bool isSupported();
+
+  /**
+   * @return whether the connection reads and writes its bytes as is, through the raw buffer
+   *         transport socket. The bytes of the other transport sockets can't bypass them, either
+   *         because they are encrypted (TLS, ALTS) or because the transport socket writes its own
+   *         bytes (PROXY protocol, HTTP/1.1 CONNECT).
+   */
+  static bool usesRawBufferTransport(const Network::Connection& connection);
+
+  /**
+   * Starts splicing between the sockets of two connections.
+   * @param dispatcher supplies the dispatcher of the connections.
+   * @param downstream_fd supplies the socket of the downstream connection.
+   * @param upstream_fd supplies the socket of the upstream connection.
+   * @param callbacks supplies the callbacks to notify of the progress of the directions.
+   * @return SpliceForwarderPtr the forwarder, or nullptr if splicing is not supported or the
+   *         pipes could not be created.
+   */
+  static SpliceForwarderPtr create(Event::Dispatcher& dispatcher, os_fd_t downstream_fd,
+                                   os_fd_t upstream_fd, Callbacks& callbacks);
+
+  ~SpliceForwarder();
+
+  /**
+   * @return whether a direction is done, @see Callbacks::onSpliceDone().
+   */
+  bool done(Direction direction) const { return pipe(direction).done_; }
+
+private:
+  struct Pipe {
+    Direction direction_;
+    os_fd_t source_;
+    os_fd_t destination_;
+    os_fd_t read_end_{INVALID_SOCKET};
+    os_fd_t write_end_{INVALID_SOCKET};
+    // The file event of the source, which is activated to resume reading when the direction
+    // yields to other events.
+    Event::FileEvent* source_event_{};
+    // The number of bytes read from the source that are still in the pipe.
+    uint64_t buffered_{};
+    bool source_done_{};
+    bool done_{};
+  };
+
+  SpliceForwarder(os_fd_t downstream_fd, os_fd_t upstream_fd, Callbacks& callbacks);
+
+  const Pipe& pipe(Direction direction) const {
+    return direction == Direction::DownstreamToUpstream ? downstream_to_upstream_
+                                                        : upstream_to_downstream_;
+  }
+  bool createPipe(Pipe& pipe);
+  void onFileEvent(uint32_t events, Pipe& read_pipe, Pipe& write_pipe);
+  void transfer(Pipe& pipe);
+
+  Callbacks& callbacks_;
+  Pipe downstream_to_upstream_;
+  Pipe upstream_to_downstream_;
+  Event::FileEventPtr downstream_event_;
+  Event::FileEventPtr upstream_event_;
+};
+
+} // namespace TcpProxy
+} // namespace Envoy
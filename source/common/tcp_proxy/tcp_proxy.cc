@@ -26,6 +26,7 @@
 #include "source/common/config/utility.h"
 #include "source/common/config/well_known_names.h"
 #include "source/common/network/application_protocol.h"
+#include "source/common/network/io_socket_handle_impl.h"
 #include "source/common/network/proxy_protocol_filter_state.h"
 #include "source/common/network/socket_option_factory.h"
 #include "source/common/network/transport_socket_options_impl.h"
@@ -157,6 +158,7 @@ Config::SharedConfig::SharedConfig(
 Config::Config(const envoy::extensions::filters::network::tcp_proxy::v3::TcpProxy& config,
                Server::Configuration::FactoryContext& context)
     : max_connect_attempts_(PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, max_connect_attempts, 1)),
+      use_splice_(config.use_splice() && SpliceForwarder::isSupported()),
       upstream_drain_manager_slot_(context.serverFactoryContext().threadLocal().allocateSlot()),
       shared_config_(std::make_shared<SharedConfig>(config, context)),
       random_generator_(context.serverFactoryContext().api().randomGenerator()),
@@ -644,6 +646,7 @@ void Filter::onGenericPoolReady(StreamInfo::StreamInfo* info,
   if (info) {
     upstream_info.setUpstreamFilterState(info->filterState());
   }
+  maybeStartSplicing();
 } // namespace TcpProxy
 
 const Router::MetadataMatchCriteria* Filter::metadataMatchCriteria() {
@@ -798,6 +801,7 @@ void Filter::onDownstreamEvent(Network::ConnectionEvent event) {
   if (event == Network::ConnectionEvent::LocalClose ||
       event == Network::ConnectionEvent::RemoteClose) {
     downstream_closed_ = true;
+    stopSplicing();
     // Cancel the potential odcds callback.
     cluster_discovery_handle_ = nullptr;
   }
@@ -850,6 +854,7 @@ void Filter::onUpstreamEvent(Network::ConnectionEvent event) {
 
   if (event == Network::ConnectionEvent::RemoteClose ||
       event == Network::ConnectionEvent::LocalClose) {
+    stopSplicing();
     if (Runtime::runtimeFeatureEnabled(
             "envoy.restart_features.upstream_http_filters_with_tcp_proxy")) {
       read_callbacks_->connection().dispatcher().deferredDelete(std::move(upstream_));
@@ -926,6 +931,95 @@ void Filter::onUpstreamConnection() {
   }
 }
 
+void Filter::maybeStartSplicing() {
+  if (!config_->useSplice() || upstream_ == nullptr ||
+      read_callbacks_->connection().state() != Network::Connection::State::Open) {
+    return;
+  }
+  // Bytes can only bypass the connections if they are proxied as is, over raw buffer transport
+  // sockets of the default socket interface, and before any of them went through the connections,
+  // whose buffers must be empty.
+  const Network::Socket* upstream_socket = upstream_->upstreamSocket();
+  if (upstream_socket == nullptr ||
+      !SpliceForwarder::usesRawBufferTransport(read_callbacks_->connection()) ||
+      read_callbacks_->connection().ssl() != nullptr ||
+      upstream_->getUpstreamConnectionSslInfo() != nullptr ||
+      getStreamInfo().getDownstreamBytesMeter()->wireBytesReceived() != 0 ||
+      getStreamInfo().getUpstreamBytesMeter()->wireBytesReceived() != 0) {
+    return;
+  }
+  const Network::Socket& downstream_socket = read_callbacks_->socket();
+  if (dynamic_cast<const Network::IoSocketHandleImpl*>(&downstream_socket.ioHandle()) == nullptr ||
+      dynamic_cast<const Network::IoSocketHandleImpl*>(&upstream_socket->ioHandle()) == nullptr) {
+    return;
+  }
+
+  // The connections must stop reading before the forwarder moves any byte.
+  read_callbacks_->connection().readDisable(true);
+  upstream_->readDisable(true);
+  splice_forwarder_ = SpliceForwarder::create(
+      read_callbacks_->connection().dispatcher(), downstream_socket.ioHandle().fdDoNotUse(),
+      upstream_socket->ioHandle().fdDoNotUse(), *this);
+  if (splice_forwarder_ == nullptr) {
+    read_callbacks_->connection().readDisable(false);
+    upstream_->readDisable(false);
+    return;
+  }
+  ENVOY_CONN_LOG(debug, "splicing bytes between the downstream and upstream sockets",
+                 read_callbacks_->connection());
+  config_->stats().downstream_cx_splice_total_.inc();
+}
+
+void Filter::stopSplicing() {
+  if (splice_forwarder_ == nullptr) {
+    return;
+  }
+  // Hand the directions that are not done yet back to the connections that are still open, e.g.
+  // for an upstream connection to be drained.
+  const bool downstream_done =
+      splice_forwarder_->done(SpliceForwarder::Direction::DownstreamToUpstream);
+  const bool upstream_done =
+      splice_forwarder_->done(SpliceForwarder::Direction::UpstreamToDownstream);
+  splice_forwarder_.reset();
+  if (!downstream_done &&
+      read_callbacks_->connection().state() == Network::Connection::State::Open) {
+    read_callbacks_->connection().readDisable(false);
+  }
+  if (!upstream_done && upstream_ != nullptr) {
+    upstream_->readDisable(false);
+  }
+}
+
+void Filter::onSplicedBytes(SpliceForwarder::Direction direction, uint64_t bytes) {
+  Upstream::ClusterTrafficStats& cluster_stats =
+      *read_callbacks_->upstreamHost()->cluster().trafficStats();
+  if (direction == SpliceForwarder::Direction::DownstreamToUpstream) {
+    getStreamInfo().getDownstreamBytesMeter()->addWireBytesReceived(bytes);
+    getStreamInfo().getUpstreamBytesMeter()->addWireBytesSent(bytes);
+    config_->stats().downstream_cx_rx_bytes_total_.add(bytes);
+    cluster_stats.upstream_cx_tx_bytes_total_.add(bytes);
+  } else {
+    getStreamInfo().getUpstreamBytesMeter()->addWireBytesReceived(bytes);
+    getStreamInfo().getDownstreamBytesMeter()->addWireBytesSent(bytes);
+    cluster_stats.upstream_cx_rx_bytes_total_.add(bytes);
+    config_->stats().downstream_cx_tx_bytes_total_.add(bytes);
+  }
+  resetIdleTimer();
+}
+
+void Filter::onSpliceDone(SpliceForwarder::Direction direction) {
+  ENVOY_CONN_LOG(debug, "done splicing {} bytes", read_callbacks_->connection(),
+                 direction == SpliceForwarder::Direction::DownstreamToUpstream ? "downstream"
+                                                                                : "upstream");
+  // The connection of the source reads the end of stream or the error from its socket, and
+  // proxies it as usual.
+  if (direction == SpliceForwarder::Direction::DownstreamToUpstream) {
+    read_callbacks_->connection().readDisable(false);
+  } else if (upstream_ != nullptr) {
+    upstream_->readDisable(false);
+  }
+}
+
 void Filter::onIdleTimeout() {
   ENVOY_CONN_LOG(debug, "Session timed out", read_callbacks_->connection());
   config_->stats().idle_timeout_.inc();
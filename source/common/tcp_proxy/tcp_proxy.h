@@ -32,6 +32,7 @@
 #include "source/common/network/hash_policy.h"
 #include "source/common/network/utility.h"
 #include "source/common/stream_info/stream_info_impl.h"
+#include "source/common/tcp_proxy/splice_forwarder.h"
 #include "source/common/tcp_proxy/upstream.h"
 #include "source/common/upstream/load_balancer_context_base.h"
 
@@ -49,6 +50,7 @@ constexpr absl::string_view PerConnectionIdleTimeoutMs =
 #define ALL_TCP_PROXY_STATS(COUNTER, GAUGE)                                                        \
   COUNTER(downstream_cx_no_route)                                                                  \
   COUNTER(downstream_cx_rx_bytes_total)                                                            \
+  COUNTER(downstream_cx_splice_total)                                                              \
   COUNTER(downstream_cx_total)                                                                     \
   COUNTER(downstream_cx_tx_bytes_total)                                                            \
   COUNTER(downstream_flow_control_paused_reading_total)                                            \
@@ -316,6 +318,7 @@ public:
   Random::RandomGenerator& randomGenerator() { return random_generator_; }
   bool flushAccessLogOnConnected() const { return shared_config_->flushAccessLogOnConnected(); }
   Regex::Engine& regexEngine() const { return regex_engine_; }
+  bool useSplice() const { return use_splice_; }
 
 private:
   struct SimpleRouteImpl : public Route {
@@ -363,6 +366,7 @@ private:
   uint64_t total_cluster_weight_;
   std::vector<AccessLog::InstanceSharedPtr> access_logs_;
   const uint32_t max_connect_attempts_;
+  const bool use_splice_;
   ThreadLocal::SlotPtr upstream_drain_manager_slot_;
   SharedConfigSharedPtr shared_config_;
   std::unique_ptr<const Router::MetadataMatchCriteria> cluster_metadata_match_criteria_;
@@ -395,7 +399,8 @@ private:
 class Filter : public Network::ReadFilter,
                public Upstream::LoadBalancerContextBase,
                protected Logger::Loggable<Logger::Id::filter>,
-               public GenericConnectionPoolCallbacks {
+               public GenericConnectionPoolCallbacks,
+               public SpliceForwarder::Callbacks {
 public:
   Filter(ConfigSharedPtr config, Upstream::ClusterManager& cluster_manager);
   ~Filter() override;
@@ -415,6 +420,10 @@ public:
                             absl::string_view failure_reason,
                             Upstream::HostDescriptionConstSharedPtr host) override;
 
+  // SpliceForwarder::Callbacks
+  void onSplicedBytes(SpliceForwarder::Direction direction, uint64_t bytes) override;
+  void onSpliceDone(SpliceForwarder::Direction direction) override;
+
   // Upstream::LoadBalancerContext
   const Router::MetadataMatchCriteria* metadataMatchCriteria() override;
   absl::optional<uint64_t> computeHashKey() override {
@@ -561,6 +570,7 @@ public:
     OptRef<Http::DownstreamStreamFilterCallbacks> downstreamCallbacks() override { return {}; }
     OptRef<Http::UpstreamStreamFilterCallbacks> upstreamCallbacks() override { return {}; }
     void resetIdleTimer() override {}
+    void disableDataCallbacks() override {}
     // absl::optional<absl::string_view> upstreamOverrideHost() const override {
     //   return absl::nullopt;
     // }
@@ -620,6 +630,8 @@ protected:
   void onUpstreamData(Buffer::Instance& data, bool end_stream);
   void onUpstreamEvent(Network::ConnectionEvent event);
   void onUpstreamConnection();
+  void maybeStartSplicing();
+  void stopSplicing();
   void onIdleTimeout();
   void resetIdleTimer();
   void disableIdleTimer();
@@ -646,6 +658,9 @@ protected:
   // The upstream handle (either TCP or HTTP). This is set in onGenericPoolReady and should persist
   // until either the upstream or downstream connection is terminated.
   std::unique_ptr<GenericUpstream> upstream_;
+  // Moves the bytes between the downstream and upstream sockets when splicing. The connections
+  // are read disabled while the bytes of their direction are spliced.
+  SpliceForwarderPtr splice_forwarder_;
   // The connection pool used to set up |upstream_|.
   // This will be non-null from when an upstream connection is attempted until
   // it either succeeds or fails.
@@ -10,6 +10,7 @@
 #include "source/common/http/null_route_impl.h"
 #include "source/common/http/utility.h"
 #include "source/common/runtime/runtime_features.h"
+#include "source/common/tcp_proxy/splice_forwarder.h"
 
 namespace Envoy {
 namespace TcpProxy {
@@ -59,6 +60,14 @@ Ssl::ConnectionInfoConstSharedPtr TcpUpstream::getUpstreamConnectionSslInfo() {
   return nullptr;
 }
 
+const Network::Socket* TcpUpstream::upstreamSocket() {
+  if (upstream_conn_data_ == nullptr ||
+      !SpliceForwarder::usesRawBufferTransport(upstream_conn_data_->connection())) {
+    return nullptr;
+  }
+  return upstream_conn_data_->socket();
+}
+
 Tcp::ConnectionPool::ConnectionData*
 TcpUpstream::onDownstreamEvent(Network::ConnectionEvent event) {
   // TODO(botengyao): propagate RST back to upstream connection if RST is received from downstream.
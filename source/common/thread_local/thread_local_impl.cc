@@ -8,6 +8,7 @@
 #include "envoy/event/dispatcher.h"
 
 #include "source/common/common/assert.h"
+#include "source/common/common/cleanup.h"
 #include "source/common/common/stl_helpers.h"
 #include "source/common/runtime/runtime_features.h"
 
@@ -137,10 +138,21 @@ void InstanceImpl::SlotImpl::set(InitializeCb cb) {
   ASSERT_IS_MAIN_OR_TEST_THREAD();
   ASSERT(!parent_.shutdown_);
 
-  for (Event::Dispatcher& dispatcher : parent_.registered_threads_) {
+  if (parent_.batching()) {
     // See the header file comments for still_alive_guard_ for why we capture index_.
-    dispatcher.post(wrapCallback(
-        [index = index_, cb, &dispatcher]() -> void { setThreadLocal(index, cb(dispatcher)); }));
+    parent_.batched_callbacks_.push_back(
+        [still_alive_guard = std::weak_ptr<bool>(still_alive_guard_), index = index_,
+         cb](Event::Dispatcher& dispatcher) {
+          if (!still_alive_guard.expired()) {
+            setThreadLocal(index, cb(dispatcher));
+          }
+        });
+  } else {
+    for (Event::Dispatcher& dispatcher : parent_.registered_threads_) {
+      // See the header file comments for still_alive_guard_ for why we capture index_.
+      dispatcher.post(wrapCallback(
+          [index = index_, cb, &dispatcher]() -> void { setThreadLocal(index, cb(dispatcher)); }));
+    }
   }
 
   // Handle main thread.
@@ -192,8 +204,12 @@ void InstanceImpl::runOnAllThreads(std::function<void()> cb) {
   ASSERT_IS_MAIN_OR_TEST_THREAD();
   ASSERT(!shutdown_);
 
-  for (Event::Dispatcher& dispatcher : registered_threads_) {
-    dispatcher.post(cb);
+  if (batching()) {
+    batched_callbacks_.push_back([cb](Event::Dispatcher&) { cb(); });
+  } else {
+    for (Event::Dispatcher& dispatcher : registered_threads_) {
+      dispatcher.post(cb);
+    }
   }
 
   // Handle main thread.
@@ -209,6 +225,12 @@ void InstanceImpl::runOnAllThreads(std::function<void()> cb,
   // for programming simplicity here.
   cb();
 
+  if (batching()) {
+    batched_callbacks_.push_back([cb](Event::Dispatcher&) { cb(); });
+    batched_complete_cbs_.push_back(std::move(all_threads_complete_cb));
+    return;
+  }
+
   std::shared_ptr<std::function<void()>> cb_guard(
       new std::function<void()>(cb), [this, all_threads_complete_cb](std::function<void()>* cb) {
         main_thread_dispatcher_->post(all_threads_complete_cb);
@@ -220,6 +242,54 @@ void InstanceImpl::runOnAllThreads(std::function<void()> cb,
   }
 }
 
+ScopedBatch InstanceImpl::batchUpdates(std::function<void()> complete_cb) {
+  ASSERT_IS_MAIN_OR_TEST_THREAD();
+  ++batch_depth_;
+  if (complete_cb) {
+    batched_complete_cbs_.push_back(std::move(complete_cb));
+  }
+  return std::make_unique<Cleanup>([this]() { endBatch(); });
+}
+
+void InstanceImpl::endBatch() {
+  ASSERT_IS_MAIN_OR_TEST_THREAD();
+  ASSERT(batch_depth_ > 0);
+  if (--batch_depth_ > 0) {
+    return;
+  }
+  auto callbacks = std::make_shared<const std::vector<BatchedCb>>(std::move(batched_callbacks_));
+  batched_callbacks_.clear();
+  std::vector<std::function<void()>> complete_cbs = std::move(batched_complete_cbs_);
+  batched_complete_cbs_.clear();
+  // The workers are going away when shutting down, see removeSlot().
+  if (shutdown_ || (callbacks->empty() && complete_cbs.empty())) {
+    return;
+  }
+
+  // As with runOnAllThreads(), the completion callbacks are posted to the main thread once the
+  // last worker releases the guard.
+  std::shared_ptr<std::vector<std::function<void()>>> complete_guard(
+      new std::vector<std::function<void()>>(std::move(complete_cbs)),
+      [this](std::vector<std::function<void()>>* complete_cbs) {
+        if (!complete_cbs->empty()) {
+          main_thread_dispatcher_->post([complete_cbs = std::move(*complete_cbs)]() {
+            for (const auto& complete_cb : complete_cbs) {
+              complete_cb();
+            }
+          });
+        }
+        delete complete_cbs;
+      });
+
+  for (Event::Dispatcher& dispatcher : registered_threads_) {
+    dispatcher.post([callbacks, complete_guard, &dispatcher]() -> void {
+      for (const BatchedCb& cb : *callbacks) {
+        cb(dispatcher);
+      }
+    });
+  }
+}
+
 void InstanceImpl::setThreadLocal(uint32_t index, ThreadLocalObjectSharedPtr object) {
   if (thread_local_data_.data_.size() <= index) {
     thread_local_data_.data_.resize(index + 1);
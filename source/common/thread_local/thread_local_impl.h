@@ -29,6 +29,7 @@ public:
   void shutdownThread() override;
   Event::Dispatcher& dispatcher() override;
   bool isShutdown() const override { return shutdown_; }
+  ScopedBatch batchUpdates(std::function<void()> complete_cb) override;
 
 private:
   // On destruction returns the slot index to the deferred delete queue (detaches it). This allows
@@ -72,6 +73,11 @@ private:
     std::vector<ThreadLocalObjectSharedPtr> data_;
   };
 
+  // A callback queued for the workers while the updates are batched.
+  using BatchedCb = std::function<void(Event::Dispatcher& dispatcher)>;
+
+  bool batching() const { return batch_depth_ > 0; }
+  void endBatch();
   void removeSlot(uint32_t slot);
   void runOnAllThreads(std::function<void()> cb);
   void runOnAllThreads(std::function<void()> cb, std::function<void()> main_callback);
@@ -86,6 +92,11 @@ private:
   std::list<std::reference_wrapper<Event::Dispatcher>> registered_threads_;
   Event::Dispatcher* main_thread_dispatcher_{};
   std::atomic<bool> shutdown_{};
+  // The number of open batches, the callbacks queued for the workers while one is open, and the
+  // callbacks to invoke on the main thread once the workers ran them.
+  uint32_t batch_depth_{};
+  std::vector<BatchedCb> batched_callbacks_;
+  std::vector<std::function<void()>> batched_complete_cbs_;
 
   bool allow_slot_destroy_on_worker_threads_{};
 
@@ -0,0 +1,190 @@
+#include "source/common/tls/cert_compression.h"
+
+#include <string>
+
+#include "source/common/common/assert.h"
+#include "source/common/common/macros.h"
+#include "source/common/runtime/runtime_features.h"
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/strings/string_view.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/types/optional.h"
+#include "brotli/decode.h"
+#include "brotli/encode.h"
+#include "openssl/pool.h"
+#include "zlib.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace TransportSockets {
+namespace Tls {
+namespace CertCompression {
+namespace {
+
+// The algorithm identifiers of RFC 8879.
+constexpr uint16_t ZlibAlgorithmId = 1;
+constexpr uint16_t BrotliAlgorithmId = 2;
+
+enum Algorithm { Brotli, Zlib, AlgorithmCount };
+
+// The compressed Certificate messages of a context, by algorithm and uncompressed message. The
+// messages of a context only differ by the certificate chain selected and by its OCSP response
+// and SCT list, so that few are expected.
+class CompressedCertificates {
+public:
+  // The entries beyond which the cache of an algorithm is cleared.
+  static constexpr size_t MaxEntries = 16;
+
+  // Adds the cached compression of |in| to |out|, and returns whether there was one.
+  bool addCached(Algorithm algorithm, absl::string_view in, CBB* out) {
+    absl::ReaderMutexLock lock(&mutex_);
+    const auto it = entries_[algorithm].find(in);
+    if (it == entries_[algorithm].end()) {
+      return false;
+    }
+    return CBB_add_bytes(out, reinterpret_cast<const uint8_t*>(it->second.data()),
+                         it->second.size()) == 1;
+  }
+
+  void insert(Algorithm algorithm, absl::string_view in, std::string compressed) {
+    absl::MutexLock lock(&mutex_);
+    auto& entries = entries_[algorithm];
+    if (entries.size() >= MaxEntries) {
+      entries.clear();
+    }
+    entries.emplace(in, std::move(compressed));
+  }
+
+private:
+  absl::Mutex mutex_;
+  absl::flat_hash_map<std::string, std::string> entries_[AlgorithmCount] ABSL_GUARDED_BY(mutex_);
+};
+
+int compressedCertificatesIndex() {
+  CONSTRUCT_ON_FIRST_USE(int, []() -> int {
+    int index = SSL_CTX_get_ex_new_index(
+        0, nullptr, nullptr, nullptr,
+        [](void*, void* ptr, CRYPTO_EX_DATA*, int, long, void*) {
+          delete static_cast<CompressedCertificates*>(ptr);
+        });
+    RELEASE_ASSERT(index >= 0, "");
+    return index;
+  }());
+}
+
+absl::optional<std::string> compressWith(Algorithm algorithm, const uint8_t* in, size_t in_len) {
+  std::string out;
+  switch (algorithm) {
+  case Brotli: {
+    size_t out_len = BrotliEncoderMaxCompressedSize(in_len);
+    if (out_len == 0) {
+      return absl::nullopt;
+    }
+    out.resize(out_len);
+    // The compression is cached, so that the best one is affordable.
+    if (BrotliEncoderCompress(BROTLI_MAX_QUALITY, BROTLI_DEFAULT_WINDOW, BROTLI_MODE_GENERIC,
+                              in_len, in, reinterpret_cast<uint8_t*>(out.data()),
+                              &out_len) != BROTLI_TRUE) {
+      return absl::nullopt;
+    }
+    out.resize(out_len);
+    return out;
+  }
+  case Zlib: {
+    uLongf out_len = compressBound(in_len);
+    out.resize(out_len);
+    if (compress2(reinterpret_cast<Bytef*>(out.data()), &out_len, in, in_len,
+                  Z_BEST_COMPRESSION) != Z_OK) {
+      return absl::nullopt;
+    }
+    out.resize(out_len);
+    return out;
+  }
+  case AlgorithmCount:
+    break;
+  }
+  PANIC_DUE_TO_CORRUPT_ENUM;
+}
+
+int compressCached(Algorithm algorithm, SSL* ssl, CBB* out, const uint8_t* in, size_t in_len) {
+  auto* cache = static_cast<CompressedCertificates*>(
+      SSL_CTX_get_ex_data(SSL_get_SSL_CTX(ssl), compressedCertificatesIndex()));
+  const absl::string_view message(reinterpret_cast<const char*>(in), in_len);
+  if (cache != nullptr && cache->addCached(algorithm, message, out)) {
+    return 1;
+  }
+  absl::optional<std::string> compressed = compressWith(algorithm, in, in_len);
+  if (!compressed.has_value() ||
+      CBB_add_bytes(out, reinterpret_cast<const uint8_t*>(compressed->data()),
+                    compressed->size()) != 1) {
+    return 0;
+  }
+  if (cache != nullptr) {
+    cache->insert(algorithm, message, std::move(compressed.value()));
+  }
+  return 1;
+}
+
+// Decompresses exactly |uncompressed_len| bytes, which BoringSSL bounds by the maximum size of the
+// certificate list.
+template <class Decompress>
+int decompressInto(CRYPTO_BUFFER** out, size_t uncompressed_len, Decompress decompress) {
+  uint8_t* data;
+  bssl::UniquePtr<CRYPTO_BUFFER> buffer(CRYPTO_BUFFER_alloc(&data, uncompressed_len));
+  if (buffer == nullptr || !decompress(data)) {
+    return 0;
+  }
+  *out = buffer.release();
+  return 1;
+}
+
+} // namespace
+
+void registerAlgorithms(SSL_CTX* ssl_ctx) {
+  if (!Runtime::runtimeFeatureEnabled("envoy.reloadable_features.tls_certificate_compression")) {
+    return;
+  }
+  if (SSL_CTX_get_ex_data(ssl_ctx, compressedCertificatesIndex()) == nullptr) {
+    int rc = SSL_CTX_set_ex_data(ssl_ctx, compressedCertificatesIndex(),
+                                 new CompressedCertificates());
+    RELEASE_ASSERT(rc == 1, "");
+  }
+  int rc = SSL_CTX_add_cert_compression_alg(ssl_ctx, BrotliAlgorithmId, compressBrotli,
+                                            decompressBrotli);
+  RELEASE_ASSERT(rc == 1, "");
+  rc = SSL_CTX_add_cert_compression_alg(ssl_ctx, ZlibAlgorithmId, compressZlib, decompressZlib);
+  RELEASE_ASSERT(rc == 1, "");
+}
+
+int compressBrotli(SSL* ssl, CBB* out, const uint8_t* in, size_t in_len) {
+  return compressCached(Brotli, ssl, out, in, in_len);
+}
+
+int decompressBrotli(SSL*, CRYPTO_BUFFER** out, size_t uncompressed_len, const uint8_t* in,
+                     size_t in_len) {
+  return decompressInto(out, uncompressed_len, [&](uint8_t* data) {
+    size_t decoded_len = uncompressed_len;
+    return BrotliDecoderDecompress(in_len, in, &decoded_len, data) ==
+               BROTLI_DECODER_RESULT_SUCCESS &&
+           decoded_len == uncompressed_len;
+  });
+}
+
+int compressZlib(SSL* ssl, CBB* out, const uint8_t* in, size_t in_len) {
+  return compressCached(Zlib, ssl, out, in, in_len);
+}
+
+int decompressZlib(SSL*, CRYPTO_BUFFER** out, size_t uncompressed_len, const uint8_t* in,
+                   size_t in_len) {
+  return decompressInto(out, uncompressed_len, [&](uint8_t* data) {
+    uLongf decoded_len = uncompressed_len;
+    return uncompress(data, &decoded_len, in, in_len) == Z_OK && decoded_len == uncompressed_len;
+  });
+}
+
+} // namespace CertCompression
+} // namespace Tls
+} // namespace TransportSockets
+} // namespace Extensions
+} // namespace Envoy
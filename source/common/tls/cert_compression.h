@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "openssl/ssl.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace TransportSockets {
+namespace Tls {
+namespace CertCompression {
+
+/**
+ * Registers the brotli and zlib compressions of the certificates (RFC 8879) on a context, in this
+ * order of preference. They apply to the TLS 1.3 handshakes only. The compressed Certificate
+ * messages are cached by the context, so that a certificate chain is compressed once rather than
+ * in each handshake.
+ * @param ssl_ctx the context of the connections, on the server or the client side.
+ */
+void registerAlgorithms(SSL_CTX* ssl_ctx);
+
+// The callbacks of SSL_CTX_add_cert_compression_alg(), which return 1 on success and 0 on failure.
+int compressBrotli(SSL* ssl, CBB* out, const uint8_t* in, size_t in_len);
+int decompressBrotli(SSL* ssl, CRYPTO_BUFFER** out, size_t uncompressed_len, const uint8_t* in,
+                     size_t in_len);
+int compressZlib(SSL* ssl, CBB* out, const uint8_t* in, size_t in_len);
+int decompressZlib(SSL* ssl, CRYPTO_BUFFER** out, size_t uncompressed_len, const uint8_t* in,
+                   size_t in_len);
+
+} // namespace CertCompression
+} // namespace Tls
+} // namespace TransportSockets
+} // namespace Extensions
+} // namespace Envoy
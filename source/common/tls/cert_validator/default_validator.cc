@@ -50,6 +50,10 @@ DefaultCertValidator::DefaultCertValidator(
     allow_untrusted_certificate_ = config_->trustChainVerification() ==
                                    envoy::extensions::transport_sockets::tls::v3::
                                        CertificateValidationContext::ACCEPT_UNTRUSTED;
+    if (config_->verifiedChainCacheSize() > 0) {
+      verified_chain_cache_ = std::make_unique<VerifiedChainCache>(
+          config_->verifiedChainCacheSize(), stats_, context_.timeSource());
+    }
   }
 };
 
@@ -97,6 +101,7 @@ absl::StatusOr<int> DefaultCertValidator::initializeSslContexts(std::vector<SSL_
         }
         if (item->crl) {
           X509_STORE_add_crl(store, item->crl);
+          addCrlNextUpdate(*item->crl);
           has_crl = true;
         }
       }
@@ -138,6 +143,7 @@ absl::StatusOr<int> DefaultCertValidator::initializeSslContexts(std::vector<SSL_
       for (const X509_INFO* item : list.get()) {
         if (item->crl) {
           X509_STORE_add_crl(store, item->crl);
+          addCrlNextUpdate(*item->crl);
         }
       }
       X509_STORE_set_flags(store, config_->onlyVerifyLeafCertificateCrl()
@@ -192,6 +198,14 @@ absl::StatusOr<int> DefaultCertValidator::initializeSslContexts(std::vector<SSL_
   return verify_mode;
 }
 
+void DefaultCertValidator::addCrlNextUpdate(const X509_CRL& crl) {
+  const absl::optional<SystemTime> next_update = Utility::getNextUpdate(crl);
+  if (next_update.has_value() &&
+      (!crl_next_update_.has_value() || next_update.value() < crl_next_update_.value())) {
+    crl_next_update_ = next_update;
+  }
+}
+
 bool DefaultCertValidator::verifyCertAndUpdateStatus(
     X509* leaf_cert, const Network::TransportSocketOptions* transport_socket_options,
     Envoy::Ssl::ClientValidationStatus& detailed_status, std::string* error_details,
@@ -293,7 +307,15 @@ ValidationResults DefaultCertValidator::doVerifyCertChain(
       Envoy::Ssl::ClientValidationStatus::NotValidated;
   X509* leaf_cert = sk_X509_value(&cert_chain, 0);
   ASSERT(leaf_cert);
-  if (verify_trusted_ca_) {
+  absl::optional<VerifiedChainCache::Key> cache_key;
+  if (verify_trusted_ca_ && verified_chain_cache_ != nullptr) {
+    cache_key = VerifiedChainCache::key(cert_chain);
+  }
+  if (cache_key.has_value() && verified_chain_cache_->lookup(cache_key.value())) {
+    // The same chain was verified against the same trust store, and none of its certificates nor
+    // of the CRLs expired since.
+    detailed_status = Envoy::Ssl::ClientValidationStatus::Validated;
+  } else if (verify_trusted_ca_) {
     X509_STORE* verify_store = SSL_CTX_get_cert_store(&ssl_ctx);
     ASSERT(verify_store);
     bssl::UniquePtr<X509_STORE_CTX> ctx(X509_STORE_CTX_new());
@@ -329,6 +351,17 @@ ValidationResults DefaultCertValidator::doVerifyCertChain(
               SSL_alert_from_verify_result(X509_STORE_CTX_get_error(ctx.get())), error};
     }
     detailed_status = Envoy::Ssl::ClientValidationStatus::Validated;
+    if (cache_key.has_value()) {
+      // The verified chain includes the trust anchor, which may expire before the leaf.
+      SystemTime expiration_time = SystemTime::max();
+      for (const X509* cert : X509_STORE_CTX_get0_chain(ctx.get())) {
+        expiration_time = std::min(expiration_time, Utility::getExpirationTime(*cert));
+      }
+      if (crl_next_update_.has_value()) {
+        expiration_time = std::min(expiration_time, crl_next_update_.value());
+      }
+      verified_chain_cache_->insert(cache_key.value(), expiration_time);
+    }
   }
   std::string error_details;
   uint8_t tls_alert = SSL_AD_CERTIFICATE_UNKNOWN;
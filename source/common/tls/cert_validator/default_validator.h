@@ -21,6 +21,7 @@
 #include "source/common/stats/symbol_table.h"
 #include "source/common/tls/cert_validator/cert_validator.h"
 #include "source/common/tls/cert_validator/san_matcher.h"
+#include "source/common/tls/cert_validator/verified_chain_cache.h"
 #include "source/common/tls/stats.h"
 
 #include "absl/synchronization/mutex.h"
@@ -108,7 +109,11 @@ private:
                                  const Network::TransportSocketOptions* transport_socket_options,
                                  Envoy::Ssl::ClientValidationStatus& detailed_status,
                                  std::string* error_details, uint8_t* out_alert);
+  // Records the next update of a trusted CRL, until which the verified chains may be cached.
+  void addCrlNextUpdate(const X509_CRL& crl);
 
+  // Only used until the contexts are initialized, since the contexts might be shared beyond the
+  // lifetime of the config, see ContextManagerImpl.
   const Envoy::Ssl::CertificateValidationContextConfig* config_;
   SslStats& stats_;
   Server::Configuration::CommonFactoryContext& context_;
@@ -120,6 +125,8 @@ private:
   std::vector<std::vector<uint8_t>> verify_certificate_hash_list_;
   std::vector<std::vector<uint8_t>> verify_certificate_spki_list_;
   bool verify_trusted_ca_{false};
+  absl::optional<SystemTime> crl_next_update_;
+  VerifiedChainCachePtr verified_chain_cache_;
 };
 
 DECLARE_FACTORY(DefaultCertValidatorFactory);
@@ -0,0 +1,80 @@
+#include "source/common/tls/cert_validator/verified_chain_cache.h"
+
+#include "source/common/common/assert.h"
+
+#include "openssl/digest.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace TransportSockets {
+namespace Tls {
+
+VerifiedChainCache::VerifiedChainCache(uint32_t max_entries, SslStats& stats,
+                                       TimeSource& time_source)
+    : max_entries_(max_entries), stats_(stats), time_source_(time_source) {
+  ASSERT(max_entries_ > 0);
+}
+
+VerifiedChainCache::Key VerifiedChainCache::key(STACK_OF(X509)& cert_chain) {
+  SHA256_CTX sha256;
+  SHA256_Init(&sha256);
+  for (const X509* cert : &cert_chain) {
+    uint8_t digest[SHA256_DIGEST_LENGTH];
+    unsigned int length;
+    RELEASE_ASSERT(X509_digest(cert, EVP_sha256(), digest, &length) == 1, "");
+    ASSERT(length == SHA256_DIGEST_LENGTH);
+    SHA256_Update(&sha256, digest, length);
+  }
+  Key key;
+  SHA256_Final(key.data(), &sha256);
+  return key;
+}
+
+bool VerifiedChainCache::lookup(const Key& key) {
+  absl::MutexLock lock(&mutex_);
+  auto it = index_.find(key);
+  if (it == index_.end()) {
+    stats_.verified_chain_cache_miss_.inc();
+    return false;
+  }
+  if (it->second->expiration_time <= time_source_.systemTime()) {
+    entries_.erase(it->second);
+    index_.erase(it);
+    stats_.verified_chain_cache_miss_.inc();
+    return false;
+  }
+  entries_.splice(entries_.begin(), entries_, it->second);
+  stats_.verified_chain_cache_hit_.inc();
+  return true;
+}
+
+void VerifiedChainCache::insert(const Key& key, SystemTime expiration_time) {
+  if (expiration_time <= time_source_.systemTime()) {
+    return;
+  }
+  absl::MutexLock lock(&mutex_);
+  auto it = index_.find(key);
+  if (it != index_.end()) {
+    // Another worker verified the same chain meanwhile.
+    it->second->expiration_time = expiration_time;
+    entries_.splice(entries_.begin(), entries_, it->second);
+    return;
+  }
+  if (entries_.size() == max_entries_) {
+    index_.erase(entries_.back().key);
+    entries_.pop_back();
+    stats_.verified_chain_cache_evicted_.inc();
+  }
+  entries_.push_front({key, expiration_time});
+  index_.emplace(key, entries_.begin());
+}
+
+size_t VerifiedChainCache::size() {
+  absl::MutexLock lock(&mutex_);
+  return entries_.size();
+}
+
+} // namespace Tls
+} // namespace TransportSockets
+} // namespace Extensions
+} // namespace Envoy
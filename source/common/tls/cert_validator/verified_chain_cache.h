@@ -0,0 +1,77 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <list>
+#include <memory>
+
+#include "envoy/common/time.h"
+
+#include "source/common/tls/stats.h"
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/synchronization/mutex.h"
+#include "openssl/sha.h"
+#include "openssl/ssl.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace TransportSockets {
+namespace Tls {
+
+/**
+ * Bounded LRU cache of the peer certificate chains which were successfully verified against the
+ * trust store of a validator, so that the chains presented again skip X509_verify_cert(). Each
+ * chain is remembered until the given expiration time, after which it's verified again. The cache
+ * is owned by the validator of a context, so it's dropped with it when the trust store changes.
+ * It's shared by the workers.
+ */
+class VerifiedChainCache {
+public:
+  using Key = std::array<uint8_t, SHA256_DIGEST_LENGTH>;
+
+  VerifiedChainCache(uint32_t max_entries, SslStats& stats, TimeSource& time_source);
+
+  /**
+   * @return the key of a chain, the SHA-256 of the SHA-256 of each of its certificates, in order.
+   */
+  static Key key(STACK_OF(X509)& cert_chain);
+
+  /**
+   * @return whether the chain of the key was verified and hasn't expired since.
+   */
+  bool lookup(const Key& key);
+
+  /**
+   * Remembers that the chain of the key was verified, until the expiration time. The least
+   * recently used chain is evicted if the cache is full.
+   */
+  void insert(const Key& key, SystemTime expiration_time);
+
+  /**
+   * @return the number of chains in the cache.
+   */
+  size_t size();
+
+private:
+  struct Entry {
+    Key key;
+    SystemTime expiration_time;
+  };
+  using EntryList = std::list<Entry>;
+
+  const uint32_t max_entries_;
+  SslStats& stats_;
+  TimeSource& time_source_;
+  absl::Mutex mutex_;
+  // The most recently used entry is first.
+  EntryList entries_ ABSL_GUARDED_BY(mutex_);
+  absl::flat_hash_map<Key, EntryList::iterator> index_ ABSL_GUARDED_BY(mutex_);
+};
+
+using VerifiedChainCachePtr = std::unique_ptr<VerifiedChainCache>;
+
+} // namespace Tls
+} // namespace TransportSockets
+} // namespace Extensions
+} // namespace Envoy
@@ -46,6 +46,7 @@ public:
 
   absl::StatusOr<bssl::UniquePtr<SSL>>
   newSsl(const Network::TransportSocketOptionsConstSharedPtr& options) override;
+  bool renegotiationAllowed() const override { return allow_renegotiation_; }
 
 private:
   ClientContextImpl(Stats::Scope& scope, const Envoy::Ssl::ClientContextConfig& config,
@@ -4,16 +4,20 @@
 #include <string>
 
 #include "envoy/extensions/transport_sockets/tls/v3/cert.pb.h"
+#include "envoy/singleton/manager.h"
 
 #include "source/common/common/assert.h"
 #include "source/common/common/empty_string.h"
+#include "source/common/common/hash.h"
 #include "source/common/config/datasource.h"
+#include "source/common/config/utility.h"
 #include "source/common/network/cidr_range.h"
 #include "source/common/protobuf/utility.h"
 #include "source/common/secret/sds_api.h"
 #include "source/common/ssl/certificate_validation_context_config_impl.h"
 #include "source/common/tls/ssl_handshaker.h"
 
+#include "absl/container/flat_hash_map.h"
 #include "openssl/ssl.h"
 
 namespace Envoy {
@@ -21,8 +25,42 @@ namespace Extensions {
 namespace TransportSockets {
 namespace Tls {
 
+SINGLETON_MANAGER_REGISTRATION(tls_session_cache_registry);
+
 namespace {
 
+// The session caches in use, by the hash of their config, so that the contexts configured with
+// identical caches use a single one, which is kept across the updates of the contexts as long as
+// one of them uses it.
+class SessionCacheRegistry : public Singleton::Instance {
+public:
+  absl::StatusOr<Ssl::SessionCacheSharedPtr>
+  getOrCreate(const envoy::config::core::v3::TypedExtensionConfig& config,
+              Server::Configuration::TransportSocketFactoryContext& factory_context) {
+    const uint64_t hash = MessageUtil::hash(config);
+    std::weak_ptr<Ssl::SessionCache>& cache = caches_[hash];
+    Ssl::SessionCacheSharedPtr existing = cache.lock();
+    if (existing != nullptr) {
+      return existing;
+    }
+    auto& factory = Config::Utility::getAndCheckFactory<Ssl::SessionCacheFactory>(config);
+    ProtobufTypes::MessagePtr message = Config::Utility::translateAnyToFactoryConfig(
+        config.typed_config(), factory_context.messageValidationVisitor(), factory);
+    Ssl::SessionCacheSharedPtr created = factory.createSessionCache(
+        *message, factory_context.messageValidationVisitor(),
+        factory_context.serverFactoryContext());
+    if (created == nullptr) {
+      return absl::InvalidArgumentError(
+          fmt::format("Failed to create the TLS session cache {}", config.name()));
+    }
+    cache = created;
+    return created;
+  }
+
+private:
+  absl::flat_hash_map<uint64_t, std::weak_ptr<Ssl::SessionCache>> caches_;
+};
+
 std::vector<Secret::TlsCertificateConfigProviderSharedPtr> getTlsCertificateConfigProviders(
     const envoy::extensions::transport_sockets::tls::v3::CommonTlsContext& config,
     Server::Configuration::TransportSocketFactoryContext& factory_context,
@@ -196,7 +234,8 @@ ContextConfigImpl::ContextConfigImpl(
                                                 default_min_protocol_version)),
       max_protocol_version_(tlsVersionFromProto(config.tls_params().tls_maximum_protocol_version(),
                                                 default_max_protocol_version)),
-      factory_context_(factory_context), tls_keylog_path_(config.key_log().path()) {
+      factory_context_(factory_context), tls_keylog_path_(config.key_log().path()),
+      kernel_tls_offload_(config.kernel_tls_offload()) {
   SET_AND_RETURN_IF_NOT_OK(creation_status, creation_status);
   auto list_or_error = Network::Address::IpList::create(config.key_log().local_address_range());
   SET_AND_RETURN_IF_NOT_OK(list_or_error.status(), creation_status);
@@ -284,6 +323,42 @@ ContextConfigImpl::getCombinedValidationContextConfig(
   return std::move(config_or_status.value());
 }
 
+absl::optional<uint64_t> ContextConfigImpl::hashSecrets(uint64_t seed) const {
+  // The dynamic secrets may hold settings besides the data, e.g. the matchers of a validation
+  // context, and the data of the files they refer to is hashed below.
+  for (const auto& tls_certificate_provider : tls_certificate_providers_) {
+    if (tls_certificate_provider->secret() != nullptr) {
+      seed = HashUtil::xxHash64Value(MessageUtil::hash(*tls_certificate_provider->secret()), seed);
+    }
+  }
+  for (const auto& tls_certificate_config : tls_certificate_configs_) {
+    if (tls_certificate_config->privateKeyMethod() != nullptr) {
+      return absl::nullopt;
+    }
+    const std::vector<uint8_t>& ocsp_staple = tls_certificate_config->ocspStaple();
+    seed = HashUtil::xxHash64(tls_certificate_config->certificateChain(), seed);
+    seed = HashUtil::xxHash64(tls_certificate_config->privateKey(), seed);
+    seed = HashUtil::xxHash64(tls_certificate_config->pkcs12(), seed);
+    seed = HashUtil::xxHash64(tls_certificate_config->password(), seed);
+    seed = HashUtil::xxHash64(
+        absl::string_view(reinterpret_cast<const char*>(ocsp_staple.data()), ocsp_staple.size()),
+        seed);
+  }
+  if (certificate_validation_context_provider_ != nullptr &&
+      certificate_validation_context_provider_->secret() != nullptr) {
+    seed = HashUtil::xxHash64Value(
+        MessageUtil::hash(*certificate_validation_context_provider_->secret()), seed);
+  }
+  if (validation_context_config_ != nullptr) {
+    if (validation_context_config_->customValidatorConfig().has_value()) {
+      return absl::nullopt;
+    }
+    seed = HashUtil::xxHash64(validation_context_config_->caCert(), seed);
+    seed = HashUtil::xxHash64(validation_context_config_->certificateRevocationList(), seed);
+  }
+  return seed;
+}
+
 void ContextConfigImpl::setSecretUpdateCallback(std::function<absl::Status()> callback) {
   // When any of tls_certificate_providers_ receives a new secret, this callback updates
   // ContextConfigImpl::tls_certificate_configs_ with new secret.
@@ -454,7 +529,9 @@ ServerContextConfigImpl::ServerContextConfigImpl(
       disable_stateless_session_resumption_(getStatelessSessionResumptionDisabled(config)),
       disable_stateful_session_resumption_(config.disable_stateful_session_resumption()),
       full_scan_certs_on_sni_mismatch_(
-          PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, full_scan_certs_on_sni_mismatch, false)) {
+          PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, full_scan_certs_on_sni_mismatch, false)),
+      config_hash_(MessageUtil::hash(config)),
+      shareable_(!config.common_tls_context().has_custom_handshaker()) {
   SET_AND_RETURN_IF_NOT_OK(creation_status, creation_status);
   if (session_ticket_keys_provider_ != nullptr) {
     // Validate tls session ticket keys early to reject bad sds updates.
@@ -486,6 +563,15 @@ ServerContextConfigImpl::ServerContextConfigImpl(
     session_timeout_ =
         std::chrono::seconds(DurationUtil::durationToSeconds(config.session_timeout()));
   }
+
+  if (config.has_session_cache() && !disable_stateful_session_resumption_) {
+    auto registry = factory_context.serverFactoryContext().singletonManager().getTyped<
+        SessionCacheRegistry>(SINGLETON_MANAGER_REGISTERED_NAME(tls_session_cache_registry),
+                              [] { return std::make_shared<SessionCacheRegistry>(); }, true);
+    auto cache_or_error = registry->getOrCreate(config.session_cache(), factory_context);
+    SET_AND_RETURN_IF_NOT_OK(cache_or_error.status(), creation_status);
+    session_cache_ = std::move(*cache_or_error);
+  }
 }
 
 void ServerContextConfigImpl::setSecretUpdateCallback(std::function<absl::Status()> callback) {
@@ -503,6 +589,21 @@ void ServerContextConfigImpl::setSecretUpdateCallback(std::function<absl::Status
   }
 }
 
+absl::optional<uint64_t> ServerContextConfigImpl::contextHash() const {
+  if (!shareable_) {
+    return absl::nullopt;
+  }
+  absl::optional<uint64_t> hash = hashSecrets(config_hash_);
+  if (hash.has_value()) {
+    for (const SessionTicketKey& key : session_ticket_keys_) {
+      hash = HashUtil::xxHash64(
+          absl::string_view(reinterpret_cast<const char*>(&key), sizeof(SessionTicketKey)),
+          hash.value());
+    }
+  }
+  return hash;
+}
+
 absl::StatusOr<std::vector<Ssl::ServerContextConfig::SessionTicketKey>>
 ServerContextConfigImpl::getSessionTicketKeys(
     const envoy::extensions::transport_sockets::tls::v3::TlsSessionTicketKeys& keys) {
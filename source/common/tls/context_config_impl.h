@@ -48,6 +48,7 @@ public:
   AccessLog::AccessLogManager& accessLogManager() const override {
     return factory_context_.serverFactoryContext().accessLogManager();
   }
+  bool kernelTlsOffload() const override { return kernel_tls_offload_; }
 
   bool isReady() const override {
     const bool tls_is_ready =
@@ -75,6 +76,11 @@ protected:
                     const std::string& default_cipher_suites, const std::string& default_curves,
                     Server::Configuration::TransportSocketFactoryContext& factory_context,
                     absl::Status& creation_status);
+
+  // Mixes the secrets currently loaded into the seed, or returns absl::nullopt if the contexts
+  // created from them would depend on a private key provider or a custom certificate validator.
+  absl::optional<uint64_t> hashSecrets(uint64_t seed) const;
+
   Api::Api& api_;
   const Server::Options& options_;
   Singleton::Manager& singleton_manager_;
@@ -115,6 +121,7 @@ private:
   const std::string tls_keylog_path_;
   std::unique_ptr<Network::Address::IpList> tls_keylog_local_;
   std::unique_ptr<Network::Address::IpList> tls_keylog_remote_;
+  const bool kernel_tls_offload_;
 };
 
 class ClientContextConfigImpl : public ContextConfigImpl, public Envoy::Ssl::ClientContextConfig {
@@ -175,8 +182,10 @@ public:
   bool disableStatefulSessionResumption() const override {
     return disable_stateful_session_resumption_;
   }
+  Ssl::SessionCacheSharedPtr sessionCache() const override { return session_cache_; }
 
   bool fullScanCertsOnSNIMismatch() const override { return full_scan_certs_on_sni_mismatch_; }
+  absl::optional<uint64_t> contextHash() const override;
 
 private:
   ServerContextConfigImpl(
@@ -207,7 +216,12 @@ private:
   absl::optional<std::chrono::seconds> session_timeout_;
   const bool disable_stateless_session_resumption_;
   const bool disable_stateful_session_resumption_;
+  Ssl::SessionCacheSharedPtr session_cache_;
   bool full_scan_certs_on_sni_mismatch_;
+  // The hash of the whole config, and whether its contexts can be shared, i.e. if it doesn't use a
+  // custom handshaker.
+  const uint64_t config_hash_;
+  const bool shareable_;
 };
 
 } // namespace Tls
@@ -26,6 +26,7 @@
 #include "source/common/protobuf/utility.h"
 #include "source/common/runtime/runtime_features.h"
 #include "source/common/stats/utility.h"
+#include "source/common/tls/cert_compression.h"
 #include "source/common/tls/cert_validator/factory.h"
 #include "source/common/tls/stats.h"
 #include "source/common/tls/utility.h"
@@ -51,6 +52,20 @@ void logSslErrorChain() {
   }
 }
 
+// The PEM encoded certificates and keys of a context, as an estimate of the memory taken by their
+// parsed form.
+uint64_t certificatesBytes(const Envoy::Ssl::ContextConfig& config) {
+  uint64_t bytes = 0;
+  for (const auto& tls_certificate : config.tlsCertificates()) {
+    bytes += tls_certificate.get().certificateChain().size() +
+             tls_certificate.get().privateKey().size();
+  }
+  if (config.certificateValidationContext() != nullptr) {
+    bytes += config.certificateValidationContext()->caCert().size();
+  }
+  return bytes;
+}
+
 } // namespace
 
 namespace Extensions {
@@ -80,7 +95,10 @@ ContextImpl::ContextImpl(Stats::Scope& scope, const Envoy::Ssl::ContextConfig& c
       ssl_versions_(stat_name_set_->add("ssl.versions")),
       ssl_curves_(stat_name_set_->add("ssl.curves")),
       ssl_sigalgs_(stat_name_set_->add("ssl.sigalgs")), capabilities_(config.capabilities()),
-      tls_keylog_local_(config.tlsKeyLogLocal()), tls_keylog_remote_(config.tlsKeyLogRemote()) {
+      tls_keylog_local_(config.tlsKeyLogLocal()), tls_keylog_remote_(config.tlsKeyLogRemote()),
+      kernel_tls_offload_(config.kernelTlsOffload()),
+      accounted_bytes_(Memory::Subsystem::TlsContexts,
+                       sizeof(ContextImpl) + certificatesBytes(config)) {
 
   auto cert_validator_name = getCertValidatorName(config.certificateValidationContext());
   auto cert_validator_factory =
@@ -113,6 +131,8 @@ ContextImpl::ContextImpl(Stats::Scope& scope, const Envoy::Ssl::ContextConfig& c
     rc = SSL_CTX_set_max_proto_version(ctx.ssl_ctx_.get(), config.maxProtocolVersion());
     RELEASE_ASSERT(rc == 1, Utility::getLastCryptoError().value_or(""));
 
+    CertCompression::registerAlgorithms(ctx.ssl_ctx_.get());
+
     if (!capabilities_.provides_ciphers_and_curves &&
         !SSL_CTX_set_strict_cipher_list(ctx.ssl_ctx_.get(), config.cipherSuites().c_str())) {
       // Break up a set of ciphers into each individual cipher and try them each individually in
@@ -18,6 +18,7 @@
 #include "envoy/stats/stats_macros.h"
 
 #include "source/common/common/matchers.h"
+#include "source/common/memory/accounting.h"
 #include "source/common/stats/symbol_table.h"
 #include "source/common/tls/cert_validator/cert_validator.h"
 #include "source/common/tls/context_manager_impl.h"
@@ -89,6 +90,18 @@ public:
 
   SslStats& stats() { return stats_; }
 
+  /**
+   * @return true if the connections should offload the encryption of the records they send to
+   * the kernel after the handshake.
+   */
+  bool kernelTlsOffload() const { return kernel_tls_offload_; }
+
+  /**
+   * @return true if the connections may renegotiate after the handshake. BoringSSL would then
+   * have to write the handshake records itself.
+   */
+  virtual bool renegotiationAllowed() const { return false; }
+
   /**
    * The global SSL-library index used for storing a pointer to the SslExtendedSocketInfo
    * class in the SSL instance, for retrieval in callbacks.
@@ -169,6 +182,8 @@ protected:
   const Network::Address::IpList tls_keylog_local_;
   const Network::Address::IpList tls_keylog_remote_;
   AccessLog::AccessLogFileSharedPtr tls_keylog_file_;
+  const bool kernel_tls_offload_;
+  const Memory::AccountedBytes accounted_bytes_;
 };
 
 using ContextImplSharedPtr = std::shared_ptr<ContextImpl>;
@@ -9,6 +9,7 @@
 
 #include "source/common/common/assert.h"
 #include "source/common/config/utility.h"
+#include "source/common/runtime/runtime_features.h"
 #include "source/common/tls/client_context_impl.h"
 #include "source/common/tls/context_impl.h"
 
@@ -30,7 +31,7 @@ ContextManagerImpl::createSslClientContext(Stats::Scope& scope,
   auto context_or_error = ClientContextImpl::create(scope, config, factory_context_);
   RETURN_IF_NOT_OK(context_or_error.status());
   Envoy::Ssl::ClientContextSharedPtr context = std::move(context_or_error.value());
-  contexts_.insert(context);
+  contexts_.emplace(context, ContextEntry{1, absl::nullopt});
   return context;
 }
 
@@ -42,6 +43,19 @@ absl::StatusOr<Envoy::Ssl::ServerContextSharedPtr> ContextManagerImpl::createSsl
     return nullptr;
   }
 
+  absl::optional<ServerContextKey> shared_key;
+  const absl::optional<uint64_t> context_hash = config.contextHash();
+  if (context_hash.has_value() && additional_init == nullptr &&
+      Runtime::runtimeFeatureEnabled(
+          "envoy.reloadable_features.share_identical_tls_server_contexts")) {
+    shared_key.emplace(&scope, server_names, context_hash.value());
+    auto it = shared_server_contexts_.find(shared_key.value());
+    if (it != shared_server_contexts_.end()) {
+      ++contexts_[it->second].references_;
+      return it->second;
+    }
+  }
+
   auto factory = Envoy::Config::Utility::getFactoryByName<ServerContextFactory>(
       "envoy.ssl.server_context_factory.default");
   if (!factory) {
@@ -50,13 +64,19 @@ absl::StatusOr<Envoy::Ssl::ServerContextSharedPtr> ContextManagerImpl::createSsl
   }
   Envoy::Ssl::ServerContextSharedPtr context = factory->createServerContext(
       scope, config, server_names, factory_context_, std::move(additional_init));
-  contexts_.insert(context);
+  if (context == nullptr) {
+    return context;
+  }
+  contexts_.emplace(context, ContextEntry{1, shared_key});
+  if (shared_key.has_value()) {
+    shared_server_contexts_.emplace(std::move(shared_key.value()), context);
+  }
   return context;
 }
 
 absl::optional<uint32_t> ContextManagerImpl::daysUntilFirstCertExpires() const {
   absl::optional<uint32_t> ret = absl::make_optional(std::numeric_limits<uint32_t>::max());
-  for (const auto& context : contexts_) {
+  for (const auto& [context, entry] : contexts_) {
     if (context) {
       const absl::optional<uint32_t> tmp = context->daysUntilFirstCertExpires();
       if (!tmp.has_value()) {
@@ -70,7 +90,7 @@ absl::optional<uint32_t> ContextManagerImpl::daysUntilFirstCertExpires() const {
 
 absl::optional<uint64_t> ContextManagerImpl::secondsUntilFirstOcspResponseExpires() const {
   absl::optional<uint64_t> ret;
-  for (const auto& context : contexts_) {
+  for (const auto& [context, entry] : contexts_) {
     if (context) {
       auto next_expiration = context->secondsUntilFirstOcspResponseExpires();
       if (next_expiration) {
@@ -83,7 +103,7 @@ absl::optional<uint64_t> ContextManagerImpl::secondsUntilFirstOcspResponseExpire
 }
 
 void ContextManagerImpl::iterateContexts(std::function<void(const Envoy::Ssl::Context&)> callback) {
-  for (const auto& context : contexts_) {
+  for (const auto& [context, entry] : contexts_) {
     if (context) {
       callback(*context);
     }
@@ -92,10 +112,17 @@ void ContextManagerImpl::iterateContexts(std::function<void(const Envoy::Ssl::Co
 
 void ContextManagerImpl::removeContext(const Envoy::Ssl::ContextSharedPtr& old_context) {
   if (old_context != nullptr) {
-    auto erased = contexts_.erase(old_context);
+    auto it = contexts_.find(old_context);
     // The contexts is expected to be added before is removed.
     // And the prod ssl factory implementation guarantees any context is removed exactly once.
-    ASSERT(erased == 1);
+    ASSERT(it != contexts_.end());
+    if (it == contexts_.end() || --it->second.references_ > 0) {
+      return;
+    }
+    if (it->second.shared_key_.has_value()) {
+      shared_server_contexts_.erase(it->second.shared_key_.value());
+    }
+    contexts_.erase(it);
   }
 }
 
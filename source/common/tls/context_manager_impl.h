@@ -3,6 +3,9 @@
 #include <cstdint>
 #include <functional>
 #include <list>
+#include <string>
+#include <tuple>
+#include <vector>
 
 #include "envoy/common/time.h"
 #include "envoy/server/factory_context.h"
@@ -12,6 +15,8 @@
 
 #include "source/common/tls/private_key/private_key_manager_impl.h"
 
+#include "absl/container/flat_hash_map.h"
+
 namespace Envoy {
 namespace Extensions {
 namespace TransportSockets {
@@ -22,6 +27,11 @@ namespace Tls {
  * Contexts can be allocated the main thread. They can be released from any thread (and in practice
  * are since cluster information can be released from any thread). Context allocation/free is a very
  * uncommon thing so we just do a global lock to protect it all.
+ *
+ * The server contexts created with the same stats scope and server names from configs with the
+ * same context hash, e.g. by the filter chains of a listener with identical downstream TLS
+ * contexts, or by the unchanged filter chains of a listener updated in place, share a single
+ * context, which is released once it's removed by each of its creators.
  */
 class ContextManagerImpl final : public Envoy::Ssl::ContextManager {
 public:
@@ -45,8 +55,17 @@ public:
   void removeContext(const Envoy::Ssl::ContextSharedPtr& old_context) override;
 
 private:
+  using ServerContextKey = std::tuple<const Stats::Scope*, std::vector<std::string>, uint64_t>;
+
+  struct ContextEntry {
+    // The number of creations of the context which weren't removed yet.
+    uint32_t references_;
+    absl::optional<ServerContextKey> shared_key_;
+  };
+
   Server::Configuration::CommonFactoryContext& factory_context_;
-  absl::flat_hash_set<Envoy::Ssl::ContextSharedPtr> contexts_;
+  absl::flat_hash_map<Envoy::Ssl::ContextSharedPtr, ContextEntry> contexts_;
+  absl::flat_hash_map<ServerContextKey, Envoy::Ssl::ServerContextSharedPtr> shared_server_contexts_;
   PrivateKeyMethodManagerImpl private_key_method_manager_{};
 };
 
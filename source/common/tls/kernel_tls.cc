@@ -0,0 +1,189 @@
+#include "source/common/tls/kernel_tls.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "envoy/common/platform.h"
+
+#include "source/common/api/os_sys_calls_impl.h"
+#include "source/common/common/macros.h"
+
+#include "openssl/mem.h"
+#include "openssl/nid.h"
+
+#if defined(__linux__)
+#include <linux/tls.h>
+#include <netinet/tcp.h>
+#endif
+
+#if defined(__linux__) && defined(TLS_TX) && defined(TLS_CIPHER_CHACHA20_POLY1305) &&             \
+    defined(TCP_ULP) && defined(SOL_TLS)
+#define ENVOY_KERNEL_TLS_SUPPORT 1
+#else
+#define ENVOY_KERNEL_TLS_SUPPORT 0
+#endif
+
+namespace Envoy {
+namespace Extensions {
+namespace TransportSockets {
+namespace Tls {
+namespace KernelTls {
+
+#if ENVOY_KERNEL_TLS_SUPPORT
+namespace {
+
+constexpr uint8_t AlertRecordType = 21;
+constexpr uint8_t AlertLevelWarning = 1;
+constexpr uint8_t AlertCloseNotify = 0;
+
+// Stores a record sequence number in network byte order, as the explicit nonces and the record
+// sequence numbers of the kernel crypto info are.
+void storeSequence(uint64_t sequence, unsigned char* out) {
+  for (int i = 7; i >= 0; --i) {
+    out[i] = sequence & 0xff;
+    sequence >>= 8;
+  }
+}
+
+template <class CryptoInfo>
+bool setTxCryptoInfo(Network::IoHandle& io_handle, CryptoInfo& crypto_info) {
+  const bool set =
+      io_handle.setOption(SOL_TLS, TLS_TX, &crypto_info, sizeof(crypto_info)).return_value_ == 0;
+  OPENSSL_cleanse(&crypto_info, sizeof(crypto_info));
+  return set;
+}
+
+// AES-GCM uses the fixed part of the IV as salt, and the record sequence number as explicit nonce,
+// as BoringSSL does.
+template <class CryptoInfo>
+bool setAesGcmTx(Network::IoHandle& io_handle, uint16_t cipher_type, const uint8_t* key,
+                 const uint8_t* fixed_iv, uint64_t sequence) {
+  CryptoInfo crypto_info{};
+  crypto_info.info.version = TLS_1_2_VERSION;
+  crypto_info.info.cipher_type = cipher_type;
+  std::copy_n(key, sizeof(crypto_info.key), crypto_info.key);
+  std::copy_n(fixed_iv, sizeof(crypto_info.salt), crypto_info.salt);
+  storeSequence(sequence, crypto_info.iv);
+  storeSequence(sequence, crypto_info.rec_seq);
+  return setTxCryptoInfo(io_handle, crypto_info);
+}
+
+bool setChaCha20Poly1305Tx(Network::IoHandle& io_handle, const uint8_t* key,
+                           const uint8_t* fixed_iv, uint64_t sequence) {
+  tls12_crypto_info_chacha20_poly1305 crypto_info{};
+  crypto_info.info.version = TLS_1_2_VERSION;
+  crypto_info.info.cipher_type = TLS_CIPHER_CHACHA20_POLY1305;
+  std::copy_n(key, sizeof(crypto_info.key), crypto_info.key);
+  std::copy_n(fixed_iv, sizeof(crypto_info.iv), crypto_info.iv);
+  storeSequence(sequence, crypto_info.rec_seq);
+  return setTxCryptoInfo(io_handle, crypto_info);
+}
+
+} // namespace
+#endif
+
+bool enableTx(SSL* ssl, Network::IoHandle& io_handle) {
+#if ENVOY_KERNEL_TLS_SUPPORT
+  // The TLS 1.3 traffic secrets are not exposed by BoringSSL, and the key update and session
+  // ticket messages sent after the handshake would have to bypass the kernel.
+  if (SSL_version(ssl) != TLS1_2_VERSION) {
+    return false;
+  }
+  const SSL_CIPHER* cipher = SSL_get_current_cipher(ssl);
+  if (cipher == nullptr) {
+    return false;
+  }
+  const int cipher_nid = SSL_CIPHER_get_cipher_nid(cipher);
+  size_t key_len;
+  size_t iv_len;
+  switch (cipher_nid) {
+  case NID_aes_128_gcm:
+    key_len = TLS_CIPHER_AES_GCM_128_KEY_SIZE;
+    iv_len = TLS_CIPHER_AES_GCM_128_SALT_SIZE;
+    break;
+  case NID_aes_256_gcm:
+    key_len = TLS_CIPHER_AES_GCM_256_KEY_SIZE;
+    iv_len = TLS_CIPHER_AES_GCM_256_SALT_SIZE;
+    break;
+  case NID_chacha20_poly1305:
+    key_len = TLS_CIPHER_CHACHA20_POLY1305_KEY_SIZE;
+    iv_len = TLS_CIPHER_CHACHA20_POLY1305_IV_SIZE;
+    break;
+  default:
+    return false;
+  }
+
+  // The key block of an AEAD cipher holds no MAC keys: the client write key, the server write key,
+  // the client write IV and the server write IV.
+  const size_t key_block_len = SSL_get_key_block_len(ssl);
+  if (key_block_len != 2 * (key_len + iv_len)) {
+    return false;
+  }
+  std::vector<uint8_t> key_block(key_block_len);
+  if (!SSL_generate_key_block(ssl, key_block.data(), key_block.size())) {
+    return false;
+  }
+  const bool is_server = SSL_is_server(ssl);
+  const uint8_t* key = key_block.data() + (is_server ? key_len : 0);
+  const uint8_t* fixed_iv = key_block.data() + 2 * key_len + (is_server ? iv_len : 0);
+  const uint64_t sequence = SSL_get_write_sequence(ssl);
+
+  bool enabled = false;
+  // The TLS upper layer protocol sends plaintext as is until its transmit parameters are set.
+  if (io_handle.setOption(IPPROTO_TCP, TCP_ULP, "tls", sizeof("tls")).return_value_ == 0) {
+    switch (cipher_nid) {
+    case NID_aes_128_gcm:
+      enabled = setAesGcmTx<tls12_crypto_info_aes_gcm_128>(io_handle, TLS_CIPHER_AES_GCM_128, key,
+                                                           fixed_iv, sequence);
+      break;
+    case NID_aes_256_gcm:
+      enabled = setAesGcmTx<tls12_crypto_info_aes_gcm_256>(io_handle, TLS_CIPHER_AES_GCM_256, key,
+                                                           fixed_iv, sequence);
+      break;
+    default:
+      enabled = setChaCha20Poly1305Tx(io_handle, key, fixed_iv, sequence);
+      break;
+    }
+  }
+  OPENSSL_cleanse(key_block.data(), key_block.size());
+  return enabled;
+#else
+  UNREFERENCED_PARAMETER(ssl);
+  UNREFERENCED_PARAMETER(io_handle);
+  return false;
+#endif
+}
+
+bool sendCloseNotify(Network::IoHandle& io_handle) {
+#if ENVOY_KERNEL_TLS_SUPPORT
+  uint8_t alert[] = {AlertLevelWarning, AlertCloseNotify};
+  iovec iov;
+  iov.iov_base = alert;
+  iov.iov_len = sizeof(alert);
+  alignas(cmsghdr) char cbuf[CMSG_SPACE(sizeof(uint8_t))] = {};
+  msghdr message{};
+  message.msg_iov = &iov;
+  message.msg_iovlen = 1;
+  message.msg_control = cbuf;
+  message.msg_controllen = sizeof(cbuf);
+  // The record type of the data sent with the control message.
+  cmsghdr* cmsg = CMSG_FIRSTHDR(&message);
+  cmsg->cmsg_level = SOL_TLS;
+  cmsg->cmsg_type = TLS_SET_RECORD_TYPE;
+  cmsg->cmsg_len = CMSG_LEN(sizeof(uint8_t));
+  *CMSG_DATA(cmsg) = AlertRecordType;
+  const Api::SysCallSizeResult result =
+      Api::OsSysCallsSingleton::get().sendmsg(io_handle.fdDoNotUse(), &message, 0);
+  return result.return_value_ == static_cast<ssize_t>(sizeof(alert));
+#else
+  UNREFERENCED_PARAMETER(io_handle);
+  return false;
+#endif
+}
+
+} // namespace KernelTls
+} // namespace Tls
+} // namespace TransportSockets
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,34 @@
+#pragma once
+
+#include "envoy/network/io_handle.h"
+
+#include "openssl/ssl.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace TransportSockets {
+namespace Tls {
+namespace KernelTls {
+
+/**
+ * Moves the encryption of the records sent on a connection to the kernel TLS, if the negotiated
+ * version and cipher allow it. BoringSSL keeps decrypting the records received.
+ * @param ssl the connection, whose handshake is complete and which has no record pending write.
+ * @param io_handle the socket of the connection.
+ * @return true if the kernel encrypts the data written to the socket from now on, in which case
+ * the connection must write plaintext to the socket instead of calling SSL_write().
+ */
+bool enableTx(SSL* ssl, Network::IoHandle& io_handle);
+
+/**
+ * Sends a close_notify alert on a socket whose sent records are encrypted by the kernel.
+ * @param io_handle the socket of the connection.
+ * @return true if the alert was written to the socket.
+ */
+bool sendCloseNotify(Network::IoHandle& io_handle);
+
+} // namespace KernelTls
+} // namespace Tls
+} // namespace TransportSockets
+} // namespace Extensions
+} // namespace Envoy
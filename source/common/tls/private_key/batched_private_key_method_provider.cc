@@ -0,0 +1,167 @@
+#include "source/common/tls/private_key/batched_private_key_method_provider.h"
+
+#include <algorithm>
+#include <memory>
+
+#include "envoy/common/exception.h"
+
+#include "source/common/common/assert.h"
+#include "source/common/common/macros.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace TransportSockets {
+namespace Tls {
+
+namespace {
+
+BatchedPrivateKeyConnection* getConnection(SSL* ssl) {
+  return static_cast<BatchedPrivateKeyConnection*>(
+      SSL_get_ex_data(ssl, BatchedPrivateKeyMethodProvider::connectionIndex()));
+}
+
+ssl_private_key_result_t privateKeySign(SSL* ssl, uint8_t*, size_t*, size_t,
+                                        uint16_t signature_algorithm, const uint8_t* in,
+                                        size_t in_len) {
+  BatchedPrivateKeyConnection* connection = getConnection(ssl);
+  if (connection == nullptr || connection->operation_ != nullptr) {
+    return ssl_private_key_failure;
+  }
+
+  // The input is only valid during the call, the operation keeps a copy for the batch.
+  connection->operation_ = std::make_unique<BatchedSignOperation>(signature_algorithm, in, in_len);
+  connection->done_ = false;
+  connection->queue_.add(*connection);
+  return ssl_private_key_retry;
+}
+
+ssl_private_key_result_t privateKeyDecrypt(SSL*, uint8_t*, size_t*, size_t, const uint8_t*,
+                                           size_t) {
+  return ssl_private_key_failure;
+}
+
+ssl_private_key_result_t privateKeyComplete(SSL* ssl, uint8_t* out, size_t* out_len,
+                                            size_t max_out) {
+  BatchedPrivateKeyConnection* connection = getConnection(ssl);
+  if (connection == nullptr || connection->operation_ == nullptr) {
+    return ssl_private_key_failure;
+  }
+  // The handshake can be driven again before its batch has been processed.
+  if (!connection->done_) {
+    return ssl_private_key_retry;
+  }
+
+  std::unique_ptr<BatchedSignOperation> operation = std::move(connection->operation_);
+  const std::vector<uint8_t>& signature = operation->signature_;
+  if (signature.empty() || signature.size() > max_out) {
+    return ssl_private_key_failure;
+  }
+  std::copy(signature.begin(), signature.end(), out);
+  *out_len = signature.size();
+  return ssl_private_key_success;
+}
+
+int createIndex() {
+  int index = SSL_get_ex_new_index(0, nullptr, nullptr, nullptr, nullptr);
+  RELEASE_ASSERT(index >= 0, "Failed to get SSL user data index.");
+  return index;
+}
+
+} // namespace
+
+BatchedPrivateKeyConnection::~BatchedPrivateKeyConnection() { queue_.remove(*this); }
+
+BatchedPrivateKeyQueue::BatchedPrivateKeyQueue(BatchedPrivateKeyMethodProvider& provider,
+                                               Event::Dispatcher& dispatcher,
+                                               uint32_t max_batch_size)
+    : provider_(provider), max_batch_size_(max_batch_size),
+      process_cb_(dispatcher.createSchedulableCallback([this]() { processRequests(); })) {}
+
+void BatchedPrivateKeyQueue::add(BatchedPrivateKeyConnection& connection) {
+  pending_.push_back(&connection);
+  // The batch is processed once the events of the iteration, which may reach the signatures of
+  // more handshakes, have been handled.
+  if (!process_cb_->enabled()) {
+    process_cb_->scheduleCallbackCurrentIteration();
+  }
+}
+
+void BatchedPrivateKeyQueue::remove(BatchedPrivateKeyConnection& connection) {
+  auto it = std::find(pending_.begin(), pending_.end(), &connection);
+  if (it != pending_.end()) {
+    pending_.erase(it);
+  }
+  std::replace(completing_.begin(), completing_.end(), &connection,
+               static_cast<BatchedPrivateKeyConnection*>(nullptr));
+}
+
+void BatchedPrivateKeyQueue::processRequests() {
+  std::vector<BatchedSignOperation*> operations;
+  while (!pending_.empty()) {
+    const size_t batch_size = std::min<size_t>(pending_.size(), max_batch_size_);
+    ENVOY_LOG(debug, "signing a batch of {} private key operations", batch_size);
+    operations.clear();
+    for (size_t i = 0; i < batch_size; ++i) {
+      operations.push_back(pending_[i]->operation_.get());
+    }
+    provider_.signBatch(operations);
+    for (size_t i = 0; i < batch_size; ++i) {
+      pending_[i]->done_ = true;
+    }
+    completing_.insert(completing_.end(), pending_.begin(), pending_.begin() + batch_size);
+    pending_.erase(pending_.begin(), pending_.begin() + batch_size);
+  }
+
+  // Resuming a handshake may close connections, which are then removed from the list.
+  for (size_t i = 0; i < completing_.size(); ++i) {
+    BatchedPrivateKeyConnection* connection = completing_[i];
+    if (connection != nullptr) {
+      completing_[i] = nullptr;
+      connection->cb_.onPrivateKeyMethodComplete();
+    }
+  }
+  completing_.clear();
+}
+
+BatchedPrivateKeyMethodProvider::BatchedPrivateKeyMethodProvider(ThreadLocal::SlotAllocator& tls,
+                                                                 uint32_t max_batch_size)
+    : method_(std::make_shared<SSL_PRIVATE_KEY_METHOD>()),
+      tls_(ThreadLocal::TypedSlot<BatchedPrivateKeyQueue>::makeUnique(tls)) {
+  ASSERT(max_batch_size > 0);
+  method_->sign = privateKeySign;
+  method_->decrypt = privateKeyDecrypt;
+  method_->complete = privateKeyComplete;
+
+  tls_->set([this, max_batch_size](Event::Dispatcher& dispatcher) {
+    return std::make_shared<BatchedPrivateKeyQueue>(*this, dispatcher, max_batch_size);
+  });
+}
+
+void BatchedPrivateKeyMethodProvider::registerPrivateKeyMethod(
+    SSL* ssl, Ssl::PrivateKeyConnectionCallbacks& cb, Event::Dispatcher&) {
+  if (getConnection(ssl) != nullptr) {
+    throw EnvoyException("Not registering the batched private key provider twice for same context");
+  }
+  ASSERT(tls_->currentThreadRegistered(), "Current thread needs to be registered.");
+  SSL_set_ex_data(ssl, connectionIndex(), new BatchedPrivateKeyConnection(cb, *tls_->get()));
+}
+
+void BatchedPrivateKeyMethodProvider::unregisterPrivateKeyMethod(SSL* ssl) {
+  BatchedPrivateKeyConnection* connection = getConnection(ssl);
+  SSL_set_ex_data(ssl, connectionIndex(), nullptr);
+  delete connection;
+}
+
+Ssl::BoringSslPrivateKeyMethodSharedPtr
+BatchedPrivateKeyMethodProvider::getBoringSslPrivateKeyMethod() {
+  return method_;
+}
+
+int BatchedPrivateKeyMethodProvider::connectionIndex() {
+  CONSTRUCT_ON_FIRST_USE(int, createIndex());
+}
+
+} // namespace Tls
+} // namespace TransportSockets
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,118 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "envoy/event/dispatcher.h"
+#include "envoy/event/schedulable_cb.h"
+#include "envoy/ssl/private_key/private_key.h"
+#include "envoy/thread_local/thread_local.h"
+
+#include "source/common/common/logger.h"
+
+#include "absl/types/span.h"
+#include "openssl/ssl.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace TransportSockets {
+namespace Tls {
+
+/**
+ * A signing operation of a handshake, processed in a batch with the operations of the other
+ * handshakes of the worker.
+ */
+struct BatchedSignOperation {
+  BatchedSignOperation(uint16_t signature_algorithm, const uint8_t* in, size_t in_len)
+      : signature_algorithm_(signature_algorithm), input_(in, in + in_len) {}
+
+  const uint16_t signature_algorithm_;
+  // The unhashed input of the signature, as given to the BoringSSL sign method.
+  const std::vector<uint8_t> input_;
+  // Set by the provider, left empty if signing failed.
+  std::vector<uint8_t> signature_;
+};
+
+class BatchedPrivateKeyQueue;
+
+/**
+ * The private key state of a connection, queued on its worker while its signing is pending.
+ */
+class BatchedPrivateKeyConnection {
+public:
+  BatchedPrivateKeyConnection(Ssl::PrivateKeyConnectionCallbacks& cb,
+                              BatchedPrivateKeyQueue& queue)
+      : cb_(cb), queue_(queue) {}
+  ~BatchedPrivateKeyConnection();
+
+  Ssl::PrivateKeyConnectionCallbacks& cb_;
+  BatchedPrivateKeyQueue& queue_;
+  std::unique_ptr<BatchedSignOperation> operation_;
+  // Whether the operation has been processed, and its signature can be completed.
+  bool done_{};
+};
+
+class BatchedPrivateKeyMethodProvider;
+
+/**
+ * The signing operations requested on a worker during a dispatcher iteration. They are processed
+ * together at the end of the iteration, so that every handshake which got to its signature by
+ * then is part of the batch.
+ */
+class BatchedPrivateKeyQueue : public ThreadLocal::ThreadLocalObject,
+                               public Logger::Loggable<Logger::Id::connection> {
+public:
+  BatchedPrivateKeyQueue(BatchedPrivateKeyMethodProvider& provider, Event::Dispatcher& dispatcher,
+                         uint32_t max_batch_size);
+
+  void add(BatchedPrivateKeyConnection& connection);
+  void remove(BatchedPrivateKeyConnection& connection);
+
+private:
+  void processRequests();
+
+  BatchedPrivateKeyMethodProvider& provider_;
+  const uint32_t max_batch_size_;
+  Event::SchedulableCallbackPtr process_cb_;
+  std::vector<BatchedPrivateKeyConnection*> pending_;
+  // The connections of the processed batches whose handshakes are being resumed. A connection
+  // closed by the resumption of another one is replaced by nullptr.
+  std::vector<BatchedPrivateKeyConnection*> completing_;
+};
+
+/**
+ * A base for the private key method providers benefiting from signing several inputs at once,
+ * like multi-buffer implementations. The handshakes of a worker reaching their signature during
+ * a dispatcher iteration are suspended, their inputs are signed in batches of up to
+ * max_batch_size at the end of the iteration, and the handshakes are resumed through the
+ * asynchronous private key callbacks. Only signing is batched, decryption always fails.
+ */
+class BatchedPrivateKeyMethodProvider : public virtual Ssl::PrivateKeyMethodProvider {
+public:
+  // Ssl::PrivateKeyMethodProvider
+  void registerPrivateKeyMethod(SSL* ssl, Ssl::PrivateKeyConnectionCallbacks& cb,
+                                Event::Dispatcher& dispatcher) override;
+  void unregisterPrivateKeyMethod(SSL* ssl) override;
+  Ssl::BoringSslPrivateKeyMethodSharedPtr getBoringSslPrivateKeyMethod() override;
+
+  /**
+   * Signs a batch of inputs, on the worker which requested them.
+   * @param operations supplies the operations to sign, whose signatures are to be set.
+   */
+  virtual void signBatch(absl::Span<BatchedSignOperation* const> operations) PURE;
+
+  static int connectionIndex();
+
+protected:
+  BatchedPrivateKeyMethodProvider(ThreadLocal::SlotAllocator& tls, uint32_t max_batch_size);
+
+private:
+  Ssl::BoringSslPrivateKeyMethodSharedPtr method_;
+  ThreadLocal::TypedSlotPtr<BatchedPrivateKeyQueue> tls_;
+};
+
+} // namespace Tls
+} // namespace TransportSockets
+} // namespace Extensions
+} // namespace Envoy
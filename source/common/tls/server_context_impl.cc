@@ -37,11 +37,20 @@
 #include "openssl/evp.h"
 #include "openssl/hmac.h"
 #include "openssl/pkcs12.h"
+#include "openssl/pool.h"
 #include "openssl/rand.h"
 
 namespace Envoy {
 namespace {
 
+// The certificates received by all the server contexts share one pool, which deduplicates the
+// common intermediates of the client chains and of the sessions held in the session caches. It is
+// never freed, since buffers of sessions and connections can outlive their context.
+CRYPTO_BUFFER_POOL* certificateBufferPool() {
+  static CRYPTO_BUFFER_POOL* pool = CRYPTO_BUFFER_POOL_new();
+  return pool;
+}
+
 bool cbsContainsU16(CBS& cbs, uint16_t n) {
   while (CBS_len(&cbs) > 0) {
     uint16_t v;
@@ -97,6 +106,8 @@ ServerContextImpl::ServerContextImpl(Stats::Scope& scope,
     : ContextImpl(scope, config, factory_context, additional_init, creation_status),
       session_ticket_keys_(config.sessionTicketKeys()),
       ocsp_staple_policy_(config.ocspStaplePolicy()),
+      session_cache_(config.capabilities().handles_session_resumption ? nullptr
+                                                                       : config.sessionCache()),
       full_scan_certs_on_sni_mismatch_(config.fullScanCertsOnSNIMismatch()) {
   if (!creation_status.ok()) {
     return;
@@ -105,7 +116,13 @@ ServerContextImpl::ServerContextImpl(Stats::Scope& scope,
     throw EnvoyException("Server TlsCertificates must have a certificate specified");
   }
 
+  const bool shared_buffer_pool = Runtime::runtimeFeatureEnabled(
+      "envoy.reloadable_features.tls_shared_certificate_buffer_pool");
   for (auto& ctx : tls_contexts_) {
+    if (shared_buffer_pool) {
+      SSL_CTX_set0_buffer_pool(ctx.ssl_ctx_.get(), certificateBufferPool());
+    }
+    (ctx.is_ecdsa_ ? ecdsa_contexts_ : non_ecdsa_contexts_).push_back(ctx);
     if (ctx.cert_chain_ == nullptr) {
       continue;
     }
@@ -121,6 +138,7 @@ ServerContextImpl::ServerContextImpl(Stats::Scope& scope,
   // since we should have a common ID for session resumption no matter what cert
   // is used. We do this early because it can throw an EnvoyException.
   const SessionContextID session_id = generateHashForSessionContextId(server_names);
+  session_id_context_ = session_id;
 
   // First, configure the base context for ClientHello interception.
   // TODO(htuch): replace with SSL_IDENTITY when we have this as a means to do multi-cert in
@@ -174,6 +192,26 @@ ServerContextImpl::ServerContextImpl(Stats::Scope& scope,
 
     if (config.disableStatefulSessionResumption()) {
       SSL_CTX_set_session_cache_mode(ctx.ssl_ctx_.get(), SSL_SESS_CACHE_OFF);
+    } else if (session_cache_ != nullptr) {
+      SSL_CTX_set_session_cache_mode(ctx.ssl_ctx_.get(),
+                                     SSL_SESS_CACHE_SERVER | SSL_SESS_CACHE_NO_INTERNAL);
+      SSL_CTX_sess_set_new_cb(ctx.ssl_ctx_.get(), [](SSL* ssl, SSL_SESSION* session) -> int {
+        static_cast<ServerContextImpl*>(SSL_CTX_get_app_data(SSL_get_SSL_CTX(ssl)))
+            ->newSession(session);
+        // The session isn't retained, the cache holds its serialization.
+        return 0;
+      });
+      SSL_CTX_sess_set_get_cb(
+          ctx.ssl_ctx_.get(),
+          [](SSL* ssl, const uint8_t* id, int id_len, int* out_copy) -> SSL_SESSION* {
+            // The reference of the returned session is passed to the connection.
+            *out_copy = 0;
+            return static_cast<ServerContextImpl*>(SSL_CTX_get_app_data(SSL_get_SSL_CTX(ssl)))
+                ->getSession(ssl, id, id_len);
+          });
+      SSL_CTX_sess_set_remove_cb(ctx.ssl_ctx_.get(), [](SSL_CTX* ssl_ctx, SSL_SESSION* session) {
+        static_cast<ServerContextImpl*>(SSL_CTX_get_app_data(ssl_ctx))->removeSession(session);
+      });
     }
 
     if (config.sessionTimeout() && !config.capabilities().handles_session_resumption) {
@@ -366,6 +404,43 @@ ServerContextImpl::generateHashForSessionContextId(const std::vector<std::string
   return session_id;
 }
 
+std::string ServerContextImpl::sessionCacheKey(const uint8_t* id, size_t id_len) const {
+  std::string key(reinterpret_cast<const char*>(session_id_context_.data()),
+                  session_id_context_.size());
+  key.append(reinterpret_cast<const char*>(id), id_len);
+  return key;
+}
+
+void ServerContextImpl::newSession(SSL_SESSION* session) {
+  unsigned int id_len;
+  const uint8_t* id = SSL_SESSION_get_id(session, &id_len);
+  uint8_t* data;
+  size_t data_len;
+  if (id_len == 0 || !SSL_SESSION_to_bytes(session, &data, &data_len)) {
+    return;
+  }
+  bssl::UniquePtr<uint8_t> data_owner(data);
+  session_cache_->insert(sessionCacheKey(id, id_len),
+                         absl::string_view(reinterpret_cast<const char*>(data), data_len),
+                         std::chrono::seconds(SSL_SESSION_get_timeout(session)));
+}
+
+SSL_SESSION* ServerContextImpl::getSession(SSL* ssl, const uint8_t* id, int id_len) {
+  const absl::optional<std::string> data = session_cache_->lookup(sessionCacheKey(id, id_len));
+  if (!data.has_value()) {
+    return nullptr;
+  }
+  // The session is checked by BoringSSL, e.g. its expiry and its session ID context, once returned.
+  return SSL_SESSION_from_bytes(reinterpret_cast<const uint8_t*>(data->data()), data->size(),
+                                SSL_get_SSL_CTX(ssl));
+}
+
+void ServerContextImpl::removeSession(SSL_SESSION* session) {
+  unsigned int id_len;
+  const uint8_t* id = SSL_SESSION_get_id(session, &id_len);
+  session_cache_->remove(sessionCacheKey(id, id_len));
+}
+
 int ServerContextImpl::sessionTicketProcess(SSL*, uint8_t* key_name, uint8_t* iv,
                                             EVP_CIPHER_CTX* ctx, HMAC_CTX* hmac_ctx, int encrypt) {
   const EVP_MD* hmac = EVP_sha256();
@@ -635,13 +710,21 @@ ServerContextImpl::findTlsContext(absl::string_view sni, bool client_ecdsa_capab
   // it requires full_scan_certs_on_sni_mismatch is enabled.
   if (selected_ctx == nullptr) {
     candidate_ctx = nullptr;
-    // Skip loop when there is no cert compatible to key type
-    if (client_ecdsa_capable || (!client_ecdsa_capable && has_rsa_)) {
-      for (const auto& ctx : tls_contexts_) {
-        if (selected(ctx)) {
-          break;
+    // ECDSA certificates are scanned first for the ECDSA capable clients, and only the other
+    // certificates are compatible with the other clients.
+    auto scan = [&selected, &candidate_ctx](const auto& contexts) -> bool {
+      for (const Ssl::TlsContext& ctx : contexts) {
+        if (selected(ctx) || candidate_ctx != nullptr) {
+          return true;
         }
       }
+      return false;
+    };
+    if (!client_ecdsa_capable || !scan(ecdsa_contexts_)) {
+      // Skip loop when there is no cert compatible to key type
+      if (client_ecdsa_capable || has_rsa_) {
+        scan(non_ecdsa_contexts_);
+      }
     }
     tail_select(false);
   }
@@ -82,6 +82,11 @@ private:
                          unsigned int inlen);
   int sessionTicketProcess(SSL* ssl, uint8_t* key_name, uint8_t* iv, EVP_CIPHER_CTX* ctx,
                            HMAC_CTX* hmac_ctx, int encrypt);
+  // The callbacks of the session cache, if configured, replacing the cache of each SSL_CTX.
+  void newSession(SSL_SESSION* session);
+  SSL_SESSION* getSession(SSL* ssl, const uint8_t* id, int id_len);
+  void removeSession(SSL_SESSION* session);
+  std::string sessionCacheKey(const uint8_t* id, size_t id_len) const;
   bool isClientEcdsaCapable(const SSL_CLIENT_HELLO* ssl_client_hello);
   bool isClientOcspCapable(const SSL_CLIENT_HELLO* ssl_client_hello);
   OcspStapleAction ocspStapleAction(const Ssl::TlsContext& ctx, bool client_ocsp_capable);
@@ -90,7 +95,14 @@ private:
 
   const std::vector<Envoy::Ssl::ServerContextConfig::SessionTicketKey> session_ticket_keys_;
   const Ssl::ServerContextConfig::OcspStaplePolicy ocsp_staple_policy_;
+  const Ssl::SessionCacheSharedPtr session_cache_;
+  // The session ID context, which prefixes the keys of the session cache since it may be shared.
+  SessionContextID session_id_context_{};
   ServerNamesMap server_names_map_;
+  // The contexts with and without an ECDSA certificate, in configuration order, which are scanned
+  // for the clients whose server name matches no certificate.
+  std::vector<std::reference_wrapper<const Ssl::TlsContext>> ecdsa_contexts_;
+  std::vector<std::reference_wrapper<const Ssl::TlsContext>> non_ecdsa_contexts_;
   bool has_rsa_{false};
   bool full_scan_certs_on_sni_mismatch_;
 };
@@ -8,6 +8,7 @@
 #include "source/common/http/headers.h"
 #include "source/common/runtime/runtime_features.h"
 #include "source/common/tls/io_handle_bio.h"
+#include "source/common/tls/kernel_tls.h"
 #include "source/common/tls/ssl_handshaker.h"
 #include "source/common/tls/utility.h"
 
@@ -166,6 +167,22 @@ Network::IoResult SslSocket::doRead(Buffer::Instance& read_buffer) {
     bytes_read += bytes_read_this_iteration;
   }
 
+  if (kernel_tls_tx_) {
+    // BoringSSL answered a received record, e.g. with an alert, but its write BIO is a memory
+    // BIO since the offload. The peer never gets the answer, so the connection can't go on.
+    BIO* wbio = SSL_get_wbio(rawSsl());
+    const size_t dropped = BIO_pending(wbio);
+    if (dropped > 0) {
+      ENVOY_CONN_LOG(debug, "kernel TLS dropped {} bytes written by BoringSSL",
+                     callbacks_->connection(), dropped);
+      BIO_reset(wbio);
+      if (action == PostIoAction::KeepOpen) {
+        failure_reason_ = "kernel TLS dropped records written by BoringSSL";
+        action = PostIoAction::Close;
+      }
+    }
+  }
+
   ENVOY_CONN_LOG(trace, "ssl read {} bytes", callbacks_->connection(), bytes_read);
 
   return {action, bytes_read, end_stream};
@@ -190,6 +207,9 @@ Network::Connection& SslSocket::connection() const { return callbacks_->connecti
 
 void SslSocket::onSuccess(SSL* ssl) {
   ctx_->logHandshake(ssl);
+  if (ctx_->kernelTlsOffload()) {
+    enableKernelTlsTx(ssl);
+  }
   if (callbacks_->connection().streamInfo().upstreamInfo()) {
     callbacks_->connection()
         .streamInfo()
@@ -203,6 +223,29 @@ void SslSocket::onSuccess(SSL* ssl) {
   callbacks_->raiseEvent(Network::ConnectionEvent::Connected);
 }
 
+void SslSocket::enableKernelTlsTx(SSL* ssl) {
+  // The records of a renegotiation would be written by BoringSSL, which can't once offloaded.
+  if (ctx_->renegotiationAllowed()) {
+    ENVOY_CONN_LOG(debug, "kernel TLS offload not available with renegotiation allowed",
+                   callbacks_->connection());
+    ctx_->stats().kernel_tls_tx_offload_failed_.inc();
+    return;
+  }
+  if (!KernelTls::enableTx(ssl, callbacks_->ioHandle())) {
+    ENVOY_CONN_LOG(debug, "kernel TLS offload not available for {} with {}",
+                   callbacks_->connection(), SSL_get_version(ssl),
+                   SSL_CIPHER_get_name(SSL_get_current_cipher(ssl)));
+    ctx_->stats().kernel_tls_tx_offload_failed_.inc();
+    return;
+  }
+  // BoringSSL must not write to the socket anymore, the kernel would send its records as data.
+  // Records it still produces are dropped, see doRead().
+  SSL_set0_wbio(ssl, BIO_new(BIO_s_mem()));
+  kernel_tls_tx_ = true;
+  ctx_->stats().kernel_tls_tx_offloaded_.inc();
+  ENVOY_CONN_LOG(debug, "kernel TLS offload enabled for sent records", callbacks_->connection());
+}
+
 void SslSocket::onFailure() { drainErrorQueue(); }
 
 PostIoAction SslSocket::doHandshake() { return info_->doHandshake(); }
@@ -266,6 +309,10 @@ Network::IoResult SslSocket::doWrite(Buffer::Instance& write_buffer, bool end_st
     }
   }
 
+  if (kernel_tls_tx_) {
+    return doKernelTlsWrite(write_buffer, end_stream);
+  }
+
   uint64_t bytes_to_write;
   if (bytes_to_retry_) {
     bytes_to_write = bytes_to_retry_;
@@ -316,12 +363,47 @@ Network::IoResult SslSocket::doWrite(Buffer::Instance& write_buffer, bool end_st
   return {PostIoAction::KeepOpen, total_bytes_written, false};
 }
 
+Network::IoResult SslSocket::doKernelTlsWrite(Buffer::Instance& write_buffer, bool end_stream) {
+  uint64_t total_bytes_written = 0;
+  while (write_buffer.length() > 0) {
+    // The kernel encrypts the plaintext written into records.
+    Api::IoCallUint64Result result = callbacks_->ioHandle().write(write_buffer);
+    if (!result.ok()) {
+      ENVOY_CONN_LOG(trace, "kernel TLS write error: {}", callbacks_->connection(),
+                     result.err_->getErrorDetails());
+      if (result.err_->getErrorCode() == Api::IoError::IoErrorCode::Again) {
+        return {PostIoAction::KeepOpen, total_bytes_written, false};
+      }
+      failure_reason_ = absl::StrCat("kernel TLS write error: ", result.err_->getErrorDetails());
+      return {PostIoAction::Close, total_bytes_written, false};
+    }
+    ENVOY_CONN_LOG(trace, "kernel TLS write returns: {}", callbacks_->connection(),
+                   result.return_value_);
+    total_bytes_written += result.return_value_;
+  }
+
+  if (end_stream) {
+    shutdownSsl();
+  }
+
+  return {PostIoAction::KeepOpen, total_bytes_written, false};
+}
+
 void SslSocket::onConnected() { ASSERT(info_->state() == Ssl::SocketState::PreHandshake); }
 
 Ssl::ConnectionInfoConstSharedPtr SslSocket::ssl() const { return info_; }
 
 void SslSocket::shutdownSsl() {
   ASSERT(info_->state() != Ssl::SocketState::PreHandshake);
+  if (info_->state() != Ssl::SocketState::ShutdownSent &&
+      callbacks_->connection().state() != Network::Connection::State::Closed && kernel_tls_tx_) {
+    // The kernel has to encrypt the close_notify alert, BoringSSL's write state is stale.
+    const bool sent = KernelTls::sendCloseNotify(callbacks_->ioHandle());
+    ENVOY_CONN_LOG(debug, "SSL shutdown through kernel TLS: sent={}", callbacks_->connection(),
+                   sent);
+    info_->setState(Ssl::SocketState::ShutdownSent);
+    return;
+  }
   if (info_->state() != Ssl::SocketState::ShutdownSent &&
       callbacks_->connection().state() != Network::Connection::State::Closed) {
     int rc = SSL_shutdown(rawSsl());
@@ -91,6 +91,8 @@ private:
   ReadResult sslReadIntoSlice(Buffer::RawSlice& slice);
 
   Network::PostIoAction doHandshake();
+  void enableKernelTlsTx(SSL* ssl);
+  Network::IoResult doKernelTlsWrite(Buffer::Instance& write_buffer, bool end_stream);
   void drainErrorQueue();
   void shutdownSsl();
   void shutdownBasic();
@@ -101,6 +103,8 @@ private:
   ContextImplSharedPtr ctx_;
   uint64_t bytes_to_retry_{};
   std::string failure_reason_;
+  // Whether the kernel encrypts the records sent, after the handshake.
+  bool kernel_tls_tx_{};
 
   SslHandshakerImplSharedPtr info_;
 };
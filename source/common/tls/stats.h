@@ -21,7 +21,12 @@ namespace Tls {
   COUNTER(ocsp_staple_omitted)                                                                     \
   COUNTER(ocsp_staple_responses)                                                                   \
   COUNTER(ocsp_staple_requests)                                                                    \
-  COUNTER(was_key_usage_invalid)
+  COUNTER(was_key_usage_invalid)                                                                   \
+  COUNTER(kernel_tls_tx_offloaded)                                                                 \
+  COUNTER(kernel_tls_tx_offload_failed)                                                            \
+  COUNTER(verified_chain_cache_evicted)                                                            \
+  COUNTER(verified_chain_cache_hit)                                                                \
+  COUNTER(verified_chain_cache_miss)
 
 /**
  * Wrapper struct for SSL stats. @see stats_macros.h
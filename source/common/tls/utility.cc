@@ -431,6 +431,17 @@ SystemTime Utility::getExpirationTime(const X509& cert) {
   return std::chrono::system_clock::from_time_t(static_cast<time_t>(days) * 24 * 60 * 60 + seconds);
 }
 
+absl::optional<SystemTime> Utility::getNextUpdate(const X509_CRL& crl) {
+  const ASN1_TIME* next_update = X509_CRL_get0_nextUpdate(&crl);
+  if (next_update == nullptr) {
+    return absl::nullopt;
+  }
+  int days, seconds;
+  int rc = ASN1_TIME_diff(&days, &seconds, &epochASN1Time(), next_update);
+  ASSERT(rc == 1);
+  return std::chrono::system_clock::from_time_t(static_cast<time_t>(days) * 24 * 60 * 60 + seconds);
+}
+
 absl::optional<std::string> Utility::getLastCryptoError() {
   auto err = ERR_get_error();
 
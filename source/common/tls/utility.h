@@ -109,6 +109,13 @@ SystemTime getValidFrom(const X509& cert);
  */
 SystemTime getExpirationTime(const X509& cert);
 
+/**
+ * Returns the time when the next update of this CRL is due.
+ * @param crl the certificate revocation list.
+ * @return the next update time, or absl::nullopt if the CRL doesn't have one.
+ */
+absl::optional<SystemTime> getNextUpdate(const X509_CRL& crl);
+
 /**
  * Returns the last crypto error from ERR_get_error(), or `absl::nullopt`
  * if the error stack is empty.
@@ -0,0 +1,220 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <memory>
+#include <vector>
+
+#include "envoy/upstream/scheduler.h"
+
+#include "source/common/common/assert.h"
+
+namespace Envoy {
+namespace Upstream {
+
+// Alias table scheduler
+// ---------------------
+// This scheduler lays out the weights of the objects inserted in an alias table
+// (https://en.wikipedia.org/wiki/Alias_method): one column per object, each column holding its
+// object up to a threshold and an alias object above it, with the weights of all the columns
+// being equal. A pick walks the columns in order, and chooses between the object and the alias of
+// the column by comparing the threshold to a low discrepancy sequence, which honors the weights
+// without any randomness. All picks are constant time, and building the table after the objects
+// have been added is linear in their number.
+//
+// For the case where all object weights are the same, the scheduler behaves identical to vanilla
+// round-robin. Otherwise the picks follow the weights over a cycle through the columns, but the
+// picks of an object are not as evenly spaced as they are with the EDF scheduler.
+//
+// The weights returned by calculate_weight are not applied on each pick. Once a pick returned a
+// new weight, the weights of all the objects are recomputed and the table is rebuilt at the end
+// of the current cycle through the columns, which keeps the picks constant time in amortized
+// terms when the weights change with each pick (like in the least request LB).
+template <class C> class AliasTableScheduler : public Scheduler<C> {
+public:
+  AliasTableScheduler() = default;
+
+  // See scheduler.h for an explanation of each public method.
+  std::shared_ptr<C> peekAgain(std::function<double(const C&)> calculate_weight) override {
+    std::shared_ptr<C> ret = pickEntry(calculate_weight);
+    if (ret) {
+      prepick_list_.push_back(ret);
+    }
+    return ret;
+  }
+
+  std::shared_ptr<C> pickAndAdd(std::function<double(const C&)> calculate_weight) override {
+    while (!prepick_list_.empty()) {
+      // In this case the entry was picked during peekAgain so don't pick again.
+      std::shared_ptr<C> ret = prepick_list_.front().lock();
+      prepick_list_.pop_front();
+      if (ret) {
+        return ret;
+      }
+    }
+    return pickEntry(calculate_weight);
+  }
+
+  void add(double weight, std::shared_ptr<C> entry) override {
+    ASSERT(weight > 0);
+    entries_.push_back({weight, entry});
+    rebuild_table_ = true;
+  }
+
+  bool empty() const override { return entries_.empty(); }
+
+  // Creates an AliasTableScheduler with the given entries, in the state it would be in after the
+  // given number of picks without weight changes. Unlike with the EDF scheduler, emulating the
+  // picks is constant time.
+  static AliasTableScheduler<C> createWithPicks(const std::vector<std::shared_ptr<C>>& entries,
+                                                std::function<double(const C&)> calculate_weight,
+                                                uint32_t picks) {
+    AliasTableScheduler<C> scheduler;
+    scheduler.entries_.reserve(entries.size());
+    for (const auto& entry : entries) {
+      scheduler.add(calculate_weight(*entry), entry);
+    }
+    scheduler.buildTable();
+    if (!entries.empty()) {
+      scheduler.next_column_ = picks % entries.size();
+      scheduler.sequence_ = sequenceValue(picks);
+    }
+    return scheduler;
+  }
+
+private:
+  // The fractional part of the golden ratio. The multiples of an irrational number modulo 1 are
+  // spread evenly over [0, 1), whatever the number of consecutive values considered.
+  static constexpr double SequenceStep = 0.6180339887498949;
+
+  static double sequenceValue(uint64_t index) {
+    const double value = index * SequenceStep;
+    return value - static_cast<uint64_t>(value);
+  }
+
+  struct Entry {
+    double weight_;
+    // We only hold a weak pointer, since we don't support a remove operator. This allows entries to
+    // be lazily unloaded from the table.
+    std::weak_ptr<C> entry_;
+  };
+
+  struct Column {
+    // The column picks its own entry when the sequence value is below the threshold, its alias
+    // otherwise.
+    double threshold_;
+    uint32_t alias_;
+  };
+
+  std::shared_ptr<C> pickEntry(const std::function<double(const C&)>& calculate_weight) {
+    while (true) {
+      if (rebuild_table_ || (weights_changed_ && picks_since_build_ >= columns_.size())) {
+        if (weights_changed_ && calculate_weight) {
+          refreshWeights(calculate_weight);
+        }
+        buildTable();
+      }
+      if (columns_.empty()) {
+        return nullptr;
+      }
+
+      const uint32_t column_index = next_column_;
+      next_column_ = next_column_ + 1 == columns_.size() ? 0 : next_column_ + 1;
+      sequence_ += SequenceStep;
+      if (sequence_ >= 1.0) {
+        sequence_ -= 1.0;
+      }
+      ++picks_since_build_;
+
+      const Column& column = columns_[column_index];
+      Entry& entry = entries_[sequence_ < column.threshold_ ? column_index : column.alias_];
+      std::shared_ptr<C> ret = entry.entry_.lock();
+      if (!ret) {
+        // Entry has been removed, drop it from the table and pick again.
+        rebuild_table_ = true;
+        continue;
+      }
+      if (calculate_weight && calculate_weight(*ret) != entry.weight_) {
+        weights_changed_ = true;
+      }
+      return ret;
+    }
+  }
+
+  void refreshWeights(const std::function<double(const C&)>& calculate_weight) {
+    for (Entry& entry : entries_) {
+      std::shared_ptr<C> object = entry.entry_.lock();
+      if (object) {
+        entry.weight_ = calculate_weight(*object);
+        ASSERT(entry.weight_ > 0);
+      }
+    }
+  }
+
+  // Builds the table with Vose's algorithm, dropping the expired entries.
+  void buildTable() {
+    entries_.erase(std::remove_if(entries_.begin(), entries_.end(),
+                                  [](const Entry& entry) { return entry.entry_.expired(); }),
+                   entries_.end());
+    rebuild_table_ = false;
+    weights_changed_ = false;
+    picks_since_build_ = 0;
+
+    const uint32_t size = entries_.size();
+    columns_.resize(size);
+    if (size == 0) {
+      next_column_ = 0;
+      return;
+    }
+    next_column_ %= size;
+
+    double weights_sum = 0;
+    for (const Entry& entry : entries_) {
+      weights_sum += entry.weight_;
+    }
+    // The thresholds start as the weights scaled to a mean of 1, those above 1 then giving to
+    // those below it until all are filled.
+    std::vector<uint32_t> small;
+    std::vector<uint32_t> large;
+    for (uint32_t i = 0; i < size; ++i) {
+      columns_[i] = {entries_[i].weight_ * size / weights_sum, i};
+      (columns_[i].threshold_ < 1.0 ? small : large).push_back(i);
+    }
+    while (!small.empty() && !large.empty()) {
+      const uint32_t filled = small.back();
+      small.pop_back();
+      const uint32_t giver = large.back();
+      columns_[filled].alias_ = giver;
+      columns_[giver].threshold_ -= 1.0 - columns_[filled].threshold_;
+      if (columns_[giver].threshold_ < 1.0) {
+        large.pop_back();
+        small.push_back(giver);
+      }
+    }
+    // The columns left are full, up to floating point errors.
+    for (const uint32_t i : small) {
+      columns_[i].threshold_ = 1.0;
+    }
+    for (const uint32_t i : large) {
+      columns_[i].threshold_ = 1.0;
+    }
+  }
+
+  std::vector<Entry> entries_;
+  std::vector<Column> columns_;
+  // The column of the next pick.
+  uint32_t next_column_{};
+  // The low discrepancy sequence value of the last pick.
+  double sequence_{};
+  uint64_t picks_since_build_{};
+  // Whether entries were added or have expired since the table was built.
+  bool rebuild_table_{};
+  // Whether a pick returned a new weight since the table was built.
+  bool weights_changed_{};
+  std::list<std::weak_ptr<C>> prepick_list_;
+};
+
+} // namespace Upstream
+} // namespace Envoy
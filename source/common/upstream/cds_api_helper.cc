@@ -27,6 +27,13 @@ CdsApiHelper::onConfigUpdate(const std::vector<Config::DecodedResourceRef>& adde
         Config::getTypeUrl<envoy::extensions::transport_sockets::tls::v3::Secret>()};
     maybe_resume_eds_leds_sds = cm_.adsMux()->pause(paused_xds_types);
   }
+  // The thread local updates of all the clusters of the response are posted to the workers at
+  // once, when the response has been processed.
+  Config::ScopedResume maybe_resume_thread_local_updates;
+  if (Runtime::runtimeFeatureEnabled(
+          "envoy.reloadable_features.batch_thread_local_cluster_updates")) {
+    maybe_resume_thread_local_updates = cm_.pauseThreadLocalClusterUpdates();
+  }
 
   ENVOY_LOG(info, "{}: add {} cluster(s), remove {} cluster(s)", name_, added_resources.size(),
             removed_resources.size());
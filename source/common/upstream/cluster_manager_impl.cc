@@ -1,5 +1,6 @@
 #include "source/common/upstream/cluster_manager_impl.h"
 
+#include <algorithm>
 #include <chrono>
 #include <cstdint>
 #include <functional>
@@ -24,6 +25,7 @@
 #include "source/common/common/assert.h"
 #include "source/common/common/enum_to_int.h"
 #include "source/common/common/fmt.h"
+#include "source/common/common/hash.h"
 #include "source/common/common/utility.h"
 #include "source/common/config/custom_config_validators_impl.h"
 #include "source/common/config/null_grpc_mux_impl.h"
@@ -45,6 +47,8 @@
 #include "source/common/upstream/load_balancer_context_base.h"
 #include "source/common/upstream/priority_conn_pool_map_impl.h"
 
+#include "absl/container/flat_hash_set.h"
+
 #ifdef ENVOY_ENABLE_QUIC
 #include "source/common/http/conn_pool_grid.h"
 #include "source/common/http/http3/conn_pool.h"
@@ -310,9 +314,10 @@ ClusterManagerImpl::ClusterManagerImpl(
     OptRef<Server::Admin> admin, ProtobufMessage::ValidationContext& validation_context,
     Api::Api& api, Http::Context& http_context, Grpc::Context& grpc_context,
     Router::Context& router_context, Server::Instance& server)
-    : server_(server), factory_(factory), runtime_(runtime), stats_(stats), tls_(tls),
-      random_(api.randomGenerator()),
+    : server_(server), factory_(factory), runtime_(runtime), stats_(stats), thread_local_(tls),
+      tls_(tls), random_(api.randomGenerator()),
       deferred_cluster_creation_(bootstrap.cluster_manager().enable_deferred_cluster_creation()),
+      concurrency_(server.options().concurrency()),
       bind_config_(bootstrap.cluster_manager().has_upstream_bind_config()
                        ? absl::make_optional(bootstrap.cluster_manager().upstream_bind_config())
                        : absl::nullopt),
@@ -544,7 +549,10 @@ ClusterManagerImpl::initialize(const envoy::config::bootstrap::v3::Bootstrap& bo
   // Once the initial set of static bootstrap clusters are created (including the local cluster),
   // we can instantiate the thread local cluster manager.
   tls_.set([this, local_cluster_params](Event::Dispatcher& dispatcher) {
-    return std::make_shared<ThreadLocalClusterManagerImpl>(*this, dispatcher, local_cluster_params);
+    const absl::optional<uint32_t> worker_index =
+        &dispatcher == &dispatcher_ ? absl::nullopt : absl::make_optional(next_worker_index_++);
+    return std::make_shared<ThreadLocalClusterManagerImpl>(*this, dispatcher, local_cluster_params,
+                                                           worker_index);
   });
 
   // We can now potentially create the CDS API once the backing cluster exists.
@@ -887,7 +895,7 @@ bool ClusterManagerImpl::removeCluster(const std::string& cluster_name) {
     active_clusters_.erase(existing_active_cluster);
 
     ENVOY_LOG(debug, "removing cluster {}", cluster_name);
-    tls_.runOnAllThreads([cluster_name](OptRef<ThreadLocalClusterManagerImpl> cluster_manager) {
+    runOnAllThreadsInOrder([cluster_name](OptRef<ThreadLocalClusterManagerImpl> cluster_manager) {
       ASSERT(cluster_manager->thread_local_clusters_.contains(cluster_name) ||
              cluster_manager->thread_local_deferred_clusters_.contains(cluster_name));
       ENVOY_LOG(debug, "removing TLS cluster {}", cluster_name);
@@ -1132,19 +1140,20 @@ void ClusterManagerImpl::drainConnections(const std::string& cluster,
                                           DrainConnectionsHostPredicate predicate) {
   ENVOY_LOG_EVENT(debug, "drain_connections_call", "drainConnections called for cluster {}",
                   cluster);
-  tls_.runOnAllThreads([cluster, predicate](OptRef<ThreadLocalClusterManagerImpl> cluster_manager) {
-    auto cluster_entry = cluster_manager->thread_local_clusters_.find(cluster);
-    if (cluster_entry != cluster_manager->thread_local_clusters_.end()) {
-      cluster_entry->second->drainConnPools(
-          predicate, ConnectionPool::DrainBehavior::DrainExistingConnections);
-    }
-  });
+  runOnAllThreadsInOrder(
+      [cluster, predicate](OptRef<ThreadLocalClusterManagerImpl> cluster_manager) {
+        auto cluster_entry = cluster_manager->thread_local_clusters_.find(cluster);
+        if (cluster_entry != cluster_manager->thread_local_clusters_.end()) {
+          cluster_entry->second->drainConnPools(
+              predicate, ConnectionPool::DrainBehavior::DrainExistingConnections);
+        }
+      });
 }
 
 void ClusterManagerImpl::drainConnections(DrainConnectionsHostPredicate predicate) {
   ENVOY_LOG_EVENT(debug, "drain_connections_call_for_all_clusters",
                   "drainConnections called for all clusters");
-  tls_.runOnAllThreads([predicate](OptRef<ThreadLocalClusterManagerImpl> cluster_manager) {
+  runOnAllThreadsInOrder([predicate](OptRef<ThreadLocalClusterManagerImpl> cluster_manager) {
     for (const auto& cluster_entry : cluster_manager->thread_local_clusters_) {
       cluster_entry.second->drainConnPools(predicate,
                                            ConnectionPool::DrainBehavior::DrainExistingConnections);
@@ -1168,12 +1177,59 @@ void ClusterManagerImpl::postThreadLocalRemoveHosts(const Cluster& cluster,
                                                     const HostVector& hosts_removed) {
   // Drain the connection pools for the given hosts. For deferred clusters have
   // been created.
-  tls_.runOnAllThreads([name = cluster.info()->name(),
-                        hosts_removed](OptRef<ThreadLocalClusterManagerImpl> cluster_manager) {
+  runOnAllThreadsInOrder([name = cluster.info()->name(),
+                          hosts_removed](OptRef<ThreadLocalClusterManagerImpl> cluster_manager) {
     cluster_manager->removeHosts(name, hosts_removed);
   });
 }
 
+Config::ScopedResume ClusterManagerImpl::pauseThreadLocalClusterUpdates() {
+  ++thread_local_updates_pauses_;
+  // The slot updates of the clusters created meanwhile go with the held updates, in the same post
+  // to each worker.
+  std::shared_ptr<Cleanup> batch = thread_local_.batchUpdates(nullptr);
+  return std::make_unique<Cleanup>([this, batch]() mutable {
+    resumeThreadLocalClusterUpdates();
+    batch.reset();
+  });
+}
+
+void ClusterManagerImpl::resumeThreadLocalClusterUpdates() {
+  ASSERT(thread_local_updates_pauses_ > 0);
+  if (--thread_local_updates_pauses_ > 0 || paused_thread_local_updates_.empty()) {
+    return;
+  }
+  auto updates = std::make_shared<const std::vector<ThreadLocalClusterManagerImpl::UpdateCb>>(
+      std::move(paused_thread_local_updates_));
+  paused_thread_local_updates_.clear();
+  if (shutdown_) {
+    return;
+  }
+
+  ENVOY_LOG(debug, "posting {} thread local cluster update(s) to the workers", updates->size());
+  // One post per worker for the whole batch, rather than one per update.
+  const ThreadLocalClusterManagerImpl* main_cluster_manager = tls_.get().ptr();
+  tls_.runOnAllThreads([updates, main_cluster_manager](
+                           OptRef<ThreadLocalClusterManagerImpl> cluster_manager) {
+    // The main thread got the updates when they were made.
+    if (cluster_manager.ptr() != main_cluster_manager) {
+      cluster_manager->queueUpdates(*updates);
+    }
+  });
+}
+
+void ClusterManagerImpl::runOnAllThreadsInOrder(ThreadLocalClusterManagerImpl::UpdateCb update) {
+  if (thread_local_updates_pauses_ > 0) {
+    update(tls_.get());
+    paused_thread_local_updates_.push_back(std::move(update));
+    return;
+  }
+  tls_.runOnAllThreads(
+      [update = std::move(update)](OptRef<ThreadLocalClusterManagerImpl> cluster_manager) {
+        cluster_manager->applyUpdate(update);
+      });
+}
+
 bool ClusterManagerImpl::deferralIsSupportedForCluster(
     const ClusterInfoConstSharedPtr& info) const {
   if (!deferred_cluster_creation_) {
@@ -1241,10 +1297,10 @@ void ClusterManagerImpl::postThreadLocalClusterUpdate(ClusterManagerCluster& cm_
       addOrUpdateClusterInitializationObjectIfSupported(
           params, cm_cluster.cluster().info(), load_balancer_factory, host_map, drop_overload);
 
-  tls_.runOnAllThreads([info = cm_cluster.cluster().info(), params = std::move(params),
-                        add_or_update_cluster, load_balancer_factory, map = std::move(host_map),
-                        cluster_initialization_object = std::move(cluster_initialization_object),
-                        drop_overload](OptRef<ThreadLocalClusterManagerImpl> cluster_manager) {
+  runOnAllThreadsInOrder([info = cm_cluster.cluster().info(), params = std::move(params),
+                          add_or_update_cluster, load_balancer_factory, map = std::move(host_map),
+                          cluster_initialization_object = std::move(cluster_initialization_object),
+                          drop_overload](OptRef<ThreadLocalClusterManagerImpl> cluster_manager) {
     ASSERT(cluster_manager.has_value(),
            "Expected the ThreadLocalClusterManager to be set during ClusterManagerImpl creation.");
 
@@ -1486,7 +1542,7 @@ ClusterManagerImpl::ClusterInitializationObject::ClusterInitializationObject(
 }
 
 void ClusterManagerImpl::postThreadLocalHealthFailure(const HostSharedPtr& host) {
-  tls_.runOnAllThreads([host](OptRef<ThreadLocalClusterManagerImpl> cluster_manager) {
+  runOnAllThreadsInOrder([host](OptRef<ThreadLocalClusterManagerImpl> cluster_manager) {
     cluster_manager->onHostHealthFailure(host);
   });
 }
@@ -1548,9 +1604,21 @@ void ClusterManagerImpl::ThreadLocalClusterManagerImpl::ClusterEntry::updateHost
     HostMapConstSharedPtr cross_priority_host_map) {
   ENVOY_LOG(debug, "membership update for TLS cluster {} added {} removed {}", name,
             hosts_added.size(), hosts_removed.size());
-  priority_set_.updateHosts(priority, std::move(update_hosts_params), std::move(locality_weights),
-                            hosts_added, hosts_removed, seed, weighted_priority_health,
-                            overprovisioning_factor, std::move(cross_priority_host_map));
+  if (workers_per_host_ > 0 && workers_per_host_ < parent_.parent_.concurrency_ &&
+      parent_.worker_index_.has_value()) {
+    HostVector sharded_hosts_added;
+    HostVector sharded_hosts_removed;
+    shardHosts(priority, update_hosts_params, sharded_hosts_added, sharded_hosts_removed);
+    priority_set_.updateHosts(priority, std::move(update_hosts_params),
+                              std::move(locality_weights), sharded_hosts_added,
+                              sharded_hosts_removed, seed, weighted_priority_health,
+                              overprovisioning_factor, std::move(cross_priority_host_map));
+  } else {
+    priority_set_.updateHosts(priority, std::move(update_hosts_params),
+                              std::move(locality_weights), hosts_added, hosts_removed, seed,
+                              weighted_priority_health, overprovisioning_factor,
+                              std::move(cross_priority_host_map));
+  }
   // If an LB is thread aware, create a new worker local LB on membership changes.
   if (lb_factory_ != nullptr && lb_factory_->recreateOnHostChange()) {
     ENVOY_LOG(debug, "re-creating local LB for TLS cluster {}", name);
@@ -1558,6 +1626,74 @@ void ClusterManagerImpl::ThreadLocalClusterManagerImpl::ClusterEntry::updateHost
   }
 }
 
+bool ClusterManagerImpl::ThreadLocalClusterManagerImpl::ClusterEntry::ownsHost(
+    const Host& host) const {
+  if (host.address() == nullptr) {
+    return true;
+  }
+  // The host is owned by the workers_per_host_ workers following the one its address hashes to.
+  const uint32_t concurrency = parent_.parent_.concurrency_;
+  const uint32_t first_worker = HashUtil::xxHash64(host.address()->asStringView()) % concurrency;
+  return (parent_.worker_index_.value() + concurrency - first_worker) % concurrency <
+         workers_per_host_;
+}
+
+void ClusterManagerImpl::ThreadLocalClusterManagerImpl::ClusterEntry::shardHosts(
+    uint32_t priority, PrioritySet::UpdateHostsParams& update_hosts_params,
+    HostVector& hosts_added, HostVector& hosts_removed) const {
+  const auto owned = [this](const Host& host) { return ownsHost(host); };
+  const HostVector& hosts = *update_hosts_params.hosts;
+  if (std::any_of(hosts.begin(), hosts.end(),
+                  [&owned](const HostSharedPtr& host) { return owned(*host); })) {
+    const auto filter = [&owned](const HostVector& unfiltered) {
+      HostVector filtered;
+      for (const HostSharedPtr& host : unfiltered) {
+        if (owned(*host)) {
+          filtered.push_back(host);
+        }
+      }
+      return filtered;
+    };
+    update_hosts_params.hosts = std::make_shared<const HostVector>(filter(hosts));
+    update_hosts_params.healthy_hosts = std::make_shared<const HealthyHostVector>(
+        filter(update_hosts_params.healthy_hosts->get()));
+    update_hosts_params.degraded_hosts = std::make_shared<const DegradedHostVector>(
+        filter(update_hosts_params.degraded_hosts->get()));
+    update_hosts_params.excluded_hosts = std::make_shared<const ExcludedHostVector>(
+        filter(update_hosts_params.excluded_hosts->get()));
+    update_hosts_params.hosts_per_locality =
+        update_hosts_params.hosts_per_locality->filter({owned})[0];
+    update_hosts_params.healthy_hosts_per_locality =
+        update_hosts_params.healthy_hosts_per_locality->filter({owned})[0];
+    update_hosts_params.degraded_hosts_per_locality =
+        update_hosts_params.degraded_hosts_per_locality->filter({owned})[0];
+    update_hosts_params.excluded_hosts_per_locality =
+        update_hosts_params.excluded_hosts_per_locality->filter({owned})[0];
+  }
+
+  // The hosts kept by an update depend on the other hosts of the priority, so the changes are
+  // computed from the hosts kept by the previous update.
+  absl::flat_hash_set<const Host*> previous_hosts;
+  const auto& host_sets = priority_set_.hostSetsPerPriority();
+  if (priority < host_sets.size()) {
+    for (const HostSharedPtr& host : host_sets[priority]->hosts()) {
+      previous_hosts.insert(host.get());
+    }
+  }
+  for (const HostSharedPtr& host : *update_hosts_params.hosts) {
+    if (previous_hosts.erase(host.get()) == 0) {
+      hosts_added.push_back(host);
+    }
+  }
+  if (priority < host_sets.size()) {
+    for (const HostSharedPtr& host : host_sets[priority]->hosts()) {
+      if (previous_hosts.contains(host.get())) {
+        hosts_removed.push_back(host);
+      }
+    }
+  }
+}
+
 void ClusterManagerImpl::ThreadLocalClusterManagerImpl::ClusterEntry::drainConnPools(
     const HostVector& hosts_removed) {
   for (const auto& host : hosts_removed) {
@@ -1692,7 +1828,7 @@ void ClusterManagerImpl::notifyClusterDiscoveryStatus(absl::string_view name,
     return;
   }
   // Let all the worker threads know that the discovery timed out.
-  tls_.runOnAllThreads(
+  runOnAllThreadsInOrder(
       [name = std::string(name), status](OptRef<ThreadLocalClusterManagerImpl> cluster_manager) {
         ENVOY_LOG(
             trace,
@@ -1760,8 +1896,10 @@ ClusterManagerImpl::dumpClusterConfigs(const Matchers::StringMatcher& name_match
 
 ClusterManagerImpl::ThreadLocalClusterManagerImpl::ThreadLocalClusterManagerImpl(
     ClusterManagerImpl& parent, Event::Dispatcher& dispatcher,
-    const absl::optional<LocalClusterParams>& local_cluster_params)
-    : parent_(parent), thread_local_dispatcher_(dispatcher), cdm_(dispatcher.name(), *this),
+    const absl::optional<LocalClusterParams>& local_cluster_params,
+    absl::optional<uint32_t> worker_index)
+    : parent_(parent), thread_local_dispatcher_(dispatcher), worker_index_(worker_index),
+      cdm_(dispatcher.name(), *this),
       local_stats_(generateStats(*parent.stats_.rootScope(), dispatcher.name())) {
   // If local cluster is defined then we need to initialize it first.
   if (local_cluster_params.has_value()) {
@@ -1781,6 +1919,7 @@ ClusterManagerImpl::ThreadLocalClusterManagerImpl::~ThreadLocalClusterManagerImp
   // member update callback registered with the local cluster.
   ENVOY_LOG(debug, "shutting down thread local cluster manager");
   destroying_ = true;
+  pending_updates_.clear();
   host_http_conn_pool_map_.clear();
   host_tcp_conn_pool_map_.clear();
   ASSERT(host_tcp_conn_map_.empty());
@@ -1795,6 +1934,42 @@ ClusterManagerImpl::ThreadLocalClusterManagerImpl::~ThreadLocalClusterManagerImp
   thread_local_dispatcher_.clearDeferredDeleteList();
 }
 
+void ClusterManagerImpl::ThreadLocalClusterManagerImpl::applyUpdate(const UpdateCb& update) {
+  if (pending_updates_.empty()) {
+    update(*this);
+  } else {
+    pending_updates_.push_back(update);
+  }
+}
+
+void ClusterManagerImpl::ThreadLocalClusterManagerImpl::queueUpdates(
+    const std::vector<UpdateCb>& updates) {
+  const bool was_empty = pending_updates_.empty();
+  pending_updates_.insert(pending_updates_.end(), updates.begin(), updates.end());
+  if (was_empty) {
+    applyPendingUpdates();
+  }
+}
+
+void ClusterManagerImpl::ThreadLocalClusterManagerImpl::applyPendingUpdates() {
+  TimeSource& time_source = thread_local_dispatcher_.timeSource();
+  const MonotonicTime deadline = time_source.monotonicTime() + UpdatesTimeSlice;
+  while (!pending_updates_.empty()) {
+    UpdateCb update = std::move(pending_updates_.front());
+    pending_updates_.pop_front();
+    update(*this);
+    if (!pending_updates_.empty() && time_source.monotonicTime() >= deadline) {
+      // Let the requests of the worker be processed before applying the remaining updates.
+      if (pending_updates_cb_ == nullptr) {
+        pending_updates_cb_ =
+            thread_local_dispatcher_.createSchedulableCallback([this]() { applyPendingUpdates(); });
+      }
+      pending_updates_cb_->scheduleCallbackNextIteration();
+      return;
+    }
+  }
+}
+
 void ClusterManagerImpl::ThreadLocalClusterManagerImpl::removeTcpConn(
     const HostConstSharedPtr& host, Network::ClientConnection& connection) {
   auto host_tcp_conn_map_it = host_tcp_conn_map_.find(host);
@@ -1903,7 +2078,9 @@ ClusterManagerImpl::ThreadLocalClusterManagerImpl::ClusterEntry::ClusterEntry(
     ThreadLocalClusterManagerImpl& parent, ClusterInfoConstSharedPtr cluster,
     const LoadBalancerFactorySharedPtr& lb_factory)
     : parent_(parent), cluster_info_(cluster), lb_factory_(lb_factory),
-      override_host_statuses_(HostUtility::createOverrideHostStatus(cluster_info_->lbConfig())) {
+      override_host_statuses_(HostUtility::createOverrideHostStatus(cluster_info_->lbConfig())),
+      workers_per_host_(
+          PROTOBUF_GET_WRAPPED_OR_DEFAULT(cluster_info_->lbConfig(), workers_per_host, 0)) {
   priority_set_.getOrCreateHostSet(0);
 
   // TODO(mattklein123): Consider converting other LBs over to thread local. All of them could
@@ -1,7 +1,9 @@
 #pragma once
 
 #include <array>
+#include <chrono>
 #include <cstdint>
+#include <deque>
 #include <functional>
 #include <list>
 #include <map>
@@ -309,6 +311,7 @@ public:
   }
 
   Config::GrpcMuxSharedPtr adsMux() override { return ads_mux_; }
+  Config::ScopedResume pauseThreadLocalClusterUpdates() override;
   Grpc::AsyncClientManager& grpcAsyncClientManager() override { return *async_client_manager_; }
 
   const absl::optional<std::string>& localClusterName() const override {
@@ -622,6 +625,14 @@ private:
       HostConstSharedPtr chooseHost(LoadBalancerContext* context);
       HostConstSharedPtr peekAnotherHost(LoadBalancerContext* context);
 
+      // Whether the worker load balances to the host, when the hosts are sharded between the
+      // workers.
+      bool ownsHost(const Host& host) const;
+      // Keeps the hosts of the update owned by the worker, or all of them when it owns none. The
+      // added and removed hosts are computed from the hosts kept by the previous update.
+      void shardHosts(uint32_t priority, PrioritySet::UpdateHostsParams& update_hosts_params,
+                      HostVector& hosts_added, HostVector& hosts_removed) const;
+
       ThreadLocalClusterManagerImpl& parent_;
       PrioritySetImpl priority_set_;
       UnitFloat drop_overload_{0};
@@ -652,6 +663,8 @@ private:
       // If multiple bit fields are set, it is acceptable as long as the status of override host is
       // in any of these statuses.
       const HostUtility::HostStatusSet override_host_statuses_{};
+      // The number of workers load balancing to each host, 0 if they all do.
+      const uint32_t workers_per_host_;
     };
 
     using ClusterEntryPtr = std::unique_ptr<ClusterEntry>;
@@ -661,10 +674,24 @@ private:
       ClusterInfoConstSharedPtr info_;
     };
 
+    using UpdateCb = std::function<void(OptRef<ThreadLocalClusterManagerImpl>)>;
+
+    // The time a worker spends applying the updates of a batch before yielding to the other
+    // events of its dispatcher.
+    static constexpr std::chrono::milliseconds UpdatesTimeSlice{1};
+
     ThreadLocalClusterManagerImpl(ClusterManagerImpl& parent, Event::Dispatcher& dispatcher,
-                                  const absl::optional<LocalClusterParams>& local_cluster_params);
+                                  const absl::optional<LocalClusterParams>& local_cluster_params,
+                                  absl::optional<uint32_t> worker_index);
     ~ThreadLocalClusterManagerImpl() override;
 
+    // Applies an update, after the pending updates if there are some.
+    void applyUpdate(const UpdateCb& update);
+    // Queues a batch of updates, which are applied over as many dispatcher iterations as needed
+    // to spend at most about UpdatesTimeSlice in each of them.
+    void queueUpdates(const std::vector<UpdateCb>& updates);
+    void applyPendingUpdates();
+
     // Drain or close connections of host. If no drain behavior is provided then closing will
     // be immediate.
     void drainOrCloseConnPools(const HostSharedPtr& host,
@@ -700,6 +727,8 @@ private:
 
     ClusterManagerImpl& parent_;
     Event::Dispatcher& thread_local_dispatcher_;
+    // The index of the worker among all the workers, not set on the main thread.
+    const absl::optional<uint32_t> worker_index_;
     // Known clusters will exclusively exist in either `thread_local_clusters_`
     // or `thread_local_deferred_clusters_`.
     absl::flat_hash_map<std::string, ClusterEntryPtr> thread_local_clusters_;
@@ -719,6 +748,9 @@ private:
     bool destroying_{};
     ClusterDiscoveryManager cdm_;
     ThreadLocalClusterManagerStats local_stats_;
+    // The updates of the batches which did not fit in the time slice of their iteration.
+    std::deque<UpdateCb> pending_updates_;
+    Event::SchedulableCallbackPtr pending_updates_cb_;
 
   private:
     static ThreadLocalClusterManagerStats generateStats(Stats::Scope& scope,
@@ -877,16 +909,26 @@ private:
 
   bool deferralIsSupportedForCluster(const ClusterInfoConstSharedPtr& info) const;
 
+  // Runs the update on all the threads, in the order of the previous updates. The update is
+  // applied to the main thread and held for the workers while the updates are paused.
+  void runOnAllThreadsInOrder(ThreadLocalClusterManagerImpl::UpdateCb update);
+  void resumeThreadLocalClusterUpdates();
+
   Server::Instance& server_;
   ClusterManagerFactory& factory_;
   Runtime::Loader& runtime_;
   Stats::Store& stats_;
+  ThreadLocal::Instance& thread_local_;
   ThreadLocal::TypedSlot<ThreadLocalClusterManagerImpl> tls_;
   // Contains information about ongoing on-demand cluster discoveries.
   ClusterCreationsMap pending_cluster_creations_;
   Random::RandomGenerator& random_;
   ClusterMap warming_clusters_;
   const bool deferred_cluster_creation_;
+  // The number of workers, which are numbered in the order they get their thread local cluster
+  // manager.
+  const uint32_t concurrency_;
+  std::atomic<uint32_t> next_worker_index_{};
   absl::optional<envoy::config::core::v3::BindConfig> bind_config_;
   Outlier::EventLoggerSharedPtr outlier_event_logger_;
   const LocalInfo::LocalInfo& local_info_;
@@ -903,6 +945,9 @@ private:
   Server::ConfigTracker::EntryOwnerPtr config_tracker_entry_;
   TimeSource& time_source_;
   ClusterUpdatesMap updates_map_;
+  // The updates held for the workers while the thread local cluster updates are paused.
+  std::vector<ThreadLocalClusterManagerImpl::UpdateCb> paused_thread_local_updates_;
+  uint32_t thread_local_updates_pauses_{};
   Event::Dispatcher& dispatcher_;
   Http::Context& http_context_;
   ProtobufMessage::ValidationContext& validation_context_;
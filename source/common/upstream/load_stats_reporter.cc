@@ -72,55 +72,33 @@ void LoadStatsReporter::sendLoadStatsRequest() {
     if (const auto& name = cluster.info()->edsServiceName(); !name.empty()) {
       cluster_stats->set_cluster_service_name(name);
     }
-    for (const HostSetPtr& host_set : cluster.prioritySet().hostSetsPerPriority()) {
-      ENVOY_LOG(trace, "Load report locality count {}", host_set->hostsPerLocality().get().size());
-      for (const HostVector& hosts : host_set->hostsPerLocality().get()) {
-        ASSERT(!hosts.empty());
-        uint64_t rq_success = 0;
-        uint64_t rq_error = 0;
-        uint64_t rq_active = 0;
-        uint64_t rq_issued = 0;
-        LoadMetricStats::StatMap load_metrics;
-        for (const HostSharedPtr& host : hosts) {
-          uint64_t host_rq_success = host->stats().rq_success_.latch();
-          uint64_t host_rq_error = host->stats().rq_error_.latch();
-          uint64_t host_rq_active = host->stats().rq_active_.value();
-          uint64_t host_rq_issued = host->stats().rq_total_.latch();
-          rq_success += host_rq_success;
-          rq_error += host_rq_error;
-          rq_active += host_rq_active;
-          rq_issued += host_rq_issued;
-          if (host_rq_success + host_rq_error + host_rq_active != 0) {
-            const std::unique_ptr<LoadMetricStats::StatMap> latched_stats =
-                host->loadMetricStats().latch();
-            if (latched_stats != nullptr) {
-              for (const auto& metric : *latched_stats) {
-                const std::string& name = metric.first;
-                LoadMetricStats::Stat& stat = load_metrics[name];
-                stat.num_requests_with_metric += metric.second.num_requests_with_metric;
-                stat.total_metric_value += metric.second.total_metric_value;
-              }
-            }
+    // The requests are counted per locality and priority as they are made, so this doesn't
+    // depend on the number of hosts, and also reports the requests of the hosts removed since the
+    // last report.
+    cluster.info()->localityLoadStats().forEach(
+        [cluster_stats](const envoy::config::core::v3::Locality& locality, uint32_t priority,
+                        LocalityLoadStats& stats) {
+          const LocalityLoadStats::Latched latched = stats.latch();
+          if (latched.rq_success_ + latched.rq_error_ + latched.rq_active_ == 0) {
+            return;
           }
-        }
-        if (rq_success + rq_error + rq_active != 0) {
           auto* locality_stats = cluster_stats->add_upstream_locality_stats();
-          locality_stats->mutable_locality()->MergeFrom(hosts[0]->locality());
-          locality_stats->set_priority(host_set->priority());
-          locality_stats->set_total_successful_requests(rq_success);
-          locality_stats->set_total_error_requests(rq_error);
-          locality_stats->set_total_requests_in_progress(rq_active);
-          locality_stats->set_total_issued_requests(rq_issued);
-          for (const auto& metric : load_metrics) {
-            auto* load_metric_stats = locality_stats->add_load_metric_stats();
-            load_metric_stats->set_metric_name(metric.first);
-            load_metric_stats->set_num_requests_finished_with_metric(
-                metric.second.num_requests_with_metric);
-            load_metric_stats->set_total_metric_value(metric.second.total_metric_value);
+          locality_stats->mutable_locality()->MergeFrom(locality);
+          locality_stats->set_priority(priority);
+          locality_stats->set_total_successful_requests(latched.rq_success_);
+          locality_stats->set_total_error_requests(latched.rq_error_);
+          locality_stats->set_total_requests_in_progress(latched.rq_active_);
+          locality_stats->set_total_issued_requests(latched.rq_total_);
+          if (latched.load_metrics_ != nullptr) {
+            for (const auto& metric : *latched.load_metrics_) {
+              auto* load_metric_stats = locality_stats->add_load_metric_stats();
+              load_metric_stats->set_metric_name(metric.first);
+              load_metric_stats->set_num_requests_finished_with_metric(
+                  metric.second.num_requests_with_metric);
+              load_metric_stats->set_total_metric_value(metric.second.total_metric_value);
+            }
           }
-        }
-      }
-    }
+        });
     cluster_stats->set_total_dropped_requests(
         cluster.info()->loadReportStats().upstream_rq_dropped_.latch());
     const uint64_t drop_overload_count =
@@ -198,7 +176,7 @@ void LoadStatsReporter::startLoadReportPeriod() {
     }
   }
   clusters_.clear();
-  // Reset stats for all hosts in clusters we are tracking.
+  // Reset the load stats of the clusters we start tracking.
   auto handle_cluster_func = [this, &existing_clusters,
                               &all_clusters](const std::string& cluster_name) {
     auto existing_cluster_it = existing_clusters.find(cluster_name);
@@ -214,13 +192,10 @@ void LoadStatsReporter::startLoadReportPeriod() {
       return;
     }
     auto& cluster = it->second.get();
-    for (auto& host_set : cluster.prioritySet().hostSetsPerPriority()) {
-      for (const auto& host : host_set->hosts()) {
-        host->stats().rq_success_.latch();
-        host->stats().rq_error_.latch();
-        host->stats().rq_total_.latch();
-      }
-    }
+    cluster.info()->localityLoadStats().forEach(
+        [](const envoy::config::core::v3::Locality&, uint32_t, LocalityLoadStats& stats) {
+          stats.latch();
+        });
     cluster.info()->loadReportStats().upstream_rq_dropped_.latch();
     cluster.info()->loadReportStats().upstream_rq_drop_overload_.latch();
   };
@@ -15,22 +15,52 @@
 #include "source/common/common/assert.h"
 #include "source/common/common/enum_to_int.h"
 #include "source/common/common/fmt.h"
+#include "source/common/common/lock_guard.h"
+#include "source/common/common/macros.h"
 #include "source/common/common/utility.h"
 #include "source/common/http/codes.h"
 #include "source/common/protobuf/utility.h"
+#include "source/common/runtime/runtime_key_index.h"
 
 namespace Envoy {
 namespace Upstream {
 namespace Outlier {
 
+namespace {
+
+// Counts the results put on the thread, to only sample one in sampling_ratio of them. The count
+// is shared by the hosts of all the clusters, which leaves the workers without any shared write
+// for the results which are not sampled.
+bool sampleResult(uint32_t sampling_ratio) {
+  if (sampling_ratio <= 1) {
+    return true;
+  }
+  static thread_local uint32_t results = 0;
+  return ++results % sampling_ratio == 0;
+}
+
+// The runtime keys read for each failure, which are looked up by their index.
+const Runtime::IndexedKey& consecutive5xxKey() {
+  CONSTRUCT_ON_FIRST_USE(Runtime::IndexedKey, Consecutive5xxRuntime);
+}
+const Runtime::IndexedKey& consecutiveGatewayFailureKey() {
+  CONSTRUCT_ON_FIRST_USE(Runtime::IndexedKey, ConsecutiveGatewayFailureRuntime);
+}
+const Runtime::IndexedKey& consecutiveLocalOriginFailureKey() {
+  CONSTRUCT_ON_FIRST_USE(Runtime::IndexedKey, ConsecutiveLocalOriginFailureRuntime);
+}
+
+} // namespace
+
 absl::StatusOr<DetectorSharedPtr> DetectorImplFactory::createForCluster(
     Cluster& cluster, const envoy::config::cluster::v3::Cluster& cluster_config,
     Event::Dispatcher& dispatcher, Runtime::Loader& runtime, EventLoggerSharedPtr event_logger,
-    Random::RandomGenerator& random) {
+    Random::RandomGenerator& random, Thread::ThreadFactory& thread_factory) {
   if (cluster_config.has_outlier_detection()) {
 
     return DetectorImpl::create(cluster, cluster_config.outlier_detection(), dispatcher, runtime,
-                                dispatcher.timeSource(), std::move(event_logger), random);
+                                dispatcher.timeSource(), std::move(event_logger), random,
+                                thread_factory);
   } else {
     return nullptr;
   }
@@ -41,7 +71,8 @@ DetectorHostMonitorImpl::DetectorHostMonitorImpl(std::shared_ptr<DetectorImpl> d
     : detector_(detector), host_(host),
       // add Success Rate monitors
       external_origin_sr_monitor_(envoy::data::cluster::v3::SUCCESS_RATE),
-      local_origin_sr_monitor_(envoy::data::cluster::v3::SUCCESS_RATE_LOCAL_ORIGIN) {
+      local_origin_sr_monitor_(envoy::data::cluster::v3::SUCCESS_RATE_LOCAL_ORIGIN),
+      success_rate_sampling_ratio_(detector->config().successRateSamplingRatio()) {
   // Setup method to call when putResult is invoked. Depending on the config's
   // split_external_local_origin_errors_ boolean value different method is called.
   put_result_func_ = detector->config().splitExternalLocalOriginErrors()
@@ -65,8 +96,15 @@ void DetectorHostMonitorImpl::updateCurrentSuccessRateBucket() {
   local_origin_sr_monitor_.updateCurrentSuccessRateBucket();
 }
 
+bool DetectorHostMonitorImpl::sampleSuccessRate() const {
+  return sampleResult(success_rate_sampling_ratio_);
+}
+
 void DetectorHostMonitorImpl::putHttpResponseCode(uint64_t response_code) {
-  external_origin_sr_monitor_.incTotalReqCounter();
+  const bool sampled = sampleSuccessRate();
+  if (sampled) {
+    external_origin_sr_monitor_.incTotalReqCounter();
+  }
   if (Http::CodeUtility::is5xx(response_code)) {
     std::shared_ptr<DetectorImpl> detector = detector_.lock();
     if (!detector) {
@@ -75,20 +113,23 @@ void DetectorHostMonitorImpl::putHttpResponseCode(uint64_t response_code) {
     }
     if (Http::CodeUtility::isGatewayError(response_code)) {
       if (++consecutive_gateway_failure_ ==
-          detector->runtime().snapshot().getInteger(
-              ConsecutiveGatewayFailureRuntime, detector->config().consecutiveGatewayFailure())) {
+          consecutiveGatewayFailureKey().getInteger(
+              detector->runtime().snapshot(), detector->config().consecutiveGatewayFailure())) {
         detector->onConsecutiveGatewayFailure(host_.lock());
       }
     } else {
       consecutive_gateway_failure_ = 0;
     }
 
-    if (++consecutive_5xx_ == detector->runtime().snapshot().getInteger(
-                                  Consecutive5xxRuntime, detector->config().consecutive5xx())) {
+    if (++consecutive_5xx_ ==
+        consecutive5xxKey().getInteger(detector->runtime().snapshot(),
+                                       detector->config().consecutive5xx())) {
       detector->onConsecutive5xx(host_.lock());
     }
   } else {
-    external_origin_sr_monitor_.incSuccessReqCounter();
+    if (sampled) {
+      external_origin_sr_monitor_.incSuccessReqCounter();
+    }
     consecutive_5xx_ = 0;
     consecutive_gateway_failure_ = 0;
   }
@@ -185,11 +226,12 @@ void DetectorHostMonitorImpl::localOriginFailure() {
     // It's possible for the cluster/detector to go away while we still have a host in use.
     return;
   }
-  local_origin_sr_monitor_.incTotalReqCounter();
+  if (sampleSuccessRate()) {
+    local_origin_sr_monitor_.incTotalReqCounter();
+  }
   if (++consecutive_local_origin_failure_ ==
-      detector->runtime().snapshot().getInteger(
-          ConsecutiveLocalOriginFailureRuntime,
-          detector->config().consecutiveLocalOriginFailure())) {
+      consecutiveLocalOriginFailureKey().getInteger(
+          detector->runtime().snapshot(), detector->config().consecutiveLocalOriginFailure())) {
     detector->onConsecutiveLocalOriginFailure(host_.lock());
   }
 }
@@ -201,8 +243,10 @@ void DetectorHostMonitorImpl::localOriginNoFailure() {
     return;
   }
 
-  local_origin_sr_monitor_.incTotalReqCounter();
-  local_origin_sr_monitor_.incSuccessReqCounter();
+  if (sampleSuccessRate()) {
+    local_origin_sr_monitor_.incTotalReqCounter();
+    local_origin_sr_monitor_.incSuccessReqCounter();
+  }
 
   resetConsecutiveLocalOriginFailure();
 }
@@ -259,7 +303,10 @@ DetectorConfig::DetectorConfig(const envoy::config::cluster::v3::OutlierDetectio
       max_ejection_time_jitter_ms_(static_cast<uint64_t>(PROTOBUF_GET_MS_OR_DEFAULT(
           config, max_ejection_time_jitter, DEFAULT_MAX_EJECTION_TIME_JITTER_MS))),
       successful_active_health_check_uneject_host_(PROTOBUF_GET_WRAPPED_OR_DEFAULT(
-          config, successful_active_health_check_uneject_host, true)) {}
+          config, successful_active_health_check_uneject_host, true)),
+      background_success_rate_(config.has_background_success_rate()),
+      success_rate_sampling_ratio_(
+          PROTOBUF_GET_WRAPPED_OR_DEFAULT(config.background_success_rate(), sampling_ratio, 1)) {}
 
 DetectorImpl::DetectorImpl(const Cluster& cluster,
                            const envoy::config::cluster::v3::OutlierDetection& config,
@@ -276,6 +323,15 @@ DetectorImpl::DetectorImpl(const Cluster& cluster,
 }
 
 DetectorImpl::~DetectorImpl() {
+  if (background_thread_ != nullptr) {
+    {
+      Thread::LockGuard lock(background_lock_);
+      background_thread_exit_ = true;
+      background_event_.notifyOne();
+    }
+    background_thread_->join();
+  }
+
   for (const auto& host : host_monitors_) {
     if (host.first->healthFlagGet(Host::HealthFlag::FAILED_OUTLIER_CHECK)) {
       ASSERT(ejections_active_helper_.value() > 0);
@@ -288,7 +344,8 @@ absl::StatusOr<std::shared_ptr<DetectorImpl>>
 DetectorImpl::create(Cluster& cluster, const envoy::config::cluster::v3::OutlierDetection& config,
                      Event::Dispatcher& dispatcher, Runtime::Loader& runtime,
                      TimeSource& time_source, EventLoggerSharedPtr event_logger,
-                     Random::RandomGenerator& random) {
+                     Random::RandomGenerator& random,
+                     OptRef<Thread::ThreadFactory> thread_factory) {
   std::shared_ptr<DetectorImpl> detector(
       new DetectorImpl(cluster, config, dispatcher, runtime, time_source, event_logger, random));
 
@@ -296,6 +353,14 @@ DetectorImpl::create(Cluster& cluster, const envoy::config::cluster::v3::Outlier
     return absl::InvalidArgumentError(
         "outlier detector's max_ejection_time cannot be smaller than base_ejection_time");
   }
+  // Without a thread factory, the ejections are computed on the main thread as usual, only the
+  // sampling of the results still applies.
+  if (detector->config().backgroundSuccessRate() && thread_factory.has_value()) {
+    DetectorImpl* raw_detector = detector.get();
+    detector->background_thread_ = thread_factory->createThread(
+        [raw_detector]() -> void { raw_detector->backgroundThreadFunc(); },
+        Thread::Options{"outlier_detect"});
+  }
   detector->initialize(cluster);
 
   return detector;
@@ -643,32 +708,40 @@ DetectorImpl::EjectionPair DetectorImpl::successRateEjectionThreshold(
 
 void DetectorImpl::processSuccessRateEjections(
     DetectorHostMonitor::SuccessRateMonitorType monitor_type) {
-  uint64_t success_rate_minimum_hosts = runtime_.snapshot().getInteger(
-      SuccessRateMinimumHostsRuntime, config_.successRateMinimumHosts());
-  uint64_t success_rate_request_volume = runtime_.snapshot().getInteger(
-      SuccessRateRequestVolumeRuntime, config_.successRateRequestVolume());
-  uint64_t failure_percentage_minimum_hosts = runtime_.snapshot().getInteger(
-      FailurePercentageMinimumHostsRuntime, config_.failurePercentageMinimumHosts());
-  uint64_t failure_percentage_request_volume = runtime_.snapshot().getInteger(
-      FailurePercentageRequestVolumeRuntime, config_.failurePercentageRequestVolume());
-
-  std::vector<HostSuccessRatePair> valid_success_rate_hosts;
-  std::vector<HostSuccessRatePair> valid_failure_percentage_hosts;
-  double success_rate_sum = 0;
+  const SuccessRateEjectionParams params = successRateEjectionParams();
+  applySuccessRateEjections(
+      monitor_type, computeSuccessRateEjections(monitor_type, params,
+                                                collectSuccessRateSamples(monitor_type, params)));
+}
 
-  // Reset the Detector's success rate mean and stdev.
-  getSRNums(monitor_type) = {-1, -1};
+DetectorImpl::SuccessRateEjectionParams DetectorImpl::successRateEjectionParams() const {
+  return {runtime_.snapshot().getInteger(SuccessRateMinimumHostsRuntime,
+                                         config_.successRateMinimumHosts()),
+          runtime_.snapshot().getInteger(SuccessRateRequestVolumeRuntime,
+                                         config_.successRateRequestVolume()),
+          runtime_.snapshot().getInteger(SuccessRateStdevFactorRuntime,
+                                         config_.successRateStdevFactor()) /
+              1000.0,
+          runtime_.snapshot().getInteger(FailurePercentageMinimumHostsRuntime,
+                                         config_.failurePercentageMinimumHosts()),
+          runtime_.snapshot().getInteger(FailurePercentageRequestVolumeRuntime,
+                                         config_.failurePercentageRequestVolume()),
+          static_cast<double>(runtime_.snapshot().getInteger(
+              FailurePercentageThresholdRuntime, config_.failurePercentageThreshold()))};
+}
 
+std::vector<HostSuccessRateSample>
+DetectorImpl::collectSuccessRateSamples(DetectorHostMonitor::SuccessRateMonitorType monitor_type,
+                                        const SuccessRateEjectionParams& params) const {
+  std::vector<HostSuccessRateSample> samples;
   // Exit early if there are not enough hosts.
-  if (host_monitors_.size() < success_rate_minimum_hosts &&
-      host_monitors_.size() < failure_percentage_minimum_hosts) {
-    return;
+  if (host_monitors_.size() < params.success_rate_minimum_hosts_ &&
+      host_monitors_.size() < params.failure_percentage_minimum_hosts_) {
+    return samples;
   }
 
   // reserve upper bound of vector size to avoid reallocation.
-  valid_success_rate_hosts.reserve(host_monitors_.size());
-  valid_failure_percentage_hosts.reserve(host_monitors_.size());
-
+  samples.reserve(host_monitors_.size());
   for (const auto& host : host_monitors_) {
     // Don't do work if the host is already ejected.
     if (!host.first->healthFlagGet(Host::HealthFlag::FAILED_OUTLIER_CHECK)) {
@@ -680,65 +753,157 @@ void DetectorImpl::processSuccessRateEjections(
       if (!host_success_rate_and_volume) {
         continue;
       }
-      double success_rate = host_success_rate_and_volume.value().first;
-      double request_volume = host_success_rate_and_volume.value().second;
+      // The accumulators only count one in the sampling ratio results.
+      samples.push_back({host.first, host_success_rate_and_volume.value().first,
+                         host_success_rate_and_volume.value().second *
+                             config_.successRateSamplingRatio()});
+    }
+  }
+  return samples;
+}
 
-      if (request_volume >=
-          std::min(success_rate_request_volume, failure_percentage_request_volume)) {
-        host.second->successRate(monitor_type, success_rate);
-      }
+DetectorImpl::SuccessRateEjections
+DetectorImpl::computeSuccessRateEjections(DetectorHostMonitor::SuccessRateMonitorType monitor_type,
+                                          const SuccessRateEjectionParams& params,
+                                          const std::vector<HostSuccessRateSample>& samples) {
+  SuccessRateEjections ejections;
+  std::vector<HostSuccessRatePair> valid_success_rate_hosts;
+  std::vector<HostSuccessRatePair> valid_failure_percentage_hosts;
+  double success_rate_sum = 0;
 
-      if (request_volume >= success_rate_request_volume) {
-        valid_success_rate_hosts.emplace_back(HostSuccessRatePair(host.first, success_rate));
-        success_rate_sum += success_rate;
-      }
-      if (request_volume >= failure_percentage_request_volume) {
-        valid_failure_percentage_hosts.emplace_back(HostSuccessRatePair(host.first, success_rate));
-      }
+  // reserve upper bound of vector size to avoid reallocation.
+  valid_success_rate_hosts.reserve(samples.size());
+  valid_failure_percentage_hosts.reserve(samples.size());
+
+  for (const HostSuccessRateSample& sample : samples) {
+    if (sample.request_volume_ >= std::min(params.success_rate_request_volume_,
+                                           params.failure_percentage_request_volume_)) {
+      ejections.host_success_rates_.emplace_back(sample.host_, sample.success_rate_);
+    }
+
+    if (sample.request_volume_ >= params.success_rate_request_volume_) {
+      valid_success_rate_hosts.emplace_back(sample.host_, sample.success_rate_);
+      success_rate_sum += sample.success_rate_;
+    }
+    if (sample.request_volume_ >= params.failure_percentage_request_volume_) {
+      valid_failure_percentage_hosts.emplace_back(sample.host_, sample.success_rate_);
     }
   }
 
   if (!valid_success_rate_hosts.empty() &&
-      valid_success_rate_hosts.size() >= success_rate_minimum_hosts) {
-    const double success_rate_stdev_factor =
-        runtime_.snapshot().getInteger(SuccessRateStdevFactorRuntime,
-                                       config_.successRateStdevFactor()) /
-        1000.0;
-    getSRNums(monitor_type) = successRateEjectionThreshold(
-        success_rate_sum, valid_success_rate_hosts, success_rate_stdev_factor);
-    const double success_rate_ejection_threshold = getSRNums(monitor_type).ejection_threshold_;
+      valid_success_rate_hosts.size() >= params.success_rate_minimum_hosts_) {
+    ejections.success_rate_nums_ = successRateEjectionThreshold(
+        success_rate_sum, valid_success_rate_hosts, params.success_rate_stdev_factor_);
+    const double success_rate_ejection_threshold = ejections.success_rate_nums_.ejection_threshold_;
+    const envoy::data::cluster::v3::OutlierEjectionType type =
+        (monitor_type == DetectorHostMonitor::SuccessRateMonitorType::ExternalOrigin)
+            ? envoy::data::cluster::v3::SUCCESS_RATE
+            : envoy::data::cluster::v3::SUCCESS_RATE_LOCAL_ORIGIN;
     for (const auto& host_success_rate_pair : valid_success_rate_hosts) {
       if (host_success_rate_pair.success_rate_ < success_rate_ejection_threshold) {
-        stats_.ejections_success_rate_.inc(); // Deprecated.
-        const envoy::data::cluster::v3::OutlierEjectionType type =
-            host_monitors_[host_success_rate_pair.host_]
-                ->getSRMonitor(monitor_type)
-                .getEjectionType();
-        updateDetectedEjectionStats(type);
-        ejectHost(host_success_rate_pair.host_, type);
+        ejections.ejections_.emplace_back(host_success_rate_pair.host_, type);
       }
     }
   }
 
   if (!valid_failure_percentage_hosts.empty() &&
-      valid_failure_percentage_hosts.size() >= failure_percentage_minimum_hosts) {
-    const double failure_percentage_threshold = runtime_.snapshot().getInteger(
-        FailurePercentageThresholdRuntime, config_.failurePercentageThreshold());
-
+      valid_failure_percentage_hosts.size() >= params.failure_percentage_minimum_hosts_) {
+    // The ejection type returned by the SuccessRateMonitor's getEjectionType() will be a
+    // SUCCESS_RATE type, so we need to figure it out for ourselves.
+    const envoy::data::cluster::v3::OutlierEjectionType type =
+        (monitor_type == DetectorHostMonitor::SuccessRateMonitorType::ExternalOrigin)
+            ? envoy::data::cluster::v3::FAILURE_PERCENTAGE
+            : envoy::data::cluster::v3::FAILURE_PERCENTAGE_LOCAL_ORIGIN;
     for (const auto& host_success_rate_pair : valid_failure_percentage_hosts) {
-      if ((100.0 - host_success_rate_pair.success_rate_) >= failure_percentage_threshold) {
+      if ((100.0 - host_success_rate_pair.success_rate_) >= params.failure_percentage_threshold_) {
         // We should eject.
+        ejections.ejections_.emplace_back(host_success_rate_pair.host_, type);
+      }
+    }
+  }
+  return ejections;
+}
+
+void DetectorImpl::applySuccessRateEjections(
+    DetectorHostMonitor::SuccessRateMonitorType monitor_type,
+    const SuccessRateEjections& ejections) {
+  for (const HostSuccessRatePair& host_success_rate : ejections.host_success_rates_) {
+    auto host_monitor = host_monitors_.find(host_success_rate.host_);
+    // When computed in the background, the host may have been removed in the meantime.
+    if (host_monitor != host_monitors_.end()) {
+      host_monitor->second->successRate(monitor_type, host_success_rate.success_rate_);
+    }
+  }
+  getSRNums(monitor_type) = ejections.success_rate_nums_;
+
+  for (const auto& [host, type] : ejections.ejections_) {
+    if (background_thread_ != nullptr &&
+        (host_monitors_.count(host) == 0 ||
+         host->healthFlagGet(Host::HealthFlag::FAILED_OUTLIER_CHECK))) {
+      // The host was removed or ejected while the ejections were computed in the background.
+      continue;
+    }
+    if (type == envoy::data::cluster::v3::SUCCESS_RATE ||
+        type == envoy::data::cluster::v3::SUCCESS_RATE_LOCAL_ORIGIN) {
+      stats_.ejections_success_rate_.inc(); // Deprecated.
+    }
+    updateDetectedEjectionStats(type);
+    ejectHost(host, type);
+  }
+}
 
-        // The ejection type returned by the SuccessRateMonitor's getEjectionType() will be a
-        // SUCCESS_RATE type, so we need to figure it out for ourselves.
-        const envoy::data::cluster::v3::OutlierEjectionType type =
-            (monitor_type == DetectorHostMonitor::SuccessRateMonitorType::ExternalOrigin)
-                ? envoy::data::cluster::v3::FAILURE_PERCENTAGE
-                : envoy::data::cluster::v3::FAILURE_PERCENTAGE_LOCAL_ORIGIN;
-        updateDetectedEjectionStats(type);
-        ejectHost(host_success_rate_pair.host_, type);
+void DetectorImpl::postSuccessRateEjectionsToBackgroundThread() {
+  auto computation = std::make_unique<BackgroundSuccessRateComputation>();
+  computation->detector_ = weak_from_this();
+  computation->params_ = successRateEjectionParams();
+  computation->external_origin_samples_ = collectSuccessRateSamples(
+      DetectorHostMonitor::SuccessRateMonitorType::ExternalOrigin, computation->params_);
+  computation->local_origin_samples_ = collectSuccessRateSamples(
+      DetectorHostMonitor::SuccessRateMonitorType::LocalOrigin, computation->params_);
+
+  Thread::LockGuard lock(background_lock_);
+  // A computation the thread hasn't started yet is dropped here, on the main thread.
+  background_computation_ = std::move(computation);
+  background_event_.notifyOne();
+}
+
+void DetectorImpl::backgroundThreadFunc() {
+  while (true) {
+    std::unique_ptr<BackgroundSuccessRateComputation> computation;
+    {
+      Thread::LockGuard lock(background_lock_);
+      while (background_computation_ == nullptr && !background_thread_exit_) {
+        // CondVar::wait() does not throw, so it's safe to pass the mutex rather than the guard.
+        background_event_.wait(background_lock_);
       }
+      if (background_thread_exit_) {
+        return;
+      }
+      computation = std::move(background_computation_);
     }
+    computation->external_origin_ejections_ =
+        computeSuccessRateEjections(DetectorHostMonitor::SuccessRateMonitorType::ExternalOrigin,
+                                    computation->params_, computation->external_origin_samples_);
+    computation->local_origin_ejections_ =
+        computeSuccessRateEjections(DetectorHostMonitor::SuccessRateMonitorType::LocalOrigin,
+                                    computation->params_, computation->local_origin_samples_);
+
+    // The computation is moved into the posted callback rather than released here, so the last
+    // reference to a host removed in the meantime is dropped on the main thread. The detector
+    // joins the thread before it is destroyed, so only the posted callback needs to check
+    // whether it is still alive.
+    dispatcher_.post([computation = std::move(computation)]() {
+      std::shared_ptr<DetectorImpl> detector = computation->detector_.lock();
+      if (!detector) {
+        return;
+      }
+      detector->applySuccessRateEjections(
+          DetectorHostMonitor::SuccessRateMonitorType::ExternalOrigin,
+          computation->external_origin_ejections_);
+      detector->applySuccessRateEjections(DetectorHostMonitor::SuccessRateMonitorType::LocalOrigin,
+                                          computation->local_origin_ejections_);
+      detector->decrementEjectTimeBackoff(detector->time_source_.monotonicTime());
+    });
   }
 }
 
@@ -756,9 +921,21 @@ void DetectorImpl::onIntervalTimer() {
     host.second->successRate(DetectorHostMonitor::SuccessRateMonitorType::ExternalOrigin, -1);
   }
 
+  if (background_thread_ != nullptr) {
+    // The eject time backoffs are decremented once the ejections are applied.
+    postSuccessRateEjectionsToBackgroundThread();
+    armIntervalTimer();
+    return;
+  }
+
   processSuccessRateEjections(DetectorHostMonitor::SuccessRateMonitorType::ExternalOrigin);
   processSuccessRateEjections(DetectorHostMonitor::SuccessRateMonitorType::LocalOrigin);
+  decrementEjectTimeBackoff(now);
+
+  armIntervalTimer();
+}
 
+void DetectorImpl::decrementEjectTimeBackoff(MonotonicTime now) {
   // Decrement time backoff for all hosts which have not been ejected.
   for (auto host : host_monitors_) {
     if (!host.first->healthFlagGet(Host::HealthFlag::FAILED_OUTLIER_CHECK)) {
@@ -774,8 +951,6 @@ void DetectorImpl::onIntervalTimer() {
       }
     }
   }
-
-  armIntervalTimer();
 }
 
 void DetectorImpl::runCallbacks(HostSharedPtr host) {
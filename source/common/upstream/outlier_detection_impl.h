@@ -3,6 +3,7 @@
 #include <atomic>
 #include <chrono>
 #include <cstdint>
+#include <functional>
 #include <list>
 #include <memory>
 #include <string>
@@ -10,6 +11,7 @@
 
 #include "envoy/access_log/access_log.h"
 #include "envoy/common/callback.h"
+#include "envoy/common/optref.h"
 #include "envoy/common/time.h"
 #include "envoy/config/cluster/v3/cluster.pb.h"
 #include "envoy/config/cluster/v3/outlier_detection.pb.h"
@@ -19,8 +21,10 @@
 #include "envoy/runtime/runtime.h"
 #include "envoy/stats/scope.h"
 #include "envoy/stats/stats.h"
+#include "envoy/thread/thread.h"
 #include "envoy/upstream/outlier_detection.h"
 
+#include "source/common/common/thread.h"
 #include "source/common/upstream/upstream_impl.h"
 
 #include "absl/container/node_hash_map.h"
@@ -37,7 +41,8 @@ public:
   static absl::StatusOr<DetectorSharedPtr>
   createForCluster(Cluster& cluster, const envoy::config::cluster::v3::Cluster& cluster_config,
                    Event::Dispatcher& dispatcher, Runtime::Loader& runtime,
-                   EventLoggerSharedPtr event_logger, Random::RandomGenerator& random);
+                   EventLoggerSharedPtr event_logger, Random::RandomGenerator& random,
+                   Thread::ThreadFactory& thread_factory);
 };
 
 /**
@@ -50,6 +55,16 @@ struct HostSuccessRatePair {
   double success_rate_;
 };
 
+/**
+ * The success rate of a host over the last interval, with the number of requests it is computed
+ * from.
+ */
+struct HostSuccessRateSample {
+  HostSharedPtr host_;
+  double success_rate_;
+  uint64_t request_volume_;
+};
+
 struct SuccessRateAccumulatorBucket {
   std::atomic<uint64_t> success_request_counter_;
   std::atomic<uint64_t> total_request_counter_;
@@ -131,6 +146,8 @@ public:
   void resetConsecutive5xx() { consecutive_5xx_ = 0; }
   void resetConsecutiveGatewayFailure() { consecutive_gateway_failure_ = 0; }
   void resetConsecutiveLocalOriginFailure() { consecutive_local_origin_failure_ = 0; }
+  // Whether the result being put is counted by the success rate monitors.
+  bool sampleSuccessRate() const;
   static absl::optional<Http::Code> resultToHttpCode(Result result);
 
   // Upstream::Outlier::DetectorHostMonitor
@@ -200,6 +217,8 @@ private:
   //   not used when external/local events are not split.
   SuccessRateMonitor external_origin_sr_monitor_;
   SuccessRateMonitor local_origin_sr_monitor_;
+  // The success rate monitors only count one in this many results.
+  const uint32_t success_rate_sampling_ratio_;
 
   void putResultNoLocalExternalSplit(Result result, absl::optional<uint64_t> code);
   void putResultWithLocalExternalSplit(Result result, absl::optional<uint64_t> code);
@@ -316,6 +335,8 @@ public:
   bool successfulActiveHealthCheckUnejectHost() const {
     return successful_active_health_check_uneject_host_;
   }
+  bool backgroundSuccessRate() const { return background_success_rate_; }
+  uint32_t successRateSamplingRatio() const { return success_rate_sampling_ratio_; }
 
 private:
   const uint64_t interval_ms_;
@@ -341,6 +362,8 @@ private:
   const uint64_t max_ejection_time_ms_;
   const uint64_t max_ejection_time_jitter_ms_;
   const bool successful_active_health_check_uneject_host_;
+  const bool background_success_rate_;
+  const uint32_t success_rate_sampling_ratio_;
 
   static constexpr uint64_t DEFAULT_INTERVAL_MS = 10000;
   static constexpr uint64_t DEFAULT_BASE_EJECTION_TIME_MS = 30000;
@@ -375,7 +398,8 @@ public:
   static absl::StatusOr<std::shared_ptr<DetectorImpl>>
   create(Cluster& cluster, const envoy::config::cluster::v3::OutlierDetection& config,
          Event::Dispatcher& dispatcher, Runtime::Loader& runtime, TimeSource& time_source,
-         EventLoggerSharedPtr event_logger, Random::RandomGenerator& random);
+         EventLoggerSharedPtr event_logger, Random::RandomGenerator& random,
+         OptRef<Thread::ThreadFactory> thread_factory = {});
   ~DetectorImpl() override;
 
   void onConsecutive5xx(HostSharedPtr host);
@@ -423,6 +447,36 @@ private:
                Event::Dispatcher& dispatcher, Runtime::Loader& runtime, TimeSource& time_source,
                EventLoggerSharedPtr event_logger, Random::RandomGenerator& random);
 
+  // The parameters of the success rate and failure percentage ejections, read from the runtime on
+  // the main thread.
+  struct SuccessRateEjectionParams {
+    uint64_t success_rate_minimum_hosts_;
+    uint64_t success_rate_request_volume_;
+    double success_rate_stdev_factor_;
+    uint64_t failure_percentage_minimum_hosts_;
+    uint64_t failure_percentage_request_volume_;
+    double failure_percentage_threshold_;
+  };
+  // The outcome of the success rate and failure percentage ejections of an interval.
+  struct SuccessRateEjections {
+    EjectionPair success_rate_nums_{-1, -1};
+    // The hosts with enough requests for their success rate to be reported.
+    std::vector<HostSuccessRatePair> host_success_rates_;
+    // The hosts to eject, in order.
+    std::vector<std::pair<HostSharedPtr, envoy::data::cluster::v3::OutlierEjectionType>>
+        ejections_;
+  };
+  // The samples of an interval and the ejections computed from them on the background thread. It
+  // holds references to the hosts, so it is only ever released on the main thread.
+  struct BackgroundSuccessRateComputation {
+    std::weak_ptr<DetectorImpl> detector_;
+    SuccessRateEjectionParams params_;
+    std::vector<HostSuccessRateSample> external_origin_samples_;
+    std::vector<HostSuccessRateSample> local_origin_samples_;
+    SuccessRateEjections external_origin_ejections_;
+    SuccessRateEjections local_origin_ejections_;
+  };
+
   void addHostMonitor(HostSharedPtr host);
   void armIntervalTimer();
   void checkHostForUneject(HostSharedPtr host, DetectorHostMonitorImpl* monitor, MonotonicTime now);
@@ -439,6 +493,19 @@ private:
   void updateEnforcedEjectionStats(envoy::data::cluster::v3::OutlierEjectionType type);
   void updateDetectedEjectionStats(envoy::data::cluster::v3::OutlierEjectionType type);
   void processSuccessRateEjections(DetectorHostMonitor::SuccessRateMonitorType monitor_type);
+  SuccessRateEjectionParams successRateEjectionParams() const;
+  std::vector<HostSuccessRateSample>
+  collectSuccessRateSamples(DetectorHostMonitor::SuccessRateMonitorType monitor_type,
+                            const SuccessRateEjectionParams& params) const;
+  static SuccessRateEjections
+  computeSuccessRateEjections(DetectorHostMonitor::SuccessRateMonitorType monitor_type,
+                              const SuccessRateEjectionParams& params,
+                              const std::vector<HostSuccessRateSample>& samples);
+  void applySuccessRateEjections(DetectorHostMonitor::SuccessRateMonitorType monitor_type,
+                                 const SuccessRateEjections& ejections);
+  void postSuccessRateEjectionsToBackgroundThread();
+  void backgroundThreadFunc();
+  void decrementEjectTimeBackoff(MonotonicTime now);
 
   // The helper to double write value and gauge. The gauge could be null value since because any
   // stat might be deactivated.
@@ -478,6 +545,16 @@ private:
   EjectionPair external_origin_sr_num_;
   EjectionPair local_origin_sr_num_;
 
+  // The thread computing the success rate and failure percentage ejections, when they are
+  // computed in the background. Only the computation of the last interval is kept when the
+  // thread falls behind.
+  Thread::ThreadPtr background_thread_;
+  Thread::MutexBasicLockable background_lock_;
+  Thread::CondVar background_event_;
+  std::unique_ptr<BackgroundSuccessRateComputation>
+      background_computation_ ABSL_GUARDED_BY(background_lock_);
+  bool background_thread_exit_ ABSL_GUARDED_BY(background_lock_){false};
+
   const EjectionPair& getSRNums(DetectorHostMonitor::SuccessRateMonitorType monitor_type) const {
     return (DetectorHostMonitor::SuccessRateMonitorType::ExternalOrigin == monitor_type)
                ? external_origin_sr_num_
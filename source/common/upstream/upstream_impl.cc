@@ -411,6 +411,69 @@ LoadMetricStats::StatMapPtr LoadMetricStatsImpl::latch() {
   return latched;
 }
 
+LocalityLoadStatsImpl::Shard& LocalityLoadStatsImpl::shard() {
+  // The threads take the shards in turn, so that the workers get distinct ones.
+  static std::atomic<size_t> next_shard{0};
+  static thread_local const size_t index = next_shard.fetch_add(1, std::memory_order_relaxed);
+  return shards_[index % Shards];
+}
+
+LocalityLoadStats::Latched LocalityLoadStatsImpl::latch() {
+  Latched latched;
+  for (Shard& shard_stats : shards_) {
+    latched.rq_success_ += shard_stats.rq_success_.exchange(0, std::memory_order_relaxed);
+    latched.rq_error_ += shard_stats.rq_error_.exchange(0, std::memory_order_relaxed);
+    latched.rq_total_ += shard_stats.rq_total_.exchange(0, std::memory_order_relaxed);
+    latched.rq_active_ += shard_stats.rq_active_.load(std::memory_order_relaxed);
+  }
+  latched.load_metrics_ = load_metrics_.latch();
+  return latched;
+}
+
+LoadMetricStats::StatMapPtr LocalityLoadStatsImpl::LoadMetrics::latch() {
+  StatMapPtr latched;
+  for (Shard& shard_stats : parent_.shards_) {
+    StatMapPtr shard_metrics = shard_stats.load_metrics_.latch();
+    if (shard_metrics == nullptr) {
+      continue;
+    }
+    if (latched == nullptr) {
+      latched = std::move(shard_metrics);
+      continue;
+    }
+    for (const auto& [name, metric] : *shard_metrics) {
+      Stat& stat = (*latched)[name];
+      stat.num_requests_with_metric += metric.num_requests_with_metric;
+      stat.total_metric_value += metric.total_metric_value;
+    }
+  }
+  return latched;
+}
+
+LocalityLoadStats& LocalityLoadStatsMapImpl::get(const envoy::config::core::v3::Locality& locality,
+                                                 uint32_t priority) {
+  absl::MutexLock lock(&mu_);
+  std::vector<std::unique_ptr<LocalityLoadStatsImpl>>& stats = stats_[locality];
+  if (stats.size() <= priority) {
+    stats.resize(priority + 1);
+  }
+  if (stats[priority] == nullptr) {
+    stats[priority] = std::make_unique<LocalityLoadStatsImpl>();
+  }
+  return *stats[priority];
+}
+
+void LocalityLoadStatsMapImpl::forEach(const ForEachCb& cb) {
+  absl::MutexLock lock(&mu_);
+  for (const auto& [locality, stats] : stats_) {
+    for (uint32_t priority = 0; priority < stats.size(); ++priority) {
+      if (stats[priority] != nullptr) {
+        cb(locality, priority, *stats[priority]);
+      }
+    }
+  }
+}
+
 HostDescriptionImpl::HostDescriptionImpl(
     ClusterInfoConstSharedPtr cluster, const std::string& hostname,
     Network::Address::InstanceConstSharedPtr dest_address, MetadataConstSharedPtr endpoint_metadata,
@@ -447,6 +510,21 @@ HostDescriptionImplBase::HostDescriptionImplBase(
     throwEnvoyExceptionOrPanic(
         fmt::format("Invalid host configuration: non-zero port for non-IP address"));
   }
+  setLocalityLoadStats(priority);
+}
+
+void HostDescriptionImplBase::priority(uint32_t priority) {
+  priority_ = priority;
+  setLocalityLoadStats(priority);
+}
+
+void HostDescriptionImplBase::setLocalityLoadStats(uint32_t priority) {
+  LocalityLoadStats& stats = cluster_->localityLoadStats().get(locality_, priority);
+  stats_.rq_success_.setLocalityStat(&stats.rqSuccess());
+  stats_.rq_error_.setLocalityStat(&stats.rqError());
+  stats_.rq_total_.setLocalityStat(&stats.rqTotal());
+  stats_.rq_active_.setLocalityStat(&stats.rqActive());
+  locality_load_stats_.store(&stats, std::memory_order_release);
 }
 
 HostDescription::SharedConstAddressVector HostDescriptionImplBase::makeAddressListOrNull(
@@ -1083,6 +1161,11 @@ ClusterInfoImpl::ClusterInfoImpl(
           config.preconnect_policy(), per_upstream_preconnect_ratio, 1.0)),
       peekahead_ratio_(PROTOBUF_GET_WRAPPED_OR_DEFAULT(config.preconnect_policy(),
                                                        predictive_preconnect_ratio, 0)),
+      max_adaptive_preconnect_connections_(
+          config.preconnect_policy().has_adaptive_preconnect()
+              ? PROTOBUF_GET_WRAPPED_OR_DEFAULT(config.preconnect_policy().adaptive_preconnect(),
+                                                max_preconnected_connections, 2)
+              : 0),
       socket_matcher_(std::move(socket_matcher)), stats_scope_(std::move(stats_scope)),
       traffic_stats_(generateStats(stats_scope_,
                                    factory_context.clusterManager().clusterStatNames(),
@@ -1465,8 +1548,14 @@ ClusterImplBase::ClusterImplBase(const envoy::config::cluster::v3::Cluster& clus
                      cluster.name()),
       const_metadata_shared_pool_(Config::Metadata::getConstMetadataSharedPool(
           cluster_context.serverFactoryContext().singletonManager(),
-          cluster_context.serverFactoryContext().mainThreadDispatcher())) {
+          cluster_context.serverFactoryContext().mainThreadDispatcher())),
+      health_update_batch_window_(PROTOBUF_GET_MS_OR_DEFAULT(cluster.common_lb_config(),
+                                                             health_update_batch_window, 0)) {
   auto& server_context = cluster_context.serverFactoryContext();
+  if (health_update_batch_window_.count() > 0) {
+    health_update_batch_timer_ = server_context.mainThreadDispatcher().createTimer(
+        [this]() -> void { reloadPendingHealthyHosts(); });
+  }
 
   auto stats_scope = generateStatsScope(cluster, server_context.serverScope().store());
   transport_factory_context_ =
@@ -1768,10 +1857,30 @@ void ClusterImplBase::reloadHealthyHosts(const HostSharedPtr& host) {
     return;
   }
 
-  reloadHealthyHostsHelper(host);
+  if (host != nullptr) {
+    pending_health_updates_.push_back(host);
+  }
+  // The transitions within the batch window are applied by a single update, so that a cascade of
+  // transitions doesn't recompute the host sets and the load balancers once per host.
+  if (health_update_batch_timer_ != nullptr && host != nullptr) {
+    if (!health_update_batch_timer_->enabled()) {
+      health_update_batch_timer_->enableTimer(health_update_batch_window_);
+    }
+    return;
+  }
+  reloadPendingHealthyHosts();
+}
+
+void ClusterImplBase::reloadPendingHealthyHosts() {
+  if (health_update_batch_timer_ != nullptr) {
+    health_update_batch_timer_->disableTimer();
+  }
+  const HostVector hosts = std::move(pending_health_updates_);
+  pending_health_updates_.clear();
+  reloadHealthyHostsHelper(hosts);
 }
 
-void ClusterImplBase::reloadHealthyHostsHelper(const HostSharedPtr&) {
+void ClusterImplBase::reloadHealthyHostsHelper(const HostVector&) {
   const auto& host_sets = prioritySet().hostSetsPerPriority();
   for (size_t priority = 0; priority < host_sets.size(); ++priority) {
     const auto& host_set = host_sets[priority];
@@ -5,6 +5,7 @@
 #include <chrono>
 #include <cstdint>
 #include <functional>
+#include <limits>
 #include <list>
 #include <memory>
 #include <string>
@@ -54,6 +55,7 @@
 #include "source/common/http/http2/codec_stats.h"
 #include "source/common/http/http3/codec_stats.h"
 #include "source/common/init/manager_impl.h"
+#include "source/common/memory/accounting.h"
 #include "source/common/network/utility.h"
 #include "source/common/shared_pool/shared_pool.h"
 #include "source/common/stats/isolated_store_impl.h"
@@ -66,6 +68,8 @@
 #include "source/extensions/upstreams/tcp/config.h"
 #include "source/server/transport_socket_config_impl.h"
 
+#include "absl/base/optimization.h"
+#include "absl/container/node_hash_map.h"
 #include "absl/container/node_hash_set.h"
 #include "absl/synchronization/mutex.h"
 
@@ -119,6 +123,94 @@ private:
   StatMapPtr map_ ABSL_GUARDED_BY(mu_);
 };
 
+/**
+ * Implementation of LocalityLoadStats. The stats are sharded by thread, with a cache line per
+ * shard, so that the workers counting the requests to the hosts of a locality don't contend.
+ */
+class LocalityLoadStatsImpl : public LocalityLoadStats {
+public:
+  static constexpr size_t Shards = 8;
+
+  // LocalityLoadStats
+  LocalityLoadStat& rqSuccess() override { return rq_success_; }
+  LocalityLoadStat& rqError() override { return rq_error_; }
+  LocalityLoadStat& rqTotal() override { return rq_total_; }
+  LocalityLoadStat& rqActive() override { return rq_active_; }
+  LoadMetricStats& loadMetricStats() override { return load_metrics_; }
+  Latched latch() override;
+
+private:
+  struct ABSL_CACHELINE_ALIGNED Shard {
+    std::atomic<uint64_t> rq_success_{0};
+    std::atomic<uint64_t> rq_error_{0};
+    std::atomic<uint64_t> rq_total_{0};
+    // The requests in progress are counted modulo 2^64, as they may end on another shard.
+    std::atomic<uint64_t> rq_active_{0};
+    LoadMetricStatsImpl load_metrics_;
+  };
+
+  class ShardedStat : public LocalityLoadStat {
+  public:
+    ShardedStat(LocalityLoadStatsImpl& parent, std::atomic<uint64_t> Shard::*value)
+        : parent_(parent), value_(value) {}
+
+    // LocalityLoadStat
+    void add(uint64_t amount) override {
+      (parent_.shard().*value_).fetch_add(amount, std::memory_order_relaxed);
+    }
+    void sub(uint64_t amount) override {
+      (parent_.shard().*value_).fetch_sub(amount, std::memory_order_relaxed);
+    }
+
+  private:
+    LocalityLoadStatsImpl& parent_;
+    std::atomic<uint64_t> Shard::*const value_;
+  };
+
+  class LoadMetrics : public LoadMetricStats {
+  public:
+    explicit LoadMetrics(LocalityLoadStatsImpl& parent) : parent_(parent) {}
+
+    // LoadMetricStats
+    void add(const absl::string_view key, double value) override {
+      parent_.shard().load_metrics_.add(key, value);
+    }
+    StatMapPtr latch() override;
+
+  private:
+    LocalityLoadStatsImpl& parent_;
+  };
+
+  // Returns the shard of the current thread.
+  Shard& shard();
+
+  std::array<Shard, Shards> shards_;
+  ShardedStat rq_success_{*this, &Shard::rq_success_};
+  ShardedStat rq_error_{*this, &Shard::rq_error_};
+  ShardedStat rq_total_{*this, &Shard::rq_total_};
+  ShardedStat rq_active_{*this, &Shard::rq_active_};
+  LoadMetrics load_metrics_{*this};
+};
+
+/**
+ * Implementation of LocalityLoadStatsMap.
+ */
+class LocalityLoadStatsMapImpl : public LocalityLoadStatsMap {
+public:
+  // LocalityLoadStatsMap
+  LocalityLoadStats& get(const envoy::config::core::v3::Locality& locality,
+                         uint32_t priority) override;
+  void forEach(const ForEachCb& cb) override;
+
+private:
+  absl::Mutex mu_;
+  // The stats of each locality, indexed by priority.
+  absl::node_hash_map<envoy::config::core::v3::Locality,
+                      std::vector<std::unique_ptr<LocalityLoadStatsImpl>>, LocalityHash,
+                      LocalityEqualTo>
+      stats_ ABSL_GUARDED_BY(mu_);
+};
+
 /**
  * Null host monitor implementation.
  */
@@ -219,7 +311,9 @@ public:
     return *null_outlier_detector;
   }
   HostStats& stats() const override { return stats_; }
-  LoadMetricStats& loadMetricStats() const override { return load_metric_stats_; }
+  LoadMetricStats& loadMetricStats() const override {
+    return locality_load_stats_.load(std::memory_order_acquire)->loadMetricStats();
+  }
   const std::string& hostnameForHealthChecks() const override { return health_checks_hostname_; }
   const std::string& hostname() const override { return hostname_; }
   const envoy::config::core::v3::Locality& locality() const override { return locality_; }
@@ -227,11 +321,18 @@ public:
     return locality_zone_stat_name_.statName();
   }
   uint32_t priority() const override { return priority_; }
-  void priority(uint32_t priority) override { priority_ = priority; }
+  void priority(uint32_t priority) override;
   Network::UpstreamTransportSocketFactory&
   resolveTransportSocketFactory(const Network::Address::InstanceConstSharedPtr& dest_address,
                                 const envoy::config::core::v3::Metadata* metadata) const override;
-  absl::optional<MonotonicTime> lastHcPassTime() const override { return last_hc_pass_time_; }
+  absl::optional<MonotonicTime> lastHcPassTime() const override {
+    const int64_t last_hc_pass_time = last_hc_pass_time_.load(std::memory_order_relaxed);
+    if (last_hc_pass_time == NoHcPassTime) {
+      return absl::nullopt;
+    }
+    return MonotonicTime(std::chrono::duration_cast<MonotonicTime::duration>(
+        std::chrono::nanoseconds(last_hc_pass_time)));
+  }
 
   void setHealthChecker(HealthCheckHostMonitorPtr&& health_checker) override {
     health_checker_ = std::move(health_checker);
@@ -242,9 +343,17 @@ public:
   }
 
   void setLastHcPassTime(MonotonicTime last_hc_pass_time) override {
-    last_hc_pass_time_.emplace(std::move(last_hc_pass_time));
+    last_hc_pass_time_.store(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                 last_hc_pass_time.time_since_epoch())
+                                 .count(),
+                             std::memory_order_relaxed);
   }
 
+  void setLbPolicyData(HostLbPolicyDataPtr lb_policy_data) override {
+    lb_policy_data_ = std::move(lb_policy_data);
+  }
+  const HostLbPolicyDataPtr& lbPolicyData() const override { return lb_policy_data_; }
+
 protected:
   /**
    * @return nullptr if address_list is empty, otherwise a shared_ptr copy of address_list.
@@ -254,6 +363,9 @@ protected:
                         const AddressVector& address_list);
 
 private:
+  // Counts the next requests of the host in the load report stats of its locality and priority.
+  void setLocalityLoadStats(uint32_t priority);
+
   ClusterInfoConstSharedPtr cluster_;
   const std::string hostname_;
   const std::string health_checks_hostname_;
@@ -263,15 +375,22 @@ private:
   const MetadataConstSharedPtr locality_metadata_;
   const envoy::config::core::v3::Locality locality_;
   Stats::StatNameDynamicStorage locality_zone_stat_name_;
-  mutable HostStats stats_;
-  mutable LoadMetricStatsImpl load_metric_stats_;
+  // The stats are written by all the workers on each request to the host, and rq_active_ is read
+  // on each pick of the least request load balancer. They get cache lines of their own, so that
+  // the reads of the members around them do not contend with these writes.
+  ABSL_CACHELINE_ALIGNED mutable HostStats stats_;
+  std::atomic<LocalityLoadStats*> locality_load_stats_{nullptr};
   Outlier::DetectorHostMonitorPtr outlier_detector_;
   HealthCheckHostMonitorPtr health_checker_;
   std::atomic<uint32_t> priority_;
   std::reference_wrapper<Network::UpstreamTransportSocketFactory>
       socket_factory_ ABSL_GUARDED_BY(metadata_mutex_);
   const MonotonicTime creation_time_;
-  absl::optional<MonotonicTime> last_hc_pass_time_;
+  static constexpr int64_t NoHcPassTime = std::numeric_limits<int64_t>::min();
+  // In nanoseconds since the epoch of the monotonic clock. Atomic as it is set by the health check
+  // sessions, which may run on their own threads, and by the workers.
+  std::atomic<int64_t> last_hc_pass_time_{NoHcPassTime};
+  HostLbPolicyDataPtr lb_policy_data_;
 };
 
 /**
@@ -414,11 +533,6 @@ public:
     return std::make_unique<HostHandleImpl>(shared_from_this());
   }
 
-  void setLbPolicyData(HostLbPolicyDataPtr lb_policy_data) override {
-    lb_policy_data_ = std::move(lb_policy_data);
-  }
-  const HostLbPolicyDataPtr& lbPolicyData() const override { return lb_policy_data_; }
-
 protected:
   static CreateConnectionData
   createConnection(Event::Dispatcher& dispatcher, const ClusterInfo& cluster,
@@ -442,7 +556,6 @@ private:
   // flag access? May be we could refactor HealthFlag to contain all these statuses and flags in the
   // future.
   std::atomic<Host::HealthStatus> eds_health_status_{};
-  HostLbPolicyDataPtr lb_policy_data_;
 
   struct HostHandleImpl : HostHandle {
     HostHandleImpl(const std::shared_ptr<const HostImplBase>& parent) : parent_(parent) {
@@ -470,7 +583,10 @@ public:
            TimeSource& time_source, const AddressVector& address_list = {})
       : HostImplBase(initial_weight, health_check_config, health_status),
         HostDescriptionImpl(cluster, hostname, address, endpoint_metadata, locality_metadata,
-                            locality, health_check_config, priority, time_source, address_list) {}
+                            locality, health_check_config, priority, time_source, address_list) {
+    Memory::Accounting::charge(Memory::Subsystem::Hosts, sizeof(HostImpl));
+  }
+  ~HostImpl() override { Memory::Accounting::credit(Memory::Subsystem::Hosts, sizeof(HostImpl)); }
 };
 
 class HostsPerLocalityImpl : public HostsPerLocality {
@@ -868,6 +984,9 @@ public:
 
   float perUpstreamPreconnectRatio() const override { return per_upstream_preconnect_ratio_; }
   float peekaheadRatio() const override { return peekahead_ratio_; }
+  uint32_t maxAdaptivePreconnectConnections() const override {
+    return max_adaptive_preconnect_connections_;
+  }
   uint32_t perConnectionBufferLimitBytes() const override {
     return per_connection_buffer_limit_bytes_;
   }
@@ -933,6 +1052,7 @@ public:
   }
 
   ClusterLoadReportStats& loadReportStats() const override { return load_report_stats_; }
+  LocalityLoadStatsMap& localityLoadStats() const override { return locality_load_stats_; }
 
   ClusterTimeoutBudgetStatsOptRef timeoutBudgetStats() const override {
     if (optional_cluster_stats_ == nullptr ||
@@ -1065,6 +1185,7 @@ private:
   OptionalTimeouts optional_timeouts_;
   const float per_upstream_preconnect_ratio_;
   const float peekahead_ratio_;
+  const uint32_t max_adaptive_preconnect_connections_;
   TransportSocketMatcherPtr socket_matcher_;
   Stats::ScopeSharedPtr stats_scope_;
   mutable DeferredCreationCompatibleClusterTrafficStats traffic_stats_;
@@ -1073,6 +1194,7 @@ private:
   mutable ClusterEndpointStats endpoint_stats_;
   Stats::IsolatedStoreImpl load_report_stats_store_;
   mutable ClusterLoadReportStats load_report_stats_;
+  mutable LocalityLoadStatsMapImpl locality_load_stats_;
   const std::unique_ptr<OptionalClusterStats> optional_cluster_stats_;
   const uint64_t features_;
   mutable ResourceManagers resource_managers_;
@@ -1208,7 +1330,11 @@ protected:
    */
   void onInitDone();
 
-  virtual void reloadHealthyHostsHelper(const HostSharedPtr& host);
+  /**
+   * Updates the host sets with the current health of their hosts.
+   * @param hosts supplies the hosts whose health changed since the last update, if known.
+   */
+  virtual void reloadHealthyHostsHelper(const HostVector& hosts);
 
   absl::Status parseDropOverloadConfig(
       const envoy::config::endpoint::v3::ClusterLoadAssignment& cluster_load_assignment);
@@ -1245,6 +1371,7 @@ private:
 
   void finishInitialization();
   void reloadHealthyHosts(const HostSharedPtr& host);
+  void reloadPendingHealthyHosts();
 
   bool initialization_started_{};
   std::function<void()> initialization_complete_callback_;
@@ -1254,6 +1381,11 @@ private:
   Common::CallbackHandlePtr priority_update_cb_;
   UnitFloat drop_overload_{0};
   static constexpr int kDropOverloadSize = 1;
+  const std::chrono::milliseconds health_update_batch_window_;
+  // Only set if health_update_batch_window_ is, to apply the health transitions in a batch.
+  Event::TimerPtr health_update_batch_timer_;
+  // The hosts whose health changed since the last update of the host sets, if they are batched.
+  HostVector pending_health_updates_;
 };
 
 using ClusterImplBaseSharedPtr = std::shared_ptr<ClusterImplBase>;
@@ -150,6 +150,9 @@ private:
   virtual void addEntry(HttpLogProto&& entry) PURE;
   virtual void addEntry(TcpLogProto&& entry) PURE;
   virtual void clearMessage() { message_.Clear(); }
+  // Sends the batched message, returning false if it couldn't be sent, in which case it's kept for
+  // the next flush.
+  virtual bool sendMessage() { return client_->log(message_); }
 
   void flush() {
     if (isEmpty()) {
@@ -161,7 +164,7 @@ private:
       initMessage();
     }
 
-    if (client_->log(message_)) {
+    if (sendMessage()) {
       // Clear the message regardless of the success.
       approximate_message_size_bytes_ = 0;
       clearMessage();
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <functional>
 #include <memory>
 
 #include "envoy/config/core/v3/config_source.pb.h"
@@ -9,6 +10,7 @@
 #include "envoy/stats/scope.h"
 #include "envoy/thread_local/thread_local.h"
 
+#include "source/common/buffer/buffer_impl.h"
 #include "source/common/common/assert.h"
 #include "source/common/grpc/typed_async_client.h"
 #include "source/common/http/utility.h"
@@ -117,6 +119,27 @@ public:
   bool isConnected() override { return stream_ != nullptr && stream_->stream_ != nullptr; }
 
   bool log(const LogRequest& request) override {
+    return logOnStream([&request](Grpc::AsyncStream<LogRequest>& stream) {
+      stream->sendMessage(request, false);
+    });
+  }
+
+  /**
+   * Sends an already serialized request, moving it out of the buffer.
+   * @return false if the stream is above its write buffer high watermark, leaving the buffer as is.
+   */
+  bool log(Buffer::Instance& serialized_request) {
+    return logOnStream([&serialized_request](Grpc::AsyncStream<LogRequest>& stream) {
+      auto request = std::make_unique<Buffer::OwnedImpl>();
+      request->move(serialized_request);
+      stream->sendMessageRaw(std::move(request), false);
+    });
+  }
+
+  std::unique_ptr<LocalStream> stream_;
+
+private:
+  bool logOnStream(const std::function<void(Grpc::AsyncStream<LogRequest>&)>& send) {
     if (!stream_) {
       stream_ = std::make_unique<LocalStream>(*this);
     }
@@ -131,15 +154,13 @@ public:
       if (stream_->stream_->isAboveWriteBufferHighWatermark()) {
         return false;
       }
-      stream_->stream_->sendMessage(request, false);
+      send(stream_->stream_);
     } else {
       // Clear out the stream data due to stream creation failure.
       stream_.reset();
     }
     return true;
   }
-
-  std::unique_ptr<LocalStream> stream_;
 };
 
 } // namespace Common
@@ -30,7 +30,7 @@ private:
   const ::Envoy::LocalInfo::LocalInfo& local_info_;
   Extensions::Filters::Common::Expr::BuilderInstanceSharedPtr builder_;
   const google::api::expr::v1alpha1::Expr parsed_expr_;
-  Extensions::Filters::Common::Expr::ExpressionPtr compiled_expr_;
+  Extensions::Filters::Common::Expr::ExpressionSharedPtr compiled_expr_;
 };
 
 } // namespace CEL
@@ -7,6 +7,7 @@
 
 #include "source/common/config/utility.h"
 #include "source/common/grpc/typed_async_client.h"
+#include "source/common/protobuf/protobuf.h"
 #include "source/extensions/access_loggers/common/grpc_access_logger_clients.h"
 
 const char GRPC_LOG_STATS_PREFIX[] = "access_logs.grpc_access_log.";
@@ -16,6 +17,31 @@ namespace Extensions {
 namespace AccessLoggers {
 namespace GrpcCommon {
 
+namespace {
+
+using StreamAccessLogsMessage = envoy::service::accesslog::v3::StreamAccessLogsMessage;
+using Protobuf::io::CodedOutputStream;
+
+constexpr uint32_t ProtobufLengthDelimitedField = 2;
+
+// The log_entry field of both HTTPAccessLogEntries and TCPAccessLogEntries.
+static_assert(StreamAccessLogsMessage::HTTPAccessLogEntries::kLogEntryFieldNumber ==
+              StreamAccessLogsMessage::TCPAccessLogEntries::kLogEntryFieldNumber);
+constexpr uint32_t LogEntryTag =
+    (StreamAccessLogsMessage::HTTPAccessLogEntries::kLogEntryFieldNumber << 3) |
+    ProtobufLengthDelimitedField;
+
+void appendLengthDelimitedTag(Buffer::Instance& buffer, uint32_t field_number, uint64_t length) {
+  // Room for the varints of the tag and of the length.
+  uint8_t tag[15];
+  uint8_t* end = CodedOutputStream::WriteTagToArray(
+      (field_number << 3) | ProtobufLengthDelimitedField, tag);
+  end = CodedOutputStream::WriteVarint64ToArray(length, end);
+  buffer.add(tag, end - tag);
+}
+
+} // namespace
+
 GrpcAccessLoggerImpl::GrpcAccessLoggerImpl(
     const Grpc::RawAsyncClientSharedPtr& client,
     const envoy::extensions::access_loggers::grpc::v3::CommonGrpcAccessLogConfig& config,
@@ -28,26 +54,65 @@ GrpcAccessLoggerImpl::GrpcAccessLoggerImpl(
                            *Protobuf::DescriptorPool::generated_pool()->FindMethodByName(
                                "envoy.service.accesslog.v3.AccessLogService.StreamAccessLogs"),
                            GrpcCommon::optionalRetryPolicy(config))),
-      log_name_(config.log_name()), local_info_(local_info) {}
+      log_name_(config.log_name()), local_info_(local_info),
+      stream_client_(static_cast<Common::StreamingGrpcAccessLogClient<
+                         envoy::service::accesslog::v3::StreamAccessLogsMessage,
+                         envoy::service::accesslog::v3::StreamAccessLogsResponse>&>(*client_)) {}
 
 void GrpcAccessLoggerImpl::addEntry(envoy::data::accesslog::v3::HTTPAccessLogEntry&& entry) {
-  message_.mutable_http_logs()->mutable_log_entry()->Add(std::move(entry));
+  appendEntry(StreamAccessLogsMessage::kHttpLogsFieldNumber, entry);
 }
 
 void GrpcAccessLoggerImpl::addEntry(envoy::data::accesslog::v3::TCPAccessLogEntry&& entry) {
-  message_.mutable_tcp_logs()->mutable_log_entry()->Add(std::move(entry));
+  appendEntry(StreamAccessLogsMessage::kTcpLogsFieldNumber, entry);
 }
 
-bool GrpcAccessLoggerImpl::isEmpty() {
-  return !message_.has_http_logs() && !message_.has_tcp_logs();
+void GrpcAccessLoggerImpl::appendEntry(int field_number, const Protobuf::Message& entry) {
+  if (entries_field_number_ != field_number) {
+    // Like setting the other field of the oneof, which clears the entries of the first one.
+    entries_.drain(entries_.length());
+    entries_field_number_ = field_number;
+  }
+  const size_t entry_size = entry.ByteSizeLong();
+  const size_t size = CodedOutputStream::VarintSize32(LogEntryTag) +
+                      CodedOutputStream::VarintSize64(entry_size) + entry_size;
+  Buffer::ReservationSingleSlice reservation = entries_.reserveSingleSlice(size);
+  uint8_t* target = static_cast<uint8_t*>(reservation.slice().mem_);
+  target = CodedOutputStream::WriteTagToArray(LogEntryTag, target);
+  target = CodedOutputStream::WriteVarint64ToArray(entry_size, target);
+  entry.SerializeWithCachedSizesToArray(target);
+  reservation.commit(size);
 }
 
+bool GrpcAccessLoggerImpl::isEmpty() { return entries_.length() == 0; }
+
 void GrpcAccessLoggerImpl::initMessage() {
   auto* identifier = message_.mutable_identifier();
   *identifier->mutable_node() = local_info_.node();
   identifier->set_log_name(log_name_);
 }
 
+void GrpcAccessLoggerImpl::clearMessage() {
+  message_.Clear();
+  entries_.drain(entries_.length());
+}
+
+bool GrpcAccessLoggerImpl::sendMessage() {
+  // The message only holds the identifier, which precedes the entries on the wire.
+  Buffer::OwnedImpl header;
+  if (message_.has_identifier()) {
+    header.add(message_.SerializeAsString());
+  }
+  appendLengthDelimitedTag(header, entries_field_number_, entries_.length());
+  const uint64_t header_size = header.length();
+  entries_.prepend(header);
+  if (!stream_client_.log(entries_)) {
+    entries_.drain(header_size);
+    return false;
+  }
+  return true;
+}
+
 GrpcAccessLoggerCacheImpl::GrpcAccessLoggerCacheImpl(Grpc::AsyncClientManager& async_client_manager,
                                                      Stats::Scope& scope,
                                                      ThreadLocal::SlotAllocator& tls,
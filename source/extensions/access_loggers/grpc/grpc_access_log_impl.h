@@ -10,6 +10,7 @@
 #include "envoy/service/accesslog/v3/als.pb.h"
 #include "envoy/thread_local/thread_local.h"
 
+#include "source/common/buffer/buffer_impl.h"
 #include "source/extensions/access_loggers/common/grpc_access_logger.h"
 
 namespace Envoy {
@@ -17,6 +18,8 @@ namespace Extensions {
 namespace AccessLoggers {
 namespace GrpcCommon {
 
+// The entries are serialized as they are logged into a buffer holding the log entries field of the
+// message, so that a flush only frames the buffer and hands it off to the stream.
 class GrpcAccessLoggerImpl
     : public Common::GrpcAccessLogger<envoy::data::accesslog::v3::HTTPAccessLogEntry,
                                       envoy::data::accesslog::v3::TCPAccessLogEntry,
@@ -34,9 +37,20 @@ private:
   void addEntry(envoy::data::accesslog::v3::TCPAccessLogEntry&& entry) override;
   bool isEmpty() override;
   void initMessage() override;
+  void clearMessage() override;
+  bool sendMessage() override;
+
+  // Appends the entry to the entries of the oneof field of the message.
+  void appendEntry(int field_number, const Protobuf::Message& entry);
 
   const std::string log_name_;
   const LocalInfo::LocalInfo& local_info_;
+  Common::StreamingGrpcAccessLogClient<envoy::service::accesslog::v3::StreamAccessLogsMessage,
+                                       envoy::service::accesslog::v3::StreamAccessLogsResponse>&
+      stream_client_;
+  // The serialized log_entry fields of the http_logs or tcp_logs field, whose number it is.
+  Buffer::OwnedImpl entries_;
+  int entries_field_number_{};
 };
 
 class GrpcAccessLoggerCacheImpl
@@ -54,7 +54,9 @@ void HttpGrpcAccessLog::emitLog(const Formatter::HttpFormatterContext& context,
                                 const StreamInfo::StreamInfo& stream_info) {
   // Common log properties.
   // TODO(mattklein123): Populate sample_rate field.
-  envoy::data::accesslog::v3::HTTPAccessLogEntry log_entry;
+  ThreadLocalLogger& logger = tls_slot_->getTyped<ThreadLocalLogger>();
+  auto& log_entry =
+      *Protobuf::Arena::Create<envoy::data::accesslog::v3::HTTPAccessLogEntry>(&logger.arena_);
 
   const auto& request_headers = context.requestHeaders();
 
@@ -181,7 +183,8 @@ void HttpGrpcAccessLog::emitLog(const Formatter::HttpFormatterContext& context,
     response_properties->set_upstream_header_bytes_received(bytes_meter->headerBytesReceived());
   }
 
-  tls_slot_->getTyped<ThreadLocalLogger>().logger_->log(std::move(log_entry));
+  logger.logger_->log(std::move(log_entry));
+  logger.arena_.Reset();
 }
 
 } // namespace HttpGrpc
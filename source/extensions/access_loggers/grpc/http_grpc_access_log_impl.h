@@ -11,6 +11,7 @@
 #include "envoy/thread_local/thread_local.h"
 
 #include "source/common/grpc/typed_async_client.h"
+#include "source/common/protobuf/protobuf.h"
 #include "source/extensions/access_loggers/common/access_log_base.h"
 #include "source/extensions/access_loggers/grpc/grpc_access_log_impl.h"
 
@@ -41,6 +42,9 @@ private:
     ThreadLocalLogger(GrpcCommon::GrpcAccessLoggerSharedPtr logger);
 
     const GrpcCommon::GrpcAccessLoggerSharedPtr logger_;
+    // Holds the entry being built, which the logger serializes right away. It's reset after each
+    // entry and keeps its first block, so that building the entries doesn't allocate.
+    Protobuf::Arena arena_;
   };
 
   // Common::ImplBase
@@ -6,11 +6,26 @@
 #include "envoy/extensions/clusters/aggregate/v3/cluster.pb.validate.h"
 
 #include "source/common/common/assert.h"
+#include "source/common/runtime/runtime_features.h"
 
 namespace Envoy {
 namespace Extensions {
 namespace Clusters {
 namespace Aggregate {
+namespace {
+
+// Returns the priorities of the priority set which have hosts, in order.
+std::vector<uint32_t> prioritiesWithHosts(const Upstream::PrioritySet& priority_set) {
+  std::vector<uint32_t> priorities;
+  for (const auto& host_set : priority_set.hostSetsPerPriority()) {
+    if (!host_set->hosts().empty()) {
+      priorities.push_back(host_set->priority());
+    }
+  }
+  return priorities;
+}
+
+} // namespace
 
 Cluster::Cluster(const envoy::config::cluster::v3::Cluster& cluster,
                  const envoy::extensions::clusters::aggregate::v3::ClusterConfig& config,
@@ -45,11 +60,10 @@ void AggregateClusterLoadBalancer::addMemberUpdateCallbackForCluster(
     Upstream::ThreadLocalCluster& thread_local_cluster) {
   member_update_cbs_[thread_local_cluster.info()->name()] =
       thread_local_cluster.prioritySet().addMemberUpdateCb(
-          [this, target_cluster_info = thread_local_cluster.info()](const Upstream::HostVector&,
-                                                                    const Upstream::HostVector&) {
+          [this, &thread_local_cluster](const Upstream::HostVector&, const Upstream::HostVector&) {
             ENVOY_LOG(debug, "member update for cluster '{}' in aggregate cluster '{}'",
-                      target_cluster_info->name(), parent_info_->name());
-            refresh();
+                      thread_local_cluster.info()->name(), parent_info_->name());
+            refreshCluster(thread_local_cluster);
             return absl::OkStatus();
           });
 }
@@ -83,6 +97,8 @@ AggregateClusterLoadBalancer::linearizePrioritySet(OptRef<const std::string> exc
     }
 
     uint32_t priority_in_current_cluster = 0;
+    std::vector<uint32_t>& linearized_priorities =
+        priority_context->cluster_to_linearized_priorities_[cluster];
     for (const auto& host_set : tlc->prioritySet().hostSetsPerPriority()) {
       if (!host_set->hosts().empty()) {
         priority_context->priority_set_.updateHosts(
@@ -94,6 +110,7 @@ AggregateClusterLoadBalancer::linearizePrioritySet(OptRef<const std::string> exc
 
         priority_context->cluster_and_priority_to_linearized_priority_[std::make_pair(
             cluster, priority_in_current_cluster)] = next_priority_after_linearizing;
+        linearized_priorities.push_back(priority_in_current_cluster);
         next_priority_after_linearizing++;
       }
       priority_in_current_cluster++;
@@ -114,6 +131,33 @@ void AggregateClusterLoadBalancer::refresh(OptRef<const std::string> excluded_cl
   priority_context_ = std::move(priority_context);
 }
 
+void AggregateClusterLoadBalancer::refreshCluster(
+    Upstream::ThreadLocalCluster& thread_local_cluster) {
+  const std::string cluster_name = thread_local_cluster.info()->name();
+  const Upstream::PrioritySet& priority_set = thread_local_cluster.prioritySet();
+  auto it = priority_context_->cluster_to_linearized_priorities_.find(cluster_name);
+  // The linearized priorities of the clusters after this one shift if the priorities of this
+  // cluster which have hosts changed.
+  if (!Runtime::runtimeFeatureEnabled(
+          "envoy.reloadable_features.aggregate_cluster_incremental_refresh") ||
+      it == priority_context_->cluster_to_linearized_priorities_.end() ||
+      it->second != prioritiesWithHosts(priority_set)) {
+    refresh();
+    return;
+  }
+
+  // Otherwise only the linearized priorities of this cluster are updated, and the load balancer
+  // recalculates their loads from its priority update callback.
+  for (const uint32_t priority : it->second) {
+    const auto& host_set = priority_set.hostSetsPerPriority()[priority];
+    priority_context_->priority_set_.updateHosts(
+        priority_context_->cluster_and_priority_to_linearized_priority_.at(
+            std::make_pair(cluster_name, priority)),
+        Upstream::HostSetImpl::updateHostsParams(*host_set), host_set->localityWeights(), {}, {},
+        random_.random(), host_set->weightedPriorityHealth(), host_set->overprovisioningFactor());
+  }
+}
+
 void AggregateClusterLoadBalancer::onClusterAddOrUpdate(
     absl::string_view cluster_name, Upstream::ThreadLocalClusterCommand& get_cluster) {
   if (std::find(clusters_->begin(), clusters_->end(), cluster_name) != clusters_->end()) {
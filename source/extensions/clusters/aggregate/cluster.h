@@ -24,10 +24,15 @@ using PriorityToClusterVector = std::vector<std::pair<uint32_t, Upstream::Thread
 using ClusterAndPriorityToLinearizedPriorityMap =
     absl::flat_hash_map<std::pair<std::string, uint32_t>, uint32_t>;
 
+// Maps the name of each cluster found when linearizing to its priorities which have hosts, i.e.
+// which are linearized, in order.
+using ClusterToLinearizedPrioritiesMap = absl::flat_hash_map<std::string, std::vector<uint32_t>>;
+
 struct PriorityContext {
   Upstream::PrioritySetImpl priority_set_;
   PriorityToClusterVector priority_to_cluster_;
   ClusterAndPriorityToLinearizedPriorityMap cluster_and_priority_to_linearized_priority_;
+  ClusterToLinearizedPrioritiesMap cluster_to_linearized_priorities_;
 };
 
 using PriorityContextPtr = std::unique_ptr<PriorityContext>;
@@ -123,6 +128,9 @@ private:
   void addMemberUpdateCallbackForCluster(Upstream::ThreadLocalCluster& thread_local_cluster);
   PriorityContextPtr linearizePrioritySet(OptRef<const std::string> excluded_cluster);
   void refresh(OptRef<const std::string> excluded_cluster = OptRef<const std::string>());
+  // Updates the linearized priorities of the cluster in place, on a member update of the cluster.
+  // The whole priority set is rebuilt if the linearized priorities of the cluster changed.
+  void refreshCluster(Upstream::ThreadLocalCluster& thread_local_cluster);
 
   LoadBalancerImplPtr load_balancer_;
   Upstream::ClusterInfoConstSharedPtr parent_info_;
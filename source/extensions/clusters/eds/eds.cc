@@ -342,40 +342,36 @@ void EdsClusterImpl::onCachedResourceRemoved(absl::string_view resource_name) {
   update(resource);
 }
 
-void EdsClusterImpl::reloadHealthyHostsHelper(const HostSharedPtr& host) {
-  // Here we will see if we have a host that has been marked for deletion by service discovery
-  // but has been stabilized due to passing active health checking. If such a host is now
-  // failing active health checking we can remove it during this health check update.
-  HostSharedPtr host_to_exclude = host;
-  if (host_to_exclude != nullptr &&
-      host_to_exclude->healthFlagGet(Host::HealthFlag::FAILED_ACTIVE_HC) &&
-      host_to_exclude->healthFlagGet(Host::HealthFlag::PENDING_DYNAMIC_REMOVAL)) {
-    // Empty for clarity.
-  } else {
-    // Do not exclude and remove the host during the update.
-    host_to_exclude = nullptr;
+void EdsClusterImpl::reloadHealthyHostsHelper(const HostVector& hosts) {
+  // Here we will see if we have hosts that have been marked for deletion by service discovery
+  // but have been stabilized due to passing active health checking. If such hosts are now
+  // failing active health checking we can remove them during this health check update.
+  absl::flat_hash_set<const Host*> hosts_to_exclude;
+  for (const HostSharedPtr& host : hosts) {
+    if (host->healthFlagGet(Host::HealthFlag::FAILED_ACTIVE_HC) &&
+        host->healthFlagGet(Host::HealthFlag::PENDING_DYNAMIC_REMOVAL)) {
+      hosts_to_exclude.insert(host.get());
+    }
   }
 
   const auto& host_sets = prioritySet().hostSetsPerPriority();
   for (size_t priority = 0; priority < host_sets.size(); ++priority) {
     const auto& host_set = host_sets[priority];
 
-    // Filter current hosts in case we need to exclude a host.
+    // Filter current hosts in case we need to exclude some, which are then removed.
     HostVectorSharedPtr hosts_copy(new HostVector());
-    std::copy_if(host_set->hosts().begin(), host_set->hosts().end(),
-                 std::back_inserter(*hosts_copy),
-                 [&host_to_exclude](const HostSharedPtr& host) { return host_to_exclude != host; });
-
-    // Setup a hosts to remove vector in case we need to exclude a host.
     HostVector hosts_to_remove;
-    if (hosts_copy->size() != host_set->hosts().size()) {
-      ASSERT(hosts_copy->size() == host_set->hosts().size() - 1);
-      hosts_to_remove.emplace_back(host_to_exclude);
+    for (const HostSharedPtr& host : host_set->hosts()) {
+      if (hosts_to_exclude.contains(host.get())) {
+        hosts_to_remove.push_back(host);
+      } else {
+        hosts_copy->push_back(host);
+      }
     }
 
-    // Filter hosts per locality in case we need to exclude a host.
+    // Filter hosts per locality in case we need to exclude some.
     HostsPerLocalityConstSharedPtr hosts_per_locality_copy = host_set->hostsPerLocality().filter(
-        {[&host_to_exclude](const Host& host) { return &host != host_to_exclude.get(); }})[0];
+        {[&hosts_to_exclude](const Host& host) { return !hosts_to_exclude.contains(&host); }})[0];
 
     prioritySet().updateHosts(priority,
                               HostSetImpl::partitionHosts(hosts_copy, hosts_per_locality_copy),
@@ -71,7 +71,7 @@ private:
   void onCachedResourceRemoved(absl::string_view resource_name) override;
 
   // ClusterImplBase
-  void reloadHealthyHostsHelper(const HostSharedPtr& host) override;
+  void reloadHealthyHostsHelper(const HostVector& hosts) override;
   void startPreInit() override;
   void onAssignmentTimeout();
 
@@ -58,14 +58,21 @@ HostConstSharedPtr OriginalDstCluster::LoadBalancer::chooseHost(LoadBalancerCont
 
     if (dst_host) {
       const Network::Address::Instance& dst_addr = *dst_host.get();
+      const std::string& address = dst_addr.asString();
       // Check if a host with the destination address is already in the host set.
-      auto it = host_map_->find(dst_addr.asString());
+      auto it = host_map_->find(address);
       if (it != host_map_->end()) {
         HostConstSharedPtr host = it->second->host_;
         ENVOY_LOG(trace, "Using existing host {} {}.", *host, host->address()->asString());
         it->second->used_ = true;
         return host;
       }
+      // Check if this load balancer already added a host which isn't in its host map yet.
+      auto added_it = added_hosts_.find(address);
+      if (added_it != added_hosts_.end()) {
+        ENVOY_LOG(trace, "Using added host {} {}.", *added_it->second, address);
+        return added_it->second;
+      }
       // Add a new host
       const Network::Address::Ip* dst_ip = dst_addr.ip();
       if (dst_ip) {
@@ -74,24 +81,29 @@ HostConstSharedPtr OriginalDstCluster::LoadBalancer::chooseHost(LoadBalancerCont
         // Create a host we can use immediately.
         auto info = parent_->cluster_->info();
         HostSharedPtr host(std::make_shared<HostImpl>(
-            info, info->name() + dst_addr.asString(), std::move(host_ip_port), nullptr, nullptr, 1,
+            info, info->name() + address, std::move(host_ip_port), nullptr, nullptr, 1,
             envoy::config::core::v3::Locality().default_instance(),
             envoy::config::endpoint::v3::Endpoint::HealthCheckConfig().default_instance(), 0,
             envoy::config::core::v3::UNKNOWN, parent_->cluster_->time_source_));
         ENVOY_LOG(debug, "Created host {} {}.", *host, host->address()->asString());
 
-        // Tell the cluster about the new host
-        // lambda cannot capture a member by value.
-        std::weak_ptr<OriginalDstClusterHandle> post_parent = parent_;
-        parent_->cluster_->dispatcher_.post([post_parent, host]() mutable {
-          // The main cluster may have disappeared while this post was queued.
-          if (std::shared_ptr<OriginalDstClusterHandle> parent = post_parent.lock()) {
-            parent->cluster_->addHost(host);
-          }
-        });
+        added_hosts_.emplace(address, host);
+
+        // Tell the cluster about the new host, unless the addition of the hosts queued before is
+        // already posted.
+        if (parent_->cluster_->queueHost(host)) {
+          // lambda cannot capture a member by value.
+          std::weak_ptr<OriginalDstClusterHandle> post_parent = parent_;
+          parent_->cluster_->dispatcher_.post([post_parent]() {
+            // The main cluster may have disappeared while this post was queued.
+            if (std::shared_ptr<OriginalDstClusterHandle> parent = post_parent.lock()) {
+              parent->cluster_->addPendingHosts();
+            }
+          });
+        }
         return host;
       } else {
-        ENVOY_LOG(debug, "Failed to create host for {}.", dst_addr.asString());
+        ENVOY_LOG(debug, "Failed to create host for {}.", address);
       }
     }
   }
@@ -213,33 +225,50 @@ OriginalDstCluster::OriginalDstCluster(const envoy::config::cluster::v3::Cluster
   cleanup_timer_->enableTimer(cleanup_interval_ms_);
 }
 
-void OriginalDstCluster::addHost(HostSharedPtr& host) {
-  std::string address = host->address()->asString();
+bool OriginalDstCluster::queueHost(const HostSharedPtr& host) {
+  absl::MutexLock lock(&pending_hosts_lock_);
+  pending_hosts_.push_back(host);
+  return pending_hosts_.size() == 1;
+}
+
+void OriginalDstCluster::addPendingHosts() {
+  HostVector hosts;
+  {
+    absl::MutexLock lock(&pending_hosts_lock_);
+    hosts.swap(pending_hosts_);
+  }
+  if (hosts.empty()) {
+    return;
+  }
+
   HostMultiMapSharedPtr new_host_map = std::make_shared<HostMultiMap>(*getCurrentHostMap());
-  auto it = new_host_map->find(address);
-  if (it != new_host_map->end()) {
-    // If the entry already exists, that means the worker that posted this host
-    // had a stale host map. Because the host is potentially in that worker's
-    // connection pools, we save the host in the host map hosts_ list and the
-    // cluster priority set. Subsequently, the entire hosts_ list and the
-    // primary host are removed collectively, once no longer in use.
-    it->second->hosts_.push_back(host);
-  } else {
-    // The first worker that creates a host for the address defines the primary
-    // host structure.
-    new_host_map->emplace(address, std::make_shared<HostsForAddress>(host));
+  for (HostSharedPtr& host : hosts) {
+    std::string address = host->address()->asString();
+    auto it = new_host_map->find(address);
+    if (it != new_host_map->end()) {
+      // If the entry already exists, that means the worker that posted this host
+      // had a stale host map. Because the host is potentially in that worker's
+      // connection pools, we save the host in the host map hosts_ list and the
+      // cluster priority set. Subsequently, the entire hosts_ list and the
+      // primary host are removed collectively, once no longer in use.
+      it->second->hosts_.push_back(host);
+    } else {
+      // The first worker that creates a host for the address defines the primary
+      // host structure.
+      new_host_map->emplace(address, std::make_shared<HostsForAddress>(host));
+    }
+    ENVOY_LOG(debug, "addPendingHosts() adding {} {}.", *host, address);
   }
-  ENVOY_LOG(debug, "addHost() adding {} {}.", *host, address);
   setHostMap(new_host_map);
 
   // Given the current config, only EDS clusters support multiple priorities.
   ASSERT(priority_set_.hostSetsPerPriority().size() == 1);
   const auto& first_host_set = priority_set_.getOrCreateHostSet(0);
   HostVectorSharedPtr all_hosts(new HostVector(first_host_set.hosts()));
-  all_hosts->emplace_back(host);
+  all_hosts->insert(all_hosts->end(), hosts.begin(), hosts.end());
   priority_set_.updateHosts(
       0, HostSetImpl::partitionHosts(all_hosts, HostsPerLocalityImpl::empty()), {},
-      {std::move(host)}, {}, random_.random(), absl::nullopt, absl::nullopt);
+      std::move(hosts), {}, random_.random(), absl::nullopt, absl::nullopt);
 }
 
 void OriginalDstCluster::cleanup() {
@@ -16,6 +16,9 @@
 #include "source/common/upstream/cluster_factory_impl.h"
 #include "source/common/upstream/upstream_impl.h"
 
+#include "absl/container/flat_hash_map.h"
+#include "absl/synchronization/mutex.h"
+
 namespace Envoy {
 namespace Upstream {
 
@@ -84,7 +87,8 @@ public:
    * add hosts on demand. Additions are synced with all other threads so that the host set in the
    * cluster remains (eventually) consistent. If multiple threads add a host to the same upstream
    * address then two distinct HostSharedPtr's (with the same upstream IP address) will be added,
-   * and both of them will eventually time out.
+   * and both of them will eventually time out. Until the load balancer is recreated with the
+   * updated host map, it reuses the hosts it added itself.
    */
   class LoadBalancer : public Upstream::LoadBalancer {
   public:
@@ -121,6 +125,8 @@ public:
     const absl::optional<Config::MetadataKey>& metadata_key_;
     const absl::optional<uint32_t> port_override_;
     HostMultiMapConstSharedPtr host_map_;
+    // The hosts added by this load balancer, which aren't in host_map_ yet.
+    absl::flat_hash_map<std::string, HostSharedPtr> added_hosts_;
   };
 
   const absl::optional<Http::LowerCaseString>& httpHeaderName() { return http_header_name_; }
@@ -166,7 +172,12 @@ private:
     host_map_ = new_host_map;
   }
 
-  void addHost(HostSharedPtr&);
+  // Queues a host created by a worker to be added on the main thread. Returns true if the queue
+  // was empty, in which case the caller must post addPendingHosts() to the main thread. The hosts
+  // queued in the meantime are added along with it, in a single update of the host map and
+  // priority set.
+  bool queueHost(const HostSharedPtr& host);
+  void addPendingHosts();
   void cleanup();
 
   // ClusterImplBase
@@ -178,6 +189,8 @@ private:
 
   absl::Mutex host_map_lock_;
   HostMultiMapConstSharedPtr host_map_ ABSL_GUARDED_BY(host_map_lock_);
+  absl::Mutex pending_hosts_lock_;
+  HostVector pending_hosts_ ABSL_GUARDED_BY(pending_hosts_lock_);
   absl::optional<Http::LowerCaseString> http_header_name_;
   absl::optional<Config::MetadataKey> metadata_key_;
   absl::optional<uint32_t> port_override_;
@@ -175,7 +175,8 @@ public:
     if (newfd.return_value_ == -1) {
       return statusAfterFileError(newfd);
     }
-    return std::make_shared<AsyncFileContextThreadPool>(context()->manager(), newfd.return_value_);
+    return static_cast<AsyncFileManagerThreadPool&>(context()->manager())
+        .createHandle(newfd.return_value_);
   }
 
   void onCancelledBeforeCallback(absl::StatusOr<AsyncFileHandle> result) override {
@@ -7,6 +7,11 @@
 #include "source/common/protobuf/utility.h"
 #include "source/extensions/common/async_files/async_file_manager_thread_pool.h"
 
+#if defined(__linux__) && !defined(__ANDROID_API__)
+#include "source/common/io/io_uring_impl.h"
+#include "source/extensions/common/async_files/async_file_manager_io_uring.h"
+#endif
+
 #include "absl/base/thread_annotations.h"
 #include "absl/container/flat_hash_map.h"
 
@@ -61,6 +66,23 @@ std::shared_ptr<AsyncFileManager> AsyncFileManagerFactoryImpl::getAsyncFileManag
                             std::make_shared<AsyncFileManagerThreadPool>(config, posix), config}})
                .first;
       break;
+    case envoy::extensions::common::async_files::v3::AsyncFileManagerConfig::kIoUring: {
+      std::shared_ptr<AsyncFileManager> manager;
+#if defined(__linux__) && !defined(__ANDROID_API__)
+      if (Io::isIoUringSupported()) {
+        manager = std::make_shared<AsyncFileManagerIoUring>(config, posix);
+      }
+#endif
+      if (manager == nullptr) {
+        ENVOY_LOG_MISC(warn, "io_uring is not supported, AsyncFileManager with id '{}' uses a "
+                       "thread pool instead",
+                       config.id());
+        manager = std::make_shared<AsyncFileManagerThreadPool>(
+            config.id(), config.io_uring().thread_count(), posix);
+      }
+      it = managers_.insert({config.id(), ManagerAndConfig{std::move(manager), config}}).first;
+      break;
+    }
     case envoy::extensions::common::async_files::v3::AsyncFileManagerConfig::MANAGER_TYPE_NOT_SET:
       // This is theoretically unreachable due to proto validation 'required', but it's possible
       // for code to have modified the proto post-validation.
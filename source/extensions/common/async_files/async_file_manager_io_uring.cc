@@ -0,0 +1,287 @@
+#include "source/extensions/common/async_files/async_file_manager_io_uring.h"
+
+#include <poll.h>
+#include <sys/eventfd.h>
+
+#include <climits>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "source/common/buffer/buffer_impl.h"
+#include "source/common/io/io_uring_impl.h"
+#include "source/extensions/common/async_files/async_file_action.h"
+#include "source/extensions/common/async_files/async_file_context_thread_pool.h"
+#include "source/extensions/common/async_files/status_after_file_error.h"
+
+#include "absl/strings/str_cat.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace Common {
+namespace AsyncFiles {
+
+namespace {
+
+constexpr uint32_t DefaultIoUringSize = 256;
+
+// The request of an action in flight, which keeps the action alive until its completion.
+class ActionRequest : public Io::Request {
+public:
+  explicit ActionRequest(std::shared_ptr<IoUringAction> action)
+      : Io::Request(action->requestType()), action_(std::move(action)) {}
+
+  const std::shared_ptr<IoUringAction> action_;
+};
+
+// An action whose result is the completion of its io_uring request. The callback is called, or
+// not if the action was cancelled, when the completion is reaped.
+template <typename T>
+class IoUringActionWithResult : public AsyncFileActionWithResult<T>, public IoUringAction {
+public:
+  IoUringActionWithResult(AsyncFileHandle handle, int fd, std::function<void(T)> on_complete)
+      : AsyncFileActionWithResult<T>(std::move(on_complete)), handle_(std::move(handle)),
+        file_descriptor_(fd) {}
+
+  void onCompletion(int32_t result) override {
+    result_ = result;
+    this->execute();
+  }
+
+protected:
+  // Keeps the file context alive until the completion.
+  const AsyncFileHandle handle_;
+  const int file_descriptor_;
+  int32_t result_{};
+};
+
+class ActionReadIoUring : public IoUringActionWithResult<absl::StatusOr<Buffer::InstancePtr>> {
+public:
+  ActionReadIoUring(AsyncFileHandle handle, int fd, off_t offset, size_t length,
+                    std::function<void(absl::StatusOr<Buffer::InstancePtr>)> on_complete)
+      : IoUringActionWithResult(std::move(handle), fd, std::move(on_complete)), offset_(offset),
+        buffer_(std::make_unique<Buffer::OwnedImpl>()),
+        reservation_(buffer_->reserveSingleSlice(length)) {
+    iovec_.iov_base = reservation_.slice().mem_;
+    iovec_.iov_len = length;
+  }
+
+  Io::Request::RequestType requestType() const override { return Io::Request::RequestType::Read; }
+
+  Io::IoUringResult prepare(Io::IoUring& ring, Io::Request* user_data) override {
+    return ring.prepareReadv(file_descriptor_, &iovec_, 1, offset_, user_data);
+  }
+
+  absl::StatusOr<Buffer::InstancePtr> executeImpl() override {
+    if (result_ < 0) {
+      return statusAfterFileError(-result_);
+    }
+    // The file was read into the buffer's own memory, so there is nothing to copy.
+    reservation_.commit(result_);
+    return std::move(buffer_);
+  }
+
+private:
+  const off_t offset_;
+  std::unique_ptr<Buffer::OwnedImpl> buffer_;
+  Buffer::ReservationSingleSlice reservation_;
+  struct iovec iovec_;
+};
+
+class ActionWriteIoUring : public IoUringActionWithResult<absl::StatusOr<size_t>> {
+public:
+  ActionWriteIoUring(AsyncFileHandle handle, int fd, Buffer::Instance& contents, off_t offset,
+                     std::function<void(absl::StatusOr<size_t>)> on_complete)
+      : IoUringActionWithResult(std::move(handle), fd, std::move(on_complete)), offset_(offset) {
+    contents_.move(contents);
+    if (contents_.getRawSlices().size() > IOV_MAX) {
+      contents_.linearize(contents_.length());
+    }
+    for (const Buffer::RawSlice& slice : contents_.getRawSlices()) {
+      iovecs_.push_back({slice.mem_, slice.len_});
+    }
+  }
+
+  Io::Request::RequestType requestType() const override { return Io::Request::RequestType::Write; }
+
+  Io::IoUringResult prepare(Io::IoUring& ring, Io::Request* user_data) override {
+    return ring.prepareWritev(file_descriptor_, iovecs_.data(), iovecs_.size(), offset_,
+                              user_data);
+  }
+
+  // A short write, which a regular file only does when running out of space, is reported as is
+  // rather than retried.
+  absl::StatusOr<size_t> executeImpl() override {
+    if (result_ < 0) {
+      return statusAfterFileError(-result_);
+    }
+    return result_;
+  }
+
+  Buffer::Instance& contents() { return contents_; }
+
+private:
+  const off_t offset_;
+  Buffer::OwnedImpl contents_;
+  std::vector<struct iovec> iovecs_;
+};
+
+class ActionCloseIoUring : public IoUringActionWithResult<absl::Status> {
+public:
+  ActionCloseIoUring(AsyncFileHandle handle, int fd, std::function<void(absl::Status)> on_complete)
+      : IoUringActionWithResult(std::move(handle), fd, std::move(on_complete)) {}
+
+  Io::Request::RequestType requestType() const override { return Io::Request::RequestType::Close; }
+
+  Io::IoUringResult prepare(Io::IoUring& ring, Io::Request* user_data) override {
+    return ring.prepareClose(file_descriptor_, user_data);
+  }
+
+  absl::Status executeImpl() override {
+    if (result_ < 0) {
+      return statusAfterFileError(-result_);
+    }
+    return absl::OkStatus();
+  }
+};
+
+// The io_uring implementation of an AsyncFileContext - reads, writes and closes the file through
+// the manager's io_uring, falling back to the thread pool for everything else.
+class AsyncFileContextIoUring : public AsyncFileContextThreadPool {
+public:
+  AsyncFileContextIoUring(AsyncFileManagerIoUring& manager, int fd)
+      : AsyncFileContextThreadPool(manager, fd) {}
+
+  absl::Status close(std::function<void(absl::Status)> on_complete) override {
+    if (fileDescriptor() == -1) {
+      return absl::FailedPreconditionError("file was already closed");
+    }
+    if (!ioUringManager().submit(
+            std::make_shared<ActionCloseIoUring>(handle(), fileDescriptor(), on_complete))) {
+      return AsyncFileContextThreadPool::close(std::move(on_complete));
+    }
+    fileDescriptor() = -1;
+    return absl::OkStatus();
+  }
+
+  absl::StatusOr<CancelFunction>
+  read(off_t offset, size_t length,
+       std::function<void(absl::StatusOr<Buffer::InstancePtr>)> on_complete) override {
+    if (fileDescriptor() == -1) {
+      return absl::FailedPreconditionError("file was already closed");
+    }
+    auto action = std::make_shared<ActionReadIoUring>(handle(), fileDescriptor(), offset, length,
+                                                      on_complete);
+    if (!ioUringManager().submit(action)) {
+      return AsyncFileContextThreadPool::read(offset, length, std::move(on_complete));
+    }
+    return [action]() { action->cancel(); };
+  }
+
+  absl::StatusOr<CancelFunction>
+  write(Buffer::Instance& contents, off_t offset,
+        std::function<void(absl::StatusOr<size_t>)> on_complete) override {
+    if (fileDescriptor() == -1) {
+      return absl::FailedPreconditionError("file was already closed");
+    }
+    auto action = std::make_shared<ActionWriteIoUring>(handle(), fileDescriptor(), contents,
+                                                       offset, on_complete);
+    if (!ioUringManager().submit(action)) {
+      return AsyncFileContextThreadPool::write(action->contents(), offset, std::move(on_complete));
+    }
+    return [action]() { action->cancel(); };
+  }
+
+private:
+  AsyncFileManagerIoUring& ioUringManager() const {
+    return static_cast<AsyncFileManagerIoUring&>(manager_);
+  }
+};
+
+} // namespace
+
+AsyncFileManagerIoUring::AsyncFileManagerIoUring(
+    const envoy::extensions::common::async_files::v3::AsyncFileManagerConfig& config,
+    Api::OsSysCalls& posix)
+    : AsyncFileManagerThreadPool(config.id(), config.io_uring().thread_count(), posix),
+      io_uring_size_(config.io_uring().io_uring_size() == 0 ? DefaultIoUringSize
+                                                             : config.io_uring().io_uring_size()),
+      io_uring_(std::make_unique<Io::IoUringImpl>(io_uring_size_, false)),
+      event_fd_(io_uring_->registerEventfd()) {
+  ENVOY_LOG(info, fmt::format("AsyncFileManagerIoUring created with id '{}', with {} entries",
+                              config.id(), io_uring_size_));
+  completion_thread_ = std::thread([this]() { reapCompletions(); });
+}
+
+AsyncFileManagerIoUring::~AsyncFileManagerIoUring() ABSL_LOCKS_EXCLUDED(ring_mutex_) {
+  {
+    absl::MutexLock lock(&ring_mutex_);
+    terminate_ = true;
+  }
+  // Wakes the completion thread, which returns once the requests in flight are complete.
+  eventfd_write(event_fd_, 1);
+  completion_thread_.join();
+}
+
+std::string AsyncFileManagerIoUring::describe() const {
+  return absl::StrCat(AsyncFileManagerThreadPool::describe(), ", io_uring_size = ", io_uring_size_);
+}
+
+AsyncFileHandle AsyncFileManagerIoUring::createHandle(int fd) {
+  return std::make_shared<AsyncFileContextIoUring>(*this, fd);
+}
+
+bool AsyncFileManagerIoUring::submit(std::shared_ptr<IoUringAction> action) {
+  auto request = std::make_unique<ActionRequest>(std::move(action));
+  absl::MutexLock lock(&ring_mutex_);
+  // Bounding the requests in flight by the size of the ring guarantees that all their
+  // completions fit in a single pass of the completion thread.
+  if (terminate_ || in_flight_ >= io_uring_size_) {
+    return false;
+  }
+  if (request->action_->prepare(*io_uring_, request.get()) != Io::IoUringResult::Ok) {
+    return false;
+  }
+  ++in_flight_;
+  request.release();
+  // If the kernel is busy, the request is left in the submission queue, for the completion thread
+  // to submit once it has reaped completions.
+  io_uring_->submit();
+  return true;
+}
+
+void AsyncFileManagerIoUring::reapCompletions() {
+  std::vector<std::pair<std::unique_ptr<ActionRequest>, int32_t>> completions;
+  completions.reserve(io_uring_size_);
+  while (true) {
+    {
+      absl::MutexLock lock(&ring_mutex_);
+      if (terminate_ && in_flight_ == 0) {
+        return;
+      }
+    }
+    struct pollfd poll_fd {};
+    poll_fd.fd = event_fd_;
+    poll_fd.events = POLLIN;
+    ::poll(&poll_fd, 1, -1);
+    {
+      absl::MutexLock lock(&ring_mutex_);
+      io_uring_->forEveryCompletion(
+          [&completions](Io::Request* user_data, int32_t result, uint32_t, bool) {
+            completions.emplace_back(static_cast<ActionRequest*>(user_data), result);
+          });
+      in_flight_ -= completions.size();
+      io_uring_->submit();
+    }
+    // The callbacks are called without the lock, since they commonly submit the next action.
+    for (auto& [request, result] : completions) {
+      request->action_->onCompletion(result);
+    }
+    completions.clear();
+  }
+}
+
+} // namespace AsyncFiles
+} // namespace Common
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <thread>
+
+#include "envoy/common/io/io_uring.h"
+#include "envoy/extensions/common/async_files/v3/async_file_manager.pb.h"
+
+#include "source/extensions/common/async_files/async_file_handle.h"
+#include "source/extensions/common/async_files/async_file_manager_thread_pool.h"
+
+#include "absl/base/thread_annotations.h"
+#include "absl/synchronization/mutex.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace Common {
+namespace AsyncFiles {
+
+// An action performed by an io_uring request rather than by a thread of the pool.
+class IoUringAction {
+public:
+  virtual ~IoUringAction() = default;
+
+  virtual Io::Request::RequestType requestType() const PURE;
+
+  // Prepares the request of the action in the submission queue of the ring.
+  virtual Io::IoUringResult prepare(Io::IoUring& ring, Io::Request* user_data) PURE;
+
+  // Called from the completion thread with the result of the request, which is the return value
+  // of the system call or a negated errno.
+  virtual void onCompletion(int32_t result) PURE;
+};
+
+// An AsyncFileManager which submits the reads, writes and closes of the open files to an
+// io_uring from the calling thread, so that they don't require a handoff to a thread of the pool
+// nor a blocking system call. The completions are reaped by a single thread, which calls their
+// callbacks, like the threads of the pool do for the other actions.
+//
+// The actions that io_uring can't take, or that don't fit in the submission queue, are performed
+// by the thread pool.
+class AsyncFileManagerIoUring : public AsyncFileManagerThreadPool {
+public:
+  AsyncFileManagerIoUring(
+      const envoy::extensions::common::async_files::v3::AsyncFileManagerConfig& config,
+      Api::OsSysCalls& posix);
+  ~AsyncFileManagerIoUring() ABSL_LOCKS_EXCLUDED(ring_mutex_) override;
+
+  std::string describe() const override;
+  AsyncFileHandle createHandle(int fd) override;
+
+  // Submits the request of the action from the calling thread. Returns false if the action
+  // couldn't be submitted, in which case it should be performed by the thread pool instead.
+  bool submit(std::shared_ptr<IoUringAction> action) ABSL_LOCKS_EXCLUDED(ring_mutex_);
+
+private:
+  void reapCompletions() ABSL_LOCKS_EXCLUDED(ring_mutex_);
+
+  const uint32_t io_uring_size_;
+  absl::Mutex ring_mutex_;
+  Io::IoUringPtr io_uring_ ABSL_GUARDED_BY(ring_mutex_);
+  const os_fd_t event_fd_;
+  // The number of requests submitted and not completed yet.
+  uint64_t in_flight_ ABSL_GUARDED_BY(ring_mutex_){};
+  bool terminate_ ABSL_GUARDED_BY(ring_mutex_){};
+  std::thread completion_thread_;
+};
+
+} // namespace AsyncFiles
+} // namespace Common
+} // namespace Extensions
+} // namespace Envoy
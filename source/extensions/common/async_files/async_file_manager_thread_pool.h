@@ -29,6 +29,7 @@ public:
   explicit AsyncFileManagerThreadPool(
       const envoy::extensions::common::async_files::v3::AsyncFileManagerConfig& config,
       Api::OsSysCalls& posix);
+  AsyncFileManagerThreadPool(absl::string_view id, uint32_t thread_count, Api::OsSysCalls& posix);
   ~AsyncFileManagerThreadPool() ABSL_LOCKS_EXCLUDED(queue_mutex_) override;
   CancelFunction
   createAnonymousFile(absl::string_view path,
@@ -43,6 +44,9 @@ public:
   std::string describe() const override;
   Api::OsSysCalls& posix() const { return posix_; }
 
+  // Creates the handle of a file opened by an action of the pool.
+  virtual AsyncFileHandle createHandle(int fd);
+
 #ifdef O_TMPFILE
   // The first time we try to open an anonymous file, these values are used to capture whether
   // opening with O_TMPFILE works. If it does not, the first open is retried using 'mkstemp',
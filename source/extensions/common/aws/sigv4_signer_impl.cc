@@ -41,17 +41,36 @@ std::string SigV4SignerImpl::createSignature(
     const absl::string_view secret_access_key, const absl::string_view short_date,
     const absl::string_view string_to_sign, const absl::string_view override_region) const {
 
+  auto& crypto_util = Envoy::Common::Crypto::UtilitySingleton::get();
+  const auto signing_key = signingKey(secret_access_key, short_date,
+                                      override_region.empty() ? region_ : override_region);
+  return Hex::encode(crypto_util.getSha256Hmac(signing_key, string_to_sign));
+}
+
+std::vector<uint8_t> SigV4SignerImpl::signingKey(absl::string_view secret_access_key,
+                                                 absl::string_view short_date,
+                                                 absl::string_view region) const {
+  {
+    absl::ReaderMutexLock lock(&signing_key_mutex_);
+    if (signing_key_.short_date_ == short_date && signing_key_.region_ == region &&
+        signing_key_.secret_access_key_ == secret_access_key) {
+      return signing_key_.key_;
+    }
+  }
+
   auto& crypto_util = Envoy::Common::Crypto::UtilitySingleton::get();
   const auto secret_key =
       absl::StrCat(SigV4SignatureConstants::SigV4SignatureVersion, secret_access_key);
   const auto date_key = crypto_util.getSha256Hmac(
       std::vector<uint8_t>(secret_key.begin(), secret_key.end()), short_date);
-  const auto region_key =
-      crypto_util.getSha256Hmac(date_key, override_region.empty() ? region_ : override_region);
+  const auto region_key = crypto_util.getSha256Hmac(date_key, region);
   const auto service_key = crypto_util.getSha256Hmac(region_key, service_name_);
-  const auto signing_key =
-      crypto_util.getSha256Hmac(service_key, SigV4SignatureConstants::Aws4Request);
-  return Hex::encode(crypto_util.getSha256Hmac(signing_key, string_to_sign));
+  auto signing_key = crypto_util.getSha256Hmac(service_key, SigV4SignatureConstants::Aws4Request);
+
+  absl::MutexLock lock(&signing_key_mutex_);
+  signing_key_ = {std::string(secret_access_key), std::string(short_date), std::string(region),
+                  signing_key};
+  return signing_key;
 }
 
 std::string SigV4SignerImpl::createAuthorizationHeader(
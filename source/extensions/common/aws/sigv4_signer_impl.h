@@ -1,7 +1,9 @@
 #pragma once
 
 #include <cstdint>
+#include <string>
 #include <utility>
+#include <vector>
 
 #include "source/common/common/logger.h"
 #include "source/common/common/matchers.h"
@@ -12,6 +14,8 @@
 #include "source/extensions/common/aws/signer.h"
 #include "source/extensions/common/aws/signer_base_impl.h"
 
+#include "absl/synchronization/mutex.h"
+
 namespace Envoy {
 namespace Extensions {
 namespace Common {
@@ -69,6 +73,21 @@ private:
                                         const absl::string_view signature) const override;
 
   absl::string_view getAlgorithmString() const override;
+
+  // Returns the signing key of the secret key for the day, the region and the service, derived
+  // again only when it differs from the one of the previous request.
+  std::vector<uint8_t> signingKey(absl::string_view secret_access_key, absl::string_view short_date,
+                                  absl::string_view region) const;
+
+  struct SigningKey {
+    std::string secret_access_key_;
+    std::string short_date_;
+    std::string region_;
+    std::vector<uint8_t> key_;
+  };
+
+  mutable absl::Mutex signing_key_mutex_;
+  mutable SigningKey signing_key_ ABSL_GUARDED_BY(signing_key_mutex_);
 };
 
 } // namespace Aws
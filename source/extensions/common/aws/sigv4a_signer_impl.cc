@@ -70,27 +70,50 @@ std::string SigV4ASignerImpl::createSignature(
 
   auto& crypto_util = Envoy::Common::Crypto::UtilitySingleton::get();
 
-  EC_KEY* ec_key = SigV4AKeyDerivation::derivePrivateKey(access_key_id, secret_access_key);
+  bssl::UniquePtr<EC_KEY> ec_key = privateKey(access_key_id, secret_access_key);
   if (!ec_key) {
     ENVOY_LOG(debug, "SigV4A key derivation failed");
     return blank_str_;
   }
 
-  std::vector<uint8_t> signature(ECDSA_size(ec_key));
+  std::vector<uint8_t> signature(ECDSA_size(ec_key.get()));
   unsigned int signature_size;
 
   // Sign the SHA256 hash of our calculated string_to_sign
   auto hash = crypto_util.getSha256Digest(Buffer::OwnedImpl(string_to_sign));
 
-  ECDSA_sign(0, hash.data(), hash.size(), signature.data(), &signature_size, ec_key);
+  ECDSA_sign(0, hash.data(), hash.size(), signature.data(), &signature_size, ec_key.get());
 
-  EC_KEY_free(ec_key);
   std::string encoded_signature(
       Hex::encode(std::vector<uint8_t>(signature.data(), signature.data() + signature_size)));
 
   return encoded_signature;
 }
 
+bssl::UniquePtr<EC_KEY> SigV4ASignerImpl::privateKey(absl::string_view access_key_id,
+                                                     absl::string_view secret_access_key) const {
+  {
+    absl::ReaderMutexLock lock(&private_key_mutex_);
+    if (private_key_.key_ != nullptr && private_key_.access_key_id_ == access_key_id &&
+        private_key_.secret_access_key_ == secret_access_key) {
+      EC_KEY_up_ref(private_key_.key_.get());
+      return bssl::UniquePtr<EC_KEY>(private_key_.key_.get());
+    }
+  }
+
+  bssl::UniquePtr<EC_KEY> ec_key(
+      SigV4AKeyDerivation::derivePrivateKey(access_key_id, secret_access_key));
+  if (ec_key == nullptr) {
+    return nullptr;
+  }
+
+  absl::MutexLock lock(&private_key_mutex_);
+  EC_KEY_up_ref(ec_key.get());
+  private_key_ = {std::string(access_key_id), std::string(secret_access_key),
+                  bssl::UniquePtr<EC_KEY>(ec_key.get())};
+  return ec_key;
+}
+
 absl::string_view SigV4ASignerImpl::getAlgorithmString() const {
   return SigV4ASignatureConstants::SigV4AAlgorithm;
 }
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <string>
 #include <utility>
 
 #include "source/common/common/logger.h"
@@ -11,6 +12,9 @@
 #include "source/extensions/common/aws/signer.h"
 #include "source/extensions/common/aws/signer_base_impl.h"
 
+#include "absl/synchronization/mutex.h"
+#include "openssl/ec_key.h"
+
 namespace Envoy {
 namespace Extensions {
 namespace Common {
@@ -86,6 +90,20 @@ private:
                                         const absl::string_view signature) const override;
 
   absl::string_view getAlgorithmString() const override;
+
+  // Returns the private key derived from the credentials, derived again only when they differ from
+  // the ones of the previous request.
+  bssl::UniquePtr<EC_KEY> privateKey(absl::string_view access_key_id,
+                                     absl::string_view secret_access_key) const;
+
+  struct PrivateKey {
+    std::string access_key_id_;
+    std::string secret_access_key_;
+    bssl::UniquePtr<EC_KEY> key_;
+  };
+
+  mutable absl::Mutex private_key_mutex_;
+  mutable PrivateKey private_key_ ABSL_GUARDED_BY(private_key_mutex_);
 };
 
 } // namespace Aws
@@ -109,18 +109,25 @@ DnsCacheImpl::loadDnsCacheEntryWithForceRefresh(absl::string_view raw_host, uint
             is_proxy_lookup ? "proxy mode " : "");
   ThreadLocalHostInfo& tls_host_info = *tls_slot_;
 
-  bool is_overflow = false;
+  const bool is_overflow = num_primary_hosts_ >= max_hosts_;
   absl::optional<DnsHostInfoSharedPtr> host_info = absl::nullopt;
   bool ignore_cached_entries = force_refresh;
 
-  {
+  if (Runtime::runtimeFeatureEnabled(
+          "envoy.reloadable_features.dns_cache_thread_local_resolved_hosts")) {
+    auto tls_host = tls_host_info.resolved_hosts_.find(host);
+    if (tls_host != tls_host_info.resolved_hosts_.end()) {
+      host_info = tls_host->second;
+    }
+  }
+  // The thread may not have received the latest resolution of the host yet.
+  if (!host_info) {
     absl::ReaderMutexLock read_lock{&primary_hosts_lock_};
-    is_overflow = primary_hosts_.size() >= max_hosts_;
     auto tls_host = primary_hosts_.find(host);
     if (tls_host != primary_hosts_.end() && tls_host->second->host_info_->firstResolveComplete()) {
       host_info = tls_host->second->host_info_;
     }
-  };
+  }
 
   if (host_info) {
     ENVOY_LOG(debug, "cache hit for host '{}'", host);
@@ -234,15 +241,18 @@ DnsCacheImpl::PrimaryHostInfo* DnsCacheImpl::createHost(const std::string& host,
   // matter, but we could consider collapsing these down and sharing the underlying DNS resolution.
   {
     absl::WriterMutexLock writer_lock{&primary_hosts_lock_};
-    return primary_hosts_
-        // try_emplace() is used here for direct argument forwarding.
-        .try_emplace(host,
-                     std::make_unique<PrimaryHostInfo>(
-                         *this, std::string(host_attributes.host_),
-                         host_attributes.port_.value_or(default_port),
-                         host_attributes.is_ip_address_, [this, host]() { onReResolveAlarm(host); },
-                         [this, host]() { onResolveTimeout(host); }))
-        .first->second.get();
+    PrimaryHostInfo* primary_host =
+        primary_hosts_
+            // try_emplace() is used here for direct argument forwarding.
+            .try_emplace(host, std::make_unique<PrimaryHostInfo>(
+                                   *this, std::string(host_attributes.host_),
+                                   host_attributes.port_.value_or(default_port),
+                                   host_attributes.is_ip_address_,
+                                   [this, host]() { onReResolveAlarm(host); },
+                                   [this, host]() { onResolveTimeout(host); }))
+            .first->second.get();
+    num_primary_hosts_ = primary_hosts_.size();
+    return primary_host;
   }
 }
 
@@ -303,7 +313,9 @@ void DnsCacheImpl::removeHost(const std::string& host, const PrimaryHostInfo& pr
     ASSERT(host_it != primary_hosts_.end());
     host_to_erase = std::move(host_it->second);
     primary_hosts_.erase(host_it);
+    num_primary_hosts_ = primary_hosts_.size();
   }
+  updateThreadSnapshots(host, nullptr);
   // In the case of force-remove and resolve, don't cancel outstanding resolve
   // callbacks on remove, as a resolve is pending.
   if (update_threads) {
@@ -460,6 +472,10 @@ void DnsCacheImpl::finishResolve(const std::string& host,
   if (first_resolve || (address_changed && !primary_host_info->host_info_->isStale())) {
     notifyThreads(host, primary_host_info->host_info_);
   }
+  if ((first_resolve || address_changed || current_address == nullptr) &&
+      primary_host_info->host_info_->firstResolveComplete()) {
+    updateThreadSnapshots(host, primary_host_info->host_info_);
+  }
 
   runResolutionCompleteCallbacks(host, primary_host_info->host_info_, status);
 
@@ -507,6 +523,20 @@ void DnsCacheImpl::notifyThreads(const std::string& host,
   });
 }
 
+void DnsCacheImpl::updateThreadSnapshots(const std::string& host,
+                                         const DnsHostInfoImplSharedPtr& host_info) {
+  // The snapshots are handed over whatever the runtime guard, so that none is stale if it flips.
+  DnsHostInfoSharedPtr snapshot =
+      host_info != nullptr ? std::make_shared<DnsHostSnapshotImpl>(host_info) : nullptr;
+  tls_slot_.runOnAllThreads([host, snapshot](OptRef<ThreadLocalHostInfo> local_host_info) {
+    if (snapshot != nullptr) {
+      local_host_info->resolved_hosts_[host] = snapshot;
+    } else {
+      local_host_info->resolved_hosts_.erase(host);
+    }
+  });
+}
+
 DnsCacheImpl::ThreadLocalHostInfo::~ThreadLocalHostInfo() {
   // Make sure we cancel any handles that still exist.
   for (const auto& per_host_list : pending_resolutions_) {
@@ -102,6 +102,9 @@ private:
     ~ThreadLocalHostInfo() override;
     void onHostMapUpdate(const HostMapUpdateInfoSharedPtr& resolved_info);
     absl::flat_hash_map<std::string, std::list<LoadDnsCacheEntryHandleImpl*>> pending_resolutions_;
+    // The resolved hosts as of the last resolution event received by the thread, which lets the
+    // cache hits take no lock.
+    absl::flat_hash_map<std::string, DnsHostInfoSharedPtr> resolved_hosts_;
     DnsCacheImpl& parent_;
   };
 
@@ -187,6 +190,31 @@ private:
     bool first_resolve_complete_ ABSL_GUARDED_BY(resolve_lock_){false};
   };
 
+  // An immutable copy of a resolved host, handed to the threads on each resolution event.
+  class DnsHostSnapshotImpl : public DnsHostInfo {
+  public:
+    DnsHostSnapshotImpl(const DnsHostInfoImplSharedPtr& host_info)
+        : host_info_(host_info), address_(host_info->address()),
+          address_list_(host_info->addressList()), details_(host_info->details()) {}
+
+    // DnsHostInfo
+    Network::Address::InstanceConstSharedPtr address() const override { return address_; }
+    std::vector<Network::Address::InstanceConstSharedPtr> addressList() const override {
+      return address_list_;
+    }
+    const std::string& resolvedHost() const override { return host_info_->resolvedHost(); }
+    bool isIpAddress() const override { return host_info_->isIpAddress(); }
+    void touch() override { host_info_->touch(); }
+    std::string details() override { return details_; }
+    bool firstResolveComplete() const override { return true; }
+
+  private:
+    const DnsHostInfoImplSharedPtr host_info_;
+    const Network::Address::InstanceConstSharedPtr address_;
+    const std::vector<Network::Address::InstanceConstSharedPtr> address_list_;
+    const std::string details_;
+  };
+
   // Primary host information that accounts for TTL, re-resolution, etc.
   struct PrimaryHostInfo {
     PrimaryHostInfo(DnsCacheImpl& parent, absl::string_view host_to_resolve, uint16_t port,
@@ -232,6 +260,8 @@ private:
                                       Network::DnsResolver::ResolutionStatus status);
   void runRemoveCallbacks(const std::string& host);
   void notifyThreads(const std::string& host, const DnsHostInfoImplSharedPtr& resolved_info);
+  // Hands a snapshot of the host to the threads, or removes it from them if host_info is null.
+  void updateThreadSnapshots(const std::string& host, const DnsHostInfoImplSharedPtr& host_info);
   void onReResolveAlarm(const std::string& host);
   void removeHost(const std::string& host, const PrimaryHostInfo& host_info, bool update_threads);
   void onResolveTimeout(const std::string& host);
@@ -260,6 +290,8 @@ private:
   absl::Mutex primary_hosts_lock_;
   absl::flat_hash_map<std::string, PrimaryHostInfoPtr>
       primary_hosts_ ABSL_GUARDED_BY(primary_hosts_lock_);
+  // The size of primary_hosts_, readable without the lock.
+  std::atomic<size_t> num_primary_hosts_{};
   std::unique_ptr<KeyValueStore> key_value_store_;
   DnsCacheResourceManagerImpl resource_manager_;
   const std::chrono::milliseconds refresh_interval_;
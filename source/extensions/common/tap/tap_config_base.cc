@@ -46,17 +46,29 @@ bool Utility::addBufferToProtoBytes(envoy::data::tap::v3::Body& output_body,
   }
 }
 
+namespace {
+
+using TsfContextRef = std::reference_wrapper<Server::Configuration::TransportSocketFactoryContext>;
+using HttpContextRef = std::reference_wrapper<Server::Configuration::FactoryContext>;
+
+Server::Configuration::CommonFactoryContext& serverContext(SinkContext context) {
+  if (absl::holds_alternative<TsfContextRef>(context)) {
+    return absl::get<TsfContextRef>(context).get().serverFactoryContext();
+  }
+  return absl::get<HttpContextRef>(context).get().serverFactoryContext();
+}
+
+} // namespace
+
 TapConfigBaseImpl::TapConfigBaseImpl(const envoy::config::tap::v3::TapConfig& proto_config,
                                      Common::Tap::Sink* admin_streamer, SinkContext context)
     : max_buffered_rx_bytes_(PROTOBUF_GET_WRAPPED_OR_DEFAULT(
           proto_config.output_config(), max_buffered_rx_bytes, DefaultMaxBufferedBytes)),
       max_buffered_tx_bytes_(PROTOBUF_GET_WRAPPED_OR_DEFAULT(
           proto_config.output_config(), max_buffered_tx_bytes, DefaultMaxBufferedBytes)),
-      streaming_(proto_config.output_config().streaming()) {
+      streaming_(proto_config.output_config().streaming()),
+      stats_({ALL_TAP_STATS(POOL_COUNTER_PREFIX(serverContext(context).scope(), "tap."))}) {
 
-  using TsfContextRef =
-      std::reference_wrapper<Server::Configuration::TransportSocketFactoryContext>;
-  using HttpContextRef = std::reference_wrapper<Server::Configuration::FactoryContext>;
   using ProtoOutputSink = envoy::config::tap::v3::OutputSink;
   auto& sinks = proto_config.output_config().sinks();
   ASSERT(sinks.size() == 1);
@@ -143,16 +155,29 @@ TapConfigBaseImpl::TapConfigBaseImpl(const envoy::config::tap::v3::TapConfig& pr
                                      proto_config.DebugString()));
   }
 
-  Server::Configuration::CommonFactoryContext* server_context = nullptr;
-  if (absl::holds_alternative<TsfContextRef>(context)) {
-    Server::Configuration::TransportSocketFactoryContext& tsf_context =
-        absl::get<TsfContextRef>(context).get();
-    server_context = &tsf_context.serverFactoryContext();
-  } else {
-    Server::Configuration::FactoryContext& http_context = absl::get<HttpContextRef>(context).get();
-    server_context = &http_context.serverFactoryContext();
+  Server::Configuration::CommonFactoryContext& server_context = serverContext(context);
+  buildMatcher(match, matchers_, server_context);
+
+  if (proto_config.has_tap_enabled()) {
+    tap_enabled_.emplace(proto_config.tap_enabled(), server_context.runtime());
+  }
+  if (proto_config.has_max_taps_per_second()) {
+    const uint32_t max_taps_per_second = proto_config.max_taps_per_second().value();
+    rate_limiter_ = std::make_unique<SharedTokenBucketImpl>(
+        max_taps_per_second, server_context.timeSource(), max_taps_per_second);
   }
-  buildMatcher(match, matchers_, *server_context);
+}
+
+bool TapConfigBaseImpl::admit(bool sampled) {
+  if (!sampled) {
+    stats_.taps_not_sampled_.inc();
+    return false;
+  }
+  if (rate_limiter_ != nullptr && rate_limiter_->consume(1, false) == 0) {
+    stats_.taps_rate_limited_.inc();
+    return false;
+  }
+  return true;
 }
 
 const Matcher& TapConfigBaseImpl::rootMatcher() const {
@@ -222,6 +247,12 @@ void Utility::bodyBytesToString(envoy::data::tap::v3::TraceWrapper& trace,
 }
 
 void TapConfigBaseImpl::PerTapSinkHandleManagerImpl::submitTrace(TraceWrapperPtr&& trace) {
+  if (!admitted_.has_value()) {
+    admitted_ = parent_.admit(sampled_);
+  }
+  if (!admitted_.value()) {
+    return;
+  }
   Utility::bodyBytesToString(*trace, parent_.sink_format_);
   handle_->submitTrace(std::move(trace), parent_.sink_format_);
 }
@@ -6,10 +6,16 @@
 #include "envoy/config/tap/v3/common.pb.h"
 #include "envoy/data/tap/v3/common.pb.h"
 #include "envoy/data/tap/v3/wrapper.pb.h"
+#include "envoy/stats/scope.h"
+#include "envoy/stats/stats_macros.h"
 
+#include "source/common/common/shared_token_bucket_impl.h"
+#include "source/common/runtime/runtime_protos.h"
 #include "source/extensions/common/matcher/matcher.h"
 #include "source/extensions/common/tap/tap.h"
 
+#include "absl/types/optional.h"
+
 namespace Envoy {
 namespace Extensions {
 namespace Common {
@@ -68,8 +74,21 @@ public:
 };
 
 /**
- * Base class for all tap configurations.
- * TODO(mattklein123): This class will handle common functionality such as rate limiting, etc.
+ * All stats for the taps. @see stats_macros.h
+ */
+#define ALL_TAP_STATS(COUNTER)                                                                     \
+  COUNTER(taps_not_sampled)                                                                        \
+  COUNTER(taps_rate_limited)
+
+/**
+ * Struct definition for all tap stats. @see stats_macros.h
+ */
+struct TapStats {
+  ALL_TAP_STATS(GENERATE_COUNTER_STRUCT)
+};
+
+/**
+ * Base class for all tap configurations. It handles the sampling and the rate limiting of the taps.
  */
 class TapConfigBaseImpl : public virtual TapConfig {
 public:
@@ -79,7 +98,8 @@ public:
   public:
     PerTapSinkHandleManagerImpl(TapConfigBaseImpl& parent, uint64_t trace_id)
         : parent_(parent),
-          handle_(parent.sink_to_use_->createPerTapSinkHandle(trace_id, parent.sink_type_)) {}
+          handle_(parent.sink_to_use_->createPerTapSinkHandle(trace_id, parent.sink_type_)),
+          sampled_(parent.sampled()) {}
 
     // PerTapSinkHandleManager
     void submitTrace(TraceWrapperPtr&& trace) override;
@@ -87,6 +107,9 @@ public:
   private:
     TapConfigBaseImpl& parent_;
     PerTapSinkHandlePtr handle_;
+    const bool sampled_;
+    // Whether the traces of the tap are submitted to the sink, decided with its first trace.
+    absl::optional<bool> admitted_;
   };
 
   // TapConfig
@@ -110,6 +133,12 @@ private:
   // maximum amount that can be buffered is 2x this value).
   static constexpr uint32_t DefaultMaxBufferedBytes = 1024;
 
+  // Returns whether a new tap is sampled by tap_enabled.
+  bool sampled() const { return !tap_enabled_.has_value() || tap_enabled_->enabled(); }
+  // Returns whether the traces of a tap which matched are submitted to the sink, counting the taps
+  // which are dropped.
+  bool admit(bool sampled);
+
   const uint32_t max_buffered_rx_bytes_;
   const uint32_t max_buffered_tx_bytes_;
   const bool streaming_;
@@ -118,6 +147,9 @@ private:
   envoy::config::tap::v3::OutputSink::Format sink_format_;
   envoy::config::tap::v3::OutputSink::OutputSinkTypeCase sink_type_;
   std::vector<MatcherPtr> matchers_;
+  absl::optional<Runtime::FractionalPercent> tap_enabled_;
+  std::unique_ptr<SharedTokenBucketImpl> rate_limiter_;
+  TapStats stats_;
 };
 
 /**
@@ -0,0 +1,132 @@
+#include "source/extensions/common/wasm/compilation_cache.h"
+
+#include "source/common/buffer/buffer_impl.h"
+#include "source/common/common/hex.h"
+#include "source/common/crypto/utility.h"
+
+#include "absl/strings/match.h"
+#include "absl/strings/str_cat.h"
+#include "include/proxy-wasm/bytecode_util.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace Common {
+namespace Wasm {
+namespace {
+
+void appendVarint(std::string& out, uint32_t value) {
+  do {
+    uint8_t byte = value & 0x7f;
+    value >>= 7;
+    if (value != 0) {
+      byte |= 0x80;
+    }
+    out.push_back(static_cast<char>(byte));
+  } while (value != 0);
+}
+
+} // namespace
+
+absl::optional<PrecompiledCode> CompilationCache::getOrCreate(const std::string& code,
+                                                              absl::string_view section_name,
+                                                              const PrecompileFn& precompile) {
+  std::string_view precompiled;
+  if (section_name.empty() ||
+      !proxy_wasm::BytecodeUtil::getCustomSection(code, section_name, precompiled) ||
+      !precompiled.empty()) {
+    return absl::nullopt;
+  }
+
+  const std::string cache_path = path(code, section_name);
+  if (file_system_.fileExists(cache_path)) {
+    auto cached = file_system_.fileReadToEnd(cache_path);
+    // The cached code is the code with a precompiled section appended, and is discarded if it was
+    // only partially written.
+    if (cached.ok() && absl::StartsWith(cached.value(), code) &&
+        proxy_wasm::BytecodeUtil::getCustomSection(cached.value(), section_name, precompiled) &&
+        !precompiled.empty()) {
+      ENVOY_LOG(debug, "Loaded the compiled Wasm module from {}", cache_path);
+      return PrecompiledCode{std::move(cached.value()), true};
+    }
+    ENVOY_LOG(warn, "Ignoring the invalid compiled Wasm module in {}", cache_path);
+  }
+
+  std::string stripped;
+  if (!proxy_wasm::BytecodeUtil::getStrippedSource(code, stripped)) {
+    return absl::nullopt;
+  }
+  const std::string serialized = precompile(stripped);
+  if (serialized.empty()) {
+    ENVOY_LOG(debug, "The Wasm runtime didn't precompile the module");
+    return absl::nullopt;
+  }
+  std::string precompiled_code = appendCustomSection(code, section_name, serialized);
+  write(cache_path, precompiled_code);
+  return PrecompiledCode{std::move(precompiled_code), false};
+}
+
+std::string CompilationCache::appendCustomSection(const std::string& code, absl::string_view name,
+                                                  absl::string_view contents) {
+  std::string name_size;
+  appendVarint(name_size, name.size());
+  std::string out = code;
+  out.push_back('\0'); // Custom section.
+  appendVarint(out, name_size.size() + name.size() + contents.size());
+  absl::StrAppend(&out, name_size, name, contents);
+  return out;
+}
+
+std::string CompilationCache::cpuFeatures() {
+  std::string features;
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+  __builtin_cpu_init();
+#define APPEND_CPU_FEATURE(feature)                                                                \
+  if (__builtin_cpu_supports(feature)) {                                                           \
+    absl::StrAppend(&features, feature, ",");                                                      \
+  }
+  APPEND_CPU_FEATURE("popcnt")
+  APPEND_CPU_FEATURE("sse4.1")
+  APPEND_CPU_FEATURE("sse4.2")
+  APPEND_CPU_FEATURE("avx")
+  APPEND_CPU_FEATURE("avx2")
+  APPEND_CPU_FEATURE("bmi")
+  APPEND_CPU_FEATURE("bmi2")
+  APPEND_CPU_FEATURE("fma")
+  APPEND_CPU_FEATURE("avx512f")
+#undef APPEND_CPU_FEATURE
+#endif
+  return features;
+}
+
+std::string CompilationCache::path(const std::string& code, absl::string_view section_name) const {
+  Buffer::OwnedImpl key;
+  key.add(code);
+  key.add(absl::StrCat(";", section_name, ";", cpuFeatures()));
+  const std::vector<uint8_t> digest =
+      Envoy::Common::Crypto::UtilitySingleton::get().getSha256Digest(key);
+  return absl::StrCat(directory_, "/", Hex::encode(digest), ".wasm");
+}
+
+void CompilationCache::write(const std::string& path, absl::string_view contents) {
+  static constexpr Filesystem::FlagSet DefaultFlags{1 << Filesystem::File::Operation::Write |
+                                                    1 << Filesystem::File::Operation::Create};
+  if (!file_system_.directoryExists(directory_) &&
+      !file_system_.createPath(directory_).return_value_) {
+    ENVOY_LOG(warn, "Failed to create the Wasm compilation cache directory {}", directory_);
+    return;
+  }
+  Filesystem::FilePathAndType file_info{Filesystem::DestinationType::File, path};
+  auto file = file_system_.createFile(file_info);
+  if (!file || !file->open(DefaultFlags).return_value_) {
+    ENVOY_LOG(warn, "Failed to write the compiled Wasm module to {}", path);
+    return;
+  }
+  file->write(contents);
+  file->close();
+  ENVOY_LOG(debug, "Wrote the compiled Wasm module to {}", path);
+}
+
+} // namespace Wasm
+} // namespace Common
+} // namespace Extensions
+} // namespace Envoy
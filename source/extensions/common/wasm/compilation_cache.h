@@ -0,0 +1,61 @@
+#pragma once
+
+#include <functional>
+#include <string>
+
+#include "envoy/filesystem/filesystem.h"
+
+#include "source/common/common/logger.h"
+
+#include "absl/strings/string_view.h"
+#include "absl/types/optional.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace Common {
+namespace Wasm {
+
+// Compiles the stripped bytecode of a module and returns it serialized, or an empty string if it
+// can't.
+using PrecompileFn = std::function<std::string(absl::string_view stripped_bytecode)>;
+
+struct PrecompiledCode {
+  // The code with the compiled module in its precompiled section.
+  std::string code;
+  // Whether the compiled module was read from the cache rather than compiled.
+  bool cache_hit;
+};
+
+// An on-disk cache of compiled modules, keyed by the hash of the code, the precompiled section
+// name of the runtime, which identifies its version and platform, and the CPU features, so that
+// the VMs created for the same code, on this or a later start of Envoy, load the compiled module
+// instead of compiling the code.
+class CompilationCache : public Logger::Loggable<Logger::Id::wasm> {
+public:
+  CompilationCache(Filesystem::Instance& file_system, absl::string_view directory)
+      : file_system_(file_system), directory_(directory) {}
+
+  // Returns the code with the compiled module in the section, read from the cache or compiled and
+  // written to it, or nullopt if the code already has a precompiled module or can't be compiled.
+  absl::optional<PrecompiledCode> getOrCreate(const std::string& code,
+                                              absl::string_view section_name,
+                                              const PrecompileFn& precompile);
+
+  // Returns the code with a custom section appended.
+  static std::string appendCustomSection(const std::string& code, absl::string_view name,
+                                         absl::string_view contents);
+  // Returns the flags of the CPU features the compiled code may depend on.
+  static std::string cpuFeatures();
+
+private:
+  std::string path(const std::string& code, absl::string_view section_name) const;
+  void write(const std::string& path, absl::string_view contents);
+
+  Filesystem::Instance& file_system_;
+  const std::string directory_;
+};
+
+} // namespace Wasm
+} // namespace Common
+} // namespace Extensions
+} // namespace Envoy
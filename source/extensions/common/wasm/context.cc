@@ -138,6 +138,14 @@ WasmResult Buffer::copyTo(WasmBase* wasm, size_t start, size_t length, uint64_t
   return proxy_wasm::BufferBase::copyTo(wasm, start, length, ptr_ptr, size_ptr);
 }
 
+absl::optional<ssize_t> Buffer::search(std::string_view pattern, size_t start,
+                                       size_t length) const {
+  if (!const_buffer_instance_) {
+    return absl::nullopt;
+  }
+  return const_buffer_instance_->search(pattern.data(), pattern.size(), start, length);
+}
+
 WasmResult Buffer::copyFrom(size_t start, size_t length, std::string_view data) {
   if (buffer_instance_) {
     if (start == 0) {
@@ -849,6 +857,56 @@ WasmResult Context::getHeaderMapSize(WasmHeaderMapType type, uint32_t* result) {
   return WasmResult::Ok;
 }
 
+WasmResult Context::getHeaderMapValues(WasmHeaderMapType type,
+                                       const std::vector<std::string_view>& keys, Pairs* result) {
+  auto map = getConstMap(type);
+  if (!map) {
+    return WasmResult::BadArgument;
+  }
+  result->clear();
+  for (const std::string_view key : keys) {
+    const Http::LowerCaseString lower_key{std::string(key)};
+    const auto entry = map->get(lower_key);
+    for (size_t i = 0; i < entry.size(); i++) {
+      result->emplace_back(toStdStringView(entry[i]->key().getStringView()),
+                           toStdStringView(entry[i]->value().getStringView()));
+    }
+  }
+  return WasmResult::Ok;
+}
+
+WasmResult Context::mutateHeaderMap(WasmHeaderMapType type,
+                                    const std::function<void(Http::HeaderMap&)>& mutate) {
+  auto map = getMap(type);
+  if (!map) {
+    return WasmResult::BadArgument;
+  }
+  mutate(*map);
+  // The route cache is cleared once for all the mutations.
+  if (type == WasmHeaderMapType::RequestHeaders) {
+    clearRouteCache();
+  }
+  return WasmResult::Ok;
+}
+
+WasmResult Context::searchBuffer(WasmBufferType type, std::string_view pattern, uint64_t start,
+                                 uint64_t length, int64_t* offset) {
+  // getBuffer returns the buffer of the context, or nullptr.
+  const auto* buffer = static_cast<const Buffer*>(getBuffer(type));
+  if (!buffer) {
+    return WasmResult::NotFound;
+  }
+  if (start > buffer->size()) {
+    return WasmResult::BadArgument;
+  }
+  const absl::optional<ssize_t> found = buffer->search(pattern, start, length);
+  if (!found.has_value()) {
+    return WasmResult::Unimplemented;
+  }
+  *offset = found.value();
+  return WasmResult::Ok;
+}
+
 // Buffer
 
 BufferInterface* Context::getBuffer(WasmBufferType type) {
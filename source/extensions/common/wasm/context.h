@@ -17,6 +17,7 @@
 #include "source/extensions/filters/common/expr/cel_state.h"
 #include "source/extensions/filters/common/expr/evaluator.h"
 
+#include "absl/types/optional.h"
 #include "eval/public/activation.h"
 #include "include/proxy-wasm/wasm.h"
 
@@ -70,6 +71,11 @@ public:
                     uint64_t size_ptr) const override;
   WasmResult copyFrom(size_t start, size_t length, std::string_view data) override;
 
+  // Returns the offset of the first occurrence of the pattern in the length bytes from start, or
+  // in all of them from start if length is zero, or -1 if there's none. Returns nullopt if the
+  // buffer doesn't wrap an Envoy buffer.
+  absl::optional<ssize_t> search(std::string_view pattern, size_t start, size_t length) const;
+
   // proxy_wasm::BufferBase
   void clear() override {
     proxy_wasm::BufferBase::clear();
@@ -236,6 +242,15 @@ public:
 
   WasmResult getHeaderMapSize(WasmHeaderMapType type, uint32_t* size) override;
 
+  // Batched accessors, exposed as foreign functions so that the plugins read or mutate several
+  // headers in a single call, and scan the bodies without copying them into the VM.
+  WasmResult getHeaderMapValues(WasmHeaderMapType type, const std::vector<std::string_view>& keys,
+                                Pairs* result);
+  WasmResult mutateHeaderMap(WasmHeaderMapType type,
+                             const std::function<void(Http::HeaderMap&)>& mutate);
+  WasmResult searchBuffer(WasmBufferType type, std::string_view pattern, uint64_t start,
+                          uint64_t length, int64_t* offset);
+
   // Buffer
   BufferInterface* getBuffer(WasmBufferType type) override;
   // TODO: use stream_type.
@@ -7,6 +7,7 @@
 #include "envoy/config/core/v3/grpc_service.pb.h"
 
 #include "source/extensions/common/wasm/ext/declare_property.pb.h"
+#include "source/extensions/common/wasm/ext/header_map_and_buffer.pb.h"
 #include "source/extensions/common/wasm/ext/verify_signature.pb.h"
 
 #include "include/proxy-wasm/null_plugin.h"
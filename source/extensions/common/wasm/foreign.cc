@@ -1,5 +1,6 @@
 #include "source/common/common/logger.h"
 #include "source/extensions/common/wasm/ext/declare_property.pb.h"
+#include "source/extensions/common/wasm/ext/header_map_and_buffer.pb.h"
 #include "source/extensions/common/wasm/ext/set_envoy_filter_state.pb.h"
 #include "source/extensions/common/wasm/ext/verify_signature.pb.h"
 #include "source/extensions/common/wasm/wasm.h"
@@ -9,6 +10,7 @@
 #include "eval/public/cel_expr_builder_factory.h"
 #include "parser/parser.h"
 #endif
+#include "include/proxy-wasm/pairs_util.h"
 #include "zlib.h"
 #include "source/common/crypto/crypto_impl.h"
 #include "source/common/crypto/utility.h"
@@ -126,6 +128,86 @@ RegisterForeignFunction registerSetEnvoyFilterStateForeignFunction(
       return WasmResult::BadArgument;
     });
 
+RegisterForeignFunction registerGetHeaderMapValuesForeignFunction(
+    "get_header_map_values",
+    [](WasmBase&, std::string_view arguments,
+       const std::function<void*(size_t size)>& alloc_result) -> WasmResult {
+      envoy::source::extensions::common::wasm::GetHeaderMapValuesArguments args;
+      if (!args.ParseFromArray(arguments.data(), arguments.size())) {
+        return WasmResult::BadArgument;
+      }
+      std::vector<std::string_view> keys(args.keys().begin(), args.keys().end());
+      Pairs pairs;
+      auto context = static_cast<Context*>(proxy_wasm::current_context_);
+      auto status = context->getHeaderMapValues(static_cast<WasmHeaderMapType>(args.map_type()),
+                                                keys, &pairs);
+      if (status != WasmResult::Ok) {
+        return status;
+      }
+      auto size = proxy_wasm::PairsUtil::pairsSize(pairs);
+      auto result = alloc_result(size);
+      if (!proxy_wasm::PairsUtil::marshalPairs(pairs, static_cast<char*>(result), size)) {
+        return WasmResult::SerializationFailure;
+      }
+      return WasmResult::Ok;
+    });
+
+RegisterForeignFunction registerMutateHeaderMapForeignFunction(
+    "mutate_header_map",
+    [](WasmBase&, std::string_view arguments,
+       const std::function<void*(size_t size)>&) -> WasmResult {
+      envoy::source::extensions::common::wasm::MutateHeaderMapArguments args;
+      if (!args.ParseFromArray(arguments.data(), arguments.size())) {
+        return WasmResult::BadArgument;
+      }
+      auto context = static_cast<Context*>(proxy_wasm::current_context_);
+      return context->mutateHeaderMap(
+          static_cast<WasmHeaderMapType>(args.map_type()), [&args](Http::HeaderMap& map) {
+            using Mutation = envoy::source::extensions::common::wasm::HeaderMapMutation;
+            for (const Mutation& mutation : args.mutations()) {
+              const Http::LowerCaseString key{mutation.key()};
+              switch (mutation.operation()) {
+              case Mutation::Add:
+                map.addCopy(key, mutation.value());
+                break;
+              case Mutation::Replace:
+                map.setCopy(key, mutation.value());
+                break;
+              case Mutation::Remove:
+                map.remove(key);
+                break;
+              default:
+                break;
+              }
+            }
+          });
+    });
+
+RegisterForeignFunction registerSearchBufferForeignFunction(
+    "search_buffer",
+    [](WasmBase&, std::string_view arguments,
+       const std::function<void*(size_t size)>& alloc_result) -> WasmResult {
+      envoy::source::extensions::common::wasm::SearchBufferArguments args;
+      if (!args.ParseFromArray(arguments.data(), arguments.size())) {
+        return WasmResult::BadArgument;
+      }
+      auto context = static_cast<Context*>(proxy_wasm::current_context_);
+      envoy::source::extensions::common::wasm::SearchBufferResult search_result;
+      for (const std::string& pattern : args.patterns()) {
+        int64_t offset;
+        auto status = context->searchBuffer(static_cast<WasmBufferType>(args.buffer_type()),
+                                            pattern, args.start(), args.length(), &offset);
+        if (status != WasmResult::Ok) {
+          return status;
+        }
+        search_result.add_offsets(offset);
+      }
+      auto size = search_result.ByteSizeLong();
+      auto result = alloc_result(size);
+      search_result.SerializeToArray(result, static_cast<int>(size));
+      return WasmResult::Ok;
+    });
+
 #if defined(WASM_USE_CEL_PARSER)
 class ExpressionFactory : public Logger::Loggable<Logger::Id::wasm> {
 protected:
@@ -29,6 +29,12 @@ void CreateStatsHandler::resetStatsForTesting() {
 
 void CreateStatsHandler::onEvent(WasmEvent event) {
   switch (event) {
+  case WasmEvent::CompilationCacheHit:
+    create_wasm_stats_->compilation_cache_hits_.inc();
+    break;
+  case WasmEvent::CompilationCacheMiss:
+    create_wasm_stats_->compilation_cache_misses_.inc();
+    break;
   case WasmEvent::RemoteLoadCacheHit:
     create_wasm_stats_->remote_load_cache_hits_.inc();
     break;
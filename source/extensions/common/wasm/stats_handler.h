@@ -20,6 +20,8 @@ namespace Wasm {
 constexpr absl::string_view CustomStatNamespace = "wasmcustom";
 
 #define CREATE_WASM_STATS(COUNTER, GAUGE)                                                          \
+  COUNTER(compilation_cache_hits)                                                                  \
+  COUNTER(compilation_cache_misses)                                                                \
   COUNTER(remote_load_cache_hits)                                                                  \
   COUNTER(remote_load_cache_negative_hits)                                                         \
   COUNTER(remote_load_cache_misses)                                                                \
@@ -43,6 +45,8 @@ using ScopeWeakPtr = std::weak_ptr<Stats::Scope>;
 
 enum class WasmEvent : int {
   Ok,
+  CompilationCacheHit,
+  CompilationCacheMiss,
   RemoteLoadCacheHit,
   RemoteLoadCacheNegativeHit,
   RemoteLoadCacheMiss,
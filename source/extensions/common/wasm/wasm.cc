@@ -7,9 +7,11 @@
 
 #include "source/common/common/logger.h"
 #include "source/common/network/dns_resolver/dns_factory_util.h"
+#include "source/extensions/common/wasm/compilation_cache.h"
 #include "source/extensions/common/wasm/plugin.h"
 #include "source/extensions/common/wasm/remote_async_datasource.h"
 #include "source/extensions/common/wasm/stats_handler.h"
+#include "source/extensions/common/wasm/wasm_runtime_factory.h"
 
 #include "absl/strings/str_cat.h"
 
@@ -61,6 +63,27 @@ inline Wasm* getWasm(WasmHandleSharedPtr& base_wasm_handle) {
   return static_cast<Wasm*>(base_wasm_handle->wasm().get());
 }
 
+// Returns the code with its module compiled by the runtime, from the compilation cache, or nullopt
+// if the runtime can't precompile it.
+absl::optional<PrecompiledCode>
+getPrecompiledCode(const envoy::extensions::wasm::v3::VmConfig& vm_config, const std::string& code,
+                   Api::Api& api) {
+  absl::string_view runtime = vm_config.runtime();
+  if (runtime.empty()) {
+    runtime = getFirstAvailableWasmEngineName();
+  }
+  auto* runtime_factory = Registry::FactoryRegistry<WasmRuntimeFactory>::getFactory(runtime);
+  if (runtime_factory == nullptr) {
+    return absl::nullopt;
+  }
+  // The section name identifies the version and the platform of the runtime.
+  const std::string section_name(runtime_factory->createWasmVm()->getPrecompiledSectionName());
+  CompilationCache cache(api.fileSystem(), vm_config.compilation_cache_dir());
+  return cache.getOrCreate(code, section_name, [runtime_factory](absl::string_view bytecode) {
+    return runtime_factory->precompile(bytecode);
+  });
+}
+
 } // namespace
 
 void Wasm::initializeLifecycle(Server::ServerLifecycleNotifier& lifecycle_notifier) {
@@ -394,12 +417,28 @@ bool createWasm(const PluginSharedPtr& plugin, const Stats::ScopeSharedPtr& scop
     }
 
     auto config = plugin->wasmConfig();
+    const auto& vm_config = config.config().vm_config();
+    bool allow_precompiled = vm_config.allow_precompiled();
+    absl::optional<PrecompiledCode> precompiled;
+    if (!vm_config.compilation_cache_dir().empty()) {
+      precompiled = getPrecompiledCode(vm_config, code, api);
+      if (precompiled.has_value()) {
+        // The section was compiled by Envoy, so it can be trusted like the code.
+        code = std::move(precompiled->code);
+        allow_precompiled = true;
+      }
+    }
+    // The base VM of the key is reused if it exists, and is cloned to the workers, which share its
+    // compiled module.
     auto wasm = proxy_wasm::createWasm(
         vm_key, code, plugin,
         getWasmHandleFactory(config, scope, api, cluster_manager, dispatcher, lifecycle_notifier),
-        getWasmHandleCloneFactory(dispatcher, create_root_context_for_testing),
-        config.config().vm_config().allow_precompiled());
+        getWasmHandleCloneFactory(dispatcher, create_root_context_for_testing), allow_precompiled);
     Stats::ScopeSharedPtr create_wasm_stats_scope = stats_handler.lockAndCreateStats(scope);
+    if (precompiled.has_value()) {
+      stats_handler.onEvent(precompiled->cache_hit ? WasmEvent::CompilationCacheHit
+                                                   : WasmEvent::CompilationCacheMiss);
+    }
     stats_handler.onEvent(toWasmEvent(wasm));
     if (!wasm || wasm->wasm()->isFailed()) {
       ENVOY_LOG_TO_LOGGER(Envoy::Logger::Registry::getLog(Envoy::Logger::Id::wasm), trace,
@@ -18,6 +18,13 @@ public:
   ~WasmRuntimeFactory() override = default;
   virtual WasmVmPtr createWasmVm() PURE;
 
+  /**
+   * Compiles the stripped bytecode of a module ahead of time.
+   * @return the compiled module, serialized in the format of the precompiled section of the
+   *         runtime, or an empty string if the runtime doesn't support it.
+   */
+  virtual std::string precompile(absl::string_view) { return ""; }
+
   std::string category() const override { return "envoy.wasm.runtime"; }
 };
 
@@ -0,0 +1,32 @@
+#include "source/extensions/compression/brotli/common/dictionary.h"
+
+#include "source/common/buffer/buffer_impl.h"
+#include "source/common/crypto/utility.h"
+
+#include "absl/strings/str_cat.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace Compression {
+namespace Brotli {
+namespace Common {
+
+namespace {
+
+std::string sha256(absl::string_view content) {
+  const std::vector<uint8_t> digest =
+      Envoy::Common::Crypto::UtilitySingleton::get().getSha256Digest(Buffer::OwnedImpl(content));
+  return {digest.begin(), digest.end()};
+}
+
+} // namespace
+
+Dictionary::Dictionary(std::string&& content)
+    : content_(std::move(content)), hash_(sha256(content_)),
+      stream_header_(absl::StrCat(DictionaryStreamMagic, hash_)) {}
+
+} // namespace Common
+} // namespace Brotli
+} // namespace Compression
+} // namespace Extensions
+} // namespace Envoy
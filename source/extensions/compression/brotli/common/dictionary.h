@@ -0,0 +1,117 @@
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <string>
+
+#include "envoy/api/api.h"
+#include "envoy/config/core/v3/base.pb.h"
+#include "envoy/event/dispatcher.h"
+#include "envoy/filesystem/watcher.h"
+#include "envoy/thread_local/thread_local.h"
+
+#include "source/common/config/datasource.h"
+
+#include "absl/strings/string_view.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace Compression {
+namespace Brotli {
+namespace Common {
+
+// The magic number starting the streams of the "dcb" content encoding. It is followed by the
+// SHA-256 hash of the dictionary the stream is compressed with.
+constexpr absl::string_view DictionaryStreamMagic{"\xff\x44\x43\x42", 4};
+
+// The size of the header of the "dcb" streams.
+constexpr size_t DictionaryStreamHeaderSize = DictionaryStreamMagic.size() + 32;
+
+/**
+ * A raw shared dictionary, with its SHA-256 hash which identifies it in the
+ * "available-dictionary" request header and in the header of the streams compressed with it.
+ */
+class Dictionary {
+public:
+  explicit Dictionary(std::string&& content);
+  virtual ~Dictionary() = default;
+
+  const std::string& content() const { return content_; }
+  // The raw bytes of the SHA-256 hash of the content.
+  const std::string& hash() const { return hash_; }
+  // The header of the "dcb" streams compressed with the dictionary.
+  const std::string& streamHeader() const { return stream_header_; }
+
+private:
+  const std::string content_;
+  const std::string hash_;
+  const std::string stream_header_;
+};
+
+/**
+ * Loads a dictionary from a data source, and reloads it when the file it is read from changes.
+ * Each version of the dictionary is built once, on the main thread, and shared by the workers,
+ * which each use the last version published to them.
+ */
+template <class T> class DictionaryManager {
+public:
+  using DictionaryBuilder = std::function<std::shared_ptr<const T>(std::string&& content)>;
+
+  DictionaryManager(const envoy::config::core::v3::DataSource& source,
+                    Event::Dispatcher& dispatcher, Api::Api& api, ThreadLocal::SlotAllocator& tls,
+                    DictionaryBuilder builder)
+      : api_(api), tls_slot_(ThreadLocal::TypedSlot<ThreadLocalDictionary>::makeUnique(tls)),
+        builder_(std::move(builder)) {
+    std::shared_ptr<const T> dictionary = builder_(
+        THROW_OR_RETURN_VALUE(Config::DataSource::read(source, false, api), std::string));
+    tls_slot_->set([dictionary](Event::Dispatcher&) {
+      return std::make_shared<ThreadLocalDictionary>(dictionary);
+    });
+
+    if (source.specifier_case() ==
+        envoy::config::core::v3::DataSource::SpecifierCase::kFilename) {
+      watcher_ = dispatcher.createFilesystemWatcher();
+      THROW_IF_NOT_OK(watcher_->addWatch(
+          source.filename(),
+          Filesystem::Watcher::Events::Modified | Filesystem::Watcher::Events::MovedTo,
+          [this, filename = source.filename()](uint32_t) {
+            onDictionaryUpdate(filename);
+            return absl::OkStatus();
+          }));
+    }
+  }
+
+  // Returns the dictionary of the current thread.
+  std::shared_ptr<const T> dictionary() const { return tls_slot_->get()->dictionary_; }
+
+private:
+  struct ThreadLocalDictionary : public ThreadLocal::ThreadLocalObject {
+    explicit ThreadLocalDictionary(std::shared_ptr<const T> dictionary)
+        : dictionary_(std::move(dictionary)) {}
+
+    std::shared_ptr<const T> dictionary_;
+  };
+
+  void onDictionaryUpdate(const std::string& filename) {
+    auto file_or_error = api_.fileSystem().fileReadToEnd(filename);
+    // The dictionary in use is kept if the file can't be read, or is empty while it is rewritten.
+    if (!file_or_error.ok() || file_or_error.value().empty()) {
+      return;
+    }
+    std::shared_ptr<const T> dictionary = builder_(std::move(file_or_error.value()));
+    tls_slot_->runOnAllThreads([dictionary](OptRef<ThreadLocalDictionary> tls_dictionary) {
+      tls_dictionary->dictionary_ = dictionary;
+    });
+  }
+
+  Api::Api& api_;
+  ThreadLocal::TypedSlotPtr<ThreadLocalDictionary> tls_slot_;
+  const DictionaryBuilder builder_;
+  Filesystem::WatcherPtr watcher_;
+};
+
+} // namespace Common
+} // namespace Brotli
+} // namespace Compression
+} // namespace Extensions
+} // namespace Envoy
@@ -8,12 +8,24 @@ namespace Compression {
 namespace Brotli {
 namespace Compressor {
 
+PreparedDictionary::PreparedDictionary(std::string&& content)
+    : Common::Dictionary(std::move(content)),
+      prepared_(BrotliEncoderPrepareDictionary(
+                    BROTLI_SHARED_DICTIONARY_RAW, this->content().size(),
+                    reinterpret_cast<const uint8_t*>(this->content().data()), BROTLI_MAX_QUALITY,
+                    nullptr, nullptr, nullptr),
+                &BrotliEncoderDestroyPreparedDictionary) {
+  RELEASE_ASSERT(prepared_ != nullptr, "unable to prepare the brotli dictionary");
+}
+
 BrotliCompressorImpl::BrotliCompressorImpl(const uint32_t quality, const uint32_t window_bits,
                                            const uint32_t input_block_bits,
                                            const bool disable_literal_context_modeling,
-                                           const EncoderMode mode, const uint32_t chunk_size)
-    : chunk_size_{chunk_size}, state_(BrotliEncoderCreateInstance(nullptr, nullptr, nullptr),
-                                      &BrotliEncoderDestroyInstance) {
+                                           const EncoderMode mode, const uint32_t chunk_size,
+                                           PreparedDictionarySharedPtr dictionary)
+    : chunk_size_{chunk_size}, dictionary_(std::move(dictionary)),
+      state_(BrotliEncoderCreateInstance(nullptr, nullptr, nullptr),
+             &BrotliEncoderDestroyInstance) {
   RELEASE_ASSERT(quality <= BROTLI_MAX_QUALITY, "");
   BROTLI_BOOL result = BrotliEncoderSetParameter(state_.get(), BROTLI_PARAM_QUALITY, quality);
   RELEASE_ASSERT(result == BROTLI_TRUE, "");
@@ -35,6 +47,11 @@ BrotliCompressorImpl::BrotliCompressorImpl(const uint32_t quality, const uint32_
 
   result = BrotliEncoderSetParameter(state_.get(), BROTLI_PARAM_MODE, static_cast<uint32_t>(mode));
   RELEASE_ASSERT(result == BROTLI_TRUE, "");
+
+  if (dictionary_ != nullptr) {
+    result = BrotliEncoderAttachPreparedDictionary(state_.get(), dictionary_->prepared());
+    RELEASE_ASSERT(result == BROTLI_TRUE, "");
+  }
 }
 
 void BrotliCompressorImpl::compress(Buffer::Instance& buffer,
@@ -42,6 +59,10 @@ void BrotliCompressorImpl::compress(Buffer::Instance& buffer,
   Common::BrotliContext ctx(chunk_size_);
 
   Buffer::OwnedImpl accumulation_buffer;
+  if (dictionary_ != nullptr && !stream_header_written_) {
+    accumulation_buffer.add(dictionary_->streamHeader());
+    stream_header_written_ = true;
+  }
   for (const Buffer::RawSlice& input_slice : buffer.getRawSlices()) {
     ctx.avail_in_ = input_slice.len_;
     ctx.next_in_ = static_cast<uint8_t*>(input_slice.mem_);
@@ -3,6 +3,7 @@
 #include "envoy/compression/compressor/compressor.h"
 
 #include "source/extensions/compression/brotli/common/base.h"
+#include "source/extensions/compression/brotli/common/dictionary.h"
 
 #include "brotli/encode.h"
 
@@ -12,6 +13,24 @@ namespace Compression {
 namespace Brotli {
 namespace Compressor {
 
+/**
+ * A shared dictionary prepared once for the encoders of all the workers.
+ */
+class PreparedDictionary : public Common::Dictionary {
+public:
+  explicit PreparedDictionary(std::string&& content);
+
+  const BrotliEncoderPreparedDictionary* prepared() const { return prepared_.get(); }
+
+private:
+  // References the content of the dictionary, which outlives it.
+  std::unique_ptr<BrotliEncoderPreparedDictionary,
+                  decltype(&BrotliEncoderDestroyPreparedDictionary)>
+      prepared_;
+};
+
+using PreparedDictionarySharedPtr = std::shared_ptr<const PreparedDictionary>;
+
 /**
  * Implementation of compressor's interface.
  */
@@ -44,10 +63,13 @@ public:
    * feature. This flag is a "decoding-speed vs compression ratio" trade-off.
    * @param mode tunes encoder for specific input. @see EncoderMode enum.
    * @param chunk_size amount of memory reserved for the compressor output.
+   * @param dictionary the shared dictionary to compress with, if any, in which case the output is
+   * a "dcb" stream starting with the header identifying the dictionary.
    */
   BrotliCompressorImpl(const uint32_t quality, const uint32_t window_bits,
                        const uint32_t input_block_bits, const bool disable_literal_context_modeling,
-                       const EncoderMode mode, const uint32_t chunk_size);
+                       const EncoderMode mode, const uint32_t chunk_size,
+                       PreparedDictionarySharedPtr dictionary = nullptr);
 
   // Compression::Compressor::Compressor
   void compress(Buffer::Instance& buffer, Envoy::Compression::Compressor::State state) override;
@@ -57,6 +79,9 @@ private:
                const BrotliEncoderOperation op);
 
   const uint32_t chunk_size_;
+  // Declared before the encoder, which references it until it is destroyed.
+  const PreparedDictionarySharedPtr dictionary_;
+  bool stream_header_written_{};
   std::unique_ptr<BrotliEncoderState, decltype(&BrotliEncoderDestroyInstance)> state_;
 };
 
@@ -7,19 +7,45 @@ namespace Brotli {
 namespace Compressor {
 
 BrotliCompressorFactory::BrotliCompressorFactory(
-    const envoy::extensions::compression::brotli::compressor::v3::Brotli& brotli)
+    const envoy::extensions::compression::brotli::compressor::v3::Brotli& brotli,
+    Event::Dispatcher& dispatcher, Api::Api& api, ThreadLocal::SlotAllocator& tls)
     : chunk_size_(PROTOBUF_GET_WRAPPED_OR_DEFAULT(brotli, chunk_size, DefaultChunkSize)),
       disable_literal_context_modeling_(brotli.disable_literal_context_modeling()),
       encoder_mode_(encoderModeEnum(brotli.encoder_mode())),
       input_block_bits_(
           PROTOBUF_GET_WRAPPED_OR_DEFAULT(brotli, input_block_bits, DefaultInputBlockBits)),
       quality_(PROTOBUF_GET_WRAPPED_OR_DEFAULT(brotli, quality, DefaultQuality)),
-      window_bits_(PROTOBUF_GET_WRAPPED_OR_DEFAULT(brotli, window_bits, DefaultWindowBits)) {}
+      window_bits_(PROTOBUF_GET_WRAPPED_OR_DEFAULT(brotli, window_bits, DefaultWindowBits)) {
+  if (brotli.has_dictionary()) {
+    dictionary_manager_ = std::make_unique<Common::DictionaryManager<PreparedDictionary>>(
+        brotli.dictionary(), dispatcher, api, tls, [](std::string&& content) {
+          return std::make_shared<const PreparedDictionary>(std::move(content));
+        });
+  }
+}
 
 Envoy::Compression::Compressor::CompressorPtr BrotliCompressorFactory::createCompressor() {
-  return std::make_unique<BrotliCompressorImpl>(quality_, window_bits_, input_block_bits_,
-                                                disable_literal_context_modeling_, encoder_mode_,
-                                                chunk_size_);
+  return makeCompressor(quality_);
+}
+
+Envoy::Compression::Compressor::CompressorPtr
+BrotliCompressorFactory::createCompressorForLoad(UnitFloat load) {
+  return makeCompressor(compressionLevelForLoad(load).value());
+}
+
+std::string BrotliCompressorFactory::dictionaryHash() const {
+  return dictionary_manager_ != nullptr ? dictionary_manager_->dictionary()->hash() : "";
+}
+
+Envoy::Compression::Compressor::CompressorPtr
+BrotliCompressorFactory::makeCompressor(uint32_t quality) {
+  return std::make_unique<BrotliCompressorImpl>(
+      quality, window_bits_, input_block_bits_, disable_literal_context_modeling_, encoder_mode_,
+      chunk_size_, dictionary_manager_ != nullptr ? dictionary_manager_->dictionary() : nullptr);
+}
+
+absl::optional<uint32_t> BrotliCompressorFactory::compressionLevelForLoad(UnitFloat load) const {
+  return Compression::Common::Compressor::compressionLevelForLoad(quality_, MinQuality, load);
 }
 
 BrotliCompressorImpl::EncoderMode BrotliCompressorFactory::encoderModeEnum(
@@ -39,8 +65,11 @@ BrotliCompressorImpl::EncoderMode BrotliCompressorFactory::encoderModeEnum(
 Envoy::Compression::Compressor::CompressorFactoryPtr
 BrotliCompressorLibraryFactory::createCompressorFactoryFromProtoTyped(
     const envoy::extensions::compression::brotli::compressor::v3::Brotli& proto_config,
-    Server::Configuration::FactoryContext&) {
-  return std::make_unique<BrotliCompressorFactory>(proto_config);
+    Server::Configuration::FactoryContext& context) {
+  auto& server_context = context.serverFactoryContext();
+  return std::make_unique<BrotliCompressorFactory>(
+      proto_config, server_context.mainThreadDispatcher(), server_context.api(),
+      server_context.threadLocal());
 }
 
 /**
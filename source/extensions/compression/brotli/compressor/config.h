@@ -23,6 +23,9 @@ const uint32_t DefaultWindowBits = 18;
 // Default quality.
 const uint32_t DefaultQuality = 3;
 
+// The quality of the fastest compression.
+const uint32_t MinQuality = 0;
+
 // Default zlib chunk size.
 const uint32_t DefaultChunkSize = 4096;
 
@@ -38,24 +41,33 @@ const std::string& brotliExtensionName() {
 class BrotliCompressorFactory : public Envoy::Compression::Compressor::CompressorFactory {
 public:
   BrotliCompressorFactory(
-      const envoy::extensions::compression::brotli::compressor::v3::Brotli& brotli);
+      const envoy::extensions::compression::brotli::compressor::v3::Brotli& brotli,
+      Event::Dispatcher& dispatcher, Api::Api& api, ThreadLocal::SlotAllocator& tls);
 
   // Envoy::Compression::Compressor::CompressorFactory
   Envoy::Compression::Compressor::CompressorPtr createCompressor() override;
+  Envoy::Compression::Compressor::CompressorPtr createCompressorForLoad(UnitFloat load) override;
+  absl::optional<uint32_t> compressionLevelForLoad(UnitFloat load) const override;
   const std::string& statsPrefix() const override { return brotliStatsPrefix(); }
   const std::string& contentEncoding() const override {
-    return Http::CustomHeaders::get().ContentEncodingValues.Brotli;
+    return dictionary_manager_ != nullptr
+               ? Http::CustomHeaders::get().ContentEncodingValues.BrotliDictionary
+               : Http::CustomHeaders::get().ContentEncodingValues.Brotli;
   }
+  std::string dictionaryHash() const override;
 
 private:
   static BrotliCompressorImpl::EncoderMode encoderModeEnum(
       envoy::extensions::compression::brotli::compressor::v3::Brotli::EncoderMode encoder_mode);
+  Envoy::Compression::Compressor::CompressorPtr makeCompressor(uint32_t quality);
+
   const uint32_t chunk_size_;
   const bool disable_literal_context_modeling_;
   const BrotliCompressorImpl::EncoderMode encoder_mode_;
   const uint32_t input_block_bits_;
   const uint32_t quality_;
   const uint32_t window_bits_;
+  std::unique_ptr<Common::DictionaryManager<PreparedDictionary>> dictionary_manager_;
 };
 
 class BrotliCompressorLibraryFactory
@@ -22,23 +22,43 @@ constexpr uint32_t MaxInflateRatio = 100;
 
 BrotliDecompressorImpl::BrotliDecompressorImpl(Stats::Scope& scope, const std::string& stats_prefix,
                                                const uint32_t chunk_size,
-                                               const bool disable_ring_buffer_reallocation)
-    : chunk_size_{chunk_size},
+                                               const bool disable_ring_buffer_reallocation,
+                                               std::shared_ptr<const Common::Dictionary> dictionary)
+    : chunk_size_{chunk_size}, dictionary_(std::move(dictionary)),
       state_(BrotliDecoderCreateInstance(nullptr, nullptr, nullptr), &BrotliDecoderDestroyInstance),
       stats_(generateStats(stats_prefix, scope)) {
   BROTLI_BOOL result =
       BrotliDecoderSetParameter(state_.get(), BROTLI_DECODER_PARAM_DISABLE_RING_BUFFER_REALLOCATION,
                                 disable_ring_buffer_reallocation ? BROTLI_TRUE : BROTLI_FALSE);
   RELEASE_ASSERT(result == BROTLI_TRUE, "");
+
+  if (dictionary_ != nullptr) {
+    result = BrotliDecoderAttachDictionary(
+        state_.get(), BROTLI_SHARED_DICTIONARY_RAW, dictionary_->content().size(),
+        reinterpret_cast<const uint8_t*>(dictionary_->content().data()));
+    RELEASE_ASSERT(result == BROTLI_TRUE, "");
+  }
 }
 
 void BrotliDecompressorImpl::decompress(const Buffer::Instance& input_buffer,
                                         Buffer::Instance& output_buffer) {
+  uint64_t header_length = 0;
+  if (dictionary_ != nullptr &&
+      (dictionary_mismatch_ || stream_header_.size() < Common::DictionaryStreamHeaderSize)) {
+    header_length = consumeStreamHeader(input_buffer);
+    if (stream_header_.size() < Common::DictionaryStreamHeaderSize || dictionary_mismatch_) {
+      return;
+    }
+  }
+
   Common::BrotliContext ctx(chunk_size_, MaxInflateRatio * input_buffer.length());
 
   for (const Buffer::RawSlice& input_slice : input_buffer.getRawSlices()) {
-    ctx.avail_in_ = input_slice.len_;
-    ctx.next_in_ = static_cast<uint8_t*>(input_slice.mem_);
+    // The stream header is skipped, it isn't brotli.
+    const uint64_t skipped = std::min<uint64_t>(header_length, input_slice.len_);
+    header_length -= skipped;
+    ctx.avail_in_ = input_slice.len_ - skipped;
+    ctx.next_in_ = static_cast<uint8_t*>(input_slice.mem_) + skipped;
 
     while (ctx.avail_in_ > 0) {
       if (!process(ctx, output_buffer)) {
@@ -59,6 +79,24 @@ void BrotliDecompressorImpl::decompress(const Buffer::Instance& input_buffer,
   ctx.finalizeOutput(output_buffer);
 }
 
+uint64_t BrotliDecompressorImpl::consumeStreamHeader(const Buffer::Instance& input_buffer) {
+  if (dictionary_mismatch_) {
+    return 0;
+  }
+  const uint64_t length = std::min<uint64_t>(
+      Common::DictionaryStreamHeaderSize - stream_header_.size(), input_buffer.length());
+  const size_t offset = stream_header_.size();
+  stream_header_.resize(offset + length);
+  input_buffer.copyOut(0, length, stream_header_.data() + offset);
+  if (stream_header_.size() == Common::DictionaryStreamHeaderSize &&
+      stream_header_ != dictionary_->streamHeader()) {
+    stats_.brotli_error_.inc();
+    stats_.brotli_bad_dictionary_.inc();
+    dictionary_mismatch_ = true;
+  }
+  return length;
+}
+
 bool BrotliDecompressorImpl::process(Common::BrotliContext& ctx, Buffer::Instance& output_buffer) {
   BrotliDecoderResult result = BrotliDecoderDecompressStream(
       state_.get(), &ctx.avail_in_, &ctx.next_in_, &ctx.avail_out_, &ctx.next_out_, nullptr);
@@ -5,6 +5,7 @@
 #include "envoy/stats/stats_macros.h"
 
 #include "source/extensions/compression/brotli/common/base.h"
+#include "source/extensions/compression/brotli/common/dictionary.h"
 
 #include "brotli/decode.h"
 
@@ -20,7 +21,8 @@ namespace Decompressor {
 #define ALL_BROTLI_DECOMPRESSOR_STATS(COUNTER)                                                     \
   COUNTER(brotli_error)           /*Decompression error of all.*/                                  \
   COUNTER(brotli_output_overflow) /*Decompression error because of the overflow output.*/          \
-  COUNTER(brotli_redundant_input) /*Decompression error because of the redundant input.*/
+  COUNTER(brotli_redundant_input) /*Decompression error because of the redundant input.*/          \
+  COUNTER(brotli_bad_dictionary)  /*Decompression error because of an unknown dictionary.*/
 
 /**
  * Struct definition for brotli decompressor stats. @see stats_macros.h
@@ -40,9 +42,12 @@ public:
    * @param disable_ring_buffer_reallocation if true disables "canny" ring buffer allocation
    * strategy. Ring buffer is allocated according to window size, despite the real size of the
    * content.
+   * @param dictionary the shared dictionary to decompress with, if any, in which case the input is
+   * a "dcb" stream starting with the header identifying the dictionary.
    */
   BrotliDecompressorImpl(Stats::Scope& scope, const std::string& stats_prefix,
-                         const uint32_t chunk_size, bool disable_ring_buffer_reallocation);
+                         const uint32_t chunk_size, bool disable_ring_buffer_reallocation,
+                         std::shared_ptr<const Common::Dictionary> dictionary = nullptr);
 
   // Envoy::Compression::Decompressor::Decompressor
   void decompress(const Buffer::Instance& input_buffer, Buffer::Instance& output_buffer) override;
@@ -54,8 +59,14 @@ private:
   }
 
   bool process(Common::BrotliContext& ctx, Buffer::Instance& output_buffer);
+  // Consumes the part of the stream header at the start of the input, returning its length.
+  uint64_t consumeStreamHeader(const Buffer::Instance& input_buffer);
 
   const uint32_t chunk_size_;
+  // Declared before the decoder, which references it until it is destroyed.
+  const std::shared_ptr<const Common::Dictionary> dictionary_;
+  std::string stream_header_;
+  bool dictionary_mismatch_{};
   std::unique_ptr<BrotliDecoderState, decltype(&BrotliDecoderDestroyInstance)> state_;
   const BrotliDecompressorStats stats_;
 };
@@ -14,22 +14,38 @@ const uint32_t DefaultChunkSize = 4096;
 
 BrotliDecompressorFactory::BrotliDecompressorFactory(
     const envoy::extensions::compression::brotli::decompressor::v3::Brotli& brotli,
-    Stats::Scope& scope)
+    Stats::Scope& scope, Event::Dispatcher& dispatcher, Api::Api& api,
+    ThreadLocal::SlotAllocator& tls)
     : scope_(scope),
       chunk_size_(PROTOBUF_GET_WRAPPED_OR_DEFAULT(brotli, chunk_size, DefaultChunkSize)),
-      disable_ring_buffer_reallocation_{brotli.disable_ring_buffer_reallocation()} {}
+      disable_ring_buffer_reallocation_{brotli.disable_ring_buffer_reallocation()} {
+  if (brotli.has_dictionary()) {
+    dictionary_manager_ = std::make_unique<Common::DictionaryManager<Common::Dictionary>>(
+        brotli.dictionary(), dispatcher, api, tls, [](std::string&& content) {
+          return std::make_shared<const Common::Dictionary>(std::move(content));
+        });
+  }
+}
 
 Envoy::Compression::Decompressor::DecompressorPtr
 BrotliDecompressorFactory::createDecompressor(const std::string& stats_prefix) {
-  return std::make_unique<BrotliDecompressorImpl>(scope_, stats_prefix, chunk_size_,
-                                                  disable_ring_buffer_reallocation_);
+  return std::make_unique<BrotliDecompressorImpl>(
+      scope_, stats_prefix, chunk_size_, disable_ring_buffer_reallocation_,
+      dictionary_manager_ != nullptr ? dictionary_manager_->dictionary() : nullptr);
+}
+
+std::string BrotliDecompressorFactory::dictionaryHash() const {
+  return dictionary_manager_ != nullptr ? dictionary_manager_->dictionary()->hash() : "";
 }
 
 Envoy::Compression::Decompressor::DecompressorFactoryPtr
 BrotliDecompressorLibraryFactory::createDecompressorFactoryFromProtoTyped(
     const envoy::extensions::compression::brotli::decompressor::v3::Brotli& proto_config,
     Server::Configuration::FactoryContext& context) {
-  return std::make_unique<BrotliDecompressorFactory>(proto_config, context.scope());
+  auto& server_context = context.serverFactoryContext();
+  return std::make_unique<BrotliDecompressorFactory>(
+      proto_config, context.scope(), server_context.mainThreadDispatcher(), server_context.api(),
+      server_context.threadLocal());
 }
 
 /**
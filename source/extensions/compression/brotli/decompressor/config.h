@@ -26,20 +26,25 @@ class BrotliDecompressorFactory : public Envoy::Compression::Decompressor::Decom
 public:
   BrotliDecompressorFactory(
       const envoy::extensions::compression::brotli::decompressor::v3::Brotli& brotli,
-      Stats::Scope& scope);
+      Stats::Scope& scope, Event::Dispatcher& dispatcher, Api::Api& api,
+      ThreadLocal::SlotAllocator& tls);
 
   // Envoy::Compression::Decompressor::DecompressorFactory
   Envoy::Compression::Decompressor::DecompressorPtr
   createDecompressor(const std::string& stats_prefix) override;
   const std::string& statsPrefix() const override { return brotliStatsPrefix(); }
   const std::string& contentEncoding() const override {
-    return Http::CustomHeaders::get().ContentEncodingValues.Brotli;
+    return dictionary_manager_ != nullptr
+               ? Http::CustomHeaders::get().ContentEncodingValues.BrotliDictionary
+               : Http::CustomHeaders::get().ContentEncodingValues.Brotli;
   }
+  std::string dictionaryHash() const override;
 
 private:
   Stats::Scope& scope_;
   const uint32_t chunk_size_;
   const bool disable_ring_buffer_reallocation_;
+  std::unique_ptr<Common::DictionaryManager<Common::Dictionary>> dictionary_manager_;
 };
 
 class BrotliDecompressorLibraryFactory
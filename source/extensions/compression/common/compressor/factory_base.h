@@ -4,12 +4,29 @@
 #include "envoy/compression/compressor/factory.h"
 #include "envoy/server/filter_config.h"
 
+#include "source/common/common/interval_value.h"
+
 namespace Envoy {
 namespace Extensions {
 namespace Compression {
 namespace Common {
 namespace Compressor {
 
+/**
+ * @return the compression level for the given load of the
+ *         envoy.overload_actions.reduce_compression_level overload action, lowered linearly from
+ *         the configured level when the action is inactive down to the cheapest level when it is
+ *         saturated.
+ */
+inline uint32_t compressionLevelForLoad(uint32_t configured_level, uint32_t cheapest_level,
+                                        UnitFloat load) {
+  if (configured_level <= cheapest_level) {
+    return configured_level;
+  }
+  return configured_level -
+         static_cast<uint32_t>((configured_level - cheapest_level) * load.value() + 0.5f);
+}
+
 template <class ConfigProto>
 class CompressorLibraryFactoryBase
     : public Envoy::Compression::Compressor::NamedCompressorLibraryConfigFactory {
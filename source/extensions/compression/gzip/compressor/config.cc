@@ -65,6 +65,24 @@ Envoy::Compression::Compressor::CompressorPtr GzipCompressorFactory::createCompr
   return compressor;
 }
 
+Envoy::Compression::Compressor::CompressorPtr
+GzipCompressorFactory::createCompressorForLoad(UnitFloat load) {
+  auto compressor = std::make_unique<ZlibCompressorImpl>(chunk_size_);
+  compressor->init(
+      static_cast<ZlibCompressorImpl::CompressionLevel>(compressionLevelForLoad(load).value()),
+      compression_strategy_, window_bits_, memory_level_);
+  return compressor;
+}
+
+absl::optional<uint32_t> GzipCompressorFactory::compressionLevelForLoad(UnitFloat load) const {
+  const uint32_t configured_level =
+      compression_level_ == ZlibCompressorImpl::CompressionLevel::Standard
+          ? StandardCompressionLevel
+          : static_cast<uint32_t>(compression_level_);
+  return Compression::Common::Compressor::compressionLevelForLoad(
+      configured_level, static_cast<uint32_t>(ZlibCompressorImpl::CompressionLevel::Speed), load);
+}
+
 Envoy::Compression::Compressor::CompressorFactoryPtr
 GzipCompressorLibraryFactory::createCompressorFactoryFromProtoTyped(
     const envoy::extensions::compression::gzip::compressor::v3::Gzip& proto_config,
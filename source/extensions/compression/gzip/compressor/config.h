@@ -27,6 +27,9 @@ const uint64_t GzipHeaderValue = 16;
 // Default zlib chunk size.
 const uint32_t DefaultChunkSize = 4096;
 
+// The compression level zlib applies for Z_DEFAULT_COMPRESSION.
+const uint32_t StandardCompressionLevel = 6;
+
 namespace {
 
 const std::string& gzipStatsPrefix() { CONSTRUCT_ON_FIRST_USE(std::string, "gzip."); }
@@ -42,6 +45,8 @@ public:
 
   // Envoy::Compression::Compressor::CompressorFactory
   Envoy::Compression::Compressor::CompressorPtr createCompressor() override;
+  Envoy::Compression::Compressor::CompressorPtr createCompressorForLoad(UnitFloat load) override;
+  absl::optional<uint32_t> compressionLevelForLoad(UnitFloat load) const override;
   const std::string& statsPrefix() const override { return gzipStatsPrefix(); }
   const std::string& contentEncoding() const override {
     return Http::CustomHeaders::get().ContentEncodingValues.Gzip;
@@ -2,6 +2,7 @@
 
 #include <zlib.h>
 
+#include <algorithm>
 #include <memory>
 
 #include "envoy/common/exception.h"
@@ -17,6 +18,14 @@ namespace Compression {
 namespace Gzip {
 namespace Decompressor {
 
+namespace {
+
+// The minimum size of the slices reserved for the output, so that the output of the
+// decompression of a body is held in a few large slices.
+constexpr uint64_t MinOutputReservationSize = 16 * 1024;
+
+} // namespace
+
 ZlibDecompressorImpl::ZlibDecompressorImpl(Stats::Scope& scope, const std::string& stats_prefix,
                                            uint64_t chunk_size, uint64_t max_inflate_ratio)
     : Common::Base(chunk_size,
@@ -24,7 +33,9 @@ ZlibDecompressorImpl::ZlibDecompressorImpl(Stats::Scope& scope, const std::strin
                      inflateEnd(z);
                      delete z;
                    }),
-      stats_(generateStats(stats_prefix, scope)), max_inflate_ratio_(max_inflate_ratio) {
+      stats_(generateStats(stats_prefix, scope)), max_inflate_ratio_(max_inflate_ratio),
+      decompress_into_reservations_(Runtime::runtimeFeatureEnabled(
+          "envoy.reloadable_features.zlib_decompress_into_reservations")) {
   zstream_ptr_->zalloc = Z_NULL;
   zstream_ptr_->zfree = Z_NULL;
   zstream_ptr_->opaque = Z_NULL;
@@ -41,6 +52,11 @@ void ZlibDecompressorImpl::init(int64_t window_bits) {
 
 void ZlibDecompressorImpl::decompress(const Buffer::Instance& input_buffer,
                                       Buffer::Instance& output_buffer) {
+  if (decompress_into_reservations_) {
+    decompressIntoReservations(input_buffer, output_buffer);
+    return;
+  }
+
   uint64_t limit = max_inflate_ratio_ * input_buffer.length();
 
   for (const Buffer::RawSlice& input_slice : input_buffer.getRawSlices()) {
@@ -51,14 +67,7 @@ void ZlibDecompressorImpl::decompress(const Buffer::Instance& input_buffer,
         updateOutput(output_buffer);
       }
 
-      if (Runtime::runtimeFeatureEnabled(
-              "envoy.reloadable_features.enable_compression_bomb_protection") &&
-          (output_buffer.length() > limit)) {
-        stats_.zlib_data_error_.inc();
-        ENVOY_LOG(trace,
-                  "excessive decompression ratio detected: output "
-                  "size {} for input size {}",
-                  output_buffer.length(), input_buffer.length());
+      if (excessiveRatio(input_buffer, output_buffer, limit)) {
         return;
       }
     }
@@ -69,6 +78,54 @@ void ZlibDecompressorImpl::decompress(const Buffer::Instance& input_buffer,
   updateOutput(output_buffer);
 }
 
+void ZlibDecompressorImpl::decompressIntoReservations(const Buffer::Instance& input_buffer,
+                                                      Buffer::Instance& output_buffer) {
+  const uint64_t limit = max_inflate_ratio_ * input_buffer.length();
+  const uint64_t reservation_size = std::max(chunk_size_, MinOutputReservationSize);
+
+  bool excessive_ratio = false;
+  for (const Buffer::RawSlice& input_slice : input_buffer.getRawSlices()) {
+    zstream_ptr_->avail_in = input_slice.len_;
+    zstream_ptr_->next_in = static_cast<Bytef*>(input_slice.mem_);
+    bool more_output = true;
+    while (more_output && !excessive_ratio) {
+      Buffer::ReservationSingleSlice reservation =
+          output_buffer.reserveSingleSlice(reservation_size);
+      zstream_ptr_->next_out = static_cast<Bytef*>(reservation.slice().mem_);
+      zstream_ptr_->avail_out = reservation.length();
+      do {
+        more_output = inflateNext();
+      } while (more_output && zstream_ptr_->avail_out > 0);
+      reservation.commit(reservation.length() - zstream_ptr_->avail_out);
+      // The ratio is checked for each reservation, so that a compression bomb is stopped within
+      // one reservation of the limit.
+      excessive_ratio = excessiveRatio(input_buffer, output_buffer, limit);
+    }
+    if (excessive_ratio) {
+      break;
+    }
+  }
+
+  // The z_stream must not point to the reserved slices once they are committed.
+  zstream_ptr_->avail_out = chunk_size_;
+  zstream_ptr_->next_out = chunk_char_ptr_.get();
+}
+
+bool ZlibDecompressorImpl::excessiveRatio(const Buffer::Instance& input_buffer,
+                                          const Buffer::Instance& output_buffer, uint64_t limit) {
+  if (!Runtime::runtimeFeatureEnabled(
+          "envoy.reloadable_features.enable_compression_bomb_protection") ||
+      output_buffer.length() <= limit) {
+    return false;
+  }
+  stats_.zlib_data_error_.inc();
+  ENVOY_LOG(trace,
+            "excessive decompression ratio detected: output "
+            "size {} for input size {}",
+            output_buffer.length(), input_buffer.length());
+  return true;
+}
+
 bool ZlibDecompressorImpl::inflateNext() {
   const int result = inflate(zstream_ptr_.get(), Z_NO_FLUSH);
   if (result == Z_STREAM_END) {
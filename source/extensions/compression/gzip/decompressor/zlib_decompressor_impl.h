@@ -78,9 +78,16 @@ private:
 
   bool inflateNext();
   void chargeErrorStats(const int result);
+  // Decompresses straight into slices reserved in the output buffer, instead of copying the
+  // output of each chunk to it.
+  void decompressIntoReservations(const Buffer::Instance& input_buffer,
+                                  Buffer::Instance& output_buffer);
+  bool excessiveRatio(const Buffer::Instance& input_buffer, const Buffer::Instance& output_buffer,
+                      uint64_t limit);
 
   const ZlibDecompressorStats stats_;
   const uint64_t max_inflate_ratio_;
+  const bool decompress_into_reservations_;
 };
 
 } // namespace Decompressor
@@ -29,6 +29,25 @@ Envoy::Compression::Compressor::CompressorPtr ZstdCompressorFactory::createCompr
                                               cdict_manager_, chunk_size_);
 }
 
+Envoy::Compression::Compressor::CompressorPtr
+ZstdCompressorFactory::createCompressorForLoad(UnitFloat load) {
+  const absl::optional<uint32_t> compression_level = compressionLevelForLoad(load);
+  if (!compression_level.has_value()) {
+    return createCompressor();
+  }
+  return std::make_unique<ZstdCompressorImpl>(compression_level.value(), enable_checksum_,
+                                              strategy_, cdict_manager_, chunk_size_);
+}
+
+absl::optional<uint32_t> ZstdCompressorFactory::compressionLevelForLoad(UnitFloat load) const {
+  // The dictionaries are digested for the configured compression level, which they impose.
+  if (cdict_manager_ != nullptr) {
+    return absl::nullopt;
+  }
+  return Compression::Common::Compressor::compressionLevelForLoad(compression_level_,
+                                                                 MinCompressionLevel, load);
+}
+
 Envoy::Compression::Compressor::CompressorFactoryPtr
 ZstdCompressorLibraryFactory::createCompressorFactoryFromProtoTyped(
     const envoy::extensions::compression::zstd::compressor::v3::Zstd& proto_config,
@@ -14,6 +14,9 @@ namespace Compression {
 namespace Zstd {
 namespace Compressor {
 
+// The compression level of the fastest compression, short of the negative levels.
+const uint32_t MinCompressionLevel = 1;
+
 namespace {
 
 const std::string& zstdStatsPrefix() { CONSTRUCT_ON_FIRST_USE(std::string, "zstd."); }
@@ -31,6 +34,8 @@ public:
 
   // Envoy::Compression::Compressor::CompressorFactory
   Envoy::Compression::Compressor::CompressorPtr createCompressor() override;
+  Envoy::Compression::Compressor::CompressorPtr createCompressorForLoad(UnitFloat load) override;
+  absl::optional<uint32_t> compressionLevelForLoad(UnitFloat load) const override;
   const std::string& statsPrefix() const override { return zstdStatsPrefix(); }
   const std::string& contentEncoding() const override {
     return Http::CustomHeaders::get().ContentEncodingValues.Zstd;
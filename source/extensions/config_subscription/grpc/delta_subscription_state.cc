@@ -184,17 +184,34 @@ bool DeltaSubscriptionState::isHeartbeatResponse(
 
 void DeltaSubscriptionState::handleGoodResponse(
     const envoy::service::discovery::v3::DeltaDiscoveryResponse& message) {
-  absl::flat_hash_set<std::string> names_added_removed;
+  // The names are views of those of the message, to not copy each of them.
+  absl::flat_hash_set<absl::string_view> names_added_removed;
+  names_added_removed.reserve(message.resources_size() + message.removed_resources_size());
+  // The resources are only copied if some of them are heartbeats to filter out. Until then, they
+  // are the first non_heartbeats_count of those of the message.
   Protobuf::RepeatedPtrField<envoy::service::discovery::v3::Resource> non_heartbeat_resources;
+  int non_heartbeats_count = 0;
+  bool found_heartbeat = false;
   for (const auto& resource : message.resources()) {
     if (!names_added_removed.insert(resource.name()).second) {
       throw EnvoyException(
           fmt::format("duplicate name {} found among added/updated resources", resource.name()));
     }
     if (isHeartbeatResponse(resource)) {
+      if (!found_heartbeat) {
+        found_heartbeat = true;
+        non_heartbeat_resources.Reserve(message.resources_size() - 1);
+        for (int i = 0; i < non_heartbeats_count; ++i) {
+          non_heartbeat_resources.Add()->CopyFrom(message.resources(i));
+        }
+      }
       continue;
     }
-    non_heartbeat_resources.Add()->CopyFrom(resource);
+    if (found_heartbeat) {
+      non_heartbeat_resources.Add()->CopyFrom(resource);
+    } else {
+      ++non_heartbeats_count;
+    }
     // DeltaDiscoveryResponses for unresolved aliases don't contain an actual resource
     if (!resource.has_resource() && resource.aliases_size() > 0) {
       continue;
@@ -213,12 +230,14 @@ void DeltaSubscriptionState::handleGoodResponse(
     }
   }
 
-  watch_map_.onConfigUpdate(non_heartbeat_resources, message.removed_resources(),
+  const Protobuf::RepeatedPtrField<envoy::service::discovery::v3::Resource>& resources =
+      found_heartbeat ? non_heartbeat_resources : message.resources();
+  watch_map_.onConfigUpdate(resources, message.removed_resources(),
                             message.system_version_info());
 
   // Processing point when resources are successfully ingested.
   if (xds_config_tracker_.has_value()) {
-    xds_config_tracker_->onConfigAccepted(message.type_url(), non_heartbeat_resources,
+    xds_config_tracker_->onConfigAccepted(message.type_url(), resources,
                                           message.removed_resources());
   }
 
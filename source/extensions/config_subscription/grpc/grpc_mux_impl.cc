@@ -3,6 +3,7 @@
 #include "envoy/service/discovery/v3/discovery.pb.h"
 
 #include "source/common/config/decoded_resource_impl.h"
+#include "source/common/config/resource_decoder_pool.h"
 #include "source/common/config/utility.h"
 #include "source/common/memory/utils.h"
 #include "source/common/protobuf/protobuf.h"
@@ -372,10 +373,10 @@ void GrpcMuxImpl::onDiscoveryResponse(
             fmt::format("{} does not match the message-wide type URL {} in DiscoveryResponse {}",
                         resource.type_url(), type_url, message->DebugString()));
       }
+    }
 
-      auto decoded_resource =
-          DecodedResourceImpl::fromResource(resource_decoder, resource, message->version_info());
-
+    for (DecodedResourcePtr& decoded_resource :
+         decodeResources(resource_decoder, message->resources(), message->version_info())) {
       if (!isHeartbeatResource(type_url, *decoded_resource)) {
         resources.emplace_back(std::move(decoded_resource));
       }
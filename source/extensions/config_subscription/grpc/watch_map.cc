@@ -1,5 +1,7 @@
 #include "source/extensions/config_subscription/grpc/watch_map.h"
 
+#include <algorithm>
+
 #include "envoy/service/discovery/v3/discovery.pb.h"
 
 #include "source/common/common/cleanup.h"
@@ -80,10 +82,11 @@ WatchMap::updateWatchInterest(Watch* watch,
   return {std::move(added_resources), std::move(removed_resources)};
 }
 
-absl::flat_hash_set<Watch*> WatchMap::watchesInterestedIn(const std::string& resource_name) {
-  absl::flat_hash_set<Watch*> ret;
+void WatchMap::watchesInterestedIn(const std::string& resource_name,
+                                   std::vector<Watch*>& watches) {
+  watches.clear();
   if (!use_namespace_matching_) {
-    ret = wildcard_watches_;
+    watches.insert(watches.end(), wildcard_watches_.begin(), wildcard_watches_.end());
   }
   const bool is_xdstp = XdsResourceIdentifier::hasXdsTpScheme(resource_name);
   xds::core::v3::ResourceName xdstp_resource;
@@ -118,11 +121,13 @@ absl::flat_hash_set<Watch*> WatchMap::watchesInterestedIn(const std::string& res
     }
   }
   if (watches_interested != watch_interest_.end()) {
-    for (const auto& watch : watches_interested->second) {
-      ret.insert(watch);
+    for (Watch* watch : watches_interested->second) {
+      // A watch of both the wildcard and some names is already in.
+      if (use_namespace_matching_ || !wildcard_watches_.contains(watch)) {
+        watches.push_back(watch);
+      }
     }
   }
-  return ret;
 }
 
 void WatchMap::onConfigUpdate(const std::vector<DecodedResourcePtr>& resources,
@@ -143,9 +148,11 @@ void WatchMap::onConfigUpdate(const std::vector<DecodedResourcePtr>& resources,
   // entry in the map is then a nice little bundle that can be fed directly into the individual
   // onConfigUpdate()s.
   absl::flat_hash_map<Watch*, std::vector<DecodedResourceRef>> per_watch_updates;
+  per_watch_updates.reserve(watches_.size());
+  std::vector<Watch*> interested_in_r;
   for (const auto& r : resources) {
-    const absl::flat_hash_set<Watch*>& interested_in_r = watchesInterestedIn(r->name());
-    for (const auto& interested_watch : interested_in_r) {
+    watchesInterestedIn(r->name(), interested_in_r);
+    for (Watch* interested_watch : interested_in_r) {
       per_watch_updates[interested_watch].emplace_back(*r);
     }
     // Set the corresponding interested_resources entry to true iff there is a
@@ -226,24 +233,27 @@ void WatchMap::onConfigUpdate(
   // cares about. Each entry in the map-pair is then a nice little bundle that can be fed directly
   // into the individual onConfigUpdate()s.
   std::vector<DecodedResourcePtr> decoded_resources;
+  decoded_resources.reserve(added_resources.size());
   absl::flat_hash_map<Watch*, std::vector<DecodedResourceRef>> per_watch_added;
+  per_watch_added.reserve(std::min<size_t>(watches_.size(), added_resources.size()));
+  std::vector<Watch*> interested_in_r;
   for (const auto& r : added_resources) {
-    const absl::flat_hash_set<Watch*>& interested_in_r = watchesInterestedIn(r.name());
+    watchesInterestedIn(r.name(), interested_in_r);
     // If there are no watches, then we don't need to decode. If there are watches, they should all
     // be for the same resource type, so we can just use the callbacks of the first watch to decode.
     if (interested_in_r.empty()) {
       continue;
     }
     decoded_resources.emplace_back(
-        new DecodedResourceImpl((*interested_in_r.begin())->resource_decoder_, r));
-    for (const auto& interested_watch : interested_in_r) {
+        new DecodedResourceImpl(interested_in_r.front()->resource_decoder_, r));
+    for (Watch* interested_watch : interested_in_r) {
       per_watch_added[interested_watch].emplace_back(*decoded_resources.back());
     }
   }
   absl::flat_hash_map<Watch*, Protobuf::RepeatedPtrField<std::string>> per_watch_removed;
   for (const auto& r : removed_resources) {
-    const absl::flat_hash_set<Watch*>& interested_in_r = watchesInterestedIn(r);
-    for (const auto& interested_watch : interested_in_r) {
+    watchesInterestedIn(r, interested_in_r);
+    for (Watch* interested_watch : interested_in_r) {
       *per_watch_removed[interested_watch].Add() = r;
     }
   }
@@ -3,6 +3,7 @@
 #include <set>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "envoy/config/custom_config_validators.h"
 #include "envoy/config/eds_resources_cache.h"
@@ -127,8 +128,10 @@ private:
   absl::flat_hash_set<std::string>
   findRemovals(const absl::flat_hash_set<std::string>& newly_removed_from_watch, Watch* watch);
 
-  // Returns the union of watch_interest_[resource_name] and wildcard_watches_.
-  absl::flat_hash_set<Watch*> watchesInterestedIn(const std::string& resource_name);
+  // Sets the watches to the union of watch_interest_[resource_name] and wildcard_watches_, without
+  // duplicates. The vector is reused across the resources of an update, so that looking up each of
+  // them doesn't allocate a set.
+  void watchesInterestedIn(const std::string& resource_name, std::vector<Watch*>& watches);
 
   absl::flat_hash_set<std::unique_ptr<Watch>> watches_;
 
@@ -321,6 +321,7 @@ EXTENSIONS = {
     #
     "envoy.extensions.http.cache.file_system_http_cache": "//source/extensions/http/cache/file_system_http_cache:config",
     "envoy.extensions.http.cache.simple":               "//source/extensions/http/cache/simple_http_cache:config",
+    "envoy.extensions.http.cache.tiered":               "//source/extensions/http/cache/tiered_http_cache:config",
 
     #
     # Internal redirect predicates
@@ -372,6 +373,13 @@ EXTENSIONS = {
 
     "envoy.tls.cert_validator.spiffe":                  "//source/extensions/transport_sockets/tls/cert_validator/spiffe:config",
 
+    #
+    # TLS session caches
+    #
+
+    "envoy.tls.session_cache.in_memory":                "//source/extensions/transport_sockets/tls/session_cache/in_memory:config",
+    "envoy.tls.session_cache.key_value":                "//source/extensions/transport_sockets/tls/session_cache/key_value:config",
+
     #
     # HTTP header formatters
     #
@@ -486,6 +494,7 @@ EXTENSIONS = {
     "envoy.load_balancing_policies.ring_hash":         "//source/extensions/load_balancing_policies/ring_hash:config",
     "envoy.load_balancing_policies.subset":            "//source/extensions/load_balancing_policies/subset:config",
     "envoy.load_balancing_policies.cluster_provided":  "//source/extensions/load_balancing_policies/cluster_provided:config",
+    "envoy.load_balancing_policies.peak_ewma":         "//source/extensions/load_balancing_policies/peak_ewma:config",
 
     #
     # HTTP Early Header Mutation
@@ -1,5 +1,7 @@
 #include "source/extensions/filters/common/expr/evaluator.h"
 
+#include <algorithm>
+
 #include "envoy/common/exception.h"
 #include "envoy/singleton/manager.h"
 
@@ -30,6 +32,36 @@ const ActivationLookupTable& getActivationTokens() {
 #undef _PAIR
 }
 
+// An activation memoizing the values of the attributes, so that their wrappers are created once
+// however many times the evaluations sharing the activation look them up.
+class MemoizingStreamActivation : public StreamActivation {
+public:
+  MemoizingStreamActivation(const LocalInfo::LocalInfo* local_info,
+                            const StreamInfo::StreamInfo& info,
+                            const Http::RequestHeaderMap* request_headers,
+                            const Http::ResponseHeaderMap* response_headers,
+                            const Http::ResponseTrailerMap* response_trailers,
+                            Protobuf::Arena* arena)
+      : StreamActivation(local_info, info, request_headers, response_headers, response_trailers),
+        arena_(arena != nullptr ? arena : &own_arena_) {}
+
+  absl::optional<CelValue> FindValue(absl::string_view name, Protobuf::Arena*) const override {
+    if (auto it = values_.find(name); it != values_.end()) {
+      return it->second;
+    }
+    absl::optional<CelValue> value = StreamActivation::FindValue(name, arena_);
+    if (value.has_value()) {
+      values_.emplace(name, value.value());
+    }
+    return value;
+  }
+
+private:
+  mutable Protobuf::Arena own_arena_;
+  Protobuf::Arena* const arena_;
+  mutable absl::flat_hash_map<std::string, CelValue> values_;
+};
+
 } // namespace
 
 absl::optional<CelValue> StreamActivation::FindValue(absl::string_view name,
@@ -91,9 +123,10 @@ ActivationPtr createActivation(const LocalInfo::LocalInfo* local_info,
                                const StreamInfo::StreamInfo& info,
                                const Http::RequestHeaderMap* request_headers,
                                const Http::ResponseHeaderMap* response_headers,
-                               const Http::ResponseTrailerMap* response_trailers) {
-  return std::make_unique<StreamActivation>(local_info, info, request_headers, response_headers,
-                                            response_trailers);
+                               const Http::ResponseTrailerMap* response_trailers,
+                               Protobuf::Arena* arena) {
+  return std::make_unique<MemoizingStreamActivation>(local_info, info, request_headers,
+                                                     response_headers, response_trailers, arena);
 }
 
 BuilderPtr createBuilder(Protobuf::Arena* arena) {
@@ -129,7 +162,34 @@ SINGLETON_MANAGER_REGISTRATION(expression_builder);
 BuilderInstanceSharedPtr getBuilder(Server::Configuration::CommonFactoryContext& context) {
   return context.singletonManager().getTyped<BuilderInstance>(
       SINGLETON_MANAGER_REGISTERED_NAME(expression_builder),
-      [] { return std::make_shared<BuilderInstance>(createBuilder(nullptr)); });
+      [] {
+        // The folded constants live as long as the builder and the expressions it created.
+        auto constant_arena = std::make_shared<Protobuf::Arena>();
+        return std::make_shared<BuilderInstance>(createBuilder(constant_arena.get()),
+                                                 std::move(constant_arena));
+      });
+}
+
+ExpressionSharedPtr
+BuilderInstance::createExpression(const google::api::expr::v1alpha1::Expr& expr) {
+  std::string key = expr.SerializeAsString();
+  absl::MutexLock lock(&mutex_);
+  if (auto it = expressions_.find(key); it != expressions_.end()) {
+    if (ExpressionSharedPtr expression = it->second.lock(); expression != nullptr) {
+      return expression;
+    }
+  }
+  auto cached = std::make_shared<CachedExpression>();
+  cached->expr_ = expr;
+  cached->constant_arena_ = constant_arena_;
+  cached->expression_ = Expr::createExpression(*builder_, cached->expr_);
+  ExpressionSharedPtr expression(cached, cached->expression_.get());
+  if (expressions_.size() >= next_sweep_) {
+    absl::erase_if(expressions_, [](const auto& entry) { return entry.second.expired(); });
+    next_sweep_ = std::max(MinSweepSize, 2 * expressions_.size());
+  }
+  expressions_.insert_or_assign(std::move(key), expression);
+  return expression;
 }
 
 ExpressionPtr createExpression(Builder& builder, const google::api::expr::v1alpha1::Expr& expr) {
@@ -148,8 +208,8 @@ absl::optional<CelValue> evaluate(const Expression& expr, Protobuf::Arena& arena
                                   const Http::RequestHeaderMap* request_headers,
                                   const Http::ResponseHeaderMap* response_headers,
                                   const Http::ResponseTrailerMap* response_trailers) {
-  auto activation =
-      createActivation(local_info, info, request_headers, response_headers, response_trailers);
+  auto activation = createActivation(local_info, info, request_headers, response_headers,
+                                     response_trailers, &arena);
   auto eval_status = expr.Evaluate(*activation, &arena);
   if (!eval_status.ok()) {
     return {};
@@ -6,6 +6,10 @@
 #include "source/common/protobuf/protobuf.h"
 #include "source/extensions/filters/common/expr/context.h"
 
+#include "absl/base/thread_annotations.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/synchronization/mutex.h"
+
 // CEL-CPP does not enforce unused parameter checks consistently, so we relax it here.
 
 #if defined(__GNUC__)
@@ -33,6 +37,7 @@ using Builder = google::api::expr::runtime::CelExpressionBuilder;
 using BuilderPtr = std::unique_ptr<Builder>;
 using Expression = google::api::expr::runtime::CelExpression;
 using ExpressionPtr = std::unique_ptr<Expression>;
+using ExpressionSharedPtr = std::shared_ptr<const Expression>;
 
 // Base class for the context used by the CEL evaluator to look up attributes.
 class StreamActivation : public google::api::expr::runtime::BaseActivation {
@@ -65,21 +70,52 @@ protected:
 };
 
 // Creates an activation providing the common context attributes.
-// The activation lazily creates wrappers during an evaluation using the evaluation arena.
+// The activation lazily creates the wrappers of the attributes the first time they are looked up,
+// using the optional arena, or an arena of its own, and returns the same wrappers to the later
+// lookups, including those of the other evaluations sharing the activation. The values looked up
+// must not outlive that arena.
 ActivationPtr createActivation(const ::Envoy::LocalInfo::LocalInfo* local_info,
                                const StreamInfo::StreamInfo& info,
                                const ::Envoy::Http::RequestHeaderMap* request_headers,
                                const ::Envoy::Http::ResponseHeaderMap* response_headers,
-                               const ::Envoy::Http::ResponseTrailerMap* response_trailers);
+                               const ::Envoy::Http::ResponseTrailerMap* response_trailers,
+                               Protobuf::Arena* arena = nullptr);
 
 // Shared expression builder instance.
 class BuilderInstance : public Singleton::Instance {
 public:
-  explicit BuilderInstance(BuilderPtr builder) : builder_(std::move(builder)) {}
+  // The constant arena, if any, is the one the builder folds the constants into.
+  explicit BuilderInstance(BuilderPtr builder,
+                           std::shared_ptr<Protobuf::Arena> constant_arena = nullptr)
+      : constant_arena_(std::move(constant_arena)), builder_(std::move(builder)) {}
   Builder& builder() { return *builder_; }
 
+  // Creates an interpretable expression from a protobuf representation, or returns the one
+  // already created for an identical representation and still in use. The expression keeps a copy
+  // of the representation, so the latter doesn't need to outlive it.
+  // Throws an exception if fails to construct a runtime expression.
+  ExpressionSharedPtr createExpression(const google::api::expr::v1alpha1::Expr& expr)
+      ABSL_LOCKS_EXCLUDED(mutex_);
+
 private:
+  static constexpr size_t MinSweepSize = 16;
+
+  // Keeps alive what the expression refers to.
+  struct CachedExpression {
+    google::api::expr::v1alpha1::Expr expr_;
+    std::shared_ptr<Protobuf::Arena> constant_arena_;
+    ExpressionPtr expression_;
+  };
+
+  const std::shared_ptr<Protobuf::Arena> constant_arena_;
   BuilderPtr builder_;
+  absl::Mutex mutex_;
+  // The expressions by the serialization of their representation, which is deterministic since
+  // the representation has no map.
+  absl::flat_hash_map<std::string, std::weak_ptr<const Expression>>
+      expressions_ ABSL_GUARDED_BY(mutex_);
+  // The number of expressions at which the expired ones are next swept.
+  size_t next_sweep_ ABSL_GUARDED_BY(mutex_){MinSweepSize};
 };
 
 using BuilderInstanceSharedPtr = std::shared_ptr<BuilderInstance>;
@@ -89,7 +125,8 @@ using BuilderInstanceSharedPtr = std::shared_ptr<BuilderInstance>;
 // Throws an exception if fails to construct an expression builder.
 BuilderPtr createBuilder(Protobuf::Arena* arena);
 
-// Gets the singleton expression builder. Must be called on the main thread.
+// Gets the singleton expression builder, which folds the constants of the expressions. Must be
+// called on the main thread.
 BuilderInstanceSharedPtr getBuilder(Server::Configuration::CommonFactoryContext& context);
 
 // Creates an interpretable expression from a protobuf representation.
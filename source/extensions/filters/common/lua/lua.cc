@@ -36,6 +36,7 @@ void Coroutine::resume(int num_args, const std::function<void()>& yield_callback
 
   if (0 == rc) {
     state_ = State::Finished;
+    finished_ok_ = true;
     ENVOY_LOG(debug, "coroutine finished");
   } else if (LUA_YIELD == rc) {
     state_ = State::Yielded;
@@ -51,6 +52,13 @@ void Coroutine::resume(int num_args, const std::function<void()>& yield_callback
   }
 }
 
+void Coroutine::resetForReuse() {
+  ASSERT(reusable());
+  lua_settop(coroutine_state_.get(), 0);
+  state_ = State::NotStarted;
+  finished_ok_ = false;
+}
+
 ThreadLocalState::ThreadLocalState(const std::string& code, ThreadLocal::SlotAllocator& tls)
     : tls_slot_(ThreadLocal::TypedSlot<LuaThreadLocal>::makeUnique(tls)) {
 
@@ -93,10 +101,38 @@ uint64_t ThreadLocalState::registerGlobal(const std::string& global,
 }
 
 CoroutinePtr ThreadLocalState::createCoroutine() {
+  std::vector<CoroutinePtr>& pool = (*tls_slot_)->coroutine_pool_;
+  if (!pool.empty()) {
+    CoroutinePtr coroutine = std::move(pool.back());
+    pool.pop_back();
+    return coroutine;
+  }
   lua_State* state = tlsState().get();
   return std::make_unique<Coroutine>(std::make_pair(lua_newthread(state), state));
 }
 
+void ThreadLocalState::releaseCoroutine(CoroutinePtr&& coroutine) {
+  std::vector<CoroutinePtr>& pool = (*tls_slot_)->coroutine_pool_;
+  if (coroutine == nullptr || !coroutine->reusable() || pool.size() >= max_pooled_coroutines_) {
+    coroutine.reset();
+    return;
+  }
+  coroutine->resetForReuse();
+  pool.push_back(std::move(coroutine));
+}
+
+void ThreadLocalState::setGCParameters(absl::optional<uint32_t> pause,
+                                       absl::optional<uint32_t> step_multiplier) {
+  tls_slot_->runOnAllThreads([pause, step_multiplier](OptRef<LuaThreadLocal> tls) {
+    if (pause.has_value()) {
+      lua_gc(tls->state_.get(), LUA_GCSETPAUSE, pause.value());
+    }
+    if (step_multiplier.has_value()) {
+      lua_gc(tls->state_.get(), LUA_GCSETSTEPMUL, step_multiplier.value());
+    }
+  });
+}
+
 ThreadLocalState::LuaThreadLocal::LuaThreadLocal(const std::string& code)
     : state_(luaL_newstate()) {
 
@@ -11,6 +11,7 @@
 #include "source/common/common/c_smart_ptr.h"
 #include "source/common/common/logger.h"
 
+#include "absl/types/optional.h"
 #include "lua.hpp"
 
 namespace Envoy {
@@ -373,9 +374,21 @@ public:
    */
   void resume(int num_args, const std::function<void()>& yield_callback);
 
+  /**
+   * @return whether the coroutine can be started again, i.e. whether it never started or ran to
+   *         completion without an error.
+   */
+  bool reusable() const { return state_ == State::NotStarted || finished_ok_; }
+
+  /**
+   * Clear the stack of a reusable coroutine so that it can be started again.
+   */
+  void resetForReuse();
+
 private:
   LuaRef<lua_State> coroutine_state_;
   State state_{State::NotStarted};
+  bool finished_ok_{};
 };
 
 using CoroutinePtr = std::unique_ptr<Coroutine>;
@@ -392,10 +405,29 @@ public:
   ThreadLocalState(const std::string& code, ThreadLocal::SlotAllocator& tls);
 
   /**
-   * @return CoroutinePtr a new coroutine.
+   * @return CoroutinePtr a new coroutine, or a pooled one if coroutine pooling is enabled.
    */
   CoroutinePtr createCoroutine();
 
+  /**
+   * Return a coroutine to the pool of the worker, if coroutine pooling is enabled, the coroutine
+   * is reusable and the pool isn't full. Otherwise the coroutine is destroyed. Must be called on
+   * the worker which created the coroutine.
+   */
+  void releaseCoroutine(CoroutinePtr&& coroutine);
+
+  /**
+   * Enable the pooling of up to max_pooled coroutines per worker. Must be called before any
+   * coroutine is created.
+   */
+  void setMaxPooledCoroutines(uint32_t max_pooled) { max_pooled_coroutines_ = max_pooled; }
+
+  /**
+   * Set the pause and the step multiplier of the incremental garbage collector on all workers. See
+   * LUA_GCSETPAUSE and LUA_GCSETSTEPMUL.
+   */
+  void setGCParameters(absl::optional<uint32_t> pause, absl::optional<uint32_t> step_multiplier);
+
   /**
    * @return a global reference previously registered via registerGlobal(). This may return
    *         LUA_REFNIL if there was no such global.
@@ -434,18 +466,30 @@ public:
    */
   void runtimeGC() { lua_gc(tlsState().get(), LUA_GCCOLLECT, 0); }
 
+  /**
+   * Run an incremental runtime GC step.
+   * @param size_kb supplies the size of the step, in KiB of allocation.
+   * @return whether the step finished a GC cycle.
+   */
+  bool runtimeGCStep(uint32_t size_kb) {
+    return lua_gc(tlsState().get(), LUA_GCSTEP, size_kb) == 1;
+  }
+
 private:
   struct LuaThreadLocal : public ThreadLocal::ThreadLocalObject {
     LuaThreadLocal(const std::string& code);
 
     CSmartPtr<lua_State, lua_close> state_;
     std::vector<int> global_slots_;
+    // Destroyed before the state the coroutines belong to.
+    std::vector<CoroutinePtr> coroutine_pool_;
   };
 
   CSmartPtr<lua_State, lua_close>& tlsState() { return (*tls_slot_)->state_; }
 
   ThreadLocal::TypedSlotPtr<LuaThreadLocal> tls_slot_;
   uint64_t current_global_slot_{};
+  uint32_t max_pooled_coroutines_{};
 };
 
 using ThreadLocalStatePtr = std::unique_ptr<ThreadLocalState>;
@@ -60,6 +60,13 @@ public:
                         Http::RequestHeaderMapPtr&& request_headers_to_add,
                         const std::string& response_body,
                         DynamicMetadataPtr&& dynamic_metadata) PURE;
+
+  /**
+   * Called before complete() when the rate limit service granted a quota for the descriptors.
+   *
+   * @quota The quota granted for the descriptors.
+   */
+  virtual void onQuota(const envoy::service::ratelimit::v3::RateLimitResponse::Quota&) {}
 };
 
 /**
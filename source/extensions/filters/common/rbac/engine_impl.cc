@@ -57,6 +57,16 @@ RoleBasedAccessControlEngineImpl::RoleBasedAccessControlEngineImpl(
     policies_.emplace(policy.first, std::make_unique<PolicyMatcher>(policy.second, builder_.get(),
                                                                     validation_visitor, context));
   }
+
+  std::vector<const envoy::config::rbac::v3::Policy*> policy_configs;
+  for (const auto& policy : policies_) {
+    ordered_policies_.emplace_back(&policy.first, policy.second.get());
+    policy_configs.push_back(&rules.policies().at(policy.first));
+  }
+  index_ = std::make_unique<PolicyIndex>(policy_configs);
+  if (index_->empty()) {
+    index_.reset();
+  }
 }
 
 bool RoleBasedAccessControlEngineImpl::handleAction(const Network::Connection& connection,
@@ -92,6 +102,20 @@ bool RoleBasedAccessControlEngineImpl::checkPolicyMatch(
     const Envoy::Http::RequestHeaderMap& headers, std::string* effective_policy_id) const {
   bool matched = false;
 
+  if (index_ != nullptr) {
+    // Only the candidate policies can match, in the same order as all the policies.
+    for (const size_t position : index_->candidates(connection, headers, info)) {
+      const auto& [name, policy] = ordered_policies_[position];
+      if (policy->matches(connection, headers, info)) {
+        if (effective_policy_id != nullptr) {
+          *effective_policy_id = *name;
+        }
+        return true;
+      }
+    }
+    return false;
+  }
+
   for (const auto& policy : policies_) {
     if (policy.second->matches(connection, headers, info)) {
       matched = true;
@@ -6,6 +6,7 @@
 #include "source/common/matcher/matcher.h"
 #include "source/extensions/filters/common/rbac/engine.h"
 #include "source/extensions/filters/common/rbac/matchers.h"
+#include "source/extensions/filters/common/rbac/policy_index.h"
 
 #include "xds/type/matcher/v3/matcher.pb.h"
 
@@ -87,6 +88,10 @@ private:
   const EnforcementMode mode_;
 
   std::map<std::string, std::unique_ptr<PolicyMatcher>> policies_;
+  // The policies in evaluation order, the positions the index refers to.
+  std::vector<std::pair<const std::string*, const PolicyMatcher*>> ordered_policies_;
+  // The index of the policies, or nullptr if none of them can be indexed.
+  PolicyIndexPtr index_;
 
   Protobuf::Arena constant_arena_;
   Expr::BuilderPtr builder_;
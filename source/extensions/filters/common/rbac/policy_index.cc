@@ -0,0 +1,186 @@
+#include "source/extensions/filters/common/rbac/policy_index.h"
+
+#include <algorithm>
+
+#include "source/common/http/path_utility.h"
+#include "source/common/network/cidr_range.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace Filters {
+namespace Common {
+namespace RBAC {
+namespace {
+
+// Returns whether the string matcher matches exactly one string, or the strings with a prefix.
+bool isExact(const envoy::type::matcher::v3::StringMatcher& matcher) {
+  return matcher.match_pattern_case() == envoy::type::matcher::v3::StringMatcher::kExact &&
+         !matcher.ignore_case();
+}
+
+bool isPrefix(const envoy::type::matcher::v3::StringMatcher& matcher) {
+  return matcher.match_pattern_case() == envoy::type::matcher::v3::StringMatcher::kPrefix &&
+         !matcher.ignore_case();
+}
+
+} // namespace
+
+PolicyIndex::PolicyIndex(const std::vector<const envoy::config::rbac::v3::Policy*>& policies) {
+  std::vector<std::pair<size_t, std::vector<Network::Address::CidrRange>>>
+      source_ranges[SourceAddress::Count];
+  for (size_t position = 0; position < policies.size(); ++position) {
+    const envoy::config::rbac::v3::Policy& policy = *policies[position];
+    if (indexPrincipals(position, policy, source_ranges) || indexPaths(position, policy)) {
+      ++indexed_policies_;
+    } else {
+      unindexed_.push_back(position);
+    }
+  }
+
+  for (size_t source = 0; source < SourceAddress::Count; ++source) {
+    if (!source_ranges[source].empty()) {
+      source_tries_[source] = std::make_unique<IpTrie>(source_ranges[source]);
+    }
+  }
+  // The lists are no longer added to, so their addresses are stable.
+  for (const auto& [prefix, prefix_policies] : path_prefixes_) {
+    path_prefix_trie_.add(prefix, &prefix_policies);
+  }
+}
+
+bool PolicyIndex::indexPrincipals(
+    size_t position, const envoy::config::rbac::v3::Policy& policy,
+    std::vector<std::pair<size_t, std::vector<Network::Address::CidrRange>>>* source_ranges) {
+  using envoy::config::rbac::v3::Principal;
+  for (const Principal& principal : policy.principals()) {
+    switch (principal.identifier_case()) {
+    case Principal::IdentifierCase::kSourceIp:
+    case Principal::IdentifierCase::kDirectRemoteIp:
+    case Principal::IdentifierCase::kRemoteIp:
+      break;
+    case Principal::IdentifierCase::kAuthenticated:
+      if (!principal.authenticated().has_principal_name() ||
+          !isExact(principal.authenticated().principal_name())) {
+        return false;
+      }
+      break;
+    default:
+      return false;
+    }
+  }
+
+  std::vector<Network::Address::CidrRange> ranges[SourceAddress::Count];
+  for (const Principal& principal : policy.principals()) {
+    switch (principal.identifier_case()) {
+    case Principal::IdentifierCase::kSourceIp:
+      ranges[ConnectionRemote].push_back(THROW_OR_RETURN_VALUE(
+          Network::Address::CidrRange::create(principal.source_ip()), Network::Address::CidrRange));
+      break;
+    case Principal::IdentifierCase::kDirectRemoteIp:
+      ranges[DownstreamDirectRemote].push_back(
+          THROW_OR_RETURN_VALUE(Network::Address::CidrRange::create(principal.direct_remote_ip()),
+                                Network::Address::CidrRange));
+      break;
+    case Principal::IdentifierCase::kRemoteIp:
+      ranges[DownstreamRemote].push_back(THROW_OR_RETURN_VALUE(
+          Network::Address::CidrRange::create(principal.remote_ip()), Network::Address::CidrRange));
+      break;
+    default:
+      principal_names_[principal.authenticated().principal_name().exact()].push_back(position);
+      break;
+    }
+  }
+  for (size_t source = 0; source < SourceAddress::Count; ++source) {
+    if (!ranges[source].empty()) {
+      source_ranges[source].emplace_back(position, std::move(ranges[source]));
+    }
+  }
+  return true;
+}
+
+bool PolicyIndex::indexPaths(size_t position, const envoy::config::rbac::v3::Policy& policy) {
+  using envoy::config::rbac::v3::Permission;
+  for (const Permission& permission : policy.permissions()) {
+    if (permission.rule_case() != Permission::RuleCase::kUrlPath ||
+        !permission.url_path().has_path() ||
+        !(isExact(permission.url_path().path()) || isPrefix(permission.url_path().path()))) {
+      return false;
+    }
+  }
+
+  for (const Permission& permission : policy.permissions()) {
+    const envoy::type::matcher::v3::StringMatcher& path = permission.url_path().path();
+    if (isExact(path)) {
+      exact_paths_[path.exact()].push_back(position);
+    } else {
+      path_prefixes_[path.prefix()].push_back(position);
+    }
+  }
+  return true;
+}
+
+std::vector<size_t> PolicyIndex::candidates(const Network::Connection& connection,
+                                            const Envoy::Http::RequestHeaderMap& headers,
+                                            const StreamInfo::StreamInfo& info) const {
+  std::vector<size_t> candidates = unindexed_;
+
+  const Network::Address::InstanceConstSharedPtr sources[SourceAddress::Count] = {
+      connection.connectionInfoProvider().remoteAddress(),
+      info.downstreamAddressProvider().directRemoteAddress(),
+      info.downstreamAddressProvider().remoteAddress()};
+  for (size_t source = 0; source < SourceAddress::Count; ++source) {
+    if (source_tries_[source] != nullptr && sources[source] != nullptr &&
+        sources[source]->type() == Network::Address::Type::Ip) {
+      const std::vector<size_t> matched = source_tries_[source]->getData(sources[source]);
+      candidates.insert(candidates.end(), matched.begin(), matched.end());
+    }
+  }
+  addAuthenticatedCandidates(connection, candidates);
+  addPathCandidates(headers, candidates);
+
+  std::sort(candidates.begin(), candidates.end());
+  candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+  return candidates;
+}
+
+void PolicyIndex::addAuthenticatedCandidates(const Network::Connection& connection,
+                                             std::vector<size_t>& candidates) const {
+  const auto& ssl = connection.ssl();
+  if (principal_names_.empty() || ssl == nullptr) {
+    return;
+  }
+  // The same names as AuthenticatedMatcher matches the principal name against.
+  const auto add = [this, &candidates](absl::string_view name) {
+    if (auto it = principal_names_.find(name); it != principal_names_.end()) {
+      candidates.insert(candidates.end(), it->second.begin(), it->second.end());
+    }
+  };
+  for (const std::string& uri : ssl->uriSanPeerCertificate()) {
+    add(uri);
+  }
+  for (const std::string& dns : ssl->dnsSansPeerCertificate()) {
+    add(dns);
+  }
+  add(ssl->subjectPeerCertificate());
+}
+
+void PolicyIndex::addPathCandidates(const Envoy::Http::RequestHeaderMap& headers,
+                                    std::vector<size_t>& candidates) const {
+  if ((exact_paths_.empty() && path_prefixes_.empty()) || headers.Path() == nullptr) {
+    return;
+  }
+  // The same path as PathMatcher matches.
+  const absl::string_view path = Http::PathUtil::removeQueryAndFragment(headers.getPathValue());
+  if (auto it = exact_paths_.find(path); it != exact_paths_.end()) {
+    candidates.insert(candidates.end(), it->second.begin(), it->second.end());
+  }
+  for (const PolicyList* prefix_policies : path_prefix_trie_.findMatchingPrefixes(path)) {
+    candidates.insert(candidates.end(), prefix_policies->begin(), prefix_policies->end());
+  }
+}
+
+} // namespace RBAC
+} // namespace Common
+} // namespace Filters
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "envoy/config/rbac/v3/rbac.pb.h"
+#include "envoy/http/header_map.h"
+#include "envoy/network/connection.h"
+#include "envoy/stream_info/stream_info.h"
+
+#include "source/common/common/utility.h"
+#include "source/common/network/lc_trie.h"
+
+#include "absl/container/flat_hash_map.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace Filters {
+namespace Common {
+namespace RBAC {
+
+/**
+ * An index of the RBAC policies, compiled from their configuration, which narrows the policies a
+ * request or connection has to be evaluated against down to the ones that can match it.
+ *
+ * A policy whose principals are all source IPs or exact authenticated principal names is indexed
+ * by those, in an LC trie per kind of source address and a hash map. Otherwise, a policy whose
+ * permissions are all exact or prefix URL paths is indexed by those, in a hash map and a trie.
+ * The other policies are candidates for every request.
+ */
+class PolicyIndex {
+public:
+  /**
+   * @param policies supplies the policies, in the order they are evaluated in.
+   */
+  explicit PolicyIndex(const std::vector<const envoy::config::rbac::v3::Policy*>& policies);
+
+  /**
+   * @return whether no policy is indexed, in which case all the policies are candidates.
+   */
+  bool empty() const { return indexed_policies_ == 0; }
+
+  /**
+   * @return the positions of the policies which can match, in increasing order. The policies not
+   * returned don't match.
+   */
+  std::vector<size_t> candidates(const Network::Connection& connection,
+                                 const Envoy::Http::RequestHeaderMap& headers,
+                                 const StreamInfo::StreamInfo& info) const;
+
+private:
+  // The source addresses principals can match, the same as in IPMatcher.
+  enum SourceAddress { ConnectionRemote = 0, DownstreamDirectRemote, DownstreamRemote, Count };
+
+  using PolicyList = std::vector<size_t>;
+  using IpTrie = Network::LcTrie::LcTrie<size_t>;
+
+  bool indexPrincipals(size_t position, const envoy::config::rbac::v3::Policy& policy,
+                       std::vector<std::pair<size_t, std::vector<Network::Address::CidrRange>>>*
+                           source_ranges);
+  bool indexPaths(size_t position, const envoy::config::rbac::v3::Policy& policy);
+  void addAuthenticatedCandidates(const Network::Connection& connection,
+                                  std::vector<size_t>& candidates) const;
+  void addPathCandidates(const Envoy::Http::RequestHeaderMap& headers,
+                         std::vector<size_t>& candidates) const;
+
+  size_t indexed_policies_{};
+  // The policies which aren't indexed.
+  PolicyList unindexed_;
+  std::unique_ptr<IpTrie> source_tries_[SourceAddress::Count];
+  absl::flat_hash_map<std::string, PolicyList> principal_names_;
+  absl::flat_hash_map<std::string, PolicyList> exact_paths_;
+  absl::flat_hash_map<std::string, PolicyList> path_prefixes_;
+  TrieLookupTable<const PolicyList*> path_prefix_trie_;
+};
+
+using PolicyIndexPtr = std::unique_ptr<PolicyIndex>;
+
+} // namespace RBAC
+} // namespace Common
+} // namespace Filters
+} // namespace Extensions
+} // namespace Envoy
@@ -102,16 +102,48 @@ void GradientController::enterMinRTTSamplingWindow() {
 
   // Throw away any latency samples from before the recalculation window as it may not represent
   // the minRTT.
-  hist_clear(latency_sample_hist_.get());
+  clearLatencySamples();
 
   min_rtt_epoch_ = time_source_.monotonicTime();
 }
 
+GradientController::SampleShard& GradientController::sampleShard() {
+  // The threads take the shards in turn, so that the workers get distinct ones.
+  static std::atomic<size_t> next_shard{0};
+  static thread_local const size_t index = next_shard.fetch_add(1, std::memory_order_relaxed);
+  return sample_shards_[index % SampleShards];
+}
+
+void GradientController::mergeLatencySamples() {
+  for (SampleShard& shard : sample_shards_) {
+    absl::MutexLock ml(&shard.mutex_);
+    if (hist_sample_count(shard.hist_.get()) == 0) {
+      continue;
+    }
+    const histogram_t* hist = shard.hist_.get();
+    hist_accumulate(latency_sample_hist_.get(), &hist, 1);
+    hist_clear(shard.hist_.get());
+  }
+}
+
+void GradientController::clearLatencySamples() {
+  for (SampleShard& shard : sample_shards_) {
+    absl::MutexLock ml(&shard.mutex_);
+    sample_count_.fetch_sub(hist_sample_count(shard.hist_.get()));
+    hist_clear(shard.hist_.get());
+  }
+  sample_count_.fetch_sub(hist_sample_count(latency_sample_hist_.get()));
+  hist_clear(latency_sample_hist_.get());
+}
+
 void GradientController::updateMinRTT() {
   // Only update minRTT when it is in minRTT sampling window and
   // number of samples is greater than or equal to the minRTTAggregateRequestCount.
-  if (!inMinRTTSamplingWindow() ||
-      hist_sample_count(latency_sample_hist_.get()) < config_.minRTTAggregateRequestCount()) {
+  if (!inMinRTTSamplingWindow()) {
+    return;
+  }
+  mergeLatencySamples();
+  if (hist_sample_count(latency_sample_hist_.get()) < config_.minRTTAggregateRequestCount()) {
     return;
   }
 
@@ -141,6 +173,7 @@ void GradientController::resetSampleWindow() {
   // The sampling window must not be reset while sampling for the new minRTT value.
   ASSERT(!inMinRTTSamplingWindow());
 
+  mergeLatencySamples();
   if (hist_sample_count(latency_sample_hist_.get()) == 0) {
     return;
   }
@@ -155,6 +188,7 @@ std::chrono::microseconds GradientController::processLatencySamplesAndClear() {
   const std::array<double, 1> quantile{config_.sampleAggregatePercentile()};
   std::array<double, 1> calculated_quantile;
   hist_approx_quantile(latency_sample_hist_.get(), quantile.data(), 1, calculated_quantile.data());
+  sample_count_.fetch_sub(hist_sample_count(latency_sample_hist_.get()));
   hist_clear(latency_sample_hist_.get());
   return std::chrono::microseconds(static_cast<int>(calculated_quantile[0]));
 }
@@ -214,8 +248,17 @@ void GradientController::recordLatencySample(MonotonicTime rq_send_time) {
                                                             rq_send_time);
   synchronizer_.syncPoint("pre_hist_insert");
   {
+    SampleShard& shard = sampleShard();
+    absl::MutexLock ml(&shard.mutex_);
+    hist_insert(shard.hist_.get(), rq_latency.count(), 1);
+  }
+  const int64_t sample_count = sample_count_.fetch_add(1) + 1;
+
+  // Outside of the minRTT sampling window, the samples are only processed when the sample window
+  // is reset. Within it, the minRTT is updated once enough samples were recorded.
+  if (ABSL_PREDICT_FALSE(inMinRTTSamplingWindow()) &&
+      sample_count >= static_cast<int64_t>(config_.minRTTAggregateRequestCount())) {
     absl::MutexLock ml(&sample_mutation_mtx_);
-    hist_insert(latency_sample_hist_.get(), rq_latency.count(), 1);
     updateMinRTT();
   }
 }
@@ -1,6 +1,9 @@
 #pragma once
 
+#include <array>
+#include <atomic>
 #include <chrono>
+#include <memory>
 #include <vector>
 
 #include "envoy/common/random_generator.h"
@@ -13,6 +16,7 @@
 #include "source/common/common/thread_synchronizer.h"
 #include "source/extensions/filters/http/adaptive_concurrency/controller/controller.h"
 
+#include "absl/base/optimization.h"
 #include "absl/base/thread_annotations.h"
 #include "absl/strings/numbers.h"
 #include "absl/synchronization/mutex.h"
@@ -208,6 +212,10 @@ using GradientControllerConfigSharedPtr = std::shared_ptr<GradientControllerConf
  * prevent the overlap of these windows. It is necessary for a worker thread to know specifically if
  * the controller is inside of a minRTT recalculation window during the recording of a latency
  * sample, so this extra bit of information is stored in inMinRTTSamplingWindow().
+ *
+ * The workers record the latency samples in histograms sharded by thread, each with a lock of its
+ * own, so that they don't all contend on the sample mutation mutex on each request. The shards are
+ * merged under the sample mutation mutex when the samples of a window are processed.
  */
 class GradientController : public ConcurrencyController {
 public:
@@ -230,6 +238,19 @@ public:
 private:
   static GradientControllerStats generateStats(Stats::Scope& scope,
                                                const std::string& stats_prefix);
+  struct ABSL_CACHELINE_ALIGNED SampleShard {
+    SampleShard() : hist_(hist_fast_alloc(), hist_free) {}
+
+    absl::Mutex mutex_;
+    std::unique_ptr<histogram_t, decltype(&hist_free)> hist_ ABSL_GUARDED_BY(mutex_);
+  };
+  static constexpr size_t SampleShards = 8;
+
+  // Returns the shard of the current thread.
+  SampleShard& sampleShard();
+  // Moves the samples of the shards to latency_sample_hist_.
+  void mergeLatencySamples() ABSL_EXCLUSIVE_LOCKS_REQUIRED(sample_mutation_mtx_);
+  void clearLatencySamples() ABSL_EXCLUSIVE_LOCKS_REQUIRED(sample_mutation_mtx_);
   void updateMinRTT() ABSL_EXCLUSIVE_LOCKS_REQUIRED(sample_mutation_mtx_);
   std::chrono::microseconds processLatencySamplesAndClear()
       ABSL_EXCLUSIVE_LOCKS_REQUIRED(sample_mutation_mtx_);
@@ -278,6 +299,13 @@ private:
   std::unique_ptr<histogram_t, decltype(&hist_free)>
       latency_sample_hist_ ABSL_GUARDED_BY(sample_mutation_mtx_);
 
+  // The latency samples recorded by the workers since they were last merged into
+  // latency_sample_hist_.
+  std::array<SampleShard, SampleShards> sample_shards_;
+  // The count of the samples of the shards and of latency_sample_hist_. It may transiently be off
+  // by the samples being recorded, so it is signed.
+  std::atomic<int64_t> sample_count_{0};
+
   // Tracks the number of consecutive times that the concurrency limit is set to the minimum. This
   // is used to determine whether the controller should trigger an additional minRTT measurement
   // after remaining at the minimum limit for too long.
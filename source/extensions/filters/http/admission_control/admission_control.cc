@@ -54,6 +54,16 @@ AdmissionControlFilterConfig::AdmissionControlFilterConfig(
                                      : nullptr),
       response_evaluator_(std::move(response_evaluator)) {}
 
+AdmissionControlFilterConfig::AdmissionControlFilterConfig(
+    const AdmissionControlProto& proto_config, Runtime::Loader& runtime,
+    Random::RandomGenerator& random, Stats::Scope& scope,
+    std::unique_ptr<ThreadLocalController>&& shared_controller,
+    std::shared_ptr<ResponseEvaluator> response_evaluator)
+    : AdmissionControlFilterConfig(proto_config, runtime, random, scope, nullptr,
+                                   std::move(response_evaluator)) {
+  shared_controller_ = std::move(shared_controller);
+}
+
 double AdmissionControlFilterConfig::aggression() const {
   return std::max<double>(1.0, aggression_ ? aggression_->value() : defaultAggression);
 }
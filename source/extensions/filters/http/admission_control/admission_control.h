@@ -56,9 +56,16 @@ public:
                                Random::RandomGenerator& random, Stats::Scope& scope,
                                ThreadLocal::TypedSlotPtr<ThreadLocalControllerImpl>&& tls,
                                std::shared_ptr<ResponseEvaluator> response_evaluator);
+  // Makes a configuration whose workers share the given controller.
+  AdmissionControlFilterConfig(const AdmissionControlProto& proto_config, Runtime::Loader& runtime,
+                               Random::RandomGenerator& random, Stats::Scope& scope,
+                               std::unique_ptr<ThreadLocalController>&& shared_controller,
+                               std::shared_ptr<ResponseEvaluator> response_evaluator);
   virtual ~AdmissionControlFilterConfig() = default;
 
-  virtual ThreadLocalController& getController() const { return **tls_; }
+  virtual ThreadLocalController& getController() const {
+    return shared_controller_ != nullptr ? *shared_controller_ : **tls_;
+  }
 
   Random::RandomGenerator& random() const { return random_; }
   bool filterEnabled() const { return admission_control_feature_.enabled(); }
@@ -73,6 +80,8 @@ private:
   Random::RandomGenerator& random_;
   Stats::Scope& scope_;
   const ThreadLocal::TypedSlotPtr<ThreadLocalControllerImpl> tls_;
+  // Only set if the workers share a controller, instead of having one each in tls_.
+  std::unique_ptr<ThreadLocalController> shared_controller_;
   Runtime::FeatureFlag admission_control_feature_;
   std::unique_ptr<Runtime::Double> aggression_;
   std::unique_ptr<Runtime::Percentage> sr_threshold_;
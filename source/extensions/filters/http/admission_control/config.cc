@@ -28,14 +28,9 @@ AdmissionControlFilterFactory::createFilterFactoryFromProtoTyped(
 
   const std::string prefix = stats_prefix + "admission_control.";
 
-  // Create the thread-local controller.
-  auto tls = ThreadLocal::TypedSlot<ThreadLocalControllerImpl>::makeUnique(context.threadLocal());
   auto sampling_window = std::chrono::seconds(
       PROTOBUF_GET_MS_OR_DEFAULT(config, sampling_window, 1000 * defaultSamplingWindow.count()) /
       1000);
-  tls->set([sampling_window, &context](Event::Dispatcher&) {
-    return std::make_shared<ThreadLocalControllerImpl>(context.timeSource(), sampling_window);
-  });
 
   std::unique_ptr<ResponseEvaluator> response_evaluator;
   switch (config.evaluation_criteria_case()) {
@@ -46,10 +41,23 @@ AdmissionControlFilterFactory::createFilterFactoryFromProtoTyped(
     throw EnvoyException("Evaluation criteria not set");
   }
 
-  AdmissionControlFilterConfigSharedPtr filter_config =
-      std::make_shared<AdmissionControlFilterConfig>(
-          config, context.runtime(), context.api().randomGenerator(), dual_info.scope,
-          std::move(tls), std::move(response_evaluator));
+  AdmissionControlFilterConfigSharedPtr filter_config;
+  if (config.aggregate_across_workers()) {
+    filter_config = std::make_shared<AdmissionControlFilterConfig>(
+        config, context.runtime(), context.api().randomGenerator(), dual_info.scope,
+        std::make_unique<ShardedControllerImpl>(context.timeSource(), sampling_window),
+        std::move(response_evaluator));
+  } else {
+    // Create the thread-local controller.
+    auto tls =
+        ThreadLocal::TypedSlot<ThreadLocalControllerImpl>::makeUnique(context.threadLocal());
+    tls->set([sampling_window, &context](Event::Dispatcher&) {
+      return std::make_shared<ThreadLocalControllerImpl>(context.timeSource(), sampling_window);
+    });
+    filter_config = std::make_shared<AdmissionControlFilterConfig>(
+        config, context.runtime(), context.api().randomGenerator(), dual_info.scope,
+        std::move(tls), std::move(response_evaluator));
+  }
 
   return [filter_config, prefix](Http::FilterChainFactoryCallbacks& callbacks) -> void {
     callbacks.addStreamFilter(std::make_shared<AdmissionControlFilter>(filter_config, prefix));
@@ -1,5 +1,6 @@
 #include "source/extensions/filters/http/admission_control/thread_local_controller.h"
 
+#include <algorithm>
 #include <cstdint>
 
 #include "envoy/common/pure.h"
@@ -53,6 +54,79 @@ void ThreadLocalControllerImpl::recordRequest(bool success) {
   }
 }
 
+ShardedControllerImpl::ShardedControllerImpl(TimeSource& time_source,
+                                             std::chrono::seconds sampling_window)
+    : time_source_(time_source), sampling_window_(std::max<std::chrono::seconds>(
+                                     sampling_window, defaultHistoryGranularity)) {
+  shards_.reserve(Shards);
+  for (size_t i = 0; i < Shards; ++i) {
+    shards_.emplace_back(sampling_window_.count());
+  }
+}
+
+int64_t ShardedControllerImpl::currentSecond() const {
+  return std::chrono::duration_cast<std::chrono::seconds>(
+             time_source_.monotonicTime().time_since_epoch())
+      .count();
+}
+
+void ShardedControllerImpl::recordRequest(bool success) {
+  // The threads take the shards in turn, so that the workers get distinct ones.
+  static std::atomic<size_t> next_shard{0};
+  static thread_local const size_t index = next_shard.fetch_add(1, std::memory_order_relaxed);
+  Shard& shard = shards_[index % Shards];
+
+  const int64_t second = currentSecond();
+  Bucket& bucket = shard.buckets_[second % shard.buckets_.size()];
+  int64_t bucket_second = bucket.second_.load(std::memory_order_acquire);
+  if (ABSL_PREDICT_FALSE(bucket_second != second) &&
+      bucket.second_.compare_exchange_strong(bucket_second, second, std::memory_order_acq_rel)) {
+    bucket.requests_.store(0, std::memory_order_relaxed);
+    bucket.successes_.store(0, std::memory_order_relaxed);
+  }
+  bucket.requests_.fetch_add(1, std::memory_order_relaxed);
+  if (success) {
+    bucket.successes_.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+ThreadLocalController::RequestData ShardedControllerImpl::bucketCounts(int64_t second) const {
+  RequestData counts;
+  for (const Shard& shard : shards_) {
+    const Bucket& bucket = shard.buckets_[second % shard.buckets_.size()];
+    if (bucket.second_.load(std::memory_order_acquire) == second) {
+      counts.requests += bucket.requests_.load(std::memory_order_relaxed);
+      counts.successes += bucket.successes_.load(std::memory_order_relaxed);
+    }
+  }
+  return counts;
+}
+
+ThreadLocalController::RequestData ShardedControllerImpl::windowCounts() const {
+  const int64_t second = currentSecond();
+  if (cached_second_.load(std::memory_order_acquire) != second) {
+    // The whole buckets don't change anymore, so any thread may sum them for the current second.
+    RequestData counts;
+    for (int64_t past = second - sampling_window_.count() + 1; past < second; ++past) {
+      const RequestData past_counts = bucketCounts(past);
+      counts.requests += past_counts.requests;
+      counts.successes += past_counts.successes;
+    }
+    cached_counts_.store((static_cast<uint64_t>(counts.requests) << 32) | counts.successes,
+                         std::memory_order_relaxed);
+    cached_second_.store(second, std::memory_order_release);
+  }
+  const uint64_t cached_counts = cached_counts_.load(std::memory_order_relaxed);
+  RequestData counts = bucketCounts(second);
+  counts.requests += cached_counts >> 32;
+  counts.successes += cached_counts & 0xffffffff;
+  return counts;
+}
+
+uint32_t ShardedControllerImpl::averageRps() const {
+  return windowCounts().requests / sampling_window_.count();
+}
+
 } // namespace AdmissionControl
 } // namespace HttpFilters
 } // namespace Extensions
@@ -1,17 +1,25 @@
 #pragma once
 
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <vector>
+
 #include "envoy/common/pure.h"
 #include "envoy/common/time.h"
 #include "envoy/http/codes.h"
 #include "envoy/thread_local/thread_local_object.h"
 
+#include "absl/base/optimization.h"
+
 namespace Envoy {
 namespace Extensions {
 namespace HttpFilters {
 namespace AdmissionControl {
 
 /*
- * Thread-local admission controller interface.
+ * Admission controller interface, implemented by thread-local and process-wide controllers.
  */
 class ThreadLocalController {
 public:
@@ -117,6 +125,63 @@ private:
   const std::chrono::seconds sampling_window_;
 };
 
+/**
+ * Process-wide controller tracking the request counts and successes of all the workers over a
+ * rolling time window, so that the admission decisions of the workers agree even when each of them
+ * only sees a few requests.
+ *
+ * The requests are counted without locking in rings of one second buckets, sharded by thread with
+ * a ring per shard so that the workers don't contend on the counters. The counts of the whole
+ * buckets of the window are summed once per second and cached, so that reading the counts of the
+ * window on each request only sums the current bucket of each shard.
+ *
+ * A bucket is recycled by the first request of its new second. The requests counted concurrently
+ * by other threads of the shard while it is recycled may be lost, which is acceptable for
+ * the statistics of the window.
+ */
+class ShardedControllerImpl : public ThreadLocalController {
+public:
+  static constexpr size_t Shards = 8;
+
+  ShardedControllerImpl(TimeSource& time_source, std::chrono::seconds sampling_window);
+
+  // ThreadLocalController
+  void recordSuccess() override { recordRequest(true); }
+  void recordFailure() override { recordRequest(false); }
+  RequestData requestCounts() override { return windowCounts(); }
+  uint32_t averageRps() const override;
+  std::chrono::seconds samplingWindow() const override { return sampling_window_; }
+
+private:
+  struct Bucket {
+    // The second counted by the bucket, or -1 if it never counted any.
+    std::atomic<int64_t> second_{-1};
+    std::atomic<uint32_t> requests_{0};
+    std::atomic<uint32_t> successes_{0};
+  };
+
+  struct ABSL_CACHELINE_ALIGNED Shard {
+    explicit Shard(size_t buckets) : buckets_(buckets) {}
+
+    std::vector<Bucket> buckets_;
+  };
+
+  void recordRequest(bool success);
+  int64_t currentSecond() const;
+  // Returns the counts of the buckets of the shards for the given second.
+  RequestData bucketCounts(int64_t second) const;
+  RequestData windowCounts() const;
+
+  TimeSource& time_source_;
+  const std::chrono::seconds sampling_window_;
+  std::vector<Shard> shards_;
+
+  // The counts of the whole buckets of the window ending at cached_second_, without its current
+  // bucket, packed as requests in the high 32 bits and successes in the low ones.
+  mutable std::atomic<int64_t> cached_second_{-1};
+  mutable std::atomic<uint64_t> cached_counts_{0};
+};
+
 } // namespace AdmissionControl
 } // namespace HttpFilters
 } // namespace Extensions
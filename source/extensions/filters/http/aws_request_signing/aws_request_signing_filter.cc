@@ -3,7 +3,6 @@
 #include "envoy/extensions/filters/http/aws_request_signing/v3/aws_request_signing.pb.h"
 
 #include "source/common/common/hex.h"
-#include "source/common/crypto/utility.h"
 #include "source/common/http/utility.h"
 
 namespace Envoy {
@@ -17,7 +16,9 @@ FilterConfigImpl::FilterConfigImpl(Extensions::Common::Aws::SignerPtr&& signer,
     : signer_(std::move(signer)), stats_(Filter::generateStats(stats_prefix, scope)),
       host_rewrite_(host_rewrite), use_unsigned_payload_{use_unsigned_payload} {}
 
-Filter::Filter(const std::shared_ptr<FilterConfig>& config) : config_(config) {}
+Filter::Filter(const std::shared_ptr<FilterConfig>& config) : config_(config) {
+  SHA256_Init(&payload_hash_);
+}
 
 Extensions::Common::Aws::Signer& FilterConfigImpl::signer() { return *signer_; }
 
@@ -72,16 +73,19 @@ Http::FilterDataStatus Filter::decodeData(Buffer::Instance& data, bool end_strea
     return Http::FilterDataStatus::Continue;
   }
 
+  for (const Buffer::RawSlice& slice : data.getRawSlices()) {
+    SHA256_Update(&payload_hash_, slice.mem_, slice.len_);
+  }
+
   if (!end_stream) {
     return Http::FilterDataStatus::StopIterationAndBuffer;
   }
 
   decoder_callbacks_->addDecodedData(data, false);
 
-  const Buffer::Instance& decoding_buffer = *decoder_callbacks_->decodingBuffer();
-
-  auto& hashing_util = Envoy::Common::Crypto::UtilitySingleton::get();
-  const std::string hash = Hex::encode(hashing_util.getSha256Digest(decoding_buffer));
+  uint8_t digest[SHA256_DIGEST_LENGTH];
+  SHA256_Final(digest, &payload_hash_);
+  const std::string hash = Hex::encode(digest, SHA256_DIGEST_LENGTH);
 
   ENVOY_LOG(debug, "aws request signing from decodeData");
   ASSERT(request_headers_ != nullptr);
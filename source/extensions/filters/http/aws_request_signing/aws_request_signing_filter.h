@@ -8,6 +8,8 @@
 #include "source/extensions/common/aws/signer.h"
 #include "source/extensions/filters/http/common/pass_through_filter.h"
 
+#include "openssl/sha.h"
+
 namespace Envoy {
 namespace Extensions {
 namespace HttpFilters {
@@ -99,6 +101,8 @@ private:
 
   std::shared_ptr<FilterConfig> config_;
   Http::RequestHeaderMap* request_headers_{};
+  // The hash of the payload received so far, updated as each chunk arrives.
+  SHA256_CTX payload_hash_;
 };
 
 } // namespace AwsRequestSigningFilter
@@ -55,15 +55,17 @@ FilterConfig::FilterConfig(const BandwidthLimit& config, Stats::Scope& scope,
               ? DefaultResponseFilterDelayTrailer
               : Http::LowerCaseString(absl::StrCat(config.response_trailer_prefix(), "-",
                                                    DefaultResponseFilterDelayTrailer.get()))),
-      enable_response_trailers_(config.enable_response_trailers()) {
+      enable_response_trailers_(config.enable_response_trailers()),
+      shared_fill_timer_(config.shared_fill_timer()) {
   if (per_route && !config.has_limit_kbps()) {
     throw EnvoyException("bandwidthlimitfilter: limit must be set for per route filter config");
   }
 
   // The token bucket is configured with a max token count of the number of
   // bytes per second, and refills at the same rate, so that we have a per
-  // second limit which refills gradually in 1/fill_interval increments.
-  token_bucket_ = std::make_shared<SharedTokenBucketImpl>(
+  // second limit which refills gradually in 1/fill_interval increments. The workers share it
+  // without a lock.
+  token_bucket_ = std::make_shared<AtomicTokenBucketImpl>(
       StreamRateLimiter::kiloBytesToBytes(limit_kbps_), time_source,
       StreamRateLimiter::kiloBytesToBytes(limit_kbps_));
 }
@@ -105,7 +107,8 @@ Http::FilterHeadersStatus BandwidthLimiter::decodeHeaders(Http::RequestHeaderMap
           }
         },
         const_cast<FilterConfig*>(&config)->timeSource(), decoder_callbacks_->dispatcher(),
-        decoder_callbacks_->scope(), config.tokenBucket(), config.fillInterval());
+        decoder_callbacks_->scope(), config.tokenBucket(), config.fillInterval(),
+        config.sharedFillTimer());
   }
 
   return Http::FilterHeadersStatus::Continue;
@@ -172,7 +175,8 @@ Http::FilterHeadersStatus BandwidthLimiter::encodeHeaders(Http::ResponseHeaderMa
           }
         },
         const_cast<FilterConfig*>(&config)->timeSource(), encoder_callbacks_->dispatcher(),
-        encoder_callbacks_->scope(), config.tokenBucket(), config.fillInterval());
+        encoder_callbacks_->scope(), config.tokenBucket(), config.fillInterval(),
+        config.sharedFillTimer());
   }
 
   return Http::FilterHeadersStatus::Continue;
@@ -45,7 +45,10 @@ CacheFilterConfig::CacheFilterConfig(
     const envoy::extensions::filters::http::cache::v3::CacheConfig& config,
     Server::Configuration::CommonFactoryContext& context)
     : vary_allow_list_(config.allowed_vary_headers(), context), time_source_(context.timeSource()),
-      ignore_request_cache_control_header_(config.ignore_request_cache_control_header()) {}
+      ignore_request_cache_control_header_(config.ignore_request_cache_control_header()),
+      collapsed_request_timeout_(PROTOBUF_GET_MS_OR_DEFAULT(config, collapsed_request_timeout, 0)),
+      in_flight_fills_(config.has_collapsed_request_timeout() ? std::make_shared<InFlightFills>()
+                                                              : nullptr) {}
 
 CacheFilter::CacheFilter(std::shared_ptr<const CacheFilterConfig> config,
                          std::shared_ptr<HttpCache> http_cache)
@@ -53,6 +56,7 @@ CacheFilter::CacheFilter(std::shared_ptr<const CacheFilterConfig> config,
 
 void CacheFilter::onDestroy() {
   filter_state_ = FilterState::Destroyed;
+  stopWaitingForFill();
   if (lookup_ != nullptr) {
     lookup_->onDestroy();
   }
@@ -67,6 +71,8 @@ void CacheFilter::onDestroy() {
     insert_queue_->setSelfOwned(std::move(insert_queue_));
     insert_queue_.reset();
   }
+  // Ends the fill of the request if it didn't hand it to the insert queue.
+  in_flight_fill_.reset();
 }
 
 void CacheFilter::onStreamComplete() {
@@ -107,7 +113,13 @@ Http::FilterHeadersStatus CacheFilter::decodeHeaders(Http::RequestHeaderMap& hea
                                config_->ignoreRequestCacheControlHeader());
   request_allows_inserts_ = !lookup_request.requestCacheControl().no_store_;
   is_head_request_ = headers.getMethodValue() == Http::Headers::get().MethodValues.Head;
+  if (config_->inFlightFills() != nullptr) {
+    key_hash_ = stableHashKey(lookup_request.key());
+  }
   lookup_ = cache_->makeLookupContext(std::move(lookup_request), *decoder_callbacks_);
+  if (encoder_callbacks_ != nullptr) {
+    lookup_->setEncoderFilterCallbacks(*encoder_callbacks_);
+  }
 
   ASSERT(lookup_);
   getHeaders(headers);
@@ -125,6 +137,14 @@ Http::FilterHeadersStatus CacheFilter::encodeHeaders(Http::ResponseHeaderMap& he
     return Http::FilterHeadersStatus::Continue;
   }
 
+  if (filter_state_ == FilterState::WaitingForFill) {
+    // A response was injected into the filter chain while the request waited for a fill, e.g.
+    // because the request stream timed out.
+    stopWaitingForFill();
+    filter_state_ = FilterState::NotServingFromCache;
+    return Http::FilterHeadersStatus::Continue;
+  }
+
   // If lookup_ is null, the request wasn't cacheable, so the response isn't either.
   if (!lookup_) {
     return Http::FilterHeadersStatus::Continue;
@@ -170,6 +190,8 @@ Http::FilterHeadersStatus CacheFilter::encodeHeaders(Http::ResponseHeaderMap& he
                                                insert_queue_ = nullptr;
                                                insert_status_ = InsertStatus::InsertAbortedByCache;
                                              });
+      // The requests waiting for the fill of the key look it up once the entry is written.
+      insert_queue_->setInFlightFill(std::move(in_flight_fill_));
       // Add metadata associated with the cached response. Right now this is only response_time;
       const ResponseMetadata metadata = {config_->timeSource().systemTime()};
       insert_queue_->insertHeaders(headers, metadata, end_stream);
@@ -182,6 +204,9 @@ Http::FilterHeadersStatus CacheFilter::encodeHeaders(Http::ResponseHeaderMap& he
   } else {
     insert_status_ = InsertStatus::NoInsertResponseNotCacheable;
   }
+  // Unless handed to the insert queue, the fill is over: the requests waiting for it will miss and
+  // go upstream.
+  in_flight_fill_.reset();
   filter_state_ = FilterState::NotServingFromCache;
   return Http::FilterHeadersStatus::Continue;
 }
@@ -246,6 +271,8 @@ CacheFilter::resolveLookupStatus(absl::optional<CacheEntryStatus> cache_entry_st
       // special handling for those cases.
       switch (filter_state) {
       case FilterState::ValidatingCachedResponse:
+        ABSL_FALLTHROUGH_INTENDED;
+      case FilterState::WaitingForFill:
         return LookupStatus::RequestIncomplete;
       case FilterState::EncodeServingFromCache:
         ABSL_FALLTHROUGH_INTENDED;
@@ -288,6 +315,8 @@ CacheFilter::resolveLookupStatus(absl::optional<CacheEntryStatus> cache_entry_st
   // GCOV_EXCL_START
   case FilterState::ValidatingCachedResponse:
     ABSL_FALLTHROUGH_INTENDED;
+  case FilterState::WaitingForFill:
+    ABSL_FALLTHROUGH_INTENDED;
   case FilterState::DecodeServingFromCache:
     ABSL_FALLTHROUGH_INTENDED;
   case FilterState::EncodeServingFromCache:
@@ -412,6 +441,9 @@ void CacheFilter::onHeaders(LookupResult&& result, Http::RequestHeaderMap& reque
     // request and let it pass through as if no cache entry was found. If the
     // cache entry was valid, the response status should be 304 (unmodified)
     // and the cache entry will be injected in the response body.
+    if (waitForFill(request_headers)) {
+      return;
+    }
     handleCacheHitWithValidation(request_headers);
     return;
   case CacheEntryStatus::Ok:
@@ -422,6 +454,9 @@ void CacheFilter::onHeaders(LookupResult&& result, Http::RequestHeaderMap& reque
     handleCacheHit();
     return;
   case CacheEntryStatus::Unusable:
+    if (waitForFill(request_headers)) {
+      return;
+    }
     decoder_callbacks_->continueDecoding();
     return;
   case CacheEntryStatus::LookupError:
@@ -436,6 +471,76 @@ void CacheFilter::onHeaders(LookupResult&& result, Http::RequestHeaderMap& reque
   decoder_callbacks_->continueDecoding();
 }
 
+bool CacheFilter::waitForFill(Http::RequestHeaderMap& request_headers) {
+  InFlightFills* in_flight_fills = config_->inFlightFills();
+  // Requests that won't insert their response can't fill the cache for the others.
+  if (in_flight_fills == nullptr || waited_for_fill_ || !request_allows_inserts_ ||
+      is_head_request_) {
+    return false;
+  }
+  // The fill may end after the filter is destroyed, in which case the posted callback is ignored.
+  CacheFilterWeakPtr self = weak_from_this();
+  InFlightFills::StartResult result = in_flight_fills->startFillOrWait(
+      key_hash_, decoder_callbacks_->dispatcher(), [self, &request_headers]() {
+        if (CacheFilterSharedPtr cache_filter = self.lock()) {
+          cache_filter->onFillDone(request_headers);
+        }
+      });
+  in_flight_fill_ = std::move(result.handle_);
+  if (result.is_fill_) {
+    return false;
+  }
+  ENVOY_STREAM_LOG(debug, "CacheFilter waiting for the fill in flight of the key",
+                   *decoder_callbacks_);
+  waited_for_fill_ = true;
+  filter_state_ = FilterState::WaitingForFill;
+  fill_wait_timer_ = decoder_callbacks_->dispatcher().createTimer(
+      [this, &request_headers]() { onFillWaitTimeout(request_headers); });
+  fill_wait_timer_->enableTimer(config_->collapsedRequestTimeout());
+  return true;
+}
+
+void CacheFilter::onFillDone(Http::RequestHeaderMap& request_headers) {
+  if (filter_state_ != FilterState::WaitingForFill) {
+    // The wait timed out, or a response was injected into the filter chain.
+    return;
+  }
+  ENVOY_STREAM_LOG(debug, "CacheFilter fill over, looking the key up again", *decoder_callbacks_);
+  stopWaitingForFill();
+  filter_state_ = FilterState::Initial;
+  lookup_->onDestroy();
+  lookup_result_.reset();
+  LookupRequest lookup_request(request_headers, config_->timeSource().systemTime(),
+                               config_->varyAllowList(),
+                               config_->ignoreRequestCacheControlHeader());
+  lookup_ = cache_->makeLookupContext(std::move(lookup_request), *decoder_callbacks_);
+  if (encoder_callbacks_ != nullptr) {
+    lookup_->setEncoderFilterCallbacks(*encoder_callbacks_);
+  }
+  getHeaders(request_headers);
+}
+
+void CacheFilter::onFillWaitTimeout(Http::RequestHeaderMap& request_headers) {
+  ENVOY_STREAM_LOG(debug, "CacheFilter timed out waiting for the fill of the key",
+                   *decoder_callbacks_);
+  stopWaitingForFill();
+  filter_state_ = FilterState::Initial;
+  if (lookup_result_->cache_entry_status_ == CacheEntryStatus::RequiresValidation) {
+    handleCacheHitWithValidation(request_headers);
+  } else {
+    decoder_callbacks_->continueDecoding();
+  }
+}
+
+void CacheFilter::stopWaitingForFill() {
+  // The timer only exists while waiting: the handle of a request filling the cache is left alone.
+  if (fill_wait_timer_ != nullptr) {
+    fill_wait_timer_->disableTimer();
+    fill_wait_timer_.reset();
+    in_flight_fill_.reset();
+  }
+}
+
 // TODO(toddmgreer): Handle downstream backpressure.
 void CacheFilter::onBody(Buffer::InstancePtr&& body) {
   // Can be called during decoding if a valid cache hit is found,
@@ -595,10 +700,14 @@ void CacheFilter::processSuccessfulValidation(Http::ResponseHeaderMap& response_
     // TODO(yosrym93): else the cached entry should be deleted.
     // Update metadata associated with the cached response. Right now this is only response_time;
     const ResponseMetadata metadata = {config_->timeSource().systemTime()};
-    cache_->updateHeaders(*lookup_, response_headers, metadata,
-                          [](bool updated ABSL_ATTRIBUTE_UNUSED) {});
+    // The requests waiting for the validation look the key up once the entry is updated.
+    cache_->updateHeaders(
+        *lookup_, response_headers, metadata,
+        [fill = std::shared_ptr<InFlightFills::Handle>(std::move(in_flight_fill_))](
+            bool updated ABSL_ATTRIBUTE_UNUSED) {});
     insert_status_ = InsertStatus::HeaderUpdate;
   }
+  in_flight_fill_.reset();
 
   // A cache entry was successfully validated -> encode cached body and trailers.
   encodeCachedResponse();
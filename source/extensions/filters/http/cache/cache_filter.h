@@ -12,6 +12,7 @@
 #include "source/extensions/filters/http/cache/cache_headers_utils.h"
 #include "source/extensions/filters/http/cache/cache_insert_queue.h"
 #include "source/extensions/filters/http/cache/http_cache.h"
+#include "source/extensions/filters/http/cache/in_flight_fills.h"
 #include "source/extensions/filters/http/common/pass_through_filter.h"
 
 namespace Envoy {
@@ -25,6 +26,10 @@ enum class FilterState {
   // Cache lookup found a cached response that requires validation.
   ValidatingCachedResponse,
 
+  // Cache lookup missed, or found a cached response that requires validation, while another
+  // request is filling the cache for the same key. The lookup is retried once the fill is over.
+  WaitingForFill,
+
   // Cache lookup found a fresh cached response and it is being added to the encoding stream.
   DecodeServingFromCache,
 
@@ -55,11 +60,17 @@ public:
   const VaryAllowList& varyAllowList() const { return vary_allow_list_; }
   TimeSource& timeSource() const { return time_source_; }
   bool ignoreRequestCacheControlHeader() const { return ignore_request_cache_control_header_; }
+  // The fills in flight of the filters sharing this config, null unless the requests are
+  // collapsed.
+  InFlightFills* inFlightFills() const { return in_flight_fills_.get(); }
+  std::chrono::milliseconds collapsedRequestTimeout() const { return collapsed_request_timeout_; }
 
 private:
   const VaryAllowList vary_allow_list_;
   TimeSource& time_source_;
   const bool ignore_request_cache_control_header_;
+  const std::chrono::milliseconds collapsed_request_timeout_;
+  const InFlightFillsSharedPtr in_flight_fills_;
 };
 
 /**
@@ -97,6 +108,16 @@ private:
   void onBody(Buffer::InstancePtr&& body);
   void onTrailers(Http::ResponseTrailerMapPtr&& trailers);
 
+  // Waits for the fill in flight for the key of the request, if there is one and the requests are
+  // collapsed. Otherwise the request becomes the fill of the key, if it can fill the cache. Returns
+  // true if the request waits.
+  bool waitForFill(Http::RequestHeaderMap& request_headers);
+  // Looks the key up again once the fill the request waited for is over.
+  void onFillDone(Http::RequestHeaderMap& request_headers);
+  // Handles the lookup result the request had before waiting, as no fill completed in time.
+  void onFillWaitTimeout(Http::RequestHeaderMap& request_headers);
+  void stopWaitingForFill();
+
   // Set required state in the CacheFilter for handling a cache hit.
   void handleCacheHit();
 
@@ -171,6 +192,14 @@ private:
   // The status of the insert operation or header update, or decision not to insert or update.
   // If it's too early to determine the final status, this is empty.
   absl::optional<InsertStatus> insert_status_;
+
+  // The stable hash of the key of the request, identifying its fill.
+  uint64_t key_hash_ = 0;
+  // The fill of the cache this request performs, or its wait for the fill of another request.
+  InFlightFills::HandlePtr in_flight_fill_;
+  Event::TimerPtr fill_wait_timer_;
+  // A request only waits for a fill once.
+  bool waited_for_fill_ = false;
 };
 
 using CacheFilterSharedPtr = std::shared_ptr<CacheFilter>;
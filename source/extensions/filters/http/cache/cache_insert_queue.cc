@@ -163,6 +163,8 @@ void CacheInsertQueue::onFragmentComplete(bool cache_success, bool end_stream, s
     if (end_stream) {
       ASSERT(fragments_.empty(), "ending a stream with the queue not empty is a bug");
       ASSERT(!watermarked_, "being over the high watermark when the queue is empty makes no sense");
+      // The entry is complete, the requests waiting for it can look it up.
+      in_flight_fill_.reset();
       self_ownership_.reset();
       return;
     }
@@ -4,6 +4,7 @@
 #include <functional>
 
 #include "source/extensions/filters/http/cache/http_cache.h"
+#include "source/extensions/filters/http/cache/in_flight_fills.h"
 
 namespace Envoy {
 namespace Extensions {
@@ -42,6 +43,9 @@ public:
   void insertBody(const Buffer::Instance& fragment, bool end_stream);
   void insertTrailers(const Http::ResponseTrailerMap& trailers);
   void setSelfOwned(std::unique_ptr<CacheInsertQueue> self);
+  // Keeps the fill of the key in flight until the queue is done with the cache, so that the
+  // requests waiting for it find the complete entry.
+  void setInFlightFill(InFlightFills::HandlePtr fill) { in_flight_fill_ = std::move(fill); }
   ~CacheInsertQueue();
 
 private:
@@ -78,6 +82,8 @@ private:
   // while a cache action is still in flight, which can cause the cache to be
   // deleted prematurely.
   std::shared_ptr<HttpCache> cache_;
+  // Reset once the entry is complete, or by the destructor once the insert context is done.
+  InFlightFills::HandlePtr in_flight_fill_;
 };
 
 } // namespace Cache
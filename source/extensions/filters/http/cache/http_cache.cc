@@ -54,6 +54,12 @@ LookupRequest::LookupRequest(const Http::RequestHeaderMap& request_headers, Syst
   }
 }
 
+LookupRequest::LookupRequest(const LookupRequest& other)
+    : key_(other.key_), request_range_spec_(other.request_range_spec_),
+      request_headers_(Http::createHeaderMap<Http::RequestHeaderMapImpl>(*other.request_headers_)),
+      vary_allow_list_(other.vary_allow_list_), timestamp_(other.timestamp_),
+      request_cache_control_(other.request_cache_control_) {}
+
 // Unless this API is still alpha, calls to stableHashKey() must always return
 // the same result, or a way must be provided to deal with a complete cache
 // flush.
@@ -80,6 +80,9 @@ public:
   LookupRequest(const Http::RequestHeaderMap& request_headers, SystemTime timestamp,
                 const VaryAllowList& vary_allow_list,
                 bool ignore_request_cache_control_header = false);
+  // Copies the request, e.g. to look it up in several caches.
+  LookupRequest(const LookupRequest& other);
+  LookupRequest(LookupRequest&& other) = default;
 
   const RequestCacheControl& requestCacheControl() const { return request_cache_control_; }
 
@@ -217,6 +220,11 @@ public:
   // Http::ResponseTrailerMapPtr passed to cb must not be null.
   virtual void getTrailers(LookupTrailersCallback&& cb) PURE;
 
+  // Called before getHeaders with the encoder callbacks of the stream, for caches that insert
+  // while serving a lookup, e.g. to copy an entry between tiers. The callbacks outlive the
+  // LookupContext.
+  virtual void setEncoderFilterCallbacks(Http::StreamEncoderFilterCallbacks&) {}
+
   // This routine is called prior to a LookupContext being destroyed. LookupContext is responsible
   // for making sure that any async activities are cleaned up before returning from onDestroy().
   // This includes timers, network calls, etc. The reason there is an onDestroy() method vs. doing
@@ -0,0 +1,77 @@
+#include "source/extensions/filters/http/cache/in_flight_fills.h"
+
+#include "source/common/common/assert.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace Cache {
+
+// Holds the fills alive as the handles can outlive the filter config, e.g. in an insert queue
+// completing the write of an entry.
+class InFlightFills::FillHandle : public Handle {
+public:
+  FillHandle(InFlightFillsSharedPtr parent, uint64_t key_hash)
+      : parent_(std::move(parent)), key_hash_(key_hash) {}
+  ~FillHandle() override { parent_->endFill(key_hash_); }
+
+private:
+  const InFlightFillsSharedPtr parent_;
+  const uint64_t key_hash_;
+};
+
+class InFlightFills::WaitHandle : public Handle {
+public:
+  WaitHandle(InFlightFillsSharedPtr parent, uint64_t key_hash, Event::Dispatcher& dispatcher,
+             FillDoneCallback on_fill_done)
+      : parent_(std::move(parent)), key_hash_(key_hash),
+        waiter_{dispatcher, std::move(on_fill_done)} {}
+  ~WaitHandle() override { parent_->endWait(key_hash_, &waiter_); }
+
+  const Waiter& waiter() const { return waiter_; }
+
+private:
+  const InFlightFillsSharedPtr parent_;
+  const uint64_t key_hash_;
+  const Waiter waiter_;
+};
+
+InFlightFills::StartResult InFlightFills::startFillOrWait(uint64_t key_hash,
+                                                         Event::Dispatcher& dispatcher,
+                                                         FillDoneCallback on_fill_done) {
+  absl::MutexLock lock(&mutex_);
+  auto fill = fills_.find(key_hash);
+  if (fill == fills_.end()) {
+    fills_[key_hash];
+    return {std::make_unique<FillHandle>(shared_from_this(), key_hash), true};
+  }
+  auto wait = std::make_unique<WaitHandle>(shared_from_this(), key_hash, dispatcher,
+                                           std::move(on_fill_done));
+  fill->second.push_back(&wait->waiter());
+  return {std::move(wait), false};
+}
+
+void InFlightFills::endFill(uint64_t key_hash) {
+  absl::MutexLock lock(&mutex_);
+  auto fill = fills_.find(key_hash);
+  ASSERT(fill != fills_.end());
+  // The waiters are still registered, so they can't be destroyed before their callback is posted.
+  for (const Waiter* waiter : fill->second) {
+    waiter->dispatcher_.post(waiter->on_fill_done_);
+  }
+  fills_.erase(fill);
+}
+
+void InFlightFills::endWait(uint64_t key_hash, const Waiter* waiter) {
+  absl::MutexLock lock(&mutex_);
+  auto fill = fills_.find(key_hash);
+  // The fill may have ended, and another one started since.
+  if (fill != fills_.end()) {
+    fill->second.remove(waiter);
+  }
+}
+
+} // namespace Cache
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <memory>
+
+#include "envoy/event/dispatcher.h"
+
+#include "absl/base/thread_annotations.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/synchronization/mutex.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace Cache {
+
+// Tracks the cache fills in flight, shared by the filters of all the workers, so that the
+// concurrent requests missing a key wait for the request filling the cache for it rather than
+// all going upstream.
+class InFlightFills : public std::enable_shared_from_this<InFlightFills> {
+public:
+  using FillDoneCallback = std::function<void()>;
+
+  // Ends the fill of a key, or the wait for it, when destroyed.
+  class Handle {
+  public:
+    virtual ~Handle() = default;
+  };
+  using HandlePtr = std::unique_ptr<Handle>;
+
+  struct StartResult {
+    HandlePtr handle_;
+    // True if the caller fills the cache for the key, false if it waits for the fill in flight.
+    bool is_fill_;
+  };
+
+  // Starts the fill of the key unless one is in flight. Otherwise the caller waits for it, and
+  // on_fill_done is posted to dispatcher when the fill ends, unless the wait ended first.
+  StartResult startFillOrWait(uint64_t key_hash, Event::Dispatcher& dispatcher,
+                              FillDoneCallback on_fill_done);
+
+private:
+  struct Waiter {
+    Event::Dispatcher& dispatcher_;
+    const FillDoneCallback on_fill_done_;
+  };
+
+  class FillHandle;
+  class WaitHandle;
+
+  void endFill(uint64_t key_hash);
+  void endWait(uint64_t key_hash, const Waiter* waiter);
+
+  absl::Mutex mutex_;
+  // The waiters of the fills in flight. A fill only has an entry while in flight.
+  absl::flat_hash_map<uint64_t, std::list<const Waiter*>> fills_ ABSL_GUARDED_BY(mutex_);
+};
+
+using InFlightFillsSharedPtr = std::shared_ptr<InFlightFills>;
+
+} // namespace Cache
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
@@ -6,20 +6,73 @@
 #include "envoy/event/timer.h"
 
 #include "source/common/common/assert.h"
+#include "source/common/common/scope_tracker.h"
 #include "source/common/common/token_bucket_impl.h"
 
+#include "absl/container/flat_hash_map.h"
+
 namespace Envoy {
 namespace Extensions {
 namespace HttpFilters {
 namespace Common {
 
+StreamRateLimiterScheduler::StreamRateLimiterScheduler(Event::Dispatcher& dispatcher,
+                                                       std::chrono::milliseconds fill_interval)
+    : dispatcher_(dispatcher), fill_interval_(fill_interval),
+      timer_(dispatcher.createTimer([this] { onTick(); })) {}
+
+std::shared_ptr<StreamRateLimiterScheduler>
+StreamRateLimiterScheduler::get(Event::Dispatcher& dispatcher,
+                                std::chrono::milliseconds fill_interval) {
+  // The dispatchers of a thread are only used by the thread. The expired schedulers are replaced
+  // when their dispatcher and fill interval are used again.
+  static thread_local absl::flat_hash_map<std::pair<Event::Dispatcher*, int64_t>,
+                                          std::weak_ptr<StreamRateLimiterScheduler>>
+      schedulers;
+  std::weak_ptr<StreamRateLimiterScheduler>& weak_scheduler =
+      schedulers[{&dispatcher, fill_interval.count()}];
+  std::shared_ptr<StreamRateLimiterScheduler> scheduler = weak_scheduler.lock();
+  if (scheduler == nullptr) {
+    scheduler = std::make_shared<StreamRateLimiterScheduler>(dispatcher, fill_interval);
+    weak_scheduler = scheduler;
+  }
+  return scheduler;
+}
+
+void StreamRateLimiterScheduler::schedule(const EntrySharedPtr& entry) {
+  if (entry->scheduled_) {
+    return;
+  }
+  entry->scheduled_ = true;
+  scheduled_.push_back(entry);
+  if (!timer_->enabled()) {
+    timer_->enableTimer(fill_interval_);
+  }
+}
+
+void StreamRateLimiterScheduler::onTick() {
+  // The callbacks may destroy the last limiter using the scheduler.
+  const std::shared_ptr<StreamRateLimiterScheduler> self = shared_from_this();
+  // The entries scheduled by the callbacks are run by the next tick.
+  ticking_.swap(scheduled_);
+  for (const EntrySharedPtr& entry : ticking_) {
+    entry->scheduled_ = false;
+    if (entry->active_) {
+      ScopeTrackerScopeState scope(entry->scope_, dispatcher_);
+      entry->cb_();
+    }
+  }
+  ticking_.clear();
+}
+
 StreamRateLimiter::StreamRateLimiter(
     uint64_t max_kbps, uint64_t max_buffered_data, std::function<void()> pause_data_cb,
     std::function<void()> resume_data_cb,
     std::function<void(Buffer::Instance&, bool)> write_data_cb, std::function<void()> continue_cb,
     std::function<void(uint64_t, bool, std::chrono::milliseconds)> write_stats_cb,
     TimeSource& time_source, Event::Dispatcher& dispatcher, const ScopeTrackedObject& scope,
-    std::shared_ptr<TokenBucket> token_bucket, std::chrono::milliseconds fill_interval)
+    std::shared_ptr<TokenBucket> token_bucket, std::chrono::milliseconds fill_interval,
+    bool shared_fill_timer)
     : fill_interval_(std::move(fill_interval)), write_data_cb_(write_data_cb),
       continue_cb_(continue_cb), write_stats_cb_(std::move(write_stats_cb)), scope_(scope),
       token_bucket_(std::move(token_bucket)),
@@ -46,6 +99,11 @@ StreamRateLimiter::StreamRateLimiter(
             "initial_tokens={} max_tokens={}",
             fill_interval_.count(), initial_tokens, max_tokens);
   buffer_.setWatermarks(max_buffered_data);
+  if (shared_fill_timer) {
+    scheduler_ = StreamRateLimiterScheduler::get(dispatcher, fill_interval_);
+    scheduler_entry_ = std::make_shared<StreamRateLimiterScheduler::Entry>(
+        StreamRateLimiterScheduler::Entry{[this] { onTokenTimer(); }, &scope_});
+  }
 }
 
 void StreamRateLimiter::onTokenTimer() {
@@ -74,7 +132,11 @@ void StreamRateLimiter::onTokenTimer() {
               "StreamRateLimiter <onTokenTimer>: scheduling wakeup for {}ms, "
               "buffered={}",
               fill_interval_.count(), buffer_.length());
-    token_timer_->enableTimer(fill_interval_, &scope_);
+    if (scheduler_ != nullptr) {
+      scheduler_->schedule(scheduler_entry_);
+    } else {
+      token_timer_->enableTimer(fill_interval_, &scope_);
+    }
   }
 
   // Write the data out, indicating end stream if we saw end stream, there is no further data to
@@ -100,11 +162,13 @@ void StreamRateLimiter::writeData(Buffer::Instance& incoming_buffer, bool end_st
     saw_trailers_ = true;
   }
 
+  const bool scheduled =
+      token_timer_->enabled() || (scheduler_entry_ != nullptr && scheduler_entry_->scheduled_);
   ENVOY_LOG(debug,
             "StreamRateLimiter <writeData>: got new {} bytes of data. token "
             "timer {} scheduled.",
-            len, !token_timer_->enabled() ? "now" : "already");
-  if (!token_timer_->enabled()) {
+            len, !scheduled ? "now" : "already");
+  if (!scheduled) {
     // TODO(mattklein123): In an optimal world we would be able to continue iteration with the data
     // we want in the buffer, but have a way to clear end_stream in case we can't send it all.
     // The filter API does not currently support that and it will not be a trivial change to add.
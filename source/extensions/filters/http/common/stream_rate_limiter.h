@@ -22,6 +22,49 @@ namespace Extensions {
 namespace HttpFilters {
 namespace Common {
 
+/**
+ * Runs the token refills of the throttled streams of a worker which have the same fill interval on
+ * a single periodic timer, instead of a timer for each stream. The streams waiting for tokens are
+ * serviced together on each tick.
+ */
+class StreamRateLimiterScheduler
+    : public std::enable_shared_from_this<StreamRateLimiterScheduler> {
+public:
+  struct Entry {
+    std::function<void()> cb_;
+    const ScopeTrackedObject* scope_;
+    // Cleared when the stream goes away.
+    bool active_{true};
+    bool scheduled_{};
+  };
+  using EntrySharedPtr = std::shared_ptr<Entry>;
+
+  StreamRateLimiterScheduler(Event::Dispatcher& dispatcher,
+                             std::chrono::milliseconds fill_interval);
+
+  /**
+   * @return the scheduler of the fill interval on the dispatcher, which is shared by the limiters
+   * of the dispatcher's thread as long as any of them uses it.
+   */
+  static std::shared_ptr<StreamRateLimiterScheduler> get(Event::Dispatcher& dispatcher,
+                                                         std::chrono::milliseconds fill_interval);
+
+  /**
+   * Runs the callback of the entry on the next tick, if it isn't scheduled yet.
+   */
+  void schedule(const EntrySharedPtr& entry);
+
+private:
+  void onTick();
+
+  Event::Dispatcher& dispatcher_;
+  const std::chrono::milliseconds fill_interval_;
+  const Event::TimerPtr timer_;
+  std::vector<EntrySharedPtr> scheduled_;
+  // The entries run by the current tick.
+  std::vector<EntrySharedPtr> ticking_;
+};
+
 /**
  * A generic HTTP stream rate limiter. It limits the rate of transfer for a stream to the specified
  * max rate. It calls appropriate callbacks when the buffered data crosses certain high and low
@@ -45,6 +88,8 @@ public:
    * @param time_source the time source to run the token bucket with.
    * @param dispatcher the stream's dispatcher to use for creating timers.
    * @param scope the stream's scope
+   * @param shared_fill_timer whether the token refills are run by the StreamRateLimiterScheduler
+   *                          of the dispatcher instead of a timer of the stream.
    */
   StreamRateLimiter(uint64_t max_kbps, uint64_t max_buffered_data,
                     std::function<void()> pause_data_cb, std::function<void()> resume_data_cb,
@@ -54,7 +99,10 @@ public:
                     TimeSource& time_source, Event::Dispatcher& dispatcher,
                     const ScopeTrackedObject& scope,
                     std::shared_ptr<TokenBucket> token_bucket = nullptr,
-                    std::chrono::milliseconds fill_interval = DefaultFillInterval);
+                    std::chrono::milliseconds fill_interval = DefaultFillInterval,
+                    bool shared_fill_timer = false);
+
+  ~StreamRateLimiter() { destroy(); }
 
   /**
    * Called by the stream to write data. All data writes happen asynchronously, the stream should
@@ -72,7 +120,12 @@ public:
    * Like the owning filter, we must handle inline destruction, so we have a destroy() method which
    * kills any callbacks.
    */
-  void destroy() { token_timer_.reset(); }
+  void destroy() {
+    token_timer_.reset();
+    if (scheduler_entry_ != nullptr) {
+      scheduler_entry_->active_ = false;
+    }
+  }
   bool destroyed() { return token_timer_ == nullptr; }
 
 private:
@@ -88,6 +141,9 @@ private:
   const ScopeTrackedObject& scope_;
   std::shared_ptr<TokenBucket> token_bucket_;
   Event::TimerPtr token_timer_;
+  // Set if the refills are run by the scheduler.
+  std::shared_ptr<StreamRateLimiterScheduler> scheduler_;
+  StreamRateLimiterScheduler::EntrySharedPtr scheduler_entry_;
   bool saw_end_stream_{};
   bool saw_trailers_{};
   Buffer::WatermarkBuffer buffer_;
@@ -0,0 +1,67 @@
+#include "source/extensions/filters/http/compressor/compressed_variant_cache.h"
+
+#include <algorithm>
+
+#include "source/common/common/assert.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace Compressor {
+
+namespace {
+
+// Default maximum size of a cached compressed body.
+constexpr uint64_t DefaultMaxEntryBytes = 1024 * 1024;
+
+} // namespace
+
+CompressedVariantCache::CompressedVariantCache(uint64_t max_size_bytes, uint64_t max_entry_bytes)
+    : max_size_bytes_(max_size_bytes),
+      max_entry_bytes_(
+          std::min(max_size_bytes, max_entry_bytes > 0 ? max_entry_bytes : DefaultMaxEntryBytes)) {}
+
+std::shared_ptr<const std::string> CompressedVariantCache::lookup(const std::string& key) {
+  absl::MutexLock lock(&mutex_);
+  auto iter = entries_.find(key);
+  if (iter == entries_.end()) {
+    return nullptr;
+  }
+  lru_.splice(lru_.begin(), lru_, iter->second.lru_position_);
+  return iter->second.body_;
+}
+
+void CompressedVariantCache::insert(const std::string& key, std::string&& body) {
+  if (body.size() > max_entry_bytes_) {
+    return;
+  }
+  auto shared_body = std::make_shared<const std::string>(std::move(body));
+  absl::MutexLock lock(&mutex_);
+  if (auto iter = entries_.find(key); iter != entries_.end()) {
+    eraseLocked(iter);
+  }
+  while (size_bytes_ + shared_body->size() > max_size_bytes_ && !lru_.empty()) {
+    eraseLocked(entries_.find(*lru_.back()));
+  }
+  size_bytes_ += shared_body->size();
+  auto [iter, inserted] = entries_.try_emplace(key, Entry{std::move(shared_body), {}});
+  ASSERT(inserted);
+  lru_.push_front(&iter->first);
+  iter->second.lru_position_ = lru_.begin();
+}
+
+uint64_t CompressedVariantCache::sizeBytes() const {
+  absl::MutexLock lock(&mutex_);
+  return size_bytes_;
+}
+
+void CompressedVariantCache::eraseLocked(EntryMap::iterator iter) {
+  size_bytes_ -= iter->second.body_->size();
+  lru_.erase(iter->second.lru_position_);
+  entries_.erase(iter);
+}
+
+} // namespace Compressor
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
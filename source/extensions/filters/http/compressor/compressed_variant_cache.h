@@ -0,0 +1,60 @@
+#pragma once
+
+#include <list>
+#include <memory>
+#include <string>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/container/node_hash_map.h"
+#include "absl/synchronization/mutex.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace Compressor {
+
+/**
+ * A bounded cache of compressed response bodies, shared by the workers. The least recently used
+ * bodies are evicted when the cache is full. The bodies are immutable and shared with the
+ * responses being served from them.
+ */
+class CompressedVariantCache {
+public:
+  CompressedVariantCache(uint64_t max_size_bytes, uint64_t max_entry_bytes);
+
+  // Returns the compressed body of the key, or nullptr if it isn't cached.
+  std::shared_ptr<const std::string> lookup(const std::string& key) ABSL_LOCKS_EXCLUDED(mutex_);
+
+  // Caches the compressed body of the key, replacing any previous one. Bodies larger than
+  // maxEntryBytes() are not cached.
+  void insert(const std::string& key, std::string&& body) ABSL_LOCKS_EXCLUDED(mutex_);
+
+  uint64_t maxEntryBytes() const { return max_entry_bytes_; }
+  uint64_t sizeBytes() const ABSL_LOCKS_EXCLUDED(mutex_);
+
+private:
+  struct Entry {
+    std::shared_ptr<const std::string> body_;
+    // The position of the entry in the LRU list.
+    std::list<const std::string*>::iterator lru_position_;
+  };
+  using EntryMap = absl::node_hash_map<std::string, Entry>;
+
+  void eraseLocked(EntryMap::iterator iter) ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+
+  const uint64_t max_size_bytes_;
+  const uint64_t max_entry_bytes_;
+  mutable absl::Mutex mutex_;
+  // The entry nodes are stable, so the LRU list points to their keys.
+  EntryMap entries_ ABSL_GUARDED_BY(mutex_);
+  // The most recently used keys first.
+  std::list<const std::string*> lru_ ABSL_GUARDED_BY(mutex_);
+  uint64_t size_bytes_ ABSL_GUARDED_BY(mutex_){};
+};
+
+using CompressedVariantCacheSharedPtr = std::shared_ptr<CompressedVariantCache>;
+
+} // namespace Compressor
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
@@ -1,6 +1,7 @@
 #include "source/extensions/filters/http/compressor/compressor_filter.h"
 
 #include "source/common/buffer/buffer_impl.h"
+#include "source/common/common/base64.h"
 #include "source/common/http/header_map_impl.h"
 #include "source/common/http/utility.h"
 
@@ -15,6 +16,8 @@ using envoy::extensions::filters::http::compressor::v3::CompressorPerRoute;
 
 Http::RegisterCustomInlineHeader<Http::CustomInlineHeaderRegistry::Type::RequestHeaders>
     accept_encoding_handle(Http::CustomHeaders::get().AcceptEncoding);
+Http::RegisterCustomInlineHeader<Http::CustomInlineHeaderRegistry::Type::RequestHeaders>
+    available_dictionary_handle(Http::CustomHeaders::get().AvailableDictionary);
 Http::RegisterCustomInlineHeader<Http::CustomInlineHeaderRegistry::Type::ResponseHeaders>
     cache_control_handle(Http::CustomHeaders::get().CacheControl);
 Http::RegisterCustomInlineHeader<Http::CustomInlineHeaderRegistry::Type::ResponseHeaders>
@@ -54,6 +57,16 @@ const std::vector<std::string>& defaultContentEncoding() {
                                                     "application/grpc-web+proto"});
 }
 
+// Returns the raw hash of the dictionary announced by an "available-dictionary" header, which is a
+// structured field byte sequence, or an empty string if the header is malformed.
+std::string availableDictionaryHash(absl::string_view value) {
+  value = StringUtil::trim(value);
+  if (value.size() < 2 || value.front() != ':' || value.back() != ':') {
+    return "";
+  }
+  return Base64::decode(value.substr(1, value.size() - 2));
+}
+
 // List of CompressorFilterConfig objects registered for a stream.
 struct CompressorRegistry : public StreamInfo::FilterState::Object {
   std::list<CompressorFilterConfigSharedPtr> filter_configs_;
@@ -71,6 +84,26 @@ void compressAndUpdateStats(const Compression::Compressor::CompressorPtr& compre
   stats.total_compressed_bytes_.add(data.length());
 }
 
+// A buffer fragment referencing a cached compressed variant, which it keeps alive until drained.
+class CachedVariantFragment : public Buffer::BufferFragment {
+public:
+  explicit CachedVariantFragment(std::shared_ptr<const std::string> variant)
+      : variant_(std::move(variant)) {}
+
+  // Buffer::BufferFragment
+  const void* data() const override { return variant_->data(); }
+  size_t size() const override { return variant_->size(); }
+  void done() override { delete this; }
+
+private:
+  const std::shared_ptr<const std::string> variant_;
+};
+
+// True if the entity tag is a strong one, i.e. identifies the exact bytes of the response.
+bool isStrongEtag(absl::string_view etag) {
+  return etag.length() > 2 && !((etag[0] == 'w' || etag[0] == 'W') && etag[1] == '/');
+}
+
 } // namespace
 
 CompressorFilterConfig::DirectionConfig::DirectionConfig(
@@ -86,6 +119,7 @@ CompressorFilterConfig::DirectionConfig::DirectionConfig(
 CompressorFilterConfig::CompressorFilterConfig(
     const envoy::extensions::filters::http::compressor::v3::Compressor& proto_config,
     const std::string& stats_prefix, Stats::Scope& scope, Runtime::Loader& runtime,
+    Server::OverloadManager& overload_manager,
     Compression::Compressor::CompressorFactoryPtr compressor_factory)
     : common_stats_prefix_(fmt::format("{}compressor.{}.{}", stats_prefix,
                                        proto_config.compressor_library().name(),
@@ -94,7 +128,14 @@ CompressorFilterConfig::CompressorFilterConfig(
       response_direction_config_(proto_config, common_stats_prefix_, scope, runtime),
       content_encoding_(compressor_factory->contentEncoding()),
       compressor_factory_(std::move(compressor_factory)),
-      choose_first_(proto_config.choose_first()) {}
+      choose_first_(proto_config.choose_first()), overload_manager_(overload_manager),
+      library_stats_{LIBRARY_COMPRESSOR_STATS(POOL_GAUGE_PREFIX(scope, common_stats_prefix_))} {
+  const absl::optional<uint32_t> compression_level =
+      compressor_factory_->compressionLevelForLoad(UnitFloat::min());
+  if (compression_level.has_value()) {
+    library_stats_.compression_level_.set(compression_level.value());
+  }
+}
 
 StringUtil::CaseUnorderedSet CompressorFilterConfig::DirectionConfig::contentTypeSet(
     const Protobuf::RepeatedPtrField<std::string>& types) {
@@ -130,7 +171,17 @@ CompressorFilterConfig::ResponseDirectionConfig::ResponseDirectionConfig(
           proto_config.has_response_direction_config()
               ? proto_config.response_direction_config().remove_accept_encoding_header()
               : proto_config.remove_accept_encoding_header()),
-      response_stats_{generateResponseStats(stats_prefix, scope)} {}
+      response_stats_{generateResponseStats(stats_prefix, scope)},
+      compressed_variant_cache_(
+          proto_config.response_direction_config().has_compressed_variant_cache()
+              ? std::make_shared<CompressedVariantCache>(
+                    proto_config.response_direction_config()
+                        .compressed_variant_cache()
+                        .max_size_bytes(),
+                    proto_config.response_direction_config()
+                        .compressed_variant_cache()
+                        .max_entry_bytes())
+              : nullptr) {}
 
 const envoy::extensions::filters::http::compressor::v3::Compressor::CommonDirectionConfig
 CompressorFilterConfig::ResponseDirectionConfig::commonConfig(
@@ -160,7 +211,16 @@ CompressorFilterConfig::ResponseDirectionConfig::commonConfig(
 }
 
 Envoy::Compression::Compressor::CompressorPtr CompressorFilterConfig::makeCompressor() {
-  return compressor_factory_->createCompressor();
+  const UnitFloat load =
+      overload_manager_.getThreadLocalOverloadState()
+          .getState(Server::OverloadActionNames::get().ReduceCompressionLevel)
+          .value();
+  const absl::optional<uint32_t> compression_level =
+      compressor_factory_->compressionLevelForLoad(load);
+  if (compression_level.has_value()) {
+    library_stats_.compression_level_.set(compression_level.value());
+  }
+  return compressor_factory_->createCompressorForLoad(load);
 }
 
 CompressorFilter::CompressorFilter(const CompressorFilterConfigSharedPtr config)
@@ -200,8 +260,17 @@ Http::FilterHeadersStatus CompressorFilter::decodeHeaders(Http::RequestHeaderMap
     // decision on compressing the corresponding HTTP response.
     accept_encoding_ = std::make_unique<std::string>(accept_encoding->value().getStringView());
   }
+  const Http::HeaderEntry* available_dictionary =
+      headers.getInline(available_dictionary_handle.handle());
+  if (available_dictionary != nullptr) {
+    available_dictionary_ = availableDictionaryHash(available_dictionary->value().getStringView());
+  }
 
   const auto& response_config = config_->responseDirectionConfig();
+  if (response_config.compressedVariantCache() != nullptr &&
+      headers.getMethodValue() == Http::Headers::get().MethodValues.Get) {
+    request_key_ = absl::StrCat(headers.getHostValue(), headers.getPathValue());
+  }
   const auto* per_route_config =
       Http::Utility::resolveMostSpecificPerFilterConfig<CompressorPerRouteFilterConfig>(
           decoder_callbacks_);
@@ -288,12 +357,27 @@ Http::FilterHeadersStatus CompressorFilter::encodeHeaders(Http::ResponseHeaderMa
       isEtagAllowed(headers) && !headers.getInline(response_content_encoding_handle.handle());
   if (!end_stream && isAcceptEncodingAllowed(isEnabledAndContentLengthBigEnough, headers) &&
       isCompressible && isTransferEncodingAllowed(headers)) {
+    // The key is made before the strong etag is removed.
+    std::string variant_key = compressedVariantKey(headers);
     sanitizeEtagHeader(headers);
     headers.removeContentLength();
     headers.setInline(response_content_encoding_handle.handle(), config_->contentEncoding());
     config.stats().compressed_.inc();
-    // Finally instantiate the compressor.
-    response_compressor_ = config_->makeCompressor();
+    if (!variant_key.empty()) {
+      cached_variant_ = config.compressedVariantCache()->lookup(variant_key);
+      if (cached_variant_ != nullptr) {
+        config.responseStats().compressed_variant_cache_hit_.inc();
+        headers.setContentLength(cached_variant_->size());
+      } else {
+        config.responseStats().compressed_variant_cache_miss_.inc();
+        variant_key_ = std::move(variant_key);
+        compressed_variant_ = std::make_unique<std::string>();
+      }
+    }
+    // Finally instantiate the compressor, unless the compressed body is already cached.
+    if (cached_variant_ == nullptr) {
+      response_compressor_ = config_->makeCompressor();
+    }
   } else {
     config.stats().not_compressed_.inc();
   }
@@ -309,26 +393,75 @@ Http::FilterHeadersStatus CompressorFilter::encodeHeaders(Http::ResponseHeaderMa
 }
 
 Http::FilterDataStatus CompressorFilter::encodeData(Buffer::Instance& data, bool end_stream) {
-  if (response_compressor_ != nullptr) {
+  if (cached_variant_ != nullptr) {
+    serveCachedVariant(data);
+  } else if (response_compressor_ != nullptr) {
     compressAndUpdateStats(response_compressor_, config_->responseDirectionConfig().stats(), data,
                            end_stream);
+    if (compressed_variant_ != nullptr) {
+      captureCompressedVariant(data, end_stream);
+    }
   }
   return Http::FilterDataStatus::Continue;
 }
 
 Http::FilterTrailersStatus CompressorFilter::encodeTrailers(Http::ResponseTrailerMap&) {
-  if (response_compressor_ != nullptr) {
+  if (cached_variant_ != nullptr) {
+    if (!cached_variant_sent_) {
+      Buffer::OwnedImpl variant;
+      serveCachedVariant(variant);
+      encoder_callbacks_->addEncodedData(variant, true);
+    }
+  } else if (response_compressor_ != nullptr) {
     Buffer::OwnedImpl empty_buffer;
     // The presence of trailers means the stream is ended, but encodeData()
     // is never called with end_stream=true, thus let the compression library know
     // that the stream is ended.
     compressAndUpdateStats(response_compressor_, config_->responseDirectionConfig().stats(),
                            empty_buffer, true);
+    if (compressed_variant_ != nullptr) {
+      captureCompressedVariant(empty_buffer, true);
+    }
     encoder_callbacks_->addEncodedData(empty_buffer, true);
   }
   return Http::FilterTrailersStatus::Continue;
 }
 
+std::string CompressorFilter::compressedVariantKey(const Http::ResponseHeaderMap& headers) const {
+  if (request_key_.empty()) {
+    return "";
+  }
+  const Http::HeaderEntry* etag = headers.getInline(etag_handle.handle());
+  if (etag == nullptr || !isStrongEtag(etag->value().getStringView())) {
+    return "";
+  }
+  // The dictionary the variant is compressed with may be reloaded.
+  return absl::StrCat(request_key_, "\n", etag->value().getStringView(), "\n",
+                      config_->dictionaryHash());
+}
+
+void CompressorFilter::serveCachedVariant(Buffer::Instance& data) {
+  // The body from upstream is the one the variant was compressed from, so it is dropped.
+  data.drain(data.length());
+  if (!cached_variant_sent_) {
+    data.addBufferFragment(*new CachedVariantFragment(cached_variant_));
+    cached_variant_sent_ = true;
+  }
+}
+
+void CompressorFilter::captureCompressedVariant(const Buffer::Instance& data, bool end_stream) {
+  CompressedVariantCache& cache = *config_->responseDirectionConfig().compressedVariantCache();
+  if (compressed_variant_->size() + data.length() > cache.maxEntryBytes()) {
+    compressed_variant_.reset();
+    return;
+  }
+  absl::StrAppend(compressed_variant_.get(), data.toString());
+  if (end_stream) {
+    cache.insert(variant_key_, std::move(*compressed_variant_));
+    compressed_variant_.reset();
+  }
+}
+
 bool CompressorFilter::hasCacheControlNoTransform(Http::ResponseHeaderMap& headers) const {
   const Http::HeaderEntry* cache_control = headers.getInline(cache_control_handle.handle());
   if (cache_control) {
@@ -367,6 +500,12 @@ CompressorFilter::chooseEncoding(const Http::ResponseHeaderMap& headers) const {
   ASSERT(typed_state != nullptr);
 
   for (const auto& filter_config : (*typed_state).filter_configs_) {
+    // A compressor with a dictionary is only allowed for the clients which have the dictionary.
+    const std::string dictionary_hash = filter_config->dictionaryHash();
+    if (!dictionary_hash.empty() && dictionary_hash != available_dictionary_) {
+      continue;
+    }
+
     // A compressor filter may be limited to compress certain Content-Types. If the response's
     // content type doesn't match the list of content types this filter is enabled for then
     // it must be excluded from the decision process.
@@ -609,18 +748,22 @@ bool CompressorFilter::isTransferEncodingAllowed(Http::RequestOrResponseHeaderMa
 }
 
 void CompressorFilter::insertVaryHeader(Http::ResponseHeaderMap& headers) {
+  insertVaryValue(headers, Http::CustomHeaders::get().VaryValues.AcceptEncoding);
+  if (!config_->dictionaryHash().empty()) {
+    insertVaryValue(headers, Http::CustomHeaders::get().VaryValues.AvailableDictionary);
+  }
+}
+
+void CompressorFilter::insertVaryValue(Http::ResponseHeaderMap& headers, const std::string& value) {
   const Http::HeaderEntry* vary = headers.getInline(vary_handle.handle());
   if (vary != nullptr) {
-    if (!StringUtil::findToken(vary->value().getStringView(), ",",
-                               Http::CustomHeaders::get().VaryValues.AcceptEncoding, true)) {
+    if (!StringUtil::findToken(vary->value().getStringView(), ",", value, true)) {
       std::string new_header;
-      absl::StrAppend(&new_header, vary->value().getStringView(), ", ",
-                      Http::CustomHeaders::get().VaryValues.AcceptEncoding);
+      absl::StrAppend(&new_header, vary->value().getStringView(), ", ", value);
       headers.setInline(vary_handle.handle(), new_header);
     }
   } else {
-    headers.setReferenceInline(vary_handle.handle(),
-                               Http::CustomHeaders::get().VaryValues.AcceptEncoding);
+    headers.setReferenceInline(vary_handle.handle(), value);
   }
 }
 
@@ -631,11 +774,8 @@ void CompressorFilter::insertVaryHeader(Http::ResponseHeaderMap& headers) {
 // the strong ones when disable_on_etag_header is false. Envoy does NOT re-write entity tags.
 void CompressorFilter::sanitizeEtagHeader(Http::ResponseHeaderMap& headers) {
   const Http::HeaderEntry* etag = headers.getInline(etag_handle.handle());
-  if (etag != nullptr) {
-    absl::string_view value(etag->value().getStringView());
-    if (value.length() > 2 && !((value[0] == 'w' || value[0] == 'W') && value[1] == '/')) {
-      headers.removeInline(etag_handle.handle());
-    }
+  if (etag != nullptr && isStrongEtag(etag->value().getStringView())) {
+    headers.removeInline(etag_handle.handle());
   }
 }
 
@@ -2,11 +2,13 @@
 
 #include "envoy/compression/compressor/factory.h"
 #include "envoy/extensions/filters/http/compressor/v3/compressor.pb.h"
+#include "envoy/server/overload/overload_manager.h"
 #include "envoy/stats/stats_macros.h"
 
 #include "source/common/protobuf/protobuf.h"
 #include "source/common/runtime/runtime_protos.h"
 #include "source/extensions/filters/http/common/pass_through_filter.h"
+#include "source/extensions/filters/http/compressor/compressed_variant_cache.h"
 
 #include "absl/types/optional.h"
 
@@ -39,6 +41,9 @@ namespace Compressor {
  *
  * "header_gzip" is specific to the gzip filter and is deprecated since it duplicates
  * "header_compressor_used".
+ *
+ * "compressed_variant_cache_hit" and "compressed_variant_cache_miss" count the compressed
+ * responses served from the compressed variant cache and the ones compressed for it.
  */
 #define RESPONSE_COMPRESSOR_STATS(COUNTER)                                                         \
   COUNTER(no_accept_header)                                                                        \
@@ -47,7 +52,17 @@ namespace Compressor {
   COUNTER(header_compressor_overshadowed)                                                          \
   COUNTER(header_wildcard)                                                                         \
   COUNTER(header_not_valid)                                                                        \
-  COUNTER(not_compressed_etag)
+  COUNTER(not_compressed_etag)                                                                     \
+  COUNTER(compressed_variant_cache_hit)                                                            \
+  COUNTER(compressed_variant_cache_miss)
+
+/**
+ * Compressor filter stats of the compressor library. @see stats_macros.h
+ * "compression_level" is the compression level last applied by the compressor library, which is
+ * lowered by the envoy.overload_actions.reduce_compression_level overload action. It is only set
+ * for the compressor libraries which support lowering their compression level.
+ */
+#define LIBRARY_COMPRESSOR_STATS(GAUGE) GAUGE(compression_level, NeverImport)
 
 /**
  * Struct definitions for compressor stats. @see stats_macros.h
@@ -58,6 +73,9 @@ struct CompressorStats {
 struct ResponseCompressorStats {
   RESPONSE_COMPRESSOR_STATS(GENERATE_COUNTER_STRUCT)
 };
+struct LibraryCompressorStats {
+  LIBRARY_COMPRESSOR_STATS(GENERATE_GAUGE_STRUCT)
+};
 
 /**
  * Configuration for the compressor filter.
@@ -121,6 +139,10 @@ public:
     const ResponseCompressorStats& responseStats() const { return response_stats_; }
     bool disableOnEtagHeader() const { return disable_on_etag_header_; }
     bool removeAcceptEncodingHeader() const { return remove_accept_encoding_header_; }
+    // The cache of the compressed bodies, nullptr if not configured.
+    CompressedVariantCache* compressedVariantCache() const {
+      return compressed_variant_cache_.get();
+    }
 
   private:
     static ResponseCompressorStats generateResponseStats(const std::string& prefix,
@@ -136,17 +158,23 @@ public:
     const bool disable_on_etag_header_;
     const bool remove_accept_encoding_header_;
     const ResponseCompressorStats response_stats_;
+    const CompressedVariantCacheSharedPtr compressed_variant_cache_;
   };
 
   CompressorFilterConfig() = delete;
   CompressorFilterConfig(
       const envoy::extensions::filters::http::compressor::v3::Compressor& proto_config,
       const std::string& stats_prefix, Stats::Scope& scope, Runtime::Loader& runtime,
+      Server::OverloadManager& overload_manager,
       Envoy::Compression::Compressor::CompressorFactoryPtr compressor_factory);
 
+  // Makes a compressor for the current state of the overload action reducing the compression
+  // level. Must be called on a worker thread.
   Envoy::Compression::Compressor::CompressorPtr makeCompressor();
 
   const std::string contentEncoding() const { return content_encoding_; };
+  // The raw hash of the dictionary the compressors compress with, empty if they don't.
+  std::string dictionaryHash() const { return compressor_factory_->dictionaryHash(); }
   bool chooseFirst() const { return choose_first_; };
   const RequestDirectionConfig& requestDirectionConfig() { return request_direction_config_; }
   const ResponseDirectionConfig& responseDirectionConfig() { return response_direction_config_; }
@@ -159,6 +187,8 @@ private:
   const std::string content_encoding_;
   const Envoy::Compression::Compressor::CompressorFactoryPtr compressor_factory_;
   const bool choose_first_;
+  Server::OverloadManager& overload_manager_;
+  LibraryCompressorStats library_stats_;
 };
 using CompressorFilterConfigSharedPtr = std::shared_ptr<CompressorFilterConfig>;
 
@@ -209,6 +239,15 @@ private:
 
   void sanitizeEtagHeader(Http::ResponseHeaderMap& headers);
   void insertVaryHeader(Http::ResponseHeaderMap& headers);
+  static void insertVaryValue(Http::ResponseHeaderMap& headers, const std::string& value);
+
+  // Returns the key of the compressed variant of the response in the cache, or an empty string
+  // if the response can't be cached.
+  std::string compressedVariantKey(const Http::ResponseHeaderMap& headers) const;
+  // Replaces the response body with the cached compressed variant.
+  void serveCachedVariant(Buffer::Instance& data);
+  // Appends the compressed data to the variant being cached, caching it at the end of the stream.
+  void captureCompressedVariant(const Buffer::Instance& data, bool end_stream);
 
   class EncodingDecision : public StreamInfo::FilterState::Object {
   public:
@@ -235,6 +274,16 @@ private:
   Envoy::Compression::Compressor::CompressorPtr request_compressor_;
   const CompressorFilterConfigSharedPtr config_;
   std::unique_ptr<std::string> accept_encoding_;
+  // The raw hash of the dictionary announced by the "available-dictionary" request header.
+  std::string available_dictionary_;
+  // The authority and the path of a GET request, if the compressed variants are cached.
+  std::string request_key_;
+  // The cached compressed variant being served, in place of the response body.
+  std::shared_ptr<const std::string> cached_variant_;
+  bool cached_variant_sent_{};
+  // The key and the compressed body of the variant being compressed for the cache.
+  std::string variant_key_;
+  std::unique_ptr<std::string> compressed_variant_;
 };
 
 } // namespace Compressor
@@ -208,25 +208,12 @@ void CorsFilter::setDecoderFilterCallbacks(Http::StreamDecoderFilterCallbacks& c
 }
 
 bool CorsFilter::isOriginAllowed(const Http::HeaderString& origin) {
-  const auto allow_origins = allowOrigins();
-  if (allow_origins == nullptr) {
-    return false;
-  }
-  for (const auto& allow_origin : *allow_origins) {
-    if (allow_origin->match("*") || allow_origin->match(origin.getStringView())) {
-      return true;
-    }
-  }
-  return false;
-}
-
-const std::vector<Matchers::StringMatcherPtr>* CorsFilter::allowOrigins() {
   for (const auto policy : policies_) {
     if (policy && !policy->allowOrigins().empty()) {
-      return &policy->allowOrigins();
+      return policy->isOriginAllowed(origin.getStringView());
     }
   }
-  return nullptr;
+  return false;
 }
 
 bool CorsFilter::forwardNotMatchingPreflights() {
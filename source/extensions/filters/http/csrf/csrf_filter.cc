@@ -3,11 +3,12 @@
 #include "envoy/extensions/filters/http/csrf/v3/csrf.pb.h"
 #include "envoy/stats/scope.h"
 
-#include "source/common/common/empty_string.h"
 #include "source/common/http/header_map_impl.h"
 #include "source/common/http/headers.h"
 #include "source/common/http/utility.h"
 
+#include "absl/strings/str_cat.h"
+
 namespace Envoy {
 namespace Extensions {
 namespace HttpFilters {
@@ -34,38 +35,39 @@ bool isModifyMethod(const Http::RequestHeaderMap& headers) {
           method_type == method_values.Delete || method_type == method_values.Patch);
 }
 
-std::string hostAndPort(const absl::string_view absolute_url) {
+// Returns a view of the host and port of the URL, or of the whole URL if it can't be parsed.
+absl::string_view hostAndPort(const absl::string_view absolute_url) {
   Http::Utility::Url url;
-  if (!absolute_url.empty()) {
-    if (url.initialize(absolute_url, /*is_connect=*/false)) {
-      return std::string(url.hostAndPort());
-    }
-    return std::string(absolute_url);
+  if (!absolute_url.empty() && url.initialize(absolute_url, /*is_connect=*/false)) {
+    return url.hostAndPort();
   }
-  return EMPTY_STRING;
+  return absolute_url;
 }
 
 // Note: per https://developer.mozilla.org/en-US/docs/Web/HTTP/Headers/Origin,
 //       the Origin header must include the scheme (and hostAndPort expects
 //       an absolute URL).
-std::string sourceOriginValue(const Http::RequestHeaderMap& headers) {
-  const auto origin = hostAndPort(headers.getInlineValue(origin_handle.handle()));
+absl::string_view sourceOriginValue(const Http::RequestHeaderMap& headers) {
+  const absl::string_view origin = hostAndPort(headers.getInlineValue(origin_handle.handle()));
   if (!origin.empty()) {
     return origin;
   }
   return hostAndPort(headers.getInlineValue(referer_handle.handle()));
 }
 
-std::string targetOriginValue(const Http::RequestHeaderMap& headers) {
+// Returns a view of the host and port of the target URL, which is built in absolute_url.
+absl::string_view targetOriginValue(const Http::RequestHeaderMap& headers,
+                                    std::string& absolute_url) {
   const auto host_value = headers.getHostValue();
 
   // Don't even bother if there's not Host header.
   if (host_value.empty()) {
-    return EMPTY_STRING;
+    return {};
   }
 
-  const auto absolute_url = fmt::format(
-      "{}://{}", headers.Scheme() != nullptr ? headers.getSchemeValue() : "http", host_value);
+  absl::StrAppend(&absolute_url,
+                  headers.Scheme() != nullptr ? headers.getSchemeValue() : "http", "://",
+                  host_value);
   return hostAndPort(absolute_url);
 }
 
@@ -101,7 +103,7 @@ Http::FilterHeadersStatus CsrfFilter::decodeHeaders(Http::RequestHeaderMap& head
   }
 
   bool is_valid = true;
-  const auto source_origin = sourceOriginValue(headers);
+  const absl::string_view source_origin = sourceOriginValue(headers);
   if (source_origin.empty()) {
     is_valid = false;
     config_->stats().missing_source_origin_.inc();
@@ -137,7 +139,8 @@ void CsrfFilter::determinePolicy() {
 }
 
 bool CsrfFilter::isValid(const absl::string_view source_origin, Http::RequestHeaderMap& headers) {
-  const auto target_origin = targetOriginValue(headers);
+  std::string target_url;
+  const absl::string_view target_origin = targetOriginValue(headers, target_url);
   if (source_origin == target_origin) {
     return true;
   }
@@ -1,6 +1,7 @@
 #include "source/extensions/filters/http/decompressor/decompressor_filter.h"
 
 #include "source/common/buffer/buffer_impl.h"
+#include "source/common/common/base64.h"
 #include "source/common/common/empty_string.h"
 #include "source/common/common/macros.h"
 
@@ -11,6 +12,8 @@ namespace Decompressor {
 
 Http::RegisterCustomInlineHeader<Http::CustomInlineHeaderRegistry::Type::RequestHeaders>
     accept_encoding_handle(Http::CustomHeaders::get().AcceptEncoding);
+Http::RegisterCustomInlineHeader<Http::CustomInlineHeaderRegistry::Type::RequestHeaders>
+    available_dictionary_handle(Http::CustomHeaders::get().AvailableDictionary);
 Http::RegisterCustomInlineHeader<Http::CustomInlineHeaderRegistry::Type::RequestHeaders>
     cache_control_request_handle(Http::CustomHeaders::get().CacheControl);
 Http::RegisterCustomInlineHeader<Http::CustomInlineHeaderRegistry::Type::RequestHeaders>
@@ -75,6 +78,14 @@ Http::FilterHeadersStatus DecompressorFilter::decodeHeaders(Http::RequestHeaderM
     const std::string new_accept_encoding_header = Http::HeaderUtility::addEncodingToAcceptEncoding(
         headers.getInlineValue(accept_encoding_handle.handle()), config_->contentEncoding());
     headers.setInline(accept_encoding_handle.handle(), new_accept_encoding_header);
+    // The encodings with a dictionary are only used if the dictionary is announced too, as a
+    // structured field byte sequence.
+    const std::string dictionary_hash = config_->dictionaryHash();
+    if (!dictionary_hash.empty()) {
+      headers.setInline(
+          available_dictionary_handle.handle(),
+          absl::StrCat(":", Base64::encode(dictionary_hash.data(), dictionary_hash.size()), ":"));
+    }
 
     ENVOY_STREAM_LOG(debug,
                      "DecompressorFilter::decodeHeaders advertise Accept-Encoding with value '{}'",
@@ -161,7 +172,7 @@ void DecompressorFilter::decompress(
                    direction_config.logString(), input_buffer.length(), output_buffer.length());
 
   input_buffer.drain(input_buffer.length());
-  input_buffer.add(output_buffer);
+  input_buffer.move(output_buffer);
 
   if (trailers.has_value()) {
     byte_tracker.reportTotalBytes(trailers.value().get());
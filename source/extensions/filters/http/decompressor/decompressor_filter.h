@@ -100,6 +100,7 @@ public:
     return decompressor_factory_->createDecompressor(decompressor_stats_prefix_);
   }
   const std::string& contentEncoding() { return decompressor_factory_->contentEncoding(); }
+  std::string dictionaryHash() const { return decompressor_factory_->dictionaryHash(); }
   const RequestDirectionConfig& requestDirectionConfig() { return request_direction_config_; }
   const ResponseDirectionConfig& responseDirectionConfig() { return response_direction_config_; }
   const Http::LowerCaseString& trailersCompressedBytesString() const {
@@ -0,0 +1,180 @@
+#include "source/extensions/filters/http/ext_authz/decision_cache.h"
+
+#include "source/common/common/empty_string.h"
+#include "source/common/http/header_utility.h"
+#include "source/common/http/path_utility.h"
+#include "source/common/protobuf/utility.h"
+
+#include "absl/strings/match.h"
+#include "absl/strings/numbers.h"
+#include "absl/strings/str_cat.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace ExtAuthz {
+namespace {
+
+constexpr uint32_t DefaultMaxEntries = 10000;
+constexpr uint32_t DefaultWorkerMaxEntries = 1000;
+
+// Appends a part of the key, prefixed by its length so that the parts can't run into each other.
+void appendKeyPart(std::string& key, absl::string_view part) {
+  absl::StrAppend(&key, part.size(), ":", part, ";");
+}
+
+// Returns the path, without its query, cut after its first segments if segments isn't zero.
+absl::string_view pathPrefix(absl::string_view path, uint32_t segments) {
+  path = Http::PathUtil::removeQueryAndFragment(path);
+  if (segments == 0) {
+    return path;
+  }
+  for (size_t pos = 0; (pos = path.find('/', pos + 1)) != absl::string_view::npos;) {
+    if (--segments == 0) {
+      return path.substr(0, pos);
+    }
+  }
+  return path;
+}
+
+std::vector<Http::LowerCaseString>
+toLowerCaseStrings(const Protobuf::RepeatedPtrField<std::string>& names) {
+  return {names.begin(), names.end()};
+}
+
+} // namespace
+
+DecisionCache::DecisionCache(
+    const envoy::extensions::filters::http::ext_authz::v3::DecisionCache& config,
+    ThreadLocal::SlotAllocator& tls, TimeSource& time_source)
+    : key_headers_(toLowerCaseStrings(config.key_headers())), key_method_(config.key_method()),
+      key_path_(config.key_path()), key_path_segments_(config.key_path_segments()),
+      key_peer_certificate_(config.key_peer_certificate()),
+      ttl_(PROTOBUF_GET_MS_REQUIRED(config, ttl)),
+      denied_ttl_(config.has_denied_ttl()
+                      ? absl::make_optional(std::chrono::milliseconds(
+                            PROTOBUF_GET_MS_REQUIRED(config, denied_ttl)))
+                      : absl::nullopt),
+      ttl_header_(config.ttl_header()), ttl_metadata_key_(config.ttl_metadata_key()),
+      max_entries_(PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, max_entries, DefaultMaxEntries)),
+      worker_max_entries_(
+          PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, worker_max_entries, DefaultWorkerMaxEntries)),
+      time_source_(time_source), tls_(tls) {
+  tls_.set([](Event::Dispatcher&) { return std::make_shared<ThreadLocalCache>(); });
+}
+
+std::string DecisionCache::key(const Http::RequestHeaderMap& headers,
+                               const Network::Connection* connection) const {
+  std::string key;
+  for (const Http::LowerCaseString& name : key_headers_) {
+    const auto value = Http::HeaderUtility::getAllOfHeaderAsString(headers, name).result();
+    if (value.has_value()) {
+      appendKeyPart(key, value.value());
+    } else {
+      key.append("-;");
+    }
+  }
+  if (key_method_) {
+    appendKeyPart(key, headers.getMethodValue());
+  }
+  if (key_path_) {
+    appendKeyPart(key, pathPrefix(headers.getPathValue(), key_path_segments_));
+  }
+  if (key_peer_certificate_) {
+    appendKeyPart(key, connection != nullptr && connection->ssl() != nullptr
+                           ? connection->ssl()->sha256PeerCertificateDigest()
+                           : EMPTY_STRING);
+  }
+  return key;
+}
+
+CachedResponseSharedPtr DecisionCache::lookup(const std::string& key) {
+  const MonotonicTime now = time_source_.monotonicTime();
+  EntryMap& worker_entries = tls_->entries_;
+  if (auto it = worker_entries.find(key); it != worker_entries.end()) {
+    if (it->second.expiry_ > now) {
+      return it->second.response_;
+    }
+    worker_entries.erase(it);
+  }
+
+  Entry entry;
+  {
+    absl::MutexLock lock(&mutex_);
+    auto it = shared_entries_.find(key);
+    if (it == shared_entries_.end()) {
+      return nullptr;
+    }
+    if (it->second.expiry_ <= now) {
+      shared_entries_.erase(it);
+      return nullptr;
+    }
+    entry = it->second;
+  }
+  makeRoom(worker_entries, worker_max_entries_, now);
+  return worker_entries.emplace(key, std::move(entry)).first->second.response_;
+}
+
+void DecisionCache::insert(const std::string& key,
+                           const Filters::Common::ExtAuthz::Response& response) {
+  const absl::optional<std::chrono::milliseconds> response_ttl = ttl(response);
+  if (!response_ttl.has_value() || response_ttl->count() <= 0) {
+    return;
+  }
+  const MonotonicTime now = time_source_.monotonicTime();
+  const Entry entry{std::make_shared<const Filters::Common::ExtAuthz::Response>(response),
+                    now + response_ttl.value()};
+  EntryMap& worker_entries = tls_->entries_;
+  makeRoom(worker_entries, worker_max_entries_, now);
+  worker_entries.insert_or_assign(key, entry);
+
+  absl::MutexLock lock(&mutex_);
+  makeRoom(shared_entries_, max_entries_, now);
+  shared_entries_.insert_or_assign(key, entry);
+}
+
+absl::optional<std::chrono::milliseconds>
+DecisionCache::ttl(const Filters::Common::ExtAuthz::Response& response) const {
+  using Filters::Common::ExtAuthz::CheckStatus;
+  if (response.status == CheckStatus::Error) {
+    return absl::nullopt;
+  }
+  if (!ttl_header_.empty()) {
+    for (const auto* headers : {&response.headers_to_set, &response.headers_to_add,
+                                &response.response_headers_to_set,
+                                &response.response_headers_to_add}) {
+      for (const auto& [name, value] : *headers) {
+        uint64_t seconds;
+        if (absl::EqualsIgnoreCase(name, ttl_header_) && absl::SimpleAtoi(value, &seconds)) {
+          return std::chrono::seconds(seconds);
+        }
+      }
+    }
+  }
+  if (!ttl_metadata_key_.empty()) {
+    const auto& fields = response.dynamic_metadata.fields();
+    if (auto it = fields.find(ttl_metadata_key_);
+        it != fields.end() && it->second.kind_case() == ProtobufWkt::Value::kNumberValue) {
+      return std::chrono::milliseconds(static_cast<int64_t>(it->second.number_value() * 1000));
+    }
+  }
+  if (response.status == CheckStatus::OK) {
+    return ttl_;
+  }
+  return denied_ttl_;
+}
+
+void DecisionCache::makeRoom(EntryMap& entries, size_t max_entries, MonotonicTime now) {
+  if (entries.size() < max_entries) {
+    return;
+  }
+  absl::erase_if(entries, [now](const auto& entry) { return entry.second.expiry_ <= now; });
+  while (entries.size() >= max_entries) {
+    entries.erase(entries.begin());
+  }
+}
+
+} // namespace ExtAuthz
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "envoy/common/time.h"
+#include "envoy/extensions/filters/http/ext_authz/v3/ext_authz.pb.h"
+#include "envoy/http/header_map.h"
+#include "envoy/network/connection.h"
+#include "envoy/thread_local/thread_local.h"
+
+#include "source/common/common/logger.h"
+#include "source/extensions/filters/common/ext_authz/ext_authz.h"
+
+#include "absl/base/thread_annotations.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/types/optional.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace ExtAuthz {
+
+using CachedResponseSharedPtr = std::shared_ptr<const Filters::Common::ExtAuthz::Response>;
+
+/**
+ * A cache of the decisions of the authorization service, keyed by the configured request
+ * attributes. Each worker has its own cache, in front of a cache shared by the workers.
+ */
+class DecisionCache : public Logger::Loggable<Logger::Id::ext_authz> {
+public:
+  DecisionCache(const envoy::extensions::filters::http::ext_authz::v3::DecisionCache& config,
+                ThreadLocal::SlotAllocator& tls, TimeSource& time_source);
+
+  /**
+   * @return the cache key of a request.
+   */
+  std::string key(const Http::RequestHeaderMap& headers,
+                  const Network::Connection* connection) const;
+
+  /**
+   * @return the cached decision for the key, or nullptr if none is cached or it expired.
+   */
+  CachedResponseSharedPtr lookup(const std::string& key) ABSL_LOCKS_EXCLUDED(mutex_);
+
+  /**
+   * Caches the decision for the key, for as long as the configuration or the response says, if
+   * at all.
+   */
+  void insert(const std::string& key, const Filters::Common::ExtAuthz::Response& response)
+      ABSL_LOCKS_EXCLUDED(mutex_);
+
+private:
+  struct Entry {
+    CachedResponseSharedPtr response_;
+    MonotonicTime expiry_;
+  };
+  using EntryMap = absl::flat_hash_map<std::string, Entry>;
+
+  struct ThreadLocalCache : public ThreadLocal::ThreadLocalObject {
+    EntryMap entries_;
+  };
+
+  // Returns how long the decision is cached, or nullopt if it isn't.
+  absl::optional<std::chrono::milliseconds>
+  ttl(const Filters::Common::ExtAuthz::Response& response) const;
+  // Makes room for a new entry, first by evicting the expired entries, then arbitrary ones.
+  static void makeRoom(EntryMap& entries, size_t max_entries, MonotonicTime now);
+
+  const std::vector<Http::LowerCaseString> key_headers_;
+  const bool key_method_;
+  const bool key_path_;
+  const uint32_t key_path_segments_;
+  const bool key_peer_certificate_;
+  const std::chrono::milliseconds ttl_;
+  const absl::optional<std::chrono::milliseconds> denied_ttl_;
+  const std::string ttl_header_;
+  const std::string ttl_metadata_key_;
+  const size_t max_entries_;
+  const size_t worker_max_entries_;
+  TimeSource& time_source_;
+  ThreadLocal::TypedSlot<ThreadLocalCache> tls_;
+  absl::Mutex mutex_;
+  EntryMap shared_entries_ ABSL_GUARDED_BY(mutex_);
+};
+
+using DecisionCachePtr = std::unique_ptr<DecisionCache>;
+
+} // namespace ExtAuthz
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
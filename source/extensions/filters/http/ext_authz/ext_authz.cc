@@ -115,6 +115,11 @@ FilterConfig::FilterConfig(const envoy::extensions::filters::http::ext_authz::v3
       charge_cluster_response_stats_(
           PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, charge_cluster_response_stats, true)),
       stats_(generateStats(stats_prefix, config.stat_prefix(), scope)),
+      decision_cache_(config.has_decision_cache()
+                          ? std::make_unique<DecisionCache>(config.decision_cache(),
+                                                            factory_context.threadLocal(),
+                                                            factory_context.timeSource())
+                          : nullptr),
       ext_authz_ok_(pool_.add(createPoolStatName(config.stat_prefix(), "ok"))),
       ext_authz_denied_(pool_.add(createPoolStatName(config.stat_prefix(), "denied"))),
       ext_authz_error_(pool_.add(createPoolStatName(config.stat_prefix(), "error"))),
@@ -173,6 +178,27 @@ void Filter::initiateCall(const Http::RequestHeaderMap& headers) {
     return;
   }
 
+  DecisionCache* decision_cache = config_->decisionCache();
+  if (decision_cache != nullptr) {
+    decision_cache_key_ = decision_cache->key(headers, decoder_callbacks_->connection().ptr());
+    CachedResponseSharedPtr cached = decision_cache->lookup(decision_cache_key_.value());
+    if (cached != nullptr) {
+      ENVOY_STREAM_LOG(trace, "ext_authz filter found the decision in the cache",
+                       *decoder_callbacks_);
+      stats_.decision_cache_hit_.inc();
+      // The cached decision is applied like a response received on the stack of the call.
+      decision_cache_key_.reset();
+      state_ = State::Calling;
+      filter_return_ = FilterReturn::StopDecoding;
+      cluster_ = decoder_callbacks_->clusterInfo();
+      initiating_call_ = true;
+      onComplete(std::make_unique<Filters::Common::ExtAuthz::Response>(*cached));
+      initiating_call_ = false;
+      return;
+    }
+    stats_.decision_cache_miss_.inc();
+  }
+
   auto&& maybe_merged_per_route_config =
       Http::Utility::getMergedPerFilterConfig<FilterConfigPerRoute>(
           decoder_callbacks_, [](FilterConfigPerRoute& cfg_base, const FilterConfigPerRoute& cfg) {
@@ -405,6 +431,12 @@ void Filter::onComplete(Filters::Common::ExtAuthz::ResponsePtr&& response) {
   using Filters::Common::ExtAuthz::CheckStatus;
   Stats::StatName empty_stat_name;
 
+  if (decision_cache_key_.has_value()) {
+    // The decision is cached as received, before the filter adds to it.
+    config_->decisionCache()->insert(decision_cache_key_.value(), *response);
+    decision_cache_key_.reset();
+  }
+
   if (!response->dynamic_metadata.fields().empty()) {
     if (!config_->enableDynamicMetadataIngestion()) {
       ENVOY_STREAM_LOG(trace,
@@ -25,6 +25,7 @@
 #include "source/extensions/filters/common/ext_authz/ext_authz_grpc_impl.h"
 #include "source/extensions/filters/common/ext_authz/ext_authz_http_impl.h"
 #include "source/extensions/filters/common/mutation_rules/mutation_rules.h"
+#include "source/extensions/filters/http/ext_authz/decision_cache.h"
 
 namespace Envoy {
 namespace Extensions {
@@ -42,7 +43,9 @@ namespace ExtAuthz {
   COUNTER(disabled)                                                                                \
   COUNTER(failure_mode_allowed)                                                                    \
   COUNTER(invalid)                                                                                 \
-  COUNTER(ignored_dynamic_metadata)
+  COUNTER(ignored_dynamic_metadata)                                                                \
+  COUNTER(decision_cache_hit)                                                                      \
+  COUNTER(decision_cache_miss)
 
 /**
  * Wrapper struct for ext_authz filter stats. @see stats_macros.h
@@ -149,6 +152,9 @@ public:
     return disallowed_headers_matcher_;
   }
 
+  // The cache of the authorization decisions, or nullptr if they aren't cached.
+  DecisionCache* decisionCache() const { return decision_cache_.get(); }
+
 private:
   static Http::Code toErrorCode(uint64_t status) {
     const auto code = static_cast<Http::Code>(status);
@@ -212,6 +218,8 @@ private:
   Filters::Common::ExtAuthz::MatcherSharedPtr allowed_headers_matcher_;
   Filters::Common::ExtAuthz::MatcherSharedPtr disallowed_headers_matcher_;
 
+  const DecisionCachePtr decision_cache_;
+
 public:
   // TODO(nezdolik): deprecate cluster scope stats counters in favor of filter scope stats
   // (ExtAuthzFilterStats stats_).
@@ -366,6 +374,8 @@ private:
   bool buffer_data_{};
   bool skip_check_{false};
   envoy::service::auth::v3::CheckRequest check_request_{};
+  // The key of the request in the decision cache, if the decision is to be cached.
+  absl::optional<std::string> decision_cache_key_;
 };
 
 } // namespace ExtAuthz
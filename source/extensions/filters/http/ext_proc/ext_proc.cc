@@ -40,6 +40,7 @@ using Http::ResponseTrailerMap;
 constexpr absl::string_view ErrorPrefix = "ext_proc_error";
 constexpr int DefaultImmediateStatus = 200;
 constexpr absl::string_view FilterName = "envoy.filters.http.ext_proc";
+constexpr uint64_t DefaultObservabilityBodyMaxDelayMs = 100;
 
 absl::optional<ProcessingMode> initProcessingMode(const ExtProcPerRoute& config) {
   if (!config.disabled() && config.has_overrides() && config.overrides().has_processing_mode()) {
@@ -184,6 +185,10 @@ FilterConfig::FilterConfig(
     Server::Configuration::CommonFactoryContext& context)
     : failure_mode_allow_(config.failure_mode_allow()),
       observability_mode_(config.observability_mode()),
+      observability_body_min_bytes_(config.observability_body_coalescing().min_bytes()),
+      observability_body_max_delay_(PROTOBUF_GET_MS_OR_DEFAULT(
+          config.observability_body_coalescing(), max_delay, DefaultObservabilityBodyMaxDelayMs)),
+      multiplex_streams_(config.multiplex_streams()),
       route_cache_action_(config.route_cache_action()), message_timeout_(message_timeout),
       max_message_timeout_ms_(max_message_timeout_ms),
       stats_(generateStats(stats_prefix, config.stat_prefix(), scope)),
@@ -343,7 +348,10 @@ Filter::StreamOpenState Filter::openStream() {
                        .setBufferBodyForRetry(true);
 
     ExternalProcessorStreamPtr stream_object =
-        client_->start(*this, config_with_hash_key_, options);
+        config_->multiplexStreams()
+            ? config_->threadLocalStreamManager().multiplexedStreams().start(*client_, *this,
+                                                                           config_with_hash_key_)
+            : client_->start(*this, config_with_hash_key_, options);
 
     if (processing_complete_) {
       // Stream failed while starting and either onGrpcError or onGrpcClose was already called
@@ -387,6 +395,11 @@ void Filter::deferredCloseStream() {
 
 void Filter::onDestroy() {
   ENVOY_LOG(debug, "onDestroy");
+  if (config_->observabilityMode()) {
+    // Send the body chunks still held back, which the deferred closure of the stream delivers.
+    sendObservedBody(decoding_state_, false);
+    sendObservedBody(encoding_state_, false);
+  }
   // Make doubly-sure we no longer use the stream, as
   // per the filter contract.
   processing_complete_ = true;
@@ -675,12 +688,24 @@ Http::FilterDataStatus Filter::sendDataInObservabilityMode(Buffer::Instance& dat
       // Fall through
       break;
     }
-    // Set up the the body chunk and send.
-    auto req = setupBodyChunk(state, data, end_stream);
-    req.set_observability_mode(true);
-    stream_->send(std::move(req), false);
-    stats_.stream_msgs_sent_.inc();
-    ENVOY_LOG(debug, "Sending body message in ObservabilityMode");
+    if (config_->observabilityBodyMinBytes() == 0) {
+      // Set up the the body chunk and send.
+      auto req = setupBodyChunk(state, data, end_stream);
+      req.set_observability_mode(true);
+      stream_->send(std::move(req), false);
+      stats_.stream_msgs_sent_.inc();
+      ENVOY_LOG(debug, "Sending body message in ObservabilityMode");
+      return FilterDataStatus::Continue;
+    }
+    // Hold the chunk back until enough of the body is held back, the end of the stream is seen,
+    // or the first chunk held back has waited long enough.
+    state.observedBody().add(data);
+    if (end_stream || state.observedBody().length() >= config_->observabilityBodyMinBytes()) {
+      sendObservedBody(state, end_stream);
+    } else {
+      state.startObservedBodyTimer([this, &state]() { sendObservedBody(state, false); },
+                                   config_->observabilityBodyMaxDelay());
+    }
   } else if (state.bodyMode() != ProcessingMode::NONE) {
     ENVOY_LOG(error, "Wrong body mode for observability mode, no data is sent.");
   }
@@ -688,6 +713,25 @@ Http::FilterDataStatus Filter::sendDataInObservabilityMode(Buffer::Instance& dat
   return FilterDataStatus::Continue;
 }
 
+void Filter::sendObservedBody(ProcessorState& state, bool end_stream) {
+  state.stopObservedBodyTimer();
+  Buffer::OwnedImpl& body = state.observedBody();
+  if (body.length() == 0 && !end_stream) {
+    return;
+  }
+  if (stream_ == nullptr || processing_complete_) {
+    // The stream was closed by the external processor, which needs no more messages.
+    body.drain(body.length());
+    return;
+  }
+  auto req = setupBodyChunk(state, body, end_stream);
+  body.drain(body.length());
+  req.set_observability_mode(true);
+  stream_->send(std::move(req), false);
+  stats_.stream_msgs_sent_.inc();
+  ENVOY_LOG(debug, "Sending coalesced body message in ObservabilityMode");
+}
+
 std::pair<bool, Http::FilterDataStatus> Filter::sendStreamChunk(ProcessorState& state) {
   switch (openStream()) {
   case StreamOpenState::Error:
@@ -732,6 +776,7 @@ FilterTrailersStatus Filter::onTrailers(ProcessorState& state, Http::HeaderMap&
       // Fall through
       break;
     }
+    sendObservedBody(state, false);
     sendTrailers(state, trailers, /*observability_mode=*/true);
     return FilterTrailersStatus::Continue;
   }
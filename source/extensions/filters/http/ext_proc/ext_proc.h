@@ -25,6 +25,7 @@
 #include "source/extensions/filters/http/common/pass_through_filter.h"
 #include "source/extensions/filters/http/ext_proc/client.h"
 #include "source/extensions/filters/http/ext_proc/matching_utils.h"
+#include "source/extensions/filters/http/ext_proc/multiplexed_stream.h"
 #include "source/extensions/filters/http/ext_proc/processor_state.h"
 
 namespace Envoy {
@@ -189,7 +190,11 @@ public:
     it->second->deferredClose(dispatcher, stream_id);
   }
 
+  MultiplexedStreamPool& multiplexedStreams() { return multiplexed_streams_; }
+
 private:
+  // The shared gRPC streams of the worker, used when the HTTP streams are multiplexed.
+  MultiplexedStreamPool multiplexed_streams_;
   // Map of DeferredDeletableStreamPtrs with stream id as key.
   absl::flat_hash_map<uint64_t, DeferredDeletableStreamPtr> stream_manager_;
 };
@@ -207,6 +212,15 @@ public:
 
   bool observabilityMode() const { return observability_mode_; }
 
+  bool multiplexStreams() const { return multiplex_streams_; }
+
+  // The bytes of body held back to be sent together in observability mode, or 0 if each body
+  // chunk is sent in its own message.
+  uint32_t observabilityBodyMinBytes() const { return observability_body_min_bytes_; }
+  const std::chrono::milliseconds& observabilityBodyMaxDelay() const {
+    return observability_body_max_delay_;
+  }
+
   const std::chrono::milliseconds& messageTimeout() const { return message_timeout_; }
 
   uint32_t maxMessageTimeout() const { return max_message_timeout_ms_; }
@@ -268,6 +282,9 @@ private:
   }
   const bool failure_mode_allow_;
   const bool observability_mode_;
+  const uint32_t observability_body_min_bytes_;
+  const std::chrono::milliseconds observability_body_max_delay_;
+  const bool multiplex_streams_;
   envoy::extensions::filters::http::ext_proc::v3::ExternalProcessor::RouteCacheAction
       route_cache_action_;
   const std::chrono::milliseconds message_timeout_;
@@ -450,6 +467,7 @@ private:
                                  bool end_stream);
   Http::FilterDataStatus sendDataInObservabilityMode(Buffer::Instance& data, ProcessorState& state,
                                                      bool end_stream);
+  void sendObservedBody(ProcessorState& state, bool end_stream);
   void deferredCloseStream();
 
   envoy::service::ext_proc::v3::ProcessingRequest
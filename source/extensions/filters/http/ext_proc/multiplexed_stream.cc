@@ -0,0 +1,122 @@
+#include "source/extensions/filters/http/ext_proc/multiplexed_stream.h"
+
+#include <vector>
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace ExternalProcessing {
+
+MultiplexedStream::~MultiplexedStream() {
+  if (stream_ != nullptr) {
+    stream_->close();
+  }
+}
+
+bool MultiplexedStream::start(ExternalProcessorClient& client,
+                              const Grpc::GrpcServiceConfigWithHashKey& config_with_hash_key) {
+  // The gRPC stream outlives the HTTP stream starting it, so none of its options apply.
+  stream_ = client.start(*this, config_with_hash_key, Http::AsyncClient::StreamOptions());
+  return stream_ != nullptr && !closed_;
+}
+
+void MultiplexedStream::reportClose(ExternalProcessorCallbacks& callbacks) const {
+  if (close_status_ == Grpc::Status::WellKnownGrpcStatus::Ok) {
+    callbacks.onGrpcClose();
+  } else {
+    callbacks.onGrpcError(close_status_);
+  }
+}
+
+void MultiplexedStream::attach(uint64_t correlation_id, ExternalProcessorCallbacks& callbacks) {
+  attached_[correlation_id] = &callbacks;
+}
+
+void MultiplexedStream::send(envoy::service::ext_proc::v3::ProcessingRequest&& request) {
+  if (closed_) {
+    return;
+  }
+  stream_->send(std::move(request), false);
+}
+
+void MultiplexedStream::onReceiveMessage(
+    std::unique_ptr<envoy::service::ext_proc::v3::ProcessingResponse>&& response) {
+  auto it = attached_.find(response->correlation_id());
+  if (it == attached_.end()) {
+    ENVOY_LOG(debug, "Ignoring response for correlation id {} with no HTTP stream",
+              response->correlation_id());
+    return;
+  }
+  it->second->onReceiveMessage(std::move(response));
+}
+
+void MultiplexedStream::onGrpcError(Grpc::Status::GrpcStatus error) { onClose(error); }
+
+void MultiplexedStream::onGrpcClose() { onClose(Grpc::Status::WellKnownGrpcStatus::Ok); }
+
+void MultiplexedStream::onClose(Grpc::Status::GrpcStatus status) {
+  ENVOY_LOG(debug, "Multiplexed gRPC stream closed with status {}, ending {} HTTP streams", status,
+            attached_.size());
+  closed_ = true;
+  close_status_ = status;
+  // The HTTP streams close their streams when told, which detaches them.
+  std::vector<uint64_t> correlation_ids;
+  correlation_ids.reserve(attached_.size());
+  for (const auto& [correlation_id, callbacks] : attached_) {
+    correlation_ids.push_back(correlation_id);
+  }
+  for (const uint64_t correlation_id : correlation_ids) {
+    auto it = attached_.find(correlation_id);
+    if (it == attached_.end()) {
+      continue;
+    }
+    ExternalProcessorCallbacks& callbacks = *it->second;
+    attached_.erase(it);
+    callbacks.logGrpcStreamInfo();
+    reportClose(callbacks);
+  }
+}
+
+MultiplexedStreamHandle::MultiplexedStreamHandle(MultiplexedStreamSharedPtr stream,
+                                                 uint64_t correlation_id,
+                                                 ExternalProcessorCallbacks& callbacks)
+    : stream_(std::move(stream)), correlation_id_(correlation_id) {
+  stream_->attach(correlation_id_, callbacks);
+}
+
+void MultiplexedStreamHandle::send(envoy::service::ext_proc::v3::ProcessingRequest&& request,
+                                   bool) {
+  request.set_correlation_id(correlation_id_);
+  stream_->send(std::move(request));
+}
+
+bool MultiplexedStreamHandle::close() {
+  if (closed_) {
+    return false;
+  }
+  closed_ = true;
+  stream_->detach(correlation_id_);
+  return true;
+}
+
+ExternalProcessorStreamPtr
+MultiplexedStreamPool::start(ExternalProcessorClient& client, ExternalProcessorCallbacks& callbacks,
+                             const Grpc::GrpcServiceConfigWithHashKey& config_with_hash_key) {
+  MultiplexedStreamSharedPtr& stream = streams_[config_with_hash_key];
+  if (stream == nullptr || stream->closed()) {
+    stream = std::make_shared<MultiplexedStream>();
+    if (!stream->start(client, config_with_hash_key)) {
+      // The next HTTP stream tries to start a new one.
+      const MultiplexedStreamSharedPtr failed = std::move(stream);
+      streams_.erase(config_with_hash_key);
+      failed->reportClose(callbacks);
+      return nullptr;
+    }
+  }
+  return std::make_unique<MultiplexedStreamHandle>(stream, next_correlation_id_++, callbacks);
+}
+
+} // namespace ExternalProcessing
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+
+#include "envoy/grpc/async_client_manager.h"
+#include "envoy/grpc/status.h"
+#include "envoy/service/ext_proc/v3/external_processor.pb.h"
+#include "envoy/stream_info/stream_info.h"
+
+#include "source/common/common/logger.h"
+#include "source/extensions/filters/http/ext_proc/client.h"
+
+#include "absl/container/flat_hash_map.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace ExternalProcessing {
+
+// A gRPC stream to the external processor shared by HTTP streams, each of which is identified on
+// it by a correlation id. The responses are dispatched to the HTTP streams by their correlation
+// id, and the closure of the gRPC stream is reported to all of them.
+class MultiplexedStream : public ExternalProcessorCallbacks,
+                          public Logger::Loggable<Logger::Id::ext_proc> {
+public:
+  ~MultiplexedStream() override;
+
+  // Starts the gRPC stream. Returns false if it failed to start.
+  bool start(ExternalProcessorClient& client,
+             const Grpc::GrpcServiceConfigWithHashKey& config_with_hash_key);
+  // Reports the closure of the gRPC stream, or its failure to start, to the callbacks of an HTTP
+  // stream.
+  void reportClose(ExternalProcessorCallbacks& callbacks) const;
+
+  void attach(uint64_t correlation_id, ExternalProcessorCallbacks& callbacks);
+  void detach(uint64_t correlation_id) { attached_.erase(correlation_id); }
+  void send(envoy::service::ext_proc::v3::ProcessingRequest&& request);
+  bool closed() const { return closed_; }
+  const StreamInfo::StreamInfo& streamInfo() const { return stream_->streamInfo(); }
+
+  // ExternalProcessorCallbacks
+  void onReceiveMessage(
+      std::unique_ptr<envoy::service::ext_proc::v3::ProcessingResponse>&& response) override;
+  void onGrpcError(Grpc::Status::GrpcStatus error) override;
+  void onGrpcClose() override;
+  void logGrpcStreamInfo() override {}
+
+private:
+  void onClose(Grpc::Status::GrpcStatus status);
+
+  ExternalProcessorStreamPtr stream_;
+  // The callbacks of the HTTP streams multiplexed over the gRPC stream, by correlation id.
+  absl::flat_hash_map<uint64_t, ExternalProcessorCallbacks*> attached_;
+  bool closed_{};
+  Grpc::Status::GrpcStatus close_status_{Grpc::Status::WellKnownGrpcStatus::Unavailable};
+};
+
+using MultiplexedStreamSharedPtr = std::shared_ptr<MultiplexedStream>;
+
+// The stream of an HTTP stream multiplexed over a shared gRPC stream.
+class MultiplexedStreamHandle : public ExternalProcessorStream {
+public:
+  MultiplexedStreamHandle(MultiplexedStreamSharedPtr stream, uint64_t correlation_id,
+                          ExternalProcessorCallbacks& callbacks);
+  ~MultiplexedStreamHandle() override { stream_->detach(correlation_id_); }
+
+  // ExternalProcessorStream
+  // The shared gRPC stream is never half-closed by an HTTP stream, so end_stream is ignored.
+  void send(envoy::service::ext_proc::v3::ProcessingRequest&& request, bool end_stream) override;
+  bool close() override;
+  const StreamInfo::StreamInfo& streamInfo() const override { return stream_->streamInfo(); }
+  void notifyFilterDestroy() override { stream_->detach(correlation_id_); }
+
+private:
+  const MultiplexedStreamSharedPtr stream_;
+  const uint64_t correlation_id_;
+  bool closed_{};
+};
+
+// The shared gRPC streams of a worker, one per gRPC service. A closed gRPC stream is replaced by
+// a new one when the next HTTP stream starts.
+class MultiplexedStreamPool {
+public:
+  // Returns the stream of an HTTP stream multiplexed over the shared gRPC stream to the service,
+  // or nullptr if the gRPC stream failed to start, which is reported to the callbacks.
+  ExternalProcessorStreamPtr start(ExternalProcessorClient& client,
+                                   ExternalProcessorCallbacks& callbacks,
+                                   const Grpc::GrpcServiceConfigWithHashKey& config_with_hash_key);
+
+private:
+  absl::flat_hash_map<Grpc::GrpcServiceConfigWithHashKey, MultiplexedStreamSharedPtr> streams_;
+  uint64_t next_correlation_id_{1};
+};
+
+} // namespace ExternalProcessing
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
@@ -57,6 +57,21 @@ void ProcessorState::stopMessageTimer() {
   }
 }
 
+void ProcessorState::startObservedBodyTimer(Event::TimerCb cb, std::chrono::milliseconds delay) {
+  if (!observed_body_timer_) {
+    observed_body_timer_ = filter_callbacks_->dispatcher().createTimer(cb);
+  }
+  if (!observed_body_timer_->enabled()) {
+    observed_body_timer_->enableTimer(delay);
+  }
+}
+
+void ProcessorState::stopObservedBodyTimer() {
+  if (observed_body_timer_) {
+    observed_body_timer_->disableTimer();
+  }
+}
+
 // Server sends back response to stop the original timer and start a new timer.
 // Do not change call_start_time_ since that call has not been responded yet.
 // Do not change callback_state_ either.
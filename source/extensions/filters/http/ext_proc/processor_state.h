@@ -149,6 +149,12 @@ public:
   void stopMessageTimer();
   bool restartMessageTimer(const uint32_t message_timeout_ms);
 
+  // The body chunks held back to be sent together in observability mode.
+  Buffer::OwnedImpl& observedBody() { return observed_body_; }
+  // Arms the timer sending the body chunks held back, unless it is already armed.
+  void startObservedBodyTimer(Event::TimerCb cb, std::chrono::milliseconds delay);
+  void stopObservedBodyTimer();
+
   // Idempotent methods for watermarking the body
   virtual void requestWatermark() PURE;
   virtual void clearWatermark() PURE;
@@ -260,6 +266,8 @@ protected:
   // Envoy should receive at most one such message in one particular state.
   bool new_timeout_received_{false};
   ChunkQueue chunk_queue_;
+  Buffer::OwnedImpl observed_body_;
+  Event::TimerPtr observed_body_timer_;
   absl::optional<MonotonicTime> call_start_time_ = absl::nullopt;
   const envoy::config::core::v3::TrafficDirection traffic_direction_;
 
@@ -22,6 +22,8 @@
 #include "source/common/protobuf/utility.h"
 #include "source/common/stats/utility.h"
 
+#include "absl/strings/str_cat.h"
+
 namespace Envoy {
 namespace Extensions {
 namespace HttpFilters {
@@ -118,6 +120,11 @@ Http::FilterHeadersStatus FaultFilter::decodeHeaders(Http::RequestHeaderMap& hea
       Http::Utility::resolveMostSpecificPerFilterConfig<FaultSettings>(decoder_callbacks_);
   fault_settings_ = per_route_settings ? per_route_settings : fault_settings_;
 
+  // Nothing can be injected, so there is no need to match the request.
+  if (!fault_settings_->hasFaults()) {
+    return Http::FilterHeadersStatus::Continue;
+  }
+
   if (!matchesTargetUpstreamCluster()) {
     return Http::FilterHeadersStatus::Continue;
   }
@@ -138,16 +145,21 @@ Http::FilterHeadersStatus FaultFilter::decodeHeaders(Http::RequestHeaderMap& hea
           downstream_cluster_, config_->scope().symbolTable());
     }
 
-    downstream_cluster_delay_percent_key_ =
-        fmt::format("fault.http.{}.delay.fixed_delay_percent", downstream_cluster_);
-    downstream_cluster_abort_percent_key_ =
-        fmt::format("fault.http.{}.abort.abort_percent", downstream_cluster_);
-    downstream_cluster_delay_duration_key_ =
-        fmt::format("fault.http.{}.delay.fixed_duration_ms", downstream_cluster_);
-    downstream_cluster_abort_http_status_key_ =
-        fmt::format("fault.http.{}.abort.http_status", downstream_cluster_);
-    downstream_cluster_abort_grpc_status_key_ =
-        fmt::format("fault.http.{}.abort.grpc_status", downstream_cluster_);
+    // The runtime keys are only looked up for the faults which are configured.
+    if (fault_settings_->requestDelay() != nullptr) {
+      downstream_cluster_delay_percent_key_ =
+          absl::StrCat("fault.http.", downstream_cluster_, ".delay.fixed_delay_percent");
+      downstream_cluster_delay_duration_key_ =
+          absl::StrCat("fault.http.", downstream_cluster_, ".delay.fixed_duration_ms");
+    }
+    if (fault_settings_->requestAbort() != nullptr) {
+      downstream_cluster_abort_percent_key_ =
+          absl::StrCat("fault.http.", downstream_cluster_, ".abort.abort_percent");
+      downstream_cluster_abort_http_status_key_ =
+          absl::StrCat("fault.http.", downstream_cluster_, ".abort.http_status");
+      downstream_cluster_abort_grpc_status_key_ =
+          absl::StrCat("fault.http.", downstream_cluster_, ".abort.grpc_status");
+    }
   }
 
   maybeSetupResponseRateLimit(headers);
@@ -67,6 +67,11 @@ public:
   const Filters::Common::Fault::FaultRateLimitConfig* responseRateLimit() const {
     return response_rate_limit_.get();
   }
+  // Whether any delay, abort or response rate limit is configured.
+  bool hasFaults() const {
+    return request_delay_config_ != nullptr || request_abort_config_ != nullptr ||
+           response_rate_limit_ != nullptr;
+  }
   const std::string& abortPercentRuntime() const { return abort_percent_runtime_; }
   const std::string& delayPercentRuntime() const { return delay_percent_runtime_; }
   const std::string& abortHttpStatusRuntime() const { return abort_http_status_runtime_; }
@@ -0,0 +1,372 @@
+#include "source/extensions/filters/http/grpc_field_extraction/field_scanner.h"
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "envoy/common/exception.h"
+
+#include "source/common/common/assert.h"
+#include "source/extensions/filters/http/grpc_field_extraction/message_converter/message_converter_utility.h"
+
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_format.h"
+#include "absl/strings/str_split.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace GrpcFieldExtraction {
+namespace {
+
+using Protobuf::internal::WireFormatLite;
+
+constexpr uint32_t kMaxVarintBytes = 10;
+
+bool isSupportedPathEnd(Protobuf::Field::Kind kind) {
+  switch (kind) {
+  case Protobuf::Field::TYPE_STRING:
+  case Protobuf::Field::TYPE_UINT32:
+  case Protobuf::Field::TYPE_UINT64:
+  case Protobuf::Field::TYPE_INT32:
+  case Protobuf::Field::TYPE_INT64:
+  case Protobuf::Field::TYPE_SINT32:
+  case Protobuf::Field::TYPE_SINT64:
+  case Protobuf::Field::TYPE_FIXED32:
+  case Protobuf::Field::TYPE_FIXED64:
+  case Protobuf::Field::TYPE_SFIXED32:
+  case Protobuf::Field::TYPE_SFIXED64:
+  case Protobuf::Field::TYPE_FLOAT:
+  case Protobuf::Field::TYPE_DOUBLE:
+    return true;
+  default:
+    return false;
+  }
+}
+
+// The wire type of a value of the kind, when it isn't packed.
+uint32_t wireType(Protobuf::Field::Kind kind) {
+  switch (kind) {
+  case Protobuf::Field::TYPE_STRING:
+  case Protobuf::Field::TYPE_MESSAGE:
+    return WireFormatLite::WIRETYPE_LENGTH_DELIMITED;
+  case Protobuf::Field::TYPE_FIXED32:
+  case Protobuf::Field::TYPE_SFIXED32:
+  case Protobuf::Field::TYPE_FLOAT:
+    return WireFormatLite::WIRETYPE_FIXED32;
+  case Protobuf::Field::TYPE_FIXED64:
+  case Protobuf::Field::TYPE_SFIXED64:
+  case Protobuf::Field::TYPE_DOUBLE:
+    return WireFormatLite::WIRETYPE_FIXED64;
+  default:
+    return WireFormatLite::WIRETYPE_VARINT;
+  }
+}
+
+std::string valueToString(Protobuf::Field::Kind kind, uint64_t value) {
+  switch (kind) {
+  case Protobuf::Field::TYPE_UINT32:
+  case Protobuf::Field::TYPE_FIXED32:
+    return absl::StrCat(static_cast<uint32_t>(value));
+  case Protobuf::Field::TYPE_UINT64:
+  case Protobuf::Field::TYPE_FIXED64:
+    return absl::StrCat(value);
+  case Protobuf::Field::TYPE_INT32:
+  case Protobuf::Field::TYPE_SFIXED32:
+    return absl::StrCat(static_cast<int32_t>(value));
+  case Protobuf::Field::TYPE_INT64:
+  case Protobuf::Field::TYPE_SFIXED64:
+    return absl::StrCat(static_cast<int64_t>(value));
+  case Protobuf::Field::TYPE_SINT32:
+    return absl::StrCat(WireFormatLite::ZigZagDecode32(static_cast<uint32_t>(value)));
+  case Protobuf::Field::TYPE_SINT64:
+    return absl::StrCat(WireFormatLite::ZigZagDecode64(value));
+  case Protobuf::Field::TYPE_FLOAT:
+    return absl::StrCat(WireFormatLite::DecodeFloat(static_cast<uint32_t>(value)));
+  case Protobuf::Field::TYPE_DOUBLE:
+    return absl::StrCat(WireFormatLite::DecodeDouble(value));
+  default:
+    PANIC("not a scalar kind");
+  }
+}
+
+const Protobuf::Field* findField(const Protobuf::Type& type, absl::string_view name) {
+  for (const Protobuf::Field& field : type.fields()) {
+    if (field.name() == name) {
+      return &field;
+    }
+  }
+  return nullptr;
+}
+
+absl::Status exceedsMessageError() {
+  return absl::InvalidArgumentError("A field of the request message exceeds the message.");
+}
+
+} // namespace
+
+absl::StatusOr<FieldScannerPathsConstPtr> FieldScannerPaths::create(
+    const TypeFinder& type_finder, absl::string_view request_type_url,
+    const envoy::extensions::filters::http::grpc_field_extraction::v3::FieldExtractions&
+        field_extractions) {
+  const Protobuf::Type* request_type = type_finder(std::string(request_type_url));
+  if (request_type == nullptr) {
+    return absl::InvalidArgumentError(
+        absl::StrFormat("unable to find the type `%s`", request_type_url));
+  }
+
+  auto paths = std::unique_ptr<FieldScannerPaths>(new FieldScannerPaths());
+  for (const auto& it : field_extractions.request_field_extractions()) {
+    const Protobuf::Type* type = request_type;
+    Node* node = &paths->root_;
+    const std::vector<absl::string_view> names = absl::StrSplit(it.first, '.');
+    for (size_t i = 0; i < names.size(); ++i) {
+      const Protobuf::Field* field = findField(*type, names[i]);
+      if (field == nullptr) {
+        return absl::InvalidArgumentError(absl::StrFormat(
+            "the field `%s` of the path `%s` isn't in `%s`", names[i], it.first, type->name()));
+      }
+      Field& scanned = node->fields[field->number()];
+      scanned.kind = field->kind();
+      node->max_field_number = std::max<uint32_t>(node->max_field_number, field->number());
+
+      if (i + 1 == names.size()) {
+        if (!isSupportedPathEnd(field->kind())) {
+          return absl::InvalidArgumentError(
+              absl::StrFormat("the type of the field at the end of the path `%s` isn't supported",
+                              it.first));
+        }
+        scanned.path_index = paths->paths_.size();
+        continue;
+      }
+      if (field->kind() != Protobuf::Field::TYPE_MESSAGE) {
+        return absl::InvalidArgumentError(absl::StrFormat(
+            "the field `%s` of the path `%s` isn't a message", names[i], it.first));
+      }
+      type = type_finder(field->type_url());
+      if (type == nullptr) {
+        return absl::InvalidArgumentError(
+            absl::StrFormat("unable to find the type `%s`", field->type_url()));
+      }
+      if (scanned.message == nullptr) {
+        scanned.message = std::make_unique<Node>();
+      }
+      node = scanned.message.get();
+    }
+    paths->paths_.push_back(it.first);
+  }
+  return paths;
+}
+
+FieldScanner::FieldScanner(const FieldScannerPaths& paths)
+    : paths_(paths), values_(paths.paths().size()) {}
+
+absl::Status FieldScanner::scan(const Buffer::Instance& data) {
+  for (const Buffer::RawSlice& slice : data.getRawSlices()) {
+    if (done_) {
+      break;
+    }
+    RETURN_IF_NOT_OK(scanBytes(static_cast<const uint8_t*>(slice.mem_), slice.len_));
+  }
+  return absl::OkStatus();
+}
+
+ExtractionResult FieldScanner::result() const {
+  ASSERT(done_);
+  ExtractionResult result;
+  result.reserve(values_.size());
+  for (size_t i = 0; i < values_.size(); ++i) {
+    result.push_back({paths_.paths()[i], values_[i]});
+  }
+  return result;
+}
+
+absl::Status FieldScanner::scanBytes(const uint8_t* data, uint64_t length) {
+  const uint8_t* const end = data + length;
+  while (data < end && !done_) {
+    if (state_ == State::FrameHeader) {
+      frame_header_[value_bytes_++] = *data++;
+      if (value_bytes_ == sizeof(frame_header_)) {
+        RETURN_IF_NOT_OK(onFrameHeader());
+      }
+      continue;
+    }
+
+    // The frames which are scanned whole are closed right away, so a field is being scanned.
+    const uint64_t available = std::min<uint64_t>(end - data, frames_.back().end - offset_);
+    if (available == 0) {
+      return exceedsMessageError();
+    }
+    switch (state_) {
+    case State::Tag:
+    case State::Varint:
+    case State::Length: {
+      if (value_bytes_ == kMaxVarintBytes) {
+        return absl::InvalidArgumentError("The request message has a malformed varint.");
+      }
+      const uint8_t byte = *data++;
+      ++offset_;
+      value_ |= static_cast<uint64_t>(byte & 0x7f) << (7 * value_bytes_++);
+      if ((byte & 0x80) == 0) {
+        if (state_ == State::Tag) {
+          RETURN_IF_NOT_OK(onTag());
+        } else if (state_ == State::Length) {
+          RETURN_IF_NOT_OK(onLength());
+        } else {
+          RETURN_IF_NOT_OK(onValue());
+        }
+      }
+      break;
+    }
+    case State::Fixed: {
+      value_ |= static_cast<uint64_t>(*data++) << (8 * value_bytes_++);
+      ++offset_;
+      if (value_bytes_ == (wire_type_ == WireFormatLite::WIRETYPE_FIXED32 ? 4 : 8)) {
+        RETURN_IF_NOT_OK(onValue());
+      }
+      break;
+    }
+    case State::Bytes: {
+      // The fields which aren't extracted are skipped over without looking at their bytes.
+      const uint64_t count = std::min(available, bytes_left_);
+      if (field_ != nullptr) {
+        bytes_.append(reinterpret_cast<const char*>(data), count);
+      }
+      data += count;
+      offset_ += count;
+      bytes_left_ -= count;
+      if (bytes_left_ == 0) {
+        if (field_ != nullptr) {
+          addValue(std::move(bytes_));
+          bytes_.clear();
+        }
+        nextField();
+      }
+      break;
+    }
+    case State::FrameHeader:
+      PANIC("not reached");
+    }
+  }
+  return absl::OkStatus();
+}
+
+absl::Status FieldScanner::onFrameHeader() {
+  absl::StatusOr<uint64_t> message_size = delimiterToSize(frame_header_);
+  if (!message_size.ok()) {
+    return message_size.status();
+  }
+  frames_.push_back({&paths_.root(), nullptr, message_size.value()});
+  offset_ = 0;
+  nextField();
+  return absl::OkStatus();
+}
+
+absl::Status FieldScanner::onTag() {
+  const uint64_t field_number = value_ >> 3;
+  wire_type_ = value_ & 0x7;
+  if (field_number == 0 || field_number > WireFormatLite::kMaxFieldNumber) {
+    return absl::InvalidArgumentError("The request message has an invalid field number.");
+  }
+
+  const Frame& frame = frames_.back();
+  if (frames_.size() == 1 && field_number > frame.node->max_field_number) {
+    // The fields to extract, if any, came before.
+    done_ = true;
+    return absl::OkStatus();
+  }
+  const auto it = frame.node->fields.find(field_number);
+  field_ = it != frame.node->fields.end() ? &it->second : nullptr;
+  value_ = 0;
+  value_bytes_ = 0;
+  switch (wire_type_) {
+  case WireFormatLite::WIRETYPE_VARINT:
+    state_ = State::Varint;
+    break;
+  case WireFormatLite::WIRETYPE_FIXED32:
+  case WireFormatLite::WIRETYPE_FIXED64:
+    state_ = State::Fixed;
+    break;
+  case WireFormatLite::WIRETYPE_LENGTH_DELIMITED:
+    state_ = State::Length;
+    break;
+  default:
+    return absl::InvalidArgumentError(
+        absl::StrFormat("The wire type %d of the request message isn't supported.", wire_type_));
+  }
+  return absl::OkStatus();
+}
+
+absl::Status FieldScanner::onLength() {
+  const uint64_t length = value_;
+  if (length > frames_.back().end - offset_) {
+    return exceedsMessageError();
+  }
+
+  if (field_ != nullptr && field_->message != nullptr) {
+    frames_.push_back({field_->message.get(), nullptr, offset_ + length});
+    nextField();
+    return absl::OkStatus();
+  }
+  if (field_ != nullptr && field_->kind != Protobuf::Field::TYPE_STRING) {
+    // The values of a repeated scalar field, if extracted.
+    if (field_->path_index.has_value()) {
+      frames_.push_back({nullptr, field_, offset_ + length});
+      nextField();
+      return absl::OkStatus();
+    }
+    field_ = nullptr;
+  }
+
+  bytes_left_ = length;
+  if (length == 0) {
+    if (field_ != nullptr) {
+      addValue("");
+    }
+    nextField();
+    return absl::OkStatus();
+  }
+  state_ = State::Bytes;
+  return absl::OkStatus();
+}
+
+absl::Status FieldScanner::onValue() {
+  if (field_ != nullptr && field_->path_index.has_value() && wireType(field_->kind) == wire_type_) {
+    addValue(valueToString(field_->kind, value_));
+  }
+  nextField();
+  return absl::OkStatus();
+}
+
+void FieldScanner::nextField() {
+  field_ = nullptr;
+  value_ = 0;
+  value_bytes_ = 0;
+  while (!frames_.empty() && offset_ == frames_.back().end) {
+    frames_.pop_back();
+  }
+  if (frames_.empty()) {
+    // The whole message was scanned.
+    done_ = true;
+    return;
+  }
+
+  const Frame& frame = frames_.back();
+  if (frame.packed_field == nullptr) {
+    state_ = State::Tag;
+    return;
+  }
+  field_ = frame.packed_field;
+  wire_type_ = wireType(field_->kind);
+  state_ = wire_type_ == WireFormatLite::WIRETYPE_VARINT ? State::Varint : State::Fixed;
+}
+
+void FieldScanner::addValue(std::string value) {
+  values_[field_->path_index.value()].push_back(std::move(value));
+}
+
+} // namespace GrpcFieldExtraction
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,144 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "envoy/buffer/buffer.h"
+#include "envoy/extensions/filters/http/grpc_field_extraction/v3/config.pb.h"
+
+#include "source/common/protobuf/protobuf.h"
+#include "source/extensions/filters/http/grpc_field_extraction/extractor.h"
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/optional.h"
+#include "grpc_transcoding/message_reader.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace GrpcFieldExtraction {
+
+// The field paths to extract from the request messages of a gRPC method, resolved to field numbers
+// so that they can be looked up in the wire format. It should be created once per method and
+// shared among the scanners.
+class FieldScannerPaths {
+public:
+  struct Node;
+
+  struct Field {
+    Protobuf::Field::Kind kind;
+
+    // The index of the extracted path, if the field is the last one of a path.
+    absl::optional<size_t> path_index;
+
+    // The fields of the message leading to other paths, if the field isn't the last of its path.
+    std::unique_ptr<Node> message;
+  };
+
+  struct Node {
+    absl::flat_hash_map<uint32_t, Field> fields;
+
+    // The highest number of the fields above.
+    uint32_t max_field_number = 0;
+  };
+
+  static absl::StatusOr<std::unique_ptr<const FieldScannerPaths>>
+  create(const TypeFinder& type_finder, absl::string_view request_type_url,
+         const envoy::extensions::filters::http::grpc_field_extraction::v3::FieldExtractions&
+             field_extractions);
+
+  const Node& root() const { return root_; }
+  const std::vector<absl::string_view>& paths() const { return paths_; }
+
+private:
+  FieldScannerPaths() = default;
+
+  Node root_;
+  // The paths are owned by the field extractions of the config.
+  std::vector<absl::string_view> paths_;
+};
+
+using FieldScannerPathsConstPtr = std::unique_ptr<const FieldScannerPaths>;
+
+// Extracts the configured fields of the first message of a gRPC stream by walking its wire format
+// as the data arrives, across the buffer slices. The fields which aren't on a path are skipped
+// using their length, without being copied.
+//
+// The protobuf serializers write the fields of a message in field number order. Relying on it, the
+// scan is done as soon as it reaches a field of the top level message numbered after the last
+// field leading to a path, so the rest of the message doesn't need to be waited for.
+class FieldScanner {
+public:
+  explicit FieldScanner(const FieldScannerPaths& paths);
+
+  /**
+   * Scans the next data of the stream, which is left untouched. Nothing is scanned once done.
+   * @return an error if the data isn't a gRPC frame of a valid protobuf message.
+   */
+  absl::Status scan(const Buffer::Instance& data);
+
+  /**
+   * @return true once the fields to extract are known.
+   */
+  bool done() const { return done_; }
+
+  /**
+   * @return the values of each path, once done.
+   */
+  ExtractionResult result() const;
+
+private:
+  enum class State {
+    FrameHeader,
+    Tag,
+    Varint,
+    Fixed,
+    Length,
+    Bytes,
+  };
+
+  // A message, or the packed values of a repeated field, being scanned.
+  struct Frame {
+    const FieldScannerPaths::Node* node;
+    const FieldScannerPaths::Field* packed_field;
+    // The offset of the end of the message in the gRPC message.
+    uint64_t end;
+  };
+
+  absl::Status scanBytes(const uint8_t* data, uint64_t length);
+  absl::Status onFrameHeader();
+  absl::Status onTag();
+  absl::Status onLength();
+  absl::Status onValue();
+  // Moves on to the next field, closing the frames which have been scanned whole.
+  void nextField();
+  void addValue(std::string value);
+
+  const FieldScannerPaths& paths_;
+  std::vector<std::vector<std::string>> values_;
+  std::vector<Frame> frames_;
+  State state_ = State::FrameHeader;
+  // The offset of the next byte in the gRPC message.
+  uint64_t offset_ = 0;
+  // The field being scanned, or nullptr if it isn't on a path.
+  const FieldScannerPaths::Field* field_ = nullptr;
+  uint32_t wire_type_ = 0;
+  // The value being decoded, and how many of its bytes, or of the frame header, were read.
+  uint64_t value_ = 0;
+  uint32_t value_bytes_ = 0;
+  // The bytes left of a length delimited field, and the string value kept of it if on a path.
+  uint64_t bytes_left_ = 0;
+  std::string bytes_;
+  unsigned char frame_header_[google::grpc::transcoding::kGrpcDelimiterByteSize];
+  bool done_ = false;
+};
+
+} // namespace GrpcFieldExtraction
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
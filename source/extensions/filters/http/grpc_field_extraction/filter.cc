@@ -109,6 +109,11 @@ Envoy::Http::FilterHeadersStatus Filter::decodeHeaders(Envoy::Http::RequestHeade
   }
 
   extractor_ = extractor;
+  if (const FieldScannerPaths* scanner_paths = filter_config_->findScannerPaths(*proto_path);
+      scanner_paths != nullptr) {
+    field_scanner_ = std::make_unique<FieldScanner>(*scanner_paths);
+    return Envoy::Http::FilterHeadersStatus::StopIteration;
+  }
   auto cord_message_data_factory = std::make_unique<CreateMessageDataFunc>(
       []() { return std::make_unique<Protobuf::field_extraction::CordMessageData>(); });
   request_msg_converter_ = std::make_unique<MessageConverter>(
@@ -124,6 +129,10 @@ Envoy::Http::FilterDataStatus Filter::decodeData(Envoy::Buffer::Instance& data,
     return Envoy::Http::FilterDataStatus::Continue;
   }
 
+  if (field_scanner_ != nullptr) {
+    return scanDecodeData(data, end_stream);
+  }
+
   if (auto status = handleDecodeData(data, end_stream); !status.got_messages) {
     return status.filter_status;
   }
@@ -208,6 +217,43 @@ Filter::HandleDecodeDataStatus Filter::handleDecodeData(Envoy::Buffer::Instance&
   return {};
 }
 
+Envoy::Http::FilterDataStatus Filter::scanDecodeData(Envoy::Buffer::Instance& data,
+                                                     bool end_stream) {
+  const absl::Status status = field_scanner_->scan(data);
+  if (!status.ok()) {
+    rejectRequest(status.raw_code(), status.message(),
+                  generateRcDetails(kRcDetailFilterGrpcFieldExtraction,
+                                    absl::StatusCodeToString(status.code()),
+                                    kRcDetailErrorRequestFieldExtractionFailed));
+    return Envoy::Http::FilterDataStatus::StopIterationNoBuffer;
+  }
+  scanned_data_.move(data);
+
+  if (!field_scanner_->done()) {
+    if (end_stream) {
+      rejectRequest(Status::WellKnownGrpcStatus::InvalidArgument,
+                    "did not receive enough data to form a message.",
+                    generateRcDetails(kRcDetailFilterGrpcFieldExtraction,
+                                      absl::StatusCodeToString(absl::StatusCode::kInvalidArgument),
+                                      kRcDetailErrorRequestOutOfData));
+    } else if (scanned_data_.length() > decoder_callbacks_->decoderBufferLimit()) {
+      rejectRequest(
+          Status::WellKnownGrpcStatus::FailedPrecondition,
+          "Rejected because internal buffer limits are exceeded.",
+          generateRcDetails(kRcDetailFilterGrpcFieldExtraction,
+                            absl::StatusCodeToString(absl::StatusCode::kFailedPrecondition),
+                            kRcDetailErrorRequestBufferConversion));
+    }
+    return Envoy::Http::FilterDataStatus::StopIterationNoBuffer;
+  }
+
+  extraction_done_ = true;
+  handleExtractionResult(field_scanner_->result());
+  data.move(scanned_data_);
+  ENVOY_STREAM_LOG(debug, "decodeData: scanned data size={}", *decoder_callbacks_, data.length());
+  return Envoy::Http::FilterDataStatus::Continue;
+}
+
 void Filter::handleExtractionResult(const ExtractionResult& result) {
   RELEASE_ASSERT(extractor_, "`extractor_ should be inited when extracting fields");
 
@@ -7,8 +7,10 @@
 #include "envoy/extensions/filters/http/grpc_field_extraction/v3/config.pb.validate.h"
 #include "envoy/http/filter.h"
 
+#include "source/common/buffer/buffer_impl.h"
 #include "source/extensions/filters/http/common/factory_base.h"
 #include "source/extensions/filters/http/common/pass_through_filter.h"
+#include "source/extensions/filters/http/grpc_field_extraction/field_scanner.h"
 #include "source/extensions/filters/http/grpc_field_extraction/filter_config.h"
 #include "source/extensions/filters/http/grpc_field_extraction/message_converter/message_converter.h"
 
@@ -44,6 +46,9 @@ private:
 
   HandleDecodeDataStatus handleDecodeData(Envoy::Buffer::Instance& data, bool end_stream);
 
+  // Scans the data for the fields to extract, holding it until they are known.
+  Envoy::Http::FilterDataStatus scanDecodeData(Envoy::Buffer::Instance& data, bool end_stream);
+
   void handleExtractionResult(const ExtractionResult& result);
 
   void rejectRequest(Envoy::Grpc::Status::GrpcStatus grpc_status, absl::string_view error_msg,
@@ -53,6 +58,11 @@ private:
 
   MessageConverterPtr request_msg_converter_ = nullptr;
 
+  std::unique_ptr<FieldScanner> field_scanner_;
+
+  // The data held while the first message is scanned.
+  Envoy::Buffer::OwnedImpl scanned_data_;
+
   const Extractor* extractor_ = nullptr;
 
   bool extraction_done_ = false;
@@ -43,6 +43,18 @@ void FilterConfig::initExtractors(ExtractorFactory& extractor_factory) {
                                        extractor.status().message()));
     }
 
+    if (proto_config_.extract_from_message_prefix()) {
+      auto scanner_paths = FieldScannerPaths::create(
+          *type_finder_,
+          Envoy::Grpc::Common::typeUrlPrefix() + "/" + method->input_type()->full_name(),
+          it.second);
+      if (!scanner_paths.ok()) {
+        throw EnvoyException(fmt::format("couldn't init field scanner for method `{}`: {}",
+                                         it.first, scanner_paths.status().message()));
+      }
+      proto_path_to_scanner_paths_.emplace(it.first, std::move(scanner_paths.value()));
+    }
+
     ENVOY_LOG_MISC(debug, "registered field extraction for gRPC method `{}`", it.first);
     proto_path_to_extractor_.emplace(it.first, std::move(extractor.value()));
   }
@@ -91,6 +103,11 @@ const Extractor* FilterConfig::findExtractor(absl::string_view proto_path) const
   return proto_path_to_extractor_.find(proto_path)->second.get();
 }
 
+const FieldScannerPaths* FilterConfig::findScannerPaths(absl::string_view proto_path) const {
+  auto it = proto_path_to_scanner_paths_.find(proto_path);
+  return it != proto_path_to_scanner_paths_.end() ? it->second.get() : nullptr;
+}
+
 } // namespace GrpcFieldExtraction
 } // namespace HttpFilters
 } // namespace Extensions
@@ -15,6 +15,7 @@
 #include "source/common/grpc/common.h"
 #include "source/common/protobuf/protobuf.h"
 #include "source/extensions/filters/http/grpc_field_extraction/extractor.h"
+#include "source/extensions/filters/http/grpc_field_extraction/field_scanner.h"
 
 #include "absl/container/flat_hash_map.h"
 #include "absl/container/flat_hash_set.h"
@@ -38,6 +39,9 @@ public:
 
   const Extractor* findExtractor(absl::string_view proto_path) const;
 
+  // Returns the paths to scan the first message for, if it is to be scanned as it arrives.
+  const FieldScannerPaths* findScannerPaths(absl::string_view proto_path) const;
+
 private:
   void initDescriptorPool(Api::Api& api);
 
@@ -46,6 +50,7 @@ private:
   const envoy::extensions::filters::http::grpc_field_extraction::v3::GrpcFieldExtractionConfig
       proto_config_;
   absl::flat_hash_map<std::string, std::unique_ptr<const Extractor>> proto_path_to_extractor_;
+  absl::flat_hash_map<std::string, FieldScannerPathsConstPtr> proto_path_to_scanner_paths_;
   std::unique_ptr<const Protobuf::DescriptorPool> descriptor_pool_;
   std::unique_ptr<const google::grpc::transcoding::TypeHelper> type_helper_;
   std::unique_ptr<const TypeFinder> type_finder_;
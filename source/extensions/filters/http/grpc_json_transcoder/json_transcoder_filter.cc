@@ -1,5 +1,6 @@
 #include "source/extensions/filters/http/grpc_json_transcoder/json_transcoder_filter.h"
 
+#include <limits>
 #include <memory>
 #include <unordered_set>
 
@@ -18,6 +19,7 @@
 #include "source/common/runtime/runtime_features.h"
 #include "source/extensions/filters/http/grpc_json_transcoder/http_body_utils.h"
 
+#include "absl/strings/numbers.h"
 #include "google/api/annotations.pb.h"
 #include "google/api/http.pb.h"
 #include "google/api/httpbody.pb.h"
@@ -237,6 +239,7 @@ JsonTranscoderConfig::JsonTranscoderConfig(
   if (proto_config.has_max_response_body_size()) {
     max_response_body_size_ = proto_config.max_response_body_size().value();
   }
+  stream_http_body_requests_ = proto_config.stream_http_body_requests();
 }
 
 void JsonTranscoderConfig::addFileDescriptor(const Protobuf::FileDescriptorProto& file) {
@@ -532,6 +535,7 @@ Http::FilterHeadersStatus JsonTranscoderFilter::decodeHeaders(Http::RequestHeade
     if (checkAndRejectIfRequestTranscoderFailed(RcDetails::get().GrpcTranscodeFailed)) {
       return Http::FilterHeadersStatus::StopIteration;
     }
+    maybeStreamHttpBodyRequest(headers, end_stream);
   }
 
   headers.removeContentLength();
@@ -577,6 +581,10 @@ Http::FilterDataStatus JsonTranscoderFilter::decodeData(Buffer::Instance& data,
     return Http::FilterDataStatus::Continue;
   }
 
+  if (streamed_request_body_remaining_.has_value()) {
+    return streamHttpBodyRequestData(data, end_stream);
+  }
+
   if (method_->request_type_is_http_body_) {
     stats_->transcoder_request_buffer_bytes_.add(data.length());
     request_data_.move(data);
@@ -588,7 +596,6 @@ Http::FilterDataStatus JsonTranscoderFilter::decodeData(Buffer::Instance& data,
     if (end_stream || method_->descriptor_->client_streaming()) {
       maybeSendHttpBodyRequestMessage(&data);
     } else {
-      // TODO(euroelessar): Avoid buffering if content length is already known.
       return Http::FilterDataStatus::StopIterationAndBuffer;
     }
   } else {
@@ -626,7 +633,15 @@ Http::FilterTrailersStatus JsonTranscoderFilter::decodeTrailers(Http::RequestTra
     return Http::FilterTrailersStatus::Continue;
   }
 
-  if (method_->request_type_is_http_body_) {
+  if (streamed_request_body_remaining_.has_value()) {
+    if (streamed_request_body_remaining_.value() != 0) {
+      ENVOY_STREAM_LOG(debug, "HttpBody request is shorter than its content length",
+                       *decoder_callbacks_);
+      error_ = true;
+      decoder_callbacks_->resetStream();
+      return Http::FilterTrailersStatus::StopIteration;
+    }
+  } else if (method_->request_type_is_http_body_) {
     maybeSendHttpBodyRequestMessage(nullptr);
   } else {
     request_in_.finish();
@@ -920,6 +935,57 @@ void JsonTranscoderFilter::maybeSendHttpBodyRequestMessage(Buffer::Instance* dat
   first_request_sent_ = true;
 }
 
+void JsonTranscoderFilter::maybeStreamHttpBodyRequest(const Http::RequestHeaderMap& headers,
+                                                      bool end_stream) {
+  if (!per_route_config_->stream_http_body_requests_ || end_stream ||
+      method_->descriptor_->client_streaming() || headers.ContentLength() == nullptr) {
+    return;
+  }
+  uint64_t content_length;
+  if (!absl::SimpleAtoi(headers.getContentLengthValue(), &content_length) || content_length == 0 ||
+      content_length > std::numeric_limits<int32_t>::max()) {
+    return;
+  }
+  // A body over the limit is buffered, and rejected as it is without streaming.
+  if (per_route_config_->max_request_body_size_.has_value() &&
+      content_length > per_route_config_->max_request_body_size_.value()) {
+    return;
+  }
+  streamed_request_body_remaining_ = content_length;
+}
+
+Http::FilterDataStatus JsonTranscoderFilter::streamHttpBodyRequestData(Buffer::Instance& data,
+                                                                       bool end_stream) {
+  uint64_t& remaining = streamed_request_body_remaining_.value();
+  if (data.length() > remaining || (end_stream && data.length() != remaining)) {
+    ENVOY_STREAM_LOG(debug, "HttpBody request doesn't match its content length",
+                     *decoder_callbacks_);
+    error_ = true;
+    decoder_callbacks_->resetStream();
+    return Http::FilterDataStatus::StopIterationNoBuffer;
+  }
+
+  const uint64_t length = data.length();
+  if (!first_request_sent_) {
+    // The message is framed with the length of the whole body, which then follows as it comes.
+    Buffer::OwnedImpl message_prefix;
+    stats_->transcoder_request_buffer_bytes_.sub(initial_request_data_.length());
+    message_prefix.move(initial_request_data_);
+    HttpBodyUtils::appendHttpBodyEnvelope(message_prefix, method_->request_body_field_path,
+                                          std::move(content_type_), remaining);
+    content_type_.clear();
+    Grpc::Encoder().prependFrameHeader(Grpc::GRPC_FH_DEFAULT, message_prefix,
+                                       message_prefix.length() + remaining);
+    data.prepend(message_prefix);
+    first_request_sent_ = true;
+  }
+  remaining -= length;
+
+  ENVOY_STREAM_LOG(debug, "streaming HttpBody request data, remaining={}, end_stream={}",
+                   *decoder_callbacks_, remaining, end_stream);
+  return Http::FilterDataStatus::Continue;
+}
+
 bool JsonTranscoderFilter::buildResponseFromHttpBodyOutput(
     Http::ResponseHeaderMap& response_headers, Buffer::Instance& data) {
   std::vector<Grpc::Frame> frames;
@@ -110,6 +110,7 @@ public:
 
   absl::optional<uint32_t> max_request_body_size_;
   absl::optional<uint32_t> max_response_body_size_;
+  bool stream_http_body_requests_{};
 
   void addBuiltinSymbolDescriptor(const std::string& symbol_name);
 
@@ -186,6 +187,11 @@ private:
   bool checkAndRejectIfResponseTranscoderFailed();
   bool readToBuffer(Protobuf::io::ZeroCopyInputStream& stream, Buffer::Instance& data);
   void maybeSendHttpBodyRequestMessage(Buffer::Instance* data);
+  /**
+   * Starts streaming the body of a unary HttpBody request if its length is known.
+   */
+  void maybeStreamHttpBodyRequest(const Http::RequestHeaderMap& headers, bool end_stream);
+  Http::FilterDataStatus streamHttpBodyRequestData(Buffer::Instance& data, bool end_stream);
   /**
    * Builds response from HttpBody protobuf.
    * Returns true if at least one gRPC frame has processed.
@@ -225,6 +231,8 @@ private:
   Buffer::OwnedImpl request_data_;
   bool first_request_sent_{false};
   std::string content_type_;
+  // The length of the body still to come, when the body of an HttpBody request is streamed.
+  absl::optional<uint64_t> streamed_request_body_remaining_;
 
   bool error_{false};
   bool has_body_{false};
@@ -19,21 +19,32 @@ namespace HttpFilters {
 namespace HeaderToMetadataFilter {
 
 // Extract the value of the header.
-absl::optional<std::string> HeaderValueSelector::extract(Http::HeaderMap& map) const {
-  const auto header_value = Http::HeaderUtility::getAllOfHeaderAsString(map, header_);
-  if (!header_value.result().has_value()) {
+template <class HeaderMapType>
+absl::optional<std::string> HeaderValueSelector::extractImpl(HeaderMapType& map) const {
+  const auto header = header_.get(map);
+  if (header.empty()) {
     return absl::nullopt;
   }
   // Catch the value in the header before removing.
-  absl::optional<std::string> value = std::string(header_value.result().value());
+  absl::optional<std::string> value =
+      header.size() == 1 ? std::string(header[0]->value().getStringView())
+                         : Http::HeaderUtility::getAllOfHeaderAsString(header).backingString();
   if (remove_) {
-    map.remove(header_);
+    header_.remove(map);
   }
   return value;
 }
 
+absl::optional<std::string> HeaderValueSelector::extract(Http::RequestHeaderMap& map) const {
+  return extractImpl(map);
+}
+
+absl::optional<std::string> HeaderValueSelector::extract(Http::ResponseHeaderMap& map) const {
+  return extractImpl(map);
+}
+
 // Extract the value of the key from the cookie header.
-absl::optional<std::string> CookieValueSelector::extract(Http::HeaderMap& map) const {
+absl::optional<std::string> CookieValueSelector::extractImpl(const Http::HeaderMap& map) const {
   std::string value = Envoy::Http::Utility::parseCookieValue(map, cookie_);
   if (!value.empty()) {
     return {std::move(value)};
@@ -226,7 +237,8 @@ void HeaderToMetadataFilter::applyKeyValue(std::string&& value, const Rule& rule
   }
 }
 
-void HeaderToMetadataFilter::writeHeaderToMetadata(Http::HeaderMap& headers,
+template <class HeaderMapType>
+void HeaderToMetadataFilter::writeHeaderToMetadata(HeaderMapType& headers,
                                                    const HeaderToMetadataRules& rules,
                                                    Http::StreamFilterCallbacks& callbacks) {
   StructMap structs_by_namespace;
@@ -9,6 +9,7 @@
 
 #include "source/common/common/logger.h"
 #include "source/common/common/matchers.h"
+#include "source/common/http/header_accessor.h"
 
 #include "absl/strings/string_view.h"
 
@@ -32,7 +33,8 @@ public:
    * @param http header map.
    * @return absl::optional<std::string> the extracted header or cookie.
    */
-  virtual absl::optional<std::string> extract(Http::HeaderMap& map) const PURE;
+  virtual absl::optional<std::string> extract(Http::RequestHeaderMap& map) const PURE;
+  virtual absl::optional<std::string> extract(Http::ResponseHeaderMap& map) const PURE;
 
   /**
    * @return a string representation of either a cookie or a header passed in the request.
@@ -44,14 +46,21 @@ public:
 class HeaderValueSelector : public ValueSelector {
 public:
   // ValueSelector.
-  explicit HeaderValueSelector(Http::LowerCaseString header, bool remove)
-      : header_(std::move(header)), remove_(std::move(remove)) {}
-  absl::optional<std::string> extract(Http::HeaderMap& map) const override;
-  std::string toString() const override { return fmt::format("header '{}'", header_.get()); }
+  explicit HeaderValueSelector(const Http::LowerCaseString& header, bool remove)
+      : header_(header), remove_(remove) {}
+  absl::optional<std::string> extract(Http::RequestHeaderMap& map) const override;
+  absl::optional<std::string> extract(Http::ResponseHeaderMap& map) const override;
+  std::string toString() const override {
+    return fmt::format("header '{}'", header_.name().get());
+  }
   ~HeaderValueSelector() override = default;
 
 private:
-  const Http::LowerCaseString header_;
+  template <class HeaderMapType>
+  absl::optional<std::string> extractImpl(HeaderMapType& map) const;
+
+  // Headers registered as inline headers are found in O(1).
+  const Http::HeaderAccessor header_;
   const bool remove_;
 };
 
@@ -60,11 +69,18 @@ class CookieValueSelector : public ValueSelector {
 public:
   // ValueSelector.
   explicit CookieValueSelector(std::string cookie) : cookie_(std::move(cookie)) {}
-  absl::optional<std::string> extract(Http::HeaderMap& map) const override;
+  absl::optional<std::string> extract(Http::RequestHeaderMap& map) const override {
+    return extractImpl(map);
+  }
+  absl::optional<std::string> extract(Http::ResponseHeaderMap& map) const override {
+    return extractImpl(map);
+  }
   std::string toString() const override { return fmt::format("cookie '{}'", cookie_); }
   ~CookieValueSelector() override = default;
 
 private:
+  absl::optional<std::string> extractImpl(const Http::HeaderMap& map) const;
+
   const std::string cookie_;
 };
 
@@ -186,7 +202,8 @@ private:
    *  @param callbacks the callback used to fetch the StreamInfo (which is then used to get
    *                   metadata). Callable with both encoder_callbacks_ and decoder_callbacks_.
    */
-  void writeHeaderToMetadata(Http::HeaderMap& headers, const HeaderToMetadataRules& rules,
+  template <class HeaderMapType>
+  void writeHeaderToMetadata(HeaderMapType& headers, const HeaderToMetadataRules& rules,
                              Http::StreamFilterCallbacks& callbacks);
   bool addMetadata(StructMap&, const std::string&, const std::string&, std::string, ValueType,
                    ValueEncode) const;
@@ -16,8 +16,10 @@ Http::FilterFactoryCb IpTaggingFilterFactory::createFilterFactoryFromProtoTyped(
     const envoy::extensions::filters::http::ip_tagging::v3::IPTagging& proto_config,
     const std::string& stat_prefix, Server::Configuration::FactoryContext& context) {
 
+  Server::Configuration::ServerFactoryContext& server_context = context.serverFactoryContext();
   IpTaggingFilterConfigSharedPtr config(new IpTaggingFilterConfig(
-      proto_config, stat_prefix, context.scope(), context.serverFactoryContext().runtime()));
+      proto_config, stat_prefix, context.scope(), server_context.runtime(),
+      server_context.mainThreadDispatcher(), server_context.threadLocal(), server_context.api()));
 
   return [config](Http::FilterChainFactoryCallbacks& callbacks) -> void {
     callbacks.addStreamDecoderFilter(std::make_shared<IpTaggingFilter>(config));
@@ -3,10 +3,14 @@
 #include "envoy/config/core/v3/address.pb.h"
 #include "envoy/extensions/filters/http/ip_tagging/v3/ip_tagging.pb.h"
 
+#include "source/common/config/datasource.h"
 #include "source/common/http/header_map_impl.h"
 #include "source/common/http/headers.h"
 
+#include "absl/container/flat_hash_map.h"
+#include "absl/strings/ascii.h"
 #include "absl/strings/str_join.h"
+#include "absl/strings/str_split.h"
 
 namespace Envoy {
 namespace Extensions {
@@ -15,23 +19,21 @@ namespace IpTagging {
 
 IpTaggingFilterConfig::IpTaggingFilterConfig(
     const envoy::extensions::filters::http::ip_tagging::v3::IPTagging& config,
-    const std::string& stat_prefix, Stats::Scope& scope, Runtime::Loader& runtime)
-    : request_type_(requestTypeEnum(config.request_type())), scope_(scope), runtime_(runtime),
+    const std::string& stat_prefix, Stats::Scope& scope, Runtime::Loader& runtime,
+    Event::Dispatcher& main_dispatcher, ThreadLocal::SlotAllocator& tls, Api::Api& api)
+    : main_dispatcher_(main_dispatcher), request_type_(requestTypeEnum(config.request_type())),
+      scope_(scope), runtime_(runtime),
       stat_name_set_(scope.symbolTable().makeSet("IpTagging")),
       stats_prefix_(stat_name_set_->add(stat_prefix + "ip_tagging")),
       no_hit_(stat_name_set_->add("no_hit")), total_(stat_name_set_->add("total")),
       unknown_tag_(stat_name_set_->add("unknown_tag.hit")) {
 
-  // Once loading IP tags from a file system is supported, the restriction on the size
-  // of the set should be removed and observability into what tags are loaded needs
-  // to be implemented.
-  // TODO(ccaraman): Remove size check once file system support is implemented.
-  // Work is tracked by issue https://github.com/envoyproxy/envoy/issues/2695.
-  if (config.ip_tags().empty()) {
-    throw EnvoyException("HTTP IP Tagging Filter requires ip_tags to be specified.");
+  if (config.ip_tags().empty() && !config.has_ip_tags_file()) {
+    throw EnvoyException(
+        "HTTP IP Tagging Filter requires ip_tags or ip_tags_file to be specified.");
   }
 
-  std::vector<std::pair<std::string, std::vector<Network::Address::CidrRange>>> tag_data;
+  IpTagData tag_data;
   tag_data.reserve(config.ip_tags().size());
   for (const auto& ip_tag : config.ip_tags()) {
     std::vector<Network::Address::CidrRange> cidr_set;
@@ -52,7 +54,115 @@ IpTaggingFilterConfig::IpTaggingFilterConfig(
     tag_data.emplace_back(ip_tag.ip_tag_name(), cidr_set);
     stat_name_set_->rememberBuiltin(absl::StrCat(ip_tag.ip_tag_name(), ".hit"));
   }
-  trie_ = std::make_unique<Network::LcTrie::LcTrie<std::string>>(tag_data);
+  if (!config.has_ip_tags_file()) {
+    trie_ = std::make_shared<const IpTagTrie>(tag_data);
+    return;
+  }
+
+  const auto& source = config.ip_tags_file();
+  const std::string contents =
+      THROW_OR_RETURN_VALUE(Config::DataSource::read(source, true, api), std::string);
+  IpTagData file_tag_data = tag_data;
+  THROW_IF_NOT_OK(addFileTags(contents, file_tag_data));
+  for (size_t i = tag_data.size(); i < file_tag_data.size(); ++i) {
+    stat_name_set_->rememberBuiltin(absl::StrCat(file_tag_data[i].first, ".hit"));
+  }
+  trie_ = std::make_shared<const IpTagTrie>(file_tag_data);
+  if (!source.has_watched_directory() ||
+      source.specifier_case() != envoy::config::core::v3::DataSource::kFilename) {
+    return;
+  }
+
+  tags_ = ThreadLocal::TypedSlot<ThreadLocalTags>::makeUnique(tls);
+  tags_->set([trie = std::move(trie_)](Event::Dispatcher&) {
+    return std::make_shared<ThreadLocalTags>(trie);
+  });
+  watcher_ = main_dispatcher.createFilesystemWatcher();
+  THROW_IF_NOT_OK(watcher_->addWatch(
+      absl::StrCat(source.watched_directory().path(), "/"), Filesystem::Watcher::Events::MovedTo,
+      [tags = tags_.get(), &api, filename = source.filename(),
+       config_tag_data = std::move(tag_data)](uint32_t) -> absl::Status {
+        auto contents_or_error = api.fileSystem().fileReadToEnd(filename);
+        if (!contents_or_error.ok()) {
+          ENVOY_LOG(error, "failed to read the IP tags file {}: {}", filename,
+                    contents_or_error.status().message());
+          return absl::OkStatus();
+        }
+        auto trie_or_error = buildTrie(config_tag_data, contents_or_error.value());
+        if (!trie_or_error.ok()) {
+          ENVOY_LOG(error, "failed to load the IP tags file {}: {}", filename,
+                    trie_or_error.status().message());
+          return absl::OkStatus();
+        }
+        ENVOY_LOG(debug, "reloaded the IP tags file {}", filename);
+        tags->runOnAllThreads(
+            [trie = std::move(trie_or_error.value())](OptRef<ThreadLocalTags> thread_tags) {
+              if (thread_tags.has_value()) {
+                thread_tags->trie_ = trie;
+              }
+            });
+        return absl::OkStatus();
+      }));
+}
+
+IpTaggingFilterConfig::~IpTaggingFilterConfig() {
+  // The filters may release the configuration on a worker, but the slot and the watcher belong to
+  // the main thread.
+  if (tags_ != nullptr && !main_dispatcher_.isThreadSafe()) {
+    main_dispatcher_.post([watcher = std::move(watcher_), tags = std::move(tags_)]() mutable {
+      watcher.reset();
+      tags.reset();
+    });
+  }
+}
+
+absl::Status IpTaggingFilterConfig::addFileTags(absl::string_view contents, IpTagData& tag_data) {
+  absl::flat_hash_map<std::string, size_t> tag_indexes;
+  for (size_t i = 0; i < tag_data.size(); ++i) {
+    tag_indexes.emplace(tag_data[i].first, i);
+  }
+  for (absl::string_view line : absl::StrSplit(contents, '\n')) {
+    line = absl::StripAsciiWhitespace(line);
+    if (line.empty() || line[0] == '#') {
+      continue;
+    }
+    const std::vector<absl::string_view> fields =
+        absl::StrSplit(line, absl::ByAnyChar(" \t"), absl::SkipEmpty());
+    if (fields.size() != 2) {
+      return absl::InvalidArgumentError(fmt::format(
+          "invalid IP tag line '{}' (format is <ip tag name> <ip>/<# mask bits>)", line));
+    }
+    absl::StatusOr<Network::Address::CidrRange> cidr_or_error =
+        Network::Address::CidrRange::create(std::string(fields[1]));
+    if (!cidr_or_error.ok()) {
+      return absl::InvalidArgumentError(
+          fmt::format("invalid ip/mask combo '{}' (format is <ip>/<# mask bits>)", fields[1]));
+    }
+
+    auto it = tag_indexes.find(fields[0]);
+    if (it == tag_indexes.end()) {
+      it = tag_indexes.emplace(fields[0], tag_data.size()).first;
+      tag_data.emplace_back(std::string(fields[0]), std::vector<Network::Address::CidrRange>{});
+    }
+    tag_data[it->second].second.push_back(std::move(cidr_or_error.value()));
+  }
+  return absl::OkStatus();
+}
+
+absl::StatusOr<IpTagTrieConstSharedPtr>
+IpTaggingFilterConfig::buildTrie(const IpTagData& config_tag_data, absl::string_view contents) {
+  IpTagData tag_data = config_tag_data;
+  RETURN_IF_NOT_OK(addFileTags(contents, tag_data));
+  // The trie throws if the tags need more nodes than it supports.
+  std::string error;
+  IpTagTrieConstSharedPtr trie;
+  TRY_ASSERT_MAIN_THREAD { trie = std::make_shared<const IpTagTrie>(tag_data); }
+  END_TRY
+  CATCH(EnvoyException & e, { error = e.what(); });
+  if (!error.empty()) {
+    return absl::InvalidArgumentError(error);
+  }
+  return trie;
 }
 
 void IpTaggingFilterConfig::incCounter(Stats::StatName name) {
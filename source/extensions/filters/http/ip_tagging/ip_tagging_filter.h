@@ -6,11 +6,15 @@
 #include <utility>
 #include <vector>
 
+#include "envoy/api/api.h"
 #include "envoy/common/exception.h"
+#include "envoy/event/dispatcher.h"
 #include "envoy/extensions/filters/http/ip_tagging/v3/ip_tagging.pb.h"
+#include "envoy/filesystem/watcher.h"
 #include "envoy/http/filter.h"
 #include "envoy/runtime/runtime.h"
 #include "envoy/stats/scope.h"
+#include "envoy/thread_local/thread_local.h"
 
 #include "source/common/network/cidr_range.h"
 #include "source/common/network/lc_trie.h"
@@ -26,18 +30,27 @@ namespace IpTagging {
  */
 enum class FilterRequestType { INTERNAL, EXTERNAL, BOTH };
 
+using IpTagTrie = Network::LcTrie::LcTrie<std::string>;
+using IpTagTrieConstSharedPtr = std::shared_ptr<const IpTagTrie>;
+
 /**
  * Configuration for the HTTP IP Tagging filter.
+ *
+ * If the tags of a watched file are reloaded, the new trie is built on the main thread and then
+ * published to the workers, each of which keeps looking up the previous trie until it gets the new
+ * one.
  */
-class IpTaggingFilterConfig {
+class IpTaggingFilterConfig : Logger::Loggable<Logger::Id::filter> {
 public:
   IpTaggingFilterConfig(const envoy::extensions::filters::http::ip_tagging::v3::IPTagging& config,
                         const std::string& stat_prefix, Stats::Scope& scope,
-                        Runtime::Loader& runtime);
+                        Runtime::Loader& runtime, Event::Dispatcher& main_dispatcher,
+                        ThreadLocal::SlotAllocator& tls, Api::Api& api);
+  ~IpTaggingFilterConfig();
 
   Runtime::Loader& runtime() { return runtime_; }
   FilterRequestType requestType() const { return request_type_; }
-  const Network::LcTrie::LcTrie<std::string>& trie() const { return *trie_; }
+  const IpTagTrie& trie() const { return tags_ != nullptr ? *(*tags_)->trie_ : *trie_; }
 
   void incHit(absl::string_view tag) {
     incCounter(stat_name_set_->getBuiltin(absl::StrCat(tag, ".hit"), unknown_tag_));
@@ -60,8 +73,22 @@ private:
     PANIC_DUE_TO_CORRUPT_ENUM;
   }
 
+  using IpTagData = std::vector<std::pair<std::string, std::vector<Network::Address::CidrRange>>>;
+
+  struct ThreadLocalTags : public ThreadLocal::ThreadLocalObject {
+    explicit ThreadLocalTags(IpTagTrieConstSharedPtr trie) : trie_(std::move(trie)) {}
+    IpTagTrieConstSharedPtr trie_;
+  };
+
+  // Adds the tags of the lines of an IP tags file to the tag data.
+  static absl::Status addFileTags(absl::string_view contents, IpTagData& tag_data);
+  // Builds the trie of the tags of the configuration and of the content of the IP tags file.
+  static absl::StatusOr<IpTagTrieConstSharedPtr> buildTrie(const IpTagData& config_tag_data,
+                                                           absl::string_view contents);
+
   void incCounter(Stats::StatName name);
 
+  Event::Dispatcher& main_dispatcher_;
   const FilterRequestType request_type_;
   Stats::Scope& scope_;
   Runtime::Loader& runtime_;
@@ -70,7 +97,10 @@ private:
   const Stats::StatName no_hit_;
   const Stats::StatName total_;
   const Stats::StatName unknown_tag_;
-  std::unique_ptr<Network::LcTrie::LcTrie<std::string>> trie_;
+  // The trie of the tags, unless they are reloaded from a watched file into tags_.
+  IpTagTrieConstSharedPtr trie_;
+  ThreadLocal::TypedSlotPtr<ThreadLocalTags> tags_;
+  Filesystem::WatcherPtr watcher_;
 };
 
 using IpTaggingFilterConfigSharedPtr = std::shared_ptr<IpTaggingFilterConfig>;
@@ -85,6 +85,16 @@ Regex::CompiledMatcherPtr generateAllowContentTypeRegexs(
   return allow_content_types_regex;
 }
 
+// The bodies are only loaded with the values the rules look up.
+Json::KeySelection generateKeySelection(const Rules& rules) {
+  std::vector<std::vector<std::string>> key_paths;
+  key_paths.reserve(rules.size());
+  for (const auto& rule : rules) {
+    key_paths.push_back(rule.keys_);
+  }
+  return Json::KeySelection(key_paths);
+}
+
 } // anonymous namespace
 
 Rule::Rule(const ProtoRule& rule) : rule_(rule) {
@@ -116,6 +126,8 @@ FilterConfig::FilterConfig(
           ALL_JSON_TO_METADATA_FILTER_STATS(POOL_COUNTER_PREFIX(scope, "json_to_metadata.resp"))},
       request_rules_(generateRules(proto_config.request_rules().rules())),
       response_rules_(generateRules(proto_config.response_rules().rules())),
+      request_selection_(generateKeySelection(request_rules_)),
+      response_selection_(generateKeySelection(response_rules_)),
       request_allow_content_types_(
           generateAllowContentTypes(proto_config.request_rules().allow_content_types())),
       response_allow_content_types_(
@@ -328,7 +340,8 @@ absl::Status Filter::handleOnPresent(Json::ObjectSharedPtr parent_node, const st
 }
 
 void Filter::processBody(const Buffer::Instance* body, const Rules& rules,
-                         bool should_clear_route_cache, JsonToMetadataStats& stats,
+                         const Json::KeySelection& selection, bool should_clear_route_cache,
+                         JsonToMetadataStats& stats,
                          Http::StreamFilterCallbacks& filter_callback,
                          bool& processing_finished_flag) {
   // In case we have trailers but no body.
@@ -339,7 +352,7 @@ void Filter::processBody(const Buffer::Instance* body, const Rules& rules,
   }
 
   absl::StatusOr<Json::ObjectSharedPtr> result =
-      Json::Factory::loadFromStringNoThrow(body->toString());
+      Json::Factory::loadSelectedFromStringNoThrow(body->toString(), selection);
   if (!result.ok()) {
     ENVOY_LOG(debug, result.status().message());
     stats.invalid_json_body_.inc();
@@ -393,13 +406,15 @@ void Filter::processBody(const Buffer::Instance* body, const Rules& rules,
 }
 
 void Filter::processRequestBody() {
-  processBody(decoder_callbacks_->decodingBuffer(), config_->requestRules(), true,
-              config_->rqstats(), *decoder_callbacks_, request_processing_finished_);
+  processBody(decoder_callbacks_->decodingBuffer(), config_->requestRules(),
+              config_->requestSelection(), true, config_->rqstats(), *decoder_callbacks_,
+              request_processing_finished_);
 }
 
 void Filter::processResponseBody() {
-  processBody(encoder_callbacks_->encodingBuffer(), config_->responseRules(), false,
-              config_->respstats(), *encoder_callbacks_, response_processing_finished_);
+  processBody(encoder_callbacks_->encodingBuffer(), config_->responseRules(),
+              config_->responseSelection(), false, config_->respstats(), *encoder_callbacks_,
+              response_processing_finished_);
 }
 
 Http::FilterHeadersStatus Filter::decodeHeaders(Http::RequestHeaderMap& headers, bool end_stream) {
@@ -12,6 +12,7 @@
 
 #include "source/common/buffer/buffer_impl.h"
 #include "source/common/common/matchers.h"
+#include "source/common/json/json_loader.h"
 #include "source/extensions/filters/http/common/pass_through_filter.h"
 
 #include "absl/strings/string_view.h"
@@ -69,6 +70,8 @@ public:
   bool doResponse() const { return !response_rules_.empty(); }
   const Rules& requestRules() const { return request_rules_; }
   const Rules& responseRules() const { return response_rules_; }
+  const Json::KeySelection& requestSelection() const { return request_selection_; }
+  const Json::KeySelection& responseSelection() const { return response_selection_; }
   bool requestContentTypeAllowed(absl::string_view) const;
   bool responseContentTypeAllowed(absl::string_view) const;
 
@@ -79,6 +82,9 @@ private:
   JsonToMetadataStats respstats_;
   const Rules request_rules_;
   const Rules response_rules_;
+  // The keys of the rules, to only load the values they look up from the bodies.
+  const Json::KeySelection request_selection_;
+  const Json::KeySelection response_selection_;
   const absl::flat_hash_set<std::string> request_allow_content_types_;
   const absl::flat_hash_set<std::string> response_allow_content_types_;
   const bool request_allow_empty_content_type_;
@@ -125,7 +131,8 @@ private:
                         Http::StreamFilterCallbacks& filter_callback,
                         bool& processing_finished_flag);
   // Parse the body while we have the whole json.
-  void processBody(const Buffer::Instance* body, const Rules& rules, bool should_clear_route_cache,
+  void processBody(const Buffer::Instance* body, const Rules& rules,
+                   const Json::KeySelection& selection, bool should_clear_route_cache,
                    JsonToMetadataStats& stats, Http::StreamFilterCallbacks& filter_callback,
                    bool& processing_finished_flag);
   void processRequestBody();
@@ -78,8 +78,14 @@ public:
 
     bool enable_jwt_cache = jwt_provider_.has_jwt_cache_config();
     const auto& config = jwt_provider_.jwt_cache_config();
-    tls_.set([enable_jwt_cache, config](Envoy::Event::Dispatcher& dispatcher) {
-      return std::make_shared<ThreadLocalCache>(enable_jwt_cache, config, dispatcher.timeSource());
+    if (enable_jwt_cache && config.shared_jwt_cache_size() > 0) {
+      shared_jwt_cache_ =
+          std::make_shared<SharedJwtCache>(config.shared_jwt_cache_size(), time_source_);
+    }
+    tls_.set([enable_jwt_cache, config,
+              shared_jwt_cache = shared_jwt_cache_](Envoy::Event::Dispatcher& dispatcher) {
+      return std::make_shared<ThreadLocalCache>(enable_jwt_cache, config, dispatcher.timeSource(),
+                                                shared_jwt_cache);
     });
 
     const auto inline_jwks =
@@ -147,6 +153,7 @@ public:
   const ::google::jwt_verify::Jwks* setRemoteJwks(JwksConstPtr&& jwks) override {
     // convert unique_ptr to shared_ptr
     JwksConstSharedPtr shared_jwks = std::move(jwks);
+    clearSharedJwtCache();
     tls_->jwks_ = shared_jwks;
     tls_->expire_ = time_source_.monotonicTime() +
                     JwksAsyncFetcher::getCacheDuration(jwt_provider_.remote_jwks());
@@ -159,8 +166,9 @@ private:
   struct ThreadLocalCache : public ThreadLocal::ThreadLocalObject {
     ThreadLocalCache(bool enable_jwt_cache,
                      const envoy::extensions::filters::http::jwt_authn::v3::JwtCacheConfig& config,
-                     TimeSource& time_source)
-        : jwt_cache_(JwtCache::create(enable_jwt_cache, config, time_source)) {}
+                     TimeSource& time_source, SharedJwtCacheSharedPtr shared_jwt_cache)
+        : jwt_cache_(JwtCache::create(enable_jwt_cache, config, time_source,
+                                      std::move(shared_jwt_cache))) {}
 
     // The jwks object.
     JwksConstSharedPtr jwks_;
@@ -173,12 +181,21 @@ private:
   // Set jwks shared_ptr to all threads.
   void setJwksToAllThreads(JwksConstPtr&& jwks) {
     JwksConstSharedPtr shared_jwks = std::move(jwks);
+    clearSharedJwtCache();
     tls_.runOnAllThreads([shared_jwks](OptRef<ThreadLocalCache> obj) {
       obj->jwks_ = shared_jwks;
       obj->expire_ = std::chrono::steady_clock::time_point::max();
     });
   }
 
+  // The tokens verified with the previous JWKS are no longer trusted by the workers which didn't
+  // cache them yet.
+  void clearSharedJwtCache() {
+    if (shared_jwt_cache_) {
+      shared_jwt_cache_->clear();
+    }
+  }
+
   // The jwt provider config.
   const JwtProvider& jwt_provider_;
   // Check audience object
@@ -187,6 +204,8 @@ private:
   TimeSource& time_source_;
   // the thread local slot for cache
   ThreadLocal::TypedSlot<ThreadLocalCache> tls_;
+  // the cache of verified tokens shared by the workers, if enabled
+  SharedJwtCacheSharedPtr shared_jwt_cache_;
   // async fetcher
   JwksAsyncFetcherPtr async_fetcher_;
   absl::optional<Matchers::StringMatcherImpl<envoy::type::matcher::v3::StringMatcher>> sub_matcher_;
@@ -1,7 +1,10 @@
 #include "source/extensions/filters/http/jwt_authn/jwt_cache.h"
 
+#include <algorithm>
+
 #include "source/common/common/assert.h"
 
+#include "openssl/sha.h"
 #include "simple_lru_cache/simple_lru_cache_inl.h"
 
 using ::google::simple_lru_cache::SimpleLRUCache;
@@ -19,8 +22,9 @@ constexpr int kMaxJwtSizeForCache = 4 * 1024; // 4KiB
 
 class JwtCacheImpl : public JwtCache {
 public:
-  JwtCacheImpl(bool enable_cache, const JwtCacheConfig& config, TimeSource& time_source)
-      : time_source_(time_source) {
+  JwtCacheImpl(bool enable_cache, const JwtCacheConfig& config, TimeSource& time_source,
+               SharedJwtCacheSharedPtr shared_cache)
+      : time_source_(time_source), shared_cache_(enable_cache ? std::move(shared_cache) : nullptr) {
     if (enable_cache) {
       // if cache_size is 0, it is not specified in the config, use default
       auto cache_size =
@@ -52,25 +56,95 @@ public:
         jwt_lru_cache_->remove(token);
       }
     }
-    return nullptr;
+    return lookupShared(token);
   }
 
   void insert(const std::string& token, std::unique_ptr<::google::jwt_verify::Jwt>&& jwt) override {
     if (jwt_lru_cache_ && token.size() <= kMaxJwtSizeForCache) {
+      if (shared_cache_) {
+        shared_cache_->insert(token, jwt->exp_);
+      }
       // pass the ownership of jwt to cache
       jwt_lru_cache_->insert(token, jwt.release(), 1);
     }
   }
 
 private:
+  // Looks the token up in the shared cache, and if it was verified, parses it and adds it to the
+  // cache without verifying its signature.
+  ::google::jwt_verify::Jwt* lookupShared(const std::string& token) {
+    if (!shared_cache_ || token.size() > kMaxJwtSizeForCache || !shared_cache_->lookup(token)) {
+      return nullptr;
+    }
+    auto jwt = std::make_unique<::google::jwt_verify::Jwt>();
+    if (jwt->parseFromString(token) != ::google::jwt_verify::Status::Ok ||
+        jwt->verifyTimeConstraint(DateUtil::nowToSeconds(time_source_)) !=
+            ::google::jwt_verify::Status::Ok) {
+      return nullptr;
+    }
+    ::google::jwt_verify::Jwt* const found_jwt = jwt.get();
+    jwt_lru_cache_->insert(token, jwt.release(), 1);
+    return found_jwt;
+  }
+
   std::unique_ptr<SimpleLRUCache<std::string, ::google::jwt_verify::Jwt>> jwt_lru_cache_;
   TimeSource& time_source_;
+  const SharedJwtCacheSharedPtr shared_cache_;
 };
 } // namespace
 
+SharedJwtCache::SharedJwtCache(uint32_t max_entries, TimeSource& time_source)
+    : max_shard_entries_(std::max<size_t>(1, max_entries / NumShards)), time_source_(time_source) {}
+
+bool SharedJwtCache::lookup(const std::string& token) {
+  const Digest token_digest = digest(token);
+  Shard& token_shard = shard(token_digest);
+  absl::MutexLock lock(&token_shard.mutex_);
+  auto it = token_shard.entries_.find(token_digest);
+  if (it == token_shard.entries_.end()) {
+    return false;
+  }
+  if (it->second != 0 && it->second <= DateUtil::nowToSeconds(time_source_)) {
+    token_shard.entries_.erase(it);
+    return false;
+  }
+  return true;
+}
+
+void SharedJwtCache::insert(const std::string& token, uint64_t exp) {
+  const Digest token_digest = digest(token);
+  Shard& token_shard = shard(token_digest);
+  absl::MutexLock lock(&token_shard.mutex_);
+  if (token_shard.entries_.size() >= max_shard_entries_ &&
+      !token_shard.entries_.contains(token_digest)) {
+    // Make room, first by evicting the expired tokens, then arbitrary ones.
+    const uint64_t now = DateUtil::nowToSeconds(time_source_);
+    absl::erase_if(token_shard.entries_,
+                   [now](const auto& entry) { return entry.second != 0 && entry.second <= now; });
+    while (token_shard.entries_.size() >= max_shard_entries_) {
+      token_shard.entries_.erase(token_shard.entries_.begin());
+    }
+  }
+  token_shard.entries_.insert_or_assign(token_digest, exp);
+}
+
+void SharedJwtCache::clear() {
+  for (Shard& token_shard : shards_) {
+    absl::MutexLock lock(&token_shard.mutex_);
+    token_shard.entries_.clear();
+  }
+}
+
+SharedJwtCache::Digest SharedJwtCache::digest(const std::string& token) {
+  Digest token_digest;
+  SHA256(reinterpret_cast<const uint8_t*>(token.data()), token.size(), token_digest.data());
+  return token_digest;
+}
+
 JwtCachePtr JwtCache::create(bool enable_cache, const JwtCacheConfig& config,
-                             TimeSource& time_source) {
-  return std::make_unique<JwtCacheImpl>(enable_cache, config, time_source);
+                             TimeSource& time_source, SharedJwtCacheSharedPtr shared_cache) {
+  return std::make_unique<JwtCacheImpl>(enable_cache, config, time_source,
+                                        std::move(shared_cache));
 }
 
 } // namespace JwtAuthn
@@ -1,4 +1,5 @@
 #pragma once
+#include <array>
 #include <chrono>
 #include <memory>
 #include <string>
@@ -7,6 +8,9 @@
 
 #include "source/common/common/utility.h"
 
+#include "absl/base/thread_annotations.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/synchronization/mutex.h"
 #include "jwt_verify_lib/jwt.h"
 #include "jwt_verify_lib/verify.h"
 
@@ -17,6 +21,43 @@ namespace Extensions {
 namespace HttpFilters {
 namespace JwtAuthn {
 
+// A cache of verified JWT tokens shared by the workers, in front of which each worker has its own
+// JwtCache. The entries are keyed by the SHA-256 digest of the tokens and record their expiration,
+// so the cache is bounded by its number of entries whatever the size of the tokens. The cache is
+// split in shards, each guarded by its own mutex.
+class SharedJwtCache {
+public:
+  SharedJwtCache(uint32_t max_entries, TimeSource& time_source);
+
+  // Returns whether the token was verified and hasn't expired since.
+  bool lookup(const std::string& token);
+
+  // Records that the token was verified. exp is its expiration in seconds, or 0 if it has none.
+  void insert(const std::string& token, uint64_t exp);
+
+  // Removes all the tokens, as they may have been verified with keys no longer in the JWKS.
+  void clear();
+
+private:
+  static constexpr size_t NumShards = 16;
+  using Digest = std::array<uint8_t, 32>;
+
+  struct Shard {
+    absl::Mutex mutex_;
+    // The expiration of the tokens by digest.
+    absl::flat_hash_map<Digest, uint64_t> entries_ ABSL_GUARDED_BY(mutex_);
+  };
+
+  static Digest digest(const std::string& token);
+  Shard& shard(const Digest& digest) { return shards_[digest[0] % NumShards]; }
+
+  const size_t max_shard_entries_;
+  TimeSource& time_source_;
+  std::array<Shard, NumShards> shards_;
+};
+
+using SharedJwtCacheSharedPtr = std::shared_ptr<SharedJwtCache>;
+
 // Cache key is the JWT string, value is parsed JWT struct.
 
 class JwtCache;
@@ -35,9 +76,11 @@ public:
   virtual void insert(const std::string& token,
                       std::unique_ptr<::google::jwt_verify::Jwt>&& jwt) PURE;
 
-  // JwtCache factory function.
+  // JwtCache factory function. If shared_cache isn't nullptr, the tokens missing from the cache
+  // are looked up in it, and the inserted tokens are added to it.
   static JwtCachePtr create(bool enable_cache, const JwtCacheConfig& config,
-                            TimeSource& time_source);
+                            TimeSource& time_source,
+                            SharedJwtCacheSharedPtr shared_cache = nullptr);
 };
 
 } // namespace JwtAuthn
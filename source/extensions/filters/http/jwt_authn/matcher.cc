@@ -43,8 +43,8 @@ public:
 
     matches &= Http::HeaderUtility::matchHeaders(headers, config_headers_);
     if (!config_query_parameters_.empty()) {
-      Http::Utility::QueryParamsMulti query_parameters =
-          Http::Utility::QueryParamsMulti::parseQueryString(headers.getPathValue());
+      const Http::Utility::QueryParamsMulti& query_parameters =
+          Http::Utility::QueryParamsMulti::parseQueryStringCached(headers.getPathValue());
       matches &= ConfigUtility::matchQueryParams(query_parameters, config_query_parameters_);
     }
     return matches;
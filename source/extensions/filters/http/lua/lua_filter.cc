@@ -229,6 +229,18 @@ PerLuaCodeSetup::PerLuaCodeSetup(const std::string& lua_code, ThreadLocal::SlotA
   }
 }
 
+void PerLuaCodeSetup::configureRuntime(
+    const envoy::extensions::filters::http::lua::v3::Lua& proto_config) {
+  lua_state_.setMaxPooledCoroutines(proto_config.max_pooled_coroutines());
+  if (proto_config.has_garbage_collection()) {
+    const auto& gc = proto_config.garbage_collection();
+    lua_state_.setGCParameters(
+        gc.has_pause() ? absl::make_optional(gc.pause().value()) : absl::nullopt,
+        gc.has_step_multiplier() ? absl::make_optional(gc.step_multiplier().value())
+                                 : absl::nullopt);
+  }
+}
+
 StreamHandleWrapper::StreamHandleWrapper(Filters::Common::Lua::Coroutine& coroutine,
                                          Http::RequestOrResponseHeaderMap& headers, bool end_stream,
                                          Filter& filter, FilterCallbacks& callbacks,
@@ -820,7 +832,8 @@ FilterConfig::FilterConfig(const envoy::extensions::filters::http::lua::v3::Lua&
                            Upstream::ClusterManager& cluster_manager, Api::Api& api,
                            Stats::Scope& scope, const std::string& stats_prefix)
     : cluster_manager_(cluster_manager),
-      stats_(generateStats(stats_prefix, proto_config.stat_prefix(), scope)) {
+      stats_(generateStats(stats_prefix, proto_config.stat_prefix(), scope)),
+      gc_step_size_kb_(proto_config.garbage_collection().step_size_kb()) {
   if (proto_config.has_default_source_code()) {
     if (!proto_config.inline_code().empty()) {
       throw EnvoyException("Error: Only one of `inline_code` or `default_source_code` can be set "
@@ -843,6 +856,13 @@ FilterConfig::FilterConfig(const envoy::extensions::filters::http::lua::v3::Lua&
     }
     per_lua_code_setups_map_[source.first] = std::move(per_lua_code_setup_ptr);
   }
+
+  if (default_lua_code_setup_ != nullptr) {
+    default_lua_code_setup_->configureRuntime(proto_config);
+  }
+  for (auto& [name, setup] : per_lua_code_setups_map_) {
+    setup->configureRuntime(proto_config);
+  }
 }
 
 FilterConfigPerRoute::FilterConfigPerRoute(
@@ -867,6 +887,34 @@ void Filter::onDestroy() {
   if (response_stream_wrapper_.get()) {
     response_stream_wrapper_.get()->onReset();
   }
+
+  // The stream handles no longer resume the coroutines once reset.
+  releaseCoroutine(request_setup_, request_coroutine_);
+  releaseCoroutine(response_setup_, response_coroutine_);
+
+  // Collect the garbage of the request now rather than during the processing of the next ones.
+  if (config_->gcStepSizeKb() > 0) {
+    for (PerLuaCodeSetup* setup :
+         {request_setup_, response_setup_ != request_setup_ ? response_setup_ : nullptr}) {
+      if (setup == nullptr) {
+        continue;
+      }
+      const MonotonicTime start = time_source_.monotonicTime();
+      setup->runtimeGCStep(config_->gcStepSizeKb());
+      stats_.gc_step_time_us_.recordValue(
+          std::chrono::duration_cast<std::chrono::microseconds>(time_source_.monotonicTime() -
+                                                                start)
+              .count());
+    }
+  }
+}
+
+void Filter::releaseCoroutine(PerLuaCodeSetup* setup,
+                              Filters::Common::Lua::CoroutinePtr& coroutine) {
+  // The coroutines which can't be reused are left to be destroyed with the filter.
+  if (setup != nullptr && coroutine != nullptr && coroutine->reusable()) {
+    setup->releaseCoroutine(std::move(coroutine));
+  }
 }
 
 Http::FilterHeadersStatus
@@ -20,13 +20,15 @@ namespace Lua {
 /**
  * All lua stats. @see stats_macros.h
  */
-#define ALL_LUA_FILTER_STATS(COUNTER) COUNTER(errors)
+#define ALL_LUA_FILTER_STATS(COUNTER, HISTOGRAM)                                                   \
+  COUNTER(errors)                                                                                  \
+  HISTOGRAM(gc_step_time_us, Microseconds)
 
 /**
  * Struct definition for all Lua stats. @see stats_macros.h
  */
 struct LuaFilterStats {
-  ALL_LUA_FILTER_STATS(GENERATE_COUNTER_STRUCT)
+  ALL_LUA_FILTER_STATS(GENERATE_COUNTER_STRUCT, GENERATE_HISTOGRAM_STRUCT)
 };
 
 class PerLuaCodeSetup : Logger::Loggable<Logger::Id::lua> {
@@ -36,12 +38,17 @@ public:
   Extensions::Filters::Common::Lua::CoroutinePtr createCoroutine() {
     return lua_state_.createCoroutine();
   }
+  void releaseCoroutine(Extensions::Filters::Common::Lua::CoroutinePtr&& coroutine) {
+    lua_state_.releaseCoroutine(std::move(coroutine));
+  }
+  void configureRuntime(const envoy::extensions::filters::http::lua::v3::Lua& proto_config);
 
   int requestFunctionRef() { return lua_state_.getGlobalRef(request_function_slot_); }
   int responseFunctionRef() { return lua_state_.getGlobalRef(response_function_slot_); }
 
   uint64_t runtimeBytesUsed() { return lua_state_.runtimeBytesUsed(); }
   void runtimeGC() { return lua_state_.runtimeGC(); }
+  void runtimeGCStep(uint32_t size_kb) { lua_state_.runtimeGCStep(size_kb); }
 
 private:
   uint64_t request_function_slot_{};
@@ -410,6 +417,7 @@ public:
   }
 
   const LuaFilterStats& stats() const { return stats_; }
+  uint32_t gcStepSizeKb() const { return gc_step_size_kb_; }
 
   Upstream::ClusterManager& cluster_manager_;
 
@@ -417,12 +425,14 @@ private:
   LuaFilterStats generateStats(const std::string& prefix, const std::string& filter_stats_prefix,
                                Stats::Scope& scope) {
     const std::string final_prefix = absl::StrCat(prefix, "lua.", filter_stats_prefix);
-    return {ALL_LUA_FILTER_STATS(POOL_COUNTER_PREFIX(scope, final_prefix))};
+    return {ALL_LUA_FILTER_STATS(POOL_COUNTER_PREFIX(scope, final_prefix),
+                                 POOL_HISTOGRAM_PREFIX(scope, final_prefix))};
   }
 
   PerLuaCodeSetupPtr default_lua_code_setup_;
   absl::flat_hash_map<std::string, PerLuaCodeSetupPtr> per_lua_code_setups_map_;
   LuaFilterStats stats_;
+  const uint32_t gc_step_size_kb_;
 };
 
 using FilterConfigConstSharedPtr = std::shared_ptr<FilterConfig>;
@@ -514,6 +524,9 @@ public:
                                           bool end_stream) override {
     PerLuaCodeSetup* setup = getPerLuaCodeSetup(config_.get(), decoder_callbacks_.callbacks_);
     const int function_ref = setup ? setup->requestFunctionRef() : LUA_REFNIL;
+    if (function_ref != LUA_REFNIL) {
+      request_setup_ = setup;
+    }
     return doHeaders(request_stream_wrapper_, request_coroutine_, decoder_callbacks_, function_ref,
                      setup, headers, end_stream);
   }
@@ -535,6 +548,9 @@ public:
                                           bool end_stream) override {
     PerLuaCodeSetup* setup = getPerLuaCodeSetup(config_.get(), decoder_callbacks_.callbacks_);
     const int function_ref = setup ? setup->responseFunctionRef() : LUA_REFNIL;
+    if (function_ref != LUA_REFNIL) {
+      response_setup_ = setup;
+    }
     return doHeaders(response_stream_wrapper_, response_coroutine_, encoder_callbacks_,
                      function_ref, setup, headers, end_stream);
   }
@@ -609,6 +625,7 @@ private:
                                       Http::RequestOrResponseHeaderMap& headers, bool end_stream);
   Http::FilterDataStatus doData(StreamHandleRef& handle, Buffer::Instance& data, bool end_stream);
   Http::FilterTrailersStatus doTrailers(StreamHandleRef& handle, Http::HeaderMap& trailers);
+  void releaseCoroutine(PerLuaCodeSetup* setup, Filters::Common::Lua::CoroutinePtr& coroutine);
 
   FilterConfigConstSharedPtr config_;
   DecoderCallbacks decoder_callbacks_{*this};
@@ -633,6 +650,9 @@ private:
   // seems like a safer fix for now.
   Filters::Common::Lua::CoroutinePtr request_coroutine_;
   Filters::Common::Lua::CoroutinePtr response_coroutine_;
+  // The code setups the coroutines were created by, which they are returned to.
+  PerLuaCodeSetup* request_setup_{};
+  PerLuaCodeSetup* response_setup_{};
 };
 
 } // namespace Lua
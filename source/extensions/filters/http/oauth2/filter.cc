@@ -109,10 +109,10 @@ void setBearerToken(Http::RequestHeaderMap& headers, const std::string& token) {
   headers.setInline(authorization_handle.handle(), absl::StrCat("Bearer ", token));
 }
 
-std::string findValue(const absl::flat_hash_map<std::string, std::string>& map,
-                      const std::string& key) {
+// Moves the value of the key out of the map, or returns an empty string if it isn't in it.
+std::string takeValue(absl::flat_hash_map<std::string, std::string>& map, const std::string& key) {
   const auto value_it = map.find(key);
-  return value_it != map.end() ? value_it->second : EMPTY_STRING;
+  return value_it != map.end() ? std::move(value_it->second) : EMPTY_STRING;
 }
 
 AuthType
@@ -143,26 +143,22 @@ Http::Utility::QueryParamsMulti buildAutorizationQueryParams(
   return query_params;
 }
 
-std::string encodeHmacHexBase64(const std::vector<uint8_t>& secret, absl::string_view host,
-                                absl::string_view expires, absl::string_view token = "",
-                                absl::string_view id_token = "",
-                                absl::string_view refresh_token = "") {
+std::string hmacPayload(absl::string_view host, absl::string_view expires,
+                        absl::string_view token = "", absl::string_view id_token = "",
+                        absl::string_view refresh_token = "") {
+  return absl::StrJoin({host, expires, token, id_token, refresh_token}, HmacPayloadSeparator);
+}
+
+std::string encodeHmacHexBase64(const std::vector<uint8_t>& secret,
+                                absl::string_view hmac_payload) {
   auto& crypto_util = Envoy::Common::Crypto::UtilitySingleton::get();
-  const auto hmac_payload =
-      absl::StrJoin({host, expires, token, id_token, refresh_token}, HmacPayloadSeparator);
   std::string encoded_hmac;
   absl::Base64Escape(Hex::encode(crypto_util.getSha256Hmac(secret, hmac_payload)), &encoded_hmac);
   return encoded_hmac;
 }
 
-std::string encodeHmacBase64(const std::vector<uint8_t>& secret, absl::string_view host,
-                             absl::string_view expires, absl::string_view token = "",
-                             absl::string_view id_token = "",
-                             absl::string_view refresh_token = "") {
+std::string encodeHmacBase64(const std::vector<uint8_t>& secret, absl::string_view hmac_payload) {
   auto& crypto_util = Envoy::Common::Crypto::UtilitySingleton::get();
-  const auto hmac_payload =
-      absl::StrJoin({host, expires, token, id_token, refresh_token}, HmacPayloadSeparator);
-
   std::string base64_encoded_hmac;
   std::vector<uint8_t> hmac_result = crypto_util.getSha256Hmac(secret, hmac_payload);
   std::string hmac_string(hmac_result.begin(), hmac_result.end());
@@ -173,7 +169,7 @@ std::string encodeHmacBase64(const std::vector<uint8_t>& secret, absl::string_vi
 std::string encodeHmac(const std::vector<uint8_t>& secret, absl::string_view host,
                        absl::string_view expires, absl::string_view token = "",
                        absl::string_view id_token = "", absl::string_view refresh_token = "") {
-  return encodeHmacBase64(secret, host, expires, token, id_token, refresh_token);
+  return encodeHmacBase64(secret, hmacPayload(host, expires, token, id_token, refresh_token));
 }
 
 } // namespace
@@ -201,7 +197,8 @@ FilterConfig::FilterConfig(
       use_refresh_token_(proto_config.use_refresh_token().value()),
       default_expires_in_(PROTOBUF_GET_SECONDS_OR_DEFAULT(proto_config, default_expires_in, 0)),
       default_refresh_token_expires_in_(
-          PROTOBUF_GET_SECONDS_OR_DEFAULT(proto_config, default_refresh_token_expires_in, 604800)) {
+          PROTOBUF_GET_SECONDS_OR_DEFAULT(proto_config, default_refresh_token_expires_in, 604800)),
+      validated_cookies_(context.threadLocal()) {
   if (!context.clusterManager().clusters().hasCluster(oauth_token_endpoint_.cluster())) {
     throw EnvoyException(fmt::format("OAuth2 filter: unknown cluster '{}' in config. Please "
                                      "specify which cluster to direct OAuth requests to.",
@@ -215,23 +212,61 @@ FilterConfig::FilterConfig(
   }
 }
 
+ValidatedCookieCache::ValidatedCookieCache(ThreadLocal::SlotAllocator& tls) : tls_(tls) {
+  tls_.set([](Event::Dispatcher&) { return std::make_shared<ThreadLocalCache>(); });
+}
+
+bool ValidatedCookieCache::contains(const std::vector<uint8_t>& secret, absl::string_view hmac,
+                                    absl::string_view payload, SystemTime now) {
+  ThreadLocalCache& cache = *tls_;
+  if (cache.secret_ != secret) {
+    return false;
+  }
+  const auto it = cache.entries_.find(hmac);
+  if (it == cache.entries_.end()) {
+    return false;
+  }
+  if (it->second.expiry_ <= now) {
+    cache.entries_.erase(it);
+    return false;
+  }
+  return it->second.payload_ == payload;
+}
+
+void ValidatedCookieCache::insert(const std::vector<uint8_t>& secret, absl::string_view hmac,
+                                  std::string&& payload, SystemTime expiry, SystemTime now) {
+  ThreadLocalCache& cache = *tls_;
+  if (cache.secret_ != secret) {
+    cache.entries_.clear();
+    cache.secret_ = secret;
+  }
+  if (cache.entries_.size() >= MaxEntries) {
+    absl::erase_if(cache.entries_,
+                   [now](const auto& entry) { return entry.second.expiry_ <= now; });
+    while (cache.entries_.size() >= MaxEntries) {
+      cache.entries_.erase(cache.entries_.begin());
+    }
+  }
+  cache.entries_.insert_or_assign(std::string(hmac), Entry{std::move(payload), expiry});
+}
+
 FilterStats FilterConfig::generateStats(const std::string& prefix, Stats::Scope& scope) {
   return {ALL_OAUTH_FILTER_STATS(POOL_COUNTER_PREFIX(scope, prefix))};
 }
 
 void OAuth2CookieValidator::setParams(const Http::RequestHeaderMap& headers,
                                       const std::string& secret) {
-  const auto& cookies = Http::Utility::parseCookies(headers, [this](absl::string_view key) -> bool {
+  auto cookies = Http::Utility::parseCookies(headers, [this](absl::string_view key) -> bool {
     return key == cookie_names_.oauth_expires_ || key == cookie_names_.bearer_token_ ||
            key == cookie_names_.oauth_hmac_ || key == cookie_names_.id_token_ ||
            key == cookie_names_.refresh_token_;
   });
 
-  expires_ = findValue(cookies, cookie_names_.oauth_expires_);
-  token_ = findValue(cookies, cookie_names_.bearer_token_);
-  id_token_ = findValue(cookies, cookie_names_.id_token_);
-  refresh_token_ = findValue(cookies, cookie_names_.refresh_token_);
-  hmac_ = findValue(cookies, cookie_names_.oauth_hmac_);
+  expires_ = takeValue(cookies, cookie_names_.oauth_expires_);
+  token_ = takeValue(cookies, cookie_names_.bearer_token_);
+  id_token_ = takeValue(cookies, cookie_names_.id_token_);
+  refresh_token_ = takeValue(cookies, cookie_names_.refresh_token_);
+  hmac_ = takeValue(cookies, cookie_names_.oauth_hmac_);
   host_ = headers.Host()->value().getStringView();
 
   secret_.assign(secret.begin(), secret.end());
@@ -240,9 +275,22 @@ void OAuth2CookieValidator::setParams(const Http::RequestHeaderMap& headers,
 bool OAuth2CookieValidator::canUpdateTokenByRefreshToken() const { return !refresh_token_.empty(); }
 
 bool OAuth2CookieValidator::hmacIsValid() const {
-  return (
-      (encodeHmacBase64(secret_, host_, expires_, token_, id_token_, refresh_token_) == hmac_) ||
-      (encodeHmacHexBase64(secret_, host_, expires_, token_, id_token_, refresh_token_) == hmac_));
+  std::string payload = hmacPayload(host_, expires_, token_, id_token_, refresh_token_);
+  const SystemTime now = time_source_.systemTime();
+  if (validated_cookies_ != nullptr && validated_cookies_->contains(secret_, hmac_, payload, now)) {
+    return true;
+  }
+  if (encodeHmacBase64(secret_, payload) != hmac_ &&
+      encodeHmacHexBase64(secret_, payload) != hmac_) {
+    return false;
+  }
+  uint64_t expires;
+  if (validated_cookies_ != nullptr && absl::SimpleAtoi(expires_, &expires) &&
+      SystemTime(std::chrono::seconds(expires)) > now) {
+    validated_cookies_->insert(secret_, hmac_, std::move(payload),
+                               SystemTime(std::chrono::seconds(expires)), now);
+  }
+  return true;
 }
 
 bool OAuth2CookieValidator::timestampIsValid() const {
@@ -259,7 +307,8 @@ bool OAuth2CookieValidator::isValid() const { return hmacIsValid() && timestampI
 
 OAuth2Filter::OAuth2Filter(FilterConfigSharedPtr config,
                            std::unique_ptr<OAuth2Client>&& oauth_client, TimeSource& time_source)
-    : validator_(std::make_shared<OAuth2CookieValidator>(time_source, config->cookieNames())),
+    : validator_(std::make_shared<OAuth2CookieValidator>(time_source, config->cookieNames(),
+                                                         &config->validatedCookies())),
       oauth_client_(std::move(oauth_client)), config_(std::move(config)),
       time_source_(time_source) {
 
@@ -6,12 +6,14 @@
 
 #include "envoy/common/callback.h"
 #include "envoy/common/matchers.h"
+#include "envoy/common/time.h"
 #include "envoy/config/core/v3/http_uri.pb.h"
 #include "envoy/extensions/filters/http/oauth2/v3/oauth.pb.h"
 #include "envoy/http/header_map.h"
 #include "envoy/server/filter_config.h"
 #include "envoy/stats/stats_macros.h"
 #include "envoy/stream_info/stream_info.h"
+#include "envoy/thread_local/thread_local.h"
 #include "envoy/upstream/cluster_manager.h"
 
 #include "source/common/common/assert.h"
@@ -25,6 +27,7 @@
 #include "source/extensions/filters/http/oauth2/oauth.h"
 #include "source/extensions/filters/http/oauth2/oauth_client.h"
 
+#include "absl/container/flat_hash_map.h"
 #include "absl/strings/str_split.h"
 #include "absl/strings/string_view.h"
 
@@ -110,6 +113,44 @@ struct CookieNames {
  * This class encapsulates all data needed for the filter to operate so that we don't pass around
  * raw protobufs and other arbitrary data.
  */
+/**
+ * The session cookies validated recently on each worker, so that the HMAC of the cookies isn't
+ * computed again for each request of a session. An entry is keyed by the HMAC cookie and holds the
+ * payload of the other cookies it was computed from, until the cookies expire.
+ */
+class ValidatedCookieCache {
+public:
+  static constexpr size_t MaxEntries = 256;
+
+  explicit ValidatedCookieCache(ThreadLocal::SlotAllocator& tls);
+
+  /**
+   * @return whether the HMAC was validated with the secret for the payload, and isn't expired.
+   */
+  bool contains(const std::vector<uint8_t>& secret, absl::string_view hmac,
+                absl::string_view payload, SystemTime now);
+
+  /**
+   * Caches the HMAC validated with the secret for the payload, until the expiry of the cookies.
+   */
+  void insert(const std::vector<uint8_t>& secret, absl::string_view hmac, std::string&& payload,
+              SystemTime expiry, SystemTime now);
+
+private:
+  struct Entry {
+    std::string payload_;
+    SystemTime expiry_;
+  };
+
+  struct ThreadLocalCache : public ThreadLocal::ThreadLocalObject {
+    // The secret of the entries, which are all dropped when it changes.
+    std::vector<uint8_t> secret_;
+    absl::flat_hash_map<std::string, Entry> entries_;
+  };
+
+  ThreadLocal::TypedSlot<ThreadLocalCache> tls_;
+};
+
 class FilterConfig {
 public:
   FilterConfig(const envoy::extensions::filters::http::oauth2::v3::OAuth2Config& proto_config,
@@ -147,6 +188,7 @@ public:
   std::chrono::seconds defaultRefreshTokenExpiresIn() const {
     return default_refresh_token_expires_in_;
   }
+  ValidatedCookieCache& validatedCookies() { return validated_cookies_; }
 
 private:
   static FilterStats generateStats(const std::string& prefix, Stats::Scope& scope);
@@ -173,6 +215,7 @@ private:
   const bool use_refresh_token_{};
   const std::chrono::seconds default_expires_in_;
   const std::chrono::seconds default_refresh_token_expires_in_;
+  ValidatedCookieCache validated_cookies_;
 };
 
 using FilterConfigSharedPtr = std::shared_ptr<FilterConfig>;
@@ -200,8 +243,10 @@ public:
 
 class OAuth2CookieValidator : public CookieValidator {
 public:
-  explicit OAuth2CookieValidator(TimeSource& time_source, const CookieNames& cookie_names)
-      : time_source_(time_source), cookie_names_(cookie_names) {}
+  explicit OAuth2CookieValidator(TimeSource& time_source, const CookieNames& cookie_names,
+                                 ValidatedCookieCache* validated_cookies = nullptr)
+      : time_source_(time_source), cookie_names_(cookie_names),
+        validated_cookies_(validated_cookies) {}
 
   const std::string& token() const override { return token_; }
   const std::string& refreshToken() const override { return refresh_token_; }
@@ -222,6 +267,7 @@ private:
   absl::string_view host_;
   TimeSource& time_source_;
   const CookieNames cookie_names_;
+  ValidatedCookieCache* const validated_cookies_;
 };
 
 /**
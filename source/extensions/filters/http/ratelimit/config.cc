@@ -32,11 +32,17 @@ Http::FilterFactoryCb RateLimitFilterConfig::createFilterFactoryFromProtoTyped(
   THROW_IF_NOT_OK(Config::Utility::checkTransportVersion(proto_config.rate_limit_service()));
   Grpc::GrpcServiceConfigWithHashKey config_with_hash_key =
       Grpc::GrpcServiceConfigWithHashKey(proto_config.rate_limit_service().grpc_service());
-  return [config_with_hash_key, &context, timeout,
-          filter_config](Http::FilterChainFactoryCallbacks& callbacks) -> void {
+  QuotaCacheSharedPtr quota_cache;
+  if (proto_config.has_quota_cache()) {
+    quota_cache = std::make_shared<QuotaCache>(
+        proto_config.quota_cache(), server_context.threadLocal(), server_context.timeSource());
+  }
+  return [config_with_hash_key, &context, timeout, filter_config,
+          quota_cache](Http::FilterChainFactoryCallbacks& callbacks) -> void {
     callbacks.addStreamFilter(std::make_shared<Filter>(
         filter_config,
-        Filters::Common::RateLimit::rateLimitClient(context, config_with_hash_key, timeout)));
+        Filters::Common::RateLimit::rateLimitClient(context, config_with_hash_key, timeout),
+        quota_cache));
   };
 }
 
@@ -0,0 +1,105 @@
+#include "source/extensions/filters/http/ratelimit/quota_cache.h"
+
+#include "source/common/protobuf/utility.h"
+
+#include "absl/strings/str_cat.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace RateLimitFilter {
+namespace {
+
+constexpr uint32_t DefaultRenewalThresholdPercent = 20;
+constexpr uint32_t DefaultMaxEntries = 1000;
+
+// Appends a part of the key, prefixed by its length so that the parts can't run into each other.
+void appendKeyPart(std::string& key, absl::string_view part) {
+  absl::StrAppend(&key, part.size(), ":", part, ";");
+}
+
+} // namespace
+
+QuotaCache::QuotaCache(
+    const envoy::extensions::filters::http::ratelimit::v3::RateLimit::QuotaCache& config,
+    ThreadLocal::SlotAllocator& tls, TimeSource& time_source)
+    : renewal_threshold_percent_(PROTOBUF_GET_WRAPPED_OR_DEFAULT(
+          config, renewal_threshold_percent, DefaultRenewalThresholdPercent)),
+      max_entries_(PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, max_entries, DefaultMaxEntries)),
+      time_source_(time_source), tls_(tls) {
+  tls_.set([](Event::Dispatcher&) { return std::make_shared<ThreadLocalCache>(); });
+}
+
+std::string QuotaCache::key(absl::string_view domain,
+                            const std::vector<Envoy::RateLimit::Descriptor>& descriptors) {
+  std::string key;
+  appendKeyPart(key, domain);
+  for (const Envoy::RateLimit::Descriptor& descriptor : descriptors) {
+    absl::StrAppend(&key, descriptor.entries_.size(), "|");
+    for (const Envoy::RateLimit::DescriptorEntry& entry : descriptor.entries_) {
+      appendKeyPart(key, entry.key_);
+      appendKeyPart(key, entry.value_);
+    }
+  }
+  return key;
+}
+
+QuotaCache::Result QuotaCache::consume(const std::string& key, bool& renew) {
+  renew = false;
+  EntryMap& entries = tls_->entries_;
+  auto it = entries.find(key);
+  if (it == entries.end()) {
+    return Result::Miss;
+  }
+  Entry& entry = it->second;
+  if (entry.expiry_.has_value() && entry.expiry_.value() <= time_source_.systemTime()) {
+    entries.erase(it);
+    return Result::Miss;
+  }
+  if (entry.remaining_ == 0) {
+    return entry.renewing_ ? Result::OverLimit : Result::Miss;
+  }
+  entry.remaining_--;
+  if (entry.remaining_ <= entry.renewal_threshold_ && !entry.renewing_) {
+    entry.renewing_ = true;
+    renew = true;
+  }
+  return Result::Allowed;
+}
+
+void QuotaCache::insert(const std::string& key,
+                        const envoy::service::ratelimit::v3::RateLimitResponse::Quota& quota,
+                        bool renewal) {
+  EntryMap& entries = tls_->entries_;
+  if (entries.size() >= max_entries_ && !entries.contains(key)) {
+    // Makes room for the new entry, first by evicting the expired entries, then an arbitrary one.
+    const SystemTime now = time_source_.systemTime();
+    absl::erase_if(entries, [now](const auto& entry) {
+      return entry.second.expiry_.has_value() && entry.second.expiry_.value() <= now;
+    });
+    if (entries.size() >= max_entries_) {
+      entries.erase(entries.begin());
+    }
+  }
+  Entry entry;
+  entry.remaining_ = renewal || quota.requests() == 0 ? quota.requests() : quota.requests() - 1;
+  entry.renewal_threshold_ =
+      static_cast<uint64_t>(quota.requests()) * renewal_threshold_percent_ / 100;
+  if (quota.has_valid_until()) {
+    entry.expiry_ = SystemTime{std::chrono::milliseconds(
+        Protobuf::util::TimeUtil::TimestampToMilliseconds(quota.valid_until()))};
+  }
+  entries.insert_or_assign(key, entry);
+}
+
+void QuotaCache::renewed(const std::string& key) {
+  EntryMap& entries = tls_->entries_;
+  if (auto it = entries.find(key); it != entries.end()) {
+    it->second.renewing_ = false;
+  }
+}
+
+} // namespace RateLimitFilter
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
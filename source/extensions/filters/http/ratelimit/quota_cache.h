@@ -0,0 +1,90 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "envoy/common/time.h"
+#include "envoy/extensions/filters/http/ratelimit/v3/rate_limit.pb.h"
+#include "envoy/ratelimit/ratelimit.h"
+#include "envoy/service/ratelimit/v3/rls.pb.h"
+#include "envoy/thread_local/thread_local.h"
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/types/optional.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace RateLimitFilter {
+
+/**
+ * A cache of the quotas the rate limit service grants for the descriptor sets, keyed by the domain
+ * and the descriptors. Each worker has its own cache, which it serves its requests out of.
+ */
+class QuotaCache {
+public:
+  QuotaCache(const envoy::extensions::filters::http::ratelimit::v3::RateLimit::QuotaCache& config,
+             ThreadLocal::SlotAllocator& tls, TimeSource& time_source);
+
+  enum class Result {
+    // The request consumed a unit of the cached quota.
+    Allowed,
+    // The cached quota is exhausted but not expired, and being renewed, so the request is over
+    // limit.
+    OverLimit,
+    // There is no cached quota, it expired, or it is exhausted and not being renewed, so the rate
+    // limit service must be called.
+    Miss,
+  };
+
+  /**
+   * @return the cache key of the descriptors of a domain.
+   */
+  static std::string key(absl::string_view domain,
+                         const std::vector<Envoy::RateLimit::Descriptor>& descriptors);
+
+  /**
+   * Consumes a unit of the cached quota of the key, if any. Sets renew if the request should renew
+   * the quota in the background, which it is then the only one to do until renewed() is called.
+   */
+  Result consume(const std::string& key, bool& renew);
+
+  /**
+   * Caches the quota granted for the key, of which the request the service was called for
+   * consumes a unit unless it was a renewal.
+   */
+  void insert(const std::string& key,
+              const envoy::service::ratelimit::v3::RateLimitResponse::Quota& quota, bool renewal);
+
+  /**
+   * Called when the renewal of the quota of the key completed, whether it succeeded or not.
+   */
+  void renewed(const std::string& key);
+
+private:
+  struct Entry {
+    uint32_t remaining_;
+    // The remaining units at which the quota is renewed.
+    uint32_t renewal_threshold_;
+    absl::optional<SystemTime> expiry_;
+    bool renewing_{};
+  };
+  using EntryMap = absl::flat_hash_map<std::string, Entry>;
+
+  struct ThreadLocalCache : public ThreadLocal::ThreadLocalObject {
+    EntryMap entries_;
+  };
+
+  const uint32_t renewal_threshold_percent_;
+  const size_t max_entries_;
+  TimeSource& time_source_;
+  ThreadLocal::TypedSlot<ThreadLocalCache> tls_;
+};
+
+using QuotaCacheSharedPtr = std::shared_ptr<QuotaCache>;
+
+} // namespace RateLimitFilter
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
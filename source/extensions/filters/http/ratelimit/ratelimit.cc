@@ -6,6 +6,7 @@
 #include "envoy/http/codes.h"
 
 #include "source/common/common/assert.h"
+#include "source/common/common/empty_string.h"
 #include "source/common/common/enum_to_int.h"
 #include "source/common/common/fmt.h"
 #include "source/common/http/codes.h"
@@ -67,14 +68,39 @@ void Filter::initiateCall(const Http::RequestHeaderMap& headers) {
   }
 
   if (!descriptors.empty()) {
+    const std::string domain = getDomain();
+    if (quota_cache_ != nullptr && serveFromQuotaCache(domain, descriptors)) {
+      return;
+    }
     state_ = State::Calling;
     initiating_call_ = true;
-    client_->limit(*this, getDomain(), descriptors, callbacks_->activeSpan(),
-                   callbacks_->streamInfo(), 0);
+    client_->limit(*this, domain, descriptors, callbacks_->activeSpan(), callbacks_->streamInfo(),
+                   0);
     initiating_call_ = false;
   }
 }
 
+bool Filter::serveFromQuotaCache(const std::string& domain,
+                                 const std::vector<Envoy::RateLimit::Descriptor>& descriptors) {
+  quota_key_ = QuotaCache::key(domain, descriptors);
+  bool renew;
+  const QuotaCache::Result result = quota_cache_->consume(quota_key_, renew);
+  if (result == QuotaCache::Result::Miss) {
+    return false;
+  }
+  using Filters::Common::RateLimit::LimitStatus;
+  initiating_call_ = true;
+  complete(result == QuotaCache::Result::Allowed ? LimitStatus::OK : LimitStatus::OverLimit, nullptr,
+           nullptr, nullptr, EMPTY_STRING, nullptr);
+  initiating_call_ = false;
+  if (renew) {
+    renewing_ = true;
+    client_->limit(*this, domain, descriptors, callbacks_->activeSpan(), callbacks_->streamInfo(),
+                   0);
+  }
+  return true;
+}
+
 Http::FilterHeadersStatus Filter::decodeHeaders(Http::RequestHeaderMap& headers, bool) {
   if (!config_->runtime().snapshot().featureEnabled("ratelimit.http_filter_enabled", 100)) {
     return Http::FilterHeadersStatus::Continue;
@@ -133,6 +159,16 @@ void Filter::onDestroy() {
   if (state_ == State::Calling) {
     state_ = State::Complete;
     client_->cancel();
+  } else if (renewing_) {
+    renewing_ = false;
+    client_->cancel();
+    quota_cache_->renewed(quota_key_);
+  }
+}
+
+void Filter::onQuota(const envoy::service::ratelimit::v3::RateLimitResponse::Quota& quota) {
+  if (quota_cache_ != nullptr) {
+    quota_cache_->insert(quota_key_, quota, renewing_);
   }
 }
 
@@ -142,6 +178,12 @@ void Filter::complete(Filters::Common::RateLimit::LimitStatus status,
                       Http::RequestHeaderMapPtr&& request_headers_to_add,
                       const std::string& response_body,
                       Filters::Common::RateLimit::DynamicMetadataPtr&& dynamic_metadata) {
+  if (renewing_) {
+    // The request was already decided on, only the cached quota is renewed.
+    renewing_ = false;
+    quota_cache_->renewed(quota_key_);
+    return;
+  }
   state_ = State::Complete;
   response_headers_to_add_ = std::move(response_headers_to_add);
   Http::HeaderMapPtr req_headers_to_add = std::move(request_headers_to_add);
@@ -19,6 +19,7 @@
 #include "source/common/router/header_parser.h"
 #include "source/extensions/filters/common/ratelimit/ratelimit.h"
 #include "source/extensions/filters/common/ratelimit/stat_names.h"
+#include "source/extensions/filters/http/ratelimit/quota_cache.h"
 
 namespace Envoy {
 namespace Extensions {
@@ -153,8 +154,9 @@ private:
  */
 class Filter : public Http::StreamFilter, public Filters::Common::RateLimit::RequestCallbacks {
 public:
-  Filter(FilterConfigSharedPtr config, Filters::Common::RateLimit::ClientPtr&& client)
-      : config_(config), client_(std::move(client)) {}
+  Filter(FilterConfigSharedPtr config, Filters::Common::RateLimit::ClientPtr&& client,
+         QuotaCacheSharedPtr quota_cache = nullptr)
+      : config_(config), client_(std::move(client)), quota_cache_(std::move(quota_cache)) {}
 
   // Http::StreamFilterBase
   void onDestroy() override;
@@ -182,9 +184,14 @@ public:
                 Http::RequestHeaderMapPtr&& request_headers_to_add,
                 const std::string& response_body,
                 Filters::Common::RateLimit::DynamicMetadataPtr&& dynamic_metadata) override;
+  void onQuota(const envoy::service::ratelimit::v3::RateLimitResponse::Quota& quota) override;
 
 private:
   void initiateCall(const Http::RequestHeaderMap& headers);
+  // Decides on the request out of the cached quota of its descriptors, renewing it in the
+  // background if it runs low. Returns false if the rate limit service must be called instead.
+  bool serveFromQuotaCache(const std::string& domain,
+                           const std::vector<Envoy::RateLimit::Descriptor>& descriptors);
   void populateRateLimitDescriptors(const Router::RateLimitPolicy& rate_limit_policy,
                                     std::vector<Envoy::RateLimit::Descriptor>& descriptors,
                                     const Http::RequestHeaderMap& headers) const;
@@ -199,6 +206,10 @@ private:
 
   FilterConfigSharedPtr config_;
   Filters::Common::RateLimit::ClientPtr client_;
+  const QuotaCacheSharedPtr quota_cache_;
+  std::string quota_key_;
+  // Whether the call in flight renews the cached quota rather than decides on the request.
+  bool renewing_{};
   Http::StreamDecoderFilterCallbacks* callbacks_{};
   State state_{State::NotStarted};
   VhRateLimitOptions vh_rate_limits_;
@@ -131,6 +131,10 @@ RoleBasedAccessControlFilter::decodeHeaders(Http::RequestHeaderMap& headers, boo
           : "none",
       headers, callbacks_->streamInfo().dynamicMetadata().DebugString());
 
+  // The policies only match the headers, so the body of the request, e.g. the data of a long-lived
+  // tunnel, doesn't need to go through the filter.
+  callbacks_->disableDataCallbacks();
+
   std::string effective_policy_id;
   const auto shadow_engine =
       config_->engine(callbacks_, Filters::Common::RBAC::EnforcementMode::Shadow);
@@ -118,14 +118,19 @@ Config::Config(
                          : false) {
   for (const auto& rule : proto_config.rules()) {
     tlv_types_[0xFF & rule.tlv_type()] = rule.on_tlv_present();
+    used_tlv_types_.set(0xFF & rule.tlv_type());
   }
 
   if (proto_config.has_pass_through_tlvs() &&
       proto_config.pass_through_tlvs().match_type() == ProxyProtocolPassThroughTLVs::INCLUDE) {
     for (const auto& tlv_type : proto_config.pass_through_tlvs().tlv_type()) {
       pass_through_tlvs_.insert(0xFF & tlv_type);
+      used_tlv_types_.set(0xFF & tlv_type);
     }
   }
+  if (pass_all_tlvs_) {
+    used_tlv_types_.set();
+  }
 
   for (const auto& version : proto_config.disallowed_versions()) {
     switch (version) {
@@ -228,11 +233,14 @@ ReadOrParseState Filter::parseBuffer(Network::ListenerFilterBuffer& buffer) {
   }
 
   // After parse the header, the extensions size is discovered. Then extend the buffer
-  // size to receive the extensions.
+  // size to receive the extensions, unless they were already peeked with the header, as the
+  // buffer may be larger than requested by this filter.
   if (proxy_protocol_header_.value().wholeHeaderLength() > max_proxy_protocol_len_) {
     max_proxy_protocol_len_ = proxy_protocol_header_.value().wholeHeaderLength();
-    // The expected header size is changed, waiting for more data.
-    return ReadOrParseState::TryAgainLater;
+    if (buffer.rawSlice().len_ < max_proxy_protocol_len_) {
+      // The expected header size is changed, waiting for more data.
+      return ReadOrParseState::TryAgainLater;
+    }
   }
 
   if (proxy_protocol_header_.has_value()) {
@@ -255,7 +263,7 @@ ReadOrParseState Filter::parseBuffer(Network::ListenerFilterBuffer& buffer) {
           Network::ProxyProtocolFilterState::key(),
           std::make_unique<Network::ProxyProtocolFilterState>(Network::ProxyProtocolData{
               socket.connectionInfoProvider().remoteAddress(),
-              socket.connectionInfoProvider().localAddress(), parsed_tlvs_}),
+              socket.connectionInfoProvider().localAddress(), std::move(parsed_tlvs_)}),
           StreamInfo::FilterState::StateType::Mutable,
           StreamInfo::FilterState::LifeSpan::Connection);
     } else {
@@ -272,7 +280,7 @@ ReadOrParseState Filter::parseBuffer(Network::ListenerFilterBuffer& buffer) {
           Network::ProxyProtocolFilterState::key(),
           std::make_unique<Network::ProxyProtocolFilterState>(Network::ProxyProtocolData{
               proxy_protocol_header_.value().remote_address_,
-              proxy_protocol_header_.value().local_address_, parsed_tlvs_}),
+              proxy_protocol_header_.value().local_address_, std::move(parsed_tlvs_)}),
           StreamInfo::FilterState::StateType::Mutable,
           StreamInfo::FilterState::LifeSpan::Connection);
     }
@@ -536,6 +544,12 @@ bool Filter::parseTlvs(const uint8_t* buf, size_t len) {
       return false;
     }
 
+    if (!config_->isTlvTypeUsed(tlv_type)) {
+      ENVOY_LOG(trace, "proxy_protocol: Skip TLV of type {} since it's not needed", tlv_type);
+      idx += tlv_value_length;
+      continue;
+    }
+
     // Only save to dynamic metadata if this type of TLV is needed.
     absl::string_view tlv_value(reinterpret_cast<char const*>(buf + idx), tlv_value_length);
     auto key_value_pair = config_->isTlvTypeNeeded(tlv_type);
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <bitset>
+
 #include "envoy/event/file_event.h"
 #include "envoy/extensions/filters/listener/proxy_protocol/v3/proxy_protocol.pb.h"
 #include "envoy/network/filter.h"
@@ -126,6 +128,12 @@ public:
    */
   bool isPassThroughTlvTypeNeeded(uint8_t type) const;
 
+  /**
+   * Return true if the type of TLV is needed for dynamic metadata or for pass-through. The other
+   * TLVs are skipped without being looked up.
+   */
+  bool isTlvTypeUsed(uint8_t type) const { return used_tlv_types_[type]; }
+
   /**
    * Filter configuration that determines if we should pass-through requests without
    * proxy protocol. Should only be configured to true for trusted downstreams.
@@ -143,6 +151,7 @@ private:
   const bool allow_requests_without_proxy_protocol_;
   const bool pass_all_tlvs_;
   absl::flat_hash_set<uint8_t> pass_through_tlvs_{};
+  std::bitset<256> used_tlv_types_;
   bool allow_v1_{true};
   bool allow_v2_{true};
 };
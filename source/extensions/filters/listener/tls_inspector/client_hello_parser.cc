@@ -0,0 +1,195 @@
+#include "source/extensions/filters/listener/tls_inspector/client_hello_parser.h"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+
+#include "openssl/bytestring.h"
+#include "openssl/tls1.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace ListenerFilters {
+namespace TlsInspector {
+namespace {
+
+// The ClientHellos with more extensions are left to BoringSSL, which bounds the duplicate check.
+constexpr size_t MaxExtensions = 64;
+
+// Returns the highest version in the range offered by the client, or 0 if there is none, like
+// BoringSSL's version negotiation.
+uint16_t negotiateVersion(const SSL_CLIENT_HELLO& client_hello, uint16_t min_version,
+                          uint16_t max_version) {
+  const uint8_t* data;
+  size_t len;
+  if (!SSL_early_callback_ctx_extension_get(&client_hello, TLSEXT_TYPE_supported_versions, &data,
+                                            &len)) {
+    // Without the extension, the client supports the versions from TLS 1.0 up to the one of the
+    // ClientHello, or TLS 1.2 at most.
+    if (client_hello.version < TLS1_VERSION) {
+      return 0;
+    }
+    const uint16_t version =
+        std::min<uint16_t>(std::min<uint16_t>(client_hello.version, TLS1_2_VERSION), max_version);
+    return version >= min_version ? version : 0;
+  }
+  if (client_hello.version < TLS1_2_VERSION) {
+    return 0;
+  }
+  CBS extension;
+  CBS versions;
+  CBS_init(&extension, data, len);
+  if (!CBS_get_u8_length_prefixed(&extension, &versions) || CBS_len(&extension) != 0 ||
+      CBS_len(&versions) == 0 || CBS_len(&versions) % 2 != 0) {
+    return 0;
+  }
+  uint16_t negotiated = 0;
+  while (CBS_len(&versions) > 0) {
+    uint16_t version;
+    CBS_get_u16(&versions, &version);
+    if (version >= min_version && version <= max_version && version > negotiated) {
+      negotiated = version;
+    }
+  }
+  return negotiated;
+}
+
+// Returns false if the server name extension is malformed, like BoringSSL which only reads the
+// first name of the list.
+bool parseServerName(const SSL_CLIENT_HELLO& client_hello, absl::string_view& server_name) {
+  const uint8_t* data;
+  size_t len;
+  if (!SSL_early_callback_ctx_extension_get(&client_hello, TLSEXT_TYPE_server_name, &data, &len)) {
+    return true;
+  }
+  CBS extension;
+  CBS names;
+  CBS host_name;
+  uint8_t name_type;
+  CBS_init(&extension, data, len);
+  if (!CBS_get_u16_length_prefixed(&extension, &names) || CBS_len(&extension) != 0 ||
+      !CBS_get_u8(&names, &name_type) || !CBS_get_u16_length_prefixed(&names, &host_name) ||
+      name_type != TLSEXT_NAMETYPE_host_name || CBS_len(&host_name) == 0 ||
+      CBS_len(&host_name) > TLSEXT_MAXLEN_host_name || CBS_contains_zero_byte(&host_name)) {
+    return false;
+  }
+  server_name =
+      absl::string_view(reinterpret_cast<const char*>(CBS_data(&host_name)), CBS_len(&host_name));
+  return true;
+}
+
+// Returns false if the extensions are malformed or if an extension is repeated.
+bool checkExtensions(const SSL_CLIENT_HELLO& client_hello) {
+  CBS extensions;
+  CBS_init(&extensions, client_hello.extensions, client_hello.extensions_len);
+  std::array<uint16_t, MaxExtensions> types;
+  size_t count = 0;
+  while (CBS_len(&extensions) > 0) {
+    uint16_t type;
+    CBS extension;
+    if (count == MaxExtensions || !CBS_get_u16(&extensions, &type) ||
+        !CBS_get_u16_length_prefixed(&extensions, &extension)) {
+      return false;
+    }
+    for (size_t i = 0; i < count; ++i) {
+      if (types[i] == type) {
+        return false;
+      }
+    }
+    types[count++] = type;
+  }
+  return true;
+}
+
+} // namespace
+
+ClientHelloParseResult parseClientHello(absl::Span<const uint8_t> data, uint16_t min_version,
+                                        uint16_t max_version, ParsedClientHello& parsed) {
+  if (!data.empty() && data[0] != SSL3_RT_HANDSHAKE) {
+    return ClientHelloParseResult::Unsupported;
+  }
+  CBS input;
+  CBS_init(&input, data.data(), data.size());
+  uint8_t content_type;
+  uint16_t record_version;
+  uint16_t record_len;
+  if (!CBS_get_u8(&input, &content_type) || !CBS_get_u16(&input, &record_version) ||
+      !CBS_get_u16(&input, &record_len)) {
+    return ClientHelloParseResult::NeedMoreData;
+  }
+  if ((record_version >> 8) != SSL3_VERSION_MAJOR || record_len > SSL3_RT_MAX_PLAIN_LENGTH) {
+    return ClientHelloParseResult::Unsupported;
+  }
+  CBS record;
+  if (!CBS_get_bytes(&input, &record, record_len)) {
+    return ClientHelloParseResult::NeedMoreData;
+  }
+
+  // The record must hold the whole ClientHello, and nothing else.
+  uint8_t message_type;
+  CBS body;
+  if (!CBS_get_u8(&record, &message_type) || message_type != SSL3_MT_CLIENT_HELLO ||
+      !CBS_get_u24_length_prefixed(&record, &body) || CBS_len(&record) != 0) {
+    return ClientHelloParseResult::Unsupported;
+  }
+
+  SSL_CLIENT_HELLO& client_hello = parsed.client_hello;
+  client_hello = SSL_CLIENT_HELLO{};
+  client_hello.client_hello = CBS_data(&body);
+  client_hello.client_hello_len = CBS_len(&body);
+  CBS random;
+  CBS session_id;
+  CBS cipher_suites;
+  CBS compression_methods;
+  if (!CBS_get_u16(&body, &client_hello.version) ||
+      !CBS_get_bytes(&body, &random, SSL3_RANDOM_SIZE) ||
+      !CBS_get_u8_length_prefixed(&body, &session_id) ||
+      CBS_len(&session_id) > SSL_MAX_SSL_SESSION_ID_LENGTH ||
+      !CBS_get_u16_length_prefixed(&body, &cipher_suites) || CBS_len(&cipher_suites) < 2 ||
+      CBS_len(&cipher_suites) % 2 != 0 ||
+      !CBS_get_u8_length_prefixed(&body, &compression_methods) ||
+      CBS_len(&compression_methods) < 1) {
+    return ClientHelloParseResult::Unsupported;
+  }
+  client_hello.random = CBS_data(&random);
+  client_hello.random_len = CBS_len(&random);
+  client_hello.session_id = CBS_data(&session_id);
+  client_hello.session_id_len = CBS_len(&session_id);
+  client_hello.cipher_suites = CBS_data(&cipher_suites);
+  client_hello.cipher_suites_len = CBS_len(&cipher_suites);
+  client_hello.compression_methods = CBS_data(&compression_methods);
+  client_hello.compression_methods_len = CBS_len(&compression_methods);
+  // The extensions are optional.
+  if (CBS_len(&body) != 0) {
+    CBS extensions;
+    if (!CBS_get_u16_length_prefixed(&body, &extensions) || CBS_len(&body) != 0) {
+      return ClientHelloParseResult::Unsupported;
+    }
+    client_hello.extensions = CBS_data(&extensions);
+    client_hello.extensions_len = CBS_len(&extensions);
+  }
+  if (!checkExtensions(client_hello)) {
+    return ClientHelloParseResult::Unsupported;
+  }
+
+  // Only the null compression is supported, and TLS 1.3 requires the client to offer no other.
+  const uint16_t version = negotiateVersion(client_hello, min_version, max_version);
+  const bool null_compression =
+      memchr(client_hello.compression_methods, 0, client_hello.compression_methods_len) != nullptr;
+  if (version == 0 || !null_compression ||
+      (version >= TLS1_3_VERSION && client_hello.compression_methods_len != 1)) {
+    return ClientHelloParseResult::Unsupported;
+  }
+
+  parsed.server_name = {};
+  if (!parseServerName(client_hello, parsed.server_name)) {
+    return ClientHelloParseResult::Unsupported;
+  }
+  parsed.size = SSL3_RT_HEADER_LENGTH + record_len;
+  return ClientHelloParseResult::Parsed;
+}
+
+} // namespace TlsInspector
+} // namespace ListenerFilters
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstdint>
+
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+#include "openssl/ssl.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace ListenerFilters {
+namespace TlsInspector {
+
+/**
+ * A ClientHello parsed in place from the first bytes of a connection.
+ */
+struct ParsedClientHello {
+  // The ClientHello in the form given to the BoringSSL early callback, without its SSL, so that it
+  // can be inspected the same way. Its fields point into the parsed data.
+  SSL_CLIENT_HELLO client_hello{};
+  // The host name of the server name extension, or empty if there is none.
+  absl::string_view server_name;
+  // The size of the record holding the ClientHello.
+  uint64_t size{};
+};
+
+enum class ClientHelloParseResult {
+  // The ClientHello was parsed.
+  Parsed,
+  // The data is the beginning of a TLS record, which needs more data to be parsed.
+  NeedMoreData,
+  // The data isn't a ClientHello of the form handled by the parser, e.g. it isn't TLS, or the
+  // ClientHello is split across several records or would be rejected by BoringSSL before its
+  // server name is known. BoringSSL must be used to tell what it is.
+  Unsupported,
+};
+
+/**
+ * Parses the ClientHello at the beginning of the data of a connection, without any allocation.
+ * Only the common form of ClientHello, in a single record, is supported, and only its framing, its
+ * version, its compression methods and its server name are checked the way BoringSSL does before
+ * calling the server name callback: the other extensions are left to the TLS stack terminating
+ * the connection.
+ * @param data supplies the data received on the connection so far.
+ * @param min_version supplies the minimum TLS version the ClientHello must be compatible with.
+ * @param max_version supplies the maximum TLS version the ClientHello must be compatible with.
+ * @param parsed supplies the ClientHello to fill, if parsed.
+ * @return the result of the parsing.
+ */
+ClientHelloParseResult parseClientHello(absl::Span<const uint8_t> data, uint16_t min_version,
+                                        uint16_t max_version, ParsedClientHello& parsed);
+
+} // namespace TlsInspector
+} // namespace ListenerFilters
+} // namespace Extensions
+} // namespace Envoy
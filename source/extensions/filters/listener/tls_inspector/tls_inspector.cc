@@ -16,6 +16,8 @@
 #include "source/common/common/assert.h"
 #include "source/common/common/hex.h"
 #include "source/common/protobuf/utility.h"
+#include "source/common/runtime/runtime_features.h"
+#include "source/extensions/filters/listener/tls_inspector/client_hello_parser.h"
 
 #include "absl/strings/str_format.h"
 #include "absl/strings/str_join.h"
@@ -96,8 +98,15 @@ Config::Config(
 bssl::UniquePtr<SSL> Config::newSsl() { return bssl::UniquePtr<SSL>{SSL_new(ssl_ctx_.get())}; }
 
 Filter::Filter(const ConfigSharedPtr& config)
-    : config_(config), ssl_(config_->newSsl()),
-      requested_read_bytes_(config->initialReadBufferSize()) {
+    : config_(config), requested_read_bytes_(config->initialReadBufferSize()) {
+  if (!Runtime::runtimeFeatureEnabled(
+          "envoy.reloadable_features.tls_inspector_parse_client_hello_in_place")) {
+    createSsl();
+  }
+}
+
+void Filter::createSsl() {
+  ssl_ = config_->newSsl();
   SSL_set_app_data(ssl_.get(), this);
   SSL_set_accept_state(ssl_.get());
 }
@@ -152,7 +161,10 @@ Network::FilterStatus Filter::onData(Network::ListenerFilterBuffer& buffer) {
     const size_t len = raw_slice.len_ - read_;
     const uint64_t bytes_already_processed = read_;
     read_ = raw_slice.len_;
-    ParseState parse_state = parseClientHello(data, len, bytes_already_processed);
+    ParseState parse_state =
+        ssl_ == nullptr
+            ? parseClientHelloInPlace(static_cast<const uint8_t*>(raw_slice.mem_), raw_slice.len_)
+            : parseClientHello(data, len, bytes_already_processed);
     switch (parse_state) {
     case ParseState::Error:
       cb_->socket().ioHandle().close();
@@ -169,6 +181,69 @@ Network::FilterStatus Filter::onData(Network::ListenerFilterBuffer& buffer) {
   return Network::FilterStatus::StopIteration;
 }
 
+ParseState Filter::parseClientHelloInPlace(const uint8_t* data, size_t len) {
+  ParsedClientHello parsed;
+  switch (TlsInspector::parseClientHello(absl::MakeConstSpan(data, len),
+                                         Config::TLS_MIN_SUPPORTED_VERSION,
+                                         Config::TLS_MAX_SUPPORTED_VERSION, parsed)) {
+  case ClientHelloParseResult::NeedMoreData: {
+    const ParseState state = onMoreDataNeeded();
+    if (state != ParseState::Continue) {
+      config_->stats().bytes_processed_.recordValue(len);
+    }
+    return state;
+  }
+  case ClientHelloParseResult::Unsupported:
+    // Let BoringSSL tell what the data is, from its beginning.
+    createSsl();
+    return parseClientHello(data, len, 0);
+  case ClientHelloParseResult::Parsed:
+    break;
+  }
+
+  // The same callbacks as those of the BoringSSL handshake, in the same order.
+  createJA3Hash(&parsed.client_hello);
+  const uint8_t* alpn;
+  size_t alpn_len;
+  if (SSL_early_callback_ctx_extension_get(&parsed.client_hello,
+                                           TLSEXT_TYPE_application_layer_protocol_negotiation,
+                                           &alpn, &alpn_len)) {
+    onALPN(alpn, alpn_len);
+  }
+  onServername(parsed.server_name);
+  config_->stats().bytes_processed_.recordValue(parsed.size);
+  return onClientHelloDone();
+}
+
+ParseState Filter::onMoreDataNeeded() {
+  if (read_ == maxConfigReadBytes()) {
+    // We've hit the specified size limit. This is an unreasonably large ClientHello;
+    // indicate failure.
+    config_->stats().client_hello_too_large_.inc();
+    return ParseState::Error;
+  }
+  if (read_ == requested_read_bytes_) {
+    // Double requested bytes up to the maximum configured.
+    requested_read_bytes_ = std::min<uint32_t>(2 * requested_read_bytes_, maxConfigReadBytes());
+  }
+  return ParseState::Continue;
+}
+
+ParseState Filter::onClientHelloDone() {
+  if (clienthello_success_) {
+    config_->stats().tls_found_.inc();
+    if (alpn_found_) {
+      config_->stats().alpn_found_.inc();
+    } else {
+      config_->stats().alpn_not_found_.inc();
+    }
+    cb_->socket().setDetectedTransportProtocol("tls");
+  } else {
+    config_->stats().tls_not_found_.inc();
+  }
+  return ParseState::Done;
+}
+
 ParseState Filter::parseClientHello(const void* data, size_t len,
                                     uint64_t bytes_already_processed) {
   // Ownership remains here though we pass a reference to it in `SSL_set0_rbio()`.
@@ -188,30 +263,9 @@ ParseState Filter::parseClientHello(const void* data, size_t len,
   ParseState state = [this, ret]() {
     switch (SSL_get_error(ssl_.get(), ret)) {
     case SSL_ERROR_WANT_READ:
-      if (read_ == maxConfigReadBytes()) {
-        // We've hit the specified size limit. This is an unreasonably large ClientHello;
-        // indicate failure.
-        config_->stats().client_hello_too_large_.inc();
-        return ParseState::Error;
-      }
-      if (read_ == requested_read_bytes_) {
-        // Double requested bytes up to the maximum configured.
-        requested_read_bytes_ = std::min<uint32_t>(2 * requested_read_bytes_, maxConfigReadBytes());
-      }
-      return ParseState::Continue;
+      return onMoreDataNeeded();
     case SSL_ERROR_SSL:
-      if (clienthello_success_) {
-        config_->stats().tls_found_.inc();
-        if (alpn_found_) {
-          config_->stats().alpn_found_.inc();
-        } else {
-          config_->stats().alpn_not_found_.inc();
-        }
-        cb_->socket().setDetectedTransportProtocol("tls");
-      } else {
-        config_->stats().tls_not_found_.inc();
-      }
-      return ParseState::Done;
+      return onClientHelloDone();
     default:
       return ParseState::Error;
     }
@@ -87,7 +87,14 @@ public:
   size_t maxReadBytes() const override { return requested_read_bytes_; }
 
 private:
+  // Parses the ClientHello in place in the data peeked so far, falling back to BoringSSL for the
+  // data it doesn't support.
+  ParseState parseClientHelloInPlace(const uint8_t* data, size_t len);
+  // Parses the ClientHello with BoringSSL, which is fed the new data of each read.
   ParseState parseClientHello(const void* data, size_t len, uint64_t bytes_already_processed);
+  void createSsl();
+  ParseState onMoreDataNeeded();
+  ParseState onClientHelloDone();
   ParseState onRead();
   void onALPN(const unsigned char* data, unsigned int len);
   void onServername(absl::string_view name);
@@ -97,6 +104,7 @@ private:
   ConfigSharedPtr config_;
   Network::ListenerFilterCallbacks* cb_{};
 
+  // Created only if the ClientHello is parsed with BoringSSL.
   bssl::UniquePtr<SSL> ssl_;
   uint64_t read_{0};
   bool alpn_found_{false};
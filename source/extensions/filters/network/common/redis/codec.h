@@ -208,6 +208,14 @@ public:
    * @param out supplies the buffer to encode to.
    */
   virtual void encode(const RespValue& value, Buffer::Instance& out) PURE;
+
+  /**
+   * Encode a RESP value to a buffer, moving its large bulk strings into the buffer instead of
+   * copying them.
+   * @param value supplies the value to encode, which is consumed.
+   * @param out supplies the buffer to encode to.
+   */
+  virtual void encodeOwned(RespValuePtr&& value, Buffer::Instance& out) PURE;
 };
 
 using EncoderPtr = std::unique_ptr<Encoder>;
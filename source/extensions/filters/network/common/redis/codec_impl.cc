@@ -18,6 +18,29 @@ namespace Extensions {
 namespace NetworkFilters {
 namespace Common {
 namespace Redis {
+namespace {
+
+// The bulk strings large enough for moving them into the output buffer to be cheaper than copying.
+constexpr uint64_t MinMovedBulkStringSize = 16 * 1024;
+// The most storage reserved for a bulk string before its body has arrived, so that a peer can't
+// make the decoder allocate more than it sends.
+constexpr uint64_t MaxReservedBulkStringSize = 64 * 1024;
+
+// A buffer fragment owning a bulk string moved out of a RESP value.
+class BulkStringFragment : public Buffer::BufferFragment {
+public:
+  explicit BulkStringFragment(std::string&& string) : string_(std::move(string)) {}
+
+  // Buffer::BufferFragment
+  const void* data() const override { return string_.data(); }
+  size_t size() const override { return string_.size(); }
+  void done() override { delete this; }
+
+private:
+  const std::string string_;
+};
+
+} // namespace
 
 std::string RespValue::toString() const {
   switch (type_) {
@@ -651,7 +674,9 @@ void DecoderImpl::parseSlice(const Buffer::RawSlice& slice) {
       } else {
         ASSERT(current_value.value_->type() == RespType::BulkString);
         if (!pending_integer_.negative_) {
-          // TODO(mattklein123): reserve and define max length since we don't stream currently.
+          // TODO(mattklein123): define max length since we don't stream currently.
+          current_value.value_->asString().reserve(std::min(
+              static_cast<uint64_t>(pending_integer_.integer_), MaxReservedBulkStringSize));
           state_ = State::BulkStringBody;
         } else {
           // Null bulk string. Switch type to null and move to value complete.
@@ -774,15 +799,48 @@ void EncoderImpl::encode(const RespValue& value, Buffer::Instance& out) {
   }
 }
 
-void EncoderImpl::encodeArray(const std::vector<RespValue>& array, Buffer::Instance& out) {
+void EncoderImpl::encodeOwned(RespValuePtr&& value, Buffer::Instance& out) {
+  encodeMovingBulkStrings(*value, out);
+}
+
+void EncoderImpl::encodeMovingBulkStrings(RespValue& value, Buffer::Instance& out) {
+  switch (value.type()) {
+  case RespType::Array: {
+    encodeHeader('*', value.asArray().size(), out);
+    for (RespValue& element : value.asArray()) {
+      encodeMovingBulkStrings(element, out);
+    }
+    break;
+  }
+  case RespType::BulkString: {
+    if (value.asString().size() < MinMovedBulkStringSize) {
+      encodeBulkString(value.asString(), out);
+      break;
+    }
+    encodeHeader('$', value.asString().size(), out);
+    out.addBufferFragment(*new BulkStringFragment(std::move(value.asString())));
+    out.add("\r\n", 2);
+    break;
+  }
+  default:
+    // The composite arrays share their base array, so nothing can be moved out of them.
+    encode(value, out);
+    break;
+  }
+}
+
+void EncoderImpl::encodeHeader(char type, uint64_t size, Buffer::Instance& out) {
   char buffer[32];
   char* current = buffer;
-  *current++ = '*';
-  current += StringUtil::itoa(current, 21, array.size());
+  *current++ = type;
+  current += StringUtil::itoa(current, 21, size);
   *current++ = '\r';
   *current++ = '\n';
   out.add(buffer, current - buffer);
+}
 
+void EncoderImpl::encodeArray(const std::vector<RespValue>& array, Buffer::Instance& out) {
+  encodeHeader('*', array.size(), out);
   for (const RespValue& value : array) {
     encode(value, out);
   }
@@ -790,26 +848,14 @@ void EncoderImpl::encodeArray(const std::vector<RespValue>& array, Buffer::Insta
 
 void EncoderImpl::encodeCompositeArray(const RespValue::CompositeArray& composite_array,
                                        Buffer::Instance& out) {
-  char buffer[32];
-  char* current = buffer;
-  *current++ = '*';
-  current += StringUtil::itoa(current, 21, composite_array.size());
-  *current++ = '\r';
-  *current++ = '\n';
-  out.add(buffer, current - buffer);
+  encodeHeader('*', composite_array.size(), out);
   for (const RespValue& value : composite_array) {
     encode(value, out);
   }
 }
 
 void EncoderImpl::encodeBulkString(const std::string& string, Buffer::Instance& out) {
-  char buffer[32];
-  char* current = buffer;
-  *current++ = '$';
-  current += StringUtil::itoa(current, 21, string.size());
-  *current++ = '\r';
-  *current++ = '\n';
-  out.add(buffer, current - buffer);
+  encodeHeader('$', string.size(), out);
   out.add(string);
   out.add("\r\n", 2);
 }
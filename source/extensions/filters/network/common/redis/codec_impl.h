@@ -90,8 +90,11 @@ class EncoderImpl : public Encoder {
 public:
   // RedisProxy::Encoder
   void encode(const RespValue& value, Buffer::Instance& out) override;
+  void encodeOwned(RespValuePtr&& value, Buffer::Instance& out) override;
 
 private:
+  void encodeMovingBulkStrings(RespValue& value, Buffer::Instance& out);
+  void encodeHeader(char type, uint64_t size, Buffer::Instance& out);
   void encodeArray(const std::vector<RespValue>& array, Buffer::Instance& out);
   void encodeCompositeArray(const RespValue::CompositeArray& array, Buffer::Instance& out);
   void encodeBulkString(const std::string& string, Buffer::Instance& out);
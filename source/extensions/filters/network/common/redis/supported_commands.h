@@ -66,6 +66,11 @@ struct SupportedCommands {
    */
   static const std::string& echo() { CONSTRUCT_ON_FIRST_USE(std::string, "echo"); }
 
+  /**
+   * @return get command
+   */
+  static const std::string& get() { CONSTRUCT_ON_FIRST_USE(std::string, "get"); }
+
   /**
    * @return mget command
    */
@@ -11,11 +11,16 @@ namespace ConnectionLimitFilter {
 
 Config::Config(
     const envoy::extensions::filters::network::connection_limit::v3::ConnectionLimit& proto_config,
-    Stats::Scope& scope, Runtime::Loader& runtime)
+    Stats::Scope& scope, Runtime::Loader& runtime, uint32_t concurrency)
     : enabled_(proto_config.runtime_enabled(), runtime),
       stats_(generateStats(proto_config.stat_prefix(), scope)),
       max_connections_(PROTOBUF_GET_WRAPPED_REQUIRED(proto_config, max_connections)),
-      connections_(0), delay_(PROTOBUF_GET_OPTIONAL_MS(proto_config, delay)) {}
+      connections_(0),
+      sharded_(proto_config.per_worker_slack() > 0
+                   ? std::make_unique<ShardedLimit>(max_connections_,
+                                                    proto_config.per_worker_slack(), concurrency)
+                   : nullptr),
+      delay_(PROTOBUF_GET_OPTIONAL_MS(proto_config, delay)) {}
 
 ConnectionLimitStats Config::generateStats(const std::string& prefix, Stats::Scope& scope) {
   const std::string final_prefix = "connection_limit." + prefix;
@@ -24,6 +29,9 @@ ConnectionLimitStats Config::generateStats(const std::string& prefix, Stats::Sco
 }
 
 bool Config::incrementConnectionWithinLimit() {
+  if (sharded_ != nullptr) {
+    return sharded_->tryAllocate(1);
+  }
   auto conns = connections_.load(std::memory_order_relaxed);
   while (conns < max_connections_) {
     // Testing hook.
@@ -37,9 +45,11 @@ bool Config::incrementConnectionWithinLimit() {
   return false;
 }
 
-void Config::incrementConnection() { connections_++; }
-
 void Config::decrementConnection() {
+  if (sharded_ != nullptr) {
+    sharded_->release(1);
+    return;
+  }
   ASSERT(connections_ > 0);
   connections_--;
 }
@@ -73,8 +83,6 @@ Network::FilterStatus Filter::onNewConnection() {
 
     // Set is_rejected_ is true, so that onData() will return StopIteration during the delay time.
     is_rejected_ = true;
-    // The close() will trigger onEvent() with close event, increment the active connections count.
-    config_->incrementConnection();
 
     // Delay rejection provides a better DoS protection for Envoy.
     absl::optional<std::chrono::milliseconds> duration = config_->delay();
@@ -91,6 +99,7 @@ Network::FilterStatus Filter::onNewConnection() {
     return Network::FilterStatus::StopIteration;
   }
 
+  is_counted_ = true;
   return Network::FilterStatus::Continue;
 }
 
@@ -98,7 +107,10 @@ void Filter::onEvent(Network::ConnectionEvent event) {
   if (event == Network::ConnectionEvent::RemoteClose ||
       event == Network::ConnectionEvent::LocalClose) {
     resetTimerState();
-    config_->decrementConnection();
+    if (is_counted_) {
+      is_counted_ = false;
+      config_->decrementConnection();
+    }
     config_->stats().active_connections_.dec();
   }
 }
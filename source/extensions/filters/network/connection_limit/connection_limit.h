@@ -10,6 +10,7 @@
 #include "envoy/runtime/runtime.h"
 #include "envoy/stats/stats_macros.h"
 
+#include "source/common/common/sharded_limit.h"
 #include "source/common/common/thread_synchronizer.h"
 #include "source/common/runtime/runtime_protos.h"
 
@@ -37,12 +38,14 @@ struct ConnectionLimitStats {
  */
 class Config : Logger::Loggable<Logger::Id::filter> {
 public:
+  /**
+   * @param concurrency the number of workers, among which the slack of the config is shared.
+   */
   Config(const envoy::extensions::filters::network::connection_limit::v3::ConnectionLimit&
              proto_config,
-         Stats::Scope& scope, Runtime::Loader& runtime);
+         Stats::Scope& scope, Runtime::Loader& runtime, uint32_t concurrency = 1);
 
   bool incrementConnectionWithinLimit();
-  void incrementConnection();
   void decrementConnection();
   bool enabled() { return enabled_.enabled(); }
   absl::optional<std::chrono::milliseconds> delay() { return delay_; }
@@ -54,6 +57,8 @@ private:
   ConnectionLimitStats stats_;
   const uint64_t max_connections_;
   std::atomic<uint64_t> connections_;
+  // Counts the connections instead of connections_ when the workers have slack.
+  std::unique_ptr<ShardedLimit> sharded_;
   absl::optional<std::chrono::milliseconds> delay_;
   mutable Thread::ThreadSynchronizer synchronizer_; // Used for testing only.
 
@@ -91,6 +96,8 @@ private:
   Network::ReadFilterCallbacks* read_callbacks_{};
   Event::TimerPtr delay_timer_ = nullptr;
   bool is_rejected_{false};
+  // Whether the connection is counted in the connections of the config.
+  bool is_counted_{false};
 };
 
 } // namespace ConnectionLimitFilter
@@ -422,7 +422,8 @@ HttpConnectionManagerConfig::HttpConnectionManagerConfig(
       append_local_overload_(config.append_local_overload()),
       append_x_forwarded_port_(config.append_x_forwarded_port()),
       add_proxy_protocol_connection_state_(
-          PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, add_proxy_protocol_connection_state, true)) {
+          PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, add_proxy_protocol_connection_state, true)),
+      filter_latency_sample_interval_(config.filter_latency_sample_interval()) {
   if (!creation_status.ok()) {
     return;
   }
@@ -737,6 +738,18 @@ HttpConnectionManagerConfig::HttpConnectionManagerConfig(
           std::make_pair(name, FilterConfig{std::move(factories), enabled}));
     }
   }
+
+  if (filter_latency_sample_interval_ > 0) {
+    Http::FilterChainUtility::createLatencyStats(filter_factories_, context_.scope(),
+                                                 stats_prefix_);
+    for (auto& [name, upgrade_config] : upgrade_filter_factories_) {
+      if (upgrade_config.filter_factories != nullptr) {
+        Http::FilterChainUtility::createLatencyStats(*upgrade_config.filter_factories,
+                                                     context_.scope(),
+                                                     fmt::format("{}{}.", stats_prefix_, name));
+      }
+    }
+  }
 }
 
 Http::ServerConnectionPtr HttpConnectionManagerConfig::createCodec(
@@ -775,10 +788,18 @@ Http::ServerConnectionPtr HttpConnectionManagerConfig::createCodec(
 
 bool HttpConnectionManagerConfig::createFilterChain(Http::FilterChainManager& manager, bool,
                                                     const Http::FilterChainOptions& options) const {
-  Http::FilterChainUtility::createFilterChainForFactories(manager, options, filter_factories_);
+  Http::FilterChainUtility::createFilterChainForFactories(manager, options, filter_factories_,
+                                                          sampleFilterLatency());
   return true;
 }
 
+bool HttpConnectionManagerConfig::sampleFilterLatency() const {
+  return filter_latency_sample_interval_ > 0 &&
+         context_.serverFactoryContext().api().randomGenerator().random() %
+                 filter_latency_sample_interval_ ==
+             0;
+}
+
 bool HttpConnectionManagerConfig::createUpgradeFilterChain(
     absl::string_view upgrade_type,
     const Http::FilterChainFactory::UpgradeMap* per_route_upgrade_map,
@@ -808,7 +829,7 @@ bool HttpConnectionManagerConfig::createUpgradeFilterChain(
   }
 
   Http::FilterChainUtility::createFilterChainForFactories(
-      callbacks, Http::EmptyFilterChainOptions{}, *filters_to_use);
+      callbacks, Http::EmptyFilterChainOptions{}, *filters_to_use, sampleFilterLatency());
   return true;
 }
 
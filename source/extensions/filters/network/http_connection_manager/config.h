@@ -284,6 +284,12 @@ private:
       const envoy::extensions::filters::network::http_connection_manager::v3::HttpConnectionManager&
           filter_config);
 
+  /**
+   * @return whether the filters of a new stream record their latency, for one in every
+   *         filter_latency_sample_interval_ streams.
+   */
+  bool sampleFilterLatency() const;
+
   Http::RequestIDExtensionSharedPtr request_id_extension_;
   Server::Configuration::FactoryContext& context_;
   FilterFactoriesList filter_factories_;
@@ -365,6 +371,7 @@ private:
   const bool append_local_overload_;
   const bool append_x_forwarded_port_;
   const bool add_proxy_protocol_connection_state_;
+  const uint32_t filter_latency_sample_interval_;
 };
 
 /**
@@ -215,6 +215,16 @@ public:
 
 using DecoderPtr = std::unique_ptr<Decoder>;
 
+/**
+ * Callbacks for the mongo messages of which only the header is decoded.
+ */
+class HeaderDecoderCallbacks {
+public:
+  virtual ~HeaderDecoderCallbacks() = default;
+
+  virtual void decodeMessageHeader(Message::OpCode op_code) PURE;
+};
+
 /**
  * Mongo message encoder.
  */
@@ -1,6 +1,8 @@
 #include "source/extensions/filters/network/mongo_proxy/codec_impl.h"
 
+#include <algorithm>
 #include <cstdint>
+#include <cstring>
 #include <list>
 #include <memory>
 #include <sstream>
@@ -434,6 +436,58 @@ void DecoderImpl::onData(Buffer::Instance& data) {
   }
 }
 
+void HeaderDecoderImpl::onData(const Buffer::Instance& data) {
+  const uint64_t length = data.length();
+  uint64_t offset = 0;
+  while (offset < length) {
+    if (body_remaining_ > 0) {
+      const uint64_t skipped = std::min(body_remaining_, length - offset);
+      body_remaining_ -= skipped;
+      offset += skipped;
+      continue;
+    }
+
+    const uint64_t copied =
+        std::min<uint64_t>(Message::MessageHeaderSize - header_length_, length - offset);
+    data.copyOut(offset, copied, header_.data() + header_length_);
+    header_length_ += copied;
+    offset += copied;
+    if (header_length_ < Message::MessageHeaderSize) {
+      return;
+    }
+
+    header_length_ = 0;
+    const uint32_t message_length = headerInt32(0);
+    if (message_length < Message::MessageHeaderSize) {
+      throw EnvoyException(fmt::format("invalid mongo message size {}", message_length));
+    }
+    body_remaining_ = message_length - Message::MessageHeaderSize;
+
+    const Message::OpCode op_code = static_cast<Message::OpCode>(headerInt32(12));
+    ENVOY_LOG(trace, "message op: {}, skipping {} bytes", static_cast<int32_t>(op_code),
+              body_remaining_);
+    switch (op_code) {
+    case Message::OpCode::Reply:
+    case Message::OpCode::Query:
+    case Message::OpCode::GetMore:
+    case Message::OpCode::Insert:
+    case Message::OpCode::KillCursors:
+    case Message::OpCode::Command:
+    case Message::OpCode::CommandReply:
+      callbacks_.decodeMessageHeader(op_code);
+      break;
+    default:
+      throw EnvoyException(fmt::format("invalid mongo op {}", static_cast<int32_t>(op_code)));
+    }
+  }
+}
+
+int32_t HeaderDecoderImpl::headerInt32(uint32_t offset) const {
+  uint32_t value;
+  std::memcpy(&value, header_.data() + offset, sizeof(value));
+  return le32toh(value);
+}
+
 void EncoderImpl::encodeCommonHeader(int32_t total_size, const Message& message,
                                      Message::OpCode op) {
   Bson::BufferHelper::writeInt32(output_, total_size);
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <array>
 #include <cstdint>
 #include <list>
 #include <string>
@@ -282,6 +283,27 @@ private:
   DecoderCallbacks& callbacks_;
 };
 
+/**
+ * Decodes only the header of the messages, and skips their body. The data is only looked at, so
+ * that it doesn't need to be buffered until the messages are complete.
+ */
+class HeaderDecoderImpl : Logger::Loggable<Logger::Id::mongo> {
+public:
+  HeaderDecoderImpl(HeaderDecoderCallbacks& callbacks) : callbacks_(callbacks) {}
+
+  void onData(const Buffer::Instance& data);
+
+private:
+  int32_t headerInt32(uint32_t offset) const;
+
+  HeaderDecoderCallbacks& callbacks_;
+  // The header of the next message, of which header_length_ bytes were received.
+  std::array<uint8_t, Message::MessageHeaderSize> header_;
+  uint32_t header_length_{};
+  // The bytes of the body of the current message which are still to be skipped.
+  uint64_t body_remaining_{};
+};
+
 class EncoderImpl : public Encoder, Logger::Loggable<Logger::Id::mongo> {
 public:
   EncoderImpl(Buffer::Instance& output) : output_(output) {}
@@ -62,6 +62,8 @@ ProxyFilter::ProxyFilter(const std::string& stat_prefix, Stats::Scope& scope,
                          const Network::DrainDecision& drain_decision, TimeSource& time_source,
                          bool emit_dynamic_metadata, const MongoStatsSharedPtr& mongo_stats)
     : stats_(generateStats(stat_prefix, scope)), runtime_(runtime), drain_decision_(drain_decision),
+      full_decoding_(
+          runtime_.snapshot().featureEnabled(MongoRuntimeConfig::get().FullDecodingEnabled, 100)),
       access_log_(access_log), fault_config_(fault_config), time_source_(time_source),
       emit_dynamic_metadata_(emit_dynamic_metadata), mongo_stats_(mongo_stats) {
   if (!runtime_.snapshot().featureEnabled(MongoRuntimeConfig::get().ConnectionLoggingEnabled,
@@ -287,6 +289,41 @@ void ProxyFilter::decodeCommandReply(CommandReplyMessagePtr&& message) {
   ENVOY_LOG(debug, "decoded COMMANDREPLY: {}", message->toString(true));
 }
 
+void ProxyFilter::decodeMessageHeader(Message::OpCode op_code) {
+  switch (op_code) {
+  case Message::OpCode::Reply:
+    stats_.op_reply_.inc();
+    break;
+  case Message::OpCode::Query:
+    tryInjectDelay();
+    stats_.op_query_.inc();
+    break;
+  case Message::OpCode::GetMore:
+    tryInjectDelay();
+    stats_.op_get_more_.inc();
+    break;
+  case Message::OpCode::Insert:
+    tryInjectDelay();
+    stats_.op_insert_.inc();
+    break;
+  case Message::OpCode::KillCursors:
+    tryInjectDelay();
+    stats_.op_kill_cursors_.inc();
+    break;
+  case Message::OpCode::Command:
+    tryInjectDelay();
+    stats_.op_command_.inc();
+    break;
+  case Message::OpCode::CommandReply:
+    tryInjectDelay();
+    stats_.op_command_reply_.inc();
+    break;
+  default:
+    break;
+  }
+  ENVOY_LOG(debug, "decoded header of op {}", static_cast<int32_t>(op_code));
+}
+
 void ProxyFilter::onDrainClose() {
   read_callbacks_->connection().close(Network::ConnectionCloseType::FlushWrite);
 }
@@ -315,9 +352,13 @@ void ProxyFilter::chargeReplyStats(ActiveQuery& active_query, Stats::ElementVec&
   names.resize(orig_size);
 }
 
+bool ProxyFilter::decodingEnabled() {
+  return sniffing_ &&
+         runtime_.snapshot().featureEnabled(MongoRuntimeConfig::get().ProxyEnabled, 100);
+}
+
 void ProxyFilter::doDecode(Buffer::Instance& buffer) {
-  if (!sniffing_ ||
-      !runtime_.snapshot().featureEnabled(MongoRuntimeConfig::get().ProxyEnabled, 100)) {
+  if (!decodingEnabled()) {
     // Safety measure just to make sure that if we have a decoding error we keep going and lose
     // stats. This can be removed once we are more confident of this code.
     buffer.drain(buffer.length());
@@ -345,6 +386,20 @@ void ProxyFilter::doDecode(Buffer::Instance& buffer) {
   }
 }
 
+void ProxyFilter::doDecodeHeaders(const Buffer::Instance& data,
+                                  HeaderDecoderImpl& header_decoder) {
+  if (!decodingEnabled()) {
+    return;
+  }
+
+  TRY_NEEDS_AUDIT { header_decoder.onData(data); }
+  END_TRY catch (EnvoyException& e) {
+    ENVOY_LOG(info, "mongo decoding error: {}", e.what());
+    stats_.decoding_error_.inc();
+    sniffing_ = false;
+  }
+}
+
 void ProxyFilter::logMessage(Message& message, bool full) {
   if (access_log_ &&
       runtime_.snapshot().featureEnabled(MongoRuntimeConfig::get().LoggingEnabled, 100)) {
@@ -376,15 +431,23 @@ void ProxyFilter::onEvent(Network::ConnectionEvent event) {
 }
 
 Network::FilterStatus ProxyFilter::onData(Buffer::Instance& data, bool) {
-  read_buffer_.add(data);
-  doDecode(read_buffer_);
+  if (full_decoding_) {
+    read_buffer_.add(data);
+    doDecode(read_buffer_);
+  } else {
+    doDecodeHeaders(data, read_header_decoder_);
+  }
 
   return delay_timer_ ? Network::FilterStatus::StopIteration : Network::FilterStatus::Continue;
 }
 
 Network::FilterStatus ProxyFilter::onWrite(Buffer::Instance& data, bool) {
-  write_buffer_.add(data);
-  doDecode(write_buffer_);
+  if (full_decoding_) {
+    write_buffer_.add(data);
+    doDecode(write_buffer_);
+  } else {
+    doDecodeHeaders(data, write_header_decoder_);
+  }
   return Network::FilterStatus::Continue;
 }
 
@@ -23,6 +23,7 @@
 #include "source/common/singleton/const_singleton.h"
 #include "source/extensions/filters/common/fault/fault_config.h"
 #include "source/extensions/filters/network/mongo_proxy/codec.h"
+#include "source/extensions/filters/network/mongo_proxy/codec_impl.h"
 #include "source/extensions/filters/network/mongo_proxy/mongo_stats.h"
 #include "source/extensions/filters/network/mongo_proxy/utility.h"
 
@@ -39,6 +40,7 @@ public:
   const std::string ProxyEnabled{"mongo.proxy_enabled"};
   const std::string ConnectionLoggingEnabled{"mongo.connection_logging_enabled"};
   const std::string DrainCloseEnabled{"mongo.drain_close_enabled"};
+  const std::string FullDecodingEnabled{"mongo.full_decoding_enabled"};
 };
 
 using MongoRuntimeConfig = ConstSingleton<MongoRuntimeConfigKeys>;
@@ -102,6 +104,7 @@ using AccessLogSharedPtr = std::shared_ptr<AccessLog>;
  */
 class ProxyFilter : public Network::Filter,
                     public DecoderCallbacks,
+                    public HeaderDecoderCallbacks,
                     public Network::ConnectionCallbacks,
                     Logger::Loggable<Logger::Id::mongo> {
 public:
@@ -134,6 +137,9 @@ public:
   void decodeCommand(CommandMessagePtr&& message) override;
   void decodeCommandReply(CommandReplyMessagePtr&& message) override;
 
+  // Mongo::HeaderDecoderCallbacks
+  void decodeMessageHeader(Message::OpCode op_code) override;
+
   // Network::ConnectionCallbacks
   void onEvent(Network::ConnectionEvent event) override;
   void onAboveWriteBufferHighWatermark() override {}
@@ -174,7 +180,9 @@ private:
   void chargeReplyStats(ActiveQuery& active_query, Stats::ElementVec& names,
                         const ReplyMessage& message);
 
+  bool decodingEnabled();
   void doDecode(Buffer::Instance& buffer);
+  void doDecodeHeaders(const Buffer::Instance& data, HeaderDecoderImpl& header_decoder);
   void logMessage(Message& message, bool full);
   void onDrainClose();
   absl::optional<std::chrono::milliseconds> delayDuration();
@@ -187,6 +195,10 @@ private:
   const Network::DrainDecision& drain_decision_;
   Buffer::OwnedImpl read_buffer_;
   Buffer::OwnedImpl write_buffer_;
+  // Whether the messages of the connection are fully decoded, rather than only their header.
+  const bool full_decoding_;
+  HeaderDecoderImpl read_header_decoder_{*this};
+  HeaderDecoderImpl write_header_decoder_{*this};
   bool sniffing_{true};
   std::list<ActiveQueryPtr> active_query_list_;
   AccessLogSharedPtr access_log_;
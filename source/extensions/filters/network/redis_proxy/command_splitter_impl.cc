@@ -154,6 +154,11 @@ void DelayFaultRequest::onDelayResponse() {
 
 void DelayFaultRequest::cancel() { delay_timer_->disableTimer(); }
 
+void NearCacheRequest::onResponse(Common::Redis::RespValuePtr&& response) {
+  near_cache_.insert(key_, *response, generation_);
+  callbacks_.onResponse(std::move(response));
+}
+
 SplitRequestPtr SimpleRequest::create(Router& router,
                                       Common::Redis::RespValuePtr&& incoming_request,
                                       SplitCallbacks& callbacks, CommandStats& command_stats,
@@ -553,13 +558,15 @@ SplitRequestPtr TransactionRequest::create(Router& router,
 
 InstanceImpl::InstanceImpl(RouterPtr&& router, Stats::Scope& scope, const std::string& stat_prefix,
                            TimeSource& time_source, bool latency_in_micros,
-                           Common::Redis::FaultManagerPtr&& fault_manager)
+                           Common::Redis::FaultManagerPtr&& fault_manager,
+                           NearCacheSharedPtr near_cache)
     : router_(std::move(router)), simple_command_handler_(*router_),
       eval_command_handler_(*router_), mget_handler_(*router_), mset_handler_(*router_),
       split_keys_sum_result_handler_(*router_),
       transaction_handler_(*router_), stats_{ALL_COMMAND_SPLITTER_STATS(
                                           POOL_COUNTER_PREFIX(scope, stat_prefix + "splitter."))},
-      time_source_(time_source), fault_manager_(std::move(fault_manager)) {
+      time_source_(time_source), fault_manager_(std::move(fault_manager)),
+      near_cache_(std::move(near_cache)) {
   for (const std::string& command : Common::Redis::SupportedCommands::simpleCommands()) {
     addHandler(scope, stat_prefix, command, latency_in_micros, simple_command_handler_);
   }
@@ -697,6 +704,13 @@ SplitRequestPtr InstanceImpl::makeRequest(Common::Redis::RespValuePtr&& request,
   // Fault Injection Check
   const Common::Redis::Fault* fault_ptr = fault_manager_->getFaultForCommand(command_name);
 
+  std::unique_ptr<NearCacheRequest> near_cache_request;
+  if (near_cache_ != nullptr &&
+      serveFromNearCache(command_name, *request, fault_ptr != nullptr, callbacks,
+                         handler->command_stats_, near_cache_request)) {
+    return nullptr;
+  }
+
   // Check if delay, which determines which callbacks to use. If a delay fault is enabled,
   // the delay fault itself wraps the request (or other fault) and the delay fault itself
   // implements the callbacks functions, and in turn calls the real callbacks after injecting
@@ -721,6 +735,16 @@ SplitRequestPtr InstanceImpl::makeRequest(Common::Redis::RespValuePtr&& request,
     request_ptr = ErrorFaultRequest::create(has_delay_fault ? *delay_fault_ptr : callbacks,
                                             handler->command_stats_, time_source_, has_delay_fault,
                                             stream_info);
+  } else if (near_cache_request != nullptr) {
+    request_ptr = handler->handler_.get().startRequest(std::move(request), *near_cache_request,
+                                                       handler->command_stats_, time_source_,
+                                                       has_delay_fault, stream_info);
+    if (request_ptr == nullptr) {
+      // The request already completed.
+      return nullptr;
+    }
+    near_cache_request->wrapped_request_ptr_ = std::move(request_ptr);
+    return near_cache_request;
   } else {
     request_ptr = handler->handler_.get().startRequest(
         std::move(request), has_delay_fault ? *delay_fault_ptr : callbacks, handler->command_stats_,
@@ -736,6 +760,38 @@ SplitRequestPtr InstanceImpl::makeRequest(Common::Redis::RespValuePtr&& request,
   }
 }
 
+bool InstanceImpl::serveFromNearCache(const std::string& command_name,
+                                      const Common::Redis::RespValue& request, bool faulted,
+                                      SplitCallbacks& callbacks, CommandStats& command_stats,
+                                      std::unique_ptr<NearCacheRequest>& near_cache_request) {
+  const std::vector<Common::Redis::RespValue>& args = request.asArray();
+  if (!Common::Redis::SupportedCommands::isReadCommand(command_name)) {
+    for (uint64_t i = 1; i < args.size(); i++) {
+      if (near_cache_->cacheable(args[i].asString())) {
+        near_cache_->invalidate(args[i].asString());
+      }
+    }
+    return false;
+  }
+  // The transactions read what they wrote, and the faults apply to the cached reads too, so
+  // neither is served from the cache.
+  if (command_name != Common::Redis::SupportedCommands::get() || args.size() != 2 || faulted ||
+      callbacks.transaction().active_ || !near_cache_->cacheable(args[1].asString())) {
+    return false;
+  }
+  Common::Redis::RespValuePtr value = near_cache_->lookup(args[1].asString());
+  if (value == nullptr) {
+    near_cache_request = std::make_unique<NearCacheRequest>(callbacks, *near_cache_,
+                                                            args[1].asString());
+    return false;
+  }
+  ENVOY_LOG(debug, "serving '{}' from the near cache", request.toString());
+  command_stats.total_.inc();
+  command_stats.success_.inc();
+  callbacks.onResponse(std::move(value));
+  return true;
+}
+
 void InstanceImpl::onInvalidRequest(SplitCallbacks& callbacks) {
   stats_.invalid_request_.inc();
   callbacks.onResponse(Common::Redis::Utility::makeError(Response::get().InvalidRequest));
@@ -16,6 +16,7 @@
 #include "source/extensions/filters/network/common/redis/utility.h"
 #include "source/extensions/filters/network/redis_proxy/command_splitter.h"
 #include "source/extensions/filters/network/redis_proxy/conn_pool_impl.h"
+#include "source/extensions/filters/network/redis_proxy/near_cache.h"
 #include "source/extensions/filters/network/redis_proxy/router.h"
 
 namespace Envoy {
@@ -171,6 +172,38 @@ private:
   Common::Redis::RespValuePtr response_;
 };
 
+/**
+ * NearCacheRequest wraps the GET request of a cached key that missed the near cache, and caches
+ * its response.
+ */
+class NearCacheRequest : public SplitRequest, public SplitCallbacks {
+public:
+  NearCacheRequest(SplitCallbacks& callbacks, NearCache& near_cache, const std::string& key)
+      : callbacks_(callbacks), near_cache_(near_cache), key_(key),
+        generation_(near_cache.generation()) {}
+
+  // SplitCallbacks
+  bool connectionAllowed() override { return callbacks_.connectionAllowed(); }
+  void onQuit() override { callbacks_.onQuit(); }
+  void onAuth(const std::string& password) override { callbacks_.onAuth(password); }
+  void onAuth(const std::string& username, const std::string& password) override {
+    callbacks_.onAuth(username, password);
+  }
+  void onResponse(Common::Redis::RespValuePtr&& response) override;
+  Common::Redis::Client::Transaction& transaction() override { return callbacks_.transaction(); }
+
+  // RedisProxy::CommandSplitter::SplitRequest
+  void cancel() override { wrapped_request_ptr_->cancel(); }
+
+  SplitRequestPtr wrapped_request_ptr_;
+
+private:
+  SplitCallbacks& callbacks_;
+  NearCache& near_cache_;
+  const std::string key_;
+  const uint64_t generation_;
+};
+
 /**
  * SimpleRequest hashes the first argument as the key.
  */
@@ -364,7 +397,8 @@ class InstanceImpl : public Instance, Logger::Loggable<Logger::Id::redis> {
 public:
   InstanceImpl(RouterPtr&& router, Stats::Scope& scope, const std::string& stat_prefix,
                TimeSource& time_source, bool latency_in_micros,
-               Common::Redis::FaultManagerPtr&& fault_manager);
+               Common::Redis::FaultManagerPtr&& fault_manager,
+               NearCacheSharedPtr near_cache = nullptr);
 
   // RedisProxy::CommandSplitter::Instance
   SplitRequestPtr makeRequest(Common::Redis::RespValuePtr&& request, SplitCallbacks& callbacks,
@@ -384,6 +418,11 @@ private:
   void addHandler(Stats::Scope& scope, const std::string& stat_prefix, const std::string& name,
                   bool latency_in_micros, CommandHandler& handler);
   void onInvalidRequest(SplitCallbacks& callbacks);
+  // Serves the GET of a cached key from the near cache if it is cached, returning true, and
+  // otherwise returns the request caching its response. Evicts the cached keys written to.
+  bool serveFromNearCache(const std::string& command_name, const Common::Redis::RespValue& request,
+                          bool faulted, SplitCallbacks& callbacks, CommandStats& command_stats,
+                          std::unique_ptr<NearCacheRequest>& near_cache_request);
 
   RouterPtr router_;
   CommandHandlerFactory<SimpleRequest> simple_command_handler_;
@@ -396,6 +435,7 @@ private:
   InstanceStats stats_;
   TimeSource& time_source_;
   Common::Redis::FaultManagerPtr fault_manager_;
+  const NearCacheSharedPtr near_cache_;
 };
 
 } // namespace CommandSplitter
@@ -8,6 +8,7 @@
 #include "source/extensions/filters/network/common/redis/client_impl.h"
 #include "source/extensions/filters/network/common/redis/fault_impl.h"
 #include "source/extensions/filters/network/redis_proxy/command_splitter_impl.h"
+#include "source/extensions/filters/network/redis_proxy/near_cache.h"
 #include "source/extensions/filters/network/redis_proxy/proxy_filter.h"
 #include "source/extensions/filters/network/redis_proxy/router_impl.h"
 
@@ -90,10 +91,18 @@ Network::FilterFactoryCb RedisProxyFilterConfigFactory::createFilterFactoryFromP
   auto fault_manager = std::make_unique<Common::Redis::FaultManagerImpl>(
       server_context.api().randomGenerator(), server_context.runtime(), proto_config.faults());
 
+  NearCacheSharedPtr near_cache;
+  if (proto_config.has_near_cache()) {
+    near_cache =
+        std::make_shared<NearCache>(proto_config.near_cache(), context.scope(),
+                                    filter_config->stat_prefix_, server_context.timeSource());
+  }
+
   std::shared_ptr<CommandSplitter::Instance> splitter =
       std::make_shared<CommandSplitter::InstanceImpl>(
           std::move(router), context.scope(), filter_config->stat_prefix_,
-          server_context.timeSource(), proto_config.latency_in_micros(), std::move(fault_manager));
+          server_context.timeSource(), proto_config.latency_in_micros(), std::move(fault_manager),
+          std::move(near_cache));
   return [splitter, filter_config](Network::FilterManager& filter_manager) -> void {
     Common::Redis::DecoderFactoryImpl factory;
     filter_manager.addReadFilter(std::make_shared<ProxyFilter>(
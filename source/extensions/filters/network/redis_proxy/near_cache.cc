@@ -0,0 +1,122 @@
+#include "source/extensions/filters/network/redis_proxy/near_cache.h"
+
+#include "source/common/protobuf/utility.h"
+
+#include "absl/strings/match.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace NetworkFilters {
+namespace RedisProxy {
+namespace {
+
+constexpr uint64_t DefaultMaxBytes = 16 * 1024 * 1024;
+
+} // namespace
+
+NearCache::NearCache(
+    const envoy::extensions::filters::network::redis_proxy::v3::RedisProxy::NearCache& config,
+    Stats::Scope& scope, const std::string& stat_prefix, TimeSource& time_source)
+    : key_prefixes_(config.key_prefixes().begin(), config.key_prefixes().end()),
+      ttl_(PROTOBUF_GET_MS_REQUIRED(config, ttl)),
+      max_bytes_(PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, max_bytes, DefaultMaxBytes)),
+      stats_{ALL_NEAR_CACHE_STATS(POOL_COUNTER_PREFIX(scope, stat_prefix + "near_cache."),
+                                  POOL_GAUGE_PREFIX(scope, stat_prefix + "near_cache."))},
+      time_source_(time_source) {}
+
+bool NearCache::cacheable(absl::string_view key) const {
+  for (const std::string& prefix : key_prefixes_) {
+    if (absl::StartsWith(key, prefix)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+Common::Redis::RespValuePtr NearCache::lookup(const std::string& key) {
+  const MonotonicTime now = time_source_.monotonicTime();
+  absl::MutexLock lock(&mutex_);
+  auto it = entries_.find(key);
+  if (it == entries_.end()) {
+    stats_.miss_.inc();
+    return nullptr;
+  }
+  if (it->second.expiry_ <= now) {
+    erase(it);
+    stats_.miss_.inc();
+    return nullptr;
+  }
+  stats_.hit_.inc();
+  return std::make_unique<Common::Redis::RespValue>(it->second.value_);
+}
+
+uint64_t NearCache::generation() const {
+  absl::MutexLock lock(&mutex_);
+  return generation_;
+}
+
+void NearCache::insert(const std::string& key, const Common::Redis::RespValue& value,
+                       uint64_t generation) {
+  if (value.type() != Common::Redis::RespType::BulkString &&
+      value.type() != Common::Redis::RespType::Null) {
+    return;
+  }
+  const uint64_t bytes = key.size() + (value.type() == Common::Redis::RespType::BulkString
+                                           ? value.asString().size()
+                                           : 0);
+  if (bytes > max_bytes_) {
+    return;
+  }
+  const MonotonicTime now = time_source_.monotonicTime();
+  absl::MutexLock lock(&mutex_);
+  if (generation != generation_) {
+    return;
+  }
+  if (auto it = entries_.find(key); it != entries_.end()) {
+    erase(it);
+  }
+  makeRoom(bytes, now);
+  entries_.emplace(key, Entry{value, now + ttl_, bytes});
+  bytes_ += bytes;
+  stats_.bytes_.set(bytes_);
+  stats_.entries_.set(entries_.size());
+}
+
+void NearCache::invalidate(const std::string& key) {
+  absl::MutexLock lock(&mutex_);
+  // The reads in flight may have been served before the write, so none of them is cached.
+  generation_++;
+  if (auto it = entries_.find(key); it != entries_.end()) {
+    erase(it);
+    stats_.invalidation_.inc();
+  }
+}
+
+void NearCache::erase(EntryMap::iterator it) {
+  bytes_ -= it->second.bytes_;
+  entries_.erase(it);
+  stats_.bytes_.set(bytes_);
+  stats_.entries_.set(entries_.size());
+}
+
+void NearCache::makeRoom(uint64_t bytes, MonotonicTime now) {
+  if (bytes_ + bytes <= max_bytes_) {
+    return;
+  }
+  for (auto it = entries_.begin(); it != entries_.end();) {
+    if (it->second.expiry_ <= now) {
+      erase(it++);
+    } else {
+      ++it;
+    }
+  }
+  while (bytes_ + bytes > max_bytes_) {
+    erase(entries_.begin());
+    stats_.eviction_.inc();
+  }
+}
+
+} // namespace RedisProxy
+} // namespace NetworkFilters
+} // namespace Extensions
+} // namespace Envoy
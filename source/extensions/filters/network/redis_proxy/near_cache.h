@@ -0,0 +1,110 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "envoy/common/time.h"
+#include "envoy/extensions/filters/network/redis_proxy/v3/redis_proxy.pb.h"
+#include "envoy/stats/scope.h"
+#include "envoy/stats/stats_macros.h"
+
+#include "source/extensions/filters/network/common/redis/codec.h"
+
+#include "absl/base/thread_annotations.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/synchronization/mutex.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace NetworkFilters {
+namespace RedisProxy {
+
+/**
+ * All near cache stats. @see stats_macros.h
+ */
+#define ALL_NEAR_CACHE_STATS(COUNTER, GAUGE)                                                       \
+  COUNTER(eviction)                                                                                \
+  COUNTER(hit)                                                                                     \
+  COUNTER(invalidation)                                                                            \
+  COUNTER(miss)                                                                                    \
+  GAUGE(bytes, NeverImport)                                                                        \
+  GAUGE(entries, NeverImport)
+
+/**
+ * Struct definition for all near cache stats. @see stats_macros.h
+ */
+struct NearCacheStats {
+  ALL_NEAR_CACHE_STATS(GENERATE_COUNTER_STRUCT, GENERATE_GAUGE_STRUCT)
+};
+
+/**
+ * A cache of the values of the keys with the configured prefixes, shared by the workers. The
+ * values are cached for the configured TTL, or until a write to their key invalidates them.
+ */
+class NearCache {
+public:
+  NearCache(
+      const envoy::extensions::filters::network::redis_proxy::v3::RedisProxy::NearCache& config,
+      Stats::Scope& scope, const std::string& stat_prefix, TimeSource& time_source);
+
+  /**
+   * @return whether the values of the key are cached.
+   */
+  bool cacheable(absl::string_view key) const;
+
+  /**
+   * @return a copy of the cached value of the key, or nullptr if none is cached or it expired.
+   */
+  Common::Redis::RespValuePtr lookup(const std::string& key) ABSL_LOCKS_EXCLUDED(mutex_);
+
+  /**
+   * @return the number of invalidations so far, to be passed to insert() with the value read
+   * after it.
+   */
+  uint64_t generation() const ABSL_LOCKS_EXCLUDED(mutex_);
+
+  /**
+   * Caches the value of a key read after the given generation, unless a key was invalidated
+   * since, in which case the value may predate the write. Only bulk strings and nulls are cached.
+   */
+  void insert(const std::string& key, const Common::Redis::RespValue& value, uint64_t generation)
+      ABSL_LOCKS_EXCLUDED(mutex_);
+
+  /**
+   * Evicts the value of a key being written to.
+   */
+  void invalidate(const std::string& key) ABSL_LOCKS_EXCLUDED(mutex_);
+
+private:
+  struct Entry {
+    Common::Redis::RespValue value_;
+    MonotonicTime expiry_;
+    uint64_t bytes_;
+  };
+  using EntryMap = absl::flat_hash_map<std::string, Entry>;
+
+  void erase(EntryMap::iterator it) ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+  // Makes room for an entry of the given size, first by evicting the expired entries, then
+  // arbitrary ones.
+  void makeRoom(uint64_t bytes, MonotonicTime now) ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+
+  const std::vector<std::string> key_prefixes_;
+  const std::chrono::milliseconds ttl_;
+  const uint64_t max_bytes_;
+  NearCacheStats stats_;
+  TimeSource& time_source_;
+  mutable absl::Mutex mutex_;
+  EntryMap entries_ ABSL_GUARDED_BY(mutex_);
+  uint64_t bytes_ ABSL_GUARDED_BY(mutex_){};
+  uint64_t generation_ ABSL_GUARDED_BY(mutex_){};
+};
+
+using NearCacheSharedPtr = std::shared_ptr<NearCache>;
+
+} // namespace RedisProxy
+} // namespace NetworkFilters
+} // namespace Extensions
+} // namespace Envoy
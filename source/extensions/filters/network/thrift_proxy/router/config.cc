@@ -4,6 +4,7 @@
 #include "envoy/extensions/filters/network/thrift_proxy/router/v3/router.pb.validate.h"
 #include "envoy/registry/registry.h"
 
+#include "source/extensions/filters/network/thrift_proxy/router/multiplexed_conn_pool.h"
 #include "source/extensions/filters/network/thrift_proxy/router/router_impl.h"
 #include "source/extensions/filters/network/thrift_proxy/router/shadow_writer_impl.h"
 
@@ -12,6 +13,11 @@ namespace Extensions {
 namespace NetworkFilters {
 namespace ThriftProxy {
 namespace Router {
+namespace {
+
+constexpr uint32_t DefaultMaxRequestsPerConnection = 100;
+
+} // namespace
 
 ThriftFilters::FilterFactoryCb RouterFilterConfig::createFilterFactoryFromProtoTyped(
     const envoy::extensions::filters::network::thrift_proxy::router::v3::Router& proto_config,
@@ -25,12 +31,20 @@ ThriftFilters::FilterFactoryCb RouterFilterConfig::createFilterFactoryFromProtoT
                                                           server_context.threadLocal());
   bool close_downstream_on_error =
       PROTOBUF_GET_WRAPPED_OR_DEFAULT(proto_config, close_downstream_on_upstream_error, true);
-
-  return [&context, stats, shadow_writer, close_downstream_on_error](
-             ThriftFilters::FilterChainFactoryCallbacks& callbacks) -> void {
+  MultiplexedConnPoolsSharedPtr multiplexed_conn_pools;
+  if (proto_config.has_multiplexing()) {
+    const uint32_t max_requests_per_connection = PROTOBUF_GET_WRAPPED_OR_DEFAULT(
+        proto_config.multiplexing(), max_requests_per_connection, DefaultMaxRequestsPerConnection);
+    multiplexed_conn_pools = std::make_shared<MultiplexedConnPools>(server_context.threadLocal(),
+                                                                    max_requests_per_connection);
+  }
+
+  return [&context, stats, shadow_writer, close_downstream_on_error,
+          multiplexed_conn_pools](ThriftFilters::FilterChainFactoryCallbacks& callbacks) -> void {
     callbacks.addDecoderFilter(std::make_shared<Router>(
         context.serverFactoryContext().clusterManager(), *stats,
-        context.serverFactoryContext().runtime(), *shadow_writer, close_downstream_on_error));
+        context.serverFactoryContext().runtime(), *shadow_writer, close_downstream_on_error,
+        multiplexed_conn_pools.get()));
   };
 }
 
@@ -0,0 +1,318 @@
+#include "source/extensions/filters/network/thrift_proxy/router/multiplexed_conn_pool.h"
+
+#include <algorithm>
+#include <string>
+
+#include "source/common/common/thread.h"
+#include "source/extensions/filters/network/thrift_proxy/header_transport_impl.h"
+#include "source/extensions/filters/network/thrift_proxy/metadata.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace NetworkFilters {
+namespace ThriftProxy {
+namespace Router {
+namespace {
+
+// The size prefixing the frames of the framed and header transports.
+constexpr uint64_t FrameSizeLength = 4;
+// The sequence id of a response is decoded from the beginning of its frame, unless its headers
+// are longer.
+constexpr uint64_t DecodedFramePrefixSize = 256;
+
+} // namespace
+
+MultiplexedConnection::MultiplexedConnection(TransportType transport_type,
+                                             ProtocolType protocol_type, uint32_t max_requests,
+                                             ClosedCb closed_cb)
+    : max_requests_(max_requests), closed_cb_(std::move(closed_cb)),
+      transport_(NamedTransportConfigFactory::getFactory(transport_type).createTransport()),
+      protocol_(NamedProtocolConfigFactory::getFactory(protocol_type).createProtocol()) {}
+
+MultiplexedConnection::~MultiplexedConnection() {
+  if (conn_pool_handle_ != nullptr) {
+    conn_pool_handle_->cancel(ConnectionPool::CancelPolicy::Default);
+  }
+  if (conn_data_ != nullptr) {
+    // Responses to abandoned requests may still be on their way, so the connection can't be
+    // reused. It is released first so that its closure isn't reported to this connection.
+    Network::ClientConnection& connection = conn_data_->connection();
+    conn_data_.reset();
+    connection.close(Network::ConnectionCloseType::NoFlush);
+  }
+}
+
+void MultiplexedConnection::connect(Upstream::TcpPoolData& pool_data) {
+  upstream_host_ = pool_data.host();
+  Tcp::ConnectionPool::Cancellable* handle = pool_data.newConnection(*this);
+  if (handle != nullptr) {
+    conn_pool_handle_ = handle;
+  }
+}
+
+Tcp::ConnectionPool::Cancellable*
+MultiplexedConnection::newStream(Tcp::ConnectionPool::Callbacks& callbacks) {
+  ASSERT(!closed_);
+  if (conn_data_ != nullptr) {
+    onReady(callbacks);
+    return nullptr;
+  }
+  auto stream = std::make_unique<PendingStream>(*this, callbacks);
+  Tcp::ConnectionPool::Cancellable* handle = stream.get();
+  LinkedList::moveIntoListBack(std::move(stream), pending_);
+  return handle;
+}
+
+void MultiplexedConnection::drain() {
+  ENVOY_LOG(debug, "draining multiplexed connection with {} requests", attached_.size());
+  draining_ = true;
+  closeIfIdle();
+}
+
+void MultiplexedConnection::attach(MultiplexedConnectionData& stream) { attached_.insert(&stream); }
+
+void MultiplexedConnection::detach(MultiplexedConnectionData& stream) {
+  attached_.erase(&stream);
+  if (stream.sequenceId().has_value()) {
+    auto it = streams_.find(stream.sequenceId().value());
+    if (it != streams_.end() && it->second == &stream) {
+      streams_.erase(it);
+    }
+  }
+  closeIfIdle();
+}
+
+void MultiplexedConnection::setSequenceId(MultiplexedConnectionData& stream,
+                                          int32_t sequence_id) {
+  streams_[sequence_id] = &stream;
+}
+
+void MultiplexedConnection::onPoolFailure(ConnectionPool::PoolFailureReason reason,
+                                          absl::string_view transport_failure_reason,
+                                          Upstream::HostDescriptionConstSharedPtr host) {
+  conn_pool_handle_ = nullptr;
+  if (host != nullptr) {
+    upstream_host_ = std::move(host);
+  }
+  onClosed(reason, transport_failure_reason);
+}
+
+void MultiplexedConnection::onPoolReady(Tcp::ConnectionPool::ConnectionDataPtr&& conn_data,
+                                        Upstream::HostDescriptionConstSharedPtr host) {
+  conn_pool_handle_ = nullptr;
+  upstream_host_ = std::move(host);
+  conn_data_ = std::move(conn_data);
+  conn_data_->addUpstreamCallbacks(*this);
+  if (conn_data_->connectionStateTyped<ThriftConnectionState>() == nullptr) {
+    conn_data_->setConnectionState(std::make_unique<ThriftConnectionState>());
+  }
+
+  // The requests may close the connection while it is handed to them.
+  const MultiplexedConnectionSharedPtr self = shared_from_this();
+  while (!pending_.empty() && !closed_) {
+    PendingStreamPtr stream = pending_.front()->removeFromList(pending_);
+    onReady(stream->callbacks_);
+  }
+}
+
+void MultiplexedConnection::onReady(Tcp::ConnectionPool::Callbacks& callbacks) {
+  callbacks.onPoolReady(std::make_unique<MultiplexedConnectionData>(shared_from_this()),
+                        upstream_host_);
+}
+
+void MultiplexedConnection::onUpstreamData(Buffer::Instance& data, bool end_stream) {
+  // The requests may close the connection while their responses are dispatched to them.
+  const MultiplexedConnectionSharedPtr self = shared_from_this();
+  response_buffer_.move(data);
+  while (response_buffer_.length() >= FrameSizeLength && !closed_) {
+    const int32_t size = response_buffer_.peekBEInt<int32_t>();
+    if (size <= 0 || size > HeaderTransportImpl::MaxFrameSize) {
+      ENVOY_LOG(debug, "closing multiplexed connection on invalid frame size {}", size);
+      conn_data_->connection().close(Network::ConnectionCloseType::NoFlush);
+      return;
+    }
+    if (response_buffer_.length() < FrameSizeLength + size) {
+      break;
+    }
+
+    Buffer::OwnedImpl frame;
+    frame.move(response_buffer_, FrameSizeLength + size);
+    const absl::optional<int32_t> sequence_id = decodeSequenceId(frame);
+    if (!sequence_id.has_value()) {
+      conn_data_->connection().close(Network::ConnectionCloseType::NoFlush);
+      return;
+    }
+    auto it = streams_.find(sequence_id.value());
+    if (it == streams_.end()) {
+      ENVOY_LOG(debug, "dropping response with sequence id {} with no request",
+                sequence_id.value());
+      continue;
+    }
+    // A request gets a single response.
+    MultiplexedConnectionData& stream = *it->second;
+    streams_.erase(it);
+    if (stream.callbacks() != nullptr) {
+      stream.callbacks()->onUpstreamData(frame, false);
+    }
+  }
+
+  if (end_stream && !closed_) {
+    ENVOY_LOG(debug, "closing multiplexed connection on upstream end of stream");
+    conn_data_->connection().close(Network::ConnectionCloseType::NoFlush);
+  }
+}
+
+void MultiplexedConnection::onEvent(Network::ConnectionEvent event) {
+  if (event != Network::ConnectionEvent::RemoteClose &&
+      event != Network::ConnectionEvent::LocalClose) {
+    return;
+  }
+  const MultiplexedConnectionSharedPtr self = shared_from_this();
+  ENVOY_LOG(debug, "multiplexed connection closed with {} requests", attached_.size());
+  onClosed(event == Network::ConnectionEvent::RemoteClose
+               ? ConnectionPool::PoolFailureReason::RemoteConnectionFailure
+               : ConnectionPool::PoolFailureReason::LocalConnectionFailure,
+           "");
+
+  // The requests release their connections when told, which detaches them.
+  std::vector<MultiplexedConnectionData*> streams(attached_.begin(), attached_.end());
+  for (MultiplexedConnectionData* stream : streams) {
+    if (attached_.contains(stream) && stream->callbacks() != nullptr) {
+      stream->callbacks()->onEvent(event);
+    }
+  }
+  conn_data_.reset();
+}
+
+void MultiplexedConnection::onAboveWriteBufferHighWatermark() {
+  for (MultiplexedConnectionData* stream : attached_) {
+    if (stream->callbacks() != nullptr) {
+      stream->callbacks()->onAboveWriteBufferHighWatermark();
+    }
+  }
+}
+
+void MultiplexedConnection::onBelowWriteBufferLowWatermark() {
+  for (MultiplexedConnectionData* stream : attached_) {
+    if (stream->callbacks() != nullptr) {
+      stream->callbacks()->onBelowWriteBufferLowWatermark();
+    }
+  }
+}
+
+void MultiplexedConnection::onClosed(ConnectionPool::PoolFailureReason reason,
+                                     absl::string_view failure_reason) {
+  if (closed_) {
+    return;
+  }
+  const MultiplexedConnectionSharedPtr self = shared_from_this();
+  closed_ = true;
+  closed_cb_(*this);
+  while (!pending_.empty()) {
+    PendingStreamPtr stream = pending_.front()->removeFromList(pending_);
+    stream->callbacks_.onPoolFailure(reason, failure_reason, upstream_host_);
+  }
+}
+
+void MultiplexedConnection::closeIfIdle() {
+  if (draining_ && !closed_ && conn_data_ != nullptr && attached_.empty() && pending_.empty()) {
+    ENVOY_LOG(debug, "closing drained multiplexed connection");
+    conn_data_->connection().close(Network::ConnectionCloseType::NoFlush);
+  }
+}
+
+absl::optional<int32_t> MultiplexedConnection::decodeSequenceId(const Buffer::Instance& frame) {
+  uint64_t prefix_size = std::min(frame.length(), DecodedFramePrefixSize);
+  while (true) {
+    std::string prefix_data(prefix_size, '\0');
+    frame.copyOut(0, prefix_size, prefix_data.data());
+    Buffer::OwnedImpl prefix(prefix_data);
+    MessageMetadata metadata;
+    TRY_NEEDS_AUDIT {
+      // The header transport carries the sequence id in its headers.
+      if (transport_->decodeFrameStart(prefix, metadata) &&
+          (metadata.hasSequenceId() || protocol_->readMessageBegin(prefix, metadata))) {
+        return metadata.sequenceId();
+      }
+    }
+    END_TRY catch (const EnvoyException& ex) {
+      ENVOY_LOG(debug, "failed to decode the sequence id of a response: {}", ex.what());
+      return absl::nullopt;
+    }
+    if (prefix_size == frame.length()) {
+      ENVOY_LOG(debug, "failed to decode the sequence id of a response");
+      return absl::nullopt;
+    }
+    prefix_size = frame.length();
+  }
+}
+
+MultiplexedConnectionData::MultiplexedConnectionData(MultiplexedConnectionSharedPtr connection)
+    : connection_(std::move(connection)) {
+  connection_->attach(*this);
+}
+
+MultiplexedConnPools::MultiplexedConnPools(ThreadLocal::SlotAllocator& tls,
+                                           uint32_t max_requests_per_connection)
+    : max_requests_per_connection_(max_requests_per_connection), tls_(tls) {
+  tls_.set([](Event::Dispatcher&) { return std::make_shared<ThreadLocalPools>(); });
+}
+
+bool MultiplexedConnPools::supported(TransportType transport_type, ProtocolType protocol_type) {
+  // The twitter protocol upgrades the connection, which can't be done under other requests.
+  return (transport_type == TransportType::Framed || transport_type == TransportType::Header) &&
+         protocol_type != ProtocolType::Twitter;
+}
+
+Tcp::ConnectionPool::Cancellable*
+MultiplexedConnPools::newConnection(Upstream::TcpPoolData& pool_data, TransportType transport_type,
+                                    ProtocolType protocol_type,
+                                    Tcp::ConnectionPool::Callbacks& callbacks) {
+  ASSERT(supported(transport_type, protocol_type));
+  const Key key{pool_data.host().get(), transport_type, protocol_type};
+  std::vector<MultiplexedConnectionSharedPtr>& connections = tls_->connections_[key];
+  for (const MultiplexedConnectionSharedPtr& connection : connections) {
+    if (connection->available()) {
+      return connection->newStream(callbacks);
+    }
+  }
+
+  // A closed connection removes itself from the pools, if they are still around.
+  std::weak_ptr<ThreadLocalPools> weak_pools = tls_->shared_from_this();
+  auto connection = std::make_shared<MultiplexedConnection>(
+      transport_type, protocol_type, max_requests_per_connection_,
+      [weak_pools, key](MultiplexedConnection& closed) {
+        std::shared_ptr<ThreadLocalPools> pools = weak_pools.lock();
+        if (pools == nullptr) {
+          return;
+        }
+        auto it = pools->connections_.find(key);
+        if (it == pools->connections_.end()) {
+          return;
+        }
+        auto& connections = it->second;
+        auto closed_it =
+            std::find_if(connections.begin(), connections.end(),
+                         [&closed](const MultiplexedConnectionSharedPtr& connection) {
+                           return connection.get() == &closed;
+                         });
+        if (closed_it != connections.end()) {
+          connections.erase(closed_it);
+        }
+        if (connections.empty()) {
+          pools->connections_.erase(it);
+        }
+      });
+  connections.push_back(connection);
+  // The request is pending before the connection is opened, since the pool may be done with it
+  // right away.
+  Tcp::ConnectionPool::Cancellable* handle = connection->newStream(callbacks);
+  connection->connect(pool_data);
+  return connection->connecting() ? handle : nullptr;
+}
+
+} // namespace Router
+} // namespace ThriftProxy
+} // namespace NetworkFilters
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,220 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <memory>
+#include <tuple>
+#include <vector>
+
+#include "envoy/tcp/conn_pool.h"
+#include "envoy/thread_local/thread_local.h"
+#include "envoy/upstream/thread_local_cluster.h"
+
+#include "source/common/buffer/buffer_impl.h"
+#include "source/common/common/linked_object.h"
+#include "source/common/common/logger.h"
+#include "source/extensions/filters/network/thrift_proxy/conn_state.h"
+#include "source/extensions/filters/network/thrift_proxy/protocol.h"
+#include "source/extensions/filters/network/thrift_proxy/thrift.h"
+#include "source/extensions/filters/network/thrift_proxy/transport.h"
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/container/flat_hash_set.h"
+#include "absl/types/optional.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace NetworkFilters {
+namespace ThriftProxy {
+namespace Router {
+
+class MultiplexedConnectionData;
+
+/**
+ * An upstream connection shared by the requests to a host, each of which is identified on it by
+ * its sequence id. The connection is only shared with the framed and header transports, whose
+ * frames are prefixed by their size, so that the responses can be told apart and dispatched to
+ * their requests by sequence id.
+ */
+class MultiplexedConnection : public Tcp::ConnectionPool::Callbacks,
+                              public Tcp::ConnectionPool::UpstreamCallbacks,
+                              public std::enable_shared_from_this<MultiplexedConnection>,
+                              Logger::Loggable<Logger::Id::thrift> {
+public:
+  using ClosedCb = std::function<void(MultiplexedConnection&)>;
+
+  MultiplexedConnection(TransportType transport_type, ProtocolType protocol_type,
+                        uint32_t max_requests, ClosedCb closed_cb);
+  ~MultiplexedConnection() override;
+
+  /**
+   * Opens the connection from the pool.
+   */
+  void connect(Upstream::TcpPoolData& pool_data);
+
+  /**
+   * Hands the connection to the callbacks of a request, once it is ready.
+   * @return a handle to cancel the pending request, or nullptr if the callbacks were invoked.
+   */
+  Tcp::ConnectionPool::Cancellable* newStream(Tcp::ConnectionPool::Callbacks& callbacks);
+
+  /**
+   * Stops the connection from taking new requests, and closes it once the requests in flight are
+   * done.
+   */
+  void drain();
+
+  /**
+   * @return true if the connection takes new requests.
+   */
+  bool available() const {
+    return !draining_ && !closed_ && attached_.size() + pending_.size() < max_requests_;
+  }
+  bool connecting() const { return conn_pool_handle_ != nullptr; }
+  bool closed() const { return closed_; }
+
+  void attach(MultiplexedConnectionData& stream);
+  void detach(MultiplexedConnectionData& stream);
+  void setSequenceId(MultiplexedConnectionData& stream, int32_t sequence_id);
+  Tcp::ConnectionPool::ConnectionData& connectionData() { return *conn_data_; }
+
+  // Tcp::ConnectionPool::Callbacks
+  void onPoolFailure(ConnectionPool::PoolFailureReason reason,
+                     absl::string_view transport_failure_reason,
+                     Upstream::HostDescriptionConstSharedPtr host) override;
+  void onPoolReady(Tcp::ConnectionPool::ConnectionDataPtr&& conn_data,
+                   Upstream::HostDescriptionConstSharedPtr host) override;
+
+  // Tcp::ConnectionPool::UpstreamCallbacks
+  void onUpstreamData(Buffer::Instance& data, bool end_stream) override;
+  void onEvent(Network::ConnectionEvent event) override;
+  void onAboveWriteBufferHighWatermark() override;
+  void onBelowWriteBufferLowWatermark() override;
+
+private:
+  struct PendingStream : public Tcp::ConnectionPool::Cancellable,
+                         public LinkedObject<PendingStream> {
+    PendingStream(MultiplexedConnection& parent, Tcp::ConnectionPool::Callbacks& callbacks)
+        : parent_(parent), callbacks_(callbacks) {}
+
+    // Tcp::ConnectionPool::Cancellable
+    void cancel(ConnectionPool::CancelPolicy) override { removeFromList(parent_.pending_); }
+
+    MultiplexedConnection& parent_;
+    Tcp::ConnectionPool::Callbacks& callbacks_;
+  };
+  using PendingStreamPtr = std::unique_ptr<PendingStream>;
+
+  void onReady(Tcp::ConnectionPool::Callbacks& callbacks);
+  void onClosed(ConnectionPool::PoolFailureReason reason, absl::string_view failure_reason);
+  void closeIfIdle();
+  // Returns the sequence id of the response in the frame, or nullopt if it can't be decoded.
+  absl::optional<int32_t> decodeSequenceId(const Buffer::Instance& frame);
+
+  const uint32_t max_requests_;
+  const ClosedCb closed_cb_;
+  TransportPtr transport_;
+  ProtocolPtr protocol_;
+  Tcp::ConnectionPool::Cancellable* conn_pool_handle_{};
+  Tcp::ConnectionPool::ConnectionDataPtr conn_data_;
+  Upstream::HostDescriptionConstSharedPtr upstream_host_;
+  std::list<PendingStreamPtr> pending_;
+  // The requests that were handed the connection, and those of them which were assigned a
+  // sequence id.
+  absl::flat_hash_set<MultiplexedConnectionData*> attached_;
+  absl::flat_hash_map<int32_t, MultiplexedConnectionData*> streams_;
+  Buffer::OwnedImpl response_buffer_;
+  bool draining_{};
+  bool closed_{};
+};
+
+using MultiplexedConnectionSharedPtr = std::shared_ptr<MultiplexedConnection>;
+
+/**
+ * The connection handed to a request multiplexed over a shared connection. The connection state,
+ * and so the sequence ids, are those of the shared connection.
+ */
+class MultiplexedConnectionData : public Tcp::ConnectionPool::ConnectionData {
+public:
+  explicit MultiplexedConnectionData(MultiplexedConnectionSharedPtr connection);
+  ~MultiplexedConnectionData() override { connection_->detach(*this); }
+
+  /**
+   * Dispatches the response with the sequence id to the request.
+   */
+  void setSequenceId(int32_t sequence_id) {
+    sequence_id_ = sequence_id;
+    connection_->setSequenceId(*this, sequence_id);
+  }
+  const absl::optional<int32_t>& sequenceId() const { return sequence_id_; }
+
+  /**
+   * Drains the shared connection, instead of closing it under the other requests.
+   */
+  void drain() { connection_->drain(); }
+
+  Tcp::ConnectionPool::UpstreamCallbacks* callbacks() const { return callbacks_; }
+
+  // Tcp::ConnectionPool::ConnectionData
+  Network::ClientConnection& connection() override {
+    return connection_->connectionData().connection();
+  }
+  const Network::Socket* socket() override { return connection_->connectionData().socket(); }
+  void addUpstreamCallbacks(Tcp::ConnectionPool::UpstreamCallbacks& callbacks) override {
+    callbacks_ = &callbacks;
+  }
+  void setConnectionState(Tcp::ConnectionPool::ConnectionStatePtr&& state) override {
+    connection_->connectionData().setConnectionState(std::move(state));
+  }
+  Tcp::ConnectionPool::ConnectionState* connectionState() override {
+    return connection_->connectionData().connectionState();
+  }
+
+private:
+  const MultiplexedConnectionSharedPtr connection_;
+  Tcp::ConnectionPool::UpstreamCallbacks* callbacks_{};
+  absl::optional<int32_t> sequence_id_;
+};
+
+/**
+ * The shared upstream connections of the workers, by host, transport and protocol. A host gets
+ * another connection when its connections have as many requests in flight as they may carry.
+ */
+class MultiplexedConnPools {
+public:
+  MultiplexedConnPools(ThreadLocal::SlotAllocator& tls, uint32_t max_requests_per_connection);
+
+  /**
+   * @return true if the requests with the transport and protocol can be multiplexed.
+   */
+  static bool supported(TransportType transport_type, ProtocolType protocol_type);
+
+  /**
+   * Hands a connection to the host of the pool to the callbacks, as Tcp::ConnectionPool does.
+   * @return a handle to cancel the pending request, or nullptr if the callbacks were invoked.
+   */
+  Tcp::ConnectionPool::Cancellable* newConnection(Upstream::TcpPoolData& pool_data,
+                                                  TransportType transport_type,
+                                                  ProtocolType protocol_type,
+                                                  Tcp::ConnectionPool::Callbacks& callbacks);
+
+private:
+  using Key = std::tuple<const Upstream::HostDescription*, TransportType, ProtocolType>;
+
+  struct ThreadLocalPools : public ThreadLocal::ThreadLocalObject,
+                            public std::enable_shared_from_this<ThreadLocalPools> {
+    absl::flat_hash_map<Key, std::vector<MultiplexedConnectionSharedPtr>> connections_;
+  };
+
+  const uint32_t max_requests_per_connection_;
+  ThreadLocal::TypedSlot<ThreadLocalPools> tls_;
+};
+
+using MultiplexedConnPoolsSharedPtr = std::shared_ptr<MultiplexedConnPools>;
+
+} // namespace Router
+} // namespace ThriftProxy
+} // namespace NetworkFilters
+} // namespace Extensions
+} // namespace Envoy
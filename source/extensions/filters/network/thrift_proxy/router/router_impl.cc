@@ -244,8 +244,8 @@ RouteConstSharedPtr RouteMatcher::route(const MessageMetadata& metadata,
 
 void Router::onDestroy() {
   if (upstream_request_ != nullptr) {
-    ENVOY_LOG(debug, "router on destroy reset stream");
-    upstream_request_->resetStream();
+    ENVOY_LOG(debug, "router on destroy abandon stream");
+    upstream_request_->abandonStream();
     cleanup();
   }
 
@@ -332,7 +332,7 @@ FilterStatus Router::messageBegin(MessageMetadataSharedPtr metadata) {
 
   upstream_request_ = std::make_unique<UpstreamRequest>(
       *this, *upstream_req_info.conn_pool_data, metadata, upstream_req_info.transport,
-      upstream_req_info.protocol, close_downstream_on_error_);
+      upstream_req_info.protocol, close_downstream_on_error_, multiplexed_conn_pools_);
   return upstream_request_->start();
 }
 
@@ -14,6 +14,7 @@
 #include "source/common/upstream/load_balancer_context_base.h"
 #include "source/extensions/filters/network/thrift_proxy/conn_manager.h"
 #include "source/extensions/filters/network/thrift_proxy/filters/filter.h"
+#include "source/extensions/filters/network/thrift_proxy/router/multiplexed_conn_pool.h"
 #include "source/extensions/filters/network/thrift_proxy/router/router.h"
 #include "source/extensions/filters/network/thrift_proxy/router/router_ratelimit_impl.h"
 #include "source/extensions/filters/network/thrift_proxy/router/upstream_request.h"
@@ -230,9 +231,11 @@ class Router : public Tcp::ConnectionPool::UpstreamCallbacks,
                public ThriftFilters::DecoderFilter {
 public:
   Router(Upstream::ClusterManager& cluster_manager, const RouterStats& stats,
-         Runtime::Loader& runtime, ShadowWriter& shadow_writer, bool close_downstream_on_error)
+         Runtime::Loader& runtime, ShadowWriter& shadow_writer, bool close_downstream_on_error,
+         MultiplexedConnPools* multiplexed_conn_pools = nullptr)
       : RequestOwner(cluster_manager, stats), passthrough_supported_(false), runtime_(runtime),
-        shadow_writer_(shadow_writer), close_downstream_on_error_(close_downstream_on_error) {}
+        shadow_writer_(shadow_writer), close_downstream_on_error_(close_downstream_on_error),
+        multiplexed_conn_pools_(multiplexed_conn_pools) {}
 
   ~Router() override = default;
 
@@ -336,6 +339,7 @@ private:
   std::vector<std::reference_wrapper<ShadowRouterHandle>> shadow_routers_{};
 
   bool close_downstream_on_error_;
+  MultiplexedConnPools* const multiplexed_conn_pools_;
 };
 
 } // namespace Router
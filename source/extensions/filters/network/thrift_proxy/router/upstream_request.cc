@@ -10,8 +10,13 @@ namespace Router {
 
 UpstreamRequest::UpstreamRequest(RequestOwner& parent, Upstream::TcpPoolData& pool_data,
                                  MessageMetadataSharedPtr& metadata, TransportType transport_type,
-                                 ProtocolType protocol_type, bool close_downstream_on_error)
-    : parent_(parent), stats_(parent.stats()), conn_pool_data_(pool_data), metadata_(metadata),
+                                 ProtocolType protocol_type, bool close_downstream_on_error,
+                                 MultiplexedConnPools* multiplexed_conn_pools)
+    : parent_(parent), stats_(parent.stats()), conn_pool_data_(pool_data),
+      multiplexed_conn_pools_(
+          MultiplexedConnPools::supported(transport_type, protocol_type) ? multiplexed_conn_pools
+                                                                         : nullptr),
+      metadata_(metadata),
       transport_(NamedTransportConfigFactory::getFactory(transport_type).createTransport()),
       protocol_(NamedProtocolConfigFactory::getFactory(protocol_type).createProtocol()),
       request_complete_(false), response_underflow_(false), charged_response_timing_(false),
@@ -24,7 +29,11 @@ UpstreamRequest::~UpstreamRequest() {
 }
 
 FilterStatus UpstreamRequest::start() {
-  Tcp::ConnectionPool::Cancellable* handle = conn_pool_data_.newConnection(*this);
+  Tcp::ConnectionPool::Cancellable* handle =
+      multiplexed_conn_pools_ != nullptr
+          ? multiplexed_conn_pools_->newConnection(conn_pool_data_, transport_->type(),
+                                                   protocol_->type(), *this)
+          : conn_pool_data_.newConnection(*this);
   if (handle) {
     // Pause while we wait for a connection.
     conn_pool_handle_ = handle;
@@ -56,7 +65,12 @@ void UpstreamRequest::releaseConnection(const bool close) {
   // closing.
   auto conn_data = std::move(conn_data_);
   if (close && conn_data != nullptr) {
-    conn_data->connection().close(Network::ConnectionCloseType::NoFlush);
+    if (multiplexed_conn_pools_ != nullptr) {
+      // The other requests on the shared connection are let complete.
+      static_cast<MultiplexedConnectionData&>(*conn_data).drain();
+    } else {
+      conn_data->connection().close(Network::ConnectionCloseType::NoFlush);
+    }
   }
 }
 
@@ -65,6 +79,12 @@ void UpstreamRequest::resetStream() {
   releaseConnection(true);
 }
 
+void UpstreamRequest::abandonStream() {
+  ENVOY_LOG(debug, "abandon stream");
+  // The response to the request is dropped by the shared connection when it arrives.
+  releaseConnection(multiplexed_conn_pools_ == nullptr);
+}
+
 void UpstreamRequest::onPoolFailure(ConnectionPool::PoolFailureReason reason, absl::string_view,
                                     Upstream::HostDescriptionConstSharedPtr host) {
   ENVOY_LOG(debug, "on pool failure");
@@ -256,7 +276,12 @@ void UpstreamRequest::onRequestStart(bool continue_decoding) {
   auto& buffer = parent_.buffer();
   parent_.initProtocolConverter(*protocol_, buffer);
 
-  metadata_->setSequenceId(conn_state_->nextSequenceId());
+  const int32_t sequence_id = conn_state_->nextSequenceId();
+  metadata_->setSequenceId(sequence_id);
+  if (multiplexed_conn_pools_ != nullptr) {
+    // The response is dispatched to the request by its sequence id.
+    static_cast<MultiplexedConnectionData&>(*conn_data_).setSequenceId(sequence_id);
+  }
   parent_.convertMessageBegin(metadata_);
 
   if (continue_decoding) {
@@ -7,6 +7,7 @@
 #include "source/extensions/filters/network/thrift_proxy/decoder_events.h"
 #include "source/extensions/filters/network/thrift_proxy/filters/filter.h"
 #include "source/extensions/filters/network/thrift_proxy/metadata.h"
+#include "source/extensions/filters/network/thrift_proxy/router/multiplexed_conn_pool.h"
 #include "source/extensions/filters/network/thrift_proxy/router/router.h"
 #include "source/extensions/filters/network/thrift_proxy/thrift.h"
 
@@ -30,11 +31,15 @@ struct UpstreamRequest : public Tcp::ConnectionPool::Callbacks,
                          Logger::Loggable<Logger::Id::thrift> {
   UpstreamRequest(RequestOwner& parent, Upstream::TcpPoolData& pool_data,
                   MessageMetadataSharedPtr& metadata, TransportType transport_type,
-                  ProtocolType protocol_type, bool close_downstream_on_error);
+                  ProtocolType protocol_type, bool close_downstream_on_error,
+                  MultiplexedConnPools* multiplexed_conn_pools = nullptr);
   ~UpstreamRequest() override;
 
   FilterStatus start();
   void resetStream();
+  // Releases the connection of a request whose response is no longer awaited. A connection shared
+  // with other requests is left open.
+  void abandonStream();
   void releaseConnection(bool close);
 
   // Tcp::ConnectionPool::Callbacks
@@ -61,6 +66,8 @@ struct UpstreamRequest : public Tcp::ConnectionPool::Callbacks,
   RequestOwner& parent_;
   const RouterStats& stats_;
   Upstream::TcpPoolData& conn_pool_data_;
+  // The pools of the shared connections, if the request is multiplexed over one.
+  MultiplexedConnPools* const multiplexed_conn_pools_;
   MessageMetadataSharedPtr metadata_;
 
   Tcp::ConnectionPool::Cancellable* conn_pool_handle_{};
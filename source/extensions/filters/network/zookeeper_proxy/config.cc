@@ -2,9 +2,11 @@
 
 #include <string>
 
+#include "envoy/config/core/v3/base.pb.h"
 #include "envoy/extensions/filters/network/zookeeper_proxy/v3/zookeeper_proxy.pb.h"
 #include "envoy/extensions/filters/network/zookeeper_proxy/v3/zookeeper_proxy.pb.validate.h"
 #include "envoy/registry/registry.h"
+#include "envoy/runtime/runtime.h"
 #include "envoy/server/filter_config.h"
 
 #include "source/common/common/logger.h"
@@ -55,9 +57,20 @@ Network::FilterFactoryCb ZooKeeperConfigFactory::createFilterFactoryFromProtoTyp
       enable_latency_threshold_metrics, default_latency_threshold, latency_threshold_overrides,
       context.scope()));
   auto& time_source = context.serverFactoryContext().mainThreadDispatcher().timeSource();
+  auto& runtime = context.serverFactoryContext().runtime();
+  absl::optional<envoy::config::core::v3::RuntimeFractionalPercent> full_decoding_connections;
+  if (proto_config.has_full_decoding_connections()) {
+    full_decoding_connections = proto_config.full_decoding_connections();
+  }
 
-  return [filter_config, &time_source](Network::FilterManager& filter_manager) -> void {
-    filter_manager.addFilter(std::make_shared<ZooKeeperFilter>(filter_config, time_source));
+  return [filter_config, &time_source, &runtime,
+          full_decoding_connections](Network::FilterManager& filter_manager) -> void {
+    const bool full_decoding = !full_decoding_connections.has_value() ||
+                               runtime.snapshot().featureEnabled(
+                                   full_decoding_connections->runtime_key(),
+                                   full_decoding_connections->default_value());
+    filter_manager.addFilter(
+        std::make_shared<ZooKeeperFilter>(filter_config, time_source, full_decoding));
   };
 }
 
@@ -964,6 +964,11 @@ absl::Status DecoderImpl::decodeAndBufferHelper(Buffer::Instance& data, DecodeTy
 }
 
 void DecoderImpl::decode(Buffer::Instance& data, DecodeType dtype, uint64_t full_packets_len) {
+  if (!full_decoding_) {
+    decodeLengths(data, dtype, full_packets_len);
+    return;
+  }
+
   uint64_t offset = 0;
 
   TRY_NEEDS_AUDIT {
@@ -1005,6 +1010,21 @@ void DecoderImpl::decode(Buffer::Instance& data, DecodeType dtype, uint64_t full
   }
 }
 
+void DecoderImpl::decodeLengths(Buffer::Instance& data, DecodeType dtype,
+                                uint64_t full_packets_len) {
+  uint64_t offset = 0;
+  while (offset < full_packets_len) {
+    // The lengths were validated while looking for the full packets.
+    const uint64_t packet_len = INT_LENGTH + data.peekBEInt<int32_t>(offset);
+    offset += packet_len;
+    if (dtype == DecodeType::READ) {
+      callbacks_.onRequestBytes(absl::nullopt, packet_len);
+    } else {
+      callbacks_.onResponseBytes(absl::nullopt, packet_len);
+    }
+  }
+}
+
 absl::Status DecoderImpl::parseConnectResponse(Buffer::Instance& data, uint64_t& offset,
                                                uint32_t len,
                                                const std::chrono::milliseconds latency) {
@@ -133,10 +133,11 @@ using DecoderPtr = std::unique_ptr<Decoder>;
 
 class DecoderImpl : public Decoder, Logger::Loggable<Logger::Id::filter> {
 public:
+  // Only the length of the packets is decoded if full_decoding is false.
   explicit DecoderImpl(DecoderCallbacks& callbacks, uint32_t max_packet_bytes,
-                       TimeSource& time_source)
+                       TimeSource& time_source, bool full_decoding = true)
       : callbacks_(callbacks), max_packet_bytes_(max_packet_bytes), helper_(max_packet_bytes),
-        time_source_(time_source) {}
+        time_source_(time_source), full_decoding_(full_decoding) {}
 
   // ZooKeeperProxy::Decoder
   Network::FilterStatus onData(Buffer::Instance& data) override;
@@ -159,6 +160,8 @@ private:
   absl::Status decodeAndBufferHelper(Buffer::Instance& data, DecodeType dtype,
                                      Buffer::OwnedImpl& zk_filter_buffer);
   void decode(Buffer::Instance& data, DecodeType dtype, uint64_t full_packets_len);
+  // Charges the bytes of the full packets, without decoding them.
+  void decodeLengths(Buffer::Instance& data, DecodeType dtype, uint64_t full_packets_len);
   // decodeOnData and decodeOnWrite return ZooKeeper opcode or absl::nullopt.
   // absl::nullopt indicates WATCH_XID, which is generated by the server and has no corresponding
   // opcode.
@@ -205,6 +208,7 @@ private:
   const uint32_t max_packet_bytes_;
   BufferHelper helper_;
   TimeSource& time_source_;
+  const bool full_decoding_;
   absl::flat_hash_map<int32_t, RequestBegin> requests_by_xid_;
   // Different from transaction ids of data requests, the transaction ids (XidCodes) of same kind of
   // control requests are always the same. Therefore, we use a queue for each kind of control
@@ -190,8 +190,9 @@ LatencyThresholdOverrideMap ZooKeeperFilterConfig::parseLatencyThresholdOverride
   return latency_threshold_override_map;
 }
 
-ZooKeeperFilter::ZooKeeperFilter(ZooKeeperFilterConfigSharedPtr config, TimeSource& time_source)
-    : config_(std::move(config)), decoder_(createDecoder(*this, time_source)) {}
+ZooKeeperFilter::ZooKeeperFilter(ZooKeeperFilterConfigSharedPtr config, TimeSource& time_source,
+                                 bool full_decoding)
+    : config_(std::move(config)), decoder_(createDecoder(*this, time_source, full_decoding)) {}
 
 void ZooKeeperFilter::initializeReadFilterCallbacks(Network::ReadFilterCallbacks& callbacks) {
   read_callbacks_ = &callbacks;
@@ -209,8 +210,10 @@ Network::FilterStatus ZooKeeperFilter::onWrite(Buffer::Instance& data, bool) {
 
 Network::FilterStatus ZooKeeperFilter::onNewConnection() { return Network::FilterStatus::Continue; }
 
-DecoderPtr ZooKeeperFilter::createDecoder(DecoderCallbacks& callbacks, TimeSource& time_source) {
-  return std::make_unique<DecoderImpl>(callbacks, config_->maxPacketBytes(), time_source);
+DecoderPtr ZooKeeperFilter::createDecoder(DecoderCallbacks& callbacks, TimeSource& time_source,
+                                          bool full_decoding) {
+  return std::make_unique<DecoderImpl>(callbacks, config_->maxPacketBytes(), time_source,
+                                       full_decoding);
 }
 
 void ZooKeeperFilter::setDynamicMetadata(const std::string& key, const std::string& value) {
@@ -357,7 +357,9 @@ class ZooKeeperFilter : public Network::Filter,
                         DecoderCallbacks,
                         Logger::Loggable<Logger::Id::filter> {
 public:
-  ZooKeeperFilter(ZooKeeperFilterConfigSharedPtr config, TimeSource& time_source);
+  // Only the length of the packets of the connection is decoded if full_decoding is false.
+  ZooKeeperFilter(ZooKeeperFilterConfigSharedPtr config, TimeSource& time_source,
+                  bool full_decoding = true);
 
   // Network::ReadFilter
   Network::FilterStatus onData(Buffer::Instance& data, bool end_stream) override;
@@ -404,7 +406,8 @@ public:
   void onWatchEvent(int32_t event_type, int32_t client_state, const std::string& path, int64_t zxid,
                     int32_t error) override;
 
-  DecoderPtr createDecoder(DecoderCallbacks& callbacks, TimeSource& time_source);
+  DecoderPtr createDecoder(DecoderCallbacks& callbacks, TimeSource& time_source,
+                           bool full_decoding);
   void setDynamicMetadata(const std::string& key, const std::string& value);
   void setDynamicMetadata(const std::vector<std::pair<const std::string, const std::string>>& data);
   void clearDynamicMetadata();
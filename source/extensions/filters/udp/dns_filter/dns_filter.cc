@@ -17,6 +17,12 @@ namespace DnsFilter {
 static constexpr std::chrono::milliseconds DEFAULT_RESOLVER_TIMEOUT{500};
 static constexpr std::chrono::seconds DEFAULT_RESOLVER_TTL{300};
 
+// The bits of the first flags byte of a query the response depends on: the operation code and
+// whether recursion is desired.
+static constexpr uint8_t CACHED_QUERY_FLAGS_MASK = 0x79;
+// The queries may spell the configured names in any case, so the cache is bounded on its own.
+static constexpr size_t MAX_CACHED_RESPONSES = 1024;
+
 DnsFilterEnvoyConfig::DnsFilterEnvoyConfig(
     Server::Configuration::ListenerFactoryContext& context,
     const envoy::extensions::filters::udp::dns_filter::v3::DnsFilterConfig& config)
@@ -172,6 +178,7 @@ DnsFilterEnvoyConfig::DnsFilterEnvoyConfig(
     resolver_timeout_ = std::chrono::milliseconds(PROTOBUF_GET_MS_OR_DEFAULT(
         client_config, resolver_timeout, DEFAULT_RESOLVER_TIMEOUT.count()));
     max_pending_lookups_ = client_config.max_pending_lookups();
+    max_cached_resolutions_ = client_config.max_cached_resolutions();
   } else {
     // In case client_config doesn't exist, create default DNS resolver factory and save it.
     dns_resolver_factory_ = &Network::createDefaultDnsResolverFactory(typed_dns_resolver_config_);
@@ -257,14 +264,25 @@ DnsFilter::DnsFilter(Network::UdpReadFilterCallbacks& callbacks,
 
   resolver_ = std::make_unique<DnsFilterResolver>(
       resolver_callback_, config->resolverTimeout(), listener_.dispatcher(),
-      config->maxPendingLookups(), config->typedDnsResolverConfig(), config->dnsResolverFactory(),
-      config->api());
+      config->maxPendingLookups(), config->maxCachedResolutions(),
+      config->stats().external_resolution_cache_hits_, config->typedDnsResolverConfig(),
+      config->dnsResolverFactory(), config->api());
 }
 
 Network::FilterStatus DnsFilter::onData(Network::UdpRecvData& client_request) {
-  config_->stats().downstream_rx_bytes_.recordValue(client_request.buffer_->length());
+  const uint64_t request_length = client_request.buffer_->length();
+  config_->stats().downstream_rx_bytes_.recordValue(request_length);
   config_->stats().downstream_rx_queries_.inc();
 
+  // Queries for the configured domains are answered with the responses built for the same
+  // questions before, skipping the parsing, the lookups and the serialization.
+  const absl::string_view request{
+      static_cast<const char*>(client_request.buffer_->linearize(request_length)), request_length};
+  const std::string cache_key = responseCacheKey(request);
+  if (!cache_key.empty() && sendCachedResponse(client_request, request, cache_key)) {
+    return Network::FilterStatus::StopIteration;
+  }
+
   // Setup counters for the parser
   DnsParserCounters parser_counters(
       config_->stats().query_buffer_underflow_, config_->stats().record_name_overflow_,
@@ -288,17 +306,118 @@ Network::FilterStatus DnsFilter::onData(Network::UdpRecvData& client_request) {
   }
 
   // We have an answer, it might be "No Answer". Send it to the client
-  sendDnsResponse(std::move(query_context));
+  sendDnsResponse(std::move(query_context), cache_key);
 
   return Network::FilterStatus::StopIteration;
 }
 
-void DnsFilter::sendDnsResponse(DnsQueryContextPtr query_context) {
+std::string DnsFilter::responseCacheKey(absl::string_view request) {
+  constexpr size_t header_size = sizeof(DnsHeader);
+  if (request.size() <= header_size) {
+    return {};
+  }
+  const auto field = [request](size_t offset) -> uint16_t {
+    return static_cast<uint16_t>(static_cast<uint8_t>(request[offset]) << 8 |
+                                 static_cast<uint8_t>(request[offset + 1]));
+  };
+
+  // Only queries with a transaction id and a single question, without any other records. The
+  // queries with additional records (e.g. EDNS) take the regular path, which accounts for them.
+  const uint8_t flags = request[2];
+  if (field(0) == 0 || (flags & 0x80) != 0 || field(4) != 1 || field(6) != 0 || field(8) != 0 ||
+      field(10) != 0) {
+    return {};
+  }
+
+  // The question name is a sequence of labels, which can't be compressed as nothing precedes
+  // them, followed by the record type and class that end the query.
+  size_t offset = header_size;
+  while (offset < request.size() && request[offset] != 0) {
+    const uint8_t label_length = request[offset];
+    if (label_length > MAX_LABEL_LENGTH) {
+      return {};
+    }
+    offset += label_length + 1;
+  }
+  if (offset + 1 + 2 * sizeof(uint16_t) != request.size()) {
+    return {};
+  }
+
+  // The name keeps the case of the query, which the answers repeat.
+  std::string key(1, static_cast<char>(flags & CACHED_QUERY_FLAGS_MASK));
+  key.append(request.substr(header_size));
+  return key;
+}
+
+bool DnsFilter::sendCachedResponse(const Network::UdpRecvData& client_request,
+                                   absl::string_view request, const std::string& cache_key) {
+  const auto it = response_cache_.find(cache_key);
+  if (it == response_cache_.end()) {
+    return false;
+  }
+  if (it->second.expiry_ <= listener_.dispatcher().timeSource().monotonicTime()) {
+    response_cache_.erase(it);
+    return false;
+  }
+  const CachedResponse& cached = it->second;
+  config_->stats().response_cache_hits_.inc();
+
+  // Account for the query as if it was parsed and resolved.
+  incrementQueryTypeCount(cached.query_type_);
+  config_->stats().known_domain_queries_.inc();
+  for (size_t i = 0; i < cached.answers_; ++i) {
+    incrementLocalQueryTypeAnswerCount(cached.query_type_);
+  }
+
+  // The response only differs from the cached one by the transaction id.
+  std::string serialized = cached.response_;
+  serialized.replace(0, sizeof(uint16_t), request.data(), sizeof(uint16_t));
+
+  Buffer::OwnedImpl response{serialized};
+  config_->stats().downstream_tx_responses_.inc();
+  config_->stats().downstream_tx_bytes_.recordValue(response.length());
+  Network::UdpSendData response_data{client_request.addresses_.local_->ip(),
+                                     *(client_request.addresses_.peer_), response};
+  listener_.send(response_data);
+  return true;
+}
+
+void DnsFilter::sendDnsResponse(DnsQueryContextPtr query_context, absl::string_view cache_key) {
   Buffer::OwnedImpl response;
 
   // Serializes the generated response to the parsed query from the client. If there is a
   // parsing error or the incoming query is invalid, we will still generate a valid DNS response
   message_parser_.buildResponseBuffer(query_context, response);
+
+  // Cache the responses answered from the configured domains with all of their answers, which are
+  // then always serialized in the same order. The cached question must be the one of the queries
+  // it answers.
+  if (!cache_key.empty() && query_context->parse_status_ &&
+      query_context->resolved_via_configured_hosts_ && query_context->queries_.size() == 1) {
+    const DnsQueryRecord& query = *query_context->queries_.front();
+    const size_t answers = query_context->answers_.size();
+    const std::chrono::seconds ttl = getDomainTTL(query.name_);
+    const std::string serialized = response.toString();
+    const absl::string_view question = absl::string_view(cache_key).substr(1);
+    if ((query.type_ == DNS_RECORD_TYPE_A || query.type_ == DNS_RECORD_TYPE_AAAA) &&
+        answers > 0 && answers <= MAX_RETURNED_RECORDS &&
+        query_context->response_header_.answers == answers && ttl.count() > 0 &&
+        serialized.size() > sizeof(DnsHeader) + question.size() &&
+        absl::string_view(serialized).substr(sizeof(DnsHeader), question.size()) == question) {
+      const MonotonicTime now = listener_.dispatcher().timeSource().monotonicTime();
+      if (response_cache_.size() >= MAX_CACHED_RESPONSES) {
+        // Evict the expired responses first, then arbitrary ones.
+        absl::erase_if(response_cache_,
+                       [now](const auto& entry) { return entry.second.expiry_ <= now; });
+        while (response_cache_.size() >= MAX_CACHED_RESPONSES) {
+          response_cache_.erase(response_cache_.begin());
+        }
+      }
+      response_cache_.insert_or_assign(std::string(cache_key),
+                                       CachedResponse{serialized, query.type_, answers, now + ttl});
+    }
+  }
+
   config_->stats().downstream_tx_responses_.inc();
   config_->stats().downstream_tx_bytes_.recordValue(response.length());
   Network::UdpSendData response_data{query_context->local_->ip(), *(query_context->peer_),
@@ -323,11 +442,13 @@ DnsLookupResponseCode DnsFilter::getResponseForQuery(DnsQueryContextPtr& context
     if (isKnownDomain(query->name_) || !forward_queries) {
       // Determine whether the name is a cluster. Move on to the next query if successful
       if (resolveViaClusters(context, *query)) {
+        context->resolved_via_configured_hosts_ = false;
         continue;
       }
 
       // Determine whether we an answer this query with the static configuration
       if (resolveViaConfiguredHosts(context, *query)) {
+        context->resolved_via_configured_hosts_ = true;
         continue;
       }
     }
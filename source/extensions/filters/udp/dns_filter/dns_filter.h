@@ -12,6 +12,7 @@
 #include "source/extensions/filters/udp/dns_filter/dns_filter_resolver.h"
 #include "source/extensions/filters/udp/dns_filter/dns_parser.h"
 
+#include "absl/container/flat_hash_map.h"
 #include "absl/container/flat_hash_set.h"
 
 namespace Envoy {
@@ -40,6 +41,7 @@ namespace DnsFilter {
   COUNTER(external_unsupported_answers)                                                            \
   COUNTER(external_unsupported_queries)                                                            \
   COUNTER(externally_resolved_queries)                                                             \
+  COUNTER(external_resolution_cache_hits)                                                          \
   COUNTER(known_domain_queries)                                                                    \
   COUNTER(local_a_record_answers)                                                                  \
   COUNTER(local_aaaa_record_answers)                                                               \
@@ -53,6 +55,7 @@ namespace DnsFilter {
   COUNTER(queries_with_additional_rrs)                                                             \
   COUNTER(queries_with_ans_or_authority_rrs)                                                       \
   COUNTER(record_name_overflow)                                                                    \
+  COUNTER(response_cache_hits)                                                                     \
   HISTOGRAM(downstream_rx_bytes, Bytes)                                                            \
   HISTOGRAM(downstream_rx_query_latency, Milliseconds)                                             \
   HISTOGRAM(downstream_tx_bytes, Bytes)
@@ -92,6 +95,7 @@ public:
   uint64_t retryCount() const { return retry_count_; }
   Random::RandomGenerator& random() const { return random_; }
   uint64_t maxPendingLookups() const { return max_pending_lookups_; }
+  uint32_t maxCachedResolutions() const { return max_cached_resolutions_; }
   const envoy::config::core::v3::TypedExtensionConfig& typedDnsResolverConfig() const {
     return typed_dns_resolver_config_;
   }
@@ -130,6 +134,7 @@ private:
   std::chrono::milliseconds resolver_timeout_;
   Random::RandomGenerator& random_;
   uint64_t max_pending_lookups_;
+  uint32_t max_cached_resolutions_{};
   envoy::config::core::v3::TypedExtensionConfig typed_dns_resolver_config_;
   Network::DnsResolverFactory* dns_resolver_factory_;
 };
@@ -158,12 +163,41 @@ public:
   bool isKnownDomain(const absl::string_view domain_name);
 
 private:
+  /**
+   * A serialized response to a query answered from the configured domains, sent again to the
+   * queries with the same flags and question with their transaction id patched in.
+   */
+  struct CachedResponse {
+    std::string response_;
+    uint16_t query_type_;
+    size_t answers_;
+    MonotonicTime expiry_;
+  };
+
   /**
    * Prepare the response buffer and send it to the client
    *
    * @param context contains the data necessary to create a response and send it to a client
+   * @param cache_key the key to cache the response with, if it was answered from the configured
+   * domains. Empty if the response can't be cached
+   */
+  void sendDnsResponse(DnsQueryContextPtr context, absl::string_view cache_key = {});
+
+  /**
+   * @param request the incoming query
+   * @return std::string the key of the response cache for the query, covering the header flags
+   * the response depends on and the question as sent. Empty if the query isn't a plain
+   * single question query whose response can be cached
+   */
+  static std::string responseCacheKey(absl::string_view request);
+
+  /**
+   * @brief Sends the cached response to the query, if there is one that did not expire
+   *
+   * @return bool true if the response was sent
    */
-  void sendDnsResponse(DnsQueryContextPtr context);
+  bool sendCachedResponse(const Network::UdpRecvData& client_request, absl::string_view request,
+                          const std::string& cache_key);
 
   /**
    * @brief Encapsulates all of the logic required to find an answer for a DNS query
@@ -379,6 +413,8 @@ private:
   Network::Address::InstanceConstSharedPtr local_;
   Network::Address::InstanceConstSharedPtr peer_;
   DnsFilterResolverCallback resolver_callback_;
+  // The responses answered from the configured domains, by the flags and question of the query.
+  absl::flat_hash_map<std::string, CachedResponse> response_cache_;
 };
 
 } // namespace DnsFilter
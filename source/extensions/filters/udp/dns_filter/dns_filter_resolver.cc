@@ -2,6 +2,8 @@
 
 #include "source/common/network/utility.h"
 
+#include "absl/strings/ascii.h"
+
 namespace Envoy {
 namespace Extensions {
 namespace UdpFilters {
@@ -36,6 +38,25 @@ void DnsFilterResolver::resolveExternalQuery(DnsQueryContextPtr context,
     return;
   }
 
+  // Answer from the cache if the name was resolved recently.
+  if (max_cached_resolutions_ > 0) {
+    const auto it =
+        resolutions_.find({absl::AsciiStrToLower(domain_query->name_), domain_query->type_});
+    if (it != resolutions_.end()) {
+      if (it->second.expiry > dispatcher_.timeSource().monotonicTime()) {
+        ENVOY_LOG(trace, "Answering query for [{}] from the cached resolution",
+                  domain_query->name_);
+        cache_hits_.inc();
+        ctx.resolved_hosts = it->second.resolved_hosts;
+        ctx.query_context->resolution_status_ = Network::DnsResolver::ResolutionStatus::Success;
+        ctx.resolver_status = DnsFilterResolverStatus::Complete;
+        invokeCallback(ctx);
+        return;
+      }
+      resolutions_.erase(it);
+    }
+  }
+
   const DnsQueryRecord* id = domain_query;
 
   // If we have too many pending lookups, invoke the callback to retry the query.
@@ -86,7 +107,6 @@ void DnsFilterResolver::resolveExternalQuery(DnsQueryContextPtr context,
                        ctx.query_context->resolution_status_ = status;
                        ctx.resolver_status = DnsFilterResolverStatus::Complete;
 
-                       // C-ares doesn't expose the TTL in the data available here.
                        if (status == Network::DnsResolver::ResolutionStatus::Success) {
                          ctx.resolved_hosts.reserve(response.size());
                          for (const auto& resp : response) {
@@ -97,6 +117,7 @@ void DnsFilterResolver::resolveExternalQuery(DnsQueryContextPtr context,
                                      ctx.query_rec->name_);
                            ctx.resolved_hosts.emplace_back(std::move(addrinfo.address_));
                          }
+                         cacheResolution(*ctx.query_rec, response);
                        }
                        // Invoke the filter callback notifying it of resolved addresses
                        invokeCallback(ctx);
@@ -123,6 +144,42 @@ void DnsFilterResolver::onResolveTimeout() {
     }
   }
 }
+
+void DnsFilterResolver::cacheResolution(const DnsQueryRecord& query,
+                                        const std::list<Network::DnsResponse>& response) {
+  if (max_cached_resolutions_ == 0 || response.empty()) {
+    return;
+  }
+
+  // The addresses are cached together, for as long as the shortest TTL of theirs.
+  CachedResolution resolution;
+  resolution.resolved_hosts.reserve(response.size());
+  std::chrono::seconds ttl = std::chrono::seconds::max();
+  for (const auto& resp : response) {
+    const auto& addrinfo = resp.addrInfo();
+    ttl = std::min(ttl, addrinfo.ttl_);
+    resolution.resolved_hosts.push_back(addrinfo.address_);
+  }
+  if (ttl.count() <= 0) {
+    return;
+  }
+
+  const MonotonicTime now = dispatcher_.timeSource().monotonicTime();
+  resolution.expiry = now + ttl;
+  makeRoom(now);
+  resolutions_.insert_or_assign(ResolutionKey{absl::AsciiStrToLower(query.name_), query.type_},
+                                std::move(resolution));
+}
+
+void DnsFilterResolver::makeRoom(MonotonicTime now) {
+  if (resolutions_.size() < max_cached_resolutions_) {
+    return;
+  }
+  absl::erase_if(resolutions_, [now](const auto& entry) { return entry.second.expiry <= now; });
+  while (resolutions_.size() >= max_cached_resolutions_) {
+    resolutions_.erase(resolutions_.begin());
+  }
+}
 } // namespace DnsFilter
 } // namespace UdpFilters
 } // namespace Extensions
@@ -2,10 +2,13 @@
 
 #include "envoy/event/dispatcher.h"
 #include "envoy/network/dns.h"
+#include "envoy/stats/stats.h"
 
 #include "source/common/network/dns_resolver/dns_factory_util.h"
 #include "source/extensions/filters/udp/dns_filter/dns_parser.h"
 
+#include "absl/container/flat_hash_map.h"
+
 namespace Envoy {
 namespace Extensions {
 namespace UdpFilters {
@@ -21,10 +24,12 @@ class DnsFilterResolver : Logger::Loggable<Logger::Id::filter> {
 public:
   DnsFilterResolver(DnsFilterResolverCallback& callback, std::chrono::milliseconds timeout,
                     Event::Dispatcher& dispatcher, uint64_t max_pending_lookups,
+                    uint32_t max_cached_resolutions, Stats::Counter& cache_hits,
                     const envoy::config::core::v3::TypedExtensionConfig& typed_dns_resolver_config,
                     const Network::DnsResolverFactory& dns_resolver_factory, Api::Api& api)
       : timeout_(timeout), dispatcher_(dispatcher), callback_(callback),
-        max_pending_lookups_(max_pending_lookups),
+        max_pending_lookups_(max_pending_lookups), max_cached_resolutions_(max_cached_resolutions),
+        cache_hits_(cache_hits),
         resolver_(THROW_OR_RETURN_VALUE(
             dns_resolver_factory.createDnsResolver(dispatcher, api, typed_dns_resolver_config),
             Network::DnsResolverSharedPtr)) {}
@@ -33,7 +38,8 @@ public:
    *
    * This function uses the query object to determine whether it is requesting an A or AAAA record
    * for the given name. When the resolver callback executes, this will execute a DNS Filter
-   * callback in order to build the answer object returned to the client.
+   * callback in order to build the answer object returned to the client. The cached resolutions
+   * are handed to the callback right away.
    *
    * @param domain_query the query record object containing the name for which we are resolving
    */
@@ -48,6 +54,14 @@ private:
     DnsFilterResolverStatus resolver_status;
     Event::TimerPtr timeout_timer;
   };
+
+  // The addresses a name of a record type resolved to, until the shortest of their TTLs elapses.
+  struct CachedResolution {
+    AddressConstPtrVec resolved_hosts;
+    MonotonicTime expiry;
+  };
+  using ResolutionKey = std::pair<std::string, uint16_t>;
+
   /**
    * @brief invokes the DNS Filter callback only if our state indicates we have not timed out
    * waiting for a response from the external resolver
@@ -65,11 +79,27 @@ private:
    */
   void onResolveTimeout();
 
+  /**
+   * @brief Caches the addresses a query resolved to, if resolutions are cached and the resolver
+   * returned TTLs for them.
+   */
+  void cacheResolution(const DnsQueryRecord& query,
+                       const std::list<Network::DnsResponse>& response);
+
+  /**
+   * @brief Makes room for a new resolution, first by evicting the expired resolutions, then
+   * arbitrary ones.
+   */
+  void makeRoom(MonotonicTime now);
+
   std::chrono::milliseconds timeout_;
   Event::Dispatcher& dispatcher_;
   DnsFilterResolverCallback& callback_;
   absl::flat_hash_map<const DnsQueryRecord*, LookupContext> lookups_;
   uint64_t max_pending_lookups_;
+  const uint32_t max_cached_resolutions_;
+  Stats::Counter& cache_hits_;
+  absl::flat_hash_map<ResolutionKey, CachedResolution> resolutions_;
 
   // The order of members is important. If the lookups_'s destructor is called before the
   // resolver_'s destructor and some c-ares queries were in progress, then the DnsFilterResolver's
@@ -207,6 +207,8 @@ public:
   DnsAnswerMap answers_;
   DnsAnswerMap additional_;
   bool in_callback_;
+  // Whether the answers come from the configured domains only, so that the response can be cached.
+  bool resolved_via_configured_hosts_{false};
 
   /**
    * @param context the query context for which we are querying the response code
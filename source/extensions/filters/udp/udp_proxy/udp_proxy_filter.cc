@@ -97,8 +97,7 @@ UdpProxyFilter::ClusterInfo::ClusterInfo(UdpProxyFilter& filter,
               if (host_sessions_it != host_to_sessions_.end()) {
                 for (auto& session : host_sessions_it->second) {
                   session->onSessionComplete();
-                  ASSERT(sessions_.count(session) == 1);
-                  sessions_.erase(session);
+                  eraseSession(session);
                 }
                 host_to_sessions_.erase(host_sessions_it);
               }
@@ -129,6 +128,13 @@ void UdpProxyFilter::ClusterInfo::removeSession(ActiveSession* session) {
   session->onSessionComplete();
 
   // Now remove it from the primary map.
+  eraseSession(session);
+}
+
+void UdpProxyFilter::ClusterInfo::eraseSession(ActiveSession* session) {
+  if (last_session_ == session) {
+    last_session_ = nullptr;
+  }
   ASSERT(sessions_.count(session) == 1);
   sessions_.erase(session);
 }
@@ -203,15 +209,19 @@ UdpProxyFilter::StickySessionClusterInfo::StickySessionClusterInfo(
 
 Network::FilterStatus UdpProxyFilter::StickySessionClusterInfo::onData(Network::UdpRecvData& data) {
   bool defer_socket = filter_.config_->hasSessionFilters() || filter_.config_->tunnelingConfig();
-  const auto active_session_it = sessions_.find(data.addresses_);
-  ActiveSession* active_session;
-  if (active_session_it == sessions_.end()) {
+  ActiveSession* active_session = nullptr;
+  if (last_session_ != nullptr && last_session_->addresses() == data.addresses_) {
+    active_session = last_session_;
+  } else if (const auto active_session_it = sessions_.find(data.addresses_);
+             active_session_it != sessions_.end()) {
+    active_session = active_session_it->get();
+  }
+  if (active_session == nullptr) {
     active_session = createSession(std::move(data.addresses_), nullptr, defer_socket);
     if (active_session == nullptr) {
       return Network::FilterStatus::StopIteration;
     }
   } else {
-    active_session = active_session_it->get();
     // We defer the socket creation when the session includes filters, so the filters can be
     // iterated before choosing the host, to allow dynamically choosing upstream host. Due to this,
     // we can't perform health checks during a session.
@@ -235,6 +245,7 @@ Network::FilterStatus UdpProxyFilter::StickySessionClusterInfo::onData(Network::
     }
   }
 
+  last_session_ = active_session;
   active_session->onData(data);
 
   return Network::FilterStatus::StopIteration;
@@ -281,7 +292,9 @@ std::atomic<uint64_t> UdpProxyFilter::ActiveSession::next_global_session_id_;
 UdpProxyFilter::ActiveSession::ActiveSession(ClusterInfo& cluster,
                                              Network::UdpRecvData::LocalPeerAddresses&& addresses,
                                              const Upstream::HostConstSharedPtr& host)
-    : cluster_(cluster), addresses_(std::move(addresses)), host_(host),
+    : cluster_(cluster), addresses_(std::move(addresses)),
+      addresses_hash_(absl::Hash<const Network::UdpRecvData::LocalPeerAddresses>()(addresses_)),
+      host_(host),
       session_id_(next_global_session_id_++),
       idle_timer_(cluster.filter_.read_callbacks_->udpListener().dispatcher().createTimer(
           [this] { onIdleTimer(); })),
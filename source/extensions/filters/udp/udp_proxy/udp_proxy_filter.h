@@ -527,6 +527,8 @@ private:
     ~ActiveSession() override;
 
     const Network::UdpRecvData::LocalPeerAddresses& addresses() const { return addresses_; }
+    // The hash of the addresses, computed once as it is needed on every lookup and rehash.
+    size_t addressesHash() const { return addresses_hash_; }
     absl::optional<std::reference_wrapper<const Upstream::Host>> host() const {
       if (host_) {
         return *host_;
@@ -598,6 +600,7 @@ private:
 
     ClusterInfo& cluster_;
     const Network::UdpRecvData::LocalPeerAddresses addresses_;
+    const size_t addresses_hash_;
     Upstream::HostConstSharedPtr host_;
     uint64_t session_id_;
     // TODO(mattklein123): Consider replacing an idle timer for each session with a last used
@@ -740,19 +743,23 @@ private:
       return absl::Hash<const Network::UdpRecvData::LocalPeerAddresses>()(value);
     }
     size_t operator()(const LocalPeerHostAddresses& value) const {
-      auto hash = this->operator()(value.local_peer_addresses_);
-      if (consider_host_) {
-        hash = absl::HashOf(hash, value.host_.value().get().address()->asStringView());
-      }
-      return hash;
+      return withHost(this->operator()(value.local_peer_addresses_), value.host_);
     }
     size_t operator()(const ActiveSession* value) const {
-      LocalPeerHostAddresses key{value->addresses(), value->host()};
-      return this->operator()(key);
+      return withHost(value->addressesHash(), value->host());
     }
     size_t operator()(const ActiveSessionPtr& value) const { return this->operator()(value.get()); }
 
   private:
+    size_t
+    withHost(size_t hash,
+             const absl::optional<std::reference_wrapper<const Upstream::Host>>& host) const {
+      if (consider_host_) {
+        hash = absl::HashOf(hash, host.value().get().address()->asStringView());
+      }
+      return hash;
+    }
+
     const bool consider_host_;
   };
 
@@ -813,8 +820,12 @@ private:
     ActiveSession* createSession(Network::UdpRecvData::LocalPeerAddresses&& addresses,
                                  const Upstream::HostConstSharedPtr& optional_host,
                                  bool defer_socket_creation);
+    void eraseSession(ActiveSession* session);
 
     SessionStorageType sessions_;
+    // The session of the last datagram. Datagrams come in runs from the same peer, which then skip
+    // hashing the addresses and probing the sessions.
+    ActiveSession* last_session_{};
 
   private:
     static UdpProxyUpstreamStats generateStats(Stats::Scope& scope) {
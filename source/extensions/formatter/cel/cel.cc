@@ -21,7 +21,7 @@ CELFormatter::CELFormatter(const ::Envoy::LocalInfo::LocalInfo& local_info,
                            absl::optional<size_t>& max_length)
     : local_info_(local_info), expr_builder_(expr_builder), parsed_expr_(input_expr),
       max_length_(max_length) {
-  compiled_expr_ = Expr::createExpression(expr_builder_->builder(), parsed_expr_);
+  compiled_expr_ = expr_builder_->createExpression(parsed_expr_);
 }
 
 absl::optional<std::string>
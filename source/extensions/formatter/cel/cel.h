@@ -29,7 +29,7 @@ private:
   Extensions::Filters::Common::Expr::BuilderInstanceSharedPtr expr_builder_;
   const google::api::expr::v1alpha1::Expr parsed_expr_;
   const absl::optional<size_t> max_length_;
-  Extensions::Filters::Common::Expr::ExpressionPtr compiled_expr_;
+  Extensions::Filters::Common::Expr::ExpressionSharedPtr compiled_expr_;
 };
 
 class CELFormatterCommandParser : public ::Envoy::Formatter::CommandParser {
@@ -35,7 +35,8 @@ public:
     } else {
       const auto& provider_config =
           std::make_shared<GeoipProviderConfig>(proto_config, stat_prefix, context.scope());
-      driver = std::make_shared<GeoipProvider>(singleton, provider_config);
+      driver = std::make_shared<GeoipProvider>(singleton, provider_config,
+                                               context.serverFactoryContext().threadLocal());
       drivers_[key] = driver;
     }
     return driver;
@@ -1,7 +1,9 @@
 #include "source/extensions/geoip_providers/maxmind/geoip_provider.h"
 
 #include "source/common/common/assert.h"
+#include "source/common/network/utility.h"
 #include "source/common/protobuf/protobuf.h"
+#include "source/common/protobuf/utility.h"
 
 namespace Envoy {
 namespace Extensions {
@@ -27,8 +29,17 @@ GeoipProviderConfig::GeoipProviderConfig(
                                                  : absl::nullopt),
       anon_db_path_(!config.anon_db_path().empty() ? absl::make_optional(config.anon_db_path())
                                                    : absl::nullopt),
+      lookup_cache_size_(config.has_lookup_cache() ? PROTOBUF_GET_WRAPPED_OR_DEFAULT(
+                                                         config.lookup_cache(), max_entries, 10000)
+                                                   : 0),
+      ipv4_cache_prefix_len_(
+          PROTOBUF_GET_WRAPPED_OR_DEFAULT(config.lookup_cache(), ipv4_prefix_len, 32)),
+      ipv6_cache_prefix_len_(
+          PROTOBUF_GET_WRAPPED_OR_DEFAULT(config.lookup_cache(), ipv6_prefix_len, 128)),
       stats_scope_(scope.createScope(absl::StrCat(stat_prefix, "maxmind."))),
-      stat_name_set_(stats_scope_->symbolTable().makeSet("Maxmind")) {
+      stat_name_set_(stats_scope_->symbolTable().makeSet("Maxmind")),
+      lookup_cache_hit_(stat_name_set_->add("lookup_cache.hit")),
+      lookup_cache_miss_(stat_name_set_->add("lookup_cache.miss")) {
   auto geo_headers_to_add = config.common_provider_config().geo_headers_to_add();
   country_header_ = !geo_headers_to_add.country().empty()
                         ? absl::make_optional(geo_headers_to_add.country())
@@ -114,13 +125,52 @@ MaxmindDbPtr GeoipProvider::initMaxMindDb(const absl::optional<std::string>& db_
 void GeoipProvider::lookup(Geolocation::LookupRequest&& request,
                            Geolocation::LookupGeoHeadersCallback&& cb) const {
   auto& remote_address = request.remoteAddress();
+  LookupCache* cache = nullptr;
+  std::string cache_key;
+  if (lookup_cache_ != nullptr && remote_address->ip() != nullptr) {
+    cache = &lookup_cache_->get()->cache_;
+    cache_key = lookupCacheKey(*remote_address->ip());
+    LookupResultMap cached_result;
+    bool found = false;
+    {
+      LookupCache::ScopedLookup lookup(cache, cache_key);
+      if (lookup.found()) {
+        found = true;
+        cached_result = *lookup.value();
+      }
+    }
+    if (found) {
+      config_->incLookupCacheHit();
+      cb(std::move(cached_result));
+      return;
+    }
+    config_->incLookupCacheMiss();
+  }
   auto lookup_result = absl::flat_hash_map<std::string, std::string>{};
   lookupInCityDb(remote_address, lookup_result);
   lookupInAsnDb(remote_address, lookup_result);
   lookupInAnonDb(remote_address, lookup_result);
+  if (cache != nullptr) {
+    cache->insert(cache_key, new LookupResultMap(lookup_result), 1);
+  }
   cb(std::move(lookup_result));
 }
 
+std::string GeoipProvider::lookupCacheKey(const Network::Address::Ip& ip) const {
+  if (ip.version() == Network::Address::IpVersion::v4) {
+    const uint32_t prefix_len = config_->ipv4CachePrefixLen();
+    const uint32_t address = ntohl(ip.ipv4()->address());
+    const uint32_t prefix =
+        prefix_len == 0 ? 0 : address & (~static_cast<uint32_t>(0) << (32 - prefix_len));
+    return std::string(reinterpret_cast<const char*>(&prefix), sizeof(prefix));
+  }
+  const uint32_t prefix_len = config_->ipv6CachePrefixLen();
+  const absl::uint128 address = Network::Utility::Ip6ntohl(ip.ipv6()->address());
+  const absl::uint128 prefix =
+      prefix_len == 0 ? 0 : address & (~absl::uint128(0) << (128 - prefix_len));
+  return std::string(reinterpret_cast<const char*>(&prefix), sizeof(prefix));
+}
+
 void GeoipProvider::lookupInCityDb(
     const Network::Address::InstanceConstSharedPtr& remote_address,
     absl::flat_hash_map<std::string, std::string>& lookup_result) const {
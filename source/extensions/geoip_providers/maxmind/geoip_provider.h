@@ -3,10 +3,12 @@
 #include "envoy/common/platform.h"
 #include "envoy/extensions/geoip_providers/maxmind/v3/maxmind.pb.h"
 #include "envoy/geoip/geoip_provider_driver.h"
+#include "envoy/thread_local/thread_local.h"
 
 #include "source/common/common/logger.h"
 
 #include "maxminddb.h"
+#include "simple_lru_cache/simple_lru_cache_inl.h"
 
 namespace Envoy {
 namespace Extensions {
@@ -35,6 +37,11 @@ public:
   const absl::optional<std::string>& anonTorHeader() const { return anon_tor_header_; }
   const absl::optional<std::string>& anonProxyHeader() const { return anon_proxy_header_; }
 
+  // The maximum number of lookup results cached by each worker, or 0 if they aren't cached.
+  uint32_t lookupCacheSize() const { return lookup_cache_size_; }
+  uint32_t ipv4CachePrefixLen() const { return ipv4_cache_prefix_len_; }
+  uint32_t ipv6CachePrefixLen() const { return ipv6_cache_prefix_len_; }
+
   void incLookupError(absl::string_view maxmind_db_type) {
     incCounter(
         stat_name_set_->getBuiltin(absl::StrCat(maxmind_db_type, ".lookup_error"), unknown_hit_));
@@ -48,6 +55,9 @@ public:
     incCounter(stat_name_set_->getBuiltin(absl::StrCat(maxmind_db_type, ".hit"), unknown_hit_));
   }
 
+  void incLookupCacheHit() { incCounter(lookup_cache_hit_); }
+  void incLookupCacheMiss() { incCounter(lookup_cache_miss_); }
+
   void registerGeoDbStats(const std::string& db_type);
 
   Stats::Scope& getStatsScopeForTest() const { return *stats_scope_; }
@@ -68,24 +78,41 @@ private:
   absl::optional<std::string> anon_tor_header_;
   absl::optional<std::string> anon_proxy_header_;
 
+  const uint32_t lookup_cache_size_;
+  const uint32_t ipv4_cache_prefix_len_;
+  const uint32_t ipv6_cache_prefix_len_;
+
   Stats::ScopeSharedPtr stats_scope_;
   Stats::StatNameSetPtr stat_name_set_;
   const Stats::StatName unknown_hit_;
+  const Stats::StatName lookup_cache_hit_;
+  const Stats::StatName lookup_cache_miss_;
   void incCounter(Stats::StatName name);
 };
 
 using GeoipProviderConfigSharedPtr = std::shared_ptr<GeoipProviderConfig>;
 
 using MaxmindDbPtr = std::unique_ptr<MMDB_s>;
+
+/**
+ * The databases are memory mapped, so that all the workers share their pages.
+ */
 class GeoipProvider : public Envoy::Geolocation::Driver,
                       public Logger::Loggable<Logger::Id::geolocation> {
 
 public:
-  GeoipProvider(Singleton::InstanceSharedPtr owner, GeoipProviderConfigSharedPtr config)
+  GeoipProvider(Singleton::InstanceSharedPtr owner, GeoipProviderConfigSharedPtr config,
+                ThreadLocal::SlotAllocator& tls)
       : config_(config), owner_(owner) {
     city_db_ = initMaxMindDb(config_->cityDbPath());
     isp_db_ = initMaxMindDb(config_->ispDbPath());
     anon_db_ = initMaxMindDb(config_->anonDbPath());
+    if (config_->lookupCacheSize() > 0) {
+      lookup_cache_ = ThreadLocal::TypedSlot<ThreadLocalLookupCache>::makeUnique(tls);
+      lookup_cache_->set([size = config_->lookupCacheSize()](Event::Dispatcher&) {
+        return std::make_shared<ThreadLocalLookupCache>(size);
+      });
+    }
   };
 
   ~GeoipProvider() override;
@@ -94,6 +121,17 @@ public:
   void lookup(Geolocation::LookupRequest&&, Geolocation::LookupGeoHeadersCallback&&) const override;
 
 private:
+  using LookupResultMap = absl::flat_hash_map<std::string, std::string>;
+  using LookupCache = ::google::simple_lru_cache::SimpleLRUCache<std::string, LookupResultMap>;
+
+  struct ThreadLocalLookupCache : public ThreadLocal::ThreadLocalObject {
+    explicit ThreadLocalLookupCache(uint32_t size) : cache_(size) {}
+    LookupCache cache_;
+  };
+
+  // Returns the key of the results of the address in the lookup cache.
+  std::string lookupCacheKey(const Network::Address::Ip& ip) const;
+
   // Allow the unit test to have access to private members.
   friend class GeoipProviderPeer;
   GeoipProviderConfigSharedPtr config_;
@@ -113,6 +151,7 @@ private:
                                const std::string& result_key, Params... lookup_params) const;
   // A shared_ptr to keep the provider singleton alive as long as any of its providers are in use.
   const Singleton::InstanceSharedPtr owner_;
+  ThreadLocal::TypedSlotPtr<ThreadLocalLookupCache> lookup_cache_;
 };
 
 using GeoipProviderSharedPtr = std::shared_ptr<GeoipProvider>;
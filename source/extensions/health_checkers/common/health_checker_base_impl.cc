@@ -5,12 +5,21 @@
 #include "envoy/data/core/v3/health_check_event.pb.h"
 #include "envoy/stats/scope.h"
 
+#include "source/common/common/hash.h"
+#include "source/common/common/lock_guard.h"
 #include "source/common/network/utility.h"
 #include "source/common/router/router.h"
 
 namespace Envoy {
 namespace Upstream {
 
+namespace {
+
+// The dispatcher of the session shard running on the current thread, if any.
+thread_local Event::Dispatcher* session_shard_dispatcher = nullptr;
+
+} // namespace
+
 HealthCheckerImplBase::HealthCheckerImplBase(const Cluster& cluster,
                                              const envoy::config::core::v3::HealthCheck& config,
                                              Event::Dispatcher& dispatcher,
@@ -39,6 +48,7 @@ HealthCheckerImplBase::HealthCheckerImplBase(const Cluster& cluster,
           PROTOBUF_GET_MS_OR_DEFAULT(config, healthy_edge_interval, interval_.count())),
       transport_socket_options_(initTransportSocketOptions(config)),
       transport_socket_match_metadata_(initTransportSocketMatchMetadata(config)),
+      session_threads_(PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, session_threads, 0)),
       member_update_cb_{cluster_.prioritySet().addMemberUpdateCb(
           [this](const HostVector& hosts_added, const HostVector& hosts_removed) -> absl::Status {
             onClusterMemberUpdate(hosts_added, hosts_removed);
@@ -82,6 +92,93 @@ HealthCheckerImplBase::~HealthCheckerImplBase() {
   for (auto& session : active_sessions_) {
     session.second->onDeferredDeleteBase();
   }
+  stopSessionShards();
+}
+
+void HealthCheckerImplBase::createSessionShards(Api::Api& api) {
+  ASSERT(shards_.empty());
+  if (session_threads_ == 0) {
+    return;
+  }
+  if (event_logger_ != nullptr) {
+    event_logger_ = std::make_unique<MainThreadEventLogger>(*this, std::move(event_logger_));
+  }
+  refreshIntervalBounds();
+  for (uint32_t i = 0; i < session_threads_; ++i) {
+    auto shard = std::make_unique<SessionShard>();
+    shard->dispatcher_ = api.allocateDispatcher("hc_shard");
+    Event::Dispatcher* dispatcher = shard->dispatcher_.get();
+    shard->thread_ = api.threadFactory().createThread(
+        [dispatcher]() -> void {
+          session_shard_dispatcher = dispatcher;
+          dispatcher->run(Event::Dispatcher::RunType::RunUntilExit);
+          // Destroys the sessions and connections deferred deleted on the thread of the shard.
+          dispatcher->shutdown();
+          session_shard_dispatcher = nullptr;
+        },
+        Thread::Options{"hc_shard"});
+    shards_.push_back(std::move(shard));
+  }
+}
+
+void HealthCheckerImplBase::stopSessionShards() {
+  for (auto& shard : shards_) {
+    SessionShard* raw_shard = shard.get();
+    raw_shard->dispatcher_->post([raw_shard]() -> void {
+      for (auto& session : raw_shard->sessions_) {
+        session.second->onDeferredDeleteBase();
+      }
+      raw_shard->sessions_.clear();
+      raw_shard->dispatcher_->exit();
+    });
+  }
+  for (auto& shard : shards_) {
+    shard->thread_->join();
+  }
+  shards_.clear();
+  sharded_hosts_.clear();
+}
+
+HealthCheckerImplBase::SessionShard&
+HealthCheckerImplBase::shardForHost(const HostSharedPtr& host) {
+  return *shards_[HashUtil::xxHash64(host->address()->asStringView()) % shards_.size()];
+}
+
+void HealthCheckerImplBase::postToMainThread(std::function<void()> cb) {
+  bool schedule;
+  {
+    Thread::LockGuard lock(main_thread_batch_lock_);
+    schedule = main_thread_batch_.empty();
+    main_thread_batch_.push_back(std::move(cb));
+  }
+  // A single event runs all the results handed over in the meantime.
+  if (schedule) {
+    std::weak_ptr<HealthCheckerImplBase> weak_this = weak_from_this();
+    dispatcher_.post([weak_this]() -> void {
+      std::shared_ptr<HealthCheckerImplBase> shared_this = weak_this.lock();
+      if (shared_this != nullptr) {
+        shared_this->runMainThreadBatch();
+      }
+    });
+  }
+}
+
+void HealthCheckerImplBase::runMainThreadBatch() {
+  std::vector<std::function<void()>> batch;
+  {
+    Thread::LockGuard lock(main_thread_batch_lock_);
+    batch.swap(main_thread_batch_);
+  }
+  refreshIntervalBounds();
+  for (const auto& cb : batch) {
+    cb();
+  }
+}
+
+void HealthCheckerImplBase::refreshIntervalBounds() {
+  min_interval_ = runtime_.snapshot().getInteger("health_check.min_interval", 0);
+  max_interval_ = runtime_.snapshot().getInteger("health_check.max_interval",
+                                                 std::numeric_limits<uint64_t>::max());
 }
 
 void HealthCheckerImplBase::decHealthy() { stats_.healthy_.sub(1); }
@@ -149,9 +246,14 @@ HealthCheckerImplBase::intervalWithJitter(uint64_t base_time_ms,
     base_time_ms += (random_.random() % interval_jitter.count());
   }
 
-  const uint64_t min_interval = runtime_.snapshot().getInteger("health_check.min_interval", 0);
-  const uint64_t max_interval = runtime_.snapshot().getInteger(
-      "health_check.max_interval", std::numeric_limits<uint64_t>::max());
+  // The runtime is only readable from the main thread, the shards use the bounds cached by it.
+  const uint64_t min_interval =
+      shards_.empty() ? runtime_.snapshot().getInteger("health_check.min_interval", 0)
+                      : min_interval_.load();
+  const uint64_t max_interval =
+      shards_.empty() ? runtime_.snapshot().getInteger("health_check.max_interval",
+                                                       std::numeric_limits<uint64_t>::max())
+                      : max_interval_.load();
 
   uint64_t final_ms = std::min(base_time_ms, max_interval);
   // We force a non-zero final MS, to prevent live lock.
@@ -164,6 +266,18 @@ void HealthCheckerImplBase::addHosts(const HostVector& hosts) {
     if (host->disableActiveHealthCheck()) {
       continue;
     }
+    if (!shards_.empty()) {
+      host->setHealthChecker(
+          HealthCheckHostMonitorPtr{new HealthCheckHostMonitorImpl(shared_from_this(), host)});
+      SessionShard& shard = shardForHost(host);
+      sharded_hosts_[host] = &shard;
+      shard.dispatcher_->post([this, &shard, host]() -> void {
+        ActiveHealthCheckSessionPtr& session = shard.sessions_[host];
+        session = makeSession(host);
+        session->start();
+      });
+      continue;
+    }
     active_sessions_[host] = makeSession(host);
     host->setHealthChecker(
         HealthCheckHostMonitorPtr{new HealthCheckHostMonitorImpl(shared_from_this(), host)});
@@ -178,6 +292,20 @@ void HealthCheckerImplBase::onClusterMemberUpdate(const HostVector& hosts_added,
     if (host->disableActiveHealthCheck()) {
       continue;
     }
+    if (!shards_.empty()) {
+      auto shard_iter = sharded_hosts_.find(host);
+      ASSERT(sharded_hosts_.end() != shard_iter);
+      SessionShard& shard = *shard_iter->second;
+      sharded_hosts_.erase(shard_iter);
+      shard.dispatcher_->post([&shard, host]() -> void {
+        auto session_iter = shard.sessions_.find(host);
+        ASSERT(shard.sessions_.end() != session_iter);
+        session_iter->second->onDeferredDeleteBase();
+        shard.dispatcher_->deferredDelete(std::move(session_iter->second));
+        shard.sessions_.erase(session_iter);
+      });
+      continue;
+    }
     auto session_iter = active_sessions_.find(host);
     ASSERT(active_sessions_.end() != session_iter);
     // This deletion can happen inline in response to a host failure, so we deferred delete.
@@ -194,6 +322,67 @@ void HealthCheckerImplBase::runCallbacks(HostSharedPtr host, HealthTransition ch
   }
 }
 
+void HealthCheckerImplBase::onCheckResult(HostSharedPtr host, HealthTransition changed_state,
+                                          HealthState current_check_result) {
+  if (shards_.empty()) {
+    runCallbacks(host, changed_state, current_check_result);
+    return;
+  }
+  postToMainThread([this, host, changed_state, current_check_result]() -> void {
+    runCallbacks(host, changed_state, current_check_result);
+  });
+}
+
+void HealthCheckerImplBase::MainThreadEventLogger::logEjectUnhealthy(
+    envoy::data::core::v3::HealthCheckerType health_checker_type,
+    const HostDescriptionConstSharedPtr& host,
+    envoy::data::core::v3::HealthCheckFailureType failure_type) {
+  parent_.postToMainThread([this, health_checker_type, host, failure_type]() -> void {
+    logger_->logEjectUnhealthy(health_checker_type, host, failure_type);
+  });
+}
+
+void HealthCheckerImplBase::MainThreadEventLogger::logUnhealthy(
+    envoy::data::core::v3::HealthCheckerType health_checker_type,
+    const HostDescriptionConstSharedPtr& host,
+    envoy::data::core::v3::HealthCheckFailureType failure_type, bool first_check) {
+  parent_.postToMainThread([this, health_checker_type, host, failure_type, first_check]() -> void {
+    logger_->logUnhealthy(health_checker_type, host, failure_type, first_check);
+  });
+}
+
+void HealthCheckerImplBase::MainThreadEventLogger::logAddHealthy(
+    envoy::data::core::v3::HealthCheckerType health_checker_type,
+    const HostDescriptionConstSharedPtr& host, bool first_check) {
+  parent_.postToMainThread([this, health_checker_type, host, first_check]() -> void {
+    logger_->logAddHealthy(health_checker_type, host, first_check);
+  });
+}
+
+void HealthCheckerImplBase::MainThreadEventLogger::logSuccessfulHealthCheck(
+    envoy::data::core::v3::HealthCheckerType health_checker_type,
+    const HostDescriptionConstSharedPtr& host) {
+  parent_.postToMainThread([this, health_checker_type, host]() -> void {
+    logger_->logSuccessfulHealthCheck(health_checker_type, host);
+  });
+}
+
+void HealthCheckerImplBase::MainThreadEventLogger::logDegraded(
+    envoy::data::core::v3::HealthCheckerType health_checker_type,
+    const HostDescriptionConstSharedPtr& host) {
+  parent_.postToMainThread([this, health_checker_type, host]() -> void {
+    logger_->logDegraded(health_checker_type, host);
+  });
+}
+
+void HealthCheckerImplBase::MainThreadEventLogger::logNoLongerDegraded(
+    envoy::data::core::v3::HealthCheckerType health_checker_type,
+    const HostDescriptionConstSharedPtr& host) {
+  parent_.postToMainThread([this, health_checker_type, host]() -> void {
+    logger_->logNoLongerDegraded(health_checker_type, host);
+  });
+}
+
 void HealthCheckerImplBase::HealthCheckHostMonitorImpl::setUnhealthy(UnhealthyType type) {
   // This is called cross thread. The cluster/health checker might already be gone.
   std::shared_ptr<HealthCheckerImplBase> health_checker = health_checker_.lock();
@@ -222,6 +411,22 @@ void HealthCheckerImplBase::setUnhealthyCrossThread(const HostSharedPtr& host,
       return;
     }
 
+    if (!shared_this->shards_.empty()) {
+      const auto shard = shared_this->sharded_hosts_.find(host);
+      if (shard == shared_this->sharded_hosts_.end()) {
+        return;
+      }
+      // The session runs on the thread of its shard, which lives as long as the health checker.
+      SessionShard* raw_shard = shard->second;
+      raw_shard->dispatcher_->post([raw_shard, host]() -> void {
+        const auto session = raw_shard->sessions_.find(host);
+        if (session != raw_shard->sessions_.end()) {
+          session->second->setUnhealthy(envoy::data::core::v3::PASSIVE, /*retriable=*/false);
+        }
+      });
+      return;
+    }
+
     const auto session = shared_this->active_sessions_.find(host);
     if (session == shared_this->active_sessions_.end()) {
       return;
@@ -240,9 +445,11 @@ void HealthCheckerImplBase::start() {
 HealthCheckerImplBase::ActiveHealthCheckSession::ActiveHealthCheckSession(
     HealthCheckerImplBase& parent, HostSharedPtr host)
     : host_(host), parent_(parent),
-      interval_timer_(parent.dispatcher_.createTimer([this]() -> void { onIntervalBase(); })),
-      timeout_timer_(parent.dispatcher_.createTimer([this]() -> void { onTimeoutBase(); })),
-      time_source_(parent.dispatcher_.timeSource()) {
+      dispatcher_(session_shard_dispatcher != nullptr ? *session_shard_dispatcher
+                                                      : parent.dispatcher_),
+      interval_timer_(dispatcher_.createTimer([this]() -> void { onIntervalBase(); })),
+      timeout_timer_(dispatcher_.createTimer([this]() -> void { onTimeoutBase(); })),
+      time_source_(dispatcher_.timeSource()) {
 
   if (!host->healthFlagGet(Host::HealthFlag::FAILED_ACTIVE_HC)) {
     parent.incHealthy();
@@ -276,7 +483,7 @@ void HealthCheckerImplBase::ActiveHealthCheckSession::onDeferredDeleteBase() {
 
   // Run callbacks in case something is waiting for health checks to run which will now never run.
   if (first_check_) {
-    parent_.runCallbacks(host_, HealthTransition::Unchanged, state);
+    parent_.onCheckResult(host_, HealthTransition::Unchanged, state);
   }
 }
 
@@ -340,7 +547,7 @@ void HealthCheckerImplBase::ActiveHealthCheckSession::handleSuccess(bool degrade
 
   parent_.stats_.success_.inc();
   first_check_ = false;
-  parent_.runCallbacks(host_, changed_state, HealthState::Healthy);
+  parent_.onCheckResult(host_, changed_state, HealthState::Healthy);
 
   timeout_timer_->disableTimer();
   interval_timer_->enableTimer(parent_.interval(HealthState::Healthy, changed_state));
@@ -398,7 +605,7 @@ HealthTransition HealthCheckerImplBase::ActiveHealthCheckSession::setUnhealthy(
   }
 
   first_check_ = false;
-  parent_.runCallbacks(host_, changed_state, HealthState::Unhealthy);
+  parent_.onCheckResult(host_, changed_state, HealthState::Unhealthy);
   return changed_state;
 }
 
@@ -1,6 +1,12 @@
 #pragma once
 
+#include <atomic>
+#include <functional>
+#include <limits>
+#include <vector>
+
 #include "envoy/access_log/access_log.h"
+#include "envoy/api/api.h"
 #include "envoy/common/callback.h"
 #include "envoy/common/random_generator.h"
 #include "envoy/config/core/v3/health_check.pb.h"
@@ -8,11 +14,13 @@
 #include "envoy/event/timer.h"
 #include "envoy/runtime/runtime.h"
 #include "envoy/stats/scope.h"
+#include "envoy/thread/thread.h"
 #include "envoy/type/matcher/string.pb.h"
 #include "envoy/upstream/health_checker.h"
 
 #include "source/common/common/logger.h"
 #include "source/common/common/matchers.h"
+#include "source/common/common/thread.h"
 #include "source/common/network/transport_socket_options_impl.h"
 
 namespace Envoy {
@@ -54,6 +62,12 @@ public:
   MetadataConstSharedPtr transportSocketMatchMetadata() const {
     return transport_socket_match_metadata_;
   }
+  /**
+   * Creates the threads the sessions are spread over when session_threads is configured. Only
+   * called by the health checkers whose sessions can run away from the main thread, before
+   * start(). These health checkers must call stopSessionShards() from their destructor.
+   */
+  void createSessionShards(Api::Api& api);
 
 protected:
   class ActiveHealthCheckSession : public Event::DeferredDeletable {
@@ -69,6 +83,8 @@ protected:
 
     void handleSuccess(bool degraded = false);
     void handleFailure(envoy::data::core::v3::HealthCheckFailureType type, bool retriable = false);
+    // The dispatcher of the thread running the session.
+    Event::Dispatcher& dispatcher() { return dispatcher_; }
 
     HostSharedPtr host_;
 
@@ -85,6 +101,7 @@ protected:
     void onInitialInterval();
 
     HealthCheckerImplBase& parent_;
+    Event::Dispatcher& dispatcher_;
     Event::TimerPtr interval_timer_;
     Event::TimerPtr timeout_timer_;
     uint32_t num_unhealthy_{};
@@ -102,6 +119,8 @@ protected:
 
   virtual ActiveHealthCheckSessionPtr makeSession(HostSharedPtr host) PURE;
   virtual envoy::data::core::v3::HealthCheckerType healthCheckerType() const PURE;
+  // Destroys the sessions running away from the main thread and joins their threads.
+  void stopSessionShards();
 
   const bool always_log_health_check_failures_;
   const bool always_log_health_check_success_;
@@ -129,6 +148,45 @@ private:
     std::weak_ptr<Host> host_;
   };
 
+  // A thread running the sessions of the hosts it owns. The sessions only update the fields of
+  // their host that are atomic, the health flags and the last health check pass time, and the
+  // stats. The host status callbacks and the event logging run on the main thread.
+  struct SessionShard {
+    Event::DispatcherPtr dispatcher_;
+    Thread::ThreadPtr thread_;
+    // Only accessed on the thread of the shard.
+    absl::node_hash_map<HostSharedPtr, ActiveHealthCheckSessionPtr> sessions_;
+  };
+
+  // Hands the events of the sessions running away from the main thread to the main thread, with
+  // the other results of their checks.
+  class MainThreadEventLogger : public HealthCheckEventLogger {
+  public:
+    MainThreadEventLogger(HealthCheckerImplBase& parent, HealthCheckEventLoggerPtr&& logger)
+        : parent_(parent), logger_(std::move(logger)) {}
+
+    // Upstream::HealthCheckEventLogger
+    void logEjectUnhealthy(envoy::data::core::v3::HealthCheckerType health_checker_type,
+                           const HostDescriptionConstSharedPtr& host,
+                           envoy::data::core::v3::HealthCheckFailureType failure_type) override;
+    void logUnhealthy(envoy::data::core::v3::HealthCheckerType health_checker_type,
+                      const HostDescriptionConstSharedPtr& host,
+                      envoy::data::core::v3::HealthCheckFailureType failure_type,
+                      bool first_check) override;
+    void logAddHealthy(envoy::data::core::v3::HealthCheckerType health_checker_type,
+                       const HostDescriptionConstSharedPtr& host, bool first_check) override;
+    void logSuccessfulHealthCheck(envoy::data::core::v3::HealthCheckerType health_checker_type,
+                                  const HostDescriptionConstSharedPtr& host) override;
+    void logDegraded(envoy::data::core::v3::HealthCheckerType health_checker_type,
+                     const HostDescriptionConstSharedPtr& host) override;
+    void logNoLongerDegraded(envoy::data::core::v3::HealthCheckerType health_checker_type,
+                             const HostDescriptionConstSharedPtr& host) override;
+
+  private:
+    HealthCheckerImplBase& parent_;
+    const HealthCheckEventLoggerPtr logger_;
+  };
+
   void addHosts(const HostVector& hosts);
   void decHealthy();
   void decDegraded();
@@ -141,6 +199,13 @@ private:
   void onClusterMemberUpdate(const HostVector& hosts_added, const HostVector& hosts_removed);
   void runCallbacks(HostSharedPtr host, HealthTransition changed_state,
                     HealthState current_check_result);
+  // Runs the callbacks for the result of a check, on the main thread.
+  void onCheckResult(HostSharedPtr host, HealthTransition changed_state,
+                     HealthState current_check_result);
+  void postToMainThread(std::function<void()> cb);
+  void runMainThreadBatch();
+  void refreshIntervalBounds();
+  SessionShard& shardForHost(const HostSharedPtr& host);
   void setUnhealthyCrossThread(const HostSharedPtr& host,
                                HealthCheckHostMonitor::UnhealthyType type);
   static std::shared_ptr<const Network::TransportSocketOptionsImpl>
@@ -161,6 +226,16 @@ private:
   absl::node_hash_map<HostSharedPtr, ActiveHealthCheckSessionPtr> active_sessions_;
   const std::shared_ptr<const Network::TransportSocketOptionsImpl> transport_socket_options_;
   const MetadataConstSharedPtr transport_socket_match_metadata_;
+  const uint32_t session_threads_;
+  // The sessions run on the main thread when there is no shard.
+  std::vector<std::unique_ptr<SessionShard>> shards_;
+  absl::node_hash_map<HostSharedPtr, SessionShard*> sharded_hosts_;
+  // The results of the checks of the shards waiting to be handled on the main thread.
+  Thread::MutexBasicLockable main_thread_batch_lock_;
+  std::vector<std::function<void()>> main_thread_batch_ ABSL_GUARDED_BY(main_thread_batch_lock_);
+  // The runtime bounds of the intervals, as the shards can't read the runtime.
+  std::atomic<uint64_t> min_interval_{0};
+  std::atomic<uint64_t> max_interval_{std::numeric_limits<uint64_t>::max()};
   const Common::CallbackHandlePtr member_update_cb_;
 };
 
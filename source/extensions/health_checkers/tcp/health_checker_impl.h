@@ -49,6 +49,8 @@ public:
   TcpHealthCheckerImpl(const Cluster& cluster, const envoy::config::core::v3::HealthCheck& config,
                        Event::Dispatcher& dispatcher, Runtime::Loader& runtime,
                        Random::RandomGenerator& random, HealthCheckEventLoggerPtr&& event_logger);
+  // The sessions running on the session threads reference the members of this class.
+  ~TcpHealthCheckerImpl() override { stopSessionShards(); }
 
 private:
   struct TcpActiveHealthCheckSession;
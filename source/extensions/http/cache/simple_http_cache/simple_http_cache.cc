@@ -2,10 +2,14 @@
 
 #include "envoy/extensions/http/cache/simple_http_cache/v3/config.pb.h"
 #include "envoy/registry/registry.h"
+#include "envoy/singleton/manager.h"
 
 #include "source/common/buffer/buffer_impl.h"
 #include "source/common/http/header_map_impl.h"
 
+#include "absl/container/flat_hash_map.h"
+#include "absl/strings/str_join.h"
+
 namespace Envoy {
 namespace Extensions {
 namespace HttpFilters {
@@ -31,6 +35,22 @@ absl::optional<Key> variedRequestKey(const LookupRequest& request,
   return varied_request_key;
 }
 
+// A buffer fragment referencing a cached body, which it keeps alive until drained.
+class SharedBodyFragment : public Buffer::BufferFragment {
+public:
+  SharedBodyFragment(std::shared_ptr<const std::string> body, const AdjustedByteRange& range)
+      : body_(std::move(body)), range_(range) {}
+
+  // Buffer::BufferFragment
+  const void* data() const override { return body_->data() + range_.begin(); }
+  size_t size() const override { return range_.length(); }
+  void done() override { delete this; }
+
+private:
+  const std::shared_ptr<const std::string> body_;
+  const AdjustedByteRange range_;
+};
+
 class SimpleLookupContext : public LookupContext {
 public:
   SimpleLookupContext(SimpleHttpCache& cache, LookupRequest&& request)
@@ -41,14 +61,17 @@ public:
     body_ = std::move(entry.body_);
     trailers_ = std::move(entry.trailers_);
     cb(entry.response_headers_ ? request_.makeLookupResult(std::move(entry.response_headers_),
-                                                           std::move(entry.metadata_), body_.size(),
-                                                           trailers_ != nullptr)
+                                                           std::move(entry.metadata_),
+                                                           body_->size(), trailers_ != nullptr)
                                : LookupResult{});
   }
 
   void getBody(const AdjustedByteRange& range, LookupBodyCallback&& cb) override {
-    ASSERT(range.end() <= body_.length(), "Attempt to read past end of body.");
-    cb(std::make_unique<Buffer::OwnedImpl>(&body_[range.begin()], range.length()));
+    ASSERT(range.end() <= body_->length(), "Attempt to read past end of body.");
+    // The body is shared with the cache rather than copied.
+    auto buffer = std::make_unique<Buffer::OwnedImpl>();
+    buffer->addBufferFragment(*new SharedBodyFragment(body_, range));
+    cb(std::move(buffer));
   }
 
   // The cache must call cb with the cached trailers.
@@ -63,7 +86,7 @@ public:
 private:
   SimpleHttpCache& cache_;
   const LookupRequest request_;
-  std::string body_;
+  std::shared_ptr<const std::string> body_;
   Http::ResponseTrailerMapPtr trailers_;
 };
 
@@ -142,93 +165,160 @@ LookupContextPtr SimpleHttpCache::makeLookupContext(LookupRequest&& request,
   return std::make_unique<SimpleLookupContext>(*this, std::move(request));
 }
 
+SimpleHttpCache::SimpleHttpCache(const ConfigProto& config, Stats::Scope& scope)
+    : config_(config), stats_({ALL_SIMPLE_HTTP_CACHE_STATS(
+                           POOL_COUNTER_PREFIX(scope, "simple_http_cache."),
+                           POOL_GAUGE_PREFIX(scope, "simple_http_cache."))}),
+      max_shard_size_bytes_(config.max_cache_size_bytes() /
+                            PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, shards, 16)) {
+  shards_.resize(PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, shards, 16));
+  for (auto& shard : shards_) {
+    shard = std::make_unique<Shard>();
+  }
+}
+
+SimpleHttpCache::Shard& SimpleHttpCache::shardFor(const Key& key) {
+  return *shards_[stableHashKey(key) % shards_.size()];
+}
+
+uint64_t SimpleHttpCache::entrySize(const Entry& entry) {
+  return entry.response_headers_->byteSize() + entry.body_->size() +
+         (entry.trailers_ ? entry.trailers_->byteSize() : 0);
+}
+
 void SimpleHttpCache::updateHeaders(const LookupContext& lookup_context,
                                     const Http::ResponseHeaderMap& response_headers,
                                     const ResponseMetadata& metadata,
                                     std::function<void(bool)> on_complete) {
   const auto& simple_lookup_context = static_cast<const SimpleLookupContext&>(lookup_context);
-  const Key& key = simple_lookup_context.request().key();
-  absl::WriterMutexLock lock(&mutex_);
-  auto iter = map_.find(key);
-  if (iter == map_.end() || !iter->second.response_headers_) {
-    on_complete(false);
-    return;
-  }
-  if (VaryHeaderUtils::hasVary(*iter->second.response_headers_)) {
-    absl::optional<Key> varied_key =
-        variedRequestKey(simple_lookup_context.request(), *iter->second.response_headers_);
-    if (!varied_key.has_value()) {
-      on_complete(false);
-      return;
+  const LookupRequest& request = simple_lookup_context.request();
+  on_complete(updateKey(request.key(), request, response_headers, metadata, true));
+}
+
+bool SimpleHttpCache::updateKey(const Key& key, const LookupRequest& request,
+                                const Http::ResponseHeaderMap& response_headers,
+                                const ResponseMetadata& metadata, bool resolve_vary) {
+  absl::optional<Key> varied_key;
+  {
+    Shard& shard = shardFor(key);
+    absl::MutexLock lock(&shard.mutex_);
+    auto iter = shard.map_.find(key);
+    if (iter == shard.map_.end()) {
+      return false;
     }
-    iter = map_.find(varied_key.value());
-    if (iter == map_.end() || !iter->second.response_headers_) {
-      on_complete(false);
-      return;
+    CachedEntry& cached = iter->second;
+    if (!resolve_vary || !VaryHeaderUtils::hasVary(*cached.entry_.response_headers_)) {
+      applyHeaderUpdate(response_headers, *cached.entry_.response_headers_);
+      cached.entry_.metadata_ = metadata;
+      // The shard may go over its capacity until the next insert evicts.
+      const uint64_t size_bytes = entrySize(cached.entry_);
+      shard.size_bytes_ = shard.size_bytes_ - cached.size_bytes_ + size_bytes;
+      stats_.size_bytes_.sub(cached.size_bytes_);
+      stats_.size_bytes_.add(size_bytes);
+      cached.size_bytes_ = size_bytes;
+      return true;
     }
+    varied_key = variedRequestKey(request, *cached.entry_.response_headers_);
   }
-  Entry& entry = iter->second;
-
-  applyHeaderUpdate(response_headers, *entry.response_headers_);
-  entry.metadata_ = metadata;
-  on_complete(true);
+  // The varied entry may live in another shard, so it's updated once the marker's lock is gone.
+  return varied_key.has_value() &&
+         updateKey(varied_key.value(), request, response_headers, metadata, false);
 }
 
 SimpleHttpCache::Entry SimpleHttpCache::lookup(const LookupRequest& request) {
-  absl::ReaderMutexLock lock(&mutex_);
-  auto iter = map_.find(request.key());
-  if (iter == map_.end()) {
+  Entry entry = lookupKey(request.key());
+  if (entry.response_headers_ && VaryHeaderUtils::hasVary(*entry.response_headers_)) {
+    absl::optional<Key> varied_key = variedRequestKey(request, *entry.response_headers_);
+    entry = varied_key.has_value() ? lookupKey(varied_key.value()) : Entry{};
+  }
+  if (entry.response_headers_) {
+    stats_.hits_.inc();
+  } else {
+    stats_.misses_.inc();
+  }
+  return entry;
+}
+
+SimpleHttpCache::Entry SimpleHttpCache::lookupKey(const Key& key) {
+  Shard& shard = shardFor(key);
+  absl::MutexLock lock(&shard.mutex_);
+  auto iter = shard.map_.find(key);
+  if (iter == shard.map_.end()) {
     return Entry{};
   }
-  ASSERT(iter->second.response_headers_);
+  CachedEntry& cached = iter->second;
+  ASSERT(cached.entry_.response_headers_);
+  shard.lru_.splice(shard.lru_.begin(), shard.lru_, cached.lru_position_);
 
-  if (VaryHeaderUtils::hasVary(*iter->second.response_headers_)) {
-    return varyLookup(request, iter->second.response_headers_);
-  } else {
-    Http::ResponseTrailerMapPtr trailers_map;
-    if (iter->second.trailers_) {
-      trailers_map = Http::createHeaderMap<Http::ResponseTrailerMapImpl>(*iter->second.trailers_);
-    }
-    return SimpleHttpCache::Entry{
-        Http::createHeaderMap<Http::ResponseHeaderMapImpl>(*iter->second.response_headers_),
-        iter->second.metadata_, iter->second.body_, std::move(trailers_map)};
+  Http::ResponseTrailerMapPtr trailers_map;
+  if (cached.entry_.trailers_) {
+    trailers_map = Http::createHeaderMap<Http::ResponseTrailerMapImpl>(*cached.entry_.trailers_);
   }
+  return SimpleHttpCache::Entry{
+      Http::createHeaderMap<Http::ResponseHeaderMapImpl>(*cached.entry_.response_headers_),
+      cached.entry_.metadata_, cached.entry_.body_, std::move(trailers_map)};
 }
 
 bool SimpleHttpCache::insert(const Key& key, Http::ResponseHeaderMapPtr&& response_headers,
                              ResponseMetadata&& metadata, std::string&& body,
                              Http::ResponseTrailerMapPtr&& trailers) {
-  absl::WriterMutexLock lock(&mutex_);
-  map_[key] = SimpleHttpCache::Entry{std::move(response_headers), std::move(metadata),
-                                     std::move(body), std::move(trailers)};
-  return true;
+  return insertInShard(key,
+                       SimpleHttpCache::Entry{std::move(response_headers), std::move(metadata),
+                                              std::make_shared<const std::string>(std::move(body)),
+                                              std::move(trailers)},
+                       true);
 }
 
-SimpleHttpCache::Entry
-SimpleHttpCache::varyLookup(const LookupRequest& request,
-                            const Http::ResponseHeaderMapPtr& response_headers) {
-  // This method should be called from lookup, which holds the mutex for reading.
-  mutex_.AssertReaderHeld();
-
-  absl::optional<Key> varied_key = variedRequestKey(request, *response_headers);
-  if (!varied_key.has_value()) {
-    return SimpleHttpCache::Entry{};
+bool SimpleHttpCache::insertInShard(const Key& key, Entry&& entry, bool replace) {
+  const uint64_t size_bytes = entrySize(entry);
+  if (max_shard_size_bytes_ != 0 && size_bytes > max_shard_size_bytes_) {
+    stats_.inserts_too_large_.inc();
+    return false;
   }
-  Key& varied_request_key = varied_key.value();
+  Shard& shard = shardFor(key);
+  absl::MutexLock lock(&shard.mutex_);
+  auto iter = shard.map_.find(key);
+  if (iter != shard.map_.end()) {
+    if (!replace) {
+      return true;
+    }
+    eraseLocked(shard, iter);
+  }
+  evictLocked(shard, size_bytes);
+
+  iter = shard.map_.try_emplace(key).first;
+  CachedEntry& cached = iter->second;
+  cached.entry_ = std::move(entry);
+  cached.size_bytes_ = size_bytes;
+  shard.lru_.push_front(&iter->first);
+  cached.lru_position_ = shard.lru_.begin();
+  shard.size_bytes_ += size_bytes;
+  stats_.size_bytes_.add(size_bytes);
+  stats_.entries_.inc();
+  if (replace) {
+    stats_.inserts_.inc();
+  }
+  return true;
+}
 
-  auto iter = map_.find(varied_request_key);
-  if (iter == map_.end()) {
-    return SimpleHttpCache::Entry{};
+void SimpleHttpCache::evictLocked(Shard& shard, uint64_t needed_bytes) {
+  if (max_shard_size_bytes_ == 0) {
+    return;
   }
-  ASSERT(iter->second.response_headers_);
-  Http::ResponseTrailerMapPtr trailers_map;
-  if (iter->second.trailers_) {
-    trailers_map = Http::createHeaderMap<Http::ResponseTrailerMapImpl>(*iter->second.trailers_);
+  while (!shard.lru_.empty() && shard.size_bytes_ + needed_bytes > max_shard_size_bytes_) {
+    // An evicted vary marker leaves its varied entries unreachable until they are evicted too.
+    eraseLocked(shard, shard.map_.find(*shard.lru_.back()));
+    stats_.evictions_.inc();
   }
+}
 
-  return SimpleHttpCache::Entry{
-      Http::createHeaderMap<Http::ResponseHeaderMapImpl>(*iter->second.response_headers_),
-      iter->second.metadata_, iter->second.body_, std::move(trailers_map)};
+void SimpleHttpCache::eraseLocked(Shard& shard, EntryMap::iterator iter) {
+  ASSERT(iter != shard.map_.end());
+  shard.lru_.erase(iter->second.lru_position_);
+  shard.size_bytes_ -= iter->second.size_bytes_;
+  stats_.size_bytes_.sub(iter->second.size_bytes_);
+  stats_.entries_.dec();
+  shard.map_.erase(iter);
 }
 
 bool SimpleHttpCache::varyInsert(const Key& request_key,
@@ -237,8 +327,6 @@ bool SimpleHttpCache::varyInsert(const Key& request_key,
                                  const Http::RequestHeaderMap& request_headers,
                                  const VaryAllowList& vary_allow_list,
                                  Http::ResponseTrailerMapPtr&& trailers) {
-  absl::WriterMutexLock lock(&mutex_);
-
   absl::btree_set<absl::string_view> vary_header_values =
       VaryHeaderUtils::getVaryValues(*response_headers);
   ASSERT(!vary_header_values.empty());
@@ -251,27 +339,33 @@ bool SimpleHttpCache::varyInsert(const Key& request_key,
     // Skip the insert if we are unable to create a vary key.
     return false;
   }
+  // The vary values point into the response headers, which are moved into the entry below.
+  const std::string vary_header = absl::StrJoin(vary_header_values, ",");
 
   varied_request_key.add_custom_fields(vary_identifier.value());
-  map_[varied_request_key] = SimpleHttpCache::Entry{
-      std::move(response_headers), std::move(metadata), std::move(body), std::move(trailers)};
-
-  // Add a special entry to flag that this request generates varied responses.
-  auto iter = map_.find(request_key);
-  if (iter == map_.end()) {
-    Envoy::Http::ResponseHeaderMapPtr vary_only_map =
-        Envoy::Http::createHeaderMap<Envoy::Http::ResponseHeaderMapImpl>({});
-    vary_only_map->setCopy(Envoy::Http::CustomHeaders::get().Vary,
-                           absl::StrJoin(vary_header_values, ","));
-    // TODO(cbdm): In a cache that evicts entries, we could maintain a list of the "varykey"s that
-    // we have inserted as the body for this first lookup. This way, we would know which keys we
-    // have inserted for that resource. For the first entry simply use vary_identifier as the
-    // entry_list; for future entries append vary_identifier to existing list.
-    std::string entry_list;
-    map_[request_key] =
-        SimpleHttpCache::Entry{std::move(vary_only_map), {}, std::move(entry_list), {}};
+  if (!insertInShard(varied_request_key,
+                     SimpleHttpCache::Entry{std::move(response_headers), std::move(metadata),
+                                            std::make_shared<const std::string>(std::move(body)),
+                                            std::move(trailers)},
+                     true)) {
+    return false;
   }
-  return true;
+
+  // Add a special entry to flag that this request generates varied responses, unless there is
+  // one already.
+  Envoy::Http::ResponseHeaderMapPtr vary_only_map =
+      Envoy::Http::createHeaderMap<Envoy::Http::ResponseHeaderMapImpl>({});
+  vary_only_map->setCopy(Envoy::Http::CustomHeaders::get().Vary, vary_header);
+  // TODO(cbdm): In a cache that evicts entries, we could maintain a list of the "varykey"s that
+  // we have inserted as the body for this first lookup. This way, we would know which keys we
+  // have inserted for that resource. For the first entry simply use vary_identifier as the
+  // entry_list; for future entries append vary_identifier to existing list.
+  return insertInShard(request_key,
+                       SimpleHttpCache::Entry{std::move(vary_only_map),
+                                              {},
+                                              std::make_shared<const std::string>(),
+                                              {}},
+                       false);
 }
 
 InsertContextPtr SimpleHttpCache::makeInsertContext(LookupContextPtr&& lookup_context,
@@ -288,6 +382,34 @@ CacheInfo SimpleHttpCache::cacheInfo() const {
   return cache_info;
 }
 
+/**
+ * A singleton holding the SimpleHttpCaches, so that the filters configured with equivalent
+ * configs share a cache. It is pinned, since the filters only reference the caches it hands out.
+ */
+class CacheSingleton : public Singleton::Instance {
+public:
+  std::shared_ptr<SimpleHttpCache> get(const SimpleHttpCache::ConfigProto& config,
+                                       Stats::Scope& stats_scope) {
+    std::shared_ptr<SimpleHttpCache> cache;
+    const size_t key = MessageUtil::hash(config);
+    absl::MutexLock lock(&mu_);
+    auto it = caches_.find(key);
+    if (it != caches_.end()) {
+      cache = it->second.lock();
+    }
+    if (!cache) {
+      cache = std::make_shared<SimpleHttpCache>(config, stats_scope);
+      caches_[key] = cache;
+    }
+    return cache;
+  }
+
+private:
+  absl::Mutex mu_;
+  // The caches are destroyed once no filter config uses them anymore.
+  absl::flat_hash_map<size_t, std::weak_ptr<SimpleHttpCache>> caches_ ABSL_GUARDED_BY(mu_);
+};
+
 SINGLETON_MANAGER_REGISTRATION(simple_http_cache_singleton);
 
 class SimpleHttpCacheFactory : public HttpCacheFactory {
@@ -296,20 +418,19 @@ public:
   std::string name() const override { return std::string(Name); }
   // From TypedFactory
   ProtobufTypes::MessagePtr createEmptyConfigProto() override {
-    return std::make_unique<
-        envoy::extensions::http::cache::simple_http_cache::v3::SimpleHttpCacheConfig>();
+    return std::make_unique<SimpleHttpCache::ConfigProto>();
   }
   // From HttpCacheFactory
   std::shared_ptr<HttpCache>
-  getCache(const envoy::extensions::filters::http::cache::v3::CacheConfig&,
+  getCache(const envoy::extensions::filters::http::cache::v3::CacheConfig& filter_config,
            Server::Configuration::FactoryContext& context) override {
-    return context.serverFactoryContext().singletonManager().getTyped<SimpleHttpCache>(
-        SINGLETON_MANAGER_REGISTERED_NAME(simple_http_cache_singleton), &createCache);
-  }
-
-private:
-  static std::shared_ptr<Singleton::Instance> createCache() {
-    return std::make_shared<SimpleHttpCache>();
+    SimpleHttpCache::ConfigProto config;
+    THROW_IF_NOT_OK(MessageUtil::unpackTo(filter_config.typed_config(), config));
+    std::shared_ptr<CacheSingleton> caches =
+        context.serverFactoryContext().singletonManager().getTyped<CacheSingleton>(
+            SINGLETON_MANAGER_REGISTERED_NAME(simple_http_cache_singleton),
+            [] { return std::make_shared<CacheSingleton>(); }, /*pin=*/true);
+    return caches->get(config, context.serverFactoryContext().scope());
   }
 };
 
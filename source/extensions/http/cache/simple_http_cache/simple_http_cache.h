@@ -1,10 +1,19 @@
 #pragma once
 
+#include <list>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "envoy/extensions/http/cache/simple_http_cache/v3/config.pb.h"
+#include "envoy/stats/scope.h"
+#include "envoy/stats/stats_macros.h"
+
 #include "source/common/protobuf/utility.h"
 #include "source/extensions/filters/http/cache/http_cache.h"
 
 #include "absl/base/thread_annotations.h"
-#include "absl/container/flat_hash_map.h"
+#include "absl/container/node_hash_map.h"
 #include "absl/synchronization/mutex.h"
 
 namespace Envoy {
@@ -12,27 +21,41 @@ namespace Extensions {
 namespace HttpFilters {
 namespace Cache {
 
-// Example cache backend that never evicts. Not suitable for production use.
-class SimpleHttpCache : public HttpCache, public Singleton::Instance {
-private:
+/**
+ * All simple http cache stats. @see stats_macros.h
+ */
+#define ALL_SIMPLE_HTTP_CACHE_STATS(COUNTER, GAUGE)                                                \
+  COUNTER(evictions)                                                                               \
+  COUNTER(hits)                                                                                    \
+  COUNTER(inserts)                                                                                 \
+  COUNTER(inserts_too_large)                                                                       \
+  COUNTER(misses)                                                                                  \
+  GAUGE(entries, NeverImport)                                                                      \
+  GAUGE(size_bytes, NeverImport)
+
+/**
+ * Struct definition for all simple http cache stats. @see stats_macros.h
+ */
+struct SimpleHttpCacheStats {
+  ALL_SIMPLE_HTTP_CACHE_STATS(GENERATE_COUNTER_STRUCT, GENERATE_GAUGE_STRUCT)
+};
+
+// In-memory cache backend. The entries are split between shards, each with its own lock and its
+// own LRU list, and the bodies are immutable and shared with the responses served from them, so
+// that a hit doesn't copy the body.
+class SimpleHttpCache : public HttpCache {
+public:
+  using ConfigProto = envoy::extensions::http::cache::simple_http_cache::v3::SimpleHttpCacheConfig;
+
   struct Entry {
     Http::ResponseHeaderMapPtr response_headers_;
     ResponseMetadata metadata_;
-    std::string body_;
+    std::shared_ptr<const std::string> body_;
     Http::ResponseTrailerMapPtr trailers_;
   };
 
-  // Looks for a response that has been varied. Only called from lookup.
-  Entry varyLookup(const LookupRequest& request,
-                   const Http::ResponseHeaderMapPtr& response_headers);
+  SimpleHttpCache(const ConfigProto& config, Stats::Scope& scope);
 
-  // A list of headers that we do not want to update upon validation
-  // We skip these headers because either it's updated by other application logic
-  // or they are fall into categories defined in the IETF doc below
-  // https://www.ietf.org/archive/id/draft-ietf-httpbis-cache-18.html s3.2
-  static const absl::flat_hash_set<Http::LowerCaseString> headersNotToUpdate();
-
-public:
   // HttpCache
   LookupContextPtr makeLookupContext(LookupRequest&& request,
                                      Http::StreamDecoderFilterCallbacks& callbacks) override;
@@ -55,8 +78,60 @@ public:
                   const Http::RequestHeaderMap& request_headers,
                   const VaryAllowList& vary_allow_list, Http::ResponseTrailerMapPtr&& trailers);
 
-  absl::Mutex mutex_;
-  absl::flat_hash_map<Key, Entry, MessageUtil, MessageUtil> map_ ABSL_GUARDED_BY(mutex_);
+  const ConfigProto& config() const { return config_; }
+  const SimpleHttpCacheStats& stats() const { return stats_; }
+
+private:
+  struct CachedEntry {
+    Entry entry_;
+    uint64_t size_bytes_{};
+    // The position of the entry in the LRU list of its shard.
+    std::list<const Key*>::iterator lru_position_;
+  };
+
+  using EntryMap = absl::node_hash_map<Key, CachedEntry, MessageUtil, MessageUtil>;
+
+  struct Shard {
+    absl::Mutex mutex_;
+    // The entry nodes are stable, so the LRU list points to their keys.
+    EntryMap map_ ABSL_GUARDED_BY(mutex_);
+    // The most recently used keys first.
+    std::list<const Key*> lru_ ABSL_GUARDED_BY(mutex_);
+    uint64_t size_bytes_ ABSL_GUARDED_BY(mutex_){};
+  };
+
+  Shard& shardFor(const Key& key);
+
+  // Returns a copy of the entry of the key, sharing its body, and marks it as recently used.
+  Entry lookupKey(const Key& key);
+
+  // Applies the header update to the entry of the key. If resolve_vary is set and the entry is
+  // a vary marker, the update is applied to the varied entry of the request instead.
+  bool updateKey(const Key& key, const LookupRequest& request,
+                 const Http::ResponseHeaderMap& response_headers, const ResponseMetadata& metadata,
+                 bool resolve_vary);
+
+  // Inserts the entry, evicting the least recently used entries of the shard to make room for
+  // it. Unless replace is set, an existing entry of the key is kept.
+  bool insertInShard(const Key& key, Entry&& entry, bool replace);
+
+  void evictLocked(Shard& shard, uint64_t needed_bytes) ABSL_EXCLUSIVE_LOCKS_REQUIRED(shard.mutex_);
+  void eraseLocked(Shard& shard, EntryMap::iterator iter)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(shard.mutex_);
+
+  static uint64_t entrySize(const Entry& entry);
+
+  // A list of headers that we do not want to update upon validation
+  // We skip these headers because either it's updated by other application logic
+  // or they are fall into categories defined in the IETF doc below
+  // https://www.ietf.org/archive/id/draft-ietf-httpbis-cache-18.html s3.2
+  static const absl::flat_hash_set<Http::LowerCaseString> headersNotToUpdate();
+
+  const ConfigProto config_;
+  SimpleHttpCacheStats stats_;
+  // The capacity of each shard, zero if unbounded.
+  const uint64_t max_shard_size_bytes_;
+  std::vector<std::unique_ptr<Shard>> shards_;
 };
 
 } // namespace Cache
@@ -0,0 +1,296 @@
+#include "source/extensions/http/cache/tiered_http_cache/tiered_http_cache.h"
+
+#include "envoy/extensions/http/cache/tiered_http_cache/v3/config.pb.h"
+#include "envoy/registry/registry.h"
+
+#include "source/common/http/header_map_impl.h"
+#include "source/common/protobuf/utility.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace Cache {
+namespace {
+
+constexpr absl::string_view Name = "envoy.extensions.http.cache.tiered";
+constexpr uint32_t DefaultPromotionHits = 2;
+// The number of keys whose hits are counted before the counts are cleared.
+constexpr size_t MaxTrackedKeys = 64 * 1024;
+
+bool isServable(CacheEntryStatus status) {
+  return status == CacheEntryStatus::Ok || status == CacheEntryStatus::FoundNotModified;
+}
+
+class TieredLookupContext : public LookupContext {
+public:
+  TieredLookupContext(TieredHttpCache& cache, LookupRequest&& request,
+                      Http::StreamDecoderFilterCallbacks& decoder_callbacks)
+      : cache_(cache), request_(std::move(request)), decoder_callbacks_(decoder_callbacks),
+        lookups_(cache.tiers().size()) {}
+
+  void setEncoderFilterCallbacks(Http::StreamEncoderFilterCallbacks& callbacks) override {
+    encoder_callbacks_ = &callbacks;
+  }
+
+  void getHeaders(LookupHeadersCallback&& cb) override { lookUpTier(0, std::move(cb)); }
+
+  void getBody(const AdjustedByteRange& range, LookupBodyCallback&& cb) override {
+    lookups_[serving_tier_]->getBody(
+        range, [this, begin = range.begin(), cb = std::move(cb)](Buffer::InstancePtr&& body) {
+          if (promotion_state_ == PromotionState::InProgress) {
+            promoteBody(begin, body.get());
+          }
+          cb(std::move(body));
+        });
+  }
+
+  void getTrailers(LookupTrailersCallback&& cb) override {
+    lookups_[serving_tier_]->getTrailers(
+        [this, cb = std::move(cb)](Http::ResponseTrailerMapPtr&& trailers) {
+          if (promotion_state_ == PromotionState::InProgress) {
+            promoteTrailers(trailers.get());
+          }
+          cb(std::move(trailers));
+        });
+  }
+
+  void onDestroy() override {
+    if (promotion_ != nullptr) {
+      if (promotion_state_ == PromotionState::InProgress) {
+        abortPromotion();
+      }
+      promotion_->onDestroy();
+    }
+    for (LookupContextPtr& lookup : lookups_) {
+      if (lookup != nullptr) {
+        lookup->onDestroy();
+      }
+    }
+  }
+
+  // Returns the lookup context of the last tier, for an insert into it, looking the request up in
+  // the last tier if it wasn't already. The insert context may or may not take its ownership.
+  LookupContextPtr& lastTierLookup() {
+    if (lookups_.back() == nullptr) {
+      lookups_.back() = makeTierLookup(lookups_.size() - 1);
+    }
+    return lookups_.back();
+  }
+
+  size_t servingTier() const { return serving_tier_; }
+  const LookupContext& servingLookup() const { return *lookups_[serving_tier_]; }
+
+private:
+  enum class PromotionState { None, InProgress, Done, Aborted };
+
+  LookupContextPtr makeTierLookup(size_t tier) {
+    LookupContextPtr lookup =
+        cache_.tiers()[tier]->makeLookupContext(LookupRequest(request_), decoder_callbacks_);
+    if (encoder_callbacks_ != nullptr) {
+      lookup->setEncoderFilterCallbacks(*encoder_callbacks_);
+    }
+    return lookup;
+  }
+
+  void lookUpTier(size_t tier, LookupHeadersCallback&& cb) {
+    lookups_[tier] = makeTierLookup(tier);
+    lookups_[tier]->getHeaders([this, tier, cb = std::move(cb)](LookupResult&& result) mutable {
+      onTierHeaders(tier, std::move(result), std::move(cb));
+    });
+  }
+
+  void onTierHeaders(size_t tier, LookupResult&& result, LookupHeadersCallback&& cb) {
+    if (!isServable(result.cache_entry_status_) && tier + 1 < lookups_.size()) {
+      lookUpTier(tier + 1, std::move(cb));
+      return;
+    }
+    serving_tier_ = tier;
+    if (tier > 0 && result.cache_entry_status_ == CacheEntryStatus::Ok) {
+      cache_.stats().lower_tier_hits_.inc();
+      if (cache_.recordLowerTierHit(request_.key())) {
+        startPromotion(result);
+      }
+    }
+    cb(std::move(result));
+  }
+
+  // Starts copying the entry being served into the first tier, through the lookup context of the
+  // first tier. The body is copied as the filter reads it, so the entry is only promoted if the
+  // whole body is read in order, which range requests don't.
+  void startPromotion(const LookupResult& result) {
+    if (encoder_callbacks_ == nullptr || lookups_[0] == nullptr) {
+      return;
+    }
+    promotion_ = cache_.tiers()[0]->makeInsertContext(std::move(lookups_[0]), *encoder_callbacks_);
+    if (promotion_ == nullptr) {
+      return;
+    }
+    promotion_state_ = PromotionState::InProgress;
+    content_length_ = result.content_length_;
+    has_trailers_ = result.has_trailers_;
+    promotion_pending_ = true;
+    const bool end_stream = content_length_ == 0 && !has_trailers_;
+    promotion_->insertHeaders(
+        *result.headers_, {cache_.timeSource().systemTime()},
+        [this, end_stream](bool ready) { onPromotionReady(ready, end_stream); }, end_stream);
+  }
+
+  void promoteBody(uint64_t begin, const Buffer::Instance* body) {
+    // The first tier paces the copy, which is abandoned rather than holding back the response.
+    if (body == nullptr || promotion_pending_ || begin != promoted_bytes_) {
+      abortPromotion();
+      return;
+    }
+    promoted_bytes_ += body->length();
+    const bool end_stream = promoted_bytes_ >= content_length_ && !has_trailers_;
+    promotion_pending_ = true;
+    promotion_->insertBody(
+        *body, [this, end_stream](bool ready) { onPromotionReady(ready, end_stream); },
+        end_stream);
+  }
+
+  void promoteTrailers(const Http::ResponseTrailerMap* trailers) {
+    if (trailers == nullptr || promotion_pending_ || promoted_bytes_ < content_length_) {
+      abortPromotion();
+      return;
+    }
+    promotion_pending_ = true;
+    promotion_->insertTrailers(*trailers, [this](bool ready) { onPromotionReady(ready, true); });
+  }
+
+  void onPromotionReady(bool ready, bool end_stream) {
+    promotion_pending_ = false;
+    if (promotion_state_ != PromotionState::InProgress) {
+      return;
+    }
+    if (!ready) {
+      abortPromotion();
+    } else if (end_stream) {
+      promotion_state_ = PromotionState::Done;
+      cache_.stats().promotions_.inc();
+    }
+  }
+
+  // The insert context is destroyed in onDestroy, since this may be called from its callbacks.
+  void abortPromotion() {
+    promotion_state_ = PromotionState::Aborted;
+    cache_.stats().promotions_aborted_.inc();
+  }
+
+  TieredHttpCache& cache_;
+  const LookupRequest request_;
+  Http::StreamDecoderFilterCallbacks& decoder_callbacks_;
+  Http::StreamEncoderFilterCallbacks* encoder_callbacks_{};
+  // The lookup contexts of the tiers the request was looked up in.
+  std::vector<LookupContextPtr> lookups_;
+  size_t serving_tier_{};
+
+  InsertContextPtr promotion_;
+  PromotionState promotion_state_{PromotionState::None};
+  // Whether the first tier hasn't acknowledged the last part of the entry yet.
+  bool promotion_pending_{};
+  uint64_t promoted_bytes_{};
+  uint64_t content_length_{};
+  bool has_trailers_{};
+};
+
+} // namespace
+
+TieredHttpCache::TieredHttpCache(const ConfigProto& config,
+                                 std::vector<std::shared_ptr<HttpCache>> tiers,
+                                 TimeSource& time_source, Stats::Scope& scope)
+    : promotion_hits_(
+          PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, promotion_hits, DefaultPromotionHits)),
+      tiers_(std::move(tiers)), time_source_(time_source),
+      stats_({ALL_TIERED_HTTP_CACHE_STATS(POOL_COUNTER_PREFIX(scope, "tiered_http_cache."))}) {
+  ASSERT(tiers_.size() >= 2);
+}
+
+LookupContextPtr TieredHttpCache::makeLookupContext(LookupRequest&& request,
+                                                    Http::StreamDecoderFilterCallbacks& callbacks) {
+  return std::make_unique<TieredLookupContext>(*this, std::move(request), callbacks);
+}
+
+InsertContextPtr TieredHttpCache::makeInsertContext(LookupContextPtr&& lookup_context,
+                                                    Http::StreamEncoderFilterCallbacks& callbacks) {
+  ASSERT(lookup_context != nullptr);
+  // The tiered lookup context is left to the caller, since it owns the lookup context of the last
+  // tier unless the insert context takes it.
+  auto& tiered_lookup = static_cast<TieredLookupContext&>(*lookup_context);
+  return tiers_.back()->makeInsertContext(std::move(tiered_lookup.lastTierLookup()), callbacks);
+}
+
+void TieredHttpCache::updateHeaders(const LookupContext& lookup_context,
+                                    const Http::ResponseHeaderMap& response_headers,
+                                    const ResponseMetadata& metadata,
+                                    std::function<void(bool)> on_complete) {
+  const auto& tiered_lookup = static_cast<const TieredLookupContext&>(lookup_context);
+  tiers_[tiered_lookup.servingTier()]->updateHeaders(tiered_lookup.servingLookup(),
+                                                     response_headers, metadata,
+                                                     std::move(on_complete));
+}
+
+CacheInfo TieredHttpCache::cacheInfo() const {
+  CacheInfo cache_info;
+  cache_info.name_ = Name;
+  cache_info.supports_range_requests_ = true;
+  for (const std::shared_ptr<HttpCache>& tier : tiers_) {
+    cache_info.supports_range_requests_ &= tier->cacheInfo().supports_range_requests_;
+  }
+  return cache_info;
+}
+
+bool TieredHttpCache::recordLowerTierHit(const Key& key) {
+  const size_t key_hash = stableHashKey(key);
+  absl::MutexLock lock(&mutex_);
+  if (lower_tier_hits_.size() >= MaxTrackedKeys) {
+    lower_tier_hits_.clear();
+  }
+  auto it = lower_tier_hits_.try_emplace(key_hash, 0).first;
+  if (++it->second < promotion_hits_) {
+    return false;
+  }
+  lower_tier_hits_.erase(it);
+  return true;
+}
+
+class TieredHttpCacheFactory : public HttpCacheFactory {
+public:
+  // From UntypedFactory
+  std::string name() const override { return std::string(Name); }
+  // From TypedFactory
+  ProtobufTypes::MessagePtr createEmptyConfigProto() override {
+    return std::make_unique<TieredHttpCache::ConfigProto>();
+  }
+  // From HttpCacheFactory
+  std::shared_ptr<HttpCache>
+  getCache(const envoy::extensions::filters::http::cache::v3::CacheConfig& filter_config,
+           Server::Configuration::FactoryContext& context) override {
+    TieredHttpCache::ConfigProto config;
+    THROW_IF_NOT_OK(MessageUtil::unpackTo(filter_config.typed_config(), config));
+    std::vector<std::shared_ptr<HttpCache>> tiers;
+    for (const ProtobufWkt::Any& tier_config : config.tiers()) {
+      const std::string type{TypeUtil::typeUrlToDescriptorFullName(tier_config.type_url())};
+      HttpCacheFactory* const tier_factory =
+          Registry::FactoryRegistry<HttpCacheFactory>::getFactoryByType(type);
+      if (tier_factory == nullptr) {
+        throw EnvoyException(
+            fmt::format("Didn't find a registered implementation for type: '{}'", type));
+      }
+      // Each tier is configured like a cache of the filter, with its own typed config.
+      envoy::extensions::filters::http::cache::v3::CacheConfig tier_filter_config = filter_config;
+      *tier_filter_config.mutable_typed_config() = tier_config;
+      tiers.push_back(tier_factory->getCache(tier_filter_config, context));
+    }
+    return std::make_shared<TieredHttpCache>(config, std::move(tiers),
+                                             context.serverFactoryContext().timeSource(),
+                                             context.serverFactoryContext().scope());
+  }
+};
+
+static Registry::RegisterFactory<TieredHttpCacheFactory, HttpCacheFactory> register_;
+
+} // namespace Cache
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "envoy/common/time.h"
+#include "envoy/extensions/http/cache/tiered_http_cache/v3/config.pb.h"
+#include "envoy/stats/scope.h"
+#include "envoy/stats/stats_macros.h"
+
+#include "source/extensions/filters/http/cache/http_cache.h"
+
+#include "absl/base/thread_annotations.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/synchronization/mutex.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace Cache {
+
+/**
+ * All tiered http cache stats. @see stats_macros.h
+ */
+#define ALL_TIERED_HTTP_CACHE_STATS(COUNTER)                                                       \
+  COUNTER(lower_tier_hits)                                                                         \
+  COUNTER(promotions)                                                                              \
+  COUNTER(promotions_aborted)
+
+/**
+ * Struct definition for all tiered http cache stats. @see stats_macros.h
+ */
+struct TieredHttpCacheStats {
+  ALL_TIERED_HTTP_CACHE_STATS(GENERATE_COUNTER_STRUCT)
+};
+
+// A cache which stacks other caches, the fastest first. A lookup is served by the first tier with
+// a fresh entry, or by the last tier if none has one, and the responses are inserted into the last
+// tier. Once an entry has been served by the tiers below the first one often enough, it is copied
+// into the first tier while being served, so that the hottest entries are served from the fastest
+// tier. The first tier evicts by its own policy, after which the entry is served by the tiers
+// below it again.
+class TieredHttpCache : public HttpCache {
+public:
+  using ConfigProto = envoy::extensions::http::cache::tiered_http_cache::v3::TieredHttpCacheConfig;
+
+  TieredHttpCache(const ConfigProto& config, std::vector<std::shared_ptr<HttpCache>> tiers,
+                  TimeSource& time_source, Stats::Scope& scope);
+
+  // HttpCache
+  LookupContextPtr makeLookupContext(LookupRequest&& request,
+                                     Http::StreamDecoderFilterCallbacks& callbacks) override;
+  InsertContextPtr makeInsertContext(LookupContextPtr&& lookup_context,
+                                     Http::StreamEncoderFilterCallbacks& callbacks) override;
+  void updateHeaders(const LookupContext& lookup_context,
+                     const Http::ResponseHeaderMap& response_headers,
+                     const ResponseMetadata& metadata,
+                     std::function<void(bool)> on_complete) override;
+  CacheInfo cacheInfo() const override;
+
+  const std::vector<std::shared_ptr<HttpCache>>& tiers() const { return tiers_; }
+  TimeSource& timeSource() const { return time_source_; }
+  TieredHttpCacheStats& stats() { return stats_; }
+
+  // Records that the entry of the key was served by a tier below the first one. Returns true if
+  // the entry should be copied into the first tier.
+  bool recordLowerTierHit(const Key& key) ABSL_LOCKS_EXCLUDED(mutex_);
+
+private:
+  const uint32_t promotion_hits_;
+  const std::vector<std::shared_ptr<HttpCache>> tiers_;
+  TimeSource& time_source_;
+  TieredHttpCacheStats stats_;
+  absl::Mutex mutex_;
+  // The hits of the keys not promoted yet, by their stable hash. Cleared when it grows too large,
+  // which only delays the promotion of the keys that were hit before.
+  absl::flat_hash_map<size_t, uint32_t> lower_tier_hits_ ABSL_GUARDED_BY(mutex_);
+};
+
+} // namespace Cache
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
@@ -7,7 +7,7 @@
 #include "source/common/runtime/runtime_features.h"
 #include "source/extensions/http/header_validators/envoy_default/character_tables.h"
 
-#include "absl/strings/match.h"
+#include "absl/strings/str_cat.h"
 
 namespace Envoy {
 namespace Extensions {
@@ -199,12 +199,13 @@ PathNormalizer::normalizePathUri(RequestHeaderMap& header_map) const {
 
   // Split the path and the query parameters / fragment component.
   auto [path_view, query] = splitPathAndQueryParams(original_path);
-  // Make a copy of the original path and then create a readonly string_view to it. The string_view
-  // is used for optimized sub-strings and the path is modified in place.
-  std::string path{path_view.data(), path_view.length()};
+  if (!needsNormalization(path_view)) {
+    // The common case: the path is left as it is, without being copied.
+    return PathNormalizationResult::success();
+  }
 
-  // Start normalizing the path.
-  bool redirect = false;
+  // Make a copy of the path, which is normalized in place.
+  std::string path{path_view.data(), path_view.length()};
 
   // Path normalization is based on RFC 3986:
   // https://datatracker.ietf.org/doc/html/rfc3986#section-3.3
@@ -228,74 +229,92 @@ PathNormalizer::normalizePathUri(RequestHeaderMap& header_map) const {
   //
   // pchar         = unreserved / pct-encoded / sub-delims / ":" / "@"
   // SPELLCHECKER(on)
-  {
-    // pass 1: normalize and decode percent-encoded octets
-    const auto result = decodePass(path);
-    if (result.action() == PathNormalizationResult::Action::Reject) {
-      return result;
-    }
-
-    redirect |= result.action() == PathNormalizationResult::Action::Redirect;
-  }
-
-  // The `envoy.uhv.allow_non_compliant_characters_in_path` flag allows the \ (back slash)
-  // character, which legacy path normalization was changing to / (forward slash).
-  if (config_overrides_.allow_non_compliant_characters_in_path_) {
-    translateBackToForwardSlashes(path);
-  }
-
-  if (!config_.uri_path_normalization_options().skip_merging_slashes()) {
-    // pass 2: merge duplicate slashes (if configured to do so)
-    const auto result = mergeSlashesPass(path);
-    if (result.action() == PathNormalizationResult::Action::Reject) {
-      return result;
-    }
-
-    redirect |= result.action() == PathNormalizationResult::Action::Redirect;
-  }
-
-  {
-    // pass 3: collapse dot and dot-dot segments
-    const auto result = collapseDotSegmentsPass(path);
-    if (result.action() == PathNormalizationResult::Action::Reject) {
-      return result;
-    }
-
-    redirect |= result.action() == PathNormalizationResult::Action::Redirect;
+  auto result = normalizePass(path);
+  if (result.action() == PathNormalizationResult::Action::Reject) {
+    return result;
   }
 
-  absl::string_view normalized_path{path};
   // Update the :path header. We need to honor the normalized path and the original query/fragment
   // components.
-  header_map.setPath(absl::StrCat(normalized_path, query));
-
-  if (redirect) {
-    return {PathNormalizationResult::Action::Redirect,
-            ::Envoy::Http::PathNormalizerResponseCodeDetail::get().RedirectNormalized};
-  }
-
-  return PathNormalizationResult::success();
+  header_map.setPath(absl::StrCat(path, query));
+  return result;
 }
 
-void PathNormalizer::translateBackToForwardSlashes(std::string& path) const {
-  for (char& character : path) {
-    if (character == '\\') {
-      character = '/';
+bool PathNormalizer::needsNormalization(absl::string_view path) const {
+  const bool translate_backslashes = config_overrides_.allow_non_compliant_characters_in_path_;
+  const bool merge_slashes = !config_.uri_path_normalization_options().skip_merging_slashes();
+  char prev = '\0';
+  for (const char ch : path) {
+    switch (ch) {
+    case '%':
+      return true;
+    case '\\':
+      if (translate_backslashes) {
+        return true;
+      }
+      break;
+    case '/':
+      if (merge_slashes && prev == '/') {
+        return true;
+      }
+      break;
+    case '.':
+      // A segment starting with a dot may be a dot segment.
+      if (prev == '/') {
+        return true;
+      }
+      break;
+    default:
+      break;
     }
+    prev = ch;
   }
+  return false;
 }
 
-PathNormalizer::PathNormalizationResult PathNormalizer::decodePass(std::string& path) const {
-  auto begin = path.begin();
+PathNormalizer::PathNormalizationResult PathNormalizer::normalizePass(std::string& path) const {
+  const bool translate_backslashes = config_overrides_.allow_non_compliant_characters_in_path_;
+  const bool merge_slashes = !config_.uri_path_normalization_options().skip_merging_slashes();
+  const bool allow_invalid_url_encoding =
+      Runtime::runtimeFeatureEnabled("envoy.reloadable_features.uhv_allow_malformed_url_encoding");
+  const auto begin = path.begin();
+  const auto end = path.end();
   auto read = std::next(begin);
   auto write = std::next(begin);
-  auto end = path.end();
+  // The start of the segment being written, right after its leading slash.
+  auto segment = write;
   bool redirect = false;
-  const bool allow_invalid_url_encoding =
-      Runtime::runtimeFeatureEnabled("envoy.reloadable_features.uhv_allow_malformed_url_encoding");
 
+  // Removes the segment being written if it is a dot segment, along with the previous segment for
+  // a dot-dot segment. Returns false if a dot-dot segment goes above the root.
+  bool removed_dot_segment = false;
+  const auto remove_dot_segment = [&]() {
+    removed_dot_segment = false;
+    const auto length = std::distance(segment, write);
+    if (length == 1 && *segment == '.') {
+      // A "/./" segment or the path is terminated by "/.".
+      write = segment;
+      removed_dot_segment = true;
+    } else if (length == 2 && *segment == '.' && *std::next(segment) == '.') {
+      // A "/../" segment or the path is terminated by "/..": navigate one segment up.
+      const auto new_write = findStartOfPreviousSegment(std::prev(segment), begin);
+      if (new_write == begin) {
+        // This is an invalid ".." segment, most likely the full path is "/..", which attempts to
+        // go above the root.
+        return false;
+      }
+      write = segment = new_write;
+      removed_dot_segment = true;
+    }
+    return true;
+  };
+
+  // Each character is decoded, translated, merged with the previous slash and collapsed with the
+  // dot segment it ends, in this order, before the next one is read. The output is never longer
+  // than the input, so it is written over the characters already read.
   while (read != end) {
-    if (*read == '%') {
+    char ch = *read;
+    if (ch == '%') {
       auto decode_result = normalizeAndDecodeOctet(read, end);
       // TODO(#23885) - add and honor config to not reject invalid percent-encoded octets.
       switch (decode_result.result()) {
@@ -304,7 +323,7 @@ PathNormalizer::PathNormalizationResult PathNormalizer::decodePass(std::string&
           // Write the % character that starts invalid URL encoded sequence and then continue
           // scanning from the next character.
           *write++ = *read++;
-          break;
+          continue;
         }
         ABSL_FALLTHROUGH_INTENDED;
       case PercentDecodeResult::Reject:
@@ -317,7 +336,7 @@ PathNormalizer::PathNormalizationResult PathNormalizer::decodePass(std::string&
         *write++ = *read++;
         *write++ = *read++;
         *write++ = *read++;
-        break;
+        continue;
 
       case PercentDecodeResult::DecodedRedirect:
         // The encoding was properly decoded but, based on the config, the request should be
@@ -325,98 +344,46 @@ PathNormalizer::PathNormalizationResult PathNormalizer::decodePass(std::string&
         redirect = true;
         ABSL_FALLTHROUGH_INTENDED;
       case PercentDecodeResult::Decoded:
-        // The encoding was decoded. Store the decoded octet in the last character of the percent
-        // encoding (read[2]) so it will be processed in the next iteration. We can safely advance
-        // 2 positions since we know that the value was correctly decoded.
+        // The encoding was decoded. The decoded octet is processed as if it was read instead of
+        // the percent encoding.
         std::advance(read, 2);
-        *read = decode_result.octet();
+        ch = decode_result.octet();
       }
-    } else {
-      *write++ = *read++;
     }
-  }
-
-  path.resize(std::distance(begin, write));
-  if (redirect) {
-    return {PathNormalizationResult::Action::Redirect,
-            ::Envoy::Http::PathNormalizerResponseCodeDetail::get().RedirectNormalized};
-  }
-
-  return PathNormalizationResult::success();
-}
+    ++read;
 
-PathNormalizer::PathNormalizationResult PathNormalizer::mergeSlashesPass(std::string& path) const {
-  auto begin = path.begin();
-  auto read = std::next(begin);
-  auto write = std::next(begin);
-  auto end = path.end();
+    // The `envoy.uhv.allow_non_compliant_characters_in_path` flag allows the \ (back slash)
+    // character, which legacy path normalization was changing to / (forward slash).
+    if (ch == '\\' && translate_backslashes) {
+      ch = '/';
+    }
 
-  while (read != end) {
-    if (*read == '/') {
-      char prev = *std::prev(write);
-      if (prev == '/') {
-        // Duplicate slash, merge it
-        ++read;
-      } else {
-        // Not a duplicate slash
-        *write++ = *read++;
-      }
-    } else {
-      *write++ = *read++;
+    if (ch != '/') {
+      *write++ = ch;
+      continue;
+    }
+    if (!remove_dot_segment()) {
+      return {PathNormalizationResult::Action::Reject, UhvResponseCodeDetail::get().InvalidUrl};
     }
+    // The slash ending a dot segment is removed with it, and duplicate slashes are merged if
+    // configured to do so.
+    if (removed_dot_segment || (merge_slashes && *std::prev(write) == '/')) {
+      continue;
+    }
+    *write++ = ch;
+    segment = write;
   }
 
-  path.resize(std::distance(begin, write));
-  return PathNormalizationResult::success();
-}
-
-PathNormalizer::PathNormalizationResult
-PathNormalizer::collapseDotSegmentsPass(std::string& path) const {
-  auto begin = path.begin();
-  auto read = std::next(begin);
-  auto write = std::next(begin);
-  auto end = path.end();
-  absl::string_view path_view{path};
-
-  while (read != end) {
-    if (*read == '.') {
-      char prev = *std::prev(write);
-      if (prev == '/') {
-        // attempt to read ahead 2 characters to see if we are in a "./" or "../" segment.
-        const auto dot_segment = path_view.substr(std::distance(begin, read), 3);
-        if (absl::StartsWith(dot_segment, "./") || dot_segment == ".") {
-          // This is a "/./" segment or the path is terminated by "/.", ignore it
-          size_t distance = std::min<size_t>(dot_segment.size(), 2);
-          // Advance the read iterator by 1 if the path ends with "." or 2 if the segment is "./"
-          std::advance(read, distance);
-        } else if (dot_segment == "../" || dot_segment == "..") {
-          // This is a "/../" segment or the path is terminated by "/..", navigate one segment up.
-          // Back up write 1 position to the previous slash to find the previous segment start.
-          auto new_write = findStartOfPreviousSegment(std::prev(write), begin);
-          if (new_write == begin) {
-            // This is an invalid ".." segment, most likely the full path is "/..", which attempts
-            // to go above the root.
-            return {PathNormalizationResult::Action::Reject,
-                    UhvResponseCodeDetail::get().InvalidUrl};
-          }
-
-          // Set the write position to overwrite the previous segment
-          write = new_write;
-          // Advance the read iterator by 2 if the path ends with ".." or 3 if the segment is "../"
-          size_t distance = std::min<size_t>(dot_segment.size(), 3);
-          std::advance(read, distance);
-        } else {
-          *write++ = *read++;
-        }
-      } else {
-        *write++ = *read++;
-      }
-    } else {
-      *write++ = *read++;
-    }
+  if (!remove_dot_segment()) {
+    return {PathNormalizationResult::Action::Reject, UhvResponseCodeDetail::get().InvalidUrl};
   }
 
   path.resize(std::distance(begin, write));
+  if (redirect) {
+    return {PathNormalizationResult::Action::Redirect,
+            ::Envoy::Http::PathNormalizerResponseCodeDetail::get().RedirectNormalized};
+  }
+
   return PathNormalizationResult::success();
 }
 
@@ -66,28 +66,22 @@ public:
 
 private:
   /*
-   * Normalization pass: normalize percent-encoded octets to UPPERCASE and decode valid octets.
+   * Returns false if the path component is already normalized, which is checked without copying
+   * it. A true result may be conservative.
    */
-  PathNormalizationResult decodePass(std::string& path) const;
+  bool needsNormalization(absl::string_view path) const;
   /*
-   * Normalization pass: merge duplicate slashes.
+   * Normalization pass, in place and in a single scan of the path: normalize percent-encoded
+   * octets to UPPERCASE and decode valid octets, translate backslashes if configured to do so,
+   * merge duplicate slashes unless configured not to, and collapse dot and dot-dot segments.
    */
-  PathNormalizationResult mergeSlashesPass(std::string& path) const;
-  /*
-   * Normalization pass: collapse dot and dot-dot segments.
-   */
-  PathNormalizationResult collapseDotSegmentsPass(std::string& path) const;
+  PathNormalizationResult normalizePass(std::string& path) const;
   /*
    * Split the path and query parameters / fragment components. The return value is a 2-item tuple:
    * (path, query_params).
    */
   std::tuple<absl::string_view, absl::string_view>
   splitPathAndQueryParams(absl::string_view path_and_query_params) const;
-  /**
-   * Translate backslash to forward slash. Enabled by the
-   * envoy.reloadable_features.uhv_translate_backslash_to_slash flag.
-   */
-  void translateBackToForwardSlashes(std::string& path) const;
 
   const envoy::extensions::http::header_validators::envoy_default::v3::HeaderValidatorConfig
       config_;
@@ -68,7 +68,7 @@ private:
     // Otherwise treat it as "old" style format, which is ip-address:port.
     envoy::Cookie cookie;
     if (cookie.ParseFromString(decoded_value)) {
-      address = cookie.address();
+      address = std::move(*cookie.mutable_address());
       if (address.empty()) {
         return absl::nullopt;
       }
@@ -1,6 +1,7 @@
 #include "source/extensions/io_socket/user_space/file_event_impl.h"
 
 #include "source/common/common/assert.h"
+#include "source/common/runtime/runtime_features.h"
 #include "source/extensions/io_socket/user_space/io_handle.h"
 
 namespace Envoy {
@@ -12,20 +13,33 @@ FileEventImpl::FileEventImpl(Event::Dispatcher& dispatcher, Event::FileReadyCb c
                              IoHandle& io_source)
     : schedulable_(dispatcher.createSchedulableCallback([this, cb]() {
         auto ephemeral_events = event_listener_.getAndClearEphemeralEvents();
+        // The callback may have been scheduled in both iterations, and its events delivered by the
+        // first run.
+        if (ephemeral_events == 0) {
+          return;
+        }
         ENVOY_LOG(trace, "User space event {} invokes callbacks on events = {}",
                   static_cast<void*>(this), ephemeral_events);
         THROW_IF_NOT_OK(cb(ephemeral_events));
       })),
-      io_source_(io_source) {
+      io_source_(io_source),
+      peer_events_in_current_iteration_(Runtime::runtimeFeatureEnabled(
+          "envoy.reloadable_features.user_space_peer_events_in_current_iteration")) {
   setEnabled(events);
 }
 
-void FileEventImpl::activate(uint32_t events) {
+void FileEventImpl::activate(uint32_t events) { activate(events, false); }
+
+void FileEventImpl::activate(uint32_t events, bool current_iteration) {
   // Only supported event types are set.
   ASSERT((events & (Event::FileReadyType::Read | Event::FileReadyType::Write |
                     Event::FileReadyType::Closed)) == events);
   event_listener_.onEventActivated(events);
-  schedulable_->scheduleCallbackNextIteration();
+  if (current_iteration) {
+    schedulable_->scheduleCallbackCurrentIteration();
+  } else {
+    schedulable_->scheduleCallbackNextIteration();
+  }
 }
 
 void FileEventImpl::setEnabled(uint32_t events) {
@@ -69,7 +83,9 @@ void FileEventImpl::activateIfEnabled(uint32_t events) {
   if (filtered_events == 0) {
     return;
   }
-  activate(filtered_events);
+  // Both ends of a user space socket pair run on the same dispatcher, so the events written by the
+  // peer can be handled once its callback returns, rather than after another poll of the loop.
+  activate(filtered_events, peer_events_in_current_iteration_);
 }
 } // namespace UserSpace
 } // namespace IoSocket
@@ -31,10 +31,13 @@ public:
   void registerEventIfEmulatedEdge(uint32_t) override {}
 
   // Notify events. Unlike activate() method, this method activates the given events only if the
-  // events are enabled.
+  // events are enabled. It is called by the peer of the io source, on the same dispatcher, and
+  // delivers the events in the current iteration of the event loop.
   void activateIfEnabled(uint32_t events);
 
 private:
+  void activate(uint32_t events, bool current_iteration);
+
   // This class maintains the ephemeral events and enabled events.
   class EventListener {
   public:
@@ -70,6 +73,9 @@ private:
 
   // Supplies readable and writable status.
   IoHandle& io_source_;
+
+  // Whether the events notified by the peer are delivered in the current iteration.
+  const bool peer_events_in_current_iteration_;
 };
 } // namespace UserSpace
 } // namespace IoSocket
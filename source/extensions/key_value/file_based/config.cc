@@ -5,6 +5,21 @@
 namespace Envoy {
 namespace Extensions {
 namespace KeyValue {
+namespace {
+
+// The file isn't rewritten until it holds at least that many outdated entries.
+constexpr uint64_t MinOutdatedRecordsToCompact = 128;
+
+void appendRecord(std::string& out, absl::string_view key, absl::string_view value,
+                  absl::optional<std::chrono::seconds> ttl) {
+  absl::StrAppend(&out, key.length(), "\n", key, value.length(), "\n", value);
+  if (ttl.has_value()) {
+    const std::string ttl_string = std::to_string(ttl.value().count());
+    absl::StrAppend(&out, KV_STORE_TTL_KEY, ttl_string.length(), "\n", ttl_string);
+  }
+}
+
+} // namespace
 
 FileBasedKeyValueStore::FileBasedKeyValueStore(Event::Dispatcher& dispatcher,
                                                std::chrono::milliseconds flush_interval,
@@ -19,33 +34,67 @@ FileBasedKeyValueStore::FileBasedKeyValueStore(Event::Dispatcher& dispatcher,
   auto file_or_error = file_system_.fileReadToEnd(filename_);
   THROW_IF_STATUS_NOT_OK(file_or_error, throw);
   const std::string contents = file_or_error.value();
-  if (!parseContents(contents)) {
+  if (!parseContents(contents, &file_records_)) {
     ENVOY_LOG(warn, "Failed to parse key value store file {}", filename);
+    return;
   }
+  // The entries changed from now on can be appended after the ones parsed.
+  rewrite_ = false;
+}
+
+void FileBasedKeyValueStore::onUpdated(const std::string& key, const ValueWithTtl* value) {
+  if (value != nullptr) {
+    appendRecord(pending_, key, value->value_, value->ttl_);
+  } else {
+    // An absolute TTL of 0 is in the past, so that the key is removed when the file is parsed.
+    appendRecord(pending_, key, "", std::chrono::seconds(0));
+  }
+  ++pending_records_;
 }
 
 void FileBasedKeyValueStore::flush() {
-  static constexpr Filesystem::FlagSet DefaultFlags{1 << Filesystem::File::Operation::Write |
+  if (pending_records_ == 0 && !rewrite_) {
+    return;
+  }
+  const uint64_t records = file_records_ + pending_records_;
+  if (!rewrite_ && records < 2 * store().size() + MinOutdatedRecordsToCompact) {
+    if (writeFile(pending_, true)) {
+      file_records_ = records;
+    } else {
+      rewrite_ = true;
+    }
+  } else {
+    std::string contents;
+    for (const auto& [key, value_with_ttl] : store()) {
+      appendRecord(contents, key, value_with_ttl.value_, value_with_ttl.ttl_);
+    }
+    rewrite_ = !writeFile(contents, false);
+    file_records_ = store().size();
+  }
+  // The changes which couldn't be appended are written with the whole store by the next flush.
+  pending_.clear();
+  pending_records_ = 0;
+}
+
+bool FileBasedKeyValueStore::writeFile(absl::string_view contents, bool append) {
+  static constexpr Filesystem::FlagSet ReplaceFlags{1 << Filesystem::File::Operation::Write |
                                                     1 << Filesystem::File::Operation::Create};
+  static constexpr Filesystem::FlagSet AppendFlags{1 << Filesystem::File::Operation::Write |
+                                                   1 << Filesystem::File::Operation::Create |
+                                                   1 << Filesystem::File::Operation::Append};
   Filesystem::FilePathAndType file_info{Filesystem::DestinationType::File, filename_};
   auto file = file_system_.createFile(file_info);
-  if (!file || !file->open(DefaultFlags).return_value_) {
+  if (!file || !file->open(append ? AppendFlags : ReplaceFlags).return_value_) {
     ENVOY_LOG(error, "Failed to flush cache to file {}", filename_);
-    return;
-  }
-  for (const auto& [key, value_with_ttl] : store()) {
-    file->write(absl::StrCat(key.length(), "\n"));
-    file->write(key);
-    file->write(absl::StrCat(value_with_ttl.value_.length(), "\n"));
-    file->write(value_with_ttl.value_);
-    if (value_with_ttl.ttl_.has_value()) {
-      std::string ttl = std::to_string(value_with_ttl.ttl_.value().count());
-      file->write(KV_STORE_TTL_KEY);
-      file->write(absl::StrCat(ttl.length(), "\n"));
-      file->write(ttl);
-    }
+    return false;
   }
+  const Api::IoCallSizeResult result = file->write(contents);
   file->close();
+  if (result.return_value_ != static_cast<ssize_t>(contents.size())) {
+    ENVOY_LOG(error, "Failed to flush cache to file {}", filename_);
+    return false;
+  }
+  return true;
 }
 
 KeyValueStorePtr FileBasedKeyValueStoreFactory::createStore(
@@ -17,6 +17,10 @@ namespace KeyValue {
 //
 // All keys and values are flushed to a single file as
 // [length]\n[key][length]\n[value]
+//
+// The file is a log: each flush appends the entries changed since the previous one, a removed key
+// being appended with a TTL in the past. Once the file holds more than about twice as many entries
+// as the store, the next flush rewrites it with the store only.
 class FileBasedKeyValueStore : public KeyValueStoreBase {
 public:
   FileBasedKeyValueStore(Event::Dispatcher& dispatcher, std::chrono::milliseconds flush_interval,
@@ -25,9 +29,23 @@ public:
   // KeyValueStore
   void flush() override;
 
+protected:
+  // KeyValueStoreBase
+  void onUpdated(const std::string& key, const ValueWithTtl* value) override;
+
 private:
+  // Writes |contents| to the file in a single write, appending to it or replacing it.
+  bool writeFile(absl::string_view contents, bool append);
+
   Filesystem::Instance& file_system_;
   const std::string filename_;
+  // The entries changed since the last flush, serialized.
+  std::string pending_;
+  uint64_t pending_records_{};
+  // The entries in the file, including the outdated ones.
+  uint64_t file_records_{};
+  // Whether the file must be rewritten, as it doesn't exist yet or couldn't be parsed or written.
+  bool rewrite_{true};
 };
 
 class FileBasedKeyValueStoreFactory : public KeyValueStoreFactory {
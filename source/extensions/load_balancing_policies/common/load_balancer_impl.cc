@@ -837,10 +837,11 @@ EdfLoadBalancerBase::EdfLoadBalancerBase(
     const PrioritySet& priority_set, const PrioritySet* local_priority_set, ClusterLbStats& stats,
     Runtime::Loader& runtime, Random::RandomGenerator& random, uint32_t healthy_panic_threshold,
     const absl::optional<LocalityLbConfig> locality_config,
-    const absl::optional<SlowStartConfig> slow_start_config, TimeSource& time_source)
+    const absl::optional<SlowStartConfig> slow_start_config, TimeSource& time_source,
+    WeightedSchedulerType weighted_scheduler_type)
     : ZoneAwareLoadBalancerBase(priority_set, local_priority_set, stats, runtime, random,
                                 healthy_panic_threshold, locality_config),
-      seed_(random_.random()),
+      seed_(random_.random()), weighted_scheduler_type_(weighted_scheduler_type),
       slow_start_window_(slow_start_config.has_value()
                              ? std::chrono::milliseconds(DurationUtil::durationToMilliseconds(
                                    slow_start_config.value().slow_start_window()))
@@ -904,10 +905,37 @@ void EdfLoadBalancerBase::recalculateHostsInSlowStart(const HostVector& hosts) {
   }
 }
 
+bool EdfLoadBalancerBase::schedulerHostsUnchanged(const Scheduler& scheduler,
+                                                  const HostVector& hosts) {
+  if (scheduler.hosts_ == nullptr || *scheduler.hosts_ != hosts) {
+    return false;
+  }
+  for (size_t i = 0; i < hosts.size(); ++i) {
+    if (hosts[i]->weight() != scheduler.weights_[i]) {
+      return false;
+    }
+  }
+  return true;
+}
+
 void EdfLoadBalancerBase::refresh(uint32_t priority) {
-  const auto add_hosts_source = [this](HostsSource source, const HostVector& hosts) {
+  const auto add_hosts_source = [this](HostsSource source, HostVectorConstSharedPtr hosts_ptr) {
+    const HostVector& hosts = *hosts_ptr;
+    auto& scheduler = scheduler_[source];
+    // A membership update usually only touches a few of the sources, like the localities of the
+    // added or removed hosts. The scheduler of a source whose hosts and weights are unchanged is
+    // kept rather than rebuilt.
+    if (scheduler.edf_ != nullptr && !isSlowStartEnabled() &&
+        Runtime::runtimeFeatureEnabled(
+            "envoy.reloadable_features.edf_lb_keep_unchanged_schedulers") &&
+        schedulerHostsUnchanged(scheduler, hosts)) {
+      scheduler.hosts_ = std::move(hosts_ptr);
+      refreshHostSource(source);
+      return;
+    }
+
     // Nuke existing scheduler if it exists.
-    auto& scheduler = scheduler_[source] = Scheduler{};
+    scheduler = Scheduler{};
     refreshHostSource(source);
     if (isSlowStartEnabled()) {
       recalculateHostsInSlowStart(hosts);
@@ -922,8 +950,17 @@ void EdfLoadBalancerBase::refresh(uint32_t priority) {
       return;
     }
 
-    if (Runtime::runtimeFeatureEnabled(
-            "envoy.reloadable_features.edf_lb_host_scheduler_init_fix")) {
+    if (weighted_scheduler_type_ ==
+        envoy::extensions::load_balancing_policies::common::v3::WeightedSchedulerConfig::
+            ALIAS_TABLE) {
+      if (hosts.size() <= 1) {
+        return;
+      }
+      scheduler.edf_ = std::make_unique<AliasTableScheduler<Host>>(
+          AliasTableScheduler<Host>::createWithPicks(
+              hosts, [this](const Host& host) { return hostWeight(host); }, seed_));
+    } else if (Runtime::runtimeFeatureEnabled(
+                   "envoy.reloadable_features.edf_lb_host_scheduler_init_fix")) {
       // If there are no hosts or a single one, there is no need for an EDF scheduler
       // (thus lowering memory and CPU overhead), as the (possibly) single host
       // will be the one always selected by the scheduler.
@@ -969,25 +1006,40 @@ void EdfLoadBalancerBase::refresh(uint32_t priority) {
         }
       }
     }
+    scheduler.weights_.reserve(hosts.size());
+    for (const auto& host : hosts) {
+      scheduler.weights_.push_back(host->weight());
+    }
+    scheduler.hosts_ = std::move(hosts_ptr);
   };
   // Populate EdfSchedulers for each valid HostsSource value for the host set at this priority.
+  // The host vectors are immutable snapshots, the schedulers hold on to those they were built
+  // from, those of the localities through their HostsPerLocality.
   const auto& host_set = priority_set_.hostSetsPerPriority()[priority];
-  add_hosts_source(HostsSource(priority, HostsSource::SourceType::AllHosts), host_set->hosts());
+  add_hosts_source(HostsSource(priority, HostsSource::SourceType::AllHosts), host_set->hostsPtr());
+  const HealthyHostVectorConstSharedPtr healthy_hosts = host_set->healthyHostsPtr();
   add_hosts_source(HostsSource(priority, HostsSource::SourceType::HealthyHosts),
-                   host_set->healthyHosts());
+                   HostVectorConstSharedPtr(healthy_hosts, &healthy_hosts->get()));
+  const DegradedHostVectorConstSharedPtr degraded_hosts = host_set->degradedHostsPtr();
   add_hosts_source(HostsSource(priority, HostsSource::SourceType::DegradedHosts),
-                   host_set->degradedHosts());
-  for (uint32_t locality_index = 0;
-       locality_index < host_set->healthyHostsPerLocality().get().size(); ++locality_index) {
+                   HostVectorConstSharedPtr(degraded_hosts, &degraded_hosts->get()));
+  const HostsPerLocalityConstSharedPtr healthy_hosts_per_locality =
+      host_set->healthyHostsPerLocalityPtr();
+  for (uint32_t locality_index = 0; locality_index < healthy_hosts_per_locality->get().size();
+       ++locality_index) {
     add_hosts_source(
         HostsSource(priority, HostsSource::SourceType::LocalityHealthyHosts, locality_index),
-        host_set->healthyHostsPerLocality().get()[locality_index]);
+        HostVectorConstSharedPtr(healthy_hosts_per_locality,
+                                 &healthy_hosts_per_locality->get()[locality_index]));
   }
-  for (uint32_t locality_index = 0;
-       locality_index < host_set->degradedHostsPerLocality().get().size(); ++locality_index) {
+  const HostsPerLocalityConstSharedPtr degraded_hosts_per_locality =
+      host_set->degradedHostsPerLocalityPtr();
+  for (uint32_t locality_index = 0; locality_index < degraded_hosts_per_locality->get().size();
+       ++locality_index) {
     add_hosts_source(
         HostsSource(priority, HostsSource::SourceType::LocalityDegradedHosts, locality_index),
-        host_set->degradedHostsPerLocality().get()[locality_index]);
+        HostVectorConstSharedPtr(degraded_hosts_per_locality,
+                                 &degraded_hosts_per_locality->get()[locality_index]));
   }
 }
 
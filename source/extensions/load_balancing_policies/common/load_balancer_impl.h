@@ -21,6 +21,7 @@
 
 #include "source/common/protobuf/utility.h"
 #include "source/common/runtime/runtime_protos.h"
+#include "source/common/upstream/alias_table_scheduler.h"
 #include "source/common/upstream/edf_scheduler.h"
 #include "source/common/upstream/load_balancer_context_base.h"
 
@@ -468,13 +469,15 @@ private:
 class EdfLoadBalancerBase : public ZoneAwareLoadBalancerBase {
 public:
   using SlowStartConfig = envoy::extensions::load_balancing_policies::common::v3::SlowStartConfig;
+  using WeightedSchedulerType = envoy::extensions::load_balancing_policies::common::v3::
+      WeightedSchedulerConfig::SchedulerType;
 
   EdfLoadBalancerBase(const PrioritySet& priority_set, const PrioritySet* local_priority_set,
                       ClusterLbStats& stats, Runtime::Loader& runtime,
                       Random::RandomGenerator& random, uint32_t healthy_panic_threshold,
                       const absl::optional<LocalityLbConfig> locality_config,
                       const absl::optional<SlowStartConfig> slow_start_config,
-                      TimeSource& time_source);
+                      TimeSource& time_source, WeightedSchedulerType weighted_scheduler_type);
 
   // Upstream::ZoneAwareLoadBalancerBase
   HostConstSharedPtr peekAnotherHost(LoadBalancerContext* context) override;
@@ -482,15 +485,20 @@ public:
 
 protected:
   struct Scheduler {
-    // EdfScheduler for weighted LB. The edf_ is only created when the original
-    // host weights of 2 or more hosts differ. When not present, the
+    // Scheduler for weighted LB, an EdfScheduler unless configured otherwise. The edf_ is only
+    // created when the original host weights of 2 or more hosts differ. When not present, the
     // implementation of chooseHostOnce falls back to unweightedHostPick.
-    std::unique_ptr<EdfScheduler<Host>> edf_;
+    std::unique_ptr<Upstream::Scheduler<Host>> edf_;
+    // The hosts the edf_ was built from and their weights at the time, which let a refresh keep
+    // the edf_ of a source whose hosts are unchanged.
+    HostVectorConstSharedPtr hosts_;
+    std::vector<uint32_t> weights_;
   };
 
   void initialize();
 
   virtual void refresh(uint32_t priority);
+  static bool schedulerHostsUnchanged(const Scheduler& scheduler, const HostVector& hosts);
 
   bool isSlowStartEnabled() const;
   bool noHostsAreInSlowStart() const;
@@ -515,6 +523,7 @@ private:
   virtual HostConstSharedPtr unweightedHostPick(const HostVector& hosts_to_use,
                                                 const HostsSource& source) PURE;
 
+  const WeightedSchedulerType weighted_scheduler_type_;
   // Scheduler for each valid HostsSource.
   absl::flat_hash_map<HostsSource, Scheduler, HostsSourceHash> scheduler_;
   Common::CallbackHandlePtr priority_update_cb_;
@@ -163,7 +163,7 @@ private:
   };
 
   virtual HashingLoadBalancerSharedPtr
-  createLoadBalancer(const NormalizedHostWeightVector& normalized_host_weights,
+  createLoadBalancer(uint32_t priority, const NormalizedHostWeightVector& normalized_host_weights,
                      double min_normalized_weight, double max_normalized_weight) PURE;
   absl::Status refresh();
 
@@ -39,7 +39,8 @@ public:
                 ? LoadBalancerConfigHelper::slowStartConfigFromLegacyProto(
                       least_request_config.ref())
                 : absl::nullopt,
-            time_source),
+            time_source,
+            envoy::extensions::load_balancing_policies::common::v3::WeightedSchedulerConfig::EDF),
         choice_count_(
             least_request_config.has_value()
                 ? PROTOBUF_GET_WRAPPED_OR_DEFAULT(least_request_config.ref(), choice_count, 2)
@@ -61,7 +62,8 @@ public:
       : EdfLoadBalancerBase(
             priority_set, local_priority_set, stats, runtime, random, healthy_panic_threshold,
             LoadBalancerConfigHelper::localityLbConfigFromProto(least_request_config),
-            LoadBalancerConfigHelper::slowStartConfigFromProto(least_request_config), time_source),
+            LoadBalancerConfigHelper::slowStartConfigFromProto(least_request_config), time_source,
+            least_request_config.weighted_scheduler_config().scheduler_type()),
         choice_count_(PROTOBUF_GET_WRAPPED_OR_DEFAULT(least_request_config, choice_count, 2)),
         active_request_bias_runtime_(
             least_request_config.has_active_request_bias()
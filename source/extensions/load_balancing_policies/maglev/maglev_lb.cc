@@ -70,7 +70,8 @@ LegacyMaglevLbConfig::LegacyMaglevLbConfig(const ClusterProto& cluster) {
 TypedMaglevLbConfig::TypedMaglevLbConfig(const MaglevLbProto& lb_config) : lb_config_(lb_config) {}
 
 ThreadAwareLoadBalancerBase::HashingLoadBalancerSharedPtr
-MaglevLoadBalancer::createLoadBalancer(const NormalizedHostWeightVector& normalized_host_weights,
+MaglevLoadBalancer::createLoadBalancer(uint32_t /* priority */,
+                                       const NormalizedHostWeightVector& normalized_host_weights,
                                        double /* min_normalized_weight */,
                                        double max_normalized_weight) {
   HashingLoadBalancerSharedPtr maglev_lb =
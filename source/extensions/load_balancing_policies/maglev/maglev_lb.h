@@ -194,7 +194,8 @@ public:
 private:
   // ThreadAwareLoadBalancerBase
   HashingLoadBalancerSharedPtr
-  createLoadBalancer(const NormalizedHostWeightVector& normalized_host_weights,
+  createLoadBalancer(uint32_t /* priority */,
+                     const NormalizedHostWeightVector& normalized_host_weights,
                      double /* min_normalized_weight */, double max_normalized_weight) override;
   static MaglevLoadBalancerStats generateStats(Stats::Scope& scope);
 
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <memory>
+
+#include "envoy/extensions/load_balancing_policies/peak_ewma/v3/peak_ewma.pb.h"
+#include "envoy/extensions/load_balancing_policies/peak_ewma/v3/peak_ewma.pb.validate.h"
+#include "envoy/upstream/load_balancer.h"
+
+#include "source/common/upstream/load_balancer_factory_base.h"
+#include "source/extensions/load_balancing_policies/peak_ewma/peak_ewma_lb.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace LoadBalancingPolices {
+namespace PeakEwma {
+
+using PeakEwmaLbProto = envoy::extensions::load_balancing_policies::peak_ewma::v3::PeakEwma;
+
+/**
+ * Load balancer config that used to wrap the peak EWMA config.
+ */
+class TypedPeakEwmaLbConfig : public Upstream::LoadBalancerConfig {
+public:
+  TypedPeakEwmaLbConfig(const PeakEwmaLbProto& lb_config);
+
+  const PeakEwmaLbProto lb_config_;
+};
+
+class Factory : public Upstream::TypedLoadBalancerFactoryBase<PeakEwmaLbProto> {
+public:
+  Factory() : TypedLoadBalancerFactoryBase("envoy.load_balancing_policies.peak_ewma") {}
+
+  Upstream::ThreadAwareLoadBalancerPtr create(OptRef<const Upstream::LoadBalancerConfig> lb_config,
+                                              const Upstream::ClusterInfo& cluster_info,
+                                              const Upstream::PrioritySet& priority_set,
+                                              Runtime::Loader& runtime,
+                                              Random::RandomGenerator& random,
+                                              TimeSource& time_source) override;
+
+  Upstream::LoadBalancerConfigPtr loadConfig(const Protobuf::Message& config,
+                                             ProtobufMessage::ValidationVisitor&) override {
+    auto typed_config = dynamic_cast<const PeakEwmaLbProto*>(&config);
+    ASSERT(typed_config != nullptr);
+    return std::make_unique<TypedPeakEwmaLbConfig>(*typed_config);
+  }
+};
+
+DECLARE_FACTORY(Factory);
+
+} // namespace PeakEwma
+} // namespace LoadBalancingPolices
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,221 @@
+#include "source/extensions/load_balancing_policies/peak_ewma/peak_ewma_lb.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <limits>
+
+#include "source/common/protobuf/utility.h"
+
+#include "absl/container/flat_hash_map.h"
+
+namespace Envoy {
+namespace Upstream {
+
+namespace {
+
+constexpr uint64_t DefaultDecayTimeMs = 10000;
+constexpr uint32_t DefaultChoiceCount = 2;
+
+// The tables of the load balancers of the clusters on this thread.
+absl::flat_hash_map<const PeakEwmaHosts*, PeakEwmaWorkerTable*>& localTables() {
+  static thread_local absl::flat_hash_map<const PeakEwmaHosts*, PeakEwmaWorkerTable*> tables;
+  return tables;
+}
+
+uint64_t nextHostId() {
+  static std::atomic<uint64_t> next_id{1};
+  return next_id.fetch_add(1, std::memory_order_relaxed);
+}
+
+} // namespace
+
+void PeakEwmaHosts::attach(const HostVector& hosts) {
+  for (const HostSharedPtr& host : hosts) {
+    if (host->lbPolicyData() != nullptr) {
+      continue;
+    }
+    uint32_t index;
+    {
+      absl::MutexLock lock(&mutex_);
+      if (free_indexes_.empty()) {
+        index = next_index_++;
+      } else {
+        index = free_indexes_.back();
+        free_indexes_.pop_back();
+      }
+    }
+    host->setLbPolicyData(
+        std::make_shared<PeakEwmaHostData>(shared_from_this(), index, nextHostId()));
+  }
+}
+
+PeakEwmaWorkerTable* PeakEwmaHosts::localTable() const {
+  const auto& tables = localTables();
+  const auto it = tables.find(this);
+  return it == tables.end() ? nullptr : it->second;
+}
+
+void PeakEwmaHosts::registerLocalTable(PeakEwmaWorkerTable& table) const {
+  localTables()[this] = &table;
+}
+
+void PeakEwmaHosts::unregisterLocalTable(const PeakEwmaWorkerTable& table) const {
+  auto& tables = localTables();
+  const auto it = tables.find(this);
+  if (it != tables.end() && it->second == &table) {
+    tables.erase(it);
+  }
+}
+
+void PeakEwmaHosts::releaseIndex(uint32_t index) {
+  // The hosts may be destroyed on any thread.
+  absl::MutexLock lock(&mutex_);
+  free_indexes_.push_back(index);
+}
+
+void PeakEwmaHostData::onResponseTime(std::chrono::microseconds response_time) {
+  PeakEwmaWorkerTable* table = hosts_->localTable();
+  if (table != nullptr) {
+    table->update(*this, response_time);
+  }
+}
+
+double PeakEwmaWorkerTable::decay(MonotonicTime::duration elapsed) const {
+  return std::exp(-std::chrono::duration<double, std::milli>(elapsed).count() / decay_time_ms_);
+}
+
+void PeakEwmaWorkerTable::update(const PeakEwmaHostData& host,
+                                 std::chrono::microseconds response_time) {
+  if (host.index_ >= entries_.size()) {
+    entries_.resize(host.index_ + 1);
+  }
+  Entry& entry = entries_[host.index_];
+  const MonotonicTime now = time_source_.monotonicTime();
+  double sample = response_time.count();
+  if (entry.id_ != host.id_) {
+    // The first response of the host, or of a new host reusing the index of a destroyed one.
+    entry.id_ = host.id_;
+    entry.latency_us_ = sample;
+    entry.last_update_ = now;
+    return;
+  }
+
+  const double weight = decay(now - entry.last_update_);
+  const double latency = entry.latency_us_ * weight;
+  if (max_response_time_ratio_.has_value()) {
+    sample = std::min(sample, std::max(latency, 1.0) * max_response_time_ratio_.value());
+  }
+  if (sample > latency) {
+    // A slower response replaces the latency, so that a host which slows down is avoided at once.
+    entry.latency_us_ = sample;
+  } else {
+    entry.latency_us_ = latency + sample * (1 - weight);
+  }
+  entry.last_update_ = now;
+}
+
+absl::optional<double> PeakEwmaWorkerTable::latency(const PeakEwmaHostData& host) const {
+  if (host.index_ >= entries_.size() || entries_[host.index_].id_ != host.id_) {
+    return absl::nullopt;
+  }
+  // The latency decays while the host gets no response, so that the hosts which were avoided
+  // when they were slow get requests again eventually.
+  const Entry& entry = entries_[host.index_];
+  return entry.latency_us_ * decay(time_source_.monotonicTime() - entry.last_update_);
+}
+
+PeakEwmaLoadBalancer::PeakEwmaLoadBalancer(
+    const PrioritySet& priority_set, const PrioritySet* local_priority_set, ClusterLbStats& stats,
+    Runtime::Loader& runtime, Random::RandomGenerator& random, uint32_t healthy_panic_threshold,
+    const PeakEwmaLbProto& config, PeakEwmaHostsSharedPtr hosts, TimeSource& time_source)
+    : ZoneAwareLoadBalancerBase(priority_set, local_priority_set, stats, runtime, random,
+                                healthy_panic_threshold,
+                                LoadBalancerConfigHelper::localityLbConfigFromProto(config)),
+      choice_count_(PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, choice_count, DefaultChoiceCount)),
+      hosts_(std::move(hosts)),
+      table_(std::chrono::milliseconds(
+                 PROTOBUF_GET_MS_OR_DEFAULT(config, decay_time, DefaultDecayTimeMs)),
+             config.has_max_response_time_ratio()
+                 ? absl::make_optional(config.max_response_time_ratio().value())
+                 : absl::nullopt,
+             time_source) {
+  hosts_->registerLocalTable(table_);
+}
+
+PeakEwmaLoadBalancer::~PeakEwmaLoadBalancer() { hosts_->unregisterLocalTable(table_); }
+
+double PeakEwmaLoadBalancer::cost(const Host& host) const {
+  const uint64_t active_requests = host.stats().rq_active_.value();
+  const auto* data = static_cast<const PeakEwmaHostData*>(host.lbPolicyData().get());
+  const absl::optional<double> latency =
+      data != nullptr ? table_.latency(*data) : absl::optional<double>();
+  if (!latency.has_value()) {
+    // A host without a response yet gets one request to measure its latency.
+    return active_requests == 0 ? 0 : std::numeric_limits<double>::max();
+  }
+  return latency.value() * (active_requests + 1);
+}
+
+HostConstSharedPtr PeakEwmaLoadBalancer::chooseHostOnce(LoadBalancerContext* context) {
+  const absl::optional<HostsSource> hosts_source = hostSourceToUse(context, random(false));
+  if (!hosts_source) {
+    return nullptr;
+  }
+
+  const HostVector& hosts_to_use = hostSourceToHosts(*hosts_source);
+  if (hosts_to_use.empty()) {
+    return nullptr;
+  }
+
+  HostSharedPtr candidate_host;
+  double candidate_cost = 0;
+  for (uint32_t choice_idx = 0; choice_idx < choice_count_; ++choice_idx) {
+    const HostSharedPtr& sampled_host = hosts_to_use[random_.random() % hosts_to_use.size()];
+    const double sampled_cost = cost(*sampled_host);
+    if (candidate_host == nullptr || sampled_cost < candidate_cost) {
+      candidate_host = sampled_host;
+      candidate_cost = sampled_cost;
+    }
+  }
+  return candidate_host;
+}
+
+HostConstSharedPtr PeakEwmaLoadBalancer::peekAnotherHost(LoadBalancerContext*) {
+  // The choice depends on the latencies at the time of the request, which can't be peeked ahead.
+  return nullptr;
+}
+
+PeakEwmaThreadAwareLoadBalancer::PeakEwmaThreadAwareLoadBalancer(
+    const PeakEwmaLbProto& config, const ClusterInfo& cluster_info,
+    const PrioritySet& priority_set, Runtime::Loader& runtime, Random::RandomGenerator& random,
+    TimeSource& time_source)
+    : priority_set_(priority_set), hosts_(std::make_shared<PeakEwmaHosts>()),
+      factory_(std::make_shared<LbFactory>(config, cluster_info, hosts_, runtime, random,
+                                           time_source)) {}
+
+absl::Status PeakEwmaThreadAwareLoadBalancer::initialize() {
+  for (const HostSetPtr& host_set : priority_set_.hostSetsPerPriority()) {
+    hosts_->attach(host_set->hosts());
+  }
+  // The added hosts get their data before the update of the priority set is posted to the
+  // workers, since the cluster manager registers its own callback after the initialization of the
+  // load balancer.
+  priority_update_cb_ = priority_set_.addPriorityUpdateCb(
+      [this](uint32_t, const HostVector& hosts_added, const HostVector&) -> absl::Status {
+        hosts_->attach(hosts_added);
+        return absl::OkStatus();
+      });
+  return absl::OkStatus();
+}
+
+LoadBalancerPtr PeakEwmaThreadAwareLoadBalancer::LbFactory::create(LoadBalancerParams params) {
+  return std::make_unique<PeakEwmaLoadBalancer>(
+      params.priority_set, params.local_priority_set, cluster_info_.lbStats(), runtime_, random_,
+      PROTOBUF_PERCENT_TO_ROUNDED_INTEGER_OR_DEFAULT(cluster_info_.lbConfig(),
+                                                     healthy_panic_threshold, 100, 50),
+      config_, hosts_, time_source_);
+}
+
+} // namespace Upstream
+} // namespace Envoy
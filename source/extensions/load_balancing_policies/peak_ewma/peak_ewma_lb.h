@@ -0,0 +1,190 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "envoy/common/callback.h"
+#include "envoy/extensions/load_balancing_policies/peak_ewma/v3/peak_ewma.pb.h"
+
+#include "source/extensions/load_balancing_policies/common/load_balancer_impl.h"
+
+#include "absl/synchronization/mutex.h"
+#include "absl/types/optional.h"
+
+namespace Envoy {
+namespace Upstream {
+
+using PeakEwmaLbProto = envoy::extensions::load_balancing_policies::peak_ewma::v3::PeakEwma;
+
+class PeakEwmaHostData;
+class PeakEwmaWorkerTable;
+
+/**
+ * The hosts of a cluster balanced by the Peak EWMA load balancer. Each host gets an index, which
+ * is reused once the host is destroyed, so that the workers keep the latencies of the hosts in
+ * dense tables indexed by host.
+ */
+class PeakEwmaHosts : public std::enable_shared_from_this<PeakEwmaHosts> {
+public:
+  /**
+   * Attaches the data of the policy to the hosts which don't have it yet. It must be called on the
+   * main thread, before the hosts are used by the workers.
+   */
+  void attach(const HostVector& hosts);
+
+  /**
+   * @return the latency table of the load balancer of the cluster on this thread, or nullptr if
+   * there is none.
+   */
+  PeakEwmaWorkerTable* localTable() const;
+
+  /**
+   * Makes the table the one of the cluster on this thread, until it is unregistered.
+   */
+  void registerLocalTable(PeakEwmaWorkerTable& table) const;
+  void unregisterLocalTable(const PeakEwmaWorkerTable& table) const;
+
+private:
+  friend class PeakEwmaHostData;
+
+  void releaseIndex(uint32_t index);
+
+  absl::Mutex mutex_;
+  std::vector<uint32_t> free_indexes_ ABSL_GUARDED_BY(mutex_);
+  uint32_t next_index_ ABSL_GUARDED_BY(mutex_){};
+};
+
+using PeakEwmaHostsSharedPtr = std::shared_ptr<PeakEwmaHosts>;
+
+/**
+ * The data of the policy attached to each host, which feeds the response times of the host to the
+ * latency table of the thread of the request.
+ */
+class PeakEwmaHostData : public HostDescription::HostLbPolicyData {
+public:
+  PeakEwmaHostData(PeakEwmaHostsSharedPtr hosts, uint32_t index, uint64_t id)
+      : index_(index), id_(id), hosts_(std::move(hosts)) {}
+  ~PeakEwmaHostData() override { hosts_->releaseIndex(index_); }
+
+  // HostDescription::HostLbPolicyData
+  void onResponseTime(std::chrono::microseconds response_time) override;
+
+  const PeakEwmaHosts& hosts() const { return *hosts_; }
+
+  // The index of the host in the latency tables.
+  const uint32_t index_;
+  // Tells apart the successive hosts of an index, and the hosts of different clusters.
+  const uint64_t id_;
+
+private:
+  const PeakEwmaHostsSharedPtr hosts_;
+};
+
+/**
+ * The latencies of the hosts of a cluster as seen by the requests of a worker, which only this
+ * worker reads and writes.
+ */
+class PeakEwmaWorkerTable {
+public:
+  PeakEwmaWorkerTable(std::chrono::milliseconds decay_time,
+                      absl::optional<double> max_response_time_ratio, TimeSource& time_source)
+      : decay_time_ms_(decay_time.count()), max_response_time_ratio_(max_response_time_ratio),
+        time_source_(time_source) {}
+
+  void update(const PeakEwmaHostData& host, std::chrono::microseconds response_time);
+
+  /**
+   * @return the latency of the host in microseconds, decayed since its last response, or nullopt
+   * if no response of the host completed on this worker yet.
+   */
+  absl::optional<double> latency(const PeakEwmaHostData& host) const;
+
+private:
+  struct Entry {
+    // The id of the host whose latency this is, or 0 if none.
+    uint64_t id_{};
+    double latency_us_{};
+    MonotonicTime last_update_;
+  };
+
+  // The weight of a latency measured the elapsed time ago.
+  double decay(MonotonicTime::duration elapsed) const;
+
+  const double decay_time_ms_;
+  const absl::optional<double> max_response_time_ratio_;
+  TimeSource& time_source_;
+  std::vector<Entry> entries_;
+};
+
+/**
+ * Peak EWMA load balancer, on each worker. It picks the host of the lowest cost out of
+ * choice_count random hosts, the cost of a host being its latency multiplied by its active
+ * requests plus one.
+ */
+class PeakEwmaLoadBalancer : public ZoneAwareLoadBalancerBase {
+public:
+  PeakEwmaLoadBalancer(const PrioritySet& priority_set, const PrioritySet* local_priority_set,
+                       ClusterLbStats& stats, Runtime::Loader& runtime,
+                       Random::RandomGenerator& random, uint32_t healthy_panic_threshold,
+                       const PeakEwmaLbProto& config, PeakEwmaHostsSharedPtr hosts,
+                       TimeSource& time_source);
+  ~PeakEwmaLoadBalancer() override;
+
+  // Upstream::ZoneAwareLoadBalancerBase
+  HostConstSharedPtr chooseHostOnce(LoadBalancerContext* context) override;
+  HostConstSharedPtr peekAnotherHost(LoadBalancerContext* context) override;
+
+private:
+  double cost(const Host& host) const;
+
+  const uint32_t choice_count_;
+  const PeakEwmaHostsSharedPtr hosts_;
+  PeakEwmaWorkerTable table_;
+};
+
+/**
+ * The Peak EWMA load balancer of a cluster, which attaches the data of the policy to the hosts of
+ * the cluster and creates the load balancers of the workers.
+ */
+class PeakEwmaThreadAwareLoadBalancer : public ThreadAwareLoadBalancer {
+public:
+  PeakEwmaThreadAwareLoadBalancer(const PeakEwmaLbProto& config, const ClusterInfo& cluster_info,
+                                  const PrioritySet& priority_set, Runtime::Loader& runtime,
+                                  Random::RandomGenerator& random, TimeSource& time_source);
+
+  // Upstream::ThreadAwareLoadBalancer
+  LoadBalancerFactorySharedPtr factory() override { return factory_; }
+  absl::Status initialize() override;
+
+private:
+  class LbFactory : public LoadBalancerFactory {
+  public:
+    LbFactory(const PeakEwmaLbProto& config, const ClusterInfo& cluster_info,
+              PeakEwmaHostsSharedPtr hosts, Runtime::Loader& runtime,
+              Random::RandomGenerator& random, TimeSource& time_source)
+        : config_(config), cluster_info_(cluster_info), hosts_(std::move(hosts)),
+          runtime_(runtime), random_(random), time_source_(time_source) {}
+
+    // Upstream::LoadBalancerFactory
+    LoadBalancerPtr create(LoadBalancerParams params) override;
+    bool recreateOnHostChange() const override { return false; }
+
+  private:
+    const PeakEwmaLbProto config_;
+    const ClusterInfo& cluster_info_;
+    const PeakEwmaHostsSharedPtr hosts_;
+    Runtime::Loader& runtime_;
+    Random::RandomGenerator& random_;
+    TimeSource& time_source_;
+  };
+
+  const PrioritySet& priority_set_;
+  const PeakEwmaHostsSharedPtr hosts_;
+  const std::shared_ptr<LbFactory> factory_;
+  Common::CallbackHandlePtr priority_update_cb_;
+};
+
+} // namespace Upstream
+} // namespace Envoy
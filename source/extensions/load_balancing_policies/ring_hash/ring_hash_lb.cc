@@ -2,6 +2,8 @@
 
 #include <cstdint>
 #include <iostream>
+#include <iterator>
+#include <limits>
 #include <string>
 #include <vector>
 
@@ -9,6 +11,7 @@
 
 #include "source/common/common/assert.h"
 
+#include "absl/container/flat_hash_map.h"
 #include "absl/container/inlined_vector.h"
 #include "absl/strings/string_view.h"
 
@@ -135,14 +138,15 @@ HostConstSharedPtr RingHashLoadBalancer::Ring::chooseHost(uint64_t h, uint32_t a
     midp = (midp + attempt) % ring_.size();
   }
 
-  return ring_[midp].host_;
+  return hosts_[ring_[midp].host_index_];
 }
 
 using HashFunction = envoy::config::cluster::v3::Cluster::RingHashLbConfig::HashFunction;
 RingHashLoadBalancer::Ring::Ring(const NormalizedHostWeightVector& normalized_host_weights,
                                  double min_normalized_weight, uint64_t min_ring_size,
                                  uint64_t max_ring_size, HashFunction hash_function,
-                                 bool use_hostname_for_hashing, RingHashLoadBalancerStats& stats)
+                                 bool use_hostname_for_hashing, const Ring* previous_ring,
+                                 RingHashLoadBalancerStats& stats)
     : stats_(stats) {
   ENVOY_LOG(trace, "ring hash: building ring");
 
@@ -160,12 +164,10 @@ RingHashLoadBalancer::Ring::Ring(const NormalizedHostWeightVector& normalized_ho
       std::min(std::ceil(min_normalized_weight * min_ring_size) / min_normalized_weight,
                static_cast<double>(max_ring_size));
 
-  // Reserve memory for the entire ring up front.
   const uint64_t ring_size = std::ceil(scale);
-  ring_.reserve(ring_size);
 
-  // Populate the hash ring by walking through the (host, weight) pairs in
-  // normalized_host_weights, and generating (scale * weight) hashes for each host. Since these
+  // Determine the number of hashes of each host by walking through the (host, weight) pairs in
+  // normalized_host_weights, and counting (scale * weight) hashes for each host. Since these
   // aren't necessarily whole numbers, we maintain running sums -- current_hashes and
   // target_hashes -- which allows us to populate the ring in a mostly stable way.
   //
@@ -181,26 +183,79 @@ RingHashLoadBalancer::Ring::Ring(const NormalizedHostWeightVector& normalized_ho
   // For stats reporting, keep track of the minimum and maximum actual number of hashes per host.
   // Users should hopefully pay attention to these numbers and alert if min_hashes_per_host is too
   // low, since that implies an inaccurate request distribution.
-
-  absl::InlinedVector<char, 196> hash_key_buffer;
+  const size_t num_hosts = normalized_host_weights.size();
+  hosts_.reserve(num_hosts);
+  hash_keys_.reserve(num_hosts);
+  hash_counts_.reserve(num_hosts);
   double current_hashes = 0.0;
   double target_hashes = 0.0;
+  uint64_t total_hashes = 0;
   uint64_t min_hashes_per_host = ring_size;
   uint64_t max_hashes_per_host = 0;
   for (const auto& entry : normalized_host_weights) {
     const auto& host = entry.first;
     const absl::string_view key_to_hash = hashKey(host, use_hostname_for_hashing);
     ASSERT(!key_to_hash.empty());
+    hosts_.push_back(host);
+    hash_keys_.emplace_back(key_to_hash);
 
+    target_hashes += scale * entry.second;
+    uint32_t i = 0;
+    while (current_hashes < target_hashes) {
+      ++i;
+      ++current_hashes;
+    }
+    hash_counts_.push_back(i);
+    total_hashes += i;
+    min_hashes_per_host = std::min<uint64_t>(i, min_hashes_per_host);
+    max_hashes_per_host = std::max<uint64_t>(i, max_hashes_per_host);
+  }
+
+  // The i-th hash of a host only depends on its hash key, so that the hashes a host had in the
+  // previous ring, which already are in order there, are kept rather than computed and sorted
+  // again. A membership change then only costs the hashing and sorting of the hashes it adds,
+  // rather than of the whole ring.
+  constexpr uint32_t NotInRing = std::numeric_limits<uint32_t>::max();
+  std::vector<uint32_t> kept_counts(num_hosts, 0);
+  std::vector<RingEntry> kept_entries;
+  if (previous_ring != nullptr && !previous_ring->hosts_.empty()) {
+    absl::flat_hash_map<const Host*, uint32_t> host_indexes;
+    host_indexes.reserve(num_hosts);
+    for (uint32_t i = 0; i < num_hosts; ++i) {
+      host_indexes.emplace(hosts_[i].get(), i);
+    }
+    std::vector<uint32_t> new_indexes(previous_ring->hosts_.size(), NotInRing);
+    for (uint32_t i = 0; i < previous_ring->hosts_.size(); ++i) {
+      auto it = host_indexes.find(previous_ring->hosts_[i].get());
+      // The hash key of a host changes with its metadata.
+      if (it != host_indexes.end() && previous_ring->hash_keys_[i] == hash_keys_[it->second]) {
+        new_indexes[i] = it->second;
+        kept_counts[it->second] =
+            std::min(previous_ring->hash_counts_[i], hash_counts_[it->second]);
+      }
+    }
+    kept_entries.reserve(total_hashes);
+    for (const RingEntry& entry : previous_ring->ring_) {
+      const uint32_t host_index = new_indexes[entry.host_index_];
+      if (host_index != NotInRing && entry.replica_ < kept_counts[host_index]) {
+        kept_entries.push_back({entry.hash_, host_index, entry.replica_});
+      }
+    }
+  }
+
+  std::vector<RingEntry> added_entries;
+  added_entries.reserve(total_hashes - kept_entries.size());
+  absl::InlinedVector<char, 196> hash_key_buffer;
+  for (uint32_t host_index = 0; host_index < num_hosts; ++host_index) {
+    if (kept_counts[host_index] == hash_counts_[host_index]) {
+      continue;
+    }
+    const std::string& key_to_hash = hash_keys_[host_index];
     hash_key_buffer.assign(key_to_hash.begin(), key_to_hash.end());
     hash_key_buffer.emplace_back('_');
     auto offset_start = hash_key_buffer.end();
 
-    // As noted above: maintain current_hashes and target_hashes as running sums across the entire
-    // host set. `i` is needed only to construct the hash key, and tally min/max hashes per host.
-    target_hashes += scale * entry.second;
-    uint64_t i = 0;
-    while (current_hashes < target_hashes) {
+    for (uint32_t i = kept_counts[host_index]; i < hash_counts_[host_index]; ++i) {
       const std::string i_str = absl::StrCat("", i);
       hash_key_buffer.insert(offset_start, i_str.begin(), i_str.end());
 
@@ -213,22 +268,27 @@ RingHashLoadBalancer::Ring::Ring(const NormalizedHostWeightVector& normalized_ho
               : HashUtil::xxHash64(hash_key);
 
       ENVOY_LOG(trace, "ring hash: hash_key={} hash={}", hash_key, hash);
-      ring_.push_back({hash, host});
-      ++i;
-      ++current_hashes;
+      added_entries.push_back({hash, host_index, i});
       hash_key_buffer.erase(offset_start, hash_key_buffer.end());
     }
-    min_hashes_per_host = std::min(i, min_hashes_per_host);
-    max_hashes_per_host = std::max(i, max_hashes_per_host);
   }
 
-  std::sort(ring_.begin(), ring_.end(), [](const RingEntry& lhs, const RingEntry& rhs) -> bool {
+  const auto hash_less = [](const RingEntry& lhs, const RingEntry& rhs) -> bool {
     return lhs.hash_ < rhs.hash_;
-  });
+  };
+  std::sort(added_entries.begin(), added_entries.end(), hash_less);
+  if (kept_entries.empty()) {
+    ring_ = std::move(added_entries);
+  } else {
+    ring_.reserve(kept_entries.size() + added_entries.size());
+    std::merge(kept_entries.begin(), kept_entries.end(), added_entries.begin(),
+               added_entries.end(), std::back_inserter(ring_), hash_less);
+  }
+  ENVOY_LOG(debug, "ring hash: built ring of {} hashes, {} of which kept from the previous ring",
+            ring_.size(), kept_entries.size());
   if (ENVOY_LOG_CHECK_LEVEL(trace)) {
     for (const auto& entry : ring_) {
-      const absl::string_view key_to_hash = hashKey(entry.host_, use_hostname_for_hashing);
-      ENVOY_LOG(trace, "ring hash: host={} hash={}", key_to_hash, entry.hash_);
+      ENVOY_LOG(trace, "ring hash: host={} hash={}", hash_keys_[entry.host_index_], entry.hash_);
     }
   }
 
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <string>
 #include <vector>
 
 #include "envoy/config/cluster/v3/cluster.pb.h"
@@ -91,18 +92,27 @@ private:
 
   struct RingEntry {
     uint64_t hash_;
-    HostConstSharedPtr host_;
+    // The index of the host in the hosts of the ring.
+    uint32_t host_index_;
+    // The rank of the hash among those of the host.
+    uint32_t replica_;
   };
 
   struct Ring : public HashingLoadBalancer {
+    // The hashes of the hosts of previous_ring, if any, are kept rather than computed again.
     Ring(const NormalizedHostWeightVector& normalized_host_weights, double min_normalized_weight,
          uint64_t min_ring_size, uint64_t max_ring_size, HashFunction hash_function,
-         bool use_hostname_for_hashing, RingHashLoadBalancerStats& stats);
+         bool use_hostname_for_hashing, const Ring* previous_ring,
+         RingHashLoadBalancerStats& stats);
 
     // ThreadAwareLoadBalancerBase::HashingLoadBalancer
     HostConstSharedPtr chooseHost(uint64_t hash, uint32_t attempt) const override;
 
     std::vector<RingEntry> ring_;
+    std::vector<HostConstSharedPtr> hosts_;
+    // The keys the hashes of each host are computed from, and the number of hashes of each host.
+    std::vector<std::string> hash_keys_;
+    std::vector<uint32_t> hash_counts_;
 
     RingHashLoadBalancerStats& stats_;
   };
@@ -110,17 +120,21 @@ private:
 
   // ThreadAwareLoadBalancerBase
   HashingLoadBalancerSharedPtr
-  createLoadBalancer(const NormalizedHostWeightVector& normalized_host_weights,
+  createLoadBalancer(uint32_t priority, const NormalizedHostWeightVector& normalized_host_weights,
                      double min_normalized_weight, double /* max_normalized_weight */) override {
-    HashingLoadBalancerSharedPtr ring_hash_lb =
-        std::make_shared<Ring>(normalized_host_weights, min_normalized_weight, min_ring_size_,
-                               max_ring_size_, hash_function_, use_hostname_for_hashing_, stats_);
+    if (rings_.size() <= priority) {
+      rings_.resize(priority + 1);
+    }
+    std::shared_ptr<Ring> ring = std::make_shared<Ring>(
+        normalized_host_weights, min_normalized_weight, min_ring_size_, max_ring_size_,
+        hash_function_, use_hostname_for_hashing_, rings_[priority].get(), stats_);
+    rings_[priority] = ring;
     if (hash_balance_factor_ == 0) {
-      return ring_hash_lb;
+      return ring;
     }
 
     return std::make_shared<BoundedLoadHashingLoadBalancer>(
-        ring_hash_lb, std::move(normalized_host_weights), hash_balance_factor_);
+        ring, std::move(normalized_host_weights), hash_balance_factor_);
   }
 
   static RingHashLoadBalancerStats generateStats(Stats::Scope& scope);
@@ -135,6 +149,8 @@ private:
   const HashFunction hash_function_;
   const bool use_hostname_for_hashing_;
   const uint32_t hash_balance_factor_;
+  // The current ring of each priority, which the next ring of the priority is built from.
+  std::vector<RingConstSharedPtr> rings_;
 };
 
 } // namespace Upstream
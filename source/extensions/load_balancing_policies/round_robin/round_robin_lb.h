@@ -6,8 +6,8 @@ namespace Envoy {
 namespace Upstream {
 
 /**
- * A round robin load balancer. When in weighted mode, EDF scheduling is used. When in not
- * weighted mode, simple RR index selection is used.
+ * A round robin load balancer. When in weighted mode, EDF scheduling is used unless an alias table
+ * scheduler is configured. When in not weighted mode, simple RR index selection is used.
  */
 class RoundRobinLoadBalancer : public EdfLoadBalancerBase {
 public:
@@ -25,7 +25,8 @@ public:
             round_robin_config.has_value()
                 ? LoadBalancerConfigHelper::slowStartConfigFromLegacyProto(round_robin_config.ref())
                 : absl::nullopt,
-            time_source) {
+            time_source,
+            envoy::extensions::load_balancing_policies::common::v3::WeightedSchedulerConfig::EDF) {
     initialize();
   }
 
@@ -38,7 +39,8 @@ public:
       : EdfLoadBalancerBase(
             priority_set, local_priority_set, stats, runtime, random, healthy_panic_threshold,
             LoadBalancerConfigHelper::localityLbConfigFromProto(round_robin_config),
-            LoadBalancerConfigHelper::slowStartConfigFromProto(round_robin_config), time_source) {
+            LoadBalancerConfigHelper::slowStartConfigFromProto(round_robin_config), time_source,
+            round_robin_config.weighted_scheduler_config().scheduler_type()) {
     initialize();
   }
 
@@ -58,9 +58,11 @@ SubsetLoadBalancer::SubsetLoadBalancer(const SubsetLoadBalancerConfig& lb_config
                                lb_config_.subsetInfo().defaultSubset().fields().end()),
       subset_selectors_(lb_config_.subsetInfo().subsetSelectors()),
       original_priority_set_(priority_set), original_local_priority_set_(local_priority_set),
+      max_lazy_subsets_(lb_config_.subsetInfo().maxLazySubsets()),
       locality_weight_aware_(lb_config_.subsetInfo().localityWeightAware()),
       scale_locality_weight_(lb_config_.subsetInfo().scaleLocalityWeight()),
       list_as_any_(lb_config_.subsetInfo().listAsAny()),
+      lazy_subsets_(lb_config_.subsetInfo().lazySubsets()),
       allow_redundant_keys_(lb_config_.subsetInfo().allowRedundantKeys()) {
   ASSERT(lb_config_.subsetInfo().isEnabled());
 
@@ -89,8 +91,8 @@ SubsetLoadBalancer::SubsetLoadBalancer(const SubsetLoadBalancerConfig& lb_config
 
   // Configure future updates.
   original_priority_set_callback_handle_ = priority_set.addPriorityUpdateCb(
-      [this](uint32_t priority, const HostVector&, const HostVector&) {
-        refreshSubsets(priority);
+      [this](uint32_t priority, const HostVector&, const HostVector& hosts_removed) {
+        refreshSubsets(priority, hosts_removed);
         purgeEmptySubsets(subsets_);
         return absl::OkStatus();
       });
@@ -108,14 +110,14 @@ SubsetLoadBalancer::~SubsetLoadBalancer() {
 
 void SubsetLoadBalancer::refreshSubsets() {
   for (auto& host_set : original_priority_set_.hostSetsPerPriority()) {
-    update(host_set->priority(), host_set->hosts());
+    update(host_set->priority(), host_set->hosts(), {});
   }
 }
 
-void SubsetLoadBalancer::refreshSubsets(uint32_t priority) {
+void SubsetLoadBalancer::refreshSubsets(uint32_t priority, const HostVector& hosts_removed) {
   const auto& host_sets = original_priority_set_.hostSetsPerPriority();
   ASSERT(priority < host_sets.size());
-  update(priority, host_sets[priority]->hosts());
+  update(priority, host_sets[priority]->hosts(), hosts_removed);
 }
 
 void SubsetLoadBalancer::initSubsetAnyOnce() {
@@ -370,6 +372,15 @@ HostConstSharedPtr SubsetLoadBalancer::tryChooseHostFromContext(LoadBalancerCont
 
   // Route has metadata match criteria defined, see if we have a matching subset.
   LbSubsetEntryPtr entry = findSubset(match_criteria->metadataMatchCriteria());
+  if (lazy_subsets_) {
+    if (entry == nullptr || !entry->initialized()) {
+      entry = createLazySubset(match_criteria->metadataMatchCriteria());
+    } else {
+      // Move the subset to the front of the least recently used list.
+      lazy_subsets_lru_.splice(lazy_subsets_lru_.begin(), lazy_subsets_lru_,
+                               *entry->lazy_subset_it_);
+    }
+  }
   if (entry == nullptr || !entry->active()) {
     // No matching subset or subset not active: use fallback policy.
     return nullptr;
@@ -419,6 +430,105 @@ SubsetLoadBalancer::LbSubsetEntryPtr SubsetLoadBalancer::findSubset(
   return nullptr;
 }
 
+// Same as above, for the key-values extracted from a host.
+SubsetLoadBalancer::LbSubsetEntryPtr SubsetLoadBalancer::findSubset(const SubsetMetadata& kvs) {
+  const LbSubsetMap* subsets = &subsets_;
+  for (uint32_t i = 0; i < kvs.size(); i++) {
+    const auto& subset_it = subsets->find(kvs[i].first);
+    if (subset_it == subsets->end()) {
+      break;
+    }
+
+    const ValueSubsetMap& vs_map = subset_it->second;
+    const auto& vs_it = vs_map.find(HashedValue(kvs[i].second));
+    if (vs_it == vs_map.end()) {
+      break;
+    }
+
+    const LbSubsetEntryPtr& entry = vs_it->second;
+    if (i + 1 == kvs.size()) {
+      return entry;
+    }
+
+    subsets = &entry->children_;
+  }
+
+  return nullptr;
+}
+
+// Creates the subset of the given metadata match criteria, if they name the keys of a selector,
+// from the hosts of all the priorities.
+SubsetLoadBalancer::LbSubsetEntryPtr SubsetLoadBalancer::createLazySubset(
+    const std::vector<Router::MetadataMatchCriterionConstSharedPtr>& match_criteria) {
+  const auto key_matches = [](const std::string& key,
+                               const Router::MetadataMatchCriterionConstSharedPtr& criterion) {
+    return key == criterion->name();
+  };
+  const SubsetSelector* selector = nullptr;
+  for (const auto& subset_selector : subset_selectors_) {
+    const auto& keys = subset_selector->selectorKeys();
+    // Both the keys and the criteria are sorted by name.
+    if (std::equal(keys.begin(), keys.end(), match_criteria.begin(), match_criteria.end(),
+                   key_matches)) {
+      selector = subset_selector.get();
+      break;
+    }
+  }
+  if (selector == nullptr) {
+    return nullptr;
+  }
+
+  // Make room for the new subset before creating it, so that it is not purged with the evicted
+  // ones if it is empty.
+  evictLazySubsets(max_lazy_subsets_ - 1);
+
+  SubsetMetadata kvs;
+  kvs.reserve(match_criteria.size());
+  for (const auto& criterion : match_criteria) {
+    kvs.emplace_back(criterion->name(), criterion->value().value());
+  }
+  LbSubsetEntryPtr entry = findOrCreateLbSubsetEntry(subsets_, kvs, 0);
+  ENVOY_LOG(debug, "subset lb: creating subset for {}", describeMetadata(kvs));
+  initLbSubsetEntryOnce(entry, selector->singleHostPerSubset());
+  lazy_subsets_lru_.push_front(entry.get());
+  entry->lazy_subset_it_ = lazy_subsets_lru_.begin();
+
+  const auto host_matches = [&kvs](const SubsetMetadata& host_kvs) {
+    return std::equal(host_kvs.begin(), host_kvs.end(), kvs.begin(), kvs.end(),
+                      [](const auto& host_kv, const auto& kv) {
+                        return ValueUtil::equal(host_kv.second, kv.second);
+                      });
+  };
+  for (const auto& host_set : original_priority_set_.hostSetsPerPriority()) {
+    for (const auto& host : host_set->hosts()) {
+      const std::vector<SubsetMetadata> all_kvs =
+          extractSubsetMetadata(selector->selectorKeys(), *host);
+      if (std::any_of(all_kvs.begin(), all_kvs.end(), host_matches)) {
+        entry->lb_subset_->pushHost(host_set->priority(), host);
+      }
+    }
+    entry->lb_subset_->finalize(host_set->priority(), random_.random());
+  }
+  return entry;
+}
+
+// Removes the least recently selected subsets beyond max_subsets.
+void SubsetLoadBalancer::evictLazySubsets(uint32_t max_subsets) {
+  if (lazy_subsets_lru_.size() <= max_subsets) {
+    return;
+  }
+  while (lazy_subsets_lru_.size() > max_subsets) {
+    LbSubsetEntry* entry = lazy_subsets_lru_.back();
+    lazy_subsets_lru_.pop_back();
+    entry->lazy_subset_it_.reset();
+    entry->lb_subset_.reset();
+    stats_.lb_subsets_active_.dec();
+    stats_.lb_subsets_removed_.inc();
+  }
+  // Drop the entries of the evicted subsets from the hierarchy.
+  purgeEmptySubsets(subsets_);
+}
+
 void SubsetLoadBalancer::updateFallbackSubset(uint32_t priority, const HostVector& all_hosts) {
   auto update_func = [priority, &all_hosts](LbSubsetPtr& subset, const HostPredicate& predicate,
                                             uint64_t seed) {
@@ -520,11 +630,72 @@ void SubsetLoadBalancer::processSubsets(uint32_t priority, const HostVector& all
   });
 }
 
+// Updates the lazily created subsets for the hosts of the priority added, removed, or whose
+// metadata changed since the last update, rather than for all the hosts.
+void SubsetLoadBalancer::processLazySubsets(uint32_t priority, const HostVector& all_hosts,
+                                            const HostVector& hosts_removed) {
+  if (lazy_host_metadata_.size() <= priority) {
+    lazy_host_metadata_.resize(priority + 1);
+  }
+  auto& host_metadata = lazy_host_metadata_[priority];
+
+  // The hosts which may have left their subsets, and those among them to match again.
+  HostHashSet updated_hosts;
+  HostVector hosts_to_match;
+  for (const auto& host : hosts_removed) {
+    host_metadata.erase(host.get());
+    updated_hosts.emplace(host);
+  }
+  for (const auto& host : all_hosts) {
+    MetadataConstSharedPtr metadata = host->metadata();
+    auto [it, inserted] = host_metadata.try_emplace(host.get(), metadata);
+    if (!inserted) {
+      if (it->second == metadata) {
+        continue;
+      }
+      it->second = std::move(metadata);
+    }
+    updated_hosts.emplace(host);
+    hosts_to_match.push_back(host);
+  }
+
+  if (lazy_subsets_lru_.empty()) {
+    return;
+  }
+
+  absl::flat_hash_map<const LbSubsetEntry*, HostVector> matched_hosts;
+  for (const auto& host : hosts_to_match) {
+    for (const auto& subset_selector : subset_selectors_) {
+      for (const auto& kvs : extractSubsetMetadata(subset_selector->selectorKeys(), *host)) {
+        const LbSubsetEntryPtr entry = findSubset(kvs);
+        if (entry != nullptr && entry->initialized()) {
+          matched_hosts[entry.get()].push_back(host);
+        }
+      }
+    }
+  }
+
+  for (LbSubsetEntry* entry : lazy_subsets_lru_) {
+    entry->lb_subset_->pushCurrentHosts(priority, updated_hosts);
+    if (const auto it = matched_hosts.find(entry); it != matched_hosts.end()) {
+      for (const auto& host : it->second) {
+        entry->lb_subset_->pushHost(priority, host);
+      }
+    }
+    entry->lb_subset_->finalize(priority, random_.random());
+  }
+}
+
 // Given the latest all hosts, update all subsets for this priority level, creating new subsets as
 // necessary.
-void SubsetLoadBalancer::update(uint32_t priority, const HostVector& all_hosts) {
+void SubsetLoadBalancer::update(uint32_t priority, const HostVector& all_hosts,
+                                const HostVector& hosts_removed) {
   updateFallbackSubset(priority, all_hosts);
-  processSubsets(priority, all_hosts);
+  if (lazy_subsets_) {
+    processLazySubsets(priority, all_hosts, hosts_removed);
+  } else {
+    processSubsets(priority, all_hosts);
+  }
 }
 
 bool SubsetLoadBalancer::hostMatches(const SubsetMetadata& kvs, const Host& host) {
@@ -688,6 +859,9 @@ void SubsetLoadBalancer::purgeEmptySubsets(LbSubsetMap& subsets) {
         stats_.lb_subsets_active_.dec();
         stats_.lb_subsets_removed_.inc();
       }
+      if (entry->lazy_subset_it_.has_value()) {
+        lazy_subsets_lru_.erase(*entry->lazy_subset_it_);
+      }
 
       auto next_it = std::next(it);
       subset_it->second.erase(it);
@@ -4,6 +4,7 @@
 #include <bitset>
 #include <cstdint>
 #include <functional>
+#include <list>
 #include <map>
 #include <memory>
 #include <string>
@@ -24,6 +25,7 @@
 #include "source/common/upstream/upstream_impl.h"
 #include "source/extensions/load_balancing_policies/subset/subset_lb_config.h"
 
+#include "absl/container/flat_hash_map.h"
 #include "absl/container/node_hash_map.h"
 #include "absl/types/optional.h"
 
@@ -224,6 +226,8 @@ private:
     virtual void pushHost(uint32_t priority, HostSharedPtr host) PURE;
     virtual void finalize(uint32_t priority, uint64_t seed) PURE;
     virtual bool active() const PURE;
+    // Pushes the hosts the subset has for the priority, except the given ones.
+    virtual void pushCurrentHosts(uint32_t priority, const HostHashSet& excluded_hosts) PURE;
   };
   using LbSubsetPtr = std::unique_ptr<LbSubset>;
 
@@ -274,6 +278,18 @@ private:
 
     bool active() const override { return !subset_.empty(); }
 
+    void pushCurrentHosts(uint32_t priority, const HostHashSet& excluded_hosts) override {
+      if (host_sets_.size() <= priority) {
+        return;
+      }
+      auto& [old_hosts, new_hosts] = host_sets_[priority];
+      for (const auto& host : old_hosts) {
+        if (excluded_hosts.count(host) == 0) {
+          new_hosts.emplace(host);
+        }
+      }
+    }
+
     std::vector<std::pair<HostHashSet, HostHashSet>> host_sets_;
     PrioritySubsetImpl subset_;
   };
@@ -281,9 +297,9 @@ private:
   class SingleHostLbSubset : public LbSubset {
     // Subset
     HostConstSharedPtr chooseHost(LoadBalancerContext*) const override { return subset_; }
-    // This is called at most once for every update for single host subset.
+    // Only the first host pushed for the priority is kept.
     void pushHost(uint32_t priority, HostSharedPtr host) override {
-      new_hosts_[priority] = std::move(host);
+      new_hosts_.try_emplace(priority, std::move(host));
     }
     // Called after pushHost. Update subset by the host that pushed in the pushHost. If no any host
     // is pushed then subset_ will be set to nullptr.
@@ -306,6 +322,13 @@ private:
     }
     bool active() const override { return subset_ != nullptr; }
 
+    void pushCurrentHosts(uint32_t priority, const HostHashSet& excluded_hosts) override {
+      if (auto iter = hosts_.find(priority);
+          iter != hosts_.end() && excluded_hosts.count(iter->second) == 0) {
+        pushHost(priority, iter->second);
+      }
+    }
+
     // We will update subsets for every priority separately and these simple map can help us
     // to ensure which priority has valid host quickly.
     std::map<uint32_t, HostSharedPtr> hosts_;
@@ -313,6 +336,9 @@ private:
     HostConstSharedPtr subset_;
   };
 
+  // The lazily created subsets, most recently selected first.
+  using LazySubsetList = std::list<LbSubsetEntry*>;
+
   // Entry in the subset hierarchy.
   class LbSubsetEntry {
   public:
@@ -327,6 +353,9 @@ private:
     // Only initialized if a match exists at this level.
     LbSubsetPtr lb_subset_;
 
+    // The position of the entry in the lazily created subsets, if it is one.
+    absl::optional<LazySubsetList::iterator> lazy_subset_it_;
+
     // Used to quick check if entry is single host subset entry or not.
     bool single_host_subset_{};
   };
@@ -335,13 +364,18 @@ private:
 
   // Create filtered default subset (if necessary) and other subsets based on current hosts.
   void refreshSubsets();
-  void refreshSubsets(uint32_t priority);
+  void refreshSubsets(uint32_t priority, const HostVector& hosts_removed);
 
   // Called by HostSet::MemberUpdateCb
-  void update(uint32_t priority, const HostVector& all_hosts);
+  void update(uint32_t priority, const HostVector& all_hosts, const HostVector& hosts_removed);
 
   void updateFallbackSubset(uint32_t priority, const HostVector& all_hosts);
   void processSubsets(uint32_t priority, const HostVector& all_hosts);
+  void processLazySubsets(uint32_t priority, const HostVector& all_hosts,
+                          const HostVector& hosts_removed);
+  LbSubsetEntryPtr
+  createLazySubset(const std::vector<Router::MetadataMatchCriterionConstSharedPtr>& matches);
+  void evictLazySubsets(uint32_t max_subsets);
 
   HostConstSharedPtr tryChooseHostFromContext(LoadBalancerContext* context, bool& host_chosen);
 
@@ -352,6 +386,7 @@ private:
 
   LbSubsetEntryPtr
   findSubset(const std::vector<Router::MetadataMatchCriterionConstSharedPtr>& matches);
+  LbSubsetEntryPtr findSubset(const SubsetMetadata& kvs);
 
   LbSubsetEntryPtr findOrCreateLbSubsetEntry(LbSubsetMap& subsets, const SubsetMetadata& kvs,
                                              uint32_t idx);
@@ -399,10 +434,18 @@ private:
 
   Stats::Gauge* single_duplicate_stat_{};
 
+  // Only used when the subsets are created lazily.
+  LazySubsetList lazy_subsets_lru_;
+  // The metadata of the hosts of each priority at the last update, to find those whose metadata
+  // changed since.
+  std::vector<absl::flat_hash_map<const Host*, MetadataConstSharedPtr>> lazy_host_metadata_;
+  const uint32_t max_lazy_subsets_;
+
   // Keep small members (bools and enums) at the end of class, to reduce alignment overhead.
   const bool locality_weight_aware_ : 1;
   const bool scale_locality_weight_ : 1;
   const bool list_as_any_ : 1;
+  const bool lazy_subsets_ : 1;
   const bool allow_redundant_keys_{};
 };
 
@@ -7,6 +7,8 @@
 #include "envoy/extensions/load_balancing_policies/subset/v3/subset.pb.validate.h"
 #include "envoy/upstream/load_balancer.h"
 
+#include "source/common/protobuf/utility.h"
+
 namespace Envoy {
 namespace Upstream {
 
@@ -111,6 +113,16 @@ public:
    * @return bool whether redundant key/value pairs is allowed in the request metadata.
    */
   virtual bool allowRedundantKeys() const PURE;
+
+  /*
+   * @return bool whether the subsets are only created when a request first selects them.
+   */
+  virtual bool lazySubsets() const PURE;
+
+  /*
+   * @return uint32_t the maximum number of subsets kept when they are created lazily.
+   */
+  virtual uint32_t maxLazySubsets() const PURE;
 };
 
 using LoadBalancerSubsetInfoPtr = std::unique_ptr<LoadBalancerSubsetInfo>;
@@ -132,10 +144,13 @@ public:
         fallback_policy_(static_cast<FallbackPolicy>(subset_config.fallback_policy())),
         metadata_fallback_policy_(
             static_cast<MetadataFallbackPolicy>(subset_config.metadata_fallback_policy())),
+        max_lazy_subsets_(PROTOBUF_GET_WRAPPED_OR_DEFAULT(subset_config.lazy_subsets(),
+                                                          max_subsets, DefaultMaxLazySubsets)),
         enabled_(!subset_config.subset_selectors().empty()),
         locality_weight_aware_(subset_config.locality_weight_aware()),
         scale_locality_weight_(subset_config.scale_locality_weight()),
         panic_mode_any_(subset_config.panic_mode_any()), list_as_any_(subset_config.list_as_any()),
+        lazy_subsets_(subset_config.has_lazy_subsets()),
         allow_redundant_keys_(subset_config.allow_redundant_keys()) {
     for (const auto& subset : subset_config.subset_selectors()) {
       if (!subset.keys().empty()) {
@@ -190,18 +205,24 @@ public:
   bool panicModeAny() const override { return panic_mode_any_; }
   bool listAsAny() const override { return list_as_any_; }
   bool allowRedundantKeys() const override { return allow_redundant_keys_; }
+  bool lazySubsets() const override { return lazy_subsets_; }
+  uint32_t maxLazySubsets() const override { return max_lazy_subsets_; }
 
 private:
+  static constexpr uint32_t DefaultMaxLazySubsets = 1024;
+
   const ProtobufWkt::Struct default_subset_;
   std::vector<SubsetSelectorPtr> subset_selectors_;
   // Keep small members (bools and enums) at the end of class, to reduce alignment overhead.
   const FallbackPolicy fallback_policy_;
   const MetadataFallbackPolicy metadata_fallback_policy_;
+  const uint32_t max_lazy_subsets_{DefaultMaxLazySubsets};
   const bool enabled_ : 1;
   const bool locality_weight_aware_ : 1;
   const bool scale_locality_weight_ : 1;
   const bool panic_mode_any_ : 1;
   const bool list_as_any_ : 1;
+  const bool lazy_subsets_{};
   const bool allow_redundant_keys_{};
 };
 
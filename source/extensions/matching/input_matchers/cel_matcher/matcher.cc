@@ -15,12 +15,10 @@ CelInputMatcher::CelInputMatcher(CelMatcherSharedPtr cel_matcher,
   const CelExpression& input_expr = cel_matcher_->expr_match();
   switch (input_expr.expr_specifier_case()) {
   case CelExpression::ExprSpecifierCase::kParsedExpr:
-    compiled_expr_ = Filters::Common::Expr::createExpression(builder_->builder(),
-                                                             input_expr.parsed_expr().expr());
+    compiled_expr_ = builder_->createExpression(input_expr.parsed_expr().expr());
     return;
   case CelExpression::ExprSpecifierCase::kCheckedExpr:
-    compiled_expr_ = Filters::Common::Expr::createExpression(builder_->builder(),
-                                                             input_expr.checked_expr().expr());
+    compiled_expr_ = builder_->createExpression(input_expr.checked_expr().expr());
     return;
   case CelExpression::ExprSpecifierCase::EXPR_SPECIFIER_NOT_SET:
     PANIC_DUE_TO_PROTO_UNSET;
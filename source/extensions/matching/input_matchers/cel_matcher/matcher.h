@@ -24,7 +24,7 @@ using ::Envoy::Matcher::InputMatcherFactoryCb;
 using ::Envoy::Matcher::MatchingDataType;
 
 using CelMatcher = ::xds::type::matcher::v3::CelMatcher;
-using CompiledExpressionPtr = std::unique_ptr<google::api::expr::runtime::CelExpression>;
+using CompiledExpressionPtr = Filters::Common::Expr::ExpressionSharedPtr;
 using BaseActivationPtr = std::unique_ptr<google::api::expr::runtime::BaseActivation>;
 using CelMatcherSharedPtr = std::shared_ptr<::xds::type::matcher::v3::CelMatcher>;
 
@@ -38,6 +38,10 @@ DnsResolverImpl::DnsResolverImpl(
           static_cast<uint32_t>(PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, udp_max_queries, 0))),
       resolvers_csv_(resolvers_csv),
       filter_unroutable_families_(config.filter_unroutable_families()),
+      resolution_cache_enabled_(config.has_resolution_cache()),
+      negative_ttl_(PROTOBUF_GET_MS_OR_DEFAULT(config.resolution_cache(), negative_ttl, 5000)),
+      max_cached_resolutions_(
+          PROTOBUF_GET_WRAPPED_OR_DEFAULT(config.resolution_cache(), max_entries, 1024)),
       scope_(root_scope.createScope("dns.cares.")), stats_(generateCaresDnsResolverStats(*scope_)) {
   AresOptions options = defaultAresOptions();
   initializeChannel(&options.options_, options.optmask_);
@@ -183,6 +187,8 @@ void DnsResolverImpl::AddrInfoPendingResolution::onAresGetAddrInfoCallback(
     // can be done with this query and initiate a new one.
     ENVOY_LOG_EVENT(debug, "cares_dns_resolution_destroyed", "dns resolution for {} destroyed",
                     dns_name_);
+    // The failure is that of the channel, not of the name.
+    cache_result_ = false;
 
     // Nothing can follow a call to finishResolve due to the deletion of this object upon
     // finishResolve().
@@ -301,28 +307,27 @@ void DnsResolverImpl::PendingResolution::finishResolve() {
                   "dns resolution for {} completed with status {}", dns_name_,
                   static_cast<int>(pending_response_.status_));
 
+  const ResolutionKey key{dns_name_, dns_lookup_family_};
+  if (in_flight_) {
+    parent_.in_flight_resolutions_.erase(key);
+  }
+  // The result is cached before any callback, so that the resolutions they start are answered
+  // from the cache.
+  if (cache_result_) {
+    parent_.cacheResolution(key, pending_response_.status_, pending_response_.details_,
+                            pending_response_.address_list_);
+  }
+
+  for (const auto& coalesced : coalesced_) {
+    if (!coalesced->cancelled_) {
+      runCallback(coalesced->callback_, std::string(pending_response_.details_),
+                  std::list<DnsResponse>(pending_response_.address_list_));
+    }
+  }
+
   if (!cancelled_) {
-    // Use a raw try here because it is used in both main thread and filter.
-    // Can not convert to use status code as there may be unexpected exceptions in server fuzz
-    // tests, which must be handled. Potential exception may come from getAddressWithPort() or
-    // portFromTcpUrl().
-    // TODO(chaoqin-li1123): remove try catch pattern here once we figure how to handle unexpected
-    // exception in fuzz tests.
-    TRY_NEEDS_AUDIT {
-      callback_(pending_response_.status_, std::move(pending_response_.details_),
+    runCallback(callback_, std::move(pending_response_.details_),
                 std::move(pending_response_.address_list_));
-    }
-    END_TRY
-    MULTI_CATCH(
-        const EnvoyException& e,
-        {
-          ENVOY_LOG(critical, "EnvoyException in c-ares callback: {}", e.what());
-          dispatcher_.post([s = std::string(e.what())] { throw EnvoyException(s); });
-        },
-        {
-          ENVOY_LOG(critical, "Unknown exception in c-ares callback");
-          dispatcher_.post([] { throw EnvoyException("unknown"); });
-        });
   } else {
     ENVOY_LOG_EVENT(debug, "cares_dns_callback_cancelled",
                     "dns resolution callback for {} not issued. Cancelled with reason={}",
@@ -334,6 +339,99 @@ void DnsResolverImpl::PendingResolution::finishResolve() {
   }
 }
 
+void DnsResolverImpl::PendingResolution::runCallback(const ResolveCb& callback,
+                                                     std::string&& details,
+                                                     std::list<DnsResponse>&& address_list) {
+  // Use a raw try here because it is used in both main thread and filter.
+  // Can not convert to use status code as there may be unexpected exceptions in server fuzz
+  // tests, which must be handled. Potential exception may come from getAddressWithPort() or
+  // portFromTcpUrl().
+  // TODO(chaoqin-li1123): remove try catch pattern here once we figure how to handle unexpected
+  // exception in fuzz tests.
+  TRY_NEEDS_AUDIT {
+    callback(pending_response_.status_, std::move(details), std::move(address_list));
+  }
+  END_TRY
+  MULTI_CATCH(
+      const EnvoyException& e,
+      {
+        ENVOY_LOG(critical, "EnvoyException in c-ares callback: {}", e.what());
+        dispatcher_.post([s = std::string(e.what())] { throw EnvoyException(s); });
+      },
+      {
+        ENVOY_LOG(critical, "Unknown exception in c-ares callback");
+        dispatcher_.post([] { throw EnvoyException("unknown"); });
+      });
+}
+
+void DnsResolverImpl::resetNetworking() {
+  // Dirty the channel so that the next query will recreate it.
+  dirty_channel_ = true;
+  // The cached results may not hold on the new network.
+  resolution_cache_.clear();
+  stats_.cached_resolutions_.set(0);
+}
+
+bool DnsResolverImpl::resolveFromCache(const ResolutionKey& key, const ResolveCb& callback) {
+  auto it = resolution_cache_.find(key);
+  if (it == resolution_cache_.end()) {
+    return false;
+  }
+  const MonotonicTime now = dispatcher_.timeSource().monotonicTime();
+  if (now >= it->second.expiry_) {
+    resolution_cache_.erase(it);
+    stats_.cached_resolutions_.dec();
+    return false;
+  }
+
+  const CachedResolution& cached = it->second;
+  stats_.cache_hits_.inc();
+  if (cached.address_list_.empty()) {
+    stats_.cache_negative_hits_.inc();
+  }
+  ENVOY_LOG_EVENT(debug, "cares_dns_resolution_cached", "dns resolution for {} found in cache",
+                  key.first);
+  // The TTLs are those remaining, as for the answers of a caching DNS server.
+  const auto elapsed = std::chrono::duration_cast<std::chrono::seconds>(now - cached.cached_at_);
+  std::list<DnsResponse> address_list;
+  for (const DnsResponse& response : cached.address_list_) {
+    address_list.emplace_back(response.addrInfo().address_, response.addrInfo().ttl_ - elapsed);
+  }
+  // The callback may start resolutions, which would invalidate the iterator.
+  const ResolutionStatus status = cached.status_;
+  const std::string details = cached.details_;
+  callback(status, details, std::move(address_list));
+  return true;
+}
+
+void DnsResolverImpl::cacheResolution(const ResolutionKey& key, ResolutionStatus status,
+                                      const std::string& details,
+                                      const std::list<DnsResponse>& address_list) {
+  std::chrono::milliseconds ttl = negative_ttl_;
+  if (!address_list.empty()) {
+    ttl = std::chrono::milliseconds::max();
+    for (const DnsResponse& response : address_list) {
+      ttl = std::min<std::chrono::milliseconds>(ttl, response.addrInfo().ttl_);
+    }
+  }
+  if (ttl.count() == 0) {
+    return;
+  }
+
+  const MonotonicTime now = dispatcher_.timeSource().monotonicTime();
+  if (resolution_cache_.size() >= max_cached_resolutions_ && !resolution_cache_.contains(key)) {
+    absl::erase_if(resolution_cache_,
+                   [now](const auto& entry) { return now >= entry.second.expiry_; });
+    if (resolution_cache_.size() >= max_cached_resolutions_) {
+      stats_.cached_resolutions_.set(resolution_cache_.size());
+      return;
+    }
+  }
+  resolution_cache_.insert_or_assign(
+      key, CachedResolution{status, details, address_list, now, now + ttl});
+  stats_.cached_resolutions_.set(resolution_cache_.size());
+}
+
 void DnsResolverImpl::updateAresTimer() {
   // Update the timeout for events.
   timeval timeout;
@@ -384,9 +482,13 @@ ActiveDnsQuery* DnsResolverImpl::resolve(const std::string& dns_name,
                                          DnsLookupFamily dns_lookup_family, ResolveCb callback) {
   ENVOY_LOG_EVENT(debug, "cares_dns_resolution_start", "dns resolution for {} started", dns_name);
 
-  // TODO(hennna): Add DNS caching which will allow testing the edge case of a
-  // failed initial call to getAddrInfo followed by a synchronous IPv4
-  // resolution.
+  ResolutionKey key{dns_name, dns_lookup_family};
+  if (resolution_cache_enabled_) {
+    if (resolveFromCache(key, callback)) {
+      return nullptr;
+    }
+    stats_.cache_misses_.inc();
+  }
 
   // @see DnsResolverImpl::PendingResolution::onAresGetAddrInfoCallback for why this is done.
   if (dirty_channel_) {
@@ -395,6 +497,18 @@ ActiveDnsQuery* DnsResolverImpl::resolve(const std::string& dns_name,
     initializeChannel(&options.options_, options.optmask_);
   }
 
+  if (resolution_cache_enabled_) {
+    auto it = in_flight_resolutions_.find(key);
+    if (it != in_flight_resolutions_.end()) {
+      ENVOY_LOG_EVENT(debug, "cares_dns_resolution_coalesced",
+                      "dns resolution for {} coalesced into one in flight", dns_name);
+      stats_.coalesced_resolutions_.inc();
+      auto& coalesced = it->second->coalesced_.emplace_back(
+          std::make_unique<CoalescedResolution>(std::move(callback)));
+      return coalesced.get();
+    }
+  }
+
   auto pending_resolution = std::make_unique<AddrInfoPendingResolution>(
       *this, callback, dispatcher_, channel_, dns_name, dns_lookup_family);
   pending_resolution->startResolution();
@@ -410,6 +524,10 @@ ActiveDnsQuery* DnsResolverImpl::resolve(const std::string& dns_name,
     // if ~DnsResolverImpl() happens via ares_destroy() and subsequent handling of ARES_EDESTRUCTION
     // in DnsResolverImpl::PendingResolution::onAresGetAddrInfoCallback()).
     pending_resolution->owned_ = true;
+    if (resolution_cache_enabled_) {
+      pending_resolution->in_flight_ = true;
+      in_flight_resolutions_.emplace(std::move(key), pending_resolution.get());
+    }
     return pending_resolution.release();
   }
 }
@@ -432,8 +550,8 @@ void DnsResolverImpl::chargeGetAddrInfoErrorStats(int status, int timeouts) {
 DnsResolverImpl::AddrInfoPendingResolution::AddrInfoPendingResolution(
     DnsResolverImpl& parent, ResolveCb callback, Event::Dispatcher& dispatcher,
     ares_channel channel, const std::string& dns_name, DnsLookupFamily dns_lookup_family)
-    : PendingResolution(parent, callback, dispatcher, channel, dns_name),
-      dns_lookup_family_(dns_lookup_family), available_interfaces_(availableInterfaces()) {
+    : PendingResolution(parent, callback, dispatcher, channel, dns_name, dns_lookup_family),
+      available_interfaces_(availableInterfaces()) {
   if (dns_lookup_family == DnsLookupFamily::Auto ||
       dns_lookup_family == DnsLookupFamily::V4Preferred) {
     dual_resolution_ = true;
@@ -1,9 +1,13 @@
 #pragma once
 
 #include <cstdint>
+#include <list>
+#include <memory>
 #include <string>
+#include <utility>
 
 #include "envoy/common/platform.h"
+#include "envoy/common/time.h"
 #include "envoy/event/dispatcher.h"
 #include "envoy/event/file_event.h"
 #include "envoy/network/dns.h"
@@ -14,6 +18,7 @@
 #include "source/common/common/utility.h"
 #include "source/common/network/dns_resolver/dns_factory_util.h"
 
+#include "absl/container/flat_hash_map.h"
 #include "absl/container/node_hash_map.h"
 #include "ares.h"
 
@@ -28,7 +33,12 @@ namespace Network {
   GAUGE(pending_resolutions, NeverImport)                                                          \
   COUNTER(not_found)                                                                               \
   COUNTER(get_addr_failure)                                                                        \
-  COUNTER(timeouts)
+  COUNTER(timeouts)                                                                                \
+  COUNTER(cache_hits)                                                                              \
+  COUNTER(cache_negative_hits)                                                                     \
+  COUNTER(cache_misses)                                                                            \
+  COUNTER(coalesced_resolutions)                                                                   \
+  GAUGE(cached_resolutions, NeverImport)
 
 /**
  * Struct definition for all DNS stats. @see stats_macros.h
@@ -59,13 +69,27 @@ public:
   // Network::DnsResolver
   ActiveDnsQuery* resolve(const std::string& dns_name, DnsLookupFamily dns_lookup_family,
                           ResolveCb callback) override;
-  void resetNetworking() override {
-    // Dirty the channel so that the next query will recreate it.
-    dirty_channel_ = true;
-  }
+  void resetNetworking() override;
 
 private:
   friend class DnsResolverImplPeer;
+
+  // The name and lookup family of a resolution, which identify the resolutions sharing a query
+  // and a cached result.
+  using ResolutionKey = std::pair<std::string, DnsLookupFamily>;
+
+  // A resolution coalesced into an identical one in flight, of which it gets the result.
+  class CoalescedResolution : public ActiveDnsQuery {
+  public:
+    explicit CoalescedResolution(ResolveCb callback) : callback_(std::move(callback)) {}
+
+    // Network::ActiveDnsQuery
+    void cancel(CancelReason) override { cancelled_ = true; }
+
+    const ResolveCb callback_;
+    bool cancelled_ = false;
+  };
+
   class PendingResolution : public ActiveDnsQuery {
   public:
     void cancel(CancelReason reason) override {
@@ -80,15 +104,23 @@ private:
     bool owned_ = false;
     // Has the query completed? Only meaningful if !owned_;
     bool completed_ = false;
+    // Is the resolution in the in-flight resolutions of the parent, which get coalesced into it?
+    bool in_flight_ = false;
+    // The resolutions coalesced into this one.
+    std::list<std::unique_ptr<CoalescedResolution>> coalesced_;
 
   protected:
     // Network::ActiveDnsQuery
     PendingResolution(DnsResolverImpl& parent, ResolveCb callback, Event::Dispatcher& dispatcher,
-                      ares_channel channel, const std::string& dns_name)
+                      ares_channel channel, const std::string& dns_name,
+                      DnsLookupFamily dns_lookup_family)
         : parent_(parent), callback_(callback), dispatcher_(dispatcher), channel_(channel),
-          dns_name_(dns_name) {}
+          dns_name_(dns_name), dns_lookup_family_(dns_lookup_family),
+          cache_result_(parent.resolution_cache_enabled_) {}
 
     void finishResolve();
+    void runCallback(const ResolveCb& callback, std::string&& details,
+                     std::list<DnsResponse>&& address_list);
 
     DnsResolverImpl& parent_;
     // Caller supplied callback to invoke on query completion or error.
@@ -99,7 +131,10 @@ private:
     bool cancelled_ = false;
     const ares_channel channel_;
     const std::string dns_name_;
+    const DnsLookupFamily dns_lookup_family_;
     CancelReason cancel_reason_;
+    // Is the result stored in the resolution cache of the parent on completion?
+    bool cache_result_;
 
     // Small wrapping struct to accumulate addresses from firings of the
     // onAresGetAddrInfoCallback callback.
@@ -161,11 +196,19 @@ private:
     // all concurrent queries are unwound before cleaning up the resolution.
     uint32_t pending_resolutions_ = 0;
     int family_ = AF_INET;
-    const DnsLookupFamily dns_lookup_family_;
     // Queried for at construction time.
     const AvailableInterfaces available_interfaces_;
   };
 
+  // The result of a resolution, kept until expiry_ to answer the identical resolutions.
+  struct CachedResolution {
+    ResolutionStatus status_;
+    std::string details_;
+    std::list<DnsResponse> address_list_;
+    MonotonicTime cached_at_;
+    MonotonicTime expiry_;
+  };
+
   struct AresOptions {
     ares_options options_;
     int optmask_;
@@ -186,6 +229,12 @@ private:
   AresOptions defaultAresOptions();
 
   void chargeGetAddrInfoErrorStats(int status, int timeouts);
+  // Invokes the callback with the cached result of the resolution, if any and unexpired.
+  bool resolveFromCache(const ResolutionKey& key, const ResolveCb& callback);
+  // Caches the result of a resolution, for the minimum TTL of its addresses, or for negative_ttl_
+  // if it failed or found no addresses.
+  void cacheResolution(const ResolutionKey& key, ResolutionStatus status,
+                       const std::string& details, const std::list<DnsResponse>& address_list);
 
   Event::Dispatcher& dispatcher_;
   Event::TimerPtr timer_;
@@ -198,6 +247,12 @@ private:
   const uint32_t udp_max_queries_;
   const absl::optional<std::string> resolvers_csv_;
   const bool filter_unroutable_families_;
+  // The identical resolutions in flight are coalesced and the results cached only if set.
+  const bool resolution_cache_enabled_;
+  const std::chrono::milliseconds negative_ttl_;
+  const uint32_t max_cached_resolutions_;
+  absl::flat_hash_map<ResolutionKey, PendingResolution*> in_flight_resolutions_;
+  absl::flat_hash_map<ResolutionKey, CachedResolution> resolution_cache_;
   Stats::ScopeSharedPtr scope_;
   CaresDnsResolverStats stats_;
 };
@@ -1,5 +1,7 @@
 #include "source/extensions/network/dns_resolver/getaddrinfo/getaddrinfo.h"
 
+#include <chrono>
+
 namespace Envoy {
 namespace Network {
 namespace {
@@ -21,28 +23,91 @@ private:
 
 } // namespace
 
+GetAddrInfoDnsResolver::GetAddrInfoDnsResolver(
+    const envoy::extensions::network::dns_resolver::getaddrinfo::v3::GetAddrInfoDnsResolverConfig&
+        config,
+    Event::Dispatcher& dispatcher, Api::Api& api)
+    : dispatcher_(dispatcher), query_timeout_(PROTOBUF_GET_OPTIONAL_MS(config, query_timeout)) {
+  if (query_timeout_.has_value()) {
+    timeout_timer_ = dispatcher.createTimer([this] { onQueryTimeout(); });
+  }
+  const uint32_t num_resolver_threads =
+      PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, num_resolver_threads, 1);
+  resolver_threads_.reserve(num_resolver_threads);
+  for (uint32_t i = 0; i < num_resolver_threads; ++i) {
+    resolver_threads_.push_back(
+        api.threadFactory().createThread([this] { resolveThreadRoutine(); }));
+  }
+}
+
 GetAddrInfoDnsResolver::~GetAddrInfoDnsResolver() {
   {
     absl::MutexLock guard(&mutex_);
     shutting_down_ = true;
-    pending_queries_.clear();
+    pending_resolutions_.clear();
+    resolutions_.clear();
   }
 
-  resolver_thread_->join();
+  for (const auto& thread : resolver_threads_) {
+    thread->join();
+  }
 }
 
 ActiveDnsQuery* GetAddrInfoDnsResolver::resolve(const std::string& dns_name,
                                                 DnsLookupFamily dns_lookup_family,
                                                 ResolveCb callback) {
-  ENVOY_LOG(debug, "adding new query [{}] to pending queries", dns_name);
+  auto new_query = std::make_shared<PendingQuery>(dns_name, dns_lookup_family, callback, mutex_);
+  if (query_timeout_.has_value()) {
+    new_query->deadline_ = dispatcher_.timeSource().monotonicTime() + *query_timeout_;
+    timeout_queue_.push_back(new_query);
+    if (!timeout_timer_->enabled()) {
+      timeout_timer_->enableTimer(*query_timeout_);
+    }
+  }
+
   absl::MutexLock guard(&mutex_);
-  auto new_query = std::make_unique<PendingQuery>(dns_name, dns_lookup_family, callback, mutex_);
-  pending_queries_.emplace_back(std::move(new_query));
-  return pending_queries_.back().get();
+  auto [it, inserted] = resolutions_.try_emplace(ResolutionKey{dns_name, dns_lookup_family});
+  if (inserted) {
+    ENVOY_LOG(debug, "adding new query [{}] to pending queries", dns_name);
+    pending_resolutions_.push_back(it->first);
+  } else {
+    ENVOY_LOG(debug, "adding new query [{}] to the identical pending query", dns_name);
+  }
+  it->second.push_back(new_query);
+  return new_query.get();
+}
+
+void GetAddrInfoDnsResolver::onQueryTimeout() {
+  const MonotonicTime now = dispatcher_.timeSource().monotonicTime();
+  std::vector<PendingQuerySharedPtr> timed_out_queries;
+  while (!timeout_queue_.empty()) {
+    PendingQuerySharedPtr query = timeout_queue_.front().lock();
+    if (query != nullptr && query->deadline_ > now) {
+      timeout_timer_->enableTimer(
+          std::chrono::ceil<std::chrono::milliseconds>(query->deadline_ - now));
+      break;
+    }
+    timeout_queue_.pop_front();
+    if (query != nullptr && !query->completed_ && !query->cancelled_) {
+      ENVOY_LOG(debug, "query [{}] timed out", query->dns_name_);
+      {
+        // The result of the resolution in progress, if any, is dropped.
+        absl::MutexLock guard(&mutex_);
+        query->cancelled_ = true;
+      }
+      timed_out_queries.push_back(std::move(query));
+    }
+  }
+
+  // The callbacks may destroy the resolver, so nothing of it must be accessed after them.
+  for (const PendingQuerySharedPtr& query : timed_out_queries) {
+    query->completed_ = true;
+    query->callback_(ResolutionStatus::Failure, "getaddrinfo_timeout", {});
+  }
 }
 
 std::pair<DnsResolver::ResolutionStatus, std::list<DnsResponse>>
-GetAddrInfoDnsResolver::processResponse(const PendingQuery& query,
+GetAddrInfoDnsResolver::processResponse(const ResolutionKey& key,
                                         const addrinfo* addrinfo_result) {
   std::list<DnsResponse> v4_results;
   std::list<DnsResponse> v6_results;
@@ -70,7 +135,7 @@ GetAddrInfoDnsResolver::processResponse(const PendingQuery& query,
   }
 
   std::list<DnsResponse> final_results;
-  switch (query.dns_lookup_family_) {
+  switch (key.second) {
   case DnsLookupFamily::All:
     final_results = std::move(v4_results);
     final_results.splice(final_results.begin(), v6_results);
@@ -98,7 +163,7 @@ GetAddrInfoDnsResolver::processResponse(const PendingQuery& query,
     break;
   }
 
-  ENVOY_LOG(debug, "getaddrinfo resolution complete for host '{}': {}", query.dns_name_,
+  ENVOY_LOG(debug, "getaddrinfo resolution complete for host '{}': {}", key.first,
             accumulateToString<Network::DnsResponse>(final_results, [](const auto& dns_response) {
               return dns_response.addrInfo().address_->asString();
             }));
@@ -111,7 +176,7 @@ void GetAddrInfoDnsResolver::resolveThreadRoutine() {
   ENVOY_LOG(debug, "starting getaddrinfo resolver thread");
 
   while (true) {
-    PendingQuerySharedPtr next_query;
+    ResolutionKey next_resolution;
     const bool reresolve =
         Runtime::runtimeFeatureEnabled("envoy.reloadable_features.dns_reresolve_on_eai_again");
     const bool treat_nodata_noname_as_success =
@@ -119,21 +184,27 @@ void GetAddrInfoDnsResolver::resolveThreadRoutine() {
     {
       absl::MutexLock guard(&mutex_);
       auto condition = [this]() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_) {
-        return shutting_down_ || !pending_queries_.empty();
+        return shutting_down_ || !pending_resolutions_.empty();
       };
       mutex_.Await(absl::Condition(&condition));
       if (shutting_down_) {
         break;
       }
 
-      next_query = std::move(pending_queries_.front());
-      pending_queries_.pop_front();
-      if (reresolve && next_query->cancelled_) {
-        continue;
+      next_resolution = std::move(pending_resolutions_.front());
+      pending_resolutions_.pop_front();
+      if (reresolve) {
+        auto it = resolutions_.find(next_resolution);
+        it->second.remove_if([](const PendingQuerySharedPtr& query) { return query->cancelled_; });
+        if (it->second.empty()) {
+          resolutions_.erase(it);
+          continue;
+        }
       }
     }
 
-    ENVOY_LOG(debug, "popped pending query [{}]", next_query->dns_name_);
+    const std::string& dns_name = next_resolution.first;
+    ENVOY_LOG(debug, "popped pending query [{}]", dns_name);
 
     // For mock testing make sure the getaddrinfo() response is freed prior to the post.
     std::pair<ResolutionStatus, std::list<DnsResponse>> response;
@@ -148,15 +219,15 @@ void GetAddrInfoDnsResolver::resolveThreadRoutine() {
       // anyway, just pick one.
       hints.ai_socktype = SOCK_STREAM;
       addrinfo* addrinfo_result_do_not_use = nullptr;
-      auto rc = Api::OsSysCallsSingleton::get().getaddrinfo(next_query->dns_name_.c_str(), nullptr,
-                                                            &hints, &addrinfo_result_do_not_use);
+      auto rc = Api::OsSysCallsSingleton::get().getaddrinfo(dns_name.c_str(), nullptr, &hints,
+                                                            &addrinfo_result_do_not_use);
       auto addrinfo_wrapper = AddrInfoWrapper(addrinfo_result_do_not_use);
       if (rc.return_value_ == 0) {
-        response = processResponse(*next_query, addrinfo_wrapper.get());
+        response = processResponse(next_resolution, addrinfo_wrapper.get());
       } else if (reresolve && rc.return_value_ == EAI_AGAIN) {
-        ENVOY_LOG(debug, "retrying query [{}]", next_query->dns_name_);
+        ENVOY_LOG(debug, "retrying query [{}]", dns_name);
         absl::MutexLock guard(&mutex_);
-        pending_queries_.push_back(next_query);
+        pending_resolutions_.push_back(std::move(next_resolution));
         continue;
       } else if (treat_nodata_noname_as_success &&
                  (rc.return_value_ == EAI_NONAME || rc.return_value_ == EAI_NODATA)) {
@@ -165,23 +236,38 @@ void GetAddrInfoDnsResolver::resolveThreadRoutine() {
         // the DNS query is retried.
         // NOTE: this is also how the c-ares resolver treats NONAME and NODATA:
         // https://github.com/envoyproxy/envoy/blob/099d85925b32ce8bf06e241ee433375a0a3d751b/source/extensions/network/dns_resolver/cares/dns_impl.h#L109-L111.
-        ENVOY_LOG(debug, "getaddrinfo for host={} has no results rc={}", next_query->dns_name_,
+        ENVOY_LOG(debug, "getaddrinfo for host={} has no results rc={}", dns_name,
                   gai_strerror(rc.return_value_));
         response = std::make_pair(ResolutionStatus::Success, std::list<DnsResponse>());
       } else {
-        ENVOY_LOG(debug, "getaddrinfo failed for host={} with rc={} errno={}",
-                  next_query->dns_name_, gai_strerror(rc.return_value_), errorDetails(rc.errno_));
+        ENVOY_LOG(debug, "getaddrinfo failed for host={} with rc={} errno={}", dns_name,
+                  gai_strerror(rc.return_value_), errorDetails(rc.errno_));
         response = std::make_pair(ResolutionStatus::Failure, std::list<DnsResponse>());
       }
       details = gai_strerror(rc.return_value_);
     }
 
-    dispatcher_.post([finished_query = std::move(next_query), response = std::move(response),
-                      details = std::string(details)]() mutable {
-      if (finished_query->cancelled_) {
-        ENVOY_LOG(debug, "dropping cancelled query [{}]", finished_query->dns_name_);
-      } else {
-        finished_query->callback_(response.first, std::move(details), std::move(response.second));
+    std::list<PendingQuerySharedPtr> finished_queries;
+    {
+      absl::MutexLock guard(&mutex_);
+      auto node = resolutions_.extract(next_resolution);
+      if (node.empty()) {
+        // The resolver is shutting down.
+        continue;
+      }
+      finished_queries = std::move(node.mapped());
+    }
+
+    dispatcher_.post([finished_queries = std::move(finished_queries),
+                      response = std::move(response), details = std::string(details)]() {
+      for (const PendingQuerySharedPtr& finished_query : finished_queries) {
+        if (finished_query->cancelled_) {
+          ENVOY_LOG(debug, "dropping cancelled query [{}]", finished_query->dns_name_);
+        } else {
+          finished_query->completed_ = true;
+          finished_query->callback_(response.first, details,
+                                    std::list<DnsResponse>(response.second));
+        }
       }
     });
   }
@@ -1,25 +1,37 @@
 #pragma once
 
+#include <deque>
+#include <list>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
 #include "envoy/extensions/network/dns_resolver/getaddrinfo/v3/getaddrinfo_dns_resolver.pb.h"
 #include "envoy/network/dns_resolver.h"
 #include "envoy/registry/registry.h"
 
 #include "source/common/api/os_sys_calls_impl.h"
 #include "source/common/network/address_impl.h"
+#include "source/common/protobuf/utility.h"
+
+#include "absl/container/flat_hash_map.h"
 
 namespace Envoy {
 namespace Network {
 
 DECLARE_FACTORY(GetAddrInfoDnsResolverFactory);
 
-// This resolver uses getaddrinfo() on a dedicated resolution thread. Thus, it is only suitable
-// currently for relatively low rate resolutions. In the future a thread pool could be added if
-// desired.
+// This resolver uses getaddrinfo() on a pool of dedicated resolution threads, one by default.
+// getaddrinfo() blocks its thread until it returns, so the number of threads bounds the number of
+// concurrent resolutions. The concurrent queries of the same name and lookup family share a
+// resolution.
 class GetAddrInfoDnsResolver : public DnsResolver, public Logger::Loggable<Logger::Id::dns> {
 public:
-  GetAddrInfoDnsResolver(Event::Dispatcher& dispatcher, Api::Api& api)
-      : dispatcher_(dispatcher),
-        resolver_thread_(api.threadFactory().createThread([this] { resolveThreadRoutine(); })) {}
+  GetAddrInfoDnsResolver(
+      const envoy::extensions::network::dns_resolver::getaddrinfo::v3::GetAddrInfoDnsResolverConfig&
+          config,
+      Event::Dispatcher& dispatcher, Api::Api& api);
 
   ~GetAddrInfoDnsResolver() override;
 
@@ -47,30 +59,50 @@ protected:
     const DnsLookupFamily dns_lookup_family_;
     ResolveCb callback_;
     bool cancelled_{false};
+    // Has the callback been invoked? Only accessed on the dispatcher thread.
+    bool completed_{false};
+    // When the query times out, if a query timeout is configured.
+    MonotonicTime deadline_;
   };
   // Must be a shared_ptr for passing around via post.
   using PendingQuerySharedPtr = std::shared_ptr<PendingQuery>;
 
+  // The name and lookup family of the queries sharing a resolution.
+  using ResolutionKey = std::pair<std::string, DnsLookupFamily>;
+
   // Parse a getaddrinfo() response and determine the final address list. We could potentially avoid
   // adding v4 or v6 addresses if we know they will never be used. Right now the final filtering is
   // done below and this code is kept simple.
   std::pair<ResolutionStatus, std::list<DnsResponse>>
-  processResponse(const PendingQuery& query, const addrinfo* addrinfo_result);
+  processResponse(const ResolutionKey& key, const addrinfo* addrinfo_result);
 
   // Background thread which wakes up and does resolutions.
   void resolveThreadRoutine();
 
+  // Fails the queries whose deadline passed, and re-arms the timer for the next deadline.
+  void onQueryTimeout();
+
   // getaddrinfo() doesn't provide TTL so use a hard coded default. This can be made configurable
   // later if needed.
   static constexpr std::chrono::seconds DEFAULT_TTL = std::chrono::seconds(60);
 
   Event::Dispatcher& dispatcher_;
+  const absl::optional<std::chrono::milliseconds> query_timeout_;
+  // The queries with a deadline, in the order of their deadlines. Only accessed on the dispatcher
+  // thread.
+  std::deque<std::weak_ptr<PendingQuery>> timeout_queue_;
+  Event::TimerPtr timeout_timer_;
   absl::Mutex mutex_;
-  std::list<PendingQuerySharedPtr> pending_queries_ ABSL_GUARDED_BY(mutex_);
+  // The queries of each resolution which is pending or in progress, which the new queries of the
+  // same name and lookup family join.
+  absl::flat_hash_map<ResolutionKey, std::list<PendingQuerySharedPtr>>
+      resolutions_ ABSL_GUARDED_BY(mutex_);
+  // The resolutions waiting for a resolver thread.
+  std::list<ResolutionKey> pending_resolutions_ ABSL_GUARDED_BY(mutex_);
   bool shutting_down_ ABSL_GUARDED_BY(mutex_){};
-  // The resolver thread must be initialized last so that the above members are already fully
+  // The resolver threads must be initialized last so that the above members are already fully
   // initialized.
-  const Thread::ThreadPtr resolver_thread_;
+  std::vector<Thread::ThreadPtr> resolver_threads_;
 };
 
 // getaddrinfo DNS resolver factory
@@ -86,8 +118,12 @@ public:
 
   absl::StatusOr<DnsResolverSharedPtr>
   createDnsResolver(Event::Dispatcher& dispatcher, Api::Api& api,
-                    const envoy::config::core::v3::TypedExtensionConfig&) const override {
-    return std::make_shared<GetAddrInfoDnsResolver>(dispatcher, api);
+                    const envoy::config::core::v3::TypedExtensionConfig& typed_dns_resolver_config)
+      const override {
+    envoy::extensions::network::dns_resolver::getaddrinfo::v3::GetAddrInfoDnsResolverConfig config;
+    RETURN_IF_NOT_OK(
+        Envoy::MessageUtil::unpackTo(typed_dns_resolver_config.typed_config(), config));
+    return std::make_shared<GetAddrInfoDnsResolver>(config, dispatcher, api);
   }
 };
 
@@ -1,7 +1,9 @@
 #include "source/extensions/quic/connection_id_generator/envoy_deterministic_connection_id_generator.h"
 
 #include <cstdint>
+#include <limits>
 
+#include "source/common/common/safe_memcpy.h"
 #include "source/common/network/socket_option_impl.h"
 #include "source/common/quic/envoy_quic_utils.h"
 
@@ -9,6 +11,16 @@
 
 namespace Envoy {
 namespace Quic {
+namespace {
+
+// The first 4 bytes of a connection id in host byte order, as the BPF program loads them.
+uint32_t connectionIdSnippet(const quic::QuicConnectionId& connection_id) {
+  uint32_t snippet;
+  safeMemcpyUnsafeSrc(&snippet, connection_id.data());
+  return ntohl(snippet);
+}
+
+} // namespace
 
 absl::optional<quic::QuicConnectionId>
 EnvoyDeterministicConnectionIdGenerator::GenerateNextConnectionId(
@@ -30,8 +42,68 @@ EnvoyDeterministicConnectionIdGenerator::MaybeReplaceConnectionId(
   return (new_cid.has_value() && new_cid.value() == original) ? absl::nullopt : new_cid;
 }
 
+EnvoyWorkerIndexConnectionIdGenerator::EnvoyWorkerIndexConnectionIdGenerator(
+    uint8_t expected_connection_id_length, uint32_t worker_index, uint32_t concurrency)
+    : EnvoyDeterministicConnectionIdGenerator(expected_connection_id_length),
+      worker_index_(worker_index), concurrency_(concurrency) {
+  ASSERT(worker_index_ < concurrency_);
+}
+
+absl::optional<quic::QuicConnectionId>
+EnvoyWorkerIndexConnectionIdGenerator::GenerateNextConnectionId(
+    const quic::QuicConnectionId& original) {
+  auto new_cid = EnvoyDeterministicConnectionIdGenerator::GenerateNextConnectionId(original);
+  if (new_cid.has_value()) {
+    encodeWorkerIndex(new_cid.value());
+  }
+  return (new_cid.has_value() && new_cid.value() == original) ? absl::nullopt : new_cid;
+}
+
+absl::optional<quic::QuicConnectionId>
+EnvoyWorkerIndexConnectionIdGenerator::MaybeReplaceConnectionId(
+    const quic::QuicConnectionId& original, const quic::ParsedQuicVersion& version) {
+  auto new_cid =
+      EnvoyDeterministicConnectionIdGenerator::MaybeReplaceConnectionId(original, version);
+  if (!new_cid.has_value()) {
+    if (routesToWorker(original)) {
+      return absl::nullopt;
+    }
+    new_cid = DeterministicConnectionIdGenerator::GenerateNextConnectionId(original);
+    if (!new_cid.has_value()) {
+      return absl::nullopt;
+    }
+  }
+  encodeWorkerIndex(new_cid.value());
+  return new_cid.value() == original ? absl::nullopt : new_cid;
+}
+
+bool EnvoyWorkerIndexConnectionIdGenerator::routesToWorker(
+    const quic::QuicConnectionId& connection_id) const {
+  return connection_id.length() >= sizeof(uint32_t) &&
+         connectionIdSnippet(connection_id) % concurrency_ == worker_index_;
+}
+
+void EnvoyWorkerIndexConnectionIdGenerator::encodeWorkerIndex(
+    quic::QuicConnectionId& connection_id) const {
+  if (connection_id.length() < sizeof(uint32_t)) {
+    return;
+  }
+  const uint32_t snippet = connectionIdSnippet(connection_id);
+  uint64_t encoded = static_cast<uint64_t>(snippet) - snippet % concurrency_ + worker_index_;
+  if (encoded > std::numeric_limits<uint32_t>::max()) {
+    encoded -= concurrency_;
+  }
+  const uint32_t encoded_snippet = htonl(static_cast<uint32_t>(encoded));
+  safeMemcpyUnsafeDst(connection_id.mutable_data(), &encoded_snippet);
+}
+
 QuicConnectionIdGeneratorPtr
-EnvoyDeterministicConnectionIdGeneratorFactory::createQuicConnectionIdGenerator(uint32_t) {
+EnvoyDeterministicConnectionIdGeneratorFactory::createQuicConnectionIdGenerator(
+    uint32_t worker_index, uint32_t concurrency) {
+  if (encode_worker_index_ && concurrency > 1) {
+    return std::make_unique<EnvoyWorkerIndexConnectionIdGenerator>(
+        quic::kQuicDefaultConnectionIdLength, worker_index, concurrency);
+  }
   return std::make_unique<EnvoyDeterministicConnectionIdGenerator>(
       quic::kQuicDefaultConnectionIdLength);
 }
@@ -27,17 +27,48 @@ public:
                            const quic::ParsedQuicVersion& version) override;
 };
 
+// This class encodes the index of the worker in the first 4 bytes of the connection ids, so that
+// they route the packets to the worker regardless of the connection ids of the client.
+class EnvoyWorkerIndexConnectionIdGenerator : public EnvoyDeterministicConnectionIdGenerator {
+public:
+  EnvoyWorkerIndexConnectionIdGenerator(uint8_t expected_connection_id_length,
+                                        uint32_t worker_index, uint32_t concurrency);
+
+  absl::optional<quic::QuicConnectionId>
+  GenerateNextConnectionId(const quic::QuicConnectionId& original) override;
+  // Replace the connection ID if |original| is not of the expected length, or if it does not route
+  // the packets to this worker.
+  absl::optional<quic::QuicConnectionId>
+  MaybeReplaceConnectionId(const quic::QuicConnectionId& original,
+                           const quic::ParsedQuicVersion& version) override;
+
+private:
+  // Whether the first 4 bytes of |connection_id| route its packets to this worker.
+  bool routesToWorker(const quic::QuicConnectionId& connection_id) const;
+  // Sets the first 4 bytes of |connection_id| to route its packets to this worker, keeping as
+  // much of their entropy as possible.
+  void encodeWorkerIndex(quic::QuicConnectionId& connection_id) const;
+
+  const uint32_t worker_index_;
+  const uint32_t concurrency_;
+};
+
 class EnvoyDeterministicConnectionIdGeneratorFactory
     : public EnvoyQuicConnectionIdGeneratorFactory {
 public:
+  explicit EnvoyDeterministicConnectionIdGeneratorFactory(bool encode_worker_index = false)
+      : encode_worker_index_(encode_worker_index) {}
+
   // EnvoyQuicConnectionIdGeneratorFactory.
-  QuicConnectionIdGeneratorPtr createQuicConnectionIdGenerator(uint32_t worker_index) override;
+  QuicConnectionIdGeneratorPtr createQuicConnectionIdGenerator(uint32_t worker_index,
+                                                               uint32_t concurrency) override;
   Network::Socket::OptionConstSharedPtr
   createCompatibleLinuxBpfSocketOption(uint32_t concurrency) override;
   QuicConnectionIdWorkerSelector
   getCompatibleConnectionIdWorkerSelector(uint32_t concurrency) override;
 
 private:
+  const bool encode_worker_index_;
 #if defined(SO_ATTACH_REUSEPORT_CBPF) && defined(__linux__)
   sock_fprog prog_;
   std::vector<sock_filter> filter_;
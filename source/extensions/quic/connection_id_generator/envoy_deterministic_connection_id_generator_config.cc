@@ -15,8 +15,12 @@ EnvoyDeterministicConnectionIdGeneratorConfigFactory::createEmptyConfigProto() {
 
 EnvoyQuicConnectionIdGeneratorFactoryPtr
 EnvoyDeterministicConnectionIdGeneratorConfigFactory::createQuicConnectionIdGeneratorFactory(
-    const Protobuf::Message&) {
-  return std::make_unique<EnvoyDeterministicConnectionIdGeneratorFactory>();
+    const Protobuf::Message& config) {
+  using envoy::extensions::quic::connection_id_generator::v3::
+      DeterministicConnectionIdGeneratorConfig;
+  const auto& typed_config = dynamic_cast<const DeterministicConnectionIdGeneratorConfig&>(config);
+  return std::make_unique<EnvoyDeterministicConnectionIdGeneratorFactory>(
+      typed_config.encode_worker_index());
 }
 
 REGISTER_FACTORY(EnvoyDeterministicConnectionIdGeneratorConfigFactory,
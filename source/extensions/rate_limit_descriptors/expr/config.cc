@@ -27,8 +27,7 @@ public:
       const google::api::expr::v1alpha1::Expr& input_expr)
       : builder_(builder), input_expr_(input_expr), descriptor_key_(config.descriptor_key()),
         skip_if_error_(config.skip_if_error()) {
-    compiled_expr_ =
-        Extensions::Filters::Common::Expr::createExpression(builder_->builder(), input_expr_);
+    compiled_expr_ = builder_->createExpression(input_expr_);
   }
 
   // Ratelimit::DescriptorProducer
@@ -53,7 +52,7 @@ private:
   const google::api::expr::v1alpha1::Expr input_expr_;
   const std::string descriptor_key_;
   const bool skip_if_error_;
-  Extensions::Filters::Common::Expr::ExpressionPtr compiled_expr_;
+  Extensions::Filters::Common::Expr::ExpressionSharedPtr compiled_expr_;
 };
 
 } // namespace
@@ -4,7 +4,6 @@
 #include "envoy/tracing/tracer.h"
 
 #include "source/common/common/random_generator.h"
-#include "source/common/common/utility.h"
 #include "source/common/stream_info/stream_id_provider_impl.h"
 
 namespace Envoy {
@@ -16,6 +15,12 @@ void UUIDRequestIDExtension::set(Http::RequestHeaderMap& request_headers, bool f
     return;
   }
 
+  if (use_fast_random_) {
+    Random::RandomUtility::UuidBuffer buffer;
+    request_headers.setRequestId(Random::RandomUtility::fastUuid(buffer));
+    return;
+  }
+
   // TODO(PiotrSikora) PERF: Write UUID directly to the header map.
   std::string uuid = random_.uuid();
   ASSERT(!uuid.empty());
@@ -42,14 +47,23 @@ UUIDRequestIDExtension::getInteger(const Http::RequestHeaderMap& request_headers
   if (request_headers.RequestId() == nullptr) {
     return absl::nullopt;
   }
-  const std::string uuid(request_headers.getRequestIdValue());
+  const absl::string_view uuid = request_headers.getRequestIdValue();
   if (uuid.length() < 8) {
     return absl::nullopt;
   }
 
-  uint64_t value;
-  if (!StringUtil::atoull(uuid.substr(0, 8).c_str(), value, 16)) {
-    return absl::nullopt;
+  // Parse the first 8 hex digits in place, without copying them.
+  uint64_t value = 0;
+  for (const char c : uuid.substr(0, 8)) {
+    if (c >= '0' && c <= '9') {
+      value = (value << 4) | (c - '0');
+    } else if (c >= 'a' && c <= 'f') {
+      value = (value << 4) | (c - 'a' + 10);
+    } else if (c >= 'A' && c <= 'F') {
+      value = (value << 4) | (c - 'A' + 10);
+    } else {
+      return absl::nullopt;
+    }
   }
 
   return value;
@@ -86,7 +100,8 @@ void UUIDRequestIDExtension::setTraceReason(Http::RequestHeaderMap& request_head
   if (uuid_view.length() != Random::RandomGeneratorImpl::UUID_LENGTH) {
     return;
   }
-  std::string uuid(uuid_view);
+  Random::RandomUtility::UuidBuffer uuid;
+  uuid_view.copy(uuid.data(), uuid.size());
 
   switch (reason) {
   case Tracing::Reason::ServiceForced:
@@ -104,7 +119,7 @@ void UUIDRequestIDExtension::setTraceReason(Http::RequestHeaderMap& request_head
   default:
     break;
   }
-  request_headers.setRequestId(uuid);
+  request_headers.setRequestId(absl::string_view(uuid.data(), uuid.size()));
 }
 
 REGISTER_FACTORY(UUIDRequestIDExtensionFactory, Server::Configuration::RequestIDExtensionFactory);
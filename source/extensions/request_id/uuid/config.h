@@ -18,7 +18,8 @@ public:
       : random_(random),
         pack_trace_reason_(PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, pack_trace_reason, true)),
         use_request_id_for_trace_sampling_(
-            PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, use_request_id_for_trace_sampling, true)) {}
+            PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, use_request_id_for_trace_sampling, true)),
+        use_fast_random_(config.use_fast_random()) {}
 
   static Envoy::Http::RequestIDExtensionSharedPtr defaultInstance(Random::RandomGenerator& random) {
     return std::make_shared<UUIDRequestIDExtension>(
@@ -44,6 +45,7 @@ private:
   Envoy::Random::RandomGenerator& random_;
   const bool pack_trace_reason_;
   const bool use_request_id_for_trace_sampling_;
+  const bool use_fast_random_;
 
   // Byte on this position has predefined value of 4 for UUID4.
   static const int TRACE_BYTE_POSITION = 14;
@@ -16,8 +16,9 @@ Server::ProactiveResourceMonitorPtr
 ActiveDownstreamConnectionsMonitorFactory::createProactiveResourceMonitorFromProtoTyped(
     const envoy::extensions::resource_monitors::downstream_connections::v3::
         DownstreamConnectionsConfig& config,
-    Server::Configuration::ResourceMonitorFactoryContext& /*unused_context*/) {
-  return std::make_unique<ActiveDownstreamConnectionsResourceMonitor>(config);
+    Server::Configuration::ResourceMonitorFactoryContext& context) {
+  return std::make_unique<ActiveDownstreamConnectionsResourceMonitor>(
+      config, context.options().concurrency());
 }
 
 /**
@@ -11,10 +11,17 @@ namespace DownstreamConnections {
 
 ActiveDownstreamConnectionsResourceMonitor::ActiveDownstreamConnectionsResourceMonitor(
     const envoy::extensions::resource_monitors::downstream_connections::v3::
-        DownstreamConnectionsConfig& config)
-    : max_(config.max_active_downstream_connections()), current_(0){};
+        DownstreamConnectionsConfig& config,
+    uint32_t concurrency)
+    : max_(config.max_active_downstream_connections()), current_(0),
+      sharded_(config.per_worker_slack() > 0 && max_ > 0
+                   ? std::make_unique<ShardedLimit>(max_, config.per_worker_slack(), concurrency)
+                   : nullptr){};
 
 bool ActiveDownstreamConnectionsResourceMonitor::tryAllocateResource(int64_t increment) {
+  if (sharded_ != nullptr) {
+    return increment >= 0 && sharded_->tryAllocate(increment);
+  }
   // No synchronization is imposed on other reads or writes.
   auto current = current_.load(std::memory_order_relaxed);
   while (current + increment <= max_) {
@@ -36,6 +43,14 @@ bool ActiveDownstreamConnectionsResourceMonitor::tryAllocateResource(int64_t inc
 }
 
 bool ActiveDownstreamConnectionsResourceMonitor::tryDeallocateResource(int64_t decrement) {
+  if (sharded_ != nullptr) {
+    // The releases aren't checked against the allocations, which are counted by the workers.
+    if (decrement < 0) {
+      return false;
+    }
+    sharded_->release(decrement);
+    return true;
+  }
   // No synchronization is imposed on other reads or writes.
   auto current = current_.load(std::memory_order_relaxed);
   while (current - decrement >= 0) {
@@ -57,6 +72,9 @@ bool ActiveDownstreamConnectionsResourceMonitor::tryDeallocateResource(int64_t d
 }
 
 int64_t ActiveDownstreamConnectionsResourceMonitor::currentResourceUsage() const {
+  if (sharded_ != nullptr) {
+    return sharded_->allocated();
+  }
   return current_.load();
 }
 int64_t ActiveDownstreamConnectionsResourceMonitor::maxResourceUsage() const { return max_; };
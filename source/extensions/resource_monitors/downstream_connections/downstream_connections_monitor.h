@@ -1,8 +1,11 @@
 #pragma once
 
+#include <memory>
+
 #include "envoy/extensions/resource_monitors/downstream_connections/v3/downstream_connections.pb.h"
 #include "envoy/server/proactive_resource_monitor.h"
 
+#include "source/common/common/sharded_limit.h"
 #include "source/common/common/thread_synchronizer.h"
 
 namespace Envoy {
@@ -12,9 +15,13 @@ namespace DownstreamConnections {
 
 class ActiveDownstreamConnectionsResourceMonitor : public Server::ProactiveResourceMonitor {
 public:
+  /**
+   * @param concurrency the number of workers, among which the slack of the config is shared.
+   */
   ActiveDownstreamConnectionsResourceMonitor(
       const envoy::extensions::resource_monitors::downstream_connections::v3::
-          DownstreamConnectionsConfig& config);
+          DownstreamConnectionsConfig& config,
+      uint32_t concurrency = 1);
 
   bool tryAllocateResource(int64_t increment) override;
 
@@ -26,6 +33,8 @@ public:
 protected:
   const int64_t max_;
   std::atomic<int64_t> current_;
+  // Accounts the connections instead of current_ when the workers have slack.
+  std::unique_ptr<ShardedLimit> sharded_;
   // Used for testing only.
   mutable Thread::ThreadSynchronizer synchronizer_;
 
@@ -15,13 +15,15 @@
 #include "source/common/buffer/buffer_impl.h"
 #include "source/common/common/assert.h"
 #include "source/common/common/fmt.h"
+#include "source/common/common/logger.h"
 #include "source/common/common/utility.h"
 #include "source/common/config/utility.h"
 #include "source/common/network/socket_interface.h"
 #include "source/common/network/utility.h"
 #include "source/common/stats/symbol_table.h"
 
-#include "absl/strings/str_join.h"
+#include "absl/container/fixed_array.h"
+#include "absl/strings/str_cat.h"
 
 namespace Envoy {
 namespace Extensions {
@@ -40,8 +42,42 @@ void UdpStatsdSink::WriterImpl::write(const std::string& message) {
   Network::Utility::writeToSocket(*io_handle_, &slice, 1, nullptr, *parent_.server_address_);
 }
 
-void UdpStatsdSink::WriterImpl::writeBuffer(Buffer::Instance& data) {
-  Network::Utility::writeToSocket(*io_handle_, data, nullptr, *parent_.server_address_);
+void UdpStatsdSink::WriterImpl::writeDatagrams(const std::vector<std::string>& datagrams) {
+  if (!io_handle_->supportsMmsg()) {
+    for (const std::string& datagram : datagrams) {
+      write(datagram);
+    }
+    return;
+  }
+
+  absl::FixedArray<struct iovec> iovs(datagrams.size());
+  absl::FixedArray<mmsghdr> mmsg_hdr(datagrams.size());
+  for (size_t i = 0; i < datagrams.size(); ++i) {
+    iovs[i].iov_base = const_cast<char*>(datagrams[i].data());
+    iovs[i].iov_len = datagrams[i].size();
+
+    mmsg_hdr[i] = {};
+    msghdr& hdr = mmsg_hdr[i].msg_hdr;
+    hdr.msg_name = const_cast<sockaddr*>(parent_.server_address_->sockAddr());
+    hdr.msg_namelen = parent_.server_address_->sockAddrLen();
+    hdr.msg_iov = &iovs[i];
+    hdr.msg_iovlen = 1;
+  }
+
+  // As with the datagrams written one at a time, a datagram which fails to be sent is dropped.
+  Api::OsSysCalls& os_sys_calls = Api::OsSysCallsSingleton::get();
+  size_t sent = 0;
+  while (sent < datagrams.size()) {
+    const Api::SysCallIntResult result = os_sys_calls.sendmmsg(
+        io_handle_->fdDoNotUse(), &mmsg_hdr[sent], datagrams.size() - sent, 0);
+    if (result.return_value_ <= 0) {
+      ENVOY_LOG_MISC(trace, "statsd sendmmsg failed with error code {} after {} of {} datagrams",
+                     result.errno_, sent, datagrams.size());
+      ++sent;
+    } else {
+      sent += result.return_value_;
+    }
+  }
 }
 
 UdpStatsdSink::UdpStatsdSink(ThreadLocal::SlotAllocator& tls,
@@ -57,62 +93,74 @@ UdpStatsdSink::UdpStatsdSink(ThreadLocal::SlotAllocator& tls,
 }
 
 void UdpStatsdSink::flush(Stats::MetricSnapshot& snapshot) {
-  Writer& writer = tls_->getTyped<Writer>();
-  Buffer::OwnedImpl buffer;
+  // The metrics are built into a single scratch string and packed into the datagrams, which are
+  // all written at the end of the flush.
+  std::vector<std::string> datagrams;
+  std::string datagram;
+  std::string message;
 
   for (const auto& counter : snapshot.counters()) {
     if (counter.counter_.get().used()) {
-      const std::string counter_str = buildMessage(counter.counter_.get(), counter.delta_, "|c");
-      writeBuffer(buffer, writer, counter_str);
+      message.clear();
+      appendMessage(message, counter.counter_.get(), counter.delta_, "|c");
+      addToDatagrams(datagrams, datagram, message);
     }
   }
 
   for (const auto& counter : snapshot.hostCounters()) {
-    const std::string counter_str = buildMessage(counter, counter.delta(), "|c");
-    writeBuffer(buffer, writer, counter_str);
+    message.clear();
+    appendMessage(message, counter, counter.delta(), "|c");
+    addToDatagrams(datagrams, datagram, message);
   }
 
   for (const auto& gauge : snapshot.gauges()) {
     if (gauge.get().used()) {
-      const std::string gauge_str = buildMessage(gauge.get(), gauge.get().value(), "|g");
-      writeBuffer(buffer, writer, gauge_str);
+      message.clear();
+      appendMessage(message, gauge.get(), gauge.get().value(), "|g");
+      addToDatagrams(datagrams, datagram, message);
     }
   }
 
   for (const auto& gauge : snapshot.hostGauges()) {
-    const std::string gauge_str = buildMessage(gauge, gauge.value(), "|g");
-    writeBuffer(buffer, writer, gauge_str);
+    message.clear();
+    appendMessage(message, gauge, gauge.value(), "|g");
+    addToDatagrams(datagrams, datagram, message);
   }
 
-  flushBuffer(buffer, writer);
+  if (!datagram.empty()) {
+    datagrams.push_back(std::move(datagram));
+  }
+  if (!datagrams.empty()) {
+    tls_->getTyped<Writer>().writeDatagrams(datagrams);
+  }
   // TODO(efimki): Add support of text readouts stats.
 }
 
-void UdpStatsdSink::writeBuffer(Buffer::OwnedImpl& buffer, Writer& writer,
-                                const std::string& statsd_metric) const {
+void UdpStatsdSink::addToDatagrams(std::vector<std::string>& datagrams, std::string& datagram,
+                                   const std::string& statsd_metric) const {
   if (statsd_metric.length() >= buffer_size_) {
-    // Our statsd_metric is too large to fit into the buffer, skip buffering and write directly
-    writer.write(statsd_metric);
-  } else {
-    if ((buffer.length() + statsd_metric.length() + 1) > buffer_size_) {
-      // If we add the new statsd_metric, we'll overflow our buffer. Flush the buffer to make
+    // Our statsd_metric is too large to fit into the buffer, skip buffering and send it on its
+    // own.
+    datagrams.push_back(statsd_metric);
+    return;
+  }
+
+  if (!datagram.empty()) {
+    if ((datagram.length() + statsd_metric.length() + 1) > buffer_size_) {
+      // If we add the new statsd_metric, we'll overflow our buffer. Complete the datagram to make
       // room for the new statsd_metric.
-      flushBuffer(buffer, writer);
-    } else if (buffer.length() > 0) {
+      datagrams.push_back(std::move(datagram));
+      datagram.clear();
+    } else {
       // We have room and have metrics already in the buffer, add a newline to separate
       // metric entries.
-      buffer.add("\n");
+      datagram.push_back('\n');
     }
-    buffer.add(statsd_metric);
   }
-}
-
-void UdpStatsdSink::flushBuffer(Buffer::OwnedImpl& buffer, Writer& writer) const {
-  if (buffer.length() == 0) {
-    return;
+  if (datagram.empty()) {
+    datagram.reserve(buffer_size_);
   }
-  writer.writeBuffer(buffer);
-  buffer.drain(buffer.length());
+  datagram.append(statsd_metric);
 }
 
 void UdpStatsdSink::onHistogramComplete(const Stats::Histogram& histogram, uint64_t value) {
@@ -139,28 +187,27 @@ void UdpStatsdSink::onHistogramComplete(const Stats::Histogram& histogram, uint6
 template <class StatType, typename ValueType>
 const std::string UdpStatsdSink::buildMessage(const StatType& metric, ValueType value,
                                               const std::string& type) const {
+  std::string message;
+  appendMessage(message, metric, value, type);
+  return message;
+}
+
+template <class StatType, typename ValueType>
+void UdpStatsdSink::appendMessage(std::string& message, const StatType& metric, ValueType value,
+                                  absl::string_view type) const {
   switch (tag_format_.tag_position) {
-  case Statsd::TagPosition::TagAfterValue: {
-    const std::string message = absl::StrCat(
-        // metric name
-        prefix_, ".", getName(metric),
-        // value and type
-        ":", value, type,
-        // tags
-        buildTagStr(metric.tags()));
-    return message;
-  }
+  case Statsd::TagPosition::TagAfterValue:
+    // metric name, value and type, tags
+    absl::StrAppend(&message, prefix_, ".", getName(metric), ":", value, type);
+    appendTagStr(message, metric.tags());
+    return;
 
-  case Statsd::TagPosition::TagAfterName: {
-    const std::string message = absl::StrCat(
-        // metric name
-        prefix_, ".", getName(metric),
-        // tags
-        buildTagStr(metric.tags()),
-        // value and type
-        ":", value, type);
-    return message;
-  }
+  case Statsd::TagPosition::TagAfterName:
+    // metric name, tags, value and type
+    absl::StrAppend(&message, prefix_, ".", getName(metric));
+    appendTagStr(message, metric.tags());
+    absl::StrAppend(&message, ":", value, type);
+    return;
   }
   PANIC_DUE_TO_CORRUPT_ENUM;
 }
@@ -173,17 +220,19 @@ template <class StatType> const std::string UdpStatsdSink::getName(const StatTyp
   }
 }
 
-const std::string UdpStatsdSink::buildTagStr(const std::vector<Stats::Tag>& tags) const {
+void UdpStatsdSink::appendTagStr(std::string& message,
+                                 const std::vector<Stats::Tag>& tags) const {
   if (!use_tag_ || tags.empty()) {
-    return "";
+    return;
   }
 
-  std::vector<std::string> tag_strings;
-  tag_strings.reserve(tags.size());
-  for (const Stats::Tag& tag : tags) {
-    tag_strings.emplace_back(tag.name_ + tag_format_.assign + tag.value_);
+  message.append(tag_format_.start);
+  for (size_t i = 0; i < tags.size(); ++i) {
+    if (i > 0) {
+      message.append(tag_format_.separator);
+    }
+    absl::StrAppend(&message, tags[i].name_, tag_format_.assign, tags[i].value_);
   }
-  return tag_format_.start + absl::StrJoin(tag_strings, tag_format_.separator);
 }
 
 TcpStatsdSink::TcpStatsdSink(const LocalInfo::LocalInfo& local_info,
@@ -222,10 +271,10 @@ void TcpStatsdSink::flush(Stats::MetricSnapshot& snapshot) {
     if (gauge.get().used()) {
       tls_sink.flushGauge(gauge.get().name(), gauge.get().value());
     }
+  }
 
-    for (const auto& gauge : snapshot.hostGauges()) {
-      tls_sink.flushGauge(gauge.name(), gauge.value());
-    }
+  for (const auto& gauge : snapshot.hostGauges()) {
+    tls_sink.flushGauge(gauge.name(), gauge.value());
   }
   // TODO(efimki): Add support of text readouts stats.
   tls_sink.endFlush(true);
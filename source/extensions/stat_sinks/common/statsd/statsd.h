@@ -1,5 +1,8 @@
 #pragma once
 
+#include <string>
+#include <vector>
+
 #include "envoy/buffer/buffer.h"
 #include "envoy/common/platform.h"
 #include "envoy/local_info/local_info.h"
@@ -17,6 +20,7 @@
 #include "source/common/network/io_socket_handle_impl.h"
 #include "source/extensions/stat_sinks/common/statsd/tag_formats.h"
 
+#include "absl/strings/string_view.h"
 #include "absl/types/optional.h"
 
 namespace Envoy {
@@ -38,7 +42,12 @@ public:
   class Writer : public ThreadLocal::ThreadLocalObject {
   public:
     virtual void write(const std::string& message) PURE;
-    virtual void writeBuffer(Buffer::Instance& data) PURE;
+
+    /**
+     * Writes the datagrams of a flush, with as few system calls as the platform allows.
+     * @param datagrams supplies the datagrams, in the order they are to be sent.
+     */
+    virtual void writeDatagrams(const std::vector<std::string>& datagrams) PURE;
   };
 
   UdpStatsdSink(ThreadLocal::SlotAllocator& tls, Network::Address::InstanceConstSharedPtr address,
@@ -75,21 +84,24 @@ private:
 
     // Writer
     void write(const std::string& message) override;
-    void writeBuffer(Buffer::Instance& data) override;
+    void writeDatagrams(const std::vector<std::string>& datagrams) override;
 
   private:
     UdpStatsdSink& parent_;
     const Network::IoHandlePtr io_handle_;
   };
 
-  void flushBuffer(Buffer::OwnedImpl& buffer, Writer& writer) const;
-  void writeBuffer(Buffer::OwnedImpl& buffer, Writer& writer, const std::string& data) const;
+  void addToDatagrams(std::vector<std::string>& datagrams, std::string& datagram,
+                      const std::string& statsd_metric) const;
 
   template <class StatType, typename ValueType>
   const std::string buildMessage(const StatType& metric, ValueType value,
                                  const std::string& type) const;
+  template <class StatType, typename ValueType>
+  void appendMessage(std::string& message, const StatType& metric, ValueType value,
+                     absl::string_view type) const;
   template <class StatType> const std::string getName(const StatType& metric) const;
-  const std::string buildTagStr(const std::vector<Stats::Tag>& tags) const;
+  void appendTagStr(std::string& message, const std::vector<Stats::Tag>& tags) const;
 
   const ThreadLocal::SlotPtr tls_;
   const Network::Address::InstanceConstSharedPtr server_address_;
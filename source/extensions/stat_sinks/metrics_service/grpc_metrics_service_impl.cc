@@ -47,7 +47,7 @@ void GrpcMetricsStreamerImpl::send(MetricsPtr&& metrics) {
   stream_->sendMessage(message, false);
 }
 
-MetricsPtr MetricsFlusher::flush(Stats::MetricSnapshot& snapshot) const {
+MetricsPtr MetricsFlusher::flush(Stats::MetricSnapshot& snapshot) {
   auto metrics =
       std::make_unique<Envoy::Protobuf::RepeatedPtrField<io::prometheus::client::MetricFamily>>();
 
@@ -60,18 +60,37 @@ MetricsPtr MetricsFlusher::flush(Stats::MetricSnapshot& snapshot) const {
                                  snapshot.snapshotTime().time_since_epoch())
                                  .count();
   for (const auto& counter : snapshot.counters()) {
+    if (report_only_changed_metrics_ && counter.delta_ == 0) {
+      continue;
+    }
     if (predicate_(counter.counter_.get())) {
       flushCounter(*metrics->Add(), counter, snapshot_time_ms);
     }
   }
 
+  absl::flat_hash_map<const Stats::Gauge*, uint64_t> gauge_values;
+  if (report_only_changed_metrics_) {
+    gauge_values.reserve(snapshot.gauges().size());
+  }
   for (const auto& gauge : snapshot.gauges()) {
+    if (report_only_changed_metrics_) {
+      const uint64_t value = gauge.get().value();
+      gauge_values.emplace(&gauge.get(), value);
+      const auto it = gauge_values_.find(&gauge.get());
+      if (it != gauge_values_.end() && it->second == value) {
+        continue;
+      }
+    }
     if (predicate_(gauge)) {
       flushGauge(*metrics->Add(), gauge.get(), snapshot_time_ms);
     }
   }
+  gauge_values_ = std::move(gauge_values);
 
   for (const auto& histogram : snapshot.histograms()) {
+    if (report_only_changed_metrics_ && histogram.get().intervalStatistics().sampleCount() == 0) {
+      continue;
+    }
     if (predicate_(histogram.get())) {
       if (emit_summary_) {
         flushSummary(*metrics->Add(), histogram.get(), snapshot_time_ms);
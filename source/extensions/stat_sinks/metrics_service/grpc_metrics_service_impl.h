@@ -17,6 +17,8 @@
 #include "source/common/grpc/status.h"
 #include "source/common/grpc/typed_async_client.h"
 
+#include "absl/container/flat_hash_map.h"
+
 namespace Envoy {
 namespace Extensions {
 namespace StatSinks {
@@ -91,6 +93,7 @@ class MetricsFlusher {
 public:
   MetricsFlusher(
       bool report_counters_as_deltas, bool emit_labels, HistogramEmitMode histogram_emit_mode,
+      bool report_only_changed_metrics = false,
       std::function<bool(const Stats::Metric&)> predicate =
           [](const auto& metric) { return metric.used(); })
       : report_counters_as_deltas_(report_counters_as_deltas), emit_labels_(emit_labels),
@@ -98,9 +101,13 @@ public:
                       histogram_emit_mode == HistogramEmitMode::SUMMARY),
         emit_histogram_(histogram_emit_mode == HistogramEmitMode::SUMMARY_AND_HISTOGRAM ||
                         histogram_emit_mode == HistogramEmitMode::HISTOGRAM),
-        predicate_(predicate) {}
+        report_only_changed_metrics_(report_only_changed_metrics), predicate_(predicate) {}
 
-  MetricsPtr flush(Stats::MetricSnapshot& snapshot) const;
+  /**
+   * @return the metrics of the snapshot to send. When only the changed metrics are reported, the
+   * gauges are compared with their values in the snapshot of the previous call.
+   */
+  MetricsPtr flush(Stats::MetricSnapshot& snapshot);
 
 private:
   void flushCounter(io::prometheus::client::MetricFamily& metrics_family,
@@ -123,7 +130,12 @@ private:
   const bool emit_labels_;
   const bool emit_summary_;
   const bool emit_histogram_;
+  const bool report_only_changed_metrics_;
   const std::function<bool(const Stats::Metric&)> predicate_;
+  // The values of the gauges at the previous flush, when only the changed metrics are reported.
+  // The gauges are only compared by address: it is rebuilt from each snapshot, so that it doesn't
+  // reference the gauges which were destroyed since.
+  absl::flat_hash_map<const Stats::Gauge*, uint64_t> gauge_values_;
 };
 
 /**
@@ -133,10 +145,11 @@ template <class RequestProto, class ResponseProto> class MetricsServiceSink : pu
 public:
   MetricsServiceSink(
       const GrpcMetricsStreamerSharedPtr<RequestProto, ResponseProto>& grpc_metrics_streamer,
-      bool report_counters_as_deltas, bool emit_labels, HistogramEmitMode histogram_emit_mode)
-      : MetricsServiceSink(
-            grpc_metrics_streamer,
-            MetricsFlusher(report_counters_as_deltas, emit_labels, histogram_emit_mode)) {}
+      bool report_counters_as_deltas, bool emit_labels, HistogramEmitMode histogram_emit_mode,
+      bool report_only_changed_metrics = false)
+      : MetricsServiceSink(grpc_metrics_streamer,
+                           MetricsFlusher(report_counters_as_deltas, emit_labels,
+                                          histogram_emit_mode, report_only_changed_metrics)) {}
 
   MetricsServiceSink(
       const GrpcMetricsStreamerSharedPtr<RequestProto, ResponseProto>& grpc_metrics_streamer,
@@ -150,7 +163,7 @@ public:
   void onHistogramComplete(const Stats::Histogram&, uint64_t) override {}
 
 private:
-  const MetricsFlusher flusher_;
+  MetricsFlusher flusher_;
   GrpcMetricsStreamerSharedPtr<RequestProto, ResponseProto> grpc_metrics_streamer_;
 };
 
@@ -16,6 +16,8 @@ bool OpenTelemetryGrpcTraceExporter::log(const ExportTraceServiceRequest& reques
   return client_.log(request);
 }
 
+bool OpenTelemetryGrpcTraceExporter::log(Buffer::Instance& request) { return client_.log(request); }
+
 } // namespace OpenTelemetry
 } // namespace Tracers
 } // namespace Extensions
@@ -2,7 +2,9 @@
 
 #include "envoy/grpc/async_client_manager.h"
 
+#include "source/common/buffer/buffer_impl.h"
 #include "source/common/common/logger.h"
+#include "source/common/grpc/common.h"
 #include "source/common/grpc/typed_async_client.h"
 #include "source/extensions/tracers/opentelemetry/otlp_utils.h"
 #include "source/extensions/tracers/opentelemetry/trace_exporter.h"
@@ -54,6 +56,10 @@ public:
   };
 
   bool log(const ExportTraceServiceRequest& request) {
+    return log(*Grpc::Common::serializeMessage(request));
+  }
+
+  bool log(Buffer::Instance& request) {
     // If we don't have a stream already, we need to initialize it.
     if (!stream_) {
       stream_ = std::make_unique<LocalStream>(*this);
@@ -72,7 +78,9 @@ public:
       if (stream_->stream_->isAboveWriteBufferHighWatermark()) {
         return false;
       }
-      stream_->stream_->sendMessage(request, true);
+      auto serialized_request = std::make_unique<Buffer::OwnedImpl>();
+      serialized_request->move(request);
+      stream_->stream_->sendMessageRaw(std::move(serialized_request), true);
     } else {
       stream_.reset();
     }
@@ -89,6 +97,7 @@ public:
   OpenTelemetryGrpcTraceExporter(const Grpc::RawAsyncClientSharedPtr& client);
 
   bool log(const ExportTraceServiceRequest& request) override;
+  bool log(Buffer::Instance& request) override;
 
 private:
   OpenTelemetryGrpcTraceExporterClient client_;
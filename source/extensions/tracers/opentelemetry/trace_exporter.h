@@ -1,5 +1,7 @@
 #pragma once
 
+#include "envoy/buffer/buffer.h"
+
 #include "source/common/common/logger.h"
 
 #include "opentelemetry/proto/collector/trace/v1/trace_service.pb.h"
@@ -28,6 +30,15 @@ public:
    * @return false When sending the request failed.
    */
   virtual bool log(const ExportTraceServiceRequest& request) = 0;
+
+  /**
+   * @brief Exports an already serialized trace request to the configured OTLP service.
+   *
+   * @param request The serialized OTLP trace request, which is moved out of the buffer when sent.
+   * @return true When the request was sent.
+   * @return false When sending the request failed.
+   */
+  virtual bool log(Buffer::Instance& request) = 0;
 };
 
 using OpenTelemetryTraceExporterPtr = std::unique_ptr<OpenTelemetryTraceExporter>;
@@ -7,6 +7,7 @@
 
 #include "source/common/common/empty_string.h"
 #include "source/common/common/hex.h"
+#include "source/common/protobuf/protobuf.h"
 #include "source/common/tracing/common_values.h"
 #include "source/common/tracing/trace_context_impl.h"
 #include "source/extensions/tracers/opentelemetry/otlp_utils.h"
@@ -25,6 +26,46 @@ using opentelemetry::proto::collector::trace::v1::ExportTraceServiceRequest;
 
 namespace {
 
+using Protobuf::io::CodedOutputStream;
+
+constexpr uint32_t ProtobufLengthDelimitedField = 2;
+
+void appendLengthDelimitedTag(Buffer::Instance& buffer, uint32_t field_number, uint64_t length) {
+  // Room for the varints of the tag and of the length.
+  uint8_t tag[15];
+  uint8_t* end = CodedOutputStream::WriteTagToArray(
+      (field_number << 3) | ProtobufLengthDelimitedField, tag);
+  end = CodedOutputStream::WriteVarint64ToArray(length, end);
+  buffer.add(tag, end - tag);
+}
+
+// Appends the message as the length delimited field of its enclosing message.
+void appendMessageField(Buffer::Instance& buffer, uint32_t field_number,
+                        const Protobuf::Message& message) {
+  const uint32_t tag = (field_number << 3) | ProtobufLengthDelimitedField;
+  const size_t message_size = message.ByteSizeLong();
+  const size_t size = CodedOutputStream::VarintSize32(tag) +
+                      CodedOutputStream::VarintSize64(message_size) + message_size;
+  Buffer::ReservationSingleSlice reservation = buffer.reserveSingleSlice(size);
+  uint8_t* target = static_cast<uint8_t*>(reservation.slice().mem_);
+  target = CodedOutputStream::WriteTagToArray(tag, target);
+  target = CodedOutputStream::WriteVarint64ToArray(message_size, target);
+  message.SerializeWithCachedSizesToArray(target);
+  reservation.commit(size);
+}
+
+std::string encodeResource(const Resource& resource) {
+  ::opentelemetry::proto::trace::v1::ResourceSpans resource_span;
+  resource_span.set_schema_url(resource.schema_url_);
+  for (auto const& att : resource.attributes_) {
+    opentelemetry::proto::common::v1::KeyValue* key_value =
+        resource_span.mutable_resource()->add_attributes();
+    key_value->set_key(att.first);
+    key_value->mutable_value()->set_string_value(att.second);
+  }
+  return resource_span.SerializeAsString();
+}
+
 const Tracing::TraceContextHandler& traceParentHeader() {
   CONSTRUCT_ON_FIRST_USE(Tracing::TraceContextHandler, "traceparent");
 }
@@ -111,15 +152,11 @@ void Span::setAttribute(absl::string_view name, const OTelAttribute& attribute_v
       return;
     }
   }
-  // If we haven't found an existing match already, we can add a new key/value.
-  opentelemetry::proto::common::v1::KeyValue key_value =
-      opentelemetry::proto::common::v1::KeyValue();
-  opentelemetry::proto::common::v1::AnyValue value_proto =
-      opentelemetry::proto::common::v1::AnyValue();
-  OtlpUtils::populateAnyValue(value_proto, attribute_value);
-  key_value.set_key(std::string{name});
-  *key_value.mutable_value() = value_proto;
-  *span_.add_attributes() = key_value;
+  // If we haven't found an existing match already, we can add a new key/value, which is populated
+  // in place.
+  opentelemetry::proto::common::v1::KeyValue* key_value = span_.add_attributes();
+  key_value->set_key(std::string{name});
+  OtlpUtils::populateAnyValue(*key_value->mutable_value(), attribute_value);
 }
 
 void Span::setTag(absl::string_view name, absl::string_view value) {
@@ -147,7 +184,8 @@ Tracer::Tracer(OpenTelemetryTraceExporterPtr exporter, Envoy::TimeSource& time_s
                Event::Dispatcher& dispatcher, OpenTelemetryTracerStats tracing_stats,
                const ResourceConstSharedPtr resource, SamplerSharedPtr sampler)
     : exporter_(std::move(exporter)), time_source_(time_source), random_(random), runtime_(runtime),
-      tracing_stats_(tracing_stats), resource_(resource), sampler_(sampler) {
+      tracing_stats_(tracing_stats), resource_(resource),
+      encoded_resource_(encodeResource(*resource)), sampler_(sampler) {
   flush_timer_ = dispatcher.createTimer([this]() -> void {
     tracing_stats_.timer_flushed_.inc();
     flushSpans();
@@ -163,44 +201,39 @@ void Tracer::enableTimer() {
 }
 
 void Tracer::flushSpans() {
-  ExportTraceServiceRequest request;
-  // A request consists of ResourceSpans.
-  ::opentelemetry::proto::trace::v1::ResourceSpans* resource_span = request.add_resource_spans();
-  resource_span->set_schema_url(resource_->schema_url_);
-
-  // add resource attributes
-  for (auto const& att : resource_->attributes_) {
-    opentelemetry::proto::common::v1::KeyValue key_value =
-        opentelemetry::proto::common::v1::KeyValue();
-    opentelemetry::proto::common::v1::AnyValue value_proto =
-        opentelemetry::proto::common::v1::AnyValue();
-    value_proto.set_string_value(std::string{att.second});
-    key_value.set_key(std::string{att.first});
-    *key_value.mutable_value() = value_proto;
-    (*resource_span->mutable_resource()->add_attributes()) = key_value;
-  }
+  // A request consists of a single ResourceSpans, holding a single ScopeSpans with the spans.
+  Buffer::OwnedImpl resource_span;
+  resource_span.add(encoded_resource_);
+  appendLengthDelimitedTag(resource_span,
+                           ::opentelemetry::proto::trace::v1::ResourceSpans::kScopeSpansFieldNumber,
+                           span_buffer_.length());
+  resource_span.move(span_buffer_);
+  Buffer::OwnedImpl request;
+  appendLengthDelimitedTag(request, ExportTraceServiceRequest::kResourceSpansFieldNumber,
+                           resource_span.length());
+  request.move(resource_span);
 
-  ::opentelemetry::proto::trace::v1::ScopeSpans* scope_span = resource_span->add_scope_spans();
-  for (const auto& pending_span : span_buffer_) {
-    (*scope_span->add_spans()) = pending_span;
-  }
   if (exporter_) {
-    tracing_stats_.spans_sent_.add(span_buffer_.size());
-    if (!exporter_->log(request)) {
-      // TODO: should there be any sort of retry or reporting here?
+    if (exporter_->log(request)) {
+      tracing_stats_.spans_sent_.add(span_buffer_count_);
+    } else {
+      // The spans are dropped rather than buffered while the collector can't keep up.
+      tracing_stats_.spans_dropped_.add(span_buffer_count_);
       ENVOY_LOG(trace, "Unsuccessful log request to OpenTelemetry trace collector.");
     }
   } else {
     ENVOY_LOG(info, "Skipping log request to OpenTelemetry: no exporter configured");
   }
-  span_buffer_.clear();
+  span_buffer_count_ = 0;
 }
 
-void Tracer::sendSpan(::opentelemetry::proto::trace::v1::Span& span) {
-  span_buffer_.push_back(span);
+void Tracer::sendSpan(const ::opentelemetry::proto::trace::v1::Span& span) {
+  appendMessageField(span_buffer_, ::opentelemetry::proto::trace::v1::ScopeSpans::kSpansFieldNumber,
+                     span);
+  ++span_buffer_count_;
   const uint64_t min_flush_spans =
       runtime_.snapshot().getInteger("tracing.opentelemetry.min_flush_spans", 5U);
-  if (span_buffer_.size() >= min_flush_spans) {
+  if (span_buffer_count_ >= min_flush_spans) {
     flushSpans();
   }
 }
@@ -9,6 +9,7 @@
 #include "envoy/thread_local/thread_local.h"
 #include "envoy/tracing/trace_driver.h"
 
+#include "source/common/buffer/buffer_impl.h"
 #include "source/common/common/logger.h"
 #include "source/extensions/tracers/common/factory_base.h"
 #include "source/extensions/tracers/opentelemetry/grpc_trace_exporter.h"
@@ -24,6 +25,7 @@ namespace Tracers {
 namespace OpenTelemetry {
 
 #define OPENTELEMETRY_TRACER_STATS(COUNTER)                                                        \
+  COUNTER(spans_dropped)                                                                           \
   COUNTER(spans_sent)                                                                              \
   COUNTER(timer_flushed)
 
@@ -41,7 +43,10 @@ public:
          OpenTelemetryTracerStats tracing_stats, const ResourceConstSharedPtr resource,
          SamplerSharedPtr sampler);
 
-  void sendSpan(::opentelemetry::proto::trace::v1::Span& span);
+  /**
+   * Serializes the finished span into the span buffer, which is flushed once it holds enough spans.
+   */
+  void sendSpan(const ::opentelemetry::proto::trace::v1::Span& span);
 
   Tracing::SpanPtr startSpan(const std::string& operation_name, SystemTime start_time,
 
@@ -67,11 +72,16 @@ private:
   OpenTelemetryTraceExporterPtr exporter_;
   Envoy::TimeSource& time_source_;
   Random::RandomGenerator& random_;
-  std::vector<::opentelemetry::proto::trace::v1::Span> span_buffer_;
+  // The serialized spans field of the ScopeSpans of the next export request, so that exporting is
+  // only encoding the few enclosing fields around it.
+  Buffer::OwnedImpl span_buffer_;
+  uint64_t span_buffer_count_{};
   Runtime::Loader& runtime_;
   Event::TimerPtr flush_timer_;
   OpenTelemetryTracerStats tracing_stats_;
   const ResourceConstSharedPtr resource_;
+  // The fields of the ResourceSpans other than its ScopeSpans, encoded once.
+  const std::string encoded_resource_;
   SamplerSharedPtr sampler_;
 };
 
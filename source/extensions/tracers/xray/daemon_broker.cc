@@ -3,6 +3,7 @@
 #include "envoy/network/address.h"
 
 #include "source/common/buffer/buffer_impl.h"
+#include "source/common/common/macros.h"
 #include "source/common/network/socket_interface.h"
 #include "source/common/network/utility.h"
 #include "source/common/protobuf/utility.h"
@@ -14,15 +15,22 @@ namespace Tracers {
 namespace XRay {
 
 namespace {
-// creates a header JSON for X-Ray daemon.
+// creates a header JSON for X-Ray daemon, followed by the newline separating it from the segment.
 // For example:
 // { "format": "json", "version": 1}
 std::string createHeader(const std::string& format, uint32_t version) {
   source::extensions::tracers::xray::daemon::Header header;
   header.set_format(format);
   header.set_version(version);
-  return MessageUtil::getJsonStringFromMessageOrError(header, false /* pretty_print  */,
-                                                      false /* always_print_primitive_fields */);
+  return absl::StrCat(
+      MessageUtil::getJsonStringFromMessageOrError(header, false /* pretty_print  */,
+                                                   false /* always_print_primitive_fields */),
+      "\n");
+}
+
+// The header of every datagram, as the daemon only accepts the json format version 1.
+const std::string& daemonHeader() {
+  CONSTRUCT_ON_FIRST_USE(std::string, createHeader("json", 1));
 }
 
 } // namespace
@@ -38,16 +46,15 @@ DaemonBrokerImpl::DaemonBrokerImpl(const std::string& daemon_endpoint)
 
 void DaemonBrokerImpl::send(const std::string& data) const {
   auto& logger = Logger::Registry::getLog(Logger::Id::tracing);
-  constexpr auto version = 1;
-  constexpr auto format = "json";
-  const std::string payload = absl::StrCat(createHeader(format, version), "\n", data);
-  Buffer::RawSlice buf;
-  buf.mem_ = const_cast<char*>(payload.data());
-  buf.len_ = payload.length();
-  const auto rc = Network::Utility::writeToSocket(*io_handle_, &buf, 1 /*num_slices*/,
+  // The header and the segment are gathered into the datagram by the kernel, without copying them
+  // into a payload first.
+  const std::string& header = daemonHeader();
+  Buffer::RawSlice slices[] = {{const_cast<char*>(header.data()), header.length()},
+                               {const_cast<char*>(data.data()), data.length()}};
+  const auto rc = Network::Utility::writeToSocket(*io_handle_, slices, 2 /*num_slices*/,
                                                   nullptr /*local_ip*/, *address_);
 
-  if (rc.return_value_ != payload.length()) {
+  if (rc.return_value_ != header.length() + data.length()) {
     // TODO(suniltheta): report this in stats
     ENVOY_LOG_TO_LOGGER(logger, debug, "Failed to send trace payload to the X-Ray daemon.");
   }
@@ -2,6 +2,7 @@
 
 #include "envoy/config/trace/v3/zipkin.pb.h"
 
+#include "source/common/json/json_streamer.h"
 #include "source/common/protobuf/protobuf.h"
 #include "source/extensions/tracers/zipkin/tracer_interface.h"
 #include "source/extensions/tracers/zipkin/zipkin_core_types.h"
@@ -94,7 +95,8 @@ using SpanBufferPtr = std::unique_ptr<SpanBuffer>;
 
 /**
  * JsonV2Serializer implements Zipkin::Serializer that serializes list of Zipkin spans into JSON
- * Zipkin v2 array.
+ * Zipkin v2 array. The spans are streamed straight into the output, without building intermediate
+ * JSON structures.
  */
 class JsonV2Serializer : public Serializer {
 public:
@@ -107,9 +109,8 @@ public:
   std::string serialize(const std::vector<Span>& pending_spans) override;
 
 private:
-  const std::vector<ProtobufWkt::Struct> toListOfSpans(const Span& zipkin_span,
-                                                       Util::Replacements& replacements) const;
-  const ProtobufWkt::Struct toProtoEndpoint(const Endpoint& zipkin_endpoint) const;
+  void addSpans(const Span& zipkin_span, Json::Streamer::Array& spans) const;
+  static void addEndpoint(const Endpoint& zipkin_endpoint, Json::Streamer::Map& span);
 
   const bool shared_span_context_;
 };
@@ -129,8 +130,8 @@ public:
   std::string serialize(const std::vector<Span>& pending_spans) override;
 
 private:
-  const zipkin::proto3::ListOfSpans toListOfSpans(const Span& zipkin_span) const;
-  const zipkin::proto3::Endpoint toProtoEndpoint(const Endpoint& zipkin_endpoint) const;
+  void addSpans(const Span& zipkin_span, zipkin::proto3::ListOfSpans& spans) const;
+  static void setEndpoint(const Endpoint& zipkin_endpoint, zipkin::proto3::Endpoint& endpoint);
 
   const bool shared_span_context_;
 };
@@ -37,8 +37,9 @@ Network::IoResult TapSocket::doRead(Buffer::Instance& buffer) {
 }
 
 Network::IoResult TapSocket::doWrite(Buffer::Instance& buffer, bool end_stream) {
-  // TODO(htuch): avoid copy.
-  Buffer::OwnedImpl copy(buffer);
+  // The tapped copy shares the memory of the buffer, as the written bytes are drained from it.
+  Buffer::OwnedImpl copy;
+  copy.addShared(buffer);
   Network::IoResult result = transport_socket_->doWrite(buffer, end_stream);
   if (tapper_ != nullptr && result.bytes_processed_ > 0) {
     tapper_->onWrite(copy, result.bytes_processed_, end_stream);
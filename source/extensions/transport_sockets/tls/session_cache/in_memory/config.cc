@@ -0,0 +1,32 @@
+#include "source/extensions/transport_sockets/tls/session_cache/in_memory/config.h"
+
+#include "envoy/server/factory_context.h"
+
+#include "source/common/protobuf/utility.h"
+#include "source/extensions/transport_sockets/tls/session_cache/in_memory/in_memory_session_cache.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace TransportSockets {
+namespace Tls {
+namespace SessionCache {
+
+Ssl::SessionCacheSharedPtr InMemorySessionCacheFactory::createSessionCache(
+    const Protobuf::Message& config, ProtobufMessage::ValidationVisitor& validation_visitor,
+    Server::Configuration::ServerFactoryContext& context) {
+  const auto& typed_config = MessageUtil::downcastAndValidate<
+      const envoy::extensions::transport_sockets::tls::session_cache::in_memory::v3::
+          InMemorySessionCacheConfig&>(config, validation_visitor);
+  return std::make_shared<InMemorySessionCache>(
+      PROTOBUF_GET_WRAPPED_OR_DEFAULT(typed_config, max_sessions,
+                                      InMemorySessionCache::DefaultMaxSessions),
+      context.timeSource());
+}
+
+REGISTER_FACTORY(InMemorySessionCacheFactory, Ssl::SessionCacheFactory);
+
+} // namespace SessionCache
+} // namespace Tls
+} // namespace TransportSockets
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,34 @@
+#pragma once
+
+#include "envoy/extensions/transport_sockets/tls/session_cache/in_memory/v3/in_memory.pb.h"
+#include "envoy/extensions/transport_sockets/tls/session_cache/in_memory/v3/in_memory.pb.validate.h"
+#include "envoy/registry/registry.h"
+#include "envoy/ssl/session_cache/session_cache.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace TransportSockets {
+namespace Tls {
+namespace SessionCache {
+
+class InMemorySessionCacheFactory : public Ssl::SessionCacheFactory {
+public:
+  // Ssl::SessionCacheFactory
+  Ssl::SessionCacheSharedPtr
+  createSessionCache(const Protobuf::Message& config,
+                     ProtobufMessage::ValidationVisitor& validation_visitor,
+                     Server::Configuration::ServerFactoryContext& context) override;
+  ProtobufTypes::MessagePtr createEmptyConfigProto() override {
+    return std::make_unique<envoy::extensions::transport_sockets::tls::session_cache::in_memory::
+                                v3::InMemorySessionCacheConfig>();
+  }
+  std::string name() const override { return "envoy.tls.session_cache.in_memory"; }
+};
+
+DECLARE_FACTORY(InMemorySessionCacheFactory);
+
+} // namespace SessionCache
+} // namespace Tls
+} // namespace TransportSockets
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,64 @@
+#include "source/extensions/transport_sockets/tls/session_cache/in_memory/in_memory_session_cache.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace TransportSockets {
+namespace Tls {
+namespace SessionCache {
+
+void InMemorySessionCache::insert(absl::string_view key, absl::string_view session,
+                                  std::chrono::seconds timeout) {
+  const MonotonicTime expiry = time_source_.monotonicTime() + timeout;
+  absl::MutexLock lock(&mutex_);
+  auto it = index_.find(key);
+  if (it != index_.end()) {
+    it->second->session_ = std::string(session);
+    it->second->expiry_ = expiry;
+    entries_.splice(entries_.begin(), entries_, it->second);
+    return;
+  }
+  if (entries_.size() >= max_sessions_) {
+    removeEntry(std::prev(entries_.end()));
+  }
+  entries_.push_front(Entry{std::string(key), std::string(session), expiry});
+  index_.emplace(entries_.front().key_, entries_.begin());
+}
+
+absl::optional<std::string> InMemorySessionCache::lookup(absl::string_view key) {
+  const MonotonicTime now = time_source_.monotonicTime();
+  absl::MutexLock lock(&mutex_);
+  auto it = index_.find(key);
+  if (it == index_.end()) {
+    return absl::nullopt;
+  }
+  if (it->second->expiry_ <= now) {
+    removeEntry(it->second);
+    return absl::nullopt;
+  }
+  entries_.splice(entries_.begin(), entries_, it->second);
+  return it->second->session_;
+}
+
+void InMemorySessionCache::remove(absl::string_view key) {
+  absl::MutexLock lock(&mutex_);
+  auto it = index_.find(key);
+  if (it != index_.end()) {
+    removeEntry(it->second);
+  }
+}
+
+size_t InMemorySessionCache::size() const {
+  absl::MutexLock lock(&mutex_);
+  return entries_.size();
+}
+
+void InMemorySessionCache::removeEntry(EntryList::iterator entry) {
+  index_.erase(entry->key_);
+  entries_.erase(entry);
+}
+
+} // namespace SessionCache
+} // namespace Tls
+} // namespace TransportSockets
+} // namespace Extensions
+} // namespace Envoy
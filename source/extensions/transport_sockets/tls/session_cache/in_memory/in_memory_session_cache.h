@@ -0,0 +1,61 @@
+#pragma once
+
+#include <chrono>
+#include <list>
+#include <string>
+
+#include "envoy/common/time.h"
+#include "envoy/ssl/session_cache/session_cache.h"
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/synchronization/mutex.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace TransportSockets {
+namespace Tls {
+namespace SessionCache {
+
+/**
+ * A session cache in memory, shared by the workers. The least recently used sessions are evicted
+ * once it holds max_sessions, and the expired ones when looked up.
+ */
+class InMemorySessionCache : public Ssl::SessionCache {
+public:
+  // The size of the cache of each SSL_CTX in BoringSSL.
+  static constexpr uint32_t DefaultMaxSessions = 20480;
+
+  InMemorySessionCache(uint32_t max_sessions, TimeSource& time_source)
+      : max_sessions_(max_sessions), time_source_(time_source) {}
+
+  // Ssl::SessionCache
+  void insert(absl::string_view key, absl::string_view session,
+              std::chrono::seconds timeout) override;
+  absl::optional<std::string> lookup(absl::string_view key) override;
+  void remove(absl::string_view key) override;
+
+  size_t size() const;
+
+private:
+  struct Entry {
+    const std::string key_;
+    std::string session_;
+    MonotonicTime expiry_;
+  };
+  using EntryList = std::list<Entry>;
+
+  void removeEntry(EntryList::iterator entry) ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+
+  const uint32_t max_sessions_;
+  TimeSource& time_source_;
+  mutable absl::Mutex mutex_;
+  // The entries from the most to the least recently used, indexed by their key.
+  EntryList entries_ ABSL_GUARDED_BY(mutex_);
+  absl::flat_hash_map<absl::string_view, EntryList::iterator> index_ ABSL_GUARDED_BY(mutex_);
+};
+
+} // namespace SessionCache
+} // namespace Tls
+} // namespace TransportSockets
+} // namespace Extensions
+} // namespace Envoy
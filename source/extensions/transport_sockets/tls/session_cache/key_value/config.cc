@@ -0,0 +1,41 @@
+#include "source/extensions/transport_sockets/tls/session_cache/key_value/config.h"
+
+#include "envoy/common/key_value_store.h"
+#include "envoy/server/factory_context.h"
+
+#include "source/common/config/utility.h"
+#include "source/common/protobuf/utility.h"
+#include "source/extensions/transport_sockets/tls/session_cache/in_memory/in_memory_session_cache.h"
+#include "source/extensions/transport_sockets/tls/session_cache/key_value/key_value_session_cache.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace TransportSockets {
+namespace Tls {
+namespace SessionCache {
+
+Ssl::SessionCacheSharedPtr KeyValueSessionCacheFactory::createSessionCache(
+    const Protobuf::Message& config, ProtobufMessage::ValidationVisitor& validation_visitor,
+    Server::Configuration::ServerFactoryContext& context) {
+  const auto& typed_config = MessageUtil::downcastAndValidate<
+      const envoy::extensions::transport_sockets::tls::session_cache::key_value::v3::
+          KeyValueSessionCacheConfig&>(config, validation_visitor);
+  auto& factory = Config::Utility::getAndCheckFactory<KeyValueStoreFactory>(
+      typed_config.key_value_config().config());
+  KeyValueStorePtr store =
+      factory.createStore(typed_config.key_value_config(), validation_visitor,
+                          context.mainThreadDispatcher(), context.api().fileSystem());
+  return std::make_shared<KeyValueSessionCache>(
+      std::move(store),
+      PROTOBUF_GET_WRAPPED_OR_DEFAULT(typed_config, max_sessions,
+                                      InMemorySessionCache::DefaultMaxSessions),
+      context.mainThreadDispatcher(), context.timeSource());
+}
+
+REGISTER_FACTORY(KeyValueSessionCacheFactory, Ssl::SessionCacheFactory);
+
+} // namespace SessionCache
+} // namespace Tls
+} // namespace TransportSockets
+} // namespace Extensions
+} // namespace Envoy
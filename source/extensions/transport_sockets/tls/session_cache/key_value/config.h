@@ -0,0 +1,34 @@
+#pragma once
+
+#include "envoy/extensions/transport_sockets/tls/session_cache/key_value/v3/key_value.pb.h"
+#include "envoy/extensions/transport_sockets/tls/session_cache/key_value/v3/key_value.pb.validate.h"
+#include "envoy/registry/registry.h"
+#include "envoy/ssl/session_cache/session_cache.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace TransportSockets {
+namespace Tls {
+namespace SessionCache {
+
+class KeyValueSessionCacheFactory : public Ssl::SessionCacheFactory {
+public:
+  // Ssl::SessionCacheFactory
+  Ssl::SessionCacheSharedPtr
+  createSessionCache(const Protobuf::Message& config,
+                     ProtobufMessage::ValidationVisitor& validation_visitor,
+                     Server::Configuration::ServerFactoryContext& context) override;
+  ProtobufTypes::MessagePtr createEmptyConfigProto() override {
+    return std::make_unique<envoy::extensions::transport_sockets::tls::session_cache::key_value::
+                                v3::KeyValueSessionCacheConfig>();
+  }
+  std::string name() const override { return "envoy.tls.session_cache.key_value"; }
+};
+
+DECLARE_FACTORY(KeyValueSessionCacheFactory);
+
+} // namespace SessionCache
+} // namespace Tls
+} // namespace TransportSockets
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,87 @@
+#include "source/extensions/transport_sockets/tls/session_cache/key_value/key_value_session_cache.h"
+
+#include "source/common/common/base64.h"
+#include "source/common/common/hex.h"
+
+#include "absl/strings/numbers.h"
+#include "absl/strings/str_cat.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace TransportSockets {
+namespace Tls {
+namespace SessionCache {
+
+KeyValueSessionCache::KeyValueSessionCache(KeyValueStorePtr store, uint32_t max_sessions,
+                                           Event::Dispatcher& main_thread_dispatcher,
+                                           TimeSource& time_source)
+    : memory_(max_sessions, time_source), store_(std::move(store)),
+      main_thread_dispatcher_(main_thread_dispatcher), time_source_(time_source) {
+  load();
+}
+
+KeyValueSessionCache::~KeyValueSessionCache() {
+  // The last context using the cache may be destroyed on a worker.
+  if (!main_thread_dispatcher_.isThreadSafe()) {
+    main_thread_dispatcher_.post([store = std::move(store_)]() mutable { store.reset(); });
+  }
+}
+
+void KeyValueSessionCache::load() {
+  const uint64_t now = std::chrono::duration_cast<std::chrono::seconds>(
+                           time_source_.systemTime().time_since_epoch())
+                           .count();
+  store_->iterate([this, now](const std::string& key, const std::string& value) {
+    const std::vector<uint8_t> decoded_key = Hex::decode(key);
+    const size_t separator = value.find(':');
+    uint64_t expiry;
+    if (decoded_key.empty() || separator == std::string::npos ||
+        !absl::SimpleAtoi(absl::string_view(value).substr(0, separator), &expiry)) {
+      return KeyValueStore::Iterate::Continue;
+    }
+    const std::string session = Base64::decode(absl::string_view(value).substr(separator + 1));
+    if (expiry > now && !session.empty()) {
+      memory_.insert(
+          absl::string_view(reinterpret_cast<const char*>(decoded_key.data()), decoded_key.size()),
+          session, std::chrono::seconds(expiry - now));
+    }
+    return KeyValueStore::Iterate::Continue;
+  });
+}
+
+void KeyValueSessionCache::insert(absl::string_view key, absl::string_view session,
+                                  std::chrono::seconds timeout) {
+  memory_.insert(key, session, timeout);
+  if (timeout.count() <= 0) {
+    return;
+  }
+  const auto expiry = std::chrono::duration_cast<std::chrono::seconds>(
+                          time_source_.systemTime().time_since_epoch()) +
+                      timeout;
+  main_thread_dispatcher_.post(
+      [store = std::weak_ptr<KeyValueStore>(store_),
+       key = Hex::encode(reinterpret_cast<const uint8_t*>(key.data()), key.size()),
+       value = absl::StrCat(expiry.count(), ":", Base64::encode(session.data(), session.size())),
+       timeout]() {
+        if (auto locked = store.lock()) {
+          locked->addOrUpdate(key, value, timeout);
+        }
+      });
+}
+
+void KeyValueSessionCache::remove(absl::string_view key) {
+  memory_.remove(key);
+  main_thread_dispatcher_.post(
+      [store = std::weak_ptr<KeyValueStore>(store_),
+       key = Hex::encode(reinterpret_cast<const uint8_t*>(key.data()), key.size())]() {
+        if (auto locked = store.lock()) {
+          locked->remove(key);
+        }
+      });
+}
+
+} // namespace SessionCache
+} // namespace Tls
+} // namespace TransportSockets
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <chrono>
+#include <memory>
+#include <string>
+
+#include "envoy/common/key_value_store.h"
+#include "envoy/common/time.h"
+#include "envoy/event/dispatcher.h"
+#include "envoy/ssl/session_cache/session_cache.h"
+
+#include "source/extensions/transport_sockets/tls/session_cache/in_memory/in_memory_session_cache.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace TransportSockets {
+namespace Tls {
+namespace SessionCache {
+
+/**
+ * A session cache in memory, written through to a key value store from which it's loaded when
+ * created. The store is only used on the main thread, so the sessions are written to it
+ * asynchronously, and the lookups are served from memory.
+ *
+ * The keys are hex encoded in the store, and the values are the expiry of the sessions in seconds
+ * since the epoch followed by a colon and the base64 encoded sessions.
+ */
+class KeyValueSessionCache : public Ssl::SessionCache {
+public:
+  KeyValueSessionCache(KeyValueStorePtr store, uint32_t max_sessions,
+                       Event::Dispatcher& main_thread_dispatcher, TimeSource& time_source);
+  ~KeyValueSessionCache() override;
+
+  // Ssl::SessionCache
+  void insert(absl::string_view key, absl::string_view session,
+              std::chrono::seconds timeout) override;
+  absl::optional<std::string> lookup(absl::string_view key) override {
+    return memory_.lookup(key);
+  }
+  void remove(absl::string_view key) override;
+
+  size_t size() const { return memory_.size(); }
+
+private:
+  void load();
+
+  InMemorySessionCache memory_;
+  // Shared with the posted writes, which may run after the cache was destroyed.
+  std::shared_ptr<KeyValueStore> store_;
+  Event::Dispatcher& main_thread_dispatcher_;
+  TimeSource& time_source_;
+};
+
+} // namespace SessionCache
+} // namespace Tls
+} // namespace TransportSockets
+} // namespace Extensions
+} // namespace Envoy
@@ -16,10 +16,15 @@ namespace Quic {
 class UdpGsoBatchWriterFactoryFactory : public Network::UdpPacketWriterFactoryFactory {
 public:
   std::string name() const override { return "envoy.udp_packet_writer.gso"; }
-  Network::UdpPacketWriterFactoryPtr
-  createUdpPacketWriterFactory(const envoy::config::core::v3::TypedExtensionConfig&) override {
+  Network::UdpPacketWriterFactoryPtr createUdpPacketWriterFactory(
+      const envoy::config::core::v3::TypedExtensionConfig& config) override {
 #ifdef ENVOY_ENABLE_QUIC
-    return std::make_unique<UdpGsoBatchWriterFactory>();
+    envoy::extensions::udp_packet_writer::v3::UdpGsoBatchWriterFactory proto_config;
+    if (config.has_typed_config()) {
+      MessageUtil::anyConvert(config.typed_config(), proto_config);
+    }
+    return std::make_unique<UdpGsoBatchWriterFactory>(proto_config.batch_across_connections(),
+                                                      proto_config.pacing_offload());
 #else
     return {};
 #endif
@@ -1,8 +1,18 @@
+#include <cstring>
+
 #include "envoy/registry/registry.h"
 
 #include "source/extensions/common/wasm/wasm_runtime_factory.h"
 
 #include "include/proxy-wasm/v8.h"
+#include "wasm-api/wasm.hh"
+
+namespace proxy_wasm {
+namespace v8 {
+// The engine shared by the V8 VMs, defined with them.
+wasm::Engine* engine();
+} // namespace v8
+} // namespace proxy_wasm
 
 namespace Envoy {
 namespace Extensions {
@@ -13,6 +23,22 @@ class V8RuntimeFactory : public WasmRuntimeFactory {
 public:
   WasmVmPtr createWasmVm() override { return proxy_wasm::createV8Vm(); }
 
+  std::string precompile(absl::string_view bytecode) override {
+    auto store = wasm::Store::make(proxy_wasm::v8::engine());
+    auto vec = wasm::vec<byte_t>::make_uninitialized(bytecode.size());
+    ::memcpy(vec.get(), bytecode.data(), bytecode.size());
+    auto module = wasm::Module::make(store.get(), vec);
+    if (module == nullptr) {
+      return "";
+    }
+    // The module can't be serialized until all its functions are compiled by the optimizing tier.
+    const auto serialized = module->serialize();
+    if (!serialized) {
+      return "";
+    }
+    return {serialized.get(), serialized.size()};
+  }
+
   std::string name() const override { return "envoy.wasm.runtime.v8"; }
 };
 
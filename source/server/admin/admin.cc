@@ -151,6 +151,15 @@ AdminImpl::AdminImpl(const std::string& profile_path, Server::Instance& server,
                         "all listeners with /init_dump?mask=listener`"}}),
           makeHandler("/contention", "dump current Envoy mutex contention stats (if enabled)",
                       MAKE_ADMIN_HANDLER(stats_handler_.handlerContention), false, false),
+          makeHandler("/continuousprofiler", "enable/disable the continuous CPU profiler",
+                      MAKE_ADMIN_HANDLER(profiling_handler_.handlerContinuousProfiler), false,
+                      true,
+                      {{Admin::ParamDescriptor::Type::Enum,
+                        "enable",
+                        "enables the continuous CPU profiler",
+                        {"y", "n"}},
+                       {Admin::ParamDescriptor::Type::String, "frequency",
+                        "the number of samples per second of CPU time, 19 by default"}}),
           makeHandler("/cpuprofiler", "enable/disable the CPU profiler",
                       MAKE_ADMIN_HANDLER(profiling_handler_.handlerCpuProfiler), false, true,
                       {{Admin::ParamDescriptor::Type::Enum,
@@ -193,6 +202,9 @@ AdminImpl::AdminImpl(const std::string& profile_path, Server::Instance& server,
                         prepend("", LogsHandler::levelStrings())}}),
           makeHandler("/memory", "print current allocation/heap usage",
                       MAKE_ADMIN_HANDLER(server_info_handler_.handlerMemory), false, false),
+          makeHandler("/profile/continuous", "dump the samples of the continuous CPU profiler",
+                      MAKE_ADMIN_HANDLER(profiling_handler_.handlerContinuousProfile), false,
+                      false),
           makeHandler("/quitquitquit", "exit the server",
                       MAKE_ADMIN_HANDLER(server_cmd_handler_.handlerQuitQuitQuit), false, true),
           makeHandler("/reset_counters", "reset all counters to zero",
@@ -216,19 +228,7 @@ AdminImpl::AdminImpl(const std::string& profile_path, Server::Instance& server,
           makeHandler("/ready", "print server state, return 200 if LIVE, otherwise return 503",
                       MAKE_ADMIN_HANDLER(server_info_handler_.handlerReady), false, false),
           stats_handler_.statsHandler(false /* not active mode */),
-          makeHandler("/stats/prometheus", "print server stats in prometheus format",
-                      MAKE_ADMIN_HANDLER(stats_handler_.handlerPrometheusStats), false, false,
-                      {{ParamDescriptor::Type::Boolean, "usedonly",
-                        "Only include stats that have been written by system since restart"},
-                       {ParamDescriptor::Type::Boolean, "text_readouts",
-                        "Render text_readouts as new gaugues with value 0 (increases Prometheus "
-                        "data size)"},
-                       {ParamDescriptor::Type::String, "filter",
-                        "Regular expression (Google re2) for filtering stats"},
-                       {ParamDescriptor::Type::Enum,
-                        "histogram_buckets",
-                        "Histogram bucket display mode",
-                        {"cumulative", "summary"}}}),
+          stats_handler_.prometheusHandler(),
           makeHandler("/stats/recentlookups", "Show recent stat-name lookups",
                       MAKE_ADMIN_HANDLER(stats_handler_.handlerStatsRecentLookups), false, false),
           makeHandler("/stats/recentlookups/clear", "clear list of stat-name lookups and counter",
@@ -404,6 +404,7 @@ private:
     }
     Init::Manager& initManager() override { return *init_manager_; }
     bool ignoreGlobalConnLimit() const override { return ignore_global_conn_limit_; }
+    bool coalesceWrites() const override { return true; }
     bool shouldBypassOverloadManager() const override { return true; }
 
     AdminImpl& parent_;
@@ -1,8 +1,11 @@
 #include "source/server/admin/profiling_handler.h"
 
 #include "source/common/profiler/profiler.h"
+#include "source/common/profiler/sampling_profiler.h"
 #include "source/server/admin/utils.h"
 
+#include "absl/strings/numbers.h"
+
 namespace Envoy {
 namespace Server {
 
@@ -21,6 +24,10 @@ Http::Code ProfilingHandler::handlerCpuProfiler(Http::ResponseHeaderMap&,
 
   bool enable = enableVal.value() == "y";
   if (enable && !Profiler::Cpu::profilerEnabled()) {
+    if (Profiler::SamplingProfiler::started()) {
+      response.add("failure to start the profiler: the continuous profiler is started");
+      return Http::Code::BadRequest;
+    }
     if (!Profiler::Cpu::startProfiler(profile_path_)) {
       response.add("failure to start the profiler");
       return Http::Code::InternalServerError;
@@ -80,6 +87,47 @@ Http::Code ProfilingHandler::handlerHeapProfiler(Http::ResponseHeaderMap&,
   return res;
 }
 
+Http::Code ProfilingHandler::handlerContinuousProfiler(Http::ResponseHeaderMap&,
+                                                       Buffer::Instance& response,
+                                                       AdminStream& admin_stream) {
+  Http::Utility::QueryParamsMulti query_params = admin_stream.queryParams();
+  const auto enableVal = query_params.getFirstValue("enable");
+  const auto frequencyVal = query_params.getFirstValue("frequency");
+  uint32_t frequency = DefaultContinuousProfilerFrequency;
+  if (!enableVal.has_value() || (enableVal.value() != "y" && enableVal.value() != "n") ||
+      query_params.data().size() != (frequencyVal.has_value() ? 2 : 1) ||
+      (frequencyVal.has_value() &&
+       (!absl::SimpleAtoi(frequencyVal.value(), &frequency) || frequency == 0))) {
+    response.add("?enable=<y|n>&frequency=<samples per second>\n");
+    return Http::Code::BadRequest;
+  }
+
+  bool enable = enableVal.value() == "y";
+  if (enable && !Profiler::SamplingProfiler::started()) {
+    if (!Profiler::SamplingProfiler::start(frequency)) {
+      response.add("failure to start the continuous profiler");
+      return Http::Code::InternalServerError;
+    }
+  } else if (!enable) {
+    Profiler::SamplingProfiler::stop();
+  }
+
+  response.add("OK\n");
+  return Http::Code::OK;
+}
+
+Http::Code ProfilingHandler::handlerContinuousProfile(Http::ResponseHeaderMap&,
+                                                      Buffer::Instance& response, AdminStream&) {
+  auto profile = Profiler::SamplingProfiler::profile();
+  if (!profile.ok()) {
+    response.add(profile.status().message());
+    return Http::Code::BadRequest;
+  }
+
+  response.add(profile.value());
+  return Http::Code::OK;
+}
+
 Http::Code TcmallocProfilingHandler::handlerHeapDump(Http::ResponseHeaderMap&,
                                                      Buffer::Instance& response, AdminStream&) {
   auto dump_result = Profiler::TcmallocProfiler::tcmallocHeapProfile();
@@ -21,6 +21,15 @@ public:
   Http::Code handlerHeapProfiler(Http::ResponseHeaderMap& response_headers,
                                  Buffer::Instance& response, AdminStream&);
 
+  Http::Code handlerContinuousProfiler(Http::ResponseHeaderMap& response_headers,
+                                       Buffer::Instance& response, AdminStream&);
+
+  Http::Code handlerContinuousProfile(Http::ResponseHeaderMap& response_headers,
+                                      Buffer::Instance& response, AdminStream&);
+
+  // The default number of samples per second of CPU time of the continuous profiler.
+  static constexpr uint32_t DefaultContinuousProfilerFrequency = 19;
+
 private:
   const std::string profile_path_;
 };
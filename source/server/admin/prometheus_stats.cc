@@ -1,6 +1,8 @@
 #include "source/server/admin/prometheus_stats.h"
 
+#include <algorithm>
 #include <cmath>
+#include <limits>
 
 #include "source/common/common/empty_string.h"
 #include "source/common/common/macros.h"
@@ -8,6 +10,7 @@
 #include "source/common/stats/histogram_impl.h"
 #include "source/common/upstream/host_utility.h"
 
+#include "absl/strings/ascii.h"
 #include "absl/strings/str_cat.h"
 #include "absl/strings/str_replace.h"
 
@@ -27,6 +30,11 @@ std::string sanitizeName(const absl::string_view name) {
   // The name must match the regex [a-zA-Z_][a-zA-Z0-9_]* as required by
   // prometheus. Refer to https://prometheus.io/docs/concepts/data_model/.
   // The initial [a-zA-Z_] constraint is always satisfied by the namespace prefix.
+  // Most names are valid already, and are copied without running the regex.
+  if (std::all_of(name.begin(), name.end(),
+                  [](char c) { return absl::ascii_isalnum(c) || c == '_'; })) {
+    return std::string(name);
+  }
   return promRegex().replaceAll(name, "_");
 }
 
@@ -39,6 +47,9 @@ std::string sanitizeValue(const absl::string_view value) {
   // text serialization issues. This matches the prometheus text formatting code:
   // https://github.com/prometheus/common/blob/88f1636b699ae4fb949d292ffb904c205bf542c9/expfmt/text_create.go#L419-L420.
   // The goal is to replace '\' with "\\", newline with "\n", and '"' with "\"".
+  if (value.find_first_of("\\\n\"") == absl::string_view::npos) {
+    return std::string(value);
+  }
   return absl::StrReplaceAll(value, {
                                         {R"(\)", R"(\\)"},
                                         {"\n", R"(\n)"},
@@ -131,25 +142,17 @@ std::string generateHistogramOutput(const Stats::ParentHistogram& histogram,
 };
 
 /**
- * Processes a stat type (counter, gauge, histogram) by generating all output lines, sorting
- * them by tag-extracted metric name, and then outputting them in the correct sorted order into
- * response.
+ * Groups the metrics of a stat type (counter, gauge, histogram) by tag-extracted metric name.
  *
- * @param response The buffer to put the output into.
- * @param used_only Whether to only output stats that are used.
- * @param regex A filter on which stats to output.
- * @param metrics The metrics to output stats for. This must contain all stats of the given type
- *        to be included in the same output.
- * @param generate_output A function which returns the output text for this metric.
- * @param type The name of the prometheus metric type for used in TYPE annotations.
+ * @param params Whether to only output stats that are used, and a filter on which stats to
+ *        output.
+ * @param metrics The metrics to group. This must contain all stats of the given type to be
+ *        included in the same output.
+ * @return the groups, sorted by tag-extracted metric name, of metrics sorted by name.
  */
 template <class StatType>
-uint64_t outputStatType(
-    Buffer::Instance& response, const StatsParams& params,
-    const std::vector<Stats::RefcountPtr<StatType>>& metrics,
-    const std::function<std::string(
-        const StatType& metric, const std::string& prefixed_tag_extracted_name)>& generate_output,
-    absl::string_view type, const Stats::CustomStatNamespaces& custom_namespaces) {
+PrometheusStatsRequest::MetricGroups<StatType>
+groupMetrics(const StatsParams& params, const std::vector<Stats::RefcountPtr<StatType>>& metrics) {
 
   /*
    * From
@@ -170,7 +173,7 @@ uint64_t outputStatType(
 
   // Return early to avoid crashing when getting the symbol table from the first metric.
   if (metrics.empty()) {
-    return 0;
+    return {};
   }
 
   // There should only be one symbol table for all of the stats in the admin
@@ -192,22 +195,49 @@ uint64_t outputStatType(
     groups[metric->tagExtractedStatName()].push_back(metric.get());
   }
 
-  auto result = groups.size();
+  PrometheusStatsRequest::MetricGroups<StatType> sorted_groups;
+  sorted_groups.reserve(groups.size());
   for (auto& group : groups) {
+    // Sort before producing the final output to satisfy the "preferred" ordering from the
+    // prometheus spec: metrics will be sorted by their tags' textual representation, which will
+    // be consistent across calls.
+    std::sort(group.second.begin(), group.second.end(), MetricLessThan());
+    sorted_groups.emplace_back(group.first, std::move(group.second));
+  }
+  return sorted_groups;
+}
+
+/**
+ * Outputs the groups of a stat type into response, starting at next_group, until the response
+ * reaches max_length.
+ *
+ * @param response The buffer to put the output into.
+ * @param groups The groups of metrics returned by groupMetrics.
+ * @param next_group The index of the first group to output, updated past the groups output.
+ * @param max_length The response length after which no more groups are output.
+ * @param generate_output A function which returns the output text for this metric.
+ * @param type The name of the prometheus metric type for used in TYPE annotations.
+ * @return the number of metric names output.
+ */
+template <class StatType>
+uint64_t outputMetricGroups(
+    Buffer::Instance& response, const PrometheusStatsRequest::MetricGroups<StatType>& groups,
+    size_t& next_group, uint64_t max_length,
+    const std::function<std::string(
+        const StatType& metric, const std::string& prefixed_tag_extracted_name)>& generate_output,
+    absl::string_view type, const Stats::CustomStatNamespaces& custom_namespaces) {
+  uint64_t result = 0;
+  for (; next_group < groups.size() && response.length() < max_length; ++next_group) {
+    const auto& group = groups[next_group];
+    const Stats::SymbolTable& symbol_table = group.second.front()->constSymbolTable();
     const absl::optional<std::string> prefixed_tag_extracted_name =
-        PrometheusStatsFormatter::metricName(global_symbol_table.toString(group.first),
+        PrometheusStatsFormatter::metricName(symbol_table.toString(group.first),
                                              custom_namespaces);
     if (!prefixed_tag_extracted_name.has_value()) {
-      --result;
       continue;
     }
+    ++result;
     response.add(fmt::format("# TYPE {0} {1}\n", prefixed_tag_extracted_name.value(), type));
-
-    // Sort before producing the final output to satisfy the "preferred" ordering from the
-    // prometheus spec: metrics will be sorted by their tags' textual representation, which will
-    // be consistent across calls.
-    std::sort(group.second.begin(), group.second.end(), MetricLessThan());
-
     for (const auto& metric : group.second) {
       response.add(generate_output(*metric, prefixed_tag_extracted_name.value()));
     }
@@ -215,6 +245,32 @@ uint64_t outputStatType(
   return result;
 }
 
+/**
+ * Processes a stat type (counter, gauge, histogram) by generating all output lines, sorting
+ * them by tag-extracted metric name, and then outputting them in the correct sorted order into
+ * response.
+ *
+ * @param response The buffer to put the output into.
+ * @param params Whether to only output stats that are used, and a filter on which stats to
+ *        output.
+ * @param metrics The metrics to output stats for. This must contain all stats of the given type
+ *        to be included in the same output.
+ * @param generate_output A function which returns the output text for this metric.
+ * @param type The name of the prometheus metric type for used in TYPE annotations.
+ */
+template <class StatType>
+uint64_t outputStatType(
+    Buffer::Instance& response, const StatsParams& params,
+    const std::vector<Stats::RefcountPtr<StatType>>& metrics,
+    const std::function<std::string(
+        const StatType& metric, const std::string& prefixed_tag_extracted_name)>& generate_output,
+    absl::string_view type, const Stats::CustomStatNamespaces& custom_namespaces) {
+  size_t next_group = 0;
+  return outputMetricGroups<StatType>(
+      response, groupMetrics(params, metrics), next_group, std::numeric_limits<uint64_t>::max(),
+      generate_output, type, custom_namespaces);
+}
+
 template <class StatType>
 uint64_t outputPrimitiveStatType(Buffer::Instance& response, const StatsParams& params,
                                  const std::vector<StatType>& metrics, absl::string_view type,
@@ -418,5 +474,106 @@ uint64_t PrometheusStatsFormatter::statsAsPrometheus(
   return metric_name_count;
 }
 
+PrometheusStatsRequest::PrometheusStatsRequest(
+    Stats::Store& stats, const StatsParams& params,
+    const Upstream::ClusterManager& cluster_manager,
+    const Stats::CustomStatNamespaces& custom_namespaces)
+    : stats_(stats), params_(params), cluster_manager_(cluster_manager),
+      custom_namespaces_(custom_namespaces) {}
+
+Http::Code PrometheusStatsRequest::start(Http::ResponseHeaderMap&) {
+  counters_ = stats_.counters();
+  gauges_ = stats_.gauges();
+  if (params_.prometheus_text_readouts_) {
+    text_readouts_ = stats_.textReadouts();
+  }
+  histograms_ = stats_.histograms();
+  return Http::Code::OK;
+}
+
+template <class StatType>
+bool PrometheusStatsRequest::renderGroups(
+    const std::vector<Stats::RefcountPtr<StatType>>& metrics, MetricGroups<StatType>& groups,
+    const std::function<std::string(const StatType& metric, const std::string& prefixed_name)>&
+        generate,
+    absl::string_view type, Buffer::Instance& response, uint64_t max_length) {
+  if (next_group_ == 0) {
+    groups = groupMetrics(params_, metrics);
+  }
+  outputMetricGroups<StatType>(response, groups, next_group_, max_length, generate, type,
+                               custom_namespaces_);
+  if (next_group_ < groups.size()) {
+    return false;
+  }
+  groups.clear();
+  next_group_ = 0;
+  return true;
+}
+
+bool PrometheusStatsRequest::nextChunk(Buffer::Instance& response) {
+  // nextChunk's contract is to add up to chunk_size_ additional bytes, the last group of a chunk
+  // being rendered whole.
+  const uint64_t max_length = response.length() + chunk_size_;
+  while (response.length() < max_length) {
+    switch (phase_) {
+    case Phase::Counters:
+      if (renderGroups<Stats::Counter>(counters_, counter_groups_,
+                                       generateStatNumericOutput<Stats::Counter>, "counter",
+                                       response, max_length)) {
+        counters_.clear();
+        phase_ = Phase::Gauges;
+      }
+      break;
+    case Phase::Gauges:
+      if (renderGroups<Stats::Gauge>(gauges_, gauge_groups_,
+                                     generateStatNumericOutput<Stats::Gauge>, "gauge", response,
+                                     max_length)) {
+        gauges_.clear();
+        phase_ = Phase::TextReadouts;
+      }
+      break;
+    case Phase::TextReadouts:
+      // TextReadout stats are returned in gauge format, so "gauge" type is set intentionally.
+      if (renderGroups<Stats::TextReadout>(text_readouts_, text_readout_groups_,
+                                           generateTextReadoutOutput, "gauge", response,
+                                           max_length)) {
+        text_readouts_.clear();
+        phase_ = Phase::Histograms;
+      }
+      break;
+    case Phase::Histograms: {
+      // The bucket mode has been validated by validateParams.
+      const bool summary =
+          params_.histogram_buckets_mode_ == Utility::HistogramBucketsMode::Summary;
+      if (renderGroups<Stats::ParentHistogram>(
+              histograms_, histogram_groups_,
+              summary ? generateSummaryOutput : generateHistogramOutput,
+              summary ? "summary" : "histogram", response, max_length)) {
+        histograms_.clear();
+        phase_ = Phase::HostMetrics;
+      }
+      break;
+    }
+    case Phase::HostMetrics: {
+      // The per-endpoint stats are not grouped with the other stats, as in statsAsPrometheus.
+      std::vector<Stats::PrimitiveCounterSnapshot> host_counters;
+      std::vector<Stats::PrimitiveGaugeSnapshot> host_gauges;
+      Upstream::HostUtility::forEachHostMetric(
+          cluster_manager_,
+          [&](Stats::PrimitiveCounterSnapshot&& metric) {
+            host_counters.emplace_back(std::move(metric));
+          },
+          [&](Stats::PrimitiveGaugeSnapshot&& metric) {
+            host_gauges.emplace_back(std::move(metric));
+          });
+      outputPrimitiveStatType(response, params_, host_counters, "counter", custom_namespaces_);
+      outputPrimitiveStatType(response, params_, host_gauges, "gauge", custom_namespaces_);
+      return false;
+    }
+    }
+  }
+  return true;
+}
+
 } // namespace Server
 } // namespace Envoy
@@ -4,9 +4,11 @@
 #include <string>
 
 #include "envoy/buffer/buffer.h"
+#include "envoy/server/admin.h"
 #include "envoy/stats/custom_stat_namespaces.h"
 #include "envoy/stats/histogram.h"
 #include "envoy/stats/stats.h"
+#include "envoy/stats/store.h"
 
 #include "source/server/admin/stats_params.h"
 
@@ -53,5 +55,60 @@ public:
              const Stats::CustomStatNamespaces& custom_namespace_factory);
 };
 
+/**
+ * Streams the stats in the prometheus format, in chunks of about chunk_size bytes. The metrics
+ * are grouped by tag-extracted name once per type, and the groups are rendered a chunk at a
+ * time, so that the whole exposition is never buffered.
+ */
+class PrometheusStatsRequest : public Admin::Request {
+public:
+  static constexpr uint64_t DefaultChunkSize = 2 * 1000 * 1000;
+
+  // The metrics of a type sharing a tag-extracted name, in the order they are rendered.
+  template <class StatType>
+  using MetricGroups = std::vector<std::pair<Stats::StatName, std::vector<const StatType*>>>;
+
+  PrometheusStatsRequest(Stats::Store& stats, const StatsParams& params,
+                         const Upstream::ClusterManager& cluster_manager,
+                         const Stats::CustomStatNamespaces& custom_namespaces);
+
+  // Admin::Request
+  Http::Code start(Http::ResponseHeaderMap& response_headers) override;
+  bool nextChunk(Buffer::Instance& response) override;
+
+  // Sets the chunk size.
+  void setChunkSize(uint64_t chunk_size) { chunk_size_ = chunk_size; }
+
+private:
+  enum class Phase { Counters, Gauges, TextReadouts, Histograms, HostMetrics };
+
+  // Renders the groups of the metrics of the current phase until the response reaches
+  // max_length, grouping the metrics first when the phase starts.
+  // @return whether all the groups of the phase have been rendered.
+  template <class StatType>
+  bool renderGroups(const std::vector<Stats::RefcountPtr<StatType>>& metrics,
+                    MetricGroups<StatType>& groups,
+                    const std::function<std::string(const StatType& metric,
+                                                    const std::string& prefixed_name)>& generate,
+                    absl::string_view type, Buffer::Instance& response, uint64_t max_length);
+
+  Stats::Store& stats_;
+  const StatsParams params_;
+  const Upstream::ClusterManager& cluster_manager_;
+  const Stats::CustomStatNamespaces& custom_namespaces_;
+  Phase phase_{Phase::Counters};
+  size_t next_group_{0};
+  uint64_t chunk_size_{DefaultChunkSize};
+  // The metrics are held for the whole request, as the groups point to them.
+  std::vector<Stats::CounterSharedPtr> counters_;
+  std::vector<Stats::GaugeSharedPtr> gauges_;
+  std::vector<Stats::TextReadoutSharedPtr> text_readouts_;
+  std::vector<Stats::ParentHistogramSharedPtr> histograms_;
+  MetricGroups<Stats::Counter> counter_groups_;
+  MetricGroups<Stats::Gauge> gauge_groups_;
+  MetricGroups<Stats::TextReadout> text_readout_groups_;
+  MetricGroups<Stats::ParentHistogram> histogram_groups_;
+};
+
 } // namespace Server
 } // namespace Envoy
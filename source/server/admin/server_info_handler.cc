@@ -3,6 +3,7 @@
 #include "envoy/admin/v3/memory.pb.h"
 
 #include "source/common/http/headers.h"
+#include "source/common/memory/accounting.h"
 #include "source/common/memory/stats.h"
 #include "source/common/version/version.h"
 #include "source/server/utils.h"
@@ -50,6 +51,12 @@ Http::Code ServerInfoHandler::handlerMemory(Http::ResponseHeaderMap& response_he
   memory.set_pageheap_unmapped(Memory::Stats::totalPageHeapUnmapped());
   memory.set_pageheap_free(Memory::Stats::totalPageHeapFree());
   memory.set_total_physical_bytes(Memory::Stats::totalPhysicalBytes());
+  const auto subsystem_bytes = Memory::Accounting::bytes();
+  for (size_t i = 0; i < Memory::Accounting::NumSubsystems; ++i) {
+    const Memory::Subsystem subsystem = static_cast<Memory::Subsystem>(i);
+    (*memory.mutable_subsystems())[std::string(Memory::Accounting::name(subsystem))] =
+        subsystem_bytes[i];
+  }
   response.add(MessageUtil::getJsonStringFromMessageOrError(memory, true, true)); // pretty-print
   return Http::Code::OK;
 }
@@ -59,8 +59,12 @@ ValidationInstance::ValidationInstance(
       api_(new Api::ValidationImpl(thread_factory, store, time_system, file_system,
                                    random_generator_, bootstrap_, process_context)),
       dispatcher_(api_->allocateDispatcher("main_thread")),
-      access_log_manager_(options.fileFlushIntervalMsec(), *api_, *dispatcher_, access_log_lock,
-                          store),
+      // The access log files have a write shard per worker, and one for the main thread.
+      access_log_manager_({options.fileFlushIntervalMsec(),
+                           uint64_t{options.fileFlushMinSizeKb()} * 1024,
+                           uint64_t{options.fileMaxBufferedSizeKb()} * 1024,
+                           options.concurrency() + 1},
+                          *api_, *dispatcher_, access_log_lock, store),
       grpc_context_(stats_store_.symbolTable()), http_context_(stats_store_.symbolTable()),
       router_context_(stats_store_.symbolTable()), time_system_(time_system),
       server_contexts_(*this), quic_stat_names_(stats_store_.symbolTable()) {
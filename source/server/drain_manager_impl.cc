@@ -1,5 +1,6 @@
 #include "source/server/drain_manager_impl.h"
 
+#include <algorithm>
 #include <chrono>
 #include <cstdint>
 #include <functional>
@@ -82,7 +83,35 @@ bool DrainManagerImpl::drainClose() const {
   }
   const auto elapsed_time = drain_time - remaining_time;
   return static_cast<uint64_t>(elapsed_time.count()) >
-         (server_.api().randomGenerator().random() % drain_time_count);
+             (server_.api().randomGenerator().random() % drain_time_count) &&
+         drainCloseWithinRate(current_time);
+}
+
+bool DrainManagerImpl::drainCloseWithinRate(MonotonicTime current_time) const {
+  const uint64_t max_closes_per_second = server_.runtime().snapshot().getInteger(
+      "server.drain_max_closes_per_second_per_worker", 0);
+  if (max_closes_per_second == 0) {
+    return true;
+  }
+
+  // The drain closes of all the workers take turns at the aggregate rate. The turns which aren't
+  // taken aren't saved for later, so that the closes don't burst after a quiet period. The
+  // connections which are refused a turn are asked again on their next response, and are all
+  // closed from the drain deadline on.
+  const int64_t interval_ns = std::max<int64_t>(
+      1, std::chrono::nanoseconds(std::chrono::seconds(1)).count() /
+             (max_closes_per_second * std::max(server_.options().concurrency(), 1U)));
+  const int64_t now_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                             current_time.time_since_epoch())
+                             .count();
+  int64_t next_ns = next_drain_close_ns_.load(std::memory_order_relaxed);
+  do {
+    if (next_ns > now_ns) {
+      return false;
+    }
+  } while (!next_drain_close_ns_.compare_exchange_weak(next_ns, now_ns + interval_ns,
+                                                       std::memory_order_relaxed));
+  return true;
 }
 
 Common::CallbackHandlePtr DrainManagerImpl::addOnDrainCloseCb(DrainCloseCb cb) const {
@@ -1,6 +1,8 @@
 #pragma once
 
+#include <atomic>
 #include <chrono>
+#include <cstdint>
 #include <functional>
 #include <vector>
 
@@ -22,6 +24,8 @@ namespace Server {
  * 1) Terminates the parent process after 15 minutes.
  * 2) Drains the parent process over a period of 10 minutes where drain close becomes more
  *    likely each second that passes.
+ * The drain closes of the gradual strategy can be paced to a maximum rate per worker, so that the
+ * clients don't all reconnect at once.
  */
 class DrainManagerImpl : Logger::Loggable<Logger::Id::main>, public DrainManager {
 public:
@@ -43,6 +47,9 @@ public:
 
 private:
   void addDrainCompleteCallback(std::function<void()> cb);
+  // Returns whether a drain close at the current time fits in the maximum rate of drain closes,
+  // consuming its turn if it does.
+  bool drainCloseWithinRate(MonotonicTime current_time) const;
 
   Instance& server_;
   Event::Dispatcher& dispatcher_;
@@ -51,6 +58,8 @@ private:
   std::atomic<bool> draining_{false};
   Event::TimerPtr drain_tick_timer_;
   MonotonicTime drain_deadline_;
+  // The earliest time of the next paced drain close, in nanoseconds since the monotonic epoch.
+  mutable std::atomic<int64_t> next_drain_close_ns_{0};
   mutable Common::CallbackManager<std::chrono::milliseconds> cbs_{};
   std::vector<std::function<void()>> drain_complete_cbs_{};
 
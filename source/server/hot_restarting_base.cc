@@ -12,7 +12,6 @@ namespace Server {
 
 using HotRestartMessage = envoy::HotRestartMessage;
 
-static constexpr uint64_t MaxSendmsgSize = 4096;
 static constexpr absl::Duration CONNECTION_REFUSED_RETRY_DELAY = absl::Seconds(1);
 static constexpr int SENDMSG_MAX_RETRIES = 10;
 
@@ -84,6 +83,18 @@ bool RpcStream::sendHotRestartMessage(sockaddr_un& address, const HotRestartMess
   RELEASE_ASSERT(fcntl(domain_socket_, F_SETFL, 0) != -1,
                  fmt::format("Set domain socket blocking failed, errno = {}", errno));
 
+  // The fds to pass as control data, only by the PassListenSocket and PassListenSockets replies.
+  std::vector<int> fds;
+  if (replyIsExpectedType(&proto, HotRestartMessage::Reply::kPassListenSocket) &&
+      proto.reply().pass_listen_socket().fd() != -1) {
+    fds.push_back(proto.reply().pass_listen_socket().fd());
+  } else if (replyIsExpectedType(&proto, HotRestartMessage::Reply::kPassListenSockets)) {
+    for (const auto& socket : proto.reply().pass_listen_sockets().sockets()) {
+      fds.push_back(socket.fd());
+    }
+  }
+  RELEASE_ASSERT(fds.size() <= MaxPassedFds, "too many fds for one hot restart sendmsg().");
+
   uint8_t* next_byte_to_send = send_buf.data();
   uint64_t sent = 0;
   while (sent < total_size) {
@@ -100,18 +111,19 @@ bool RpcStream::sendHotRestartMessage(sockaddr_un& address, const HotRestartMess
     message.msg_iov = iov;
     message.msg_iovlen = 1;
 
-    // Control data stuff, only relevant for the fd passing done with PassListenSocketReply.
-    uint8_t control_buffer[CMSG_SPACE(sizeof(int))];
-    if (replyIsExpectedType(&proto, HotRestartMessage::Reply::kPassListenSocket) &&
-        proto.reply().pass_listen_socket().fd() != -1) {
-      memset(control_buffer, 0, CMSG_SPACE(sizeof(int)));
+    // Control data stuff, only relevant for the fd passing done with PassListenSocketReply and
+    // PassListenSocketsReply.
+    uint8_t control_buffer[CMSG_SPACE(sizeof(int) * MaxPassedFds)];
+    if (!fds.empty()) {
+      const size_t fds_size = sizeof(int) * fds.size();
+      memset(control_buffer, 0, CMSG_SPACE(fds_size));
       message.msg_control = control_buffer;
-      message.msg_controllen = CMSG_SPACE(sizeof(int));
+      message.msg_controllen = CMSG_SPACE(fds_size);
       cmsghdr* control_message = CMSG_FIRSTHDR(&message);
       control_message->cmsg_level = SOL_SOCKET;
       control_message->cmsg_type = SCM_RIGHTS;
-      control_message->cmsg_len = CMSG_LEN(sizeof(int));
-      *reinterpret_cast<int*>(CMSG_DATA(control_message)) = proto.reply().pass_listen_socket().fd();
+      control_message->cmsg_len = CMSG_LEN(fds_size);
+      memcpy(CMSG_DATA(control_message), fds.data(), fds_size);
       ASSERT(sent == total_size, "an fd passing message was too long for one sendmsg().");
     }
 
@@ -159,21 +171,34 @@ bool RpcStream::replyIsExpectedType(const HotRestartMessage* proto,
          proto->reply().reply_case() == oneof_type;
 }
 
-// Pull the cloned fd, if present, out of the control data and write it into the
-// PassListenSocketReply proto; the higher level code will see a listening fd that Just Works. We
-// should only get control data in a PassListenSocketReply, it should only be the fd passing type,
-// and there should only be one at a time. Crash on any other control data.
+// Pull the cloned fds, if present, out of the control data and write them into the
+// PassListenSocketReply or PassListenSocketsReply proto; the higher level code will see listening
+// fds that Just Work. We should only get control data in those replies, it should only be the fd
+// passing type, with one fd per socket of the reply, and there should only be one at a time. Crash
+// on any other control data.
 void RpcStream::getPassedFdIfPresent(HotRestartMessage* out, msghdr* message) {
   // NOLINTNEXTLINE(clang-analyzer-core.UndefinedBinaryOperatorResult)
   cmsghdr* cmsg = CMSG_FIRSTHDR(message);
   if (cmsg != nullptr) {
     RELEASE_ASSERT(cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SCM_RIGHTS &&
-                       replyIsExpectedType(out, HotRestartMessage::Reply::kPassListenSocket),
+                       (replyIsExpectedType(out, HotRestartMessage::Reply::kPassListenSocket) ||
+                        replyIsExpectedType(out, HotRestartMessage::Reply::kPassListenSockets)),
                    "recvmsg() came with control data when the message's purpose was not to pass a "
                    "file descriptor.");
 
-    out->mutable_reply()->mutable_pass_listen_socket()->set_fd(
-        *reinterpret_cast<int*>(CMSG_DATA(cmsg)));
+    const int* fds = reinterpret_cast<int*>(CMSG_DATA(cmsg));
+    const size_t num_fds = (cmsg->cmsg_len - CMSG_LEN(0)) / sizeof(int);
+    if (out->reply().reply_case() == HotRestartMessage::Reply::kPassListenSocket) {
+      RELEASE_ASSERT(num_fds == 1, "recvmsg() came with more than one fd for one socket.");
+      out->mutable_reply()->mutable_pass_listen_socket()->set_fd(fds[0]);
+    } else {
+      auto* sockets = out->mutable_reply()->mutable_pass_listen_sockets()->mutable_sockets();
+      RELEASE_ASSERT(num_fds == static_cast<size_t>(sockets->size()),
+                     "recvmsg() came with a different number of fds than of sockets.");
+      for (size_t i = 0; i < num_fds; ++i) {
+        sockets->Mutable(i)->set_fd(fds[i]);
+      }
+    }
 
     RELEASE_ASSERT(CMSG_NXTHDR(message, cmsg) == nullptr,
                    "More than one control data on a single hot restart recvmsg().");
@@ -214,20 +239,20 @@ std::unique_ptr<HotRestartMessage> RpcStream::receiveHotRestartMessage(Blocking
 
   iovec iov[1];
   msghdr message;
-  uint8_t control_buffer[CMSG_SPACE(sizeof(int))];
+  uint8_t control_buffer[CMSG_SPACE(sizeof(int) * MaxPassedFds)];
   std::unique_ptr<HotRestartMessage> ret = nullptr;
   Api::OsSysCalls& os_sys_calls = Api::OsSysCallsSingleton::get();
   while (!ret) {
     iov[0].iov_base = recv_buf_.data() + cur_msg_recvd_bytes_;
     iov[0].iov_len = MaxSendmsgSize;
 
-    // We always setup to receive an FD even though most messages do not pass one.
-    memset(control_buffer, 0, CMSG_SPACE(sizeof(int)));
+    // We always setup to receive FDs even though most messages do not pass any.
+    memset(control_buffer, 0, sizeof(control_buffer));
     memset(&message, 0, sizeof(message));
     message.msg_iov = iov;
     message.msg_iovlen = 1;
     message.msg_control = control_buffer;
-    message.msg_controllen = CMSG_SPACE(sizeof(int));
+    message.msg_controllen = sizeof(control_buffer);
 
     const Api::SysCallSizeResult recv_result = os_sys_calls.recvmsg(domain_socket_, &message, 0);
     if (block == Blocking::No && recv_result.return_value_ == -1 &&
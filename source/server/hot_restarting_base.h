@@ -25,6 +25,11 @@ class RpcStream : public Logger::Loggable<Logger::Id::main> {
 public:
   enum class Blocking { Yes, No };
 
+  // The most bytes sent by one sendmsg datagram of the protocol.
+  static constexpr uint64_t MaxSendmsgSize = 4096;
+  // The most fds passed by one PassListenSockets reply, which must fit in one datagram.
+  static constexpr uint32_t MaxPassedFds = 64;
+
   explicit RpcStream(uint64_t base_id) : base_id_(base_id) {}
   ~RpcStream();
   void initDomainSocketAddress(sockaddr_un* address);
@@ -1,8 +1,10 @@
 #include "source/server/hot_restarting_child.h"
 
+#include "source/common/api/os_sys_calls_impl.h"
 #include "source/common/buffer/buffer_impl.h"
 #include "source/common/common/utility.h"
 #include "source/common/network/utility.h"
+#include "source/common/protobuf/protobuf.h"
 
 namespace Envoy {
 namespace Server {
@@ -130,6 +132,19 @@ int HotRestartingChild::duplicateParentListenSocket(const std::string& address,
     return -1;
   }
 
+  if (!parent_listen_sockets_requested_) {
+    parent_listen_sockets_requested_ = true;
+    getAllParentListenSockets();
+  }
+  auto it = parent_listen_sockets_.find(std::make_pair(address, worker_index));
+  if (it != parent_listen_sockets_.end()) {
+    const int fd = it->second;
+    parent_listen_sockets_.erase(it);
+    return fd;
+  }
+
+  // The socket is asked for alone if the parent didn't pass it with the others, e.g. because it
+  // can't pass them all at once.
   HotRestartMessage wrapped_request;
   wrapped_request.mutable_request()->mutable_pass_listen_socket()->set_address(address);
   wrapped_request.mutable_request()->mutable_pass_listen_socket()->set_worker_index(worker_index);
@@ -144,13 +159,48 @@ int HotRestartingChild::duplicateParentListenSocket(const std::string& address,
   return wrapped_reply->reply().pass_listen_socket().fd();
 }
 
+void HotRestartingChild::getAllParentListenSockets() {
+  uint32_t start = 0;
+  do {
+    HotRestartMessage wrapped_request;
+    wrapped_request.mutable_request()->mutable_pass_listen_sockets()->set_start(start);
+    main_rpc_stream_.sendHotRestartMessage(parent_address_, wrapped_request);
+
+    std::unique_ptr<HotRestartMessage> wrapped_reply =
+        main_rpc_stream_.receiveHotRestartMessage(RpcStream::Blocking::Yes);
+    if (!main_rpc_stream_.replyIsExpectedType(wrapped_reply.get(),
+                                              HotRestartMessage::Reply::kPassListenSockets)) {
+      // An older parent doesn't recognize the request.
+      return;
+    }
+    const HotRestartMessage::Reply::PassListenSockets& reply =
+        wrapped_reply->reply().pass_listen_sockets();
+    for (const auto& socket : reply.sockets()) {
+      if (!parent_listen_sockets_
+               .try_emplace(std::make_pair(socket.address(), socket.worker_index()), socket.fd())
+               .second) {
+        Api::OsSysCallsSingleton::get().close(socket.fd());
+      }
+    }
+    start = reply.next();
+  } while (start != 0);
+}
+
+void HotRestartingChild::closeUnclaimedParentListenSockets() {
+  // The sockets of the listeners created later are asked for alone.
+  for (const auto& socket : parent_listen_sockets_) {
+    Api::OsSysCallsSingleton::get().close(socket.second);
+  }
+  parent_listen_sockets_.clear();
+}
+
 std::unique_ptr<HotRestartMessage> HotRestartingChild::getParentStats() {
   if (parent_terminated_ || skip_parent_stats_) {
     return nullptr;
   }
 
   HotRestartMessage wrapped_request;
-  wrapped_request.mutable_request()->mutable_stats();
+  wrapped_request.mutable_request()->mutable_stats()->set_packed(true);
   main_rpc_stream_.sendHotRestartMessage(parent_address_, wrapped_request);
 
   std::unique_ptr<HotRestartMessage> wrapped_reply =
@@ -165,6 +215,8 @@ void HotRestartingChild::drainParentListeners() {
   if (parent_terminated_) {
     return;
   }
+  // The listeners which took sockets from the parent are all created by now.
+  closeUnclaimedParentListenSockets();
   // No reply expected.
   HotRestartMessage wrapped_request;
   wrapped_request.mutable_request()->mutable_drain_listeners();
@@ -224,6 +276,7 @@ void HotRestartingChild::sendParentTerminateRequest() {
     return;
   }
   allDrainsImplicitlyComplete();
+  closeUnclaimedParentListenSockets();
 
   HotRestartMessage wrapped_request;
   wrapped_request.mutable_request()->mutable_terminate();
@@ -252,6 +305,11 @@ void HotRestartingChild::mergeParentStats(Stats::Store& stats_store,
     hot_restart_generation_stat_name_ = hotRestartGeneration(*stats_store.rootScope()).statName();
   }
 
+  if (stats_proto.has_packed_stats()) {
+    mergePackedParentStats(stats_store.symbolTable(), stats_proto.packed_stats());
+    return;
+  }
+
   // Convert the protobuf for serialized dynamic spans into the structure
   // required by StatMerger.
   Stats::StatMerger::DynamicsMap dynamics;
@@ -265,6 +323,49 @@ void HotRestartingChild::mergeParentStats(Stats::Store& stats_store,
   stat_merger_->mergeStats(stats_proto.counter_deltas(), stats_proto.gauges(), dynamics);
 }
 
+void HotRestartingChild::mergePackedParentStats(
+    Stats::SymbolTable& symbol_table, const HotRestartMessage::Reply::PackedStats& packed_stats) {
+  // Each token is looked up or added to the symbol table once, and the names are joined from them.
+  Stats::StatNamePool symbolic_pool(symbol_table);
+  Stats::StatNameDynamicPool dynamic_pool(symbol_table);
+  std::vector<Stats::StatName> symbols;
+  symbols.reserve(packed_stats.symbols_size());
+  for (const std::string& symbol : packed_stats.symbols()) {
+    symbols.push_back(symbolic_pool.add(symbol));
+  }
+  std::vector<Stats::StatName> dynamics;
+  dynamics.reserve(packed_stats.dynamics_size());
+  for (const std::string& dynamic : packed_stats.dynamics()) {
+    dynamics.push_back(dynamic_pool.add(dynamic));
+  }
+
+  const std::string& data = packed_stats.stats();
+  Protobuf::io::CodedInputStream input(reinterpret_cast<const uint8_t*>(data.data()), data.size());
+  Stats::StatNameVec segments;
+  while (static_cast<size_t>(input.CurrentPosition()) < data.size()) {
+    uint64_t header;
+    RELEASE_ASSERT(input.ReadVarint64(&header), "malformed packed stats from the parent.");
+    segments.clear();
+    for (uint64_t i = 0; i < header >> 1; ++i) {
+      uint64_t token;
+      RELEASE_ASSERT(input.ReadVarint64(&token), "malformed packed stats from the parent.");
+      const std::vector<Stats::StatName>& tokens = (token & 1) ? dynamics : symbols;
+      RELEASE_ASSERT((token >> 1) < tokens.size(), "malformed packed stats from the parent.");
+      segments.push_back(tokens[token >> 1]);
+    }
+    uint64_t value;
+    RELEASE_ASSERT(input.ReadVarint64(&value), "malformed packed stats from the parent.");
+
+    const Stats::SymbolTable::StoragePtr storage = symbol_table.join(segments);
+    const Stats::StatName stat_name(storage.get());
+    if (header & 1) {
+      stat_merger_->mergeGauge(stat_name, value);
+    } else {
+      stat_merger_->mergeCounter(stat_name, value);
+    }
+  }
+}
+
 absl::Status HotRestartingChild::onSocketEventUdpForwarding() {
   std::unique_ptr<HotRestartMessage> wrapped_request;
   while ((wrapped_request =
@@ -71,6 +71,12 @@ protected:
 
 private:
   bool abortDueToFailedParentConnection();
+  // Asks the parent for all its listen sockets at once, keeping them for
+  // duplicateParentListenSocket() to claim.
+  void getAllParentListenSockets();
+  void closeUnclaimedParentListenSockets();
+  void mergePackedParentStats(Stats::SymbolTable& symbol_table,
+                              const envoy::HotRestartMessage::Reply::PackedStats& packed_stats);
   friend class HotRestartUdpForwardingTestHelper;
   absl::Mutex registry_mu_;
   const int restart_epoch_;
@@ -81,6 +87,9 @@ private:
   sockaddr_un parent_address_;
   sockaddr_un parent_address_udp_forwarding_;
   std::unique_ptr<Stats::StatMerger> stat_merger_{};
+  // The listen sockets passed by the parent, by address and worker index, until claimed.
+  absl::flat_hash_map<std::pair<std::string, uint32_t>, int> parent_listen_sockets_;
+  bool parent_listen_sockets_requested_{};
   Stats::StatName hot_restart_generation_stat_name_;
   // There are multiple listener instances per address that must all be reactivated
   // when the parent is drained, so a multimap is used to contain them.
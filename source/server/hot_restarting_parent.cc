@@ -4,10 +4,13 @@
 
 #include "source/common/memory/stats.h"
 #include "source/common/network/utility.h"
+#include "source/common/protobuf/protobuf.h"
 #include "source/common/stats/stat_merger.h"
 #include "source/common/stats/symbol_table.h"
 #include "source/common/stats/utility.h"
 
+#include "absl/container/flat_hash_map.h"
+
 namespace Envoy {
 namespace Server {
 
@@ -83,9 +86,19 @@ void HotRestartingParent::onSocketEvent() {
       break;
     }
 
+    case HotRestartMessage::Request::kPassListenSockets: {
+      main_rpc_stream_.sendHotRestartMessage(
+          child_address_, internal_->getAllListenSocketsForChild(wrapped_request->request()));
+      break;
+    }
+
     case HotRestartMessage::Request::kStats: {
       HotRestartMessage wrapped_reply;
-      internal_->exportStatsToChild(wrapped_reply.mutable_reply()->mutable_stats());
+      if (wrapped_request->request().stats().packed()) {
+        internal_->exportPackedStatsToChild(wrapped_reply.mutable_reply()->mutable_stats());
+      } else {
+        internal_->exportStatsToChild(wrapped_reply.mutable_reply()->mutable_stats());
+      }
       main_rpc_stream_.sendHotRestartMessage(child_address_, wrapped_reply);
       break;
     }
@@ -168,6 +181,57 @@ HotRestartingParent::Internal::getListenSocketsForChild(const HotRestartMessage:
   return wrapped_reply;
 }
 
+HotRestartMessage HotRestartingParent::Internal::getAllListenSocketsForChild(
+    const HotRestartMessage::Request& request) {
+  // Room left for the next field, which is set once the reply is full.
+  constexpr uint64_t NextFieldBytes = 8;
+  HotRestartMessage wrapped_reply;
+  HotRestartMessage::Reply::PassListenSockets* reply =
+      wrapped_reply.mutable_reply()->mutable_pass_listen_sockets();
+  const uint32_t start = request.pass_listen_sockets().start();
+  uint32_t index = 0;
+
+  for (const auto& listener : server_->listenerManager().listeners()) {
+    if (!listener.get().bindToPort()) {
+      continue;
+    }
+    for (auto& socket_factory : listener.get().listenSocketFactories()) {
+      const Network::Address::Instance& address = *socket_factory->localAddress();
+      if (address.type() == Network::Address::Type::EnvoyInternal) {
+        continue;
+      }
+      // The addresses are named as the child's listener manager asks for them.
+      std::string url;
+      if (address.type() == Network::Address::Type::Pipe) {
+        url = absl::StrCat("unix://", address.asString());
+      } else {
+        url = absl::StrCat(socket_factory->socketType() == Network::Socket::Type::Stream
+                               ? Network::Utility::TCP_SCHEME
+                               : Network::Utility::UDP_SCHEME,
+                           address.asString());
+      }
+      for (uint32_t worker_index = 0; worker_index < server_->options().concurrency();
+           ++worker_index, ++index) {
+        if (index < start) {
+          continue;
+        }
+        HotRestartMessage::Reply::PassListenSockets::Socket* socket = reply->add_sockets();
+        socket->set_address(url);
+        socket->set_worker_index(worker_index);
+        socket->set_fd(socket_factory->getListenSocket(worker_index)->ioHandle().fdDoNotUse());
+        if (static_cast<uint32_t>(reply->sockets_size()) > RpcStream::MaxPassedFds ||
+            sizeof(uint64_t) + wrapped_reply.ByteSizeLong() + NextFieldBytes >
+                RpcStream::MaxSendmsgSize) {
+          reply->mutable_sockets()->RemoveLast();
+          reply->set_next(index);
+          return wrapped_reply;
+        }
+      }
+    }
+  }
+  return wrapped_reply;
+}
+
 // TODO(fredlas) if there are enough stats for stat name length to become an issue, this current
 // implementation can negate the benefit of symbolized stat names by periodically reaching the
 // magnitude of memory usage that they are meant to avoid, since this map holds full-string
@@ -197,6 +261,78 @@ void HotRestartingParent::Internal::exportStatsToChild(HotRestartMessage::Reply:
   stats->set_num_connections(server_->listenerManager().numConnections());
 }
 
+namespace {
+
+// Writes the counters and gauges as PackedStats, adding each distinct token of their names once.
+class PackedStatsEncoder {
+public:
+  PackedStatsEncoder(const Stats::SymbolTable& symbol_table,
+                     HotRestartMessage::Reply::PackedStats& packed_stats)
+      : symbol_table_(symbol_table), packed_stats_(packed_stats),
+        output_(packed_stats.mutable_stats()), coded_output_(&output_) {}
+
+  void add(Stats::StatName stat_name, bool is_gauge, uint64_t value) {
+    tokens_.clear();
+    symbol_table_.decodeTokens(
+        stat_name,
+        [this](Stats::Symbol symbol, absl::string_view str) {
+          auto [it, inserted] = symbols_.try_emplace(symbol, packed_stats_.symbols_size());
+          if (inserted) {
+            packed_stats_.add_symbols(std::string(str));
+          }
+          tokens_.push_back(uint64_t{it->second} << 1);
+        },
+        [this](absl::string_view str) {
+          auto it = dynamics_.find(str);
+          if (it == dynamics_.end()) {
+            it = dynamics_.emplace(std::string(str), packed_stats_.dynamics_size()).first;
+            packed_stats_.add_dynamics(std::string(str));
+          }
+          tokens_.push_back((uint64_t{it->second} << 1) | 1);
+        });
+    coded_output_.WriteVarint64((tokens_.size() << 1) | (is_gauge ? 1 : 0));
+    for (const uint64_t token : tokens_) {
+      coded_output_.WriteVarint64(token);
+    }
+    coded_output_.WriteVarint64(value);
+  }
+
+private:
+  const Stats::SymbolTable& symbol_table_;
+  HotRestartMessage::Reply::PackedStats& packed_stats_;
+  absl::flat_hash_map<Stats::Symbol, uint32_t> symbols_;
+  absl::flat_hash_map<std::string, uint32_t> dynamics_;
+  std::vector<uint64_t> tokens_;
+  // The output is trimmed to what was written when the encoder is destroyed.
+  Protobuf::io::StringOutputStream output_;
+  Protobuf::io::CodedOutputStream coded_output_;
+};
+
+} // namespace
+
+void HotRestartingParent::Internal::exportPackedStatsToChild(
+    HotRestartMessage::Reply::Stats* stats) {
+  {
+    PackedStatsEncoder encoder(server_->stats().symbolTable(), *stats->mutable_packed_stats());
+    server_->stats().forEachSinkedGauge(nullptr, [&encoder](Stats::Gauge& gauge) {
+      if (gauge.used()) {
+        encoder.add(gauge.statName(), true, gauge.value());
+      }
+    });
+    server_->stats().forEachSinkedCounter(nullptr, [&encoder](Stats::Counter& counter) {
+      if (counter.used()) {
+        // As in exportStatsToChild(), the parent has stopped latching for its own sinks.
+        const uint64_t latched_value = counter.latch();
+        if (latched_value > 0) {
+          encoder.add(counter.statName(), false, latched_value);
+        }
+      }
+    });
+  }
+  stats->set_memory_allocated(Memory::Stats::totalCurrentlyAllocated());
+  stats->set_num_connections(server_->listenerManager().numConnections());
+}
+
 void HotRestartingParent::Internal::recordDynamics(HotRestartMessage::Reply::Stats* stats,
                                                    const std::string& name,
                                                    Stats::StatName stat_name) {
@@ -35,8 +35,14 @@ public:
     // Return value is the response to return to the child.
     envoy::HotRestartMessage
     getListenSocketsForChild(const envoy::HotRestartMessage::Request& request);
+    // Return value is the response to return to the child, with as many of the listen sockets as
+    // fit one message from the requested one.
+    envoy::HotRestartMessage
+    getAllListenSocketsForChild(const envoy::HotRestartMessage::Request& request);
     // 'stats' is a field in the reply protobuf to be sent to the child, which we should populate.
     void exportStatsToChild(envoy::HotRestartMessage::Reply::Stats* stats);
+    // As exportStatsToChild(), with the counters and gauges in stats->packed_stats().
+    void exportPackedStatsToChild(envoy::HotRestartMessage::Reply::Stats* stats);
     void recordDynamics(envoy::HotRestartMessage::Reply::Stats* stats, const std::string& name,
                         Stats::StatName stat_name);
     void drainListeners();
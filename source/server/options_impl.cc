@@ -121,6 +121,11 @@ OptionsImpl::OptionsImpl(std::vector<std::string> args,
       "Logger mode: enable file level log control (Fine-Grain Logger) or not", cmd, false);
   TCLAP::ValueArg<std::string> log_path("", "log-path", "Path to logfile", false, "", "string",
                                         cmd);
+  TCLAP::ValueArg<uint32_t> log_async_buffer_size_kb(
+      "", "log-async-buffer-size-kb",
+      "Size of the log buffer of each thread in KiB, written by a background thread, 0 to log "
+      "synchronously",
+      false, 0, "uint32_t", cmd);
   TCLAP::ValueArg<uint32_t> restart_epoch("", "restart-epoch", "Hot restart epoch #", false, 0,
                                           "uint32_t", cmd);
   TCLAP::SwitchArg hot_restart_version_option("", "hot-restart-version",
@@ -134,6 +139,13 @@ OptionsImpl::OptionsImpl(std::vector<std::string> args,
   TCLAP::ValueArg<uint32_t> file_flush_interval_msec("", "file-flush-interval-msec",
                                                      "Interval for log flushing in msec", false,
                                                      10000, "uint32_t", cmd);
+  TCLAP::ValueArg<uint32_t> file_flush_min_size_kb(
+      "", "file-flush-min-size-kb", "Size of the buffered log data flushed without waiting in KiB",
+      false, 64, "uint32_t", cmd);
+  TCLAP::ValueArg<uint32_t> file_max_buffered_size_kb(
+      "", "file-max-buffered-size-kb",
+      "Size of the buffered log data above which log writes are dropped in KiB, 0 to not bound it",
+      false, 0, "uint32_t", cmd);
   TCLAP::ValueArg<uint32_t> drain_time_s("", "drain-time-s",
                                          "Hot restart and LDS removal drain time in seconds", false,
                                          600, "uint32_t", cmd);
@@ -154,6 +166,9 @@ OptionsImpl::OptionsImpl(std::vector<std::string> args,
       "", "enable-mutex-tracing", "Enable mutex contention tracing functionality", cmd, false);
   TCLAP::SwitchArg cpuset_threads(
       "", "cpuset-threads", "Get the default # of worker threads from cpuset size", cmd, false);
+  TCLAP::SwitchArg pin_worker_threads(
+      "", "pin-worker-threads", "Pin each worker thread to one of the CPUs of the process", cmd,
+      false);
 
   TCLAP::ValueArg<std::string> disable_extensions("", "disable-extensions",
                                                   "Comma-separated list of extensions to disable",
@@ -200,6 +215,7 @@ OptionsImpl::OptionsImpl(std::vector<std::string> args,
   core_dump_enabled_ = enable_core_dump.getValue();
 
   cpuset_threads_ = cpuset_threads.getValue();
+  pin_worker_threads_ = pin_worker_threads.getValue();
 
   if (log_level.isSet()) {
     auto status_or_error = parseAndValidateLogLevel(log_level.getValue());
@@ -276,10 +292,13 @@ OptionsImpl::OptionsImpl(std::vector<std::string> args,
   ignore_unknown_dynamic_fields_ = ignore_unknown_dynamic_fields.getValue();
   admin_address_path_ = admin_address_path.getValue();
   log_path_ = log_path.getValue();
+  log_async_buffer_size_kb_ = log_async_buffer_size_kb.getValue();
   service_cluster_ = service_cluster.getValue();
   service_node_ = service_node.getValue();
   service_zone_ = service_zone.getValue();
   file_flush_interval_msec_ = std::chrono::milliseconds(file_flush_interval_msec.getValue());
+  file_flush_min_size_kb_ = file_flush_min_size_kb.getValue();
+  file_max_buffered_size_kb_ = file_max_buffered_size_kb.getValue();
   drain_time_ = std::chrono::seconds(drain_time_s.getValue());
   parent_shutdown_time_ = std::chrono::seconds(parent_shutdown_time_s.getValue());
   socket_path_ = socket_path.getValue();
@@ -403,6 +422,7 @@ Server::CommandLineOptionsPtr OptionsImpl::toCommandLineOptions() const {
   command_line_options->set_log_format_escaped(logFormatEscaped());
   command_line_options->set_enable_fine_grain_logging(enableFineGrainLogging());
   command_line_options->set_log_path(logPath());
+  command_line_options->set_log_async_buffer_size_kb(logAsyncBufferSizeKb());
   command_line_options->set_service_cluster(serviceClusterName());
   command_line_options->set_service_node(serviceNodeName());
   command_line_options->set_service_zone(serviceZone());
@@ -420,6 +440,8 @@ Server::CommandLineOptionsPtr OptionsImpl::toCommandLineOptions() const {
   }
   command_line_options->mutable_file_flush_interval()->MergeFrom(
       Protobuf::util::TimeUtil::MillisecondsToDuration(fileFlushIntervalMsec().count()));
+  command_line_options->set_file_flush_min_size_kb(fileFlushMinSizeKb());
+  command_line_options->set_file_max_buffered_size_kb(fileMaxBufferedSizeKb());
 
   command_line_options->mutable_drain_time()->MergeFrom(
       Protobuf::util::TimeUtil::SecondsToDuration(drainTime().count()));
@@ -432,6 +454,7 @@ Server::CommandLineOptionsPtr OptionsImpl::toCommandLineOptions() const {
   command_line_options->set_disable_hot_restart(hotRestartDisabled());
   command_line_options->set_enable_mutex_tracing(mutexTracingEnabled());
   command_line_options->set_cpuset_threads(cpusetThreadsEnabled());
+  command_line_options->set_pin_worker_threads(pinWorkerThreadsEnabled());
   command_line_options->set_restart_epoch(restartEpoch());
   for (const auto& e : disabledExtensions()) {
     command_line_options->add_disabled_extensions(e);
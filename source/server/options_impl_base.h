@@ -62,11 +62,20 @@ public:
     log_format_set_ = true;
   }
   void setLogPath(const std::string& log_path) { log_path_ = log_path; }
+  void setLogAsyncBufferSizeKb(uint32_t log_async_buffer_size_kb) {
+    log_async_buffer_size_kb_ = log_async_buffer_size_kb;
+  }
   void setRestartEpoch(uint64_t restart_epoch) { restart_epoch_ = restart_epoch; }
   void setMode(Server::Mode mode) { mode_ = mode; }
   void setFileFlushIntervalMsec(std::chrono::milliseconds file_flush_interval_msec) {
     file_flush_interval_msec_ = file_flush_interval_msec;
   }
+  void setFileFlushMinSizeKb(uint32_t file_flush_min_size_kb) {
+    file_flush_min_size_kb_ = file_flush_min_size_kb;
+  }
+  void setFileMaxBufferedSizeKb(uint32_t file_max_buffered_size_kb) {
+    file_max_buffered_size_kb_ = file_max_buffered_size_kb;
+  }
   void setServiceClusterName(const std::string& service_cluster) {
     service_cluster_ = service_cluster;
   }
@@ -79,6 +88,9 @@ public:
     signal_handling_enabled_ = signal_handling_enabled;
   }
   void setCpusetThreads(bool cpuset_threads_enabled) { cpuset_threads_ = cpuset_threads_enabled; }
+  void setPinWorkerThreads(bool pin_worker_threads_enabled) {
+    pin_worker_threads_ = pin_worker_threads_enabled;
+  }
   void setAllowUnknownFields(bool allow_unknown_static_fields) {
     allow_unknown_static_fields_ = allow_unknown_static_fields;
   }
@@ -128,11 +140,14 @@ public:
   bool logFormatEscaped() const override { return log_format_escaped_; }
   bool enableFineGrainLogging() const override { return enable_fine_grain_logging_; }
   const std::string& logPath() const override { return log_path_; }
+  uint32_t logAsyncBufferSizeKb() const override { return log_async_buffer_size_kb_; }
   uint64_t restartEpoch() const override { return restart_epoch_; }
   Server::Mode mode() const override { return mode_; }
   std::chrono::milliseconds fileFlushIntervalMsec() const override {
     return file_flush_interval_msec_;
   }
+  uint32_t fileFlushMinSizeKb() const override { return file_flush_min_size_kb_; }
+  uint32_t fileMaxBufferedSizeKb() const override { return file_max_buffered_size_kb_; }
   const std::string& serviceClusterName() const override { return service_cluster_; }
   const std::string& serviceNodeName() const override { return service_node_; }
   const std::string& serviceZone() const override { return service_zone_; }
@@ -142,6 +157,7 @@ public:
   bool coreDumpEnabled() const override { return core_dump_enabled_; }
   const Stats::TagVector& statsTags() const override { return stats_tags_; }
   bool cpusetThreadsEnabled() const override { return cpuset_threads_; }
+  bool pinWorkerThreadsEnabled() const override { return pin_worker_threads_; }
   const std::vector<std::string>& disabledExtensions() const override {
     return disabled_extensions_;
   }
@@ -191,11 +207,14 @@ private:
   bool log_format_set_{false};
   bool log_format_escaped_{false};
   std::string log_path_;
+  uint32_t log_async_buffer_size_kb_{0};
   uint64_t restart_epoch_{0};
   std::string service_cluster_;
   std::string service_node_;
   std::string service_zone_;
   std::chrono::milliseconds file_flush_interval_msec_{10000};
+  uint32_t file_flush_min_size_kb_{64};
+  uint32_t file_max_buffered_size_kb_{0};
   std::chrono::seconds drain_time_{600};
   std::chrono::seconds parent_shutdown_time_{900};
   Server::DrainStrategy drain_strategy_{Server::DrainStrategy::Gradual};
@@ -205,6 +224,7 @@ private:
   bool mutex_tracing_enabled_{false};
   bool core_dump_enabled_{false};
   bool cpuset_threads_{false};
+  bool pin_worker_threads_{false};
   std::vector<std::string> disabled_extensions_;
   Stats::TagVector stats_tags_;
   uint32_t count_{0};
@@ -315,7 +315,11 @@ OverloadActionState OverloadAction::getState() const { return state_; }
 LoadShedPointImpl::LoadShedPointImpl(const envoy::config::overload::v3::LoadShedPoint& config,
                                      Stats::Scope& stats_scope,
                                      Random::RandomGenerator& random_generator)
-    : scale_percent_(makeGauge(stats_scope, config.name(), "scale_percent",
+    : low_priority_request_header_(
+          config.low_priority_request_header().empty()
+              ? absl::nullopt
+              : absl::make_optional<Http::LowerCaseString>(config.low_priority_request_header())),
+      scale_percent_(makeGauge(stats_scope, config.name(), "scale_percent",
                                Stats::Gauge::ImportMode::NeverImport)),
       shed_load_counter_(makeCounter(stats_scope, config.name(), "shed_load_count")),
       random_generator_(random_generator) {
@@ -345,14 +349,38 @@ void LoadShedPointImpl::updateProbabilityShedLoad() {
     max_unit_float = std::max(trigger.second->actionState().value().value(), max_unit_float);
   }
 
-  probability_shed_load_.store(max_unit_float);
+  // The probability orders no other memory, so it is read and written with relaxed atomics: the
+  // workers pick up the update without any post, at the cost of a plain load per check.
+  probability_shed_load_.store(max_unit_float, std::memory_order_relaxed);
 
   // Update stats.
   scale_percent_.set(100 * max_unit_float);
 }
 
 bool LoadShedPointImpl::shouldShedLoad() {
-  float unit_float_probability_shed_load = probability_shed_load_.load();
+  return shedWithProbability(probability_shed_load_.load(std::memory_order_relaxed));
+}
+
+bool LoadShedPointImpl::shouldShedRequest(const Http::RequestHeaderMap& headers) {
+  const float unit_float_probability_shed_load =
+      probability_shed_load_.load(std::memory_order_relaxed);
+  if (!low_priority_request_header_.has_value() ||
+      !headers.get(low_priority_request_header_.value()).empty()) {
+    return shedWithProbability(unit_float_probability_shed_load);
+  }
+  // The requests of normal priority are only shed once the triggers are saturated.
+  if (unit_float_probability_shed_load == 1.0f) {
+    shed_load_counter_.inc();
+    return true;
+  }
+  return false;
+}
+
+bool LoadShedPointImpl::shedWithProbability(float unit_float_probability_shed_load) {
+  // Skip drawing a random number in the common case of no pressure.
+  if (unit_float_probability_shed_load == 0.0f) {
+    return false;
+  }
   // This should be ok as we're using unit float which saturates at 1.0f.
   if (unit_float_probability_shed_load == 1.0f) {
     shed_load_counter_.inc();
@@ -20,6 +20,7 @@
 
 #include "absl/container/node_hash_map.h"
 #include "absl/container/node_hash_set.h"
+#include "absl/types/optional.h"
 
 namespace Envoy {
 namespace Server {
@@ -71,6 +72,7 @@ public:
   LoadShedPointImpl& operator=(const LoadShedPointImpl&) = delete;
 
   bool shouldShedLoad() override;
+  bool shouldShedRequest(const Http::RequestHeaderMap& headers) override;
 
   /**
    * Provide resource updates for the LoadShedPoint. It will update the
@@ -87,7 +89,11 @@ private:
   // Helper to handle updating the probability to shed load given the triggers.
   void updateProbabilityShedLoad();
 
+  // Returns whether to shed the load given the probability, once it has been loaded.
+  bool shedWithProbability(float unit_float_probability_shed_load);
+
   absl::flat_hash_map<std::string, TriggerPtr> triggers_;
+  const absl::optional<Http::LowerCaseString> low_priority_request_header_;
   std::atomic<float> probability_shed_load_{0};
   Stats::Gauge& scale_percent_;
   Stats::Counter& shed_load_counter_;
@@ -1,17 +1,24 @@
 #include "source/server/server.h"
 
+#include <atomic>
 #include <csignal>
 #include <cstdint>
 #include <ctime>
+#include <exception>
 #include <functional>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "envoy/admin/v3/config_dump.pb.h"
 #include "envoy/common/exception.h"
 #include "envoy/common/time.h"
 #include "envoy/config/bootstrap/v3/bootstrap.pb.h"
 #include "envoy/config/bootstrap/v3/bootstrap.pb.validate.h"
+#include "envoy/config/cluster/v3/cluster.pb.h"
+#include "envoy/config/cluster/v3/cluster.pb.validate.h"
+#include "envoy/config/listener/v3/listener.pb.h"
+#include "envoy/config/listener/v3/listener.pb.validate.h"
 #include "envoy/event/dispatcher.h"
 #include "envoy/event/signal.h"
 #include "envoy/event/timer.h"
@@ -26,6 +33,8 @@
 
 #include "source/common/api/api_impl.h"
 #include "source/common/api/os_sys_calls_impl.h"
+#include "source/common/buffer/slice_storage_pool.h"
+#include "source/common/common/cleanup.h"
 #include "source/common/common/enum_to_int.h"
 #include "source/common/common/mutex_tracer_impl.h"
 #include "source/common/common/utility.h"
@@ -56,6 +65,9 @@
 #include "source/server/regex_engine.h"
 #include "source/server/utils.h"
 
+#include "absl/strings/str_cat.h"
+#include "absl/synchronization/mutex.h"
+
 namespace Envoy {
 namespace Server {
 
@@ -94,9 +106,14 @@ InstanceBase::InstanceBase(Init::Manager& init_manager, const Options& options,
           process_context ? ProcessContextOptRef(std::ref(*process_context)) : absl::nullopt,
           watermark_factory)),
       dispatcher_(api_->allocateDispatcher("main_thread")),
-      access_log_manager_(options.fileFlushIntervalMsec(), *api_, *dispatcher_, access_log_lock,
-                          store),
-      handler_(getHandler(*dispatcher_)), worker_factory_(thread_local_, *api_, hooks),
+      // The access log files have a write shard per worker, and one for the main thread.
+      access_log_manager_({options.fileFlushIntervalMsec(),
+                           uint64_t{options.fileFlushMinSizeKb()} * 1024,
+                           uint64_t{options.fileMaxBufferedSizeKb()} * 1024,
+                           options.concurrency() + 1},
+                          *api_, *dispatcher_, access_log_lock, store),
+      handler_(getHandler(*dispatcher_)),
+      worker_factory_(thread_local_, *api_, hooks, options.pinWorkerThreadsEnabled()),
       mutex_tracer_(options.mutexTracingEnabled() ? &Envoy::MutexTracerImpl::getOrCreateTracer()
                                                   : nullptr),
       grpc_context_(store.symbolTable()), http_context_(store.symbolTable()),
@@ -108,7 +125,9 @@ InstanceBase::~InstanceBase() {
   terminate();
 
   // Stop logging to file before all the AccessLogManager and its dependencies are
-  // destructed to avoid crashing at shutdown.
+  // destructed to avoid crashing at shutdown. The asynchronous logger writes to the file, so it is
+  // stopped first, once it wrote the messages it buffered.
+  async_logger_.reset();
   file_logger_.reset();
 
   // Destruct the ListenerManager explicitly, before InstanceBase's local init_manager_ is
@@ -258,6 +277,18 @@ void InstanceBase::updateServerStats() {
                                        parent_stats.parent_memory_allocated_);
   server_stats_->memory_heap_size_.set(Memory::Stats::totalCurrentlyReserved());
   server_stats_->memory_physical_size_.set(Memory::Stats::totalPhysicalBytes());
+  const Buffer::SliceStoragePool::Stats slice_pool_stats = Buffer::SliceStoragePool::stats();
+  server_stats_->buffer_slice_cache_hits_.add(slice_pool_stats.hits_ -
+                                              server_stats_->buffer_slice_cache_hits_.value());
+  server_stats_->buffer_slice_cache_misses_.add(slice_pool_stats.misses_ -
+                                                server_stats_->buffer_slice_cache_misses_.value());
+  server_stats_->buffer_slice_cache_overflows_.add(
+      slice_pool_stats.overflows_ - server_stats_->buffer_slice_cache_overflows_.value());
+  server_stats_->buffer_slice_cache_bytes_.set(slice_pool_stats.cached_bytes_);
+  const auto memory_subsystem_bytes = Memory::Accounting::bytes();
+  for (size_t i = 0; i < Memory::Accounting::NumSubsystems; ++i) {
+    memory_subsystem_gauges_[i]->set(memory_subsystem_bytes[i]);
+  }
   if (!options().hotRestartDisabled()) {
     server_stats_->parent_connections_.set(parent_stats.parent_connections_);
   }
@@ -344,6 +375,93 @@ registerCustomInlineHeadersFromBootstrap(const envoy::config::bootstrap::v3::Boo
   return absl::OkStatus();
 }
 
+// Serializes the calls of the threads validating the static resources to the visitor.
+class SynchronizedValidationVisitor : public ProtobufMessage::ValidationVisitor {
+public:
+  explicit SynchronizedValidationVisitor(ProtobufMessage::ValidationVisitor& visitor)
+      : visitor_(visitor) {}
+
+  // ProtobufMessage::ValidationVisitor
+  absl::Status onUnknownField(absl::string_view description) override {
+    absl::MutexLock lock(&mutex_);
+    return visitor_.onUnknownField(description);
+  }
+  bool skipValidation() override {
+    absl::MutexLock lock(&mutex_);
+    return visitor_.skipValidation();
+  }
+  absl::Status onDeprecatedField(absl::string_view description, bool soft_deprecation) override {
+    absl::MutexLock lock(&mutex_);
+    return visitor_.onDeprecatedField(description, soft_deprecation);
+  }
+  void onWorkInProgress(absl::string_view description) override {
+    absl::MutexLock lock(&mutex_);
+    visitor_.onWorkInProgress(description);
+  }
+  OptRef<Runtime::Loader> runtime() override {
+    absl::MutexLock lock(&mutex_);
+    return visitor_.runtime();
+  }
+
+private:
+  ProtobufMessage::ValidationVisitor& visitor_;
+  absl::Mutex mutex_;
+};
+
+// Validates the static clusters and listeners of the bootstrap on as many threads, and the rest of
+// it on the calling thread. The error of the first invalid resource is thrown, as when validating
+// the bootstrap at once.
+void validateBootstrapConcurrently(envoy::config::bootstrap::v3::Bootstrap& bootstrap,
+                                   ProtobufMessage::ValidationVisitor& validation_visitor,
+                                   uint32_t threads, Thread::ThreadFactory& thread_factory) {
+  Protobuf::RepeatedPtrField<envoy::config::cluster::v3::Cluster> clusters;
+  Protobuf::RepeatedPtrField<envoy::config::listener::v3::Listener> listeners;
+  clusters.Swap(bootstrap.mutable_static_resources()->mutable_clusters());
+  listeners.Swap(bootstrap.mutable_static_resources()->mutable_listeners());
+  Cleanup restore_static_resources([&bootstrap, &clusters, &listeners]() {
+    clusters.Swap(bootstrap.mutable_static_resources()->mutable_clusters());
+    listeners.Swap(bootstrap.mutable_static_resources()->mutable_listeners());
+  });
+  MessageUtil::validate(bootstrap, validation_visitor);
+
+  SynchronizedValidationVisitor synchronized_visitor(validation_visitor);
+  const int resources = clusters.size() + listeners.size();
+  std::atomic<int> next_resource{0};
+  absl::Mutex mutex;
+  int first_invalid_resource = resources;
+  std::exception_ptr first_error;
+  auto validate_resources = [&]() {
+    for (int i = next_resource++; i < resources; i = next_resource++) {
+      TRY_NEEDS_AUDIT {
+        if (i < clusters.size()) {
+          MessageUtil::validate(clusters[i], synchronized_visitor);
+        } else {
+          MessageUtil::validate(listeners[i - clusters.size()], synchronized_visitor);
+        }
+      }
+      END_TRY
+      catch (const EnvoyException&) {
+        absl::MutexLock lock(&mutex);
+        if (i < first_invalid_resource) {
+          first_invalid_resource = i;
+          first_error = std::current_exception();
+        }
+      }
+    }
+  };
+  std::vector<Thread::ThreadPtr> validation_threads;
+  for (uint32_t i = 1; i < threads; ++i) {
+    validation_threads.push_back(thread_factory.createThread(validate_resources));
+  }
+  validate_resources();
+  for (Thread::ThreadPtr& thread : validation_threads) {
+    thread->join();
+  }
+  if (first_error != nullptr) {
+    std::rethrow_exception(first_error);
+  }
+}
+
 } // namespace
 
 absl::Status InstanceUtil::loadBootstrapConfig(
@@ -377,7 +495,13 @@ absl::Status InstanceUtil::loadBootstrapConfig(
   if (config_proto.ByteSizeLong() != 0) {
     bootstrap.MergeFrom(config_proto);
   }
-  MessageUtil::validate(bootstrap, validation_visitor);
+  if (bootstrap.static_resources_validation_threads() > 1) {
+    validateBootstrapConcurrently(bootstrap, validation_visitor,
+                                  bootstrap.static_resources_validation_threads(),
+                                  api.threadFactory());
+  } else {
+    MessageUtil::validate(bootstrap, validation_visitor);
+  }
   return absl::OkStatus();
 }
 
@@ -399,6 +523,11 @@ void InstanceBase::initialize(Network::Address::InstanceConstSharedPtr local_add
     if (!options_.logPath().empty()) {
       set_up_logger();
     }
+    if (options_.logAsyncBufferSizeKb() > 0) {
+      async_logger_ = std::make_unique<Logger::AsyncSinkDelegate>(
+          options_.logAsyncBufferSizeKb() * 1024, api_->threadFactory(),
+          Logger::Registry::getSink());
+    }
     restarter_.initialize(*dispatcher_, *this);
     drain_manager_ = component_factory.createDrainManager(*this);
     THROW_IF_NOT_OK(initializeOrThrow(std::move(local_address), component_factory));
@@ -441,6 +570,13 @@ absl::Status InstanceBase::initializeOrThrow(Network::Address::InstanceConstShar
       bootstrap_, options_, messageValidationContext().staticValidationVisitor(), *api_));
   bootstrap_config_update_time_ = time_source_.systemTime();
 
+  if (bootstrap_.xds_decoding_threads() > 1) {
+    // The main thread takes part in the decoding.
+    resource_decoder_pool_ = std::make_unique<ScopedInjectableLoader<Config::ResourceDecoderPool>>(
+        std::make_unique<Config::ResourceDecoderPool>(api_->threadFactory(),
+                                                      bootstrap_.xds_decoding_threads() - 1));
+  }
+
   if (bootstrap_.has_application_log_config()) {
     RETURN_IF_NOT_OK(
         Utility::assertExclusiveLogFormatMethod(options_, bootstrap_.application_log_config()));
@@ -522,12 +658,21 @@ absl::Status InstanceBase::initializeOrThrow(Network::Address::InstanceConstShar
               POOL_COUNTER_PREFIX(stats_store_, server_compilation_settings_stats_prefix),
               POOL_GAUGE_PREFIX(stats_store_, server_compilation_settings_stats_prefix),
               POOL_HISTOGRAM_PREFIX(stats_store_, server_compilation_settings_stats_prefix))});
+  for (size_t i = 0; i < Memory::Accounting::NumSubsystems; ++i) {
+    memory_subsystem_gauges_[i] = &stats_store_.gaugeFromString(
+        absl::StrCat(server_stats_prefix, "memory.",
+                     Memory::Accounting::name(static_cast<Memory::Subsystem>(i))),
+        Stats::Gauge::ImportMode::NeverImport);
+  }
   validation_context_.setCounters(server_stats_->static_unknown_fields_,
                                   server_stats_->dynamic_unknown_fields_,
                                   server_stats_->wip_protos_);
 
   memory_allocator_manager_ = std::make_unique<Memory::AllocatorManager>(
       *api_, *stats_store_.rootScope(), bootstrap_.memory_allocator_manager());
+  // Must be set before the worker threads start.
+  Buffer::SliceStoragePool::setMaxCachedBytesPerThread(
+      bootstrap_.memory_allocator_manager().per_thread_buffer_slice_cache_bytes());
 
   initialization_timer_ = std::make_unique<Stats::HistogramCompletableTimespanImpl>(
       server_stats_->initialization_time_ms_, timeSource());
@@ -747,7 +892,11 @@ absl::Status InstanceBase::initializeOrThrow(Network::Address::InstanceConstShar
   // thread local data per above. See MainImpl::initialize() for why ConfigImpl
   // is constructed as part of the InstanceBase and then populated once
   // cluster_manager_factory_ is available.
-  RETURN_IF_NOT_OK(config_.initialize(bootstrap_, *this, *cluster_manager_factory_));
+  {
+    // The thread local data set up by the configuration is delivered to each worker in one post.
+    ThreadLocal::ScopedBatch batch = thread_local_.batchUpdates(nullptr);
+    RETURN_IF_NOT_OK(config_.initialize(bootstrap_, *this, *cluster_manager_factory_));
+  }
 
   // Instruct the listener manager to create the LDS provider if needed. This must be done later
   // because various items do not yet exist when the listener manager is created.
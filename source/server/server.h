@@ -1,5 +1,6 @@
 #pragma once
 
+#include <array>
 #include <atomic>
 #include <chrono>
 #include <cstdint>
@@ -28,10 +29,12 @@
 #include "source/common/common/cleanup.h"
 #include "source/common/common/logger_delegates.h"
 #include "source/common/common/perf_tracing.h"
+#include "source/common/config/resource_decoder_pool.h"
 #include "source/common/grpc/async_client_manager_impl.h"
 #include "source/common/grpc/context_impl.h"
 #include "source/common/http/context_impl.h"
 #include "source/common/init/manager_impl.h"
+#include "source/common/memory/accounting.h"
 #include "source/common/memory/stats.h"
 #include "source/common/protobuf/message_validator_impl.h"
 #include "source/common/quic/quic_stat_names.h"
@@ -76,6 +79,10 @@ struct ServerCompilationSettingsStats {
   COUNTER(static_unknown_fields)                                                                   \
   COUNTER(wip_protos)                                                                              \
   COUNTER(dropped_stat_flushes)                                                                    \
+  COUNTER(buffer_slice_cache_hits)                                                                 \
+  COUNTER(buffer_slice_cache_misses)                                                               \
+  COUNTER(buffer_slice_cache_overflows)                                                            \
+  GAUGE(buffer_slice_cache_bytes, NeverImport)                                                     \
   GAUGE(concurrency, NeverImport)                                                                  \
   GAUGE(days_until_first_cert_expiring, NeverImport)                                               \
   GAUGE(seconds_until_first_ocsp_response_expiring, NeverImport)                                   \
@@ -370,6 +377,8 @@ private:
   time_t original_start_time_;
   Stats::StoreRoot& stats_store_;
   std::unique_ptr<ServerStats> server_stats_;
+  // The bytes attributed to each memory subsystem, indexed by subsystem.
+  std::array<Stats::Gauge*, Memory::Accounting::NumSubsystems> memory_subsystem_gauges_{};
   std::unique_ptr<CompilationSettings::ServerCompilationSettingsStats>
       server_compilation_settings_stats_;
   Assert::ActionRegistrationPtr assert_action_registration_;
@@ -378,6 +387,7 @@ private:
   Random::RandomGeneratorPtr random_generator_;
   envoy::config::bootstrap::v3::Bootstrap bootstrap_;
   Api::ApiPtr api_;
+  std::unique_ptr<ScopedInjectableLoader<Config::ResourceDecoderPool>> resource_decoder_pool_;
   // ssl_context_manager_ must come before dispatcher_, since ClusterInfo
   // references SslSocketFactory and is deleted on the main thread via the dispatcher.
   std::unique_ptr<Ssl::ContextManager> ssl_context_manager_;
@@ -400,6 +410,7 @@ private:
   std::unique_ptr<Server::GuardDog> worker_guard_dog_;
   bool terminated_{false};
   std::unique_ptr<Logger::FileSinkDelegate> file_logger_;
+  std::unique_ptr<Logger::AsyncSinkDelegate> async_logger_;
   ConfigTracker::EntryOwnerPtr config_tracker_entry_;
   SystemTime bootstrap_config_update_time_;
   Grpc::AsyncClientManagerPtr async_client_manager_;
@@ -39,16 +39,18 @@ WorkerPtr ProdWorkerFactory::createWorker(uint32_t index, OverloadManager& overl
       api_.allocateDispatcher(worker_name, overload_manager.scaledTimerFactory()));
   auto conn_handler = getHandler(*dispatcher, index, overload_manager, null_overload_manager);
   return std::make_unique<WorkerImpl>(tls_, hooks_, std::move(dispatcher), std::move(conn_handler),
-                                      overload_manager, api_, stat_names_);
+                                      overload_manager, api_, stat_names_,
+                                      cpu_topology_.workerCpu(index));
 }
 
 WorkerImpl::WorkerImpl(ThreadLocal::Instance& tls, ListenerHooks& hooks,
                        Event::DispatcherPtr&& dispatcher, Network::ConnectionHandlerPtr handler,
                        OverloadManager& overload_manager, Api::Api& api,
-                       WorkerStatNames& stat_names)
+                       WorkerStatNames& stat_names, absl::optional<uint32_t> cpu)
     : tls_(tls), hooks_(hooks), dispatcher_(std::move(dispatcher)), handler_(std::move(handler)),
       api_(api), reset_streams_counter_(
-                     api_.rootScope().counterFromStatName(stat_names.reset_high_memory_stream_)) {
+                     api_.rootScope().counterFromStatName(stat_names.reset_high_memory_stream_)),
+      cpu_(cpu) {
   tls_.registerThread(*dispatcher_, false);
   overload_manager.registerForAction(
       OverloadActionNames::get().StopAcceptingConnections, *dispatcher_,
@@ -114,7 +116,10 @@ void WorkerImpl::start(OptRef<GuardDog> guard_dog, const std::function<void()>&
   //
   // TODO(jmarantz): consider refactoring how this naming works so this naming
   // architecture is centralized, resulting in clearer names.
-  Thread::Options options{absl::StrCat("wrk:", dispatcher_->name())};
+  Thread::Options options{absl::StrCat("wrk:", dispatcher_->name()), cpu_};
+  if (cpu_.has_value()) {
+    ENVOY_LOG(debug, "pinning worker {} to CPU {}", dispatcher_->name(), cpu_.value());
+  }
   thread_ = api_.threadFactory().createThread(
       [this, guard_dog, cb]() -> void { threadRoutine(guard_dog, cb); }, options);
 }
@@ -10,6 +10,7 @@
 #include "envoy/server/worker.h"
 #include "envoy/thread_local/thread_local.h"
 
+#include "source/common/common/cpu_topology.h"
 #include "source/common/common/logger.h"
 #include "source/server/listener_hooks.h"
 
@@ -28,8 +29,15 @@ struct WorkerStatNames {
 
 class ProdWorkerFactory : public WorkerFactory, Logger::Loggable<Logger::Id::main> {
 public:
-  ProdWorkerFactory(ThreadLocal::Instance& tls, Api::Api& api, ListenerHooks& hooks)
-      : tls_(tls), api_(api), stat_names_(api.rootScope().symbolTable()), hooks_(hooks) {}
+  /**
+   * @param pin_worker_threads supplies whether every worker thread is pinned to a CPU of the
+   *        process, @see CpuTopology::workerCpu().
+   */
+  ProdWorkerFactory(ThreadLocal::Instance& tls, Api::Api& api, ListenerHooks& hooks,
+                    bool pin_worker_threads = false)
+      : tls_(tls), api_(api), stat_names_(api.rootScope().symbolTable()), hooks_(hooks),
+        cpu_topology_(pin_worker_threads ? CpuTopology::discover(api.fileSystem())
+                                         : CpuTopology()) {}
 
   // Server::WorkerFactory
   WorkerPtr createWorker(uint32_t index, OverloadManager& overload_manager,
@@ -41,6 +49,8 @@ private:
   Api::Api& api_;
   WorkerStatNames stat_names_;
   ListenerHooks& hooks_;
+  // Only holds CPUs when the worker threads are pinned.
+  const CpuTopology cpu_topology_;
 };
 
 /**
@@ -50,7 +60,8 @@ class WorkerImpl : public Worker, Logger::Loggable<Logger::Id::main> {
 public:
   WorkerImpl(ThreadLocal::Instance& tls, ListenerHooks& hooks, Event::DispatcherPtr&& dispatcher,
              Network::ConnectionHandlerPtr handler, OverloadManager& overload_manager,
-             Api::Api& api, WorkerStatNames& stat_names);
+             Api::Api& api, WorkerStatNames& stat_names,
+             absl::optional<uint32_t> cpu = absl::nullopt);
 
   // Server::Worker
   void addListener(absl::optional<uint64_t> overridden_listener, Network::ListenerConfig& listener,
@@ -81,6 +92,8 @@ private:
   Network::ConnectionHandlerPtr handler_;
   Api::Api& api_;
   Stats::Counter& reset_streams_counter_;
+  // The CPU that the worker thread is pinned to, if any.
+  const absl::optional<uint32_t> cpu_;
   Thread::ThreadPtr thread_;
   WatchDogSharedPtr watch_dog_;
 };
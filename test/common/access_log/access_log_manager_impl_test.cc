@@ -31,7 +31,8 @@ class AccessLogManagerImplTest : public testing::Test {
 protected:
   AccessLogManagerImplTest()
       : file_(new NiceMock<Filesystem::MockFile>), thread_factory_(Thread::threadFactoryForTest()),
-        access_log_manager_(timeout_40ms_, api_, dispatcher_, lock_, store_) {
+        access_log_manager_(AccessLogFileOptions{timeout_40ms_}, api_, dispatcher_, lock_,
+                            store_) {
     EXPECT_CALL(file_system_,
                 createFile(testing::Matcher<const Envoy::Filesystem::FilePathAndType&>(
                     Filesystem::FilePathAndType{Filesystem::DestinationType::File, "foo"})))
@@ -168,8 +169,8 @@ TEST_F(AccessLogManagerImplTest, FlushToLogFileOnDemand) {
   EXPECT_EQ(0UL, store_.counter("filesystem.flushed_by_timer").value());
 
   // The first write to a given file will start the flush thread. Because AccessManagerImpl::write
-  // holds the write_lock_ when the thread is started, the thread will flush on its first loop, once
-  // it obtains the write_lock_. Perform a write to get all that out of the way.
+  // starts the thread once its data is buffered, the thread will flush on its first loop. Perform a
+  // write to get all that out of the way.
   EXPECT_CALL(*file_, write_(_))
       .WillOnce(Invoke([](absl::string_view data) -> Api::IoCallSizeResult {
         return Filesystem::resultSuccess<ssize_t>(static_cast<ssize_t>(data.length()));
@@ -442,6 +443,31 @@ TEST_F(AccessLogManagerImplTest, BigDataChunkShouldBeFlushedWithoutTimer) {
   EXPECT_CALL(*file_, close_()).WillOnce(Return(ByMove(Filesystem::resultSuccess<bool>(true))));
 }
 
+TEST_F(AccessLogManagerImplTest, WritesBeyondMaxBufferedSizeAreDropped) {
+  AccessLogManagerImpl bounded_manager(AccessLogFileOptions{timeout_40ms_, 64 * 1024, 8, 1}, api_,
+                                       dispatcher_, lock_, store_);
+  EXPECT_CALL(*file_, open_(_)).WillOnce(Return(ByMove(Filesystem::resultSuccess<bool>(true))));
+  AccessLogFileSharedPtr log_file =
+      bounded_manager
+          .createAccessLog(Filesystem::FilePathAndType{Filesystem::DestinationType::File, "foo"})
+          .value();
+
+  EXPECT_CALL(*file_, write_(_))
+      .WillOnce(Invoke([](absl::string_view data) -> Api::IoCallSizeResult {
+        EXPECT_EQ(0, data.compare("test"));
+        return Filesystem::resultSuccess<ssize_t>(static_cast<ssize_t>(data.length()));
+      }));
+
+  log_file->write("test");
+  // The line doesn't fit in the buffers, whichever part of them was flushed already.
+  log_file->write("0123456789");
+  EXPECT_TRUE(file_->waitForEventCount(file_->num_writes_, 1));
+  EXPECT_EQ(1UL, store_.counter("filesystem.write_buffered").value());
+  EXPECT_EQ(1UL, store_.counter("filesystem.write_dropped").value());
+
+  EXPECT_CALL(*file_, close_()).WillOnce(Return(ByMove(Filesystem::resultSuccess<bool>(true))));
+}
+
 TEST_F(AccessLogManagerImplTest, ReopenAllFiles) {
   EXPECT_CALL(dispatcher_, createTimer_(_)).WillRepeatedly(ReturnNew<NiceMock<Event::MockTimer>>());
 
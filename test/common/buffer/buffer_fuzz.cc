@@ -98,6 +98,8 @@ public:
     add(src.start(), src.size_);
   }
 
+  void addShared(Buffer::Instance& data) override { add(data); }
+
   void prepend(absl::string_view data) override {
     FUZZ_ASSERT(start_ >= data.size());
     start_ -= data.size();
@@ -493,6 +493,107 @@ TEST(WatermarkBufferFactoryTest, DefaultsToEffectivelyNotTracking) {
   EXPECT_EQ(factory.bitshift(), 63); // Too large for any reasonable account size.
 }
 
+// Returns the configuration of a factory accounting the streams to their virtual host, with the
+// given budget.
+envoy::config::overload::v3::BufferFactoryConfig tenantConfig(uint64_t budget) {
+  envoy::config::overload::v3::BufferFactoryConfig config;
+  config.set_minimum_account_to_track_power_of_two(absl::bit_width(kMinimumBalanceToTrack));
+  config.set_tenant(envoy::config::overload::v3::BufferFactoryConfig::VIRTUAL_HOST);
+  config.set_tenant_memory_budget_bytes(budget);
+  return config;
+}
+
+// Sets the reset of the stream to release its account.
+void expectResetStream(Http::MockStreamResetHandler& handler,
+                       BufferMemoryAccountSharedPtr& account) {
+  EXPECT_CALL(handler, resetStream(_)).WillOnce(Invoke([&]() {
+    account->credit(getBalance(account));
+    account->clearDownstream();
+  }));
+}
+
+TEST(WatermarkBufferFactoryTest, AccountsTheBalancesToTheTenantOfTheRoute) {
+  WatermarkBufferFactory factory(tenantConfig(4 * kMinimumBalanceToTrack));
+  Http::MockStreamResetHandler handler;
+  Http::MockStreamResetHandler other_handler;
+  auto account = factory.createAccount(handler);
+  auto other_account = factory.createAccount(other_handler);
+  const auto& account_impl = static_cast<const BufferMemoryAccountImpl&>(*account);
+
+  // The balance charged before the route is known moves to the tenant.
+  account->charge(3 * kMinimumBalanceToTrack);
+  EXPECT_FALSE(account_impl.tenantOverBudget());
+  account->setRoute("vhost", "route");
+  other_account->setRoute("vhost", "other_route");
+  EXPECT_FALSE(account_impl.tenantOverBudget());
+
+  // The balances of the streams of the tenant add up.
+  other_account->charge(2 * kMinimumBalanceToTrack);
+  EXPECT_TRUE(account_impl.tenantOverBudget());
+  other_account->credit(kMinimumBalanceToTrack);
+  EXPECT_FALSE(account_impl.tenantOverBudget());
+
+  // A new route moves the balance to its tenant.
+  other_account->charge(kMinimumBalanceToTrack);
+  EXPECT_TRUE(account_impl.tenantOverBudget());
+  other_account->setRoute("other_vhost", "other_route");
+  EXPECT_FALSE(account_impl.tenantOverBudget());
+
+  other_account->credit(getBalance(other_account));
+  other_account->clearDownstream();
+  // The account is no longer accounted to the tenant once cleared.
+  account->setRoute("other_vhost", "route");
+  account->clearDownstream();
+  EXPECT_FALSE(account_impl.tenantOverBudget());
+  account->credit(getBalance(account));
+}
+
+TEST(WatermarkBufferFactoryTest, RoutesWithoutNameHaveNoTenant) {
+  auto config = tenantConfig(kMinimumBalanceToTrack);
+  config.set_tenant(envoy::config::overload::v3::BufferFactoryConfig::ROUTE);
+  WatermarkBufferFactory factory(config);
+  Http::MockStreamResetHandler handler;
+  auto account = factory.createAccount(handler);
+  const auto& account_impl = static_cast<const BufferMemoryAccountImpl&>(*account);
+
+  account->charge(2 * kMinimumBalanceToTrack);
+  account->setRoute("vhost", "");
+  EXPECT_FALSE(account_impl.tenantOverBudget());
+  account->setRoute("vhost", "route");
+  EXPECT_TRUE(account_impl.tenantOverBudget());
+
+  account->credit(getBalance(account));
+  account->clearDownstream();
+}
+
+TEST(WatermarkBufferFactoryTest, OnlyResetsStreamsOfTenantsOverBudget) {
+  WatermarkBufferFactory factory(tenantConfig(4 * kMinimumBalanceToTrack));
+  Http::MockStreamResetHandler largest_stream_to_reset;
+  Http::MockStreamResetHandler stream_to_reset;
+  Http::MockStreamResetHandler stream_of_other_tenant;
+
+  auto largest_account_to_reset = factory.createAccount(largest_stream_to_reset);
+  auto account_to_reset = factory.createAccount(stream_to_reset);
+  auto account_of_other_tenant = factory.createAccount(stream_of_other_tenant);
+  largest_account_to_reset->setRoute("abusive_vhost", "route");
+  account_to_reset->setRoute("abusive_vhost", "route");
+  account_of_other_tenant->setRoute("vhost", "route");
+
+  largest_account_to_reset->charge(4 * kMinimumBalanceToTrack);
+  account_to_reset->charge(kMinimumBalanceToTrack);
+  account_of_other_tenant->charge(2 * kMinimumBalanceToTrack);
+
+  expectResetStream(largest_stream_to_reset, largest_account_to_reset);
+  expectResetStream(stream_to_reset, account_to_reset);
+  EXPECT_CALL(stream_of_other_tenant, resetStream(_)).Times(0);
+  EXPECT_EQ(factory.resetAccountsGivenPressure(1.0), 1);
+
+  // Once the tenant is back within its budget, the streams are reset regardless of their tenant.
+  testing::Mock::VerifyAndClearExpectations(&stream_of_other_tenant);
+  expectResetStream(stream_of_other_tenant, account_of_other_tenant);
+  EXPECT_EQ(factory.resetAccountsGivenPressure(1.0), 2);
+}
+
 TEST(WatermarkBufferFactoryTest, ShouldOnlyResetAllStreamsGreatThanOrEqualToProvidedIndex) {
   TrackedWatermarkBufferFactory factory(absl::bit_width(kMinimumBalanceToTrack));
   Http::MockStreamResetHandler largest_stream_to_reset;
@@ -2,6 +2,7 @@
 #include "envoy/http/stream_reset_handler.h"
 
 #include "source/common/buffer/buffer_impl.h"
+#include "source/common/buffer/slice_storage_pool.h"
 #include "source/common/buffer/watermark_buffer.h"
 #include "source/common/common/assert.h"
 
@@ -320,6 +321,31 @@ BENCHMARK(bufferReserveCommit)
     ->Arg(64 * 1024)
     ->Arg(128 * 1024);
 
+// Test the churn of slices that are allocated by reserve+commit and add(), then freed by drain(),
+// on several threads at once. The first Arg is the number of bytes added per iteration, the second
+// Arg whether freed slice storage is cached in per-thread slice storage pools.
+static void bufferSliceChurn(benchmark::State& state) {
+  const uint64_t size = state.range(0);
+  Buffer::SliceStoragePool::setMaxCachedBytesPerThread(state.range(1) != 0 ? 1024 * 1024 : 0);
+  const std::string data(size, 'a');
+  for (auto _ : state) {
+    UNREFERENCED_PARAMETER(_);
+    Buffer::OwnedImpl buffer;
+    Buffer::Reservation reservation = buffer.reserveForReadWithLengthForTest(size);
+    reservation.commit(reservation.length());
+    buffer.add(data);
+    buffer.drain(buffer.length());
+  }
+  const Buffer::SliceStoragePool::Stats stats = Buffer::SliceStoragePool::threadStats();
+  state.counters["pool_hits"] = benchmark::Counter(stats.hits_, benchmark::Counter::kAvgIterations);
+  Buffer::SliceStoragePool::clearThreadCache();
+  Buffer::SliceStoragePool::setMaxCachedBytesPerThread(0);
+}
+BENCHMARK(bufferSliceChurn)
+    ->ArgsProduct({{4 * 1024, 16 * 1024, 64 * 1024}, {0, 1}})
+    ->Threads(1)
+    ->Threads(8);
+
 // Test the reserve+commit cycle, for the common case where the reserved space is
 // only partially used (and therefore the commit size is smaller than the reservation size).
 static void bufferReserveCommitPartial(benchmark::State& state) {
@@ -0,0 +1,70 @@
+#include <cstdio>
+#include <string>
+
+#include "source/common/buffer/buffer_impl.h"
+#include "source/common/buffer/mapped_file.h"
+
+#include "test/test_common/environment.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Buffer {
+namespace {
+
+#ifndef WIN32
+TEST(MappedFileTest, AddsRanges) {
+  const std::string path = TestEnvironment::writeStringToFileForTest("mapped", "0123456789");
+  absl::StatusOr<MappedFileConstSharedPtr> file = MappedFile::create(path);
+  ASSERT_TRUE(file.ok()) << file.status();
+  EXPECT_EQ("0123456789", (*file)->data());
+
+  OwnedImpl buffer;
+  MappedFile::addRange(*file, 0, 4, buffer);
+  MappedFile::addRange(*file, 8, 100, buffer);
+  MappedFile::addRange(*file, 10, 1, buffer);
+  EXPECT_EQ("012389", buffer.toString());
+  // The ranges reference the mapping rather than copies of it.
+  EXPECT_EQ((*file)->data().data(), buffer.frontSlice().mem_);
+}
+
+TEST(MappedFileTest, BuffersKeepTheFileMapped) {
+  const std::string path = TestEnvironment::writeStringToFileForTest("mapped", "old contents");
+  OwnedImpl buffer;
+  std::weak_ptr<const MappedFile> weak_file;
+  {
+    absl::StatusOr<MappedFileConstSharedPtr> file = MappedFile::create(path);
+    ASSERT_TRUE(file.ok()) << file.status();
+    weak_file = *file;
+    MappedFile::addRange(*file, 0, 3, buffer);
+  }
+  EXPECT_FALSE(weak_file.expired());
+
+  // A file replaced by another one keeps its contents while it's mapped.
+  const std::string new_path = TestEnvironment::writeStringToFileForTest("new", "new contents");
+  ASSERT_EQ(0, ::rename(new_path.c_str(), path.c_str()));
+  EXPECT_EQ("old", buffer.toString());
+  buffer.drain(3);
+  EXPECT_TRUE(weak_file.expired());
+}
+
+TEST(MappedFileTest, EmptyFile) {
+  const std::string path = TestEnvironment::writeStringToFileForTest("empty", "");
+  absl::StatusOr<MappedFileConstSharedPtr> file = MappedFile::create(path);
+  ASSERT_TRUE(file.ok()) << file.status();
+  EXPECT_TRUE((*file)->data().empty());
+  OwnedImpl buffer;
+  MappedFile::addRange(*file, 0, 1, buffer);
+  EXPECT_EQ(0, buffer.length());
+}
+
+TEST(MappedFileTest, Errors) {
+  EXPECT_FALSE(MappedFile::create(TestEnvironment::temporaryPath("missing")).ok());
+  EXPECT_EQ("can't map " + TestEnvironment::temporaryDirectory() + ": not a regular file",
+            MappedFile::create(TestEnvironment::temporaryDirectory()).status().message());
+}
+#endif
+
+} // namespace
+} // namespace Buffer
+} // namespace Envoy
@@ -77,6 +77,69 @@ TEST_F(OwnedImplTest, AddBufferFragmentWithCleanup) {
   EXPECT_TRUE(release_callback_called_);
 }
 
+TEST_F(OwnedImplTest, AddShared) {
+  const std::string content(5000, 'a');
+  Buffer::OwnedImpl source(content);
+  Buffer::OwnedImpl shared;
+  shared.addShared(source);
+  EXPECT_EQ(content, source.toString());
+  EXPECT_EQ(content, shared.toString());
+  EXPECT_EQ(source.frontSlice().mem_, shared.frontSlice().mem_);
+
+  // Nothing is written next to or in front of the shared content, small slices are copied.
+  source.add("b");
+  source.drain(1);
+  source.prepend("c");
+  shared.add("d");
+  EXPECT_EQ(3, source.getRawSlices().size());
+  EXPECT_EQ(absl::StrCat("c", content.substr(1), "b"), source.toString());
+  EXPECT_EQ(absl::StrCat(content, "d"), shared.toString());
+
+  // The content outlives the buffers it was shared from.
+  Buffer::OwnedImpl reshared;
+  reshared.addShared(shared);
+  source.drain(source.length());
+  shared.drain(shared.length());
+  EXPECT_EQ(absl::StrCat(content, "d"), reshared.toString());
+
+  // A mutable slice extracted from shared content is a copy.
+  const void* shared_mem = reshared.frontSlice().mem_;
+  auto slice = reshared.extractMutableFrontSlice();
+  const absl::Span<uint8_t> data = slice->getMutableData();
+  EXPECT_NE(shared_mem, data.data());
+  EXPECT_EQ(content, absl::string_view(reinterpret_cast<const char*>(data.data()), data.size()));
+}
+
+TEST_F(OwnedImplTest, AddSharedCopiesFragments) {
+  const std::string content(1024, 'a');
+  BufferFragmentImpl frag(content.data(), content.size(), nullptr);
+  Buffer::OwnedImpl source;
+  source.addBufferFragment(frag);
+  Buffer::OwnedImpl shared;
+  shared.addShared(source);
+  EXPECT_NE(source.frontSlice().mem_, shared.frontSlice().mem_);
+  EXPECT_EQ(content, shared.toString());
+}
+
+TEST_F(OwnedImplTest, MovePartialSliceShares) {
+  const std::string content(5000, 'a');
+  Buffer::OwnedImpl source(content);
+  const char* mem = static_cast<const char*>(source.frontSlice().mem_);
+  Buffer::OwnedImpl moved;
+  moved.move(source, 3000);
+  EXPECT_EQ(mem, moved.frontSlice().mem_);
+  EXPECT_EQ(mem + 3000, source.frontSlice().mem_);
+
+  // The slice is immutable in both buffers, and small parts of it are still copied.
+  source.add("b");
+  moved.add("c");
+  EXPECT_EQ(2, source.getRawSlices().size());
+  EXPECT_EQ(2, moved.getRawSlices().size());
+  moved.move(source, 100);
+  source.drain(source.length());
+  EXPECT_EQ(absl::StrCat(content.substr(2000), "c", content.substr(4900)), moved.toString());
+}
+
 TEST_F(OwnedImplTest, MoveBufferFragment) {
   Buffer::OwnedImpl buffer1;
   testing::MockFunction<void(const void*, size_t, const BufferFragmentImpl*)>
@@ -0,0 +1,124 @@
+#include <thread>
+
+#include "source/common/buffer/slice_storage_pool.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Buffer {
+namespace {
+
+class SliceStoragePoolTest : public testing::Test {
+protected:
+  ~SliceStoragePoolTest() override {
+    SliceStoragePool::clearThreadCache();
+    SliceStoragePool::setMaxCachedBytesPerThread(0);
+  }
+};
+
+TEST_F(SliceStoragePoolTest, DisabledByDefault) {
+  EXPECT_EQ(0, SliceStoragePool::maxCachedBytesPerThread());
+  const SliceStoragePool::Stats before = SliceStoragePool::threadStats();
+  SliceStoragePool::release(SliceStoragePool::allocate(SliceStoragePool::PageSize),
+                            SliceStoragePool::PageSize);
+  SliceStoragePool::release(SliceStoragePool::allocate(SliceStoragePool::PageSize),
+                            SliceStoragePool::PageSize);
+  const SliceStoragePool::Stats after = SliceStoragePool::threadStats();
+  EXPECT_EQ(before.hits_, after.hits_);
+  EXPECT_EQ(before.misses_, after.misses_);
+  EXPECT_EQ(0, after.cached_bytes_);
+}
+
+TEST_F(SliceStoragePoolTest, ReusesReleasedStorage) {
+  SliceStoragePool::setMaxCachedBytesPerThread(1024 * 1024);
+  const SliceStoragePool::Stats before = SliceStoragePool::threadStats();
+
+  SliceStoragePool::StoragePtr storage = SliceStoragePool::allocate(2 * SliceStoragePool::PageSize);
+  const uint8_t* address = storage.get();
+  SliceStoragePool::release(std::move(storage), 2 * SliceStoragePool::PageSize);
+  EXPECT_EQ(2 * SliceStoragePool::PageSize, SliceStoragePool::threadStats().cached_bytes_);
+
+  // Another size class does not get the cached storage.
+  SliceStoragePool::StoragePtr other = SliceStoragePool::allocate(SliceStoragePool::PageSize);
+  EXPECT_NE(address, other.get());
+  storage = SliceStoragePool::allocate(2 * SliceStoragePool::PageSize);
+  EXPECT_EQ(address, storage.get());
+
+  const SliceStoragePool::Stats after = SliceStoragePool::threadStats();
+  EXPECT_EQ(before.hits_ + 1, after.hits_);
+  EXPECT_EQ(before.misses_ + 2, after.misses_);
+  EXPECT_EQ(0, after.cached_bytes_);
+  SliceStoragePool::release(std::move(storage), 2 * SliceStoragePool::PageSize);
+  SliceStoragePool::release(std::move(other), SliceStoragePool::PageSize);
+  EXPECT_EQ(3 * SliceStoragePool::PageSize, SliceStoragePool::threadStats().cached_bytes_);
+}
+
+TEST_F(SliceStoragePoolTest, Overflow) {
+  SliceStoragePool::setMaxCachedBytesPerThread(SliceStoragePool::PageSize);
+  const SliceStoragePool::Stats before = SliceStoragePool::threadStats();
+
+  SliceStoragePool::StoragePtr first = SliceStoragePool::allocate(SliceStoragePool::PageSize);
+  SliceStoragePool::StoragePtr second = SliceStoragePool::allocate(SliceStoragePool::PageSize);
+  SliceStoragePool::release(std::move(first), SliceStoragePool::PageSize);
+  SliceStoragePool::release(std::move(second), SliceStoragePool::PageSize);
+
+  const SliceStoragePool::Stats after = SliceStoragePool::threadStats();
+  EXPECT_EQ(before.overflows_ + 1, after.overflows_);
+  EXPECT_EQ(SliceStoragePool::PageSize, after.cached_bytes_);
+}
+
+TEST_F(SliceStoragePoolTest, UncacheableSizes) {
+  SliceStoragePool::setMaxCachedBytesPerThread(1024 * 1024);
+  const SliceStoragePool::Stats before = SliceStoragePool::threadStats();
+
+  for (const uint64_t size : {uint64_t(0), SliceStoragePool::PageSize + 1,
+                              SliceStoragePool::MaxCachedSize + SliceStoragePool::PageSize}) {
+    SliceStoragePool::release(SliceStoragePool::allocate(size), size);
+    SliceStoragePool::release(SliceStoragePool::allocate(size), size);
+  }
+
+  const SliceStoragePool::Stats after = SliceStoragePool::threadStats();
+  EXPECT_EQ(before.hits_, after.hits_);
+  EXPECT_EQ(before.misses_, after.misses_);
+  EXPECT_EQ(before.overflows_, after.overflows_);
+  EXPECT_EQ(0, after.cached_bytes_);
+}
+
+TEST_F(SliceStoragePoolTest, ClearThreadCache) {
+  SliceStoragePool::setMaxCachedBytesPerThread(1024 * 1024);
+  SliceStoragePool::release(SliceStoragePool::allocate(SliceStoragePool::MaxCachedSize),
+                            SliceStoragePool::MaxCachedSize);
+  EXPECT_EQ(SliceStoragePool::MaxCachedSize, SliceStoragePool::threadStats().cached_bytes_);
+
+  SliceStoragePool::clearThreadCache();
+  EXPECT_EQ(0, SliceStoragePool::threadStats().cached_bytes_);
+  const SliceStoragePool::Stats before = SliceStoragePool::threadStats();
+  SliceStoragePool::release(SliceStoragePool::allocate(SliceStoragePool::MaxCachedSize),
+                            SliceStoragePool::MaxCachedSize);
+  EXPECT_EQ(before.misses_ + 1, SliceStoragePool::threadStats().misses_);
+}
+
+// The statistics of exited threads are retained in the aggregated statistics, and the storage
+// cached by exited threads is freed.
+TEST_F(SliceStoragePoolTest, StatsOfExitedThreads) {
+  SliceStoragePool::setMaxCachedBytesPerThread(1024 * 1024);
+  const SliceStoragePool::Stats before = SliceStoragePool::stats();
+
+  std::thread thread([] {
+    for (int i = 0; i < 3; ++i) {
+      SliceStoragePool::release(SliceStoragePool::allocate(SliceStoragePool::PageSize),
+                                SliceStoragePool::PageSize);
+    }
+    EXPECT_EQ(SliceStoragePool::PageSize, SliceStoragePool::stats().cached_bytes_);
+  });
+  thread.join();
+
+  const SliceStoragePool::Stats after = SliceStoragePool::stats();
+  EXPECT_EQ(before.hits_ + 2, after.hits_);
+  EXPECT_EQ(before.misses_ + 1, after.misses_);
+  EXPECT_EQ(before.cached_bytes_, after.cached_bytes_);
+}
+
+} // namespace
+} // namespace Buffer
+} // namespace Envoy
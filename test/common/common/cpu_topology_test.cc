@@ -0,0 +1,117 @@
+#include "source/common/common/cpu_topology.h"
+
+#include "test/mocks/filesystem/mocks.h"
+
+#if defined(__linux__)
+#include "test/mocks/api/mocks.h"
+#include "test/test_common/threadsafe_singleton_injector.h"
+#endif
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+using testing::_;
+using testing::DoAll;
+using testing::ElementsAre;
+using testing::Return;
+using testing::SetArgPointee;
+
+namespace Envoy {
+namespace {
+
+TEST(CpuTopologyTest, ParseList) {
+  EXPECT_THAT(CpuTopology::parseList("0-3,8,10-11\n").value(), ElementsAre(0, 1, 2, 3, 8, 10, 11));
+  EXPECT_THAT(CpuTopology::parseList("5,1-2,2").value(), ElementsAre(1, 2, 5));
+  EXPECT_THAT(CpuTopology::parseList("\n").value(), ElementsAre());
+
+  EXPECT_FALSE(CpuTopology::parseList("0-").has_value());
+  EXPECT_FALSE(CpuTopology::parseList("-1").has_value());
+  EXPECT_FALSE(CpuTopology::parseList("3-1").has_value());
+  EXPECT_FALSE(CpuTopology::parseList("0,,1").has_value());
+  EXPECT_FALSE(CpuTopology::parseList("a").has_value());
+  EXPECT_FALSE(CpuTopology::parseList("0-4294967295").has_value());
+  EXPECT_THAT(CpuTopology::parseList("4294967295").value(), ElementsAre(4294967295));
+}
+
+TEST(CpuTopologyTest, NumaNodes) {
+  const CpuTopology topology({6, 0, 4, 2}, {{0, 0}, {2, 0}, {4, 1}, {6, 1}});
+  EXPECT_THAT(topology.cpus(), ElementsAre(0, 2, 4, 6));
+  EXPECT_THAT(topology.numaNodes(), ElementsAre(0, 1));
+  EXPECT_EQ(1, topology.numaNode(4));
+  // A CPU of an unknown node is in node 0.
+  EXPECT_EQ(0, topology.numaNode(7));
+}
+
+TEST(CpuTopologyTest, WorkerCpu) {
+  EXPECT_FALSE(CpuTopology().workerCpu(0).has_value());
+
+  const CpuTopology topology({1, 3}, {});
+  EXPECT_EQ(1, topology.workerCpu(0));
+  EXPECT_EQ(3, topology.workerCpu(1));
+  EXPECT_EQ(1, topology.workerCpu(2));
+  EXPECT_THAT(topology.numaNodes(), ElementsAre(0));
+}
+
+#if defined(__linux__)
+class CpuTopologyDiscoverTest : public testing::Test {
+protected:
+  void expectAffinity(std::vector<uint32_t> cpus) {
+    cpu_set_t mask;
+    CPU_ZERO(&mask);
+    for (const uint32_t cpu : cpus) {
+      CPU_SET(cpu, &mask);
+    }
+    EXPECT_CALL(linux_os_sys_calls_, sched_getaffinity(0, _, _))
+        .WillOnce(DoAll(SetArgPointee<2>(mask), Return(Api::SysCallIntResult{0, 0})));
+  }
+
+  Api::MockLinuxOsSysCalls linux_os_sys_calls_;
+  TestThreadsafeSingletonInjector<Api::LinuxOsSysCallsImpl> linux_os_calls_{&linux_os_sys_calls_};
+  Filesystem::MockInstance file_system_;
+};
+
+TEST_F(CpuTopologyDiscoverTest, NumaNodes) {
+  expectAffinity({0, 1, 2, 3});
+  EXPECT_CALL(file_system_, fileReadToEnd("/sys/devices/system/node/online"))
+      .WillOnce(Return(std::string("0-1\n")));
+  EXPECT_CALL(file_system_, fileReadToEnd("/sys/devices/system/node/node0/cpulist"))
+      .WillOnce(Return(std::string("0-1\n")));
+  EXPECT_CALL(file_system_, fileReadToEnd("/sys/devices/system/node/node1/cpulist"))
+      .WillOnce(Return(std::string("2-3\n")));
+
+  const CpuTopology topology = CpuTopology::discover(file_system_);
+  EXPECT_THAT(topology.cpus(), ElementsAre(0, 1, 2, 3));
+  EXPECT_THAT(topology.numaNodes(), ElementsAre(0, 1));
+  EXPECT_EQ(0, topology.numaNode(1));
+  EXPECT_EQ(1, topology.numaNode(2));
+}
+
+TEST_F(CpuTopologyDiscoverTest, NoNumaSupport) {
+  expectAffinity({1, 3});
+  EXPECT_CALL(file_system_, fileReadToEnd("/sys/devices/system/node/online"))
+      .WillOnce(Return(absl::NotFoundError("no such file")));
+
+  const CpuTopology topology = CpuTopology::discover(file_system_);
+  EXPECT_THAT(topology.cpus(), ElementsAre(1, 3));
+  EXPECT_THAT(topology.numaNodes(), ElementsAre(0));
+}
+
+TEST_F(CpuTopologyDiscoverTest, AffinityFailure) {
+  EXPECT_CALL(linux_os_sys_calls_, sched_getaffinity(0, _, _))
+      .WillOnce(Return(Api::SysCallIntResult{-1, EPERM}));
+
+  const CpuTopology topology = CpuTopology::discover(file_system_);
+  EXPECT_TRUE(topology.cpus().empty());
+}
+
+TEST_F(CpuTopologyDiscoverTest, CurrentCpu) {
+  EXPECT_CALL(linux_os_sys_calls_, sched_getcpu()).WillOnce(Return(Api::SysCallIntResult{5, 0}));
+  EXPECT_EQ(5, CpuTopology::currentCpu());
+  EXPECT_CALL(linux_os_sys_calls_, sched_getcpu())
+      .WillOnce(Return(Api::SysCallIntResult{-1, ENOSYS}));
+  EXPECT_FALSE(CpuTopology::currentCpu().has_value());
+}
+#endif
+
+} // namespace
+} // namespace Envoy
@@ -3,12 +3,16 @@
 
 #include "source/common/common/json_escape_string.h"
 #include "source/common/common/logger.h"
+#include "source/common/common/logger_delegates.h"
 
 #include "test/mocks/common.h"
 #include "test/mocks/http/mocks.h"
 #include "test/mocks/network/mocks.h"
 #include "test/test_common/environment.h"
+#include "test/test_common/logging.h"
+#include "test/test_common/thread_factory_for_test.h"
 
+#include "absl/strings/str_cat.h"
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 
@@ -25,6 +29,53 @@ TEST(LoggerTest, StackingStderrSinkDelegate) {
   StderrSinkDelegate stacked(Envoy::Logger::Registry::getSink());
 }
 
+// Verifies that the messages logged by each thread to the asynchronous sink are written in order
+// to the previous delegate once flushed.
+TEST(AsyncSinkDelegateTest, WritesMessagesOnFlush) {
+  LogLevelSetter save_levels(spdlog::level::info);
+  LogRecordingSink recording_sink(Registry::getSink());
+  {
+    AsyncSinkDelegate async_sink(1024, Thread::threadFactoryForTest(), Registry::getSink());
+    std::thread([]() {
+      for (int i = 0; i < 3; ++i) {
+        ENVOY_LOG_MISC(info, "worker message {}", i);
+      }
+    }).join();
+    ENVOY_LOG_MISC(info, "main message");
+    Registry::getSink()->flush();
+
+    const std::vector<std::string> messages = recording_sink.messages();
+    ASSERT_EQ(4, messages.size());
+    for (int i = 0; i < 3; ++i) {
+      EXPECT_THAT(messages[i], HasSubstr(absl::StrCat("worker message ", i)));
+    }
+    EXPECT_THAT(messages[3], HasSubstr("main message"));
+    EXPECT_EQ(0, async_sink.droppedMessages());
+
+    // The messages left are written when the sink is destroyed.
+    ENVOY_LOG_MISC(info, "last message");
+  }
+  ENVOY_LOG_MISC(info, "synchronous message");
+  const std::vector<std::string> messages = recording_sink.messages();
+  ASSERT_EQ(6, messages.size());
+  EXPECT_THAT(messages[4], HasSubstr("last message"));
+  EXPECT_THAT(messages[5], HasSubstr("synchronous message"));
+}
+
+// Verifies that the messages which don't fit in the buffer of their thread are dropped and counted.
+TEST(AsyncSinkDelegateTest, DropsMessagesWhenFull) {
+  LogLevelSetter save_levels(spdlog::level::info);
+  LogRecordingSink recording_sink(Registry::getSink());
+  AsyncSinkDelegate async_sink(64, Thread::threadFactoryForTest(), Registry::getSink());
+  ENVOY_LOG_MISC(info, "a message too long for the buffer {}", std::string(64, 'a'));
+  EXPECT_EQ(1, async_sink.droppedMessages());
+  Registry::getSink()->flush();
+
+  const std::vector<std::string> messages = recording_sink.messages();
+  ASSERT_EQ(1, messages.size());
+  EXPECT_THAT(messages[0], HasSubstr("async log sink dropped 1 messages"));
+}
+
 TEST(LoggerEscapeTest, LinuxEOL) {
 #ifdef _WIN32
   EXPECT_EQ(DelegatingLogSink::escapeLogLine("line 1 \n line 2\n"), "line 1 \\n line 2\\n");
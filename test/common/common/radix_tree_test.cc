@@ -0,0 +1,99 @@
+#include "source/common/common/radix_tree.h"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+namespace Envoy {
+
+TEST(RadixTreeTest, AddItems) {
+  RadixTree<const char*> tree;
+  const char* cstr_a = "a";
+  const char* cstr_b = "b";
+  const char* cstr_c = "c";
+
+  EXPECT_TRUE(tree.empty());
+  EXPECT_TRUE(tree.add("foo", cstr_a));
+  EXPECT_TRUE(tree.add("bar", cstr_b));
+  EXPECT_FALSE(tree.empty());
+  EXPECT_EQ(cstr_a, tree.find("foo"));
+  EXPECT_EQ(cstr_b, tree.find("bar"));
+  EXPECT_EQ(nullptr, tree.find("fo"));
+  EXPECT_EQ(nullptr, tree.find("fooo"));
+
+  // overwrite_existing = false
+  EXPECT_FALSE(tree.add("foo", cstr_c, false));
+  EXPECT_EQ(cstr_a, tree.find("foo"));
+
+  // overwrite_existing = true
+  EXPECT_TRUE(tree.add("foo", cstr_c));
+  EXPECT_EQ(cstr_c, tree.find("foo"));
+}
+
+TEST(RadixTreeTest, SplitEdges) {
+  RadixTree<const char*> tree;
+  const char* cstr_a = "a";
+  const char* cstr_b = "b";
+  const char* cstr_c = "c";
+  const char* cstr_d = "d";
+
+  EXPECT_TRUE(tree.add("foobar", cstr_a));
+  // Splits the "foobar" edge with a value at the split point.
+  EXPECT_TRUE(tree.add("foo", cstr_b));
+  // Splits the "bar" edge without a value at the split point.
+  EXPECT_TRUE(tree.add("foobaz", cstr_c));
+  // Prepends a sibling.
+  EXPECT_TRUE(tree.add("a", cstr_d));
+
+  EXPECT_EQ(cstr_a, tree.find("foobar"));
+  EXPECT_EQ(cstr_b, tree.find("foo"));
+  EXPECT_EQ(cstr_c, tree.find("foobaz"));
+  EXPECT_EQ(cstr_d, tree.find("a"));
+  EXPECT_EQ(nullptr, tree.find("fooba"));
+  EXPECT_EQ(nullptr, tree.find("f"));
+
+  // A value can be added at an existing split point.
+  EXPECT_TRUE(tree.add("fooba", cstr_d, false));
+  EXPECT_EQ(cstr_d, tree.find("fooba"));
+}
+
+TEST(RadixTreeTest, LongestPrefix) {
+  RadixTree<const char*> tree;
+  const char* cstr_a = "a";
+  const char* cstr_b = "b";
+  const char* cstr_c = "c";
+  const char* cstr_d = "d";
+  const char* cstr_e = "e";
+  const char* cstr_f = "f";
+
+  EXPECT_TRUE(tree.add("foo", cstr_a));
+  EXPECT_TRUE(tree.add("bar", cstr_b));
+  EXPECT_TRUE(tree.add("baro", cstr_c));
+  EXPECT_TRUE(tree.add("foo/bar", cstr_d));
+  EXPECT_TRUE(tree.add("barn", cstr_e));
+  EXPECT_TRUE(tree.add("barp", cstr_f));
+
+  EXPECT_EQ(cstr_a, tree.findLongestPrefix("foo"));
+  EXPECT_EQ(cstr_a, tree.findLongestPrefix("foosball"));
+  EXPECT_EQ(cstr_a, tree.findLongestPrefix("foo/"));
+  EXPECT_EQ(cstr_a, tree.findLongestPrefix("foo/ba"));
+  EXPECT_EQ(cstr_d, tree.findLongestPrefix("foo/bar"));
+  EXPECT_EQ(cstr_d, tree.findLongestPrefix("foo/bar/zzz"));
+
+  EXPECT_EQ(cstr_b, tree.findLongestPrefix("bar"));
+  EXPECT_EQ(cstr_b, tree.findLongestPrefix("baritone"));
+  EXPECT_EQ(cstr_c, tree.findLongestPrefix("barometer"));
+  EXPECT_EQ(cstr_e, tree.findLongestPrefix("barnacle"));
+  EXPECT_EQ(cstr_f, tree.findLongestPrefix("barpomus"));
+
+  EXPECT_EQ(nullptr, tree.findLongestPrefix("toto"));
+  EXPECT_EQ(nullptr, tree.findLongestPrefix("fo"));
+  EXPECT_EQ(nullptr, tree.findLongestPrefix(" "));
+  EXPECT_EQ(nullptr, tree.findLongestPrefix(""));
+
+  // The empty key is a prefix of every key.
+  EXPECT_TRUE(tree.add("", cstr_a));
+  EXPECT_EQ(cstr_a, tree.findLongestPrefix("toto"));
+  EXPECT_EQ(cstr_a, tree.findLongestPrefix(""));
+}
+
+} // namespace Envoy
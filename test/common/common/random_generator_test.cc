@@ -68,6 +68,37 @@ TEST(UUID, SanityCheckOfUniqueness) {
   EXPECT_EQ(num_of_uuids, uuids.size());
 }
 
+TEST(Random, SanityCheckOfUniquenessFastRandom) {
+  std::set<uint64_t> results;
+  const size_t num_of_results = 1000000;
+
+  for (size_t i = 0; i < num_of_results; ++i) {
+    results.insert(RandomUtility::fastRandom());
+  }
+
+  EXPECT_EQ(num_of_results, results.size());
+}
+
+TEST(UUID, SanityCheckOfFastUUID) {
+  std::set<std::string> uuids;
+  const size_t num_of_uuids = 100000;
+
+  RandomUtility::UuidBuffer buffer;
+  for (size_t i = 0; i < num_of_uuids; ++i) {
+    const std::string uuid(RandomUtility::fastUuid(buffer));
+    ASSERT_EQ(36, uuid.length());
+    EXPECT_EQ('-', uuid[8]);
+    EXPECT_EQ('-', uuid[13]);
+    EXPECT_EQ('4', uuid[14]);
+    EXPECT_EQ('-', uuid[18]);
+    EXPECT_THAT(uuid[19], testing::AnyOf('8', '9', 'a', 'b'));
+    EXPECT_EQ('-', uuid[23]);
+    uuids.insert(uuid);
+  }
+
+  EXPECT_EQ(num_of_uuids, uuids.size());
+}
+
 TEST(Random, Bernoilli) {
   Random::RandomGeneratorImpl random;
 
@@ -0,0 +1,91 @@
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "source/common/common/sharded_limit.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace {
+
+TEST(ShardedLimitTest, AllocatesUpToMax) {
+  for (const uint64_t slack : {0, 1, 5, 100}) {
+    ShardedLimit limit(10, slack, 4);
+    EXPECT_EQ(10, limit.max());
+    EXPECT_TRUE(limit.tryAllocate(3));
+    EXPECT_EQ(3, limit.allocated());
+    for (int i = 0; i < 7; ++i) {
+      EXPECT_TRUE(limit.tryAllocate(1)) << slack;
+    }
+    EXPECT_FALSE(limit.tryAllocate(1)) << slack;
+    EXPECT_EQ(10, limit.allocated());
+
+    limit.release(2);
+    EXPECT_EQ(8, limit.allocated());
+    EXPECT_FALSE(limit.tryAllocate(3)) << slack;
+    EXPECT_TRUE(limit.tryAllocate(2)) << slack;
+    EXPECT_FALSE(limit.tryAllocate(1)) << slack;
+
+    limit.release(10);
+    EXPECT_EQ(0, limit.allocated());
+  }
+}
+
+// Test that a shard reserves up to its slack ahead, and gives the units released beyond its slack
+// back to the global pool.
+TEST(ShardedLimitTest, ReservesUpToSlack) {
+  ShardedLimit limit(10, 2, 1);
+  // 10 units are taken from the global pool, of which 2 stay reserved by the shard.
+  EXPECT_TRUE(limit.tryAllocate(8));
+  EXPECT_EQ(8, limit.allocated());
+  EXPECT_TRUE(limit.tryAllocate(2));
+  EXPECT_FALSE(limit.tryAllocate(1));
+
+  // 2 of the released units stay reserved by the shard, the 6 others go back to the global pool.
+  limit.release(8);
+  EXPECT_EQ(2, limit.allocated());
+  EXPECT_TRUE(limit.tryAllocate(6));
+  EXPECT_TRUE(limit.tryAllocate(2));
+  EXPECT_FALSE(limit.tryAllocate(1));
+  EXPECT_EQ(10, limit.allocated());
+}
+
+// Test that concurrent allocations never exceed the limit, and that the units can be allocated again
+// once released, except for the ones still reserved by the other shards.
+TEST(ShardedLimitTest, Multithreaded) {
+  constexpr uint64_t max = 100;
+  ShardedLimit limit(max, 4, 4);
+  std::atomic<uint64_t> allocated{0};
+  std::atomic<bool> exceeded{false};
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 8; ++t) {
+    threads.emplace_back([&] {
+      for (int i = 0; i < 10000; ++i) {
+        if (limit.tryAllocate(1)) {
+          if (allocated.fetch_add(1) + 1 > max) {
+            exceeded = true;
+          }
+          allocated.fetch_sub(1);
+          limit.release(1);
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  EXPECT_FALSE(exceeded);
+  EXPECT_EQ(0, limit.allocated());
+  uint64_t allocations = 0;
+  while (limit.tryAllocate(1)) {
+    ++allocations;
+  }
+  EXPECT_LE(allocations, max);
+  EXPECT_GE(allocations, max - 3 * 4);
+}
+
+} // namespace
+} // namespace Envoy
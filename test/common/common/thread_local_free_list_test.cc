@@ -0,0 +1,78 @@
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "source/common/common/thread_local_free_list.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace {
+
+class TestObject {
+public:
+  using FreeList = ThreadLocalFreeList<TestObject, 2>;
+  static void* operator new(size_t size) { return FreeList::allocate(size); }
+  static void operator delete(void* object, size_t size) { FreeList::release(object, size); }
+
+  virtual ~TestObject() = default;
+
+  uint64_t value_[4]{};
+};
+
+class DerivedTestObject : public TestObject {
+public:
+  uint64_t other_value_{};
+};
+
+class ThreadLocalFreeListTest : public testing::Test {
+protected:
+  // Starts each test without free blocks on the thread.
+  void SetUp() override {
+    while (TestObject::FreeList::freeBlocks() > 0) {
+      ::operator delete(TestObject::FreeList::allocate(sizeof(TestObject)));
+    }
+  }
+};
+
+TEST_F(ThreadLocalFreeListTest, ReusesReleasedMemory) {
+  auto object = std::make_unique<TestObject>();
+  void* memory = object.get();
+  object->value_[0] = 1;
+  object.reset();
+  EXPECT_EQ(1, TestObject::FreeList::freeBlocks());
+
+  // The object is constructed again in the memory of the released one.
+  object = std::make_unique<TestObject>();
+  EXPECT_EQ(memory, object.get());
+  EXPECT_EQ(0, object->value_[0]);
+  EXPECT_EQ(0, TestObject::FreeList::freeBlocks());
+}
+
+TEST_F(ThreadLocalFreeListTest, KeepsUpToTheMaxFreeBlocks) {
+  std::vector<std::unique_ptr<TestObject>> objects;
+  for (int i = 0; i < 4; ++i) {
+    objects.push_back(std::make_unique<TestObject>());
+  }
+  objects.clear();
+  EXPECT_EQ(2, TestObject::FreeList::freeBlocks());
+}
+
+TEST_F(ThreadLocalFreeListTest, DerivedObjectsUseTheHeap) {
+  std::unique_ptr<TestObject> object = std::make_unique<DerivedTestObject>();
+  object.reset();
+  EXPECT_EQ(0, TestObject::FreeList::freeBlocks());
+}
+
+TEST_F(ThreadLocalFreeListTest, ReleasedToTheDestroyingThread) {
+  auto object = std::make_unique<TestObject>();
+  std::thread thread([&object]() {
+    object.reset();
+    EXPECT_EQ(1, TestObject::FreeList::freeBlocks());
+  });
+  thread.join();
+  EXPECT_EQ(0, TestObject::FreeList::freeBlocks());
+}
+
+} // namespace
+} // namespace Envoy
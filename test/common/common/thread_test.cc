@@ -1,5 +1,9 @@
 #include <functional>
 
+#ifdef __linux__
+#include <sched.h>
+#endif
+
 #if defined(__linux__) || defined(__APPLE__)
 #include "source/common/common/posix/thread_impl.h"
 #endif
@@ -251,6 +255,32 @@ TEST_F(ThreadAsyncPtrTest, NameNotSpecifiedWait) {
   thread->join();
 }
 
+#ifdef __linux__
+TEST_F(ThreadAsyncPtrTest, PinnedToCpu) {
+  cpu_set_t allowed;
+  ASSERT_EQ(0, sched_getaffinity(0, sizeof(allowed), &allowed));
+  uint32_t cpu = 0;
+  while (!CPU_ISSET(cpu, &allowed)) {
+    ++cpu;
+  }
+
+  cpu_set_t pinned;
+  CPU_ZERO(&pinned);
+  absl::Notification notify;
+  auto thread = thread_factory_.createThread(
+      [&notify, &pinned]() {
+        notify.WaitForNotification();
+        sched_getaffinity(0, sizeof(pinned), &pinned);
+      },
+      Options{"pinned", cpu});
+  notify.Notify();
+  thread->join();
+
+  EXPECT_EQ(1, CPU_COUNT(&pinned));
+  EXPECT_TRUE(CPU_ISSET(cpu, &pinned));
+}
+#endif
+
 #if defined(__linux__) || defined(__APPLE__)
 TEST(PosixThreadTest, PThreadId) {
   auto thread_factory = PosixThreadFactory::create();
@@ -0,0 +1,52 @@
+#include <memory>
+
+#include "source/common/common/shared_token_bucket_impl.h"
+#include "source/common/common/token_bucket_impl.h"
+#include "source/common/event/real_time_system.h"
+
+#include "benchmark/benchmark.h"
+
+namespace Envoy {
+namespace {
+
+// The buckets never run out of tokens, so that only the cost of consuming them is measured.
+constexpr uint64_t MaxTokens = uint64_t(1) << 40;
+
+Event::RealTimeSystem time_system;
+// The buckets shared by the threads of the benchmarks.
+const auto mutex_bucket =
+    std::make_shared<SharedTokenBucketImpl>(MaxTokens, time_system, MaxTokens);
+const auto atomic_bucket =
+    std::make_shared<AtomicTokenBucketImpl>(MaxTokens, time_system, MaxTokens);
+
+// Measures the consumption from concurrent threads of the mutex-based shared token bucket.
+void bmSharedTokenBucketConsume(benchmark::State& state) {
+  for (auto _ : state) {
+    UNREFERENCED_PARAMETER(_);
+    benchmark::DoNotOptimize(mutex_bucket->consume(1, false));
+  }
+}
+BENCHMARK(bmSharedTokenBucketConsume)->ThreadRange(1, 16)->UseRealTime();
+
+// Measures the consumption from concurrent threads of the lock-free token bucket.
+void bmAtomicTokenBucketConsume(benchmark::State& state) {
+  for (auto _ : state) {
+    UNREFERENCED_PARAMETER(_);
+    benchmark::DoNotOptimize(atomic_bucket->consume(1, false));
+  }
+}
+BENCHMARK(bmAtomicTokenBucketConsume)->ThreadRange(1, 16)->UseRealTime();
+
+// Measures the consumption from concurrent threads, each leasing the tokens of the lock-free
+// token bucket. The argument is the size of the leases.
+void bmLeasedTokenBucketConsume(benchmark::State& state) {
+  LeasedTokenBucketImpl lease(atomic_bucket, state.range(0));
+  for (auto _ : state) {
+    UNREFERENCED_PARAMETER(_);
+    benchmark::DoNotOptimize(lease.consume(1, false));
+  }
+}
+BENCHMARK(bmLeasedTokenBucketConsume)->Arg(16)->Arg(256)->ThreadRange(1, 16)->UseRealTime();
+
+} // namespace
+} // namespace Envoy
@@ -1,4 +1,6 @@
 #include <chrono>
+#include <thread>
+#include <vector>
 
 #include "source/common/common/token_bucket_impl.h"
 
@@ -126,4 +128,132 @@ TEST_F(TokenBucketImplTest, YearlyMinRefillRate) {
   EXPECT_EQ(1, token_bucket.consume(1, false));
 }
 
+class AtomicTokenBucketImplTest : public testing::Test {
+protected:
+  Event::SimulatedTimeSystem time_system_;
+};
+
+// Verifies that AtomicTokenBucketImpl can consume tokens.
+TEST_F(AtomicTokenBucketImplTest, Consume) {
+  AtomicTokenBucketImpl token_bucket{10, time_system_, 1};
+
+  EXPECT_EQ(0, token_bucket.consume(20, false));
+  EXPECT_EQ(9, token_bucket.consume(9, false));
+
+  EXPECT_EQ(1, token_bucket.consume(1, false));
+
+  time_system_.setMonotonicTime(std::chrono::milliseconds(999));
+  EXPECT_EQ(0, token_bucket.consume(1, false));
+
+  time_system_.setMonotonicTime(std::chrono::milliseconds(5999));
+  EXPECT_EQ(0, token_bucket.consume(6, false));
+
+  time_system_.setMonotonicTime(std::chrono::milliseconds(6000));
+  EXPECT_EQ(6, token_bucket.consume(6, false));
+  EXPECT_EQ(0, token_bucket.consume(1, false));
+}
+
+// Verifies AtomicTokenBucketImpl's maximum capacity.
+TEST_F(AtomicTokenBucketImplTest, MaxBucketSize) {
+  AtomicTokenBucketImpl token_bucket{3, time_system_, 1};
+
+  EXPECT_EQ(3, token_bucket.consume(3, false));
+  time_system_.setMonotonicTime(std::chrono::seconds(10));
+  EXPECT_EQ(0, token_bucket.consume(4, false));
+  EXPECT_EQ(3, token_bucket.consume(3, false));
+}
+
+// Test partial consumption of tokens, and the time to the next token.
+TEST_F(AtomicTokenBucketImplTest, PartialConsumption) {
+  AtomicTokenBucketImpl token_bucket{16, time_system_, 16};
+  EXPECT_EQ(16, token_bucket.consume(18, true));
+  EXPECT_EQ(std::chrono::milliseconds(63), token_bucket.nextTokenAvailable());
+  time_system_.advanceTimeWait(std::chrono::milliseconds(62));
+  EXPECT_EQ(0, token_bucket.consume(1, true));
+  time_system_.advanceTimeWait(std::chrono::milliseconds(1));
+  std::chrono::milliseconds time_to_next_token(0);
+  EXPECT_EQ(1, token_bucket.consume(2, true, time_to_next_token));
+  // The fraction of a token left shortens the time to the next one.
+  EXPECT_EQ(std::chrono::milliseconds(62), time_to_next_token);
+  time_system_.advanceTimeWait(std::chrono::milliseconds(62));
+  EXPECT_EQ(1, token_bucket.consume(1, false));
+}
+
+// Test reset functionality.
+TEST_F(AtomicTokenBucketImplTest, Reset) {
+  AtomicTokenBucketImpl token_bucket{16, time_system_, 16};
+  token_bucket.maybeReset(1);
+  EXPECT_EQ(1, token_bucket.consume(2, true));
+  EXPECT_EQ(std::chrono::milliseconds(63), token_bucket.nextTokenAvailable());
+}
+
+// Test that only the first reset resets the bucket.
+TEST_F(AtomicTokenBucketImplTest, ResetOnce) {
+  AtomicTokenBucketImpl token_bucket{16, time_system_, 16};
+  token_bucket.maybeReset(1);
+  EXPECT_EQ(1, token_bucket.consume(2, true));
+  token_bucket.maybeReset(16);
+  EXPECT_EQ(0, token_bucket.consume(1, false));
+
+  // Nor through a lease.
+  auto shared = std::make_shared<AtomicTokenBucketImpl>(16, time_system_, 16);
+  LeasedTokenBucketImpl lease{shared, 4};
+  lease.maybeReset(2);
+  lease.maybeReset(16);
+  EXPECT_EQ(2, lease.consume(16, true));
+  EXPECT_EQ(0, shared->consume(1, false));
+}
+
+// Validate that a minimal refresh time is 1 year.
+TEST_F(AtomicTokenBucketImplTest, YearlyMinRefillRate) {
+  constexpr uint64_t seconds_per_year = 365 * 24 * 60 * 60;
+  AtomicTokenBucketImpl token_bucket{1, time_system_, 1.0 / (seconds_per_year * 2)};
+
+  EXPECT_EQ(1, token_bucket.consume(1, false));
+  time_system_.setMonotonicTime(std::chrono::seconds(seconds_per_year - 1));
+  EXPECT_EQ(0, token_bucket.consume(1, false));
+  time_system_.setMonotonicTime(std::chrono::seconds(seconds_per_year));
+  EXPECT_EQ(1, token_bucket.consume(1, false));
+}
+
+// Verifies that the threads sharing the bucket consume each token once.
+TEST_F(AtomicTokenBucketImplTest, ConcurrentConsumption) {
+  AtomicTokenBucketImpl token_bucket{10000, time_system_, 1};
+  std::atomic<uint64_t> consumed{0};
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 4; i++) {
+    threads.emplace_back([&token_bucket, &consumed] {
+      for (int j = 0; j < 5000; j++) {
+        consumed += token_bucket.consume(1, false);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(10000, consumed.load());
+}
+
+// Verifies that the leases consume the tokens of the shared bucket in batches.
+TEST_F(AtomicTokenBucketImplTest, Lease) {
+  auto shared = std::make_shared<AtomicTokenBucketImpl>(10, time_system_, 1);
+  LeasedTokenBucketImpl lease_1{shared, 4};
+  LeasedTokenBucketImpl lease_2{shared, 4};
+
+  EXPECT_EQ(1, lease_1.consume(1, false));
+  EXPECT_EQ(1, lease_2.consume(1, false));
+  // Each lease holds 3 more tokens, and the shared bucket has 2 left.
+  EXPECT_EQ(2, shared->consume(3, true));
+  EXPECT_EQ(3, lease_1.consume(5, true));
+  EXPECT_EQ(0, lease_1.consume(1, false));
+  EXPECT_EQ(std::chrono::milliseconds(1000), lease_1.nextTokenAvailable());
+  EXPECT_EQ(std::chrono::milliseconds(0), lease_2.nextTokenAvailable());
+  EXPECT_EQ(3, lease_2.consume(3, false));
+
+  // A larger consumption leases what it misses.
+  time_system_.setMonotonicTime(std::chrono::seconds(8));
+  EXPECT_EQ(6, lease_1.consume(6, false));
+  EXPECT_EQ(2, lease_2.consume(4, true));
+}
+
 } // namespace Envoy
@@ -1118,6 +1118,32 @@ TEST(TrieLookupTable, LongestPrefix) {
   EXPECT_EQ(nullptr, trie.findLongestPrefix(" "));
 }
 
+TEST(TrieLookupTable, MatchingPrefixes) {
+  TrieLookupTable<const char*> trie;
+  const char* cstr_a = "a";
+  const char* cstr_b = "b";
+  const char* cstr_c = "c";
+  const char* cstr_d = "d";
+
+  EXPECT_TRUE(trie.findMatchingPrefixes("foo").empty());
+
+  EXPECT_TRUE(trie.add("foo", cstr_a));
+  EXPECT_TRUE(trie.add("foo/bar", cstr_b));
+  EXPECT_TRUE(trie.add("fo", cstr_c));
+
+  EXPECT_THAT(trie.findMatchingPrefixes("foo/bar/zzz"), ElementsAre(cstr_c, cstr_a, cstr_b));
+  EXPECT_THAT(trie.findMatchingPrefixes("foo/ba"), ElementsAre(cstr_c, cstr_a));
+  EXPECT_THAT(trie.findMatchingPrefixes("fo"), ElementsAre(cstr_c));
+  EXPECT_TRUE(trie.findMatchingPrefixes("f").empty());
+  EXPECT_TRUE(trie.findMatchingPrefixes("bar").empty());
+
+  // The empty key is a prefix of every key.
+  EXPECT_TRUE(trie.add("", cstr_d));
+  EXPECT_THAT(trie.findMatchingPrefixes("foo"), ElementsAre(cstr_d, cstr_c, cstr_a));
+  EXPECT_THAT(trie.findMatchingPrefixes("bar"), ElementsAre(cstr_d));
+  EXPECT_THAT(trie.findMatchingPrefixes(""), ElementsAre(cstr_d));
+}
+
 TEST(InlineStorageTest, InlineString) {
   InlineStringPtr hello = InlineString::create("Hello, world!");
   EXPECT_EQ("Hello, world!", hello->toStringView());
@@ -5,6 +5,7 @@
 
 #include "envoy/http/header_map.h"
 
+#include "source/common/common/radix_tree.h"
 #include "source/common/common/utility.h"
 #include "source/common/http/headers.h"
 
@@ -70,6 +71,10 @@ static void bmTrieLookups(benchmark::State& s) {
   typedBmTrieLookups<TrieLookupTable<const void*>>(s);
 }
 
+static void bmRadixTreeLookups(benchmark::State& s) {
+  typedBmTrieLookups<RadixTree<const void*>>(s);
+}
+
 #define ADD_HEADER_TO_KEYS(name) keys.emplace_back(Http::Headers::get().name);
 static void bmTrieLookupsRequestHeaders(benchmark::State& s) {
   std::vector<std::string> keys;
@@ -85,5 +90,6 @@ static void bmTrieLookupsResponseHeaders(benchmark::State& s) {
 BENCHMARK(bmTrieLookupsRequestHeaders);
 BENCHMARK(bmTrieLookupsResponseHeaders);
 BENCHMARK(bmTrieLookups)->ArgsProduct({{10, 100, 1000, 10000}, {0, 8, 128}});
+BENCHMARK(bmRadixTreeLookups)->ArgsProduct({{10, 100, 1000, 10000}, {0, 8, 128}});
 
 } // namespace Envoy
@@ -0,0 +1,92 @@
+#include <atomic>
+#include <vector>
+
+#include "envoy/config/endpoint/v3/endpoint.pb.h"
+#include "envoy/config/endpoint/v3/endpoint.pb.validate.h"
+#include "envoy/service/discovery/v3/discovery.pb.h"
+
+#include "source/common/config/opaque_resource_decoder_impl.h"
+#include "source/common/config/resource_decoder_pool.h"
+#include "source/common/protobuf/message_validator_impl.h"
+
+#include "test/test_common/thread_factory_for_test.h"
+#include "test/test_common/utility.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Config {
+namespace {
+
+TEST(ResourceDecoderPoolTest, RunsEachIndexOnce) {
+  ResourceDecoderPool pool(Thread::threadFactoryForTest(), 3);
+  for (size_t count : {0, 1, 1000}) {
+    std::vector<std::atomic<uint32_t>> runs(count);
+    pool.run(count, [&runs](size_t i) { ++runs[i]; });
+    for (const auto& index_runs : runs) {
+      EXPECT_EQ(1, index_runs);
+    }
+  }
+}
+
+class DecodeResourcesTest : public testing::Test {
+public:
+  Protobuf::RepeatedPtrField<ProtobufWkt::Any> resources(size_t count) {
+    Protobuf::RepeatedPtrField<ProtobufWkt::Any> resources;
+    for (size_t i = 0; i < count; ++i) {
+      envoy::config::endpoint::v3::ClusterLoadAssignment cluster_load_assignment;
+      cluster_load_assignment.set_cluster_name(absl::StrCat("cluster_", i));
+      if (i % 2 == 0) {
+        resources.Add()->PackFrom(cluster_load_assignment);
+      } else {
+        // Half of them come in a Resource wrapper.
+        envoy::service::discovery::v3::Resource wrapper;
+        wrapper.set_name(absl::StrCat("cluster_", i));
+        wrapper.mutable_resource()->PackFrom(cluster_load_assignment);
+        resources.Add()->PackFrom(wrapper);
+      }
+    }
+    return resources;
+  }
+
+  ProtobufMessage::StrictValidationVisitorImpl validation_visitor_;
+  OpaqueResourceDecoderImpl<envoy::config::endpoint::v3::ClusterLoadAssignment> resource_decoder_{
+      validation_visitor_, "cluster_name"};
+  ScopedInjectableLoader<ResourceDecoderPool> pool_{
+      std::make_unique<ResourceDecoderPool>(Thread::threadFactoryForTest(), 3)};
+};
+
+// The resources are decoded as they are one at a time, with or without the pool.
+TEST_F(DecodeResourcesTest, DecodesInOrder) {
+  for (size_t count : {10, 200}) {
+    const std::vector<DecodedResourcePtr> decoded_resources =
+        decodeResources(resource_decoder_, resources(count), "1");
+    ASSERT_EQ(count, decoded_resources.size());
+    for (size_t i = 0; i < count; ++i) {
+      EXPECT_EQ(absl::StrCat("cluster_", i), decoded_resources[i]->name());
+      EXPECT_EQ("1", decoded_resources[i]->version());
+      EXPECT_TRUE(decoded_resources[i]->hasResource());
+      EXPECT_EQ(absl::StrCat("cluster_", i),
+                dynamic_cast<const envoy::config::endpoint::v3::ClusterLoadAssignment&>(
+                    decoded_resources[i]->resource())
+                    .cluster_name());
+    }
+  }
+}
+
+// The first resource failing to decode throws, whether it fails to unpack or to validate.
+TEST_F(DecodeResourcesTest, FirstFailureThrows) {
+  Protobuf::RepeatedPtrField<ProtobufWkt::Any> invalid_resources = resources(200);
+  invalid_resources[100].PackFrom(envoy::config::endpoint::v3::ClusterLoadAssignment());
+  invalid_resources[150].set_type_url("huh");
+  EXPECT_THROW(decodeResources(resource_decoder_, invalid_resources, "1"),
+               ProtoValidationException);
+
+  invalid_resources[50].set_type_url("huh");
+  EXPECT_THROW_WITH_REGEX(decodeResources(resource_decoder_, invalid_resources, "1"),
+                          EnvoyException, "Unable to unpack");
+}
+
+} // namespace
+} // namespace Config
+} // namespace Envoy
@@ -684,5 +684,34 @@ TEST_F(ConnPoolImplDispatcherBaseTest, PoolDrainsWithEarlyDataStreams) {
   closeStream();
 }
 
+TEST_F(ConnPoolImplDispatcherBaseTest, AdaptivePreconnect) {
+  ON_CALL(*cluster_, maxAdaptivePreconnectConnections).WillByDefault(Return(2));
+  max_connection_duration_opt_ = absl::nullopt;
+
+  // Without any connect latency sample, a single connection is created for the first stream.
+  newConnectingClient();
+  EXPECT_EQ(1, pool_.host()->cluster().trafficStats()->upstream_rq_preconnect_miss_.value());
+  time_system_.advanceTimeWait(std::chrono::milliseconds(10));
+  EXPECT_CALL(pool_, onPoolReady);
+  clients_.back()->onEvent(Network::ConnectionEvent::Connected);
+  closeStream();
+  EXPECT_EQ(ActiveClient::State::Ready, clients_.back()->state());
+
+  // As the streams arrive faster than a connection is established, the next stream preconnects
+  // up to the configured number of connections.
+  time_system_.advanceTimeWait(std::chrono::milliseconds(5));
+  EXPECT_CALL(pool_, onPoolReady);
+  EXPECT_CALL(pool_, instantiateActiveClient).Times(2);
+  EXPECT_EQ(nullptr, pool_.newStreamImpl(context_, /*can_send_early_data=*/false));
+  EXPECT_EQ(1, pool_.host()->cluster().trafficStats()->upstream_rq_preconnect_hit_.value());
+  EXPECT_EQ(3, clients_.size());
+  CHECK_STATE(1 /*active*/, 0 /*pending*/, 2 /*connecting capacity*/);
+
+  // Clean up.
+  --clients_.front()->active_streams_;
+  pool_.onStreamClosed(*clients_.front(), false);
+  pool_.drainConnectionsImpl(Envoy::ConnectionPool::DrainBehavior::DrainAndDelete);
+}
+
 } // namespace ConnectionPool
 } // namespace Envoy
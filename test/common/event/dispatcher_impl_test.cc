@@ -5,11 +5,13 @@
 
 #include "source/common/api/api_impl.h"
 #include "source/common/api/os_sys_calls_impl.h"
+#include "source/common/buffer/watermark_buffer.h"
 #include "source/common/common/lock_guard.h"
 #include "source/common/common/scope_tracker.h"
 #include "source/common/common/utility.h"
 #include "source/common/event/deferred_task.h"
 #include "source/common/event/dispatcher_impl.h"
+#include "source/common/event/scaled_range_timer_manager_impl.h"
 #include "source/common/event/timer_impl.h"
 #include "source/common/network/address_impl.h"
 #include "source/common/stats/isolated_store_impl.h"
@@ -283,6 +285,74 @@ TEST(DeferredDeleteTest, DeferredDelete) {
   dispatcher->clearDeferredDeleteList();
 }
 
+DispatcherPtr createDispatcher(
+    Event::TimeSystem& time_system,
+    const envoy::config::bootstrap::v3::Bootstrap::DeferredDeletion& deferred_deletion) {
+  return std::make_unique<DispatcherImpl>(
+      "test_thread", Thread::threadFactoryForTest(), time_system, Filesystem::fileSystemForTest(),
+      time_system,
+      [](Dispatcher& dispatcher) {
+        return std::make_unique<ScaledRangeTimerManagerImpl>(dispatcher);
+      },
+      std::make_shared<Buffer::WatermarkBufferFactory>(
+          envoy::config::overload::v3::BufferFactoryConfig()),
+      deferred_deletion);
+}
+
+// A bounded pass leaves the objects over the count to the next passes, which destroy them before
+// the objects deferred since.
+TEST(DeferredDeleteTest, CountBoundedPasses) {
+  InSequence s;
+  Event::SimulatedTimeSystem time_system;
+  envoy::config::bootstrap::v3::Bootstrap::DeferredDeletion deferred_deletion;
+  deferred_deletion.mutable_max_objects_per_pass()->set_value(2);
+  DispatcherPtr dispatcher = createDispatcher(time_system, deferred_deletion);
+  ReadyWatcher watcher1;
+  ReadyWatcher watcher2;
+  ReadyWatcher watcher3;
+  ReadyWatcher watcher4;
+
+  for (ReadyWatcher* watcher : {&watcher1, &watcher2, &watcher3}) {
+    dispatcher->deferredDelete(std::make_unique<TestDeferredDeletable>([watcher]() -> void {
+      watcher->ready();
+    }));
+  }
+  EXPECT_CALL(watcher1, ready());
+  EXPECT_CALL(watcher2, ready());
+  dispatcher->clearDeferredDeleteList();
+
+  dispatcher->deferredDelete(
+      std::make_unique<TestDeferredDeletable>([&]() -> void { watcher4.ready(); }));
+  EXPECT_CALL(watcher3, ready());
+  dispatcher->clearDeferredDeleteList();
+
+  EXPECT_CALL(watcher4, ready());
+  dispatcher->clearDeferredDeleteList();
+}
+
+// A bounded pass stops once it destroyed objects for its duration, and the loop destroys the rest
+// in its next iterations.
+TEST(DeferredDeleteTest, DurationBoundedPasses) {
+  Event::SimulatedTimeSystem time_system;
+  envoy::config::bootstrap::v3::Bootstrap::DeferredDeletion deferred_deletion;
+  deferred_deletion.mutable_max_duration_per_pass()->set_nanos(5000000);
+  DispatcherPtr dispatcher = createDispatcher(time_system, deferred_deletion);
+  int deleted = 0;
+
+  for (int i = 0; i < 3; ++i) {
+    dispatcher->deferredDelete(std::make_unique<TestDeferredDeletable>([&]() -> void {
+      time_system.setMonotonicTime(time_system.monotonicTime() + std::chrono::milliseconds(10));
+      ++deleted;
+    }));
+  }
+  dispatcher->clearDeferredDeleteList();
+  EXPECT_EQ(1, deleted);
+
+  dispatcher->run(Dispatcher::RunType::NonBlock);
+  dispatcher->run(Dispatcher::RunType::NonBlock);
+  EXPECT_EQ(3, deleted);
+}
+
 TEST(DeferredTaskTest, DeferredTask) {
   InSequence s;
   Api::ApiPtr api = Api::createApiForTest();
@@ -386,13 +456,59 @@ protected:
 // TODO(mergeconflict): We also need integration testing to validate that the expected histograms
 // are written when `enable_dispatcher_stats` is true. See issue #6582.
 TEST_F(DispatcherImplTest, InitializeStats) {
-  EXPECT_CALL(store_,
-              histogram("test.dispatcher.loop_duration_us", Stats::Histogram::Unit::Microseconds));
-  EXPECT_CALL(store_,
-              histogram("test.dispatcher.poll_delay_us", Stats::Histogram::Unit::Microseconds));
+  for (const std::string name :
+       {"deferred_delete_duration_us", "file_event_duration_us", "loop_duration_us",
+        "poll_delay_us", "post_callback_duration_us", "schedulable_callback_duration_us",
+        "timer_duration_us"}) {
+    EXPECT_CALL(store_,
+                histogram("test.dispatcher." + name, Stats::Histogram::Unit::Microseconds));
+  }
+  EXPECT_CALL(store_, histogram("test.dispatcher.deferred_delete_backlog",
+                                Stats::Histogram::Unit::Unspecified));
   dispatcher_->initializeStats(scope_, "test.");
 }
 
+// The time spent in each category of callbacks is recorded once per iteration of the loop.
+TEST_F(DispatcherImplTest, CallbackDurationStats) {
+  EXPECT_CALL(store_, deliverHistogramToSinks(_, _)).Times(testing::AnyNumber());
+  EXPECT_CALL(store_, deliverHistogramToSinks(
+                          testing::Property(&Stats::Metric::name,
+                                            "test.dispatcher.post_callback_duration_us"),
+                          _))
+      .Times(testing::AtLeast(1));
+  EXPECT_CALL(store_, deliverHistogramToSinks(
+                          testing::Property(&Stats::Metric::name,
+                                            "test.dispatcher.timer_duration_us"),
+                          _))
+      .Times(testing::AtLeast(1));
+  dispatcher_->initializeStats(scope_, "test.");
+
+  // The stats are enabled by a post callback, so the callbacks to record run once it ran. The
+  // durations are recorded before the loop polls again, so the test finishes from a timer of a
+  // later iteration.
+  TimerPtr timer_1;
+  TimerPtr timer_2;
+  dispatcher_->post([this, &timer_1, &timer_2]() {
+    timer_2 = dispatcher_->createTimer([this, &timer_1]() {
+      timer_1.reset();
+      {
+        Thread::LockGuard lock(mu_);
+        work_finished_ = true;
+      }
+      cv_.notifyOne();
+    });
+    timer_1 = dispatcher_->createTimer([this, &timer_2]() {
+      dispatcher_->post([&timer_2]() { timer_2->enableTimer(std::chrono::milliseconds(1)); });
+    });
+    timer_1->enableTimer(std::chrono::milliseconds(0));
+  });
+
+  Thread::LockGuard lock(mu_);
+  while (!work_finished_) {
+    cv_.wait(mu_);
+  }
+}
+
 TEST_F(DispatcherImplTest, Post) {
   dispatcher_->post([this]() {
     {
@@ -455,6 +571,41 @@ TEST_F(DispatcherImplTest, PostExecuteAndDestructOrder) {
   }
 }
 
+// The callbacks posted concurrently from several threads all run, in the order each thread posted
+// them.
+TEST_F(DispatcherImplTest, PostFromManyThreads) {
+  constexpr int Threads = 4;
+  constexpr int PostsPerThread = 1000;
+  std::vector<int> last_posted(Threads, -1);
+  int remaining = Threads * PostsPerThread;
+  std::vector<Thread::ThreadPtr> threads;
+  for (int i = 0; i < Threads; ++i) {
+    threads.push_back(api_->threadFactory().createThread([this, i, &last_posted, &remaining]() {
+      for (int j = 0; j < PostsPerThread; ++j) {
+        dispatcher_->post([this, i, j, &last_posted, &remaining]() {
+          EXPECT_EQ(j - 1, last_posted[i]);
+          last_posted[i] = j;
+          if (--remaining == 0) {
+            {
+              Thread::LockGuard lock(mu_);
+              work_finished_ = true;
+            }
+            cv_.notifyOne();
+          }
+        });
+      }
+    }));
+  }
+  for (auto& thread : threads) {
+    thread->join();
+  }
+
+  Thread::LockGuard lock(mu_);
+  while (!work_finished_) {
+    cv_.wait(mu_);
+  }
+}
+
 // Ensure that there is no deadlock related to calling a posted callback, or
 // destructing a closure when finished calling it.
 TEST_F(DispatcherImplTest, RunPostCallbacksLocking) {
@@ -472,8 +623,8 @@ TEST_F(DispatcherImplTest, RunPostCallbacksLocking) {
     // Block dispatcher first to ensure that both posted events below are handled
     // by a single call to runPostCallbacks().
     //
-    // This also ensures that the post_lock_ is not held while callbacks are called,
-    // or else this would deadlock.
+    // This also ensures that the posts from the callbacks don't wait on the run of the
+    // callbacks, or else this would deadlock.
     Thread::LockGuard lock(mu_);
     dispatcher_->post([this]() { Thread::LockGuard lock(mu_); });
 
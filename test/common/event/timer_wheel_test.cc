@@ -0,0 +1,146 @@
+#include <chrono>
+#include <functional>
+#include <vector>
+
+#include "source/common/event/timer_wheel.h"
+
+#include "test/test_common/simulated_time_system.h"
+#include "test/test_common/utility.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Event {
+namespace {
+
+class TestEntry : public TimerWheel::Entry {
+public:
+  explicit TestEntry(TimeSource& time_source) : time_source_(time_source) {}
+
+  // TimerWheel::Entry
+  void onWheelTimer() override {
+    fire_times_.push_back(time_source_.monotonicTime());
+    if (callback_) {
+      callback_();
+    }
+  }
+
+  TimeSource& time_source_;
+  std::vector<MonotonicTime> fire_times_;
+  std::function<void()> callback_;
+};
+
+class TimerWheelTest : public testing::Test, public TestUsingSimulatedTime {
+public:
+  TimerWheelTest()
+      : api_(Api::createApiForTest()), dispatcher_(api_->allocateDispatcher("test_thread")),
+        start_(simTime().monotonicTime()), wheel_(*dispatcher_, std::chrono::milliseconds(10)) {}
+
+  void advance(MonotonicTime::duration duration) {
+    simTime().advanceTimeAndRun(duration, *dispatcher_, Dispatcher::RunType::NonBlock);
+  }
+
+  Api::ApiPtr api_;
+  DispatcherPtr dispatcher_;
+  const MonotonicTime start_;
+  TimerWheel wheel_;
+};
+
+TEST_F(TimerWheelTest, FiresOnTheTick) {
+  TestEntry entry_1(simTime());
+  TestEntry entry_2(simTime());
+  TestEntry entry_3(simTime());
+  wheel_.schedule(entry_1, std::chrono::milliseconds(15));
+  wheel_.schedule(entry_2, std::chrono::milliseconds(20));
+  wheel_.schedule(entry_3, std::chrono::milliseconds(25));
+  EXPECT_EQ(3, wheel_.size());
+
+  advance(std::chrono::milliseconds(19));
+  EXPECT_TRUE(entry_1.fire_times_.empty());
+
+  // The expiries are rounded up to the tick, and the entries of a tick fire together.
+  advance(std::chrono::milliseconds(1));
+  EXPECT_EQ(std::vector<MonotonicTime>{start_ + std::chrono::milliseconds(20)},
+            entry_1.fire_times_);
+  EXPECT_EQ(entry_1.fire_times_, entry_2.fire_times_);
+  EXPECT_FALSE(entry_1.scheduled());
+  EXPECT_TRUE(entry_3.scheduled());
+
+  advance(std::chrono::milliseconds(10));
+  EXPECT_EQ(std::vector<MonotonicTime>{start_ + std::chrono::milliseconds(30)},
+            entry_3.fire_times_);
+  EXPECT_EQ(0, wheel_.size());
+}
+
+TEST_F(TimerWheelTest, CancelAndReschedule) {
+  TestEntry entry_1(simTime());
+  TestEntry entry_2(simTime());
+  wheel_.schedule(entry_1, std::chrono::milliseconds(10));
+  wheel_.schedule(entry_2, std::chrono::milliseconds(10));
+  wheel_.cancel(entry_1);
+  wheel_.schedule(entry_2, std::chrono::milliseconds(50));
+  EXPECT_FALSE(entry_1.scheduled());
+  EXPECT_EQ(1, wheel_.size());
+
+  advance(std::chrono::milliseconds(40));
+  EXPECT_TRUE(entry_1.fire_times_.empty());
+  EXPECT_TRUE(entry_2.fire_times_.empty());
+  advance(std::chrono::milliseconds(10));
+  EXPECT_EQ(1, entry_2.fire_times_.size());
+
+  // Cancelling an entry which isn't scheduled does nothing.
+  wheel_.cancel(entry_1);
+  wheel_.cancel(entry_2);
+  EXPECT_EQ(0, wheel_.size());
+}
+
+// The entries expiring far away move down the levels of the wheel, and still fire on their tick.
+TEST_F(TimerWheelTest, FarExpiries) {
+  const std::vector<std::chrono::milliseconds> durations = {
+      std::chrono::seconds(1), std::chrono::minutes(1), std::chrono::hours(1),
+      std::chrono::hours(24 * 30), std::chrono::hours(24 * 365)};
+  std::vector<std::unique_ptr<TestEntry>> entries;
+  for (const auto duration : durations) {
+    entries.push_back(std::make_unique<TestEntry>(simTime()));
+    wheel_.schedule(*entries.back(), duration);
+  }
+  for (size_t i = 0; i < durations.size(); ++i) {
+    advance(durations[i] - (simTime().monotonicTime() - start_) - std::chrono::milliseconds(1));
+    EXPECT_TRUE(entries[i]->fire_times_.empty());
+    advance(std::chrono::milliseconds(1));
+    EXPECT_EQ(std::vector<MonotonicTime>{start_ + durations[i]}, entries[i]->fire_times_);
+  }
+  EXPECT_EQ(0, wheel_.size());
+}
+
+// The entries may schedule and cancel entries, including those expiring on the same tick.
+TEST_F(TimerWheelTest, ScheduleFromCallbacks) {
+  TestEntry entry_1(simTime());
+  TestEntry entry_2(simTime());
+  TestEntry entry_3(simTime());
+  entry_1.callback_ = [&]() {
+    wheel_.cancel(entry_2);
+    wheel_.schedule(entry_1, std::chrono::milliseconds(100));
+    wheel_.schedule(entry_3, std::chrono::milliseconds(0));
+  };
+  wheel_.schedule(entry_1, std::chrono::milliseconds(10));
+  wheel_.schedule(entry_2, std::chrono::milliseconds(10));
+
+  advance(std::chrono::milliseconds(10));
+  EXPECT_EQ(1, entry_1.fire_times_.size());
+  EXPECT_TRUE(entry_2.fire_times_.empty());
+  EXPECT_TRUE(entry_3.fire_times_.empty());
+
+  // The entry scheduled without delay fires on the next tick.
+  advance(std::chrono::milliseconds(10));
+  EXPECT_EQ(1, entry_3.fire_times_.size());
+
+  entry_1.callback_ = nullptr;
+  advance(std::chrono::milliseconds(90));
+  EXPECT_EQ(2, entry_1.fire_times_.size());
+  EXPECT_EQ(0, wheel_.size());
+}
+
+} // namespace
+} // namespace Event
+} // namespace Envoy
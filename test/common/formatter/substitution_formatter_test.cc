@@ -4326,6 +4326,41 @@ TEST(SubstitutionFormatterTest, JsonFormatterWithOrderedPropertiesTest) {
   EXPECT_EQ(out_json, expected);
 }
 
+TEST(SubstitutionFormatterTest, JsonFormatterStreamsTypedValues) {
+  NiceMock<StreamInfo::MockStreamInfo> stream_info;
+  Http::TestRequestHeaderMapImpl request_header;
+  Http::TestResponseHeaderMapImpl response_header;
+  Http::TestResponseTrailerMapImpl response_trailer;
+  std::string body;
+
+  HttpFormatterContext formatter_context(&request_header, &response_header, &response_trailer,
+                                         body);
+
+  absl::optional<Http::Protocol> protocol = Http::Protocol::Http11;
+  EXPECT_CALL(stream_info, protocol()).WillRepeatedly(Return(protocol));
+  MockTimeSystem time_system;
+  EXPECT_CALL(time_system, monotonicTime)
+      .WillOnce(Return(MonotonicTime(std::chrono::nanoseconds(5000000))));
+  stream_info.downstream_timing_.onLastDownstreamRxByteReceived(time_system);
+
+  ProtobufWkt::Struct key_mapping;
+  TestUtility::loadFromYaml(R"EOF(
+    request_duration: '%REQUEST_DURATION%'
+    'quoted"key': plain
+    list: ['%PROTOCOL%', 5, {nested: '%PROTOCOL% %REQ(missing)%'}, {}]
+    percent: '100%%'
+    missing: '%REQ(missing)%'
+  )EOF",
+                            key_mapping);
+  JsonFormatterImpl formatter(key_mapping, true, false, false);
+
+  // The properties are sorted, and streamed without building a Struct.
+  const std::string expected = "{\"list\":[\"HTTP/1.1\",5,{\"nested\":\"HTTP/1.1 -\"},{}],"
+                               "\"missing\":null,\"percent\":\"100%\",\"quoted\\\"key\":\"plain\","
+                               "\"request_duration\":5}\n";
+  EXPECT_EQ(expected, formatter.formatWithContext(formatter_context, stream_info));
+}
+
 TEST(SubstitutionFormatterTest, CompositeFormatterSuccess) {
   Http::TestRequestHeaderMapImpl request_header{{"first", "GET"}, {":path", "/"}};
   Http::TestResponseHeaderMapImpl response_header{{"second", "PUT"}, {"test", "test"}};
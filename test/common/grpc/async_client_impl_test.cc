@@ -311,6 +311,56 @@ TEST_F(EnvoyAsyncClientImplTest, StreamHttpClientException) {
   EXPECT_EQ(grpc_stream, nullptr);
 }
 
+// Validate that the corked messages are written to the HTTP stream at once, at the end of the
+// iteration or before the next message which isn't corked.
+TEST_F(EnvoyAsyncClientImplTest, StreamCorkedMessages) {
+  NiceMock<MockAsyncStreamCallbacks<helloworld::HelloReply>> grpc_callbacks;
+  Http::MockAsyncClientStream http_stream;
+  EXPECT_CALL(http_client_, start(_, _)).WillOnce(Return(&http_stream));
+  EXPECT_CALL(http_stream, sendHeaders(_, _));
+  auto grpc_stream =
+      grpc_client_->start(*method_descriptor_, grpc_callbacks, Http::AsyncClient::StreamOptions());
+  ASSERT_NE(grpc_stream, nullptr);
+
+  helloworld::HelloRequest request;
+  request.set_name("corked");
+  const uint64_t frame_size = GRPC_FRAME_HEADER_SIZE + request.ByteSizeLong();
+  auto* flush = new NiceMock<Event::MockSchedulableCallback>(&http_client_.dispatcher_);
+  EXPECT_CALL(http_stream, sendData(_, _)).Times(0);
+  EXPECT_CALL(*flush, scheduleCallbackCurrentIteration());
+  grpc_stream->sendMessageCorked(request);
+  grpc_stream->sendMessageCorked(request);
+  testing::Mock::VerifyAndClearExpectations(&http_stream);
+
+  EXPECT_CALL(http_stream, sendData(_, false))
+      .WillOnce(Invoke([frame_size](Buffer::Instance& data, bool) {
+        EXPECT_EQ(2 * frame_size, data.length());
+        data.drain(data.length());
+      }));
+  flush->invokeCallback();
+
+  // A message which isn't corked is sent after the corked ones.
+  EXPECT_CALL(*flush, scheduleCallbackCurrentIteration());
+  grpc_stream->sendMessageCorked(request);
+  {
+    testing::InSequence s;
+    EXPECT_CALL(http_stream, sendData(_, false))
+        .WillOnce(Invoke([frame_size](Buffer::Instance& data, bool) {
+          EXPECT_EQ(frame_size, data.length());
+          data.drain(data.length());
+        }));
+    EXPECT_CALL(http_stream, sendData(_, true))
+        .WillOnce(Invoke([frame_size](Buffer::Instance& data, bool) {
+          EXPECT_EQ(frame_size, data.length());
+        }));
+  }
+  grpc_stream->sendMessage(request, true);
+  EXPECT_FALSE(flush->enabled_);
+
+  EXPECT_CALL(http_stream, reset());
+  grpc_stream->resetStream();
+}
+
 } // namespace
 } // namespace Grpc
 } // namespace Envoy
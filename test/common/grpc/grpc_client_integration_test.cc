@@ -171,6 +171,70 @@ TEST_P(GrpcClientIntegrationTest, MultiStream) {
   dispatcher_helper_.runDispatcher();
 }
 
+// Validate that the replies of several streams are all received when the Google gRPC client
+// delivers their completions to the dispatcher in a batch.
+TEST_P(GrpcClientIntegrationTest, MultiStreamCompletionBatch) {
+  initialize();
+  std::vector<HelloworldStreamPtr> streams;
+  for (int i = 0; i < 4; ++i) {
+    streams.push_back(createStream(empty_metadata_));
+    streams.back()->sendRequest();
+  }
+  // The dispatcher doesn't run while the server replies, so the completions of the streams are
+  // pending together when it does.
+  for (auto& stream : streams) {
+    stream->sendServerInitialMetadata(empty_metadata_);
+    stream->sendReply();
+    stream->sendServerTrailers(Status::WellKnownGrpcStatus::Ok, "", empty_metadata_);
+  }
+  dispatcher_helper_.runDispatcher();
+}
+
+// Validate that a stream reset while its completions are pending, next to those of another
+// stream, gets none of them.
+TEST_P(GrpcClientIntegrationTest, ResetStreamWithPendingCompletions) {
+  initialize();
+  auto stream_0 = createStream(empty_metadata_);
+  auto stream_1 = createStream(empty_metadata_);
+  stream_0->sendRequest();
+  stream_1->sendRequest();
+
+  EXPECT_CALL(*stream_0, onReceiveInitialMetadata_(_)).Times(0);
+  EXPECT_CALL(*stream_0, onRemoteClose(_, _)).Times(0);
+  stream_0->fake_stream_->startGrpcStream(false);
+  stream_0->fake_stream_->encodeHeaders(Http::TestResponseHeaderMapImpl{{":status", "200"}},
+                                        false);
+  stream_1->sendServerInitialMetadata(empty_metadata_);
+  stream_1->sendReply();
+  stream_1->sendServerTrailers(Status::WellKnownGrpcStatus::Ok, "", empty_metadata_);
+
+  stream_0->grpc_stream_->resetStream();
+  dispatcher_helper_.runDispatcher();
+  ASSERT_TRUE(stream_0->fake_stream_->waitForReset());
+}
+
+// Validate that a client destruction while the completions of its streams are pending cleans up
+// appropriately.
+TEST_P(GrpcClientIntegrationTest, ClientDestructWithPendingCompletions) {
+  initialize();
+  auto stream_0 = createStream(empty_metadata_);
+  auto stream_1 = createStream(empty_metadata_);
+  stream_0->sendRequest();
+  stream_1->sendRequest();
+  for (HelloworldStream* stream : {stream_0.get(), stream_1.get()}) {
+    EXPECT_CALL(*stream, onReceiveInitialMetadata_(_)).Times(0);
+    EXPECT_CALL(*stream, onRemoteClose(_, _)).Times(0);
+    stream->fake_stream_->startGrpcStream(false);
+    stream->fake_stream_->encodeHeaders(Http::TestResponseHeaderMapImpl{{":status", "200"}},
+                                        false);
+  }
+
+  grpc_client_.reset();
+  dispatcher_helper_.dispatcher_.run(Event::Dispatcher::RunType::NonBlock);
+  ASSERT_TRUE(stream_0->fake_stream_->waitForReset());
+  ASSERT_TRUE(stream_1->fake_stream_->waitForReset());
+}
+
 // Validate that multiple streams work with bytes metering in Envoy gRPC.
 TEST_P(GrpcClientIntegrationTest, MultiStreamWithBytesMeter) {
   SKIP_IF_GRPC_CLIENT(ClientType::GoogleGrpc);
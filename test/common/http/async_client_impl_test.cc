@@ -2334,6 +2334,32 @@ retry_back_off:
   EXPECT_EQ(route_entry.retryPolicy().maxInterval(), std::chrono::seconds(30));
 }
 
+// Test that the streams without their own retry or hash policy share the route of their timeout.
+TEST_F(AsyncClientImplUnitTest, SharedRoutes) {
+  auto create = [this](const AsyncClient::StreamOptions& options) {
+    return std::move(Http::AsyncStreamImpl::create(client_, stream_callbacks_, options).value());
+  };
+  auto stream1 = create(AsyncClient::StreamOptions());
+  auto stream2 = create(AsyncClient::StreamOptions().setTimeout(std::chrono::milliseconds(100)));
+  auto stream3 = create(AsyncClient::StreamOptions().setTimeout(std::chrono::milliseconds(100)));
+
+  EXPECT_EQ(stream_->route_, stream1->route_);
+  EXPECT_EQ(stream2->route_, stream3->route_);
+  EXPECT_NE(stream1->route_, stream2->route_);
+  EXPECT_EQ(std::chrono::milliseconds(100), stream2->route_->routeEntry()->timeout());
+  EXPECT_EQ(0, stream1->route_->routeEntry()->retryPolicy().numRetries());
+
+  Protobuf::RepeatedPtrField<envoy::config::route::v3::RouteAction::HashPolicy> hash_policy;
+  hash_policy.Add()->mutable_header()->set_header_name(":path");
+  auto stream4 = create(AsyncClient::StreamOptions().setHashPolicy(hash_policy));
+  EXPECT_NE(stream1->route_, stream4->route_);
+  EXPECT_NE(nullptr, stream4->route_->routeEntry()->hashPolicy());
+
+  setRetryPolicy("num_retries: 1");
+  EXPECT_NE(stream1->route_, stream_->route_);
+  EXPECT_EQ(1, getRouteFromStream().retryPolicy().numRetries());
+}
+
 TEST_F(AsyncClientImplUnitTest, NullConfig) {
   EXPECT_FALSE(config_.mostSpecificHeaderMutationsWins());
 }
@@ -1,5 +1,7 @@
 #include <chrono>
 
+#include "source/common/http/conn_manager_utility.h"
+
 #include "test/common/http/conn_manager_impl_test_base.h"
 #include "test/common/http/custom_header_extension.h"
 #include "test/test_common/logging.h"
@@ -2615,6 +2617,10 @@ TEST_F(HttpConnectionManagerImplTest, CodecCreationLoadShedPointCanCloseConnecti
   setup(false, "");
 
   EXPECT_CALL(close_connection_creating_codec_point, shouldShedLoad()).WillOnce(Return(true));
+  // The canned response is written without creating the codec.
+  const std::string response(ConnectionManagerUtility::overloadedConnectionResponse(
+      filter_callbacks_.connection_, Buffer::OwnedImpl("hello"), false));
+  EXPECT_CALL(filter_callbacks_.connection_, write(BufferStringEqual(response), false));
   EXPECT_CALL(filter_callbacks_.connection_, close(_, _));
 
   Buffer::OwnedImpl fake_input("hello");
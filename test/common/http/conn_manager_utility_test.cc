@@ -174,6 +174,34 @@ public:
   std::string node_id_;
 };
 
+// Tests for ConnectionManagerUtility::overloadedConnectionResponse.
+TEST_F(ConnectionManagerUtilityTest, OverloadedConnectionResponse) {
+  Network::MockConnection connection;
+  EXPECT_CALL(connection, nextProtocol()).WillRepeatedly(Return(""));
+  EXPECT_EQ("HTTP/1.1 503 Service Unavailable\r\ncontent-length: 16\r\ncontent-type: "
+            "text/plain\r\nconnection: close\r\n\r\nenvoy overloaded",
+            ConnectionManagerUtility::overloadedConnectionResponse(
+                connection, Buffer::OwnedImpl("GET / HTTP/1.1\r\n"), false));
+  EXPECT_EQ("HTTP/1.1 503 Service Unavailable\r\ncontent-length: 16\r\ncontent-type: "
+            "text/plain\r\nconnection: close\r\nx-envoy-overloaded: true\r\n\r\n"
+            "envoy overloaded",
+            ConnectionManagerUtility::overloadedConnectionResponse(
+                connection, Buffer::OwnedImpl("GET / HTTP/1.1\r\n"), true));
+
+  // SETTINGS and GOAWAY(last_stream_id=0, NO_ERROR) frames for HTTP/2.
+  const std::string http2_response("\x00\x00\x00\x04\x00\x00\x00\x00\x00"
+                                   "\x00\x00\x08\x07\x00\x00\x00\x00\x00"
+                                   "\x00\x00\x00\x00\x00\x00\x00\x00",
+                                   26);
+  EXPECT_EQ(http2_response, ConnectionManagerUtility::overloadedConnectionResponse(
+                                connection, Buffer::OwnedImpl("PRI * HTTP/2.0\r\n"), true));
+
+  Network::MockConnection h2_connection;
+  EXPECT_CALL(h2_connection, nextProtocol()).WillRepeatedly(Return("h2"));
+  EXPECT_EQ(http2_response, ConnectionManagerUtility::overloadedConnectionResponse(
+                                h2_connection, Buffer::OwnedImpl(), false));
+}
+
 // Tests for ConnectionManagerUtility::determineNextProtocol.
 TEST_F(ConnectionManagerUtilityTest, DetermineNextProtocol) {
   {
@@ -26,6 +26,7 @@
 using Envoy::Event::MockTimer;
 using testing::_;
 using testing::AnyNumber;
+using testing::Property;
 using testing::Return;
 using testing::StrictMock;
 
@@ -316,6 +317,25 @@ TEST_F(ConnectivityGridTest, SrttMatters) {
   cancel->cancel(Envoy::ConnectionPool::CancelPolicy::CloseExcess);
 }
 
+// Test the timer follows the rtt measured after the grid was created.
+TEST_F(ConnectivityGridTest, SrttLearnedAfterGridCreation) {
+  initialize();
+  addHttp3AlternateProtocol(std::chrono::microseconds(2000));
+  EXPECT_EQ(grid_->http3Pool(), nullptr);
+
+  Event::MockTimer* failover_timer = new StrictMock<MockTimer>(&dispatcher_);
+  EXPECT_CALL(*failover_timer, enableTimer(std::chrono::milliseconds(4), nullptr));
+  EXPECT_CALL(*failover_timer, enabled()).WillRepeatedly(Return(false));
+
+  auto cancel = grid_->newStream(decoder_, callbacks_,
+                                 {/*can_send_early_data_=*/false,
+                                  /*can_use_http3_=*/true});
+  EXPECT_NE(grid_->http3Pool(), nullptr);
+
+  // Clean up.
+  cancel->cancel(Envoy::ConnectionPool::CancelPolicy::CloseExcess);
+}
+
 // Test both connections happening in parallel and the first connecting.
 TEST_F(ConnectivityGridTest, TimeoutThenSuccessParallelFirstConnects) {
   initialize();
@@ -347,6 +367,35 @@ TEST_F(ConnectivityGridTest, TimeoutThenSuccessParallelFirstConnects) {
   EXPECT_CALL(callbacks_.pool_ready_, ready());
   grid_->callbacks(0)->onPoolReady(encoder_, host_, info_, absl::nullopt);
   EXPECT_FALSE(grid_->isHttp3Broken());
+  EXPECT_EQ(1, cluster_->trafficStats()->upstream_grid_http3_won_.value());
+  EXPECT_EQ(0, cluster_->trafficStats()->upstream_grid_tcp_won_.value());
+}
+
+// Test both connections happening in parallel and the second connecting before the first, which
+// connects later.
+TEST_F(ConnectivityGridTest, TimeoutThenSuccessParallelSecondConnectsFirstLater) {
+  initialize();
+  addHttp3AlternateProtocol();
+
+  Event::MockTimer* failover_timer = new NiceMock<MockTimer>(&dispatcher_);
+  grid_->newStream(decoder_, callbacks_,
+                   {/*can_send_early_data_=*/false,
+                    /*can_use_http3_=*/true});
+  failover_timer->invokeCallback();
+  EXPECT_NE(grid_->http2Pool(), nullptr);
+
+  EXPECT_CALL(callbacks_.pool_ready_, ready());
+  grid_->callbacks(1)->onPoolReady(encoder_, host_, info_, absl::nullopt);
+  EXPECT_EQ(0, cluster_->trafficStats()->upstream_grid_http3_won_.value());
+  EXPECT_EQ(1, cluster_->trafficStats()->upstream_grid_tcp_won_.value());
+
+  // The HTTP/3 attempt connects 10ms after the TCP one.
+  simTime().advanceTimeWait(std::chrono::milliseconds(10));
+  EXPECT_CALL(cluster_->stats_store_,
+              deliverHistogramToSinks(
+                  Property(&Stats::Metric::name, "upstream_grid_http3_lag_ms"), 10));
+  grid_->callbacks(0)->onPoolReady(encoder_, host_, info_, absl::nullopt);
+  EXPECT_FALSE(grid_->isHttp3Broken());
 }
 
 // Test both connections happening in parallel and the second connecting before
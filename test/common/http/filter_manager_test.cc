@@ -18,6 +18,7 @@
 #include "test/mocks/local_reply/mocks.h"
 #include "test/mocks/network/mocks.h"
 #include "test/mocks/server/overload_manager.h"
+#include "test/mocks/stats/mocks.h"
 #include "test/test_common/test_runtime.h"
 
 #include "gtest/gtest.h"
@@ -833,6 +834,145 @@ TEST_F(FilterManagerTest, IdleTimerResets) {
   filter_1->decoder_callbacks_->encodeTrailers(std::move(basic_resp_trailers));
   filter_manager_->destroyFilters();
 }
+
+// Filters which disable their data callbacks are skipped by the body data, once they continue the
+// headers, but still see the end of the stream.
+TEST_F(FilterManagerTest, DisableDataCallbacks) {
+  initialize();
+
+  std::shared_ptr<MockStreamFilter> filter_1(new NiceMock<MockStreamFilter>());
+  std::shared_ptr<MockStreamFilter> filter_2(new NiceMock<MockStreamFilter>());
+  EXPECT_CALL(filter_factory_, createFilterChain(_))
+      .WillRepeatedly(Invoke([&](FilterChainManager& manager) -> bool {
+        manager.applyFilterFactoryCb({"configName1", "filterName1"},
+                                     createStreamFilterFactoryCb(filter_1));
+        manager.applyFilterFactoryCb({"configName2", "filterName2"},
+                                     createStreamFilterFactoryCb(filter_2));
+        return true;
+      }));
+  filter_manager_->createFilterChain();
+
+  RequestHeaderMapPtr basic_headers{
+      new TestRequestHeaderMapImpl{{":authority", "host"}, {":path", "/"}, {":method", "GET"}}};
+  ON_CALL(filter_manager_callbacks_, requestHeaders())
+      .WillByDefault(Return(makeOptRef(*basic_headers)));
+  filter_manager_->requestHeadersInitialized();
+
+  EXPECT_CALL(*filter_1, decodeHeaders(_, false))
+      .WillOnce(Invoke([&](RequestHeaderMap&, bool) -> FilterHeadersStatus {
+        filter_1->decoder_callbacks_->disableDataCallbacks();
+        return FilterHeadersStatus::Continue;
+      }));
+  EXPECT_CALL(*filter_2, decodeHeaders(_, false));
+  filter_manager_->decodeHeaders(*basic_headers, false);
+
+  Buffer::OwnedImpl data("data");
+  EXPECT_CALL(*filter_1, decodeData(_, _)).Times(0);
+  EXPECT_CALL(*filter_2, decodeData(_, false));
+  filter_manager_->decodeData(data, false);
+  EXPECT_CALL(*filter_1, decodeComplete());
+  EXPECT_CALL(*filter_2, decodeData(_, true));
+  filter_manager_->decodeData(data, true);
+
+  ResponseHeaderMapPtr response_headers{new TestResponseHeaderMapImpl{{":status", "200"}}};
+  ON_CALL(filter_manager_callbacks_, responseHeaders())
+      .WillByDefault(Return(makeOptRef(*response_headers)));
+  EXPECT_CALL(*filter_1, encodeHeaders(_, false));
+  EXPECT_CALL(*filter_2, encodeHeaders(_, false))
+      .WillOnce(Invoke([&](ResponseHeaderMap&, bool) -> FilterHeadersStatus {
+        filter_2->encoder_callbacks_->disableDataCallbacks();
+        return FilterHeadersStatus::Continue;
+      }));
+  filter_2->decoder_callbacks_->encodeHeaders(
+      std::make_unique<TestResponseHeaderMapImpl>(*response_headers), false, "");
+
+  EXPECT_CALL(*filter_2, encodeData(_, _)).Times(0);
+  EXPECT_CALL(*filter_1, encodeData(_, false));
+  EXPECT_CALL(filter_manager_callbacks_, encodeData(_, false));
+  filter_2->decoder_callbacks_->encodeData(data, false);
+  EXPECT_CALL(*filter_2, encodeComplete());
+  EXPECT_CALL(*filter_1, encodeData(_, true));
+  EXPECT_CALL(filter_manager_callbacks_, encodeData(_, true));
+  filter_2->decoder_callbacks_->encodeData(data, true);
+
+  filter_manager_->destroyFilters();
+}
+
+// The callbacks of the filters with latency stats are timed, and the others aren't.
+TEST_F(FilterManagerTest, FilterLatencyStats) {
+  initialize();
+
+  NiceMock<Stats::MockHistogram> decode_data, decode_headers, encode_data, encode_headers;
+  const FilterLatencyStats latency_stats{decode_data, decode_headers, encode_data, encode_headers};
+  std::shared_ptr<MockStreamFilter> filter_1(new NiceMock<MockStreamFilter>());
+  std::shared_ptr<MockStreamFilter> filter_2(new NiceMock<MockStreamFilter>());
+  EXPECT_CALL(filter_factory_, createFilterChain(_))
+      .WillRepeatedly(Invoke([&](FilterChainManager& manager) -> bool {
+        manager.applyFilterFactoryCb({"configName1", "filterName1", &latency_stats},
+                                     createStreamFilterFactoryCb(filter_1));
+        manager.applyFilterFactoryCb({"configName2", "filterName2"},
+                                     createStreamFilterFactoryCb(filter_2));
+        return true;
+      }));
+  filter_manager_->createFilterChain();
+
+  RequestHeaderMapPtr basic_headers{
+      new TestRequestHeaderMapImpl{{":authority", "host"}, {":path", "/"}, {":method", "GET"}}};
+  ON_CALL(filter_manager_callbacks_, requestHeaders())
+      .WillByDefault(Return(makeOptRef(*basic_headers)));
+  filter_manager_->requestHeadersInitialized();
+
+  EXPECT_CALL(decode_headers, recordValue(_));
+  filter_manager_->decodeHeaders(*basic_headers, false);
+  Buffer::OwnedImpl data("data");
+  EXPECT_CALL(decode_data, recordValue(_));
+  filter_manager_->decodeData(data, true);
+
+  ResponseHeaderMapPtr response_headers{new TestResponseHeaderMapImpl{{":status", "200"}}};
+  ON_CALL(filter_manager_callbacks_, responseHeaders())
+      .WillByDefault(Return(makeOptRef(*response_headers)));
+  EXPECT_CALL(encode_headers, recordValue(_));
+  filter_2->decoder_callbacks_->encodeHeaders(
+      std::make_unique<TestResponseHeaderMapImpl>(*response_headers), false, "");
+  EXPECT_CALL(encode_data, recordValue(_));
+  filter_2->decoder_callbacks_->encodeData(data, true);
+
+  filter_manager_->destroyFilters();
+}
+
+TEST_F(FilterManagerTest, DisableDataCallbacksRuntimeDisabled) {
+  TestScopedRuntime scoped_runtime;
+  scoped_runtime.mergeValues(
+      {{"envoy.reloadable_features.skip_data_of_filters_without_interest", "false"}});
+  initialize();
+
+  std::shared_ptr<MockStreamDecoderFilter> decoder_filter(new NiceMock<MockStreamDecoderFilter>());
+  EXPECT_CALL(filter_factory_, createFilterChain(_))
+      .WillRepeatedly(Invoke([&](FilterChainManager& manager) -> bool {
+        manager.applyFilterFactoryCb({}, createDecoderFilterFactoryCb(decoder_filter));
+        return true;
+      }));
+  filter_manager_->createFilterChain();
+
+  RequestHeaderMapPtr basic_headers{
+      new TestRequestHeaderMapImpl{{":authority", "host"}, {":path", "/"}, {":method", "GET"}}};
+  ON_CALL(filter_manager_callbacks_, requestHeaders())
+      .WillByDefault(Return(makeOptRef(*basic_headers)));
+  filter_manager_->requestHeadersInitialized();
+
+  EXPECT_CALL(*decoder_filter, decodeHeaders(_, false))
+      .WillOnce(Invoke([&](RequestHeaderMap&, bool) -> FilterHeadersStatus {
+        decoder_filter->callbacks_->disableDataCallbacks();
+        return FilterHeadersStatus::Continue;
+      }));
+  filter_manager_->decodeHeaders(*basic_headers, false);
+
+  Buffer::OwnedImpl data("data");
+  EXPECT_CALL(*decoder_filter, decodeData(_, true));
+  filter_manager_->decodeData(data, true);
+
+  filter_manager_->destroyFilters();
+}
 } // namespace
 } // namespace Http
 } // namespace Envoy
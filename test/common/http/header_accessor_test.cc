@@ -0,0 +1,76 @@
+#include "source/common/http/header_accessor.h"
+#include "source/common/http/header_map_impl.h"
+
+#include "test/test_common/utility.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Http {
+namespace {
+
+Http::RegisterCustomInlineHeader<Http::CustomInlineHeaderRegistry::Type::RequestHeaders>
+    tenant_id_request_header(Http::LowerCaseString{"x-tenant-id"});
+Http::RegisterCustomInlineHeader<Http::CustomInlineHeaderRegistry::Type::ResponseTrailers>
+    tenant_id_response_trailer(Http::LowerCaseString{"x-tenant-id"});
+
+TEST(HeaderAccessorTest, InlineHeader) {
+  const HeaderAccessor accessor(LowerCaseString("x-tenant-id"));
+  EXPECT_EQ("x-tenant-id", accessor.name().get());
+  EXPECT_TRUE(accessor.isInline(CustomInlineHeaderRegistry::Type::RequestHeaders));
+  EXPECT_FALSE(accessor.isInline(CustomInlineHeaderRegistry::Type::RequestTrailers));
+  EXPECT_FALSE(accessor.isInline(CustomInlineHeaderRegistry::Type::ResponseHeaders));
+  EXPECT_TRUE(accessor.isInline(CustomInlineHeaderRegistry::Type::ResponseTrailers));
+
+  TestRequestHeaderMapImpl headers;
+  EXPECT_TRUE(accessor.get(headers).empty());
+  headers.addCopy(LowerCaseString("x-tenant-id"), "a");
+  headers.addCopy(LowerCaseString("x-tenant-id"), "b");
+  EXPECT_EQ(&headers.getInline(tenant_id_request_header.handle())->value(),
+            &accessor.get(headers)[0]->value());
+  EXPECT_EQ(1, accessor.get(headers).size());
+  EXPECT_EQ("a,b", accessor.get(headers)[0]->value().getStringView());
+  EXPECT_EQ(1, accessor.remove(headers));
+  EXPECT_TRUE(accessor.get(headers).empty());
+  EXPECT_EQ(nullptr, headers.getInline(tenant_id_request_header.handle()));
+
+  TestResponseTrailerMapImpl trailers{{"x-tenant-id", "c"}};
+  EXPECT_EQ("c", accessor.get(trailers)[0]->value().getStringView());
+  EXPECT_EQ(1, accessor.remove(trailers));
+  EXPECT_TRUE(trailers.empty());
+}
+
+TEST(HeaderAccessorTest, NonInlineHeader) {
+  const HeaderAccessor accessor(LowerCaseString("x-tenant-id"));
+
+  // The header is not an inline header of response headers, so it is looked up by name.
+  TestResponseHeaderMapImpl headers{{"x-tenant-id", "a"}, {"x-tenant-id", "b"}};
+  ASSERT_EQ(2, accessor.get(headers).size());
+  EXPECT_EQ("a", accessor.get(headers)[0]->value().getStringView());
+  EXPECT_EQ("b", accessor.get(headers)[1]->value().getStringView());
+  EXPECT_EQ(2, accessor.remove(headers));
+  EXPECT_TRUE(accessor.get(headers).empty());
+
+  const HeaderAccessor other_accessor(LowerCaseString("x-other"));
+  for (const auto type : {CustomInlineHeaderRegistry::Type::RequestHeaders,
+                          CustomInlineHeaderRegistry::Type::RequestTrailers,
+                          CustomInlineHeaderRegistry::Type::ResponseHeaders,
+                          CustomInlineHeaderRegistry::Type::ResponseTrailers}) {
+    EXPECT_FALSE(other_accessor.isInline(type));
+  }
+  TestRequestHeaderMapImpl request_headers{{"x-other", "a"}};
+  EXPECT_EQ("a", other_accessor.get(request_headers)[0]->value().getStringView());
+}
+
+TEST(HeaderAccessorTest, GenericHeaderMap) {
+  const HeaderAccessor accessor(LowerCaseString("x-tenant-id"));
+  TestRequestHeaderMapImpl headers{{"x-tenant-id", "a"}};
+  const HeaderMap& generic_headers = headers;
+  EXPECT_EQ("a", accessor.get(generic_headers)[0]->value().getStringView());
+  EXPECT_EQ(1, accessor.remove(static_cast<HeaderMap&>(headers)));
+  EXPECT_TRUE(headers.empty());
+}
+
+} // namespace
+} // namespace Http
+} // namespace Envoy
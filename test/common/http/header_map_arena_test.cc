@@ -0,0 +1,92 @@
+#include <cstddef>
+#include <cstdint>
+#include <list>
+
+#include "source/common/http/header_map_arena.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Http {
+namespace {
+
+TEST(HeaderMapArenaTest, AllocatesFromBlocks) {
+  HeaderMapArena arena(1024);
+  EXPECT_EQ(0, arena.blocksAllocated());
+  EXPECT_EQ(0, arena.bytesAllocated());
+
+  void* first = arena.allocate(64, alignof(std::max_align_t));
+  void* second = arena.allocate(64, alignof(std::max_align_t));
+  EXPECT_NE(first, second);
+  EXPECT_EQ(0, reinterpret_cast<uintptr_t>(first) % alignof(std::max_align_t));
+  EXPECT_EQ(0, reinterpret_cast<uintptr_t>(second) % alignof(std::max_align_t));
+  EXPECT_EQ(1, arena.blocksAllocated());
+  EXPECT_EQ(1024, arena.bytesAllocated());
+
+  // Fill up the first block, the next allocation needs a second one.
+  for (size_t i = 2; i < 1024 / 64; i++) {
+    arena.allocate(64, alignof(std::max_align_t));
+  }
+  EXPECT_EQ(1, arena.blocksAllocated());
+  arena.allocate(64, alignof(std::max_align_t));
+  EXPECT_EQ(2, arena.blocksAllocated());
+  EXPECT_EQ(2048, arena.bytesAllocated());
+}
+
+TEST(HeaderMapArenaTest, ReusesDeallocatedMemory) {
+  HeaderMapArena arena(1024);
+  void* first = arena.allocate(64, alignof(std::max_align_t));
+  void* second = arena.allocate(100, alignof(std::max_align_t));
+  arena.deallocate(first, 64);
+  arena.deallocate(second, 100);
+
+  // Memory is only reused for allocations of the same (rounded up) size.
+  EXPECT_EQ(second, arena.allocate(100, alignof(std::max_align_t)));
+  EXPECT_NE(first, arena.allocate(32, alignof(std::max_align_t)));
+  EXPECT_EQ(first, arena.allocate(64, alignof(std::max_align_t)));
+  EXPECT_EQ(1, arena.blocksAllocated());
+}
+
+TEST(HeaderMapArenaTest, LargeAllocation) {
+  HeaderMapArena arena(1024);
+  void* small = arena.allocate(64, alignof(std::max_align_t));
+  void* large = arena.allocate(4096, alignof(std::max_align_t));
+  EXPECT_NE(nullptr, large);
+  EXPECT_EQ(2, arena.blocksAllocated());
+  EXPECT_EQ(1024 + 4096, arena.bytesAllocated());
+
+  // The large allocation has a block of its own, so the first block keeps being used.
+  void* next = arena.allocate(64, alignof(std::max_align_t));
+  EXPECT_EQ(static_cast<char*>(small) + 64, next);
+  EXPECT_EQ(2, arena.blocksAllocated());
+}
+
+TEST(HeaderMapArenaTest, Allocator) {
+  HeaderMapArena arena;
+  {
+    std::list<int, HeaderMapArenaAllocator<int>> list{HeaderMapArenaAllocator<int>(&arena)};
+    for (int i = 0; i < 100; i++) {
+      list.push_back(i);
+    }
+    EXPECT_EQ(1, arena.blocksAllocated());
+
+    // Erased nodes are recycled.
+    list.clear();
+    for (int i = 0; i < 100; i++) {
+      list.push_back(i);
+    }
+    EXPECT_EQ(1, arena.blocksAllocated());
+  }
+
+  HeaderMapArenaAllocator<int> heap_allocator;
+  EXPECT_EQ(nullptr, heap_allocator.arena());
+  EXPECT_NE(heap_allocator, HeaderMapArenaAllocator<int>(&arena));
+  EXPECT_EQ(HeaderMapArenaAllocator<char>(&arena), HeaderMapArenaAllocator<int>(&arena));
+  std::list<int, HeaderMapArenaAllocator<int>> heap_list{heap_allocator};
+  heap_list.push_back(1);
+  EXPECT_EQ(1, arena.blocksAllocated());
+}
+
+} // namespace
+} // namespace Http
+} // namespace Envoy
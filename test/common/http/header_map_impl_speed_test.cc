@@ -1,3 +1,4 @@
+#include "source/common/http/header_map_arena.h"
 #include "source/common/http/header_map_impl.h"
 #include "source/common/http/headers.h"
 
@@ -30,6 +31,36 @@ static void headerMapImplCreate(benchmark::State& state) {
 }
 BENCHMARK(headerMapImplCreate);
 
+/**
+ * Measure the cost of the header maps of a stream: request headers with the given number of
+ * headers and request trailers are created, populated and destroyed. The second Arg selects
+ * whether the entries are allocated from a per-stream HeaderMapArena (1) or from the heap (0).
+ */
+static void headerMapImplStreamLifecycle(benchmark::State& state) {
+  const size_t num_headers = state.range(0);
+  const bool use_arena = state.range(1) != 0;
+  uint64_t arena_blocks = 0;
+  for (auto _ : state) { // NOLINT
+    HeaderMapArenaSharedPtr arena = use_arena ? std::make_shared<HeaderMapArena>() : nullptr;
+    auto headers = Http::RequestHeaderMapImpl::create(UINT32_MAX, UINT32_MAX, arena);
+    headers->setReferenceMethod(Headers::get().MethodValues.Get);
+    headers->setReferencePath("/");
+    headers->setReferenceHost("example.com");
+    addDummyHeaders(*headers, num_headers);
+    auto trailers = Http::RequestTrailerMapImpl::create(UINT32_MAX, UINT32_MAX, arena);
+    addDummyHeaders(*trailers, 2);
+    benchmark::DoNotOptimize(headers->size() + trailers->size());
+    if (arena != nullptr) {
+      arena_blocks += arena->blocksAllocated();
+    }
+  }
+  // One heap allocation per entry without an arena, one per block with it.
+  state.counters["entry_allocations"] = benchmark::Counter(
+      use_arena ? arena_blocks : state.iterations() * (num_headers + 5),
+      benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(headerMapImplStreamLifecycle)->ArgsProduct({{10, 30, 100}, {0, 1}});
+
 /**
  * Measure the speed of setting/overwriting a header value. The numeric Arg passed
  * by the BENCHMARK(...) macro call below indicates how many dummy headers this test
@@ -232,6 +232,42 @@ TEST(HeaderMapImplTest, Remove) {
   EXPECT_EQ(0UL, headers.remove(Headers::get().ContentLength));
 }
 
+TEST(HeaderMapImplTest, Arena) {
+  auto arena = std::make_shared<HeaderMapArena>();
+  auto headers = RequestHeaderMapImpl::create(UINT32_MAX, UINT32_MAX, arena);
+  auto trailers = RequestTrailerMapImpl::create(UINT32_MAX, UINT32_MAX, arena);
+  EXPECT_EQ(arena, headers->arena());
+  EXPECT_EQ(arena, trailers->arena());
+
+  headers->setMethod("GET");
+  headers->setPath("/");
+  for (int i = 0; i < 20; i++) {
+    headers->addCopy(LowerCaseString("x-header-" + std::to_string(i)),
+                     "value-" + std::to_string(i));
+  }
+  trailers->addCopy(LowerCaseString("grpc-status"), "0");
+  EXPECT_EQ(1, arena->blocksAllocated());
+  EXPECT_EQ("GET", headers->getMethodValue());
+  EXPECT_EQ("value-7", headers->get(LowerCaseString("x-header-7"))[0]->value().getStringView());
+  EXPECT_EQ(22UL, headers->size());
+
+  // Removed entries are recycled by later additions.
+  EXPECT_EQ(1UL, headers->remove(LowerCaseString("x-header-0")));
+  headers->addCopy(LowerCaseString("x-header-20"), "value-20");
+  EXPECT_EQ(1, arena->blocksAllocated());
+
+  // The header maps keep the arena alive.
+  arena.reset();
+  headers->removePrefix(LowerCaseString("x-header-"));
+  EXPECT_EQ(2UL, headers->size());
+  EXPECT_EQ("0", trailers->get(LowerCaseString("grpc-status"))[0]->value().getStringView());
+  headers.reset();
+  trailers.reset();
+
+  // Header maps without an arena allocate from the heap.
+  EXPECT_EQ(nullptr, RequestHeaderMapImpl::create()->arena());
+}
+
 TEST(HeaderMapImplTest, RemoveHost) {
   TestRequestHeaderMapImpl headers;
   headers.setHost("foo");
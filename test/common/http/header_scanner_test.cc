@@ -0,0 +1,99 @@
+#include <string>
+
+#include "source/common/http/header_scanner.h"
+
+#include "test/test_common/test_random_generator.h"
+
+#include "gtest/gtest.h"
+#include "quiche/http2/adapter/header_validator.h"
+
+namespace Envoy {
+namespace Http {
+namespace {
+
+bool isValidHeaderValueReference(absl::string_view value) {
+  return http2::adapter::HeaderValidator::IsValidHeaderValue(value,
+                                                             http2::adapter::ObsTextOption::kAllow);
+}
+
+void expectSameResult(absl::string_view value) {
+  const HeaderScanner::ValueScanResult result = HeaderScanner::scanHeaderValue(value);
+  const HeaderScanner::ValueScanResult scalar_result = HeaderScanner::scanHeaderValueScalar(value);
+  EXPECT_EQ(scalar_result.has_cr_or_lf_, result.has_cr_or_lf_);
+  EXPECT_EQ(scalar_result.has_invalid_character_, result.has_invalid_character_);
+  EXPECT_EQ(isValidHeaderValueReference(value), result.valid());
+}
+
+TEST(HeaderScannerTest, EmptyValue) {
+  const HeaderScanner::ValueScanResult result = HeaderScanner::scanHeaderValue("");
+  EXPECT_TRUE(result.valid());
+  EXPECT_FALSE(result.has_cr_or_lf_);
+  EXPECT_FALSE(result.has_invalid_character_);
+}
+
+TEST(HeaderScannerTest, ValidValues) {
+  EXPECT_TRUE(HeaderScanner::scanHeaderValue("text/html; charset=utf-8").valid());
+  EXPECT_TRUE(HeaderScanner::scanHeaderValue("a\tb c").valid());
+  EXPECT_TRUE(HeaderScanner::scanHeaderValue("obs-text \x80\xff in a long enough value").valid());
+}
+
+TEST(HeaderScannerTest, CrOrLf) {
+  for (const absl::string_view value : {"short\r\n", "a somewhat longer value\r\n folded"}) {
+    const HeaderScanner::ValueScanResult result = HeaderScanner::scanHeaderValue(value);
+    EXPECT_TRUE(result.has_cr_or_lf_);
+    EXPECT_FALSE(result.has_invalid_character_);
+    EXPECT_FALSE(result.valid());
+  }
+}
+
+TEST(HeaderScannerTest, InvalidCharacters) {
+  for (const absl::string_view value :
+       {absl::string_view("nul\0", 4), absl::string_view("a long value with nul \0 inside", 30),
+        absl::string_view("del\x7f"), absl::string_view("a long value ending with del\x7f")}) {
+    const HeaderScanner::ValueScanResult result = HeaderScanner::scanHeaderValue(value);
+    EXPECT_FALSE(result.has_cr_or_lf_);
+    EXPECT_TRUE(result.has_invalid_character_);
+    EXPECT_FALSE(result.valid());
+  }
+}
+
+// Every character is classified the same way by the vectorized and scalar scans and by the
+// oghttp2 header value validator, wherever it falls in the vectors and in the scalar tail.
+TEST(HeaderScannerTest, AllCharactersAtAllPositions) {
+  for (size_t length : {1, 15, 16, 17, 31, 32, 33, 64}) {
+    for (size_t position = 0; position < length; ++position) {
+      for (int c = 0; c < 256; ++c) {
+        std::string value(length, 'a');
+        value[position] = static_cast<char>(c);
+        expectSameResult(value);
+      }
+    }
+  }
+}
+
+TEST(HeaderScannerTest, RandomValues) {
+  TestRandomGenerator rand;
+  for (int i = 0; i < 10000; ++i) {
+    std::string value(rand.random() % 100, 'a');
+    for (char& c : value) {
+      // Mostly printable characters, with a few of the others.
+      c = rand.random() % 16 == 0 ? static_cast<char>(rand.random() % 256)
+                                  : static_cast<char>(' ' + rand.random() % 95);
+    }
+    expectSameResult(value);
+  }
+}
+
+TEST(HeaderScannerTest, IsTokenString) {
+  EXPECT_TRUE(HeaderScanner::isTokenString(""));
+  EXPECT_TRUE(HeaderScanner::isTokenString("Content-Type"));
+  EXPECT_TRUE(HeaderScanner::isTokenString("!#$%&'*+-.^_`|~09azAZ"));
+  EXPECT_FALSE(HeaderScanner::isTokenString("Content Type"));
+  EXPECT_FALSE(HeaderScanner::isTokenString("Content:Type"));
+  EXPECT_FALSE(HeaderScanner::isTokenString("\x80"));
+  EXPECT_FALSE(HeaderScanner::isTokenString(absl::string_view("a\0", 2)));
+}
+
+} // namespace
+} // namespace Http
+} // namespace Envoy
@@ -1250,6 +1250,29 @@ TEST_P(Http1ServerConnectionImplTest, SimpleGet) {
   EXPECT_EQ(Protocol::Http11, codec_->protocol());
 }
 
+// Test that the request headers are allocated from the header map arena of the stream.
+TEST_P(Http1ServerConnectionImplTest, HeaderMapArena) {
+  initialize();
+
+  InSequence sequence;
+
+  MockRequestDecoder decoder;
+  decoder.header_map_arena_ = std::make_shared<HeaderMapArena>();
+  EXPECT_CALL(callbacks_, newStream(_, _)).WillOnce(ReturnRef(decoder));
+  EXPECT_CALL(decoder, decodeHeaders_(_, true))
+      .WillOnce(Invoke([&](RequestHeaderMapSharedPtr& headers, bool) {
+        auto* headers_impl = dynamic_cast<RequestHeaderMapImpl*>(headers.get());
+        ASSERT_NE(nullptr, headers_impl);
+        EXPECT_EQ(decoder.header_map_arena_, headers_impl->arena());
+        EXPECT_EQ("bar", headers->get(LowerCaseString("foo"))[0]->value().getStringView());
+      }));
+
+  Buffer::OwnedImpl buffer("GET / HTTP/1.1\r\nfoo: bar\r\n\r\n");
+  auto status = codec_->dispatch(buffer);
+  EXPECT_TRUE(status.ok());
+  EXPECT_EQ(1, decoder.header_map_arena_->blocksAllocated());
+}
+
 // Test that if the stream is not created at the time an error is detected, it
 // is created as part of sending the protocol error.
 TEST_P(Http1ServerConnectionImplTest, BadRequestNoStream) {
@@ -1748,6 +1771,63 @@ TEST_P(Http1ServerConnectionImplTest, HeaderOnlyResponseTrainProperHeaders) {
             output);
 }
 
+// Tests that the headers added by the codec are encoded after those of the map, and counted in the
+// header bytes sent like them. The status line and the empty line ending the headers aren't.
+TEST_P(Http1ServerConnectionImplTest, HeaderBytesSentWithHeadersAddedByCodec) {
+  initialize();
+
+  NiceMock<MockRequestDecoder> decoder;
+  Http::ResponseEncoder* response_encoder = nullptr;
+  EXPECT_CALL(callbacks_, newStream(_, _))
+      .WillOnce(Invoke([&](ResponseEncoder& encoder, bool) -> RequestDecoder& {
+        response_encoder = &encoder;
+        return decoder;
+      }));
+
+  Buffer::OwnedImpl buffer("GET / HTTP/1.1\r\n\r\n");
+  auto status = codec_->dispatch(buffer);
+  EXPECT_TRUE(status.ok());
+
+  std::string output;
+  ON_CALL(connection_, write(_, _)).WillByDefault(AddBufferToString(&output));
+
+  TestResponseHeaderMapImpl headers{{":status", "200"}, {"foo", "bar"}};
+  response_encoder->encodeHeaders(headers, false);
+  const std::string header_lines = "foo: bar\r\ntransfer-encoding: chunked\r\n";
+  EXPECT_EQ("HTTP/1.1 200 OK\r\n" + header_lines + "\r\n", output);
+  EXPECT_EQ(header_lines.size(),
+            response_encoder->getStream().bytesMeter()->headerBytesSent());
+}
+
+// Tests the same with a header key formatter, which formats the keys of the headers added by the
+// codec too.
+TEST_P(Http1ServerConnectionImplTest, HeaderBytesSentWithHeadersAddedByCodecProperCase) {
+  codec_settings_.header_key_format_ = Http1Settings::HeaderKeyFormat::ProperCase;
+  initialize();
+
+  NiceMock<MockRequestDecoder> decoder;
+  Http::ResponseEncoder* response_encoder = nullptr;
+  EXPECT_CALL(callbacks_, newStream(_, _))
+      .WillOnce(Invoke([&](ResponseEncoder& encoder, bool) -> RequestDecoder& {
+        response_encoder = &encoder;
+        return decoder;
+      }));
+
+  Buffer::OwnedImpl buffer("GET / HTTP/1.1\r\n\r\n");
+  auto status = codec_->dispatch(buffer);
+  EXPECT_TRUE(status.ok());
+
+  std::string output;
+  ON_CALL(connection_, write(_, _)).WillByDefault(AddBufferToString(&output));
+
+  TestResponseHeaderMapImpl headers{{":status", "200"}, {"foo", "bar"}};
+  response_encoder->encodeHeaders(headers, true);
+  const std::string header_lines = "Foo: bar\r\nContent-Length: 0\r\n";
+  EXPECT_EQ("HTTP/1.1 200 OK\r\n" + header_lines + "\r\n", output);
+  EXPECT_EQ(header_lines.size(),
+            response_encoder->getStream().bytesMeter()->headerBytesSent());
+}
+
 TEST_P(Http1ServerConnectionImplTest, 304ResponseTransferEncodingNotAddedWhenContentLengthPresent) {
   initialize();
 
@@ -2645,6 +2725,51 @@ TEST_P(Http1ClientConnectionImplTest, SimpleGetWithHeaderCasing) {
   EXPECT_EQ("GET / HTTP/1.1\r\nMy-Custom-Header: hey\r\n\r\n", output);
 }
 
+// Tests the encoding of more headers than the codec keeps inline.
+TEST_P(Http1ClientConnectionImplTest, ManyHeaders) {
+  initialize();
+
+  MockResponseDecoder response_decoder;
+  Http::RequestEncoder& request_encoder = codec_->newStream(response_decoder);
+
+  std::string output;
+  ON_CALL(connection_, write(_, _)).WillByDefault(AddBufferToString(&output));
+
+  TestRequestHeaderMapImpl headers{{":method", "POST"}, {":path", "/"}, {":authority", "foo.com"}};
+  std::string header_lines = "host: foo.com\r\n";
+  for (int i = 0; i < 40; i++) {
+    headers.addCopy(absl::StrCat("my-header-", i), absl::StrCat("value-", i));
+    absl::StrAppend(&header_lines, "my-header-", i, ": value-", i, "\r\n");
+  }
+  absl::StrAppend(&header_lines, "transfer-encoding: chunked\r\n");
+  EXPECT_TRUE(request_encoder.encodeHeaders(headers, false).ok());
+  EXPECT_EQ("POST / HTTP/1.1\r\n" + header_lines + "\r\n", output);
+  EXPECT_EQ(header_lines.size(), request_encoder.getStream().bytesMeter()->headerBytesSent());
+}
+
+// Tests the same with a header key formatter, which formats the keys of all the headers.
+TEST_P(Http1ClientConnectionImplTest, ManyHeadersWithHeaderCasing) {
+  codec_settings_.header_key_format_ = Http1Settings::HeaderKeyFormat::ProperCase;
+  initialize();
+
+  MockResponseDecoder response_decoder;
+  Http::RequestEncoder& request_encoder = codec_->newStream(response_decoder);
+
+  std::string output;
+  ON_CALL(connection_, write(_, _)).WillByDefault(AddBufferToString(&output));
+
+  TestRequestHeaderMapImpl headers{{":method", "POST"}, {":path", "/"}, {":authority", "foo.com"}};
+  std::string header_lines = "Host: foo.com\r\n";
+  for (int i = 0; i < 40; i++) {
+    headers.addCopy(absl::StrCat("my-header-", i), absl::StrCat("value-", i));
+    absl::StrAppend(&header_lines, "My-Header-", i, ": value-", i, "\r\n");
+  }
+  absl::StrAppend(&header_lines, "Transfer-Encoding: chunked\r\n");
+  EXPECT_TRUE(request_encoder.encodeHeaders(headers, false).ok());
+  EXPECT_EQ("POST / HTTP/1.1\r\n" + header_lines + "\r\n", output);
+  EXPECT_EQ(header_lines.size(), request_encoder.getStream().bytesMeter()->headerBytesSent());
+}
+
 TEST_P(Http1ClientConnectionImplTest, FullyQualifiedGet) {
   codec_settings_.send_fully_qualified_url_ = true;
   initialize();
@@ -0,0 +1,64 @@
+// Note: this should be run with --compilation_mode=opt, and would benefit from a
+// quiescent system with disabled cstate power management.
+
+#include <string>
+
+#include "source/common/http/header_scanner.h"
+
+#include "benchmark/benchmark.h"
+#include "quiche/http2/adapter/header_validator.h"
+
+namespace Envoy {
+namespace Http {
+namespace Http1 {
+
+// Header value of the given length made of printable characters, like most values received over
+// plaintext HTTP/1.1.
+static std::string headerValue(size_t length) {
+  std::string value(length, ' ');
+  for (size_t i = 0; i < length; ++i) {
+    value[i] = static_cast<char>('!' + i % 94);
+  }
+  return value;
+}
+
+static void bmScanHeaderValue(benchmark::State& state) {
+  const std::string value = headerValue(state.range(0));
+  for (auto _ : state) { // NOLINT(clang-analyzer-deadcode.DeadStores)
+    benchmark::DoNotOptimize(HeaderScanner::scanHeaderValue(value));
+  }
+  state.SetBytesProcessed(state.iterations() * value.size());
+}
+BENCHMARK(bmScanHeaderValue)->Arg(8)->Arg(32)->Arg(128)->Arg(1024)->Arg(8192);
+
+static void bmScanHeaderValueScalar(benchmark::State& state) {
+  const std::string value = headerValue(state.range(0));
+  for (auto _ : state) { // NOLINT(clang-analyzer-deadcode.DeadStores)
+    benchmark::DoNotOptimize(HeaderScanner::scanHeaderValueScalar(value));
+  }
+  state.SetBytesProcessed(state.iterations() * value.size());
+}
+BENCHMARK(bmScanHeaderValueScalar)->Arg(8)->Arg(32)->Arg(128)->Arg(1024)->Arg(8192);
+
+// The validator previously used to check the header values received by the HTTP/1 codec.
+static void bmOghttp2HeaderValueValidator(benchmark::State& state) {
+  const std::string value = headerValue(state.range(0));
+  for (auto _ : state) { // NOLINT(clang-analyzer-deadcode.DeadStores)
+    benchmark::DoNotOptimize(http2::adapter::HeaderValidator::IsValidHeaderValue(
+        value, http2::adapter::ObsTextOption::kAllow));
+  }
+  state.SetBytesProcessed(state.iterations() * value.size());
+}
+BENCHMARK(bmOghttp2HeaderValueValidator)->Arg(8)->Arg(32)->Arg(128)->Arg(1024)->Arg(8192);
+
+static void bmIsTokenString(benchmark::State& state) {
+  const std::string name = "x-envoy-upstream-service-time";
+  for (auto _ : state) { // NOLINT(clang-analyzer-deadcode.DeadStores)
+    benchmark::DoNotOptimize(HeaderScanner::isTokenString(name));
+  }
+}
+BENCHMARK(bmIsTokenString);
+
+} // namespace Http1
+} // namespace Http
+} // namespace Envoy
@@ -219,6 +219,12 @@ public:
     }
   }
 
+  // Makes the codecs write the frames one at a time, for the tests counting them as written.
+  void writeFramesOneAtATime() {
+    scoped_runtime_.mergeValues(
+        {{"envoy.reloadable_features.http2_batch_outbound_frames", "false"}});
+  }
+
   void setupHttp2Overrides() {
     switch (http2_implementation_) {
     case Http2Impl::Nghttp2:
@@ -643,6 +649,81 @@ TEST_P(Http2CodecImplTest, SimpleRequestResponseOldApi) {
   }
 }
 
+// Verify that the frames serialized together are written together, the DATA frames referring to the
+// body slices rather than copying them.
+TEST_P(Http2CodecImplTest, OutboundFramesBatched) {
+  initialize();
+
+  TestRequestHeaderMapImpl request_headers;
+  HttpTestUtility::addDefaultHeaders(request_headers);
+  EXPECT_CALL(request_decoder_, decodeHeaders_(_, true));
+  EXPECT_TRUE(request_encoder_->encodeHeaders(request_headers, true).ok());
+  driveToCompletion();
+
+  TestResponseHeaderMapImpl response_headers{{":status", "200"}};
+  response_encoder_->encodeHeaders(response_headers, false);
+
+  // The DATA frames of the body are written at once.
+  Buffer::OwnedImpl response_body(std::string(3 * 16384, 'b'));
+  const void* response_body_mem = response_body.frontSlice().mem_;
+  int write_count = 0;
+  std::vector<const void*> written_mem;
+  ON_CALL(server_connection_, write(_, _))
+      .WillByDefault(Invoke([&](Buffer::Instance& data, bool) {
+        ++write_count;
+        for (const Buffer::RawSlice& slice : data.getRawSlices()) {
+          written_mem.push_back(slice.mem_);
+        }
+        client_wrapper_->buffer_.add(data);
+      }));
+  response_encoder_->encodeData(response_body, true);
+  EXPECT_EQ(1, write_count);
+  EXPECT_THAT(written_mem, testing::Contains(response_body_mem));
+
+  EXPECT_CALL(response_decoder_, decodeHeaders_(_, false));
+  EXPECT_CALL(response_decoder_, decodeData(_, _)).Times(AtLeast(1));
+  driveToCompletion();
+}
+
+// The header block submitted to the HTTP/2 library borrows the header map, verify that the
+// headers are still sent correctly when the header map is destroyed right after encoding.
+TEST_P(Http2CodecImplTest, HeaderMapDestroyedAfterEncode) {
+  initialize();
+
+  InSequence s;
+  TestRequestHeaderMapImpl expected_request_headers;
+  HttpTestUtility::addDefaultHeaders(expected_request_headers);
+  expected_request_headers.addCopy("x-copied", std::string(256, 'a'));
+  {
+    auto request_headers = std::make_unique<TestRequestHeaderMapImpl>(expected_request_headers);
+    EXPECT_TRUE(request_encoder_->encodeHeaders(*request_headers, false).ok());
+    request_headers->setCopy(LowerCaseString("x-copied"), "mutated");
+  }
+  EXPECT_CALL(request_decoder_, decodeHeaders_(HeaderMapEqual(&expected_request_headers), false));
+  driveToCompletion();
+
+  TestRequestTrailerMapImpl expected_request_trailers{{"trailing", "value"}};
+  {
+    auto request_trailers = std::make_unique<TestRequestTrailerMapImpl>(expected_request_trailers);
+    request_encoder_->encodeTrailers(*request_trailers);
+  }
+  EXPECT_CALL(request_decoder_, decodeTrailers_(HeaderMapEqual(&expected_request_trailers)));
+  driveToCompletion();
+
+  TestResponseHeaderMapImpl expected_response_headers{{":status", "200"},
+                                                      {"x-copied", std::string(256, 'b')}};
+  {
+    auto response_headers = std::make_unique<TestResponseHeaderMapImpl>(expected_response_headers);
+    response_encoder_->encodeHeaders(*response_headers, true);
+  }
+  EXPECT_CALL(response_decoder_,
+              decodeHeaders_(HeaderMapEqual(&expected_response_headers), true));
+  driveToCompletion();
+
+  EXPECT_TRUE(client_wrapper_->status_.ok());
+  EXPECT_TRUE(server_wrapper_->status_.ok());
+}
+
 TEST_P(Http2CodecImplTest, ShutdownNotice) {
   initialize();
   EXPECT_EQ(absl::nullopt, request_encoder_->http1StreamEncoderOptions());
@@ -2185,6 +2266,57 @@ TEST_P(Http2CodecImplFlowControlTest, PendingRecvBufferBoundedWhenDeferProcessin
   }
 }
 
+// Verify that the connection window is grown when the peer sends a window's worth of data within
+// the round trip of a BDP ping.
+TEST_P(Http2CodecImplFlowControlTest, ConnectionWindowAutotuning) {
+  server_http2_options_.mutable_max_connection_window_size()->set_value(1024 * 1024);
+  initialize();
+
+  TestRequestHeaderMapImpl request_headers;
+  HttpTestUtility::addDefaultHeaders(request_headers);
+  EXPECT_CALL(request_decoder_, decodeHeaders_(_, false));
+  EXPECT_TRUE(request_encoder_->encodeHeaders(request_headers, false).ok());
+  driveToCompletion();
+
+  const uint32_t initial_connection_window = getSendWindowSize(client_);
+  ASSERT_EQ(initial_connection_window, 65535);
+
+  EXPECT_CALL(request_decoder_, decodeData(_, false)).Times(AnyNumber());
+  Buffer::OwnedImpl data(std::string(initial_connection_window, 'a'));
+  request_encoder_->encodeData(data, false);
+  driveToCompletion();
+
+  // The consumed data is given back, and the window doubled on top of it.
+  EXPECT_EQ(1, server_stats_store_.counter("http2.connection_window_autotuned").value());
+  EXPECT_EQ(initial_connection_window,
+            server_stats_store_.gauge("http2.connection_window_autotuned_bytes",
+                                      Stats::Gauge::ImportMode::Accumulate)
+                .value());
+  EXPECT_EQ(2 * initial_connection_window, getSendWindowSize(client_));
+}
+
+// Verify that the connection window isn't grown while the data is held back by a read disabled
+// stream rather than by the window.
+TEST_P(Http2CodecImplFlowControlTest, ConnectionWindowAutotuningWhileReadDisabled) {
+  server_http2_options_.mutable_max_connection_window_size()->set_value(1024 * 1024);
+  initialize();
+
+  TestRequestHeaderMapImpl request_headers;
+  HttpTestUtility::addDefaultHeaders(request_headers);
+  EXPECT_CALL(request_decoder_, decodeHeaders_(_, false));
+  EXPECT_TRUE(request_encoder_->encodeHeaders(request_headers, false).ok());
+  driveToCompletion();
+
+  server_->getStream(1)->readDisable(true);
+  EXPECT_CALL(request_decoder_, decodeData(_, false)).Times(AnyNumber());
+  Buffer::OwnedImpl data(std::string(getSendWindowSize(client_), 'a'));
+  request_encoder_->encodeData(data, false);
+  driveToCompletion();
+
+  EXPECT_EQ(0, server_stats_store_.counter("http2.connection_window_autotuned").value());
+  EXPECT_EQ(0, getSendWindowSize(client_));
+}
+
 // Verify that we create and disable the stream flush timer when trailers follow a stream that
 // does not have enough window.
 TEST_P(Http2CodecImplFlowControlTest, TrailingHeadersLargeServerBody) {
@@ -2350,6 +2482,7 @@ TEST_P(Http2CodecImplFlowControlTest, LargeServerBodyFlushTimeoutAfterGoaway) {
 // Verify detection of downstream outbound frame queue by the WINDOW_UPDATE frames
 // sent when codec resumes reading.
 TEST_P(Http2CodecImplFlowControlTest, WindowUpdateOnReadResumingFlood) {
+  writeFramesOneAtATime();
   initialize();
 
   TestRequestHeaderMapImpl request_headers;
@@ -2431,6 +2564,7 @@ TEST_P(Http2CodecImplFlowControlTest, WindowUpdateOnReadResumingFlood) {
 // Verify detection of outbound queue flooding by the RST_STREAM frame sent by the pending flush
 // timeout.
 TEST_P(Http2CodecImplFlowControlTest, RstStreamOnPendingFlushTimeoutFlood) {
+  writeFramesOneAtATime();
   // This test sets initial stream window to 65535 bytes.
   initialize();
 
@@ -3105,6 +3239,7 @@ TEST_P(Http2CodecImplTestAll, TestCodecHeaderCompression) {
 
 // Verify that codec detects PING flood
 TEST_P(Http2CodecImplTest, PingFlood) {
+  writeFramesOneAtATime();
   initialize();
 
   TestRequestHeaderMapImpl request_headers;
@@ -3137,6 +3272,7 @@ TEST_P(Http2CodecImplTest, PingFlood) {
 
 // Verify that codec allows PING flood when mitigation is disabled
 TEST_P(Http2CodecImplTest, PingFloodMitigationDisabled) {
+  writeFramesOneAtATime();
   max_outbound_control_frames_ = 2147483647;
   initialize();
 
@@ -3159,6 +3295,7 @@ TEST_P(Http2CodecImplTest, PingFloodMitigationDisabled) {
 
 // Verify that outbound control frame counter decreases when send buffer is drained
 TEST_P(Http2CodecImplTest, PingFloodCounterReset) {
+  writeFramesOneAtATime();
   // Ping frames are 17 bytes each so 240 full frames and a partial frame fit in the current min
   // size for buffer slices. Setting the limit to 2x+1 the number that fits in a single slice allows
   // the logic below that verifies drain and overflow thresholds.
@@ -3211,6 +3348,7 @@ TEST_P(Http2CodecImplTest, PingFloodCounterReset) {
 
 // Verify that codec detects flood of outbound HEADER frames
 TEST_P(Http2CodecImplTest, ResponseHeadersFlood) {
+  writeFramesOneAtATime();
   initialize();
 
   TestRequestHeaderMapImpl request_headers;
@@ -3245,6 +3383,7 @@ TEST_P(Http2CodecImplTest, ResponseHeadersFlood) {
 
 // Verify that codec detects flood of outbound DATA frames
 TEST_P(Http2CodecImplTest, ResponseDataFlood) {
+  writeFramesOneAtATime();
   initialize();
 
   TestRequestHeaderMapImpl request_headers;
@@ -3283,6 +3422,7 @@ TEST_P(Http2CodecImplTest, ResponseDataFlood) {
 
 // Verify that codec allows outbound DATA flood when mitigation is disabled
 TEST_P(Http2CodecImplTest, ResponseDataFloodMitigationDisabled) {
+  writeFramesOneAtATime();
   max_outbound_control_frames_ = 2147483647;
   initialize();
 
@@ -3314,6 +3454,7 @@ TEST_P(Http2CodecImplTest, ResponseDataFloodMitigationDisabled) {
 
 // Verify that outbound frame counter decreases when send buffer is drained
 TEST_P(Http2CodecImplTest, ResponseDataFloodCounterReset) {
+  writeFramesOneAtATime();
   static const int kMaxOutboundFrames = 100;
   max_outbound_frames_ = kMaxOutboundFrames;
   initialize();
@@ -3361,6 +3502,7 @@ TEST_P(Http2CodecImplTest, ResponseDataFloodCounterReset) {
 
 // Verify that control frames are added to the counter of outbound frames of all types.
 TEST_P(Http2CodecImplTest, PingStacksWithDataFlood) {
+  writeFramesOneAtATime();
   initialize();
 
   TestRequestHeaderMapImpl request_headers;
@@ -3398,6 +3540,7 @@ TEST_P(Http2CodecImplTest, PingStacksWithDataFlood) {
 
 // Verify that codec detects flood of outbound trailers
 TEST_P(Http2CodecImplTest, ResponseTrailersFlood) {
+  writeFramesOneAtATime();
   initialize();
 
   TestRequestHeaderMapImpl request_headers;
@@ -3440,6 +3583,7 @@ TEST_P(Http2CodecImplTest, ResponseTrailersFlood) {
 
 // Verify that codec detects flood of outbound METADATA frames
 TEST_P(Http2CodecImplTest, MetadataFlood) {
+  writeFramesOneAtATime();
   allow_metadata_ = true;
   initialize();
 
@@ -3570,6 +3714,7 @@ TEST_P(Http2CodecImplTest, EmptyDataFloodOverride) {
 
 // Verify that codec detects flood of outbound frames caused by goAway() method
 TEST_P(Http2CodecImplTest, GoAwayCausesOutboundFlood) {
+  writeFramesOneAtATime();
   initialize();
 
   TestRequestHeaderMapImpl request_headers;
@@ -3613,6 +3758,7 @@ TEST_P(Http2CodecImplTest, GoAwayCausesOutboundFlood) {
 
 // Verify that codec detects flood of outbound frames caused by shutdownNotice() method
 TEST_P(Http2CodecImplTest, ShutdownNoticeCausesOutboundFlood) {
+  writeFramesOneAtATime();
   initialize();
 
   TestRequestHeaderMapImpl request_headers;
@@ -3656,6 +3802,7 @@ TEST_P(Http2CodecImplTest, ShutdownNoticeCausesOutboundFlood) {
 
 // Verify that codec detects flood of outbound PING frames caused by the keep alive timer
 TEST_P(Http2CodecImplTest, KeepAliveCausesOutboundFlood) {
+  writeFramesOneAtATime();
   // set-up server to send PING frames
   constexpr uint32_t interval_ms = 100;
   constexpr uint32_t timeout_ms = 200;
@@ -3713,6 +3860,7 @@ TEST_P(Http2CodecImplTest, KeepAliveCausesOutboundFlood) {
 
 // Verify that codec detects flood of RST_STREAM frame caused by resetStream() method
 TEST_P(Http2CodecImplTest, ResetStreamCausesOutboundFlood) {
+  writeFramesOneAtATime();
   initialize();
 
   TestRequestHeaderMapImpl request_headers;
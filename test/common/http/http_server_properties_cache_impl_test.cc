@@ -15,6 +15,17 @@ namespace Http {
 namespace {
 
 static const absl::optional<std::chrono::seconds> kNoTtl = absl::nullopt;
+
+class MockObserver : public HttpServerPropertiesCacheImpl::Observer {
+public:
+  MOCK_METHOD(void, onAlternatives,
+              (const HttpServerPropertiesCache::Origin& origin,
+               const std::vector<HttpServerPropertiesCache::AlternateProtocol>& protocols));
+  MOCK_METHOD(void, onSrtt,
+              (const HttpServerPropertiesCache::Origin& origin, std::chrono::microseconds srtt));
+  MOCK_METHOD(void, onHttp3Broken, (const HttpServerPropertiesCache::Origin& origin));
+};
+
 class HttpServerPropertiesCacheImplTest : public testing::Test {
 public:
   HttpServerPropertiesCacheImplTest()
@@ -424,6 +435,32 @@ TEST_F(HttpServerPropertiesCacheImplTest, ExplicitAlternativeTakesPriorityOverCa
   EXPECT_EQ(protocols2_, protocols.ref());
 }
 
+// Test that the observer is notified of the properties learned by the cache, but not of the ones
+// applied from another cache.
+TEST_F(HttpServerPropertiesCacheImplTest, Observer) {
+  initialize();
+  auto observer = std::make_unique<testing::StrictMock<MockObserver>>();
+  auto& observer_ref = *observer;
+  protocols_->setObserver(std::move(observer));
+
+  EXPECT_CALL(observer_ref, onAlternatives(origin1_, protocols1_));
+  protocols_->setAlternatives(origin1_, protocols1_);
+  EXPECT_CALL(observer_ref, onSrtt(origin1_, std::chrono::microseconds(5)));
+  protocols_->setSrtt(origin1_, std::chrono::microseconds(5));
+  EXPECT_CALL(observer_ref, onHttp3Broken(origin1_));
+  protocols_->getOrCreateHttp3StatusTracker(origin1_).markHttp3Broken();
+  protocols_->setConcurrentStreams(origin1_, 5);
+  testing::Mock::VerifyAndClearExpectations(&observer_ref);
+
+  protocols_->applyAlternatives(origin2_, protocols2_);
+  protocols_->applySrtt(origin2_, std::chrono::microseconds(10));
+  protocols_->applyHttp3Broken(origin2_);
+  ASSERT_TRUE(protocols_->findAlternatives(origin2_).has_value());
+  EXPECT_EQ(protocols2_, protocols_->findAlternatives(origin2_).ref());
+  EXPECT_EQ(std::chrono::microseconds(10), protocols_->getSrtt(origin2_));
+  EXPECT_TRUE(protocols_->getOrCreateHttp3StatusTracker(origin2_).isHttp3Broken());
+}
+
 } // namespace
 } // namespace Http
 } // namespace Envoy
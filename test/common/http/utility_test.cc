@@ -149,6 +149,29 @@ TEST(HttpUtility, parseQueryString) {
   EXPECT_EQ(expected, Utility::QueryParamsMulti::parseAndDecodeQueryString(input).data());
 }
 
+TEST(HttpUtility, parseQueryStringCached) {
+  using Vec = std::vector<std::string>;
+  using Map = absl::btree_map<std::string, Vec>;
+
+  EXPECT_EQ(Map{}, Utility::QueryParamsMulti::parseQueryStringCached("/hello").data());
+  EXPECT_EQ(Map{}, Utility::QueryParamsMulti::parseAndDecodeQueryStringCached("/hello?").data());
+
+  const Utility::QueryParamsMulti& params =
+      Utility::QueryParamsMulti::parseQueryStringCached("/hello?a=1%262&b=3");
+  EXPECT_EQ((Map{{"a", Vec{"1%262"}}, {"b", Vec{"3"}}}), params.data());
+  // The parameters of the same query string aren't parsed again, even in another path.
+  EXPECT_EQ(&params, &Utility::QueryParamsMulti::parseQueryStringCached("/world?a=1%262&b=3"));
+  EXPECT_EQ(
+      (Map{{"a", Vec{"1&2"}}, {"b", Vec{"3"}}}),
+      Utility::QueryParamsMulti::parseAndDecodeQueryStringCached("/hello?a=1%262&b=3").data());
+  EXPECT_EQ((Map{{"a", Vec{"1%262"}}, {"b", Vec{"3"}}}), params.data());
+
+  // A different query string is parsed again.
+  EXPECT_EQ((Map{{"c", Vec{""}}}),
+            Utility::QueryParamsMulti::parseQueryStringCached("/hello?c").data());
+  EXPECT_EQ(Map{}, Utility::QueryParamsMulti::parseQueryStringCached("/hello?").data());
+}
+
 TEST(HttpUtility, stripQueryString) {
   EXPECT_EQ(Utility::stripQueryString(HeaderString("/")), "/");
   EXPECT_EQ(Utility::stripQueryString(HeaderString("/?")), "/");
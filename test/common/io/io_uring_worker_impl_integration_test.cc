@@ -89,8 +89,10 @@ public:
 
 class IoUringWorkerTestImpl : public IoUringWorkerImpl {
 public:
-  IoUringWorkerTestImpl(IoUringPtr io_uring_instance, Event::Dispatcher& dispatcher)
-      : IoUringWorkerImpl(std::move(io_uring_instance), 8192, 1000, dispatcher) {}
+  IoUringWorkerTestImpl(IoUringPtr io_uring_instance, Event::Dispatcher& dispatcher,
+                        uint32_t num_provided_buffers = 0, bool batch_submissions = false)
+      : IoUringWorkerImpl(std::move(io_uring_instance), 8192, 1000, dispatcher,
+                          num_provided_buffers, batch_submissions) {}
 
   IoUringSocket& addTestSocket(os_fd_t fd) {
     return addSocket(std::make_unique<IoUringSocketTestImpl>(fd, *this));
@@ -109,11 +111,12 @@ protected:
     }
   }
 
-  void initialize() {
+  void initialize(uint32_t num_provided_buffers = 0, bool batch_submissions = false) {
     api_ = Api::createApiForTest(time_system_);
     dispatcher_ = api_->allocateDispatcher("test_thread");
     io_uring_worker_ = std::make_unique<IoUringWorkerTestImpl>(
-        std::make_unique<IoUringImpl>(20, false), *dispatcher_);
+        std::make_unique<IoUringImpl>(20, false), *dispatcher_, num_provided_buffers,
+        batch_submissions);
   }
 
   void createListenerAndConnectedSocketPair() {
@@ -315,6 +318,39 @@ TEST_F(IoUringWorkerIntegrationTest, ServerSocketRead) {
   cleanup();
 }
 
+// Reads with multishot recv requests into provided buffers, or with a request per read on kernels
+// without provided buffer rings, and submits once per dispatcher loop iteration.
+TEST_F(IoUringWorkerIntegrationTest, ServerSocketReadWithProvidedBuffers) {
+  initialize(16, true);
+  createListenerAndConnectedSocketPair();
+
+  Buffer::OwnedImpl received;
+  OptRef<IoUringSocket> socket;
+  socket = io_uring_worker_->addServerSocket(
+      server_socket_,
+      [&socket, &received](uint32_t events) {
+        ASSERT(events == Event::FileReadyType::Read);
+        received.move(socket->getReadParam()->buf_);
+        return absl::OkStatus();
+      },
+      false);
+
+  std::string write_data = "hello world";
+  for (int i = 0; i < 3; i++) {
+    Api::OsSysCallsSingleton::get().write(client_socket_, write_data.data(), write_data.size());
+    while (received.length() < (i + 1) * write_data.size()) {
+      dispatcher_->run(Event::Dispatcher::RunType::NonBlock);
+    }
+  }
+  EXPECT_EQ(absl::StrCat(write_data, write_data, write_data), received.toString());
+  received.drain(received.length());
+
+  socket->close(false);
+  runToClose(server_socket_);
+  EXPECT_EQ(io_uring_worker_->getSockets().size(), 0);
+  cleanup();
+}
+
 TEST_F(IoUringWorkerIntegrationTest, ServerSocketReadError) {
   initialize();
 
@@ -34,8 +34,10 @@ public:
 
 class IoUringWorkerTestImpl : public IoUringWorkerImpl {
 public:
-  IoUringWorkerTestImpl(IoUringPtr io_uring_instance, Event::Dispatcher& dispatcher)
-      : IoUringWorkerImpl(std::move(io_uring_instance), 8192, 1000, dispatcher) {}
+  IoUringWorkerTestImpl(IoUringPtr io_uring_instance, Event::Dispatcher& dispatcher,
+                        uint32_t num_provided_buffers = 0, bool batch_submissions = false)
+      : IoUringWorkerImpl(std::move(io_uring_instance), 8192, 1000, dispatcher,
+                          num_provided_buffers, batch_submissions) {}
 
   IoUringSocket& addTestSocket(os_fd_t fd) {
     return addSocket(std::make_unique<IoUringSocketTestImpl>(fd, *this));
@@ -219,7 +221,7 @@ TEST(IoUringWorkerImplTest, ServerSocketInjectAfterWrite) {
   EXPECT_CALL(mock_io_uring, forEveryCompletion(_))
       .WillOnce(Invoke([&io_uring_socket](const CompletionCb& cb) {
         auto* req = new Request(Request::RequestType::Write, io_uring_socket);
-        cb(req, -EAGAIN, true);
+        cb(req, -EAGAIN, 0, true);
       }));
   EXPECT_CALL(mock_io_uring, submit()).Times(1).RetiresOnSaturation();
   ASSERT_TRUE(file_event_callback(Event::FileReadyType::Read).ok());
@@ -245,9 +247,9 @@ TEST(IoUringWorkerImplTest, ServerSocketInjectAfterWrite) {
   // Finish the read, cancel and write request, then expect the close request submitted.
   EXPECT_CALL(mock_io_uring, forEveryCompletion(_))
       .WillOnce(Invoke([&read_req, &cancel_req, &write_req](const CompletionCb& cb) {
-        cb(read_req, -EAGAIN, false);
-        cb(cancel_req, 0, false);
-        cb(write_req, -EAGAIN, false);
+        cb(read_req, -EAGAIN, 0, false);
+        cb(cancel_req, 0, 0, false);
+        cb(write_req, -EAGAIN, 0, false);
       }));
   Request* close_req = nullptr;
   EXPECT_CALL(mock_io_uring, prepareClose(_, _))
@@ -258,7 +260,7 @@ TEST(IoUringWorkerImplTest, ServerSocketInjectAfterWrite) {
 
   // After the close request finished, the socket will be cleanup.
   EXPECT_CALL(mock_io_uring, forEveryCompletion(_))
-      .WillOnce(Invoke([&close_req](const CompletionCb& cb) { cb(close_req, 0, false); }));
+      .WillOnce(Invoke([&close_req](const CompletionCb& cb) { cb(close_req, 0, 0, false); }));
   EXPECT_CALL(mock_io_uring, removeInjectedCompletion(fd));
   EXPECT_CALL(dispatcher, deferredDelete_);
   EXPECT_CALL(dispatcher, clearDeferredDeleteList());
@@ -297,7 +299,7 @@ TEST(IoUringWorkerImplTest, ServerSocketInjectAfterRead) {
   EXPECT_CALL(mock_io_uring, forEveryCompletion(_))
       .WillOnce(Invoke([&io_uring_socket](const CompletionCb& cb) {
         auto* req = new Request(Request::RequestType::Write, io_uring_socket);
-        cb(req, -EAGAIN, true);
+        cb(req, -EAGAIN, 0, true);
       }));
   EXPECT_CALL(mock_io_uring, submit()).Times(1).RetiresOnSaturation();
   ASSERT_TRUE(file_event_callback(Event::FileReadyType::Read).ok());
@@ -314,8 +316,8 @@ TEST(IoUringWorkerImplTest, ServerSocketInjectAfterRead) {
   // Finish the read and cancel request, then expect the close request submitted.
   EXPECT_CALL(mock_io_uring, forEveryCompletion(_))
       .WillOnce(Invoke([&read_req, &cancel_req](const CompletionCb& cb) {
-        cb(read_req, -EAGAIN, false);
-        cb(cancel_req, 0, false);
+        cb(read_req, -EAGAIN, 0, false);
+        cb(cancel_req, 0, 0, false);
       }));
   Request* close_req = nullptr;
   EXPECT_CALL(mock_io_uring, prepareClose(_, _))
@@ -326,7 +328,7 @@ TEST(IoUringWorkerImplTest, ServerSocketInjectAfterRead) {
 
   // After the close request finished, the socket will be cleanup.
   EXPECT_CALL(mock_io_uring, forEveryCompletion(_))
-      .WillOnce(Invoke([&close_req](const CompletionCb& cb) { cb(close_req, 0, false); }));
+      .WillOnce(Invoke([&close_req](const CompletionCb& cb) { cb(close_req, 0, 0, false); }));
   EXPECT_CALL(mock_io_uring, removeInjectedCompletion(fd));
   EXPECT_CALL(dispatcher, deferredDelete_);
   EXPECT_CALL(dispatcher, clearDeferredDeleteList());
@@ -382,13 +384,13 @@ TEST(IoUringWorkerImplTest, CloseAllSocketsWhenDestruction) {
         EXPECT_CALL(mock_io_uring, removeInjectedCompletion(fd));
 
         // Fake the read request cancel completion.
-        cb(read_req, -ECANCELED, false);
+        cb(read_req, -ECANCELED, 0, false);
 
         // Fake the cancel request is done.
-        cb(cancel_req, 0, false);
+        cb(cancel_req, 0, 0, false);
 
         // Fake the close request is done.
-        cb(close_req, 0, false);
+        cb(close_req, 0, 0, false);
       }));
 
   EXPECT_CALL(dispatcher, deferredDelete_);
@@ -424,7 +426,7 @@ TEST(IoUringWorkerImplTest, ServerCloseWithWriteRequestOnly) {
   io_uring_socket.disableRead();
   // Fake the read request finish.
   EXPECT_CALL(mock_io_uring, forEveryCompletion(_))
-      .WillOnce(Invoke([&read_req](const CompletionCb& cb) { cb(read_req, -EAGAIN, false); }));
+      .WillOnce(Invoke([&read_req](const CompletionCb& cb) { cb(read_req, -EAGAIN, 0, false); }));
   EXPECT_CALL(mock_io_uring, submit()).Times(1).RetiresOnSaturation();
   ASSERT_TRUE(file_event_callback(Event::FileReadyType::Read).ok());
 
@@ -450,13 +452,13 @@ TEST(IoUringWorkerImplTest, ServerCloseWithWriteRequestOnly) {
             .RetiresOnSaturation();
         EXPECT_CALL(mock_io_uring, submit()).Times(1).RetiresOnSaturation();
 
-        cb(write_req, -EAGAIN, false);
+        cb(write_req, -EAGAIN, 0, false);
       }));
   ASSERT_TRUE(file_event_callback(Event::FileReadyType::Read).ok());
 
   // After the close request finished, the socket will be cleanup.
   EXPECT_CALL(mock_io_uring, forEveryCompletion(_))
-      .WillOnce(Invoke([&close_req](const CompletionCb& cb) { cb(close_req, 0, false); }));
+      .WillOnce(Invoke([&close_req](const CompletionCb& cb) { cb(close_req, 0, 0, false); }));
   EXPECT_CALL(mock_io_uring, removeInjectedCompletion(fd));
   EXPECT_CALL(dispatcher, deferredDelete_);
   EXPECT_CALL(dispatcher, clearDeferredDeleteList());
@@ -699,6 +701,217 @@ TEST(IoUringWorkerImplTest, NoEnableReadOnConnectError) {
   delete static_cast<Request*>(connect_req);
 }
 
+// The worker reads with a multishot recv request, whose provided buffers are handed to the read
+// buffer without a copy and given back to the ring once drained.
+TEST(IoUringWorkerImplTest, MultishotRecvIntoProvidedBuffers) {
+  Event::MockDispatcher dispatcher;
+  IoUringPtr io_uring_instance = std::make_unique<MockIoUring>();
+  MockIoUring& mock_io_uring = *dynamic_cast<MockIoUring*>(io_uring_instance.get());
+  Event::FileReadyCb file_event_callback;
+
+  EXPECT_CALL(mock_io_uring, registerEventfd());
+  EXPECT_CALL(dispatcher,
+              createFileEvent_(_, _, Event::PlatformDefaultTriggerType, Event::FileReadyType::Read))
+      .WillOnce(
+          DoAll(SaveArg<1>(&file_event_callback), ReturnNew<NiceMock<Event::MockFileEvent>>()));
+  uint8_t* provided_buffers = nullptr;
+  EXPECT_CALL(mock_io_uring, registerProvidedBuffers(_, 4, 8192))
+      .WillOnce(DoAll(SaveArg<0>(&provided_buffers), Return(true)));
+  IoUringWorkerTestImpl worker(std::move(io_uring_instance), dispatcher, 4);
+
+  Request* read_req = nullptr;
+  EXPECT_CALL(mock_io_uring, prepareRecvMultishot(0, _))
+      .WillOnce(DoAll(SaveArg<1>(&read_req), Return<IoUringResult>(IoUringResult::Ok)));
+  EXPECT_CALL(mock_io_uring, submit()).Times(1).RetiresOnSaturation();
+  Buffer::OwnedImpl received;
+  IoUringSocket* socket = nullptr;
+  socket = &worker.addServerSocket(
+      0,
+      [&socket, &received](uint32_t events) {
+        EXPECT_EQ(events, Event::FileReadyType::Read);
+        received.move(socket->getReadParam()->buf_);
+        return absl::OkStatus();
+      },
+      false);
+
+  // Two reads complete into the buffers 1 and 3, and the request stays armed.
+  memcpy(provided_buffers + 8192, "hello", 5);
+  memcpy(provided_buffers + 3 * 8192, "world", 5);
+  EXPECT_CALL(mock_io_uring, forEveryCompletion(_))
+      .WillOnce(Invoke([&read_req](const CompletionCb& cb) {
+        const uint32_t flags = IORING_CQE_F_MORE | IORING_CQE_F_BUFFER;
+        cb(read_req, 5, flags | (1 << IORING_CQE_BUFFER_SHIFT), false);
+        cb(read_req, 5, flags | (3 << IORING_CQE_BUFFER_SHIFT), false);
+      }));
+  EXPECT_CALL(mock_io_uring, submit()).Times(1).RetiresOnSaturation();
+  ASSERT_TRUE(file_event_callback(Event::FileReadyType::Read).ok());
+  EXPECT_EQ("helloworld", received.toString());
+  EXPECT_EQ(provided_buffers + 8192, received.frontSlice().mem_);
+
+  EXPECT_CALL(mock_io_uring, recycleProvidedBuffer(1));
+  received.drain(5);
+  EXPECT_CALL(mock_io_uring, recycleProvidedBuffer(3));
+  received.drain(5);
+
+  // The IoUringWorker closes the socket, which cancels the multishot recv request.
+  Request* cancel_req = nullptr;
+  EXPECT_CALL(mock_io_uring, prepareCancel(read_req, _))
+      .WillOnce(DoAll(SaveArg<1>(&cancel_req), Return<IoUringResult>(IoUringResult::Ok)))
+      .RetiresOnSaturation();
+  EXPECT_CALL(mock_io_uring, submit()).Times(1).RetiresOnSaturation();
+  EXPECT_CALL(mock_io_uring, forEveryCompletion(_))
+      .WillOnce(Invoke([&mock_io_uring, &read_req, &cancel_req](const CompletionCb& cb) {
+        Request* close_req = nullptr;
+        EXPECT_CALL(mock_io_uring, prepareClose(0, _))
+            .WillOnce(DoAll(SaveArg<1>(&close_req), Return<IoUringResult>(IoUringResult::Ok)))
+            .RetiresOnSaturation();
+        EXPECT_CALL(mock_io_uring, submit()).Times(1).RetiresOnSaturation();
+        EXPECT_CALL(mock_io_uring, removeInjectedCompletion(0));
+
+        cb(read_req, -ECANCELED, 0, false);
+        cb(cancel_req, 0, 0, false);
+        cb(close_req, 0, 0, false);
+      }));
+  EXPECT_CALL(dispatcher, deferredDelete_);
+  EXPECT_CALL(dispatcher, clearDeferredDeleteList());
+}
+
+// When the provided buffers run out, the socket reads once into a buffer of its own, then goes
+// back to a multishot recv request.
+TEST(IoUringWorkerImplTest, MultishotRecvWithoutProvidedBuffersLeft) {
+  Event::MockDispatcher dispatcher;
+  IoUringPtr io_uring_instance = std::make_unique<MockIoUring>();
+  MockIoUring& mock_io_uring = *dynamic_cast<MockIoUring*>(io_uring_instance.get());
+  Event::FileReadyCb file_event_callback;
+
+  EXPECT_CALL(mock_io_uring, registerEventfd());
+  EXPECT_CALL(dispatcher,
+              createFileEvent_(_, _, Event::PlatformDefaultTriggerType, Event::FileReadyType::Read))
+      .WillOnce(
+          DoAll(SaveArg<1>(&file_event_callback), ReturnNew<NiceMock<Event::MockFileEvent>>()));
+  EXPECT_CALL(mock_io_uring, registerProvidedBuffers(_, 4, 8192)).WillOnce(Return(true));
+  IoUringWorkerTestImpl worker(std::move(io_uring_instance), dispatcher, 4);
+
+  Request* read_req = nullptr;
+  EXPECT_CALL(mock_io_uring, prepareRecvMultishot(0, _))
+      .WillOnce(DoAll(SaveArg<1>(&read_req), Return<IoUringResult>(IoUringResult::Ok)))
+      .RetiresOnSaturation();
+  EXPECT_CALL(mock_io_uring, submit()).Times(1).RetiresOnSaturation();
+  Buffer::OwnedImpl received;
+  IoUringSocket* socket = nullptr;
+  socket = &worker.addServerSocket(
+      0,
+      [&socket, &received](uint32_t) {
+        received.move(socket->getReadParam()->buf_);
+        return absl::OkStatus();
+      },
+      false);
+
+  EXPECT_CALL(mock_io_uring, forEveryCompletion(_))
+      .WillOnce(Invoke([&mock_io_uring, &read_req](const CompletionCb& cb) {
+        EXPECT_CALL(mock_io_uring, prepareReadv(0, _, _, _, _))
+            .WillOnce(DoAll(Invoke([](os_fd_t, const struct iovec* iov, unsigned, off_t,
+                                      Request*) { memcpy(iov->iov_base, "hello", 5); }),
+                            SaveArg<4>(&read_req), Return<IoUringResult>(IoUringResult::Ok)));
+        cb(read_req, -ENOBUFS, 0, false);
+      }));
+  EXPECT_CALL(mock_io_uring, submit()).Times(1).RetiresOnSaturation();
+  ASSERT_TRUE(file_event_callback(Event::FileReadyType::Read).ok());
+  EXPECT_EQ(0, received.length());
+
+  EXPECT_CALL(mock_io_uring, forEveryCompletion(_))
+      .WillOnce(Invoke([&mock_io_uring, &read_req](const CompletionCb& cb) {
+        Request* readv_req = read_req;
+        EXPECT_CALL(mock_io_uring, prepareRecvMultishot(0, _))
+            .WillOnce(DoAll(SaveArg<1>(&read_req), Return<IoUringResult>(IoUringResult::Ok)));
+        cb(readv_req, 5, 0, false);
+      }));
+  EXPECT_CALL(mock_io_uring, submit()).Times(1).RetiresOnSaturation();
+  ASSERT_TRUE(file_event_callback(Event::FileReadyType::Read).ok());
+  EXPECT_EQ("hello", received.toString());
+
+  Request* cancel_req = nullptr;
+  EXPECT_CALL(mock_io_uring, prepareCancel(read_req, _))
+      .WillOnce(DoAll(SaveArg<1>(&cancel_req), Return<IoUringResult>(IoUringResult::Ok)))
+      .RetiresOnSaturation();
+  EXPECT_CALL(mock_io_uring, submit()).Times(1).RetiresOnSaturation();
+  EXPECT_CALL(mock_io_uring, forEveryCompletion(_))
+      .WillOnce(Invoke([&mock_io_uring, &read_req, &cancel_req](const CompletionCb& cb) {
+        Request* close_req = nullptr;
+        EXPECT_CALL(mock_io_uring, prepareClose(0, _))
+            .WillOnce(DoAll(SaveArg<1>(&close_req), Return<IoUringResult>(IoUringResult::Ok)))
+            .RetiresOnSaturation();
+        EXPECT_CALL(mock_io_uring, submit()).Times(1).RetiresOnSaturation();
+        EXPECT_CALL(mock_io_uring, removeInjectedCompletion(0));
+
+        cb(read_req, -ECANCELED, 0, false);
+        cb(cancel_req, 0, 0, false);
+        cb(close_req, 0, 0, false);
+      }));
+  EXPECT_CALL(dispatcher, deferredDelete_);
+  EXPECT_CALL(dispatcher, clearDeferredDeleteList());
+}
+
+// Without kernel support for provided buffer rings, the worker submits a read request per read.
+TEST(IoUringWorkerImplTest, ProvidedBuffersNotSupported) {
+  Event::MockDispatcher dispatcher;
+  IoUringPtr io_uring_instance = std::make_unique<MockIoUring>();
+  MockIoUring& mock_io_uring = *dynamic_cast<MockIoUring*>(io_uring_instance.get());
+
+  EXPECT_CALL(mock_io_uring, registerEventfd());
+  EXPECT_CALL(dispatcher, createFileEvent_(_, _, Event::PlatformDefaultTriggerType,
+                                           Event::FileReadyType::Read));
+  EXPECT_CALL(mock_io_uring, registerProvidedBuffers(_, 4, 8192)).WillOnce(Return(false));
+  IoUringWorkerTestImpl worker(std::move(io_uring_instance), dispatcher, 4);
+
+  IoUringServerSocket socket(
+      0, worker, [](uint32_t) { return absl::OkStatus(); }, 0, false);
+  Request* read_req = nullptr;
+  EXPECT_CALL(mock_io_uring, prepareRecvMultishot(_, _)).Times(0);
+  EXPECT_CALL(mock_io_uring, prepareReadv(0, _, _, _, _))
+      .WillOnce(DoAll(SaveArg<4>(&read_req), Return<IoUringResult>(IoUringResult::Ok)));
+  EXPECT_CALL(mock_io_uring, submit());
+  socket.enableRead();
+
+  EXPECT_CALL(dispatcher, clearDeferredDeleteList());
+  delete read_req;
+}
+
+// With batched submissions, the requests prepared out of completion handling are submitted once
+// at the end of the dispatcher loop iteration.
+TEST(IoUringWorkerImplTest, BatchSubmissions) {
+  Event::MockDispatcher dispatcher;
+  IoUringPtr io_uring_instance = std::make_unique<MockIoUring>();
+  MockIoUring& mock_io_uring = *dynamic_cast<MockIoUring*>(io_uring_instance.get());
+
+  EXPECT_CALL(mock_io_uring, registerEventfd());
+  EXPECT_CALL(dispatcher, createFileEvent_(_, _, Event::PlatformDefaultTriggerType,
+                                           Event::FileReadyType::Read));
+  auto* submit_cb = new NiceMock<Event::MockSchedulableCallback>(&dispatcher);
+  IoUringWorkerTestImpl worker(std::move(io_uring_instance), dispatcher, 0, true);
+
+  IoUringServerSocket socket(
+      0, worker, [](uint32_t) { return absl::OkStatus(); }, 0, false);
+  Request* read_req = nullptr;
+  EXPECT_CALL(mock_io_uring, prepareReadv(0, _, _, _, _))
+      .WillOnce(DoAll(SaveArg<4>(&read_req), Return<IoUringResult>(IoUringResult::Ok)));
+  Request* write_req = nullptr;
+  EXPECT_CALL(mock_io_uring, prepareWritev(0, _, _, _, _))
+      .WillOnce(DoAll(SaveArg<4>(&write_req), Return<IoUringResult>(IoUringResult::Ok)));
+  EXPECT_CALL(*submit_cb, scheduleCallbackCurrentIteration()).Times(2);
+  EXPECT_CALL(mock_io_uring, submit()).Times(0);
+  socket.enableRead();
+  Buffer::OwnedImpl write_buf("hello");
+  socket.write(write_buf);
+
+  EXPECT_CALL(mock_io_uring, submit());
+  submit_cb->invokeCallback();
+
+  EXPECT_CALL(dispatcher, clearDeferredDeleteList());
+  delete read_req;
+  delete write_req;
+}
+
 } // namespace
 } // namespace Io
 } // namespace Envoy
@@ -434,6 +434,39 @@ TEST_F(JsonLoaderTest, AsString) {
   });
 }
 
+TEST_F(JsonLoaderTest, LoadSelected) {
+  const KeySelection selection({{"a", "b"}, {"c"}, {"d", "e", "f"}});
+  const std::string json_string = R"EOF({
+    "a": {"b": {"x": [1, {"y": 2}]}, "skipped": {"z": [3]}},
+    "c": [1, "two", {"three": 3}],
+    "d": {"e": [{"f": 1}], "g": 2},
+    "h": {"c": "not at the root"}
+  })EOF";
+
+  ObjectSharedPtr json = getValid(Factory::loadSelectedFromStringNoThrow(json_string, selection));
+  // The values at the end of the paths are whole, those on the paths which aren't objects are left
+  // out.
+  EXPECT_EQ(R"({"b":{"x":[1,{"y":2}]}})", json->getObject("a")->asJsonString());
+  EXPECT_EQ(3, json->getObjectArray("c").size());
+  EXPECT_TRUE(json->getObject("d")->empty());
+  EXPECT_FALSE(json->hasObject("h"));
+
+  // The arrays are loaded empty, and the other values which aren't objects as nullptr.
+  ObjectSharedPtr array =
+      getValid(Factory::loadSelectedFromStringNoThrow("[{\"a\": 1}]", selection));
+  EXPECT_TRUE(array->isArray());
+  EXPECT_TRUE(array->empty());
+  EXPECT_EQ(nullptr, getValid(Factory::loadSelectedFromStringNoThrow("\"a\"", selection)));
+
+  // The whole document is still validated.
+  EXPECT_FALSE(Factory::loadSelectedFromStringNoThrow("{\"h\": [1,}", selection).ok());
+
+  // An empty path selects the whole document.
+  EXPECT_EQ(Factory::loadFromString(json_string)->asJsonString(),
+            getValid(Factory::loadSelectedFromStringNoThrow(json_string, KeySelection({{}})))
+                ->asJsonString());
+}
+
 TEST_F(JsonLoaderTest, LoadFromStruct) {
   const std::string json_string = R"EOF({
     "struct": {
@@ -19,7 +19,9 @@
 #include "source/common/config/metadata.h"
 #include "source/common/init/manager_impl.h"
 #include "source/common/network/address_impl.h"
+#include "source/common/network/connection_balancer_impl.h"
 #include "source/common/network/io_socket_handle_impl.h"
+#include "source/common/network/reuse_port_cpu_steering_option_impl.h"
 #include "source/common/network/socket_interface_impl.h"
 #include "source/common/network/utility.h"
 #include "source/common/protobuf/protobuf.h"
@@ -998,6 +1000,9 @@ TEST_P(ListenerManagerImplTest, RejectTcpOptionsWithInternalListenerConfig) {
       [](envoy::config::listener::v3::Listener& l) {
         l.mutable_connection_balance_config()->mutable_exact_balance();
       },
+      [](envoy::config::listener::v3::Listener& l) {
+        l.mutable_connection_balance_config()->mutable_cpu_balance();
+      },
       [](envoy::config::listener::v3::Listener& l) { l.mutable_enable_reuse_port(); },
       [](envoy::config::listener::v3::Listener& l) { l.mutable_freebind()->set_value(true); },
       [](envoy::config::listener::v3::Listener& l) { l.mutable_tcp_backlog_size(); },
@@ -7796,6 +7801,21 @@ TEST(ListenerMessageUtilTest, ListenerDefaultFilterChainChangeIsAlwaysFilterChai
   }
 }
 
+TEST(ListenerMessageUtilTest, ListenerFiltersAccessLogsAndBufferLimitAreNewConnectionsOnlyChange) {
+  envoy::config::listener::v3::Listener listener1;
+  listener1.set_name("common");
+  envoy::config::listener::v3::Listener listener2 = listener1;
+  listener2.add_listener_filters()->set_name("envoy.filters.listener.tls_inspector");
+  listener2.add_access_log()->set_name("envoy.access_loggers.stdout");
+  listener2.mutable_per_connection_buffer_limit_bytes()->set_value(8192);
+  listener2.add_filter_chains()->set_name("127.0.0.2");
+
+  EXPECT_FALSE(Server::ListenerMessageUtil::filterChainOnlyChange(listener1, listener2));
+  EXPECT_TRUE(Server::ListenerMessageUtil::newConnectionsOnlyChange(listener1, listener2));
+  listener2.mutable_listener_filters_timeout()->set_seconds(1);
+  EXPECT_FALSE(Server::ListenerMessageUtil::newConnectionsOnlyChange(listener1, listener2));
+}
+
 TEST(ListenerMessageUtilTest, ListenerMessageHaveDifferentFilterChainsAreEquivalent) {
   envoy::config::listener::v3::Listener listener1;
   listener1.set_name("common");
@@ -7927,6 +7947,62 @@ TEST_P(ListenerManagerImplForInPlaceFilterChainUpdateTest,
   EXPECT_EQ(0, server_.stats_store_.counter("listener_manager.listener_in_place_updated").value());
 }
 
+TEST_P(ListenerManagerImplForInPlaceFilterChainUpdateTest, InPlaceUpdateOfBufferLimit) {
+  EXPECT_CALL(*worker_, start(_, _));
+  manager_->startWorkers(guard_dog_, callback_.AsStdFunction());
+
+  auto listener_proto = createDefaultListener();
+  ListenerHandle* listener_foo = expectListenerCreate(false, true);
+  expectAddListener(listener_proto, listener_foo);
+
+  // The buffer limit is updated in place along with a filter chain.
+  auto new_listener_proto = listener_proto;
+  new_listener_proto.mutable_per_connection_buffer_limit_bytes()->set_value(8192);
+  new_listener_proto.mutable_filter_chains(0)
+      ->mutable_filter_chain_match()
+      ->mutable_destination_port()
+      ->set_value(9999);
+  ListenerHandle* listener_foo_update1 = expectListenerOverridden(false, listener_foo);
+  EXPECT_CALL(*listener_factory_.socket_, duplicate());
+  EXPECT_CALL(*worker_, addListener(_, _, _, _, _));
+  EXPECT_CALL(server_.options_, drainTime()).WillOnce(Return(std::chrono::seconds(600)));
+  Event::MockTimer* filter_chain_drain_timer = new Event::MockTimer(&server_.dispatcher_);
+  EXPECT_CALL(*filter_chain_drain_timer, enableTimer(std::chrono::milliseconds(600000), _));
+  EXPECT_TRUE(addOrUpdateListener(new_listener_proto));
+  worker_->callAddCompletion();
+  EXPECT_EQ(1, server_.stats_store_.counter("listener_manager.listener_in_place_updated").value());
+  EXPECT_EQ(8192U, manager_->listeners().front().get().perConnectionBufferLimitBytes());
+
+  EXPECT_CALL(*worker_, removeFilterChains(_, _, _));
+  filter_chain_drain_timer->invokeCallback();
+  EXPECT_CALL(*listener_foo, onDestroy());
+  worker_->callDrainFilterChainsComplete();
+
+  EXPECT_CALL(*listener_foo_update1, onDestroy());
+}
+
+TEST_P(ListenerManagerImplForInPlaceFilterChainUpdateTest,
+       TraditionalUpdateOfPerConnectionBufferLimitIfRuntimeDisabled) {
+  TestScopedRuntime scoped_runtime;
+  scoped_runtime.mergeValues(
+      {{"envoy.reloadable_features.in_place_update_listener_filters_and_access_logs", "false"}});
+  EXPECT_CALL(*worker_, start(_, _));
+  manager_->startWorkers(guard_dog_, callback_.AsStdFunction());
+
+  auto listener_proto = createDefaultListener();
+  ListenerHandle* listener_foo = expectListenerCreate(false, true);
+  expectAddListener(listener_proto, listener_foo);
+
+  ListenerHandle* listener_foo_update1 = expectListenerCreate(false, true);
+  auto new_listener_proto = listener_proto;
+  new_listener_proto.mutable_per_connection_buffer_limit_bytes()->set_value(8192);
+  auto duplicated_socket =
+      expectUpdateToThenDrain(new_listener_proto, listener_foo, *listener_factory_.socket_);
+
+  expectRemove(new_listener_proto, listener_foo_update1, *duplicated_socket);
+  EXPECT_EQ(0, server_.stats_store_.counter("listener_manager.listener_in_place_updated").value());
+}
+
 // This test verifies that on default initialization the UDP Packet Writer
 // is initialized in passthrough mode. (i.e. by using UdpDefaultWriter).
 TEST_P(ListenerManagerImplTest, UdpDefaultWriterConfig) {
@@ -8064,6 +8140,35 @@ TEST_P(ListenerManagerImplWithRealFiltersTest, EmptyConnectionBalanceConfig) {
 #endif
 }
 
+TEST_P(ListenerManagerImplWithRealFiltersTest, CpuConnectionBalanceConfig) {
+// Envoy always use ExactBalance at WIN32, so ignore it.
+#ifndef WIN32
+  auto listener = createIPv4Listener("TCPListener");
+  listener.mutable_enable_reuse_port()->set_value(true);
+  listener.mutable_connection_balance_config()->mutable_cpu_balance();
+  server_.options_.concurrency_ = 2;
+
+  auto listener_impl = ListenerImpl(listener, "version", *manager_, "foo", true, false,
+                                    /*hash=*/static_cast<uint64_t>(0));
+#if defined(SO_ATTACH_REUSEPORT_CBPF) && defined(__linux__)
+  // The connections are steered to the socket of the worker of the CPU that received them.
+  const Network::Socket::OptionsSharedPtr& options = listener_impl.listenSocketOptions(0);
+  ASSERT_NE(nullptr, options);
+  EXPECT_TRUE(std::any_of(options->begin(), options->end(), [](const auto& option) {
+    return dynamic_cast<const Network::ReusePortCpuSteeringOptionImpl*>(option.get()) != nullptr;
+  }));
+#endif
+
+  auto socket_factory = std::make_unique<Network::MockListenSocketFactory>();
+  Network::Address::InstanceConstSharedPtr address(
+      new Network::Address::Ipv4Instance("192.168.0.1", 80, nullptr));
+  EXPECT_CALL(*socket_factory, localAddress()).WillRepeatedly(ReturnRef(address));
+  listener_impl.addSocketFactory(std::move(socket_factory));
+  EXPECT_NE(nullptr, dynamic_cast<Network::CpuConnectionBalancerImpl*>(
+                         &listener_impl.connectionBalancer(*address)));
+#endif
+}
+
 INSTANTIATE_TEST_SUITE_P(Matcher, ListenerManagerImplTest, ::testing::Values(false));
 INSTANTIATE_TEST_SUITE_P(Matcher, ListenerManagerImplWithRealFiltersTest,
                          ::testing::Values(false, true));
@@ -125,6 +125,49 @@ TEST_F(LocalReplyTest, TestDefaultTextFormatter) {
   EXPECT_EQ(content_type_, "text/plain");
 }
 
+TEST_F(LocalReplyTest, TestStaticTextFormatters) {
+  // The formats without any per-request field, which are resolved when configured.
+  const std::string yaml = R"(
+  mappers:
+  - filter:
+      status_code_filter:
+        comparison:
+          op: EQ
+          value:
+            default_value: 503
+            runtime_key: key_b
+    body_format_override:
+      text_format: "%LOCAL_REPLY_BODY%"
+      content_type: "text/html"
+  body_format:
+     text_format_source:
+       inline_string: "service unavailable"
+)";
+  TestUtility::loadFromYaml(yaml, config_);
+  auto local = Factory::create(config_, context_);
+
+  local->rewrite(nullptr, response_headers_, stream_info_, code_, body_, content_type_);
+  EXPECT_EQ(body_, "service unavailable");
+  EXPECT_EQ(content_type_, "text/plain");
+
+  resetData(503);
+  local->rewrite(nullptr, response_headers_, stream_info_, code_, body_, content_type_);
+  EXPECT_EQ(body_, TestInitBody);
+  EXPECT_EQ(content_type_, "text/html");
+
+  // The escaped percent signs are still left to the formatter.
+  envoy::extensions::filters::network::http_connection_manager::v3::LocalReplyConfig config;
+  TestUtility::loadFromYaml(R"(
+  body_format:
+     text_format: "100%% of the time"
+)",
+                            config);
+  local = Factory::create(config, context_);
+  resetData(503);
+  local->rewrite(nullptr, response_headers_, stream_info_, code_, body_, content_type_);
+  EXPECT_EQ(body_, "100% of the time");
+}
+
 TEST_F(LocalReplyTest, TestDefaultJsonFormatter) {
   // Default json formatter without any mappers
   const std::string yaml = R"(
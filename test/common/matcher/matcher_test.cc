@@ -620,6 +620,127 @@ matcher_list:
   EXPECT_NE(recursive_result.result_, nullptr);
 }
 
+// A DataInput counting how many times its value was fetched.
+class CountingInputFactory : public DataInputFactory<TestData> {
+public:
+  CountingInputFactory() : injection_(*this) {}
+
+  DataInputFactoryCb<TestData>
+  createDataInputFactoryCb(const Protobuf::Message& config,
+                           ProtobufMessage::ValidationVisitor&) override {
+    const std::string value = dynamic_cast<const ProtobufWkt::StringValue&>(config).value();
+    return [this, value]() { return std::make_unique<CountingInput>(gets_, value); };
+  }
+
+  ProtobufTypes::MessagePtr createEmptyConfigProto() override {
+    return std::make_unique<ProtobufWkt::StringValue>();
+  }
+  std::string name() const override { return "counting"; }
+
+  uint32_t gets_{};
+
+private:
+  struct CountingInput : public DataInput<TestData> {
+    CountingInput(uint32_t& gets, const std::string& value) : gets_(gets), value_(value) {}
+    DataInputGetResult get(const TestData&) const override {
+      ++gets_;
+      return {DataInputGetResult::DataAvailability::AllDataAvailable, value_};
+    }
+
+    uint32_t& gets_;
+    const std::string value_;
+  };
+
+  Registry::InjectFactory<DataInputFactory<TestData>> injection_;
+};
+
+// Test that the identical inputs of a tree and its sub-trees are fetched once per evaluation.
+TEST_F(MatcherTest, IdenticalInputsFetchedOnce) {
+  const std::string yaml = R"EOF(
+matcher_list:
+  matchers:
+  - on_match:
+      action:
+        name: test_action
+        typed_config:
+          "@type": type.googleapis.com/google.protobuf.StringValue
+          value: first
+    predicate:
+      single_predicate:
+        input:
+          name: counting
+          typed_config:
+            "@type": type.googleapis.com/google.protobuf.StringValue
+            value: foo
+        value_match:
+          exact: bar
+  - on_match:
+      matcher:
+        matcher_list:
+          matchers:
+          - on_match:
+              action:
+                name: test_action
+                typed_config:
+                  "@type": type.googleapis.com/google.protobuf.StringValue
+                  value: second
+            predicate:
+              and_matcher:
+                predicate:
+                - single_predicate:
+                    input:
+                      name: counting
+                      typed_config:
+                        "@type": type.googleapis.com/google.protobuf.StringValue
+                        value: foo
+                    value_match:
+                      exact: foo
+                - single_predicate:
+                    input:
+                      name: counting
+                      typed_config:
+                        "@type": type.googleapis.com/google.protobuf.StringValue
+                        value: baz
+                    value_match:
+                      exact: baz
+    predicate:
+      single_predicate:
+        input:
+          name: counting
+          typed_config:
+            "@type": type.googleapis.com/google.protobuf.StringValue
+            value: foo
+        value_match:
+          exact: foo
+  )EOF";
+
+  envoy::config::common::matcher::v3::Matcher matcher;
+  MessageUtil::loadFromYaml(yaml, matcher, ProtobufMessage::getStrictValidationVisitor());
+
+  TestUtility::validate(matcher);
+
+  CountingInputFactory input_factory;
+  EXPECT_CALL(validation_visitor_,
+              performDataInputValidation(_, "type.googleapis.com/google.protobuf.StringValue"))
+      .Times(4);
+  auto match_tree = factory_.create(matcher)();
+
+  // The input of foo is fetched once, and the one of baz once.
+  const auto result = evaluateMatch(*match_tree, TestData());
+  EXPECT_EQ(result.match_state_, MatchState::MatchComplete);
+  ASSERT_NE(result.result_, nullptr);
+  EXPECT_EQ(result.result_()->getTyped<StringAction>().string_, "second");
+  EXPECT_EQ(2, input_factory.gets_);
+
+  // Each evaluation fetches the inputs again.
+  evaluateMatch(*match_tree, TestData());
+  EXPECT_EQ(4, input_factory.gets_);
+
+  // The inputs are fetched by each matcher outside of evaluateMatch().
+  match_tree->match(TestData());
+  EXPECT_EQ(6, input_factory.gets_);
+}
+
 TEST_F(MatcherTest, RecursiveMatcherNoMatch) {
   ListMatcher<TestData> matcher(absl::nullopt);
 
@@ -0,0 +1,70 @@
+#include <thread>
+
+#include "source/common/buffer/buffer_impl.h"
+#include "source/common/memory/accounting.h"
+
+#include "test/test_common/utility.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Memory {
+namespace {
+
+uint64_t bytes(Subsystem subsystem) {
+  return Accounting::bytes()[static_cast<size_t>(subsystem)];
+}
+
+TEST(AccountingTest, Names) {
+  EXPECT_EQ("buffer_accounts", Accounting::name(Subsystem::BufferAccounts));
+  EXPECT_EQ("buffers", Accounting::name(Subsystem::Buffers));
+  EXPECT_EQ("tls_contexts", Accounting::name(Subsystem::TlsContexts));
+}
+
+TEST(AccountingTest, ChargeAndCredit) {
+  const uint64_t before = bytes(Subsystem::RouteConfigs);
+  Accounting::charge(Subsystem::RouteConfigs, 100);
+  EXPECT_EQ(before + 100, bytes(Subsystem::RouteConfigs));
+  {
+    AccountedBytes accounted(Subsystem::RouteConfigs, 50);
+    EXPECT_EQ(before + 150, bytes(Subsystem::RouteConfigs));
+  }
+  Accounting::credit(Subsystem::RouteConfigs, 100);
+  EXPECT_EQ(before, bytes(Subsystem::RouteConfigs));
+}
+
+// The memory may be freed by another thread than the one which allocated it, which may exit before.
+TEST(AccountingTest, CreditedByAnotherThread) {
+  const uint64_t before = bytes(Subsystem::Hosts);
+  std::thread thread([] { Accounting::charge(Subsystem::Hosts, 10); });
+  thread.join();
+  EXPECT_EQ(before + 10, bytes(Subsystem::Hosts));
+  Accounting::credit(Subsystem::Hosts, 10);
+  EXPECT_EQ(before, bytes(Subsystem::Hosts));
+}
+
+TEST(AccountingTest, Buffers) {
+  const uint64_t before = bytes(Subsystem::Buffers);
+  {
+    Buffer::OwnedImpl buffer(std::string(20000, 'a'));
+    EXPECT_LE(before + 20000, bytes(Subsystem::Buffers));
+  }
+  EXPECT_EQ(before, bytes(Subsystem::Buffers));
+}
+
+TEST(AccountingTest, HeaderMaps) {
+  const uint64_t before = bytes(Subsystem::HeaderMaps);
+  {
+    Http::TestRequestHeaderMapImpl headers{{":path", "/"}, {"key", "value"}};
+    EXPECT_EQ(before + headers.byteSize(), bytes(Subsystem::HeaderMaps));
+    headers.setPath("/longer");
+    EXPECT_EQ(before + headers.byteSize(), bytes(Subsystem::HeaderMaps));
+    headers.remove(Http::LowerCaseString("key"));
+    EXPECT_EQ(before + headers.byteSize(), bytes(Subsystem::HeaderMaps));
+  }
+  EXPECT_EQ(before, bytes(Subsystem::HeaderMaps));
+}
+
+} // namespace
+} // namespace Memory
+} // namespace Envoy
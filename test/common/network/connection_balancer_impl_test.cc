@@ -0,0 +1,53 @@
+#include "source/common/network/connection_balancer_impl.h"
+
+#include "test/common/stats/stat_test_utility.h"
+#include "test/mocks/api/mocks.h"
+#include "test/test_common/threadsafe_singleton_injector.h"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+using testing::Return;
+
+namespace Envoy {
+namespace Network {
+namespace {
+
+class MockBalancedConnectionHandler : public BalancedConnectionHandler {
+public:
+  MOCK_METHOD(uint64_t, numConnections, (), (const));
+  MOCK_METHOD(void, incNumConnections, ());
+  MOCK_METHOD(void, post, (Network::ConnectionSocketPtr && socket));
+  MOCK_METHOD(void, onAcceptWorker,
+              (Network::ConnectionSocketPtr && socket,
+               bool hand_off_restored_destination_connections, bool rebalanced));
+};
+
+#if defined(__linux__)
+TEST(CpuConnectionBalancerImplTest, CountsConnectionsPerNumaNode) {
+  Api::MockLinuxOsSysCalls linux_os_sys_calls;
+  TestThreadsafeSingletonInjector<Api::LinuxOsSysCallsImpl> linux_os_calls(&linux_os_sys_calls);
+  Stats::TestUtil::TestStore store;
+  CpuConnectionBalancerImpl balancer(*store.rootScope(),
+                                     CpuTopology({0, 1, 2, 3}, {{0, 0}, {1, 0}, {2, 1}, {3, 1}}));
+  MockBalancedConnectionHandler handler;
+
+  EXPECT_CALL(linux_os_sys_calls, sched_getcpu())
+      .WillOnce(Return(Api::SysCallIntResult{3, 0}))
+      .WillOnce(Return(Api::SysCallIntResult{1, 0}))
+      .WillOnce(Return(Api::SysCallIntResult{2, 0}))
+      .WillOnce(Return(Api::SysCallIntResult{-1, ENOSYS}));
+  EXPECT_CALL(handler, incNumConnections()).Times(4);
+  for (int i = 0; i < 4; ++i) {
+    // Connections stay on the handler that accepted them.
+    EXPECT_EQ(&handler, &balancer.pickTargetHandler(handler));
+  }
+
+  EXPECT_EQ(1, store.counter("numa_node_0.downstream_cx_total").value());
+  EXPECT_EQ(2, store.counter("numa_node_1.downstream_cx_total").value());
+}
+#endif
+
+} // namespace
+} // namespace Network
+} // namespace Envoy
@@ -581,6 +581,47 @@ TEST_P(ConnectionImplTest, ServerTransportSocketTimeoutDisabledOnConnect) {
   server_connection->close(ConnectionCloseType::NoFlush);
 }
 
+TEST_P(ConnectionImplTest, ServerWriteCoalescing) {
+  ConnectionMocks mocks = createConnectionMocks(false);
+  MockTransportSocket* transport_socket = mocks.transport_socket_.get();
+  IoHandlePtr io_handle = std::make_unique<Network::Test::IoSocketHandlePlatformImpl>(0);
+
+  auto server_connection = std::make_unique<Network::ServerConnectionImpl>(
+      *mocks.dispatcher_,
+      std::make_unique<ConnectionSocketImpl>(std::move(io_handle), nullptr, nullptr),
+      std::move(mocks.transport_socket_), stream_info_);
+  auto* flush_cb = new NiceMock<Event::MockSchedulableCallback>(mocks.dispatcher_.get());
+  server_connection->enableWriteCoalescing();
+  auto drain = [](Buffer::Instance& buffer, bool) -> IoResult {
+    const uint64_t length = buffer.length();
+    buffer.drain(length);
+    return IoResult{PostIoAction::KeepOpen, length, false};
+  };
+
+  // The writes schedule a flush at the end of the iteration, rather than activating the write
+  // event, and are flushed together.
+  EXPECT_CALL(*mocks.file_event_, activate(_)).Times(0);
+  EXPECT_CALL(*flush_cb, scheduleCallbackCurrentIteration()).Times(2);
+  Buffer::OwnedImpl first("first");
+  server_connection->write(first, false);
+  Buffer::OwnedImpl second("second");
+  server_connection->write(second, false);
+  EXPECT_CALL(*transport_socket, doWrite(BufferStringEqual("firstsecond"), false))
+      .WillOnce(Invoke(drain));
+  flush_cb->invokeCallback();
+
+  // A write event of the socket flushes the data, and the pending flush is cancelled.
+  EXPECT_CALL(*flush_cb, scheduleCallbackCurrentIteration());
+  Buffer::OwnedImpl third("third");
+  server_connection->write(third, false);
+  EXPECT_CALL(*transport_socket, doWrite(BufferStringEqual("third"), false))
+      .WillOnce(Invoke(drain));
+  EXPECT_TRUE((*mocks.file_ready_cb_)(Event::FileReadyType::Write).ok());
+  EXPECT_FALSE(flush_cb->enabled_);
+
+  server_connection->close(ConnectionCloseType::NoFlush);
+}
+
 TEST_P(ConnectionImplTest, SocketOptions) {
   Network::ClientConnectionPtr upstream_connection_;
 
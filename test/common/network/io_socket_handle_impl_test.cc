@@ -1,3 +1,4 @@
+#include "source/common/buffer/buffer_impl.h"
 #include "source/common/common/utility.h"
 #include "source/common/network/address_impl.h"
 #include "source/common/network/io_socket_error_impl.h"
@@ -5,6 +6,7 @@
 #include "source/common/network/listen_socket_impl.h"
 
 #include "test/mocks/api/mocks.h"
+#include "test/mocks/event/mocks.h"
 #include "test/test_common/environment.h"
 #include "test/test_common/network_utility.h"
 #include "test/test_common/threadsafe_singleton_injector.h"
@@ -14,10 +16,12 @@
 #include "gtest/gtest.h"
 
 using testing::_;
+using testing::DoAll;
 using testing::Eq;
 using testing::Invoke;
 using testing::NiceMock;
 using testing::Return;
+using testing::SaveArg;
 
 namespace Envoy {
 namespace Network {
@@ -177,6 +181,143 @@ TEST(IoSocketHandleImpl, ErrnoIfaddrs) {
   EXPECT_FALSE(maybe_interface_name.has_value());
 }
 
+#if ENVOY_PLATFORM_ENABLE_MSG_ZEROCOPY
+class IoSocketHandleImplZeroCopyTest : public testing::Test {
+protected:
+  IoSocketHandleImplZeroCopyTest() {
+    // The fd isn't a real one.
+    ON_CALL(os_sys_calls_, close(fd_)).WillByDefault(Return(Api::SysCallIntResult{0, 0}));
+    EXPECT_CALL(dispatcher_, createFileEvent_(fd_, _, _, _))
+        .WillOnce(DoAll(SaveArg<1>(&file_ready_cb_), Return(new NiceMock<Event::MockFileEvent>())));
+    io_handle_.initializeFileEvent(
+        dispatcher_,
+        [this](uint32_t events) {
+          ready_events_ = events;
+          return absl::OkStatus();
+        },
+        Event::PlatformDefaultTriggerType,
+        Event::FileReadyType::Read | Event::FileReadyType::Write);
+  }
+
+  void enableZeroCopy() {
+    const int enabled = 1;
+    io_handle_.setOption(SOL_SOCKET, SO_ZEROCOPY, &enabled, sizeof(enabled));
+  }
+
+  // Adds a fragment large enough to be sent with MSG_ZEROCOPY, which records its release.
+  void addFragment(Buffer::Instance& buffer, bool& released) {
+    fragments_.push_back(std::make_unique<Buffer::BufferFragmentImpl>(
+        data_.data(), data_.size(),
+        [&released](const void*, size_t, const Buffer::BufferFragmentImpl*) { released = true; }));
+    buffer.addBufferFragment(*fragments_.back());
+  }
+
+  // Delivers the completion of the zero-copy sends from first_id to last_id through the file event.
+  void complete(uint32_t first_id, uint32_t last_id) {
+    EXPECT_CALL(os_sys_calls_, recvmsg(fd_, _, MSG_ERRQUEUE))
+        .WillOnce(Invoke([first_id, last_id](os_fd_t, msghdr* message, int) {
+          sock_extended_err error{};
+          error.ee_origin = SO_EE_ORIGIN_ZEROCOPY;
+          error.ee_info = first_id;
+          error.ee_data = last_id;
+          cmsghdr* cmsg = CMSG_FIRSTHDR(message);
+          cmsg->cmsg_level = SOL_IP;
+          cmsg->cmsg_type = IP_RECVERR;
+          cmsg->cmsg_len = CMSG_LEN(sizeof(error));
+          memcpy(CMSG_DATA(cmsg), &error, sizeof(error)); // NOLINT(safe-memcpy)
+          message->msg_controllen = CMSG_SPACE(sizeof(error));
+          return Api::SysCallSizeResult{0, 0};
+        }))
+        .WillRepeatedly(Return(Api::SysCallSizeResult{-1, SOCKET_ERROR_AGAIN}));
+    EXPECT_TRUE(file_ready_cb_(Event::FileReadyType::Write).ok());
+    EXPECT_EQ(Event::FileReadyType::Write, ready_events_);
+  }
+
+  NiceMock<Api::MockOsSysCalls> os_sys_calls_;
+  TestThreadsafeSingletonInjector<Api::OsSysCallsImpl> os_calls_{&os_sys_calls_};
+  NiceMock<Event::MockDispatcher> dispatcher_;
+  Event::FileReadyCb file_ready_cb_;
+  uint32_t ready_events_{};
+  const std::string data_ = std::string(IoSocketHandleImpl::ZeroCopyMinWriteSize, 'a');
+  std::vector<std::unique_ptr<Buffer::BufferFragmentImpl>> fragments_;
+  const os_fd_t fd_ = 42;
+  IoSocketHandleImpl io_handle_{fd_};
+};
+
+TEST_F(IoSocketHandleImplZeroCopyTest, KeepsSlicesUntilCompleted) {
+  enableZeroCopy();
+  Buffer::OwnedImpl buffer;
+  bool released = false;
+  addFragment(buffer, released);
+  buffer.add("tail");
+
+  EXPECT_CALL(os_sys_calls_, sendmsg(fd_, _, MSG_ZEROCOPY))
+      .WillOnce(Return(Api::SysCallSizeResult{static_cast<ssize_t>(data_.size() + 2), 0}));
+  EXPECT_TRUE(io_handle_.write(buffer).ok());
+  EXPECT_EQ("il", buffer.toString());
+  EXPECT_FALSE(released);
+
+  // The rest is too small for a zero-copy send.
+  EXPECT_CALL(os_sys_calls_, send(fd_, _, 2, 0)).WillOnce(Return(Api::SysCallSizeResult{2, 0}));
+  EXPECT_TRUE(io_handle_.write(buffer).ok());
+  EXPECT_EQ(0, buffer.length());
+  EXPECT_FALSE(released);
+
+  complete(0, 0);
+  EXPECT_TRUE(released);
+}
+
+TEST_F(IoSocketHandleImplZeroCopyTest, ReleasesSlicesOnceTheEarlierSendsComplete) {
+  enableZeroCopy();
+  bool released1 = false;
+  bool released2 = false;
+  for (bool* released : {&released1, &released2}) {
+    Buffer::OwnedImpl buffer;
+    addFragment(buffer, *released);
+    EXPECT_CALL(os_sys_calls_, sendmsg(fd_, _, MSG_ZEROCOPY))
+        .WillOnce(Return(Api::SysCallSizeResult{static_cast<ssize_t>(data_.size()), 0}));
+    EXPECT_TRUE(io_handle_.write(buffer).ok());
+    EXPECT_EQ(0, buffer.length());
+  }
+
+  complete(1, 1);
+  EXPECT_FALSE(released1);
+  EXPECT_FALSE(released2);
+  complete(0, 0);
+  EXPECT_TRUE(released1);
+  EXPECT_TRUE(released2);
+}
+
+TEST_F(IoSocketHandleImplZeroCopyTest, CopiesWithoutZeroCopyEnabled) {
+  // The option is only looked up once.
+  EXPECT_CALL(os_sys_calls_, getsockopt_(fd_, SOL_SOCKET, SO_ZEROCOPY, _, _)).WillOnce(Return(0));
+  EXPECT_CALL(os_sys_calls_, sendmsg(_, _, _)).Times(0);
+  for (int i = 0; i < 2; i++) {
+    Buffer::OwnedImpl buffer;
+    bool released = false;
+    addFragment(buffer, released);
+    EXPECT_CALL(os_sys_calls_, send(fd_, _, data_.size(), 0))
+        .WillOnce(Return(Api::SysCallSizeResult{static_cast<ssize_t>(data_.size()), 0}));
+    EXPECT_TRUE(io_handle_.write(buffer).ok());
+    EXPECT_TRUE(released);
+  }
+}
+
+TEST_F(IoSocketHandleImplZeroCopyTest, CopiesWhenThePagesCantBePinned) {
+  enableZeroCopy();
+  Buffer::OwnedImpl buffer;
+  bool released = false;
+  addFragment(buffer, released);
+
+  EXPECT_CALL(os_sys_calls_, sendmsg(fd_, _, MSG_ZEROCOPY))
+      .WillOnce(Return(Api::SysCallSizeResult{-1, ENOBUFS}));
+  EXPECT_CALL(os_sys_calls_, send(fd_, _, data_.size(), 0))
+      .WillOnce(Return(Api::SysCallSizeResult{static_cast<ssize_t>(data_.size()), 0}));
+  EXPECT_TRUE(io_handle_.write(buffer).ok());
+  EXPECT_TRUE(released);
+}
+#endif
+
 class IoSocketHandleImplTest : public testing::TestWithParam<Network::Address::IpVersion> {};
 INSTANTIATE_TEST_SUITE_P(IpVersions, IoSocketHandleImplTest,
                          testing::ValuesIn(TestEnvironment::getIpVersionsForTest()),
@@ -0,0 +1,86 @@
+#include "source/common/network/reuse_port_cpu_steering_option_impl.h"
+
+#include "test/common/network/socket_option_test.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Network {
+namespace {
+
+class ReusePortCpuSteeringOptionImplTest : public SocketOptionTest {};
+
+TEST_F(ReusePortCpuSteeringOptionImplTest, WorkerIndex) {
+  ReusePortCpuSteeringOptionImpl socket_option({4, 6, 4});
+  EXPECT_EQ(0, socket_option.workerIndex(4));
+  EXPECT_EQ(1, socket_option.workerIndex(6));
+  // No worker runs on CPU 5.
+  EXPECT_EQ(2, socket_option.workerIndex(5));
+  EXPECT_EQ(0, socket_option.workerIndex(9));
+}
+
+TEST_F(ReusePortCpuSteeringOptionImplTest, IgnoresOptionOnDifferentState) {
+  ReusePortCpuSteeringOptionImpl socket_option({0, 1});
+  EXPECT_CALL(socket_, setSocketOption(_, _, _, _)).Times(0);
+  EXPECT_TRUE(
+      socket_option.setOption(socket_, envoy::config::core::v3::SocketOption::STATE_PREBIND));
+  EXPECT_TRUE(socket_option.setOption(socket_, envoy::config::core::v3::SocketOption::STATE_BOUND));
+  EXPECT_FALSE(socket_option
+                   .getOptionDetails(socket_, envoy::config::core::v3::SocketOption::STATE_BOUND)
+                   .has_value());
+}
+
+TEST_F(ReusePortCpuSteeringOptionImplTest, HashKey) {
+  std::vector<uint8_t> hash_key;
+  ReusePortCpuSteeringOptionImpl({0, 1}).hashKey(hash_key);
+  std::vector<uint8_t> other_hash_key;
+  ReusePortCpuSteeringOptionImpl({1, 0}).hashKey(other_hash_key);
+  EXPECT_NE(hash_key, other_hash_key);
+}
+
+#if defined(SO_ATTACH_REUSEPORT_CBPF) && defined(__linux__)
+TEST_F(ReusePortCpuSteeringOptionImplTest, SetOption) {
+  ReusePortCpuSteeringOptionImpl socket_option({2, 3});
+  EXPECT_TRUE(socket_option.isSupported());
+  EXPECT_CALL(socket_, setSocketOption(SOL_SOCKET, SO_ATTACH_REUSEPORT_CBPF, _, sizeof(sock_fprog)))
+      .WillOnce(Invoke([](int, int, const void* optval, socklen_t) -> Api::SysCallIntResult {
+        const sock_fprog* prog = static_cast<const sock_fprog*>(optval);
+        // The CPU load, a lookup per CPU, the modulo and the return.
+        EXPECT_EQ(7, prog->len);
+        EXPECT_EQ(static_cast<uint32_t>(SKF_AD_OFF + SKF_AD_CPU), prog->filter[0].k);
+        EXPECT_EQ(2, prog->filter[1].k);
+        EXPECT_EQ(0, prog->filter[2].k);
+        EXPECT_EQ(3, prog->filter[3].k);
+        EXPECT_EQ(1, prog->filter[4].k);
+        EXPECT_EQ(2, prog->filter[5].k);
+        return {0, 0};
+      }));
+  EXPECT_TRUE(
+      socket_option.setOption(socket_, envoy::config::core::v3::SocketOption::STATE_LISTENING));
+
+  const auto details = socket_option.getOptionDetails(
+      socket_, envoy::config::core::v3::SocketOption::STATE_LISTENING);
+  ASSERT_TRUE(details.has_value());
+  EXPECT_EQ(ENVOY_ATTACH_REUSEPORT_CBPF, details->name_);
+  EXPECT_EQ(7 * sizeof(sock_filter), details->value_.size());
+}
+
+TEST_F(ReusePortCpuSteeringOptionImplTest, FailsOnSyscallFailure) {
+  ReusePortCpuSteeringOptionImpl socket_option({0});
+  EXPECT_CALL(socket_, setSocketOption(SOL_SOCKET, SO_ATTACH_REUSEPORT_CBPF, _, _))
+      .WillOnce(testing::Return(Api::SysCallIntResult{-1, EINVAL}));
+  EXPECT_FALSE(
+      socket_option.setOption(socket_, envoy::config::core::v3::SocketOption::STATE_LISTENING));
+}
+#else
+TEST_F(ReusePortCpuSteeringOptionImplTest, Unsupported) {
+  ReusePortCpuSteeringOptionImpl socket_option({0});
+  EXPECT_FALSE(socket_option.isSupported());
+  EXPECT_FALSE(
+      socket_option.setOption(socket_, envoy::config::core::v3::SocketOption::STATE_LISTENING));
+}
+#endif
+
+} // namespace
+} // namespace Network
+} // namespace Envoy
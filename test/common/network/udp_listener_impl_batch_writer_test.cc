@@ -268,6 +268,57 @@ TEST_P(UdpListenerImplBatchWriterTest, WriteBlocked) {
   }
 }
 
+/**
+ * Tests UDP Packet writer batching across connections.
+ * 1. Write packets to two peers, which are all buffered.
+ * 2. Flush and verify that one sendmmsg call sends a GSO message per peer.
+ */
+TEST_P(UdpListenerImplBatchWriterTest, BatchAcrossConnections) {
+  udp_packet_writer_ = std::make_unique<Quic::UdpGsoBatchWriter>(
+      server_socket_->ioHandle(), listener_config_.listenerScope(),
+      /*batch_across_connections=*/true);
+  const Address::InstanceConstSharedPtr first_peer = client_.localAddress();
+  const Address::InstanceConstSharedPtr second_peer =
+      server_socket_->connectionInfoProvider().localAddress();
+
+  for (const auto& [payload, peer] :
+       std::vector<std::pair<std::string, Address::InstanceConstSharedPtr>>{
+           {"length7", first_peer}, {"length7", first_peer}, {"len<7", second_peer}}) {
+    Buffer::OwnedImpl buffer(payload);
+    auto send_result = udp_packet_writer_->writePacket(buffer, nullptr, *peer);
+    EXPECT_TRUE(send_result.ok());
+    EXPECT_EQ(send_result.return_value_, payload.length());
+  }
+  EXPECT_EQ(listener_config_.listenerScope()
+                .gaugeFromString("internal_buffer_size", Stats::Gauge::ImportMode::NeverImport)
+                .value(),
+            19);
+
+  Api::MockOsSysCalls os_sys_calls;
+  TestThreadsafeSingletonInjector<Api::OsSysCallsImpl> os_calls(&os_sys_calls);
+  EXPECT_CALL(os_sys_calls, sendmmsg(_, _, 2, 0))
+      .WillOnce(Invoke([](os_fd_t, struct mmsghdr* msgvec, unsigned int, int) {
+        // The packets to the first peer are sent as one GSO message.
+        EXPECT_EQ(14, getPacketLength(&msgvec[0].msg_hdr));
+        const cmsghdr* cmsg = CMSG_FIRSTHDR(&msgvec[0].msg_hdr);
+        EXPECT_NE(nullptr, cmsg);
+        if (cmsg != nullptr) {
+          EXPECT_EQ(SOL_UDP, cmsg->cmsg_level);
+          EXPECT_EQ(UDP_SEGMENT, cmsg->cmsg_type);
+          EXPECT_EQ(7, *reinterpret_cast<const uint16_t*>(CMSG_DATA(cmsg)));
+        }
+        EXPECT_EQ(5, getPacketLength(&msgvec[1].msg_hdr));
+        EXPECT_EQ(nullptr, msgvec[1].msg_hdr.msg_control);
+        return Api::SysCallIntResult{2, 0};
+      }));
+  auto flush_result = udp_packet_writer_->flush();
+  EXPECT_TRUE(flush_result.ok());
+  EXPECT_EQ(listener_config_.listenerScope()
+                .gaugeFromString("internal_buffer_size", Stats::Gauge::ImportMode::NeverImport)
+                .value(),
+            0);
+}
+
 } // namespace
 } // namespace Network
 } // namespace Envoy
@@ -20,6 +20,7 @@
 #include "test/mocks/network/mocks.h"
 #include "test/test_common/environment.h"
 #include "test/test_common/network_utility.h"
+#include "test/test_common/test_runtime.h"
 #include "test/test_common/threadsafe_singleton_injector.h"
 #include "test/test_common/utility.h"
 
@@ -889,6 +890,112 @@ TEST_P(UdpListenerImplTest, UdpGroReadLimit) {
   dispatcher_->run(Event::Dispatcher::RunType::Block);
 }
 
+// Tests that with GRO and recvmmsg combined, every message of a recvmmsg call is segmented into
+// views of the read buffer, and that the number of messages read per call grows while the calls
+// fill all of them.
+TEST_P(UdpListenerImplTest, UdpRecvmmsgWithGro) {
+  TestScopedRuntime scoped_runtime;
+  scoped_runtime.mergeValues({{"envoy.reloadable_features.udp_recvmmsg_with_gro", "true"}});
+  setup(true);
+
+  client_.write("first", *send_to_addr_);
+
+  Api::MockOsSysCalls os_sys_calls;
+  TestThreadsafeSingletonInjector<Api::OsSysCallsImpl> os_calls(&os_sys_calls);
+  EXPECT_CALL(os_sys_calls, supportsUdpGro).WillRepeatedly(Return(true));
+  EXPECT_CALL(os_sys_calls, supportsMmsg).WillRepeatedly(Return(true));
+  EXPECT_CALL(os_sys_calls, recvmsg(_, _, _)).Times(0);
+
+  const uint16_t gso_size = 4;
+  // Fills a message as received from the client, with two segments of gso_size bytes.
+  auto fill_message = [&](mmsghdr& mmsg, absl::string_view payload) {
+    msghdr* msg = &mmsg.msg_hdr;
+    sockaddr_storage ss;
+    memset(&ss, 0, sizeof(ss));
+    if (client_.localAddress()->ip()->version() == Address::IpVersion::v4) {
+      auto ipv4_addr = reinterpret_cast<sockaddr_in*>(&ss);
+      ipv4_addr->sin_family = AF_INET;
+      ipv4_addr->sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+      ipv4_addr->sin_port = client_.localAddress()->ip()->port();
+      msg->msg_namelen = sizeof(sockaddr_in);
+    } else {
+      auto ipv6_addr = reinterpret_cast<sockaddr_in6*>(&ss);
+      ipv6_addr->sin6_family = AF_INET6;
+      ipv6_addr->sin6_addr = in6addr_loopback;
+      ipv6_addr->sin6_port = client_.localAddress()->ip()->port();
+      msg->msg_namelen = sizeof(sockaddr_in6);
+    }
+    memcpy(msg->msg_name, &ss, msg->msg_namelen);
+
+    EXPECT_EQ(msg->msg_iovlen, 1);
+    EXPECT_EQ(msg->msg_iov[0].iov_len, 64 * 1024);
+    memcpy(msg->msg_iov[0].iov_base, payload.data(), payload.length());
+    mmsg.msg_len = payload.length();
+
+    memset(msg->msg_control, 0, msg->msg_controllen);
+    cmsghdr* cmsg = CMSG_FIRSTHDR(msg);
+    if (send_to_addr_->ip()->version() == Address::IpVersion::v4) {
+      cmsg->cmsg_level = IPPROTO_IP;
+      cmsg->cmsg_type = IP_PKTINFO;
+      cmsg->cmsg_len = CMSG_LEN(sizeof(in_pktinfo));
+      reinterpret_cast<in_pktinfo*>(CMSG_DATA(cmsg))->ipi_addr.s_addr =
+          send_to_addr_->ip()->ipv4()->address();
+    } else {
+      cmsg->cmsg_len = CMSG_LEN(sizeof(in6_pktinfo));
+      cmsg->cmsg_level = IPPROTO_IPV6;
+      cmsg->cmsg_type = IPV6_PKTINFO;
+      auto pktinfo = reinterpret_cast<in6_pktinfo*>(CMSG_DATA(cmsg));
+      pktinfo->ipi6_ifindex = 0;
+      *(reinterpret_cast<absl::uint128*>(pktinfo->ipi6_addr.s6_addr)) =
+          send_to_addr_->ip()->ipv6()->address();
+    }
+    cmsg = CMSG_NXTHDR(msg, cmsg);
+    cmsg->cmsg_level = SOL_UDP;
+    cmsg->cmsg_type = UDP_GRO;
+    cmsg->cmsg_len = CMSG_LEN(sizeof(uint16_t));
+    *reinterpret_cast<uint16_t*>(CMSG_DATA(cmsg)) = gso_size;
+  };
+
+  EXPECT_CALL(os_sys_calls, recvmmsg(_, _, _, _, _))
+      .WillOnce(Invoke([&](os_fd_t, mmsghdr* msgvec, unsigned int vlen, int, timespec*) {
+        // A full read of the first call...
+        EXPECT_EQ(1u, vlen);
+        fill_message(msgvec[0], "abcdefgh");
+        return Api::SysCallIntResult{1, 0};
+      }))
+      .WillOnce(Invoke([&](os_fd_t, mmsghdr* msgvec, unsigned int vlen, int, timespec*) {
+        // ... doubles the number of messages of the next one.
+        EXPECT_EQ(2u, vlen);
+        fill_message(msgvec[0], "ijklmnop");
+        fill_message(msgvec[1], "qrstuv");
+        return Api::SysCallIntResult{2, 0};
+      }))
+      .WillOnce(Invoke([&](os_fd_t, mmsghdr*, unsigned int vlen, int, timespec*) {
+        EXPECT_EQ(4u, vlen);
+        return Api::SysCallIntResult{-1, EAGAIN};
+      }));
+
+  std::vector<std::string> received;
+  std::vector<const char*> received_data;
+  EXPECT_CALL(listener_callbacks_, onReadReady()).WillOnce(Invoke([&]() { dispatcher_->exit(); }));
+  EXPECT_CALL(listener_callbacks_, onData(_))
+      .Times(6u)
+      .WillRepeatedly(Invoke([&](const UdpRecvData& data) -> void {
+        ASSERT_NE(data.addresses_.peer_, nullptr);
+        EXPECT_EQ(*data.addresses_.local_, *send_to_addr_);
+        ASSERT_EQ(1, data.buffer_->getRawSlices().size());
+        received_data.push_back(static_cast<const char*>(data.buffer_->getRawSlices()[0].mem_));
+        received.push_back(data.buffer_->toString());
+      }));
+
+  dispatcher_->run(Event::Dispatcher::RunType::Block);
+  EXPECT_THAT(received, testing::ElementsAre("abcd", "efgh", "ijkl", "mnop", "qrst", "uv"));
+  // The segments of a message are views of the buffer the message was read into.
+  EXPECT_EQ(received_data[0] + gso_size, received_data[1]);
+  EXPECT_EQ(received_data[2] + gso_size, received_data[3]);
+  EXPECT_EQ(received_data[4] + gso_size, received_data[5]);
+}
+
 #endif
 
 } // namespace
@@ -499,5 +499,45 @@ TEST(HashTest, AnyWithKnownTypeMismatch) {
   EXPECT_NE(hash(a1), hash(a2));
 }
 
+TEST(HashTest, AnyWithKnownTypeSerializedDifferentlyMatch) {
+  deterministichashtest::AnyContainer a1, a2;
+  deterministichashtest::SingleFields value;
+  value.set_b(true);
+  value.set_int32(3);
+  a1.mutable_any()->PackFrom(value);
+  // The same fields, serialized out of field number order.
+  deterministichashtest::SingleFields b, int32;
+  b.set_b(true);
+  int32.set_int32(3);
+  a2.mutable_any()->set_type_url(a1.any().type_url());
+  a2.mutable_any()->set_value(int32.SerializeAsString() + b.SerializeAsString());
+  ASSERT_NE(a1.any().value(), a2.any().value());
+  EXPECT_EQ(hash(a1), hash(a2));
+  // Again, once the hashes of the contents are memoized.
+  EXPECT_EQ(hash(a1), hash(a2));
+}
+
+TEST(HashTest, AnyHashDiffersFromItsContents) {
+  deterministichashtest::AnyContainer a;
+  deterministichashtest::Recursion value;
+  value.set_index(1);
+  a.mutable_any()->PackFrom(value);
+  deterministichashtest::AnyContainer b;
+  *b.mutable_any() = a.any();
+  EXPECT_EQ(hash(a), hash(b));
+  EXPECT_NE(hash(a), hash(value));
+  EXPECT_NE(hash(a), hash(a.any()));
+}
+
+TEST(HashTest, MessagesWithAndWithoutMapsMismatch) {
+  // Recursion has no maps, so it is hashed by its serialization, while Maps is reflected over.
+  deterministichashtest::Recursion recursion;
+  deterministichashtest::Maps maps;
+  EXPECT_NE(hash(recursion), hash(maps));
+  recursion.set_index(1);
+  (*maps.mutable_int32_uint32())[1] = 1;
+  EXPECT_NE(hash(recursion), hash(maps));
+}
+
 } // namespace DeterministicProtoHash
 } // namespace Envoy
@@ -53,6 +53,12 @@ static std::unique_ptr<Protobuf::Message> testProtoWithRepeatedFields() {
   return msg;
 }
 
+static std::unique_ptr<Protobuf::Message> testProtoWithAny() {
+  auto msg = std::make_unique<deterministichashtest::AnyContainer>();
+  msg->mutable_any()->PackFrom(*testProtoWithMaps());
+  return msg;
+}
+
 static void bmHashByTextFormat(benchmark::State& state, std::unique_ptr<Protobuf::Message> msg) {
   TestScopedRuntime runtime;
   runtime.mergeValues({{"envoy.restart_features.use_fast_protobuf_hash", "false"}});
@@ -81,5 +87,7 @@ BENCHMARK_CAPTURE(bmHashByDeterministicHash, recursion, testProtoWithRecursion()
 BENCHMARK_CAPTURE(bmHashByTextFormat, recursion, testProtoWithRecursion());
 BENCHMARK_CAPTURE(bmHashByDeterministicHash, repeatedFields, testProtoWithRepeatedFields());
 BENCHMARK_CAPTURE(bmHashByTextFormat, repeatedFields, testProtoWithRepeatedFields());
+BENCHMARK_CAPTURE(bmHashByDeterministicHash, any, testProtoWithAny());
+BENCHMARK_CAPTURE(bmHashByTextFormat, any, testProtoWithAny());
 
 } // namespace Envoy
@@ -1,6 +1,10 @@
 #include <cstddef>
+#include <limits>
+#include <memory>
 #include <string>
+#include <vector>
 
+#include "source/common/buffer/buffer_impl.h"
 #include "source/common/event/libevent_scheduler.h"
 #include "source/common/http/headers.h"
 #include "source/common/quic/envoy_quic_alarm_factory.h"
@@ -202,6 +206,39 @@ public:
     return data.length();
   }
 
+  // Adds a slice per string to `buffer`, each recording in `released_body_slices_` when it is
+  // freed.
+  void addBodySlices(Buffer::Instance& buffer, const std::vector<std::string>& slices) {
+    for (const std::string& slice : slices) {
+      const size_t index = body_slices_.size();
+      body_slices_.push_back(std::make_unique<std::string>(slice));
+      released_body_slices_.push_back(false);
+      body_fragments_.push_back(std::make_unique<Buffer::BufferFragmentImpl>(
+          body_slices_.back()->data(), slice.size(),
+          [this, index](const void*, size_t, const Buffer::BufferFragmentImpl*) {
+            released_body_slices_[index] = true;
+          }));
+      buffer.addBufferFragment(*body_fragments_.back());
+    }
+  }
+
+  // Acknowledges `length` bytes of the stream from `offset`.
+  void ackStreamData(quic::QuicStreamOffset offset, quic::QuicByteCount length) {
+    quic::QuicByteCount newly_acked_length = 0;
+    EXPECT_TRUE(quic_stream_->OnStreamFrameAcked(offset, length, /*fin_acked=*/false,
+                                                 quic::QuicTime::Delta::Zero(),
+                                                 quic::QuicTime::Zero(), &newly_acked_length));
+    EXPECT_EQ(length, newly_acked_length);
+  }
+
+  // The offset in the stream of the body written after what is written or buffered so far.
+  quic::QuicStreamOffset nextBodyOffset(size_t body_length) {
+    const size_t data_frame_header_length =
+        bodyToHttp3StreamPayload(std::string(body_length, 'a')).size() - body_length;
+    return quic_stream_->stream_bytes_written() + quic_stream_->BufferedDataBytes() +
+           data_frame_header_length;
+  }
+
   void receiveTrailers(size_t offset) {
     spdy_trailers_["key1"] = "value1";
     std::string payload = spdyHeaderToHttp3StreamPayload(spdy_trailers_);
@@ -212,6 +249,10 @@ public:
 protected:
   Api::ApiPtr api_;
   Event::DispatcherPtr dispatcher_;
+  // The body slices encoded by the tests, which outlive the stream referencing them.
+  std::vector<std::unique_ptr<std::string>> body_slices_;
+  std::vector<std::unique_ptr<Buffer::BufferFragmentImpl>> body_fragments_;
+  std::vector<bool> released_body_slices_;
   EnvoyQuicConnectionHelper connection_helper_;
   EnvoyQuicAlarmFactory alarm_factory_;
   testing::NiceMock<quic::test::MockPacketWriter> writer_;
@@ -631,6 +672,91 @@ TEST_F(EnvoyQuicServerStreamTest, WatermarkSendBuffer) {
   EXPECT_TRUE(quic_stream_->write_side_closed());
 }
 
+// Tests that the slices of a body partially written are all taken by QUICHE, and freed as they are
+// acknowledged.
+TEST_F(EnvoyQuicServerStreamTest, EncodeMultiSliceBodyWithPartialWrite) {
+  receiveRequest(request_body_, true, request_body_.size() * 2);
+  quic_stream_->encodeHeaders(response_headers_, /*end_stream=*/false);
+
+  Buffer::OwnedImpl buffer;
+  addBodySlices(buffer, {std::string(4 * 1024, 'a'), std::string(4 * 1024, 'b'),
+                         std::string(4 * 1024, 'c')});
+  const quic::QuicStreamOffset body_offset = nextBodyOffset(buffer.length());
+  const uint64_t stream_bytes_before = quic_stream_->stream_bytes_written();
+
+  // Only the DATA frame header, the first slice and half of the second can be written.
+  uint64_t write_budget = body_offset - stream_bytes_before + 6 * 1024;
+  EXPECT_CALL(quic_session_, WritevData(_, _, _, _, _, _))
+      .WillRepeatedly(Invoke([&write_budget](quic::QuicStreamId, size_t write_length,
+                                             quic::QuicStreamOffset, quic::StreamSendingState state,
+                                             bool, absl::optional<quic::EncryptionLevel>) {
+        const size_t consumed = std::min<uint64_t>(write_length, write_budget);
+        write_budget -= consumed;
+        return quic::QuicConsumedData{consumed, consumed == write_length && state != quic::NO_FIN};
+      }));
+  quic_stream_->encodeData(buffer, false);
+
+  // QUICHE took the whole body, and buffered what it couldn't write.
+  EXPECT_EQ(0u, buffer.length());
+  EXPECT_EQ(body_offset + 6 * 1024, quic_stream_->stream_bytes_written());
+  EXPECT_EQ(6u * 1024, quic_stream_->BufferedDataBytes());
+  EXPECT_THAT(released_body_slices_, testing::ElementsAre(false, false, false));
+
+  ackStreamData(body_offset, 4 * 1024);
+  EXPECT_THAT(released_body_slices_, testing::ElementsAre(true, false, false));
+
+  write_budget = std::numeric_limits<uint64_t>::max();
+  quic_session_.OnCanWrite();
+  EXPECT_EQ(0u, quic_stream_->BufferedDataBytes());
+
+  // The third slice is freed along with the second, which is still referenced.
+  ackStreamData(body_offset + 8 * 1024, 4 * 1024);
+  EXPECT_THAT(released_body_slices_, testing::ElementsAre(true, false, false));
+  ackStreamData(body_offset + 4 * 1024, 4 * 1024);
+  EXPECT_THAT(released_body_slices_, testing::ElementsAre(true, true, true));
+}
+
+// Tests that the slices of a body are all taken by QUICHE while the stream is blocked by flow
+// control, and are written once the window is updated.
+TEST_F(EnvoyQuicServerStreamTest, EncodeMultiSliceBodyWhileFlowControlBlocked) {
+  receiveRequest(request_body_, true, request_body_.size() * 2);
+
+  // Bump connection flow control window large enough not to cause connection level flow control
+  // blocked.
+  quic::QuicWindowUpdateFrame window_update(
+      quic::kInvalidControlFrameId,
+      quic::QuicUtils::GetInvalidStreamId(quic_version_.transport_version), 1024 * 1024);
+  quic_session_.OnWindowUpdateFrame(window_update);
+  quic_stream_->encodeHeaders(response_headers_, /*end_stream=*/false);
+
+  // 24KB of body, more than the initial stream flow control window of 16KB.
+  Buffer::OwnedImpl buffer;
+  addBodySlices(buffer, {std::string(8 * 1024, 'a'), std::string(8 * 1024, 'b'),
+                         std::string(8 * 1024, 'c')});
+  const uint64_t body_length = buffer.length();
+  const quic::QuicStreamOffset body_offset = nextBodyOffset(body_length);
+  quic_stream_->encodeData(buffer, false);
+
+  // QUICHE took the whole body: what was drained is either written or buffered.
+  EXPECT_EQ(0u, buffer.length());
+  EXPECT_TRUE(quic_stream_->IsFlowControlBlocked());
+  EXPECT_LT(0u, quic_stream_->BufferedDataBytes());
+  EXPECT_EQ(body_offset + body_length,
+            quic_stream_->stream_bytes_written() + quic_stream_->BufferedDataBytes());
+  EXPECT_THAT(released_body_slices_, testing::ElementsAre(false, false, false));
+
+  quic::QuicWindowUpdateFrame window_update1(quic::kInvalidControlFrameId, quic_stream_->id(),
+                                             64 * 1024);
+  quic_stream_->OnWindowUpdateFrame(window_update1);
+  quic_session_.OnCanWrite();
+  EXPECT_FALSE(quic_stream_->IsFlowControlBlocked());
+  EXPECT_EQ(0u, quic_stream_->BufferedDataBytes());
+  EXPECT_EQ(body_offset + body_length, quic_stream_->stream_bytes_written());
+
+  ackStreamData(body_offset, body_length);
+  EXPECT_THAT(released_body_slices_, testing::ElementsAre(true, true, true));
+}
+
 TEST_F(EnvoyQuicServerStreamTest, HeadersContributeToWatermarkIquic) {
   receiveRequest(request_body_, true, request_body_.size() * 2);
 
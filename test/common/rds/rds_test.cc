@@ -148,6 +148,39 @@ TEST_F(RdsConfigUpdateReceiverTest, OnRdsUpdate) {
   EXPECT_EQ(1, config.use_count());
 }
 
+TEST_F(RdsConfigUpdateReceiverTest, OnRdsUpdateShared) {
+  setup();
+
+  auto response = std::make_shared<envoy::config::route::v3::RouteConfiguration>(
+      TestUtility::parseYaml<envoy::config::route::v3::RouteConfiguration>(R"EOF(
+name: foo_route_config
+virtual_hosts:
+- name: foo
+  domains: ["*"]
+)EOF"));
+
+  EXPECT_TRUE(config_update_->onRdsUpdate(response, "1"));
+  EXPECT_EQ("foo", *route("foo"));
+  EXPECT_EQ("1", config_update_->configInfo().value().version_);
+  // The update is kept rather than copied.
+  EXPECT_EQ(response.get(), &config_update_->protobufConfiguration());
+  EXPECT_EQ(2, response.use_count());
+
+  // An update with the same config is ignored, whichever way it comes.
+  EXPECT_FALSE(config_update_->onRdsUpdate(*response, "2"));
+  EXPECT_FALSE(config_update_->onRdsUpdate(response, "2"));
+  EXPECT_EQ("1", config_update_->configInfo().value().version_);
+  EXPECT_EQ(2, response.use_count());
+
+  auto response2 = std::make_shared<envoy::config::route::v3::RouteConfiguration>(*response);
+  response2->mutable_virtual_hosts(0)->set_name("bar");
+  EXPECT_TRUE(config_update_->onRdsUpdate(*response2, "2"));
+  EXPECT_EQ(nullptr, route("foo"));
+  EXPECT_EQ("bar", *route("bar"));
+  EXPECT_NE(response2.get(), &config_update_->protobufConfiguration());
+  EXPECT_EQ(1, response.use_count());
+}
+
 class RdsConfigProviderManagerTest : public RdsTestBase {
 public:
   RdsConfigProviderManagerTest() : manager_(server_factory_context_.admin_) {}
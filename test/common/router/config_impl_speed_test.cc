@@ -6,6 +6,7 @@
 
 #include "test/mocks/server/instance.h"
 #include "test/mocks/stream_info/mocks.h"
+#include "test/test_common/test_runtime.h"
 #include "test/test_common/utility.h"
 
 #include "benchmark/benchmark.h"
@@ -85,7 +86,12 @@ static RouteConfiguration genRouteConfig(benchmark::State& state,
  * We then time how long it takes for the request to be matched against the
  * last route.
  */
-static void bmRouteTableSize(benchmark::State& state, RouteMatch::PathSpecifierCase match_type) {
+static void bmRouteTableSize(benchmark::State& state, RouteMatch::PathSpecifierCase match_type,
+                             bool regex_prefilter = false) {
+  TestScopedRuntime scoped_runtime;
+  scoped_runtime.mergeValues({{"envoy.reloadable_features.route_regex_prefilter",
+                               regex_prefilter ? "true" : "false"}});
+
   // Setup router for benchmarking.
   Api::ApiPtr api = Api::createApiForTest();
   NiceMock<Server::Configuration::MockServerFactoryContext> factory_context;
@@ -137,9 +143,64 @@ static void bmRouteTableSizeWithRegexMatch(benchmark::State& state) {
   bmRouteTableSize(state, RouteMatch::PathSpecifierCase::kSafeRegex);
 }
 
+/**
+ * Benchmark the same regex route tables as bmRouteTableSizeWithRegexMatch, with the regex routes
+ * compiled into a single RE2::Set prefilter.
+ */
+static void bmRouteTableSizeWithRegexPrefilter(benchmark::State& state) {
+  bmRouteTableSize(state, RouteMatch::PathSpecifierCase::kSafeRegex, true);
+}
+
+/**
+ * Measure the speed of finding a virtual host among `n` virtual hosts with wildcard domains of
+ * varying lengths in the form of:
+ * - *.tenant-1.example.com and tenant-1.*
+ * - *.tenant-2.example.com and tenant-2.*
+ * - etc.
+ */
+static void bmWildcardVirtualHostLookup(benchmark::State& state) {
+  Api::ApiPtr api = Api::createApiForTest();
+  NiceMock<Server::Configuration::MockServerFactoryContext> factory_context;
+  NiceMock<Envoy::StreamInfo::MockStreamInfo> stream_info;
+  ON_CALL(factory_context, api()).WillByDefault(ReturnRef(*api));
+
+  RouteConfiguration route_config;
+  for (int i = 0; i < state.range(0); ++i) {
+    VirtualHost* v_host = route_config.add_virtual_hosts();
+    v_host->set_name(absl::StrCat("tenant_", i));
+    v_host->add_domains(absl::StrCat("*.tenant-", i, ".example.com"));
+    v_host->add_domains(absl::StrCat("tenant-", i, ".*"));
+    Route* route = v_host->add_routes();
+    route->mutable_match()->set_prefix("/");
+    route->mutable_direct_response()->set_status(200);
+  }
+  std::shared_ptr<ConfigImpl> config = *ConfigImpl::create(
+      route_config, factory_context, ProtobufMessage::getNullValidationVisitor(), true);
+
+  const int last_tenant = state.range(0) - 1;
+  const Http::TestRequestHeaderMapImpl suffix_headers{
+      {":authority", absl::StrCat("www.tenant-", last_tenant, ".example.com")},
+      {":method", "GET"},
+      {":path", "/"},
+      {"x-forwarded-proto", "http"}};
+  const Http::TestRequestHeaderMapImpl prefix_headers{
+      {":authority", absl::StrCat("tenant-", last_tenant, ".example.org")},
+      {":method", "GET"},
+      {":path", "/"},
+      {"x-forwarded-proto", "http"}};
+
+  for (auto _ : state) { // NOLINT
+    config->route(suffix_headers, stream_info, 0);
+    config->route(prefix_headers, stream_info, 0);
+  }
+}
+
 BENCHMARK(bmRouteTableSizeWithPathPrefixMatch)->RangeMultiplier(2)->Ranges({{1, 2 << 13}});
 BENCHMARK(bmRouteTableSizeWithExactPathMatch)->RangeMultiplier(2)->Ranges({{1, 2 << 13}});
 BENCHMARK(bmRouteTableSizeWithRegexMatch)->RangeMultiplier(2)->Ranges({{1, 2 << 13}});
+BENCHMARK(bmRouteTableSizeWithRegexMatch)->Arg(100)->Arg(1000)->Arg(10000);
+BENCHMARK(bmRouteTableSizeWithRegexPrefilter)->Arg(100)->Arg(1000)->Arg(10000);
+BENCHMARK(bmWildcardVirtualHostLookup)->Arg(100)->Arg(10000)->Arg(100000);
 
 } // namespace
 } // namespace Router
@@ -1174,6 +1174,64 @@ virtual_hosts:
             config.route(genHeaders("example.com", "/", "GET"), 0)->routeEntry()->clusterName());
 }
 
+// The most specific wildcard domain wins, whatever the number of wildcard domains of other lengths.
+TEST_F(RouteMatcherTest, TestLongestWildcardDomainMatch) {
+  const std::string yaml = R"EOF(
+virtual_hosts:
+- name: suffix_short
+  domains: ["*.com"]
+  routes:
+  - match: { prefix: "/" }
+    route: { cluster: suffix_short }
+- name: suffix_long
+  domains: ["*.bar.foo.com", "*-bar.foo.com"]
+  routes:
+  - match: { prefix: "/" }
+    route: { cluster: suffix_long }
+- name: suffix_mid
+  domains: ["*.foo.com"]
+  routes:
+  - match: { prefix: "/" }
+    route: { cluster: suffix_mid }
+- name: prefix_short
+  domains: ["api.*"]
+  routes:
+  - match: { prefix: "/" }
+    route: { cluster: prefix_short }
+- name: prefix_long
+  domains: ["api.foo.*"]
+  routes:
+  - match: { prefix: "/" }
+    route: { cluster: prefix_long }
+- name: default
+  domains: ["*"]
+  routes:
+  - match: { prefix: "/" }
+    route: { cluster: default }
+  )EOF";
+
+  factory_context_.cluster_manager_.initializeClusters(
+      {"suffix_short", "suffix_long", "suffix_mid", "prefix_short", "prefix_long", "default"}, {});
+  TestConfigImpl config(parseRouteConfigurationFromYaml(yaml), factory_context_, true,
+                        creation_status_);
+
+  const auto cluster_for = [&config](const std::string& host) {
+    return config.route(genHeaders(host, "/", "GET"), 0)->routeEntry()->clusterName();
+  };
+  EXPECT_EQ("suffix_long", cluster_for("www.bar.foo.com"));
+  EXPECT_EQ("suffix_long", cluster_for("www-bar.foo.com"));
+  EXPECT_EQ("suffix_mid", cluster_for("bar.foo.com"));
+  EXPECT_EQ("suffix_mid", cluster_for("WWW.FOO.COM"));
+  EXPECT_EQ("suffix_short", cluster_for("foo.com"));
+  // Wildcards must match at least one character.
+  EXPECT_EQ("suffix_short", cluster_for(".foo.com"));
+  EXPECT_EQ("prefix_long", cluster_for("api.foo.org"));
+  EXPECT_EQ("prefix_short", cluster_for("api.bar.org"));
+  EXPECT_EQ("prefix_short", cluster_for("api.foo."));
+  EXPECT_EQ("default", cluster_for("api."));
+  EXPECT_EQ("default", cluster_for(""));
+}
+
 TEST_F(RouteMatcherTest, TestRoutesWithInvalidRegex) {
   std::string invalid_route = R"EOF(
 virtual_hosts:
@@ -2317,6 +2375,186 @@ virtual_hosts:
   }
 }
 
+// Virtual hosts with many routes use a path index to skip the routes whose path criterion cannot
+// match. The index must not change which route is selected.
+TEST_F(RouteMatcherTest, PathIndexPreservesFirstMatch) {
+  const std::string yaml = R"EOF(
+virtual_hosts:
+- name: local_service
+  domains: ["*"]
+  routes:
+  - match:
+      prefix: "/api/v1/users"
+      headers:
+      - name: x-user
+        string_match:
+          exact: admin
+    route:
+      cluster: admin_users
+  - match:
+      safe_regex:
+        regex: "/api/v[0-9]+/items/.*"
+    route:
+      cluster: regex_items
+  - match:
+      path: "/api/v1/users"
+    route:
+      cluster: exact_users
+  - match:
+      prefix: "/Legacy"
+      case_sensitive: false
+    route:
+      cluster: legacy
+  - match:
+      path_separated_prefix: "/api/v1"
+    route:
+      cluster: separated_v1
+  - match:
+      prefix: "/api"
+    route:
+      cluster: api
+  )EOF";
+  auto route_configuration = parseRouteConfigurationFromYaml(yaml);
+  auto* virtual_host = route_configuration.mutable_virtual_hosts(0);
+  for (uint32_t i = 0; i < VirtualHostImpl::MinRoutesForPathIndex; ++i) {
+    auto* route = virtual_host->add_routes();
+    route->mutable_match()->set_prefix(absl::StrCat("/filler/", i));
+    route->mutable_route()->set_cluster("filler");
+  }
+  auto* default_route = virtual_host->add_routes();
+  default_route->mutable_match()->set_prefix("");
+  default_route->mutable_route()->set_cluster("default");
+
+  factory_context_.cluster_manager_.initializeClusters({"admin_users", "regex_items", "exact_users",
+                                                        "legacy", "separated_v1", "api", "filler",
+                                                        "default"},
+                                                       {});
+
+  for (const auto& [path_index, regex_prefilter] :
+       std::vector<std::pair<std::string, std::string>>{
+           {"false", "false"}, {"true", "false"}, {"true", "true"}}) {
+    TestScopedRuntime scoped_runtime;
+    scoped_runtime.mergeValues(
+        {{"envoy.reloadable_features.route_path_index", path_index},
+         {"envoy.reloadable_features.route_regex_prefilter", regex_prefilter}});
+    TestConfigImpl config(route_configuration, factory_context_, true, creation_status_);
+    ASSERT_TRUE(creation_status_.ok());
+
+    const auto cluster_for = [&config](const std::string& path) {
+      return config.route(genHeaders("www.lyft.com", path, "GET"), 0)->routeEntry()->clusterName();
+    };
+
+    {
+      Http::TestRequestHeaderMapImpl headers = genHeaders("www.lyft.com", "/api/v1/users", "GET");
+      headers.addCopy("x-user", "admin");
+      EXPECT_EQ("admin_users", config.route(headers, 0)->routeEntry()->clusterName());
+    }
+    EXPECT_EQ("exact_users", cluster_for("/api/v1/users"));
+    EXPECT_EQ("exact_users", cluster_for("/api/v1/users?foo=bar"));
+    EXPECT_EQ("regex_items", cluster_for("/api/v2/items/42"));
+    EXPECT_EQ("legacy", cluster_for("/LEGACY/index.html"));
+    EXPECT_EQ("separated_v1", cluster_for("/api/v1"));
+    EXPECT_EQ("separated_v1", cluster_for("/api/v1/other"));
+    EXPECT_EQ("api", cluster_for("/api/v1x"));
+    EXPECT_EQ("filler", cluster_for("/filler/7"));
+    EXPECT_EQ("default", cluster_for("/filler"));
+    EXPECT_EQ("default", cluster_for("/"));
+
+    // All routes matching a path are evaluated in route table order, and the evaluation status
+    // refers to the whole route table.
+    std::vector<std::string> matched;
+    config.route(
+        [&matched](RouteConstSharedPtr route, RouteEvalStatus eval_status) -> RouteMatchStatus {
+          matched.push_back(route->routeEntry()->clusterName());
+          EXPECT_EQ(matched.back() == "default", eval_status == RouteEvalStatus::NoMoreRoutes);
+          return RouteMatchStatus::Continue;
+        },
+        genHeaders("www.lyft.com", "/api/v1/items/1", "GET"));
+    EXPECT_THAT(matched, ElementsAre("regex_items", "separated_v1", "api", "default"));
+  }
+}
+
+// Virtual hosts whose configuration did not change are shared with the config built for the
+// previous version of a route configuration.
+TEST_F(RouteMatcherTest, ReuseUnchangedVirtualHosts) {
+  const std::string yaml = R"EOF(
+virtual_hosts:
+- name: foo
+  domains: ["foo.com"]
+  routes:
+  - match:
+      prefix: "/"
+    route:
+      cluster: foo
+- name: bar
+  domains: ["bar.com"]
+  routes:
+  - match:
+      prefix: "/"
+    route:
+      cluster: bar
+  )EOF";
+  factory_context_.cluster_manager_.initializeClusters({"foo", "bar", "baz"}, {});
+  NiceMock<Envoy::StreamInfo::MockStreamInfo> stream_info;
+  const auto virtual_host_for = [&stream_info](const ConfigImpl& config, const std::string& host) {
+    return &config.route(genHeaders(host, "/", "GET"), stream_info, 0)->virtualHost();
+  };
+
+  const auto route_configuration = parseRouteConfigurationFromYaml(yaml);
+  std::shared_ptr<ConfigImpl> first = *ConfigImpl::create(
+      route_configuration, factory_context_, ProtobufMessage::getNullValidationVisitor(), false);
+
+  // Only the changed virtual host is rebuilt.
+  auto changed_bar = route_configuration;
+  changed_bar.mutable_virtual_hosts(1)->mutable_routes(0)->mutable_route()->set_cluster("baz");
+  std::shared_ptr<ConfigImpl> second =
+      *ConfigImpl::create(changed_bar, factory_context_,
+                          ProtobufMessage::getNullValidationVisitor(), false, first.get());
+  EXPECT_EQ(virtual_host_for(*first, "foo.com"), virtual_host_for(*second, "foo.com"));
+  EXPECT_NE(virtual_host_for(*first, "bar.com"), virtual_host_for(*second, "bar.com"));
+  EXPECT_EQ("baz", second->route(genHeaders("bar.com", "/", "GET"), stream_info, 0)
+                       ->routeEntry()
+                       ->clusterName());
+
+  // Virtual hosts are reused from the latest config, including across a reordering.
+  auto reordered = changed_bar;
+  reordered.mutable_virtual_hosts()->SwapElements(0, 1);
+  std::shared_ptr<ConfigImpl> third =
+      *ConfigImpl::create(reordered, factory_context_, ProtobufMessage::getNullValidationVisitor(),
+                          false, second.get());
+  EXPECT_EQ(virtual_host_for(*second, "foo.com"), virtual_host_for(*third, "foo.com"));
+  EXPECT_EQ(virtual_host_for(*second, "bar.com"), virtual_host_for(*third, "bar.com"));
+
+  // A change outside of the virtual hosts rebuilds all of them.
+  auto changed_common = reordered;
+  changed_common.add_internal_only_headers("x-internal");
+  std::shared_ptr<ConfigImpl> fourth =
+      *ConfigImpl::create(changed_common, factory_context_,
+                          ProtobufMessage::getNullValidationVisitor(), false, third.get());
+  EXPECT_NE(virtual_host_for(*third, "foo.com"), virtual_host_for(*fourth, "foo.com"));
+  EXPECT_NE(virtual_host_for(*third, "bar.com"), virtual_host_for(*fourth, "bar.com"));
+  EXPECT_EQ(1, fourth->internalOnlyHeaders().size());
+
+  // Virtual hosts validated against the clusters are always rebuilt.
+  std::shared_ptr<ConfigImpl> validated =
+      *ConfigImpl::create(changed_common, factory_context_,
+                          ProtobufMessage::getNullValidationVisitor(), true, fourth.get());
+  std::shared_ptr<ConfigImpl> validated_again =
+      *ConfigImpl::create(changed_common, factory_context_,
+                          ProtobufMessage::getNullValidationVisitor(), true, validated.get());
+  EXPECT_NE(virtual_host_for(*validated, "foo.com"), virtual_host_for(*validated_again, "foo.com"));
+
+  {
+    TestScopedRuntime scoped_runtime;
+    scoped_runtime.mergeValues(
+        {{"envoy.reloadable_features.reuse_unchanged_virtual_hosts", "false"}});
+    std::shared_ptr<ConfigImpl> rebuilt =
+        *ConfigImpl::create(changed_common, factory_context_,
+                            ProtobufMessage::getNullValidationVisitor(), false, fourth.get());
+    EXPECT_NE(virtual_host_for(*fourth, "foo.com"), virtual_host_for(*rebuilt, "foo.com"));
+  }
+}
+
 // Tests that when 'ignore_port_in_host_matching' is true, port from host header
 // is ignored in host matching.
 TEST_F(RouteMatcherTest, IgnorePortInHostMatching) {
@@ -7112,6 +7350,8 @@ virtual_hosts:
   EXPECT_EQ(cors_policy->enabled(), false);
   EXPECT_EQ(cors_policy->shadowEnabled(), true);
   EXPECT_EQ(1, cors_policy->allowOrigins().size());
+  EXPECT_TRUE(cors_policy->isOriginAllowed("www.envoyproxy.io"));
+  EXPECT_FALSE(cors_policy->isOriginAllowed("envoyproxy.com"));
   EXPECT_EQ(cors_policy->allowMethods(), "test-methods");
   EXPECT_EQ(cors_policy->allowHeaders(), "test-headers");
   EXPECT_EQ(cors_policy->exposeHeaders(), "test-expose-headers");
@@ -7170,6 +7410,8 @@ virtual_hosts:
   EXPECT_EQ(cors_policy->enabled(), false);
   EXPECT_EQ(cors_policy->shadowEnabled(), true);
   EXPECT_EQ(1, cors_policy->allowOrigins().size());
+  EXPECT_TRUE(cors_policy->isOriginAllowed("test-origin"));
+  EXPECT_FALSE(cors_policy->isOriginAllowed("Test-Origin"));
   EXPECT_EQ(cors_policy->allowMethods(), "test-methods");
   EXPECT_EQ(cors_policy->allowHeaders(), "test-headers");
   EXPECT_EQ(cors_policy->exposeHeaders(), "test-expose-headers");
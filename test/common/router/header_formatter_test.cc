@@ -775,6 +775,31 @@ request_headers_to_remove: ["x-foo-header"]
   EXPECT_EQ("bar", header_map.get_("x-foo-header"));
 }
 
+// Test that several headers, inline or not and repeated or not, are removed together.
+TEST(HeaderParserTest, EvaluateRequestHeadersRemoveMultiple) {
+  const std::string yaml = R"EOF(
+match: { prefix: "/new_endpoint" }
+route:
+  cluster: www2
+request_headers_to_remove: ["x-foo-header", "user-agent", "x-bar-header"]
+)EOF";
+
+  const auto route = parseRouteFromV3Yaml(yaml);
+  HeaderParserPtr req_header_parser =
+      HeaderParser::configure(route.request_headers_to_add(), route.request_headers_to_remove())
+          .value();
+  Http::TestRequestHeaderMapImpl header_map{{"x-foo-header", "foo"},
+                                            {"user-agent", "agent"},
+                                            {"x-baz-header", "baz"},
+                                            {"x-foo-header", "foo2"},
+                                            {"x-bar-header", "bar"}};
+  NiceMock<Envoy::StreamInfo::MockStreamInfo> stream_info;
+
+  req_header_parser->evaluateHeaders(header_map, stream_info);
+  EXPECT_EQ(Http::TestRequestHeaderMapImpl({{"x-baz-header", "baz"}}), header_map);
+  EXPECT_EQ(nullptr, header_map.UserAgent());
+}
+
 TEST(HeaderParserTest, EvaluateRequestHeadersAddIfAbsent) {
   const std::string yaml = R"EOF(
 match: { prefix: "/new_endpoint" }
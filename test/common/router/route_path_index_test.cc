@@ -0,0 +1,103 @@
+#include "envoy/config/route/v3/route_components.pb.h"
+
+#include "source/common/router/route_path_index.h"
+
+#include "test/test_common/utility.h"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Router {
+namespace {
+
+using testing::ElementsAre;
+using testing::IsEmpty;
+
+envoy::config::route::v3::RouteMatch parseMatch(const std::string& yaml) {
+  envoy::config::route::v3::RouteMatch match;
+  TestUtility::loadFromYaml(yaml, match);
+  return match;
+}
+
+TEST(RoutePathIndexTest, Empty) {
+  RoutePathIndex index;
+  index.compile();
+  EXPECT_EQ(0, index.indexedRoutes());
+  EXPECT_THAT(index.candidates("/foo"), IsEmpty());
+}
+
+TEST(RoutePathIndexTest, PrefixAndExactRoutes) {
+  RoutePathIndex index;
+  index.addRoute(0, parseMatch("prefix: /foo/bar"));
+  index.addRoute(1, parseMatch("path: /foo"));
+  index.addRoute(2, parseMatch("path_separated_prefix: /foo"));
+  index.addRoute(3, parseMatch("prefix: /foo/bar"));
+  index.addRoute(4, parseMatch("prefix: /baz"));
+  index.addRoute(5, parseMatch("prefix: ''"));
+  index.compile();
+  EXPECT_EQ(6, index.indexedRoutes());
+
+  EXPECT_THAT(index.candidates("/foo"), ElementsAre(1, 2, 5));
+  EXPECT_THAT(index.candidates("/foo/bar/baz"), ElementsAre(0, 2, 3, 5));
+  EXPECT_THAT(index.candidates("/foobar"), ElementsAre(2, 5));
+  EXPECT_THAT(index.candidates("/baz"), ElementsAre(4, 5));
+  EXPECT_THAT(index.candidates("/other"), ElementsAre(5));
+}
+
+TEST(RoutePathIndexTest, UnindexedRoutesAreAlwaysCandidates) {
+  RoutePathIndex index;
+  index.addRoute(0, parseMatch("safe_regex: { regex: '/foo/.*' }"));
+  index.addRoute(1, parseMatch("prefix: /foo"));
+  index.addRoute(2, parseMatch("{ prefix: /BAR, case_sensitive: false }"));
+  index.addRoute(3, parseMatch("connect_matcher: {}"));
+  index.addRoute(4, parseMatch("path: /bar"));
+  index.compile();
+  EXPECT_EQ(2, index.indexedRoutes());
+
+  EXPECT_THAT(index.candidates("/foo/x"), ElementsAre(0, 1, 2, 3));
+  EXPECT_THAT(index.candidates("/bar"), ElementsAre(0, 2, 3, 4));
+  EXPECT_THAT(index.candidates("/other"), ElementsAre(0, 2, 3));
+}
+
+TEST(RoutePathIndexTest, RegexRoutesUnindexedWithoutPrefilter) {
+  RoutePathIndex index;
+  index.addRoute(0, parseMatch("safe_regex: { regex: '/foo/[0-9]+' }"));
+  index.addRoute(1, parseMatch("prefix: /foo"));
+  index.compile();
+  EXPECT_EQ(1, index.indexedRoutes());
+
+  EXPECT_THAT(index.candidates("/bar"), ElementsAre(0));
+}
+
+TEST(RoutePathIndexTest, RegexPrefilter) {
+  RoutePathIndex index(true);
+  index.addRoute(0, parseMatch("safe_regex: { regex: '/foo/[0-9]+' }"));
+  index.addRoute(1, parseMatch("prefix: /foo"));
+  index.addRoute(2, parseMatch("safe_regex: { regex: '/foo/.*' }"));
+  index.addRoute(3, parseMatch("safe_regex: { regex: '/bar' }"));
+  index.addRoute(4, parseMatch("connect_matcher: {}"));
+  index.compile();
+  EXPECT_EQ(4, index.indexedRoutes());
+
+  EXPECT_THAT(index.candidates("/foo/42"), ElementsAre(0, 1, 2, 4));
+  EXPECT_THAT(index.candidates("/foo/x"), ElementsAre(1, 2, 4));
+  // Regex routes must match the whole path.
+  EXPECT_THAT(index.candidates("/bar"), ElementsAre(3, 4));
+  EXPECT_THAT(index.candidates("/bar/baz"), ElementsAre(4));
+  EXPECT_THAT(index.candidates("/barbaz"), ElementsAre(4));
+}
+
+TEST(RoutePathIndexTest, RegexPrefilterWithoutRegexRoutes) {
+  RoutePathIndex index(true);
+  index.addRoute(0, parseMatch("prefix: /foo"));
+  index.compile();
+  EXPECT_EQ(1, index.indexedRoutes());
+
+  EXPECT_THAT(index.candidates("/foo"), ElementsAre(0));
+  EXPECT_THAT(index.candidates("/bar"), IsEmpty());
+}
+
+} // namespace
+} // namespace Router
+} // namespace Envoy
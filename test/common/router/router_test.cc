@@ -528,6 +528,32 @@ TEST_F(RouterTest, HashPolicyNoHash) {
             callbacks_.route_->route_entry_.virtual_cluster_.stats().upstream_rq_total_.value());
 }
 
+// Test that the hash policy is only evaluated once for the stream.
+TEST_F(RouterTest, HashPolicyComputedOnce) {
+  ON_CALL(callbacks_.route_->route_entry_, hashPolicy())
+      .WillByDefault(Return(&callbacks_.route_->route_entry_.hash_policy_));
+  EXPECT_CALL(callbacks_.route_->route_entry_.hash_policy_, generateHash(_, _, _, _))
+      .WillOnce(Return(absl::optional<uint64_t>()));
+  EXPECT_CALL(cm_.thread_local_cluster_, httpConnPool(_, _, _))
+      .WillOnce(Invoke([&](Upstream::ResourcePriority, absl::optional<Http::Protocol>,
+                           Upstream::LoadBalancerContext* context) {
+        EXPECT_FALSE(context->computeHashKey());
+        EXPECT_FALSE(context->computeHashKey());
+        return Upstream::HttpPoolData([]() {}, &cm_.thread_local_cluster_.conn_pool_);
+      }));
+  EXPECT_CALL(cm_.thread_local_cluster_.conn_pool_, newStream(_, _, _))
+      .WillOnce(Return(&cancellable_));
+  expectResponseTimerCreate();
+
+  Http::TestRequestHeaderMapImpl headers;
+  HttpTestUtility::addDefaultHeaders(headers);
+  router_->decodeHeaders(headers, true);
+  EXPECT_FALSE(router_->computeHashKey());
+
+  EXPECT_CALL(cancellable_, cancel(_));
+  router_->onDestroy();
+}
+
 TEST_F(RouterTest, HashKeyNoHashPolicy) {
   ON_CALL(callbacks_.route_->route_entry_, hashPolicy()).WillByDefault(Return(nullptr));
   EXPECT_FALSE(router_->computeHashKey().has_value());
@@ -2950,6 +2976,43 @@ TEST_F(RouterTest, RetryRequestDuringBodyBufferLimitExceeded) {
   EXPECT_TRUE(verifyHostUpstreamStats(0, 1));
 }
 
+// Test that a retry is given up as for the buffer limit of the request when the body would take
+// the bytes buffered on the worker past their budget.
+TEST_F(RouterTest, RetryRequestDuringBodyWorkerBufferBudgetExceeded) {
+  config_->max_retry_buffer_bytes_per_worker_ = 10;
+  Buffer::OwnedImpl decoding_buffer;
+  EXPECT_CALL(callbacks_, decodingBuffer()).WillRepeatedly(Return(&decoding_buffer));
+  EXPECT_CALL(callbacks_, addDecodedData(_, true))
+      .WillRepeatedly(Invoke([&](Buffer::Instance& data, bool) { decoding_buffer.move(data); }));
+
+  NiceMock<Http::MockRequestEncoder> encoder1;
+  Http::ResponseDecoder* response_decoder = nullptr;
+  expectNewStreamWithImmediateEncoder(encoder1, &response_decoder, Http::Protocol::Http10);
+
+  Http::TestRequestHeaderMapImpl headers{
+      {"x-envoy-retry-on", "5xx"}, {"x-envoy-internal", "true"}, {"myheader", "present"}};
+  HttpTestUtility::addDefaultHeaders(headers);
+  router_->decodeHeaders(headers, false);
+  const std::string body1("body1");
+  Buffer::OwnedImpl buf1(body1);
+  EXPECT_CALL(*router_->retry_state_, enabled()).Times(2).WillRepeatedly(Return(true));
+  router_->decodeData(buf1, false);
+
+  router_->retry_state_->expectResetRetry();
+  encoder1.stream_.resetStream(Http::StreamResetReason::RemoteReset);
+
+  // The rest of the body fits in the limit of the request, but not in the budget of the worker.
+  const std::string body2(50, 'a');
+  Buffer::OwnedImpl buf2(body2);
+  router_->decodeData(buf2, false);
+
+  EXPECT_EQ(callbacks_.details(), "request_payload_exceeded_retry_buffer_limit");
+  EXPECT_EQ(1U, cm_.thread_local_cluster_.cluster_.info_->stats_store_
+                    .counter("retry_or_shadow_abandoned")
+                    .value());
+  EXPECT_TRUE(verifyHostUpstreamStats(0, 1));
+}
+
 // Two requests are sent (slow request + hedged retry) and then global timeout
 // is hit. Verify everything gets cleaned up.
 TEST_F(RouterTest, HedgedPerTryTimeoutGlobalTimeout) {
@@ -4867,6 +4930,58 @@ TEST_P(RouterShadowingTest, BufferingShadow) {
   EXPECT_TRUE(verifyHostUpstreamStats(1, 0));
 }
 
+TEST_P(RouterShadowingTest, BufferingShadowSharesBody) {
+  if (streaming_shadow_) {
+    GTEST_SKIP();
+  }
+  ShadowPolicyPtr policy = makeShadowPolicy("foo", "", "bar");
+  callbacks_.route_->route_entry_.shadow_policies_.push_back(policy);
+  ON_CALL(callbacks_, streamId()).WillByDefault(Return(43));
+
+  NiceMock<Http::MockRequestEncoder> encoder;
+  Http::ResponseDecoder* response_decoder = nullptr;
+  expectNewStreamWithImmediateEncoder(encoder, &response_decoder, Http::Protocol::Http10);
+
+  expectResponseTimerCreate();
+
+  EXPECT_CALL(
+      runtime_.snapshot_,
+      featureEnabled("bar", testing::Matcher<const envoy::type::v3::FractionalPercent&>(Percent(0)),
+                     43))
+      .WillOnce(Return(true));
+
+  Http::TestRequestHeaderMapImpl headers;
+  HttpTestUtility::addDefaultHeaders(headers);
+  router_->decodeHeaders(headers, false);
+
+  // The body is large enough to be shared rather than copied.
+  Buffer::InstancePtr body_data(new Buffer::OwnedImpl(std::string(4096, 'a')));
+  const void* body_mem = body_data->frontSlice().mem_;
+  EXPECT_CALL(encoder, encodeData(_, false))
+      .WillOnce(Invoke([body_mem](Buffer::Instance& data, bool) -> void {
+        EXPECT_EQ(body_mem, data.frontSlice().mem_);
+      }));
+  EXPECT_CALL(callbacks_, addDecodedData(_, true));
+  EXPECT_EQ(Http::FilterDataStatus::StopIterationNoBuffer, router_->decodeData(*body_data, false));
+
+  Http::TestRequestTrailerMapImpl trailers{{"some", "trailer"}};
+  EXPECT_CALL(callbacks_, decodingBuffer())
+      .Times(AtLeast(2))
+      .WillRepeatedly(Return(body_data.get()));
+  EXPECT_CALL(*shadow_writer_, shadow_("foo", _, _))
+      .WillOnce(Invoke([body_mem](const std::string&, Http::RequestMessagePtr& request,
+                                  const Http::AsyncClient::RequestOptions&) -> void {
+        EXPECT_EQ(4096, request->body().length());
+        EXPECT_EQ(body_mem, request->body().frontSlice().mem_);
+      }));
+  router_->decodeTrailers(trailers);
+
+  Http::ResponseHeaderMapPtr response_headers(
+      new Http::TestResponseHeaderMapImpl{{":status", "200"}});
+  response_decoder->decodeHeaders(std::move(response_headers), true);
+  EXPECT_TRUE(verifyHostUpstreamStats(1, 0));
+}
+
 TEST_P(RouterShadowingTest, NoShadowForConnect) {
   ShadowPolicyPtr policy = makeShadowPolicy("foo");
   callbacks_.route_->route_entry_.shadow_policies_.push_back(policy);
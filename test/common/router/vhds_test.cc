@@ -19,6 +19,7 @@
 #include "test/mocks/config/mocks.h"
 #include "test/mocks/init/mocks.h"
 #include "test/mocks/server/instance.h"
+#include "test/mocks/stream_info/mocks.h"
 #include "test/mocks/thread_local/mocks.h"
 #include "test/test_common/printers.h"
 #include "test/test_common/simulated_time_system.h"
@@ -153,6 +154,45 @@ TEST_F(VhdsTest, VhdsAddsVirtualHosts) {
       vhost, config_update_info->protobufConfigurationCast().virtual_hosts(0)));
 }
 
+// verify that virtual hosts left untouched by a VHDS update are not rebuilt
+TEST_F(VhdsTest, VhdsUpdateReusesUnchangedVirtualHosts) {
+  const auto route_config =
+      TestUtility::parseYaml<envoy::config::route::v3::RouteConfiguration>(default_vhds_config_);
+  RouteConfigUpdatePtr config_update_info = makeRouteConfigUpdate(route_config);
+
+  VhdsSubscriptionPtr subscription = VhdsSubscription::createVhdsSubscription(
+                                         config_update_info, factory_context_, context_, provider_)
+                                         .value();
+  NiceMock<StreamInfo::MockStreamInfo> stream_info;
+  const auto virtual_host_for = [&config_update_info, &stream_info](const std::string& host) {
+    auto config =
+        std::dynamic_pointer_cast<const Config>(config_update_info->parsedConfiguration());
+    return &config->route(Http::TestRequestHeaderMapImpl{{":authority", host}, {":path", "/"}},
+                          stream_info, 0)
+                ->virtualHost();
+  };
+  const Protobuf::RepeatedPtrField<std::string> removed_resources;
+
+  const auto first_resources = buildAddedResources({buildVirtualHost("vhost1", "vhost.first")});
+  const auto first_decoded =
+      TestUtility::decodeResources<envoy::config::route::v3::VirtualHost>(first_resources);
+  EXPECT_TRUE(factory_context_.cluster_manager_.subscription_factory_.callbacks_
+                  ->onConfigUpdate(first_decoded.refvec_, removed_resources, "1")
+                  .ok());
+  const VirtualHost* first_vhost = virtual_host_for("vhost.first");
+
+  const auto second_resources = buildAddedResources({buildVirtualHost("vhost2", "vhost.second")});
+  const auto second_decoded =
+      TestUtility::decodeResources<envoy::config::route::v3::VirtualHost>(second_resources);
+  EXPECT_TRUE(factory_context_.cluster_manager_.subscription_factory_.callbacks_
+                  ->onConfigUpdate(second_decoded.refvec_, removed_resources, "2")
+                  .ok());
+
+  EXPECT_EQ(2UL, config_update_info->protobufConfigurationCast().virtual_hosts_size());
+  EXPECT_EQ(first_vhost, virtual_host_for("vhost.first"));
+  EXPECT_EQ("vhost2", virtual_host_for("vhost.second")->name());
+}
+
 // verify that an RDS update of virtual hosts leaves VHDS virtual hosts intact
 TEST_F(VhdsTest, RdsUpdatesVirtualHosts) {
   const auto route_config =
@@ -224,6 +264,14 @@ vhds:
               "vhost_rds2" == actual_vhost_2.name());
   EXPECT_TRUE("vhost_vhds1" == actual_vhost_0.name() || "vhost_vhds1" == actual_vhost_1.name() ||
               "vhost_vhds1" == actual_vhost_2.name());
+
+  // A shared update with VHDS is copied, to merge the VHDS vhosts into it.
+  auto shared_route_config =
+      std::make_shared<envoy::config::route::v3::RouteConfiguration>(updated_route_config);
+  shared_route_config->mutable_virtual_hosts(1)->set_name("vhost_rds3");
+  EXPECT_TRUE(config_update_info->onRdsUpdate(shared_route_config, "3"));
+  EXPECT_EQ(3UL, config_update_info->protobufConfigurationCast().virtual_hosts_size());
+  EXPECT_NE(shared_route_config.get(), &config_update_info->protobufConfiguration());
 }
 
 } // namespace
@@ -10,6 +10,7 @@
 #include "source/common/config/runtime_utility.h"
 #include "source/common/runtime/runtime_features.h"
 #include "source/common/runtime/runtime_impl.h"
+#include "source/common/runtime/runtime_key_index.h"
 
 #include "test/common/stats/stat_test_utility.h"
 #include "test/mocks/common.h"
@@ -565,6 +566,39 @@ TEST_F(StaticLoaderImplTest, All) {
   testNewOverrides(*loader_, store_);
 }
 
+// Test that the indexed keys are found in the snapshots made after they were registered, and by
+// name in the older ones.
+TEST_F(StaticLoaderImplTest, IndexedKeys) {
+  base_ = TestUtility::parseYaml<ProtobufWkt::Struct>(R"EOF(
+    indexed_integer: 4
+    indexed_double: 2.5
+    indexed_boolean: true
+    indexed_late: 7
+  )EOF");
+  const IndexedKey integer_key("indexed_integer");
+  const IndexedKey double_key("indexed_double");
+  const IndexedKey boolean_key("indexed_boolean");
+  const IndexedKey missing_key("indexed_missing");
+  setup();
+
+  EXPECT_EQ(4UL, integer_key.getInteger(loader_->snapshot(), 1));
+  EXPECT_EQ(1UL, double_key.getInteger(loader_->snapshot(), 1));
+  EXPECT_EQ(2.5, double_key.getDouble(loader_->snapshot(), 1.1));
+  EXPECT_TRUE(boolean_key.getBoolean(loader_->snapshot(), false));
+  EXPECT_FALSE(integer_key.getBoolean(loader_->snapshot(), false));
+  EXPECT_EQ(1UL, missing_key.getInteger(loader_->snapshot(), 1));
+  EXPECT_EQ(1.1, missing_key.getDouble(loader_->snapshot(), 1.1));
+  EXPECT_TRUE(missing_key.getBoolean(loader_->snapshot(), true));
+
+  const IndexedKey late_key("indexed_late");
+  EXPECT_EQ(7UL, late_key.getInteger(loader_->snapshot(), 1));
+
+  ASSERT_TRUE(loader_->mergeValues({{"indexed_late", "8"}, {"indexed_missing", "9"}}).ok());
+  EXPECT_EQ(8UL, late_key.getInteger(loader_->snapshot(), 1));
+  EXPECT_EQ(9UL, missing_key.getInteger(loader_->snapshot(), 1));
+  EXPECT_EQ(4UL, integer_key.getInteger(loader_->snapshot(), 1));
+}
+
 #ifdef ENVOY_ENABLE_QUIC
 TEST_F(StaticLoaderImplTest, QuicheReloadableFlags) {
   EXPECT_TRUE(GetQuicheReloadableFlag(quic_testonly_default_true));
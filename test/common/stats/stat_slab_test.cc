@@ -0,0 +1,81 @@
+#include <vector>
+
+#include "source/common/stats/stat_slab.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Stats {
+namespace {
+
+constexpr size_t BlockSize = 40;
+
+class StatSlabTest : public testing::Test {
+protected:
+  StatSlabTest() : slab_(&owner_, BlockSize, alignof(uint64_t)) {}
+
+  // Allocates enough blocks to fill the first chunk and start a second one.
+  std::vector<void*> allocateTwoChunks() {
+    std::vector<void*> blocks;
+    while (slab_.numChunksForTest() < 2) {
+      blocks.push_back(slab_.allocate());
+    }
+    return blocks;
+  }
+
+  int owner_;
+  StatSlab slab_;
+};
+
+TEST_F(StatSlabTest, ContiguousBlocks) {
+  void* block1 = slab_.allocate();
+  void* block2 = slab_.allocate();
+  EXPECT_EQ(BlockSize, slab_.blockSize());
+  EXPECT_EQ(static_cast<char*>(block1) + BlockSize, block2);
+  EXPECT_EQ(0, reinterpret_cast<uintptr_t>(block1) % alignof(uint64_t));
+  EXPECT_EQ(&owner_, StatSlab::owner(block1));
+  EXPECT_EQ(&owner_, StatSlab::owner(static_cast<char*>(block2) + BlockSize - 1));
+  StatSlab::release(block1);
+  StatSlab::release(block2);
+  StatSlab::release(nullptr);
+}
+
+TEST_F(StatSlabTest, ReusesReleasedBlock) {
+  void* block1 = slab_.allocate();
+  void* block2 = slab_.allocate();
+  StatSlab::release(block1);
+  EXPECT_EQ(block1, slab_.allocate());
+  StatSlab::release(block1);
+  StatSlab::release(block2);
+}
+
+TEST_F(StatSlabTest, ReleasesEmptyChunks) {
+  std::vector<void*> blocks = allocateTwoChunks();
+  void* last = blocks.back();
+  blocks.pop_back();
+
+  // Releasing a block of the full chunk makes it available again, before a third chunk.
+  void* first = blocks.front();
+  StatSlab::release(first);
+  EXPECT_EQ(first, slab_.allocate());
+  EXPECT_EQ(2, slab_.numChunksForTest());
+
+  // The first chunk is returned to the heap once all its blocks are released, not the last one.
+  for (void* block : blocks) {
+    StatSlab::release(block);
+  }
+  EXPECT_EQ(1, slab_.numChunksForTest());
+  StatSlab::release(last);
+  EXPECT_EQ(1, slab_.numChunksForTest());
+}
+
+TEST_F(StatSlabTest, RoundsBlockSize) {
+  StatSlab slab(&owner_, 1, 1);
+  EXPECT_EQ(sizeof(void*), slab.blockSize());
+  StatSlab large_slab(&owner_, 42, 8);
+  EXPECT_EQ(48, large_slab.blockSize());
+}
+
+} // namespace
+} // namespace Stats
+} // namespace Envoy
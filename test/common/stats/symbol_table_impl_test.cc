@@ -170,6 +170,27 @@ TEST_F(StatNameTest, TestDynamicPools) {
   EXPECT_NE(dynamic2.data(), dynamic.data());
 }
 
+TEST_F(StatNameTest, DecodeTokens) {
+  StatNameDynamicPool dynamic(table_);
+  const SymbolTable::StoragePtr joined =
+      table_.join({makeStat("a.b"), dynamic.add("c.d"), makeStat("a")});
+  std::vector<std::pair<Symbol, std::string>> symbols;
+  std::vector<std::string> dynamics;
+  table_.decodeTokens(
+      StatName(joined.get()),
+      [&symbols](Symbol symbol, absl::string_view str) {
+        symbols.emplace_back(symbol, std::string(str));
+      },
+      [&dynamics](absl::string_view str) { dynamics.emplace_back(str); });
+  ASSERT_EQ(3, symbols.size());
+  EXPECT_EQ("a", symbols[0].second);
+  EXPECT_EQ("b", symbols[1].second);
+  EXPECT_EQ("a", symbols[2].second);
+  EXPECT_EQ(symbols[0].first, symbols[2].first);
+  EXPECT_NE(symbols[0].first, symbols[1].first);
+  EXPECT_EQ(std::vector<std::string>{"c.d"}, dynamics);
+}
+
 TEST_F(StatNameTest, TestDynamicHash) {
   StatNameDynamicPool dynamic(table_);
   const StatName d1 = dynamic.add("dynamic");
@@ -232,7 +253,7 @@ TEST_F(StatNameTest, TestSuccessfulDecode) {
 class StatNameDeathTest : public StatNameTest {
 public:
   void decodeSymbolVec(const SymbolVec& symbol_vec) {
-    Thread::LockGuard lock(table_.lock_);
+    absl::ReaderMutexLock lock(&table_.lock_);
     for (Symbol symbol : symbol_vec) {
       table_.fromSymbol(symbol);
     }
@@ -532,19 +553,11 @@ TEST_F(StatNameTest, RacingSymbolCreation) {
   access.setReady();
   accesses.Wait();
 
-  // In a perfect world, we could use reader-locks in the SymbolTable
-  // implementation, and there should be zero additional contentions
-  // after latching 'create_contentions' above. And we can definitely
-  // have this world, but this slows down BM_CreateRace in
-  // symbol_table_speed_test.cc, even on a 72-core machine.
-  //
-  // Thus it is better to avoid symbol-table contention by refactoring
-  // all stat-creation code to symbolize all stat string elements at
-  // construction, as composition does not require a lock.
-  //
-  // See this commit
-  // https://github.com/envoyproxy/envoy/pull/5321/commits/ef712d0f5a11ff49831c1935e8a2ef8a0a935bc9
-  // for a working reader-lock implementation, which would pass this EXPECT:
+  // Encoding names whose symbols all exist only takes the SymbolTable
+  // lock shared, so there should be no additional contentions on it after
+  // latching 'create_contentions' above. The tracer also counts the
+  // contentions on the synchronization primitives of this test though, so
+  // we can't assert:
   //     EXPECT_EQ(create_contentions, mutex_tracer.numContentions());
   //
   // Note also that we cannot guarantee there *will* be contentions
@@ -556,6 +569,39 @@ TEST_F(StatNameTest, RacingSymbolCreation) {
   }
 }
 
+// Validates that the reference counts stay consistent when threads concurrently
+// add and drop references on shared symbols, some of them the last ones.
+TEST_F(StatNameTest, RacingReferenceCounts) {
+  Thread::ThreadFactory& thread_factory = Thread::threadFactoryForTest();
+  StatNameStorage shared("shared.prefix", table_);
+
+  constexpr int num_threads = 16;
+  std::vector<Thread::ThreadPtr> threads;
+  threads.reserve(num_threads);
+  ConditionalInitializer start;
+  for (int i = 0; i < num_threads; ++i) {
+    threads.push_back(thread_factory.createThread([this, i, &start, &shared]() {
+      const std::string name = absl::StrCat("shared.prefix.dynamic", i % 4);
+      start.wait();
+      for (int count = 0; count < 1000; ++count) {
+        StatNameStorage encoded(name, table_);
+        StatNameStorage copy(shared.statName(), table_);
+        EXPECT_EQ(name, table_.toString(encoded.statName()));
+        copy.free(table_);
+        encoded.free(table_);
+      }
+    }));
+  }
+  start.setReady();
+  for (auto& thread : threads) {
+    thread->join();
+  }
+
+  // Only the symbols of the shared name are left.
+  EXPECT_EQ(2, table_.numSymbols());
+  shared.free(table_);
+}
+
 TEST_F(StatNameTest, MutexContentionOnExistingSymbols) {
   Thread::ThreadFactory& thread_factory = Thread::threadFactoryForTest();
   MutexTracerImpl& mutex_tracer = MutexTracerImpl::getOrCreateTracer();
@@ -600,19 +646,11 @@ TEST_F(StatNameTest, MutexContentionOnExistingSymbols) {
   access.setReady();
   accesses.Wait();
 
-  // In a perfect world, we could use reader-locks in the SymbolTable
-  // implementation, and there should be zero additional contentions
-  // after latching 'create_contentions' above. And we can definitely
-  // have this world, but this slows down BM_CreateRace in
-  // symbol_table_speed_test.cc, even on a 72-core machine.
-  //
-  // Thus it is better to avoid symbol-table contention by refactoring
-  // all stat-creation code to symbolize all stat string elements at
-  // construction, as composition does not require a lock.
-  //
-  // See this commit
-  // https://github.com/envoyproxy/envoy/pull/5321/commits/ef712d0f5a11ff49831c1935e8a2ef8a0a935bc9
-  // for a working reader-lock implementation, which would pass this EXPECT:
+  // Encoding names whose symbols all exist only takes the SymbolTable
+  // lock shared, so there should be no additional contentions on it after
+  // latching 'create_contentions' above. The tracer also counts the
+  // contentions on the synchronization primitives of this test though, so
+  // we can't assert:
   //     EXPECT_EQ(create_contentions, mutex_tracer.numContentions());
   //
   // Note also that we cannot guarantee there *will* be contentions
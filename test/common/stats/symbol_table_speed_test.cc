@@ -13,6 +13,7 @@
 #include "test/common/stats/make_elements_helper.h"
 #include "test/test_common/utility.h"
 
+#include "absl/strings/str_cat.h"
 #include "absl/synchronization/blocking_counter.h"
 #include "benchmark/benchmark.h"
 
@@ -63,6 +64,52 @@ static void bmCreateRace(benchmark::State& state) {
 }
 BENCHMARK(bmCreateRace)->Unit(::benchmark::kMillisecond);
 
+// Measures the contention of workers building dynamic stat names, like per-cluster
+// or per-route stats, whose symbols mostly exist already. The argument is the
+// number of threads.
+// NOLINTNEXTLINE(readability-identifier-naming)
+static void bmDynamicNameContention(benchmark::State& state) {
+  const int num_threads = state.range(0);
+  Envoy::Stats::SymbolTableImpl table;
+  std::vector<Envoy::Stats::StatNameStorage> clusters;
+  for (int i = 0; i < 16; ++i) {
+    clusters.emplace_back(absl::StrCat("cluster.dynamic_", i, ".upstream_rq_total"), table);
+  }
+
+  for (auto _ : state) {
+    UNREFERENCED_PARAMETER(_);
+    Envoy::Thread::ThreadFactory& thread_factory = Envoy::Thread::threadFactoryForTest();
+    std::vector<Envoy::Thread::ThreadPtr> threads;
+    threads.reserve(num_threads);
+    Envoy::ConditionalInitializer access;
+    for (int i = 0; i < num_threads; ++i) {
+      threads.push_back(thread_factory.createThread([&access, &table, i]() {
+        access.wait();
+        for (int count = 0; count < 10000; ++count) {
+          // NOLINTNEXTLINE(clang-analyzer-unix.Malloc)
+          Envoy::Stats::StatNameStorage name(
+              absl::StrCat("cluster.dynamic_", (i + count) % 16, ".upstream_rq_total"), table);
+          name.free(table);
+        }
+      }));
+    }
+    access.setReady();
+    for (auto& thread : threads) {
+      thread->join();
+    }
+  }
+
+  for (Envoy::Stats::StatNameStorage& cluster : clusters) {
+    cluster.free(table);
+  }
+}
+BENCHMARK(bmDynamicNameContention)
+    ->Arg(1)
+    ->Arg(8)
+    ->Arg(48)
+    ->Unit(::benchmark::kMillisecond)
+    ->UseRealTime();
+
 // NOLINTNEXTLINE(readability-identifier-naming)
 static void bmJoinStatNames(benchmark::State& state) {
   Envoy::Stats::SymbolTableImpl symbol_table;
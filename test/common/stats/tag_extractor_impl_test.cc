@@ -46,6 +46,48 @@ TEST(TagExtractorTest, RE2Variants) {
   EXPECT_EQ("cluster_name", tags.at(0).name_);
 }
 
+TEST(TagExtractorTest, RE2Prefilter) {
+  TagExtractorRe2Impl cluster_extractor("cluster_name", "^cluster\\.(([^\\.]+)\\.).*");
+  TagExtractorRe2Impl response_code_extractor("response_code", "_rq(_(\\d{3}))$");
+  TagExtractorRe2Prefilter prefilter;
+  cluster_extractor.addToPrefilter(prefilter);
+  response_code_extractor.addToPrefilter(prefilter);
+  prefilter.compile();
+
+  std::vector<int> matches;
+  EXPECT_TRUE(prefilter.match("cluster.test_cluster.upstream_rq_200", matches));
+  EXPECT_THAT(matches, ElementsAre(0, 1));
+  matches.clear();
+  EXPECT_TRUE(prefilter.match("http.test.downstream_rq_200", matches));
+  EXPECT_THAT(matches, ElementsAre(1));
+
+  // Only the extractors whose regex matches the name run their match.
+  std::string name = "cluster.test_cluster.upstream_cx_total";
+  TagVector tags;
+  IntervalSetImpl<size_t> remove_characters;
+  TagExtractionContext tag_extraction_context(name, &prefilter);
+  EXPECT_FALSE(response_code_extractor.extractTag(tag_extraction_context, tags, remove_characters));
+  EXPECT_FALSE(tag_extraction_context.re2MayMatch(1));
+  ASSERT_TRUE(cluster_extractor.extractTag(tag_extraction_context, tags, remove_characters));
+  EXPECT_EQ("cluster.upstream_cx_total", StringUtil::removeCharacters(name, remove_characters));
+  ASSERT_EQ(1, tags.size());
+  EXPECT_EQ("test_cluster", tags.at(0).value_);
+
+  // An extractor which is not part of a prefilter always runs.
+  EXPECT_TRUE(tag_extraction_context.re2MayMatch(-1));
+}
+
+TEST(TagExtractorTest, RE2PrefilterNotCompiled) {
+  TagExtractorRe2Prefilter prefilter;
+  EXPECT_EQ(0, prefilter.add("^cluster\\."));
+  std::vector<int> matches;
+  EXPECT_FALSE(prefilter.match("cluster.test_cluster.upstream_cx_total", matches));
+
+  // Without a prefilter match, every extractor runs.
+  TagExtractionContext tag_extraction_context("http.test.downstream_cx_total", &prefilter);
+  EXPECT_TRUE(tag_extraction_context.re2MayMatch(0));
+}
+
 TEST(TagExtractorTest, SingleSubexpression) {
   TagExtractorStdRegexImpl tag_extractor("listner_port", "^listener\\.(\\d+?\\.)");
   std::string name = "listener.80.downstream_cx_total";
@@ -36,6 +36,7 @@
 using testing::_;
 using testing::HasSubstr;
 using testing::InSequence;
+using testing::Invoke;
 using testing::NiceMock;
 using testing::Ref;
 using testing::Return;
@@ -606,6 +607,40 @@ TEST_F(StatsThreadLocalStoreTest, ScopeDelete) {
   tls_.shutdownThread();
 }
 
+// Test that the scopes released together, and their histograms, are cleared from the TLS caches in
+// one pass each.
+TEST_F(StatsThreadLocalStoreTest, ScopeDeleteBatchesHistograms) {
+  store_->initializeThreading(main_thread_dispatcher_, tls_);
+
+  ScopeSharedPtr scope1 = store_->createScope("scope1.");
+  ScopeSharedPtr scope2 = store_->createScope("scope2.");
+  scope1->histogramFromString("h", Histogram::Unit::Unspecified);
+  scope2->histogramFromString("h", Histogram::Unit::Unspecified);
+  EXPECT_EQ(2UL, store_->histograms().size());
+
+  std::vector<Event::PostCb> posts;
+  EXPECT_CALL(main_thread_dispatcher_, post(_))
+      .WillRepeatedly(Invoke([&posts](Event::PostCb cb) { posts.push_back(std::move(cb)); }));
+  scope1.reset();
+  scope2.reset();
+  ASSERT_EQ(1UL, posts.size());
+
+  // The scopes pass releases their histograms, which are cleared right after it. The post made by
+  // their release then has nothing left to clear.
+  EXPECT_CALL(tls_, runOnAllThreads(_, _));
+  EXPECT_CALL(tls_, runOnAllThreads(_));
+  Event::PostCb clear_scopes = std::move(posts[0]);
+  posts.clear();
+  clear_scopes();
+  EXPECT_EQ(0UL, store_->histograms().size());
+  ASSERT_EQ(1UL, posts.size());
+  posts[0]();
+
+  tls_.shutdownGlobalThreading();
+  store_->shutdownThreading();
+  tls_.shutdownThread();
+}
+
 TEST_F(StatsThreadLocalStoreTest, NestedScopes) {
   InSequence s;
   store_->initializeThreading(main_thread_dispatcher_, tls_);
@@ -1560,6 +1595,21 @@ TEST_F(StatsThreadLocalStoreTestNoFixture, MemoryWithTlsRealSymbolTable) {
   EXPECT_MEMORY_LE(memory_test.consumedBytes(), 0.99 * million_);
 }
 
+// Tests that the histograms which have no samples, or samples in a single bucket, don't allocate
+// the room for many buckets.
+TEST_F(StatsThreadLocalStoreTestNoFixture, MemoryHistogramsFewBuckets) {
+  initThreading();
+  Memory::TestUtil::MemoryTest memory_test;
+  for (uint32_t i = 0; i < 1000; ++i) {
+    Histogram& histogram =
+        scope_.histogramFromString(absl::StrCat("histogram.", i), Histogram::Unit::Milliseconds);
+    if (i % 2 == 0) {
+      histogram.recordValue(10);
+    }
+  }
+  EXPECT_MEMORY_LE(memory_test.consumedBytes(), 2 * million_);
+}
+
 TEST_F(StatsThreadLocalStoreTest, ShuttingDown) {
   InSequence s;
   store_->initializeThreading(main_thread_dispatcher_, tls_);
@@ -1819,6 +1869,34 @@ TEST_F(HistogramTest, ParentHistogramBucketSummaryAndDetail) {
   EXPECT_THAT(parent_histogram->detailedIntervalBuckets(), UnorderedElementsAre(Bucket{10, 1, 1}));
 }
 
+// The statistics of the intervals without samples are cleared once, while the cumulative
+// statistics are kept.
+TEST_F(HistogramTest, StatisticsOfIntervalsWithoutSamples) {
+  Histogram& histogram = scope_.histogramFromString("histogram", Histogram::Unit::Unspecified);
+  EXPECT_CALL(sink_, onHistogramComplete(Ref(histogram), 10)).Times(2);
+  histogram.recordValue(10);
+  histogram.recordValue(10);
+  store_->mergeHistograms([]() -> void {});
+  ASSERT_EQ(1, store_->histograms().size());
+  ParentHistogramSharedPtr parent_histogram = store_->histograms()[0];
+  EXPECT_EQ(2, parent_histogram->intervalStatistics().sampleCount());
+  EXPECT_EQ(2, parent_histogram->cumulativeStatistics().sampleCount());
+
+  for (int i = 0; i < 2; ++i) {
+    store_->mergeHistograms([]() -> void {});
+    EXPECT_EQ(0, parent_histogram->intervalStatistics().sampleCount());
+    EXPECT_EQ(2, parent_histogram->cumulativeStatistics().sampleCount());
+  }
+
+  // Statistics which were not accessed after a merge are still refreshed.
+  EXPECT_CALL(sink_, onHistogramComplete(Ref(histogram), 20));
+  histogram.recordValue(20);
+  store_->mergeHistograms([]() -> void {});
+  store_->mergeHistograms([]() -> void {});
+  EXPECT_EQ(0, parent_histogram->intervalStatistics().sampleCount());
+  EXPECT_EQ(3, parent_histogram->cumulativeStatistics().sampleCount());
+}
+
 TEST_F(HistogramTest, ForEachHistogram) {
   std::vector<std::reference_wrapper<Histogram>> histograms;
 
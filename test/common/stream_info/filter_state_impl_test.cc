@@ -454,5 +454,24 @@ TEST_F(FilterStateImplTest, SetSameDataWithDifferentLifeSpan) {
   EXPECT_EQ(2, filterState().getDataMutable<SimpleType>("test_2")->access());
 }
 
+TEST_F(FilterStateImplTest, LookupByKey) {
+  const FilterState::Key key_1("test_1");
+  const FilterState::Key key_2("test_2");
+  const FilterState::Key key_3("test_3");
+  filterState().setData("test_1", std::make_unique<SimpleType>(1), FilterState::StateType::ReadOnly,
+                        FilterState::LifeSpan::FilterChain);
+  filterState().setData(key_2.name(), std::make_unique<SimpleType>(2),
+                        FilterState::StateType::ReadOnly, FilterState::LifeSpan::Connection);
+
+  EXPECT_TRUE(filterState().hasDataWithName(key_1));
+  EXPECT_EQ(1, filterState().getDataReadOnly<SimpleType>(key_1)->access());
+  // The data of the parents is found by key as well.
+  EXPECT_TRUE(filterState().hasDataWithName(key_2));
+  EXPECT_EQ(2, filterState().getDataReadOnly<SimpleType>(key_2)->access());
+  EXPECT_FALSE(filterState().hasDataWithName(key_3));
+  EXPECT_EQ(nullptr, filterState().getDataReadOnlyGeneric(key_3));
+  EXPECT_EQ(nullptr, filterState().getDataReadOnly<TestStoredTypeTracking>(key_1));
+}
+
 } // namespace StreamInfo
 } // namespace Envoy
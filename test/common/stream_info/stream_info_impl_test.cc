@@ -39,13 +39,13 @@ std::chrono::nanoseconds checkDuration(std::chrono::nanoseconds last,
 
 class StreamInfoImplTest : public testing::Test {
 protected:
-  void assertStreamInfoSize(StreamInfoImpl stream_info) {
+  void assertStreamInfoSize(const StreamInfoImpl& stream_info) {
     ASSERT_TRUE(
-        sizeof(stream_info) == 840 || sizeof(stream_info) == 856 || sizeof(stream_info) == 888 ||
-        sizeof(stream_info) == 776 || sizeof(stream_info) == 728 || sizeof(stream_info) == 744 ||
-        sizeof(stream_info) == 680 || sizeof(stream_info) == 696 || sizeof(stream_info) == 688 ||
-        sizeof(stream_info) == 736 || sizeof(stream_info) == 728 || sizeof(stream_info) == 712 ||
-        sizeof(stream_info) == 704)
+        sizeof(stream_info) == 712 || sizeof(stream_info) == 728 || sizeof(stream_info) == 760 ||
+        sizeof(stream_info) == 648 || sizeof(stream_info) == 600 || sizeof(stream_info) == 616 ||
+        sizeof(stream_info) == 552 || sizeof(stream_info) == 568 || sizeof(stream_info) == 560 ||
+        sizeof(stream_info) == 608 || sizeof(stream_info) == 600 || sizeof(stream_info) == 584 ||
+        sizeof(stream_info) == 576)
         << "If adding fields to StreamInfoImpl, please check to see if you "
            "need to add them to setFromForRecreateStream or setFrom! Current size "
         << sizeof(stream_info);
@@ -0,0 +1,174 @@
+#include <string>
+
+#include "source/common/api/os_sys_calls_impl.h"
+#include "source/common/network/raw_buffer_socket.h"
+#include "source/common/tcp_proxy/splice_forwarder.h"
+
+#include "test/mocks/network/mocks.h"
+#include "test/mocks/network/transport_socket.h"
+#include "test/test_common/network_utility.h"
+#include "test/test_common/utility.h"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+using testing::_;
+using testing::AnyNumber;
+using testing::Invoke;
+using testing::NiceMock;
+
+namespace Envoy {
+namespace TcpProxy {
+namespace {
+
+class MockSpliceForwarderCallbacks : public SpliceForwarder::Callbacks {
+public:
+  MOCK_METHOD(void, onSplicedBytes, (SpliceForwarder::Direction direction, uint64_t bytes));
+  MOCK_METHOD(void, onSpliceDone, (SpliceForwarder::Direction direction));
+};
+
+// Splices between the proxy ends of two socket pairs, standing for the downstream and upstream
+// connections, and drives the peer ends.
+class SpliceForwarderTest : public testing::Test {
+protected:
+  SpliceForwarderTest()
+      : api_(Api::createApiForTest()), dispatcher_(api_->allocateDispatcher("test_thread")),
+        os_sys_calls_(Api::OsSysCallsSingleton::get()) {}
+
+  void SetUp() override {
+    if (!SpliceForwarder::isSupported()) {
+      GTEST_SKIP() << "splice is not supported on this platform";
+    }
+    for (os_fd_t* fds : {downstream_fds_, upstream_fds_}) {
+      ASSERT_EQ(0, os_sys_calls_.socketpair(AF_UNIX, SOCK_STREAM, 0, fds).return_value_);
+      ASSERT_EQ(0, os_sys_calls_.setsocketblocking(fds[0], false).return_value_);
+      ASSERT_EQ(0, os_sys_calls_.setsocketblocking(fds[1], false).return_value_);
+    }
+    EXPECT_CALL(callbacks_, onSplicedBytes(_, _))
+        .Times(AnyNumber())
+        .WillRepeatedly(Invoke([this](SpliceForwarder::Direction direction, uint64_t bytes) {
+          spliced_[static_cast<int>(direction)] += bytes;
+        }));
+    forwarder_ = SpliceForwarder::create(*dispatcher_, downstream_fds_[1], upstream_fds_[0],
+                                         callbacks_);
+    ASSERT_NE(nullptr, forwarder_);
+  }
+
+  void TearDown() override {
+    forwarder_.reset();
+    for (os_fd_t* fds : {downstream_fds_, upstream_fds_}) {
+      os_sys_calls_.close(fds[0]);
+      os_sys_calls_.close(fds[1]);
+    }
+  }
+
+  // The client is the peer of the downstream connection, the server the peer of the upstream one.
+  os_fd_t client() const { return downstream_fds_[0]; }
+  os_fd_t server() const { return upstream_fds_[1]; }
+
+  void write(os_fd_t fd, absl::string_view data) {
+    const Api::SysCallSizeResult result = os_sys_calls_.write(fd, data.data(), data.size());
+    ASSERT_EQ(static_cast<ssize_t>(data.size()), result.return_value_);
+  }
+
+  // Runs the dispatcher until the given number of bytes is read from fd.
+  std::string read(os_fd_t fd, size_t length) {
+    std::string data;
+    for (int i = 0; i < 1000 && data.size() < length; ++i) {
+      dispatcher_->run(Event::Dispatcher::RunType::NonBlock);
+      char buffer[16384];
+      const Api::SysCallSizeResult result = os_sys_calls_.recv(fd, buffer, sizeof(buffer), 0);
+      if (result.return_value_ > 0) {
+        data.append(buffer, result.return_value_);
+      }
+    }
+    return data;
+  }
+
+  uint64_t spliced(SpliceForwarder::Direction direction) const {
+    return spliced_[static_cast<int>(direction)];
+  }
+
+  Api::ApiPtr api_;
+  Event::DispatcherPtr dispatcher_;
+  Api::OsSysCalls& os_sys_calls_;
+  os_fd_t downstream_fds_[2];
+  os_fd_t upstream_fds_[2];
+  testing::StrictMock<MockSpliceForwarderCallbacks> callbacks_;
+  uint64_t spliced_[2]{};
+  SpliceForwarderPtr forwarder_;
+};
+
+TEST_F(SpliceForwarderTest, BothDirections) {
+  write(client(), "hello");
+  EXPECT_EQ("hello", read(server(), 5));
+  EXPECT_EQ(5, spliced(SpliceForwarder::Direction::DownstreamToUpstream));
+
+  write(server(), "world!");
+  EXPECT_EQ("world!", read(client(), 6));
+  EXPECT_EQ(6, spliced(SpliceForwarder::Direction::UpstreamToDownstream));
+
+  EXPECT_FALSE(forwarder_->done(SpliceForwarder::Direction::DownstreamToUpstream));
+  EXPECT_FALSE(forwarder_->done(SpliceForwarder::Direction::UpstreamToDownstream));
+}
+
+// More bytes than a pipe holds are moved while the destination is read.
+TEST_F(SpliceForwarderTest, LargeTransfer) {
+  const std::string data(256 * 1024, 'a');
+  std::string received;
+  size_t written = 0;
+  for (int i = 0; i < 1000 && received.size() < data.size(); ++i) {
+    if (written < data.size()) {
+      const Api::SysCallSizeResult result =
+          os_sys_calls_.write(client(), data.data() + written, data.size() - written);
+      if (result.return_value_ > 0) {
+        written += result.return_value_;
+      }
+    }
+    received += read(server(), 1);
+  }
+  EXPECT_EQ(data, received);
+  EXPECT_EQ(data.size(), spliced(SpliceForwarder::Direction::DownstreamToUpstream));
+}
+
+// The end of stream of a source ends its direction only, once its bytes are delivered.
+TEST_F(SpliceForwarderTest, EndOfStream) {
+  write(client(), "hello");
+  ASSERT_EQ(0, os_sys_calls_.shutdown(client(), SHUT_WR).return_value_);
+  EXPECT_CALL(callbacks_, onSpliceDone(SpliceForwarder::Direction::DownstreamToUpstream));
+  EXPECT_EQ("hello", read(server(), 5));
+  EXPECT_TRUE(forwarder_->done(SpliceForwarder::Direction::DownstreamToUpstream));
+
+  write(server(), "world");
+  EXPECT_EQ("world", read(client(), 5));
+  EXPECT_FALSE(forwarder_->done(SpliceForwarder::Direction::UpstreamToDownstream));
+}
+
+// Only the connections of the raw buffer transport socket can be spliced. The other transport
+// sockets, including the ones which aren't TLS (ALTS, PROXY protocol, HTTP/1.1 CONNECT), encrypt
+// the bytes or write their own.
+TEST(SpliceForwarderTransportTest, UsesRawBufferTransport) {
+  Api::ApiPtr api = Api::createApiForTest();
+  Event::DispatcherPtr dispatcher = api->allocateDispatcher("test_thread");
+  const Network::Address::InstanceConstSharedPtr address =
+      Network::Test::getCanonicalLoopbackAddress(Network::Address::IpVersion::v4);
+
+  Network::ClientConnectionPtr raw_buffer = dispatcher->createClientConnection(
+      address, nullptr, std::make_unique<Network::RawBufferSocket>(), nullptr, nullptr);
+  EXPECT_TRUE(SpliceForwarder::usesRawBufferTransport(*raw_buffer));
+  raw_buffer->close(Network::ConnectionCloseType::NoFlush);
+
+  // A transport socket without SSL connection info, as ALTS or PROXY protocol ones.
+  Network::ClientConnectionPtr other = dispatcher->createClientConnection(
+      address, nullptr, std::make_unique<NiceMock<Network::MockTransportSocket>>(), nullptr,
+      nullptr);
+  EXPECT_FALSE(SpliceForwarder::usesRawBufferTransport(*other));
+  other->close(Network::ConnectionCloseType::NoFlush);
+
+  NiceMock<Network::MockConnection> mock_connection;
+  EXPECT_FALSE(SpliceForwarder::usesRawBufferTransport(mock_connection));
+}
+
+} // namespace
+} // namespace TcpProxy
+} // namespace Envoy
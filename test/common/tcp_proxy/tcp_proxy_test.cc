@@ -199,6 +199,46 @@ TEST_P(TcpProxyTest, HalfCloseProxy) {
   upstream_callbacks_->onEvent(Network::ConnectionEvent::RemoteClose);
 }
 
+// Splicing requires the socket of the upstream connection, bytes are proxied as usual without it.
+TEST_P(TcpProxyTest, UseSpliceWithoutUpstreamSocket) {
+  envoy::extensions::filters::network::tcp_proxy::v3::TcpProxy config = defaultConfig();
+  config.set_use_splice(true);
+  setup(1, config);
+
+  raiseEventUpstreamConnected(0);
+  EXPECT_EQ(0U, config_->stats().downstream_cx_splice_total_.value());
+
+  Buffer::OwnedImpl buffer("hello");
+  EXPECT_CALL(*upstream_connections_.at(0), write(BufferEqual(&buffer), true));
+  filter_->onData(buffer, true);
+
+  Buffer::OwnedImpl response("world");
+  EXPECT_CALL(filter_callbacks_.connection_, write(BufferEqual(&response), true));
+  upstream_callbacks_->onUpstreamData(response, true);
+}
+
+// Splicing requires both connections to use the raw buffer transport socket. The bytes of the
+// other transport sockets, e.g. ALTS or PROXY protocol upstream ones, are proxied as usual even
+// though the upstream socket is known.
+TEST_P(TcpProxyTest, UseSpliceWithoutRawBufferTransport) {
+  envoy::extensions::filters::network::tcp_proxy::v3::TcpProxy config = defaultConfig();
+  config.set_use_splice(true);
+  setup(1, config);
+  NiceMock<Network::MockConnectionSocket> upstream_socket;
+  ON_CALL(*upstream_connection_data_.at(0), socket()).WillByDefault(Return(&upstream_socket));
+
+  raiseEventUpstreamConnected(0);
+  EXPECT_EQ(0U, config_->stats().downstream_cx_splice_total_.value());
+
+  Buffer::OwnedImpl buffer("hello");
+  EXPECT_CALL(*upstream_connections_.at(0), write(BufferEqual(&buffer), true));
+  filter_->onData(buffer, true);
+
+  Buffer::OwnedImpl response("world");
+  EXPECT_CALL(filter_callbacks_.connection_, write(BufferEqual(&response), true));
+  upstream_callbacks_->onUpstreamData(response, true);
+}
+
 // Test with an explicitly configured upstream.
 TEST_P(TcpProxyTest, ExplicitFactory) {
   // Explicitly configure an HTTP upstream, to test factory creation.
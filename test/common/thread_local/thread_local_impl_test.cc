@@ -297,6 +297,54 @@ TEST_F(ThreadLocalInstanceImplTest, RunOnAllThreads) {
   tls_.shutdownThread();
 }
 
+// Validate that the updates of a batch are delivered with a single post to each worker, and that
+// the completion callbacks are invoked once the workers ran them.
+TEST_F(ThreadLocalInstanceImplTest, BatchUpdates) {
+  TypedSlot<StringSlotObject> slot(tls_);
+  std::vector<std::string> updates;
+  bool batch_complete = false;
+  bool update_complete = false;
+
+  EXPECT_CALL(thread_dispatcher_, post(_)).Times(0);
+  ScopedBatch batch = tls_.batchUpdates([&]() {
+    EXPECT_EQ(3, updates.size());
+    EXPECT_TRUE(update_complete);
+    batch_complete = true;
+  });
+  slot.set([this, &updates](Event::Dispatcher& dispatcher) {
+    auto object = std::make_shared<StringSlotObject>();
+    object->str_ = "hello";
+    if (&dispatcher == &thread_dispatcher_) {
+      updates.push_back(object->str_);
+    }
+    return object;
+  });
+  {
+    // A nested batch is delivered with the outermost one.
+    ScopedBatch nested_batch = tls_.batchUpdates(nullptr);
+    slot.runOnAllThreads(
+        [&updates](OptRef<StringSlotObject> object) {
+          object->str_ = "goodbye";
+          updates.push_back(object->str_);
+        },
+        [&update_complete]() { update_complete = true; });
+  }
+  // The main thread ran its part of the updates right away.
+  EXPECT_EQ("goodbye", slot->str_);
+  EXPECT_EQ(1, updates.size());
+  EXPECT_FALSE(update_complete);
+  testing::Mock::VerifyAndClearExpectations(&thread_dispatcher_);
+
+  EXPECT_CALL(thread_dispatcher_, post(_));
+  EXPECT_CALL(main_dispatcher_, post(_));
+  batch.reset();
+  EXPECT_EQ((std::vector<std::string>{"goodbye", "hello", "goodbye"}), updates);
+  EXPECT_TRUE(batch_complete);
+
+  tls_.shutdownGlobalThreading();
+  tls_.shutdownThread();
+}
+
 // Validate ThreadLocal::InstanceImpl's dispatcher() behavior.
 TEST(ThreadLocalInstanceImplDispatcherTest, Dispatcher) {
   InstanceImpl tls;
@@ -0,0 +1,177 @@
+#include <array>
+#include <string>
+#include <vector>
+
+#include "envoy/common/exception.h"
+
+#include "source/common/tls/private_key/batched_private_key_method_provider.h"
+
+#include "test/mocks/event/mocks.h"
+#include "test/mocks/thread_local/mocks.h"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "openssl/ssl.h"
+
+using testing::ElementsAre;
+using testing::NiceMock;
+
+namespace Envoy {
+namespace Extensions {
+namespace TransportSockets {
+namespace Tls {
+namespace {
+
+class MockPrivateKeyConnectionCallbacks : public Ssl::PrivateKeyConnectionCallbacks {
+public:
+  MOCK_METHOD(void, onPrivateKeyMethodComplete, ());
+};
+
+// Signs with the reversed input, and fails the inputs starting with 'x'.
+class TestBatchedPrivateKeyMethodProvider : public BatchedPrivateKeyMethodProvider {
+public:
+  TestBatchedPrivateKeyMethodProvider(ThreadLocal::SlotAllocator& tls, uint32_t max_batch_size)
+      : BatchedPrivateKeyMethodProvider(tls, max_batch_size) {}
+
+  // Ssl::PrivateKeyMethodProvider
+  bool checkFips() override { return false; }
+  bool isAvailable() override { return true; }
+
+  // BatchedPrivateKeyMethodProvider
+  void signBatch(absl::Span<BatchedSignOperation* const> operations) override {
+    batch_sizes_.push_back(operations.size());
+    for (BatchedSignOperation* operation : operations) {
+      EXPECT_EQ(SSL_SIGN_ECDSA_SECP256R1_SHA256, operation->signature_algorithm_);
+      if (operation->input_.front() != 'x') {
+        operation->signature_.assign(operation->input_.rbegin(), operation->input_.rend());
+      }
+    }
+  }
+
+  std::vector<size_t> batch_sizes_;
+};
+
+class BatchedPrivateKeyMethodProviderTest : public testing::Test {
+public:
+  BatchedPrivateKeyMethodProviderTest()
+      : process_cb_(new NiceMock<Event::MockSchedulableCallback>(&tls_.dispatcher_)),
+        provider_(tls_, 2), method_(provider_.getBoringSslPrivateKeyMethod()),
+        ctx_(SSL_CTX_new(TLS_method())) {
+    for (size_t i = 0; i < ssl_.size(); ++i) {
+      ssl_[i].reset(SSL_new(ctx_.get()));
+      provider_.registerPrivateKeyMethod(ssl_[i].get(), cb_[i], tls_.dispatcher_);
+    }
+  }
+
+  ~BatchedPrivateKeyMethodProviderTest() override {
+    for (bssl::UniquePtr<SSL>& ssl : ssl_) {
+      provider_.unregisterPrivateKeyMethod(ssl.get());
+    }
+  }
+
+  ssl_private_key_result_t sign(SSL* ssl, const std::string& input) {
+    uint8_t out[16];
+    size_t out_len;
+    return method_->sign(ssl, out, &out_len, sizeof(out), SSL_SIGN_ECDSA_SECP256R1_SHA256,
+                         reinterpret_cast<const uint8_t*>(input.data()), input.size());
+  }
+
+  ssl_private_key_result_t complete(SSL* ssl, std::string& signature) {
+    uint8_t out[16];
+    size_t out_len = 0;
+    const ssl_private_key_result_t result = method_->complete(ssl, out, &out_len, sizeof(out));
+    signature.assign(reinterpret_cast<const char*>(out), out_len);
+    return result;
+  }
+
+  NiceMock<ThreadLocal::MockInstance> tls_;
+  NiceMock<Event::MockSchedulableCallback>* process_cb_;
+  TestBatchedPrivateKeyMethodProvider provider_;
+  Ssl::BoringSslPrivateKeyMethodSharedPtr method_;
+  bssl::UniquePtr<SSL_CTX> ctx_;
+  std::array<bssl::UniquePtr<SSL>, 3> ssl_;
+  std::array<MockPrivateKeyConnectionCallbacks, 3> cb_;
+};
+
+TEST_F(BatchedPrivateKeyMethodProviderTest, SignsOperationsOfIterationInBatches) {
+  EXPECT_EQ(ssl_private_key_retry, sign(ssl_[0].get(), "abc"));
+  EXPECT_TRUE(process_cb_->enabled());
+  EXPECT_EQ(ssl_private_key_retry, sign(ssl_[1].get(), "def"));
+  EXPECT_EQ(ssl_private_key_retry, sign(ssl_[2].get(), "ghi"));
+
+  // The handshakes are not resumed before the batches are processed.
+  std::string signature;
+  EXPECT_EQ(ssl_private_key_retry, complete(ssl_[0].get(), signature));
+
+  const std::vector<std::string> expected_signatures{"cba", "fed", "ihg"};
+  for (size_t i = 0; i < cb_.size(); ++i) {
+    EXPECT_CALL(cb_[i], onPrivateKeyMethodComplete()).WillOnce([&, i]() {
+      std::string signature;
+      EXPECT_EQ(ssl_private_key_success, complete(ssl_[i].get(), signature));
+      EXPECT_EQ(expected_signatures[i], signature);
+    });
+  }
+  process_cb_->invokeCallback();
+  EXPECT_THAT(provider_.batch_sizes_, ElementsAre(2, 1));
+
+  // The operations have been completed.
+  EXPECT_EQ(ssl_private_key_failure, complete(ssl_[0].get(), signature));
+}
+
+TEST_F(BatchedPrivateKeyMethodProviderTest, FailedSignature) {
+  EXPECT_EQ(ssl_private_key_retry, sign(ssl_[0].get(), "xyz"));
+  EXPECT_CALL(cb_[0], onPrivateKeyMethodComplete()).WillOnce([this]() {
+    std::string signature;
+    EXPECT_EQ(ssl_private_key_failure, complete(ssl_[0].get(), signature));
+  });
+  process_cb_->invokeCallback();
+}
+
+TEST_F(BatchedPrivateKeyMethodProviderTest, UnregisteredWhilePending) {
+  EXPECT_EQ(ssl_private_key_retry, sign(ssl_[0].get(), "abc"));
+  EXPECT_EQ(ssl_private_key_retry, sign(ssl_[1].get(), "def"));
+  provider_.unregisterPrivateKeyMethod(ssl_[0].get());
+
+  EXPECT_CALL(cb_[0], onPrivateKeyMethodComplete()).Times(0);
+  EXPECT_CALL(cb_[1], onPrivateKeyMethodComplete());
+  process_cb_->invokeCallback();
+  EXPECT_THAT(provider_.batch_sizes_, ElementsAre(1));
+}
+
+TEST_F(BatchedPrivateKeyMethodProviderTest, UnregisteredWhileResumingAnotherHandshake) {
+  EXPECT_EQ(ssl_private_key_retry, sign(ssl_[0].get(), "abc"));
+  EXPECT_EQ(ssl_private_key_retry, sign(ssl_[1].get(), "def"));
+
+  EXPECT_CALL(cb_[0], onPrivateKeyMethodComplete()).WillOnce([this]() {
+    provider_.unregisterPrivateKeyMethod(ssl_[1].get());
+  });
+  EXPECT_CALL(cb_[1], onPrivateKeyMethodComplete()).Times(0);
+  process_cb_->invokeCallback();
+}
+
+TEST_F(BatchedPrivateKeyMethodProviderTest, SignTwiceFails) {
+  EXPECT_EQ(ssl_private_key_retry, sign(ssl_[0].get(), "abc"));
+  EXPECT_EQ(ssl_private_key_failure, sign(ssl_[0].get(), "abc"));
+  EXPECT_CALL(cb_[0], onPrivateKeyMethodComplete());
+  process_cb_->invokeCallback();
+  EXPECT_THAT(provider_.batch_sizes_, ElementsAre(1));
+}
+
+TEST_F(BatchedPrivateKeyMethodProviderTest, DecryptFails) {
+  uint8_t out[16];
+  size_t out_len;
+  const uint8_t in[16] = {};
+  EXPECT_EQ(ssl_private_key_failure,
+            method_->decrypt(ssl_[0].get(), out, &out_len, sizeof(out), in, sizeof(in)));
+}
+
+TEST_F(BatchedPrivateKeyMethodProviderTest, RegisterTwiceThrows) {
+  EXPECT_THROW(provider_.registerPrivateKeyMethod(ssl_[0].get(), cb_[0], tls_.dispatcher_),
+               EnvoyException);
+}
+
+} // namespace
+} // namespace Tls
+} // namespace TransportSockets
+} // namespace Extensions
+} // namespace Envoy
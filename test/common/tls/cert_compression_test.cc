@@ -0,0 +1,156 @@
+#include <string>
+
+#include "source/common/tls/cert_compression.h"
+
+#include "test/test_common/environment.h"
+#include "test/test_common/test_runtime.h"
+
+#include "absl/strings/str_cat.h"
+#include "absl/types/optional.h"
+#include "gtest/gtest.h"
+#include "openssl/bytestring.h"
+#include "openssl/pool.h"
+#include "openssl/ssl.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace TransportSockets {
+namespace Tls {
+namespace {
+
+constexpr uint16_t BrotliAlgorithmId = 2;
+
+class CertCompressionTest : public testing::Test {
+public:
+  CertCompressionTest() : ctx_(SSL_CTX_new(TLS_method())), ssl_(SSL_new(ctx_.get())) {}
+
+  using Compress = int (*)(SSL*, CBB*, const uint8_t*, size_t);
+  using Decompress = int (*)(SSL*, CRYPTO_BUFFER**, size_t, const uint8_t*, size_t);
+
+  std::string compress(Compress compress, const std::string& in) {
+    bssl::ScopedCBB cbb;
+    EXPECT_EQ(1, CBB_init(cbb.get(), 0));
+    EXPECT_EQ(1, compress(ssl_.get(), cbb.get(), reinterpret_cast<const uint8_t*>(in.data()),
+                          in.size()));
+    return {reinterpret_cast<const char*>(CBB_data(cbb.get())), CBB_len(cbb.get())};
+  }
+
+  // Returns the decompressed data, or nullopt if the decompression failed.
+  absl::optional<std::string> decompress(Decompress decompress, size_t uncompressed_len,
+                                         const std::string& in) {
+    CRYPTO_BUFFER* out = nullptr;
+    if (decompress(ssl_.get(), &out, uncompressed_len,
+                   reinterpret_cast<const uint8_t*>(in.data()), in.size()) != 1) {
+      return absl::nullopt;
+    }
+    bssl::UniquePtr<CRYPTO_BUFFER> buffer(out);
+    return std::string(reinterpret_cast<const char*>(CRYPTO_BUFFER_data(out)),
+                       CRYPTO_BUFFER_len(out));
+  }
+
+  // Completes a TLS 1.3 handshake in memory, with a client which only supports the brotli
+  // compression, and returns the number of certificate messages it decompressed.
+  int handshake() {
+    bssl::UniquePtr<SSL_CTX> client_ctx(SSL_CTX_new(TLS_method()));
+    EXPECT_EQ(1, SSL_CTX_add_cert_compression_alg(
+                     client_ctx.get(), BrotliAlgorithmId, nullptr,
+                     [](SSL* ssl, CRYPTO_BUFFER** out, size_t uncompressed_len, const uint8_t* in,
+                        size_t in_len) {
+                       ++decompressions_;
+                       return CertCompression::decompressBrotli(ssl, out, uncompressed_len, in,
+                                                                in_len);
+                     }));
+    const std::string cert = TestEnvironment::readFileToStringForTest(TestEnvironment::substitute(
+        "{{ test_rundir }}/test/common/tls/test_data/unittest_cert.pem"));
+    const std::string key = TestEnvironment::readFileToStringForTest(TestEnvironment::substitute(
+        "{{ test_rundir }}/test/common/tls/test_data/unittest_key.pem"));
+    bssl::UniquePtr<BIO> cert_bio(BIO_new_mem_buf(cert.data(), cert.size()));
+    bssl::UniquePtr<X509> x509(PEM_read_bio_X509(cert_bio.get(), nullptr, nullptr, nullptr));
+    bssl::UniquePtr<BIO> key_bio(BIO_new_mem_buf(key.data(), key.size()));
+    bssl::UniquePtr<EVP_PKEY> pkey(
+        PEM_read_bio_PrivateKey(key_bio.get(), nullptr, nullptr, nullptr));
+    EXPECT_EQ(1, SSL_CTX_use_certificate(ctx_.get(), x509.get()));
+    EXPECT_EQ(1, SSL_CTX_use_PrivateKey(ctx_.get(), pkey.get()));
+    for (SSL_CTX* ctx : {ctx_.get(), client_ctx.get()}) {
+      EXPECT_EQ(1, SSL_CTX_set_min_proto_version(ctx, TLS1_3_VERSION));
+    }
+
+    bssl::UniquePtr<SSL> server(SSL_new(ctx_.get()));
+    bssl::UniquePtr<SSL> client(SSL_new(client_ctx.get()));
+    BIO* server_bio;
+    BIO* client_bio;
+    EXPECT_EQ(1, BIO_new_bio_pair(&server_bio, 0, &client_bio, 0));
+    SSL_set_bio(server.get(), server_bio, server_bio);
+    SSL_set_bio(client.get(), client_bio, client_bio);
+    SSL_set_accept_state(server.get());
+    SSL_set_connect_state(client.get());
+
+    decompressions_ = 0;
+    bool server_done = false;
+    bool client_done = false;
+    for (int i = 0; i < 10 && !(server_done && client_done); ++i) {
+      client_done = client_done || SSL_do_handshake(client.get()) == 1;
+      server_done = server_done || SSL_do_handshake(server.get()) == 1;
+    }
+    EXPECT_TRUE(server_done && client_done);
+    return decompressions_;
+  }
+
+  static int decompressions_;
+  bssl::UniquePtr<SSL_CTX> ctx_;
+  bssl::UniquePtr<SSL> ssl_;
+};
+
+int CertCompressionTest::decompressions_ = 0;
+
+TEST_F(CertCompressionTest, RoundTrip) {
+  CertCompression::registerAlgorithms(ctx_.get());
+  std::string certificate;
+  for (int i = 0; i < 100; ++i) {
+    certificate += "certificate ";
+  }
+  for (const auto& [compress_fn, decompress_fn] :
+       {std::make_pair(&CertCompression::compressBrotli, &CertCompression::decompressBrotli),
+        std::make_pair(&CertCompression::compressZlib, &CertCompression::decompressZlib)}) {
+    const std::string compressed = compress(compress_fn, certificate);
+    EXPECT_LT(compressed.size(), certificate.size());
+    // The second compression comes from the cache of the context.
+    EXPECT_EQ(compressed, compress(compress_fn, certificate));
+    EXPECT_EQ(certificate, decompress(decompress_fn, certificate.size(), compressed));
+
+    // The decompressed data must have the announced length.
+    EXPECT_EQ(absl::nullopt, decompress(decompress_fn, certificate.size() - 1, compressed));
+    EXPECT_EQ(absl::nullopt, decompress(decompress_fn, certificate.size() + 1, compressed));
+    EXPECT_EQ(absl::nullopt, decompress(decompress_fn, certificate.size(), "not compressed"));
+  }
+}
+
+// Test that the different messages of a context are cached apart.
+TEST_F(CertCompressionTest, CachesEachMessage) {
+  CertCompression::registerAlgorithms(ctx_.get());
+  for (int i = 0; i < 40; ++i) {
+    const std::string certificate = absl::StrCat("certificate ", i);
+    EXPECT_EQ(certificate,
+              decompress(&CertCompression::decompressZlib, certificate.size(),
+                         compress(&CertCompression::compressZlib, certificate)));
+  }
+}
+
+TEST_F(CertCompressionTest, Handshake) {
+  CertCompression::registerAlgorithms(ctx_.get());
+  EXPECT_EQ(1, handshake());
+}
+
+TEST_F(CertCompressionTest, Disabled) {
+  TestScopedRuntime scoped_runtime;
+  scoped_runtime.mergeValues({{"envoy.reloadable_features.tls_certificate_compression", "false"}});
+  CertCompression::registerAlgorithms(ctx_.get());
+  // The server sends its certificate uncompressed.
+  EXPECT_EQ(0, handshake());
+}
+
+} // namespace
+} // namespace Tls
+} // namespace TransportSockets
+} // namespace Extensions
+} // namespace Envoy
@@ -668,6 +668,52 @@ TEST(DefaultCertValidatorTest, WithVerifyDepth) {
   EXPECT_EQ(X509_STORE_CTX_get_error(store_ctx.get()), X509_V_OK);
 }
 
+TEST(DefaultCertValidatorTest, VerifiedChainCache) {
+  NiceMock<Server::Configuration::MockServerFactoryContext> context;
+  Stats::TestUtil::TestStore test_store;
+  SslStats stats = generateSslStats(*test_store.rootScope());
+  envoy::config::core::v3::TypedExtensionConfig typed_conf;
+  TestCertificateValidationContextConfig test_config(
+      typed_conf, false, {},
+      TestEnvironment::readFileToStringForTest(
+          TestEnvironment::substitute("{{ test_rundir }}/test/common/tls/test_data/ca_cert.pem")),
+      absl::nullopt, 1);
+  DefaultCertValidator default_validator(&test_config, stats, context);
+  SSLContextPtr ssl_ctx = SSL_CTX_new(TLS_method());
+  ASSERT_TRUE(default_validator.initializeSslContexts({ssl_ctx.get()}, false).ok());
+
+  auto verify = [&](const std::string& cert_file) {
+    bssl::UniquePtr<STACK_OF(X509)> cert_chain(sk_X509_new_null());
+    EXPECT_TRUE(bssl::PushToStack(
+        cert_chain.get(), readCertFromFile(TestEnvironment::substitute(
+                              "{{ test_rundir }}/test/common/tls/test_data/" + cert_file))));
+    return default_validator
+        .doVerifyCertChain(*cert_chain, /*callback=*/nullptr,
+                           /*transport_socket_options=*/nullptr, *ssl_ctx, {}, true, "")
+        .status;
+  };
+
+  // The second verification of a chain is a hit.
+  EXPECT_EQ(ValidationResults::ValidationStatus::Successful, verify("san_dns_cert.pem"));
+  EXPECT_EQ(ValidationResults::ValidationStatus::Successful, verify("san_dns_cert.pem"));
+  EXPECT_EQ(1, stats.verified_chain_cache_miss_.value());
+  EXPECT_EQ(1, stats.verified_chain_cache_hit_.value());
+
+  // Another chain evicts it.
+  EXPECT_EQ(ValidationResults::ValidationStatus::Successful, verify("san_uri_cert.pem"));
+  EXPECT_EQ(1, stats.verified_chain_cache_evicted_.value());
+  EXPECT_EQ(ValidationResults::ValidationStatus::Successful, verify("san_dns_cert.pem"));
+  EXPECT_EQ(3, stats.verified_chain_cache_miss_.value());
+  EXPECT_EQ(2, stats.verified_chain_cache_evicted_.value());
+
+  // The chains failing verification aren't cached.
+  EXPECT_EQ(ValidationResults::ValidationStatus::Failed, verify("expired_san_uri_cert.pem"));
+  EXPECT_EQ(ValidationResults::ValidationStatus::Failed, verify("expired_san_uri_cert.pem"));
+  EXPECT_EQ(5, stats.verified_chain_cache_miss_.value());
+  EXPECT_EQ(2, stats.fail_verify_error_.value());
+  EXPECT_EQ(1, stats.verified_chain_cache_hit_.value());
+}
+
 class MockCertificateValidationContextConfig : public Ssl::CertificateValidationContextConfig {
 public:
   MockCertificateValidationContextConfig() : MockCertificateValidationContextConfig("") {}
@@ -698,6 +744,7 @@ public:
   MOCK_METHOD(Api::Api&, api, (), (const override));
   bool onlyVerifyLeafCertificateCrl() const override { return false; }
   absl::optional<uint32_t> maxVerifyDepth() const override { return absl::nullopt; }
+  uint32_t verifiedChainCacheSize() const override { return 0; }
 
 private:
   std::string s_;
@@ -47,10 +47,11 @@ public:
       bool allow_expired_certificate = false,
       std::vector<envoy::extensions::transport_sockets::tls::v3::SubjectAltNameMatcher>
           san_matchers = {},
-      std::string ca_cert = "", absl::optional<uint32_t> verify_depth = absl::nullopt)
+      std::string ca_cert = "", absl::optional<uint32_t> verify_depth = absl::nullopt,
+      uint32_t verified_chain_cache_size = 0)
       : allow_expired_certificate_(allow_expired_certificate), api_(Api::createApiForTest()),
         custom_validator_config_(custom_config), san_matchers_(san_matchers), ca_cert_(ca_cert),
-        max_verify_depth_(verify_depth){};
+        max_verify_depth_(verify_depth), verified_chain_cache_size_(verified_chain_cache_size){};
   TestCertificateValidationContextConfig()
       : api_(Api::createApiForTest()), custom_validator_config_(absl::nullopt){};
 
@@ -90,6 +91,7 @@ public:
   bool onlyVerifyLeafCertificateCrl() const override { return false; }
 
   absl::optional<uint32_t> maxVerifyDepth() const override { return max_verify_depth_; }
+  uint32_t verifiedChainCacheSize() const override { return verified_chain_cache_size_; }
 
 private:
   bool allow_expired_certificate_{false};
@@ -100,6 +102,7 @@ private:
   const std::string ca_cert_;
   const std::string ca_cert_path_{"TEST_CA_CERT_PATH"};
   const absl::optional<uint32_t> max_verify_depth_{absl::nullopt};
+  const uint32_t verified_chain_cache_size_{0};
 };
 
 } // namespace Tls
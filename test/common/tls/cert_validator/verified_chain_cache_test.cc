@@ -0,0 +1,67 @@
+#include <chrono>
+
+#include "source/common/tls/cert_validator/verified_chain_cache.h"
+
+#include "test/common/stats/stat_test_utility.h"
+#include "test/test_common/simulated_time_system.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace TransportSockets {
+namespace Tls {
+namespace {
+
+class VerifiedChainCacheTest : public Event::TestUsingSimulatedTime, public testing::Test {
+protected:
+  static VerifiedChainCache::Key key(uint8_t i) {
+    VerifiedChainCache::Key key{};
+    key[0] = i;
+    return key;
+  }
+
+  SystemTime inOneHour() { return simTime().systemTime() + std::chrono::hours(1); }
+
+  Stats::TestUtil::TestStore store_;
+  SslStats stats_{generateSslStats(*store_.rootScope())};
+  VerifiedChainCache cache_{2, stats_, simTime()};
+};
+
+TEST_F(VerifiedChainCacheTest, EvictsLeastRecentlyUsed) {
+  cache_.insert(key(1), inOneHour());
+  cache_.insert(key(2), inOneHour());
+  EXPECT_TRUE(cache_.lookup(key(1)));
+  cache_.insert(key(3), inOneHour());
+  EXPECT_EQ(2, cache_.size());
+  EXPECT_EQ(1, stats_.verified_chain_cache_evicted_.value());
+
+  EXPECT_TRUE(cache_.lookup(key(1)));
+  EXPECT_FALSE(cache_.lookup(key(2)));
+  EXPECT_TRUE(cache_.lookup(key(3)));
+  EXPECT_EQ(3, stats_.verified_chain_cache_hit_.value());
+  EXPECT_EQ(1, stats_.verified_chain_cache_miss_.value());
+}
+
+TEST_F(VerifiedChainCacheTest, Expiration) {
+  cache_.insert(key(1), inOneHour());
+  // The chains which already expired aren't inserted.
+  cache_.insert(key(2), simTime().systemTime());
+  EXPECT_EQ(1, cache_.size());
+
+  simTime().advanceTimeWait(std::chrono::minutes(59));
+  EXPECT_TRUE(cache_.lookup(key(1)));
+  simTime().advanceTimeWait(std::chrono::minutes(1));
+  EXPECT_FALSE(cache_.lookup(key(1)));
+  EXPECT_EQ(0, cache_.size());
+
+  // Verifying the chain again renews it.
+  cache_.insert(key(1), inOneHour());
+  EXPECT_TRUE(cache_.lookup(key(1)));
+}
+
+} // namespace
+} // namespace Tls
+} // namespace TransportSockets
+} // namespace Extensions
+} // namespace Envoy
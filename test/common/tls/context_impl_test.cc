@@ -29,6 +29,7 @@
 #include "test/test_common/simulated_time_system.h"
 #include "test/test_common/utility.h"
 
+#include "absl/strings/str_replace.h"
 #include "gtest/gtest.h"
 #include "openssl/x509v3.h"
 
@@ -464,6 +465,73 @@ TEST_F(SslContextImplTest, TestNoCert) {
   EXPECT_TRUE(context->getCertChainInformation().empty());
 }
 
+// Identical server contexts are only created once per stats scope and server names.
+TEST_F(SslContextImplTest, SharedServerContexts) {
+  const std::string yaml = R"EOF(
+  common_tls_context:
+    tls_certificates:
+      certificate_chain:
+        filename: "{{ test_rundir }}/test/common/tls/test_data/{{ cert }}_cert.pem"
+      private_key:
+        filename: "{{ test_rundir }}/test/common/tls/test_data/{{ cert }}_key.pem"
+)EOF";
+  auto create_config = [&](const std::string& cert) {
+    envoy::extensions::transport_sockets::tls::v3::DownstreamTlsContext tls_context;
+    TestUtility::loadFromYaml(
+        TestEnvironment::substitute(absl::StrReplaceAll(yaml, {{"{{ cert }}", cert}})),
+        tls_context);
+    return *ServerContextConfigImpl::create(tls_context, factory_context_);
+  };
+  auto create_context = [&](Stats::Scope& scope, const ServerContextConfigImpl& config,
+                            const std::vector<std::string>& server_names) {
+    return THROW_OR_RETURN_VALUE(
+        manager_.createSslServerContext(scope, config, server_names, nullptr),
+        Ssl::ServerContextSharedPtr);
+  };
+  auto count_contexts = [&]() {
+    int count = 0;
+    manager_.iterateContexts([&count](const Envoy::Ssl::Context&) { ++count; });
+    return count;
+  };
+
+  auto config = create_config("san_dns");
+  auto same_config = create_config("san_dns");
+  auto other_config = create_config("san_uri");
+  ASSERT_TRUE(config->contextHash().has_value());
+  EXPECT_EQ(config->contextHash(), same_config->contextHash());
+  EXPECT_NE(config->contextHash(), other_config->contextHash());
+
+  Stats::ScopeSharedPtr other_scope = store_.createScope("other.");
+  Ssl::ServerContextSharedPtr context = create_context(*store_.rootScope(), *config, {});
+  Ssl::ServerContextSharedPtr shared_context =
+      create_context(*store_.rootScope(), *same_config, {});
+  EXPECT_EQ(context, shared_context);
+  Ssl::ServerContextSharedPtr contexts[] = {
+      create_context(*store_.rootScope(), *other_config, {}),
+      create_context(*store_.rootScope(), *config, {"example.com"}),
+      create_context(*other_scope, *config, {}),
+  };
+  for (const Ssl::ServerContextSharedPtr& other_context : contexts) {
+    EXPECT_NE(context, other_context);
+  }
+  EXPECT_EQ(4, count_contexts());
+
+  // The shared context remains until removed by each of its creators.
+  manager_.removeContext(context);
+  EXPECT_EQ(4, count_contexts());
+  EXPECT_EQ(shared_context, create_context(*store_.rootScope(), *config, {}));
+  manager_.removeContext(shared_context);
+  manager_.removeContext(shared_context);
+  EXPECT_EQ(3, count_contexts());
+  Ssl::ServerContextSharedPtr new_context = create_context(*store_.rootScope(), *config, {});
+  EXPECT_NE(shared_context, new_context);
+  manager_.removeContext(new_context);
+  for (const Ssl::ServerContextSharedPtr& other_context : contexts) {
+    manager_.removeContext(other_context);
+  }
+  EXPECT_EQ(0, count_contexts());
+}
+
 // Multiple RSA certificates with the same exact DNS SAN are allowed.
 TEST_F(SslContextImplTest, DuplicateRsaCertSameExactDNSSan) {
   envoy::extensions::transport_sockets::tls::v3::DownstreamTlsContext tls_context;
@@ -0,0 +1,150 @@
+#include <string>
+#include <vector>
+
+#include "source/common/tls/kernel_tls.h"
+
+#include "test/mocks/network/io_handle.h"
+#include "test/test_common/environment.h"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "openssl/ssl.h"
+
+#if defined(__linux__)
+#include <linux/tls.h>
+#endif
+
+using testing::_;
+using testing::Return;
+
+namespace Envoy {
+namespace Extensions {
+namespace TransportSockets {
+namespace Tls {
+namespace {
+
+class KernelTlsTest : public testing::Test {
+public:
+  // Completes a TLS handshake between a client and a server in memory.
+  void handshake(uint16_t version, const char* cipher_list) {
+    server_ctx_.reset(SSL_CTX_new(TLS_method()));
+    const std::string cert = TestEnvironment::readFileToStringForTest(TestEnvironment::substitute(
+        "{{ test_rundir }}/test/common/tls/test_data/unittest_cert.pem"));
+    const std::string key = TestEnvironment::readFileToStringForTest(TestEnvironment::substitute(
+        "{{ test_rundir }}/test/common/tls/test_data/unittest_key.pem"));
+    bssl::UniquePtr<BIO> cert_bio(BIO_new_mem_buf(cert.data(), cert.size()));
+    bssl::UniquePtr<X509> x509(PEM_read_bio_X509(cert_bio.get(), nullptr, nullptr, nullptr));
+    bssl::UniquePtr<BIO> key_bio(BIO_new_mem_buf(key.data(), key.size()));
+    bssl::UniquePtr<EVP_PKEY> pkey(
+        PEM_read_bio_PrivateKey(key_bio.get(), nullptr, nullptr, nullptr));
+    ASSERT_EQ(1, SSL_CTX_use_certificate(server_ctx_.get(), x509.get()));
+    ASSERT_EQ(1, SSL_CTX_use_PrivateKey(server_ctx_.get(), pkey.get()));
+    client_ctx_.reset(SSL_CTX_new(TLS_method()));
+    for (SSL_CTX* ctx : {server_ctx_.get(), client_ctx_.get()}) {
+      ASSERT_EQ(1, SSL_CTX_set_min_proto_version(ctx, version));
+      ASSERT_EQ(1, SSL_CTX_set_max_proto_version(ctx, version));
+      ASSERT_EQ(1, SSL_CTX_set_strict_cipher_list(ctx, cipher_list));
+    }
+
+    server_.reset(SSL_new(server_ctx_.get()));
+    client_.reset(SSL_new(client_ctx_.get()));
+    BIO* server_bio;
+    BIO* client_bio;
+    ASSERT_EQ(1, BIO_new_bio_pair(&server_bio, 0, &client_bio, 0));
+    SSL_set_bio(server_.get(), server_bio, server_bio);
+    SSL_set_bio(client_.get(), client_bio, client_bio);
+    SSL_set_accept_state(server_.get());
+    SSL_set_connect_state(client_.get());
+
+    bool server_done = false;
+    bool client_done = false;
+    for (int i = 0; i < 10 && !(server_done && client_done); ++i) {
+      client_done = client_done || SSL_do_handshake(client_.get()) == 1;
+      server_done = server_done || SSL_do_handshake(server_.get()) == 1;
+    }
+    ASSERT_TRUE(server_done && client_done);
+  }
+
+  std::vector<uint8_t> keyBlock(SSL* ssl) {
+    std::vector<uint8_t> key_block(SSL_get_key_block_len(ssl));
+    EXPECT_EQ(1, SSL_generate_key_block(ssl, key_block.data(), key_block.size()));
+    return key_block;
+  }
+
+  bssl::UniquePtr<SSL_CTX> server_ctx_;
+  bssl::UniquePtr<SSL_CTX> client_ctx_;
+  bssl::UniquePtr<SSL> server_;
+  bssl::UniquePtr<SSL> client_;
+  Network::MockIoHandle io_handle_;
+};
+
+#if defined(__linux__) && defined(TLS_TX) && defined(TLS_CIPHER_CHACHA20_POLY1305)
+TEST_F(KernelTlsTest, EnableTxAesGcm) {
+  handshake(TLS1_2_VERSION, "ECDHE-RSA-AES128-GCM-SHA256");
+  // The client derives the same key block, with the server write key after its own.
+  const std::vector<uint8_t> key_block = keyBlock(client_.get());
+  ASSERT_EQ(2 * (16 + 4), key_block.size());
+
+  EXPECT_CALL(io_handle_, setOption(IPPROTO_TCP, TCP_ULP, _, _))
+      .WillOnce(Return(Api::SysCallIntResult{0, 0}));
+  EXPECT_CALL(io_handle_, setOption(SOL_TLS, TLS_TX, _, sizeof(tls12_crypto_info_aes_gcm_128)))
+      .WillOnce([&](int, int, const void* optval, socklen_t) {
+        const auto* crypto_info = static_cast<const tls12_crypto_info_aes_gcm_128*>(optval);
+        EXPECT_EQ(TLS_1_2_VERSION, crypto_info->info.version);
+        EXPECT_EQ(TLS_CIPHER_AES_GCM_128, crypto_info->info.cipher_type);
+        EXPECT_EQ(0, memcmp(crypto_info->key, key_block.data() + 16, 16));
+        EXPECT_EQ(0, memcmp(crypto_info->salt, key_block.data() + 2 * 16 + 4, 4));
+        // The server sent its Finished message as the first record with these keys.
+        const uint8_t sequence[8] = {0, 0, 0, 0, 0, 0, 0, 1};
+        EXPECT_EQ(0, memcmp(crypto_info->rec_seq, sequence, sizeof(sequence)));
+        EXPECT_EQ(0, memcmp(crypto_info->iv, sequence, sizeof(sequence)));
+        return Api::SysCallIntResult{0, 0};
+      });
+  EXPECT_TRUE(KernelTls::enableTx(server_.get(), io_handle_));
+}
+
+TEST_F(KernelTlsTest, EnableTxChaCha20Poly1305) {
+  handshake(TLS1_2_VERSION, "ECDHE-RSA-CHACHA20-POLY1305");
+  const std::vector<uint8_t> key_block = keyBlock(server_.get());
+  ASSERT_EQ(2 * (32 + 12), key_block.size());
+
+  EXPECT_CALL(io_handle_, setOption(IPPROTO_TCP, TCP_ULP, _, _))
+      .WillOnce(Return(Api::SysCallIntResult{0, 0}));
+  EXPECT_CALL(io_handle_,
+              setOption(SOL_TLS, TLS_TX, _, sizeof(tls12_crypto_info_chacha20_poly1305)))
+      .WillOnce([&](int, int, const void* optval, socklen_t) {
+        const auto* crypto_info = static_cast<const tls12_crypto_info_chacha20_poly1305*>(optval);
+        EXPECT_EQ(TLS_CIPHER_CHACHA20_POLY1305, crypto_info->info.cipher_type);
+        // The client write key and IV.
+        EXPECT_EQ(0, memcmp(crypto_info->key, key_block.data(), 32));
+        EXPECT_EQ(0, memcmp(crypto_info->iv, key_block.data() + 2 * 32, 12));
+        return Api::SysCallIntResult{0, 0};
+      });
+  EXPECT_TRUE(KernelTls::enableTx(client_.get(), io_handle_));
+}
+
+TEST_F(KernelTlsTest, EnableTxFailsWithoutUpperLayerProtocol) {
+  handshake(TLS1_2_VERSION, "ECDHE-RSA-AES256-GCM-SHA384");
+  EXPECT_CALL(io_handle_, setOption(IPPROTO_TCP, TCP_ULP, _, _))
+      .WillOnce(Return(Api::SysCallIntResult{-1, ENOENT}));
+  EXPECT_FALSE(KernelTls::enableTx(server_.get(), io_handle_));
+}
+#endif
+
+TEST_F(KernelTlsTest, EnableTxUnsupportedCipher) {
+  handshake(TLS1_2_VERSION, "ECDHE-RSA-AES128-SHA");
+  EXPECT_CALL(io_handle_, setOption(_, _, _, _)).Times(0);
+  EXPECT_FALSE(KernelTls::enableTx(server_.get(), io_handle_));
+}
+
+TEST_F(KernelTlsTest, EnableTxUnsupportedVersion) {
+  handshake(TLS1_3_VERSION, "ALL");
+  EXPECT_CALL(io_handle_, setOption(_, _, _, _)).Times(0);
+  EXPECT_FALSE(KernelTls::enableTx(server_.get(), io_handle_));
+}
+
+} // namespace
+} // namespace Tls
+} // namespace TransportSockets
+} // namespace Extensions
+} // namespace Envoy
@@ -6,6 +6,7 @@
 #include "envoy/config/listener/v3/listener_components.pb.h"
 #include "envoy/extensions/transport_sockets/tls/v3/cert.pb.h"
 #include "envoy/network/transport_socket.h"
+#include "envoy/ssl/session_cache/session_cache.h"
 
 #include "source/common/buffer/buffer_impl.h"
 #include "source/common/common/empty_string.h"
@@ -58,6 +59,7 @@
 #include "test/test_common/test_runtime.h"
 #include "test/test_common/utility.h"
 
+#include "absl/container/flat_hash_map.h"
 #include "absl/strings/str_replace.h"
 #include "absl/types/optional.h"
 #include "gmock/gmock.h"
@@ -1406,6 +1408,45 @@ TEST_P(SslSocketTest, MultiCertPreferEcdsaWithoutSni) {
   testUtil(test_options);
 }
 
+// Without SNI, the first RSA certificate is selected for a client which is not ECDSA capable,
+// after the ECDSA certificates configured before it.
+TEST_P(SslSocketTest, MultiCertPickRsaWithoutSniForNonEcdsaClient) {
+  const std::string client_ctx_yaml = absl::StrCat(R"EOF(
+    common_tls_context:
+      tls_params:
+        tls_minimum_protocol_version: TLSv1_2
+        tls_maximum_protocol_version: TLSv1_2
+        cipher_suites:
+        - ECDHE-RSA-AES128-GCM-SHA256
+      validation_context:
+        verify_certificate_hash: )EOF",
+                                                   TEST_SELFSIGNED_CERT_256_HASH);
+
+  const std::string server_ctx_yaml = R"EOF(
+  common_tls_context:
+    tls_certificates:
+    - certificate_chain:
+        filename: "{{ test_rundir }}/test/common/tls/test_data/selfsigned_ecdsa_p256_cert.pem"
+      private_key:
+        filename: "{{ test_rundir }}/test/common/tls/test_data/selfsigned_ecdsa_p256_key.pem"
+    - certificate_chain:
+        filename: "{{ test_rundir }}/test/common/tls/test_data/san_dns_ecdsa_1_cert.pem"
+      private_key:
+        filename: "{{ test_rundir }}/test/common/tls/test_data/san_dns_ecdsa_1_key.pem"
+    - certificate_chain:
+        filename: "{{ test_rundir }}/test/common/tls/test_data/selfsigned_cert.pem"
+      private_key:
+        filename: "{{ test_rundir }}/test/common/tls/test_data/selfsigned_key.pem"
+    - certificate_chain:
+        filename: "{{ test_rundir }}/test/common/tls/test_data/no_san_cert.pem"
+      private_key:
+        filename: "{{ test_rundir }}/test/common/tls/test_data/no_san_key.pem"
+)EOF";
+
+  TestUtilOptions test_options(client_ctx_yaml, server_ctx_yaml, true, version_);
+  testUtil(test_options);
+}
+
 // When client supports SNI, exact match is preferred over wildcard match.
 TEST_P(SslSocketTest, MultiCertPreferExactSniMatch) {
   const std::string client_ctx_yaml = absl::StrCat(R"EOF(
@@ -4246,6 +4287,84 @@ TEST_P(SslSocketTest, SessionResumptionEnabledByDefault) {
   testSupportForSessionResumption(server_ctx_yaml, client_ctx_yaml, true, true, version_);
 }
 
+namespace {
+
+// A session cache of the tests, which are single threaded.
+class TestSessionCache : public Ssl::SessionCache {
+public:
+  void insert(absl::string_view key, absl::string_view session, std::chrono::seconds) override {
+    sessions_[std::string(key)] = std::string(session);
+  }
+  absl::optional<std::string> lookup(absl::string_view key) override {
+    auto it = sessions_.find(key);
+    if (it == sessions_.end()) {
+      return absl::nullopt;
+    }
+    return it->second;
+  }
+  void remove(absl::string_view key) override { sessions_.erase(key); }
+
+private:
+  absl::flat_hash_map<std::string, std::string> sessions_;
+};
+
+class TestSessionCacheFactory : public Ssl::SessionCacheFactory {
+public:
+  Ssl::SessionCacheSharedPtr
+  createSessionCache(const Protobuf::Message&, ProtobufMessage::ValidationVisitor&,
+                     Server::Configuration::ServerFactoryContext&) override {
+    created_++;
+    return std::make_shared<TestSessionCache>();
+  }
+  ProtobufTypes::MessagePtr createEmptyConfigProto() override {
+    return std::make_unique<ProtobufWkt::Struct>();
+  }
+  std::string name() const override { return "envoy.tls.session_cache.test"; }
+
+  int created_{};
+};
+
+} // namespace
+
+// Test that the contexts configured with identical session caches resume the sessions of one
+// another, while they can't with the cache of each context.
+TEST_P(SslSocketTest, StatefulSessionResumptionWithSessionCache) {
+  TestSessionCacheFactory factory;
+  Registry::InjectFactory<Ssl::SessionCacheFactory> registered_factory(factory);
+  // The contexts differ by their session timeout, which isn't part of their session ID context.
+  const std::string server_ctx_yaml = R"EOF(
+  common_tls_context:
+    tls_certificates:
+      certificate_chain:
+        filename: "{{ test_rundir }}/test/common/tls/test_data/unittest_cert.pem"
+      private_key:
+        filename: "{{ test_rundir }}/test/common/tls/test_data/unittest_key.pem"
+  disable_stateless_session_resumption: true
+)EOF";
+  const std::string session_cache_yaml = R"EOF(
+  session_cache:
+    name: test
+    typed_config:
+      "@type": type.googleapis.com/google.protobuf.Struct
+)EOF";
+
+  const std::string client_ctx_yaml = R"EOF(
+    common_tls_context:
+      tls_params:
+        tls_maximum_protocol_version: TLSv1_2
+  )EOF";
+
+  const std::string server_ctx_yaml1 = server_ctx_yaml + "  session_timeout: 2000s\n";
+  const std::string server_ctx_yaml2 = server_ctx_yaml + "  session_timeout: 3000s\n";
+
+  testTicketSessionResumption(server_ctx_yaml1, {}, server_ctx_yaml2, {}, client_ctx_yaml, false,
+                              version_);
+  testTicketSessionResumption(server_ctx_yaml1 + session_cache_yaml, {},
+                              server_ctx_yaml2 + session_cache_yaml, {}, client_ctx_yaml, true,
+                              version_);
+  EXPECT_EQ(1, factory.created_);
+}
+
 // Test that if two listeners use the same cert and session ticket key, but
 // different client CA, that sessions cannot be resumed.
 TEST_P(SslSocketTest, ClientAuthCrossListenerSessionResumption) {
@@ -5081,6 +5200,35 @@ TEST_P(SslSocketTest, CipherSuites) {
   client_params->clear_cipher_suites();
 }
 
+// BoringSSL would have to write the records of a renegotiation, so the client doesn't offload.
+TEST_P(SslSocketTest, KernelTlsOffloadRefusedWithRenegotiation) {
+  envoy::config::listener::v3::Listener listener;
+  envoy::config::listener::v3::FilterChain* filter_chain = listener.add_filter_chains();
+  envoy::extensions::transport_sockets::tls::v3::DownstreamTlsContext tls_context;
+  envoy::extensions::transport_sockets::tls::v3::TlsCertificate* server_cert =
+      tls_context.mutable_common_tls_context()->add_tls_certificates();
+  server_cert->mutable_certificate_chain()->set_filename(
+      TestEnvironment::substitute("{{ test_rundir }}/test/common/tls/test_data/san_dns_cert.pem"));
+  server_cert->mutable_private_key()->set_filename(
+      TestEnvironment::substitute("{{ test_rundir }}/test/common/tls/test_data/san_dns_key.pem"));
+  updateFilterChain(tls_context, *filter_chain);
+
+  envoy::extensions::transport_sockets::tls::v3::UpstreamTlsContext client;
+  envoy::extensions::transport_sockets::tls::v3::TlsParameters* client_params =
+      client.mutable_common_tls_context()->mutable_tls_params();
+  client_params->set_tls_minimum_protocol_version(
+      envoy::extensions::transport_sockets::tls::v3::TlsParameters::TLSv1_2);
+  client_params->set_tls_maximum_protocol_version(
+      envoy::extensions::transport_sockets::tls::v3::TlsParameters::TLSv1_2);
+  client_params->add_cipher_suites("ECDHE-RSA-AES128-GCM-SHA256");
+  client.mutable_common_tls_context()->set_kernel_tls_offload(true);
+  client.set_allow_renegotiation(true);
+
+  TestUtilOptionsV2 test_options(listener, client, true, version_);
+  test_options.setExpectedClientStats("ssl.kernel_tls_tx_offload_failed");
+  testUtilV2(test_options);
+}
+
 TEST_P(SslSocketTest, EcdhCurves) {
   envoy::config::listener::v3::Listener listener;
   envoy::config::listener::v3::FilterChain* filter_chain = listener.add_filter_chains();
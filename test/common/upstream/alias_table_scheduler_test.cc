@@ -0,0 +1,146 @@
+#include "source/common/upstream/alias_table_scheduler.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Upstream {
+namespace {
+
+TEST(AliasTableSchedulerTest, Empty) {
+  AliasTableScheduler<uint32_t> sched;
+  EXPECT_TRUE(sched.empty());
+  EXPECT_EQ(nullptr, sched.peekAgain([](const double&) { return 1; }));
+  EXPECT_EQ(nullptr, sched.pickAndAdd([](const double&) { return 1; }));
+}
+
+// Validate we get regular RR behavior when all weights are the same.
+TEST(AliasTableSchedulerTest, Unweighted) {
+  AliasTableScheduler<uint32_t> sched;
+  constexpr uint32_t num_entries = 128;
+  std::shared_ptr<uint32_t> entries[num_entries];
+
+  for (uint32_t i = 0; i < num_entries; ++i) {
+    entries[i] = std::make_shared<uint32_t>(i);
+    sched.add(1, entries[i]);
+  }
+
+  for (uint32_t rounds = 0; rounds < 128; ++rounds) {
+    for (uint32_t i = 0; i < num_entries; ++i) {
+      auto peek = sched.peekAgain([](const double&) { return 1; });
+      auto p = sched.pickAndAdd([](const double&) { return 1; });
+      EXPECT_EQ(i, *p);
+      EXPECT_EQ(*peek, *p);
+    }
+  }
+}
+
+// Validate that the picks follow the weights.
+TEST(AliasTableSchedulerTest, Weighted) {
+  AliasTableScheduler<uint32_t> sched;
+  constexpr uint32_t num_entries = 16;
+  std::shared_ptr<uint32_t> entries[num_entries];
+  uint32_t pick_count[num_entries] = {};
+
+  double weight_sum = 0;
+  for (uint32_t i = 0; i < num_entries; ++i) {
+    entries[i] = std::make_shared<uint32_t>(i);
+    sched.add(i + 1, entries[i]);
+    weight_sum += i + 1;
+  }
+
+  constexpr uint32_t rounds = 1000;
+  for (uint32_t i = 0; i < rounds * weight_sum; ++i) {
+    auto peek = sched.peekAgain([](const double& x) { return x + 1; });
+    auto p = sched.pickAndAdd([](const double& x) { return x + 1; });
+    EXPECT_EQ(*peek, *p);
+    ++pick_count[*p];
+  }
+
+  for (uint32_t i = 0; i < num_entries; ++i) {
+    EXPECT_NEAR(rounds * (i + 1), pick_count[i], rounds * (i + 1) * 0.01);
+  }
+}
+
+// Validate that creating the scheduler with picks is the same as picking from it.
+TEST(AliasTableSchedulerTest, CreateWithPicks) {
+  std::vector<std::shared_ptr<uint32_t>> entries;
+  for (uint32_t i = 0; i < 5; ++i) {
+    entries.push_back(std::make_shared<uint32_t>(i));
+  }
+  const auto calculate_weight = [](const double& x) { return x + 1; };
+
+  for (uint32_t picks = 0; picks < 20; ++picks) {
+    AliasTableScheduler<uint32_t> sched1 =
+        AliasTableScheduler<uint32_t>::createWithPicks(entries, calculate_weight, 0);
+    for (uint32_t i = 0; i < picks; ++i) {
+      sched1.pickAndAdd(calculate_weight);
+    }
+    AliasTableScheduler<uint32_t> sched2 =
+        AliasTableScheduler<uint32_t>::createWithPicks(entries, calculate_weight, picks);
+    for (uint32_t i = 0; i < 20; ++i) {
+      EXPECT_EQ(*sched1.pickAndAdd(calculate_weight), *sched2.pickAndAdd(calculate_weight));
+    }
+  }
+}
+
+// Validate that a new weight is applied once the cycle through the entries is over.
+TEST(AliasTableSchedulerTest, WeightChange) {
+  AliasTableScheduler<uint32_t> sched;
+  auto first_entry = std::make_shared<uint32_t>(0);
+  auto second_entry = std::make_shared<uint32_t>(1);
+  sched.add(1, first_entry);
+  sched.add(1, second_entry);
+
+  const auto calculate_weight = [](const double& x) { return x == 0 ? 3 : 1; };
+  EXPECT_EQ(*first_entry, *sched.pickAndAdd(calculate_weight));
+  EXPECT_EQ(*second_entry, *sched.pickAndAdd(calculate_weight));
+
+  uint32_t first_count = 0;
+  for (uint32_t i = 0; i < 4000; ++i) {
+    first_count += *sched.pickAndAdd(calculate_weight) == 0;
+  }
+  EXPECT_NEAR(3000, first_count, 10);
+}
+
+// Validate that expired entries are ignored.
+TEST(AliasTableSchedulerTest, Expired) {
+  AliasTableScheduler<uint32_t> sched;
+
+  auto second_entry = std::make_shared<uint32_t>(42);
+  {
+    auto first_entry = std::make_shared<uint32_t>(37);
+    auto third_entry = std::make_shared<uint32_t>(22);
+    sched.add(1000, first_entry);
+    sched.add(1, second_entry);
+    sched.add(100, third_entry);
+  }
+
+  auto peek = sched.peekAgain({});
+  auto p1 = sched.pickAndAdd({});
+  auto p2 = sched.pickAndAdd({});
+  EXPECT_EQ(*peek, *p1);
+  EXPECT_EQ(*second_entry, *p1);
+  EXPECT_EQ(*second_entry, *p2);
+}
+
+// Validate that expired entries are ignored.
+TEST(AliasTableSchedulerTest, ExpiredPeekedIsNotPicked) {
+  AliasTableScheduler<uint32_t> sched;
+
+  {
+    auto second_entry = std::make_shared<uint32_t>(42);
+    auto first_entry = std::make_shared<uint32_t>(37);
+    sched.add(2, first_entry);
+    sched.add(1, second_entry);
+    for (int i = 0; i < 3; ++i) {
+      EXPECT_TRUE(sched.peekAgain({}) != nullptr);
+    }
+  }
+
+  EXPECT_TRUE(sched.peekAgain({}) == nullptr);
+  EXPECT_TRUE(sched.pickAndAdd({}) == nullptr);
+}
+
+} // namespace
+} // namespace Upstream
+} // namespace Envoy
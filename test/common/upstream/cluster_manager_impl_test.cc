@@ -4,6 +4,7 @@
 #include "envoy/config/cluster/v3/cluster.pb.validate.h"
 #include "envoy/config/core/v3/base.pb.h"
 
+#include "source/common/common/hash.h"
 #include "source/common/config/xds_resource.h"
 #include "source/common/network/raw_buffer_socket.h"
 #include "source/common/network/resolver_impl.h"
@@ -1543,6 +1544,95 @@ TEST_P(ClusterManagerLifecycleTest, ShutdownOrder) {
   }
 }
 
+// Verify that the thread local cluster updates made while paused are applied to the main thread
+// right away, and posted to the workers once as a batch when resumed.
+TEST_F(ClusterManagerImplTest, PausedThreadLocalClusterUpdates) {
+  create(defaultConfig());
+  MockClusterUpdateCallbacks callbacks;
+  ClusterUpdateCallbacksHandlePtr cb =
+      cluster_manager_->addThreadLocalClusterUpdateCallbacks(callbacks);
+
+  Config::ScopedResume resume = cluster_manager_->pauseThreadLocalClusterUpdates();
+  EXPECT_CALL(factory_.tls_, runOnAllThreads(_)).Times(0);
+  EXPECT_CALL(callbacks, onClusterAddOrUpdate("cluster_foo", _));
+  EXPECT_CALL(callbacks, onClusterAddOrUpdate("cluster_bar", _));
+  EXPECT_CALL(callbacks, onClusterRemoval("cluster_foo"));
+  EXPECT_TRUE(
+      cluster_manager_->addOrUpdateCluster(defaultStaticCluster("cluster_foo"), "version1"));
+  EXPECT_TRUE(
+      cluster_manager_->addOrUpdateCluster(defaultStaticCluster("cluster_bar"), "version1"));
+  EXPECT_NE(nullptr, cluster_manager_->getThreadLocalCluster("cluster_foo"));
+  EXPECT_TRUE(cluster_manager_->removeCluster("cluster_foo"));
+  EXPECT_EQ(nullptr, cluster_manager_->getThreadLocalCluster("cluster_foo"));
+  EXPECT_NE(nullptr, cluster_manager_->getThreadLocalCluster("cluster_bar"));
+
+  // The main thread does not apply the batch again.
+  testing::Mock::VerifyAndClearExpectations(&factory_.tls_);
+  EXPECT_CALL(factory_.tls_, runOnAllThreads(_));
+  resume.reset();
+  EXPECT_NE(nullptr, cluster_manager_->getThreadLocalCluster("cluster_bar"));
+
+  // Once resumed, the updates are posted as they are made.
+  EXPECT_CALL(factory_.tls_, runOnAllThreads(_));
+  EXPECT_CALL(callbacks, onClusterRemoval("cluster_bar"));
+  EXPECT_TRUE(cluster_manager_->removeCluster("cluster_bar"));
+  EXPECT_EQ(nullptr, cluster_manager_->getThreadLocalCluster("cluster_bar"));
+}
+
+// Verify that a worker only load balances to the hosts it owns when workers_per_host is set. The
+// thread local cluster manager of the test is the one of the first worker.
+TEST_F(ClusterManagerImplTest, WorkersPerHost) {
+  server_.options_.concurrency_ = 4;
+  std::string yaml = R"EOF(
+  static_resources:
+    clusters:
+    - name: cluster_1
+      connect_timeout: 0.250s
+      lb_policy: ROUND_ROBIN
+      type: STATIC
+      common_lb_config:
+        workers_per_host: 1
+      load_assignment:
+        cluster_name: cluster_1
+        endpoints:
+        - lb_endpoints:
+  )EOF";
+  std::vector<std::string> owned_hosts;
+  std::vector<std::string> all_hosts;
+  for (uint32_t port = 11001; port <= 11016; ++port) {
+    yaml += fmt::format(R"EOF(
+          - endpoint:
+              address:
+                socket_address:
+                  address: 127.0.0.1
+                  port_value: {}
+  )EOF",
+                        port);
+    const std::string address = fmt::format("127.0.0.1:{}", port);
+    all_hosts.push_back(address);
+    if (HashUtil::xxHash64(address) % 4 == 0) {
+      owned_hosts.push_back(address);
+    }
+  }
+  create(parseBootstrapFromV3Yaml(yaml));
+
+  std::vector<std::string> hosts;
+  for (const auto& host : cluster_manager_->getThreadLocalCluster("cluster_1")
+                              ->prioritySet()
+                              .hostSetsPerPriority()[0]
+                              ->hosts()) {
+    hosts.push_back(host->address()->asString());
+  }
+  EXPECT_EQ(owned_hosts.empty() ? all_hosts : owned_hosts, hosts);
+  EXPECT_EQ(16, cluster_manager_->activeClusters()
+                    .at("cluster_1")
+                    .get()
+                    .prioritySet()
+                    .hostSetsPerPriority()[0]
+                    ->hosts()
+                    .size());
+}
+
 TEST_F(ClusterManagerImplTest, TwoEqualCommonLbConfigSharedPool) {
   create(defaultConfig());
 
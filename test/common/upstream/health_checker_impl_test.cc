@@ -45,6 +45,8 @@
 #include "test/test_common/test_runtime.h"
 #include "test/test_common/utility.h"
 
+#include "absl/container/flat_hash_map.h"
+#include "absl/synchronization/mutex.h"
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 
@@ -4818,6 +4820,152 @@ TEST_F(TcpHealthCheckerImplTest, SuccessProxyProtocol) {
   read_filter_->onData(response, false);
 }
 
+// Follows the sessions of a health checker running them on its session threads.
+class ShardedSessions {
+public:
+  explicit ShardedSessions(Thread::ThreadFactory& thread_factory)
+      : thread_factory_(thread_factory) {}
+
+  void add(const HostSharedPtr& host) {
+    absl::MutexLock lock(&mutex_);
+    threads_.insert_or_assign(host, thread_factory_.currentThreadId());
+  }
+  void remove(const HostSharedPtr& host) {
+    absl::MutexLock lock(&mutex_);
+    threads_.erase(host);
+  }
+  // Waits for exactly `count` sessions to run, returning the thread running the session of each
+  // host.
+  absl::flat_hash_map<HostSharedPtr, Thread::ThreadId> waitFor(size_t count) {
+    absl::MutexLock lock(&mutex_);
+    const auto has_count = [this, count]() {
+      mutex_.AssertReaderHeld();
+      return threads_.size() == count;
+    };
+    mutex_.Await(absl::Condition(&has_count));
+    return threads_;
+  }
+
+private:
+  Thread::ThreadFactory& thread_factory_;
+  absl::Mutex mutex_;
+  absl::flat_hash_map<HostSharedPtr, Thread::ThreadId> threads_ ABSL_GUARDED_BY(mutex_);
+};
+
+// Runs sessions that don't check anything, to test how the sessions are spread over the session
+// threads.
+class ShardedHealthCheckerImpl : public HealthCheckerImplBase {
+public:
+  ShardedHealthCheckerImpl(const Cluster& cluster,
+                           const envoy::config::core::v3::HealthCheck& config,
+                           Event::Dispatcher& dispatcher, Runtime::Loader& runtime,
+                           Random::RandomGenerator& random, ShardedSessions& sessions)
+      : HealthCheckerImplBase(cluster, config, dispatcher, runtime, random, nullptr),
+        sessions_(sessions) {}
+  ~ShardedHealthCheckerImpl() override { stopSessionShards(); }
+
+private:
+  struct TestSession : public ActiveHealthCheckSession {
+    TestSession(ShardedHealthCheckerImpl& parent, const HostSharedPtr& host)
+        : ActiveHealthCheckSession(parent, host), sessions_(parent.sessions_) {
+      sessions_.add(host_);
+    }
+    ~TestSession() override { sessions_.remove(host_); }
+
+    // ActiveHealthCheckSession
+    void onInterval() override {}
+    void onTimeout() override {}
+    void onDeferredDelete() override {}
+
+    ShardedSessions& sessions_;
+  };
+
+  // HealthCheckerImplBase
+  ActiveHealthCheckSessionPtr makeSession(HostSharedPtr host) override {
+    return std::make_unique<TestSession>(*this, host);
+  }
+  envoy::data::core::v3::HealthCheckerType healthCheckerType() const override {
+    return envoy::data::core::v3::TCP;
+  }
+
+  ShardedSessions& sessions_;
+};
+
+class ShardedHealthCheckerImplTest : public testing::Test, public HealthCheckerTestBase {
+public:
+  void allocHealthChecker() {
+    // The checks are far enough apart to never run during the tests.
+    const std::string yaml = R"EOF(
+    timeout: 100s
+    interval: 100s
+    unhealthy_threshold: 2
+    healthy_threshold: 2
+    session_threads: 2
+    tcp_health_check: {}
+    )EOF";
+
+    health_checker_ = std::make_shared<ShardedHealthCheckerImpl>(
+        *cluster_, parseHealthCheckFromV3Yaml(yaml), dispatcher_, runtime_, random_, sessions_);
+    health_checker_->createSessionShards(*api_);
+  }
+
+  HostSharedPtr makeHost(const std::string& url) {
+    return makeTestHost(cluster_->info_, url, api_->timeSource());
+  }
+
+  Api::ApiPtr api_{Api::createApiForTest()};
+  ShardedSessions sessions_{api_->threadFactory()};
+  std::shared_ptr<ShardedHealthCheckerImpl> health_checker_;
+};
+
+// Tests that the sessions of the hosts run on the session threads, the hosts at start and the ones
+// added later.
+TEST_F(ShardedHealthCheckerImplTest, AddHosts) {
+  allocHealthChecker();
+  cluster_->prioritySet().getMockHostSet(0)->hosts_ = {makeHost("tcp://127.0.0.1:80"),
+                                                       makeHost("tcp://127.0.0.1:81")};
+  health_checker_->start();
+  EXPECT_EQ(2, sessions_.waitFor(2).size());
+
+  const HostSharedPtr added = makeHost("tcp://127.0.0.1:82");
+  cluster_->prioritySet().getMockHostSet(0)->hosts_.push_back(added);
+  cluster_->prioritySet().getMockHostSet(0)->runCallbacks({added}, {});
+  const auto threads = sessions_.waitFor(3);
+  EXPECT_TRUE(threads.contains(added));
+  for (const auto& [host, thread] : threads) {
+    EXPECT_NE(api_->threadFactory().currentThreadId(), thread) << host->address()->asString();
+  }
+}
+
+// Tests that removing a host destroys its session on its session thread.
+TEST_F(ShardedHealthCheckerImplTest, RemoveHost) {
+  allocHealthChecker();
+  const HostSharedPtr kept = makeHost("tcp://127.0.0.1:80");
+  const HostSharedPtr removed = makeHost("tcp://127.0.0.1:81");
+  cluster_->prioritySet().getMockHostSet(0)->hosts_ = {kept, removed};
+  health_checker_->start();
+  sessions_.waitFor(2);
+
+  cluster_->prioritySet().getMockHostSet(0)->hosts_ = {kept};
+  cluster_->prioritySet().getMockHostSet(0)->runCallbacks({}, {removed});
+  const auto threads = sessions_.waitFor(1);
+  EXPECT_TRUE(threads.contains(kept));
+  EXPECT_FALSE(threads.contains(removed));
+}
+
+// Tests that destroying the health checker destroys the sessions and joins the session threads.
+TEST_F(ShardedHealthCheckerImplTest, Stop) {
+  allocHealthChecker();
+  cluster_->prioritySet().getMockHostSet(0)->hosts_ = {makeHost("tcp://127.0.0.1:80"),
+                                                       makeHost("tcp://127.0.0.1:81")};
+  health_checker_->start();
+  sessions_.waitFor(2);
+
+  health_checker_.reset();
+  // The session threads are joined, every session is already gone.
+  EXPECT_TRUE(sessions_.waitFor(0).empty());
+}
+
 class TestGrpcHealthCheckerImpl : public GrpcHealthCheckerImpl {
 public:
   using GrpcHealthCheckerImpl::GrpcHealthCheckerImpl;
@@ -243,25 +243,18 @@ TEST_F(LoadStatsReporterTest, ExistingClusters) {
   response_timer_cb_();
 }
 
-HostSharedPtr makeTestHost(const std::string& hostname,
-                           const ::envoy::config::core::v3::Locality& locality) {
-  const auto host = std::make_shared<NiceMock<::Envoy::Upstream::MockHost>>();
-  ON_CALL(*host, hostname()).WillByDefault(::testing::ReturnRef(hostname));
-  ON_CALL(*host, locality()).WillByDefault(::testing::ReturnRef(locality));
-  return host;
-}
-
-void addStats(const HostSharedPtr& host, double a, double b = 0, double c = 0, double d = 0) {
-  host->stats().rq_success_.inc();
-  host->loadMetricStats().add("metric_a", a);
+// Counts a successful request with its load metrics, as a host of the locality does.
+void addStats(LocalityLoadStats& stats, double a, double b = 0, double c = 0, double d = 0) {
+  stats.rqSuccess().add(1);
+  stats.loadMetricStats().add("metric_a", a);
   if (b != 0) {
-    host->loadMetricStats().add("metric_b", b);
+    stats.loadMetricStats().add("metric_b", b);
   }
   if (c != 0) {
-    host->loadMetricStats().add("metric_c", c);
+    stats.loadMetricStats().add("metric_c", c);
   }
   if (d != 0) {
-    host->loadMetricStats().add("metric_d", d);
+    stats.loadMetricStats().add("metric_d", d);
   }
 }
 
@@ -274,7 +267,7 @@ void addStatExpectation(envoy::config::endpoint::v3::UpstreamLocalityStats* stat
   metric->set_total_metric_value(total_metric_value);
 }
 
-// Validate that per-locality metrics are aggregated across hosts and included in the load report.
+// Validate that per-locality metrics are included in the load report.
 TEST_F(LoadStatsReporterTest, UpstreamLocalityStats) {
   EXPECT_CALL(*async_client_, startRaw(_, _, _, _)).WillOnce(Return(&async_stream_));
   expectSendMessage({});
@@ -283,19 +276,17 @@ TEST_F(LoadStatsReporterTest, UpstreamLocalityStats) {
 
   // Set up some load metrics
   NiceMock<MockClusterMockPrioritySet> cluster;
-  MockHostSet& host_set_ = *cluster.prioritySet().getMockHostSet(0);
 
   ::envoy::config::core::v3::Locality locality0, locality1;
   locality0.set_region("mars");
   locality1.set_region("jupiter");
-  HostSharedPtr host0 = makeTestHost("host0", locality0), host1 = makeTestHost("host1", locality0),
-                host2 = makeTestHost("host2", locality1);
-  host_set_.hosts_per_locality_ = makeHostsPerLocality({{host0, host1}, {host2}});
+  LocalityLoadStats& locality0_stats = cluster.info_->locality_load_stats_.get(locality0, 0);
+  LocalityLoadStats& locality1_stats = cluster.info_->locality_load_stats_.get(locality1, 0);
 
-  addStats(host0, 0.11111, 1.0);
-  addStats(host0, 0.33333, 0, 3.14159);
-  addStats(host1, 0.44444, 0.12345);
-  addStats(host2, 10.01, 0, 20.02, 30.03);
+  addStats(locality0_stats, 0.11111, 1.0);
+  addStats(locality0_stats, 0.33333, 0, 3.14159);
+  addStats(locality0_stats, 0.44444, 0.12345);
+  addStats(locality1_stats, 10.01, 0, 20.02, 30.03);
 
   cluster.info_->eds_service_name_ = "bar";
   MockClusterManager::ClusterInfoMaps cluster_info{{{"foo", cluster}}, {}, {}};
@@ -330,9 +321,9 @@ TEST_F(LoadStatsReporterTest, UpstreamLocalityStats) {
   response_timer_cb_();
 
   // Traffic between previous request and next response. Previous latched metrics are cleared.
-  host1->stats().rq_success_.inc();
-  host1->loadMetricStats().add("metric_a", 1.41421);
-  host1->loadMetricStats().add("metric_e", 2.71828);
+  locality0_stats.rqSuccess().add(1);
+  locality0_stats.loadMetricStats().add("metric_a", 1.41421);
+  locality0_stats.loadMetricStats().add("metric_e", 2.71828);
 
   time_system_.setMonotonicTime(std::chrono::microseconds(6));
   deliverLoadStatsResponse({"foo"});
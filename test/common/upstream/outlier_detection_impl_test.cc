@@ -23,8 +23,10 @@
 #include "test/mocks/upstream/host.h"
 #include "test/mocks/upstream/host_set.h"
 #include "test/test_common/simulated_time_system.h"
+#include "test/test_common/thread_factory_for_test.h"
 #include "test/test_common/utility.h"
 
+#include "absl/synchronization/notification.h"
 #include "absl/types/optional.h"
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
@@ -47,7 +49,8 @@ TEST(OutlierDetectorImplFactoryTest, NoDetector) {
   NiceMock<Random::MockRandomGenerator> random;
   EXPECT_EQ(nullptr,
             DetectorImplFactory::createForCluster(cluster, defaultStaticCluster("fake_cluster"),
-                                                  dispatcher, runtime, nullptr, random)
+                                                  dispatcher, runtime, nullptr, random,
+                                                  Thread::threadFactoryForTest())
                 .value());
 }
 
@@ -59,9 +62,10 @@ TEST(OutlierDetectorImplFactoryTest, Detector) {
   NiceMock<Event::MockDispatcher> dispatcher;
   NiceMock<Runtime::MockLoader> runtime;
   NiceMock<Random::MockRandomGenerator> random;
-  EXPECT_NE(nullptr, DetectorImplFactory::createForCluster(cluster, fake_cluster, dispatcher,
-                                                           runtime, nullptr, random)
-                         .value());
+  EXPECT_NE(nullptr,
+            DetectorImplFactory::createForCluster(cluster, fake_cluster, dispatcher, runtime,
+                                                  nullptr, random, Thread::threadFactoryForTest())
+                .value());
 }
 
 class CallbackChecker {
@@ -1274,6 +1278,118 @@ TEST_F(OutlierDetectorImplTest, BasicFlowSuccessRateExternalOrigin) {
                     DetectorHostMonitor::SuccessRateMonitorType::ExternalOrigin));
 }
 
+TEST_F(OutlierDetectorImplTest, BackgroundSuccessRate) {
+  ON_CALL(runtime_.snapshot_, getInteger(MaxEjectionPercentRuntime, _)).WillByDefault(Return(100));
+  EXPECT_CALL(cluster_.prioritySet(), addMemberUpdateCb(_));
+  addHosts({
+      "tcp://127.0.0.1:80",
+      "tcp://127.0.0.1:81",
+      "tcp://127.0.0.1:82",
+      "tcp://127.0.0.1:83",
+      "tcp://127.0.0.1:84",
+  });
+
+  // Only count one in two results, the request volumes being scaled back.
+  envoy::config::cluster::v3::OutlierDetection outlier_detection;
+  outlier_detection.mutable_background_success_rate()->mutable_sampling_ratio()->set_value(2);
+  EXPECT_CALL(*interval_timer_, enableTimer(std::chrono::milliseconds(10000), _));
+  std::shared_ptr<DetectorImpl> detector(
+      DetectorImpl::create(cluster_, outlier_detection, dispatcher_, runtime_, time_system_,
+                           event_logger_, random_, Thread::threadFactoryForTest())
+          .value());
+  detector->addChangedStateCb([&](HostSharedPtr host) -> void { checker_.check(host); });
+
+  // Turn off 5xx detection to test SR detection in isolation.
+  ON_CALL(runtime_.snapshot_, featureEnabled(EnforcingConsecutive5xxRuntime, 100))
+      .WillByDefault(Return(false));
+  ON_CALL(runtime_.snapshot_, featureEnabled(EnforcingConsecutiveGatewayFailureRuntime, 100))
+      .WillByDefault(Return(false));
+  EXPECT_CALL(*event_logger_, logEject(std::static_pointer_cast<const HostDescription>(hosts_[4]),
+                                       _, envoy::data::cluster::v3::CONSECUTIVE_5XX, false))
+      .Times(40);
+  EXPECT_CALL(*event_logger_,
+              logEject(std::static_pointer_cast<const HostDescription>(hosts_[4]), _,
+                       envoy::data::cluster::v3::CONSECUTIVE_GATEWAY_FAILURE, false))
+      .Times(40);
+
+  loadRq(hosts_, 200, 200);
+  loadRq(hosts_[4], 200, 503);
+
+  // The ejections computed on the background thread are posted back to the main thread.
+  Event::PostCb apply_ejections;
+  absl::Notification posted;
+  EXPECT_CALL(dispatcher_, post(_)).WillOnce(Invoke([&](Event::PostCb cb) -> void {
+    apply_ejections = std::move(cb);
+    posted.Notify();
+  }));
+  time_system_.setMonotonicTime(std::chrono::milliseconds(10000));
+  EXPECT_CALL(*interval_timer_, enableTimer(std::chrono::milliseconds(10000), _));
+  interval_timer_->invokeCallback();
+  posted.WaitForNotification();
+  EXPECT_FALSE(hosts_[4]->healthFlagGet(Host::HealthFlag::FAILED_OUTLIER_CHECK));
+
+  EXPECT_CALL(checker_, check(hosts_[4]));
+  EXPECT_CALL(*event_logger_, logEject(std::static_pointer_cast<const HostDescription>(hosts_[4]),
+                                       _, envoy::data::cluster::v3::SUCCESS_RATE, true));
+  apply_ejections();
+  EXPECT_EQ(50, hosts_[4]->outlierDetector().successRate(
+                    DetectorHostMonitor::SuccessRateMonitorType::ExternalOrigin));
+  EXPECT_EQ(90, detector->successRateAverage(
+                    DetectorHostMonitor::SuccessRateMonitorType::ExternalOrigin));
+  EXPECT_EQ(52, detector->successRateEjectionThreshold(
+                    DetectorHostMonitor::SuccessRateMonitorType::ExternalOrigin));
+  EXPECT_TRUE(hosts_[4]->healthFlagGet(Host::HealthFlag::FAILED_OUTLIER_CHECK));
+  EXPECT_EQ(1UL, outlier_detection_ejections_active_.value());
+}
+
+// Test verifies that a host removed while its success rate is computed in the background is
+// released by the callback posted to the main thread, not by the background thread.
+TEST_F(OutlierDetectorImplTest, BackgroundSuccessRateHostRemoved) {
+  EXPECT_CALL(cluster_.prioritySet(), addMemberUpdateCb(_));
+  addHosts({
+      "tcp://127.0.0.1:80",
+      "tcp://127.0.0.1:81",
+      "tcp://127.0.0.1:82",
+      "tcp://127.0.0.1:83",
+      "tcp://127.0.0.1:84",
+  });
+
+  envoy::config::cluster::v3::OutlierDetection outlier_detection;
+  outlier_detection.mutable_background_success_rate();
+  EXPECT_CALL(*interval_timer_, enableTimer(std::chrono::milliseconds(10000), _));
+  std::shared_ptr<DetectorImpl> detector(
+      DetectorImpl::create(cluster_, outlier_detection, dispatcher_, runtime_, time_system_,
+                           event_logger_, random_, Thread::threadFactoryForTest())
+          .value());
+
+  loadRq(hosts_, 200, 200);
+
+  Event::PostCb apply_ejections;
+  absl::Notification posted;
+  EXPECT_CALL(dispatcher_, post(_)).WillOnce(Invoke([&](Event::PostCb cb) -> void {
+    apply_ejections = std::move(cb);
+    posted.Notify();
+  }));
+  time_system_.setMonotonicTime(std::chrono::milliseconds(10000));
+  EXPECT_CALL(*interval_timer_, enableTimer(std::chrono::milliseconds(10000), _));
+  interval_timer_->invokeCallback();
+  posted.WaitForNotification();
+
+  std::weak_ptr<Host> removed_host = hosts_[4];
+  HostVector removed{hosts_[4]};
+  hosts_.pop_back();
+  cluster_.prioritySet().getMockHostSet(0)->runCallbacks({}, removed);
+  removed.clear();
+  EXPECT_FALSE(removed_host.expired());
+
+  apply_ejections();
+  EXPECT_FALSE(removed_host.expired());
+  apply_ejections = nullptr;
+  EXPECT_TRUE(removed_host.expired());
+  EXPECT_EQ(100, hosts_[0]->outlierDetector().successRate(
+                     DetectorHostMonitor::SuccessRateMonitorType::ExternalOrigin));
+}
+
 // Test verifies that EXT_ORIGIN_REQUEST_FAILED and EXT_ORIGIN_REQUEST_SUCCESS cancel
 // each other in split mode.
 TEST_F(OutlierDetectorImplTest, ExternalOriginEventsWithSplit) {
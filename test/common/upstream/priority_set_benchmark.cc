@@ -0,0 +1,141 @@
+// Benchmarks of the updates of the hosts of a priority set, as done on the main thread and then on
+// each worker for each EDS or DNS update of a cluster.
+
+#include <memory>
+#include <vector>
+
+#include "source/common/common/random_generator.h"
+#include "source/common/memory/stats.h"
+#include "source/common/upstream/upstream_impl.h"
+
+#include "test/benchmark/main.h"
+#include "test/common/upstream/utility.h"
+#include "test/mocks/upstream/cluster_info.h"
+#include "test/test_common/simulated_time_system.h"
+
+#include "absl/strings/str_cat.h"
+#include "benchmark/benchmark.h"
+
+namespace Envoy {
+namespace Upstream {
+namespace {
+
+// How the hosts change between two updates.
+enum class Churn {
+  // Some hosts are removed and as many new ones are added.
+  Replace,
+  // Some hosts fail their health checks, or recover, without any host being added or removed.
+  HealthFlap,
+};
+
+class PrioritySetTester : public Event::TestUsingSimulatedTime {
+public:
+  static constexpr uint64_t Localities = 8;
+
+  explicit PrioritySetTester(uint64_t num_hosts) {
+    for (uint64_t i = 0; i < num_hosts; ++i) {
+      hosts_.push_back(makeHost(i % Localities));
+    }
+    update(hosts_, {});
+  }
+
+  // Changes churn_percent of the hosts and updates the priority set with the result.
+  void churn(Churn churn, uint64_t churn_percent) {
+    const uint64_t changed = hosts_.size() * churn_percent / 100;
+    HostVector hosts_added;
+    HostVector hosts_removed;
+    for (uint64_t i = 0; i < changed; ++i) {
+      // Go around the hosts, so that consecutive updates change different ones.
+      const uint64_t index = next_churned_++ % hosts_.size();
+      if (churn == Churn::Replace) {
+        hosts_removed.push_back(hosts_[index]);
+        hosts_[index] = makeHost(index % Localities);
+        hosts_added.push_back(hosts_[index]);
+      } else if (hosts_[index]->healthFlagGet(Host::HealthFlag::FAILED_ACTIVE_HC)) {
+        hosts_[index]->healthFlagClear(Host::HealthFlag::FAILED_ACTIVE_HC);
+      } else {
+        hosts_[index]->healthFlagSet(Host::HealthFlag::FAILED_ACTIVE_HC);
+      }
+    }
+    update(hosts_added, hosts_removed);
+  }
+
+private:
+  // The hosts are spread over the localities by their index in hosts_.
+  HostSharedPtr makeHost(uint64_t locality_index) {
+    const uint64_t i = next_host_++;
+    envoy::config::core::v3::Locality locality;
+    locality.set_zone(absl::StrCat("zone", locality_index));
+    return makeTestHost(
+        info_, fmt::format("tcp://10.{}.{}.{}:80", (i >> 16) & 0xff, (i >> 8) & 0xff, i & 0xff),
+        simTime(), locality);
+  }
+
+  void update(const HostVector& hosts_added, const HostVector& hosts_removed) {
+    std::vector<HostVector> hosts_per_locality(Localities);
+    for (uint64_t i = 0; i < hosts_.size(); ++i) {
+      hosts_per_locality[i % Localities].push_back(hosts_[i]);
+    }
+    auto locality_weights = std::make_shared<LocalityWeights>(Localities, 1);
+    priority_set_.updateHosts(
+        0,
+        HostSetImpl::partitionHosts(std::make_shared<HostVector>(hosts_),
+                                    makeHostsPerLocality(std::move(hosts_per_locality))),
+        locality_weights, hosts_added, hosts_removed, random_.random(), absl::nullopt);
+  }
+
+  std::shared_ptr<MockClusterInfo> info_{new NiceMock<MockClusterInfo>()};
+  Random::RandomGeneratorImpl random_;
+  PrioritySetImpl priority_set_;
+  HostVector hosts_;
+  uint64_t next_host_ = 0;
+  uint64_t next_churned_ = 0;
+};
+
+void benchmarkPrioritySetBuild(::benchmark::State& state) {
+  const uint64_t num_hosts = state.range(0);
+  if (benchmark::skipExpensiveBenchmarks() && num_hosts > 10000) {
+    state.SkipWithError("Skipping expensive benchmark");
+    return;
+  }
+
+  for (auto _ : state) { // NOLINT: Silences warning about dead store
+    const size_t start_mem = Memory::Stats::totalCurrentlyAllocated();
+    PrioritySetTester tester(num_hosts);
+    state.PauseTiming();
+    const size_t end_mem = Memory::Stats::totalCurrentlyAllocated();
+    state.counters["memory"] = end_mem - start_mem;
+    state.counters["memory_per_host"] = (end_mem - start_mem) / num_hosts;
+    state.ResumeTiming();
+  }
+}
+BENCHMARK(benchmarkPrioritySetBuild)
+    ->Arg(1000)
+    ->Arg(10000)
+    ->Arg(100000)
+    ->Unit(::benchmark::kMillisecond);
+
+void benchmarkPrioritySetUpdate(::benchmark::State& state) {
+  const uint64_t num_hosts = state.range(0);
+  const Churn churn = static_cast<Churn>(state.range(1));
+  const uint64_t churn_percent = state.range(2);
+  if (benchmark::skipExpensiveBenchmarks() && num_hosts > 10000) {
+    state.SkipWithError("Skipping expensive benchmark");
+    return;
+  }
+
+  PrioritySetTester tester(num_hosts);
+  for (auto _ : state) { // NOLINT: Silences warning about dead store
+    tester.churn(churn, churn_percent);
+  }
+}
+// The arguments are the number of hosts, the kind of churn and the percentage of changed hosts.
+BENCHMARK(benchmarkPrioritySetUpdate)
+    ->ArgsProduct({{1000, 10000, 100000},
+                   {static_cast<int64_t>(Churn::Replace), static_cast<int64_t>(Churn::HealthFlap)},
+                   {0, 1, 10, 100}})
+    ->Unit(::benchmark::kMillisecond);
+
+} // namespace
+} // namespace Upstream
+} // namespace Envoy
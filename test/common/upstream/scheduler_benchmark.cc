@@ -4,6 +4,7 @@
 #include <random>
 
 #include "source/common/common/random_generator.h"
+#include "source/common/upstream/alias_table_scheduler.h"
 #include "source/common/upstream/edf_scheduler.h"
 #include "source/common/upstream/wrsq_scheduler.h"
 
@@ -159,6 +160,56 @@ void uniqueWeightPickWRSQ(::benchmark::State& state) {
                             });
 }
 
+void splitWeightAddAliasTable(::benchmark::State& state) {
+  AliasTableScheduler<SchedulerTester::ObjInfo> alias_table;
+  const size_t num_objs = state.range(0);
+  for (auto _ : state) { // NOLINT: Silences warning about dead store
+    SchedulerTester::setupSplitWeights(alias_table, num_objs, state);
+  }
+}
+
+void uniqueWeightAddAliasTable(::benchmark::State& state) {
+  AliasTableScheduler<SchedulerTester::ObjInfo> alias_table;
+  const size_t num_objs = state.range(0);
+  for (auto _ : state) { // NOLINT: Silences warning about dead store
+    SchedulerTester::setupUniqueWeights(alias_table, num_objs, state);
+  }
+}
+
+void splitWeightPickAliasTable(::benchmark::State& state) {
+  AliasTableScheduler<SchedulerTester::ObjInfo> alias_table;
+  const size_t num_objs = state.range(0);
+
+  SchedulerTester::pickTest(alias_table, state,
+                            [num_objs, &state](Scheduler<SchedulerTester::ObjInfo>& sched) {
+                              return SchedulerTester::setupSplitWeights(sched, num_objs, state);
+                            });
+}
+
+void uniqueWeightPickAliasTable(::benchmark::State& state) {
+  AliasTableScheduler<SchedulerTester::ObjInfo> alias_table;
+  const size_t num_objs = state.range(0);
+
+  SchedulerTester::pickTest(alias_table, state,
+                            [num_objs, &state](Scheduler<SchedulerTester::ObjInfo>& sched) {
+                              return SchedulerTester::setupUniqueWeights(sched, num_objs, state);
+                            });
+}
+
+// A rebuild of the scheduler of a host set, as done by the load balancers on host updates.
+template <class SchedulerType> void uniqueWeightCreateWithPicks(::benchmark::State& state) {
+  std::vector<std::shared_ptr<SchedulerTester::ObjInfo>> info;
+  for (int64_t i = 0; i < state.range(0); ++i) {
+    info.push_back(std::make_shared<SchedulerTester::ObjInfo>(
+        SchedulerTester::ObjInfo{static_cast<double>(i + 1)}));
+  }
+  for (auto _ : state) { // NOLINT: Silences warning about dead store
+    SchedulerType sched = SchedulerType::createWithPicks(
+        info, [](const SchedulerTester::ObjInfo& i) { return i.weight; }, 1234567);
+    ::benchmark::DoNotOptimize(sched);
+  }
+}
+
 BENCHMARK(splitWeightAddEdf)
     ->Unit(::benchmark::kMicrosecond)
     ->RangeMultiplier(8)
@@ -179,6 +230,24 @@ BENCHMARK(uniqueWeightAddWRSQ)
     ->Range(1 << 6, 1 << 14);
 BENCHMARK(uniqueWeightPickEdf)->RangeMultiplier(8)->Range(1 << 6, 1 << 14);
 BENCHMARK(uniqueWeightPickWRSQ)->RangeMultiplier(8)->Range(1 << 6, 1 << 14);
+BENCHMARK(splitWeightAddAliasTable)
+    ->Unit(::benchmark::kMicrosecond)
+    ->RangeMultiplier(8)
+    ->Range(1 << 6, 1 << 14);
+BENCHMARK(uniqueWeightAddAliasTable)
+    ->Unit(::benchmark::kMicrosecond)
+    ->RangeMultiplier(8)
+    ->Range(1 << 6, 1 << 14);
+BENCHMARK(splitWeightPickAliasTable)->RangeMultiplier(8)->Range(1 << 6, 1 << 14);
+BENCHMARK(uniqueWeightPickAliasTable)->RangeMultiplier(8)->Range(1 << 6, 1 << 14);
+BENCHMARK_TEMPLATE(uniqueWeightCreateWithPicks, EdfScheduler<SchedulerTester::ObjInfo>)
+    ->Unit(::benchmark::kMicrosecond)
+    ->RangeMultiplier(8)
+    ->Range(1 << 6, 1 << 14);
+BENCHMARK_TEMPLATE(uniqueWeightCreateWithPicks, AliasTableScheduler<SchedulerTester::ObjInfo>)
+    ->Unit(::benchmark::kMicrosecond)
+    ->RangeMultiplier(8)
+    ->Range(1 << 6, 1 << 14);
 
 } // namespace
 } // namespace Upstream
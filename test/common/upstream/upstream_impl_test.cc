@@ -1591,6 +1591,53 @@ TEST_F(HostImplTest, HostLbPolicyData) {
   EXPECT_EQ(test_policy_data->foo, 42);
 }
 
+// Test that the load report stats of the hosts are counted in the stats of their locality and
+// priority, and that the requests in progress follow a host to its new priority.
+TEST_F(HostImplTest, LocalityLoadStats) {
+  MockClusterMockPrioritySet cluster;
+  envoy::config::core::v3::Locality locality;
+  locality.set_zone("hello");
+  HostSharedPtr host1 = makeTestHost(cluster.info_, "tcp://10.0.0.1:1234", simTime(), locality);
+  HostSharedPtr host2 = makeTestHost(cluster.info_, "tcp://10.0.0.2:1234", simTime(), locality);
+  LocalityLoadStats& priority0 = cluster.info_->locality_load_stats_.get(locality, 0);
+  LocalityLoadStats& priority1 = cluster.info_->locality_load_stats_.get(locality, 1);
+
+  host1->stats().rq_total_.inc();
+  host1->stats().rq_success_.inc();
+  host2->stats().rq_total_.add(2);
+  host2->stats().rq_error_.inc();
+  host2->stats().rq_active_.inc();
+  host1->loadMetricStats().add("metric", 1.5);
+  host2->loadMetricStats().add("metric", 2.5);
+  // The host stats are still counted for the stats sinks.
+  EXPECT_EQ(2U, host2->stats().rq_total_.value());
+
+  LocalityLoadStats::Latched latched = priority0.latch();
+  EXPECT_EQ(1U, latched.rq_success_);
+  EXPECT_EQ(1U, latched.rq_error_);
+  EXPECT_EQ(3U, latched.rq_total_);
+  EXPECT_EQ(1U, latched.rq_active_);
+  ASSERT_NE(nullptr, latched.load_metrics_);
+  EXPECT_EQ(2U, latched.load_metrics_->at("metric").num_requests_with_metric);
+  EXPECT_DOUBLE_EQ(4.0, latched.load_metrics_->at("metric").total_metric_value);
+
+  // The counters are reset by latching, but not the requests in progress.
+  latched = priority0.latch();
+  EXPECT_EQ(0U, latched.rq_total_);
+  EXPECT_EQ(1U, latched.rq_active_);
+  EXPECT_EQ(nullptr, latched.load_metrics_);
+
+  host2->priority(1);
+  EXPECT_EQ(0U, priority0.latch().rq_active_);
+  EXPECT_EQ(1U, priority1.latch().rq_active_);
+  host2->stats().rq_active_.dec();
+  host2->stats().rq_success_.inc();
+  latched = priority1.latch();
+  EXPECT_EQ(1U, latched.rq_success_);
+  EXPECT_EQ(0U, latched.rq_active_);
+  EXPECT_EQ(0U, priority0.latch().rq_success_);
+}
+
 TEST_F(HostImplTest, HostnameCanaryAndLocality) {
   MockClusterMockPrioritySet cluster;
   envoy::config::core::v3::Metadata metadata;
@@ -2626,6 +2673,74 @@ TEST_F(StaticClusterImplTest, HealthyStat) {
   EXPECT_EQ(0UL, cluster->info()->endpointStats().membership_degraded_.value());
 }
 
+// Verify that the health transitions within the health update batch window are applied by a single
+// update of the host sets once it expires.
+TEST_F(StaticClusterImplTest, HealthUpdateBatchWindow) {
+  const std::string yaml = R"EOF(
+    name: addressportconfig
+    connect_timeout: 0.25s
+    type: static
+    lb_policy: random
+    common_lb_config:
+      health_update_batch_window: 1s
+    load_assignment:
+        endpoints:
+          - lb_endpoints:
+            - endpoint:
+                address:
+                  socket_address:
+                    address: 10.0.0.1
+                    port_value: 11001
+            - endpoint:
+                address:
+                  socket_address:
+                    address: 10.0.0.1
+                    port_value: 11002
+  )EOF";
+
+  envoy::config::cluster::v3::Cluster cluster_config = parseClusterFromV3Yaml(yaml);
+
+  Envoy::Upstream::ClusterFactoryContextImpl factory_context(
+      server_context_, server_context_.cluster_manager_, nullptr, ssl_context_manager_, nullptr,
+      false);
+  Event::MockTimer* batch_timer = new Event::MockTimer(&server_context_.dispatcher_);
+  std::shared_ptr<StaticClusterImpl> cluster = createCluster(cluster_config, factory_context);
+
+  std::shared_ptr<MockHealthChecker> health_checker(new NiceMock<MockHealthChecker>());
+  cluster->setHealthChecker(health_checker);
+
+  // The first health check pass is applied when the cluster is initialized, without batching.
+  ReadyWatcher initialized;
+  cluster->initialize([&initialized] { initialized.ready(); });
+  const HostVector& hosts = cluster->prioritySet().hostSetsPerPriority()[0]->hosts();
+  for (const HostSharedPtr& host : hosts) {
+    host->healthFlagClear(Host::HealthFlag::FAILED_ACTIVE_HC);
+  }
+  EXPECT_CALL(initialized, ready());
+  for (const HostSharedPtr& host : hosts) {
+    health_checker->runCallbacks(host, HealthTransition::Changed, HealthState::Healthy);
+  }
+  EXPECT_FALSE(batch_timer->enabled());
+  EXPECT_EQ(2UL, cluster->prioritySet().hostSetsPerPriority()[0]->healthyHosts().size());
+
+  uint32_t updates = 0;
+  auto member_update_cb = cluster->prioritySet().addPriorityUpdateCb(
+      [&updates](uint32_t, const HostVector&, const HostVector&) { ++updates; });
+
+  EXPECT_CALL(*batch_timer, enableTimer(std::chrono::milliseconds(1000), _));
+  for (const HostSharedPtr& host : hosts) {
+    host->healthFlagSet(Host::HealthFlag::FAILED_ACTIVE_HC);
+    health_checker->runCallbacks(host, HealthTransition::Changed, HealthState::Unhealthy);
+  }
+  EXPECT_EQ(0, updates);
+  EXPECT_EQ(2UL, cluster->prioritySet().hostSetsPerPriority()[0]->healthyHosts().size());
+
+  batch_timer->invokeCallback();
+  EXPECT_EQ(1, updates);
+  EXPECT_EQ(0UL, cluster->prioritySet().hostSetsPerPriority()[0]->healthyHosts().size());
+  EXPECT_EQ(0UL, cluster->info()->endpointStats().membership_healthy_.value());
+}
+
 TEST_F(StaticClusterImplTest, InitialHostsDisableHC) {
   const std::string yaml = R"EOF(
     name: staticcluster
@@ -109,6 +109,35 @@ http_logs:
   logger_->log(envoy::data::accesslog::v3::HTTPAccessLogEntry(entry));
 }
 
+// The identifier is only sent with the first message of the stream.
+TEST_F(GrpcAccessLoggerImplTest, LogHttpOnOpenStream) {
+  grpc_access_logger_impl_test_helper_.expectStreamMessage(R"EOF(
+identifier:
+  node:
+    id: node_name
+    cluster: cluster_name
+    locality:
+      zone: zone_name
+  log_name: test_log_name
+http_logs:
+  log_entry:
+    request:
+      path: /test/path1
+)EOF");
+  envoy::data::accesslog::v3::HTTPAccessLogEntry entry;
+  entry.mutable_request()->set_path("/test/path1");
+  logger_->log(envoy::data::accesslog::v3::HTTPAccessLogEntry(entry));
+
+  grpc_access_logger_impl_test_helper_.expectStreamMessage(R"EOF(
+http_logs:
+  log_entry:
+    request:
+      path: /test/path2
+)EOF");
+  entry.mutable_request()->set_path("/test/path2");
+  logger_->log(envoy::data::accesslog::v3::HTTPAccessLogEntry(entry));
+}
+
 TEST_F(GrpcAccessLoggerImplTest, LogTcp) {
   grpc_access_logger_impl_test_helper_.expectStreamMessage(R"EOF(
 identifier:
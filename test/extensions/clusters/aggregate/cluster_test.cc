@@ -401,6 +401,55 @@ TEST_F(AggregateClusterTest, ContextDeterminePriorityLoad) {
   lb_->chooseHost(&lb_context);
 }
 
+// Test that the linearized priorities follow the member updates of the clusters, which update
+// them in place unless the priorities of the cluster which have hosts change.
+TEST_F(AggregateClusterTest, LinearizedPrioritiesFollowMemberUpdates) {
+  NiceMock<Upstream::MockLoadBalancerContext> lb_context;
+  initialize(default_yaml_config_);
+
+  const Upstream::PrioritySet* linearized_priority_set = nullptr;
+  Upstream::RetryPriority::PriorityMappingFunc mapping_func;
+  ON_CALL(lb_context, determinePriorityLoad(_, _, _))
+      .WillByDefault(Invoke([&](const Upstream::PrioritySet& priority_set,
+                                const Upstream::HealthyAndDegradedLoad& priority_load,
+                                const Upstream::RetryPriority::PriorityMappingFunc& func)
+                                -> const Upstream::HealthyAndDegradedLoad& {
+        linearized_priority_set = &priority_set;
+        mapping_func = func;
+        return priority_load;
+      }));
+  // Returns the linearized priority of the hosts of the priority of the cluster.
+  auto linearized_priority = [&](Upstream::PrioritySetImpl& priority_set, uint32_t priority) {
+    lb_->chooseHost(&lb_context);
+    return mapping_func(*priority_set.hostSetsPerPriority()[priority]->hosts()[0]);
+  };
+
+  // The linearized priorities are [P0, P1, S0, S1].
+  EXPECT_EQ(absl::optional<uint32_t>(3), linearized_priority(secondary_ps_, 1));
+  const Upstream::PrioritySet* initial_priority_set = linearized_priority_set;
+
+  // The hosts of a linearized priority are updated in place.
+  setupSecondary(1, 3, 0, 0);
+  EXPECT_EQ(absl::optional<uint32_t>(3), linearized_priority(secondary_ps_, 1));
+  EXPECT_EQ(initial_priority_set, linearized_priority_set);
+  EXPECT_EQ(3U, linearized_priority_set->hostSetsPerPriority()[3]->hosts().size());
+  EXPECT_EQ(3U, linearized_priority_set->hostSetsPerPriority()[3]->healthyHosts().size());
+
+  // The priorities of the secondary shift once the first priority of the primary is empty.
+  setupPrimary(0, 0, 0, 0);
+  EXPECT_EQ(absl::optional<uint32_t>(0), linearized_priority(primary_ps_, 1));
+  EXPECT_EQ(absl::optional<uint32_t>(1), linearized_priority(secondary_ps_, 0));
+  EXPECT_EQ(absl::optional<uint32_t>(2), linearized_priority(secondary_ps_, 1));
+  EXPECT_NE(initial_priority_set, linearized_priority_set);
+  EXPECT_EQ(3U, linearized_priority_set->hostSetsPerPriority().size());
+
+  // And shift back once it has hosts again.
+  setupPrimary(0, 1, 0, 0);
+  EXPECT_EQ(absl::optional<uint32_t>(0), linearized_priority(primary_ps_, 0));
+  EXPECT_EQ(absl::optional<uint32_t>(3), linearized_priority(secondary_ps_, 1));
+  EXPECT_EQ(3U, linearized_priority_set->hostSetsPerPriority()[3]->hosts().size());
+}
+
 } // namespace Aggregate
 } // namespace Clusters
 } // namespace Extensions
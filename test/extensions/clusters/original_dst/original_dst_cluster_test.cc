@@ -27,6 +27,7 @@
 #include "test/mocks/upstream/cluster_manager.h"
 #include "test/test_common/utility.h"
 
+#include "absl/strings/str_cat.h"
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 
@@ -263,21 +264,15 @@ TEST_F(OriginalDstClusterTest, AddressCollision) {
   HostConstSharedPtr host1 = lb1.chooseHost(&lb_context);
   ASSERT_NE(host1, nullptr);
   EXPECT_EQ(*connection.connectionInfoProvider().localAddress(), *host1->address());
-  Event::PostCb post_cb2;
-  EXPECT_CALL(server_context_.dispatcher_, post(_)).WillOnce([&post_cb2](Event::PostCb cb) {
-    post_cb2 = std::move(cb);
-  });
+  // The second host is added along with the first one, without another post.
   HostConstSharedPtr host2 = lb2.chooseHost(&lb_context);
   ASSERT_NE(host2, nullptr);
+  EXPECT_NE(host2, host1);
   EXPECT_EQ(*connection.connectionInfoProvider().localAddress(), *host2->address());
 
-  // Process main callbacks sequentially.
+  // Process the main callback, which adds both hosts at once.
   EXPECT_CALL(membership_updated_, ready());
   post_cb1();
-  EXPECT_EQ(1UL, cluster_->prioritySet().hostSetsPerPriority()[0]->hosts().size());
-  EXPECT_EQ(1UL, cluster_->prioritySet().hostSetsPerPriority()[0]->healthyHosts().size());
-  EXPECT_CALL(membership_updated_, ready());
-  post_cb2();
   EXPECT_EQ(2UL, cluster_->prioritySet().hostSetsPerPriority()[0]->hosts().size());
   EXPECT_EQ(2UL, cluster_->prioritySet().hostSetsPerPriority()[0]->healthyHosts().size());
 
@@ -383,16 +378,10 @@ TEST_F(OriginalDstClusterTest, CollisionHostInUse) {
     post_cb1 = std::move(cb);
   });
   HostConstSharedPtr host1 = OriginalDstCluster::LoadBalancer(handle_).chooseHost(&lb_context);
-  Event::PostCb post_cb2;
-  EXPECT_CALL(server_context_.dispatcher_, post(_)).WillOnce([&post_cb2](Event::PostCb cb) {
-    post_cb2 = std::move(cb);
-  });
   HostConstSharedPtr host2 = OriginalDstCluster::LoadBalancer(handle_).chooseHost(&lb_context);
 
   EXPECT_CALL(membership_updated_, ready());
   post_cb1();
-  EXPECT_CALL(membership_updated_, ready());
-  post_cb2();
 
   // Borrow a collision host2 handle.
   auto handle = host2->acquireHandle();
@@ -416,6 +405,92 @@ TEST_F(OriginalDstClusterTest, CollisionHostInUse) {
   EXPECT_EQ(0UL, cluster_->prioritySet().hostSetsPerPriority()[0]->hosts().size());
 }
 
+TEST_F(OriginalDstClusterTest, LoadBalancerReusesAddedHost) {
+  std::string yaml = R"EOF(
+    name: name
+    connect_timeout: 1.250s
+    type: ORIGINAL_DST
+    lb_policy: CLUSTER_PROVIDED
+  )EOF";
+
+  EXPECT_CALL(initialized_, ready());
+  setupFromYaml(yaml);
+
+  NiceMock<Network::MockConnection> connection;
+  TestLoadBalancerContext lb_context(&connection);
+  connection.stream_info_.downstream_connection_info_provider_->restoreLocalAddress(
+      std::make_shared<Network::Address::Ipv4Instance>("10.10.11.11"));
+
+  OriginalDstCluster::LoadBalancer lb(handle_);
+  Event::PostCb post_cb;
+  EXPECT_CALL(server_context_.dispatcher_, post(_)).WillOnce([&post_cb](Event::PostCb cb) {
+    post_cb = std::move(cb);
+  });
+  HostConstSharedPtr host1 = lb.chooseHost(&lb_context);
+  ASSERT_NE(host1, nullptr);
+  // The host isn't in the host map of the load balancer yet, but it isn't created again.
+  EXPECT_EQ(host1, lb.chooseHost(&lb_context));
+  EXPECT_CALL(membership_updated_, ready());
+  post_cb();
+  EXPECT_EQ(host1, lb.chooseHost(&lb_context));
+  EXPECT_EQ(1UL, cluster_->prioritySet().hostSetsPerPriority()[0]->hosts().size());
+}
+
+TEST_F(OriginalDstClusterTest, BatchedHostAdditions) {
+  std::string yaml = R"EOF(
+    name: name
+    connect_timeout: 1.250s
+    type: ORIGINAL_DST
+    lb_policy: CLUSTER_PROVIDED
+  )EOF";
+
+  EXPECT_CALL(initialized_, ready());
+  setupFromYaml(yaml);
+
+  OriginalDstCluster::LoadBalancer lb1(handle_);
+  OriginalDstCluster::LoadBalancer lb2(handle_);
+  Event::PostCb post_cb;
+  EXPECT_CALL(server_context_.dispatcher_, post(_)).WillOnce([&post_cb](Event::PostCb cb) {
+    post_cb = std::move(cb);
+  });
+  HostVector added;
+  auto priority_update_cb = cluster_->prioritySet().addPriorityUpdateCb(
+      [&added](uint32_t, const HostVector& hosts_added, const HostVector&) {
+        added.insert(added.end(), hosts_added.begin(), hosts_added.end());
+        return absl::OkStatus();
+      });
+
+  // Hosts chosen by several load balancers until the main thread runs are added in one update.
+  std::vector<HostConstSharedPtr> hosts;
+  for (uint32_t i = 0; i < 4; ++i) {
+    NiceMock<Network::MockConnection> connection;
+    TestLoadBalancerContext lb_context(&connection);
+    connection.stream_info_.downstream_connection_info_provider_->restoreLocalAddress(
+        std::make_shared<Network::Address::Ipv4Instance>(absl::StrCat("10.10.11.", i)));
+    hosts.push_back((i % 2 == 0 ? lb1 : lb2).chooseHost(&lb_context));
+  }
+  EXPECT_CALL(membership_updated_, ready());
+  post_cb();
+  ASSERT_EQ(4UL, added.size());
+  for (uint32_t i = 0; i < 4; ++i) {
+    EXPECT_EQ(hosts[i], added[i]);
+  }
+  EXPECT_EQ(4UL, cluster_->prioritySet().hostSetsPerPriority()[0]->hosts().size());
+
+  // The next host is posted again.
+  NiceMock<Network::MockConnection> connection;
+  TestLoadBalancerContext lb_context(&connection);
+  connection.stream_info_.downstream_connection_info_provider_->restoreLocalAddress(
+      std::make_shared<Network::Address::Ipv4Instance>("10.10.11.4"));
+  EXPECT_CALL(server_context_.dispatcher_, post(_)).WillOnce([&post_cb](Event::PostCb cb) {
+    post_cb = std::move(cb);
+  });
+  EXPECT_NE(nullptr, OriginalDstCluster::LoadBalancer(handle_).chooseHost(&lb_context));
+  EXPECT_CALL(membership_updated_, ready());
+  post_cb();
+  EXPECT_EQ(5UL, cluster_->prioritySet().hostSetsPerPriority()[0]->hosts().size());
+}
+
 TEST_F(OriginalDstClusterTest, Membership) {
   std::string yaml = R"EOF(
     name: name
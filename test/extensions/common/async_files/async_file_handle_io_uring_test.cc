@@ -0,0 +1,164 @@
+#include <future>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "envoy/extensions/common/async_files/v3/async_file_manager.pb.h"
+
+#include "source/common/api/os_sys_calls_impl.h"
+#include "source/common/buffer/buffer_impl.h"
+#include "source/common/io/io_uring_impl.h"
+#include "source/common/singleton/manager_impl.h"
+#include "source/extensions/common/async_files/async_file_handle.h"
+#include "source/extensions/common/async_files/async_file_manager.h"
+#include "source/extensions/common/async_files/async_file_manager_factory.h"
+
+#include "test/test_common/status_utility.h"
+#include "test/test_common/utility.h"
+
+#include "absl/status/statusor.h"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace Common {
+namespace AsyncFiles {
+
+using StatusHelpers::IsOkAndHolds;
+
+class AsyncFileHandleIoUringTest : public testing::Test {
+public:
+  AsyncFileHandleIoUringTest() : should_skip_(!Io::isIoUringSupported()) {}
+
+  void SetUp() override {
+    if (should_skip_) {
+      GTEST_SKIP();
+    }
+    singleton_manager_ = std::make_unique<Singleton::ManagerImpl>();
+    factory_ = AsyncFileManagerFactory::singleton(singleton_manager_.get());
+    envoy::extensions::common::async_files::v3::AsyncFileManagerConfig config;
+    config.mutable_io_uring()->set_thread_count(1);
+    config.mutable_io_uring()->set_io_uring_size(4);
+    manager_ = factory_->getAsyncFileManager(config);
+  }
+
+  AsyncFileHandle createAnonymousFile() {
+    std::promise<AsyncFileHandle> create_result;
+    manager_->createAnonymousFile(tmpdir_, [&](absl::StatusOr<AsyncFileHandle> result) {
+      create_result.set_value(result.value());
+    });
+    return create_result.get_future().get();
+  }
+
+  void close(AsyncFileHandle& handle) {
+    std::promise<absl::Status> close_result;
+    EXPECT_OK(handle->close([&](absl::Status status) { close_result.set_value(status); }));
+    EXPECT_OK(close_result.get_future().get());
+  }
+
+  const bool should_skip_;
+  const char* test_tmpdir = std::getenv("TEST_TMPDIR");
+  std::string tmpdir_ = test_tmpdir ? test_tmpdir : "/tmp";
+  std::unique_ptr<Singleton::ManagerImpl> singleton_manager_;
+  std::shared_ptr<AsyncFileManagerFactory> factory_;
+  std::shared_ptr<AsyncFileManager> manager_;
+};
+
+TEST_F(AsyncFileHandleIoUringTest, DescribesTheRing) {
+  EXPECT_EQ(manager_->describe(), "thread_pool_size = 1, io_uring_size = 4");
+}
+
+TEST_F(AsyncFileHandleIoUringTest, WriteReadClose) {
+  auto handle = createAnonymousFile();
+  absl::StatusOr<size_t> write_status;
+  absl::StatusOr<Buffer::InstancePtr> read_status, second_read_status;
+  Buffer::OwnedImpl hello("hello");
+  std::promise<absl::Status> close_status;
+  EXPECT_OK(handle->write(hello, 0, [&](absl::StatusOr<size_t> status) {
+    write_status = std::move(status);
+    EXPECT_OK(handle->read(0, 5, [&](absl::StatusOr<Buffer::InstancePtr> status) {
+      read_status = std::move(status);
+      // Reading past the end of the file returns what there is.
+      EXPECT_OK(handle->read(3, 10, [&](absl::StatusOr<Buffer::InstancePtr> status) {
+        second_read_status = std::move(status);
+        EXPECT_OK(handle->close(
+            [&](absl::Status status) { close_status.set_value(std::move(status)); }));
+      }));
+    }));
+  }));
+  ASSERT_OK(close_status.get_future().get());
+  EXPECT_THAT(write_status, IsOkAndHolds(5U));
+  ASSERT_OK(read_status);
+  EXPECT_THAT(*read_status.value(), BufferStringEqual("hello"));
+  ASSERT_OK(second_read_status);
+  EXPECT_THAT(*second_read_status.value(), BufferStringEqual("lo"));
+}
+
+TEST_F(AsyncFileHandleIoUringTest, ReadErrorIsReported) {
+  char filename[1024];
+  snprintf(filename, sizeof(filename), "%s/async_file_test.XXXXXX", tmpdir_.c_str());
+  Api::OsSysCalls& posix = Api::OsSysCallsSingleton().get();
+  const int fd = posix.mkstemp(filename).return_value_;
+  ASSERT_NE(fd, -1);
+  posix.close(fd);
+
+  std::promise<AsyncFileHandle> open_result;
+  manager_->openExistingFile(filename, AsyncFileManager::Mode::WriteOnly,
+                             [&](absl::StatusOr<AsyncFileHandle> result) {
+                               open_result.set_value(result.value());
+                             });
+  AsyncFileHandle handle = open_result.get_future().get();
+  std::promise<absl::StatusOr<Buffer::InstancePtr>> read_status_promise;
+  EXPECT_OK(handle->read(0, 5, [&](absl::StatusOr<Buffer::InstancePtr> status) {
+    read_status_promise.set_value(std::move(status));
+  }));
+  absl::StatusOr<Buffer::InstancePtr> read_status = read_status_promise.get_future().get();
+  EXPECT_EQ(absl::StatusCode::kFailedPrecondition, read_status.status().code())
+      << read_status.status();
+  close(handle);
+  posix.unlink(filename);
+}
+
+TEST_F(AsyncFileHandleIoUringTest, DuplicateUsesTheRing) {
+  auto handle = createAnonymousFile();
+  std::promise<absl::StatusOr<AsyncFileHandle>> duplicate_status_promise;
+  EXPECT_OK(handle->duplicate(
+      [&](absl::StatusOr<AsyncFileHandle> status) { duplicate_status_promise.set_value(status); }));
+  auto duplicate_status = duplicate_status_promise.get_future().get();
+  ASSERT_OK(duplicate_status);
+  AsyncFileHandle dup_file = std::move(duplicate_status.value());
+  close(handle);
+  std::promise<absl::StatusOr<size_t>> write_status_promise;
+  Buffer::OwnedImpl buf("hello");
+  EXPECT_OK(dup_file->write(
+      buf, 0, [&](absl::StatusOr<size_t> result) { write_status_promise.set_value(result); }));
+  EXPECT_THAT(write_status_promise.get_future().get(), IsOkAndHolds(5U));
+  close(dup_file);
+}
+
+TEST_F(AsyncFileHandleIoUringTest, ActionsBeyondTheRingUseTheThreadPool) {
+  // More writes than the ring holds are in flight at once, all of them complete.
+  constexpr int NumFiles = 16;
+  std::vector<AsyncFileHandle> handles;
+  for (int i = 0; i < NumFiles; ++i) {
+    handles.push_back(createAnonymousFile());
+  }
+  std::vector<std::promise<absl::StatusOr<size_t>>> write_promises(NumFiles);
+  for (int i = 0; i < NumFiles; ++i) {
+    Buffer::OwnedImpl hello("hello");
+    EXPECT_OK(handles[i]->write(hello, 0, [&promise = write_promises[i]](
+                                              absl::StatusOr<size_t> result) {
+      promise.set_value(result);
+    }));
+  }
+  for (int i = 0; i < NumFiles; ++i) {
+    EXPECT_THAT(write_promises[i].get_future().get(), IsOkAndHolds(5U));
+    close(handles[i]);
+  }
+}
+
+} // namespace AsyncFiles
+} // namespace Common
+} // namespace Extensions
+} // namespace Envoy
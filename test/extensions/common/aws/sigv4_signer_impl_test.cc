@@ -233,6 +233,41 @@ TEST_F(SigV4SignerImplTest, SignContentHeaderOverrideRegion) {
                 .getStringView());
 }
 
+// Verify the signing key of the signer is derived again when the region or the day changes
+TEST_F(SigV4SignerImplTest, SignWithCachedSigningKey) {
+  EXPECT_CALL(*credentials_provider_, getCredentials()).WillRepeatedly(Return(credentials_));
+  const auto sign = [this](absl::string_view override_region) {
+    Http::RequestMessageImpl message;
+    message.headers().setMethod("POST");
+    message.headers().setPath("/");
+    message.body().add("test1234");
+    EXPECT_TRUE(signer_.sign(message, true, override_region).ok());
+    return std::string(message.headers().get(Http::CustomHeaders::get().Authorization)[0]
+                           ->value()
+                           .getStringView());
+  };
+
+  const std::string region =
+      "AWS4-HMAC-SHA256 Credential=akid/20180102/region/service/aws4_request, "
+      "SignedHeaders=x-amz-content-sha256;x-amz-date, "
+      "Signature=4eab89c36f45f2032d6010ba1adab93f8510ddd6afe540821f3a05bb0253e27b";
+  const std::string region1 =
+      "AWS4-HMAC-SHA256 Credential=akid/20180102/region1/service/aws4_request, "
+      "SignedHeaders=x-amz-content-sha256;x-amz-date, "
+      "Signature=fe8136ed21972d8618171e051f4023b7c06b85d61b4d4325be869846f404b399";
+  EXPECT_EQ(region, sign(""));
+  EXPECT_EQ(region, sign(""));
+  EXPECT_EQ(region1, sign("region1"));
+  EXPECT_EQ(region, sign(""));
+
+  // 20180103T030405Z
+  time_system_.setSystemTime(std::chrono::milliseconds(1514948645000));
+  const std::string next_day = sign("");
+  EXPECT_THAT(next_day, testing::HasSubstr("Credential=akid/20180103/region/service/"));
+  EXPECT_THAT(next_day, testing::Not(testing::HasSubstr(
+                            "4eab89c36f45f2032d6010ba1adab93f8510ddd6afe540821f3a05bb0253e27b")));
+}
+
 // Verify we sign some extra headers
 TEST_F(SigV4SignerImplTest, SignExtraHeaders) {
   EXPECT_CALL(*credentials_provider_, getCredentials()).WillOnce(Return(credentials_));
@@ -342,6 +342,47 @@ e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855)EOF";
                               "ap-southeast-2");
 }
 
+// Verify the signatures of a signer whose credentials were rotated match the new credentials
+TEST_F(SigV4ASignerImplTest, SignAndVerifyRotatedCredentials) {
+  auto& crypto_util = Envoy::Common::Crypto::UtilitySingleton::get();
+  const std::string canonical_request = R"EOF(GET
+/
+
+host:www.example.com
+x-amz-content-sha256:e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855
+x-amz-date:20180102T030400Z
+x-amz-region-set:ap-southeast-2
+
+host;x-amz-content-sha256;x-amz-date;x-amz-region-set
+e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855)EOF";
+  const std::string string_to_sign =
+      fmt::format(SigV4ASignatureConstants::SigV4AStringToSignFormat,
+                  SigV4ASignatureConstants::SigV4AAlgorithm, "20180102T030400Z",
+                  "20180102/service/aws4_request",
+                  Hex::encode(crypto_util.getSha256Digest(Buffer::OwnedImpl(canonical_request))));
+  const auto hash = crypto_util.getSha256Digest(Buffer::OwnedImpl(string_to_sign));
+
+  auto signer = getTestSigner(false);
+  const Credentials rotated_credentials("akid2", "secret2");
+  for (const Credentials& credentials : {credentials_, credentials_, rotated_credentials}) {
+    EXPECT_CALL(*credentials_provider_, getCredentials()).WillOnce(Return(credentials));
+    Http::TestRequestHeaderMapImpl headers{
+        {":method", "GET"}, {":path", "/"}, {"host", "www.example.com"}};
+    ASSERT_TRUE(signer.signEmptyPayload(headers, "ap-southeast-2").ok());
+
+    const std::vector<std::string> authorization = absl::StrSplit(
+        headers.get(Http::CustomHeaders::get().Authorization)[0]->value().getStringView(),
+        "Signature=");
+    const std::vector<uint8_t> signature = Hex::decode(authorization[1]);
+    EC_KEY* ec_key = SigV4AKeyDerivation::derivePrivateKey(credentials.accessKeyId().value(),
+                                                           credentials.secretAccessKey().value());
+    SigV4AKeyDerivation::derivePublicKey(ec_key);
+    EXPECT_EQ(
+        1, ECDSA_verify(0, hash.data(), hash.size(), signature.data(), signature.size(), ec_key));
+    EC_KEY_free(ec_key);
+  }
+}
+
 TEST_F(SigV4ASignerImplTest, SignAndVerifyMultiRegion) {
 
   addMethod("GET");
@@ -1043,6 +1043,45 @@ TEST_F(DnsCacheImplTest, CacheHit) {
   EXPECT_THAT(*result.host_info_, DnsHostInfoEquals("10.0.0.1:80", "foo.com", false));
 }
 
+// The cache hits follow the re-resolutions of the host.
+TEST_F(DnsCacheImplTest, CacheHitAfterAddressChange) {
+  initialize();
+
+  MockLoadDnsCacheEntryCallbacks callbacks;
+  Network::DnsResolver::ResolveCb resolve_cb;
+  // Out of a sequence the latest timer expectation is matched first: the resolve timer is created
+  // before the timeout timer.
+  new NiceMock<Event::MockTimer>(&context_.server_factory_context_.dispatcher_);
+  Event::MockTimer* resolve_timer =
+      new Event::MockTimer(&context_.server_factory_context_.dispatcher_);
+  EXPECT_CALL(*resolver_, resolve("foo.com", _, _))
+      .Times(2)
+      .WillRepeatedly(DoAll(SaveArg<2>(&resolve_cb), Return(&resolver_->active_query_)));
+  EXPECT_CALL(update_callbacks_, onDnsHostAddOrUpdate("foo.com:80", _)).Times(2);
+  EXPECT_CALL(update_callbacks_, onDnsResolutionComplete("foo.com:80", _, _)).Times(2);
+  EXPECT_CALL(callbacks, onLoadDnsCacheComplete(_));
+  EXPECT_CALL(*resolve_timer, enableTimer(_, _)).Times(2);
+
+  auto result = dns_cache_->loadDnsCacheEntry("foo.com", 80, false, callbacks);
+  EXPECT_EQ(DnsCache::LoadDnsCacheEntryStatus::Loading, result.status_);
+  resolve_cb(Network::DnsResolver::ResolutionStatus::Success, "",
+             TestUtility::makeDnsResponse({"10.0.0.1"}));
+
+  result = dns_cache_->loadDnsCacheEntry("foo.com", 80, false, callbacks);
+  EXPECT_EQ(DnsCache::LoadDnsCacheEntryStatus::InCache, result.status_);
+  ASSERT_NE(absl::nullopt, result.host_info_);
+  EXPECT_THAT(*result.host_info_, DnsHostInfoEquals("10.0.0.1:80", "foo.com", false));
+
+  resolve_timer->invokeCallback();
+  resolve_cb(Network::DnsResolver::ResolutionStatus::Success, "",
+             TestUtility::makeDnsResponse({"10.0.0.2"}));
+
+  result = dns_cache_->loadDnsCacheEntry("foo.com", 80, false, callbacks);
+  EXPECT_EQ(DnsCache::LoadDnsCacheEntryStatus::InCache, result.status_);
+  ASSERT_NE(absl::nullopt, result.host_info_);
+  EXPECT_THAT(*result.host_info_, DnsHostInfoEquals("10.0.0.2:80", "foo.com", false));
+}
+
 // A successful resolve followed by a cache hit with different default port.
 TEST_F(DnsCacheImplTest, CacheHitWithDifferentDefaultPort) {
   initialize();
@@ -98,6 +98,7 @@ public:
   uint32_t tcpBacklogSize() const override { return ENVOY_TCP_BACKLOG_SIZE; }
   Init::Manager& initManager() override { return *init_manager_; }
   bool ignoreGlobalConnLimit() const override { return false; }
+  bool coalesceWrites() const override { return false; }
   bool shouldBypassOverloadManager() const override { return false; }
 
   // Network::FilterChainManager
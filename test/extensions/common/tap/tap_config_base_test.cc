@@ -7,6 +7,11 @@
 #include "source/common/buffer/buffer_impl.h"
 #include "source/extensions/common/tap/tap_config_base.h"
 
+#include "test/mocks/server/factory_context.h"
+#include "test/test_common/simulated_time_system.h"
+#include "test/test_common/utility.h"
+
+#include "gmock/gmock.h"
 #include "gtest/gtest.h"
 
 namespace Envoy {
@@ -160,6 +165,127 @@ TEST(TrimSlice, All) {
   }
 }
 
+class MockPerTapSinkHandle : public PerTapSinkHandle {
+public:
+  void submitTrace(TraceWrapperPtr&& trace, envoy::config::tap::v3::OutputSink::Format) override {
+    submitTrace_(*trace);
+  }
+
+  MOCK_METHOD(void, submitTrace_, (const envoy::data::tap::v3::TraceWrapper& trace));
+};
+
+class MockSink : public Sink {
+public:
+  MOCK_METHOD(PerTapSinkHandlePtr, createPerTapSinkHandle,
+              (uint64_t trace_id, envoy::config::tap::v3::OutputSink::OutputSinkTypeCase type));
+};
+
+class TestConfigImpl : public TapConfigBaseImpl {
+public:
+  TestConfigImpl(const envoy::config::tap::v3::TapConfig& proto_config, Sink* admin_streamer,
+                 SinkContext context)
+      : TapConfigBaseImpl(proto_config, admin_streamer, context) {}
+};
+
+class TapConfigBaseImplTest : public testing::Test {
+public:
+  TapConfigBaseImplTest() {
+    ON_CALL(factory_context_.server_factory_context_, timeSource())
+        .WillByDefault(testing::ReturnRef(time_system_));
+  }
+
+  void initialize(const std::string& yaml) {
+    envoy::config::tap::v3::TapConfig proto_config;
+    TestUtility::loadFromYaml(yaml, proto_config);
+    config_ = std::make_unique<TestConfigImpl>(proto_config, &sink_, factory_context_);
+  }
+
+  // Creates a tap whose traces are counted in submitted_.
+  PerTapSinkHandleManagerPtr createTap() {
+    auto handle = std::make_unique<MockPerTapSinkHandle>();
+    ON_CALL(*handle, submitTrace_(testing::_)).WillByDefault(testing::Invoke([this](auto&) {
+      submitted_++;
+    }));
+    EXPECT_CALL(sink_, createPerTapSinkHandle(testing::_, testing::_))
+        .WillOnce(testing::Return(testing::ByMove(std::move(handle))));
+    return config_->createPerTapSinkHandleManager(next_trace_id_++);
+  }
+
+  uint64_t counter(const std::string& name) {
+    return TestUtility::findCounter(factory_context_.server_factory_context_.store_, name)->value();
+  }
+
+  Event::SimulatedTimeSystem time_system_;
+  testing::NiceMock<Server::Configuration::MockFactoryContext> factory_context_;
+  testing::StrictMock<MockSink> sink_;
+  std::unique_ptr<TestConfigImpl> config_;
+  uint64_t next_trace_id_{};
+  uint64_t submitted_{};
+};
+
+// Verify the taps which are not sampled by tap_enabled drop all their traces.
+TEST_F(TapConfigBaseImplTest, TapEnabled) {
+  initialize(R"EOF(
+match:
+  any_match: true
+output_config:
+  sinks:
+    - format: JSON_BODY_AS_BYTES
+      streaming_admin: {}
+tap_enabled:
+  runtime_key: tap.enabled
+  default_value:
+    numerator: 50
+)EOF");
+  auto& snapshot = factory_context_.server_factory_context_.runtime_loader_.snapshot_;
+  EXPECT_CALL(snapshot, featureEnabled("tap.enabled",
+                                       testing::An<const envoy::type::v3::FractionalPercent&>()))
+      .WillOnce(testing::Return(false))
+      .WillOnce(testing::Return(true));
+
+  PerTapSinkHandleManagerPtr not_sampled = createTap();
+  PerTapSinkHandleManagerPtr sampled = createTap();
+  not_sampled->submitTrace(makeTraceWrapper());
+  not_sampled->submitTrace(makeTraceWrapper());
+  sampled->submitTrace(makeTraceWrapper());
+  sampled->submitTrace(makeTraceWrapper());
+  EXPECT_EQ(2U, submitted_);
+  EXPECT_EQ(1U, counter("tap.taps_not_sampled"));
+  EXPECT_EQ(0U, counter("tap.taps_rate_limited"));
+}
+
+// Verify the taps beyond max_taps_per_second drop all their traces, and those of the next second
+// don't.
+TEST_F(TapConfigBaseImplTest, MaxTapsPerSecond) {
+  initialize(R"EOF(
+match:
+  any_match: true
+output_config:
+  sinks:
+    - format: JSON_BODY_AS_BYTES
+      streaming_admin: {}
+max_taps_per_second: 2
+)EOF");
+
+  std::vector<PerTapSinkHandleManagerPtr> taps;
+  for (int i = 0; i < 3; ++i) {
+    taps.push_back(createTap());
+    taps.back()->submitTrace(makeTraceWrapper());
+  }
+  // The traces following the first one of a tap are admitted with it.
+  for (const auto& tap : taps) {
+    tap->submitTrace(makeTraceWrapper());
+  }
+  EXPECT_EQ(4U, submitted_);
+  EXPECT_EQ(1U, counter("tap.taps_rate_limited"));
+
+  time_system_.advanceTimeWait(std::chrono::seconds(1));
+  createTap()->submitTrace(makeTraceWrapper());
+  EXPECT_EQ(5U, submitted_);
+  EXPECT_EQ(1U, counter("tap.taps_rate_limited"));
+  EXPECT_EQ(0U, counter("tap.taps_not_sampled"));
+}
+
 } // namespace
 } // namespace Tap
 } // namespace Common
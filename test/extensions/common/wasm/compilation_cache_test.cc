@@ -0,0 +1,91 @@
+#include "source/extensions/common/wasm/compilation_cache.h"
+
+#include "test/test_common/environment.h"
+#include "test/test_common/utility.h"
+
+#include "gtest/gtest.h"
+#include "include/proxy-wasm/bytecode_util.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace Common {
+namespace Wasm {
+namespace {
+
+// The header of an empty module.
+const std::string EmptyModule{"\0asm\x01\0\0\0", 8};
+constexpr absl::string_view SectionName = "precompiled_test";
+
+class CompilationCacheTest : public testing::Test {
+protected:
+  CompilationCacheTest()
+      : api_(Api::createApiForTest()),
+        directory_(TestEnvironment::temporaryPath("wasm_compilation_cache")),
+        cache_(api_->fileSystem(), directory_) {
+    TestEnvironment::removePath(directory_);
+  }
+  ~CompilationCacheTest() override { TestEnvironment::removePath(directory_); }
+
+  static std::string precompiledSection(const std::string& code) {
+    std::string_view precompiled;
+    EXPECT_TRUE(proxy_wasm::BytecodeUtil::getCustomSection(code, SectionName, precompiled));
+    return std::string(precompiled);
+  }
+
+  Api::ApiPtr api_;
+  const std::string directory_;
+  CompilationCache cache_;
+};
+
+TEST_F(CompilationCacheTest, CompiledModuleIsReadFromTheCache) {
+  int compilations = 0;
+  const PrecompileFn precompile = [&compilations](absl::string_view bytecode) {
+    EXPECT_EQ(EmptyModule, bytecode);
+    compilations++;
+    return std::string("compiled");
+  };
+
+  absl::optional<PrecompiledCode> precompiled =
+      cache_.getOrCreate(EmptyModule, SectionName, precompile);
+  ASSERT_TRUE(precompiled.has_value());
+  EXPECT_FALSE(precompiled->cache_hit);
+  EXPECT_EQ("compiled", precompiledSection(precompiled->code));
+
+  // Another cache of the same directory, as on a later start, reads the compiled module.
+  CompilationCache cache(api_->fileSystem(), directory_);
+  absl::optional<PrecompiledCode> cached = cache.getOrCreate(EmptyModule, SectionName, precompile);
+  ASSERT_TRUE(cached.has_value());
+  EXPECT_TRUE(cached->cache_hit);
+  EXPECT_EQ(precompiled->code, cached->code);
+  EXPECT_EQ(1, compilations);
+
+  // Another runtime compiles the code again.
+  EXPECT_FALSE(cache_.getOrCreate(EmptyModule, "precompiled_other", precompile)->cache_hit);
+  EXPECT_EQ(2, compilations);
+}
+
+TEST_F(CompilationCacheTest, NotCachedIfTheRuntimeCantPrecompile) {
+  EXPECT_FALSE(cache_.getOrCreate(EmptyModule, SectionName, [](absl::string_view) { return ""; }));
+  EXPECT_FALSE(api_->fileSystem().directoryExists(directory_));
+
+  // Runtimes without a precompiled section aren't asked to compile the code.
+  EXPECT_FALSE(cache_.getOrCreate(EmptyModule, "", [](absl::string_view) {
+    ADD_FAILURE();
+    return "compiled";
+  }));
+}
+
+TEST_F(CompilationCacheTest, CodeWithPrecompiledModuleIsUsedAsIs) {
+  const std::string code =
+      CompilationCache::appendCustomSection(EmptyModule, SectionName, "precompiled");
+  EXPECT_FALSE(cache_.getOrCreate(code, SectionName, [](absl::string_view) {
+    ADD_FAILURE();
+    return "compiled";
+  }));
+}
+
+} // namespace
+} // namespace Wasm
+} // namespace Common
+} // namespace Extensions
+} // namespace Envoy
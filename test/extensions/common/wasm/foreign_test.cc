@@ -1,8 +1,10 @@
+#include "source/common/buffer/buffer_impl.h"
 #include "source/common/event/dispatcher_impl.h"
 #include "source/common/network/filter_state_dst_address.h"
 #include "source/common/stats/isolated_store_impl.h"
 #include "source/common/tcp_proxy/tcp_proxy.h"
 #include "source/extensions/clusters/original_dst/original_dst_cluster.h"
+#include "source/extensions/common/wasm/ext/header_map_and_buffer.pb.h"
 #include "source/extensions/common/wasm/ext/set_envoy_filter_state.pb.h"
 #include "source/extensions/common/wasm/wasm.h"
 
@@ -12,13 +14,20 @@
 
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
+#include "include/proxy-wasm/pairs_util.h"
 
 namespace Envoy {
 namespace Extensions {
 namespace Common {
 namespace Wasm {
 
-class TestContext : public Context {};
+class TestContext : public Context {
+public:
+  void setRequestHeaders(Http::RequestHeaderMap* request_headers) {
+    request_headers_ = request_headers;
+  }
+  void setRequestBodyBuffer(::Envoy::Buffer::Instance* buffer) { request_body_buffer_ = buffer; }
+};
 
 class ForeignTest : public testing::Test {
 public:
@@ -113,6 +122,119 @@ TEST_F(ForeignTest, ForeignFunctionSetEnvoyFilterTest) {
       Upstream::OriginalDstClusterFilterStateKey));
 }
 
+TEST_F(ForeignTest, ForeignFunctionHeaderMapBatchTest) {
+  Stats::IsolatedStoreImpl stats_store;
+  Api::ApiPtr api = Api::createApiForTest(stats_store);
+  Upstream::MockClusterManager cluster_manager;
+  Event::DispatcherPtr dispatcher(api->allocateDispatcher("wasm_test"));
+  auto scope = Stats::ScopeSharedPtr(stats_store.createScope("wasm."));
+  testing::NiceMock<LocalInfo::MockLocalInfo> local_info;
+
+  envoy::extensions::wasm::v3::PluginConfig plugin_config;
+  auto plugin = std::make_shared<Extensions::Common::Wasm::Plugin>(
+      plugin_config, envoy::config::core::v3::TrafficDirection::UNSPECIFIED, local_info, nullptr);
+  Wasm wasm(plugin->wasmConfig(), "", scope, *api, cluster_manager, *dispatcher);
+  Http::TestRequestHeaderMapImpl request_headers{{"a", "1"}, {"b", "2"}, {"b", "3"}, {"c", "4"}};
+  ctx_.setRequestHeaders(&request_headers);
+  proxy_wasm::current_context_ = &ctx_;
+  std::string out;
+  auto alloc_result = [&out](size_t size) {
+    out.resize(size);
+    return out.data();
+  };
+
+  auto mutate = proxy_wasm::getForeignFunction("mutate_header_map");
+  ASSERT_NE(mutate, nullptr);
+  EXPECT_EQ(WasmResult::BadArgument, mutate(wasm, "bad_arg", alloc_result));
+
+  using Mutation = envoy::source::extensions::common::wasm::HeaderMapMutation;
+  envoy::source::extensions::common::wasm::MutateHeaderMapArguments mutate_args;
+  mutate_args.set_map_type(static_cast<uint32_t>(WasmHeaderMapType::RequestHeaders));
+  auto* mutation = mutate_args.add_mutations();
+  mutation->set_key("a");
+  mutation->set_value("5");
+  mutation = mutate_args.add_mutations();
+  mutation->set_operation(Mutation::Replace);
+  mutation->set_key("c");
+  mutation->set_value("6");
+  mutation = mutate_args.add_mutations();
+  mutation->set_operation(Mutation::Remove);
+  mutation->set_key("b");
+  std::string in;
+  mutate_args.SerializeToString(&in);
+  EXPECT_EQ(WasmResult::Ok, mutate(wasm, in, alloc_result));
+  EXPECT_EQ(request_headers,
+            (Http::TestRequestHeaderMapImpl{{"a", "1"}, {"c", "6"}, {"a", "5"}}));
+
+  auto get = proxy_wasm::getForeignFunction("get_header_map_values");
+  ASSERT_NE(get, nullptr);
+  envoy::source::extensions::common::wasm::GetHeaderMapValuesArguments get_args;
+  get_args.set_map_type(static_cast<uint32_t>(WasmHeaderMapType::RequestHeaders));
+  get_args.add_keys("a");
+  get_args.add_keys("b");
+  get_args.add_keys("c");
+  get_args.SerializeToString(&in);
+  EXPECT_EQ(WasmResult::Ok, get(wasm, in, alloc_result));
+  EXPECT_EQ((Pairs{{"a", "1"}, {"a", "5"}, {"c", "6"}}), proxy_wasm::PairsUtil::toPairs(out));
+
+  // The response headers aren't set.
+  get_args.set_map_type(static_cast<uint32_t>(WasmHeaderMapType::ResponseHeaders));
+  get_args.SerializeToString(&in);
+  EXPECT_EQ(WasmResult::BadArgument, get(wasm, in, alloc_result));
+}
+
+TEST_F(ForeignTest, ForeignFunctionSearchBufferTest) {
+  Stats::IsolatedStoreImpl stats_store;
+  Api::ApiPtr api = Api::createApiForTest(stats_store);
+  Upstream::MockClusterManager cluster_manager;
+  Event::DispatcherPtr dispatcher(api->allocateDispatcher("wasm_test"));
+  auto scope = Stats::ScopeSharedPtr(stats_store.createScope("wasm."));
+  testing::NiceMock<LocalInfo::MockLocalInfo> local_info;
+
+  envoy::extensions::wasm::v3::PluginConfig plugin_config;
+  auto plugin = std::make_shared<Extensions::Common::Wasm::Plugin>(
+      plugin_config, envoy::config::core::v3::TrafficDirection::UNSPECIFIED, local_info, nullptr);
+  Wasm wasm(plugin->wasmConfig(), "", scope, *api, cluster_manager, *dispatcher);
+  // The pattern spans two slices.
+  ::Envoy::Buffer::OwnedImpl body;
+  body.appendSliceForTest("hello wo");
+  body.appendSliceForTest("rld, hello");
+  ctx_.setRequestBodyBuffer(&body);
+  proxy_wasm::current_context_ = &ctx_;
+  std::string out;
+  auto alloc_result = [&out](size_t size) {
+    out.resize(size);
+    return out.data();
+  };
+
+  auto function = proxy_wasm::getForeignFunction("search_buffer");
+  ASSERT_NE(function, nullptr);
+  EXPECT_EQ(WasmResult::BadArgument, function(wasm, "bad_arg", alloc_result));
+
+  envoy::source::extensions::common::wasm::SearchBufferArguments args;
+  args.set_buffer_type(static_cast<uint32_t>(WasmBufferType::HttpRequestBody));
+  args.add_patterns("world");
+  args.add_patterns("hello");
+  args.add_patterns("bye");
+  args.set_start(1);
+  std::string in;
+  args.SerializeToString(&in);
+  EXPECT_EQ(WasmResult::Ok, function(wasm, in, alloc_result));
+  envoy::source::extensions::common::wasm::SearchBufferResult result;
+  ASSERT_TRUE(result.ParseFromString(out));
+  EXPECT_THAT(result.offsets(), testing::ElementsAre(6, 13, -1));
+
+  args.set_start(body.length() + 1);
+  args.SerializeToString(&in);
+  EXPECT_EQ(WasmResult::BadArgument, function(wasm, in, alloc_result));
+
+  // The context has no plugin configuration.
+  args.set_buffer_type(static_cast<uint32_t>(WasmBufferType::PluginConfiguration));
+  args.set_start(0);
+  args.SerializeToString(&in);
+  EXPECT_EQ(WasmResult::NotFound, function(wasm, in, alloc_result));
+}
+
 } // namespace Wasm
 } // namespace Common
 } // namespace Extensions
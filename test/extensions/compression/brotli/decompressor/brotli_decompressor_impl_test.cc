@@ -251,6 +251,53 @@ TEST_F(BrotliDecompressorImplTest, CompressDecompressOfMultipleSlices) {
   EXPECT_EQ(0, stats_store.counterFromString("test.brotli_error").value());
 }
 
+// Exercises the "dcb" streams, which start with the hash of the dictionary they are compressed
+// with, and only decompress with the same dictionary.
+TEST_F(BrotliDecompressorImplTest, CompressAndDecompressWithDictionary) {
+  const std::string dictionary_content = "a shared dictionary of the common substrings";
+  auto compressor_dictionary = std::make_shared<const Brotli::Compressor::PreparedDictionary>(
+      std::string(dictionary_content));
+  Brotli::Compressor::BrotliCompressorImpl compressor{
+      default_quality,
+      default_window_bits,
+      default_input_block_bits,
+      false,
+      Brotli::Compressor::BrotliCompressorImpl::EncoderMode::Default,
+      4096,
+      compressor_dictionary};
+
+  const std::string original_text = "the common substrings of a shared dictionary";
+  Buffer::OwnedImpl buffer{original_text};
+  compressor.compress(buffer, Envoy::Compression::Compressor::State::Finish);
+  EXPECT_EQ(compressor_dictionary->streamHeader(),
+            buffer.toString().substr(0, Common::DictionaryStreamHeaderSize));
+
+  // The header may be split across slices.
+  Buffer::OwnedImpl split_buffer;
+  const std::string compressed = buffer.toString();
+  split_buffer.appendSliceForTest(compressed.substr(0, 3));
+  split_buffer.appendSliceForTest(compressed.substr(3));
+
+  Stats::IsolatedStoreImpl stats_store{};
+  BrotliDecompressorImpl decompressor{
+      *stats_store.rootScope(), "test.", 4096, false,
+      std::make_shared<const Common::Dictionary>(std::string(dictionary_content))};
+  Buffer::OwnedImpl output_buffer;
+  decompressor.decompress(split_buffer, output_buffer);
+  EXPECT_EQ(original_text, output_buffer.toString());
+  EXPECT_EQ(0, stats_store.counterFromString("test.brotli_error").value());
+
+  // A stream compressed with another dictionary isn't decompressed.
+  BrotliDecompressorImpl other_decompressor{
+      *stats_store.rootScope(), "test.", 4096, false,
+      std::make_shared<const Common::Dictionary>("another dictionary")};
+  Buffer::OwnedImpl other_output_buffer;
+  other_decompressor.decompress(buffer, other_output_buffer);
+  EXPECT_EQ(0, other_output_buffer.length());
+  EXPECT_EQ(1, stats_store.counterFromString("test.brotli_error").value());
+  EXPECT_EQ(1, stats_store.counterFromString("test.brotli_bad_dictionary").value());
+}
+
 class UncommonParamsTest : public BrotliDecompressorImplTest,
                            public testing::WithParamInterface<std::tuple<bool, bool>> {
 protected:
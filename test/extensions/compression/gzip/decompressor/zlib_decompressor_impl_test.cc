@@ -4,6 +4,7 @@
 #include "source/extensions/compression/gzip/compressor/zlib_compressor_impl.h"
 #include "source/extensions/compression/gzip/decompressor/zlib_decompressor_impl.h"
 
+#include "test/test_common/test_runtime.h"
 #include "test/test_common/utility.h"
 
 #include "gtest/gtest.h"
@@ -285,6 +286,54 @@ TEST_F(ZlibDecompressorImplTest, CompressDecompressWithUncommonParams) {
   }
 }
 
+// Exercises the decompression into the chunk of the decompressor, which is copied to the output.
+TEST_F(ZlibDecompressorImplTest, DecompressIntoChunks) {
+  TestScopedRuntime scoped_runtime;
+  scoped_runtime.mergeValues(
+      {{"envoy.reloadable_features.zlib_decompress_into_reservations", "false"}});
+
+  testcompressDecompressWithUncommonParams(
+      Extensions::Compression::Gzip::Compressor::ZlibCompressorImpl::CompressionLevel::Standard,
+      Extensions::Compression::Gzip::Compressor::ZlibCompressorImpl::CompressionStrategy::Standard,
+      gzip_window_bits, memory_level);
+
+  Buffer::OwnedImpl buffer;
+  Extensions::Compression::Gzip::Compressor::ZlibCompressorImpl compressor;
+  compressor.init(
+      Extensions::Compression::Gzip::Compressor::ZlibCompressorImpl::CompressionLevel::Standard,
+      Extensions::Compression::Gzip::Compressor::ZlibCompressorImpl::CompressionStrategy::Standard,
+      gzip_window_bits, memory_level);
+  buffer.add(std::string(10000, ' '));
+  compressor.compress(buffer, Envoy::Compression::Compressor::State::Finish);
+
+  Buffer::OwnedImpl output_buffer;
+  ZlibDecompressorImpl decompressor{stats_scope_, "test.", 4096, 100};
+  decompressor.init(gzip_window_bits);
+  decompressor.decompress(buffer, output_buffer);
+  EXPECT_EQ(stats_store_.counterFromString("test.zlib_data_error").value(), 1);
+}
+
+// Tests that the decompression stops within a reservation of the limit of the ratio.
+TEST_F(ZlibDecompressorImplTest, StopsExcessiveCompressionRatioWithinReservation) {
+  Buffer::OwnedImpl buffer;
+  Extensions::Compression::Gzip::Compressor::ZlibCompressorImpl compressor;
+  compressor.init(
+      Extensions::Compression::Gzip::Compressor::ZlibCompressorImpl::CompressionLevel::Standard,
+      Extensions::Compression::Gzip::Compressor::ZlibCompressorImpl::CompressionStrategy::Standard,
+      gzip_window_bits, memory_level);
+  buffer.add(std::string(10 * 1024 * 1024, ' '));
+  compressor.compress(buffer, Envoy::Compression::Compressor::State::Finish);
+  const uint64_t limit = 100 * buffer.length();
+
+  Buffer::OwnedImpl output_buffer;
+  ZlibDecompressorImpl decompressor{stats_scope_, "test.", 4096, 100};
+  decompressor.init(gzip_window_bits);
+  decompressor.decompress(buffer, output_buffer);
+  EXPECT_EQ(stats_store_.counterFromString("test.zlib_data_error").value(), 1);
+  EXPECT_GT(output_buffer.length(), limit);
+  EXPECT_LE(output_buffer.length(), limit + 16 * 1024);
+}
+
 TEST_F(ZlibDecompressorImplTest, CompressDecompressOfMultipleSlices) {
   Buffer::OwnedImpl buffer;
   Buffer::OwnedImpl accumulation_buffer;
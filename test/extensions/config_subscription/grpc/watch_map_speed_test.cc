@@ -0,0 +1,86 @@
+// Note: this should be run with --compilation_mode=opt, and would benefit from a
+// quiescent system with disabled cstate power management.
+
+#include <memory>
+#include <vector>
+
+#include "envoy/config/endpoint/v3/endpoint.pb.h"
+#include "envoy/service/discovery/v3/discovery.pb.h"
+
+#include "source/common/config/opaque_resource_decoder_impl.h"
+#include "source/common/protobuf/message_validator_impl.h"
+#include "source/extensions/config_subscription/grpc/watch_map.h"
+
+#include "test/benchmark/main.h"
+#include "test/mocks/config/custom_config_validators.h"
+
+#include "absl/strings/str_cat.h"
+#include "benchmark/benchmark.h"
+
+using ::benchmark::State;
+using Envoy::benchmark::skipExpensiveBenchmarks;
+
+namespace Envoy {
+namespace Config {
+namespace {
+
+class NullCallbacks : public SubscriptionCallbacks {
+public:
+  absl::Status onConfigUpdate(const std::vector<DecodedResourceRef>&,
+                              const std::string&) override {
+    return absl::OkStatus();
+  }
+  absl::Status onConfigUpdate(const std::vector<DecodedResourceRef>&,
+                              const Protobuf::RepeatedPtrField<std::string>&,
+                              const std::string&) override {
+    return absl::OkStatus();
+  }
+  void onConfigUpdateFailed(ConfigUpdateFailureReason, const EnvoyException*) override {}
+};
+
+// Delivers a delta update of each of the resources, as EDS over ADS does, with a watch per
+// resource as the EDS clusters each have.
+void deltaUpdate(State& state) {
+  const uint32_t num_resources = skipExpensiveBenchmarks() ? 100 : state.range(0);
+  ProtobufMessage::NullValidationVisitorImpl validation_visitor;
+  OpaqueResourceDecoderImpl<envoy::config::endpoint::v3::ClusterLoadAssignment> resource_decoder(
+      validation_visitor, "cluster_name");
+  testing::NiceMock<MockCustomConfigValidators> config_validators;
+  WatchMap watch_map(false, "type.googleapis.com/envoy.config.endpoint.v3.ClusterLoadAssignment",
+                     config_validators, {});
+  NullCallbacks callbacks;
+
+  Protobuf::RepeatedPtrField<envoy::service::discovery::v3::Resource> added_resources;
+  std::vector<Watch*> watches;
+  for (uint32_t i = 0; i < num_resources; ++i) {
+    const std::string name = absl::StrCat("cluster_", i);
+    Watch* watch = watch_map.addWatch(callbacks, resource_decoder);
+    watch_map.updateWatchInterest(watch, {name});
+    watches.push_back(watch);
+
+    envoy::config::endpoint::v3::ClusterLoadAssignment cluster_load_assignment;
+    cluster_load_assignment.set_cluster_name(name);
+    auto* resource = added_resources.Add();
+    resource->set_name(name);
+    resource->set_version("1");
+    resource->mutable_resource()->PackFrom(cluster_load_assignment);
+  }
+
+  for (auto _ : state) { // NOLINT: Silences warning about dead store
+    watch_map.onConfigUpdate(added_resources, {}, "1");
+  }
+
+  for (Watch* watch : watches) {
+    watch_map.updateWatchInterest(watch, {});
+    watch_map.removeWatch(watch);
+  }
+}
+
+BENCHMARK(deltaUpdate)
+    ->RangeMultiplier(10)
+    ->Range(1000, 1000000)
+    ->Unit(::benchmark::kMillisecond);
+
+} // namespace
+} // namespace Config
+} // namespace Envoy
@@ -194,6 +194,28 @@ TEST(WatchMapTest, Basic) {
   }
 }
 
+// A watch interested in the wildcard and in a name receives each resource of that name once.
+TEST(WatchMapTest, WildcardAndNamedInterest) {
+  MockSubscriptionCallbacks callbacks;
+  TestUtility::TestOpaqueResourceDecoderImpl<envoy::config::endpoint::v3::ClusterLoadAssignment>
+      resource_decoder("cluster_name");
+  NiceMock<MockCustomConfigValidators> config_validators;
+  WatchMap watch_map(false, "ClusterLoadAssignmentType", config_validators, {});
+  Watch* watch = watch_map.addWatch(callbacks, resource_decoder);
+  watch_map.updateWatchInterest(watch, {"*", "alice"});
+
+  Protobuf::RepeatedPtrField<ProtobufWkt::Any> updated_resources;
+  envoy::config::endpoint::v3::ClusterLoadAssignment alice;
+  alice.set_cluster_name("alice");
+  updated_resources.Add()->PackFrom(alice);
+  envoy::config::endpoint::v3::ClusterLoadAssignment bob;
+  bob.set_cluster_name("bob");
+  updated_resources.Add()->PackFrom(bob);
+
+  expectDeltaAndSotwUpdate(callbacks, {alice, bob}, {}, "version1");
+  doDeltaAndSotwUpdate(watch_map, updated_resources, {}, "version1");
+}
+
 // Checks the following:
 // First watch on a resource name ==> updateWatchInterest() returns "add it to subscription"
 // Second watch on that name ==> updateWatchInterest() returns nothing about that name
@@ -54,6 +54,45 @@ TEST(Evaluator, Activation) {
   EXPECT_TRUE(activation->FindValue("upstream_filter_state", &arena).has_value());
 }
 
+TEST(Evaluator, ActivationMemoizesTheAttributes) {
+  NiceMock<StreamInfo::MockStreamInfo> info;
+  ProtobufWkt::Arena arena;
+  const auto activation = createActivation(nullptr, info, nullptr, nullptr, nullptr);
+  const auto request = activation->FindValue("request", &arena);
+  ASSERT_TRUE(request.has_value() && request->IsMap());
+  const auto request_again = activation->FindValue("request", &arena);
+  ASSERT_TRUE(request_again.has_value() && request_again->IsMap());
+  EXPECT_EQ(request->MapOrDie(), request_again->MapOrDie());
+  EXPECT_FALSE(activation->FindValue("unknown", &arena).has_value());
+}
+
+TEST(Evaluator, BuilderSharesTheExpressions) {
+  BuilderInstance builder(createBuilder(nullptr));
+  google::api::expr::v1alpha1::Expr true_expr;
+  TestUtility::loadFromYaml("const_expr: {bool_value: true}", true_expr);
+  google::api::expr::v1alpha1::Expr false_expr;
+  TestUtility::loadFromYaml("const_expr: {bool_value: false}", false_expr);
+
+  ExpressionSharedPtr expression = builder.createExpression(true_expr);
+  EXPECT_EQ(expression, builder.createExpression(true_expr));
+  EXPECT_NE(expression, builder.createExpression(false_expr));
+
+  // The expression doesn't depend on the representation it was created from.
+  NiceMock<StreamInfo::MockStreamInfo> info;
+  Http::TestRequestHeaderMapImpl headers;
+  true_expr.mutable_const_expr()->set_bool_value(false);
+  EXPECT_TRUE(matches(*expression, info, headers));
+
+  // The expressions no longer in use are created again.
+  expression.reset();
+  for (int id = 0; id < 64; id++) {
+    false_expr.set_id(id);
+    EXPECT_FALSE(matches(*builder.createExpression(false_expr), info, headers));
+  }
+  true_expr.mutable_const_expr()->set_bool_value(true);
+  EXPECT_TRUE(matches(*builder.createExpression(true_expr), info, headers));
+}
+
 } // namespace
 } // namespace Expr
 } // namespace Common
@@ -133,6 +133,46 @@ TEST_F(LuaTest, YieldAndResume) {
   lua_gc(cr->luaState(), LUA_GCCOLLECT, 0);
 }
 
+// Coroutines which ran to completion are pooled and started again, the others aren't.
+TEST_F(LuaTest, CoroutinePooling) {
+  const std::string SCRIPT{R"EOF(
+    calls = 0
+    function callMe()
+      calls = calls + 1
+      if calls == 2 then
+        error("second call")
+      end
+      return calls
+    end
+  )EOF"};
+
+  setup(SCRIPT);
+  state_->setMaxPooledCoroutines(1);
+  const int callMeRef = state_->getGlobalRef(state_->registerGlobal("callMe", initializers_));
+
+  CoroutinePtr cr1(state_->createCoroutine());
+  Coroutine* const pooled = cr1.get();
+  cr1->start(callMeRef, 0, yield_callback_);
+  EXPECT_TRUE(cr1->reusable());
+  state_->releaseCoroutine(std::move(cr1));
+
+  // The pooled coroutine is started again, from an empty stack.
+  CoroutinePtr cr2(state_->createCoroutine());
+  EXPECT_EQ(pooled, cr2.get());
+  EXPECT_EQ(cr2->state(), Coroutine::State::NotStarted);
+  EXPECT_EQ(0, lua_gettop(cr2->luaState()));
+  EXPECT_THROW_WITH_REGEX(cr2->start(callMeRef, 0, yield_callback_), EnvoyException,
+                          "second call");
+  EXPECT_FALSE(cr2->reusable());
+  state_->releaseCoroutine(std::move(cr2));
+
+  // The failed coroutine wasn't pooled.
+  CoroutinePtr cr3(state_->createCoroutine());
+  EXPECT_NE(nullptr, cr3);
+  cr3->start(callMeRef, 0, yield_callback_);
+  EXPECT_EQ(3, lua_tointeger(cr3->luaState(), -1));
+}
+
 // Mark dead/live and ref counting across coroutines.
 TEST_F(LuaTest, MarkDead) {
   const std::string SCRIPT{R"EOF(
@@ -18,6 +18,7 @@
 #include "gtest/gtest.h"
 
 using testing::Const;
+using testing::Return;
 using testing::ReturnPointee;
 using testing::ReturnRef;
 
@@ -475,6 +476,74 @@ TEST(RoleBasedAccessControlEngineImpl, ConjunctiveCondition) {
   checkEngine(engine, false, LogResult::Undecided, info, conn, headers);
 }
 
+// Test that the policies indexed by source IP, authenticated principal name and path match the
+// same requests as when evaluated in order, the first matching one being the effective policy.
+TEST(RoleBasedAccessControlEngineImpl, IndexedPolicies) {
+  NiceMock<Server::Configuration::MockServerFactoryContext> factory_context;
+  envoy::config::rbac::v3::RBAC rbac;
+  TestUtility::loadFromYaml(R"EOF(
+action: ALLOW
+policies:
+  a-remote-ip:
+    permissions: [{any: true}]
+    principals: [{remote_ip: {address_prefix: 10.0.0.0, prefix_len: 8}}]
+  b-principal-name:
+    permissions: [{any: true}]
+    principals:
+    - authenticated: {principal_name: {exact: "spiffe://cluster.local/ns/foo/sa/bar"}}
+    - direct_remote_ip: {address_prefix: 172.16.0.0, prefix_len: 12}
+  c-path:
+    permissions: [{url_path: {path: {prefix: "/admin"}}}, {url_path: {path: {exact: "/login"}}}]
+    principals: [{any: true}]
+  d-port:
+    permissions: [{destination_port: 8080}]
+    principals: [{any: true}]
+)EOF",
+                            rbac);
+  RBAC::RoleBasedAccessControlEngineImpl engine(rbac, ProtobufMessage::getStrictValidationVisitor(),
+                                                factory_context);
+
+  const std::vector<std::string> uri_sans{"spiffe://cluster.local/ns/foo/sa/bar"};
+  const std::vector<std::string> no_sans;
+  const std::string subject = "subject";
+  auto ssl = std::make_shared<NiceMock<Ssl::MockConnectionInfo>>();
+  ON_CALL(*ssl, dnsSansPeerCertificate()).WillByDefault(Return(no_sans));
+  ON_CALL(*ssl, subjectPeerCertificate()).WillByDefault(ReturnRef(subject));
+
+  const auto effective_policy = [&](const std::string& remote, const std::string& direct_remote,
+                                    uint32_t local_port, bool authenticated,
+                                    const std::string& path) -> std::string {
+    NiceMock<Envoy::Network::MockConnection> conn;
+    NiceMock<StreamInfo::MockStreamInfo> info;
+    conn.stream_info_.downstream_connection_info_provider_->setRemoteAddress(
+        Envoy::Network::Utility::parseInternetAddressNoThrow(remote, 1000, false));
+    info.downstream_connection_info_provider_->setRemoteAddress(
+        Envoy::Network::Utility::parseInternetAddressNoThrow(remote, 1000, false));
+    info.downstream_connection_info_provider_->setDirectRemoteAddressForTest(
+        Envoy::Network::Utility::parseInternetAddressNoThrow(direct_remote, 1000, false));
+    info.downstream_connection_info_provider_->setLocalAddress(
+        Envoy::Network::Utility::parseInternetAddressNoThrow("1.2.3.4", local_port, false));
+    ON_CALL(*ssl, uriSanPeerCertificate())
+        .WillByDefault(Return(authenticated ? uri_sans : no_sans));
+    ON_CALL(Const(conn), ssl())
+        .WillByDefault(Return(authenticated ? ssl : Ssl::ConnectionInfoConstSharedPtr{}));
+    Envoy::Http::TestRequestHeaderMapImpl headers{{":path", path}};
+    std::string effective_policy_id;
+    if (!engine.handleAction(conn, headers, info, &effective_policy_id)) {
+      return "";
+    }
+    return effective_policy_id;
+  };
+
+  EXPECT_EQ("a-remote-ip", effective_policy("10.1.2.3", "10.1.2.3", 80, true, "/admin/users"));
+  EXPECT_EQ("b-principal-name", effective_policy("192.168.0.1", "192.168.0.1", 80, true, "/"));
+  EXPECT_EQ("b-principal-name", effective_policy("192.168.0.1", "172.20.0.1", 80, false, "/"));
+  EXPECT_EQ("c-path", effective_policy("192.168.0.1", "192.168.0.1", 80, false, "/admin?a=b"));
+  EXPECT_EQ("c-path", effective_policy("192.168.0.1", "192.168.0.1", 8080, false, "/login"));
+  EXPECT_EQ("d-port", effective_policy("192.168.0.1", "192.168.0.1", 8080, false, "/login/x"));
+  EXPECT_EQ("", effective_policy("192.168.0.1", "192.168.0.1", 80, false, "/other"));
+}
+
 TEST(RoleBasedAccessControlMatcherEngineImpl, Disabled) {
   xds::type::matcher::v3::Matcher matcher;
 
@@ -0,0 +1,107 @@
+// Note: this should be run with --compilation_mode=opt, and would benefit from a
+// quiescent system with disabled cstate power management.
+
+#include <string>
+
+#include "envoy/config/rbac/v3/rbac.pb.h"
+
+#include "source/common/network/utility.h"
+#include "source/extensions/filters/common/rbac/engine_impl.h"
+
+#include "test/mocks/network/mocks.h"
+#include "test/mocks/server/factory_context.h"
+#include "test/mocks/ssl/mocks.h"
+#include "test/mocks/stream_info/mocks.h"
+#include "test/test_common/utility.h"
+
+#include "absl/strings/str_cat.h"
+#include "benchmark/benchmark.h"
+
+using testing::Const;
+using testing::NiceMock;
+using testing::Return;
+using testing::ReturnRef;
+
+namespace Envoy {
+namespace Extensions {
+namespace Filters {
+namespace Common {
+namespace RBAC {
+namespace {
+
+constexpr int NumPolicies = 2000;
+
+// Returns the policies of a mesh listener: half of them allow a /24 of workloads, the other half
+// a SPIFFE identity, each on its own path prefix. If indexable is false, the principals are
+// wrapped in or_ids, which keeps the policies from being indexed.
+envoy::config::rbac::v3::RBAC makeRules(bool indexable) {
+  envoy::config::rbac::v3::RBAC rbac;
+  rbac.set_action(envoy::config::rbac::v3::RBAC::ALLOW);
+  for (int i = 0; i < NumPolicies; ++i) {
+    envoy::config::rbac::v3::Policy& policy =
+        (*rbac.mutable_policies())[absl::StrCat("policy-", i)];
+    policy.add_permissions()->mutable_url_path()->mutable_path()->set_prefix(
+        absl::StrCat("/service-", i % 100, "/"));
+    envoy::config::rbac::v3::Principal principal;
+    if (i % 2 == 0) {
+      principal.mutable_remote_ip()->set_address_prefix(
+          absl::StrCat("10.", (i / 256) % 256, ".", i % 256, ".0"));
+      principal.mutable_remote_ip()->mutable_prefix_len()->set_value(24);
+    } else {
+      principal.mutable_authenticated()->mutable_principal_name()->set_exact(
+          absl::StrCat("spiffe://cluster.local/ns/default/sa/workload-", i));
+    }
+    if (indexable) {
+      *policy.add_principals() = principal;
+    } else {
+      *policy.add_principals()->mutable_or_ids()->add_ids() = principal;
+    }
+  }
+  return rbac;
+}
+
+void benchmarkEngine(benchmark::State& state, bool indexable) {
+  NiceMock<Server::Configuration::MockServerFactoryContext> factory_context;
+  RoleBasedAccessControlEngineImpl engine(makeRules(indexable),
+                                          ProtobufMessage::getStrictValidationVisitor(),
+                                          factory_context);
+
+  // A request of the last workload allowed by identity.
+  const std::vector<std::string> uri_sans{absl::StrCat(
+      "spiffe://cluster.local/ns/default/sa/workload-", NumPolicies - 1)};
+  const std::vector<std::string> dns_sans;
+  const std::string subject;
+  auto ssl = std::make_shared<NiceMock<Ssl::MockConnectionInfo>>();
+  ON_CALL(*ssl, uriSanPeerCertificate()).WillByDefault(Return(uri_sans));
+  ON_CALL(*ssl, dnsSansPeerCertificate()).WillByDefault(Return(dns_sans));
+  ON_CALL(*ssl, subjectPeerCertificate()).WillByDefault(ReturnRef(subject));
+  NiceMock<Network::MockConnection> connection;
+  ON_CALL(Const(connection), ssl()).WillByDefault(Return(ssl));
+  NiceMock<StreamInfo::MockStreamInfo> info;
+  const auto address = Network::Utility::parseInternetAddressNoThrow("192.168.0.1", 1000, false);
+  connection.stream_info_.downstream_connection_info_provider_->setRemoteAddress(address);
+  info.downstream_connection_info_provider_->setRemoteAddress(address);
+  info.downstream_connection_info_provider_->setDirectRemoteAddressForTest(address);
+  Http::TestRequestHeaderMapImpl headers{
+      {":path", absl::StrCat("/service-", (NumPolicies - 1) % 100, "/method")}};
+
+  for (auto _ : state) { // NOLINT: Silences warning about dead store
+    benchmark::DoNotOptimize(engine.handleAction(connection, headers, info, nullptr));
+  }
+}
+
+} // namespace
+
+// NOLINTNEXTLINE(readability-identifier-naming)
+static void BM_IndexedPolicies(benchmark::State& state) { benchmarkEngine(state, true); }
+BENCHMARK(BM_IndexedPolicies);
+
+// NOLINTNEXTLINE(readability-identifier-naming)
+static void BM_UnindexedPolicies(benchmark::State& state) { benchmarkEngine(state, false); }
+BENCHMARK(BM_UnindexedPolicies);
+
+} // namespace RBAC
+} // namespace Common
+} // namespace Filters
+} // namespace Extensions
+} // namespace Envoy
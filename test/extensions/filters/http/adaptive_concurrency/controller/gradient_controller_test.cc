@@ -844,6 +844,45 @@ min_rtt_calc_params:
   EXPECT_FALSE(controller->inMinRTTSamplingWindow());
 }
 
+// Verify that the latency samples recorded by different threads are aggregated together.
+TEST_F(GradientControllerTest, MultiThreadSampleAggregation) {
+  const std::string yaml = R"EOF(
+sample_aggregate_percentile:
+  value: 50
+concurrency_limit_params:
+  max_concurrency_limit:
+  concurrency_update_interval: 0.1s
+min_rtt_calc_params:
+  jitter:
+    value: 0.0
+  interval: 3600s
+  request_count: 4
+  buffer:
+    value: 0
+  min_concurrency: 100
+)EOF";
+
+  auto controller = makeController(yaml);
+  const auto min_rtt = std::chrono::milliseconds(13);
+  time_system_.advanceTimeAndRun(min_rtt, *dispatcher_, Event::Dispatcher::RunType::Block);
+  verifyMinRTTActive();
+
+  // Each thread records half of the samples needed for the minRTT.
+  for (int thread = 0; thread < 2; ++thread) {
+    EXPECT_TRUE(controller->inMinRTTSamplingWindow());
+    std::thread t([this, &controller, min_rtt]() {
+      for (int i = 0; i < 2; ++i) {
+        tryForward(controller, true);
+        sampleLatency(controller, min_rtt);
+      }
+    });
+    t.join();
+  }
+
+  verifyMinRTTInactive();
+  verifyMinRTTValue(min_rtt);
+}
+
 } // namespace
 } // namespace Controller
 } // namespace AdaptiveConcurrency
@@ -1,4 +1,5 @@
 #include <chrono>
+#include <vector>
 
 #include "envoy/extensions/filters/http/admission_control/v3/admission_control.pb.h"
 #include "envoy/extensions/filters/http/admission_control/v3/admission_control.pb.validate.h"
@@ -6,6 +7,7 @@
 #include "source/extensions/filters/http/admission_control/thread_local_controller.h"
 
 #include "test/test_common/simulated_time_system.h"
+#include "test/test_common/thread_factory_for_test.h"
 #include "test/test_common/utility.h"
 
 #include "gmock/gmock.h"
@@ -129,6 +131,90 @@ TEST_F(ThreadLocalControllerTest, AverageRps) {
   EXPECT_EQ(0, tlc_.averageRps());
 }
 
+class ShardedControllerTest : public testing::Test {
+public:
+  ShardedControllerTest() : window_(5), controller_(time_system_, window_) {}
+
+protected:
+  Event::SimulatedTimeSystem time_system_;
+  std::chrono::seconds window_;
+  ShardedControllerImpl controller_;
+};
+
+// Test the basic functionality of the process-wide admission controller.
+TEST_F(ShardedControllerTest, BasicRecord) {
+  EXPECT_EQ(RequestData(0, 0), controller_.requestCounts());
+
+  controller_.recordFailure();
+  EXPECT_EQ(RequestData(1, 0), controller_.requestCounts());
+
+  controller_.recordSuccess();
+  EXPECT_EQ(RequestData(2, 1), controller_.requestCounts());
+}
+
+// Verify that the samples leave the window one second at a time, including those of the seconds
+// whose counts were cached.
+TEST_F(ShardedControllerTest, RemoveStaleSamples) {
+  for (int tick = 0; tick < window_.count(); ++tick) {
+    controller_.recordSuccess();
+    EXPECT_EQ(RequestData(tick + 1, tick + 1), controller_.requestCounts());
+    time_system_.advanceTimeWait(std::chrono::seconds(1));
+  }
+  // The first second left the window.
+  EXPECT_EQ(RequestData(window_.count() - 1, window_.count() - 1), controller_.requestCounts());
+
+  // Its bucket is reused by the current second.
+  controller_.recordFailure();
+  EXPECT_EQ(RequestData(window_.count(), window_.count() - 1), controller_.requestCounts());
+
+  time_system_.advanceTimeWait(std::chrono::seconds(2));
+  EXPECT_EQ(RequestData(window_.count() - 2, window_.count() - 3), controller_.requestCounts());
+
+  // Let's just sit here for a full day. We expect all samples to become stale.
+  time_system_.advanceTimeWait(std::chrono::hours(24));
+  EXPECT_EQ(RequestData(0, 0), controller_.requestCounts());
+}
+
+// Verify the average RPS is calculated properly.
+TEST_F(ShardedControllerTest, AverageRps) {
+  EXPECT_EQ(window_, controller_.samplingWindow());
+  EXPECT_EQ(0, controller_.averageRps());
+
+  for (int i = 0; i < 5; ++i) {
+    controller_.recordSuccess();
+  }
+  EXPECT_EQ(1, controller_.averageRps());
+
+  time_system_.advanceTimeWait(window_);
+  EXPECT_EQ(0, controller_.averageRps());
+}
+
+// Verify that the requests recorded by several threads are all counted.
+TEST_F(ShardedControllerTest, MultipleThreads) {
+  constexpr uint32_t threads = 16;
+  constexpr uint32_t requests_per_thread = 1000;
+  std::vector<Thread::ThreadPtr> workers;
+  for (uint32_t i = 0; i < threads; ++i) {
+    workers.push_back(Thread::threadFactoryForTest().createThread([this]() {
+      for (uint32_t j = 0; j < requests_per_thread; ++j) {
+        if (j % 2 == 0) {
+          controller_.recordSuccess();
+        } else {
+          controller_.recordFailure();
+        }
+      }
+    }));
+  }
+  for (auto& worker : workers) {
+    worker->join();
+  }
+
+  const uint32_t requests = threads * requests_per_thread;
+  EXPECT_EQ(RequestData(requests, requests / 2), controller_.requestCounts());
+  time_system_.advanceTimeWait(std::chrono::seconds(1));
+  EXPECT_EQ(RequestData(requests, requests / 2), controller_.requestCounts());
+}
+
 } // namespace
 } // namespace AdmissionControl
 } // namespace HttpFilters
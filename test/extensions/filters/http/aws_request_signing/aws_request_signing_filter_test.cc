@@ -112,7 +112,6 @@ TEST_F(AwsRequestSigningFilterTest, DecodeDataSignsEmptyPayloadAndContinues) {
   const std::string hash = "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855";
   Buffer::OwnedImpl buffer;
   EXPECT_CALL(decoder_callbacks_, addDecodedData(_, false));
-  EXPECT_CALL(decoder_callbacks_, decodingBuffer).WillOnce(Return(&buffer));
   EXPECT_CALL(*(filter_config_->signer_),
               sign(HeaderMapEqualRef(&headers), hash, An<absl::string_view>()));
   EXPECT_EQ(Http::FilterDataStatus::Continue, filter_->decodeData(buffer, true));
@@ -131,12 +130,31 @@ TEST_F(AwsRequestSigningFilterTest, DecodeDataSignsPayloadAndContinues) {
   const std::string hash = "1db26ef86fca9f7c54d2273d4673a4f2a614fadf3185d16288d454619f1cf491";
   Buffer::OwnedImpl buffer("Action=SignThis");
   EXPECT_CALL(decoder_callbacks_, addDecodedData(_, false));
-  EXPECT_CALL(decoder_callbacks_, decodingBuffer).WillOnce(Return(&buffer));
   EXPECT_CALL(*(filter_config_->signer_),
               sign(HeaderMapEqualRef(&headers), hash, An<absl::string_view>()));
   EXPECT_EQ(Http::FilterDataStatus::Continue, filter_->decodeData(buffer, true));
 }
 
+// Verify decodeData signs the hash of all the chunks of the payload.
+TEST_F(AwsRequestSigningFilterTest, DecodeDataSignsChunkedPayloadAndContinues) {
+  InSequence seq;
+  setup();
+  Http::TestRequestHeaderMapImpl headers;
+  EXPECT_EQ(Http::FilterHeadersStatus::StopIteration, filter_->decodeHeaders(headers, false));
+
+  // sha256('Action=SignThis')
+  const std::string hash = "1db26ef86fca9f7c54d2273d4673a4f2a614fadf3185d16288d454619f1cf491";
+  Buffer::OwnedImpl first("Action");
+  EXPECT_EQ(Http::FilterDataStatus::StopIterationAndBuffer, filter_->decodeData(first, false));
+  Buffer::OwnedImpl second("=Sign");
+  EXPECT_EQ(Http::FilterDataStatus::StopIterationAndBuffer, filter_->decodeData(second, false));
+  Buffer::OwnedImpl last("This");
+  EXPECT_CALL(decoder_callbacks_, addDecodedData(_, false));
+  EXPECT_CALL(*(filter_config_->signer_),
+              sign(HeaderMapEqualRef(&headers), hash, An<absl::string_view>()));
+  EXPECT_EQ(Http::FilterDataStatus::Continue, filter_->decodeData(last, true));
+}
+
 // Verify filter functionality when a host rewrite happens for header only request.
 TEST_F(AwsRequestSigningFilterTest, SignWithHostRewrite) {
   setup();
@@ -173,7 +191,6 @@ TEST_F(AwsRequestSigningFilterTest, DecodeDataSignFails) {
 
   Buffer::OwnedImpl buffer;
   EXPECT_CALL(decoder_callbacks_, addDecodedData(_, false));
-  EXPECT_CALL(decoder_callbacks_, decodingBuffer).WillOnce(Return(&buffer));
   EXPECT_CALL(*(filter_config_->signer_), sign(An<Http::RequestHeaderMap&>(),
                                                An<const std::string&>(), An<absl::string_view>()))
       .WillOnce(Invoke([](Http::HeaderMap&, const std::string&,
@@ -1,6 +1,7 @@
 #include "envoy/event/dispatcher.h"
 
 #include "source/common/http/headers.h"
+#include "source/common/stats/isolated_store_impl.h"
 #include "source/extensions/filters/http/cache/cache_filter.h"
 #include "source/extensions/filters/http/cache/cache_filter_logging_info.h"
 #include "source/extensions/http/cache/simple_http_cache/simple_http_cache.h"
@@ -29,8 +30,11 @@ class CacheFilterTest : public ::testing::Test {
 protected:
   // The filter has to be created as a shared_ptr to enable shared_from_this() which is used in the
   // cache callbacks.
-  CacheFilterSharedPtr makeFilter(std::shared_ptr<HttpCache> cache, bool auto_destroy = true) {
-    auto config = std::make_shared<CacheFilterConfig>(config_, context_.server_factory_context_);
+  CacheFilterSharedPtr makeFilter(std::shared_ptr<HttpCache> cache, bool auto_destroy = true,
+                                  std::shared_ptr<const CacheFilterConfig> config = nullptr) {
+    if (config == nullptr) {
+      config = std::make_shared<CacheFilterConfig>(config_, context_.server_factory_context_);
+    }
     std::shared_ptr<CacheFilter> filter(new CacheFilter(config, cache),
                                         [auto_destroy](CacheFilter* f) {
                                           if (auto_destroy) {
@@ -160,7 +164,9 @@ protected:
 
   void waitBeforeSecondRequest() { time_source_.advanceTimeWait(delay_); }
 
-  std::shared_ptr<SimpleHttpCache> simple_cache_ = std::make_shared<SimpleHttpCache>();
+  Stats::IsolatedStoreImpl stats_store_;
+  std::shared_ptr<SimpleHttpCache> simple_cache_ =
+      std::make_shared<SimpleHttpCache>(SimpleHttpCache::ConfigProto(), *stats_store_.rootScope());
   envoy::extensions::filters::http::cache::v3::CacheConfig config_;
   std::shared_ptr<StreamInfo::FilterState> filter_state_ =
       std::make_shared<StreamInfo::FilterStateImpl>(StreamInfo::FilterState::LifeSpan::FilterChain);
@@ -351,6 +357,72 @@ TEST_F(CacheFilterTest, CacheHitWithBody) {
   }
 }
 
+TEST_F(CacheFilterTest, CollapsedRequestServedFromFill) {
+  request_headers_.setHost("CollapsedRequestServedFromFill");
+  config_.mutable_collapsed_request_timeout()->set_seconds(5);
+  auto config = std::make_shared<CacheFilterConfig>(config_, context_.server_factory_context_);
+  const std::string body = "abc";
+
+  // The first miss fills the cache for the key.
+  CacheFilterSharedPtr fill = makeFilter(simple_cache_, true, config);
+  testDecodeRequestMiss(fill);
+
+  // The second miss waits for the fill rather than going upstream.
+  CacheFilterSharedPtr collapsed = makeFilter(simple_cache_, true, config);
+  EXPECT_CALL(decoder_callbacks_, continueDecoding).Times(0);
+  EXPECT_EQ(collapsed->decodeHeaders(request_headers_, true),
+            Http::FilterHeadersStatus::StopAllIterationAndWatermark);
+  dispatcher_->run(Event::Dispatcher::RunType::NonBlock);
+  ::testing::Mock::VerifyAndClearExpectations(&decoder_callbacks_);
+
+  // Once the entry is complete, the waiting request is served from the cache.
+  EXPECT_CALL(decoder_callbacks_,
+              encodeHeaders_(IsSupersetOfHeaders(response_headers_), /*end_stream=*/false));
+  EXPECT_CALL(
+      decoder_callbacks_,
+      encodeData(testing::Property(&Buffer::Instance::toString, testing::Eq(body)), true));
+  Buffer::OwnedImpl buffer(body);
+  response_headers_.setContentLength(body.size());
+  EXPECT_EQ(fill->encodeHeaders(response_headers_, false), Http::FilterHeadersStatus::Continue);
+  EXPECT_EQ(fill->encodeData(buffer, true), Http::FilterDataStatus::Continue);
+  dispatcher_->run(Event::Dispatcher::RunType::Block);
+  ::testing::Mock::VerifyAndClearExpectations(&decoder_callbacks_);
+
+  collapsed->onStreamComplete();
+  EXPECT_THAT(lookupStatus(), IsOkAndHolds(LookupStatus::CacheHit));
+  EXPECT_THAT(insertStatus(), IsOkAndHolds(InsertStatus::NoInsertCacheHit));
+}
+
+TEST_F(CacheFilterTest, CollapsedRequestGoesUpstreamOnTimeout) {
+  request_headers_.setHost("CollapsedRequestGoesUpstreamOnTimeout");
+  config_.mutable_collapsed_request_timeout()->set_seconds(5);
+  auto config = std::make_shared<CacheFilterConfig>(config_, context_.server_factory_context_);
+
+  CacheFilterSharedPtr fill = makeFilter(simple_cache_, true, config);
+  testDecodeRequestMiss(fill);
+
+  CacheFilterSharedPtr collapsed = makeFilter(simple_cache_, true, config);
+  EXPECT_CALL(decoder_callbacks_, continueDecoding).Times(0);
+  EXPECT_EQ(collapsed->decodeHeaders(request_headers_, true),
+            Http::FilterHeadersStatus::StopAllIterationAndWatermark);
+  dispatcher_->run(Event::Dispatcher::RunType::NonBlock);
+  ::testing::Mock::VerifyAndClearExpectations(&decoder_callbacks_);
+
+  // The fill doesn't complete in time, the waiting request goes upstream.
+  EXPECT_CALL(decoder_callbacks_, continueDecoding);
+  time_source_.advanceTimeAndRun(std::chrono::seconds(6), *dispatcher_,
+                                 Event::Dispatcher::RunType::NonBlock);
+  ::testing::Mock::VerifyAndClearExpectations(&decoder_callbacks_);
+
+  EXPECT_EQ(collapsed->encodeHeaders(response_headers_, true),
+            Http::FilterHeadersStatus::Continue);
+  EXPECT_EQ(fill->encodeHeaders(response_headers_, true), Http::FilterHeadersStatus::Continue);
+  collapsed->onStreamComplete();
+  EXPECT_THAT(lookupStatus(), IsOkAndHolds(LookupStatus::CacheMiss));
+  // Clear events off the dispatcher.
+  dispatcher_->run(Event::Dispatcher::RunType::Block);
+}
+
 TEST_F(CacheFilterTest, WatermarkEventsAreSentIfCacheBlocksStreamAndLimitExceeded) {
   request_headers_.setHost("CacheHitWithBody");
   const std::string body1 = "abcde";
@@ -2,6 +2,7 @@
 
 #include "source/common/buffer/buffer_impl.h"
 #include "source/common/common/empty_string.h"
+#include "source/common/common/token_bucket_impl.h"
 #include "source/extensions/filters/http/common/stream_rate_limiter.h"
 
 #include "test/common/http/common.h"
@@ -67,6 +68,20 @@ public:
 
   uint64_t fillInterval() { return limiter_->fill_interval_.count(); }
 
+  // Returns a limiter of 1KiB/s on the dispatcher of decoder_callbacks_, whose refills are run by
+  // the shared scheduler.
+  std::unique_ptr<StreamRateLimiter>
+  makeSharedTimerLimiter(Http::MockStreamDecoderFilterCallbacks& callbacks) {
+    return std::make_unique<StreamRateLimiter>(
+        1, 1100, [] {}, [] {},
+        [&callbacks](Buffer::Instance& data, bool end_stream) {
+          callbacks.injectDecodedDataToFilterChain(data, end_stream);
+        },
+        [] {}, [](uint64_t, bool, std::chrono::milliseconds) {}, time_system_,
+        decoder_callbacks_.dispatcher_, decoder_callbacks_.scope(), nullptr,
+        std::chrono::milliseconds(50), true);
+  }
+
   NiceMock<Stats::IsolatedStoreImpl> stats_;
   NiceMock<Http::MockStreamDecoderFilterCallbacks> decoder_callbacks_;
   NiceMock<Runtime::MockLoader> runtime_;
@@ -146,6 +161,73 @@ TEST_F(StreamRateLimiterTest, RateLimitOnSingleStream) {
   EXPECT_EQ(limiter_->destroyed(), true);
 }
 
+// Test that the streams sharing a token bucket don't refill it when they start.
+TEST_F(StreamRateLimiterTest, SharedTokenBucketNotRefilledByNewStream) {
+  ON_CALL(decoder_callbacks_, decoderBufferLimit()).WillByDefault(Return(1100));
+  auto token_bucket = std::make_shared<AtomicTokenBucketImpl>(1024, time_system_, 1024);
+
+  // The first stream resets the bucket to one fill interval of tokens, which it then consumes.
+  setUpTest(1, 50, token_bucket);
+  EXPECT_EQ(51, token_bucket->consume(1024, true));
+
+  // The second stream finds the bucket empty.
+  std::unique_ptr<StreamRateLimiter> first_limiter = std::move(limiter_);
+  setUpTest(1, 50, token_bucket);
+  EXPECT_EQ(0, token_bucket->consume(1, false));
+  EXPECT_EQ(std::chrono::milliseconds(1), token_bucket->nextTokenAvailable());
+}
+
+// Test that the refills of the limiters using the shared scheduler are run by a single timer.
+TEST_F(StreamRateLimiterTest, SharedFillTimer) {
+  EXPECT_CALL(decoder_callbacks_.dispatcher_, pushTrackedObject(_)).Times(AnyNumber());
+  EXPECT_CALL(decoder_callbacks_.dispatcher_, popTrackedObject(_)).Times(AnyNumber());
+  // The timers are created in the reverse order.
+  Event::MockTimer* token_timer2 = new NiceMock<Event::MockTimer>(&decoder_callbacks_.dispatcher_);
+  Event::MockTimer* scheduler_timer =
+      new NiceMock<Event::MockTimer>(&decoder_callbacks_.dispatcher_);
+  Event::MockTimer* token_timer1 = new NiceMock<Event::MockTimer>(&decoder_callbacks_.dispatcher_);
+  NiceMock<Http::MockStreamDecoderFilterCallbacks> other_callbacks;
+  std::unique_ptr<StreamRateLimiter> limiter1 = makeSharedTimerLimiter(decoder_callbacks_);
+  std::unique_ptr<StreamRateLimiter> limiter2 = makeSharedTimerLimiter(other_callbacks);
+
+  // Each limiter writes its first 51 bytes right away, and waits for a refill for the rest.
+  EXPECT_CALL(*scheduler_timer, enableTimer(std::chrono::milliseconds(50), _));
+  Buffer::OwnedImpl data1(std::string(100, 'a'));
+  limiter1->writeData(data1, false);
+  EXPECT_CALL(decoder_callbacks_,
+              injectDecodedDataToFilterChain(BufferStringEqual(std::string(51, 'a')), false));
+  token_timer1->invokeCallback();
+  Buffer::OwnedImpl data2(std::string(100, 'b'));
+  limiter2->writeData(data2, false);
+  EXPECT_CALL(other_callbacks,
+              injectDecodedDataToFilterChain(BufferStringEqual(std::string(51, 'b')), false));
+  token_timer2->invokeCallback();
+  EXPECT_FALSE(token_timer1->enabled());
+  EXPECT_FALSE(token_timer2->enabled());
+
+  // One tick refills both.
+  time_system_.advanceTimeWait(std::chrono::milliseconds(50));
+  EXPECT_CALL(decoder_callbacks_,
+              injectDecodedDataToFilterChain(BufferStringEqual(std::string(49, 'a')), false));
+  EXPECT_CALL(other_callbacks,
+              injectDecodedDataToFilterChain(BufferStringEqual(std::string(49, 'b')), false));
+  scheduler_timer->invokeCallback();
+
+  // A limiter destroyed while it waits for a refill isn't run by the next tick.
+  time_system_.advanceTimeWait(std::chrono::seconds(1));
+  EXPECT_CALL(*scheduler_timer, enableTimer(std::chrono::milliseconds(50), _));
+  Buffer::OwnedImpl data3(std::string(1100, 'c'));
+  limiter2->writeData(data3, false);
+  EXPECT_CALL(other_callbacks,
+              injectDecodedDataToFilterChain(BufferStringEqual(std::string(1024, 'c')), false));
+  token_timer2->invokeCallback();
+  limiter2.reset();
+  time_system_.advanceTimeWait(std::chrono::milliseconds(50));
+  scheduler_timer->invokeCallback();
+
+  limiter1.reset();
+}
+
 } // namespace Common
 } // namespace HttpFilters
 } // namespace Extensions
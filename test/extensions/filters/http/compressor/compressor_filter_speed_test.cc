@@ -10,6 +10,7 @@
 
 #include "test/mocks/http/mocks.h"
 #include "test/mocks/runtime/mocks.h"
+#include "test/mocks/server/overload_manager.h"
 #include "test/mocks/stats/mocks.h"
 
 #include "benchmark/benchmark.h"
@@ -106,6 +107,7 @@ struct CompressionParams {
 
 CompressorFilterConfigSharedPtr makeGzipConfig(Stats::IsolatedStoreImpl& stats,
                                                testing::NiceMock<Runtime::MockLoader>& runtime,
+                                               Server::MockOverloadManager& overload_manager,
                                                const CompressionParams& params) {
 
   envoy::extensions::filters::http::compressor::v3::Compressor compressor;
@@ -120,14 +122,16 @@ CompressorFilterConfigSharedPtr makeGzipConfig(Stats::IsolatedStoreImpl& stats,
   const auto memory_level = params.memory_level;
   Envoy::Compression::Compressor::CompressorFactoryPtr compressor_factory =
       std::make_unique<MockGzipCompressorFactory>(level, strategy, window_bits, memory_level);
-  CompressorFilterConfigSharedPtr config = std::make_shared<CompressorFilterConfig>(
-      compressor, "test.", *stats.rootScope(), runtime, std::move(compressor_factory));
+  CompressorFilterConfigSharedPtr config =
+      std::make_shared<CompressorFilterConfig>(compressor, "test.", *stats.rootScope(), runtime,
+                                               overload_manager, std::move(compressor_factory));
 
   return config;
 }
 
 CompressorFilterConfigSharedPtr makeZstdConfig(Stats::IsolatedStoreImpl& stats,
                                                testing::NiceMock<Runtime::MockLoader>& runtime,
+                                               Server::MockOverloadManager& overload_manager,
                                                const CompressionParams& params) {
 
   envoy::extensions::filters::http::compressor::v3::Compressor compressor;
@@ -136,14 +140,16 @@ CompressorFilterConfigSharedPtr makeZstdConfig(Stats::IsolatedStoreImpl& stats,
   const auto strategy = params.strategy;
   Envoy::Compression::Compressor::CompressorFactoryPtr compressor_factory =
       std::make_unique<MockZstdCompressorFactory>(level, strategy);
-  CompressorFilterConfigSharedPtr config = std::make_shared<CompressorFilterConfig>(
-      compressor, "test.", *stats.rootScope(), runtime, std::move(compressor_factory));
+  CompressorFilterConfigSharedPtr config =
+      std::make_shared<CompressorFilterConfig>(compressor, "test.", *stats.rootScope(), runtime,
+                                               overload_manager, std::move(compressor_factory));
 
   return config;
 }
 
 CompressorFilterConfigSharedPtr makeBrotliConfig(Stats::IsolatedStoreImpl& stats,
                                                  testing::NiceMock<Runtime::MockLoader>& runtime,
+                                                 Server::MockOverloadManager& overload_manager,
                                                  const CompressionParams& params) {
 
   envoy::extensions::filters::http::compressor::v3::Compressor compressor;
@@ -151,8 +157,9 @@ CompressorFilterConfigSharedPtr makeBrotliConfig(Stats::IsolatedStoreImpl& stats
   const auto quality = params.level;
   Envoy::Compression::Compressor::CompressorFactoryPtr compressor_factory =
       std::make_unique<MockBrotliCompressorFactory>(quality);
-  CompressorFilterConfigSharedPtr config = std::make_shared<CompressorFilterConfig>(
-      compressor, "test.", *stats.rootScope(), runtime, std::move(compressor_factory));
+  CompressorFilterConfigSharedPtr config =
+      std::make_shared<CompressorFilterConfig>(compressor, "test.", *stats.rootScope(), runtime,
+                                               overload_manager, std::move(compressor_factory));
 
   return config;
 }
@@ -208,18 +215,19 @@ static Result compressWith(enum CompressorLibs lib, std::vector<Buffer::OwnedImp
   auto start = std::chrono::high_resolution_clock::now();
   Stats::IsolatedStoreImpl stats;
   testing::NiceMock<Runtime::MockLoader> runtime;
+  testing::NiceMock<Server::MockOverloadManager> overload_manager;
   CompressorFilterConfigSharedPtr config;
   std::string compressor = "";
   std::string encoding = "";
   if (lib == CompressorLibs::Brotli) {
-    config = makeBrotliConfig(stats, runtime, params);
+    config = makeBrotliConfig(stats, runtime, overload_manager, params);
     encoding = "br";
     compressor = "brotli";
   } else if (lib == CompressorLibs::Gzip) {
-    config = makeGzipConfig(stats, runtime, params);
+    config = makeGzipConfig(stats, runtime, overload_manager, params);
     encoding = compressor = "gzip";
   } else if (lib == CompressorLibs::Zstd) {
-    config = makeZstdConfig(stats, runtime, params);
+    config = makeZstdConfig(stats, runtime, overload_manager, params);
     encoding = compressor = "zstd";
   }
 
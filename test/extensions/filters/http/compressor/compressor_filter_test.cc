@@ -1,8 +1,10 @@
+#include "source/extensions/compression/gzip/compressor/config.h"
 #include "source/extensions/filters/http/compressor/compressor_filter.h"
 
 #include "test/mocks/compression/compressor/mocks.h"
 #include "test/mocks/http/mocks.h"
 #include "test/mocks/runtime/mocks.h"
+#include "test/mocks/server/overload_manager.h"
 #include "test/mocks/stats/mocks.h"
 #include "test/test_common/utility.h"
 
@@ -17,6 +19,7 @@ namespace {
 using envoy::extensions::filters::http::compressor::v3::CompressorPerRoute;
 using testing::NiceMock;
 using testing::Return;
+using testing::ReturnRef;
 
 class TestCompressorFactory : public Envoy::Compression::Compressor::CompressorFactory {
 public:
@@ -30,12 +33,15 @@ public:
   }
   const std::string& statsPrefix() const override { CONSTRUCT_ON_FIRST_USE(std::string, "test."); }
   const std::string& contentEncoding() const override { return content_encoding_; }
+  std::string dictionaryHash() const override { return dictionary_hash_; }
 
   void setExpectedCompressCalls(uint32_t calls) { expected_compress_calls_ = calls; }
+  void setDictionaryHash(const std::string& hash) { dictionary_hash_ = hash; }
 
 private:
   uint32_t expected_compress_calls_{1};
   const std::string content_encoding_;
+  std::string dictionary_hash_;
 };
 
 class CompressorFilterTest : public testing::Test {
@@ -65,7 +71,8 @@ public:
     auto compressor_factory = std::make_unique<TestCompressorFactory>("test");
     compressor_factory_ = compressor_factory.get();
     config_ = std::make_shared<CompressorFilterConfig>(compressor, "test.", *stats_.rootScope(),
-                                                       runtime_, std::move(compressor_factory));
+                                                       runtime_, overload_manager_,
+                                                       std::move(compressor_factory));
     filter_ = std::make_unique<CompressorFilter>(config_);
     filter_->setDecoderFilterCallbacks(decoder_callbacks_);
     filter_->setEncoderFilterCallbacks(encoder_callbacks_);
@@ -179,6 +186,7 @@ public:
   std::string response_stats_prefix_{};
   Stats::TestUtil::TestStore stats_;
   NiceMock<Runtime::MockLoader> runtime_;
+  NiceMock<Server::MockOverloadManager> overload_manager_;
   NiceMock<Http::MockStreamDecoderFilterCallbacks> decoder_callbacks_;
   NiceMock<Http::MockStreamEncoderFilterCallbacks> encoder_callbacks_;
 };
@@ -342,6 +350,26 @@ TEST_F(CompressorFilterTest, AcceptanceTestEncodingWithTrailers) {
   doResponseCompression(headers, true);
 }
 
+// A compressor with a dictionary is only used if the client announces the dictionary.
+TEST_F(CompressorFilterTest, DictionaryIsNotAvailable) {
+  compressor_factory_->setDictionaryHash("hash");
+  doRequestNoCompression({{":method", "get"}, {"accept-encoding", "deflate, test"}});
+  Http::TestResponseHeaderMapImpl headers{{":method", "get"}, {"content-length", "256"}};
+  doResponseNoCompression(headers);
+  EXPECT_EQ("Accept-Encoding, Available-Dictionary", headers.get_("vary"));
+}
+
+TEST_F(CompressorFilterTest, DictionaryIsAvailable) {
+  compressor_factory_->setDictionaryHash("hash");
+  // The hash is announced as a structured field byte sequence.
+  doRequestNoCompression({{":method", "get"},
+                          {"accept-encoding", "deflate, test"},
+                          {"available-dictionary", " :aGFzaA==: "}});
+  Http::TestResponseHeaderMapImpl headers{{":method", "get"}, {"content-length", "256"}};
+  doResponseCompression(headers, false);
+  EXPECT_EQ("Accept-Encoding, Available-Dictionary", headers.get_("vary"));
+}
+
 TEST_F(CompressorFilterTest, NoAcceptEncodingHeader) {
   doRequestNoCompression({{":method", "get"}, {}});
   Http::TestResponseHeaderMapImpl headers{{":method", "get"}, {"content-length", "256"}};
@@ -428,6 +456,114 @@ TEST_F(CompressorFilterTest, EmptyResponse) {
   EXPECT_EQ(Http::FilterDataStatus::Continue, filter_->encodeData(data_, true));
 }
 
+class CompressedVariantCacheTest : public CompressorFilterTest {
+public:
+  void SetUp() override {
+    setUpFilter(R"EOF(
+{
+  "response_direction_config": {
+    "compressed_variant_cache": {
+      "max_size_bytes": 4096
+    }
+  },
+  "compressor_library": {
+     "name": "test",
+     "typed_config": {
+       "@type": "type.googleapis.com/envoy.extensions.compression.gzip.compressor.v3.Gzip"
+     }
+  }
+}
+)EOF");
+    response_stats_prefix_ = "response.";
+  }
+
+  // Sends a GET of /asset with the body and the etag through a new filter, returning the response
+  // body with its headers.
+  std::string doCachedResponse(const std::string& body, const std::string& etag,
+                               Http::TestResponseHeaderMapImpl& response_headers) {
+    NiceMock<Http::MockStreamDecoderFilterCallbacks> decoder_callbacks;
+    filter_ = std::make_unique<CompressorFilter>(config_);
+    filter_->setDecoderFilterCallbacks(decoder_callbacks);
+    filter_->setEncoderFilterCallbacks(encoder_callbacks_);
+    Http::TestRequestHeaderMapImpl request_headers{{":method", "GET"},
+                                                   {":authority", "example.com"},
+                                                   {":path", "/asset"},
+                                                   {"accept-encoding", "test"}};
+    EXPECT_EQ(Http::FilterHeadersStatus::Continue, filter_->decodeHeaders(request_headers, true));
+    response_headers = {{":status", "200"},
+                        {"content-length", absl::StrCat(body.size())},
+                        {"content-type", "text/html"},
+                        {"etag", etag}};
+    EXPECT_EQ(Http::FilterHeadersStatus::Continue,
+              filter_->encodeHeaders(response_headers, false));
+    Buffer::OwnedImpl data(body);
+    EXPECT_EQ(Http::FilterDataStatus::Continue, filter_->encodeData(data, true));
+    return data.toString();
+  }
+
+  uint64_t responseCounter(absl::string_view name) {
+    return stats_.counter(absl::StrCat("test.compressor.test.test.response.", name)).value();
+  }
+
+  // The response specific stats aren't rooted in "response.".
+  uint64_t cacheCounter(absl::string_view name) {
+    return stats_.counter(absl::StrCat("test.compressor.test.test.compressed_variant_cache_", name))
+        .value();
+  }
+};
+
+TEST_F(CompressedVariantCacheTest, ServesCachedVariant) {
+  const std::string body(100, 'a');
+  Http::TestResponseHeaderMapImpl headers;
+  // The mock compressor leaves the data as is.
+  EXPECT_EQ(body, doCachedResponse(body, "\"v1\"", headers));
+  EXPECT_EQ("test", headers.get_("content-encoding"));
+  EXPECT_EQ("", headers.get_("content-length"));
+  EXPECT_EQ(1, cacheCounter("miss"));
+
+  // The second response isn't compressed, the cached variant replaces its body.
+  compressor_factory_->setExpectedCompressCalls(0);
+  EXPECT_EQ(body, doCachedResponse(std::string(100, 'b'), "\"v1\"", headers));
+  EXPECT_EQ("test", headers.get_("content-encoding"));
+  EXPECT_EQ("100", headers.get_("content-length"));
+  EXPECT_EQ(1, cacheCounter("hit"));
+  EXPECT_EQ(100, responseCounter("total_uncompressed_bytes"));
+  EXPECT_EQ(2, responseCounter("compressed"));
+
+  // A new etag is compressed again.
+  compressor_factory_->setExpectedCompressCalls(1);
+  EXPECT_EQ(std::string(100, 'c'), doCachedResponse(std::string(100, 'c'), "\"v2\"", headers));
+  EXPECT_EQ(2, cacheCounter("miss"));
+}
+
+TEST_F(CompressedVariantCacheTest, WeakEtagIsNotCached) {
+  const std::string body(100, 'a');
+  Http::TestResponseHeaderMapImpl headers;
+  EXPECT_EQ(body, doCachedResponse(body, "W/\"v1\"", headers));
+  EXPECT_EQ(body, doCachedResponse(body, "W/\"v1\"", headers));
+  EXPECT_EQ(0, cacheCounter("miss"));
+  EXPECT_EQ(0, cacheCounter("hit"));
+  EXPECT_EQ(200, responseCounter("total_uncompressed_bytes"));
+}
+
+TEST(CompressedVariantCache, EvictsLeastRecentlyUsed) {
+  CompressedVariantCache cache(/*max_size_bytes=*/10, /*max_entry_bytes=*/0);
+  EXPECT_EQ(10, cache.maxEntryBytes());
+  cache.insert("a", "aaaa");
+  cache.insert("b", "bbbb");
+  // Marks "a" as recently used, so that "b" is evicted for "c".
+  EXPECT_NE(nullptr, cache.lookup("a"));
+  cache.insert("c", "cccc");
+  EXPECT_EQ(nullptr, cache.lookup("b"));
+  EXPECT_EQ("aaaa", *cache.lookup("a"));
+  EXPECT_EQ("cccc", *cache.lookup("c"));
+  EXPECT_EQ(8, cache.sizeBytes());
+  // Too large to be cached.
+  cache.insert("d", std::string(11, 'd'));
+  EXPECT_EQ(nullptr, cache.lookup("d"));
+  EXPECT_EQ(8, cache.sizeBytes());
+}
+
 // Verify removeAcceptEncoding header.
 TEST_F(CompressorFilterTest, RemoveAcceptEncodingHeader) {
   // Filter true, no response direction overrides. Header is removed.
@@ -930,7 +1066,8 @@ protected:
     auto compressor_factory1 = std::make_unique<TestCompressorFactory>("test1");
     compressor_factory1->setExpectedCompressCalls(0);
     auto config1 = std::make_shared<CompressorFilterConfig>(
-        compressor, "test1.", *stats1_.rootScope(), runtime_, std::move(compressor_factory1));
+        compressor, "test1.", *stats1_.rootScope(), runtime_, overload_manager_,
+        std::move(compressor_factory1));
     filter1_ = std::make_unique<CompressorFilter>(config1);
 
     TestUtility::loadFromJson(R"EOF(
@@ -947,11 +1084,13 @@ protected:
     auto compressor_factory2 = std::make_unique<TestCompressorFactory>("test2");
     compressor_factory2->setExpectedCompressCalls(0);
     auto config2 = std::make_shared<CompressorFilterConfig>(
-        compressor, "test2.", *stats2_.rootScope(), runtime_, std::move(compressor_factory2));
+        compressor, "test2.", *stats2_.rootScope(), runtime_, overload_manager_,
+        std::move(compressor_factory2));
     filter2_ = std::make_unique<CompressorFilter>(config2);
   }
 
   NiceMock<Runtime::MockLoader> runtime_;
+  NiceMock<Server::MockOverloadManager> overload_manager_;
   Stats::TestUtil::TestStore stats1_;
   Stats::TestUtil::TestStore stats2_;
   std::unique_ptr<CompressorFilter> filter1_;
@@ -1053,7 +1192,8 @@ protected:
                               compressor);
     auto compressor_factory1 = std::make_unique<TestCompressorFactory>("test1");
     auto config1 = std::make_shared<CompressorFilterConfig>(
-        compressor, "test1.", *stats1_.rootScope(), runtime_, std::move(compressor_factory1));
+        compressor, "test1.", *stats1_.rootScope(), runtime_, overload_manager_,
+        std::move(compressor_factory1));
     filter1_ = std::make_unique<CompressorFilter>(config1);
 
     TestUtility::loadFromJson(fmt::format(R"EOF(
@@ -1071,7 +1211,8 @@ protected:
                               compressor);
     auto compressor_factory2 = std::make_unique<TestCompressorFactory>("test2");
     auto config2 = std::make_shared<CompressorFilterConfig>(
-        compressor, "test2.", *stats2_.rootScope(), runtime_, std::move(compressor_factory2));
+        compressor, "test2.", *stats2_.rootScope(), runtime_, overload_manager_,
+        std::move(compressor_factory2));
     filter2_ = std::make_unique<CompressorFilter>(config2);
   }
 
@@ -1178,11 +1319,45 @@ TEST(CompressorFilterConfigTests, MakeCompressorTest) {
   EXPECT_CALL(*compressor_factory, createCompressor());
   EXPECT_CALL(*compressor_factory, statsPrefix());
   EXPECT_CALL(*compressor_factory, contentEncoding());
+  NiceMock<Server::MockOverloadManager> overload_manager;
   CompressorFilterConfig config(compressor_cfg, "test.compressor.", *stats.rootScope(), runtime,
-                                std::move(compressor_factory));
+                                overload_manager, std::move(compressor_factory));
   Envoy::Compression::Compressor::CompressorPtr compressor = config.makeCompressor();
 }
 
+TEST(CompressorFilterConfigTests, CompressionLevelFollowsOverloadAction) {
+  envoy::extensions::filters::http::compressor::v3::Compressor compressor_cfg;
+  compressor_cfg.mutable_compressor_library()->set_name("gzip");
+  envoy::extensions::compression::gzip::compressor::v3::Gzip gzip;
+  gzip.set_compression_level(
+      envoy::extensions::compression::gzip::compressor::v3::Gzip::BEST_COMPRESSION);
+  NiceMock<Runtime::MockLoader> runtime;
+  NiceMock<Server::MockOverloadManager> overload_manager;
+  Stats::TestUtil::TestStore stats;
+  CompressorFilterConfig config(
+      compressor_cfg, "test.", *stats.rootScope(), runtime, overload_manager,
+      std::make_unique<Compression::Gzip::Compressor::GzipCompressorFactory>(gzip));
+  auto& compression_level = stats.gauge("test.compressor.gzip.gzip.compression_level",
+                                        Stats::Gauge::ImportMode::NeverImport);
+  EXPECT_EQ(9, compression_level.value());
+
+  Server::OverloadActionState state(UnitFloat(0.5));
+  ON_CALL(overload_manager.overload_state_,
+          getState(Server::OverloadActionNames::get().ReduceCompressionLevel))
+      .WillByDefault(ReturnRef(state));
+  EXPECT_NE(nullptr, config.makeCompressor());
+  EXPECT_EQ(5, compression_level.value());
+
+  state = Server::OverloadActionState::saturated();
+  EXPECT_NE(nullptr, config.makeCompressor());
+  EXPECT_EQ(1, compression_level.value());
+
+  // The configured level is applied again once the action is inactive.
+  state = Server::OverloadActionState::inactive();
+  EXPECT_NE(nullptr, config.makeCompressor());
+  EXPECT_EQ(9, compression_level.value());
+}
+
 } // namespace
 } // namespace Compressor
 } // namespace HttpFilters
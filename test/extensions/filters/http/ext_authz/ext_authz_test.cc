@@ -1078,6 +1078,79 @@ TEST_F(HttpFilterTest, ImmediateErrorOpenWithHeaderAddClose) {
 }
 
 // Check a bad configuration results in validation exception.
+// Test that a decision is served from the decision cache to a request with the same key.
+TEST_F(HttpFilterTest, DecisionCacheHit) {
+  initialize(R"EOF(
+  grpc_service:
+    envoy_grpc:
+      cluster_name: "ext_authz_server"
+  decision_cache:
+    key_headers: ["x-user"]
+    ttl: 60s
+  )EOF");
+  prepareCheck();
+  request_headers_.addCopy("x-user", "alice");
+
+  Filters::Common::ExtAuthz::Response response{};
+  response.status = Filters::Common::ExtAuthz::CheckStatus::OK;
+  response.headers_to_set = {{"x-authz", "yes"}};
+  EXPECT_CALL(*client_, check(_, _, _, _))
+      .WillOnce(Invoke([&](Filters::Common::ExtAuthz::RequestCallbacks& callbacks,
+                           const envoy::service::auth::v3::CheckRequest&, Tracing::Span&,
+                           const StreamInfo::StreamInfo&) -> void {
+        callbacks.onComplete(std::make_unique<Filters::Common::ExtAuthz::Response>(response));
+      }));
+  EXPECT_EQ(Http::FilterHeadersStatus::Continue, filter_->decodeHeaders(request_headers_, false));
+  EXPECT_EQ(1U, config_->stats().decision_cache_miss_.value());
+
+  // The next request with the same key doesn't call the authorization service.
+  auto* client = new Filters::Common::ExtAuthz::MockClient();
+  Filter filter(config_, Filters::Common::ExtAuthz::ClientPtr{client});
+  filter.setDecoderFilterCallbacks(decoder_filter_callbacks_);
+  EXPECT_CALL(*client, check(_, _, _, _)).Times(0);
+  Http::TestRequestHeaderMapImpl request_headers{{"x-user", "alice"}};
+  EXPECT_EQ(Http::FilterHeadersStatus::Continue, filter.decodeHeaders(request_headers, false));
+  EXPECT_EQ(request_headers.get_("x-authz"), "yes");
+  EXPECT_EQ(1U, config_->stats().decision_cache_hit_.value());
+  EXPECT_EQ(2U, config_->stats().ok_.value());
+}
+
+// Test that a denied decision isn't cached without a denied_ttl.
+TEST_F(HttpFilterTest, DecisionCacheSkipsDenied) {
+  initialize(R"EOF(
+  grpc_service:
+    envoy_grpc:
+      cluster_name: "ext_authz_server"
+  decision_cache:
+    key_headers: ["x-user"]
+    ttl: 60s
+  )EOF");
+  prepareCheck();
+  request_headers_.addCopy("x-user", "mallory");
+
+  Filters::Common::ExtAuthz::Response response{};
+  response.status = Filters::Common::ExtAuthz::CheckStatus::Denied;
+  response.status_code = Http::Code::Forbidden;
+  EXPECT_CALL(*client_, check(_, _, _, _))
+      .WillOnce(Invoke([&](Filters::Common::ExtAuthz::RequestCallbacks& callbacks,
+                           const envoy::service::auth::v3::CheckRequest&, Tracing::Span&,
+                           const StreamInfo::StreamInfo&) -> void {
+        callbacks.onComplete(std::make_unique<Filters::Common::ExtAuthz::Response>(response));
+      }));
+  EXPECT_EQ(Http::FilterHeadersStatus::StopAllIterationAndWatermark,
+            filter_->decodeHeaders(request_headers_, false));
+
+  auto* client = new Filters::Common::ExtAuthz::MockClient();
+  Filter filter(config_, Filters::Common::ExtAuthz::ClientPtr{client});
+  filter.setDecoderFilterCallbacks(decoder_filter_callbacks_);
+  EXPECT_CALL(*client, check(_, _, _, _));
+  Http::TestRequestHeaderMapImpl request_headers{{"x-user", "mallory"}};
+  filter.decodeHeaders(request_headers, false);
+  EXPECT_EQ(0U, config_->stats().decision_cache_hit_.value());
+  EXPECT_EQ(2U, config_->stats().decision_cache_miss_.value());
+  filter.onDestroy();
+}
+
 TEST_F(HttpFilterTest, BadConfig) {
   const std::string filter_config = R"EOF(
   grpc_service:
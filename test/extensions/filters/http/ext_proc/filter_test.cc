@@ -4250,6 +4250,118 @@ TEST_F(HttpFilterTest, StreamingAllDataInObservabilityMode) {
   EXPECT_EQ(1, config_->stats().streams_closed_.value());
 }
 
+TEST_F(HttpFilterTest, CoalescedBodiesInObservabilityMode) {
+  initialize(R"EOF(
+  grpc_service:
+    envoy_grpc:
+      cluster_name: "ext_proc_server"
+  observability_mode: true
+  observability_body_coalescing:
+    min_bytes: 10
+    max_delay: 0.05s
+  processing_mode:
+    request_header_mode: "SEND"
+    response_header_mode: "SEND"
+    request_body_mode: "STREAMED"
+    response_body_mode: "STREAMED"
+    request_trailer_mode: "SEND"
+    response_trailer_mode: "SKIP"
+  )EOF");
+
+  observability_mode_ = true;
+
+  HttpTestUtility::addDefaultHeaders(request_headers_);
+  request_headers_.setMethod("POST");
+  EXPECT_EQ(FilterHeadersStatus::Continue, filter_->decodeHeaders(request_headers_, false));
+  processRequestHeaders(false, absl::nullopt);
+
+  // The chunks are held back until they hold enough bytes.
+  auto* request_body_timer = new Event::MockTimer(&dispatcher_);
+  EXPECT_CALL(*request_body_timer, enableTimer(std::chrono::milliseconds(50), _));
+  sendChunkRequestData(3, false);
+  EXPECT_EQ(1, config_->stats().stream_msgs_sent_.value());
+  sendChunkRequestData(1, false);
+  EXPECT_EQ(2, config_->stats().stream_msgs_sent_.value());
+  ASSERT_TRUE(last_request_.has_request_body());
+  EXPECT_TRUE(last_request_.observability_mode());
+  EXPECT_EQ("foofoofoofoo", last_request_.request_body().body());
+  EXPECT_FALSE(request_body_timer->enabled());
+
+  // The timer sends the chunks which don't hold enough bytes.
+  EXPECT_CALL(*request_body_timer, enableTimer(std::chrono::milliseconds(50), _));
+  sendChunkRequestData(1, false);
+  request_body_timer->invokeCallback();
+  EXPECT_EQ(3, config_->stats().stream_msgs_sent_.value());
+  EXPECT_EQ("foo", last_request_.request_body().body());
+
+  // The trailers send the chunks held back first.
+  EXPECT_CALL(*request_body_timer, enableTimer(std::chrono::milliseconds(50), _));
+  sendChunkRequestData(1, false);
+  EXPECT_EQ(FilterTrailersStatus::Continue, filter_->decodeTrailers(request_trailers_));
+  EXPECT_EQ(5, config_->stats().stream_msgs_sent_.value());
+  EXPECT_TRUE(last_request_.has_request_trailers());
+
+  response_headers_.addCopy(LowerCaseString(":status"), "200");
+  EXPECT_EQ(FilterHeadersStatus::Continue, filter_->encodeHeaders(response_headers_, false));
+  processResponseHeaders(false, absl::nullopt);
+
+  // The end of the stream sends the chunks held back along with it.
+  sendChunkResponseData(2, false);
+  Buffer::OwnedImpl last_resp_chunk("bar");
+  EXPECT_EQ(FilterDataStatus::Continue, filter_->encodeData(last_resp_chunk, true));
+  EXPECT_EQ(7, config_->stats().stream_msgs_sent_.value());
+  ASSERT_TRUE(last_request_.has_response_body());
+  EXPECT_EQ("barbarbar", last_request_.response_body().body());
+  EXPECT_TRUE(last_request_.response_body().end_of_stream());
+
+  deferred_close_timer_ = new Event::MockTimer(&dispatcher_);
+  EXPECT_CALL(*deferred_close_timer_,
+              enableTimer(std::chrono::milliseconds(DEFAULT_CLOSE_TIMEOUT_MS), _));
+  filter_->onDestroy();
+  deferred_close_timer_->invokeCallback();
+  EXPECT_EQ(7, config_->stats().stream_msgs_sent_.value());
+}
+
+TEST_F(HttpFilterTest, CoalescedBodyIsSentOnDestroyInObservabilityMode) {
+  initialize(R"EOF(
+  grpc_service:
+    envoy_grpc:
+      cluster_name: "ext_proc_server"
+  observability_mode: true
+  observability_body_coalescing:
+    min_bytes: 1024
+  processing_mode:
+    request_header_mode: "SEND"
+    response_header_mode: "SKIP"
+    request_body_mode: "STREAMED"
+    response_body_mode: "NONE"
+  )EOF");
+
+  observability_mode_ = true;
+
+  HttpTestUtility::addDefaultHeaders(request_headers_);
+  request_headers_.setMethod("POST");
+  EXPECT_EQ(FilterHeadersStatus::Continue, filter_->decodeHeaders(request_headers_, false));
+  processRequestHeaders(false, absl::nullopt);
+
+  // The timer is armed with the default delay.
+  auto* request_body_timer = new Event::MockTimer(&dispatcher_);
+  EXPECT_CALL(*request_body_timer, enableTimer(std::chrono::milliseconds(100), _));
+  sendChunkRequestData(2, false);
+  EXPECT_EQ(1, config_->stats().stream_msgs_sent_.value());
+
+  deferred_close_timer_ = new Event::MockTimer(&dispatcher_);
+  EXPECT_CALL(*deferred_close_timer_,
+              enableTimer(std::chrono::milliseconds(DEFAULT_CLOSE_TIMEOUT_MS), _));
+  filter_->onDestroy();
+  EXPECT_EQ(2, config_->stats().stream_msgs_sent_.value());
+  ASSERT_TRUE(last_request_.has_request_body());
+  EXPECT_EQ("foofoo", last_request_.request_body().body());
+  EXPECT_FALSE(last_request_.request_body().end_of_stream());
+  EXPECT_FALSE(request_body_timer->enabled());
+  deferred_close_timer_->invokeCallback();
+}
+
 class HttpFilter2Test : public HttpFilterTest,
                         public ::Envoy::Http::HttpConnectionManagerImplMixin {};
 
@@ -0,0 +1,140 @@
+#include "envoy/config/core/v3/grpc_service.pb.h"
+
+#include "source/extensions/filters/http/ext_proc/multiplexed_stream.h"
+
+#include "test/extensions/filters/http/ext_proc/mock_server.h"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+using envoy::service::ext_proc::v3::ProcessingRequest;
+using envoy::service::ext_proc::v3::ProcessingResponse;
+
+using testing::_;
+using testing::Invoke;
+using testing::Return;
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace ExternalProcessing {
+namespace {
+
+class MockCallbacks : public ExternalProcessorCallbacks {
+public:
+  MOCK_METHOD(void, onReceiveMessage, (std::unique_ptr<ProcessingResponse> && response));
+  MOCK_METHOD(void, onGrpcError, (Grpc::Status::GrpcStatus error));
+  MOCK_METHOD(void, onGrpcClose, ());
+  MOCK_METHOD(void, logGrpcStreamInfo, ());
+};
+
+class MultiplexedStreamTest : public testing::Test {
+protected:
+  MultiplexedStreamTest() {
+    envoy::config::core::v3::GrpcService grpc_service;
+    grpc_service.mutable_envoy_grpc()->set_cluster_name("test");
+    config_with_hash_key_.setConfig(grpc_service);
+  }
+
+  // Expects the next HTTP stream to start a shared gRPC stream, which is returned.
+  testing::NiceMock<MockStream>* expectGrpcStream() {
+    auto* grpc_stream = new testing::NiceMock<MockStream>();
+    EXPECT_CALL(client_, start(_, _, _))
+        .WillOnce(Invoke([this, grpc_stream](ExternalProcessorCallbacks& callbacks, auto&, auto&) {
+          grpc_callbacks_ = &callbacks;
+          return ExternalProcessorStreamPtr{grpc_stream};
+        }));
+    return grpc_stream;
+  }
+
+  std::unique_ptr<ProcessingResponse> response(uint64_t correlation_id) {
+    auto response = std::make_unique<ProcessingResponse>();
+    response->mutable_request_headers();
+    response->set_correlation_id(correlation_id);
+    return response;
+  }
+
+  Grpc::GrpcServiceConfigWithHashKey config_with_hash_key_;
+  MockClient client_;
+  ExternalProcessorCallbacks* grpc_callbacks_{};
+  MultiplexedStreamPool pool_;
+};
+
+TEST_F(MultiplexedStreamTest, HttpStreamsShareTheGrpcStream) {
+  testing::NiceMock<MockStream>* grpc_stream = expectGrpcStream();
+  MockCallbacks callbacks_1;
+  MockCallbacks callbacks_2;
+  ExternalProcessorStreamPtr stream_1 = pool_.start(client_, callbacks_1, config_with_hash_key_);
+  ExternalProcessorStreamPtr stream_2 = pool_.start(client_, callbacks_2, config_with_hash_key_);
+  ASSERT_NE(stream_1, nullptr);
+  ASSERT_NE(stream_2, nullptr);
+
+  // The requests carry the correlation id of their HTTP stream.
+  std::vector<uint64_t> sent_ids;
+  EXPECT_CALL(*grpc_stream, send(_, false))
+      .Times(2)
+      .WillRepeatedly(Invoke([&sent_ids](ProcessingRequest&& request, bool) {
+        sent_ids.push_back(request.correlation_id());
+      }));
+  stream_1->send(ProcessingRequest(), false);
+  stream_2->send(ProcessingRequest(), true);
+  ASSERT_EQ(2, sent_ids.size());
+  EXPECT_NE(sent_ids[0], sent_ids[1]);
+
+  // The responses are dispatched by their correlation id.
+  EXPECT_CALL(callbacks_2, onReceiveMessage(_));
+  grpc_callbacks_->onReceiveMessage(response(sent_ids[1]));
+  EXPECT_CALL(callbacks_1, onReceiveMessage(_));
+  grpc_callbacks_->onReceiveMessage(response(sent_ids[0]));
+
+  // Closing an HTTP stream leaves the gRPC stream open, and its responses are then ignored.
+  EXPECT_CALL(*grpc_stream, close()).Times(0);
+  EXPECT_TRUE(stream_1->close());
+  EXPECT_FALSE(stream_1->close());
+  grpc_callbacks_->onReceiveMessage(response(sent_ids[0]));
+  stream_1.reset();
+  stream_2.reset();
+  testing::Mock::VerifyAndClearExpectations(grpc_stream);
+}
+
+TEST_F(MultiplexedStreamTest, GrpcStreamClosureEndsAllHttpStreams) {
+  expectGrpcStream();
+  MockCallbacks callbacks_1;
+  MockCallbacks callbacks_2;
+  ExternalProcessorStreamPtr stream_1 = pool_.start(client_, callbacks_1, config_with_hash_key_);
+  ExternalProcessorStreamPtr stream_2 = pool_.start(client_, callbacks_2, config_with_hash_key_);
+
+  // An HTTP stream closing its stream when told doesn't keep the other one from being told.
+  EXPECT_CALL(callbacks_1, logGrpcStreamInfo());
+  EXPECT_CALL(callbacks_1, onGrpcError(Grpc::Status::WellKnownGrpcStatus::Internal))
+      .WillOnce(Invoke([&stream_1](Grpc::Status::GrpcStatus) { stream_1->close(); }));
+  EXPECT_CALL(callbacks_2, logGrpcStreamInfo());
+  EXPECT_CALL(callbacks_2, onGrpcError(Grpc::Status::WellKnownGrpcStatus::Internal))
+      .WillOnce(Invoke([&stream_2](Grpc::Status::GrpcStatus) { stream_2->close(); }));
+  grpc_callbacks_->onGrpcError(Grpc::Status::WellKnownGrpcStatus::Internal);
+
+  // The next HTTP stream starts a new gRPC stream.
+  testing::NiceMock<MockStream>* new_grpc_stream = expectGrpcStream();
+  MockCallbacks callbacks_3;
+  ExternalProcessorStreamPtr stream_3 = pool_.start(client_, callbacks_3, config_with_hash_key_);
+  ASSERT_NE(stream_3, nullptr);
+  EXPECT_CALL(*new_grpc_stream, send(_, false));
+  stream_3->send(ProcessingRequest(), false);
+}
+
+TEST_F(MultiplexedStreamTest, StartFailureIsReported) {
+  EXPECT_CALL(client_, start(_, _, _)).WillOnce(Return(nullptr));
+  MockCallbacks callbacks;
+  EXPECT_CALL(callbacks, onGrpcError(Grpc::Status::WellKnownGrpcStatus::Unavailable));
+  EXPECT_EQ(nullptr, pool_.start(client_, callbacks, config_with_hash_key_));
+
+  // The next HTTP stream tries again.
+  expectGrpcStream();
+  EXPECT_NE(nullptr, pool_.start(client_, callbacks, config_with_hash_key_));
+}
+
+} // namespace
+} // namespace ExternalProcessing
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
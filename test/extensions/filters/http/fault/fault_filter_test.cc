@@ -556,6 +556,9 @@ TEST_F(FaultFilterTest, Passthrough) {
   envoy::extensions::filters::http::fault::v3::HTTPFault fault;
   setUpTest(fault);
 
+  // Without any fault configured, the runtime isn't consulted.
+  request_headers_.addCopy("x-envoy-downstream-service-cluster", "cluster");
+  EXPECT_CALL(runtime_, snapshot()).Times(0);
   EXPECT_EQ(Http::FilterHeadersStatus::Continue, filter_->decodeHeaders(request_headers_, true));
 
   EXPECT_EQ(0UL, config_->stats().active_faults_.value());
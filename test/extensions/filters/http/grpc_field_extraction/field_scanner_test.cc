@@ -0,0 +1,198 @@
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "source/common/buffer/buffer_impl.h"
+#include "source/common/grpc/common.h"
+#include "source/extensions/filters/http/grpc_field_extraction/field_scanner.h"
+
+#include "test/proto/apikeys.pb.h"
+
+#include "gmock/gmock.h"
+#include "grpc_transcoding/type_helper.h"
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace GrpcFieldExtraction {
+namespace {
+
+using ::apikeys::CreateApiKeyRequest;
+using ::envoy::extensions::filters::http::grpc_field_extraction::v3::FieldExtractions;
+using ::testing::ElementsAre;
+using ::testing::IsEmpty;
+
+constexpr absl::string_view kRequestTypeUrl = "type.googleapis.com/apikeys.CreateApiKeyRequest";
+
+class FieldScannerTest : public ::testing::Test {
+protected:
+  FieldScannerTest()
+      : type_helper_(Protobuf::util::NewTypeResolverForDescriptorPool(
+            Grpc::Common::typeUrlPrefix(), Protobuf::DescriptorPool::generated_pool())),
+        type_finder_([this](const std::string& type_url) {
+          return type_helper_.Info()->GetTypeByTypeUrl(type_url);
+        }) {}
+
+  absl::StatusOr<FieldScannerPathsConstPtr> createPaths(const std::vector<std::string>& paths) {
+    for (const std::string& path : paths) {
+      (*field_extractions_.mutable_request_field_extractions())[path];
+    }
+    return FieldScannerPaths::create(type_finder_, kRequestTypeUrl, field_extractions_);
+  }
+
+  // Returns the values extracted of the paths, feeding the message a byte at a time if asked.
+  absl::flat_hash_map<std::string, std::vector<std::string>>
+  extract(const std::vector<std::string>& paths, const CreateApiKeyRequest& request,
+          bool byte_by_byte) {
+    auto scanner_paths = createPaths(paths);
+    EXPECT_TRUE(scanner_paths.ok()) << scanner_paths.status();
+    FieldScanner scanner(**scanner_paths);
+    Buffer::InstancePtr data = Grpc::Common::serializeToGrpcFrame(request);
+    if (byte_by_byte) {
+      while (data->length() > 0 && !scanner.done()) {
+        Buffer::OwnedImpl byte;
+        byte.move(*data, 1);
+        EXPECT_TRUE(scanner.scan(byte).ok());
+      }
+    } else {
+      EXPECT_TRUE(scanner.scan(*data).ok());
+    }
+    EXPECT_TRUE(scanner.done());
+
+    absl::flat_hash_map<std::string, std::vector<std::string>> values;
+    for (const RequestField& field : scanner.result()) {
+      values[std::string(field.path)] = field.values;
+    }
+    return values;
+  }
+
+  const google::grpc::transcoding::TypeHelper type_helper_;
+  const TypeFinder type_finder_;
+  FieldExtractions field_extractions_;
+};
+
+CreateApiKeyRequest makeRequest(absl::string_view pb) {
+  CreateApiKeyRequest request;
+  EXPECT_TRUE(Protobuf::TextFormat::ParseFromString(pb, &request));
+  return request;
+}
+
+TEST_F(FieldScannerTest, ExtractsFieldTypes) {
+  const CreateApiKeyRequest request = makeRequest(R"pb(
+    parent: "project-id"
+    key: { name: "key-name" display_name: "ignored" }
+    supported_types: {
+      string: "1" uint32: 2 int32: -4 sint32: -6 sint64: -7 fixed64: 9 sfixed32: -10
+      float: 1.2 double: 1.3
+    }
+    repeated_supported_types: { string: [ "a", "b" ] uint64: [ 3, 33 ] fixed32: [ 8, 88 ] }
+  )pb");
+  const std::vector<std::string> paths = {
+      "parent",
+      "key.name",
+      "supported_types.string",
+      "supported_types.uint32",
+      "supported_types.int32",
+      "supported_types.sint32",
+      "supported_types.sint64",
+      "supported_types.fixed64",
+      "supported_types.sfixed32",
+      "supported_types.float",
+      "supported_types.double",
+      "supported_types.uint64",
+      "repeated_supported_types.string",
+      "repeated_supported_types.uint64",
+      "repeated_supported_types.fixed32",
+  };
+
+  for (const bool byte_by_byte : {false, true}) {
+    auto values = extract(paths, request, byte_by_byte);
+    EXPECT_THAT(values["parent"], ElementsAre("project-id"));
+    EXPECT_THAT(values["key.name"], ElementsAre("key-name"));
+    EXPECT_THAT(values["supported_types.string"], ElementsAre("1"));
+    EXPECT_THAT(values["supported_types.uint32"], ElementsAre("2"));
+    EXPECT_THAT(values["supported_types.int32"], ElementsAre("-4"));
+    EXPECT_THAT(values["supported_types.sint32"], ElementsAre("-6"));
+    EXPECT_THAT(values["supported_types.sint64"], ElementsAre("-7"));
+    EXPECT_THAT(values["supported_types.fixed64"], ElementsAre("9"));
+    EXPECT_THAT(values["supported_types.sfixed32"], ElementsAre("-10"));
+    EXPECT_THAT(values["supported_types.float"], ElementsAre("1.2"));
+    EXPECT_THAT(values["supported_types.double"], ElementsAre("1.3"));
+    EXPECT_THAT(values["supported_types.uint64"], IsEmpty());
+    EXPECT_THAT(values["repeated_supported_types.string"], ElementsAre("a", "b"));
+    // The repeated scalars are packed.
+    EXPECT_THAT(values["repeated_supported_types.uint64"], ElementsAre("3", "33"));
+    EXPECT_THAT(values["repeated_supported_types.fixed32"], ElementsAre("8", "88"));
+  }
+}
+
+TEST_F(FieldScannerTest, DoneAfterTheLastField) {
+  const CreateApiKeyRequest request = makeRequest(R"pb(
+    parent: "project-id"
+    key: { name: "key-name" }
+  )pb");
+  auto scanner_paths = createPaths({"parent"});
+  ASSERT_TRUE(scanner_paths.ok());
+  FieldScanner scanner(**scanner_paths);
+
+  // The scan is done on the tag of the field after the parent, without its value.
+  Buffer::InstancePtr data = Grpc::Common::serializeToGrpcFrame(request);
+  Buffer::OwnedImpl prefix;
+  prefix.move(*data, 5 + 2 + request.parent().size());
+  ASSERT_TRUE(scanner.scan(prefix).ok());
+  EXPECT_FALSE(scanner.done());
+  prefix.move(*data, 1);
+  ASSERT_TRUE(scanner.scan(prefix).ok());
+  EXPECT_TRUE(scanner.done());
+  ASSERT_EQ(1, scanner.result().size());
+  EXPECT_THAT(scanner.result()[0].values, ElementsAre("project-id"));
+}
+
+TEST_F(FieldScannerTest, EmptyMessage) {
+  auto values = extract({"parent", "key.name"}, CreateApiKeyRequest(), false);
+  EXPECT_THAT(values["parent"], IsEmpty());
+  EXPECT_THAT(values["key.name"], IsEmpty());
+}
+
+TEST_F(FieldScannerTest, MalformedMessage) {
+  auto scanner_paths = createPaths({"key.name"});
+  ASSERT_TRUE(scanner_paths.ok());
+
+  {
+    // A field running past the end of its message.
+    FieldScanner scanner(**scanner_paths);
+    Buffer::OwnedImpl data(absl::string_view("\x00\x00\x00\x00\x03\x12\x05\x0a", 8));
+    EXPECT_FALSE(scanner.scan(data).ok());
+  }
+  {
+    // A compressed message.
+    FieldScanner scanner(**scanner_paths);
+    Buffer::OwnedImpl data(absl::string_view("\x01\x00\x00\x00\x00", 5));
+    EXPECT_FALSE(scanner.scan(data).ok());
+  }
+  {
+    // A group.
+    FieldScanner scanner(**scanner_paths);
+    Buffer::OwnedImpl data(absl::string_view("\x00\x00\x00\x00\x02\x0b\x0c", 7));
+    EXPECT_FALSE(scanner.scan(data).ok());
+  }
+}
+
+TEST_F(FieldScannerTest, InvalidPaths) {
+  EXPECT_EQ("the field `unknown` of the path `key.unknown` isn't in `apikeys.ApiKey`",
+            createPaths({"key.unknown"}).status().message());
+  field_extractions_.Clear();
+  EXPECT_EQ("the type of the field at the end of the path `unsupported_types.bool` isn't "
+            "supported",
+            createPaths({"unsupported_types.bool"}).status().message());
+  field_extractions_.Clear();
+  EXPECT_EQ("the field `parent` of the path `parent.name` isn't a message",
+            createPaths({"parent.name"}).status().message());
+}
+
+} // namespace
+} // namespace GrpcFieldExtraction
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
@@ -254,6 +254,54 @@ extractions_by_method: {
   checkSerializedData<CreateApiKeyRequest>(*request_data4, {request4});
 }
 
+TEST_F(FilterTestExtractOk, ExtractFromMessagePrefix) {
+  setUp(R"pb(
+extract_from_message_prefix: true
+extractions_by_method: {
+  key: "apikeys.ApiKeys.CreateApiKey"
+  value: {
+    request_field_extractions: {
+      key: "parent"
+      value: {
+      }
+    }
+  }
+})pb");
+  // Only the prefix of the message is held.
+  ON_CALL(mock_decoder_callbacks_, decoderBufferLimit()).WillByDefault(testing::Return(64));
+  TestRequestHeaderMapImpl req_headers =
+      TestRequestHeaderMapImpl{{":method", "POST"},
+                               {":path", "/apikeys.ApiKeys/CreateApiKey"},
+                               {"content-type", "application/grpc"}};
+  EXPECT_EQ(Envoy::Http::FilterHeadersStatus::StopIteration,
+            filter_->decodeHeaders(req_headers, false));
+
+  CreateApiKeyRequest request = makeCreateApiKeyRequest();
+  request.mutable_key()->set_display_name(std::string(1024, 'a'));
+  Envoy::Buffer::InstancePtr request_data = Envoy::Grpc::Common::serializeToGrpcFrame(request);
+  Envoy::Buffer::OwnedImpl start_request_data;
+  start_request_data.move(*request_data, 8);
+  EXPECT_EQ(Envoy::Http::FilterDataStatus::StopIterationNoBuffer,
+            filter_->decodeData(start_request_data, false));
+  EXPECT_EQ(start_request_data.length(), 0);
+
+  // The extraction is done once past the parent, and the data held is released.
+  Envoy::Buffer::OwnedImpl middle_request_data;
+  middle_request_data.move(*request_data, 32);
+  EXPECT_CALL(mock_decoder_callbacks_.stream_info_, setDynamicMetadata(_, _))
+      .WillOnce(Invoke([](const std::string& ns, const ProtobufWkt::Struct& new_dynamic_metadata) {
+        EXPECT_EQ(ns, "envoy.filters.http.grpc_field_extraction");
+        checkProtoStruct(new_dynamic_metadata, expected_metadata);
+      }));
+  EXPECT_EQ(Envoy::Http::FilterDataStatus::Continue,
+            filter_->decodeData(middle_request_data, false));
+  EXPECT_EQ(middle_request_data.length(), 40);
+
+  EXPECT_EQ(Envoy::Http::FilterDataStatus::Continue, filter_->decodeData(*request_data, true));
+  middle_request_data.move(*request_data);
+  checkSerializedData<CreateApiKeyRequest>(middle_request_data, {request});
+}
+
 using FilterTestFieldTypes = FilterTestBase;
 TEST_F(FilterTestFieldTypes, SingularType) {
   setUp(R"pb(
@@ -1376,6 +1376,89 @@ TEST_F(GrpcJsonTranscoderFilterMaxMessageSizeTest, DoesNotDecreaseBufferSize) {
   EXPECT_EQ(Http::FilterHeadersStatus::Continue, filter_.decodeHeaders(request_headers, false));
 };
 
+class GrpcJsonTranscoderFilterStreamHttpBodyTest : public GrpcJsonTranscoderFilterTest {
+public:
+  GrpcJsonTranscoderFilterStreamHttpBodyTest()
+      : GrpcJsonTranscoderFilterTest(makeProtoConfig()) {}
+
+private:
+  static const envoy::extensions::filters::http::grpc_json_transcoder::v3::GrpcJsonTranscoder
+  makeProtoConfig() {
+    auto proto_config = bookstoreProtoConfig();
+    proto_config.set_stream_http_body_requests(true);
+    return proto_config;
+  }
+};
+
+TEST_F(GrpcJsonTranscoderFilterStreamHttpBodyTest, StreamsBodyOfKnownLength) {
+  Http::TestRequestHeaderMapImpl request_headers{{":method", "POST"},
+                                                 {":path", "/postBody?arg=hi"},
+                                                 {"content-type", "text/plain"},
+                                                 {"content-length", "12"}};
+  EXPECT_EQ(Http::FilterHeadersStatus::Continue, filter_.decodeHeaders(request_headers, false));
+  EXPECT_FALSE(request_headers.has("content-length"));
+
+  // Each chunk is forwarded as it comes, the first one behind the frame header and the envelope.
+  Buffer::OwnedImpl output;
+  for (const absl::string_view chunk : {"hello", " ", "world!"}) {
+    Buffer::OwnedImpl buffer(chunk);
+    EXPECT_EQ(Http::FilterDataStatus::Continue, filter_.decodeData(buffer, chunk == "world!"));
+    EXPECT_GE(buffer.length(), chunk.size());
+    output.move(buffer);
+  }
+
+  std::vector<Grpc::Frame> frames;
+  Grpc::Decoder decoder;
+  std::ignore = decoder.decode(output, frames);
+  ASSERT_EQ(frames.size(), 1);
+  EXPECT_EQ(0, output.length());
+
+  bookstore::EchoBodyRequest expected_request;
+  expected_request.set_arg("hi");
+  expected_request.mutable_nested()->mutable_content()->set_content_type("text/plain");
+  expected_request.mutable_nested()->mutable_content()->set_data("hello world!");
+
+  bookstore::EchoBodyRequest request;
+  request.ParseFromString(frames[0].data_->toString());
+  EXPECT_THAT(request, ProtoEq(expected_request));
+}
+
+TEST_F(GrpcJsonTranscoderFilterStreamHttpBodyTest, BufferedWithoutContentLength) {
+  Http::TestRequestHeaderMapImpl request_headers{
+      {":method", "POST"}, {":path", "/postBody?arg=hi"}, {"content-type", "text/plain"}};
+  EXPECT_EQ(Http::FilterHeadersStatus::Continue, filter_.decodeHeaders(request_headers, false));
+
+  Buffer::OwnedImpl buffer("hello");
+  EXPECT_EQ(Http::FilterDataStatus::StopIterationAndBuffer, filter_.decodeData(buffer, false));
+  EXPECT_EQ(buffer.length(), 0);
+}
+
+TEST_F(GrpcJsonTranscoderFilterStreamHttpBodyTest, ResetsBodyLongerThanContentLength) {
+  Http::TestRequestHeaderMapImpl request_headers{{":method", "POST"},
+                                                 {":path", "/postBody?arg=hi"},
+                                                 {"content-type", "text/plain"},
+                                                 {"content-length", "4"}};
+  EXPECT_EQ(Http::FilterHeadersStatus::Continue, filter_.decodeHeaders(request_headers, false));
+
+  Buffer::OwnedImpl buffer("hello");
+  EXPECT_CALL(decoder_callbacks_, resetStream(_, _));
+  EXPECT_EQ(Http::FilterDataStatus::StopIterationNoBuffer, filter_.decodeData(buffer, false));
+}
+
+TEST_F(GrpcJsonTranscoderFilterStreamHttpBodyTest, ResetsBodyShorterThanContentLength) {
+  Http::TestRequestHeaderMapImpl request_headers{{":method", "POST"},
+                                                 {":path", "/postBody?arg=hi"},
+                                                 {"content-type", "text/plain"},
+                                                 {"content-length", "12"}};
+  EXPECT_EQ(Http::FilterHeadersStatus::Continue, filter_.decodeHeaders(request_headers, false));
+
+  Buffer::OwnedImpl buffer("hello");
+  EXPECT_EQ(Http::FilterDataStatus::Continue, filter_.decodeData(buffer, false));
+  Http::TestRequestTrailerMapImpl request_trailers;
+  EXPECT_CALL(decoder_callbacks_, resetStream(_, _));
+  EXPECT_EQ(Http::FilterTrailersStatus::StopIteration, filter_.decodeTrailers(request_trailers));
+}
+
 class GrpcJsonTranscoderFilterReportCollisionTest : public GrpcJsonTranscoderFilterTest {
 public:
   GrpcJsonTranscoderFilterReportCollisionTest() : GrpcJsonTranscoderFilterTest(makeProtoConfig()) {}
@@ -7,15 +7,23 @@
 #include "source/common/network/utility.h"
 #include "source/extensions/filters/http/ip_tagging/ip_tagging_filter.h"
 
+#include "test/mocks/event/mocks.h"
+#include "test/mocks/filesystem/mocks.h"
 #include "test/mocks/http/mocks.h"
 #include "test/mocks/runtime/mocks.h"
 #include "test/mocks/stats/mocks.h"
+#include "test/mocks/thread_local/mocks.h"
+#include "test/test_common/environment.h"
 #include "test/test_common/utility.h"
 
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 
+using testing::_;
+using testing::AnyNumber;
+using testing::DoAll;
 using testing::Return;
+using testing::SaveArg;
 
 namespace Envoy {
 namespace Extensions {
@@ -42,14 +50,30 @@ ip_tags:
   void initializeFilter(const std::string& yaml) {
     envoy::extensions::filters::http::ip_tagging::v3::IPTagging config;
     TestUtility::loadFromYaml(yaml, config);
-    config_ =
-        std::make_shared<IpTaggingFilterConfig>(config, "prefix.", *stats_.rootScope(), runtime_);
+    config_ = std::make_shared<IpTaggingFilterConfig>(config, "prefix.", *stats_.rootScope(),
+                                                      runtime_, dispatcher_, tls_, *api_);
     filter_ = std::make_unique<IpTaggingFilter>(config_);
     filter_->setDecoderFilterCallbacks(filter_callbacks_);
   }
 
-  ~IpTaggingFilterTest() override { filter_->onDestroy(); }
+  ~IpTaggingFilterTest() override {
+    if (filter_ != nullptr) {
+      filter_->onDestroy();
+    }
+  }
+
+  // Returns the tags of a request from the address.
+  std::string tagRequest(const std::string& address) {
+    filter_callbacks_.stream_info_.downstream_connection_info_provider_->setRemoteAddress(
+        Network::Utility::parseInternetAddressNoThrow(address));
+    Http::TestRequestHeaderMapImpl request_headers;
+    EXPECT_EQ(Http::FilterHeadersStatus::Continue, filter_->decodeHeaders(request_headers, false));
+    return request_headers.get_(Http::Headers::get().EnvoyIpTags);
+  }
 
+  NiceMock<Event::MockDispatcher> dispatcher_;
+  NiceMock<ThreadLocal::MockInstance> tls_;
+  Api::ApiPtr api_{Api::createApiForTest()};
   NiceMock<Stats::MockStore> stats_;
   IpTaggingFilterConfigSharedPtr config_;
   std::unique_ptr<IpTaggingFilter> filter_;
@@ -286,6 +310,94 @@ TEST_F(IpTaggingFilterTest, ClearRouteCache) {
   EXPECT_FALSE(request_headers.has(Http::Headers::get().EnvoyIpTags));
 }
 
+TEST_F(IpTaggingFilterTest, NoTags) {
+  EXPECT_THROW_WITH_MESSAGE(
+      initializeFilter("request_type: both"), EnvoyException,
+      "HTTP IP Tagging Filter requires ip_tags or ip_tags_file to be specified.");
+}
+
+TEST_F(IpTaggingFilterTest, TagsFile) {
+  const std::string tags_file_yaml = R"EOF(
+ip_tags:
+  - ip_tag_name: internal_request
+    ip_list:
+      - {address_prefix: 1.2.3.5, prefix_len: 32}
+ip_tags_file:
+  inline_string: |
+    # The tags of the file.
+    internal_request 1.2.3.6/32
+    bad_actor  10.0.0.0/8
+
+    bad_actor 2001:abcd::/64
+)EOF";
+  initializeFilter(tags_file_yaml);
+
+  EXPECT_CALL(stats_, counter(_)).Times(AnyNumber());
+  EXPECT_CALL(stats_, counter("prefix.ip_tagging.internal_request.hit")).Times(2);
+  EXPECT_CALL(stats_, counter("prefix.ip_tagging.bad_actor.hit")).Times(2);
+  EXPECT_EQ("internal_request", tagRequest("1.2.3.5"));
+  EXPECT_EQ("internal_request", tagRequest("1.2.3.6"));
+  EXPECT_EQ("bad_actor", tagRequest("10.1.2.3"));
+  EXPECT_EQ("bad_actor", tagRequest("2001:abcd::1"));
+  EXPECT_EQ("", tagRequest("1.2.3.4"));
+}
+
+TEST_F(IpTaggingFilterTest, InvalidTagsFile) {
+  EXPECT_THROW_WITH_MESSAGE(
+      initializeFilter(R"EOF(
+ip_tags_file:
+  inline_string: "bad_actor"
+)EOF"),
+      EnvoyException,
+      "invalid IP tag line 'bad_actor' (format is <ip tag name> <ip>/<# mask bits>)");
+  EXPECT_THROW_WITH_MESSAGE(initializeFilter(R"EOF(
+ip_tags_file:
+  inline_string: "bad_actor 10.0.0.0/33"
+)EOF"),
+                            EnvoyException,
+                            "invalid ip/mask combo '10.0.0.0/33' (format is <ip>/<# mask bits>)");
+}
+
+// Test that the tags of a watched file are reloaded, and kept if the new file is invalid.
+TEST_F(IpTaggingFilterTest, ReloadTagsFile) {
+  const std::string path =
+      TestEnvironment::writeStringToFileForTest("ip_tags", "bad_actor 10.0.0.0/8\n");
+  const std::string directory = TestEnvironment::temporaryDirectory();
+  auto* watcher = new Filesystem::MockWatcher();
+  Filesystem::Watcher::OnChangedCb on_changed;
+  EXPECT_CALL(dispatcher_, createFilesystemWatcher_()).WillOnce(Return(watcher));
+  EXPECT_CALL(*watcher, addWatch(directory + "/", Filesystem::Watcher::Events::MovedTo, _))
+      .WillOnce(DoAll(SaveArg<2>(&on_changed), Return(absl::OkStatus())));
+  initializeFilter(fmt::format(R"EOF(
+ip_tags:
+  - ip_tag_name: internal_request
+    ip_list:
+      - {{address_prefix: 1.2.3.5, prefix_len: 32}}
+ip_tags_file:
+  filename: "{}"
+  watched_directory:
+    path: "{}"
+)EOF",
+                               path, directory));
+  EXPECT_CALL(stats_, counter(_)).Times(AnyNumber());
+  EXPECT_EQ("bad_actor", tagRequest("10.1.2.3"));
+  EXPECT_EQ("", tagRequest("11.1.2.3"));
+
+  TestEnvironment::writeStringToFileForTest("ip_tags",
+                                            "bad_actor 11.0.0.0/8\nnew_tag 12.0.0.0/8\n");
+  EXPECT_TRUE(on_changed(Filesystem::Watcher::Events::MovedTo).ok());
+  EXPECT_EQ("", tagRequest("10.1.2.3"));
+  EXPECT_EQ("bad_actor", tagRequest("11.1.2.3"));
+  // The tags of the configuration are kept, and the hits of the new tags are unknown ones.
+  EXPECT_EQ("internal_request", tagRequest("1.2.3.5"));
+  EXPECT_CALL(stats_, counter("prefix.ip_tagging.unknown_tag.hit"));
+  EXPECT_EQ("new_tag", tagRequest("12.1.2.3"));
+
+  TestEnvironment::writeStringToFileForTest("ip_tags", "bad_actor 11.0.0.0\n");
+  EXPECT_TRUE(on_changed(Filesystem::Watcher::Events::MovedTo).ok());
+  EXPECT_EQ("bad_actor", tagRequest("11.1.2.3"));
+}
+
 } // namespace
 } // namespace IpTagging
 } // namespace HttpFilters
@@ -9,6 +9,8 @@
 #include "test/test_common/simulated_time_system.h"
 #include "test/test_common/utility.h"
 
+#include "absl/strings/str_cat.h"
+
 using ::google::jwt_verify::Status;
 
 namespace Envoy {
@@ -80,6 +82,52 @@ TEST_F(JwtCacheTest, TestExpiredToken) {
   EXPECT_TRUE(jwt == nullptr);
 }
 
+TEST_F(JwtCacheTest, TestSharedCache) {
+  envoy::extensions::filters::http::jwt_authn::v3::JwtCacheConfig config;
+  auto shared_cache = std::make_shared<SharedJwtCache>(100, time_system_);
+  JwtCachePtr worker_cache_1 = JwtCache::create(true, config, time_system_, shared_cache);
+  JwtCachePtr worker_cache_2 = JwtCache::create(true, config, time_system_, shared_cache);
+  loadJwt(GoodToken);
+  worker_cache_1->insert(GoodToken, std::move(jwt_));
+
+  // The token verified by a worker is found by the other one, which caches its own copy.
+  auto* jwt = worker_cache_2->lookup(GoodToken);
+  ASSERT_TRUE(jwt != nullptr);
+  EXPECT_EQ(jwt, worker_cache_2->lookup(GoodToken));
+  EXPECT_NE(jwt, worker_cache_1->lookup(GoodToken));
+  EXPECT_TRUE(worker_cache_2->lookup(OtherGoodToken) == nullptr);
+
+  // The token is no longer shared once the shared cache is cleared.
+  shared_cache->clear();
+  JwtCachePtr worker_cache_3 = JwtCache::create(true, config, time_system_, shared_cache);
+  EXPECT_TRUE(worker_cache_3->lookup(GoodToken) == nullptr);
+}
+
+TEST_F(JwtCacheTest, TestSharedCacheExpiredToken) {
+  SharedJwtCache shared_cache(100, time_system_);
+  loadJwt(ExpiredToken);
+  shared_cache.insert(ExpiredToken, jwt_->exp_);
+  EXPECT_FALSE(shared_cache.lookup(ExpiredToken));
+
+  loadJwt(NonExpiringToken);
+  shared_cache.insert(NonExpiringToken, jwt_->exp_);
+  EXPECT_TRUE(shared_cache.lookup(NonExpiringToken));
+}
+
+TEST_F(JwtCacheTest, TestSharedCacheIsBounded) {
+  // With one entry per shard, a token evicts the other token of its shard, if any.
+  SharedJwtCache shared_cache(1, time_system_);
+  for (int i = 0; i < 100; ++i) {
+    shared_cache.insert(absl::StrCat("token", i), 0);
+  }
+  int found = 0;
+  for (int i = 0; i < 100; ++i) {
+    found += shared_cache.lookup(absl::StrCat("token", i));
+  }
+  EXPECT_LE(found, 16);
+  EXPECT_TRUE(shared_cache.lookup("token99"));
+}
+
 } // namespace
 } // namespace JwtAuthn
 } // namespace HttpFilters
@@ -262,6 +262,28 @@ TEST_F(LuaHttpFilterTest, ScriptHeadersOnlyRequestHeadersOnly) {
   EXPECT_EQ(0, stats_store_.counter("test.lua.errors").value());
 }
 
+// A GC step is run and timed when the stream ends, and the coroutine is pooled for the next one.
+TEST_F(LuaHttpFilterTest, GarbageCollectionStepAndCoroutinePooling) {
+  envoy::extensions::filters::http::lua::v3::Lua proto_config;
+  proto_config.mutable_default_source_code()->set_inline_string(HEADER_ONLY_SCRIPT);
+  proto_config.mutable_garbage_collection()->mutable_pause()->set_value(400);
+  proto_config.mutable_garbage_collection()->set_step_size_kb(64);
+  proto_config.set_max_pooled_coroutines(8);
+  envoy::extensions::filters::http::lua::v3::LuaPerRoute per_route_proto_config;
+  setupConfig(proto_config, per_route_proto_config);
+
+  for (int i = 0; i < 2; ++i) {
+    setupFilter();
+    Http::TestRequestHeaderMapImpl request_headers{{":path", "/"}};
+    EXPECT_CALL(*filter_, scriptLog(spdlog::level::trace, StrEq("/")));
+    EXPECT_EQ(Http::FilterHeadersStatus::Continue, filter_->decodeHeaders(request_headers, true));
+    filter_->onDestroy();
+  }
+
+  EXPECT_EQ(0, stats_store_.counter("test.lua.errors").value());
+  EXPECT_EQ(2, stats_store_.histogramValues("test.lua.gc_step_time_us", false).size());
+}
+
 // Script touching headers only, request that has body.
 TEST_F(LuaHttpFilterTest, ScriptHeadersOnlyRequestBody) {
   InSequence s;
@@ -1000,6 +1000,56 @@ TEST_F(OAuth2Test, CookieValidatorSame) {
   EXPECT_FALSE(cookie_validator->isValid());
 }
 
+// Validates the cookies validated by the cookie validator are cached until they expire, for the
+// same cookies and secret only.
+TEST_F(OAuth2Test, CookieValidatorWithValidatedCookieCache) {
+  ValidatedCookieCache validated_cookies(factory_context_.server_factory_context_.thread_local_);
+  const CookieNames cookie_names("BearerToken", "OauthHMAC", "OauthExpires", "IdToken",
+                                 "RefreshToken");
+  test_time_.setSystemTime(SystemTime(std::chrono::seconds(0)));
+  const auto expires_at_s = DateUtil::nowToSeconds(test_time_.timeSystem()) + 10;
+  const auto request_headers = [&](absl::string_view token) {
+    return Http::TestRequestHeaderMapImpl{
+        {Http::Headers::get().Host.get(), "traffic.example.com"},
+        {Http::Headers::get().Path.get(), "/anypath"},
+        {Http::Headers::get().Method.get(), Http::Headers::get().MethodValues.Get},
+        {Http::Headers::get().Cookie.get(), fmt::format("OauthExpires={}", expires_at_s)},
+        {Http::Headers::get().Cookie.get(), absl::StrCat("BearerToken=", token)},
+        {Http::Headers::get().Cookie.get(),
+         "OauthHMAC=dCu0otMcLoaGF73jrT+R8rGA0pnWyMgNf4+GivGrHEI="},
+    };
+  };
+
+  OAuth2CookieValidator cookie_validator(test_time_, cookie_names, &validated_cookies);
+  cookie_validator.setParams(request_headers("xyztoken"), "mock-secret");
+  EXPECT_TRUE(cookie_validator.isValid());
+  // The cached cookies are still checked against the payload and the secret.
+  cookie_validator.setParams(request_headers("xyztoken"), "mock-secret");
+  EXPECT_TRUE(cookie_validator.isValid());
+  cookie_validator.setParams(request_headers("abctoken"), "mock-secret");
+  EXPECT_FALSE(cookie_validator.hmacIsValid());
+  cookie_validator.setParams(request_headers("xyztoken"), "other-secret");
+  EXPECT_FALSE(cookie_validator.hmacIsValid());
+
+  const std::vector<uint8_t> secret{'s'};
+  const std::vector<uint8_t> other_secret{'t'};
+  const SystemTime now = test_time_.systemTime();
+  const SystemTime expiry = now + std::chrono::seconds(10);
+  EXPECT_FALSE(validated_cookies.contains(secret, "hmac", "payload", now));
+  validated_cookies.insert(secret, "hmac", "payload", expiry, now);
+  EXPECT_TRUE(validated_cookies.contains(secret, "hmac", "payload", now));
+  EXPECT_FALSE(validated_cookies.contains(secret, "hmac", "other", now));
+  EXPECT_FALSE(validated_cookies.contains(secret, "other", "payload", now));
+  EXPECT_FALSE(validated_cookies.contains(secret, "hmac", "payload", expiry));
+  EXPECT_FALSE(validated_cookies.contains(secret, "hmac", "payload", now));
+
+  // The entries of a secret are dropped with it.
+  validated_cookies.insert(secret, "hmac", "payload", expiry, now);
+  validated_cookies.insert(other_secret, "other", "payload", expiry, now);
+  EXPECT_FALSE(validated_cookies.contains(secret, "hmac", "payload", now));
+  EXPECT_TRUE(validated_cookies.contains(other_secret, "other", "payload", now));
+}
+
 // Validates the behavior of the cookie validator when the expires_at value is not a valid integer.
 TEST_F(OAuth2Test, CookieValidatorInvalidExpiresAt) {
   Http::TestRequestHeaderMapImpl request_headers{
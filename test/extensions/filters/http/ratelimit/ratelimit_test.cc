@@ -16,8 +16,10 @@
 #include "test/mocks/local_info/mocks.h"
 #include "test/mocks/ratelimit/mocks.h"
 #include "test/mocks/runtime/mocks.h"
+#include "test/mocks/thread_local/mocks.h"
 #include "test/mocks/tracing/mocks.h"
 #include "test/test_common/printers.h"
+#include "test/test_common/simulated_time_system.h"
 #include "test/test_common/utility.h"
 
 #include "gmock/gmock.h"
@@ -1672,6 +1674,141 @@ TEST_F(HttpRateLimitFilterTest, StatsWithPrefix) {
   EXPECT_EQ("request_rate_limited", filter_callbacks_.details());
 }
 
+class HttpRateLimitFilterQuotaCacheTest : public HttpRateLimitFilterTest {
+public:
+  void setUpQuotaCache() {
+    setUpTest(filter_config_);
+    envoy::extensions::filters::http::ratelimit::v3::RateLimit::QuotaCache config;
+    config.mutable_renewal_threshold_percent()->set_value(20);
+    quota_cache_ = std::make_shared<QuotaCache>(config, tls_, time_system_);
+    ON_CALL(route_rate_limit_, populateDescriptors(_, _, _, _))
+        .WillByDefault(SetArgReferee<0>(descriptor_));
+  }
+
+  // Replaces the filter by the one of a new request.
+  void newRequest() {
+    client_ = new Filters::Common::RateLimit::MockClient();
+    filter_ = std::make_unique<Filter>(config_, Filters::Common::RateLimit::ClientPtr{client_},
+                                       quota_cache_);
+    filter_->setDecoderFilterCallbacks(filter_callbacks_);
+  }
+
+  // Expects the request to call the rate limit service, whose callbacks are then saved.
+  void expectCall() {
+    EXPECT_CALL(*client_, limit(_, "foo", _, _, _, 0))
+        .WillOnce(
+            WithArgs<0>(Invoke([&](Filters::Common::RateLimit::RequestCallbacks& callbacks) {
+              request_callbacks_ = &callbacks;
+            })));
+  }
+
+  static envoy::service::ratelimit::v3::RateLimitResponse::Quota quota(uint32_t requests) {
+    envoy::service::ratelimit::v3::RateLimitResponse::Quota quota;
+    quota.set_requests(requests);
+    return quota;
+  }
+
+  NiceMock<ThreadLocal::MockInstance> tls_;
+  Event::SimulatedTimeSystem time_system_;
+  QuotaCacheSharedPtr quota_cache_;
+};
+
+// Verifies that the requests are served out of the cached quota, which is renewed in the
+// background when it runs low.
+TEST_F(HttpRateLimitFilterQuotaCacheTest, ServesAndRenewsTheQuota) {
+  setUpQuotaCache();
+
+  // The first request calls the service, which grants a quota of 5 requests.
+  newRequest();
+  expectCall();
+  EXPECT_EQ(Http::FilterHeadersStatus::StopIteration,
+            filter_->decodeHeaders(request_headers_, false));
+  EXPECT_CALL(filter_callbacks_, continueDecoding());
+  request_callbacks_->onQuota(quota(5));
+  request_callbacks_->complete(Filters::Common::RateLimit::LimitStatus::OK, nullptr, nullptr,
+                               nullptr, "", nullptr);
+
+  // The next 2 requests are served out of the quota, with 2 requests left.
+  for (int i = 0; i < 2; i++) {
+    newRequest();
+    EXPECT_CALL(*client_, limit(_, _, _, _, _, _)).Times(0);
+    EXPECT_EQ(Http::FilterHeadersStatus::Continue, filter_->decodeHeaders(request_headers_, false));
+  }
+
+  // The next request leaves 1 request, the renewal threshold, and renews the quota.
+  newRequest();
+  expectCall();
+  EXPECT_EQ(Http::FilterHeadersStatus::Continue, filter_->decodeHeaders(request_headers_, false));
+  std::unique_ptr<Filter> renewing_filter = std::move(filter_);
+  Filters::Common::RateLimit::RequestCallbacks* renewal_callbacks = request_callbacks_;
+
+  // While the renewal is in flight, the last request of the quota is served out of it, and the
+  // next one is over limit.
+  newRequest();
+  EXPECT_CALL(*client_, limit(_, _, _, _, _, _)).Times(0);
+  EXPECT_EQ(Http::FilterHeadersStatus::Continue, filter_->decodeHeaders(request_headers_, false));
+  newRequest();
+  EXPECT_CALL(*client_, limit(_, _, _, _, _, _)).Times(0);
+  EXPECT_CALL(filter_callbacks_, sendLocalReply(Http::Code::TooManyRequests, _, _, _, _));
+  EXPECT_EQ(Http::FilterHeadersStatus::StopIteration,
+            filter_->decodeHeaders(request_headers_, false));
+
+  // The renewal refills the quota, without resuming the request which started it.
+  EXPECT_CALL(filter_callbacks_, continueDecoding()).Times(0);
+  renewal_callbacks->onQuota(quota(5));
+  renewal_callbacks->complete(Filters::Common::RateLimit::LimitStatus::OK, nullptr, nullptr,
+                              nullptr, "", nullptr);
+  newRequest();
+  EXPECT_CALL(*client_, limit(_, _, _, _, _, _)).Times(0);
+  EXPECT_EQ(Http::FilterHeadersStatus::Continue, filter_->decodeHeaders(request_headers_, false));
+
+  EXPECT_EQ(
+      6U, filter_callbacks_.clusterInfo()->statsScope().counterFromStatName(ratelimit_ok_).value());
+  EXPECT_EQ(1U, filter_callbacks_.clusterInfo()
+                    ->statsScope()
+                    .counterFromStatName(ratelimit_over_limit_)
+                    .value());
+}
+
+// Verifies that an expired quota is no longer served, and that a cancelled renewal is retried.
+TEST_F(HttpRateLimitFilterQuotaCacheTest, QuotaExpiryAndCancelledRenewal) {
+  setUpQuotaCache();
+
+  newRequest();
+  expectCall();
+  EXPECT_EQ(Http::FilterHeadersStatus::StopIteration,
+            filter_->decodeHeaders(request_headers_, false));
+  auto granted = quota(2);
+  TimestampUtil::systemClockToTimestamp(time_system_.systemTime() + std::chrono::seconds(10),
+                                        *granted.mutable_valid_until());
+  request_callbacks_->onQuota(granted);
+  request_callbacks_->complete(Filters::Common::RateLimit::LimitStatus::OK, nullptr, nullptr,
+                               nullptr, "", nullptr);
+
+  // The last request of the quota renews it, but the request ends first.
+  newRequest();
+  expectCall();
+  EXPECT_EQ(Http::FilterHeadersStatus::Continue, filter_->decodeHeaders(request_headers_, false));
+  EXPECT_CALL(*client_, cancel());
+  filter_->onDestroy();
+
+  // The exhausted quota is no longer being renewed, so the next request calls the service.
+  newRequest();
+  expectCall();
+  EXPECT_EQ(Http::FilterHeadersStatus::StopIteration,
+            filter_->decodeHeaders(request_headers_, false));
+  request_callbacks_->onQuota(granted);
+  request_callbacks_->complete(Filters::Common::RateLimit::LimitStatus::OK, nullptr, nullptr,
+                               nullptr, "", nullptr);
+
+  // Once expired, the quota is no longer served.
+  time_system_.advanceTimeWait(std::chrono::seconds(10));
+  newRequest();
+  expectCall();
+  EXPECT_EQ(Http::FilterHeadersStatus::StopIteration,
+            filter_->decodeHeaders(request_headers_, false));
+}
+
 } // namespace
 } // namespace RateLimitFilter
 } // namespace HttpFilters
@@ -330,6 +330,7 @@ TEST_F(RoleBasedAccessControlFilterTest, Allowed) {
   setDestinationPort(123);
   setMetadata();
 
+  EXPECT_CALL(callbacks_, disableDataCallbacks());
   EXPECT_EQ(Http::FilterHeadersStatus::Continue, filter_->decodeHeaders(headers_, false));
   Http::MetadataMap metadata_map{{"metadata", "metadata"}};
   EXPECT_EQ(Http::FilterMetadataStatus::Continue, filter_->decodeMetadata(metadata_map));
@@ -78,6 +78,7 @@ public:
   }
   Init::Manager& initManager() override { return *init_manager_; }
   bool ignoreGlobalConnLimit() const override { return false; }
+  bool coalesceWrites() const override { return false; }
   bool shouldBypassOverloadManager() const override { return false; }
 
   // Network::FilterChainManager
@@ -131,6 +131,7 @@ public:
   }
   Init::Manager& initManager() override { return *init_manager_; }
   bool ignoreGlobalConnLimit() const override { return false; }
+  bool coalesceWrites() const override { return false; }
   bool shouldBypassOverloadManager() const override { return false; }
 
   // Network::FilterChainManager
@@ -2713,6 +2714,7 @@ public:
   }
   Init::Manager& initManager() override { return *init_manager_; }
   bool ignoreGlobalConnLimit() const override { return false; }
+  bool coalesceWrites() const override { return false; }
   bool shouldBypassOverloadManager() const override { return false; }
 
   // Network::FilterChainManager
@@ -2825,6 +2827,70 @@ TEST_P(WildcardProxyProtocolTest, BasicV6) {
   EXPECT_EQ(stats_store_.counter("proxy_proto.versions.v1.found").value(), 1);
 }
 
+// A listener filter buffer of data peeked at once.
+class PeekedListenerFilterBuffer : public Network::ListenerFilterBuffer {
+public:
+  explicit PeekedListenerFilterBuffer(std::string data) : data_(std::move(data)) {}
+
+  // Network::ListenerFilterBuffer
+  const Buffer::ConstRawSlice rawSlice() const override {
+    return {data_.data() + drained_, data_.size() - drained_};
+  }
+  bool drain(uint64_t length) override {
+    if (length > data_.size() - drained_) {
+      return false;
+    }
+    drained_ += length;
+    return true;
+  }
+
+private:
+  const std::string data_;
+  uint64_t drained_{};
+};
+
+// Test that a header whose TLVs exceed the initial read size is parsed in a single pass when they
+// were peeked along with it, and that the TLVs which aren't used are skipped.
+TEST(ProxyProtocolFilterTest, V2TlvsParsedFromFirstPeek) {
+  envoy::extensions::filters::listener::proxy_protocol::v3::ProxyProtocol proto_config;
+  proto_config.mutable_pass_through_tlvs()->set_match_type(ProxyProtocolPassThroughTLVs::INCLUDE);
+  proto_config.mutable_pass_through_tlvs()->add_tlv_type(0xea);
+  Stats::TestUtil::TestStore stats_store;
+  Filter filter(std::make_shared<Config>(*stats_store.rootScope(), proto_config));
+
+  const std::string used_value(300, 'a');
+  const std::string skipped_value(20, 'b');
+  std::string tlvs;
+  tlvs.append(std::string("\x02\x00\x14", 3)).append(skipped_value);
+  tlvs.append(std::string("\xea\x01\x2c", 3)).append(used_value);
+  std::string header("\x0d\x0a\x0d\x0a\x00\x0d\x0a\x51\x55\x49\x54\x0a\x21\x11", 14);
+  const size_t length = 12 + tlvs.size();
+  header.push_back(length >> 8);
+  header.push_back(length & 0xff);
+  header.append("\x01\x02\x03\x04\x00\x01\x01\x02\x03\x05\x00\x02", 12);
+  header.append(tlvs);
+  ASSERT_GT(header.size(), filter.maxReadBytes());
+  PeekedListenerFilterBuffer buffer(header + "DATA");
+
+  NiceMock<Network::MockListenerFilterCallbacks> callbacks;
+  EXPECT_EQ(Network::FilterStatus::StopIteration, filter.onAccept(callbacks));
+  EXPECT_EQ(Network::FilterStatus::Continue, filter.onData(buffer));
+  EXPECT_EQ("DATA", absl::string_view(static_cast<const char*>(buffer.rawSlice().mem_),
+                                      buffer.rawSlice().len_));
+  EXPECT_EQ("1.2.3.4:773",
+            callbacks.socket_.connectionInfoProvider().remoteAddress()->asStringView());
+
+  const auto& tlvs_state = callbacks.filter_state_
+                               .getDataReadOnly<Network::ProxyProtocolFilterState>(
+                                   Network::ProxyProtocolFilterState::key())
+                               ->value()
+                               .tlv_vector_;
+  ASSERT_EQ(1U, tlvs_state.size());
+  EXPECT_EQ(0xea, tlvs_state[0].type);
+  EXPECT_EQ(used_value, std::string(tlvs_state[0].value.begin(), tlvs_state[0].value.end()));
+  EXPECT_EQ(1, stats_store.counter("proxy_proto.versions.v2.found").value());
+}
+
 TEST(ProxyProtocolConfigFactoryTest, TestCreateFactory) {
   Server::Configuration::NamedListenerFilterConfigFactory* factory = Registry::FactoryRegistry<
       Server::Configuration::NamedListenerFilterConfigFactory>::getFactory(ProxyProtocol);
@@ -0,0 +1,212 @@
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "source/extensions/filters/listener/tls_inspector/client_hello_parser.h"
+#include "source/extensions/filters/listener/tls_inspector/tls_inspector.h"
+
+#include "test/extensions/filters/listener/tls_inspector/tls_utility.h"
+
+#include "gtest/gtest.h"
+#include "openssl/ssl.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace ListenerFilters {
+namespace TlsInspector {
+namespace {
+
+void appendU16(std::vector<uint8_t>& out, size_t value) {
+  out.push_back(value >> 8);
+  out.push_back(value & 0xff);
+}
+
+// Returns an extension in its wire format.
+std::vector<uint8_t> extension(uint16_t type, const std::vector<uint8_t>& data) {
+  std::vector<uint8_t> out;
+  appendU16(out, type);
+  appendU16(out, data.size());
+  out.insert(out.end(), data.begin(), data.end());
+  return out;
+}
+
+std::vector<uint8_t> serverNameExtension(uint8_t name_type, const std::string& name) {
+  std::vector<uint8_t> names;
+  appendU16(names, name.size() + 3);
+  names.push_back(name_type);
+  appendU16(names, name.size());
+  names.insert(names.end(), name.begin(), name.end());
+  return extension(TLSEXT_TYPE_server_name, names);
+}
+
+// Returns a minimal ClientHello record of the version, with the extensions given in their wire
+// format, or without any extensions block if none are given.
+std::vector<uint8_t> makeClientHello(uint16_t version,
+                                     const std::vector<std::vector<uint8_t>>& extensions) {
+  std::vector<uint8_t> body;
+  appendU16(body, version);
+  body.insert(body.end(), SSL3_RANDOM_SIZE, 0);
+  // An empty session id, one cipher suite and the null compression.
+  body.insert(body.end(), {0x00, 0x00, 0x02, 0xc0, 0x2f, 0x01, 0x00});
+  if (!extensions.empty()) {
+    std::vector<uint8_t> all;
+    for (const auto& e : extensions) {
+      all.insert(all.end(), e.begin(), e.end());
+    }
+    appendU16(body, all.size());
+    body.insert(body.end(), all.begin(), all.end());
+  }
+
+  std::vector<uint8_t> out = {SSL3_RT_HANDSHAKE, 0x03, 0x01};
+  appendU16(out, body.size() + 4);
+  out.insert(out.end(), {SSL3_MT_CLIENT_HELLO, 0x00});
+  appendU16(out, body.size());
+  out.insert(out.end(), body.begin(), body.end());
+  return out;
+}
+
+ClientHelloParseResult parse(const std::vector<uint8_t>& data, ParsedClientHello& parsed) {
+  return parseClientHello(data, Config::TLS_MIN_SUPPORTED_VERSION,
+                          Config::TLS_MAX_SUPPORTED_VERSION, parsed);
+}
+
+class ClientHelloParserVersionTest
+    : public testing::TestWithParam<std::tuple<uint16_t, uint16_t>> {};
+
+INSTANTIATE_TEST_SUITE_P(TlsProtocolVersions, ClientHelloParserVersionTest,
+                         testing::Values(std::make_tuple(Config::TLS_MIN_SUPPORTED_VERSION,
+                                                         Config::TLS_MAX_SUPPORTED_VERSION),
+                                         std::make_tuple(TLS1_VERSION, TLS1_VERSION),
+                                         std::make_tuple(TLS1_1_VERSION, TLS1_1_VERSION),
+                                         std::make_tuple(TLS1_2_VERSION, TLS1_2_VERSION),
+                                         std::make_tuple(TLS1_3_VERSION, TLS1_3_VERSION)));
+
+// Test that the ClientHellos of BoringSSL are parsed with their server name and ALPN.
+TEST_P(ClientHelloParserVersionTest, ParsesBoringSslClientHello) {
+  const auto [min_version, max_version] = GetParam();
+  const std::vector<uint8_t> client_hello =
+      Tls::Test::generateClientHello(min_version, max_version, "example.com", "\x02h2");
+
+  ParsedClientHello parsed;
+  ASSERT_EQ(ClientHelloParseResult::Parsed,
+            parseClientHello(client_hello, min_version, max_version, parsed));
+  EXPECT_EQ("example.com", parsed.server_name);
+  EXPECT_EQ(client_hello.size(), parsed.size);
+  const uint8_t* alpn;
+  size_t alpn_len;
+  ASSERT_TRUE(SSL_early_callback_ctx_extension_get(
+      &parsed.client_hello, TLSEXT_TYPE_application_layer_protocol_negotiation, &alpn, &alpn_len));
+  EXPECT_EQ(std::string("\x00\x03\x02h2", 5),
+            std::string(reinterpret_cast<const char*>(alpn), alpn_len));
+}
+
+// Test that every truncation of a ClientHello needs more data.
+TEST_P(ClientHelloParserVersionTest, NeedsMoreDataForTruncatedClientHello) {
+  const auto [min_version, max_version] = GetParam();
+  const std::vector<uint8_t> client_hello =
+      Tls::Test::generateClientHello(min_version, max_version, "example.com", "");
+
+  for (size_t len = 0; len < client_hello.size(); ++len) {
+    ParsedClientHello parsed;
+    EXPECT_EQ(ClientHelloParseResult::NeedMoreData,
+              parseClientHello(absl::MakeConstSpan(client_hello.data(), len), min_version,
+                               max_version, parsed))
+        << len;
+  }
+}
+
+// Test that the data following the ClientHello record isn't looked at.
+TEST(ClientHelloParserTest, IgnoresDataAfterRecord) {
+  std::vector<uint8_t> client_hello =
+      makeClientHello(TLS1_2_VERSION, {serverNameExtension(TLSEXT_NAMETYPE_host_name, "a.b")});
+  const size_t size = client_hello.size();
+  client_hello.insert(client_hello.end(), 10, 0xff);
+
+  ParsedClientHello parsed;
+  ASSERT_EQ(ClientHelloParseResult::Parsed, parse(client_hello, parsed));
+  EXPECT_EQ("a.b", parsed.server_name);
+  EXPECT_EQ(size, parsed.size);
+}
+
+// Test that a ClientHello without extensions has no server name.
+TEST(ClientHelloParserTest, NoExtensions) {
+  ParsedClientHello parsed;
+  ASSERT_EQ(ClientHelloParseResult::Parsed, parse(makeClientHello(TLS1_2_VERSION, {}), parsed));
+  EXPECT_TRUE(parsed.server_name.empty());
+  EXPECT_EQ(0U, parsed.client_hello.extensions_len);
+}
+
+// Test that the data which isn't a TLS handshake record is left to BoringSSL, from its first byte.
+TEST(ClientHelloParserTest, NotTls) {
+  ParsedClientHello parsed;
+  EXPECT_EQ(ClientHelloParseResult::Unsupported, parse({'G'}, parsed));
+  EXPECT_EQ(ClientHelloParseResult::Unsupported, parse(std::vector<uint8_t>(100, 0), parsed));
+  // A record of an unknown version.
+  std::vector<uint8_t> client_hello = makeClientHello(TLS1_2_VERSION, {});
+  client_hello[1] = 0x04;
+  EXPECT_EQ(ClientHelloParseResult::Unsupported, parse(client_hello, parsed));
+}
+
+// Test that a ClientHello split across records is left to BoringSSL.
+TEST(ClientHelloParserTest, SplitAcrossRecords) {
+  const std::vector<uint8_t> client_hello =
+      makeClientHello(TLS1_2_VERSION, {serverNameExtension(TLSEXT_NAMETYPE_host_name, "a.b")});
+  constexpr uint8_t first_len = 20;
+  const size_t second_len = client_hello.size() - 5 - first_len;
+  std::vector<uint8_t> records = {SSL3_RT_HANDSHAKE, 0x03, 0x01, 0x00, first_len};
+  records.insert(records.end(), client_hello.begin() + 5, client_hello.begin() + 5 + first_len);
+  records.insert(records.end(), {SSL3_RT_HANDSHAKE, 0x03, 0x01, 0x00,
+                                 static_cast<uint8_t>(second_len)});
+  records.insert(records.end(), client_hello.begin() + 5 + first_len, client_hello.end());
+
+  ParsedClientHello parsed;
+  EXPECT_EQ(ClientHelloParseResult::Unsupported, parse(records, parsed));
+}
+
+// Test that the ClientHellos which BoringSSL rejects before their server name is known are left
+// to it.
+TEST(ClientHelloParserTest, InvalidClientHello) {
+  ParsedClientHello parsed;
+  // A repeated extension.
+  EXPECT_EQ(ClientHelloParseResult::Unsupported,
+            parse(makeClientHello(TLS1_2_VERSION, {extension(0x1234, {}), extension(0x1234, {})}),
+                  parsed));
+  // An empty, invalid or unknown type of server name.
+  EXPECT_EQ(ClientHelloParseResult::Unsupported,
+            parse(makeClientHello(TLS1_2_VERSION,
+                                  {serverNameExtension(TLSEXT_NAMETYPE_host_name, "")}),
+                  parsed));
+  EXPECT_EQ(ClientHelloParseResult::Unsupported,
+            parse(makeClientHello(TLS1_2_VERSION, {serverNameExtension(TLSEXT_NAMETYPE_host_name,
+                                                                       std::string("a\0b", 3))}),
+                  parsed));
+  EXPECT_EQ(ClientHelloParseResult::Unsupported,
+            parse(makeClientHello(TLS1_2_VERSION, {serverNameExtension(1, "a.b")}), parsed));
+  // An extension running past the end of the extensions.
+  std::vector<uint8_t> truncated_extension = extension(0x1234, {0x00});
+  truncated_extension[3] = 2;
+  EXPECT_EQ(ClientHelloParseResult::Unsupported,
+            parse(makeClientHello(TLS1_2_VERSION, {truncated_extension}), parsed));
+}
+
+// Test that the ClientHellos of versions out of the configured range are left to BoringSSL.
+TEST(ClientHelloParserTest, UnsupportedVersion) {
+  ParsedClientHello parsed;
+  EXPECT_EQ(ClientHelloParseResult::Unsupported, parse(makeClientHello(SSL3_VERSION, {}), parsed));
+  EXPECT_EQ(ClientHelloParseResult::Unsupported,
+            parseClientHello(makeClientHello(TLS1_VERSION, {}), TLS1_2_VERSION, TLS1_3_VERSION,
+                             parsed));
+  // TLS 1.3 only offered with supported_versions, to a TLS 1.2 server.
+  const std::vector<uint8_t> tls13 = makeClientHello(
+      TLS1_2_VERSION, {extension(TLSEXT_TYPE_supported_versions, {0x02, 0x03, 0x04})});
+  EXPECT_EQ(ClientHelloParseResult::Unsupported,
+            parseClientHello(tls13, TLS1_VERSION, TLS1_2_VERSION, parsed));
+  EXPECT_EQ(ClientHelloParseResult::Parsed,
+            parseClientHello(tls13, TLS1_VERSION, TLS1_3_VERSION, parsed));
+}
+
+} // namespace
+} // namespace TlsInspector
+} // namespace ListenerFilters
+} // namespace Extensions
+} // namespace Envoy
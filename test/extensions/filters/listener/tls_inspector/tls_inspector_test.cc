@@ -9,6 +9,7 @@
 #include "test/mocks/api/mocks.h"
 #include "test/mocks/network/mocks.h"
 #include "test/mocks/stats/mocks.h"
+#include "test/test_common/test_runtime.h"
 #include "test/test_common/threadsafe_singleton_injector.h"
 
 #include "absl/strings/str_format.h"
@@ -419,6 +420,61 @@ TEST_P(TlsInspectorTest, NotSsl) {
   EXPECT_EQ(5, bytes_processed[0]);
 }
 
+// Test that a ClientHello which can't be parsed in place, split across two records, is still
+// inspected by BoringSSL.
+TEST_P(TlsInspectorTest, ClientHelloSplitAcrossRecords) {
+  init();
+  const std::string servername("example.com");
+  const std::vector<uint8_t> client_hello = Tls::Test::generateClientHello(
+      std::get<0>(GetParam()), std::get<1>(GetParam()), servername, "");
+  const size_t first_len = 20;
+  const size_t second_len = client_hello.size() - SSL3_RT_HEADER_LENGTH - first_len;
+  std::vector<uint8_t> records(client_hello.begin(), client_hello.begin() + SSL3_RT_HEADER_LENGTH);
+  records[3] = 0;
+  records[4] = first_len;
+  records.insert(records.end(), client_hello.begin() + SSL3_RT_HEADER_LENGTH,
+                 client_hello.begin() + SSL3_RT_HEADER_LENGTH + first_len);
+  records.insert(records.end(), {SSL3_RT_HANDSHAKE, records[1], records[2],
+                                 static_cast<uint8_t>(second_len >> 8),
+                                 static_cast<uint8_t>(second_len & 0xff)});
+  records.insert(records.end(), client_hello.begin() + SSL3_RT_HEADER_LENGTH + first_len,
+                 client_hello.end());
+  mockSysCallForPeek(records);
+  EXPECT_CALL(socket_, setRequestedServerName(Eq(servername)));
+  EXPECT_CALL(socket_, setDetectedTransportProtocol(absl::string_view("tls")));
+  EXPECT_CALL(socket_, detectedTransportProtocol()).Times(::testing::AnyNumber());
+  EXPECT_TRUE(file_event_callback_(Event::FileReadyType::Read).ok());
+  auto state = filter_->onData(*buffer_);
+  EXPECT_EQ(Network::FilterStatus::Continue, state);
+  EXPECT_EQ(1, cfg_->stats().tls_found_.value());
+  EXPECT_EQ(1, cfg_->stats().sni_found_.value());
+}
+
+// Test that the ClientHello is inspected by BoringSSL alone with the in place parsing disabled.
+TEST_P(TlsInspectorTest, InPlaceParsingDisabled) {
+  TestScopedRuntime scoped_runtime;
+  scoped_runtime.mergeValues(
+      {{"envoy.reloadable_features.tls_inspector_parse_client_hello_in_place", "false"}});
+  init();
+  const std::string servername("example.com");
+  std::vector<uint8_t> client_hello = Tls::Test::generateClientHello(
+      std::get<0>(GetParam()), std::get<1>(GetParam()), servername, "\x02h2");
+  mockSysCallForPeek(client_hello);
+  EXPECT_CALL(socket_, setRequestedServerName(Eq(servername)));
+  EXPECT_CALL(socket_, setRequestedApplicationProtocols(_));
+  EXPECT_CALL(socket_, setDetectedTransportProtocol(absl::string_view("tls")));
+  EXPECT_CALL(socket_, detectedTransportProtocol()).Times(::testing::AnyNumber());
+  EXPECT_TRUE(file_event_callback_(Event::FileReadyType::Read).ok());
+  auto state = filter_->onData(*buffer_);
+  EXPECT_EQ(Network::FilterStatus::Continue, state);
+  EXPECT_EQ(1, cfg_->stats().sni_found_.value());
+  EXPECT_EQ(1, cfg_->stats().alpn_found_.value());
+  const std::vector<uint64_t> bytes_processed =
+      store_.histogramValues("tls_inspector.bytes_processed", false);
+  ASSERT_EQ(1, bytes_processed.size());
+  EXPECT_EQ(client_hello.size(), bytes_processed[0]);
+}
+
 TEST_P(TlsInspectorTest, EarlyTerminationShouldNotRecordBytesProcessed) {
   envoy::extensions::filters::listener::tls_inspector::v3::TlsInspector proto_config;
   cfg_ = std::make_shared<Config>(*store_.rootScope(), proto_config);
@@ -275,6 +275,34 @@ TEST_F(RedisEncoderDecoderImplTest, BulkString) {
   EXPECT_EQ(0UL, buffer_.length());
 }
 
+TEST_F(RedisEncoderDecoderImplTest, OwnedLargeBulkStringsAreMoved) {
+  std::vector<RespValue> values(2);
+  values[0].type(RespType::BulkString);
+  values[0].asString() = "small";
+  values[1].type(RespType::BulkString);
+  values[1].asString() = std::string(32 * 1024, 'a');
+  auto value = std::make_unique<RespValue>();
+  value->type(RespType::Array);
+  value->asArray().swap(values);
+  const RespValue copy = *value;
+  const void* large_data = value->asArray()[1].asString().data();
+
+  encoder_.encodeOwned(std::move(value), buffer_);
+  Buffer::OwnedImpl expected;
+  encoder_.encode(copy, expected);
+  EXPECT_EQ(expected.toString(), buffer_.toString());
+
+  // The large bulk string is referenced by the buffer rather than copied into it.
+  bool moved = false;
+  for (const Buffer::RawSlice& slice : buffer_.getRawSlices()) {
+    moved |= slice.mem_ == large_data;
+  }
+  EXPECT_TRUE(moved);
+  decoder_.decode(buffer_);
+  EXPECT_EQ(copy, *decoded_values_[0]);
+  EXPECT_EQ(0UL, buffer_.length());
+}
+
 TEST_F(RedisEncoderDecoderImplTest, Integer) {
   RespValue value;
   value.type(RespType::Integer);
@@ -26,6 +26,10 @@ MockEncoder::MockEncoder() {
           Invoke([this](const Common::Redis::RespValue& value, Buffer::Instance& out) -> void {
             real_encoder_.encode(value, out);
           }));
+  // The owned values are encoded through encode(), so that expectations on it cover both.
+  ON_CALL(*this, encodeOwned(_, _))
+      .WillByDefault(Invoke([this](Common::Redis::RespValuePtr&& value,
+                                   Buffer::Instance& out) -> void { encode(*value, out); }));
 }
 
 MockEncoder::~MockEncoder() = default;
@@ -30,6 +30,7 @@ public:
   ~MockEncoder() override;
 
   MOCK_METHOD(void, encode, (const Common::Redis::RespValue& value, Buffer::Instance& out));
+  MOCK_METHOD(void, encodeOwned, (Common::Redis::RespValuePtr && value, Buffer::Instance& out));
 
 private:
   Common::Redis::EncoderImpl real_encoder_;
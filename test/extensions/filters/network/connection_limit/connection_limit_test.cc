@@ -106,6 +106,45 @@ delay: 0s
                    ->value());
 }
 
+// Connection limit case with connections reserved ahead by the workers.
+TEST_F(ConnectionLimitFilterTest, ConnectionLimitWithSlack) {
+  initialize(R"EOF(
+stat_prefix: connection_limit_stats
+max_connections: 2
+delay: 0s
+per_worker_slack: 5
+)EOF");
+
+  Buffer::OwnedImpl buffer("test");
+  ActiveFilter active_filter1(config_);
+  EXPECT_EQ(Network::FilterStatus::Continue, active_filter1.filter_.onNewConnection());
+  ActiveFilter active_filter2(config_);
+  EXPECT_EQ(Network::FilterStatus::Continue, active_filter2.filter_.onNewConnection());
+
+  // The slack doesn't allow exceeding the limit.
+  ActiveFilter active_filter3(config_);
+  EXPECT_CALL(active_filter3.read_filter_callbacks_.connection_,
+              close(Network::ConnectionCloseType::NoFlush, "over_connection_limit"));
+  EXPECT_EQ(Network::FilterStatus::StopIteration, active_filter3.filter_.onNewConnection());
+  active_filter3.filter_.onEvent(Network::ConnectionEvent::LocalClose);
+  EXPECT_EQ(1, TestUtility::findCounter(
+                   stats_store_, "connection_limit.connection_limit_stats.limited_connections")
+                   ->value());
+
+  // Closing an accepted connection makes room for a new one, but closing a rejected one doesn't.
+  ActiveFilter active_filter4(config_);
+  EXPECT_CALL(active_filter4.read_filter_callbacks_.connection_,
+              close(Network::ConnectionCloseType::NoFlush, "over_connection_limit"));
+  EXPECT_EQ(Network::FilterStatus::StopIteration, active_filter4.filter_.onNewConnection());
+  active_filter1.filter_.onEvent(Network::ConnectionEvent::RemoteClose);
+  ActiveFilter active_filter5(config_);
+  EXPECT_EQ(Network::FilterStatus::Continue, active_filter5.filter_.onNewConnection());
+  EXPECT_EQ(Network::FilterStatus::Continue, active_filter5.filter_.onData(buffer, false));
+  EXPECT_EQ(2, TestUtility::findCounter(
+                   stats_store_, "connection_limit.connection_limit_stats.limited_connections")
+                   ->value());
+}
+
 // Connection limit with delay case.
 TEST_F(ConnectionLimitFilterTest, ConnectionLimitWithDelay) {
   initialize(R"EOF(
@@ -10,6 +10,7 @@
 #include "gtest/gtest.h"
 
 using testing::_;
+using testing::Invoke;
 using testing::Return;
 
 namespace Envoy {
@@ -56,6 +57,42 @@ TEST_F(FilterChainTest, CreateFilterChain) {
   config.createFilterChain(manager);
 }
 
+TEST_F(FilterChainTest, CreateFilterChainWithLatencySampling) {
+  auto proto_config = parseHttpConnectionManagerFromYaml(basic_config_);
+  proto_config.set_filter_latency_sample_interval(2);
+  HttpConnectionManagerConfig config(proto_config, context_, date_provider_,
+                                     route_config_provider_manager_,
+                                     &scoped_routes_config_provider_manager_, tracer_manager_,
+                                     filter_config_provider_manager_, creation_status_);
+  ASSERT_TRUE(creation_status_.ok());
+
+  std::vector<const Http::FilterLatencyStats*> latency_stats;
+  NiceMock<Http::MockFilterChainManager> manager;
+  ON_CALL(manager, applyFilterFactoryCb(_, _))
+      .WillByDefault(Invoke([&](Http::FilterContext context, Http::FilterFactoryCb&) {
+        latency_stats.push_back(context.latency_stats);
+      }));
+
+  // The stream isn't sampled.
+  EXPECT_CALL(context_.server_factory_context_.api_.random_, random()).WillOnce(Return(1));
+  config.createFilterChain(manager);
+  ASSERT_EQ(2, latency_stats.size());
+  EXPECT_EQ(nullptr, latency_stats[0]);
+  EXPECT_EQ(nullptr, latency_stats[1]);
+
+  // The stream is sampled.
+  latency_stats.clear();
+  EXPECT_CALL(context_.server_factory_context_.api_.random_, random()).WillOnce(Return(4));
+  config.createFilterChain(manager);
+  ASSERT_EQ(2, latency_stats.size());
+  ASSERT_NE(nullptr, latency_stats[0]);
+  EXPECT_EQ("http.router.filter.encoder-decoder-buffer-filter.decode_headers_us",
+            latency_stats[0]->decode_headers_us_.name());
+  ASSERT_NE(nullptr, latency_stats[1]);
+  EXPECT_EQ("http.router.filter.envoy.filters.http.router.encode_data_us",
+            latency_stats[1]->encode_data_us_.name());
+}
+
 TEST_F(FilterChainTest, CreateFilterChainWithDisabledFilter) {
   const std::string config_yaml = R"EOF(
 codec_type: http1
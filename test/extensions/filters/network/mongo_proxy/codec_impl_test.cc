@@ -40,6 +40,11 @@ public:
   MOCK_METHOD(void, decodeCommandReply_, (CommandReplyMessagePtr & message));
 };
 
+class TestHeaderDecoderCallbacks : public HeaderDecoderCallbacks {
+public:
+  MOCK_METHOD(void, decodeMessageHeader, (Message::OpCode op_code));
+};
+
 class MongoCodecImplTest : public testing::Test {
 public:
   Buffer::OwnedImpl output_;
@@ -323,6 +328,55 @@ TEST_F(MongoCodecImplTest, InvalidMessage) {
   EXPECT_THROW(decoder_.onData(output_), EnvoyException);
 }
 
+// Test that only the headers of the messages are decoded, whatever their split across the data.
+TEST_F(MongoCodecImplTest, HeaderDecoder) {
+  QueryMessageImpl query(1, 1);
+  query.fullCollectionName("test");
+  query.query(Bson::DocumentImpl::create()->addString("string", "string"));
+  InsertMessageImpl insert(2, 2);
+  insert.fullCollectionName("test");
+  insert.documents().push_back(Bson::DocumentImpl::create()->addString("world", "hello"));
+  ReplyMessageImpl reply(3, 1);
+  encoder_.encodeQuery(query);
+  encoder_.encodeInsert(insert);
+  encoder_.encodeReply(reply);
+  const std::string data = output_.toString();
+
+  for (size_t split = 1; split < data.size(); ++split) {
+    NiceMock<TestHeaderDecoderCallbacks> header_callbacks;
+    HeaderDecoderImpl header_decoder{header_callbacks};
+    testing::InSequence s;
+    EXPECT_CALL(header_callbacks, decodeMessageHeader(Message::OpCode::Query));
+    EXPECT_CALL(header_callbacks, decodeMessageHeader(Message::OpCode::Insert));
+    EXPECT_CALL(header_callbacks, decodeMessageHeader(Message::OpCode::Reply));
+
+    Buffer::OwnedImpl first(data.substr(0, split));
+    Buffer::OwnedImpl second(data.substr(split));
+    header_decoder.onData(first);
+    header_decoder.onData(second);
+    // The data is left to the connection.
+    EXPECT_EQ(split, first.length());
+  }
+}
+
+TEST_F(MongoCodecImplTest, HeaderDecoderInvalidMessage) {
+  NiceMock<TestHeaderDecoderCallbacks> header_callbacks;
+  HeaderDecoderImpl header_decoder{header_callbacks};
+  Bson::BufferHelper::writeInt32(output_, 16); // Size
+  Bson::BufferHelper::writeInt32(output_, 0);  // Request ID
+  Bson::BufferHelper::writeInt32(output_, 1);  // Response to
+  Bson::BufferHelper::writeInt32(output_, 2);  // Invalid op
+  EXPECT_THROW(header_decoder.onData(output_), EnvoyException);
+
+  HeaderDecoderImpl other_header_decoder{header_callbacks};
+  output_.drain(output_.length());
+  Bson::BufferHelper::writeInt32(output_, 15); // Invalid size
+  Bson::BufferHelper::writeInt32(output_, 0);
+  Bson::BufferHelper::writeInt32(output_, 1);
+  Bson::BufferHelper::writeInt32(output_, 1);
+  EXPECT_THROW(other_header_decoder.onData(output_), EnvoyException);
+}
+
 TEST_F(MongoCodecImplTest, QueryToStringWithEscape) {
   QueryMessageImpl query(1, 1);
   query.flags(0x4);
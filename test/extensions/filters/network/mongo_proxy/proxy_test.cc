@@ -522,6 +522,50 @@ TEST_F(MongoProxyFilterTest, MaxTimeCursor) {
   EXPECT_EQ(0U, store_.counter("test.op_query_no_max_time").value());
 }
 
+TEST_F(MongoProxyFilterTest, HeaderOnlyDecoding) {
+  ON_CALL(runtime_.snapshot_, featureEnabled("mongo.full_decoding_enabled", 100))
+      .WillByDefault(Return(false));
+  initializeFilter();
+  // The full decoder is never created for the connection.
+  DecoderPtr unused_decoder{filter_->decoder_};
+  EXPECT_CALL(*filter_->decoder_, onData(_)).Times(0);
+  EXPECT_CALL(*file_, write(_)).Times(0);
+
+  Buffer::OwnedImpl data;
+  EncoderImpl encoder(data);
+  QueryMessageImpl query(1, 0);
+  query.fullCollectionName("db.test");
+  query.query(Bson::DocumentImpl::create());
+  encoder.encodeQuery(query);
+  const uint64_t length = data.length();
+  filter_->onData(data, false);
+  // The data is passed through without being buffered by the filter.
+  EXPECT_EQ(length, data.length());
+
+  Buffer::OwnedImpl reply_data;
+  EncoderImpl reply_encoder(reply_data);
+  ReplyMessageImpl reply(2, 1);
+  reply.documents().push_back(Bson::DocumentImpl::create()->addString("hello", "world"));
+  reply_encoder.encodeReply(reply);
+  filter_->onWrite(reply_data, false);
+
+  EXPECT_EQ(1U, store_.counter("test.op_query").value());
+  EXPECT_EQ(1U, store_.counter("test.op_reply").value());
+  EXPECT_EQ(0U, store_.counter("test.op_query_no_max_time").value());
+  EXPECT_EQ(0U, store_.counter("test.collection.test.query.total").value());
+
+  // A message which can't be decoded stops the decoding of the connection.
+  Buffer::OwnedImpl invalid_data;
+  Bson::BufferHelper::writeInt32(invalid_data, 1);
+  Bson::BufferHelper::writeInt32(invalid_data, 0);
+  Bson::BufferHelper::writeInt32(invalid_data, 0);
+  Bson::BufferHelper::writeInt32(invalid_data, 0);
+  filter_->onData(invalid_data, false);
+  filter_->onData(data, false);
+  EXPECT_EQ(1U, store_.counter("test.decoding_error").value());
+  EXPECT_EQ(1U, store_.counter("test.op_query").value());
+}
+
 TEST_F(MongoProxyFilterTest, DecodeError) {
   initializeFilter();
 
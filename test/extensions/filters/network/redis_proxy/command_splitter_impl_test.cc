@@ -1215,6 +1215,103 @@ INSTANTIATE_TEST_SUITE_P(RedisSingleServerRequestWithDelayFaultTest,
                          RedisSingleServerRequestWithDelayFaultTest,
                          testing::ValuesIn(Common::Redis::SupportedCommands::simpleCommands()));
 
+class RedisNearCacheTest : public RedisCommandSplitterImplTest {
+public:
+  static envoy::extensions::filters::network::redis_proxy::v3::RedisProxy::NearCache
+  nearCacheConfig() {
+    envoy::extensions::filters::network::redis_proxy::v3::RedisProxy::NearCache config;
+    config.add_key_prefixes("hot:");
+    config.mutable_ttl()->set_seconds(1);
+    return config;
+  }
+
+  // Makes a request expected to be sent upstream.
+  void makeUpstreamRequest(const std::vector<std::string>& args) {
+    Common::Redis::RespValuePtr request{new Common::Redis::RespValue()};
+    makeBulkStringArray(*request, args);
+    EXPECT_CALL(callbacks_, connectionAllowed()).WillOnce(Return(true));
+    EXPECT_CALL(*conn_pool_, makeRequest_(args[1], RespVariantEq(*request), _))
+        .WillOnce(DoAll(WithArg<2>(SaveArgAddress(&pool_callbacks_)), Return(&pool_request_)));
+    handle_ = cached_splitter_.makeRequest(std::move(request), callbacks_, dispatcher_,
+                                           stream_info_);
+    EXPECT_NE(nullptr, handle_);
+  }
+
+  // Responds to the last upstream request with a bulk string.
+  void respond(const std::string& value) {
+    Common::Redis::RespValuePtr response{new Common::Redis::RespValue()};
+    response->type(Common::Redis::RespType::BulkString);
+    response->asString() = value;
+    Common::Redis::RespValue* response_ptr = response.get();
+    EXPECT_CALL(callbacks_, onResponse_(PointeesEq(response_ptr)));
+    pool_callbacks_->onResponse(std::move(response));
+  }
+
+  // Makes a GET expected to be served from the near cache.
+  void expectCachedGet(const std::string& key, const std::string& value) {
+    Common::Redis::RespValue response;
+    response.type(Common::Redis::RespType::BulkString);
+    response.asString() = value;
+    Common::Redis::RespValuePtr request{new Common::Redis::RespValue()};
+    makeBulkStringArray(*request, {"get", key});
+    EXPECT_CALL(callbacks_, connectionAllowed()).WillOnce(Return(true));
+    EXPECT_CALL(callbacks_, onResponse_(PointeesEq(&response)));
+    EXPECT_EQ(nullptr, cached_splitter_.makeRequest(std::move(request), callbacks_, dispatcher_,
+                                                    stream_info_));
+  }
+
+  ConnPool::PoolCallbacks* pool_callbacks_{};
+  Common::Redis::Client::MockPoolRequest pool_request_;
+  InstanceImpl cached_splitter_{
+      std::make_unique<NiceMock<MockRouter>>(route_),
+      *store_.rootScope(),
+      "redis.foo.",
+      time_system_,
+      false,
+      std::make_unique<NiceMock<MockFaultManager>>(fault_manager_),
+      std::make_shared<NearCache>(nearCacheConfig(), *store_.rootScope(), "redis.foo.",
+                                  time_system_)};
+};
+
+TEST_F(RedisNearCacheTest, GetIsServedFromTheCache) {
+  makeUpstreamRequest({"get", "hot:a"});
+  respond("value");
+  expectCachedGet("hot:a", "value");
+  EXPECT_EQ(1UL, store_.counter("redis.foo.near_cache.miss").value());
+  EXPECT_EQ(1UL, store_.counter("redis.foo.near_cache.hit").value());
+  EXPECT_EQ(2UL, store_.counter("redis.foo.command.get.total").value());
+  EXPECT_EQ(2UL, store_.counter("redis.foo.command.get.success").value());
+
+  // The keys without a cached prefix, and the expired values, are read upstream.
+  makeUpstreamRequest({"get", "cold:a"});
+  respond("value");
+  time_system_.advanceTimeWait(std::chrono::seconds(1));
+  makeUpstreamRequest({"get", "hot:a"});
+  respond("new value");
+  expectCachedGet("hot:a", "new value");
+}
+
+TEST_F(RedisNearCacheTest, WritesInvalidateTheCache) {
+  makeUpstreamRequest({"get", "hot:a"});
+  respond("value");
+
+  makeUpstreamRequest({"set", "hot:a", "new value"});
+  EXPECT_EQ(1UL, store_.counter("redis.foo.near_cache.invalidation").value());
+  respond("OK");
+
+  // A read started before a write may have been served before it, so it isn't cached.
+  makeUpstreamRequest({"get", "hot:a"});
+  ConnPool::PoolCallbacks* get_callbacks = pool_callbacks_;
+  SplitRequestPtr get_handle = std::move(handle_);
+  makeUpstreamRequest({"set", "hot:b", "value"});
+  respond("OK");
+  pool_callbacks_ = get_callbacks;
+  respond("value");
+  makeUpstreamRequest({"get", "hot:a"});
+  respond("newer value");
+  expectCachedGet("hot:a", "newer value");
+}
+
 } // namespace CommandSplitter
 } // namespace RedisProxy
 } // namespace NetworkFilters
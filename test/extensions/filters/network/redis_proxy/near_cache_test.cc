@@ -0,0 +1,113 @@
+#include "source/common/stats/isolated_store_impl.h"
+#include "source/extensions/filters/network/redis_proxy/near_cache.h"
+
+#include "test/test_common/simulated_time_system.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace NetworkFilters {
+namespace RedisProxy {
+namespace {
+
+class NearCacheTest : public testing::Test {
+protected:
+  NearCache& create(uint64_t max_bytes) {
+    envoy::extensions::filters::network::redis_proxy::v3::RedisProxy::NearCache config;
+    config.add_key_prefixes("hot:");
+    config.mutable_ttl()->set_seconds(1);
+    config.mutable_max_bytes()->set_value(max_bytes);
+    near_cache_ =
+        std::make_unique<NearCache>(config, *store_.rootScope(), "redis.foo.", time_system_);
+    return *near_cache_;
+  }
+
+  static Common::Redis::RespValue bulkString(const std::string& string) {
+    Common::Redis::RespValue value;
+    value.type(Common::Redis::RespType::BulkString);
+    value.asString() = string;
+    return value;
+  }
+
+  uint64_t gauge(const std::string& name) {
+    return store_
+        .gaugeFromString("redis.foo.near_cache." + name, Stats::Gauge::ImportMode::NeverImport)
+        .value();
+  }
+
+  Stats::IsolatedStoreImpl store_;
+  Event::SimulatedTimeSystem time_system_;
+  std::unique_ptr<NearCache> near_cache_;
+};
+
+TEST_F(NearCacheTest, CachesBulkStringsAndNulls) {
+  NearCache& near_cache = create(1024);
+  EXPECT_TRUE(near_cache.cacheable("hot:a"));
+  EXPECT_FALSE(near_cache.cacheable("cold:a"));
+  EXPECT_EQ(nullptr, near_cache.lookup("hot:a"));
+
+  near_cache.insert("hot:a", bulkString("value"), near_cache.generation());
+  near_cache.insert("hot:b", Common::Redis::RespValue(), near_cache.generation());
+  Common::Redis::RespValue error;
+  error.type(Common::Redis::RespType::Error);
+  error.asString() = "ERR";
+  near_cache.insert("hot:c", error, near_cache.generation());
+
+  Common::Redis::RespValuePtr value = near_cache.lookup("hot:a");
+  ASSERT_NE(nullptr, value);
+  EXPECT_EQ(bulkString("value"), *value);
+  value = near_cache.lookup("hot:b");
+  ASSERT_NE(nullptr, value);
+  EXPECT_EQ(Common::Redis::RespType::Null, value->type());
+  EXPECT_EQ(nullptr, near_cache.lookup("hot:c"));
+  EXPECT_EQ(2UL, gauge("entries"));
+  EXPECT_EQ(15UL, gauge("bytes"));
+
+  time_system_.advanceTimeWait(std::chrono::seconds(1));
+  EXPECT_EQ(nullptr, near_cache.lookup("hot:a"));
+  EXPECT_EQ(2UL, store_.counterFromString("redis.foo.near_cache.hit").value());
+  EXPECT_EQ(3UL, store_.counterFromString("redis.foo.near_cache.miss").value());
+}
+
+TEST_F(NearCacheTest, InvalidationDiscardsTheReadsInFlight) {
+  NearCache& near_cache = create(1024);
+  near_cache.insert("hot:a", bulkString("value"), near_cache.generation());
+  const uint64_t generation = near_cache.generation();
+  near_cache.invalidate("hot:a");
+  EXPECT_EQ(nullptr, near_cache.lookup("hot:a"));
+  EXPECT_EQ(1UL, store_.counterFromString("redis.foo.near_cache.invalidation").value());
+
+  near_cache.insert("hot:a", bulkString("value"), generation);
+  EXPECT_EQ(nullptr, near_cache.lookup("hot:a"));
+  near_cache.insert("hot:a", bulkString("new value"), near_cache.generation());
+  EXPECT_EQ(bulkString("new value"), *near_cache.lookup("hot:a"));
+}
+
+TEST_F(NearCacheTest, EvictsToStayWithinItsBytes) {
+  NearCache& near_cache = create(20);
+  near_cache.insert("hot:a", bulkString("value"), near_cache.generation());
+  time_system_.advanceTimeWait(std::chrono::milliseconds(500));
+  near_cache.insert("hot:b", bulkString("value"), near_cache.generation());
+  EXPECT_EQ(20UL, gauge("bytes"));
+
+  // The expired entries are evicted first, then arbitrary ones.
+  time_system_.advanceTimeWait(std::chrono::milliseconds(500));
+  near_cache.insert("hot:c", bulkString("value"), near_cache.generation());
+  EXPECT_EQ(nullptr, near_cache.lookup("hot:a"));
+  EXPECT_NE(nullptr, near_cache.lookup("hot:b"));
+  EXPECT_EQ(0UL, store_.counterFromString("redis.foo.near_cache.eviction").value());
+  near_cache.insert("hot:d", bulkString("value"), near_cache.generation());
+  EXPECT_EQ(1UL, store_.counterFromString("redis.foo.near_cache.eviction").value());
+  EXPECT_EQ(20UL, gauge("bytes"));
+
+  // The values larger than the cache aren't cached.
+  near_cache.insert("hot:e", bulkString(std::string(20, 'a')), near_cache.generation());
+  EXPECT_EQ(nullptr, near_cache.lookup("hot:e"));
+}
+
+} // namespace
+} // namespace RedisProxy
+} // namespace NetworkFilters
+} // namespace Extensions
+} // namespace Envoy
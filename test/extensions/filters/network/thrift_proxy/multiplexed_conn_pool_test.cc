@@ -0,0 +1,258 @@
+#include <memory>
+
+#include "source/common/buffer/buffer_impl.h"
+#include "source/extensions/filters/network/thrift_proxy/binary_protocol_impl.h"
+#include "source/extensions/filters/network/thrift_proxy/framed_transport_impl.h"
+#include "source/extensions/filters/network/thrift_proxy/router/multiplexed_conn_pool.h"
+
+#include "test/mocks/network/mocks.h"
+#include "test/mocks/tcp/mocks.h"
+#include "test/mocks/thread_local/mocks.h"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+using testing::_;
+using testing::Invoke;
+using testing::NiceMock;
+
+namespace Envoy {
+namespace Extensions {
+namespace NetworkFilters {
+namespace ThriftProxy {
+namespace Router {
+
+// A request taking its connection the way UpstreamRequest does.
+struct TestRequest : public Tcp::ConnectionPool::Callbacks {
+  // Tcp::ConnectionPool::Callbacks
+  void onPoolFailure(ConnectionPool::PoolFailureReason reason, absl::string_view,
+                     Upstream::HostDescriptionConstSharedPtr) override {
+    failure_ = reason;
+  }
+  void onPoolReady(Tcp::ConnectionPool::ConnectionDataPtr&& conn_data,
+                   Upstream::HostDescriptionConstSharedPtr) override {
+    conn_data_ = std::move(conn_data);
+    conn_data_->addUpstreamCallbacks(upstream_callbacks_);
+    auto* conn_state = conn_data_->connectionStateTyped<ThriftConnectionState>();
+    ASSERT_NE(nullptr, conn_state);
+    sequence_id_ = conn_state->nextSequenceId();
+    data().setSequenceId(sequence_id_);
+  }
+
+  MultiplexedConnectionData& data() {
+    return dynamic_cast<MultiplexedConnectionData&>(*conn_data_);
+  }
+
+  NiceMock<Tcp::ConnectionPool::MockUpstreamCallbacks> upstream_callbacks_;
+  Tcp::ConnectionPool::ConnectionDataPtr conn_data_;
+  int32_t sequence_id_{-1};
+  absl::optional<ConnectionPool::PoolFailureReason> failure_;
+};
+
+class MultiplexedConnPoolTest : public testing::Test {
+public:
+  void initialize(uint32_t max_requests_per_connection = 100) {
+    pools_ = std::make_unique<MultiplexedConnPools>(tls_, max_requests_per_connection);
+  }
+
+  Tcp::ConnectionPool::Cancellable* newConnection(TestRequest& request) {
+    return pools_->newConnection(pool_data_, TransportType::Framed, ProtocolType::Binary, request);
+  }
+
+  // Hands the next connection of the pool to the shared connection waiting for it.
+  void poolReady() {
+    auto& conn_data = *conn_pool_.connection_data_;
+    ON_CALL(conn_data, addUpstreamCallbacks(_))
+        .WillByDefault(Invoke([this](Tcp::ConnectionPool::UpstreamCallbacks& callbacks) {
+          upstream_callbacks_ = &callbacks;
+        }));
+    ON_CALL(conn_data, setConnectionState_(_))
+        .WillByDefault(Invoke([this](Tcp::ConnectionPool::ConnectionStatePtr& state) {
+          conn_state_ = std::move(state);
+        }));
+    ON_CALL(conn_data, connectionState()).WillByDefault(Invoke([this]() {
+      return conn_state_.get();
+    }));
+    conn_state_.reset();
+    conn_pool_.poolReady(connection_);
+  }
+
+  Buffer::OwnedImpl response(int32_t sequence_id) {
+    MessageMetadata metadata;
+    metadata.setMethodName("method");
+    metadata.setMessageType(MessageType::Reply);
+    metadata.setSequenceId(sequence_id);
+    BinaryProtocolImpl protocol;
+    Buffer::OwnedImpl message;
+    protocol.writeMessageBegin(message, metadata);
+    protocol.writeStructBegin(message, "");
+    protocol.writeFieldBegin(message, "", FieldType::Stop, 0);
+    protocol.writeStructEnd(message);
+    protocol.writeMessageEnd(message);
+    Buffer::OwnedImpl frame;
+    FramedTransportImpl().encodeFrame(frame, metadata, message);
+    return frame;
+  }
+
+  void expectResponse(TestRequest& request, uint64_t size) {
+    EXPECT_CALL(request.upstream_callbacks_, onUpstreamData(_, false))
+        .WillOnce(Invoke([size](Buffer::Instance& data, bool) { EXPECT_EQ(size, data.length()); }));
+  }
+
+  NiceMock<ThreadLocal::MockInstance> tls_;
+  NiceMock<Tcp::ConnectionPool::MockInstance> conn_pool_;
+  Upstream::TcpPoolData pool_data_{[]() {}, &conn_pool_};
+  NiceMock<Network::MockClientConnection> connection_;
+  Tcp::ConnectionPool::UpstreamCallbacks* upstream_callbacks_{};
+  Tcp::ConnectionPool::ConnectionStatePtr conn_state_;
+  std::unique_ptr<MultiplexedConnPools> pools_;
+};
+
+TEST_F(MultiplexedConnPoolTest, Supported) {
+  EXPECT_TRUE(MultiplexedConnPools::supported(TransportType::Framed, ProtocolType::Binary));
+  EXPECT_TRUE(MultiplexedConnPools::supported(TransportType::Header, ProtocolType::Compact));
+  EXPECT_FALSE(MultiplexedConnPools::supported(TransportType::Unframed, ProtocolType::Binary));
+  EXPECT_FALSE(MultiplexedConnPools::supported(TransportType::Framed, ProtocolType::Twitter));
+}
+
+TEST_F(MultiplexedConnPoolTest, RequestsShareTheConnection) {
+  initialize();
+  TestRequest request_1;
+  TestRequest request_2;
+  EXPECT_CALL(conn_pool_, newConnection(_));
+  EXPECT_NE(nullptr, newConnection(request_1));
+  EXPECT_NE(nullptr, newConnection(request_2));
+  poolReady();
+  ASSERT_NE(nullptr, request_1.conn_data_);
+  ASSERT_NE(nullptr, request_2.conn_data_);
+  EXPECT_NE(request_1.sequence_id_, request_2.sequence_id_);
+  EXPECT_EQ(&connection_, &request_1.conn_data_->connection());
+
+  // A request on the ready connection gets it right away.
+  TestRequest request_3;
+  EXPECT_EQ(nullptr, newConnection(request_3));
+  ASSERT_NE(nullptr, request_3.conn_data_);
+
+  // The responses are dispatched by sequence id, once their frames are whole.
+  Buffer::OwnedImpl response_2 = response(request_2.sequence_id_);
+  Buffer::OwnedImpl response_1 = response(request_1.sequence_id_);
+  const uint64_t response_size = response_1.length();
+  Buffer::OwnedImpl data;
+  data.move(response_2);
+  data.move(response_1, response_size - 1);
+  expectResponse(request_2, response_size);
+  upstream_callbacks_->onUpstreamData(data, false);
+  testing::Mock::VerifyAndClearExpectations(&request_2.upstream_callbacks_);
+  expectResponse(request_1, response_size);
+  upstream_callbacks_->onUpstreamData(response_1, false);
+
+  // The responses to the released requests are dropped.
+  request_3.conn_data_.reset();
+  Buffer::OwnedImpl response_3 = response(request_3.sequence_id_);
+  EXPECT_CALL(connection_, close(_)).Times(0);
+  upstream_callbacks_->onUpstreamData(response_3, false);
+  testing::Mock::VerifyAndClearExpectations(&connection_);
+}
+
+TEST_F(MultiplexedConnPoolTest, FullConnectionOpensAnother) {
+  initialize(1);
+  TestRequest request_1;
+  TestRequest request_2;
+  EXPECT_CALL(conn_pool_, newConnection(_)).Times(2);
+  EXPECT_NE(nullptr, newConnection(request_1));
+  EXPECT_NE(nullptr, newConnection(request_2));
+  poolReady();
+  EXPECT_NE(nullptr, request_1.conn_data_);
+  EXPECT_EQ(nullptr, request_2.conn_data_);
+  poolReady();
+  EXPECT_NE(nullptr, request_2.conn_data_);
+
+  // The connection of a released request takes the next one.
+  request_1.conn_data_.reset();
+  TestRequest request_3;
+  EXPECT_EQ(nullptr, newConnection(request_3));
+  EXPECT_NE(nullptr, request_3.conn_data_);
+}
+
+TEST_F(MultiplexedConnPoolTest, PoolFailureFailsPendingRequests) {
+  initialize();
+  TestRequest request_1;
+  TestRequest request_2;
+  newConnection(request_1);
+  Tcp::ConnectionPool::Cancellable* handle = newConnection(request_2);
+  ASSERT_NE(nullptr, handle);
+  handle->cancel(ConnectionPool::CancelPolicy::Default);
+  conn_pool_.poolFailure(ConnectionPool::PoolFailureReason::RemoteConnectionFailure);
+  EXPECT_EQ(ConnectionPool::PoolFailureReason::RemoteConnectionFailure, request_1.failure_);
+  EXPECT_FALSE(request_2.failure_.has_value());
+
+  // The next request opens another connection.
+  TestRequest request_3;
+  EXPECT_CALL(conn_pool_, newConnection(_));
+  EXPECT_NE(nullptr, newConnection(request_3));
+}
+
+TEST_F(MultiplexedConnPoolTest, ConnectionClosureEndsAllRequests) {
+  initialize();
+  TestRequest request_1;
+  TestRequest request_2;
+  newConnection(request_1);
+  newConnection(request_2);
+  poolReady();
+
+  // The requests release their connections when told.
+  EXPECT_CALL(request_1.upstream_callbacks_, onEvent(Network::ConnectionEvent::RemoteClose))
+      .WillOnce(Invoke([&request_1](Network::ConnectionEvent) { request_1.conn_data_.reset(); }));
+  EXPECT_CALL(request_2.upstream_callbacks_, onEvent(Network::ConnectionEvent::RemoteClose))
+      .WillOnce(Invoke([&request_2](Network::ConnectionEvent) { request_2.conn_data_.reset(); }));
+  upstream_callbacks_->onEvent(Network::ConnectionEvent::RemoteClose);
+
+  TestRequest request_3;
+  EXPECT_CALL(conn_pool_, newConnection(_));
+  EXPECT_NE(nullptr, newConnection(request_3));
+}
+
+TEST_F(MultiplexedConnPoolTest, UndecodableResponseClosesTheConnection) {
+  initialize();
+  TestRequest request;
+  newConnection(request);
+  poolReady();
+
+  Buffer::OwnedImpl data;
+  data.writeBEInt<int32_t>(4);
+  data.writeBEInt<int32_t>(0);
+  EXPECT_CALL(connection_, close(Network::ConnectionCloseType::NoFlush));
+  upstream_callbacks_->onUpstreamData(data, false);
+}
+
+TEST_F(MultiplexedConnPoolTest, DrainedConnectionClosesWhenIdle) {
+  initialize();
+  TestRequest request_1;
+  TestRequest request_2;
+  EXPECT_CALL(conn_pool_, newConnection(_));
+  newConnection(request_1);
+  newConnection(request_2);
+  poolReady();
+
+  EXPECT_CALL(connection_, close(_)).Times(0);
+  request_1.data().drain();
+  request_1.conn_data_.reset();
+  testing::Mock::VerifyAndClearExpectations(&connection_);
+
+  // A drained connection takes no new requests.
+  TestRequest request_3;
+  EXPECT_CALL(conn_pool_, newConnection(_));
+  EXPECT_NE(nullptr, newConnection(request_3));
+
+  EXPECT_CALL(connection_, close(Network::ConnectionCloseType::NoFlush))
+      .WillOnce(Invoke([this](Network::ConnectionCloseType) {
+        upstream_callbacks_->onEvent(Network::ConnectionEvent::LocalClose);
+      }));
+  request_2.conn_data_.reset();
+}
+
+} // namespace Router
+} // namespace ThriftProxy
+} // namespace NetworkFilters
+} // namespace Extensions
+} // namespace Envoy
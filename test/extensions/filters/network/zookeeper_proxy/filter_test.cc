@@ -2131,6 +2131,32 @@ TEST_F(ZooKeeperFilterTest, MultipleResponsesWithMultipleOnWriteCalls4) {
   EXPECT_EQ(0UL, config_->stats().getdata_decoder_error_.value());
 }
 
+// Test that only the bytes of the packets of the connections which aren't fully decoded are
+// charged, including of the packets split across reads.
+TEST_F(ZooKeeperFilterTest, LengthOnlyDecoding) {
+  initialize();
+  filter_ = std::make_unique<ZooKeeperFilter>(config_, time_system_, false);
+  filter_->initializeReadFilterCallbacks(filter_callbacks_);
+
+  Buffer::OwnedImpl data = encodePathWatch("/foo", true);
+  data.add(encodePathWatch("/bar", false));
+  Buffer::OwnedImpl first_data;
+  first_data.move(data, 30);
+  EXPECT_EQ(Envoy::Network::FilterStatus::Continue, filter_->onData(first_data, false));
+  EXPECT_EQ(21UL, config_->stats().request_bytes_.value());
+  EXPECT_EQ(Envoy::Network::FilterStatus::Continue, filter_->onData(data, false));
+  EXPECT_EQ(42UL, config_->stats().request_bytes_.value());
+
+  Buffer::OwnedImpl resp_data = encodeResponse(1000, 2000, 0, "");
+  EXPECT_EQ(Envoy::Network::FilterStatus::Continue, filter_->onWrite(resp_data, false));
+  EXPECT_EQ(24UL, config_->stats().response_bytes_.value());
+
+  EXPECT_EQ(0UL, config_->stats().getdata_rq_.value());
+  EXPECT_EQ(0UL, config_->stats().getdata_rq_bytes_.value());
+  EXPECT_EQ(0UL, config_->stats().getdata_resp_.value());
+  EXPECT_EQ(0UL, config_->stats().decoder_error_.value());
+}
+
 } // namespace ZooKeeperProxy
 } // namespace NetworkFilters
 } // namespace Extensions
@@ -734,6 +734,66 @@ TEST_F(DnsFilterTest, LocalTypeAAAAQuerySuccess) {
   EXPECT_EQ(1, config_->stats().aaaa_record_queries_.value());
 }
 
+TEST_F(DnsFilterTest, RepeatedQueryAnsweredFromResponseCache) {
+  InSequence s;
+
+  setup(forward_query_off_config);
+  const std::list<std::string> expected{"10.0.0.1", "10.0.0.2"};
+  const auto query_and_verify = [&](const std::string& domain, uint16_t query_id) {
+    const std::string query =
+        Utils::buildQueryForDomain(domain, DNS_RECORD_TYPE_A, DNS_RECORD_CLASS_IN, query_id);
+    ASSERT_FALSE(query.empty());
+    sendQueryFromClient("10.0.0.1:1000", query);
+
+    response_ctx_ = ResponseValidator::createResponseContext(udp_response_, counters_);
+    EXPECT_TRUE(response_ctx_->parse_status_);
+    EXPECT_EQ(query_id, response_ctx_->header_.id);
+    EXPECT_EQ(DNS_RESPONSE_CODE_NO_ERROR, response_ctx_->getQueryResponseCode());
+    EXPECT_EQ(expected.size(), response_ctx_->answers_.size());
+    for (const auto& answer : response_ctx_->answers_) {
+      EXPECT_EQ(answer.first, domain);
+      Utils::verifyAddress(expected, answer.second);
+    }
+  };
+
+  query_and_verify("www.foo1.com", 1);
+  EXPECT_EQ(0, config_->stats().response_cache_hits_.value());
+
+  // The same question is answered from the cache, with the transaction id of the query.
+  query_and_verify("www.foo1.com", 2);
+  EXPECT_EQ(1, config_->stats().response_cache_hits_.value());
+
+  // The cached response expires with the TTL of the domain.
+  simTime().advanceTimeWait(std::chrono::seconds(301));
+  query_and_verify("www.foo1.com", 3);
+  EXPECT_EQ(1, config_->stats().response_cache_hits_.value());
+
+  // The stats account for the queries answered from the cache.
+  EXPECT_EQ(3, config_->stats().downstream_rx_queries_.value());
+  EXPECT_EQ(3, config_->stats().known_domain_queries_.value());
+  EXPECT_EQ(3, config_->stats().a_record_queries_.value());
+  EXPECT_EQ(6, config_->stats().local_a_record_answers_.value());
+  EXPECT_EQ(3, config_->stats().downstream_tx_responses_.value());
+}
+
+TEST_F(DnsFilterTest, ResponseCacheSkipsRotatedAnswers) {
+  InSequence s;
+
+  setup(forward_query_off_config);
+  const std::string query =
+      Utils::buildQueryForDomain("www.foo16.com", DNS_RECORD_TYPE_A, DNS_RECORD_CLASS_IN);
+  ASSERT_FALSE(query.empty());
+
+  // The answers to the domains with more addresses than returned start at a random address, so
+  // their responses are built for each query.
+  sendQueryFromClient("10.0.0.1:1000", query);
+  sendQueryFromClient("10.0.0.1:1000", query);
+  response_ctx_ = ResponseValidator::createResponseContext(udp_response_, counters_);
+  EXPECT_TRUE(response_ctx_->parse_status_);
+  EXPECT_EQ(MAX_RETURNED_RECORDS, response_ctx_->answers_.size());
+  EXPECT_EQ(0, config_->stats().response_cache_hits_.value());
+}
+
 TEST_F(DnsFilterTest, ExternalResolutionReturnSingleAddress) {
   InSequence s;
 
@@ -893,6 +953,79 @@ TEST_F(DnsFilterTest, ExternalResolutionReturnMultipleAddresses) {
   EXPECT_TRUE(Mock::VerifyAndClearExpectations(resolver_.get()));
 }
 
+TEST_F(DnsFilterTest, ExternalResolutionCached) {
+  InSequence s;
+
+  auto timeout_timer = new NiceMock<Event::MockTimer>(&dispatcher_);
+  EXPECT_CALL(*timeout_timer, enableTimer(_, _));
+
+  const std::string expected_address("130.207.244.251");
+  const std::string domain("www.foobaz.com");
+  setup(R"EOF(
+stat_prefix: "my_prefix"
+client_config:
+  resolver_timeout: 1s
+  typed_dns_resolver_config:
+    name: envoy.network.dns_resolver.cares
+    typed_config:
+      "@type": type.googleapis.com/envoy.extensions.network.dns_resolver.cares.v3.CaresDnsResolverConfig
+  max_pending_lookups: 256
+  max_cached_resolutions: 16
+server_config:
+  inline_dns_table:
+    external_retry_count: 0
+    virtual_domains:
+      - name: "www.foo1.com"
+        endpoint:
+          address_list:
+            address:
+            - "10.0.0.1"
+)EOF");
+
+  const std::string query =
+      Utils::buildQueryForDomain(domain, DNS_RECORD_TYPE_A, DNS_RECORD_CLASS_IN);
+  ASSERT_FALSE(query.empty());
+
+  Network::DnsResolver::ResolveCb resolve_cb;
+  EXPECT_CALL(*resolver_, resolve(domain, _, _))
+      .WillOnce(DoAll(SaveArg<2>(&resolve_cb), Return(&resolver_->active_query_)));
+  sendQueryFromClient("10.0.0.1:1000", query);
+
+  EXPECT_CALL(*timeout_timer, disableTimer()).Times(AnyNumber());
+  resolve_cb(Network::DnsResolver::ResolutionStatus::Success, "",
+             TestUtility::makeDnsResponse({expected_address}, std::chrono::seconds(60)));
+  EXPECT_TRUE(Mock::VerifyAndClearExpectations(resolver_.get()));
+
+  // The next query for the name is answered without a lookup until the TTL elapses.
+  EXPECT_CALL(*resolver_, resolve(_, _, _)).Times(0);
+  sendQueryFromClient("10.0.0.1:1000", query);
+  EXPECT_TRUE(Mock::VerifyAndClearExpectations(resolver_.get()));
+
+  response_ctx_ = ResponseValidator::createResponseContext(udp_response_, counters_);
+  EXPECT_TRUE(response_ctx_->parse_status_);
+  EXPECT_EQ(DNS_RESPONSE_CODE_NO_ERROR, response_ctx_->getQueryResponseCode());
+  EXPECT_EQ(1, response_ctx_->answers_.size());
+  std::list<std::string> expected{expected_address};
+  for (const auto& answer : response_ctx_->answers_) {
+    EXPECT_EQ(answer.first, domain);
+    Utils::verifyAddress(expected, answer.second);
+  }
+
+  EXPECT_EQ(1, config_->stats().external_resolution_cache_hits_.value());
+  EXPECT_EQ(2, config_->stats().externally_resolved_queries_.value());
+  EXPECT_EQ(2, config_->stats().external_a_record_answers_.value());
+
+  // Once the TTL elapsed, the name is resolved again.
+  simTime().advanceTimeWait(std::chrono::seconds(61));
+  auto second_timer = new NiceMock<Event::MockTimer>(&dispatcher_);
+  EXPECT_CALL(*second_timer, enableTimer(_, _));
+  EXPECT_CALL(*resolver_, resolve(domain, _, _))
+      .WillOnce(DoAll(SaveArg<2>(&resolve_cb), Return(&resolver_->active_query_)));
+  sendQueryFromClient("10.0.0.1:1000", query);
+  EXPECT_EQ(1, config_->stats().external_resolution_cache_hits_.value());
+  EXPECT_TRUE(Mock::VerifyAndClearExpectations(resolver_.get()));
+}
+
 TEST_F(DnsFilterTest, ExternalResolutionReturnNoAddresses) {
   InSequence s;
 
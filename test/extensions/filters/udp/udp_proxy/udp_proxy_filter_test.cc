@@ -952,6 +952,46 @@ matcher:
   EXPECT_EQ(1, config_->stats().downstream_sess_active_.value());
 }
 
+// Datagrams of a peer keep going to its session, whether they come in runs or interleaved with the
+// datagrams of other peers.
+TEST_F(UdpProxyFilterTest, RunsAndInterleavedDatagramsOfPeers) {
+  InSequence s;
+
+  setup(readConfig(R"EOF(
+stat_prefix: foo
+matcher:
+  on_no_match:
+    action:
+      name: route
+      typed_config:
+        '@type': type.googleapis.com/envoy.extensions.filters.udp.udp_proxy.v3.Route
+        cluster: fake_cluster
+  )EOF"));
+
+  expectSessionCreate(upstream_address_);
+  test_sessions_[0].expectWriteToUpstream("hello", 0, nullptr, true);
+  recvDataFromDownstream("10.0.0.1:1000", "10.0.0.2:80", "hello");
+  test_sessions_[0].expectWriteToUpstream("hello2");
+  recvDataFromDownstream("10.0.0.1:1000", "10.0.0.2:80", "hello2");
+
+  expectSessionCreate(upstream_address_);
+  test_sessions_[1].expectWriteToUpstream("world", 0, nullptr, true);
+  recvDataFromDownstream("10.0.0.3:1000", "10.0.0.2:80", "world");
+  test_sessions_[0].expectWriteToUpstream("hello3");
+  recvDataFromDownstream("10.0.0.1:1000", "10.0.0.2:80", "hello3");
+  test_sessions_[1].expectWriteToUpstream("world2");
+  recvDataFromDownstream("10.0.0.3:1000", "10.0.0.2:80", "world2");
+
+  // The same peer to another local address is another session.
+  expectSessionCreate(upstream_address_);
+  test_sessions_[2].expectWriteToUpstream("other", 0, nullptr, true);
+  recvDataFromDownstream("10.0.0.3:1000", "10.0.0.4:80", "other");
+
+  EXPECT_EQ(3, config_->stats().downstream_sess_total_.value());
+  EXPECT_EQ(3, config_->stats().downstream_sess_active_.value());
+  EXPECT_EQ(6, config_->stats().downstream_sess_rx_datagrams_.value());
+}
+
 // In this case the host becomes unhealthy, but we get the same host back, so just keep using the
 // current session.
 TEST_F(UdpProxyFilterTest, HostUnhealthyPickSameHost) {
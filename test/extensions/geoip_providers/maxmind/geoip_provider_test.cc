@@ -265,6 +265,45 @@ TEST_F(GeoipProviderTest, ValidConfigCityMultipleLookups) {
   expectStats("city_db", 2, 2);
 }
 
+TEST_F(GeoipProviderTest, ValidConfigCityLookupCache) {
+  const std::string config_yaml = R"EOF(
+    common_provider_config:
+      geo_headers_to_add:
+        country: "x-geo-country"
+        region: "x-geo-region"
+        city: "x-geo-city"
+    city_db_path: "{{ test_rundir }}/test/extensions/geoip_providers/maxmind/test_data/GeoLite2-City-Test.mmdb"
+    lookup_cache:
+      max_entries: 1
+      ipv4_prefix_len: 24
+  )EOF";
+  initializeProvider(config_yaml);
+  auto lookup = [this](const std::string& address) {
+    Geolocation::LookupRequest lookup_rq{Network::Utility::parseInternetAddressNoThrow(address)};
+    testing::MockFunction<void(Geolocation::LookupResult &&)> lookup_cb;
+    EXPECT_CALL(lookup_cb, Call(_)).WillOnce(SaveArg<0>(&captured_lookup_response_));
+    provider_->lookup(std::move(lookup_rq), lookup_cb.AsStdFunction());
+  };
+  auto& provider_scope = GeoipProviderPeer::providerScope(provider_);
+  lookup("78.26.243.166");
+  EXPECT_EQ(3, captured_lookup_response_.size());
+  expectStats("city_db", 1, 1);
+  // The addresses of the same /24 prefix get the cached result.
+  lookup("78.26.243.1");
+  EXPECT_EQ("Boxford", captured_lookup_response_["x-geo-city"]);
+  expectStats("city_db", 1, 1);
+  EXPECT_EQ(1, provider_scope.counterFromString("lookup_cache.hit").value());
+  EXPECT_EQ(1, provider_scope.counterFromString("lookup_cache.miss").value());
+  // Another prefix evicts the cached result.
+  lookup("63.25.243.11");
+  EXPECT_EQ(3, captured_lookup_response_.size());
+  lookup("78.26.243.166");
+  EXPECT_EQ("Boxford", captured_lookup_response_["x-geo-city"]);
+  expectStats("city_db", 3, 3);
+  EXPECT_EQ(1, provider_scope.counterFromString("lookup_cache.hit").value());
+  EXPECT_EQ(3, provider_scope.counterFromString("lookup_cache.miss").value());
+}
+
 using GeoipProviderDeathTest = GeoipProviderTest;
 
 TEST_F(GeoipProviderDeathTest, GeoDbNotSetForConfiguredHeader) {
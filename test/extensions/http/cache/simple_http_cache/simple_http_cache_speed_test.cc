@@ -0,0 +1,112 @@
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "source/common/http/header_map_impl.h"
+#include "source/common/stats/isolated_store_impl.h"
+#include "source/extensions/http/cache/simple_http_cache/simple_http_cache.h"
+
+#include "test/mocks/server/server_factory_context.h"
+#include "test/test_common/utility.h"
+
+#include "benchmark/benchmark.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace Cache {
+
+// The cache shared by the threads of a benchmark, created and destroyed by its first thread.
+class SimpleHttpCacheBenchmark {
+public:
+  SimpleHttpCacheBenchmark(uint32_t shards, uint64_t max_cache_size_bytes, uint32_t num_keys) {
+    SimpleHttpCache::ConfigProto config;
+    config.mutable_shards()->set_value(shards);
+    config.set_max_cache_size_bytes(max_cache_size_bytes);
+    cache_ = std::make_unique<SimpleHttpCache>(config, *stats_store_.rootScope());
+    Http::TestRequestHeaderMapImpl request_headers{
+        {":method", "GET"}, {":scheme", "https"}, {":authority", "example.com"}};
+    requests_.reserve(num_keys);
+    for (uint32_t i = 0; i < num_keys; ++i) {
+      request_headers.setPath(absl::StrCat("/", i));
+      requests_.emplace_back(request_headers, SystemTime(), vary_allow_list_);
+    }
+  }
+
+  void insert(uint32_t index) {
+    cache_->insert(requests_[index % requests_.size()].key(),
+                   Http::createHeaderMap<Http::ResponseHeaderMapImpl>(
+                       {{Http::Headers::get().Status, "200"}}),
+                   {SystemTime()}, std::string(BodySize, 'a'), nullptr);
+  }
+
+  SimpleHttpCache::Entry lookup(uint32_t index) {
+    return cache_->lookup(requests_[index % requests_.size()]);
+  }
+
+  static constexpr uint64_t BodySize = 4096;
+
+private:
+  testing::NiceMock<Server::Configuration::MockServerFactoryContext> factory_context_;
+  Protobuf::RepeatedPtrField<envoy::type::matcher::v3::StringMatcher> allow_list_;
+  VaryAllowList vary_allow_list_{allow_list_, factory_context_};
+  Stats::IsolatedStoreImpl stats_store_;
+  std::unique_ptr<SimpleHttpCache> cache_;
+  std::vector<LookupRequest> requests_;
+};
+
+static std::unique_ptr<SimpleHttpCacheBenchmark> benchmark_cache;
+
+// Measures the hits of a warm cache from concurrent threads. The first argument is the number of
+// shards.
+static void bmLookupHits(benchmark::State& state) {
+  constexpr uint32_t NumKeys = 1024;
+  if (state.thread_index() == 0) {
+    benchmark_cache = std::make_unique<SimpleHttpCacheBenchmark>(state.range(0), 0, NumKeys);
+    for (uint32_t i = 0; i < NumKeys; ++i) {
+      benchmark_cache->insert(i);
+    }
+  }
+  uint32_t index = state.thread_index() * 7919;
+  for (auto _ : state) {
+    UNREFERENCED_PARAMETER(_);
+    benchmark::DoNotOptimize(benchmark_cache->lookup(index++));
+  }
+  if (state.thread_index() == 0) {
+    benchmark_cache.reset();
+  }
+}
+BENCHMARK(bmLookupHits)->Arg(1)->Arg(16)->Threads(1)->Threads(8)->UseRealTime();
+
+// Measures a mix of one insert for every three lookups from concurrent threads, on a cache too
+// small for all the keys so that the inserts evict. The first argument is the number of shards.
+static void bmMixedWithEvictions(benchmark::State& state) {
+  constexpr uint32_t NumKeys = 4096;
+  if (state.thread_index() == 0) {
+    // Room for about a quarter of the keys.
+    benchmark_cache = std::make_unique<SimpleHttpCacheBenchmark>(
+        state.range(0), NumKeys / 4 * SimpleHttpCacheBenchmark::BodySize, NumKeys);
+  }
+  uint32_t index = state.thread_index() * 7919;
+  for (auto _ : state) {
+    UNREFERENCED_PARAMETER(_);
+    // The lookups go to the keys inserted 512, 1024 and 1536 iterations earlier, the cache only
+    // holding the last 1024 of them, for a mix of hits and misses.
+    const uint32_t key = ((index / 4 - (index % 4) * 512) * 2654435761u) % NumKeys;
+    if (index % 4 == 0) {
+      benchmark_cache->insert(key);
+    } else {
+      benchmark::DoNotOptimize(benchmark_cache->lookup(key));
+    }
+    ++index;
+  }
+  if (state.thread_index() == 0) {
+    benchmark_cache.reset();
+  }
+}
+BENCHMARK(bmMixedWithEvictions)->Arg(1)->Arg(16)->Threads(1)->Threads(8)->UseRealTime();
+
+} // namespace Cache
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
@@ -2,6 +2,7 @@
 #include "envoy/registry/registry.h"
 
 #include "source/common/buffer/buffer_impl.h"
+#include "source/common/stats/isolated_store_impl.h"
 #include "source/extensions/filters/http/cache/cache_entry_utils.h"
 #include "source/extensions/filters/http/cache/cache_headers_utils.h"
 #include "source/extensions/http/cache/simple_http_cache/simple_http_cache.h"
@@ -25,7 +26,9 @@ public:
   bool validationEnabled() const override { return true; }
 
 private:
-  std::shared_ptr<SimpleHttpCache> cache_ = std::make_shared<SimpleHttpCache>();
+  Stats::IsolatedStoreImpl stats_store_;
+  std::shared_ptr<SimpleHttpCache> cache_ =
+      std::make_shared<SimpleHttpCache>(SimpleHttpCache::ConfigProto(), *stats_store_.rootScope());
 };
 
 INSTANTIATE_TEST_SUITE_P(SimpleHttpCacheTest, HttpCacheImplementationTest,
@@ -34,6 +37,117 @@ INSTANTIATE_TEST_SUITE_P(SimpleHttpCacheTest, HttpCacheImplementationTest,
                            return "SimpleHttpCache";
                          });
 
+class SimpleHttpCacheEvictionTest : public testing::Test {
+protected:
+  SimpleHttpCacheEvictionTest() {
+    config_.set_max_cache_size_bytes(1000);
+    config_.mutable_shards()->set_value(1);
+  }
+
+  void createCache() {
+    cache_ = std::make_shared<SimpleHttpCache>(config_, *stats_store_.rootScope());
+  }
+
+  LookupRequest makeLookupRequest(absl::string_view path) {
+    request_headers_.setPath(path);
+    return {request_headers_, time_system_.systemTime(), vary_allow_list_};
+  }
+
+  bool insert(absl::string_view path, uint64_t body_size) {
+    return cache_->insert(makeLookupRequest(path).key(),
+                          Http::createHeaderMap<Http::ResponseHeaderMapImpl>(
+                              {{Http::Headers::get().Status, "200"}}),
+                          {time_system_.systemTime()}, std::string(body_size, 'a'), nullptr);
+  }
+
+  bool cached(absl::string_view path) {
+    return cache_->lookup(makeLookupRequest(path)).response_headers_ != nullptr;
+  }
+
+  Event::SimulatedTimeSystem time_system_;
+  testing::NiceMock<Server::Configuration::MockFactoryContext> factory_context_;
+  Stats::IsolatedStoreImpl stats_store_;
+  SimpleHttpCache::ConfigProto config_;
+  Protobuf::RepeatedPtrField<envoy::type::matcher::v3::StringMatcher> allow_list_;
+  VaryAllowList vary_allow_list_{allow_list_, factory_context_.server_factory_context_};
+  Http::TestRequestHeaderMapImpl request_headers_{
+      {":method", "GET"}, {":scheme", "https"}, {":authority", "example.com"}};
+  std::shared_ptr<SimpleHttpCache> cache_;
+};
+
+TEST_F(SimpleHttpCacheEvictionTest, EvictsLeastRecentlyUsed) {
+  createCache();
+  EXPECT_TRUE(insert("/a", 300));
+  EXPECT_TRUE(insert("/b", 300));
+  EXPECT_TRUE(insert("/c", 300));
+  // Using /a makes /b the least recently used entry.
+  EXPECT_TRUE(cached("/a"));
+  EXPECT_TRUE(insert("/d", 300));
+
+  EXPECT_TRUE(cached("/a"));
+  EXPECT_FALSE(cached("/b"));
+  EXPECT_TRUE(cached("/c"));
+  EXPECT_TRUE(cached("/d"));
+  EXPECT_EQ(cache_->stats().evictions_.value(), 1);
+  EXPECT_EQ(cache_->stats().inserts_.value(), 4);
+  EXPECT_EQ(cache_->stats().entries_.value(), 3);
+  EXPECT_LE(cache_->stats().size_bytes_.value(), 1000);
+  EXPECT_EQ(cache_->stats().hits_.value(), 4);
+  EXPECT_EQ(cache_->stats().misses_.value(), 1);
+}
+
+TEST_F(SimpleHttpCacheEvictionTest, RejectsEntriesLargerThanShard) {
+  config_.mutable_shards()->set_value(2);
+  createCache();
+  // Each of the two shards holds 500 bytes.
+  EXPECT_FALSE(insert("/a", 600));
+  EXPECT_FALSE(cached("/a"));
+  EXPECT_EQ(cache_->stats().inserts_too_large_.value(), 1);
+  EXPECT_EQ(cache_->stats().entries_.value(), 0);
+}
+
+TEST_F(SimpleHttpCacheEvictionTest, UnboundedNeverEvicts) {
+  config_.clear_max_cache_size_bytes();
+  createCache();
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_TRUE(insert(absl::StrCat("/", i), 1000));
+  }
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_TRUE(cached(absl::StrCat("/", i)));
+  }
+  EXPECT_EQ(cache_->stats().evictions_.value(), 0);
+}
+
+TEST_F(SimpleHttpCacheEvictionTest, HitsShareTheCachedBody) {
+  createCache();
+  EXPECT_TRUE(insert("/a", 100));
+  SimpleHttpCache::Entry first = cache_->lookup(makeLookupRequest("/a"));
+  SimpleHttpCache::Entry second = cache_->lookup(makeLookupRequest("/a"));
+  ASSERT_NE(first.body_, nullptr);
+  EXPECT_EQ(first.body_.get(), second.body_.get());
+
+  // The cached body stays alive while a response references it, even once evicted.
+  EXPECT_TRUE(insert("/b", 950));
+  EXPECT_FALSE(cached("/a"));
+  EXPECT_EQ(*first.body_, std::string(100, 'a'));
+}
+
+TEST(Registration, ConfigsShareCaches) {
+  HttpCacheFactory* factory = Registry::FactoryRegistry<HttpCacheFactory>::getFactoryByType(
+      "envoy.extensions.http.cache.simple_http_cache.v3.SimpleHttpCacheConfig");
+  ASSERT_NE(factory, nullptr);
+  testing::NiceMock<Server::Configuration::MockFactoryContext> factory_context;
+  envoy::extensions::filters::http::cache::v3::CacheConfig config;
+  config.mutable_typed_config()->PackFrom(SimpleHttpCache::ConfigProto());
+  std::shared_ptr<HttpCache> cache = factory->getCache(config, factory_context);
+  EXPECT_EQ(factory->getCache(config, factory_context), cache);
+
+  SimpleHttpCache::ConfigProto bounded;
+  bounded.set_max_cache_size_bytes(1000);
+  config.mutable_typed_config()->PackFrom(bounded);
+  EXPECT_NE(factory->getCache(config, factory_context), cache);
+}
+
 TEST(Registration, GetFactory) {
   HttpCacheFactory* factory = Registry::FactoryRegistry<HttpCacheFactory>::getFactoryByType(
       "envoy.extensions.http.cache.simple_http_cache.v3.SimpleHttpCacheConfig");
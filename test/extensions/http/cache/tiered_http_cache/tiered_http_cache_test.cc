@@ -0,0 +1,163 @@
+#include "source/common/buffer/buffer_impl.h"
+#include "source/common/stats/isolated_store_impl.h"
+#include "source/extensions/filters/http/cache/cache_headers_utils.h"
+#include "source/extensions/http/cache/simple_http_cache/simple_http_cache.h"
+#include "source/extensions/http/cache/tiered_http_cache/tiered_http_cache.h"
+
+#include "test/extensions/filters/http/cache/http_cache_implementation_test_common.h"
+#include "test/mocks/http/mocks.h"
+#include "test/mocks/server/factory_context.h"
+#include "test/test_common/simulated_time_system.h"
+#include "test/test_common/utility.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace Cache {
+namespace {
+
+class TieredHttpCacheTestDelegate : public HttpCacheTestDelegate {
+public:
+  std::shared_ptr<HttpCache> cache() override { return cache_; }
+  bool validationEnabled() const override { return true; }
+
+private:
+  Event::SimulatedTimeSystem time_system_;
+  Stats::IsolatedStoreImpl stats_store_;
+  std::shared_ptr<TieredHttpCache> cache_ = std::make_shared<TieredHttpCache>(
+      TieredHttpCache::ConfigProto(),
+      std::vector<std::shared_ptr<HttpCache>>{
+          std::make_shared<SimpleHttpCache>(SimpleHttpCache::ConfigProto(),
+                                            *stats_store_.rootScope()),
+          std::make_shared<SimpleHttpCache>(SimpleHttpCache::ConfigProto(),
+                                            *stats_store_.rootScope())},
+      time_system_, *stats_store_.rootScope());
+};
+
+INSTANTIATE_TEST_SUITE_P(TieredHttpCacheTest, HttpCacheImplementationTest,
+                         testing::Values(std::make_unique<TieredHttpCacheTestDelegate>),
+                         [](const testing::TestParamInfo<HttpCacheImplementationTest::ParamType>&) {
+                           return "TieredHttpCache";
+                         });
+
+class TieredHttpCachePromotionTest : public testing::Test {
+protected:
+  TieredHttpCachePromotionTest() {
+    config_.mutable_promotion_hits()->set_value(2);
+    createCache();
+  }
+
+  void createCache() {
+    hot_ = std::make_shared<SimpleHttpCache>(SimpleHttpCache::ConfigProto(),
+                                             *stats_store_.rootScope());
+    cold_ = std::make_shared<SimpleHttpCache>(SimpleHttpCache::ConfigProto(),
+                                              *stats_store_.rootScope());
+    cache_ = std::make_shared<TieredHttpCache>(config_,
+                                               std::vector<std::shared_ptr<HttpCache>>{hot_, cold_},
+                                               time_system_, *stats_store_.rootScope());
+  }
+
+  LookupRequest makeLookupRequest() {
+    return {request_headers_, time_system_.systemTime(), vary_allow_list_};
+  }
+
+  void insertIntoColdTier(absl::string_view body) {
+    Http::TestResponseHeaderMapImpl response_headers{
+        {":status", "200"},
+        {"date", formatter_.fromTime(time_system_.systemTime())},
+        {"cache-control", "public,max-age=3600"}};
+    EXPECT_TRUE(cold_->insert(makeLookupRequest().key(),
+                              Http::createHeaderMap<Http::ResponseHeaderMapImpl>(response_headers),
+                              {time_system_.systemTime()}, std::string(body), nullptr));
+  }
+
+  // Looks the request up like the cache filter does, reading the body range if it's found.
+  CacheEntryStatus lookUpAndRead(uint64_t begin, uint64_t end) {
+    LookupContextPtr lookup = cache_->makeLookupContext(makeLookupRequest(), decoder_callbacks_);
+    lookup->setEncoderFilterCallbacks(encoder_callbacks_);
+    LookupResult lookup_result;
+    lookup->getHeaders([&](LookupResult&& result) { lookup_result = std::move(result); });
+    if (lookup_result.cache_entry_status_ == CacheEntryStatus::Ok) {
+      lookup->getBody({begin, end}, [](Buffer::InstancePtr&& body) { EXPECT_NE(body, nullptr); });
+    }
+    lookup->onDestroy();
+    return lookup_result.cache_entry_status_;
+  }
+
+  bool inHotTier() { return hot_->lookup(makeLookupRequest()).response_headers_ != nullptr; }
+
+  uint64_t counter(absl::string_view name) {
+    return TestUtility::findCounter(stats_store_, absl::StrCat("tiered_http_cache.", name))
+        ->value();
+  }
+
+  Event::SimulatedTimeSystem time_system_;
+  testing::NiceMock<Server::Configuration::MockFactoryContext> factory_context_;
+  Stats::IsolatedStoreImpl stats_store_;
+  TieredHttpCache::ConfigProto config_;
+  Protobuf::RepeatedPtrField<envoy::type::matcher::v3::StringMatcher> allow_list_;
+  VaryAllowList vary_allow_list_{allow_list_, factory_context_.server_factory_context_};
+  DateFormatter formatter_{"%a, %d %b %Y %H:%M:%S GMT"};
+  Http::TestRequestHeaderMapImpl request_headers_{
+      {":method", "GET"}, {":scheme", "https"}, {":authority", "example.com"}, {":path", "/a"}};
+  testing::NiceMock<Http::MockStreamDecoderFilterCallbacks> decoder_callbacks_;
+  testing::NiceMock<Http::MockStreamEncoderFilterCallbacks> encoder_callbacks_;
+  std::shared_ptr<SimpleHttpCache> hot_;
+  std::shared_ptr<SimpleHttpCache> cold_;
+  std::shared_ptr<TieredHttpCache> cache_;
+};
+
+TEST_F(TieredHttpCachePromotionTest, PromotesAfterRepeatedHits) {
+  insertIntoColdTier("hello");
+  EXPECT_EQ(CacheEntryStatus::Ok, lookUpAndRead(0, 5));
+  EXPECT_FALSE(inHotTier());
+  EXPECT_EQ(CacheEntryStatus::Ok, lookUpAndRead(0, 5));
+  EXPECT_TRUE(inHotTier());
+  EXPECT_EQ(1, counter("promotions"));
+  EXPECT_EQ(2, counter("lower_tier_hits"));
+
+  // The entry is now served by the first tier.
+  EXPECT_EQ(CacheEntryStatus::Ok, lookUpAndRead(0, 5));
+  EXPECT_EQ(2, counter("lower_tier_hits"));
+  EXPECT_EQ("hello", *hot_->lookup(makeLookupRequest()).body_);
+}
+
+TEST_F(TieredHttpCachePromotionTest, PartialReadDoesNotPromote) {
+  config_.mutable_promotion_hits()->set_value(1);
+  createCache();
+  insertIntoColdTier("hello");
+  EXPECT_EQ(CacheEntryStatus::Ok, lookUpAndRead(1, 3));
+  EXPECT_FALSE(inHotTier());
+  EXPECT_EQ(0, counter("promotions"));
+  EXPECT_EQ(1, counter("promotions_aborted"));
+}
+
+TEST_F(TieredHttpCachePromotionTest, MissIsInsertedIntoLastTier) {
+  LookupContextPtr lookup = cache_->makeLookupContext(makeLookupRequest(), decoder_callbacks_);
+  lookup->getHeaders([](LookupResult&& result) {
+    EXPECT_EQ(CacheEntryStatus::Unusable, result.cache_entry_status_);
+  });
+  InsertContextPtr insert = cache_->makeInsertContext(std::move(lookup), encoder_callbacks_);
+  Http::TestResponseHeaderMapImpl response_headers{
+      {":status", "200"},
+      {"date", formatter_.fromTime(time_system_.systemTime())},
+      {"cache-control", "public,max-age=3600"}};
+  bool inserted = false;
+  insert->insertHeaders(
+      response_headers, {time_system_.systemTime()}, [](bool ready) { EXPECT_TRUE(ready); },
+      false);
+  insert->insertBody(
+      Buffer::OwnedImpl("hello"), [&inserted](bool ready) { inserted = ready; }, true);
+  insert->onDestroy();
+  EXPECT_TRUE(inserted);
+  EXPECT_NE(cold_->lookup(makeLookupRequest()).response_headers_, nullptr);
+  EXPECT_FALSE(inHotTier());
+}
+
+} // namespace
+} // namespace Cache
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
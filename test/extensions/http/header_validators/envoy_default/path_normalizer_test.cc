@@ -526,6 +526,30 @@ TEST_F(PathNormalizerTest, NormalizePercentEncodedCase) {
   EXPECT_EQ(headers.getPathValue(), "/dir1%ABdir2%3A%FFZ");
 }
 
+TEST_F(PathNormalizerTest, NormalizePathUriAlreadyNormalized) {
+  ::Envoy::Http::TestRequestHeaderMapImpl headers{{":path", "/dir1/.well-known/dir2?q=//../"}};
+  const char* path = headers.getPathValue().data();
+
+  auto normalizer = create(empty_config);
+  auto result = normalizer->normalizePathUri(headers);
+
+  EXPECT_EQ(result.action(), PathNormalizer::PathNormalizationResult::Action::Accept);
+  EXPECT_EQ(headers.getPathValue(), "/dir1/.well-known/dir2?q=//../");
+  // The header wasn't set again.
+  EXPECT_EQ(headers.getPathValue().data(), path);
+}
+
+TEST_F(PathNormalizerTest, NormalizePathUriAllTransforms) {
+  ::Envoy::Http::TestRequestHeaderMapImpl headers{
+      {":path", "/dir1/dir2/%2e%2E//dir3%2F.%5C..\\./%41?q=/../"}};
+
+  auto normalizer = create(decode_encoded_slash_config);
+  auto result = normalizer->normalizePathUri(headers);
+
+  EXPECT_EQ(result.action(), PathNormalizer::PathNormalizationResult::Action::Accept);
+  EXPECT_EQ(headers.getPathValue(), "/dir1/A?q=/../");
+}
+
 } // namespace EnvoyDefault
 } // namespace HeaderValidators
 } // namespace Http
@@ -7,6 +7,7 @@
 #include "source/extensions/io_socket/user_space/io_handle_impl.h"
 
 #include "test/mocks/event/mocks.h"
+#include "test/test_common/test_runtime.h"
 
 #include "absl/container/fixed_array.h"
 #include "gmock/gmock.h"
@@ -683,7 +684,7 @@ TEST_F(IoHandleImplTest, ReadAndWriteAreEdgeTriggered) {
   schedulable_cb->invokeCallback();
 
   Buffer::OwnedImpl buf("abcd");
-  EXPECT_CALL(*schedulable_cb, scheduleCallbackNextIteration());
+  EXPECT_CALL(*schedulable_cb, scheduleCallbackCurrentIteration());
   io_handle_peer_->write(buf);
 
   EXPECT_CALL(cb_, called(Event::FileReadyType::Read));
@@ -698,6 +699,31 @@ TEST_F(IoHandleImplTest, ReadAndWriteAreEdgeTriggered) {
   io_handle_->resetFileEvents();
 }
 
+// Test that the events written by the peer are delivered in the next iteration when this is
+// disabled at runtime.
+TEST_F(IoHandleImplTest, PeerEventsInNextIteration) {
+  TestScopedRuntime scoped_runtime;
+  scoped_runtime.mergeValues(
+      {{"envoy.reloadable_features.user_space_peer_events_in_current_iteration", "false"}});
+  auto schedulable_cb = new Event::MockSchedulableCallback(&dispatcher_);
+  EXPECT_CALL(*schedulable_cb, enabled());
+  EXPECT_CALL(*schedulable_cb, cancel());
+  io_handle_->initializeFileEvent(
+      dispatcher_,
+      [this](uint32_t events) {
+        cb_.called(events);
+        return absl::OkStatus();
+      },
+      Event::FileTriggerType::Edge, Event::FileReadyType::Read);
+
+  Buffer::OwnedImpl buf("abcd");
+  EXPECT_CALL(*schedulable_cb, scheduleCallbackNextIteration());
+  io_handle_peer_->write(buf);
+  EXPECT_CALL(cb_, called(Event::FileReadyType::Read));
+  schedulable_cb->invokeCallback();
+  io_handle_->resetFileEvents();
+}
+
 TEST_F(IoHandleImplTest, SetDisabledBlockEventSchedule) {
   auto schedulable_cb = new Event::MockSchedulableCallback(&dispatcher_);
   EXPECT_CALL(*schedulable_cb, enabled());
@@ -769,7 +795,7 @@ TEST_F(IoHandleImplTest, DrainToLowWaterMarkTriggerReadEvent) {
   }
   {
     SCOPED_TRACE("drain to low watermark.");
-    EXPECT_CALL(*schedulable_cb, scheduleCallbackNextIteration());
+    EXPECT_CALL(*schedulable_cb, scheduleCallbackCurrentIteration());
     auto result = io_handle_->recv(buf_.data(), 232, 0);
     EXPECT_TRUE(io_handle_->isWritable());
     EXPECT_CALL(cb_, called(Event::FileReadyType::Write));
@@ -777,7 +803,7 @@ TEST_F(IoHandleImplTest, DrainToLowWaterMarkTriggerReadEvent) {
   }
   {
     SCOPED_TRACE("clean up.");
-    EXPECT_CALL(*schedulable_cb, scheduleCallbackNextIteration());
+    EXPECT_CALL(*schedulable_cb, scheduleCallbackCurrentIteration());
     // Important: close before peer.
     io_handle_->close();
   }
@@ -829,7 +855,7 @@ TEST_F(IoHandleImplTest, Close) {
   // Not closed yet.
   ASSERT_FALSE(should_close);
 
-  EXPECT_CALL(*schedulable_cb_, scheduleCallbackNextIteration());
+  EXPECT_CALL(*schedulable_cb_, scheduleCallbackCurrentIteration());
   io_handle_peer_->close();
 
   ASSERT_TRUE(schedulable_cb_->enabled());
@@ -874,7 +900,7 @@ TEST_F(IoHandleImplTest, ShutDownRaiseEvent) {
   // Not closed yet.
   ASSERT_FALSE(should_close);
 
-  EXPECT_CALL(*schedulable_cb_, scheduleCallbackNextIteration());
+  EXPECT_CALL(*schedulable_cb_, scheduleCallbackCurrentIteration());
   io_handle_peer_->shutdown(ENVOY_SHUT_WR);
 
   ASSERT_TRUE(schedulable_cb_->enabled());
@@ -914,7 +940,7 @@ TEST_F(IoHandleImplTest, WriteScheduleWritableEvent) {
   EXPECT_FALSE(schedulable_cb_->enabled());
 
   Buffer::OwnedImpl data_to_write("0123456789");
-  EXPECT_CALL(*schedulable_cb_, scheduleCallbackNextIteration());
+  EXPECT_CALL(*schedulable_cb_, scheduleCallbackCurrentIteration());
   io_handle_peer_->write(data_to_write);
   EXPECT_EQ(0, data_to_write.length());
 
@@ -956,7 +982,7 @@ TEST_F(IoHandleImplTest, WritevScheduleWritableEvent) {
 
   std::string raw_data("0123456789");
   Buffer::RawSlice slice{static_cast<void*>(raw_data.data()), raw_data.size()};
-  EXPECT_CALL(*schedulable_cb_, scheduleCallbackNextIteration());
+  EXPECT_CALL(*schedulable_cb_, scheduleCallbackCurrentIteration());
   io_handle_peer_->writev(&slice, 1);
 
   EXPECT_TRUE(schedulable_cb_->enabled());
@@ -1001,7 +1027,7 @@ TEST_F(IoHandleImplTest, ReadAfterShutdownWrite) {
   EXPECT_FALSE(schedulable_cb_->enabled());
   std::string raw_data("0123456789");
   Buffer::RawSlice slice{static_cast<void*>(raw_data.data()), raw_data.size()};
-  EXPECT_CALL(*schedulable_cb_, scheduleCallbackNextIteration());
+  EXPECT_CALL(*schedulable_cb_, scheduleCallbackCurrentIteration());
   io_handle_->writev(&slice, 1);
   EXPECT_TRUE(schedulable_cb_->enabled());
 
@@ -1009,7 +1035,7 @@ TEST_F(IoHandleImplTest, ReadAfterShutdownWrite) {
   EXPECT_FALSE(schedulable_cb_->enabled());
   EXPECT_EQ(raw_data, accumulator);
 
-  EXPECT_CALL(*schedulable_cb_, scheduleCallbackNextIteration());
+  EXPECT_CALL(*schedulable_cb_, scheduleCallbackCurrentIteration());
   io_handle_->close();
   io_handle_->resetFileEvents();
 }
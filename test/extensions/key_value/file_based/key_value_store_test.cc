@@ -9,6 +9,7 @@
 #include "test/test_common/file_system_for_test.h"
 #include "test/test_common/simulated_time_system.h"
 
+#include "absl/strings/match.h"
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 
@@ -165,6 +166,53 @@ TEST_F(KeyValueStoreTest, PersistWithTTL) {
   EXPECT_EQ(absl::nullopt, store_->get("foo"));
 }
 
+// Test that each flush appends the changes since the previous one to the file.
+TEST_F(KeyValueStoreTest, PersistAppendsChanges) {
+  test_time_.setSystemTime(std::chrono::milliseconds(0));
+  store_->addOrUpdate("foo", "a", absl::nullopt);
+  store_->addOrUpdate("bar", "b", std::chrono::seconds(5));
+  flush_timer_->invokeCallback();
+  EXPECT_EQ("3\nfoo1\na3\nbar1\nbTTL1\n5", TestEnvironment::readFileToStringForTest(filename_));
+
+  store_->addOrUpdate("foo", "c", absl::nullopt);
+  store_->remove("bar");
+  store_->remove("baz");
+  flush_timer_->invokeCallback();
+  EXPECT_EQ("3\nfoo1\na3\nbar1\nbTTL1\n53\nfoo1\nc3\nbar0\nTTL1\n0",
+            TestEnvironment::readFileToStringForTest(filename_));
+  // Nothing changed since the previous flush.
+  flush_timer_->invokeCallback();
+  EXPECT_EQ("3\nfoo1\na3\nbar1\nbTTL1\n53\nfoo1\nc3\nbar0\nTTL1\n0",
+            TestEnvironment::readFileToStringForTest(filename_));
+
+  createStore();
+  EXPECT_EQ("c", store_->get("foo").value());
+  EXPECT_EQ(absl::nullopt, store_->get("bar"));
+}
+
+// Test that the file is rewritten with the store only once it holds too many outdated entries.
+TEST_F(KeyValueStoreTest, PersistCompacts) {
+  flush_interval_ = std::chrono::seconds(0);
+  createStore();
+  store_->addOrUpdate("foo", "bar", absl::nullopt);
+  // The file holds 2 entries for the store, and up to 129 outdated ones.
+  for (int i = 1; i <= 130; ++i) {
+    store_->addOrUpdate("key", absl::StrCat(i), absl::nullopt);
+  }
+  EXPECT_TRUE(absl::StartsWith(TestEnvironment::readFileToStringForTest(filename_),
+                               "3\nfoo3\nbar3\nkey1\n13\nkey1\n2"));
+  store_->addOrUpdate("key", "131", absl::nullopt);
+  EXPECT_EQ("3\nfoo3\nbar3\nkey3\n131", TestEnvironment::readFileToStringForTest(filename_));
+
+  // The entries parsed from the file count towards the next compaction.
+  createStore();
+  EXPECT_EQ("bar", store_->get("foo").value());
+  EXPECT_EQ("131", store_->get("key").value());
+  store_->remove("foo");
+  EXPECT_EQ("3\nfoo3\nbar3\nkey3\n1313\nfoo0\nTTL1\n0",
+            TestEnvironment::readFileToStringForTest(filename_));
+}
+
 TEST_F(KeyValueStoreTest, Iterate) {
   store_->addOrUpdate("foo", "bar", absl::nullopt);
   store_->addOrUpdate("baz", "eep", absl::nullopt);
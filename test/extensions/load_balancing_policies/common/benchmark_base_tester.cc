@@ -4,37 +4,58 @@ namespace Envoy {
 namespace Upstream {
 
 BaseTester::BaseTester(uint64_t num_hosts, uint32_t weighted_subset_percent, uint32_t weight,
-                       bool attach_metadata) {
-  Upstream::HostVector hosts;
-  ASSERT(num_hosts < 65536);
+                       bool attach_metadata)
+    : attach_metadata_(attach_metadata) {
+  ASSERT(num_hosts < (1 << 24));
   for (uint64_t i = 0; i < num_hosts; i++) {
     const bool should_weight = i < num_hosts * (weighted_subset_percent / 100.0);
-    const std::string url = fmt::format("tcp://10.0.{}.{}:6379", i / 256, i % 256);
-    const auto effective_weight = should_weight ? weight : 1;
-    if (attach_metadata) {
-      envoy::config::core::v3::Metadata metadata;
-      ProtobufWkt::Value value;
-      value.set_number_value(i);
-      ProtobufWkt::Struct& map =
-          (*metadata.mutable_filter_metadata())[Config::MetadataFilters::get().ENVOY_LB];
-      (*map.mutable_fields())[std::string(metadata_key)] = value;
-
-      hosts.push_back(Upstream::makeTestHost(info_, url, metadata, simTime(), effective_weight));
-    } else {
-      hosts.push_back(Upstream::makeTestHost(info_, url, simTime(), effective_weight));
-    }
+    hosts_.push_back(makeHost(should_weight ? weight : 1));
   }
 
-  Upstream::HostVectorConstSharedPtr updated_hosts = std::make_shared<Upstream::HostVector>(hosts);
+  Upstream::HostVectorConstSharedPtr updated_hosts = std::make_shared<Upstream::HostVector>(hosts_);
   Upstream::HostsPerLocalityConstSharedPtr hosts_per_locality =
-      Upstream::makeHostsPerLocality({hosts});
+      Upstream::makeHostsPerLocality({hosts_});
   priority_set_.updateHosts(
-      0, Upstream::HostSetImpl::partitionHosts(updated_hosts, hosts_per_locality), {}, hosts, {},
+      0, Upstream::HostSetImpl::partitionHosts(updated_hosts, hosts_per_locality), {}, hosts_, {},
       random_.random(), absl::nullopt);
   local_priority_set_.updateHosts(
-      0, Upstream::HostSetImpl::partitionHosts(updated_hosts, hosts_per_locality), {}, hosts, {},
+      0, Upstream::HostSetImpl::partitionHosts(updated_hosts, hosts_per_locality), {}, hosts_, {},
       random_.random(), absl::nullopt);
 }
 
+void BaseTester::replaceHosts(uint64_t churn_percent) {
+  Upstream::HostVector hosts_added;
+  Upstream::HostVector hosts_removed;
+  const uint64_t replaced = hosts_.size() * churn_percent / 100;
+  for (uint64_t i = 0; i < replaced; i++) {
+    const uint64_t index = next_replaced_++ % hosts_.size();
+    hosts_removed.push_back(hosts_[index]);
+    hosts_[index] = makeHost(hosts_[index]->weight());
+    hosts_added.push_back(hosts_[index]);
+  }
+  priority_set_.updateHosts(
+      0,
+      Upstream::HostSetImpl::partitionHosts(std::make_shared<Upstream::HostVector>(hosts_),
+                                            Upstream::makeHostsPerLocality({hosts_})),
+      {}, hosts_added, hosts_removed, random_.random(), absl::nullopt);
+}
+
+Upstream::HostSharedPtr BaseTester::makeHost(uint32_t weight) {
+  const uint64_t i = next_host_++;
+  const std::string url =
+      fmt::format("tcp://10.{}.{}.{}:6379", (i >> 16) & 0xff, (i >> 8) & 0xff, i & 0xff);
+  if (attach_metadata_) {
+    envoy::config::core::v3::Metadata metadata;
+    ProtobufWkt::Value value;
+    value.set_number_value(i);
+    ProtobufWkt::Struct& map =
+        (*metadata.mutable_filter_metadata())[Config::MetadataFilters::get().ENVOY_LB];
+    (*map.mutable_fields())[std::string(metadata_key)] = value;
+
+    return Upstream::makeTestHost(info_, url, metadata, simTime(), weight);
+  }
+  return Upstream::makeTestHost(info_, url, simTime(), weight);
+}
+
 } // namespace Upstream
 } // namespace Envoy
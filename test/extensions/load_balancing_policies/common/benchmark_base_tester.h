@@ -25,6 +25,10 @@ public:
   BaseTester(uint64_t num_hosts, uint32_t weighted_subset_percent = 0, uint32_t weight = 0,
              bool attach_metadata = false);
 
+  // Replaces churn_percent of the hosts with new ones of the same weight, as an EDS update would,
+  // and updates the priority set. Consecutive calls replace different hosts.
+  void replaceHosts(uint64_t churn_percent);
+
   Envoy::Thread::MutexBasicLockable lock_;
   // Reduce default log level to warn while running this benchmark to avoid problems due to
   // excessive debug logging in upstream_impl.cc
@@ -46,6 +50,14 @@ public:
   envoy::config::cluster::v3::Cluster::CommonLbConfig common_config_;
   envoy::config::cluster::v3::Cluster::RoundRobinLbConfig round_robin_lb_config_;
   std::shared_ptr<Upstream::MockClusterInfo> info_{new NiceMock<Upstream::MockClusterInfo>()};
+
+private:
+  Upstream::HostSharedPtr makeHost(uint32_t weight);
+
+  const bool attach_metadata_;
+  Upstream::HostVector hosts_;
+  uint64_t next_host_ = 0;
+  uint64_t next_replaced_ = 0;
 };
 
 class TestLoadBalancerContext : public Upstream::LoadBalancerContextBase {
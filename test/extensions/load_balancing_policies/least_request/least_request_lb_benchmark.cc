@@ -1,3 +1,7 @@
+#include <atomic>
+#include <thread>
+#include <vector>
+
 #include "source/extensions/load_balancing_policies/least_request/least_request_lb.h"
 
 #include "test/benchmark/main.h"
@@ -62,6 +66,53 @@ BENCHMARK(benchmarkLeastRequestLoadBalancerChooseHost)
     ->Args({100, 100, 1000000})
     ->Unit(::benchmark::kMillisecond);
 
+// Picks hosts while other threads start and finish requests on them, as the workers do, to
+// measure the cost of sharing the cache lines of the host stats.
+void benchmarkLeastRequestLoadBalancerChooseHostContended(::benchmark::State& state) {
+  const uint64_t num_hosts = state.range(0);
+  const uint64_t choice_count = state.range(1);
+  const uint64_t num_threads = state.range(2);
+  const uint64_t keys_to_simulate = 100000;
+
+  for (auto _ : state) { // NOLINT: Silences warning about dead store
+    state.PauseTiming();
+    LeastRequestTester tester(num_hosts, choice_count);
+    const HostVector& hosts = tester.priority_set_.hostSetsPerPriority()[0]->hosts();
+    std::atomic<bool> done{false};
+    std::vector<std::thread> threads;
+    for (uint64_t i = 0; i < num_threads; ++i) {
+      threads.emplace_back([&hosts, &done, i]() {
+        for (uint64_t j = i; !done.load(std::memory_order_relaxed); ++j) {
+          HostStats& stats = hosts[j % hosts.size()]->stats();
+          stats.rq_total_.inc();
+          stats.rq_active_.inc();
+          stats.rq_success_.inc();
+          stats.rq_active_.dec();
+        }
+      });
+    }
+    TestLoadBalancerContext context;
+    state.ResumeTiming();
+
+    for (uint64_t i = 0; i < keys_to_simulate; ++i) {
+      ::benchmark::DoNotOptimize(tester.lb_->chooseHost(&context));
+    }
+
+    state.PauseTiming();
+    done = true;
+    for (std::thread& thread : threads) {
+      thread.join();
+    }
+    state.ResumeTiming();
+  }
+}
+BENCHMARK(benchmarkLeastRequestLoadBalancerChooseHostContended)
+    ->Args({100, 2, 0})
+    ->Args({100, 2, 1})
+    ->Args({100, 2, 3})
+    ->Args({100, 2, 7})
+    ->Unit(::benchmark::kMillisecond);
+
 } // namespace
 } // namespace Upstream
 } // namespace Envoy
@@ -264,6 +264,34 @@ TEST_P(LeastRequestLoadBalancerTest, WeightImbalance) {
   EXPECT_EQ(hostSet().healthy_hosts_[0], lb_.chooseHost(nullptr));
 }
 
+TEST_P(LeastRequestLoadBalancerTest, WeightImbalanceWithAliasTableScheduler) {
+  hostSet().healthy_hosts_ = {makeTestHost(info_, "tcp://127.0.0.1:80", simTime(), 1),
+                              makeTestHost(info_, "tcp://127.0.0.1:81", simTime(), 2)};
+  hostSet().hosts_ = hostSet().healthy_hosts_;
+
+  envoy::extensions::load_balancing_policies::least_request::v3::LeastRequest lr_lb_config;
+  lr_lb_config.mutable_weighted_scheduler_config()->set_scheduler_type(
+      envoy::extensions::load_balancing_policies::common::v3::WeightedSchedulerConfig::
+          ALIAS_TABLE);
+  LeastRequestLoadBalancer lb{priority_set_, nullptr, stats_,       runtime_,
+                              random_,       1,       lr_lb_config, simTime()};
+
+  // We should see 2:1 ratio for hosts[1] to hosts[0].
+  uint32_t host_1_counts = 0;
+  for (uint32_t i = 0; i < 3000; ++i) {
+    host_1_counts += lb.chooseHost(nullptr) == hostSet().healthy_hosts_[1];
+  }
+  EXPECT_NEAR(2000, host_1_counts, 10);
+
+  // Bringing hosts[1] to an active request should yield a 1:1 ratio.
+  hostSet().healthy_hosts_[1]->stats().rq_active_.set(1);
+  host_1_counts = 0;
+  for (uint32_t i = 0; i < 2000; ++i) {
+    host_1_counts += lb.chooseHost(nullptr) == hostSet().healthy_hosts_[1];
+  }
+  EXPECT_NEAR(1000, host_1_counts, 10);
+}
+
 // Validate that the load balancer defaults to an active request bias value of 1.0 if the runtime
 // value is invalid (less than 0.0).
 TEST_P(LeastRequestLoadBalancerTest, WeightImbalanceWithInvalidActiveRequestBias) {
@@ -9,8 +9,12 @@ namespace {
 
 class MaglevTester : public BaseTester {
 public:
-  MaglevTester(uint64_t num_hosts, uint32_t weighted_subset_percent = 0, uint32_t weight = 0)
+  MaglevTester(uint64_t num_hosts, uint32_t weighted_subset_percent = 0, uint32_t weight = 0,
+               uint64_t table_size = 0)
       : BaseTester(num_hosts, weighted_subset_percent, weight) {
+    if (table_size != 0) {
+      config_.emplace().mutable_table_size()->set_value(table_size);
+    }
     maglev_lb_ = std::make_unique<MaglevLoadBalancer>(
         priority_set_, stats_, stats_scope_, runtime_, random_,
         config_.has_value()
@@ -184,6 +188,36 @@ BENCHMARK(benchmarkMaglevLoadBalancerWeighted)
     ->Args({500, 95, 75, 25, 10000})
     ->Unit(::benchmark::kMillisecond);
 
+// The time of the updates includes the one of the priority set, which the priority set
+// benchmarks of test/common/upstream measure alone.
+void benchmarkMaglevLoadBalancerReplaceHosts(::benchmark::State& state) {
+  const uint64_t num_hosts = state.range(0);
+  const uint64_t table_size = state.range(1);
+  const uint64_t churn_percent = state.range(2);
+
+  if (benchmark::skipExpensiveBenchmarks() && num_hosts > 10000) {
+    state.SkipWithError("Skipping expensive benchmark");
+    return;
+  }
+
+  MaglevTester tester(num_hosts, 0, 0, table_size);
+  ASSERT_TRUE(tester.maglev_lb_->initialize().ok());
+  for (auto _ : state) { // NOLINT: Silences warning about dead store
+    // The table is built again for each update.
+    tester.replaceHosts(churn_percent);
+  }
+}
+// The arguments are the number of hosts, the size of the table, which has to be a prime larger
+// than the number of hosts, and the percentage of replaced hosts.
+BENCHMARK(benchmarkMaglevLoadBalancerReplaceHosts)
+    ->Args({1000, 65537, 1})
+    ->Args({1000, 65537, 10})
+    ->Args({10000, 65537, 1})
+    ->Args({10000, 65537, 10})
+    ->Args({100000, 1000003, 1})
+    ->Args({100000, 1000003, 10})
+    ->Unit(::benchmark::kMillisecond);
+
 } // namespace
 } // namespace Upstream
 } // namespace Envoy
@@ -0,0 +1,77 @@
+#include "envoy/config/core/v3/extension.pb.h"
+
+#include "source/extensions/load_balancing_policies/peak_ewma/config.h"
+
+#include "test/common/upstream/utility.h"
+#include "test/mocks/server/factory_context.h"
+#include "test/mocks/upstream/cluster_info.h"
+#include "test/mocks/upstream/priority_set.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace LoadBalancingPolices {
+namespace PeakEwma {
+namespace {
+
+TEST(PeakEwmaConfigTest, Create) {
+  NiceMock<Server::Configuration::MockServerFactoryContext> context;
+  NiceMock<Upstream::MockClusterInfo> cluster_info;
+  NiceMock<Upstream::MockPrioritySet> main_thread_priority_set;
+  NiceMock<Upstream::MockPrioritySet> thread_local_priority_set;
+
+  envoy::config::core::v3::TypedExtensionConfig config;
+  config.set_name("envoy.load_balancing_policies.peak_ewma");
+  PeakEwmaLbProto config_msg;
+  config_msg.mutable_choice_count()->set_value(3);
+  config.mutable_typed_config()->PackFrom(config_msg);
+
+  auto& factory = Config::Utility::getAndCheckFactory<Upstream::TypedLoadBalancerFactory>(config);
+  EXPECT_EQ("envoy.load_balancing_policies.peak_ewma", factory.name());
+
+  auto lb_config = factory.loadConfig(config_msg, context.messageValidationVisitor());
+  auto thread_aware_lb =
+      factory.create(*lb_config, cluster_info, main_thread_priority_set, context.runtime_loader_,
+                     context.api_.random_, context.time_system_);
+  EXPECT_NE(nullptr, thread_aware_lb);
+
+  ASSERT_TRUE(thread_aware_lb->initialize().ok());
+
+  auto thread_local_lb_factory = thread_aware_lb->factory();
+  EXPECT_NE(nullptr, thread_local_lb_factory);
+  EXPECT_FALSE(thread_local_lb_factory->recreateOnHostChange());
+
+  auto thread_local_lb = thread_local_lb_factory->create({thread_local_priority_set, nullptr});
+  EXPECT_NE(nullptr, thread_local_lb);
+}
+
+// Test that the hosts of the cluster, including the ones added later, get the data of the policy.
+TEST(PeakEwmaConfigTest, AttachesHostData) {
+  NiceMock<Server::Configuration::MockServerFactoryContext> context;
+  NiceMock<Upstream::MockClusterInfo> cluster_info;
+  NiceMock<Upstream::MockPrioritySet> priority_set;
+  auto info = std::make_shared<NiceMock<Upstream::MockClusterInfo>>();
+  auto* host_set = priority_set.getMockHostSet(0);
+  host_set->hosts_ = {Upstream::makeTestHost(info, "tcp://127.0.0.1:80", context.time_system_)};
+
+  Factory factory;
+  auto lb_config = factory.loadConfig(PeakEwmaLbProto(), context.messageValidationVisitor());
+  auto thread_aware_lb =
+      factory.create(*lb_config, cluster_info, priority_set, context.runtime_loader_,
+                     context.api_.random_, context.time_system_);
+  ASSERT_TRUE(thread_aware_lb->initialize().ok());
+  EXPECT_NE(nullptr, host_set->hosts_[0]->lbPolicyData());
+
+  const Upstream::HostVector hosts_added = {
+      Upstream::makeTestHost(info, "tcp://127.0.0.1:81", context.time_system_)};
+  host_set->hosts_.push_back(hosts_added[0]);
+  host_set->runCallbacks(hosts_added, {});
+  EXPECT_NE(nullptr, hosts_added[0]->lbPolicyData());
+}
+
+} // namespace
+} // namespace PeakEwma
+} // namespace LoadBalancingPolices
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,172 @@
+#include <chrono>
+#include <cmath>
+#include <thread>
+
+#include "source/extensions/load_balancing_policies/peak_ewma/peak_ewma_lb.h"
+
+#include "test/extensions/load_balancing_policies/common/load_balancer_impl_base_test.h"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Upstream {
+namespace {
+
+using testing::Return;
+
+class PeakEwmaLoadBalancerTest : public LoadBalancerTestBase {
+public:
+  void setHosts(const HostVector& hosts) {
+    hostSet().healthy_hosts_ = hosts;
+    hostSet().hosts_ = hosts;
+    hosts_->attach(hosts);
+    hostSet().runCallbacks({}, {}); // Trigger callbacks. The added/removed lists are not relevant.
+  }
+
+  static void respond(const HostSharedPtr& host, std::chrono::microseconds response_time) {
+    host->lbPolicyData()->onResponseTime(response_time);
+  }
+
+  PeakEwmaHostsSharedPtr hosts_{std::make_shared<PeakEwmaHosts>()};
+  PeakEwmaLbProto config_;
+  PeakEwmaLoadBalancer lb_{priority_set_, nullptr, stats_, runtime_, random_, 50, config_, hosts_,
+                           simTime()};
+};
+
+TEST_P(PeakEwmaLoadBalancerTest, NoHosts) { EXPECT_EQ(nullptr, lb_.chooseHost(nullptr)); }
+
+TEST_P(PeakEwmaLoadBalancerTest, NoPeek) {
+  setHosts({makeTestHost(info_, "tcp://127.0.0.1:80", simTime())});
+  EXPECT_EQ(nullptr, lb_.peekAnotherHost(nullptr));
+}
+
+// Test that the host of the lower latency is chosen out of the random hosts.
+TEST_P(PeakEwmaLoadBalancerTest, ChoosesLowerLatency) {
+  setHosts({makeTestHost(info_, "tcp://127.0.0.1:80", simTime()),
+            makeTestHost(info_, "tcp://127.0.0.1:81", simTime())});
+  respond(hostSet().healthy_hosts_[0], std::chrono::microseconds(1000));
+  respond(hostSet().healthy_hosts_[1], std::chrono::microseconds(100));
+
+  EXPECT_CALL(random_, random()).WillOnce(Return(0)).WillOnce(Return(0)).WillOnce(Return(1));
+  EXPECT_EQ(hostSet().healthy_hosts_[1], lb_.chooseHost(nullptr));
+  EXPECT_CALL(random_, random()).WillOnce(Return(0)).WillOnce(Return(1)).WillOnce(Return(0));
+  EXPECT_EQ(hostSet().healthy_hosts_[1], lb_.chooseHost(nullptr));
+  // The same host twice.
+  EXPECT_CALL(random_, random()).WillOnce(Return(0)).WillOnce(Return(0)).WillOnce(Return(0));
+  EXPECT_EQ(hostSet().healthy_hosts_[0], lb_.chooseHost(nullptr));
+}
+
+// Test that the latency of a host is multiplied by its active requests plus one.
+TEST_P(PeakEwmaLoadBalancerTest, WeighsActiveRequests) {
+  setHosts({makeTestHost(info_, "tcp://127.0.0.1:80", simTime()),
+            makeTestHost(info_, "tcp://127.0.0.1:81", simTime())});
+  respond(hostSet().healthy_hosts_[0], std::chrono::microseconds(1000));
+  respond(hostSet().healthy_hosts_[1], std::chrono::microseconds(100));
+  hostSet().healthy_hosts_[1]->stats().rq_active_.set(10);
+
+  EXPECT_CALL(random_, random()).WillOnce(Return(0)).WillOnce(Return(0)).WillOnce(Return(1));
+  EXPECT_EQ(hostSet().healthy_hosts_[0], lb_.chooseHost(nullptr));
+  hostSet().healthy_hosts_[1]->stats().rq_active_.set(8);
+  EXPECT_CALL(random_, random()).WillOnce(Return(0)).WillOnce(Return(0)).WillOnce(Return(1));
+  EXPECT_EQ(hostSet().healthy_hosts_[1], lb_.chooseHost(nullptr));
+}
+
+// Test that a host without a response yet gets a request while it has none active, and none
+// otherwise.
+TEST_P(PeakEwmaLoadBalancerTest, ProbesUnsampledHost) {
+  setHosts({makeTestHost(info_, "tcp://127.0.0.1:80", simTime()),
+            makeTestHost(info_, "tcp://127.0.0.1:81", simTime())});
+  respond(hostSet().healthy_hosts_[0], std::chrono::microseconds(100));
+
+  EXPECT_CALL(random_, random()).WillOnce(Return(0)).WillOnce(Return(0)).WillOnce(Return(1));
+  EXPECT_EQ(hostSet().healthy_hosts_[1], lb_.chooseHost(nullptr));
+  hostSet().healthy_hosts_[1]->stats().rq_active_.set(1);
+  EXPECT_CALL(random_, random()).WillOnce(Return(0)).WillOnce(Return(1)).WillOnce(Return(0));
+  EXPECT_EQ(hostSet().healthy_hosts_[0], lb_.chooseHost(nullptr));
+}
+
+// Test that the responses on the threads without a load balancer of the cluster are ignored.
+TEST_P(PeakEwmaLoadBalancerTest, IgnoresOtherThreads) {
+  setHosts({makeTestHost(info_, "tcp://127.0.0.1:80", simTime()),
+            makeTestHost(info_, "tcp://127.0.0.1:81", simTime())});
+  respond(hostSet().healthy_hosts_[0], std::chrono::microseconds(100));
+  std::thread([this] {
+    respond(hostSet().healthy_hosts_[0], std::chrono::microseconds(100000));
+  }).join();
+  respond(hostSet().healthy_hosts_[1], std::chrono::microseconds(1000));
+
+  EXPECT_CALL(random_, random()).WillOnce(Return(0)).WillOnce(Return(1)).WillOnce(Return(0));
+  EXPECT_EQ(hostSet().healthy_hosts_[0], lb_.chooseHost(nullptr));
+}
+
+INSTANTIATE_TEST_SUITE_P(PrimaryOrFailover, PeakEwmaLoadBalancerTest,
+                         ::testing::Values(LoadBalancerTestParam{true},
+                                           LoadBalancerTestParam{false}));
+
+class PeakEwmaWorkerTableTest : public Event::TestUsingSimulatedTime, public testing::Test {
+public:
+  PeakEwmaWorkerTableTest() { hosts_->attach({host_}); }
+
+  const PeakEwmaHostData& data() const {
+    return dynamic_cast<const PeakEwmaHostData&>(*host_->lbPolicyData());
+  }
+
+  std::shared_ptr<MockClusterInfo> info_{new NiceMock<MockClusterInfo>()};
+  PeakEwmaHostsSharedPtr hosts_{std::make_shared<PeakEwmaHosts>()};
+  HostSharedPtr host_{makeTestHost(info_, "tcp://127.0.0.1:80", simTime())};
+};
+
+// Test that a slower response replaces the latency, and that the faster ones bring it down
+// progressively.
+TEST_F(PeakEwmaWorkerTableTest, Peak) {
+  PeakEwmaWorkerTable table(std::chrono::seconds(10), absl::nullopt, simTime());
+  EXPECT_FALSE(table.latency(data()).has_value());
+
+  table.update(data(), std::chrono::microseconds(100));
+  EXPECT_DOUBLE_EQ(100, table.latency(data()).value());
+  table.update(data(), std::chrono::microseconds(1000));
+  EXPECT_DOUBLE_EQ(1000, table.latency(data()).value());
+
+  // A response right after the previous one weighs nothing.
+  table.update(data(), std::chrono::microseconds(0));
+  EXPECT_DOUBLE_EQ(1000, table.latency(data()).value());
+
+  simTime().advanceTimeWait(std::chrono::seconds(10));
+  table.update(data(), std::chrono::microseconds(0));
+  EXPECT_NEAR(1000 * std::exp(-1.0), table.latency(data()).value(), 0.001);
+}
+
+// Test that the latency of a host without responses decays.
+TEST_F(PeakEwmaWorkerTableTest, Decay) {
+  PeakEwmaWorkerTable table(std::chrono::seconds(10), absl::nullopt, simTime());
+  table.update(data(), std::chrono::microseconds(1000));
+  simTime().advanceTimeWait(std::chrono::seconds(20));
+  EXPECT_NEAR(1000 * std::exp(-2.0), table.latency(data()).value(), 0.001);
+}
+
+// Test that the outlier responses are capped at the ratio of the latency.
+TEST_F(PeakEwmaWorkerTableTest, MaxResponseTimeRatio) {
+  PeakEwmaWorkerTable table(std::chrono::seconds(10), 2.0, simTime());
+  table.update(data(), std::chrono::microseconds(100));
+  table.update(data(), std::chrono::microseconds(10000));
+  EXPECT_DOUBLE_EQ(200, table.latency(data()).value());
+  table.update(data(), std::chrono::microseconds(300));
+  EXPECT_DOUBLE_EQ(300, table.latency(data()).value());
+}
+
+// Test that a new host reusing the index of a destroyed one doesn't get its latency.
+TEST_F(PeakEwmaWorkerTableTest, ReusedIndex) {
+  PeakEwmaWorkerTable table(std::chrono::seconds(10), absl::nullopt, simTime());
+  table.update(data(), std::chrono::microseconds(100));
+  const uint32_t index = data().index_;
+
+  host_ = makeTestHost(info_, "tcp://127.0.0.1:81", simTime());
+  hosts_->attach({host_});
+  EXPECT_EQ(index, data().index_);
+  EXPECT_FALSE(table.latency(data()).has_value());
+}
+
+} // namespace
+} // namespace Upstream
+} // namespace Envoy
@@ -146,6 +146,31 @@ BENCHMARK(benchmarkRingHashLoadBalancerHostLoss)
     ->Args({500, 256000, 3, 10000})
     ->Unit(::benchmark::kMillisecond);
 
+// The time of the updates includes the one of the priority set, which the priority set
+// benchmarks of test/common/upstream measure alone.
+void benchmarkRingHashLoadBalancerReplaceHosts(::benchmark::State& state) {
+  const uint64_t num_hosts = state.range(0);
+  const uint64_t min_ring_size = state.range(1);
+  const uint64_t churn_percent = state.range(2);
+
+  if (benchmark::skipExpensiveBenchmarks() && num_hosts > 10000) {
+    state.SkipWithError("Skipping expensive benchmark");
+    return;
+  }
+
+  RingHashTester tester(num_hosts, min_ring_size);
+  ASSERT_TRUE(tester.ring_hash_lb_->initialize().ok());
+  for (auto _ : state) { // NOLINT: Silences warning about dead store
+    // The ring is built again for each update.
+    tester.replaceHosts(churn_percent);
+  }
+}
+// The arguments are the number of hosts, the minimum size of the ring and the percentage of
+// replaced hosts.
+BENCHMARK(benchmarkRingHashLoadBalancerReplaceHosts)
+    ->ArgsProduct({{1000, 10000, 100000}, {1024, 65536}, {1, 10}})
+    ->Unit(::benchmark::kMillisecond);
+
 } // namespace
 } // namespace Upstream
 } // namespace Envoy
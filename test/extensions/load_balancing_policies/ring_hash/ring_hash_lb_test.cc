@@ -588,6 +588,42 @@ TEST_P(RingHashLoadBalancerTest, UnevenHosts) {
   }
 }
 
+// The ring built from the previous ring on a host update is the same as a ring built from scratch.
+TEST_P(RingHashLoadBalancerTest, UpdatedRingMatchesNewRing) {
+  for (uint32_t i = 0; i < 10; ++i) {
+    hostSet().hosts_.push_back(
+        makeTestHost(info_, fmt::format("tcp://127.0.0.1:{}", 90 + i), simTime()));
+  }
+  hostSet().healthy_hosts_ = hostSet().hosts_;
+  hostSet().runCallbacks({}, {});
+
+  config_ = envoy::config::cluster::v3::Cluster::RingHashLbConfig();
+  config_.value().mutable_minimum_ring_size()->set_value(1000);
+  init();
+
+  // Remove a host, add another one and change the weight of a third one.
+  HostVector removed{hostSet().hosts_[3]};
+  hostSet().hosts_.erase(hostSet().hosts_.begin() + 3);
+  HostVector added{makeTestHost(info_, "tcp://127.0.0.1:100", simTime())};
+  hostSet().hosts_.push_back(added[0]);
+  hostSet().hosts_[5]->weight(3);
+  hostSet().healthy_hosts_ = hostSet().hosts_;
+  hostSet().runCallbacks(added, removed);
+  LoadBalancerPtr lb = lb_->factory()->create(lb_params_);
+
+  RingHashLoadBalancer new_lb(
+      priority_set_, stats_, *stats_store_.rootScope(), runtime_, random_,
+      makeOptRef<const envoy::config::cluster::v3::Cluster::RingHashLbConfig>(config_.value()),
+      common_config_);
+  EXPECT_TRUE(new_lb.initialize().ok());
+  LoadBalancerPtr expected_lb = new_lb.factory()->create(lb_params_);
+
+  for (uint64_t i = 0; i < 10000; ++i) {
+    TestLoadBalancerContext context(i * (std::numeric_limits<uint64_t>::max() / 10000));
+    EXPECT_EQ(expected_lb->chooseHost(&context), lb->chooseHost(&context));
+  }
+}
+
 // Given hosts with weights 1, 2 and 3, and a ring size of exactly 6, expect the correct number of
 // hashes for each host.
 TEST_P(RingHashLoadBalancerTest, HostWeightedTinyRing) {
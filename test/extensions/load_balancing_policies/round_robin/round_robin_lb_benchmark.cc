@@ -68,6 +68,30 @@ BENCHMARK(benchmarkRoundRobinLoadBalancerBuild)
     ->Args({50000, 100, 50})
     ->Unit(::benchmark::kMillisecond);
 
+// The time of the updates includes the one of the priority set, which the priority set
+// benchmarks of test/common/upstream measure alone.
+void benchmarkRoundRobinLoadBalancerReplaceHosts(::benchmark::State& state) {
+  const uint64_t num_hosts = state.range(0);
+  const uint64_t weighted_subset_percent = state.range(1);
+  const uint64_t churn_percent = state.range(2);
+
+  if (benchmark::skipExpensiveBenchmarks() && num_hosts > 10000) {
+    state.SkipWithError("Skipping expensive benchmark");
+    return;
+  }
+
+  RoundRobinTester tester(num_hosts, weighted_subset_percent, 50);
+  tester.initialize();
+  for (auto _ : state) { // NOLINT: Silences warning about dead store
+    tester.replaceHosts(churn_percent);
+  }
+}
+// The arguments are the number of hosts, the percentage of weighted hosts and the percentage of
+// replaced hosts.
+BENCHMARK(benchmarkRoundRobinLoadBalancerReplaceHosts)
+    ->ArgsProduct({{1000, 10000, 100000}, {0, 50}, {1, 10}})
+    ->Unit(::benchmark::kMillisecond);
+
 } // namespace
 } // namespace Upstream
 } // namespace Envoy
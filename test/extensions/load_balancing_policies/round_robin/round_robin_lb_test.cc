@@ -445,6 +445,105 @@ TEST_P(RoundRobinLoadBalancerTest, Weighted) {
   EXPECT_EQ(hostSet().healthy_hosts_[1], lb_->chooseHost(nullptr));
 }
 
+// The weighted scheduler of a locality whose hosts are unchanged by an update is kept, and goes
+// on with its schedule, while the scheduler of the updated locality is rebuilt.
+TEST_P(RoundRobinLoadBalancerTest, WeightedLocalityUnchangedSchedulerKept) {
+  envoy::config::core::v3::Locality zone_a;
+  zone_a.set_zone("A");
+  envoy::config::core::v3::Locality zone_b;
+  zone_b.set_zone("B");
+
+  HostVector hosts({makeTestHost(info_, "tcp://127.0.0.1:80", simTime(), zone_a, 1),
+                    makeTestHost(info_, "tcp://127.0.0.1:81", simTime(), zone_a, 2),
+                    makeTestHost(info_, "tcp://127.0.0.1:82", simTime(), zone_b, 1),
+                    makeTestHost(info_, "tcp://127.0.0.1:83", simTime(), zone_b, 2)});
+  hostSet().hosts_ = hosts;
+  hostSet().healthy_hosts_ = hosts;
+  hostSet().healthy_hosts_per_locality_ =
+      makeHostsPerLocality({{hosts[0], hosts[1]}, {hosts[2], hosts[3]}});
+  init(false, true);
+  EXPECT_CALL(hostSet(), chooseHealthyLocality()).WillOnce(Return(0));
+  EXPECT_EQ(hosts[1], lb_->chooseHost(nullptr));
+
+  // Add a host to the second locality.
+  HostSharedPtr added = makeTestHost(info_, "tcp://127.0.0.1:84", simTime(), zone_b, 3);
+  hostSet().hosts_.push_back(added);
+  hostSet().healthy_hosts_.push_back(added);
+  hostSet().healthy_hosts_per_locality_ =
+      makeHostsPerLocality({{hosts[0], hosts[1]}, {hosts[2], hosts[3], added}});
+  hostSet().runCallbacks({added}, {});
+
+  // The schedule of the first locality is not restarted.
+  EXPECT_CALL(hostSet(), chooseHealthyLocality()).WillOnce(Return(0));
+  EXPECT_EQ(hosts[0], lb_->chooseHost(nullptr));
+  // The added host is picked from the second locality.
+  EXPECT_CALL(hostSet(), chooseHealthyLocality()).WillRepeatedly(Return(1));
+  bool added_picked = false;
+  for (int i = 0; i < 6; ++i) {
+    added_picked |= lb_->chooseHost(nullptr) == added;
+  }
+  EXPECT_TRUE(added_picked);
+}
+
+TEST_P(RoundRobinLoadBalancerTest, WeightedLocalityUnchangedSchedulerRebuiltWhenDisabled) {
+  TestScopedRuntime scoped_runtime;
+  scoped_runtime.mergeValues(
+      {{"envoy.reloadable_features.edf_lb_keep_unchanged_schedulers", "false"}});
+  envoy::config::core::v3::Locality zone_a;
+  zone_a.set_zone("A");
+  envoy::config::core::v3::Locality zone_b;
+  zone_b.set_zone("B");
+
+  HostVector hosts({makeTestHost(info_, "tcp://127.0.0.1:80", simTime(), zone_a, 1),
+                    makeTestHost(info_, "tcp://127.0.0.1:81", simTime(), zone_a, 2),
+                    makeTestHost(info_, "tcp://127.0.0.1:82", simTime(), zone_b, 1)});
+  hostSet().hosts_ = hosts;
+  hostSet().healthy_hosts_ = hosts;
+  hostSet().healthy_hosts_per_locality_ = makeHostsPerLocality({{hosts[0], hosts[1]}, {hosts[2]}});
+  init(false, true);
+  EXPECT_CALL(hostSet(), chooseHealthyLocality()).WillOnce(Return(0));
+  EXPECT_EQ(hosts[1], lb_->chooseHost(nullptr));
+
+  HostSharedPtr added = makeTestHost(info_, "tcp://127.0.0.1:83", simTime(), zone_b, 1);
+  hostSet().hosts_.push_back(added);
+  hostSet().healthy_hosts_.push_back(added);
+  hostSet().healthy_hosts_per_locality_ =
+      makeHostsPerLocality({{hosts[0], hosts[1]}, {hosts[2], added}});
+  hostSet().runCallbacks({added}, {});
+
+  // The schedule of the first locality is restarted.
+  EXPECT_CALL(hostSet(), chooseHealthyLocality()).WillOnce(Return(0));
+  EXPECT_EQ(hosts[1], lb_->chooseHost(nullptr));
+}
+
+TEST_P(RoundRobinLoadBalancerTest, WeightedAliasTableScheduler) {
+  hostSet().healthy_hosts_ = {makeTestHost(info_, "tcp://127.0.0.1:80", simTime(), 1),
+                              makeTestHost(info_, "tcp://127.0.0.1:81", simTime(), 3)};
+  hostSet().hosts_ = hostSet().healthy_hosts_;
+  envoy::extensions::load_balancing_policies::round_robin::v3::RoundRobin round_robin_config;
+  round_robin_config.mutable_weighted_scheduler_config()->set_scheduler_type(
+      envoy::extensions::load_balancing_policies::common::v3::WeightedSchedulerConfig::
+          ALIAS_TABLE);
+  lb_ = std::make_shared<RoundRobinLoadBalancer>(priority_set_, nullptr, stats_, runtime_, random_,
+                                                 50, round_robin_config, simTime());
+
+  uint32_t host_1_counts = 0;
+  for (uint32_t i = 0; i < 4000; ++i) {
+    host_1_counts += lb_->chooseHost(nullptr) == hostSet().healthy_hosts_[1];
+  }
+  EXPECT_NEAR(3000, host_1_counts, 10);
+
+  // Add a host, it is picked as per its weight.
+  hostSet().healthy_hosts_.push_back(makeTestHost(info_, "tcp://127.0.0.1:82", simTime(), 4));
+  hostSet().hosts_.push_back(hostSet().healthy_hosts_.back());
+  hostSet().runCallbacks({hostSet().healthy_hosts_.back()}, {});
+  uint32_t host_2_counts = 0;
+  for (uint32_t i = 0; i < 8000; ++i) {
+    host_2_counts += lb_->chooseHost(nullptr) == hostSet().healthy_hosts_[2];
+  }
+  EXPECT_NEAR(4000, host_2_counts, 10);
+}
+
 // Validate that the RNG seed influences pick order when weighted RR.
 TEST_P(RoundRobinLoadBalancerTest, WeightedSeed) {
   hostSet().healthy_hosts_ = {makeTestHost(info_, "tcp://127.0.0.1:80", simTime(), 1),
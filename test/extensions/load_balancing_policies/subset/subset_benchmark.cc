@@ -115,6 +115,28 @@ BENCHMARK(benchmarkSubsetLoadBalancerUpdate)
     ->Ranges({{false, true}, {50, 2500}})
     ->Unit(::benchmark::kMillisecond);
 
+void benchmarkSubsetLoadBalancerReplaceHosts(::benchmark::State& state) {
+  const bool single_host_per_subset = state.range(0);
+  const uint64_t num_hosts = state.range(1);
+  const uint64_t churn_percent = state.range(2);
+  if (benchmark::skipExpensiveBenchmarks() && num_hosts > 1000) {
+    state.SkipWithError("Skipping expensive benchmark");
+    return;
+  }
+
+  SubsetLbTester tester(num_hosts, single_host_per_subset);
+  for (auto _ : state) { // NOLINT: Silences warning about dead store
+    // Each host is in a subset of its own, so the subsets of the replaced hosts are removed and
+    // new ones are created.
+    tester.replaceHosts(churn_percent);
+  }
+}
+// The arguments are whether each subset has a single host, the number of hosts and the
+// percentage of replaced hosts.
+BENCHMARK(benchmarkSubsetLoadBalancerReplaceHosts)
+    ->ArgsProduct({{false, true}, {1000, 10000, 100000}, {1, 10}})
+    ->Unit(::benchmark::kMillisecond);
+
 } // namespace
 } // namespace Subset
 } // namespace LoadBalancingPolices
@@ -59,6 +59,8 @@ public:
   MOCK_METHOD(bool, panicModeAny, (), (const));
   MOCK_METHOD(bool, listAsAny, (), (const));
   MOCK_METHOD(bool, allowRedundantKeys, (), (const));
+  MOCK_METHOD(bool, lazySubsets, (), (const));
+  MOCK_METHOD(uint32_t, maxLazySubsets, (), (const));
 
   std::vector<SubsetSelectorPtr> subset_selectors_;
 };
@@ -263,6 +265,19 @@ TEST(LoadBalancerSubsetInfoImplTest, DefaultConfigIsDiabled) {
   EXPECT_EQ(subset_info.subsetSelectors().size(), 0);
 }
 
+TEST(LoadBalancerSubsetInfoImplTest, LazySubsetsConfig) {
+  SubsetLbConfigProto subset_config;
+  subset_config.add_subset_selectors()->add_keys("version");
+  EXPECT_FALSE(LoadBalancerSubsetInfoImpl(subset_config).lazySubsets());
+
+  subset_config.mutable_lazy_subsets();
+  EXPECT_TRUE(LoadBalancerSubsetInfoImpl(subset_config).lazySubsets());
+  EXPECT_EQ(1024, LoadBalancerSubsetInfoImpl(subset_config).maxLazySubsets());
+
+  subset_config.mutable_lazy_subsets()->mutable_max_subsets()->set_value(10);
+  EXPECT_EQ(10, LoadBalancerSubsetInfoImpl(subset_config).maxLazySubsets());
+}
+
 TEST(LoadBalancerSubsetInfoImplTest, SubsetConfig) {
   auto subset_value = ProtobufWkt::Value();
   subset_value.set_string_value("the value");
@@ -3057,6 +3072,111 @@ TEST_P(SubsetLoadBalancerTest, MetadataFallbackAndSubsetFallback) {
   EXPECT_EQ(c64_production_host, lb_->chooseHost(&context_unknown_or_c64));
 }
 
+TEST_P(SubsetLoadBalancerTest, LazySubsetsCreatedOnFirstSelection) {
+  EXPECT_CALL(subset_info_, fallbackPolicy())
+      .WillRepeatedly(Return(envoy::config::cluster::v3::Cluster::LbSubsetConfig::NO_FALLBACK));
+  EXPECT_CALL(subset_info_, lazySubsets()).WillRepeatedly(Return(true));
+  EXPECT_CALL(subset_info_, maxLazySubsets()).WillRepeatedly(Return(10));
+
+  std::vector<SubsetSelectorPtr> subset_selectors = {makeSelector({"version"})};
+  EXPECT_CALL(subset_info_, subsetSelectors()).WillRepeatedly(ReturnRef(subset_selectors));
+
+  init({
+      {"tcp://127.0.0.1:80", {{"version", "1.0"}}},
+      {"tcp://127.0.0.1:81", {{"version", "1.0"}}},
+      {"tcp://127.0.0.1:82", {{"version", "1.1"}}},
+  });
+  EXPECT_EQ(0U, stats_.lb_subsets_created_.value());
+
+  TestLoadBalancerContext context_10({{"version", "1.0"}});
+  TestLoadBalancerContext context_12({{"version", "1.2"}});
+  TestLoadBalancerContext context_unknown({{"unknown", "1.0"}});
+
+  EXPECT_EQ(host_set_.hosts_[0], lb_->chooseHost(&context_10));
+  EXPECT_EQ(host_set_.hosts_[1], lb_->chooseHost(&context_10));
+  EXPECT_EQ(1U, stats_.lb_subsets_created_.value());
+  EXPECT_EQ(1U, stats_.lb_subsets_active_.value());
+
+  // A subset without hosts is created as well, but criteria not matching a selector create none.
+  EXPECT_EQ(nullptr, lb_->chooseHost(&context_12));
+  EXPECT_EQ(nullptr, lb_->chooseHost(&context_unknown));
+  EXPECT_EQ(2U, stats_.lb_subsets_created_.value());
+
+  // The empty subset is purged on the next update, and the 1.0 subset follows the host changes.
+  HostSharedPtr added_host = makeHost("tcp://127.0.0.1:8000", {{"version", "1.0"}});
+  modifyHosts({added_host}, {host_set_.hosts_[0]});
+  EXPECT_EQ(1U, stats_.lb_subsets_active_.value());
+  EXPECT_EQ(1U, stats_.lb_subsets_removed_.value());
+  EXPECT_EQ(host_set_.hosts_[0], lb_->chooseHost(&context_10));
+  EXPECT_EQ(added_host, lb_->chooseHost(&context_10));
+  EXPECT_EQ(host_set_.hosts_[0], lb_->chooseHost(&context_10));
+}
+
+TEST_P(SubsetLoadBalancerTest, LazySubsetsMetadataChanged) {
+  EXPECT_CALL(subset_info_, fallbackPolicy())
+      .WillRepeatedly(Return(envoy::config::cluster::v3::Cluster::LbSubsetConfig::NO_FALLBACK));
+  EXPECT_CALL(subset_info_, lazySubsets()).WillRepeatedly(Return(true));
+  EXPECT_CALL(subset_info_, maxLazySubsets()).WillRepeatedly(Return(10));
+
+  std::vector<SubsetSelectorPtr> subset_selectors = {makeSelector({"version"})};
+  EXPECT_CALL(subset_info_, subsetSelectors()).WillRepeatedly(ReturnRef(subset_selectors));
+
+  init({
+      {"tcp://127.0.0.1:80", {{"version", "1.0"}}},
+      {"tcp://127.0.0.1:81", {{"version", "1.1"}}},
+  });
+
+  TestLoadBalancerContext context_10({{"version", "1.0"}});
+  TestLoadBalancerContext context_11({{"version", "1.1"}});
+  EXPECT_EQ(host_set_.hosts_[0], lb_->chooseHost(&context_10));
+  EXPECT_EQ(host_set_.hosts_[1], lb_->chooseHost(&context_11));
+
+  // Move the second host to 1.0, the 1.1 subset is then empty and purged.
+  host_set_.hosts_[1]->metadata(buildMetadata("1.0"));
+  host_set_.runCallbacks({}, {});
+
+  EXPECT_EQ(1U, stats_.lb_subsets_active_.value());
+  EXPECT_EQ(1U, stats_.lb_subsets_removed_.value());
+  EXPECT_EQ(host_set_.hosts_[1], lb_->chooseHost(&context_10));
+  EXPECT_EQ(host_set_.hosts_[0], lb_->chooseHost(&context_10));
+  EXPECT_EQ(nullptr, lb_->chooseHost(&context_11));
+}
+
+TEST_P(SubsetLoadBalancerTest, LazySubsetsLeastRecentlySelectedEvicted) {
+  EXPECT_CALL(subset_info_, fallbackPolicy())
+      .WillRepeatedly(Return(envoy::config::cluster::v3::Cluster::LbSubsetConfig::NO_FALLBACK));
+  EXPECT_CALL(subset_info_, lazySubsets()).WillRepeatedly(Return(true));
+  EXPECT_CALL(subset_info_, maxLazySubsets()).WillRepeatedly(Return(2));
+
+  std::vector<SubsetSelectorPtr> subset_selectors = {makeSelector({"version"})};
+  EXPECT_CALL(subset_info_, subsetSelectors()).WillRepeatedly(ReturnRef(subset_selectors));
+
+  init({
+      {"tcp://127.0.0.1:80", {{"version", "1.0"}}},
+      {"tcp://127.0.0.1:81", {{"version", "1.1"}}},
+      {"tcp://127.0.0.1:82", {{"version", "1.2"}}},
+  });
+
+  TestLoadBalancerContext context_10({{"version", "1.0"}});
+  TestLoadBalancerContext context_11({{"version", "1.1"}});
+  TestLoadBalancerContext context_12({{"version", "1.2"}});
+  EXPECT_EQ(host_set_.hosts_[0], lb_->chooseHost(&context_10));
+  EXPECT_EQ(host_set_.hosts_[1], lb_->chooseHost(&context_11));
+  EXPECT_EQ(host_set_.hosts_[0], lb_->chooseHost(&context_10));
+
+  // 1.1 is the least recently selected subset.
+  EXPECT_EQ(host_set_.hosts_[2], lb_->chooseHost(&context_12));
+  EXPECT_EQ(3U, stats_.lb_subsets_created_.value());
+  EXPECT_EQ(1U, stats_.lb_subsets_removed_.value());
+  EXPECT_EQ(2U, stats_.lb_subsets_active_.value());
+
+  EXPECT_EQ(host_set_.hosts_[0], lb_->chooseHost(&context_10));
+  EXPECT_EQ(3U, stats_.lb_subsets_created_.value());
+  EXPECT_EQ(host_set_.hosts_[1], lb_->chooseHost(&context_11));
+  EXPECT_EQ(4U, stats_.lb_subsets_created_.value());
+  EXPECT_EQ(2U, stats_.lb_subsets_removed_.value());
+}
+
 INSTANTIATE_TEST_SUITE_P(UpdateOrderings, SubsetLoadBalancerTest,
                          testing::ValuesIn({UpdateOrder::RemovesFirst, UpdateOrder::Simultaneous}));
 
@@ -416,6 +416,14 @@ public:
                                                (zero_timeout ? ARES_OPT_TIMEOUTMS : 0));
   }
   bool isCaresDefaultTheOnlyNameserver() { return resolver_->isCaresDefaultTheOnlyNameserver(); }
+  size_t cachedResolutions() const { return resolver_->resolution_cache_.size(); }
+  size_t inFlightResolutions() const { return resolver_->in_flight_resolutions_.size(); }
+  // Expires the cached resolutions, as if their TTLs were over.
+  void expireResolutionCache() {
+    for (auto& entry : resolver_->resolution_cache_) {
+      entry.second.expiry_ = entry.second.cached_at_;
+    }
+  }
 
 private:
   DnsResolverImpl* resolver_;
@@ -718,6 +726,9 @@ public:
 
     cares.set_filter_unroutable_families(filterUnroutableFamilies());
     cares.set_allocated_udp_max_queries(udpMaxQueries());
+    if (cacheResolutions()) {
+      cares.mutable_resolution_cache()->mutable_negative_ttl()->set_seconds(60);
+    }
 
     // Copy over the dns_resolver_options_.
     cares.mutable_dns_resolver_options()->MergeFrom(dns_resolver_options);
@@ -958,6 +969,7 @@ protected:
   virtual bool setResolverInConstructor() const { return false; }
   virtual bool filterUnroutableFamilies() const { return false; }
   virtual ProtobufWkt::UInt32Value* udpMaxQueries() const { return 0; }
+  virtual bool cacheResolutions() const { return false; }
   Stats::TestUtil::TestStore stats_store_;
   NiceMock<Runtime::MockLoader> runtime_;
   std::unique_ptr<TestDnsServer> server_;
@@ -2123,5 +2135,134 @@ TEST_P(DnsImplAresFlagsForMaxUdpQueriesinTest, UdpMaxQueriesIsSet) {
   ares_destroy_options(&opts);
 }
 
+class DnsImplResolutionCacheTest : public DnsImplTest {
+protected:
+  bool cacheResolutions() const override { return true; }
+
+  uint64_t counter(const std::string& name) {
+    return stats_store_.counter("dns.cares." + name).value();
+  }
+};
+
+// Parameterize the DNS test server socket address.
+INSTANTIATE_TEST_SUITE_P(IpVersions, DnsImplResolutionCacheTest,
+                         testing::ValuesIn(TestEnvironment::getIpVersionsForTest()),
+                         TestUtility::ipTestParamsToString);
+
+// Validate that the concurrent resolutions of the same name and family share a query.
+TEST_P(DnsImplResolutionCacheTest, CoalescesConcurrentResolutions) {
+  server_->addHosts("some.good.domain", {"201.134.56.7"}, RecordType::A);
+  server_->setRecordTtl(std::chrono::seconds(300));
+
+  EXPECT_NE(nullptr, resolveWithExpectations("some.good.domain", DnsLookupFamily::V4Only,
+                                             DnsResolver::ResolutionStatus::Success,
+                                             {"201.134.56.7"}, {}, std::chrono::seconds(300)));
+  EXPECT_NE(nullptr, resolveWithExpectations("some.good.domain", DnsLookupFamily::V4Only,
+                                             DnsResolver::ResolutionStatus::Success,
+                                             {"201.134.56.7"}, {}, std::chrono::seconds(300)));
+  EXPECT_EQ(1U, peer_->inFlightResolutions());
+  dispatcher_->run(Event::Dispatcher::RunType::Block);
+
+  EXPECT_EQ(0U, peer_->inFlightResolutions());
+  EXPECT_EQ(1, counter("coalesced_resolutions"));
+  EXPECT_EQ(2, counter("cache_misses"));
+  checkStats(1 /*resolve_total*/, 0 /*pending_resolutions*/, 0 /*not_found*/,
+             0 /*get_addr_failure*/, 0 /*timeouts*/);
+}
+
+// Validate that a cancelled coalesced resolution doesn't get the result.
+TEST_P(DnsImplResolutionCacheTest, CancelCoalescedResolution) {
+  server_->addHosts("some.good.domain", {"201.134.56.7"}, RecordType::A);
+
+  EXPECT_NE(nullptr, resolveWithExpectations("some.good.domain", DnsLookupFamily::V4Only,
+                                             DnsResolver::ResolutionStatus::Success,
+                                             {"201.134.56.7"}, {}, absl::nullopt));
+  ActiveDnsQuery* query =
+      resolveWithUnreferencedParameters("some.good.domain", DnsLookupFamily::V4Only, false);
+  ASSERT_NE(nullptr, query);
+  query->cancel(Network::ActiveDnsQuery::CancelReason::QueryAbandoned);
+
+  dispatcher_->run(Event::Dispatcher::RunType::Block);
+  EXPECT_EQ(1, counter("coalesced_resolutions"));
+  checkStats(1 /*resolve_total*/, 0 /*pending_resolutions*/, 0 /*not_found*/,
+             0 /*get_addr_failure*/, 0 /*timeouts*/);
+}
+
+// Validate that the results are cached until their TTL expires, with their remaining TTLs.
+TEST_P(DnsImplResolutionCacheTest, CachesUntilTtlExpires) {
+  server_->addHosts("some.good.domain", {"201.134.56.7", "123.4.5.6"}, RecordType::A);
+  server_->setRecordTtl(std::chrono::seconds(300));
+
+  EXPECT_NE(nullptr, resolveWithExpectations("some.good.domain", DnsLookupFamily::V4Only,
+                                             DnsResolver::ResolutionStatus::Success,
+                                             {"201.134.56.7", "123.4.5.6"}, {},
+                                             std::chrono::seconds(300)));
+  dispatcher_->run(Event::Dispatcher::RunType::Block);
+  EXPECT_EQ(1U, peer_->cachedResolutions());
+  EXPECT_EQ(1, stats_store_
+                   .gauge("dns.cares.cached_resolutions", Stats::Gauge::ImportMode::NeverImport)
+                   .value());
+
+  // Answered synchronously from the cache.
+  EXPECT_EQ(nullptr, resolveWithExpectations("some.good.domain", DnsLookupFamily::V4Only,
+                                             DnsResolver::ResolutionStatus::Success,
+                                             {"201.134.56.7", "123.4.5.6"}, {},
+                                             std::chrono::seconds(300)));
+  EXPECT_EQ(1, counter("cache_hits"));
+  EXPECT_EQ(0, counter("cache_negative_hits"));
+
+  peer_->expireResolutionCache();
+  EXPECT_NE(nullptr, resolveWithExpectations("some.good.domain", DnsLookupFamily::V4Only,
+                                             DnsResolver::ResolutionStatus::Success,
+                                             {"201.134.56.7", "123.4.5.6"}, {},
+                                             std::chrono::seconds(300)));
+  dispatcher_->run(Event::Dispatcher::RunType::Block);
+  EXPECT_EQ(1, counter("cache_hits"));
+  EXPECT_EQ(2, counter("cache_misses"));
+  checkStats(2 /*resolve_total*/, 0 /*pending_resolutions*/, 0 /*not_found*/,
+             0 /*get_addr_failure*/, 0 /*timeouts*/);
+}
+
+// Validate that the results with a zero TTL aren't cached.
+TEST_P(DnsImplResolutionCacheTest, ZeroTtlNotCached) {
+  server_->addHosts("some.good.domain", {"201.134.56.7"}, RecordType::A);
+
+  for (int i = 0; i < 2; ++i) {
+    EXPECT_NE(nullptr, resolveWithExpectations("some.good.domain", DnsLookupFamily::V4Only,
+                                               DnsResolver::ResolutionStatus::Success,
+                                               {"201.134.56.7"}, {}, std::chrono::seconds(0)));
+    dispatcher_->run(Event::Dispatcher::RunType::Block);
+  }
+  EXPECT_EQ(0U, peer_->cachedResolutions());
+  EXPECT_EQ(0, counter("cache_hits"));
+  checkStats(2 /*resolve_total*/, 0 /*pending_resolutions*/, 0 /*not_found*/,
+             0 /*get_addr_failure*/, 0 /*timeouts*/);
+}
+
+// Validate that the resolutions finding no records are cached for the negative TTL.
+TEST_P(DnsImplResolutionCacheTest, NegativeCaching) {
+  EXPECT_NE(nullptr, resolveWithNoRecordsExpectation("some.bad.domain", DnsLookupFamily::V4Only));
+  dispatcher_->run(Event::Dispatcher::RunType::Block);
+
+  EXPECT_EQ(nullptr, resolveWithNoRecordsExpectation("some.bad.domain", DnsLookupFamily::V4Only));
+  EXPECT_EQ(1, counter("cache_hits"));
+  EXPECT_EQ(1, counter("cache_negative_hits"));
+  checkStats(1 /*resolve_total*/, 0 /*pending_resolutions*/, 1 /*not_found*/,
+             0 /*get_addr_failure*/, 0 /*timeouts*/);
+}
+
+// Validate that resetting the networking clears the cache.
+TEST_P(DnsImplResolutionCacheTest, ResetNetworkingClearsCache) {
+  EXPECT_NE(nullptr, resolveWithNoRecordsExpectation("some.bad.domain", DnsLookupFamily::V4Only));
+  dispatcher_->run(Event::Dispatcher::RunType::Block);
+  EXPECT_EQ(1U, peer_->cachedResolutions());
+
+  resolver_->resetNetworking();
+  EXPECT_EQ(0U, peer_->cachedResolutions());
+  EXPECT_EQ(0, stats_store_
+                   .gauge("dns.cares.cached_resolutions", Stats::Gauge::ImportMode::NeverImport)
+                   .value());
+}
+
 } // namespace Network
 } // namespace Envoy
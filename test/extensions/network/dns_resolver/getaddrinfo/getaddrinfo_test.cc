@@ -1,3 +1,6 @@
+#include <string>
+#include <vector>
+
 #include "envoy/extensions/network/dns_resolver/getaddrinfo/v3/getaddrinfo_dns_resolver.pb.h"
 
 #include "source/common/network/dns_resolver/dns_factory_util.h"
@@ -7,6 +10,7 @@
 #include "test/test_common/threadsafe_singleton_injector.h"
 #include "test/test_common/utility.h"
 
+#include "absl/synchronization/notification.h"
 #include "gtest/gtest.h"
 
 using testing::NiceMock;
@@ -20,9 +24,16 @@ class GetAddrInfoDnsImplTest : public testing::Test {
 public:
   GetAddrInfoDnsImplTest()
       : api_(Api::createApiForTest()), dispatcher_(api_->allocateDispatcher("test_thread")) {
+    createResolver({});
+
+    // NOP for coverage.
+    resolver_->resetNetworking();
+  }
+
+  void createResolver(
+      const envoy::extensions::network::dns_resolver::getaddrinfo::v3::GetAddrInfoDnsResolverConfig&
+          getaddrinfo) {
     envoy::config::core::v3::TypedExtensionConfig typed_dns_resolver_config;
-    envoy::extensions::network::dns_resolver::getaddrinfo::v3::GetAddrInfoDnsResolverConfig
-        getaddrinfo;
     typed_dns_resolver_config.mutable_typed_config()->PackFrom(getaddrinfo);
     typed_dns_resolver_config.set_name(std::string("envoy.network.dns_resolver.getaddrinfo"));
 
@@ -31,9 +42,6 @@ public:
     resolver_ =
         dns_resolver_factory.createDnsResolver(*dispatcher_, *api_, typed_dns_resolver_config)
             .value();
-
-    // NOP for coverage.
-    resolver_->resetNetworking();
   }
 
   void setupFakeGai(std::vector<Address::InstanceConstSharedPtr> addresses = {
@@ -396,6 +404,97 @@ TEST_F(GetAddrInfoDnsImplTest, AutoNoV6) {
   dispatcher_->run(Event::Dispatcher::RunType::RunUntilExit);
 }
 
+TEST_F(GetAddrInfoDnsImplTest, IdenticalQueriesShareResolution) {
+  TestThreadsafeSingletonInjector<Api::OsSysCallsImpl> os_calls(&os_sys_calls_);
+
+  absl::Notification queries_issued;
+  // A single resolution, which completes once all the queries have been issued.
+  EXPECT_CALL(os_sys_calls_, getaddrinfo(_, _, _, _))
+      .WillOnce(Invoke([&](const char*, const char*, const addrinfo*, addrinfo**) {
+        queries_issued.WaitForNotification();
+        return Api::SysCallIntResult{EAI_FAIL, 0};
+      }));
+  int callbacks = 0;
+  auto callback = [&](DnsResolver::ResolutionStatus status, absl::string_view,
+                      std::list<DnsResponse>&&) {
+    EXPECT_EQ(status, DnsResolver::ResolutionStatus::Failure);
+    if (++callbacks == 2) {
+      dispatcher_->exit();
+    }
+  };
+  resolver_->resolve("localhost", DnsLookupFamily::All, callback);
+  ActiveDnsQuery* cancelled = resolver_->resolve(
+      "localhost", DnsLookupFamily::All,
+      [](DnsResolver::ResolutionStatus, absl::string_view, std::list<DnsResponse>&&) { FAIL(); });
+  resolver_->resolve("localhost", DnsLookupFamily::All, callback);
+  cancelled->cancel(ActiveDnsQuery::CancelReason::QueryAbandoned);
+  queries_issued.Notify();
+
+  dispatcher_->run(Event::Dispatcher::RunType::RunUntilExit);
+  EXPECT_EQ(2, callbacks);
+}
+
+TEST_F(GetAddrInfoDnsImplTest, SlowResolutionDoesNotBlockOthers) {
+  TestThreadsafeSingletonInjector<Api::OsSysCallsImpl> os_calls(&os_sys_calls_);
+  envoy::extensions::network::dns_resolver::getaddrinfo::v3::GetAddrInfoDnsResolverConfig config;
+  config.mutable_num_resolver_threads()->set_value(2);
+  createResolver(config);
+
+  absl::Notification fast_resolved;
+  EXPECT_CALL(os_sys_calls_, getaddrinfo(_, _, _, _))
+      .Times(2)
+      .WillRepeatedly(Invoke([&](const char* node, const char*, const addrinfo*, addrinfo**) {
+        if (absl::string_view(node) == "slow") {
+          fast_resolved.WaitForNotification();
+        }
+        return Api::SysCallIntResult{EAI_FAIL, 0};
+      }));
+  std::vector<std::string> resolved;
+  auto callback = [&](const std::string& name) {
+    return [&, name](DnsResolver::ResolutionStatus, absl::string_view, std::list<DnsResponse>&&) {
+      resolved.push_back(name);
+      if (name == "fast") {
+        fast_resolved.Notify();
+      } else {
+        dispatcher_->exit();
+      }
+    };
+  };
+  resolver_->resolve("slow", DnsLookupFamily::All, callback("slow"));
+  resolver_->resolve("fast", DnsLookupFamily::All, callback("fast"));
+
+  dispatcher_->run(Event::Dispatcher::RunType::RunUntilExit);
+  EXPECT_EQ((std::vector<std::string>{"fast", "slow"}), resolved);
+}
+
+TEST_F(GetAddrInfoDnsImplTest, QueryTimeout) {
+  TestThreadsafeSingletonInjector<Api::OsSysCallsImpl> os_calls(&os_sys_calls_);
+  envoy::extensions::network::dns_resolver::getaddrinfo::v3::GetAddrInfoDnsResolverConfig config;
+  config.mutable_query_timeout()->set_nanos(10 * 1000 * 1000);
+  createResolver(config);
+
+  absl::Notification timed_out;
+  EXPECT_CALL(os_sys_calls_, getaddrinfo(_, _, _, _))
+      .WillOnce(Invoke([&](const char*, const char*, const addrinfo*, addrinfo**) {
+        timed_out.WaitForNotification();
+        return Api::SysCallIntResult{0, 0};
+      }));
+  resolver_->resolve("localhost", DnsLookupFamily::All,
+                     [&](DnsResolver::ResolutionStatus status, absl::string_view details,
+                         std::list<DnsResponse>&& response) {
+                       EXPECT_EQ(status, DnsResolver::ResolutionStatus::Failure);
+                       EXPECT_EQ("getaddrinfo_timeout", details);
+                       EXPECT_TRUE(response.empty());
+                       timed_out.Notify();
+                       dispatcher_->exit();
+                     });
+
+  dispatcher_->run(Event::Dispatcher::RunType::RunUntilExit);
+  // The result of the resolution is dropped once it completes.
+  resolver_.reset();
+  dispatcher_->run(Event::Dispatcher::RunType::NonBlock);
+}
+
 } // namespace
 } // namespace Network
 } // namespace Envoy
@@ -84,6 +84,54 @@ TEST_F(EnvoyDeterministicConnectionIdGeneratorTest, NextConnectionIdPersistsWork
   }
 }
 
+class EnvoyWorkerIndexConnectionIdGeneratorTest : public QuicTest {
+public:
+  EnvoyWorkerIndexConnectionIdGeneratorTest()
+      : generator_(EnvoyWorkerIndexConnectionIdGenerator(connection_id_length_, worker_index_,
+                                                         concurrency_)) {}
+
+protected:
+  uint8_t connection_id_length_{8};
+  uint32_t worker_index_{3};
+  uint32_t concurrency_{7};
+  EnvoyWorkerIndexConnectionIdGenerator generator_;
+};
+
+TEST_F(EnvoyWorkerIndexConnectionIdGeneratorTest, NextConnectionIdRoutesToWorker) {
+  EnvoyDeterministicConnectionIdGeneratorFactory factory;
+  for (uint64_t i = 0; i < 256; ++i) {
+    QuicConnectionId id = TestConnectionId(i << 40);
+    auto next_id = generator_.GenerateNextConnectionId(id);
+    ASSERT_TRUE(next_id.has_value());
+    EXPECT_EQ(connection_id_length_, next_id->length());
+    // A short header packet carrying the new connection id.
+    Buffer::OwnedImpl buffer("\x40");
+    buffer.add(next_id->data(), next_id->length());
+    EXPECT_THAT(FactoryFunctions(factory, concurrency_),
+                GivenPacket(buffer).ReturnsWorkerId(worker_index_))
+        << "next_id = " << next_id.value();
+  }
+}
+
+TEST_F(EnvoyWorkerIndexConnectionIdGeneratorTest, ReplacesConnectionIdRoutingToOtherWorker) {
+  // The first 4 bytes route to worker 0x01020304 % 7 = 0.
+  const char other_worker_bytes[] = {1, 2, 3, 4, 5, 6, 7, 8};
+  QuicConnectionId other_worker_id(other_worker_bytes, sizeof(other_worker_bytes));
+  auto replaced_id =
+      generator_.MaybeReplaceConnectionId(other_worker_id, quic::ParsedQuicVersion::RFCv1());
+  ASSERT_TRUE(replaced_id.has_value());
+  const auto* replaced_bytes = reinterpret_cast<const uint8_t*>(replaced_id->data());
+  const uint32_t snippet = (replaced_bytes[0] << 24) | (replaced_bytes[1] << 16) |
+                           (replaced_bytes[2] << 8) | replaced_bytes[3];
+  EXPECT_EQ(worker_index_, snippet % concurrency_);
+
+  // The first 4 bytes route to worker 0x01020300 % 7 = 3.
+  const char own_worker_bytes[] = {1, 2, 3, 0, 5, 6, 7, 8};
+  QuicConnectionId own_worker_id(own_worker_bytes, sizeof(own_worker_bytes));
+  EXPECT_FALSE(generator_.MaybeReplaceConnectionId(own_worker_id, quic::ParsedQuicVersion::RFCv1())
+                   .has_value());
+}
+
 class EnvoyDeterministicConnectionIdGeneratorFactoryTest : public ::testing::Test {
 protected:
   EnvoyDeterministicConnectionIdGeneratorFactory factory_;
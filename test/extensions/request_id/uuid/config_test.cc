@@ -30,6 +30,25 @@ TEST(UUIDRequestIDExtensionTest, SetRequestID) {
   EXPECT_EQ("second-request-id", request_headers.get_(Http::Headers::get().RequestId));
 }
 
+TEST(UUIDRequestIDExtensionTest, SetRequestIDFastRandom) {
+  testing::StrictMock<Random::MockRandomGenerator> random;
+  envoy::extensions::request_id::uuid::v3::UuidRequestIdConfig config;
+  config.set_use_fast_random(true);
+  UUIDRequestIDExtension uuid_utils(config, random);
+  Http::TestRequestHeaderMapImpl request_headers;
+
+  uuid_utils.set(request_headers, true);
+  const std::string first_request_id(request_headers.getRequestIdValue());
+  EXPECT_EQ(Random::RandomGeneratorImpl::UUID_LENGTH, first_request_id.length());
+  EXPECT_TRUE(uuid_utils.getInteger(request_headers).has_value());
+  EXPECT_EQ(Tracing::Reason::NotTraceable, uuid_utils.getTraceReason(request_headers));
+  uuid_utils.setTraceReason(request_headers, Tracing::Reason::Sampling);
+  EXPECT_EQ(Tracing::Reason::Sampling, uuid_utils.getTraceReason(request_headers));
+
+  uuid_utils.set(request_headers, true);
+  EXPECT_NE(first_request_id, request_headers.getRequestIdValue());
+}
+
 TEST(UUIDRequestIDExtensionTest, EnsureRequestID) {
   testing::StrictMock<Random::MockRandomGenerator> random;
   UUIDRequestIDExtension uuid_utils(envoy::extensions::request_id::uuid::v3::UuidRequestIdConfig(),
@@ -110,6 +129,9 @@ TEST(UUIDRequestIDExtensionTest, GetRequestIdAndModRequestIDBy) {
   EXPECT_EQ("000000ff-0000-0000-0000-000000000000", uuid_utils.get(request_headers).value());
   EXPECT_EQ(255, uuid_utils.getInteger(request_headers).value());
 
+  request_headers.setRequestId("000000FF-0000-0000-0000-000000000000");
+  EXPECT_EQ(255, uuid_utils.getInteger(request_headers).value());
+
   request_headers.setRequestId("a0090100-0012-0110-00ff-0c00400600ff");
   EXPECT_EQ("a0090100-0012-0110-00ff-0c00400600ff", uuid_utils.get(request_headers).value());
   EXPECT_EQ(8, uuid_utils.getInteger(request_headers).value() % 137);
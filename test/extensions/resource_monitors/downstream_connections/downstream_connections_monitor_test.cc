@@ -44,6 +44,24 @@ TEST_F(ActiveDownstreamConnectionsMonitorTest, ComputesCorrectUsage) {
   EXPECT_EQ(1, monitor_->currentResourceUsage());
 }
 
+TEST_F(ActiveDownstreamConnectionsMonitorTest, ComputesCorrectUsageWithSlack) {
+  envoy::extensions::resource_monitors::downstream_connections::v3::DownstreamConnectionsConfig
+      config;
+  config.set_max_active_downstream_connections(3);
+  config.set_per_worker_slack(10);
+  initialize(config);
+  EXPECT_EQ(0, monitor_->currentResourceUsage());
+  EXPECT_EQ(3, monitor_->maxResourceUsage());
+  EXPECT_TRUE(monitor_->tryAllocateResource(1));
+  EXPECT_TRUE(monitor_->tryAllocateResource(2));
+  EXPECT_EQ(3, monitor_->currentResourceUsage());
+  EXPECT_FALSE(monitor_->tryAllocateResource(1));
+  EXPECT_TRUE(monitor_->tryDeallocateResource(2));
+  EXPECT_EQ(1, monitor_->currentResourceUsage());
+  EXPECT_TRUE(monitor_->tryAllocateResource(2));
+  EXPECT_FALSE(monitor_->tryAllocateResource(1));
+}
+
 TEST_F(ActiveDownstreamConnectionsMonitorTest, FailsToAllocateDeallocateWhenMinMaxHit) {
   envoy::extensions::resource_monitors::downstream_connections::v3::DownstreamConnectionsConfig
       config;
@@ -16,10 +16,12 @@
 #include "test/test_common/network_utility.h"
 #include "test/test_common/utility.h"
 
+#include "absl/strings/str_cat.h"
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 #include "spdlog/spdlog.h"
 
+using testing::ElementsAre;
 using testing::NiceMock;
 
 namespace Envoy {
@@ -32,12 +34,13 @@ namespace {
 class MockWriter : public UdpStatsdSink::Writer {
 public:
   MOCK_METHOD(void, write, (const std::string& message));
-  MOCK_METHOD(void, writeBuffer, (Buffer::Instance & buffer));
+  MOCK_METHOD(void, writeDatagrams, (const std::vector<std::string>& datagrams));
 
   void delegateBufferFake() {
-    ON_CALL(*this, writeBuffer).WillByDefault([this](Buffer::Instance& buffer) {
-      this->buffer_writes.push_back(buffer.toString());
-    });
+    ON_CALL(*this, writeDatagrams)
+        .WillByDefault([this](const std::vector<std::string>& datagrams) {
+          this->buffer_writes.insert(this->buffer_writes.end(), datagrams.begin(), datagrams.end());
+        });
   }
 
   std::vector<std::string> buffer_writes;
@@ -143,6 +146,35 @@ TEST_P(UdpStatsdSinkTest, InitWithIpAddress) {
   tls_.shutdownThread();
 }
 
+TEST_P(UdpStatsdSinkTest, BufferedDatagramsWrittenTogether) {
+  NiceMock<ThreadLocal::MockInstance> tls_;
+  NiceMock<Stats::MockMetricSnapshot> snapshot;
+  Network::Test::UdpSyncPeer server(GetParam());
+  UdpStatsdSink sink(tls_, server.localAddress(), false, getDefaultPrefix(), 49);
+
+  std::vector<std::unique_ptr<NiceMock<Stats::MockCounter>>> counters;
+  for (int i = 0; i < 5; ++i) {
+    counters.push_back(std::make_unique<NiceMock<Stats::MockCounter>>());
+    counters.back()->name_ = absl::StrCat("test_counter_", i);
+    counters.back()->used_ = true;
+    counters.back()->latch_ = 1;
+    snapshot.counters_.push_back({1, *counters.back()});
+  }
+
+  // All the datagrams of the flush are received, in order.
+  sink.flush(snapshot);
+  const std::vector<std::string> expected{"envoy.test_counter_0:1|c\nenvoy.test_counter_1:1|c",
+                                          "envoy.test_counter_2:1|c\nenvoy.test_counter_3:1|c",
+                                          "envoy.test_counter_4:1|c"};
+  for (const std::string& datagram : expected) {
+    Network::UdpRecvData data;
+    server.recv(data);
+    EXPECT_EQ(datagram, data.buffer_->toString());
+  }
+
+  tls_.shutdownThread();
+}
+
 class UdpStatsdSinkWithTagsTest : public testing::TestWithParam<Network::Address::IpVersion> {};
 INSTANTIATE_TEST_SUITE_P(IpVersions, UdpStatsdSinkWithTagsTest,
                          testing::ValuesIn(TestEnvironment::getIpVersionsForTest()),
@@ -229,7 +261,7 @@ TEST(UdpStatsdSinkTest, CheckActualStats) {
   counter.latch_ = 1;
   snapshot.counters_.push_back({1, counter});
 
-  EXPECT_CALL(*std::dynamic_pointer_cast<NiceMock<MockWriter>>(writer_ptr), writeBuffer(_));
+  EXPECT_CALL(*std::dynamic_pointer_cast<NiceMock<MockWriter>>(writer_ptr), writeDatagrams(_));
   sink.flush(snapshot);
   EXPECT_EQ(writer_ptr->buffer_writes.size(), 1);
   EXPECT_EQ(writer_ptr->buffer_writes.at(0), "envoy.test_counter:1|c");
@@ -241,7 +273,7 @@ TEST(UdpStatsdSinkTest, CheckActualStats) {
   gauge.used_ = true;
   snapshot.gauges_.push_back(gauge);
 
-  EXPECT_CALL(*std::dynamic_pointer_cast<NiceMock<MockWriter>>(writer_ptr), writeBuffer(_));
+  EXPECT_CALL(*std::dynamic_pointer_cast<NiceMock<MockWriter>>(writer_ptr), writeDatagrams(_));
   sink.flush(snapshot);
   EXPECT_EQ(writer_ptr->buffer_writes.size(), 2);
   EXPECT_EQ(writer_ptr->buffer_writes.at(1), "envoy.test_gauge:1|g");
@@ -271,7 +303,7 @@ TEST(UdpStatsdSinkTest, CheckMetricLargerThanBuffer) {
 
   // Expect the metric to skip the buffer
   EXPECT_CALL(*std::dynamic_pointer_cast<NiceMock<MockWriter>>(writer_ptr),
-              write("envoy.test_counter:1|c"));
+              writeDatagrams(ElementsAre("envoy.test_counter:1|c")));
   sink.flush(snapshot);
   counter.used_ = false;
 
@@ -283,7 +315,7 @@ TEST(UdpStatsdSinkTest, CheckMetricLargerThanBuffer) {
 
   // Expect the metric to skip the buffer
   EXPECT_CALL(*std::dynamic_pointer_cast<NiceMock<MockWriter>>(writer_ptr),
-              write("envoy.test_gauge:1|g"));
+              writeDatagrams(ElementsAre("envoy.test_gauge:1|g")));
   sink.flush(snapshot);
 
   tls_.shutdownThread();
@@ -310,7 +342,7 @@ TEST(UdpStatsdSinkTest, CheckBufferedWritesWithinBufferSize) {
   snapshot.gauges_.push_back(gauge);
 
   // Expect both metrics to be present in single write
-  EXPECT_CALL(*std::dynamic_pointer_cast<NiceMock<MockWriter>>(writer_ptr), writeBuffer(_));
+  EXPECT_CALL(*std::dynamic_pointer_cast<NiceMock<MockWriter>>(writer_ptr), writeDatagrams(_));
   sink.flush(snapshot);
   EXPECT_EQ(writer_ptr->buffer_writes.size(), 1);
   EXPECT_EQ(writer_ptr->buffer_writes.at(0), "envoy.test_counter:1|c\nenvoy.test_gauge:1|g");
@@ -344,9 +376,8 @@ TEST(UdpStatsdSinkTest, CheckBufferedWritesExceedingBufferSize) {
   gauge.used_ = true;
   snapshot.gauges_.push_back(gauge);
 
-  // Expect both metrics to be present in single write
-  EXPECT_CALL(*std::dynamic_pointer_cast<NiceMock<MockWriter>>(writer_ptr), writeBuffer(_))
-      .Times(2);
+  // Expect the metrics to be split over two datagrams of a single write
+  EXPECT_CALL(*std::dynamic_pointer_cast<NiceMock<MockWriter>>(writer_ptr), writeDatagrams(_));
   sink.flush(snapshot);
   EXPECT_EQ(writer_ptr->buffer_writes.size(), 2);
   EXPECT_EQ(writer_ptr->buffer_writes.at(0), "envoy.test_counter_1:1|c\nenvoy.test_counter_2:1|c");
@@ -368,7 +399,7 @@ TEST(UdpStatsdSinkTest, CheckActualStatsWithCustomPrefix) {
   counter.latch_ = 1;
   snapshot.counters_.push_back({1, counter});
 
-  EXPECT_CALL(*std::dynamic_pointer_cast<NiceMock<MockWriter>>(writer_ptr), writeBuffer(_));
+  EXPECT_CALL(*std::dynamic_pointer_cast<NiceMock<MockWriter>>(writer_ptr), writeDatagrams(_));
   sink.flush(snapshot);
   EXPECT_EQ(writer_ptr->buffer_writes.size(), 1);
   EXPECT_EQ(writer_ptr->buffer_writes.at(0), "test_prefix.test_counter:1|c");
@@ -450,7 +481,7 @@ TEST(UdpStatsdSinkWithTagsTest, CheckActualStats) {
   counter.setTags(tags);
   snapshot.counters_.push_back({1, counter});
 
-  EXPECT_CALL(*std::dynamic_pointer_cast<NiceMock<MockWriter>>(writer_ptr), writeBuffer(_));
+  EXPECT_CALL(*std::dynamic_pointer_cast<NiceMock<MockWriter>>(writer_ptr), writeDatagrams(_));
   sink.flush(snapshot);
   EXPECT_EQ(writer_ptr->buffer_writes.size(), 1);
   EXPECT_EQ(writer_ptr->buffer_writes.at(0), "envoy.test_counter:1|c|#key1:value1,key2:value2");
@@ -463,7 +494,7 @@ TEST(UdpStatsdSinkWithTagsTest, CheckActualStats) {
   gauge.setTags(tags);
   snapshot.gauges_.push_back(gauge);
 
-  EXPECT_CALL(*std::dynamic_pointer_cast<NiceMock<MockWriter>>(writer_ptr), writeBuffer(_));
+  EXPECT_CALL(*std::dynamic_pointer_cast<NiceMock<MockWriter>>(writer_ptr), writeDatagrams(_));
   sink.flush(snapshot);
   EXPECT_EQ(writer_ptr->buffer_writes.size(), 2);
   EXPECT_EQ(writer_ptr->buffer_writes.at(1), "envoy.test_gauge:1|g|#key1:value1,key2:value2");
@@ -540,7 +571,7 @@ TEST(UdpStatsdSinkWithTagsTest, GraphiteTagSyntax) {
   counter.setTags(tags);
   snapshot.counters_.push_back({1, counter});
 
-  EXPECT_CALL(*std::dynamic_pointer_cast<NiceMock<MockWriter>>(writer_ptr), writeBuffer(_));
+  EXPECT_CALL(*std::dynamic_pointer_cast<NiceMock<MockWriter>>(writer_ptr), writeDatagrams(_));
   sink.flush(snapshot);
   EXPECT_EQ(writer_ptr->buffer_writes.size(), 1);
   EXPECT_EQ(writer_ptr->buffer_writes.at(0), "envoy.test_counter;key1=value1;key2=value2:1|c");
@@ -553,7 +584,7 @@ TEST(UdpStatsdSinkWithTagsTest, GraphiteTagSyntax) {
   gauge.setTags(tags);
   snapshot.gauges_.push_back(gauge);
 
-  EXPECT_CALL(*std::dynamic_pointer_cast<NiceMock<MockWriter>>(writer_ptr), writeBuffer(_));
+  EXPECT_CALL(*std::dynamic_pointer_cast<NiceMock<MockWriter>>(writer_ptr), writeDatagrams(_));
   sink.flush(snapshot);
   EXPECT_EQ(writer_ptr->buffer_writes.size(), 2);
   EXPECT_EQ(writer_ptr->buffer_writes.at(1), "envoy.test_gauge;key1=value1;key2=value2:1|g");
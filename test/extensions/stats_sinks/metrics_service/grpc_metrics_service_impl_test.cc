@@ -315,7 +315,7 @@ TEST_F(MetricsServiceSinkTest, FlushPredicate) {
   {
     MetricsFlusher flusher(true, true,
                            envoy::config::metrics::v3::HistogramEmitMode::SUMMARY_AND_HISTOGRAM,
-                           [](const auto&) { return true; });
+                           false, [](const auto&) { return true; });
     auto metrics = flusher.flush(snapshot_);
     EXPECT_EQ(2, metrics->size());
   }
@@ -323,11 +323,49 @@ TEST_F(MetricsServiceSinkTest, FlushPredicate) {
   // Using a predicate that rejects all metrics, we'd flush no metrics.
   MetricsFlusher flusher(true, true,
                          envoy::config::metrics::v3::HistogramEmitMode::SUMMARY_AND_HISTOGRAM,
-                         [](const auto&) { return false; });
+                         false, [](const auto&) { return false; });
   auto metrics = flusher.flush(snapshot_);
   EXPECT_EQ(0, metrics->size());
 }
 
+// Test that only the metrics which changed since the previous flush are reported when configured
+// to do so.
+TEST_F(MetricsServiceSinkTest, ReportOnlyChangedMetrics) {
+  MetricsServiceSink<envoy::service::metrics::v3::StreamMetricsMessage,
+                     envoy::service::metrics::v3::StreamMetricsResponse>
+      sink(streamer_, false, false,
+           envoy::config::metrics::v3::HistogramEmitMode::SUMMARY_AND_HISTOGRAM, true);
+
+  addCounterToSnapshot("changed_counter", 1, 100);
+  addCounterToSnapshot("unchanged_counter", 0, 100);
+  addGaugeToSnapshot("test_gauge", 1);
+  // The histogram has no samples in the interval.
+  addHistogramToSnapshot("test_histogram");
+
+  // The gauge is sent the first time it is seen.
+  EXPECT_CALL(*streamer_, send(_)).WillOnce(Invoke([](MetricsPtr&& metrics) {
+    ASSERT_EQ(2, metrics->size());
+    EXPECT_EQ("changed_counter", (*metrics)[0].name());
+    EXPECT_EQ(100, (*metrics)[0].metric(0).counter().value());
+    EXPECT_EQ("test_gauge", (*metrics)[1].name());
+  }));
+  sink.flush(snapshot_);
+
+  EXPECT_CALL(*streamer_, send(_)).WillOnce(Invoke([](MetricsPtr&& metrics) {
+    ASSERT_EQ(1, metrics->size());
+    EXPECT_EQ("changed_counter", (*metrics)[0].name());
+  }));
+  sink.flush(snapshot_);
+
+  gauge_storage_.back()->value_ = 2;
+  EXPECT_CALL(*streamer_, send(_)).WillOnce(Invoke([](MetricsPtr&& metrics) {
+    ASSERT_EQ(2, metrics->size());
+    EXPECT_EQ("test_gauge", (*metrics)[1].name());
+    EXPECT_EQ(2, (*metrics)[1].metric(0).gauge().value());
+  }));
+  sink.flush(snapshot_);
+}
+
 // This test will emit summary and histogram.
 TEST_F(MetricsServiceSinkTest, HistogramEmitModeBoth) {
   addHistogramToSnapshot("test_histogram");
@@ -225,6 +225,30 @@ TEST(ZipkinSpanBufferTest, ConstructBuffer) {
   expectSerializedBuffer(buffer3, delay_allocation, {expected2});
 }
 
+// Test that the tags are escaped, and that the last value of a tag set several times wins.
+TEST(ZipkinSpanBufferTest, SerializeTagsJson) {
+  SpanBuffer buffer(envoy::config::trace::v3::ZipkinConfig::HTTP_JSON, true, 1);
+  Span span = createSpan({"cs"}, IpType::V4);
+  span.setTag("quoted", "first");
+  span.setTag("quoted", "\"second\"\n");
+  buffer.addSpan(std::move(span));
+  EXPECT_THAT(wrapAsObject("[{"
+                           R"("traceId":"0000000000000001",)"
+                           R"("id":"0000000000000001",)"
+                           R"("kind":"CLIENT",)"
+                           R"("timestamp":ANNOTATION_TEST_TIMESTAMP,)"
+                           R"("duration":DEFAULT_TEST_DURATION,)"
+                           R"("localEndpoint":{)"
+                           R"("serviceName":"service1",)"
+                           R"("ipv4":"1.2.3.4",)"
+                           R"("port":8080},)"
+                           R"("tags":{)"
+                           R"("response_size":"DEFAULT_TEST_DURATION",)"
+                           R"("quoted":"\"second\"\n"})"
+                           "}]"),
+              JsonStringEq(wrapAsObject(buffer.serialize())));
+}
+
 TEST(ZipkinSpanBufferTest, SerializeSpan) {
   const bool shared = true;
   SpanBuffer buffer1(envoy::config::trace::v3::ZipkinConfig::HTTP_JSON, shared, 2);
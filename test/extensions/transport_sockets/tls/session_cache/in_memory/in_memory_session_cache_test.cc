@@ -0,0 +1,84 @@
+#include "source/extensions/transport_sockets/tls/session_cache/in_memory/config.h"
+#include "source/extensions/transport_sockets/tls/session_cache/in_memory/in_memory_session_cache.h"
+
+#include "test/mocks/server/server_factory_context.h"
+#include "test/test_common/simulated_time_system.h"
+#include "test/test_common/utility.h"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+using testing::Optional;
+
+namespace Envoy {
+namespace Extensions {
+namespace TransportSockets {
+namespace Tls {
+namespace SessionCache {
+namespace {
+
+class InMemorySessionCacheTest : public testing::Test {
+protected:
+  Event::SimulatedTimeSystem time_system_;
+};
+
+TEST_F(InMemorySessionCacheTest, InsertLookupRemove) {
+  InMemorySessionCache cache(10, time_system_);
+  EXPECT_EQ(absl::nullopt, cache.lookup("a"));
+  cache.insert("a", "session a", std::chrono::seconds(60));
+  EXPECT_THAT(cache.lookup("a"), Optional(std::string("session a")));
+  cache.insert("a", "session a2", std::chrono::seconds(60));
+  EXPECT_THAT(cache.lookup("a"), Optional(std::string("session a2")));
+  EXPECT_EQ(1U, cache.size());
+  cache.remove("a");
+  cache.remove("b");
+  EXPECT_EQ(absl::nullopt, cache.lookup("a"));
+  EXPECT_EQ(0U, cache.size());
+}
+
+TEST_F(InMemorySessionCacheTest, EvictsLeastRecentlyUsed) {
+  InMemorySessionCache cache(2, time_system_);
+  cache.insert("a", "session a", std::chrono::seconds(60));
+  cache.insert("b", "session b", std::chrono::seconds(60));
+  // The lookup of a makes b the least recently used.
+  EXPECT_TRUE(cache.lookup("a").has_value());
+  cache.insert("c", "session c", std::chrono::seconds(60));
+  EXPECT_EQ(2U, cache.size());
+  EXPECT_TRUE(cache.lookup("a").has_value());
+  EXPECT_EQ(absl::nullopt, cache.lookup("b"));
+  EXPECT_TRUE(cache.lookup("c").has_value());
+}
+
+TEST_F(InMemorySessionCacheTest, Expiry) {
+  InMemorySessionCache cache(10, time_system_);
+  cache.insert("a", "session a", std::chrono::seconds(10));
+  cache.insert("b", "session b", std::chrono::seconds(30));
+  time_system_.advanceTimeWait(std::chrono::seconds(20));
+  EXPECT_EQ(absl::nullopt, cache.lookup("a"));
+  EXPECT_TRUE(cache.lookup("b").has_value());
+  EXPECT_EQ(1U, cache.size());
+}
+
+TEST_F(InMemorySessionCacheTest, Factory) {
+  NiceMock<Server::Configuration::MockServerFactoryContext> context;
+  auto* factory = Registry::FactoryRegistry<Ssl::SessionCacheFactory>::getFactory(
+      "envoy.tls.session_cache.in_memory");
+  ASSERT_NE(nullptr, factory);
+  envoy::extensions::transport_sockets::tls::session_cache::in_memory::v3::
+      InMemorySessionCacheConfig config;
+  config.mutable_max_sessions()->set_value(1);
+  Ssl::SessionCacheSharedPtr cache = factory->createSessionCache(
+      config, ProtobufMessage::getStrictValidationVisitor(), context);
+  ASSERT_NE(nullptr, cache);
+  cache->insert("a", "session a", std::chrono::seconds(60));
+  cache->insert("b", "session b", std::chrono::seconds(60));
+  EXPECT_EQ(absl::nullopt, cache->lookup("a"));
+  EXPECT_TRUE(cache->lookup("b").has_value());
+}
+
+} // namespace
+} // namespace SessionCache
+} // namespace Tls
+} // namespace TransportSockets
+} // namespace Extensions
+} // namespace Envoy
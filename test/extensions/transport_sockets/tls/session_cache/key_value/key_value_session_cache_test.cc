@@ -0,0 +1,93 @@
+#include "source/extensions/transport_sockets/tls/session_cache/key_value/key_value_session_cache.h"
+
+#include "test/mocks/common.h"
+#include "test/mocks/event/mocks.h"
+#include "test/test_common/simulated_time_system.h"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+using testing::_;
+using testing::Invoke;
+using testing::NiceMock;
+using testing::Optional;
+using testing::Return;
+
+namespace Envoy {
+namespace Extensions {
+namespace TransportSockets {
+namespace Tls {
+namespace SessionCache {
+namespace {
+
+class KeyValueSessionCacheTest : public testing::Test {
+protected:
+  KeyValueSessionCacheTest() { time_system_.setSystemTime(SystemTime(std::chrono::seconds(1000))); }
+
+  std::unique_ptr<KeyValueSessionCache>
+  create(std::vector<std::pair<std::string, std::string>> entries = {}) {
+    auto store = std::make_unique<NiceMock<MockKeyValueStore>>();
+    store_ = store.get();
+    EXPECT_CALL(*store_, iterate(_))
+        .WillOnce(Invoke([entries](KeyValueStore::ConstIterateCb cb) {
+          for (const auto& [key, value] : entries) {
+            cb(key, value);
+          }
+        }));
+    return std::make_unique<KeyValueSessionCache>(std::move(store), 10, dispatcher_,
+                                                  time_system_);
+  }
+
+  Event::SimulatedTimeSystem time_system_;
+  NiceMock<Event::MockDispatcher> dispatcher_;
+  MockKeyValueStore* store_{};
+};
+
+TEST_F(KeyValueSessionCacheTest, WritesThrough) {
+  auto cache = create();
+  // "ab" in hex, and "session" in base64.
+  EXPECT_CALL(*store_, addOrUpdate("6162", "1060:c2Vzc2lvbg==",
+                                   Optional(std::chrono::seconds(60))));
+  cache->insert("ab", "session", std::chrono::seconds(60));
+  EXPECT_THAT(cache->lookup("ab"), Optional(std::string("session")));
+
+  EXPECT_CALL(*store_, remove("6162"));
+  cache->remove("ab");
+  EXPECT_EQ(absl::nullopt, cache->lookup("ab"));
+}
+
+TEST_F(KeyValueSessionCacheTest, LoadsTheStore) {
+  auto cache = create({
+      {"6162", "1060:c2Vzc2lvbg=="},
+      // Expired.
+      {"6364", "900:c2Vzc2lvbg=="},
+      // Invalid.
+      {"zz", "1060:c2Vzc2lvbg=="},
+      {"6566", "c2Vzc2lvbg=="},
+      {"6768", "1060:"},
+  });
+  EXPECT_EQ(1U, cache->size());
+  EXPECT_THAT(cache->lookup("ab"), Optional(std::string("session")));
+
+  // The loaded session expires with its remaining lifetime.
+  time_system_.advanceTimeWait(std::chrono::seconds(61));
+  EXPECT_EQ(absl::nullopt, cache->lookup("ab"));
+}
+
+TEST_F(KeyValueSessionCacheTest, DestroyedOffTheMainThread) {
+  auto cache = create();
+  Event::PostCb destroy_store;
+  EXPECT_CALL(dispatcher_, isThreadSafe()).WillOnce(Return(false));
+  EXPECT_CALL(dispatcher_, post(_)).WillOnce(Invoke([&](Event::PostCb cb) {
+    destroy_store = std::move(cb);
+  }));
+  cache.reset();
+  destroy_store();
+}
+
+} // namespace
+} // namespace SessionCache
+} // namespace Tls
+} // namespace TransportSockets
+} // namespace Extensions
+} // namespace Envoy
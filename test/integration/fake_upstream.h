@@ -234,6 +234,7 @@ public:
   std::list<AccessLog::InstanceSharedPtr> accessLogHandlers() override {
     return access_log_handlers_;
   }
+  Http::HeaderMapArenaSharedPtr headerMapArena() override { return nullptr; }
 
   // Http::StreamCallbacks
   void onResetStream(Http::StreamResetReason reason,
@@ -918,6 +919,7 @@ private:
     }
     Init::Manager& initManager() override { return *init_manager_; }
     bool ignoreGlobalConnLimit() const override { return false; }
+    bool coalesceWrites() const override { return false; }
 
     void setMaxConnections(const uint32_t num_connections) {
       connection_resource_.setMax(num_connections);
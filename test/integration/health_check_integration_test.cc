@@ -551,11 +551,14 @@ public:
 
   // Adds a TCP active health check specifier to the given cluster, and waits for the first health
   // check probe to be received.
-  void initTcpHealthCheck(uint32_t cluster_idx) {
+  void initTcpHealthCheck(uint32_t cluster_idx, uint32_t session_threads = 0) {
     auto& cluster_data = clusters_[cluster_idx];
     auto health_check = addHealthCheck(cluster_data.cluster_);
     health_check->mutable_tcp_health_check()->mutable_send()->set_text("50696E67"); // "Ping"
     health_check->mutable_tcp_health_check()->add_receive()->set_text("506F6E67");  // "Pong"
+    if (session_threads > 0) {
+      health_check->mutable_session_threads()->set_value(session_threads);
+    }
 
     // Introduce the cluster using compareDiscoveryRequest / sendDiscoveryResponse.
     EXPECT_TRUE(compareDiscoveryRequest(Config::TypeUrl::get().Cluster, "", {}, {}, {}, true));
@@ -626,6 +629,20 @@ TEST_P(TcpHealthCheckIntegrationTest, SingleEndpointHealthyTcp) {
   EXPECT_EQ(0, test_server_->counter("cluster.cluster_1.health_check.failure")->value());
 }
 
+// Tests that a healthy endpoint checked from a session thread is reported as healthy.
+TEST_P(TcpHealthCheckIntegrationTest, SingleEndpointHealthyTcpSessionThreads) {
+  const uint32_t cluster_idx = 0;
+  initialize();
+  initTcpHealthCheck(cluster_idx, 1);
+
+  AssertionResult result = clusters_[cluster_idx].host_fake_raw_connection_->write("Pong");
+  RELEASE_ASSERT(result, result.message());
+
+  test_server_->waitForCounterGe("cluster.cluster_1.health_check.success", 1);
+  test_server_->waitForGaugeEq("cluster.cluster_1.membership_healthy", 1);
+  EXPECT_EQ(0, test_server_->counter("cluster.cluster_1.health_check.failure")->value());
+}
+
 // Tests that an invalid response fails the health check.
 TEST_P(TcpHealthCheckIntegrationTest, SingleEndpointWrongResponseTcp) {
   const uint32_t cluster_idx = 0;
@@ -0,0 +1,169 @@
+// Benchmarks of the request path of a whole server, proxying the requests of an in-process client
+// to an in-process upstream over loopback connections.
+//
+// Besides the time of a request, each benchmark reports the request rate of its single
+// connection, and the median and 99th percentile of the request latencies in microseconds. The
+// CPU time is that of the whole process per request, so it includes the work of the server
+// threads, the client and the upstream.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "test/integration/autonomous_upstream.h"
+#include "test/integration/http_integration.h"
+#include "test/integration/ssl_utility.h"
+#include "test/test_common/environment.h"
+
+#include "benchmark/benchmark.h"
+
+namespace Envoy {
+namespace {
+
+class ProxyBenchmark : public HttpIntegrationTest {
+public:
+  ProxyBenchmark(Http::CodecType downstream_protocol, Http::CodecType upstream_protocol)
+      : HttpIntegrationTest(downstream_protocol, TestEnvironment::getIpVersionsForTest()[0]) {
+    autonomous_upstream_ = true;
+    setUpstreamProtocol(upstream_protocol);
+  }
+
+  ~ProxyBenchmark() override { client_ssl_ctx_.reset(); }
+
+  // Terminates TLS on the listener.
+  void enableTls() {
+    config_helper_.addSslConfig();
+    client_ssl_ctx_ = Ssl::createClientSslTransportSocketFactory({}, context_manager_, *api_);
+  }
+
+  // Makes a unary gRPC service of the upstream, behind a few filters besides the router.
+  void enableGrpcFilters() {
+    config_helper_.prependFilter(R"EOF(
+name: envoy.filters.http.grpc_stats
+typed_config:
+  "@type": type.googleapis.com/envoy.extensions.filters.http.grpc_stats.v3.FilterConfig
+  stats_for_all_methods: true
+)EOF");
+    config_helper_.prependFilter("{ name: passthrough-filter }");
+    grpc_ = true;
+  }
+
+  void start() {
+    initialize();
+    const uint32_t port = lookupPort("http");
+    if (client_ssl_ctx_ != nullptr) {
+      codec_client_ = makeHttpConnection(dispatcher_->createClientConnection(
+          Ssl::getSslAddress(version_, port), Network::Address::InstanceConstSharedPtr(),
+          client_ssl_ctx_->createTransportSocket(nullptr, nullptr), nullptr, nullptr));
+    } else {
+      codec_client_ = makeHttpConnection(port);
+    }
+    if (grpc_) {
+      auto& upstream = *static_cast<AutonomousUpstream*>(fake_upstreams_[0].get());
+      upstream.setResponseHeaders(
+          std::make_unique<Http::TestResponseHeaderMapImpl>(Http::TestResponseHeaderMapImpl{
+              {":status", "200"}, {"content-type", "application/grpc"}}));
+      upstream.setResponseTrailers(std::make_unique<Http::TestResponseTrailerMapImpl>(
+          Http::TestResponseTrailerMapImpl{{"grpc-status", "0"}}));
+    }
+  }
+
+  // Sends the requests one after the other on the connection, each once the response of the
+  // previous one ended.
+  void run(::benchmark::State& state, const Http::RequestHeaderMap& headers,
+           const std::string& body) {
+    std::vector<uint64_t> latencies_us;
+    for (auto _ : state) { // NOLINT: Silences warning about dead store
+      const MonotonicTime start = timeSystem().monotonicTime();
+      IntegrationStreamDecoderPtr response =
+          body.empty() ? codec_client_->makeHeaderOnlyRequest(headers)
+                       : codec_client_->makeRequestWithBody(headers, body);
+      RELEASE_ASSERT(response->waitForEndStream(), "timed out waiting for the response");
+      RELEASE_ASSERT(response->headers().getStatusValue() == "200",
+                     std::string(response->headers().getStatusValue()));
+      latencies_us.push_back(std::chrono::duration_cast<std::chrono::microseconds>(
+                                 timeSystem().monotonicTime() - start)
+                                 .count());
+    }
+
+    std::sort(latencies_us.begin(), latencies_us.end());
+    state.counters["rps"] =
+        ::benchmark::Counter(latencies_us.size(), ::benchmark::Counter::kIsRate);
+    if (!latencies_us.empty()) {
+      state.counters["p50_us"] = latencies_us[latencies_us.size() / 2];
+      state.counters["p99_us"] = latencies_us[latencies_us.size() * 99 / 100];
+    }
+  }
+
+private:
+  Network::UpstreamTransportSocketFactoryPtr client_ssl_ctx_;
+  bool grpc_{};
+};
+
+Http::TestRequestHeaderMapImpl requestHeaders() {
+  return Http::TestRequestHeaderMapImpl{{":method", "GET"},
+                                        {":path", "/test/long/url"},
+                                        {":scheme", "http"},
+                                        {":authority", "sni.lyft.com"},
+                                        {"user-agent", "benchmark"},
+                                        {"accept", "*/*"},
+                                        {AutonomousStream::RESPONSE_SIZE_BYTES, "1024"}};
+}
+
+void bmHttp1ToHttp1(::benchmark::State& state) {
+  ProxyBenchmark benchmark(Http::CodecType::HTTP1, Http::CodecType::HTTP1);
+  benchmark.start();
+  benchmark.run(state, requestHeaders(), "");
+}
+BENCHMARK(bmHttp1ToHttp1)
+    ->MeasureProcessCPUTime()
+    ->UseRealTime()
+    ->Unit(::benchmark::kMicrosecond);
+
+void bmHttp2ToHttp2(::benchmark::State& state) {
+  ProxyBenchmark benchmark(Http::CodecType::HTTP2, Http::CodecType::HTTP2);
+  benchmark.start();
+  benchmark.run(state, requestHeaders(), "");
+}
+BENCHMARK(bmHttp2ToHttp2)
+    ->MeasureProcessCPUTime()
+    ->UseRealTime()
+    ->Unit(::benchmark::kMicrosecond);
+
+void bmTlsToHttp1(::benchmark::State& state) {
+  ProxyBenchmark benchmark(Http::CodecType::HTTP1, Http::CodecType::HTTP1);
+  benchmark.enableTls();
+  benchmark.start();
+  Http::TestRequestHeaderMapImpl headers = requestHeaders();
+  headers.setScheme("https");
+  benchmark.run(state, headers, "");
+}
+BENCHMARK(bmTlsToHttp1)
+    ->MeasureProcessCPUTime()
+    ->UseRealTime()
+    ->Unit(::benchmark::kMicrosecond);
+
+void bmGrpcWithFilters(::benchmark::State& state) {
+  ProxyBenchmark benchmark(Http::CodecType::HTTP2, Http::CodecType::HTTP2);
+  benchmark.enableGrpcFilters();
+  benchmark.start();
+
+  Http::TestRequestHeaderMapImpl headers = requestHeaders();
+  headers.setMethod("POST");
+  headers.setPath("/package.Service/Method");
+  headers.setContentType("application/grpc");
+  headers.addCopy("te", "trailers");
+  // A gRPC frame of a 100 bytes message.
+  const std::string body = std::string("\0\0\0\0\x64", 5) + std::string(100, 'a');
+  benchmark.run(state, headers, body);
+}
+BENCHMARK(bmGrpcWithFilters)
+    ->MeasureProcessCPUTime()
+    ->UseRealTime()
+    ->Unit(::benchmark::kMicrosecond);
+
+} // namespace
+} // namespace Envoy
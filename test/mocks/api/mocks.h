@@ -91,9 +91,12 @@ public:
   MOCK_METHOD(SysCallIntResult, recvmmsg,
               (os_fd_t socket, struct mmsghdr* msgvec, unsigned int vlen, int flags,
                struct timespec* timeout));
+  MOCK_METHOD(SysCallIntResult, sendmmsg,
+              (os_fd_t socket, struct mmsghdr* msgvec, unsigned int vlen, int flags));
   MOCK_METHOD(SysCallIntResult, ftruncate, (int fd, off_t length));
   MOCK_METHOD(SysCallPtrResult, mmap,
               (void* addr, size_t length, int prot, int flags, int fd, off_t offset));
+  MOCK_METHOD(SysCallIntResult, munmap, (void* addr, size_t length));
   MOCK_METHOD(SysCallIntResult, stat, (const char* name, struct stat* stat));
   MOCK_METHOD(SysCallIntResult, fstat, (os_fd_t fd, struct stat* stat));
   MOCK_METHOD(SysCallIntResult, chmod, (const std::string& name, mode_t mode));
@@ -142,6 +145,11 @@ class MockLinuxOsSysCalls : public LinuxOsSysCallsImpl {
 public:
   // Api::LinuxOsSysCalls
   MOCK_METHOD(SysCallIntResult, sched_getaffinity, (pid_t pid, size_t cpusetsize, cpu_set_t* mask));
+  MOCK_METHOD(SysCallIntResult, sched_getcpu, ());
+  MOCK_METHOD(SysCallIntResult, pipe2, (os_fd_t pipefd[2], int flags));
+  MOCK_METHOD(SysCallSizeResult, splice,
+              (os_fd_t fd_in, loff_t* off_in, os_fd_t fd_out, loff_t* off_out, size_t len,
+               unsigned int flags));
 };
 #endif
 
@@ -245,6 +245,7 @@ public:
   MOCK_METHOD(void, resetStream,
               (Http::StreamResetReason reset_reason, absl::string_view transport_failure_reason));
   MOCK_METHOD(void, resetIdleTimer, ());
+  MOCK_METHOD(void, disableDataCallbacks, ());
   MOCK_METHOD(Upstream::ClusterInfoConstSharedPtr, clusterInfo, ());
   MOCK_METHOD(Router::RouteConstSharedPtr, route, ());
   MOCK_METHOD(absl::optional<Router::ConfigConstSharedPtr>, routeConfig, ());
@@ -347,6 +348,7 @@ public:
   MOCK_METHOD(void, resetStream,
               (Http::StreamResetReason reset_reason, absl::string_view transport_failure_reason));
   MOCK_METHOD(void, resetIdleTimer, ());
+  MOCK_METHOD(void, disableDataCallbacks, ());
   MOCK_METHOD(Upstream::ClusterInfoConstSharedPtr, clusterInfo, ());
   MOCK_METHOD(Router::RouteConstSharedPtr, route, ());
   MOCK_METHOD(bool, canRequestRouteConfigUpdate, ());
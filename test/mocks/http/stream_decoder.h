@@ -32,6 +32,10 @@ public:
   MOCK_METHOD(void, decodeHeaders_, (RequestHeaderMapSharedPtr & headers, bool end_stream));
   MOCK_METHOD(void, decodeTrailers_, (RequestTrailerMapPtr & trailers));
   MOCK_METHOD(std::list<AccessLog::InstanceSharedPtr>, accessLogHandlers, ());
+  // Not mocked, so that strict mocks do not need to expect it.
+  HeaderMapArenaSharedPtr headerMapArena() override { return header_map_arena_; }
+
+  HeaderMapArenaSharedPtr header_map_arena_;
 };
 
 class MockResponseDecoder : public ResponseDecoder {
@@ -28,6 +28,10 @@ public:
   MOCK_METHOD(IoUringResult, prepareClose, (os_fd_t fd, Request* user_data));
   MOCK_METHOD(IoUringResult, prepareCancel, (Request * cancelling_user_data, Request* user_data));
   MOCK_METHOD(IoUringResult, prepareShutdown, (os_fd_t fd, int how, Request* user_data));
+  MOCK_METHOD(IoUringResult, prepareRecvMultishot, (os_fd_t fd, Request* user_data));
+  MOCK_METHOD(bool, registerProvidedBuffers,
+              (uint8_t * buffers, uint32_t num_buffers, uint32_t buffer_size));
+  MOCK_METHOD(void, recycleProvidedBuffer, (uint16_t buffer_id));
   MOCK_METHOD(IoUringResult, submit, ());
   MOCK_METHOD(void, injectCompletion, (os_fd_t fd, Request* user_data, int32_t result));
   MOCK_METHOD(void, removeInjectedCompletion, (os_fd_t fd));
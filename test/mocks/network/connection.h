@@ -115,6 +115,7 @@ public:
 
   // Network::ServerConnection
   MOCK_METHOD(void, setTransportSocketConnectTimeout, (std::chrono::milliseconds, Stats::Counter&));
+  MOCK_METHOD(void, enableWriteCoalescing, ());
 };
 
 /**
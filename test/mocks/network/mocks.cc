@@ -47,6 +47,7 @@ MockListenerConfig::MockListenerConfig()
   ON_CALL(*this, maxConnectionsToAcceptPerSocketEvent())
       .WillByDefault(Return(Network::DefaultMaxConnectionsToAcceptPerSocketEvent));
   ON_CALL(*this, ignoreGlobalConnLimit()).WillByDefault(Return(false));
+  ON_CALL(*this, coalesceWrites()).WillByDefault(Return(false));
   ON_CALL(*this, bindToPort()).WillByDefault(Return(true));
 }
 MockListenerConfig::~MockListenerConfig() = default;
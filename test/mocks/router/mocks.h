@@ -78,6 +78,14 @@ public:
   const std::vector<Matchers::StringMatcherPtr>& allowOrigins() const override {
     return allow_origins_;
   };
+  bool isOriginAllowed(absl::string_view origin) const override {
+    for (const auto& allow_origin : allow_origins_) {
+      if (allow_origin->match("*") || allow_origin->match(origin)) {
+        return true;
+      }
+    }
+    return false;
+  }
   const std::string& allowMethods() const override { return allow_methods_; };
   const std::string& allowHeaders() const override { return allow_headers_; };
   const std::string& exposeHeaders() const override { return expose_headers_; };
@@ -40,8 +40,11 @@ public:
   MOCK_METHOD(bool, logFormatEscaped, (), (const));
   MOCK_METHOD(bool, enableFineGrainLogging, (), (const));
   MOCK_METHOD(const std::string&, logPath, (), (const));
+  MOCK_METHOD(uint32_t, logAsyncBufferSizeKb, (), (const));
   MOCK_METHOD(uint64_t, restartEpoch, (), (const));
   MOCK_METHOD(std::chrono::milliseconds, fileFlushIntervalMsec, (), (const));
+  MOCK_METHOD(uint32_t, fileFlushMinSizeKb, (), (const));
+  MOCK_METHOD(uint32_t, fileMaxBufferedSizeKb, (), (const));
   MOCK_METHOD(Mode, mode, (), (const));
   MOCK_METHOD(const std::string&, serviceClusterName, (), (const));
   MOCK_METHOD(const std::string&, serviceNodeName, (), (const));
@@ -51,6 +54,7 @@ public:
   MOCK_METHOD(bool, mutexTracingEnabled, (), (const));
   MOCK_METHOD(bool, coreDumpEnabled, (), (const));
   MOCK_METHOD(bool, cpusetThreadsEnabled, (), (const));
+  MOCK_METHOD(bool, pinWorkerThreadsEnabled, (), (const));
   MOCK_METHOD(const std::vector<std::string>&, disabledExtensions, (), (const));
   MOCK_METHOD(Server::CommandLineOptionsPtr, toCommandLineOptions, (), (const));
   MOCK_METHOD(const std::string&, socketPath, (), (const));
@@ -71,12 +75,14 @@ public:
   spdlog::level::level_enum log_level_{spdlog::level::trace};
   std::string log_path_;
   uint32_t concurrency_{1};
+  uint32_t file_flush_min_size_kb_{64};
   uint64_t hot_restart_epoch_{};
   bool hot_restart_disabled_{};
   bool signal_handling_enabled_{true};
   bool mutex_tracing_enabled_{};
   bool core_dump_enabled_{};
   bool cpuset_threads_enabled_{};
+  bool pin_worker_threads_enabled_{};
   std::vector<std::string> disabled_extensions_;
   std::string socket_path_;
   mode_t socket_mode_;
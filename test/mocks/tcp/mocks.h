@@ -42,6 +42,7 @@ public:
 
   // Tcp::ConnectionPool::ConnectionData
   MOCK_METHOD(Network::ClientConnection&, connection, ());
+  MOCK_METHOD(const Network::Socket*, socket, ());
   MOCK_METHOD(void, addUpstreamCallbacks, (ConnectionPool::UpstreamCallbacks&));
   void setConnectionState(ConnectionStatePtr&& state) override { setConnectionState_(state); }
   MOCK_METHOD(ConnectionPool::ConnectionState*, connectionState, ());
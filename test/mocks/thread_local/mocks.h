@@ -27,6 +27,14 @@ public:
   MOCK_METHOD(void, shutdownThread, ());
   MOCK_METHOD(Event::Dispatcher&, dispatcher, ());
   bool isShutdown() const override { return shutdown_; }
+  ScopedBatch batchUpdates(std::function<void()> complete_cb) override {
+    // The updates run right away, so the batch is complete once it ends.
+    return std::make_unique<Cleanup>([complete_cb]() {
+      if (complete_cb) {
+        complete_cb();
+      }
+    });
+  }
 
   SlotPtr allocateSlotMock() { return SlotPtr{new SlotImpl(*this, current_slot_++)}; }
   void runOnAllThreads1(std::function<void()> cb) { cb(); }
@@ -110,6 +110,7 @@ MockClusterInfo::MockClusterInfo()
       .WillByDefault(
           Invoke([this]() -> TransportSocketMatcher& { return *transport_socket_matcher_; }));
   ON_CALL(*this, loadReportStats()).WillByDefault(ReturnRef(load_report_stats_));
+  ON_CALL(*this, localityLoadStats()).WillByDefault(ReturnRef(locality_load_stats_));
   ON_CALL(*this, requestResponseSizeStats())
       .WillByDefault(Return(
           std::reference_wrapper<ClusterRequestResponseSizeStats>(*request_response_size_stats_)));
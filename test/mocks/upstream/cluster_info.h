@@ -109,6 +109,7 @@ public:
               (const));
   MOCK_METHOD(float, perUpstreamPreconnectRatio, (), (const));
   MOCK_METHOD(float, peekaheadRatio, (), (const));
+  MOCK_METHOD(uint32_t, maxAdaptivePreconnectConnections, (), (const));
   MOCK_METHOD(uint32_t, perConnectionBufferLimitBytes, (), (const));
   MOCK_METHOD(uint64_t, features, (), (const));
   MOCK_METHOD(const Http::Http1Settings&, http1Settings, (), (const));
@@ -139,6 +140,7 @@ public:
   MOCK_METHOD(ClusterConfigUpdateStats&, configUpdateStats, (), (const));
   MOCK_METHOD(Stats::Scope&, statsScope, (), (const));
   MOCK_METHOD(ClusterLoadReportStats&, loadReportStats, (), (const));
+  MOCK_METHOD(LocalityLoadStatsMap&, localityLoadStats, (), (const));
   MOCK_METHOD(ClusterRequestResponseSizeStatsOptRef, requestResponseSizeStats, (), (const));
   MOCK_METHOD(ClusterTimeoutBudgetStatsOptRef, timeoutBudgetStats, (), (const));
   MOCK_METHOD(bool, perEndpointStatsEnabled, (), (const));
@@ -203,6 +205,7 @@ public:
   Upstream::TransportSocketMatcherPtr transport_socket_matcher_;
   NiceMock<Stats::MockIsolatedStatsStore> load_report_stats_store_;
   ClusterLoadReportStats load_report_stats_;
+  LocalityLoadStatsMapImpl locality_load_stats_;
   NiceMock<Stats::MockIsolatedStatsStore> request_response_size_stats_store_;
   ClusterRequestResponseSizeStatsPtr request_response_size_stats_;
   NiceMock<Stats::MockIsolatedStatsStore> timeout_budget_stats_store_;
@@ -42,6 +42,7 @@ MockHostDescription::MockHostDescription()
   ON_CALL(*this, cluster()).WillByDefault(ReturnRef(cluster_));
   ON_CALL(*this, healthChecker()).WillByDefault(ReturnRef(health_checker_));
   ON_CALL(*this, transportSocketFactory()).WillByDefault(ReturnRef(*socket_factory_));
+  ON_CALL(*this, lbPolicyData()).WillByDefault(ReturnRef(lb_policy_data_));
   ON_CALL(*this, canCreateConnection(_))
       .WillByDefault(Invoke([this](Upstream::ResourcePriority pri) -> bool {
         return cluster().resourceManager(pri).connections().canCreate();
@@ -60,6 +61,7 @@ MockHost::MockHost() : socket_factory_(new testing::NiceMock<Network::MockTransp
   ON_CALL(*this, loadMetricStats()).WillByDefault(ReturnRef(load_metric_stats_));
   ON_CALL(*this, warmed()).WillByDefault(Return(true));
   ON_CALL(*this, transportSocketFactory()).WillByDefault(ReturnRef(*socket_factory_));
+  ON_CALL(*this, lbPolicyData()).WillByDefault(ReturnRef(lb_policy_data_));
 }
 
 MockHost::~MockHost() = default;
@@ -150,6 +150,9 @@ TEST_P(AdminInstanceTest, Help) {
       name_regex: Dump only the currently loaded configurations whose names match the specified regex. Can be used with both resource and mask query parameters.
       include_eds: Dump currently loaded configuration including EDS. See the response definition for more information
   /contention: dump current Envoy mutex contention stats (if enabled)
+  /continuousprofiler (POST): enable/disable the continuous CPU profiler
+      enable: enables the continuous CPU profiler; One of (y, n)
+      frequency: the number of samples per second of CPU time, 19 by default
   /cpuprofiler (POST): enable/disable the CPU profiler
       enable: enables the CPU profiler; One of (y, n)
   /drain_listeners (POST): drain listeners
@@ -171,6 +174,7 @@ TEST_P(AdminInstanceTest, Help) {
       paths: Change multiple logging levels by setting to <logger_name1>:<desired_level1>,<logger_name2>:<desired_level2>. If fine grain logging is enabled, use __FILE__ or a glob experision as the logger name. For example, source/common*:warning
       level: desired logging level, this will change all loggers's level; One of (, trace, debug, info, warning, error, critical, off)
   /memory: print current allocation/heap usage
+  /profile/continuous: dump the samples of the continuous CPU profiler
   /quitquitquit (POST): exit the server
   /ready: print server state, return 200 if LIVE, otherwise return 503
   /reopen_logs (POST): reopen access logs
@@ -1,4 +1,5 @@
 #include "source/common/profiler/profiler.h"
+#include "source/common/profiler/sampling_profiler.h"
 
 #include "test/server/admin/admin_instance.h"
 #include "test/test_common/logging.h"
@@ -77,6 +78,46 @@ TEST_P(AdminInstanceTest, AdminBadProfiler) {
   EXPECT_FALSE(Profiler::Cpu::profilerEnabled());
 }
 
+TEST_P(AdminInstanceTest, AdminContinuousProfiler) {
+  Buffer::OwnedImpl data;
+  Http::TestResponseHeaderMapImpl header_map;
+
+  EXPECT_EQ(Http::Code::BadRequest, postCallback("/continuousprofiler", header_map, data));
+  EXPECT_EQ(Http::Code::BadRequest,
+            postCallback("/continuousprofiler?enable=y&frequency=0", header_map, data));
+  EXPECT_EQ(Http::Code::BadRequest,
+            postCallback("/continuousprofiler?enable=y&other=1", header_map, data));
+  EXPECT_FALSE(Profiler::SamplingProfiler::started());
+  EXPECT_EQ(Http::Code::BadRequest, getCallback("/profile/continuous", header_map, data));
+
+#ifdef __linux__
+  EXPECT_EQ(Http::Code::OK,
+            postCallback("/continuousprofiler?enable=y&frequency=1000", header_map, data));
+  EXPECT_TRUE(Profiler::SamplingProfiler::started());
+  // The CPU profiler of gperftools can't be started at the same time.
+  EXPECT_EQ(Http::Code::BadRequest, postCallback("/cpuprofiler?enable=y", header_map, data));
+
+  // The legacy CPU profile of gperftools starts with its header.
+  data.drain(data.length());
+  EXPECT_EQ(Http::Code::OK, getCallback("/profile/continuous", header_map, data));
+  ASSERT_GE(data.length(), 5 * sizeof(uintptr_t));
+  uintptr_t header[5];
+  data.copyOut(0, sizeof(header), header);
+  EXPECT_EQ(0, header[0]);
+  EXPECT_EQ(3, header[1]);
+  EXPECT_EQ(0, header[2]);
+  EXPECT_EQ(1000, header[3]);
+  EXPECT_EQ(0, header[4]);
+#else
+  EXPECT_EQ(Http::Code::InternalServerError,
+            postCallback("/continuousprofiler?enable=y", header_map, data));
+#endif
+
+  EXPECT_EQ(Http::Code::OK, postCallback("/continuousprofiler?enable=n", header_map, data));
+  EXPECT_FALSE(Profiler::SamplingProfiler::started());
+  EXPECT_EQ(Http::Code::BadRequest, getCallback("/profile/continuous", header_map, data));
+}
+
 TEST_P(AdminInstanceTest, AdminHeapDump) {
   Buffer::OwnedImpl data;
   Http::TestResponseHeaderMapImpl header_map;
@@ -12,6 +12,7 @@
 #include "test/test_common/stats_utility.h"
 #include "test/test_common/utility.h"
 
+using testing::ElementsAre;
 using testing::NiceMock;
 using testing::ReturnRef;
 
@@ -366,6 +367,44 @@ envoy_cluster_default_total_match_count{envoy_cluster_name="x"} 0
   EXPECT_EQ(expected_output, response.toString());
 }
 
+TEST_F(PrometheusStatsFormatterTest, StreamedInChunksOfGroups) {
+  Stats::CustomStatNamespacesImpl custom_namespaces;
+  Stats::ThreadLocalStoreImpl store(alloc_);
+  envoy::config::metrics::v3::StatsConfig stats_config;
+  const Stats::TagVector tags;
+  store.setTagProducer(Stats::TagProducerImpl::createTagProducer(stats_config, tags).value());
+  Stats::ScopeSharedPtr scope1 = store.rootScope()->createScope("cluster.a");
+  Stats::ScopeSharedPtr scope2 = store.rootScope()->createScope("cluster.x");
+  for (const Stats::ScopeSharedPtr& scope : {scope1, scope2}) {
+    scope->counterFromStatName(makeStat("upstream_cx_total")).inc();
+    scope->gaugeFromStatName(makeStat("upstream_cx_active"), Stats::Gauge::ImportMode::Accumulate)
+        .set(2);
+  }
+
+  // Each chunk ends with the group which reached the chunk size.
+  PrometheusStatsRequest request(store, StatsParams(), endpoints_helper_->cm_, custom_namespaces);
+  request.setChunkSize(1);
+  Http::TestResponseHeaderMapImpl response_headers;
+  EXPECT_EQ(Http::Code::OK, request.start(response_headers));
+  std::vector<std::string> chunks;
+  bool more_data;
+  do {
+    Buffer::OwnedImpl response;
+    more_data = request.nextChunk(response);
+    chunks.push_back(response.toString());
+  } while (more_data);
+
+  EXPECT_THAT(chunks, ElementsAre(R"EOF(# TYPE envoy_cluster_upstream_cx_total counter
+envoy_cluster_upstream_cx_total{envoy_cluster_name="a"} 1
+envoy_cluster_upstream_cx_total{envoy_cluster_name="x"} 1
+)EOF",
+                                  R"EOF(# TYPE envoy_cluster_upstream_cx_active gauge
+envoy_cluster_upstream_cx_active{envoy_cluster_name="a"} 2
+envoy_cluster_upstream_cx_active{envoy_cluster_name="x"} 2
+)EOF",
+                                  ""));
+}
+
 TEST_F(PrometheusStatsFormatterTest, HistogramWithNonDefaultBuckets) {
   Stats::CustomStatNamespacesImpl custom_namespaces;
   HistogramWrapper h1_cumulative;
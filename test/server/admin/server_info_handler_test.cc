@@ -1,5 +1,6 @@
 #include "envoy/admin/v3/memory.pb.h"
 
+#include "source/common/memory/accounting.h"
 #include "source/common/tls/context_config_impl.h"
 
 #include "test/server/admin/admin_instance.h"
@@ -61,6 +62,9 @@ TEST_P(AdminInstanceTest, Memory) {
                                   Property(&envoy::admin::v3::Memory::pageheap_unmapped, Ge(0)),
                                   Property(&envoy::admin::v3::Memory::pageheap_free, Ge(0)),
                                   Property(&envoy::admin::v3::Memory::total_thread_cache, Ge(0))));
+  EXPECT_EQ(Memory::Accounting::NumSubsystems,
+            static_cast<size_t>(output_proto.subsystems().size()));
+  EXPECT_TRUE(output_proto.subsystems().contains("header_maps"));
 }
 
 TEST_P(AdminInstanceTest, GetReadyRequest) {
@@ -180,6 +180,7 @@ public:
     }
     Init::Manager& initManager() override { return *init_manager_; }
     bool ignoreGlobalConnLimit() const override { return ignore_global_conn_limit_; }
+    bool coalesceWrites() const override { return false; }
     bool shouldBypassOverloadManager() const override { return false; }
     void setMaxConnections(const uint32_t num_connections) {
       open_connections_.setMax(num_connections);
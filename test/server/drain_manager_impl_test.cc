@@ -199,6 +199,41 @@ TEST_P(DrainManagerImplTest, DrainDeadlineProbability) {
   }
 }
 
+// Test that the drain closes are paced to the maximum rate per worker until the drain deadline.
+TEST_F(DrainManagerImplTest, DrainCloseMaxRate) {
+  ON_CALL(server_.options_, drainStrategy()).WillByDefault(Return(Server::DrainStrategy::Gradual));
+  ON_CALL(server_.options_, concurrency()).WillByDefault(Return(2));
+  ON_CALL(server_.runtime_loader_.snapshot_,
+          getInteger("server.drain_max_closes_per_second_per_worker", 0))
+      .WillByDefault(Return(1));
+  ON_CALL(server_.api_.random_, random()).WillByDefault(Return(0));
+  EXPECT_CALL(server_, healthCheckFailed()).WillRepeatedly(Return(false));
+
+  DrainManagerImpl drain_manager(server_, envoy::config::listener::v3::Listener::DEFAULT,
+                                 server_.dispatcher());
+  drain_manager.startDrainSequence([] {});
+  simTime().advanceTimeWait(std::chrono::seconds(1));
+
+  // Two workers closing one connection per second each, so one close every 500ms.
+  EXPECT_TRUE(drain_manager.drainClose());
+  EXPECT_FALSE(drain_manager.drainClose());
+  simTime().advanceTimeWait(std::chrono::milliseconds(499));
+  EXPECT_FALSE(drain_manager.drainClose());
+  simTime().advanceTimeWait(std::chrono::milliseconds(1));
+  EXPECT_TRUE(drain_manager.drainClose());
+  EXPECT_FALSE(drain_manager.drainClose());
+
+  // The turns not taken aren't saved for later.
+  simTime().advanceTimeWait(std::chrono::seconds(10));
+  EXPECT_TRUE(drain_manager.drainClose());
+  EXPECT_FALSE(drain_manager.drainClose());
+
+  // Every connection is closed from the drain deadline on.
+  simTime().advanceTimeWait(std::chrono::seconds(DrainTimeSeconds));
+  EXPECT_TRUE(drain_manager.drainClose());
+  EXPECT_TRUE(drain_manager.drainClose());
+}
+
 TEST_P(DrainManagerImplTest, OnDrainCallbacks) {
   constexpr int num_cbs = 20;
   const bool drain_gradually = GetParam();
@@ -277,6 +277,61 @@ TEST_F(HotRestartingChildTest, ForwardsPacketToRegisteredListenerOnMatch) {
   EXPECT_LOG_NOT_CONTAINS("error", "", fake_parent_->sendUdpForwardingMessage(msg));
 }
 
+// Returns a recvmsg() action receiving the reply, with the fds as control data.
+std::function<Api::SysCallSizeResult(int, msghdr*, int)>
+receiveReply(const HotRestartMessage& reply, std::vector<int> fds) {
+  return [reply, fds](int, msghdr* msg, int) {
+    const uint64_t size = reply.ByteSizeLong();
+    *reinterpret_cast<uint64_t*>(msg->msg_iov[0].iov_base) = htobe64(size);
+    reply.SerializeToArray(static_cast<uint8_t*>(msg->msg_iov[0].iov_base) + sizeof(uint64_t),
+                           size);
+    if (fds.empty()) {
+      msg->msg_controllen = 0;
+    } else {
+      cmsghdr* cmsg = CMSG_FIRSTHDR(msg);
+      cmsg->cmsg_level = SOL_SOCKET;
+      cmsg->cmsg_type = SCM_RIGHTS;
+      cmsg->cmsg_len = CMSG_LEN(sizeof(int) * fds.size());
+      memcpy(CMSG_DATA(cmsg), fds.data(), sizeof(int) * fds.size());
+      msg->msg_controllen = CMSG_SPACE(sizeof(int) * fds.size());
+    }
+    msg->msg_flags = 0;
+    return Api::SysCallSizeResult{static_cast<ssize_t>(sizeof(uint64_t) + size), 0};
+  };
+}
+
+TEST_F(HotRestartingChildTest, DuplicatesParentListenSocketsPassedAtOnce) {
+  HotRestartMessage reply;
+  for (uint32_t worker_index : {0, 1}) {
+    auto* socket = reply.mutable_reply()->mutable_pass_listen_sockets()->add_sockets();
+    socket->set_address("tcp://127.0.0.1:80");
+    socket->set_worker_index(worker_index);
+  }
+  // The sockets are all asked for by the first call.
+  EXPECT_CALL(os_sys_calls_, sendmsg(_, _, _)).WillOnce([](int, const msghdr* msg, int) {
+    return Api::SysCallSizeResult{static_cast<ssize_t>(msg->msg_iov[0].iov_len), 0};
+  });
+  EXPECT_CALL(os_sys_calls_, recvmsg(_, _, _)).WillOnce(receiveReply(reply, {100, 101}));
+  EXPECT_EQ(101, hot_restarting_child_->duplicateParentListenSocket("tcp://127.0.0.1:80", 1));
+  EXPECT_EQ(100, hot_restarting_child_->duplicateParentListenSocket("tcp://127.0.0.1:80", 0));
+}
+
+TEST_F(HotRestartingChildTest, DuplicatesParentListenSocketAloneFromOlderParent) {
+  HotRestartMessage unrecognized;
+  unrecognized.set_didnt_recognize_your_last_message(true);
+  HotRestartMessage reply;
+  reply.mutable_reply()->mutable_pass_listen_socket()->set_fd(0);
+  EXPECT_CALL(os_sys_calls_, sendmsg(_, _, _))
+      .Times(2)
+      .WillRepeatedly([](int, const msghdr* msg, int) {
+        return Api::SysCallSizeResult{static_cast<ssize_t>(msg->msg_iov[0].iov_len), 0};
+      });
+  EXPECT_CALL(os_sys_calls_, recvmsg(_, _, _))
+      .WillOnce(receiveReply(unrecognized, {}))
+      .WillOnce(receiveReply(reply, {100}));
+  EXPECT_EQ(100, hot_restarting_child_->duplicateParentListenSocket("tcp://127.0.0.1:80", 0));
+}
+
 } // namespace
 } // namespace Server
 } // namespace Envoy
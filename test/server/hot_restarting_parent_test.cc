@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <memory>
 
 #include "source/common/network/address_impl.h"
@@ -218,6 +219,47 @@ TEST_F(HotRestartingParentTest, GetListenSocketsForChildUnixDomainSocket) {
   EXPECT_EQ(0, message.reply().pass_listen_socket().fd());
 }
 
+TEST_F(HotRestartingParentTest, GetAllListenSocketsForChild) {
+  Network::SocketSharedPtr socket = std::make_shared<NiceMock<Network::MockListenSocket>>();
+  MockListenerManager listener_manager;
+  Network::MockListenerConfig listener_config;
+  MockOptions options;
+  std::vector<std::reference_wrapper<Network::ListenerConfig>> listeners;
+  listeners.push_back(std::ref(*static_cast<Network::ListenerConfig*>(&listener_config)));
+  auto* socket_factory =
+      static_cast<Network::MockListenSocketFactory*>(listener_config.socket_factories_[0].get());
+
+  EXPECT_CALL(server_, listenerManager()).WillRepeatedly(ReturnRef(listener_manager));
+  EXPECT_CALL(listener_manager, listeners(ListenerManager::ListenerState::ACTIVE))
+      .WillRepeatedly(Return(listeners));
+  EXPECT_CALL(listener_config, bindToPort()).WillRepeatedly(Return(true));
+  EXPECT_CALL(*socket_factory, localAddress()).WillRepeatedly(ReturnRef(ipv4_test_addr_1_));
+  EXPECT_CALL(*socket_factory, socketType())
+      .WillRepeatedly(Return(Network::Socket::Type::Stream));
+  EXPECT_CALL(*socket_factory, getListenSocket(_)).WillRepeatedly(Return(socket));
+  EXPECT_CALL(server_, options()).WillRepeatedly(ReturnRef(options));
+  // One more worker than the sockets fitting one reply.
+  EXPECT_CALL(options, concurrency()).WillRepeatedly(Return(RpcStream::MaxPassedFds + 1));
+
+  HotRestartMessage::Request request;
+  request.mutable_pass_listen_sockets();
+  HotRestartMessage message = hot_restarting_parent_.getAllListenSocketsForChild(request);
+  const auto& reply = message.reply().pass_listen_sockets();
+  ASSERT_EQ(RpcStream::MaxPassedFds, reply.sockets_size());
+  EXPECT_EQ("tcp://127.0.0.1:12345", reply.sockets(0).address());
+  EXPECT_EQ(0, reply.sockets(0).worker_index());
+  EXPECT_EQ(1, reply.sockets(1).worker_index());
+  EXPECT_EQ(0, reply.sockets(0).fd());
+  EXPECT_EQ(RpcStream::MaxPassedFds, reply.next());
+
+  request.mutable_pass_listen_sockets()->set_start(reply.next());
+  message = hot_restarting_parent_.getAllListenSocketsForChild(request);
+  ASSERT_EQ(1, message.reply().pass_listen_sockets().sockets_size());
+  EXPECT_EQ(RpcStream::MaxPassedFds,
+            message.reply().pass_listen_sockets().sockets(0).worker_index());
+  EXPECT_EQ(0, message.reply().pass_listen_sockets().next());
+}
+
 TEST_F(HotRestartingParentTest, ExportStatsToChild) {
   Stats::TestUtil::TestStore store;
   MockListenerManager listener_manager;
@@ -308,6 +350,61 @@ TEST_F(HotRestartingParentTest, RetainDynamicStats) {
   }
 }
 
+TEST_F(HotRestartingParentTest, RetainDynamicStatsPacked) {
+  MockListenerManager listener_manager;
+  Stats::SymbolTableImpl parent_symbol_table;
+  Stats::TestUtil::TestStore parent_store(parent_symbol_table);
+
+  EXPECT_CALL(server_, listenerManager()).WillRepeatedly(ReturnRef(listener_manager));
+  EXPECT_CALL(listener_manager, numConnections()).WillRepeatedly(Return(0));
+  EXPECT_CALL(server_, stats()).WillRepeatedly(ReturnRef(parent_store));
+
+  HotRestartMessage::Reply::Stats stats_proto;
+  {
+    Stats::StatNameDynamicPool dynamic(parent_store.symbolTable());
+    Stats::StatNamePool symbolic(parent_store.symbolTable());
+    parent_store.counter("a.c1").inc();
+    parent_store.counter("a.unchanged");
+    const Stats::SymbolTable::StoragePtr c2_name = parent_store.symbolTable().join(
+        {symbolic.add("a"), dynamic.add("d.e"), symbolic.add("c2")});
+    parent_store.rootScope()->counterFromStatName(Stats::StatName(c2_name.get())).add(2);
+    parent_store.gauge("a.g1", Stats::Gauge::ImportMode::Accumulate).set(123);
+    parent_store.rootScope()
+        ->gaugeFromStatName(dynamic.add("g2"), Stats::Gauge::ImportMode::Accumulate)
+        .set(42);
+    hot_restarting_parent_.exportPackedStatsToChild(&stats_proto);
+  }
+  EXPECT_TRUE(stats_proto.counter_deltas().empty());
+  EXPECT_TRUE(stats_proto.gauges().empty());
+  // The tokens shared by the names are sent once.
+  EXPECT_EQ(1, std::count(stats_proto.packed_stats().symbols().begin(),
+                          stats_proto.packed_stats().symbols().end(), "a"));
+  EXPECT_EQ(2, stats_proto.packed_stats().dynamics_size());
+
+  {
+    Stats::SymbolTableImpl child_symbol_table;
+    Stats::TestUtil::TestStore child_store(child_symbol_table);
+    Stats::StatNameDynamicPool dynamic(child_store.symbolTable());
+    Stats::StatNamePool symbolic(child_store.symbolTable());
+    Stats::Counter& c1 = child_store.counter("a.c1");
+    const Stats::SymbolTable::StoragePtr c2_name = child_store.symbolTable().join(
+        {symbolic.add("a"), dynamic.add("d.e"), symbolic.add("c2")});
+    Stats::Counter& c2 =
+        child_store.rootScope()->counterFromStatName(Stats::StatName(c2_name.get()));
+    Stats::Gauge& g1 = child_store.gauge("a.g1", Stats::Gauge::ImportMode::Accumulate);
+    Stats::Gauge& g2 = child_store.rootScope()->gaugeFromStatName(
+        dynamic.add("g2"), Stats::Gauge::ImportMode::Accumulate);
+
+    HotRestartingChild hot_restarting_child(0, 0, testDomainSocketName(), 0, false, false);
+    hot_restarting_child.mergeParentStats(child_store, stats_proto);
+    EXPECT_EQ(1, c1.value());
+    EXPECT_EQ(2, c2.value());
+    EXPECT_EQ(123, g1.value());
+    EXPECT_EQ(42, g2.value());
+    EXPECT_FALSE(child_store.findCounterByString("a.unchanged").has_value());
+  }
+}
+
 MATCHER_P(UdpPacketHandlerPtrIs, expected_handler, "") {
   bool matched = arg->non_dispatched_udp_packet_handler_.ptr() == expected_handler;
   if (!matched) {
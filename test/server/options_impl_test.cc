@@ -95,13 +95,15 @@ TEST_F(OptionsImplTest, All) {
       "envoy --mode validate --concurrency 2 -c hello --admin-address-path path --restart-epoch 0 "
       "--local-address-ip-version v6 -l info --component-log-level upstream:debug,connection:trace "
       "--service-cluster cluster --service-node node --service-zone zone "
-      "--file-flush-interval-msec 9000 "
+      "--file-flush-interval-msec 9000 --file-flush-min-size-kb 16 "
+      "--file-max-buffered-size-kb 1024 "
       "--skip-hot-restart-on-no-parent "
       "--skip-hot-restart-parent-stats "
       "--drain-time-s 60 --log-format [%v] --enable-fine-grain-logging --parent-shutdown-time-s 90 "
       "--log-path "
       "/foo/bar "
-      "--disable-hot-restart --cpuset-threads --allow-unknown-static-fields "
+      "--log-async-buffer-size-kb 32 "
+      "--disable-hot-restart --cpuset-threads --pin-worker-threads --allow-unknown-static-fields "
       "--reject-unknown-dynamic-fields --base-id 5 "
       "--use-dynamic-base-id --base-id-path /foo/baz "
       "--stats-tag foo:bar --stats-tag baz:bar "
@@ -119,15 +121,19 @@ TEST_F(OptionsImplTest, All) {
   EXPECT_TRUE(options->skipHotRestartParentStats());
   EXPECT_TRUE(options->skipHotRestartOnNoParent());
   EXPECT_EQ("/foo/bar", options->logPath());
+  EXPECT_EQ(32U, options->logAsyncBufferSizeKb());
   EXPECT_EQ(true, options->enableFineGrainLogging());
   EXPECT_EQ("cluster", options->serviceClusterName());
   EXPECT_EQ("node", options->serviceNodeName());
   EXPECT_EQ("zone", options->serviceZone());
   EXPECT_EQ(std::chrono::milliseconds(9000), options->fileFlushIntervalMsec());
+  EXPECT_EQ(16U, options->fileFlushMinSizeKb());
+  EXPECT_EQ(1024U, options->fileMaxBufferedSizeKb());
   EXPECT_EQ(std::chrono::seconds(60), options->drainTime());
   EXPECT_EQ(std::chrono::seconds(90), options->parentShutdownTime());
   EXPECT_TRUE(options->hotRestartDisabled());
   EXPECT_TRUE(options->cpusetThreadsEnabled());
+  EXPECT_TRUE(options->pinWorkerThreadsEnabled());
   EXPECT_TRUE(options->allowUnknownStaticFields());
   EXPECT_TRUE(options->rejectUnknownDynamicFields());
   EXPECT_EQ(5U, options->baseId());
@@ -166,6 +172,7 @@ TEST_F(OptionsImplTest, SetAll) {
   bool hot_restart_disabled = options->hotRestartDisabled();
   bool signal_handling_enabled = options->signalHandlingEnabled();
   bool cpuset_threads_enabled = options->cpusetThreadsEnabled();
+  bool pin_worker_threads_enabled = options->pinWorkerThreadsEnabled();
 
   options->setBaseId(109876);
   options->setUseDynamicBaseId(true);
@@ -186,6 +193,8 @@ TEST_F(OptionsImplTest, SetAll) {
   options->setLogPath("/foo/bar");
   options->setRestartEpoch(44);
   options->setFileFlushIntervalMsec(std::chrono::milliseconds(45));
+  options->setFileFlushMinSizeKb(46);
+  options->setFileMaxBufferedSizeKb(47);
   options->setMode(Server::Mode::Validate);
   options->setServiceClusterName("cluster_foo");
   options->setServiceNodeName("node_foo");
@@ -193,6 +202,7 @@ TEST_F(OptionsImplTest, SetAll) {
   options->setHotRestartDisabled(!options->hotRestartDisabled());
   options->setSignalHandling(!options->signalHandlingEnabled());
   options->setCpusetThreads(!options->cpusetThreadsEnabled());
+  options->setPinWorkerThreads(!options->pinWorkerThreadsEnabled());
   options->setAllowUnknownFields(true);
   options->setRejectUnknownFieldsDynamic(true);
   options->setSocketPath("/foo/envoy_domain_socket");
@@ -219,6 +229,8 @@ TEST_F(OptionsImplTest, SetAll) {
   EXPECT_EQ(std::chrono::seconds(43), options->parentShutdownTime());
   EXPECT_EQ(44, options->restartEpoch());
   EXPECT_EQ(std::chrono::milliseconds(45), options->fileFlushIntervalMsec());
+  EXPECT_EQ(46U, options->fileFlushMinSizeKb());
+  EXPECT_EQ(47U, options->fileMaxBufferedSizeKb());
   EXPECT_EQ(Server::Mode::Validate, options->mode());
   EXPECT_EQ("cluster_foo", options->serviceClusterName());
   EXPECT_EQ("node_foo", options->serviceNodeName());
@@ -226,6 +238,7 @@ TEST_F(OptionsImplTest, SetAll) {
   EXPECT_EQ(!hot_restart_disabled, options->hotRestartDisabled());
   EXPECT_EQ(!signal_handling_enabled, options->signalHandlingEnabled());
   EXPECT_EQ(!cpuset_threads_enabled, options->cpusetThreadsEnabled());
+  EXPECT_EQ(!pin_worker_threads_enabled, options->pinWorkerThreadsEnabled());
   EXPECT_TRUE(options->allowUnknownStaticFields());
   EXPECT_TRUE(options->rejectUnknownDynamicFields());
   EXPECT_EQ("/foo/envoy_domain_socket", options->socketPath());
@@ -249,9 +262,12 @@ TEST_F(OptionsImplTest, SetAll) {
   EXPECT_EQ(spdlog::level::to_string_view(options->logLevel()), command_line_options->log_level());
   EXPECT_EQ(options->logFormat(), command_line_options->log_format());
   EXPECT_EQ(options->logPath(), command_line_options->log_path());
+  EXPECT_EQ(options->logAsyncBufferSizeKb(), command_line_options->log_async_buffer_size_kb());
   EXPECT_EQ(options->restartEpoch(), command_line_options->restart_epoch());
   EXPECT_EQ(options->fileFlushIntervalMsec().count() / 1000,
             command_line_options->file_flush_interval().seconds());
+  EXPECT_EQ(options->fileFlushMinSizeKb(), command_line_options->file_flush_min_size_kb());
+  EXPECT_EQ(options->fileMaxBufferedSizeKb(), command_line_options->file_max_buffered_size_kb());
   EXPECT_EQ(envoy::admin::v3::CommandLineOptions::Validate, command_line_options->mode());
   EXPECT_EQ(options->serviceClusterName(), command_line_options->service_cluster());
   EXPECT_EQ(options->serviceNodeName(), command_line_options->service_node());
@@ -260,6 +276,7 @@ TEST_F(OptionsImplTest, SetAll) {
   EXPECT_EQ(options->mutexTracingEnabled(), command_line_options->enable_mutex_tracing());
   EXPECT_EQ(options->coreDumpEnabled(), command_line_options->enable_core_dump());
   EXPECT_EQ(options->cpusetThreadsEnabled(), command_line_options->cpuset_threads());
+  EXPECT_EQ(options->pinWorkerThreadsEnabled(), command_line_options->pin_worker_threads());
   EXPECT_EQ(options->socketPath(), command_line_options->socket_path());
   EXPECT_EQ(options->socketMode(), command_line_options->socket_mode());
   EXPECT_EQ(1U, command_line_options->stats_tag().size());
@@ -280,6 +297,7 @@ TEST_F(OptionsImplTest, DefaultParams) {
   EXPECT_EQ(0U, options->statsTags().size());
   EXPECT_FALSE(options->hotRestartDisabled());
   EXPECT_FALSE(options->cpusetThreadsEnabled());
+  EXPECT_FALSE(options->pinWorkerThreadsEnabled());
 
   // Validate that CommandLineOptions is constructed correctly with default params.
   Server::CommandLineOptionsPtr command_line_options = options->toCommandLineOptions();
@@ -294,6 +312,7 @@ TEST_F(OptionsImplTest, DefaultParams) {
   EXPECT_EQ(0, command_line_options->socket_mode());
   EXPECT_FALSE(command_line_options->disable_hot_restart());
   EXPECT_FALSE(command_line_options->cpuset_threads());
+  EXPECT_FALSE(command_line_options->pin_worker_threads());
   EXPECT_FALSE(command_line_options->allow_unknown_static_fields());
   EXPECT_FALSE(command_line_options->reject_unknown_dynamic_fields());
   EXPECT_EQ(0, options->statsTags().size());
@@ -312,6 +331,7 @@ TEST_F(OptionsImplTest, DefaultParamsNoConstructorArgs) {
   EXPECT_EQ(0U, options->statsTags().size());
   EXPECT_FALSE(options->hotRestartDisabled());
   EXPECT_FALSE(options->cpusetThreadsEnabled());
+  EXPECT_FALSE(options->pinWorkerThreadsEnabled());
 
   // Not supported for OptionsImplBase
   EXPECT_EQ(nullptr, options->toCommandLineOptions());
@@ -495,11 +515,15 @@ TEST_F(OptionsImplTest, SaneTestConstructor) {
   EXPECT_EQ(spdlog::level::level_enum::info, test_options_impl.logLevel());
   EXPECT_EQ(regular_options_impl->componentLogLevels(), test_options_impl.componentLogLevels());
   EXPECT_EQ(regular_options_impl->logPath(), test_options_impl.logPath());
+  EXPECT_EQ(regular_options_impl->logAsyncBufferSizeKb(), test_options_impl.logAsyncBufferSizeKb());
   EXPECT_EQ(regular_options_impl->parentShutdownTime(), test_options_impl.parentShutdownTime());
   EXPECT_EQ(regular_options_impl->restartEpoch(), test_options_impl.restartEpoch());
   EXPECT_EQ(regular_options_impl->mode(), test_options_impl.mode());
   EXPECT_EQ(regular_options_impl->fileFlushIntervalMsec(),
             test_options_impl.fileFlushIntervalMsec());
+  EXPECT_EQ(regular_options_impl->fileFlushMinSizeKb(), test_options_impl.fileFlushMinSizeKb());
+  EXPECT_EQ(regular_options_impl->fileMaxBufferedSizeKb(),
+            test_options_impl.fileMaxBufferedSizeKb());
   EXPECT_EQ(regular_options_impl->hotRestartDisabled(), test_options_impl.hotRestartDisabled());
   EXPECT_EQ(regular_options_impl->cpusetThreadsEnabled(), test_options_impl.cpusetThreadsEnabled());
 }
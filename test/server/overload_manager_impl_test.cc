@@ -1080,6 +1080,54 @@ TEST_F(OverloadManagerLoadShedPointImplTest, TriggerLoadShedCunterTest) {
   }
 }
 
+TEST_F(OverloadManagerLoadShedPointImplTest, LowPriorityRequestsAreShedFirst) {
+  setDispatcherExpectation();
+  const std::string config = R"EOF(
+    resource_monitors:
+      - name: envoy.resource_monitors.fake_resource1
+        typed_config:
+          "@type": type.googleapis.com/google.protobuf.Struct
+    loadshed_points:
+      - name: "test_point"
+        low_priority_request_header: "x-low-priority"
+        triggers:
+          - name: "envoy.resource_monitors.fake_resource1"
+            scaled:
+              scaling_threshold: 0.5
+              saturation_threshold: 0.9
+  )EOF";
+
+  auto manager{createOverloadManager(config)};
+  manager->start();
+
+  LoadShedPoint* point = manager->getLoadShedPoint("test_point");
+  ASSERT_NE(point, nullptr);
+
+  Http::TestRequestHeaderMapImpl low_priority_headers{{"x-low-priority", "true"}};
+  Http::TestRequestHeaderMapImpl headers;
+  Stats::Counter& shed_load_count = stats_.counter("overload.test_point.shed_load_count");
+
+  EXPECT_FALSE(point->shouldShedRequest(low_priority_headers));
+  EXPECT_FALSE(point->shouldShedRequest(headers));
+
+  // Only the low priority requests are shed until the trigger saturates.
+  factory1_.monitor_->setPressure(0.89);
+  timer_cb_();
+  uint32_t low_priority_shed = 0;
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_FALSE(point->shouldShedRequest(headers));
+    low_priority_shed += point->shouldShedRequest(low_priority_headers);
+  }
+  EXPECT_GT(low_priority_shed, 0);
+  EXPECT_EQ(low_priority_shed, shed_load_count.value());
+
+  factory1_.monitor_->setPressure(0.95);
+  timer_cb_();
+  EXPECT_TRUE(point->shouldShedRequest(low_priority_headers));
+  EXPECT_TRUE(point->shouldShedRequest(headers));
+  EXPECT_EQ(low_priority_shed + 2, shed_load_count.value());
+}
+
 TEST_F(OverloadManagerLoadShedPointImplTest, PointWithMultipleTriggers) {
   setDispatcherExpectation();
   const std::string config = R"EOF(
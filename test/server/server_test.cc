@@ -3,6 +3,7 @@
 #include <vector>
 
 #include "envoy/common/scope_tracker.h"
+#include "envoy/config/cluster/v3/cluster.pb.h"
 #include "envoy/config/core/v3/base.pb.h"
 #include "envoy/network/exception.h"
 #include "envoy/server/bootstrap_extension_config.h"
@@ -38,6 +39,7 @@
 #include "test/test_common/test_time.h"
 #include "test/test_common/utility.h"
 
+#include "absl/strings/str_cat.h"
 #include "absl/synchronization/notification.h"
 #include "gtest/gtest.h"
 #include "openssl/crypto.h"
@@ -1112,6 +1114,34 @@ TEST_P(ServerInstanceImplTest, LoadsBootstrapFromConfigProtoOptionsLast) {
   EXPECT_EQ("foo", server_->localInfo().node().id());
 }
 
+// Validate that the static resources validated on several threads are all loaded.
+TEST_P(ServerInstanceImplTest, StaticResourcesValidatedConcurrently) {
+  options_.config_proto_.set_static_resources_validation_threads(4);
+  for (int i = 0; i < 32; ++i) {
+    auto* cluster = options_.config_proto_.mutable_static_resources()->add_clusters();
+    cluster->set_name(absl::StrCat("cluster_", i));
+    cluster->set_type(envoy::config::cluster::v3::Cluster::STATIC);
+  }
+  initialize("test/server/test_data/server/node_bootstrap.yaml");
+  for (int i = 0; i < 32; ++i) {
+    EXPECT_TRUE(server_->clusterManager().clusters().hasCluster(absl::StrCat("cluster_", i)));
+  }
+}
+
+// Validate that the first invalid static resource is reported when they are validated on several
+// threads.
+TEST_P(ServerInstanceImplTest, InvalidStaticResourceValidatedConcurrently) {
+  options_.config_proto_.set_static_resources_validation_threads(4);
+  for (int i = 0; i < 32; ++i) {
+    auto* cluster = options_.config_proto_.mutable_static_resources()->add_clusters();
+    cluster->set_name(absl::StrCat("cluster_", i));
+    cluster->mutable_connect_timeout()->set_seconds(i < 16 ? 1 : -1);
+  }
+  options_.config_proto_.mutable_static_resources()->mutable_clusters(8)->clear_name();
+  EXPECT_THROW_WITH_REGEX(initialize("test/server/test_data/server/node_bootstrap.yaml"),
+                          EnvoyException, "ClusterValidationError.Name");
+}
+
 // Validate server localInfo() from bootstrap Node with CLI overrides.
 TEST_P(ServerInstanceImplTest, BootstrapNodeWithOptionsOverride) {
   options_.service_cluster_name_ = "some_cluster_name";